@@ -0,0 +1,221 @@
+#include "headless_runner.h"
+#include <args.h>
+#include <log.h>
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <optional>
+#include <string>
+
+using gran_azul::cli::ExitCode;
+using gran_azul::cli::HeadlessOptions;
+using gran_azul::cli::HeadlessRunner;
+using wip::analysis::AnalysisCoordinator;
+using wip::analysis::AnalysisWorker;
+
+namespace {
+
+// "never" turns gating off; anything else must be a severity name
+bool parse_fail_on(const std::string& name, std::optional<wip::analysis::IssueSeverity>& fail_on) {
+    if (name == "never") {
+        fail_on.reset();
+        return true;
+    }
+    for (size_t i = 0; i < wip::analysis::ISSUE_SEVERITY_COUNT; ++i) {
+        auto severity = static_cast<wip::analysis::IssueSeverity>(i);
+        if (name == wip::analysis::severity_to_string(severity)) {
+            fail_on = severity;
+            return true;
+        }
+    }
+    return false;
+}
+
+nlohmann::json usage_error(const std::string& message) {
+    return {{"exit_code", static_cast<int>(ExitCode::Usage)}, {"error", message}};
+}
+
+// Fields left out of a request take the command line's values
+nlohmann::json handle_request(HeadlessRunner& runner, const nlohmann::json& request,
+                              const std::string& default_project, const HeadlessOptions& defaults) {
+    HeadlessOptions options = defaults;
+    std::string project = request.value("project", default_project);
+    if (request.contains("tools")) {
+        options.tools = request["tools"].get<std::vector<std::string>>();
+    }
+    options.output_file = request.value("output", defaults.output_file);
+    options.baseline_file = request.value("baseline", defaults.baseline_file);
+    options.fail_fast = request.value("fail_fast", defaults.fail_fast);
+    options.diff_base = request.value("diff_base", defaults.diff_base);
+
+    if (project.empty()) {
+        return usage_error("No project given");
+    }
+    auto format = request.value("format", std::string());
+    if (!format.empty() && !gran_azul::cli::parse_result_format(format, options.format)) {
+        return usage_error("Unknown format: " + format);
+    }
+    auto fail_on = request.value("fail_on", std::string());
+    if (!fail_on.empty() && !parse_fail_on(fail_on, options.fail_on)) {
+        return usage_error("Unknown severity: " + fail_on);
+    }
+    return runner.run(project, options).to_json();
+}
+
+// One request per line on stdin, one report per line on stdout, until EOF or {"command":"shutdown"}
+int serve(HeadlessRunner& runner, const std::string& default_project, const HeadlessOptions& defaults) {
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        if (line.empty()) {
+            continue;
+        }
+
+        auto request = nlohmann::json::parse(line, nullptr, false);
+        nlohmann::json response;
+        if (request.is_discarded() || !request.is_object()) {
+            response = usage_error("Request is not a JSON object");
+        } else if (request.value("command", "analyze") == "shutdown") {
+            break;
+        } else {
+            try {
+                response = handle_request(runner, request, default_project, defaults);
+            } catch (const nlohmann::json::exception& e) {
+                response = usage_error(std::string("Malformed request: ") + e.what());
+            }
+        }
+
+        std::cout << response.dump() << std::endl;
+    }
+
+    LOG_INFO("GRAN_AZUL_CLI", "Serve mode done, ", runner.get_project_count(), " project(s) kept warm");
+    return static_cast<int>(ExitCode::Passed);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    wip::cli::args::ArgumentParser parser("gran_azul_cli", "Run Gran Azul project analyses without the GUI", "1.0.0");
+
+    parser.add_option({"-p", "--project"}, "project")
+          .description("Project file (.granazul); optional in serve mode")
+          .metavar("FILE");
+    parser.add_option({"-t", "--tools"}, "tools")
+          .description("Comma-separated tools to run instead of those enabled in the project")
+          .multiple();
+    parser.add_option({"-o", "--output"}, "output")
+          .description("Write the results to this file")
+          .metavar("FILE");
+    parser.add_option({"-f", "--format"}, "format")
+          .description("Results file format")
+          .choices({"binary", "ndjson", "json"})
+          .default_value(std::string("binary"));
+    parser.add_option({"-b", "--baseline"}, "baseline")
+          .description("Results file of an earlier run; only new issues count for gating")
+          .metavar("FILE");
+    parser.add_option({"--fail-on"}, "fail_on")
+          .description("Lowest severity of a new issue that fails the run, or 'never'")
+          .default_value(std::string("error"));
+    parser.add_flag({"--fail-fast"}, "fail_fast")
+          .description("Stop every tool at the first issue at the --fail-on severity");
+    parser.add_option({"-j", "--jobs"}, "jobs")
+          .description("Number of tool processes to run at once (0 = from the machine)")
+          .default_value(0);
+    parser.add_flag({"--no-cache"}, "no_cache")
+          .description("Analyse every file, ignoring the project's analysis cache");
+    parser.add_option({"--diff-base"}, "diff_base")
+          .description("Only analyse what changed since this git revision, and report only on changed lines")
+          .metavar("REV");
+    parser.add_flag({"--serve"}, "serve")
+          .description("Read JSON requests from stdin, one per line, and answer each on stdout");
+    parser.add_option({"--workers"}, "workers")
+          .description("Comma-separated host:port of analysis workers to send shards to")
+          .multiple();
+    parser.add_option({"--worker"}, "worker")
+          .description("Serve shards to coordinators on this port, with --jobs slots, until killed")
+          .metavar("PORT")
+          .default_value(0);
+    parser.add_option({"--result-fd"}, "result_fd")
+          .description("Also publish the binary results in the shared memory segment inherited on this descriptor")
+          .metavar("FD")
+          .default_value(-1);
+    parser.add_flag({"-v", "--verbose"}, "verbose")
+          .description("Log progress to stderr");
+
+    auto args = parser.parse(argc, argv);
+    if (!args) {
+        std::cerr << parser.usage() << std::endl;
+        return static_cast<int>(ExitCode::Usage);
+    }
+
+    // stdout carries only reports, so every message goes to stderr
+    wip::utils::log::set_level(args->get_bool("verbose").value_or(false) ? wip::utils::log::Level::Info
+                                                                          : wip::utils::log::Level::Warning);
+    wip::utils::log::set_sink([](const wip::utils::log::Entry& entry) {
+        std::fprintf(stderr, "[%s] %.*s\n", entry.tag, static_cast<int>(entry.message.size()), entry.message.data());
+    });
+
+    HeadlessOptions options;
+    options.tools = args->get_strings("tools").value_or(std::vector<std::string>{});
+    options.output_file = args->get_string("output").value_or("");
+    options.baseline_file = args->get_string("baseline").value_or("");
+    options.use_cache = !args->get_bool("no_cache").value_or(false);
+    options.fail_fast = args->get_bool("fail_fast").value_or(false);
+    options.diff_base = args->get_string("diff_base").value_or("");
+    options.jobs = static_cast<size_t>(std::max(0, args->get_int("jobs").value_or(0)));
+    options.result_fd = args->get_int("result_fd").value_or(-1);
+
+    auto format = args->get_string("format").value_or("binary");
+    auto fail_on = args->get_string("fail_on").value_or("error");
+    if (!gran_azul::cli::parse_result_format(format, options.format)) {
+        std::cerr << "Unknown format: " << format << std::endl;
+        return static_cast<int>(ExitCode::Usage);
+    }
+    if (!parse_fail_on(fail_on, options.fail_on)) {
+        std::cerr << "Unknown severity: " << fail_on << std::endl;
+        return static_cast<int>(ExitCode::Usage);
+    }
+
+    if (int port = args->get_int("worker").value_or(0); port != 0) {
+        if (port < 0 || port > 65535) {
+            std::cerr << "Invalid worker port: " << port << std::endl;
+            return static_cast<int>(ExitCode::Usage);
+        }
+        try {
+            AnalysisWorker worker(static_cast<uint16_t>(port), AnalysisWorker::Options{options.jobs, "0.0.0.0"});
+            worker.serve();
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return static_cast<int>(ExitCode::Failed);
+        }
+        return static_cast<int>(ExitCode::Passed);
+    }
+
+    HeadlessRunner runner;
+    if (auto workers = args->get_strings("workers")) {
+        std::vector<wip::utils::net::Endpoint> endpoints;
+        for (const auto& text : *workers) {
+            auto endpoint = wip::utils::net::Endpoint::parse(text);
+            if (!endpoint) {
+                std::cerr << "Invalid worker address: " << text << std::endl;
+                return static_cast<int>(ExitCode::Usage);
+            }
+            endpoints.push_back(*endpoint);
+        }
+        runner.set_coordinator(std::make_shared<AnalysisCoordinator>(std::move(endpoints)));
+    }
+    auto project = args->get_string("project").value_or("");
+    if (args->get_bool("serve").value_or(false)) {
+        return serve(runner, project, options);
+    }
+    if (project.empty()) {
+        std::cerr << "No project given" << std::endl << parser.usage() << std::endl;
+        return static_cast<int>(ExitCode::Usage);
+    }
+
+    auto report = runner.run(project, options);
+    std::cout << report.to_json().dump(2) << std::endl;
+    if (!report.error_message.empty()) {
+        std::cerr << report.error_message << std::endl;
+    }
+    return static_cast<int>(report.exit_code);
+}
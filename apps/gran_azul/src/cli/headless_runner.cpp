@@ -0,0 +1,194 @@
+#include "headless_runner.h"
+#include "project_analysis.h"
+#include "project_manager.h"
+#include <result_file.h>
+#include <shared_memory.h>
+#include <git_diff.h>
+#include <algorithm>
+#include <filesystem>
+#include <log.h>
+
+namespace gran_azul::cli {
+
+nlohmann::json HeadlessReport::to_json() const {
+    nlohmann::json severities = nlohmann::json::object();
+    for (size_t i = 0; i < issues_by_severity.size(); ++i) {
+        severities[wip::analysis::severity_to_string(static_cast<wip::analysis::IssueSeverity>(i))] = issues_by_severity[i];
+    }
+
+    nlohmann::json j;
+    j["exit_code"] = static_cast<int>(exit_code);
+    j["project"] = project_name;
+    j["tools"] = tools;
+    j["files_analyzed"] = files_analyzed;
+    j["total_issues"] = total_issues;
+    j["new_issues"] = new_issues;
+    j["gating_issues"] = gating_issues;
+    j["issues_by_severity"] = std::move(severities);
+    j["duration_ms"] = duration.count();
+    if (!output_file.empty()) {
+        j["output_file"] = output_file;
+    }
+    if (stopped_early) {
+        j["stopped_early"] = true;
+    }
+    if (!error_message.empty()) {
+        j["error"] = error_message;
+    }
+    return j;
+}
+
+bool parse_result_format(const std::string& name, wip::analysis::ResultFormat& format) {
+    if (name == "binary") {
+        format = wip::analysis::ResultFormat::Binary;
+    } else if (name == "ndjson") {
+        format = wip::analysis::ResultFormat::Ndjson;
+    } else if (name == "json") {
+        format = wip::analysis::ResultFormat::Json;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+HeadlessRunner::ProjectState& HeadlessRunner::get_project_state(const std::string& project_file,
+                                                                 const wip::analysis::AnalysisRequest& request) {
+    auto path = std::filesystem::absolute(project_file);
+    auto& state = projects_[path.string()];
+
+    // The same cache file as the GUI, so either one benefits from the other's runs
+    if (!state.cache) {
+        state.cache = std::make_shared<wip::analysis::AnalysisCache>((path.parent_path() / ".gran_azul_cache.json").string());
+        state.cache->load();
+    }
+    if (!state.include_graph || !state.include_graph->matches(request)) {
+        state.include_graph = std::make_shared<wip::analysis::IncludeGraph>(request);
+        state.cache->set_include_graph(state.include_graph);
+    }
+    return state;
+}
+
+HeadlessReport HeadlessRunner::run(const std::string& project_file, const HeadlessOptions& options) {
+    auto started = std::chrono::steady_clock::now();
+    HeadlessReport report;
+    auto finish = [&report, started](ExitCode exit_code, std::string error_message = "") {
+        report.exit_code = exit_code;
+        report.error_message = std::move(error_message);
+        report.duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started);
+        return report;
+    };
+
+    ProjectManager project_manager;
+    std::string load_error;
+    project_manager.set_error_callback([&load_error](const std::string& message) { load_error = message; });
+    if (!project_manager.load_project(project_file)) {
+        return finish(ExitCode::Failed, load_error.empty() ? "Cannot load project: " + project_file : load_error);
+    }
+
+    const auto& project = project_manager.get_current_project();
+    report.project_name = project.name;
+    auto analysis = make_project_analysis(project);
+    if (!options.tools.empty()) {
+        analysis.tool_names = options.tools;
+    }
+    report.tools = analysis.tool_names;
+    if (analysis.tool_names.empty()) {
+        return finish(ExitCode::Failed, "No analysis tools enabled in the project");
+    }
+
+    // A diff-scoped run analyses only the units the changes reach and reports only on changed lines
+    if (!options.diff_base.empty()) {
+        std::vector<wip::utils::process::FileChanges> changes;
+        try {
+            changes = wip::utils::process::git_changed_lines(
+                std::filesystem::absolute(project_file).parent_path().string(), options.diff_base);
+        } catch (const std::exception& e) {
+            return finish(ExitCode::Failed, e.what());
+        }
+        for (const auto& file : changes) {
+            for (const auto& range : file.ranges) {
+                analysis.request.changed_ranges.push_back({file.path, range.first, range.last});
+            }
+        }
+        if (analysis.request.changed_ranges.empty()) {
+            LOG_INFO("GRAN_AZUL_CLI", "No changes since ", options.diff_base, "; nothing to analyse");
+            return finish(ExitCode::Passed);
+        }
+    }
+
+    // Against a baseline the first severe issue may be an old one, so only full runs can stop early
+    if (options.fail_fast && options.fail_on) {
+        if (options.baseline_file.empty()) {
+            analysis.request.stop_on_severity = options.fail_on;
+        } else {
+            LOG_WARNING("GRAN_AZUL_CLI", "Fail-fast is ignored when comparing against a baseline");
+        }
+    }
+
+    auto engine = wip::analysis::AnalysisEngineFactory::create_engine_with_tools(analysis.tool_names);
+    if (options.jobs > 0) {
+        engine->set_concurrency(options.jobs);
+    }
+    if (options.use_cache) {
+        engine->set_cache(get_project_state(project_file, analysis.request).cache);
+    }
+    configure_project_tools(*engine, std::filesystem::absolute(project_file).parent_path());
+    if (coordinator_) {
+        if (coordinator_->connect() > 0) {
+            engine->set_shard_executor(coordinator_);
+        } else {
+            LOG_WARNING("GRAN_AZUL_CLI", "No analysis worker reachable; analysing locally");
+        }
+    }
+
+    LOG_INFO("GRAN_AZUL_CLI", "Analysing ", project.name, " in ", analysis.request.source_path);
+    std::vector<wip::analysis::AnalysisResult> results;
+    std::vector<wip::analysis::AnalysisResult> baseline;
+    try {
+        if (!options.baseline_file.empty()) {
+            baseline = engine->load_results(options.baseline_file);
+        }
+        results = engine->analyze_async(analysis.tool_names, analysis.request, nullptr, on_output_).get();
+        if (!options.output_file.empty()) {
+            engine->save_results(results, options.output_file, options.format);
+            report.output_file = options.output_file;
+        }
+        if (options.result_fd >= 0) {
+            wip::utils::process::SharedMemorySegment::attach(options.result_fd)
+                .publish(wip::analysis::BinaryResultFile::serialize(results));
+        }
+    } catch (const std::exception& e) {
+        return finish(ExitCode::Failed, e.what());
+    }
+
+    // Aggregation drops issues reported by several tools
+    auto aggregated = engine->aggregate_results(results);
+    report.stopped_early = std::any_of(results.begin(), results.end(),
+                                       [](const wip::analysis::AnalysisResult& result) { return result.stopped_early; });
+    report.files_analyzed = aggregated.files_analyzed;
+    report.total_issues = aggregated.issues.size();
+    for (const auto& issue : aggregated.issues) {
+        ++report.issues_by_severity[static_cast<size_t>(issue.severity)];
+    }
+
+    // Without a baseline every issue is new
+    std::vector<wip::analysis::AnalysisIssue> new_issues;
+    if (options.baseline_file.empty()) {
+        new_issues = std::move(aggregated.issues);
+    } else {
+        new_issues = engine->compare_results(baseline, results).new_issues;
+    }
+    report.new_issues = new_issues.size();
+    if (options.fail_on) {
+        for (const auto& issue : new_issues) {
+            report.gating_issues += issue.severity >= *options.fail_on;
+        }
+    }
+
+    if (!aggregated.success) {
+        return finish(ExitCode::Failed, aggregated.error_message);
+    }
+    return finish(report.gating_issues > 0 ? ExitCode::Gated : ExitCode::Passed);
+}
+
+} // namespace gran_azul::cli
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <analysis_cache.h>
+#include <analysis_engine.h>
+#include <distributed_analysis.h>
+#include <include_graph.h>
+#include <result_file.h>
+#include <nlohmann/json.hpp>
+#include <array>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace gran_azul::cli {
+
+/**
+ * @brief Process exit codes of gran_azul_cli, also reported per request in serve mode
+ */
+enum class ExitCode : int {
+    Passed = 0,     ///< No issue at or above the gating severity
+    Gated = 1,      ///< Issues at or above the gating severity were found
+    Failed = 2,     ///< The project could not be loaded or a tool failed
+    Usage = 64      ///< Invalid command line or request
+};
+
+/**
+ * @brief How one headless analysis is run and judged
+ */
+struct HeadlessOptions {
+    std::vector<std::string> tools;                             ///< Tools to run (empty = those enabled in the project)
+    std::string output_file;                                    ///< Results file to write (empty = none)
+    wip::analysis::ResultFormat format = wip::analysis::ResultFormat::Binary;
+    std::string baseline_file;                                  ///< Only issues missing from this run count for gating
+    std::optional<wip::analysis::IssueSeverity> fail_on = wip::analysis::IssueSeverity::Error;  ///< nullopt = never gate
+    bool use_cache = true;                                      ///< Reuse results of unchanged files
+    bool fail_fast = false;                                     ///< Stop at the first issue at fail_on (ignored with a baseline)
+    std::string diff_base;                                      ///< Only report on lines changed since this git revision (empty = whole project)
+    size_t jobs = 0;                                            ///< Concurrency budget (0 = from the machine)
+    int result_fd = -1;                                         ///< SharedMemorySegment to publish the results in (-1 = none)
+};
+
+/**
+ * @brief Outcome of one headless analysis
+ */
+struct HeadlessReport {
+    ExitCode exit_code = ExitCode::Passed;
+    std::string project_name;
+    std::vector<std::string> tools;
+    std::string error_message;                                  ///< Why the run failed, empty otherwise
+    size_t files_analyzed = 0;
+    size_t total_issues = 0;
+    size_t new_issues = 0;                                      ///< Issues not in the baseline (all without one)
+    size_t gating_issues = 0;                                   ///< New issues at or above the gating severity
+    std::array<size_t, wip::analysis::ISSUE_SEVERITY_COUNT> issues_by_severity{};
+    std::chrono::milliseconds duration{0};
+    std::string output_file;                                    ///< Results file written, empty if none
+    bool stopped_early = false;                                 ///< A fail-fast run stopped at its first gating issue
+
+    nlohmann::json to_json() const;
+};
+
+/**
+ * @brief Runs project analyses without a GUI, keeping per-project state warm
+ *
+ * Each project file keeps its AnalysisCache and IncludeGraph between runs, so
+ * a long-lived runner (gran_azul_cli --serve) rescans only what changed and
+ * skips the cache file load. Tool discovery is cached process-wide by
+ * ToolDiscovery::get_shared() already. With a coordinator, external tools'
+ * shards run on its workers. Not thread-safe; run one analysis at a time.
+ */
+class HeadlessRunner {
+public:
+    using OutputCallback = std::function<void(const std::string& tool_name, const std::string& line)>;
+
+    HeadlessRunner() = default;
+
+    HeadlessRunner(const HeadlessRunner&) = delete;
+    HeadlessRunner& operator=(const HeadlessRunner&) = delete;
+
+    /**
+     * @brief Load a project file, analyse it and judge the result
+     * @param project_file Path to a .granazul project
+     * @param options What to run and how to gate
+     * @return Report; failures are reported in it rather than thrown
+     */
+    HeadlessReport run(const std::string& project_file, const HeadlessOptions& options);
+
+    /**
+     * @brief Receive the tools' output lines, on analysis threads (may be empty)
+     */
+    void set_output_callback(OutputCallback callback) { on_output_ = std::move(callback); }
+
+    /**
+     * @brief Send shards to remote workers (nullptr = run everything locally)
+     *
+     * Workers lost in a run are connected again at the start of the next one;
+     * without any worker reachable the run falls back to this machine.
+     */
+    void set_coordinator(std::shared_ptr<wip::analysis::AnalysisCoordinator> coordinator) {
+        coordinator_ = std::move(coordinator);
+    }
+
+    /**
+     * @brief Get number of projects whose state is kept warm
+     */
+    size_t get_project_count() const { return projects_.size(); }
+
+private:
+    struct ProjectState {
+        std::shared_ptr<wip::analysis::AnalysisCache> cache;
+        std::shared_ptr<wip::analysis::IncludeGraph> include_graph;
+    };
+
+    ProjectState& get_project_state(const std::string& project_file, const wip::analysis::AnalysisRequest& request);
+
+    OutputCallback on_output_;
+    std::shared_ptr<wip::analysis::AnalysisCoordinator> coordinator_;
+    std::map<std::string, ProjectState> projects_;     // By absolute project file path
+};
+
+/**
+ * @brief Parse a result format name ("binary", "ndjson" or "json")
+ * @return false if the name is unknown
+ */
+bool parse_result_format(const std::string& name, wip::analysis::ResultFormat& format);
+
+} // namespace gran_azul::cli
@@ -8,17 +8,29 @@
 #include "analysis_manager_widget.h"
 #include "log_window_panel.h"
 #include "analysis_result_panel.h"
+#include "event_statistics_panel.h"
+#include "history_trend_panel.h"
 #include "analysis_result.h"
 #include "progress_dialog.h"
 #include "utils/async_process_executor.h"
+#include "utils/analysis_events.h"
 #include "project_manager.h"
+#include "project_analysis.h"
 #include "report_generator.h"
 #include "widgets/project_startup_modal.h"
 #include "analysis_engine.h"
 #include "analysis_types.h"
+#include "history_store.h"
+#include "include_graph.h"
+#include "progress_channel.h"
+#include <async_file_writer.h>
+#include <file_watcher.h>
 #include <nfd.h>
+#include <cstdlib>
 #include <memory>
-#include <iostream>
+#include <log.h>
+#include <wip_string.h>
+#include <array>
 #include <atomic>
 #include <mutex>
 #include <filesystem>
@@ -45,57 +57,92 @@ struct GranAzulTheme {
     ImVec4 background = ImVec4(0.08f, 0.12f, 0.18f, 1.00f);      // Very dark blue background
 };
 
-// Font management system
+// Font management system. Only the regular font is loaded at startup; the
+// others are loaded between frames the first time they are asked for, and
+// ImGui's atlas is restored from the application's font cache when the files,
+// sizes and DPI match a previous start.
 struct FontSystem {
-    ImFont* regular_font = nullptr;
-    ImFont* medium_font = nullptr;
-    ImFont* bold_font = nullptr;
+    enum class Style { REGULAR, MEDIUM, BOLD, COUNT };
+    
     bool fonts_loaded = false;
     
-    void load_fonts() {
-        ImGuiIO& io = ImGui::GetIO();
-        
-        // Configure font loading
-        io.Fonts->AddFontDefault(); // Fallback font
-        
-        // Load Figtree fonts with different weights
-        const std::string font_path = "/home/jalvarez/wip/Figtree/static/";
-        
-        // Try to load Figtree Regular (16px)
-        regular_font = io.Fonts->AddFontFromFileTTF((font_path + "Figtree-Regular.ttf").c_str(), 16.0f);
-        if (regular_font == nullptr) {
-            std::cout << "[GRAN_AZUL] Warning: Could not load Figtree-Regular.ttf, using default font\n";
-            regular_font = io.Fonts->Fonts[0]; // Use default font as fallback
-        } else {
-            std::cout << "[GRAN_AZUL] Loaded Figtree-Regular.ttf successfully\n";
+    void load_fonts(Application& app) {
+        wanted_[static_cast<size_t>(Style::REGULAR)] = true;
+        load(app);
+        fonts_loaded = true;
+        LOG_INFO("GRAN_AZUL", "Font system initialized");
+    }
+    
+    // The font of a style, or the regular font until the style is loaded
+    ImFont* get(Style style) {
+        size_t index = static_cast<size_t>(style);
+        if (!wanted_[index]) {
+            wanted_[index] = true;
+            pending_ = true;
+        }
+        return fonts_[index] ? fonts_[index] : fonts_[static_cast<size_t>(Style::REGULAR)];
+    }
+    
+    // Load the styles asked for since the last call; only outside of a frame
+    bool load_requested_fonts(Application& app) {
+        if (!pending_) {
+            return false;
         }
+        load(app);
+        return true;
+    }
+    
+private:
+    struct Face {
+        const char* file;
+        float size;
+    };
+    
+    static constexpr Face FACES[] = {
+        {"Figtree-Regular.ttf", 16.0f},
+        {"Figtree-Medium.ttf", 18.0f},     // Headers
+        {"Figtree-Bold.ttf", 16.0f}        // Emphasis
+    };
+    static constexpr size_t STYLE_COUNT = static_cast<size_t>(Style::COUNT);
+    
+    std::array<ImFont*, STYLE_COUNT> fonts_{};
+    std::array<bool, STYLE_COUNT> wanted_{};
+    bool pending_ = false;
+    
+    // Reload the atlas with every wanted style; earlier font pointers become invalid
+    void load(Application& app) {
+        const std::string font_path = "/home/jalvarez/wip/Figtree/static/";
         
-        // Try to load Figtree Medium (18px) for headers
-        medium_font = io.Fonts->AddFontFromFileTTF((font_path + "Figtree-Medium.ttf").c_str(), 18.0f);
-        if (medium_font == nullptr) {
-            std::cout << "[GRAN_AZUL] Warning: Could not load Figtree-Medium.ttf, using regular font\n";
-            medium_font = regular_font;
-        } else {
-            std::cout << "[GRAN_AZUL] Loaded Figtree-Medium.ttf successfully\n";
+        std::vector<FontSpec> specs;
+        std::vector<size_t> styles;
+        for (size_t i = 0; i < STYLE_COUNT; ++i) {
+            if (wanted_[i]) {
+                specs.push_back({font_path + FACES[i].file, FACES[i].size});
+                styles.push_back(i);
+            }
         }
         
-        // Try to load Figtree Bold (16px) for emphasis
-        bold_font = io.Fonts->AddFontFromFileTTF((font_path + "Figtree-Bold.ttf").c_str(), 16.0f);
-        if (bold_font == nullptr) {
-            std::cout << "[GRAN_AZUL] Warning: Could not load Figtree-Bold.ttf, using regular font\n";
-            bold_font = regular_font;
-        } else {
-            std::cout << "[GRAN_AZUL] Loaded Figtree-Bold.ttf successfully\n";
+        auto start = std::chrono::steady_clock::now();
+        std::vector<ImFont*> loaded = app.load_fonts(specs);
+        fonts_.fill(nullptr);
+        for (size_t i = 0; i < styles.size(); ++i) {
+            fonts_[styles[i]] = loaded[i];
+            if (!loaded[i]) {
+                LOG_WARNING("GRAN_AZUL", "Warning: Could not load ", FACES[styles[i]].file, ", using default font");
+            }
         }
         
-        // Set Figtree Regular as the default font
-        if (regular_font) {
-            io.FontDefault = regular_font;
-            std::cout << "[GRAN_AZUL] Set Figtree-Regular as default font\n";
+        // The built-in font is the first one of the atlas
+        ImGuiIO& io = ImGui::GetIO();
+        ImFont*& regular_font = fonts_[static_cast<size_t>(Style::REGULAR)];
+        if (!regular_font) {
+            regular_font = io.Fonts->Fonts[0];
         }
+        io.FontDefault = regular_font;
+        pending_ = false;
         
-        fonts_loaded = true;
-        std::cout << "[GRAN_AZUL] Font system initialized\n";
+        auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+        LOG_DEBUG("GRAN_AZUL", "Loaded ", specs.size(), " fonts in ", elapsed.count(), " ms");
     }
 };
 
@@ -105,6 +152,7 @@ private:
     bool first_frame = true;
     GranAzulTheme current_theme;
     FontSystem font_system;
+    Application* application_ = nullptr;
     ProcessExecutor process_executor;
     
     // Widgets
@@ -112,6 +160,8 @@ private:
     std::unique_ptr<gran_azul::widgets::AnalysisManagerWidget> analysis_manager_;
     std::unique_ptr<LogWindowPanel> log_panel_;
     std::unique_ptr<AnalysisResultPanel> analysis_panel_;
+    std::unique_ptr<gran_azul::widgets::EventStatisticsPanel> event_statistics_panel_;
+    std::unique_ptr<gran_azul::widgets::HistoryTrendPanel> history_panel_;
     std::unique_ptr<gran_azul::widgets::ProgressDialog> progress_dialog_;
     std::unique_ptr<gran_azul::widgets::ProjectStartupModal> startup_modal_;
     
@@ -126,51 +176,64 @@ private:
     std::mutex completion_data_mutex_;
     std::vector<wip::analysis::AnalysisResult> pending_results_;
     std::vector<std::string> pending_tool_names_;
-    gran_azul::widgets::AnalysisResult pending_analysis_result_; // For single analysis results
+    std::shared_ptr<gran_azul::widgets::PreparedAnalysisResult> pending_analysis_result_; // Prepared on the worker
     wip::utils::process::ProcessResult pending_result_; // Keep for legacy cppcheck
     // Remove: CppcheckConfig pending_config_; // No longer needed
     std::vector<std::string> pending_args_; // Keep for legacy cppcheck
     
-    // Progress handling (for thread-safe UI updates)
-    std::atomic<bool> progress_updated_{false};
-    std::mutex progress_data_mutex_;
-    struct ProgressData {
-        std::string tool_name;
-        float progress_ratio = 0.0f;
-        std::string status_message;
-        std::string current_file;
-    };
-    ProgressData pending_progress_;
+    // Analysis engine callbacks publish events; handlers run on the UI executor
+    wip::utils::event::EventDispatcher* event_dispatcher_ = nullptr;
+    wip::utils::event::Executor* ui_executor_ = nullptr;
+    std::vector<wip::utils::event::ScopedSubscription> analysis_subscriptions_;
     
-    // Progress update throttling to prevent UI flooding
-    std::chrono::steady_clock::time_point last_progress_update_;
-    static constexpr std::chrono::milliseconds progress_update_interval_{100}; // Max 10 updates per second
+    // Tool output and progress of the running analysis; workers publish, on_update drains once per frame
+    std::shared_ptr<wip::analysis::ProgressChannel> progress_channel_;
+    uint64_t reported_dropped_lines_ = 0;
     
     // Delayed analysis start (to ensure modal renders first)
     std::atomic<bool> start_analysis_next_frame_{false};
     std::vector<std::string> pending_analysis_tool_names_;
     wip::analysis::AnalysisRequest pending_analysis_request_;
     
+    // Log entry the running analysis streams its output into (0 when none)
+    uint64_t analysis_log_entry_ = 0;
+    std::chrono::steady_clock::time_point analysis_log_started_;
+    
+    // Every completed run of the project is recorded here (null when it can't be opened)
+    std::shared_ptr<wip::analysis::HistoryStore> history_store_;
+    static constexpr size_t REPORT_HISTORY_RUNS = 30;   // Runs whose issue counts go into reports
+    
     // Store the analysis future to keep it alive
-    std::future<std::vector<wip::analysis::AnalysisResult>> current_analysis_future_;
+    wip::utils::concurrency::Task<std::vector<wip::analysis::AnalysisResult>> current_analysis_future_;
     
     // Project management
     std::unique_ptr<gran_azul::ProjectManager> project_manager_;
     bool project_loaded_ = false;
     
+    // Watches the project's sources; change batches arrive as SourceFilesChangedEvent
+    std::unique_ptr<wip::utils::file::FileWatcher> source_watcher_;
+    std::string watched_source_path_;
+    bool reanalyze_on_save_ = false;
+    bool reanalysis_pending_ = false;   // Sources changed; rerun once no analysis is running
+    
+    // Include dependencies of the analyzed units, kept between runs and updated from source changes
+    std::shared_ptr<wip::analysis::IncludeGraph> include_graph_;
+    
+    // Saves reports off the UI thread; finishes pending saves on shutdown
+    wip::utils::file::AsyncFileWriter report_writer_;
+    
     // Window state
     bool show_analysis_config = false;
 
 public:
     GranAzulMainLayer() : Layer("GranAzul") {
-        // Initialize progress update throttling
-        last_progress_update_ = std::chrono::steady_clock::now();
-        
         // Create widgets
         analysis_config_widget_ = std::make_unique<AnalysisConfigWidget>();
         analysis_manager_ = std::make_unique<gran_azul::widgets::AnalysisManagerWidget>();
         log_panel_ = std::make_unique<LogWindowPanel>();
         analysis_panel_ = std::make_unique<AnalysisResultPanel>("Analysis Results");
+        event_statistics_panel_ = std::make_unique<gran_azul::widgets::EventStatisticsPanel>();
+        history_panel_ = std::make_unique<gran_azul::widgets::HistoryTrendPanel>();
         progress_dialog_ = std::make_unique<gran_azul::widgets::ProgressDialog>("Analysis Progress");
         startup_modal_ = std::make_unique<gran_azul::widgets::ProjectStartupModal>();
         
@@ -184,34 +247,76 @@ public:
         setup_widget_callbacks();
         setup_startup_modal_callbacks();
     }
+    
+    // Fonts are loaded through the application, which owns ImGui's context
+    void set_application(Application* application) {
+        application_ = application;
+    }
+    
+    void connect_events(wip::utils::event::EventDispatcher* dispatcher, wip::utils::event::Executor& ui_executor) {
+        using namespace gran_azul::utils;
+        
+        event_dispatcher_ = dispatcher;
+        ui_executor_ = &ui_executor;
+        event_statistics_panel_->set_dispatcher(dispatcher);
+        analysis_subscriptions_.clear();
+        if (!dispatcher) {
+            return;
+        }
+        
+        // Published by analysis workers, handled on the UI thread in publication order
+        analysis_subscriptions_.push_back(dispatcher->subscribe_scoped_on<AnalysisIssuesEvent>(ui_executor,
+            [this](const AnalysisIssuesEvent& event) { analysis_panel_->append_issues(event.issues()); }));
+        analysis_subscriptions_.push_back(dispatcher->subscribe_scoped_on<AnalysisCompletedEvent>(ui_executor,
+            [this](const AnalysisCompletedEvent& event) {
+                {
+                    std::lock_guard<std::mutex> lock(completion_data_mutex_);
+                    pending_analysis_result_ = event.result();
+                }
+                handle_analysis_completion();
+            }));
+        analysis_subscriptions_.push_back(dispatcher->subscribe_scoped_on<SourceFilesChangedEvent>(ui_executor,
+            [this](const SourceFilesChangedEvent& event) { handle_source_changes(event); }));
+    }
 
     void on_attach() override {
-        std::cout << "[GRAN_AZUL] Application layer attached\n";
+        LOG_INFO("GRAN_AZUL", "Application layer attached");
         
         // Initialize NFD (nativefiledialog-extended)
         NFD_Init();
         
         // Now it's safe to initialize ImGui-dependent components
-        font_system.load_fonts();
+        if (application_) {
+            font_system.load_fonts(*application_);
+        }
         apply_gran_azul_theme();
         
-        std::cout << "[GRAN_AZUL] ImGui components initialized\n";
+        LOG_INFO("GRAN_AZUL", "ImGui components initialized");
     }
 
     void on_detach() override {
-        std::cout << "[GRAN_AZUL] Application layer detached\n";
+        LOG_INFO("GRAN_AZUL", "Application layer detached");
+        
+        // The dispatcher goes away with the application, before the layers
+        stop_source_watcher();
+        analysis_subscriptions_.clear();
         
         // Cleanup NFD (nativefiledialog-extended)
         NFD_Quit();
     }
 
     void on_update(Timestep timestep) override {
+        // Styles first asked for in the last frame are loaded now, outside of a frame
+        if (application_ && font_system.load_requested_fonts(*application_)) {
+            application_->request_frame();
+        }
+        
         // Debug: Track main thread activity during analysis
         static auto last_debug = std::chrono::steady_clock::now();
         auto now = std::chrono::steady_clock::now();
         if (now - last_debug > std::chrono::seconds(1)) {
             if (current_analysis_engine_ && current_analysis_engine_->is_analysis_running()) {
-                std::cout << "[GRAN_AZUL] Main thread active during analysis (every 1s debug)\n";
+                LOG_TRACE("GRAN_AZUL", "Main thread active during analysis (every 1s debug)");
             }
             last_debug = now;
         }
@@ -221,15 +326,22 @@ public:
             start_pending_analysis();
         }
         
-        // Check for progress updates and handle on main thread
-        if (progress_updated_.load()) {
-            handle_progress_update();
-            progress_updated_.store(false);
+        // Re-analyze saved sources once the previous analysis is done
+        bool analysis_running = current_analysis_engine_ && current_analysis_engine_->is_analysis_running();
+        if (reanalysis_pending_ && !analysis_running && !start_analysis_next_frame_.load()) {
+            reanalysis_pending_ = false;
+            if (reanalyze_on_save_ && project_manager_->has_project()) {
+                LOG_INFO("GRAN_AZUL", "Sources changed - Re-analyzing");
+                run_project_analysis();
+            }
         }
         
+        // Tool output and progress reach the widgets once per frame
+        drain_progress_channel();
+        
         // Check for completed analysis and handle on main thread
         if (analysis_completed_.load()) {
-            std::cout << "[GRAN_AZUL] Main thread detected analysis completion\n";
+            LOG_INFO("GRAN_AZUL", "Main thread detected analysis completion");
             handle_analysis_completion();
             analysis_completed_.store(false);
         }
@@ -261,6 +373,7 @@ public:
         analysis_manager_->update(delta_time);
         log_panel_->update(delta_time);
         analysis_panel_->update(delta_time);
+        event_statistics_panel_->update(delta_time);
         progress_dialog_->update(delta_time);
         
         // Main application window with docking support
@@ -294,23 +407,44 @@ public:
         // Main content area
         render_main_content();
         
+        // Panels are timed one by one for the profiler overlay (F12)
+        FrameProfiler* profiler = application_ ? &application_->get_profiler() : nullptr;
+        
         // Log window
         if (log_panel_->is_visible()) {
+            FrameProfiler::Scope scope(profiler, "Log", "Panel");
             log_panel_->draw();
         }
         
         // Analysis results window
         if (analysis_panel_->is_visible()) {
+            FrameProfiler::Scope scope(profiler, "Analysis Results", "Panel");
             analysis_panel_->draw();
         }
         
+        // Event statistics window (debug)
+        if (event_statistics_panel_->is_visible()) {
+            FrameProfiler::Scope scope(profiler, "Event Statistics", "Panel");
+            event_statistics_panel_->draw();
+        }
+        
+        // Analysis history window
+        if (history_panel_->is_visible()) {
+            FrameProfiler::Scope scope(profiler, "Analysis History", "Panel");
+            history_panel_->draw();
+        }
+        
         // Analysis manager window
         if (analysis_manager_->is_visible()) {
+            FrameProfiler::Scope scope(profiler, "Analysis Manager", "Panel");
             analysis_manager_->render();
         }
         
         // Progress dialog (rendered on top)
-        progress_dialog_->draw();
+        {
+            FrameProfiler::Scope scope(profiler, "Progress", "Panel");
+            progress_dialog_->draw();
+        }
         
         // Cppcheck configuration window (legacy - keep for backward compatibility)
         if (show_analysis_config) {
@@ -329,39 +463,25 @@ public:
             if (key_event->action() == KeyboardEvent::Action::Press) {
                 switch (key_event->key()) {
                     case GLFW_KEY_F1:
-                        std::cout << "[GRAN_AZUL] F1 pressed - Show help\n";
+                        LOG_DEBUG("GRAN_AZUL", "F1 pressed - Show help");
                         return true;
                         
                     case GLFW_KEY_F5:
                         if (project_manager_->has_project()) {
-                            std::cout << "[GRAN_AZUL] F5 pressed - Run analysis\n";
-                            // Run unified analysis with project configuration
-                            const auto& project_config = project_manager_->get_current_project();
-                            wip::analysis::AnalysisRequest request;
-                            request.source_path = project_config.analysis.source_path;
-                            request.output_file = "analysis_results.xml";
-                            
-                            std::vector<std::string> tool_names;
-                            if (project_config.analysis.enable_cppcheck) tool_names.push_back("cppcheck");
-                            if (project_config.analysis.enable_clang_tidy) tool_names.push_back("clang-tidy");
-                            
-                            if (!tool_names.empty()) {
-                                run_analysis_with_library(tool_names, request);
-                            } else {
-                                std::cout << "[GRAN_AZUL] No analysis tools enabled in project configuration\n";
-                            }
+                            LOG_DEBUG("GRAN_AZUL", "F5 pressed - Run analysis");
+                            run_project_analysis();
                         } else {
-                            std::cout << "[GRAN_AZUL] F5 pressed - No project loaded\n";
+                            LOG_DEBUG("GRAN_AZUL", "F5 pressed - No project loaded");
                         }
                         return true;
                     
                     case GLFW_KEY_F11:
-                        std::cout << "[GRAN_AZUL] F11 pressed - Toggle fullscreen\n";
+                        LOG_DEBUG("GRAN_AZUL", "F11 pressed - Toggle fullscreen");
                         return true;
                     
                     case GLFW_KEY_E:
                         if (key_event->is_ctrl() && project_manager_->has_project()) {
-                            std::cout << "[GRAN_AZUL] Ctrl+E pressed - Generate report\n";
+                            LOG_DEBUG("GRAN_AZUL", "Ctrl+E pressed - Generate report");
                             generate_comprehensive_report();
                             return true;
                         }
@@ -393,6 +513,7 @@ private:
         analysis_manager_->set_configuration_changed_callback([this]() {
             sync_project_from_ui();
             save_project();
+            watch_project_sources();
         });
         
         // Setup analysis result panel callbacks
@@ -419,53 +540,109 @@ private:
         });
     }
     
-    void handle_progress_update() {
-        std::lock_guard<std::mutex> lock(progress_data_mutex_);
-        
-        // Update progress dialog with thread-safe data
-        if (!pending_progress_.status_message.empty()) {
-            progress_dialog_->set_progress(pending_progress_.progress_ratio, pending_progress_.status_message);
+    void handle_progress_update(const std::string& tool_name, const wip::analysis::AnalysisProgress& progress) {
+        if (!progress.status_message.empty()) {
+            std::string status_message = progress.status_message;
+            if (!progress.current_file.empty()) {
+                status_message += " (" + progress.current_file + ")";
+            }
+            progress_dialog_->set_progress(static_cast<float>(progress.get_progress_ratio()), status_message);
             
             // Add output line for file processing
-            if (!pending_progress_.current_file.empty()) {
-                progress_dialog_->add_output_line("[" + pending_progress_.tool_name + "] Processing: " + pending_progress_.current_file);
+            if (!progress.current_file.empty()) {
+                progress_dialog_->add_output_line("[" + tool_name + "] Processing: " + progress.current_file);
             }
         }
     }
     
+    // Moves what the tools published since the last frame into the dialog and the log, in one batch
+    void drain_progress_channel() {
+        if (!progress_channel_) return;
+        
+        std::string log_output;
+        progress_channel_->drain(
+            [this, &log_output](const std::string& tool_name, const std::string& output_line) {
+                std::string line = "[" + tool_name + "] " + output_line;
+                progress_dialog_->add_output_line(line);
+                log_output += line;
+                log_output += '\n';
+            },
+            [this](const std::string& tool_name, const wip::analysis::AnalysisProgress& progress) {
+                handle_progress_update(tool_name, progress);
+            });
+        if (!log_output.empty()) {
+            log_panel_->append_log_output(analysis_log_entry_, OutputStream::Stdout, log_output);
+        }
+        
+        // The tools outran the UI; say so instead of silently leaving gaps
+        uint64_t dropped = progress_channel_->get_statistics().lines_dropped;
+        if (dropped > reported_dropped_lines_) {
+            progress_dialog_->add_output_line("[" + std::to_string(dropped - reported_dropped_lines_) +
+                                              " output lines dropped]");
+            reported_dropped_lines_ = dropped;
+        }
+    }
+    
     void handle_analysis_completion() {
-        std::cout << "[GRAN_AZUL] Handling analysis completion on main thread\n";
-        std::lock_guard<std::mutex> lock(completion_data_mutex_);
+        LOG_DEBUG("GRAN_AZUL", "Handling analysis completion on main thread");
+        
+        // Only the pointer swap happens under the lock; the result was prepared on the worker
+        std::shared_ptr<gran_azul::widgets::PreparedAnalysisResult> prepared;
+        {
+            std::lock_guard<std::mutex> lock(completion_data_mutex_);
+            prepared = std::move(pending_analysis_result_);
+        }
+        
+        // The tools are done publishing; deliver the rest before the log entry closes
+        if (progress_channel_) {
+            drain_progress_channel();
+            auto statistics = progress_channel_->get_statistics();
+            LOG_DEBUG("GRAN_AZUL", "Progress channel: ", statistics.lines_delivered, " lines delivered, ",
+                      statistics.lines_dropped, " dropped, peak ", statistics.peak_queued_lines, " queued; ",
+                      statistics.progress_merged, " of ", statistics.progress_published, " progress updates merged");
+            progress_channel_.reset();
+        }
+        
+        // Close the log entry the analysis output streamed into
+        if (analysis_log_entry_ != 0) {
+            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - analysis_log_started_);
+            bool success = prepared && prepared->result.analysis_successful;
+            log_panel_->finish_log_entry(analysis_log_entry_, success, success ? 0 : 1, duration);
+            analysis_log_entry_ = 0;
+        }
         
         // Check if we have a new analysis result from the analysis library
-        if (pending_analysis_result_.analysis_successful || !pending_analysis_result_.error_message.empty()) {
-            std::cout << "[GRAN_AZUL] Processing analysis library result\n";
+        if (prepared) {
+            LOG_DEBUG("GRAN_AZUL", "Processing analysis library result");
+            bool success = prepared->result.analysis_successful;
             
             // Update progress dialog
-            progress_dialog_->set_completed(pending_analysis_result_.analysis_successful, 
-                pending_analysis_result_.analysis_successful ? "Analysis completed successfully" : "Analysis completed with errors");
-            
-            // Display results in analysis panel
-            analysis_panel_->set_analysis_result(pending_analysis_result_);
+            progress_dialog_->set_completed(success, 
+                success ? "Analysis completed successfully" : "Analysis completed with errors");
             
             // Print summary to console
-            if (pending_analysis_result_.analysis_successful) {
-                std::cout << "[GRAN_AZUL] Analysis Summary:\n";
-                std::cout << "  - Total issues: " << pending_analysis_result_.issues.size() << "\n";
-                std::cout << "  - Errors: " << pending_analysis_result_.count_by_severity(IssueSeverity::ERROR) << "\n";
-                std::cout << "  - Warnings: " << pending_analysis_result_.count_by_severity(IssueSeverity::WARNING) << "\n";
-                std::cout << "  - Style issues: " << pending_analysis_result_.count_by_severity(IssueSeverity::STYLE) << "\n";
-                std::cout << "  - Performance issues: " << pending_analysis_result_.count_by_severity(IssueSeverity::PERFORMANCE) << "\n";
+            if (success) {
+                const auto& counts = prepared->severity_counts;
+                LOG_INFO("GRAN_AZUL", "Analysis Summary:");
+                LOG_INFO("GRAN_AZUL", "  - Total issues: ", prepared->result.issues.size());
+                LOG_INFO("GRAN_AZUL", "  - Errors: ", counts[static_cast<size_t>(IssueSeverity::ERROR)]);
+                LOG_INFO("GRAN_AZUL", "  - Warnings: ", counts[static_cast<size_t>(IssueSeverity::WARNING)]);
+                LOG_INFO("GRAN_AZUL", "  - Style issues: ", counts[static_cast<size_t>(IssueSeverity::STYLE)]);
+                LOG_INFO("GRAN_AZUL", "  - Performance issues: ", counts[static_cast<size_t>(IssueSeverity::PERFORMANCE)]);
             } else {
-                std::cout << "[GRAN_AZUL] Analysis failed: " << pending_analysis_result_.error_message << "\n";
+                LOG_ERROR("GRAN_AZUL", "Analysis failed: ", prepared->result.error_message);
             }
             
-            // Clear the result
-            pending_analysis_result_ = gran_azul::widgets::AnalysisResult{};
-        } 
+            // Display results in analysis panel; it takes the issues and index over
+            analysis_panel_->set_prepared_result(std::move(*prepared));
+            return;
+        }
+        
+        std::lock_guard<std::mutex> lock(completion_data_mutex_);
+        
         // Fallback to legacy cppcheck handling
-        else if (pending_result_.exit_code != -1) {
-            std::cout << "[GRAN_AZUL] Processing legacy cppcheck result\n";
+        if (pending_result_.exit_code != -1) {
+            LOG_DEBUG("GRAN_AZUL", "Processing legacy cppcheck result");
             
             // Create log entry
             std::string command_str = "cppcheck";
@@ -474,11 +651,11 @@ private:
             }
             log_panel_->add_log_entry(command_str, pending_result_);
             
-            std::cout << "[GRAN_AZUL] Cppcheck analysis completed with exit code: " << pending_result_.exit_code << "\n";
-            // std::cout << "[GRAN_AZUL] Output saved to: " << pending_config_.output_file << "\n"; // REMOVED: Legacy
+            LOG_INFO("GRAN_AZUL", "Cppcheck analysis completed with exit code: ", pending_result_.exit_code);
+            // LOG_INFO("GRAN_AZUL", "Output saved to: ", pending_config_.output_file); // REMOVED: Legacy
             
             // Update progress dialog
-            std::cout << "[GRAN_AZUL] Setting progress dialog as completed\n";
+            LOG_DEBUG("GRAN_AZUL", "Setting progress dialog as completed");
             progress_dialog_->set_completed(pending_result_.success(), 
                 pending_result_.success() ? "Analysis completed successfully" : "Analysis completed with errors");
             
@@ -489,7 +666,7 @@ private:
             pending_result_ = wip::utils::process::ProcessResult{};
         }
         
-        std::cout << "[GRAN_AZUL] Analysis completion handling finished\n";
+        LOG_DEBUG("GRAN_AZUL", "Analysis completion handling finished");
     }
     
     // REMOVED: Legacy cppcheck methods
@@ -497,12 +674,11 @@ private:
     
     void generate_comprehensive_report() {
         if (!project_manager_->has_project()) {
-            std::cout << "[GRAN_AZUL] No project loaded - cannot generate report\n";
+            LOG_ERROR("GRAN_AZUL", "No project loaded - cannot generate report");
             return;
         }
         
         std::filesystem::path project_dir = std::filesystem::path(project_manager_->get_current_project_path()).parent_path();
-        gran_azul::ReportGenerator generator(project_dir.string());
         
         // Analyze project structure
         const auto& project_config = project_manager_->get_current_project();
@@ -519,45 +695,58 @@ private:
         project_summary.name = project_config.name;
         project_summary.project_file = project_manager_->get_current_project_path();
         
-        // Generate report
-        gran_azul::ComprehensiveReport report = generator.generate_report(project_summary);
-        
-        // Add cppcheck results if available
-        std::filesystem::path cppcheck_output = project_dir / "cppcheck_analysis.xml";
-        if (std::filesystem::exists(cppcheck_output)) {
-            generator.add_cppcheck_results(report, cppcheck_output.string());
-        }
+        // Cppcheck results are included if available
+        std::string cppcheck_output = (project_dir / "cppcheck_analysis.xml").string();
         
         // Export reports with user-selected paths
         std::string json_path = select_json_report_save_path();
         if (json_path.empty()) {
-            std::cout << "[GRAN_AZUL] JSON report export cancelled\n";
+            LOG_INFO("GRAN_AZUL", "JSON report export cancelled");
             return;
         }
         
         std::string html_path = select_html_report_save_path();
         if (html_path.empty()) {
-            std::cout << "[GRAN_AZUL] HTML report export cancelled\n";
+            LOG_INFO("GRAN_AZUL", "HTML report export cancelled");
             return;
         }
         
-        bool json_success = generator.export_json_report(report, json_path);
-        bool html_success = generator.export_html_report(report, html_path);
+        // The SARIF log goes next to the JSON report, for code scanning services
+        std::string sarif_path = std::filesystem::path(json_path).replace_extension(".sarif").string();
         
-        if (json_success && html_success) {
-            std::cout << "[GRAN_AZUL] Comprehensive reports generated successfully\n";
-            std::cout << "[GRAN_AZUL] JSON: " << json_path << "\n";
-            std::cout << "[GRAN_AZUL] HTML: " << html_path << "\n";
-        } else {
-            std::cout << "[GRAN_AZUL] Some reports failed to generate\n";
-        }
+        // Reports are streamed from the cppcheck output on the writer's thread, so neither the UI
+        // nor memory use depend on the number of issues
+        auto shared_summary = std::make_shared<const gran_azul::ProjectSummary>(std::move(project_summary));
+        
+        // Run summaries come from the history catalog; no past run is loaded
+        auto history = std::make_shared<const std::vector<wip::analysis::HistoryRun>>(
+            history_store_ ? history_store_->get_runs(REPORT_HISTORY_RUNS) : std::vector<wip::analysis::HistoryRun>{});
+        
+        auto log_result = [](const std::filesystem::path& path, bool success) {
+            if (success) {
+                LOG_INFO("GRAN_AZUL", "Report saved: ", path.string());
+            } else {
+                LOG_ERROR("GRAN_AZUL", "Failed to save report: ", path.string());
+            }
+        };
+        
+        auto stream_report = [this, shared_summary, history, cppcheck_output, log_result](const std::string& path,
+                                                                                          wip::analysis::ReportFormat format) {
+            report_writer_.write_stream(path, [shared_summary, history, cppcheck_output, format](std::ostream& out) {
+                gran_azul::ReportGenerator::write_report(out, format, *shared_summary, cppcheck_output, *history);
+            }, log_result);
+        };
+        stream_report(json_path, wip::analysis::ReportFormat::Json);
+        stream_report(html_path, wip::analysis::ReportFormat::Html);
+        stream_report(sarif_path, wip::analysis::ReportFormat::Sarif);
+        
+        LOG_INFO("GRAN_AZUL", "Saving comprehensive reports in the background");
     }
     
     // REMOVED: Legacy parse_and_display_analysis_results method
     
     void open_file_at_location(const std::string& file_path, int line, int column) {
-        std::cout << "[GRAN_AZUL] Request to open file: " << file_path 
-                  << " at line " << line << ", column " << column << "\n";
+        LOG_INFO("GRAN_AZUL", "Request to open file: ", file_path, " at line ", line, ", column ", column);
         
         // For now, just log the request. In a full IDE, this would:
         // 1. Open the file in an editor
@@ -570,7 +759,7 @@ private:
     }
     
     void run_cppcheck_version() {
-        std::cout << "[GRAN_AZUL] Running cppcheck --version\n";
+        LOG_INFO("GRAN_AZUL", "Running cppcheck --version");
         
         if (!ProcessExecutor::command_exists("cppcheck")) {
             ProcessResult error_result{127, "", "cppcheck command not found", std::chrono::milliseconds(0), false};
@@ -583,72 +772,11 @@ private:
         
         log_panel_->add_log_entry("cppcheck --version", result);
         
-        std::cout << "[GRAN_AZUL] cppcheck --version completed with exit code: " << result.exit_code << "\n";
+        LOG_INFO("GRAN_AZUL", "cppcheck --version completed with exit code: ", result.exit_code);
     }
     
     // REMOVED: Legacy create_build_directory method
     
-    // Helper function to convert analysis library result to widget result
-    gran_azul::widgets::AnalysisResult convert_analysis_result(const wip::analysis::AnalysisResult& lib_result) {
-        gran_azul::widgets::AnalysisResult widget_result;
-        
-        // Copy basic fields
-        widget_result.analysis_successful = lib_result.success;
-        widget_result.error_message = lib_result.error_message;
-        widget_result.source_path = ""; // Not directly available in lib result
-        widget_result.total_files_analyzed = static_cast<int>(lib_result.files_analyzed);
-        
-        // Set timestamp (convert from time_point to string)
-        auto time_t = std::chrono::system_clock::to_time_t(lib_result.timestamp);
-        widget_result.timestamp = std::asctime(std::localtime(&time_t));
-        
-        // Convert issues
-        for (const auto& lib_issue : lib_result.issues) {
-            gran_azul::widgets::AnalysisIssue widget_issue;
-            
-            widget_issue.file = lib_issue.file_path;
-            widget_issue.line = lib_issue.line_number;
-            widget_issue.column = lib_issue.column_number;
-            widget_issue.id = lib_issue.rule_id;
-            widget_issue.message = lib_issue.message;
-            widget_issue.cwe = 0; // Not available in lib result
-            widget_issue.false_positive = false;
-            
-            // Convert severity (different enum values)
-            switch (lib_issue.severity) {
-                case wip::analysis::IssueSeverity::Error:
-                case wip::analysis::IssueSeverity::Critical:
-                    widget_issue.severity = gran_azul::widgets::IssueSeverity::ERROR;
-                    break;
-                case wip::analysis::IssueSeverity::Warning:
-                    widget_issue.severity = gran_azul::widgets::IssueSeverity::WARNING;
-                    break;
-                case wip::analysis::IssueSeverity::Info:
-                default:
-                    // Map based on category for better classification
-                    switch (lib_issue.category) {
-                        case wip::analysis::IssueCategory::Performance:
-                            widget_issue.severity = gran_azul::widgets::IssueSeverity::PERFORMANCE;
-                            break;
-                        case wip::analysis::IssueCategory::Style:
-                            widget_issue.severity = gran_azul::widgets::IssueSeverity::STYLE;
-                            break;
-                        case wip::analysis::IssueCategory::Portability:
-                            widget_issue.severity = gran_azul::widgets::IssueSeverity::PORTABILITY;
-                            break;
-                        default:
-                            widget_issue.severity = gran_azul::widgets::IssueSeverity::INFORMATION;
-                            break;
-                    }
-                    break;
-            }
-            
-            widget_result.issues.push_back(widget_issue);
-        }
-        
-        return widget_result;
-    }
-    
     // Function to merge multiple analysis results into one
     gran_azul::widgets::AnalysisResult merge_analysis_results(const std::vector<wip::analysis::AnalysisResult>& results) {
         gran_azul::widgets::AnalysisResult merged_result;
@@ -664,6 +792,13 @@ private:
         merged_result.total_files_analyzed = 0;
         std::vector<std::string> error_messages;
         
+        size_t issue_count = 0;
+        for (const auto& result : results) {
+            issue_count += result.issues.size();
+        }
+        merged_result.issues.reserve(issue_count);
+        merged_result.false_positives.reserve(issue_count);
+        
         // Get latest timestamp
         auto latest_timestamp = std::chrono::system_clock::time_point::min();
         
@@ -682,48 +817,9 @@ private:
                 latest_timestamp = result.timestamp;
             }
             
-            // Convert and merge issues
-            for (const auto& lib_issue : result.issues) {
-                gran_azul::widgets::AnalysisIssue widget_issue;
-                
-                widget_issue.file = lib_issue.file_path;
-                widget_issue.line = lib_issue.line_number;
-                widget_issue.column = lib_issue.column_number;
-                widget_issue.id = lib_issue.rule_id;
-                widget_issue.message = lib_issue.message;
-                widget_issue.cwe = 0; // Not available in lib result
-                widget_issue.false_positive = false;
-                
-                // Convert severity (different enum values)
-                switch (lib_issue.severity) {
-                    case wip::analysis::IssueSeverity::Error:
-                    case wip::analysis::IssueSeverity::Critical:
-                        widget_issue.severity = gran_azul::widgets::IssueSeverity::ERROR;
-                        break;
-                    case wip::analysis::IssueSeverity::Warning:
-                        widget_issue.severity = gran_azul::widgets::IssueSeverity::WARNING;
-                        break;
-                    case wip::analysis::IssueSeverity::Info:
-                    default:
-                        // Map based on category for better classification
-                        switch (lib_issue.category) {
-                            case wip::analysis::IssueCategory::Performance:
-                                widget_issue.severity = gran_azul::widgets::IssueSeverity::PERFORMANCE;
-                                break;
-                            case wip::analysis::IssueCategory::Style:
-                                widget_issue.severity = gran_azul::widgets::IssueSeverity::STYLE;
-                                break;
-                            case wip::analysis::IssueCategory::Portability:
-                                widget_issue.severity = gran_azul::widgets::IssueSeverity::PORTABILITY;
-                                break;
-                            default:
-                                widget_issue.severity = gran_azul::widgets::IssueSeverity::INFORMATION;
-                                break;
-                        }
-                        break;
-                }
-                
-                merged_result.issues.push_back(widget_issue);
+            // Merge issues; the store interns their strings, so repeated paths and rules are kept once
+            for (const auto& issue : result.issues) {
+                merged_result.add_issue(issue);
             }
         }
         
@@ -743,18 +839,90 @@ private:
         return merged_result;
     }
     
-    void run_analysis_with_library(const std::vector<std::string>& tool_names, const wip::analysis::AnalysisRequest& request) {
-        std::cout << "[GRAN_AZUL] Starting analysis with library for " << tool_names.size() << " tools\n";
-        std::cout << "[GRAN_AZUL] Tools: ";
-        for (const auto& tool : tool_names) {
-            std::cout << tool << " ";
+    // Run the tools enabled in the project configuration on its source path
+    void run_project_analysis() {
+        auto analysis = gran_azul::make_project_analysis(project_manager_->get_current_project());
+        if (!analysis.tool_names.empty()) {
+            run_analysis_with_library(analysis.tool_names, analysis.request);
+        } else {
+            LOG_INFO("GRAN_AZUL", "No analysis tools enabled in project configuration");
+        }
+    }
+    
+    // Watch the project's source path, restarting the watcher when the path changed
+    void watch_project_sources() {
+        if (!project_manager_->has_project()) {
+            stop_source_watcher();
+            return;
+        }
+        
+        const std::string source_path = project_manager_->get_current_project().get_full_source_path();
+        if (source_watcher_ && source_path == watched_source_path_) {
+            return;
+        }
+        stop_source_watcher();
+        if (source_path.empty()) {
+            return;
         }
-        std::cout << "\n";
-        std::cout << "[GRAN_AZUL] Source path: " << request.source_path << "\n";
-        std::cout << "[GRAN_AZUL] Output file: " << request.output_file << "\n";
+        
+        wip::utils::file::FileWatcherOptions options;
+        options.filter.extensions = {".c", ".cc", ".cpp", ".cxx", ".m", ".mm", ".h", ".hh", ".hpp", ".hxx", ".inl"};
+        options.filter.prune_directories = {".*", "build", "_build", "CMakeFiles"};
+        
+        // Batches are published from the watcher thread and handled on the UI executor
+        source_watcher_ = std::make_unique<wip::utils::file::FileWatcher>(
+            [this](const std::vector<wip::utils::file::FileChange>& changes) {
+                if (event_dispatcher_) {
+                    event_dispatcher_->dispatch(gran_azul::utils::SourceFilesChangedEvent(changes));
+                }
+            }, options);
+        
+        if (source_watcher_->watch(source_path)) {
+            watched_source_path_ = source_path;
+            LOG_INFO("GRAN_AZUL", "Watching sources in ", source_path, " (", source_watcher_->backend_name(), ")");
+        } else {
+            LOG_ERROR("GRAN_AZUL", "Cannot watch sources in ", source_path);
+            source_watcher_.reset();
+        }
+    }
+    
+    void stop_source_watcher() {
+        source_watcher_.reset();
+        watched_source_path_.clear();
+        reanalysis_pending_ = false;
+    }
+    
+    void handle_source_changes(const gran_azul::utils::SourceFilesChangedEvent& event) {
+        LOG_INFO("GRAN_AZUL", event.changes().size(), " source file(s) changed");
+        
+        // Edits reaching no analyzed unit, like a header nothing includes, need no rerun;
+        // created and removed files can add or drop units, so they always do
+        bool reaches_units = !include_graph_ || include_graph_->get_units().empty();
+        if (include_graph_) {
+            std::vector<std::string> paths;
+            paths.reserve(event.changes().size());
+            for (const auto& change : event.changes()) {
+                paths.push_back(change.path.string());
+                reaches_units |= change.type != wip::utils::file::FileChangeType::Modified;
+            }
+            auto affected = include_graph_->update(paths);
+            LOG_INFO("GRAN_AZUL", affected.size(), " translation unit(s) affected");
+            reaches_units |= !affected.empty();
+        }
+        
+        if (reanalyze_on_save_ && reaches_units && project_manager_->has_project()) {
+            reanalysis_pending_ = true;
+        }
+    }
+    
+    void run_analysis_with_library(const std::vector<std::string>& tool_names, const wip::analysis::AnalysisRequest& request) {
+        LOG_INFO("GRAN_AZUL", "Starting analysis with library for ", tool_names.size(), " tools");
+        LOG_INFO("GRAN_AZUL", "Tools: ", wip::utils::string::join(tool_names, " "));
+        LOG_INFO("GRAN_AZUL", "Source path: ", request.source_path);
+        LOG_INFO("GRAN_AZUL", "Output file: ", request.output_file);
         
         if (!project_manager_->has_project()) {
-            std::cout << "[GRAN_AZUL] No project loaded - cannot run analysis\n";
+            LOG_ERROR("GRAN_AZUL", "No project loaded - cannot run analysis");
             return;
         }
         
@@ -767,20 +935,32 @@ private:
         try {
             // Get project directory
             std::filesystem::path project_dir = std::filesystem::path(project_manager_->get_current_project_path()).parent_path();
-            std::cout << "[GRAN_AZUL] Project directory: " << project_dir << "\n";
+            LOG_INFO("GRAN_AZUL", "Project directory: ", project_dir);
             
             // Create analysis engine
             current_analysis_engine_ = wip::analysis::AnalysisEngineFactory::create_engine_with_tools(tool_names);
             if (!current_analysis_engine_) {
-                std::cout << "[GRAN_AZUL] Failed to create analysis engine\n";
+                LOG_ERROR("GRAN_AZUL", "Failed to create analysis engine");
                 gran_azul::widgets::AnalysisResult error_result;
                 error_result.analysis_successful = false;
                 error_result.error_message = "Failed to create analysis engine";
-                analysis_panel_->set_analysis_result(error_result);
+                analysis_panel_->set_analysis_result(std::move(error_result));
                 return;
             }
             
-            std::cout << "[GRAN_AZUL] Analysis engine created with " << current_analysis_engine_->get_registered_tools().size() << " tools\n";
+            LOG_INFO("GRAN_AZUL", "Analysis engine created with ", current_analysis_engine_->get_registered_tools().size(), " tools");
+            
+            // Incremental analysis: only changed files are sent to the tools
+            auto analysis_cache = std::make_shared<wip::analysis::AnalysisCache>((project_dir / ".gran_azul_cache.json").string());
+            analysis_cache->load();
+            if (!include_graph_ || !include_graph_->matches(request)) {
+                include_graph_ = std::make_shared<wip::analysis::IncludeGraph>(request);
+            }
+            analysis_cache->set_include_graph(include_graph_);
+            current_analysis_engine_->set_cache(analysis_cache);
+            gran_azul::configure_project_tools(*current_analysis_engine_, project_dir);
+            
+            open_history_store(project_dir / ".gran_azul_history");
             
             // Show progress dialog
             std::string tools_str = "";
@@ -799,7 +979,7 @@ private:
             });
             
             // Force render one frame to ensure modal appears before starting analysis
-            std::cout << "[GRAN_AZUL] Modal shown, will start analysis after UI update...\n";
+            LOG_DEBUG("GRAN_AZUL", "Modal shown, will start analysis after UI update...");
             
             // Store analysis parameters to start in next update cycle
             pending_analysis_tool_names_ = tool_names;
@@ -808,89 +988,109 @@ private:
             
             return; // Exit here, analysis will start in next update cycle
         } catch (const std::exception& e) {
-            std::cout << "[GRAN_AZUL] Exception starting analysis: " << e.what() << "\n";
+            LOG_ERROR("GRAN_AZUL", "Exception starting analysis: ", e.what());
             gran_azul::widgets::AnalysisResult error_result;
             error_result.analysis_successful = false;
             error_result.error_message = e.what();
-            analysis_panel_->set_analysis_result(error_result);
+            analysis_panel_->set_analysis_result(std::move(error_result));
         }
     }
     
+    // Open the project's history store unless it is already open
+    void open_history_store(const std::filesystem::path& directory) {
+        if (history_store_ && history_store_->get_directory() == directory.string()) {
+            return;
+        }
+        try {
+            history_store_ = std::make_shared<wip::analysis::HistoryStore>(directory.string());
+            LOG_INFO("GRAN_AZUL", "Analysis history: ", history_store_->get_run_count(), " runs in ", directory);
+        } catch (const std::exception& e) {
+            LOG_WARNING("GRAN_AZUL", "Analysis history disabled: ", e.what());
+            history_store_.reset();
+        }
+        history_panel_->set_history(history_store_);
+    }
+    
     // Helper method to actually start the analysis (called from update loop)
     void start_pending_analysis() {
         if (!start_analysis_next_frame_) return;
         
         start_analysis_next_frame_ = false;
-        std::cout << "[GRAN_AZUL] Starting delayed analysis with " << pending_analysis_tool_names_.size() << " tools\n";
+        LOG_INFO("GRAN_AZUL", "Starting delayed analysis with ", pending_analysis_tool_names_.size(), " tools");
+        
+        // Workers only publish into the channel, never waiting on the UI; a newer progress replaces an undrained one
+        progress_channel_ = std::make_shared<wip::analysis::ProgressChannel>(pending_analysis_tool_names_);
+        reported_dropped_lines_ = 0;
+        auto progress_callback = [channel = progress_channel_](const std::string& tool_name,
+                                                               const wip::analysis::AnalysisProgress& progress) {
+            channel->publish_progress(tool_name, progress);
+        };
         
-        // Run analysis asynchronously with progress callbacks
-        auto progress_callback = [this](const std::string& tool_name, const wip::analysis::AnalysisProgress& progress) {
-            // Rate limit progress updates to prevent UI flooding
-            auto now = std::chrono::steady_clock::now();
-            bool should_update = false;
+        // The worker filters and sorts the merged result the way the panel currently shows it
+        auto completion_callback = [this, history = history_store_, options = analysis_panel_->get_view_options(),
+                                    false_positives_file = gran_azul::widgets::AnalysisResultPanel::get_false_positives_file_path()](
+                                       const std::vector<wip::analysis::AnalysisResult>& results) {
+            LOG_INFO("GRAN_AZUL", "Analysis completed with ", results.size(), " results");
             
-            {
-                std::lock_guard<std::mutex> lock(progress_data_mutex_);
-                
-                // Only update if enough time has passed since last update
-                if (now - last_progress_update_ >= progress_update_interval_) {
-                    pending_progress_.tool_name = tool_name;
-                    pending_progress_.progress_ratio = static_cast<float>(progress.get_progress_ratio());
-                    pending_progress_.status_message = progress.status_message;
-                    if (!progress.current_file.empty()) {
-                        pending_progress_.status_message += " (" + progress.current_file + ")";
-                        pending_progress_.current_file = progress.current_file;
-                    } else {
-                        pending_progress_.current_file.clear();
+            // Record the run on this worker thread too; the panel rereads the catalog on the UI thread
+            if (history && !results.empty()) {
+                try {
+                    uint64_t run_id = history->append_run(results);
+                    LOG_DEBUG("GRAN_AZUL", "Recorded analysis run ", run_id, " in history");
+                    if (ui_executor_) {
+                        ui_executor_->post([this]() { history_panel_->refresh(); });
                     }
-                    
-                    last_progress_update_ = now;
-                    should_update = true;
+                } catch (const std::exception& e) {
+                    LOG_WARNING("GRAN_AZUL", "Failed to record analysis history: ", e.what());
                 }
             }
             
-            // Only signal update if we actually updated the data
-            if (should_update) {
-                progress_updated_.store(true);
-            }
+            // Merge and index on this worker thread, display on the UI thread
+            auto prepared = gran_azul::widgets::prepare_analysis_result(merge_analysis_results(results), options,
+                                                                        false_positives_file);
+            LOG_INFO("GRAN_AZUL", "Merged result with ", prepared->result.issues.size(), " total issues");
+            event_dispatcher_->dispatch(gran_azul::utils::AnalysisCompletedEvent(std::move(prepared)));
         };
         
-        auto completion_callback = [this](const std::vector<wip::analysis::AnalysisResult>& results) {
-            std::cout << "[GRAN_AZUL] Analysis completed with " << results.size() << " results\n";
-            
-            // Store merged results for main thread processing
-            {
-                std::lock_guard<std::mutex> lock(completion_data_mutex_);
-                pending_analysis_result_ = merge_analysis_results(results);
-                
-                std::cout << "[GRAN_AZUL] Merged result with " << pending_analysis_result_.issues.size() << " total issues\n";
-            }
-            
-            // Signal completion
-            analysis_completed_.store(true);
+        auto output_callback = [channel = progress_channel_](const std::string& tool_name, const std::string& output_line) {
+            channel->publish_line(tool_name, output_line);
         };
         
-        auto output_callback = [this](const std::string& tool_name, const std::string& output_line) {
-            std::cout << "[GRAN_AZUL] output_callback received from " << tool_name << ": '" << output_line << "'" << std::endl;
-            progress_dialog_->add_output_line("[" + tool_name + "] " + output_line);
+        auto issue_callback = [this](const std::string& tool_name, const std::vector<wip::analysis::AnalysisIssue>& issues) {
+            event_dispatcher_->dispatch(gran_azul::utils::AnalysisIssuesEvent(tool_name, issues));
         };
         
+        // Results stream in as the tools find them
+        analysis_panel_->clear_results();
+        
+        // Tool output streams into one log entry for the whole run
+        std::string log_command = "analysis";
+        for (const auto& tool_name : pending_analysis_tool_names_) {
+            log_command += " " + tool_name;
+        }
+        log_command += " " + pending_analysis_request_.source_path;
+        analysis_log_entry_ = log_panel_->begin_log_entry(log_command);
+        analysis_log_started_ = std::chrono::steady_clock::now();
+        
         // Start async analysis with callbacks
         try {
-            current_analysis_future_ = current_analysis_engine_->analyze_async(pending_analysis_tool_names_, pending_analysis_request_, progress_callback, output_callback, completion_callback);
+            current_analysis_future_ = current_analysis_engine_->analyze_async(pending_analysis_tool_names_, pending_analysis_request_, progress_callback, output_callback, completion_callback, issue_callback);
             
             // Future is now stored and will keep the analysis alive
-            std::cout << "[GRAN_AZUL] Analysis future created and stored, analysis running in background\n";
+            LOG_DEBUG("GRAN_AZUL", "Analysis future created and stored, analysis running in background");
             
         } catch (const std::exception& e) {
-            std::cout << "[GRAN_AZUL] Failed to start delayed async analysis: " << e.what() << "\n";
+            LOG_ERROR("GRAN_AZUL", "Failed to start delayed async analysis: ", e.what());
             
             // Store error result
             {
+                gran_azul::widgets::AnalysisResult error_result;
+                error_result.analysis_successful = false;
+                error_result.error_message = e.what();
+                auto prepared = gran_azul::widgets::prepare_analysis_result(std::move(error_result),
+                                                                            analysis_panel_->get_view_options(), "");
                 std::lock_guard<std::mutex> lock(completion_data_mutex_);
-                pending_analysis_result_ = gran_azul::widgets::AnalysisResult{};
-                pending_analysis_result_.analysis_successful = false;
-                pending_analysis_result_.error_message = e.what();
+                pending_analysis_result_ = std::move(prepared);
             }
             
             analysis_completed_.store(true);
@@ -898,7 +1098,7 @@ private:
     }
     
     void check_tool_version(const std::string& tool_name) {
-        std::cout << "[GRAN_AZUL] Checking version for: " << tool_name << "\n";
+        LOG_DEBUG("GRAN_AZUL", "Checking version for: ", tool_name);
         
         try {
             // Create analysis engine
@@ -924,10 +1124,10 @@ private:
             ProcessResult result{0, version, "", std::chrono::milliseconds(100), true};
             log_panel_->add_log_entry(tool_name + " --version", result);
             
-            std::cout << "[GRAN_AZUL] " << tool_name << " version: " << version << "\n";
+            LOG_INFO("GRAN_AZUL", tool_name, " version: ", version);
             
         } catch (const std::exception& e) {
-            std::cout << "[GRAN_AZUL] Error checking " << tool_name << " version: " << e.what() << "\n";
+            LOG_ERROR("GRAN_AZUL", "Error checking ", tool_name, " version: ", e.what());
             ProcessResult error_result{1, "", e.what(), std::chrono::milliseconds(0), false};
             log_panel_->add_log_entry(tool_name + " version check", error_result);
         }
@@ -1036,7 +1236,7 @@ private:
     
     // Project management methods
     void create_new_project() {
-        std::cout << "[GRAN_AZUL] Create new project requested\n";
+        LOG_DEBUG("GRAN_AZUL", "Create new project requested");
         
         nfdchar_t *savePath;
         nfdfilteritem_t filterItem[1] = { { "Gran Azul Projects", "granazul" } };
@@ -1047,7 +1247,7 @@ private:
             std::filesystem::path project_path(savePath);
             std::string project_dir = project_path.parent_path().string();
             
-            std::cout << "[GRAN_AZUL] Creating project in directory: " << project_dir << "\n";
+            LOG_INFO("GRAN_AZUL", "Creating project in directory: ", project_dir);
             
             // Create project with selected directory as root
             if (project_manager_->create_new_project("New Project", project_dir)) {
@@ -1055,26 +1255,26 @@ private:
                 
                 // Save the project with the selected filename
                 if (project_manager_->save_project_as(savePath)) {
-                    std::cout << "[GRAN_AZUL] New project created and saved: " << savePath << "\n";
+                    LOG_INFO("GRAN_AZUL", "New project created and saved: ", savePath);
                 } else {
-                    std::cout << "[GRAN_AZUL] Project created but failed to save\n";
+                    LOG_ERROR("GRAN_AZUL", "Project created but failed to save");
                 }
             } else {
-                std::cout << "[GRAN_AZUL] Failed to create project\n";
+                LOG_ERROR("GRAN_AZUL", "Failed to create project");
             }
             
             // Remember to free the path memory!
             NFD_FreePath(savePath);
             
         } else if (result == NFD_CANCEL) {
-            std::cout << "[GRAN_AZUL] Project creation cancelled\n";
+            LOG_INFO("GRAN_AZUL", "Project creation cancelled");
         } else {
-            std::cout << "[GRAN_AZUL] Project creation error: " << NFD_GetError() << "\n";
+            LOG_ERROR("GRAN_AZUL", "Project creation error: ", NFD_GetError());
         }
     }
     
     void open_project() {
-        std::cout << "[GRAN_AZUL] Open project requested\n";
+        LOG_DEBUG("GRAN_AZUL", "Open project requested");
         
         nfdchar_t *outPath;
         nfdfilteritem_t filterItem[1] = { { "Gran Azul Projects", "granazul" } };
@@ -1083,22 +1283,24 @@ private:
         
         if (result == NFD_OKAY) {
             std::string file_path(outPath);
-            std::cout << "[GRAN_AZUL] Selected project file: " << file_path << "\n";
+            LOG_INFO("GRAN_AZUL", "Selected project file: ", file_path);
             
-            if (project_manager_->load_project(file_path)) {
-                update_ui_from_project();
-                std::cout << "[GRAN_AZUL] Project loaded successfully\n";
-            } else {
-                std::cout << "[GRAN_AZUL] Failed to load project file\n";
-            }
+            load_project_file(file_path, [this](bool loaded) {
+                if (loaded) {
+                    update_ui_from_project();
+                    LOG_INFO("GRAN_AZUL", "Project loaded successfully");
+                } else {
+                    LOG_ERROR("GRAN_AZUL", "Failed to load project file");
+                }
+            });
             
             // Remember to free the path memory!
             NFD_FreePath(outPath);
             
         } else if (result == NFD_CANCEL) {
-            std::cout << "[GRAN_AZUL] Project opening cancelled\n";
+            LOG_INFO("GRAN_AZUL", "Project opening cancelled");
         } else {
-            std::cout << "[GRAN_AZUL] Project opening error: " << NFD_GetError() << "\n";
+            LOG_ERROR("GRAN_AZUL", "Project opening error: ", NFD_GetError());
         }
     }
     
@@ -1130,39 +1332,40 @@ private:
             if (result == NFD_OKAY) {
                 std::string file_path(savePath);
                 
-                std::cout << "[GRAN_AZUL] Saving project to: " << file_path << "\n";
+                LOG_INFO("GRAN_AZUL", "Saving project to: ", file_path);
                 
                 if (project_manager_->save_project_as(file_path)) {
-                    std::cout << "[GRAN_AZUL] Project saved successfully\n";
+                    LOG_INFO("GRAN_AZUL", "Project saved successfully");
                 } else {
-                    std::cout << "[GRAN_AZUL] Failed to save project\n";
+                    LOG_ERROR("GRAN_AZUL", "Failed to save project");
                 }
                 
                 // Remember to free the path memory!
                 NFD_FreePath(savePath);
                 
             } else if (result == NFD_CANCEL) {
-                std::cout << "[GRAN_AZUL] Save project cancelled\n";
+                LOG_INFO("GRAN_AZUL", "Save project cancelled");
             } else {
-                std::cout << "[GRAN_AZUL] Save project error: " << NFD_GetError() << "\n";
+                LOG_ERROR("GRAN_AZUL", "Save project error: ", NFD_GetError());
             }
         }
     }
     
     void close_project() {
+        stop_source_watcher();
         project_manager_->close_project();
         project_loaded_ = false;
         // Reset UI to defaults
-        std::cout << "[GRAN_AZUL] Project closed\n";
+        LOG_INFO("GRAN_AZUL", "Project closed");
     }
     
     // New methods for startup modal
     void create_new_project(const std::string& project_name, 
                            const std::string& project_path,
                            const std::string& source_path) {
-        std::cout << "[GRAN_AZUL] Creating new project: " << project_name << "\n";
-        std::cout << "[GRAN_AZUL] Project path: " << project_path << "\n";
-        std::cout << "[GRAN_AZUL] Source path: " << source_path << "\n";
+        LOG_INFO("GRAN_AZUL", "Creating new project: ", project_name);
+        LOG_INFO("GRAN_AZUL", "Project path: ", project_path);
+        LOG_INFO("GRAN_AZUL", "Source path: ", source_path);
         
         try {
             // Create the project using the project manager
@@ -1183,37 +1386,47 @@ private:
                 if (project_manager_->save_project_as(project_file.string())) {
                     project_loaded_ = true;
                     update_ui_from_project();
-                    std::cout << "[GRAN_AZUL] New project created successfully: " << project_file << "\n";
+                    LOG_INFO("GRAN_AZUL", "New project created successfully: ", project_file);
                 } else {
                     startup_modal_->show_error("Failed to save project file");
-                    std::cout << "[GRAN_AZUL] Failed to save project file\n";
+                    LOG_ERROR("GRAN_AZUL", "Failed to save project file");
                 }
             } else {
                 startup_modal_->show_error("Failed to create project");
-                std::cout << "[GRAN_AZUL] Failed to create project\n";
+                LOG_ERROR("GRAN_AZUL", "Failed to create project");
             }
         } catch (const std::exception& e) {
             startup_modal_->show_error("Error creating project: " + std::string(e.what()));
-            std::cout << "[GRAN_AZUL] Exception creating project: " << e.what() << "\n";
+            LOG_ERROR("GRAN_AZUL", "Exception creating project: ", e.what());
         }
     }
     
     void load_existing_project(const std::string& project_file) {
-        std::cout << "[GRAN_AZUL] Loading existing project: " << project_file << "\n";
+        LOG_INFO("GRAN_AZUL", "Loading existing project: ", project_file);
         
-        try {
-            if (project_manager_->load_project(project_file)) {
+        // The modal keeps rendering while the project loads
+        startup_modal_->set_loading(project_file);
+        load_project_file(project_file, [this](bool loaded) {
+            startup_modal_->set_loading("");
+            if (loaded) {
                 project_loaded_ = true;
+                startup_modal_->close();
                 update_ui_from_project();
-                std::cout << "[GRAN_AZUL] Project loaded successfully\n";
+                LOG_INFO("GRAN_AZUL", "Project loaded successfully");
             } else {
                 startup_modal_->show_error("Failed to load project file. The file may be corrupted or invalid.");
-                std::cout << "[GRAN_AZUL] Failed to load project file\n";
+                LOG_ERROR("GRAN_AZUL", "Failed to load project file");
             }
-        } catch (const std::exception& e) {
-            startup_modal_->show_error("Error loading project: " + std::string(e.what()));
-            std::cout << "[GRAN_AZUL] Exception loading project: " << e.what() << "\n";
+        });
+    }
+    
+    // Loads on a background thread once the UI executor is connected, in place before that
+    void load_project_file(const std::string& project_file, std::function<void(bool loaded)> on_done) {
+        if (ui_executor_) {
+            project_manager_->load_project_async(project_file, *ui_executor_, std::move(on_done));
+            return;
         }
+        on_done(project_manager_->load_project(project_file));
     }
     
     void update_ui_from_project() {
@@ -1224,9 +1437,11 @@ private:
             analysis_manager_->load_from_project_config(project);
             analysis_manager_->set_project_base_path(std::filesystem::path(project_manager_->get_current_project_path()).parent_path().string());
             analysis_manager_->set_visible(true); // Show analysis manager when project is loaded
+            open_history_store(std::filesystem::path(project_manager_->get_current_project_path()).parent_path() / ".gran_azul_history");
             
-            std::cout << "[GRAN_AZUL] UI updated from project: " << project.name << std::endl;
+            LOG_INFO("GRAN_AZUL", "UI updated from project: ", project.name);
         }
+        watch_project_sources();
     }
     
     void sync_project_from_ui() {
@@ -1236,12 +1451,12 @@ private:
             // Update from analysis manager widget
             analysis_manager_->save_to_project_config(project);
             
-            std::cout << "[GRAN_AZUL] Project updated from UI" << std::endl;
+            LOG_INFO("GRAN_AZUL", "Project updated from UI");
         }
     }
     
     std::string select_directory_dialog() {
-        std::cout << "[GRAN_AZUL] Directory selection dialog requested\n";
+        LOG_DEBUG("GRAN_AZUL", "Directory selection dialog requested");
         
         nfdchar_t *outPath;
         nfdfilteritem_t filterItem[1] = { { "Directory", "" } };
@@ -1251,23 +1466,23 @@ private:
         if (result == NFD_OKAY) {
             std::string directory_path(outPath);
             
-            std::cout << "[GRAN_AZUL] Selected directory: " << directory_path << "\n";
+            LOG_INFO("GRAN_AZUL", "Selected directory: ", directory_path);
             
             // Remember to free the path memory!
             NFD_FreePath(outPath);
             
             return directory_path;
         } else if (result == NFD_CANCEL) {
-            std::cout << "[GRAN_AZUL] Directory selection cancelled\n";
+            LOG_INFO("GRAN_AZUL", "Directory selection cancelled");
         } else {
-            std::cout << "[GRAN_AZUL] Directory selection error: " << NFD_GetError() << "\n";
+            LOG_ERROR("GRAN_AZUL", "Directory selection error: ", NFD_GetError());
         }
         
         return "";
     }
     
     std::string select_json_report_save_path() {
-        std::cout << "[GRAN_AZUL] JSON report save dialog requested\n";
+        LOG_DEBUG("GRAN_AZUL", "JSON report save dialog requested");
         
         nfdchar_t *savePath;
         nfdfilteritem_t filterItem[1] = { { "JSON Files", "json" } };
@@ -1276,20 +1491,20 @@ private:
         
         if (result == NFD_OKAY) {
             std::string file_path(savePath);
-            std::cout << "[GRAN_AZUL] Selected JSON report path: " << file_path << "\n";
+            LOG_INFO("GRAN_AZUL", "Selected JSON report path: ", file_path);
             NFD_FreePath(savePath);
             return file_path;
         } else if (result == NFD_CANCEL) {
-            std::cout << "[GRAN_AZUL] JSON report save cancelled\n";
+            LOG_INFO("GRAN_AZUL", "JSON report save cancelled");
         } else {
-            std::cout << "[GRAN_AZUL] JSON report save error: " << NFD_GetError() << "\n";
+            LOG_ERROR("GRAN_AZUL", "JSON report save error: ", NFD_GetError());
         }
         
         return "";
     }
     
     std::string select_html_report_save_path() {
-        std::cout << "[GRAN_AZUL] HTML report save dialog requested\n";
+        LOG_DEBUG("GRAN_AZUL", "HTML report save dialog requested");
         
         nfdchar_t *savePath;
         nfdfilteritem_t filterItem[1] = { { "HTML Files", "html" } };
@@ -1298,20 +1513,20 @@ private:
         
         if (result == NFD_OKAY) {
             std::string file_path(savePath);
-            std::cout << "[GRAN_AZUL] Selected HTML report path: " << file_path << "\n";
+            LOG_INFO("GRAN_AZUL", "Selected HTML report path: ", file_path);
             NFD_FreePath(savePath);
             return file_path;
         } else if (result == NFD_CANCEL) {
-            std::cout << "[GRAN_AZUL] HTML report save cancelled\n";
+            LOG_INFO("GRAN_AZUL", "HTML report save cancelled");
         } else {
-            std::cout << "[GRAN_AZUL] HTML report save error: " << NFD_GetError() << "\n";
+            LOG_ERROR("GRAN_AZUL", "HTML report save error: ", NFD_GetError());
         }
         
         return "";
     }
     
     void select_source_directory() {
-        std::cout << "[GRAN_AZUL] Select source directory requested\n";
+        LOG_DEBUG("GRAN_AZUL", "Select source directory requested");
         
         nfdchar_t *outPath;
         nfdresult_t result = NFD_PickFolder(&outPath, nullptr);
@@ -1319,7 +1534,7 @@ private:
         if (result == NFD_OKAY) {
             std::string directory_path(outPath);
             
-            std::cout << "[GRAN_AZUL] Selected directory: " << directory_path << "\n";
+            LOG_INFO("GRAN_AZUL", "Selected directory: ", directory_path);
             
             // Update the project configuration with new source path
             if (project_manager_->has_project()) {
@@ -1328,19 +1543,20 @@ private:
                 
                 // Save the project configuration
                 sync_project_from_ui();
+                watch_project_sources();
                 
-                std::cout << "[GRAN_AZUL] Updated project source path to: " << directory_path << "\n";
+                LOG_INFO("GRAN_AZUL", "Updated project source path to: ", directory_path);
             } else {
-                std::cout << "[GRAN_AZUL] No project loaded - cannot save source path setting\n";
+                LOG_ERROR("GRAN_AZUL", "No project loaded - cannot save source path setting");
             }
             
             // Remember to free the path memory!
             NFD_FreePath(outPath);
             
         } else if (result == NFD_CANCEL) {
-            std::cout << "[GRAN_AZUL] Directory selection cancelled\n";
+            LOG_INFO("GRAN_AZUL", "Directory selection cancelled");
         } else {
-            std::cout << "[GRAN_AZUL] Directory selection error: " << NFD_GetError() << "\n";
+            LOG_ERROR("GRAN_AZUL", "Directory selection error: ", NFD_GetError());
         }
     }
 
@@ -1369,7 +1585,7 @@ private:
                 }
                 ImGui::Separator();
                 if (ImGui::MenuItem("Exit", "Alt+F4")) {
-                    std::cout << "[GRAN_AZUL] Exit requested\n";
+                    LOG_DEBUG("GRAN_AZUL", "Exit requested");
                 }
                 ImGui::EndMenu();
             }
@@ -1381,24 +1597,14 @@ private:
                 }
                 ImGui::Separator();
                 if (ImGui::MenuItem("Run Full Analysis", "F5", nullptr, has_project)) {
-                    // Run unified analysis with project configuration
-                    const auto& project_config = project_manager_->get_current_project();
-                    wip::analysis::AnalysisRequest request;
-                    request.source_path = project_config.analysis.source_path;
-                    request.output_file = "analysis_results.xml";
-                    
-                    std::vector<std::string> tool_names;
-                    if (project_config.analysis.enable_cppcheck) tool_names.push_back("cppcheck");
-                    if (project_config.analysis.enable_clang_tidy) tool_names.push_back("clang-tidy");
-                    
-                    if (!tool_names.empty()) {
-                        run_analysis_with_library(tool_names, request);
-                    } else {
-                        std::cout << "[GRAN_AZUL] No analysis tools enabled in project configuration\n";
-                    }
+                    run_project_analysis();
                 }
                 if (ImGui::MenuItem("Run Quick Scan", "Ctrl+F5", nullptr, has_project)) {
-                    std::cout << "[GRAN_AZUL] Quick scan requested\n";
+                    LOG_DEBUG("GRAN_AZUL", "Quick scan requested");
+                }
+                if (ImGui::MenuItem("Re-analyze on Save", nullptr, &reanalyze_on_save_, has_project)) {
+                    reanalysis_pending_ = false;
+                    LOG_INFO("GRAN_AZUL", "Re-analyze on save ", (reanalyze_on_save_ ? "enabled" : "disabled"));
                 }
                 ImGui::Separator();
                 if (ImGui::MenuItem("Select Source Directory", nullptr, nullptr, has_project)) {
@@ -1412,7 +1618,7 @@ private:
                 }
                 ImGui::Separator();
                 if (ImGui::MenuItem("Configure Rules", nullptr, nullptr, has_project)) {
-                    std::cout << "[GRAN_AZUL] Configure rules requested\n";
+                    LOG_DEBUG("GRAN_AZUL", "Configure rules requested");
                 }
                 ImGui::EndMenu();
             }
@@ -1432,15 +1638,31 @@ private:
                 if (ImGui::MenuItem("Analysis Manager", nullptr, &analysis_manager_visible)) {
                     analysis_manager_->set_visible(analysis_manager_visible);
                 }
+                
+                bool history_visible = history_panel_->is_visible();
+                if (ImGui::MenuItem("Analysis History", nullptr, &history_visible)) {
+                    history_panel_->set_visible(history_visible);
+                }
+                
+                ImGui::Separator();
+                bool event_statistics_visible = event_statistics_panel_->is_visible();
+                if (ImGui::MenuItem("Event Statistics", nullptr, &event_statistics_visible)) {
+                    event_statistics_panel_->set_visible(event_statistics_visible);
+                }
+                
+                bool profiler_visible = application_ && application_->is_profiler_overlay_visible();
+                if (ImGui::MenuItem("Profiler", "F12", &profiler_visible) && application_) {
+                    application_->set_profiler_overlay_visible(profiler_visible);
+                }
                 ImGui::EndMenu();
             }
             
             if (ImGui::BeginMenu("Help")) {
                 if (ImGui::MenuItem("About Gran Azul")) {
-                    std::cout << "[GRAN_AZUL] About requested\n";
+                    LOG_DEBUG("GRAN_AZUL", "About requested");
                 }
                 if (ImGui::MenuItem("Documentation", "F1")) {
-                    std::cout << "[GRAN_AZUL] Documentation requested\n";
+                    LOG_DEBUG("GRAN_AZUL", "Documentation requested");
                 }
                 ImGui::EndMenu();
             }
@@ -1461,12 +1683,22 @@ private:
     std::unique_ptr<GranAzulMainLayer> main_layer;
     
 public:
-    GranAzulApp() : Application("Gran Azul - Code Quality Analysis") {
-        std::cout << "[GRAN_AZUL] Application initialized\n";
+    static ApplicationConfig make_config() {
+        ApplicationConfig config;
+        config.name = "Gran Azul - Code Quality Analysis";
+        config.font_cache_directory = FontAtlasCache::default_directory("gran_azul").string();
+        return config;
+    }
+    
+    GranAzulApp() : Application(make_config()) {
+        LOG_INFO("GRAN_AZUL", "Application initialized");
         
         // Create the main window
         create_window(1200, 800, "Gran Azul - Code Quality Analysis");
         
+        // The UI is mostly static; redraw on input and analysis events only
+        set_on_demand_rendering(true);
+        
         // Create the layer but don't add it yet (ImGui context needed first)
         main_layer = std::make_unique<GranAzulMainLayer>();
     }
@@ -1475,14 +1707,18 @@ public:
         // Initialize ImGui first
         initialize_imgui();
         
+        // Analysis notifications and the debug panel use the application's dispatcher
+        main_layer->set_application(this);
+        main_layer->connect_events(get_event_dispatcher(), get_ui_executor());
+        
         // Now add the layer that uses ImGui
         add_layer(std::move(main_layer));
         
-        std::cout << "[GRAN_AZUL] Application fully initialized\n";
+        LOG_INFO("GRAN_AZUL", "Application fully initialized");
     }
     
     ~GranAzulApp() {
-        std::cout << "[GRAN_AZUL] Application shutting down\n";
+        LOG_INFO("GRAN_AZUL", "Application shutting down");
     }
 };
 
@@ -1490,7 +1726,13 @@ public:
 int main() {
     int a = 0;
     try {
-        std::cout << "[GRAN_AZUL] Starting Gran Azul Code Quality Analysis Platform...\n";
+        // GRAN_AZUL_LOG_LEVEL=debug or trace shows the detailed traces
+        if (const char* level = std::getenv("GRAN_AZUL_LOG_LEVEL")) {
+            namespace log = wip::utils::log;
+            log::set_level(log::parse_level(level, log::Level::Info));
+        }
+        
+        LOG_INFO("GRAN_AZUL", "Starting Gran Azul Code Quality Analysis Platform...");
         
         // Create Gran Azul application
         GranAzulApp app;
@@ -1498,22 +1740,23 @@ int main() {
         // Initialize ImGui and add layers
         app.initialize();
         
-        std::cout << "[GRAN_AZUL] Controls:\n";
-        std::cout << "[GRAN_AZUL]   ESC - Quit application\n";
-        std::cout << "[GRAN_AZUL]   F1 - Show help\n";
-        std::cout << "[GRAN_AZUL]   F11 - Toggle fullscreen\n";
-        std::cout << "[GRAN_AZUL]   Ctrl+O - Open project\n";
-        std::cout << "[GRAN_AZUL]   F5 - Run analysis\n";
-        std::cout << "[GRAN_AZUL]   Ctrl+E - Generate report\n";
+        LOG_INFO("GRAN_AZUL", "Controls:");
+        LOG_INFO("GRAN_AZUL", "  ESC - Quit application");
+        LOG_INFO("GRAN_AZUL", "  F1 - Show help");
+        LOG_INFO("GRAN_AZUL", "  F11 - Toggle fullscreen");
+        LOG_INFO("GRAN_AZUL", "  F12 - Show profiler");
+        LOG_INFO("GRAN_AZUL", "  Ctrl+O - Open project");
+        LOG_INFO("GRAN_AZUL", "  F5 - Run analysis");
+        LOG_INFO("GRAN_AZUL", "  Ctrl+E - Generate report");
         
         // Run the application loop
         app.run();
         
-        std::cout << "[GRAN_AZUL] Application shut down successfully\n";
+        LOG_INFO("GRAN_AZUL", "Application shut down successfully");
         return 0;
         
     } catch (const std::exception& e) {
-        std::cerr << "[GRAN_AZUL] Application error: " << e.what() << std::endl;
+        LOG_ERROR("GRAN_AZUL", "Application error: ", e.what());
         return 1;
     }
 }
\ No newline at end of file
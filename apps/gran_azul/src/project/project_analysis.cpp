@@ -0,0 +1,28 @@
+#include "project_analysis.h"
+#include <tools/cppcheck_tool.h>
+
+namespace gran_azul {
+
+ProjectAnalysis make_project_analysis(const ProjectConfig& project) {
+    ProjectAnalysis analysis;
+    analysis.request.source_path = project.get_full_source_path();
+    analysis.request.exclude_patterns = project.exclude_patterns;
+    analysis.request.output_file = "analysis_results.xml";
+    
+    if (project.analysis.enable_cppcheck) analysis.tool_names.push_back("cppcheck");
+    if (project.analysis.enable_clang_tidy) analysis.tool_names.push_back("clang-tidy");
+    return analysis;
+}
+
+void configure_project_tools(wip::analysis::AnalysisEngine& engine, const std::filesystem::path& project_dir) {
+    auto* cppcheck = engine.get_tool("cppcheck");
+    if (cppcheck && cppcheck->get_configuration()) {
+        auto config = cppcheck->get_configuration()->clone();
+        if (auto* cppcheck_config = dynamic_cast<wip::analysis::tools::CppcheckConfig*>(config.get())) {
+            cppcheck_config->cache_directory = (project_dir / ".gran_azul_cppcheck").string();
+            engine.set_tool_configuration("cppcheck", std::move(config));
+        }
+    }
+}
+
+} // namespace gran_azul
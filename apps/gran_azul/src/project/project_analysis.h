@@ -0,0 +1,40 @@
+#pragma once
+
+#include "project_config.h"
+#include <analysis_engine.h>
+#include <analysis_types.h>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace gran_azul {
+
+/**
+ * @brief What running a project's analysis means: which tools, on which request
+ */
+struct ProjectAnalysis {
+    std::vector<std::string> tool_names;        ///< Tools enabled in the project, in run order
+    wip::analysis::AnalysisRequest request;     ///< Request for the project's sources
+};
+
+/**
+ * @brief Build the analysis the project configuration asks for
+ *
+ * Shared by the GUI and the headless driver, so both analyse a project the
+ * same way. The source path is resolved against the project root.
+ * @param project Project configuration
+ * @return Tools and request; no tools if the project enables none
+ */
+ProjectAnalysis make_project_analysis(const ProjectConfig& project);
+
+/**
+ * @brief Keep the caches of the engine's tools in the project's data folder
+ *
+ * Cppcheck keeps its per-file analysis in .gran_azul_cppcheck, next to the
+ * analysis cache, so the GUI and the headless driver share it too.
+ * @param engine Engine created for the project's tools
+ * @param project_dir Directory of the project file
+ */
+void configure_project_tools(wip::analysis::AnalysisEngine& engine, const std::filesystem::path& project_dir);
+
+} // namespace gran_azul
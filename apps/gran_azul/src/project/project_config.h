@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 #include <json_serializer.h>
+#include <schema_serializer.h>
 
 namespace gran_azul {
 
@@ -134,6 +135,35 @@ struct ProjectConfig {
     bool is_valid() const;
 };
 
+// Serialized fields; JSON and binary serializers are generated from these
+WIP_SCHEMA(ProjectConfig::AnalysisConfig::CppcheckSettings,
+    WIP_FIELD(enable_all), WIP_FIELD(enable_warning), WIP_FIELD(enable_style), WIP_FIELD(enable_performance),
+    WIP_FIELD(enable_portability), WIP_FIELD(enable_information), WIP_FIELD(enable_unused_function),
+    WIP_FIELD(enable_missing_include), WIP_FIELD(check_level), WIP_FIELD(inconclusive), WIP_FIELD(verbose),
+    WIP_FIELD(job_count), WIP_FIELD(quiet), WIP_FIELD(suppress_unused_function),
+    WIP_FIELD(suppress_missing_include_system), WIP_FIELD(suppress_missing_include),
+    WIP_FIELD(suppress_duplicate_conditional), WIP_FIELD(use_posix_library), WIP_FIELD(use_misra_addon),
+    WIP_FIELD(include_paths), WIP_FIELD(preprocessor_definitions))
+
+WIP_SCHEMA(ProjectConfig::AnalysisConfig::ClangTidySettings,
+    WIP_FIELD(enable_bugprone_checks), WIP_FIELD(enable_performance_checks), WIP_FIELD(enable_modernize_checks),
+    WIP_FIELD(enable_readability_checks), WIP_FIELD(enable_cppcoreguidelines_checks), WIP_FIELD(enable_misc_checks),
+    WIP_FIELD(enable_cert_checks), WIP_FIELD(disable_magic_numbers), WIP_FIELD(disable_uppercase_literal_suffix),
+    WIP_FIELD(use_color), WIP_FIELD(export_fixes), WIP_FIELD(format_style), WIP_FIELD(header_filter_regex_enabled),
+    WIP_FIELD(header_filter_regex), WIP_FIELD(system_headers), WIP_FIELD(fix_errors), WIP_FIELD(fix_notes),
+    WIP_FIELD(config_file), WIP_FIELD(additional_checks), WIP_FIELD(disabled_checks))
+
+WIP_SCHEMA(ProjectConfig::AnalysisConfig,
+    WIP_FIELD(source_path), WIP_FIELD(output_file), WIP_FIELD(build_dir), WIP_FIELD(enable_cppcheck),
+    WIP_FIELD(enable_clang_tidy), WIP_FIELD(cppcheck), WIP_FIELD(clang_tidy), WIP_FIELD(cpp_standard),
+    WIP_FIELD(platform), WIP_FIELD(suppress_duplicate_conditional), WIP_FIELD(use_posix_library),
+    WIP_FIELD(use_misra_addon))
+
+WIP_SCHEMA(ProjectConfig,
+    WIP_FIELD(name), WIP_FIELD(description), WIP_FIELD(version), WIP_FIELD(root_path), WIP_FIELD(analysis),
+    WIP_FIELD(source_directories), WIP_FIELD(include_directories), WIP_FIELD(exclude_patterns),
+    WIP_FIELD(reports_directory), WIP_FIELD(auto_save_results), WIP_FIELD(generate_html_report))
+
 } // namespace gran_azul
 
 // JSON serialization specializations for ProjectConfig types
@@ -1,12 +1,25 @@
 #include "project_manager.h"
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
-#include <iostream>
+#include <log.h>
 
 namespace gran_azul {
 
+namespace {
+
+// Top-level members of a project file that are read when it opens; everything else is skipped
+bool is_metadata_member(const std::string& key) {
+    return key == "format_version" || key == "project";
+}
+
+} // namespace
+
 ProjectManager::ProjectManager() = default;
 
+// A running background read finishes first; its completion task then finds the manager gone
+ProjectManager::~ProjectManager() = default;
+
 bool ProjectManager::create_new_project(const std::string& name, const std::string& root_path) {
     try {
         // Create new project config with defaults
@@ -54,29 +67,80 @@ bool ProjectManager::load_project(const std::string& file_path) {
             return false;
         }
         
-        // Update root path to be relative to project file location
-        std::filesystem::path project_dir = std::filesystem::path(file_path).parent_path();
-        if (project_config->root_path == "./") {
-            project_config->root_path = project_dir.string();
-        }
-        
-        if (!project_config->is_valid()) {
-            notify_error("Invalid project configuration in file: " + file_path);
-            return false;
-        }
-        
-        // Set as current project
-        current_project_ = std::make_unique<ProjectConfig>(*project_config);
-        current_project_path_ = std::filesystem::absolute(file_path).string();
-        
-        notify_project_loaded();
-        return true;
+        return install_project(file_path, std::move(*project_config));
     } catch (const std::exception& e) {
         notify_error("Failed to load project: " + std::string(e.what()));
         return false;
     }
 }
 
+void ProjectManager::load_project_async(const std::string& file_path, wip::utils::event::Executor& completion_executor,
+                                        ProjectLoadDoneCallback on_done) {
+    const uint64_t generation = ++load_generation_;
+    loading_path_ = file_path;
+    std::weak_ptr<ProjectManager*> self = self_;
+    
+    // Dropping a running read's task would wait for it, so finished reads are pruned instead
+    load_tasks_.erase(std::remove_if(load_tasks_.begin(), load_tasks_.end(),
+                                     [](const wip::utils::concurrency::Task<void>& task) { return task.is_ready(); }),
+                      load_tasks_.end());
+    
+    LOG_DEBUG("PROJECT_MANAGER", "Loading project in the background: ", file_path);
+    load_tasks_.push_back(wip::utils::concurrency::async([file_path, generation, self, &completion_executor,
+                                                          on_done = std::move(on_done)]() mutable {
+        std::string error;
+        auto project = parse_project_file(file_path, error);
+        
+        completion_executor.post([self = std::move(self), file_path, generation, error = std::move(error),
+                                  project = std::move(project), on_done = std::move(on_done)]() mutable {
+            auto owner = self.lock();
+            if (!owner) {
+                return;
+            }
+            ProjectManager* manager = *owner;
+            if (generation != manager->load_generation_) {
+                return;     // Superseded
+            }
+            manager->loading_path_.clear();
+            
+            // Executor tasks must not throw
+            try {
+                bool loaded = false;
+                if (project) {
+                    loaded = manager->install_project(file_path, std::move(*project));
+                } else {
+                    manager->notify_error(error);
+                }
+                if (on_done) {
+                    on_done(loaded);
+                }
+            } catch (const std::exception& e) {
+                manager->notify_error("Failed to load project: " + std::string(e.what()));
+            }
+        });
+    }));
+}
+
+bool ProjectManager::install_project(const std::string& file_path, ProjectConfig project) {
+    // Update root path to be relative to project file location
+    std::filesystem::path project_dir = std::filesystem::path(file_path).parent_path();
+    if (project.root_path == "./") {
+        project.root_path = project_dir.string();
+    }
+    
+    if (!project.is_valid()) {
+        notify_error("Invalid project configuration in file: " + file_path);
+        return false;
+    }
+    
+    // Set as current project
+    current_project_ = std::make_unique<ProjectConfig>(std::move(project));
+    current_project_path_ = std::filesystem::absolute(file_path).string();
+    
+    notify_project_loaded();
+    return true;
+}
+
 bool ProjectManager::save_project() {
     if (!has_project()) {
         notify_error("No project to save");
@@ -113,6 +177,8 @@ bool ProjectManager::save_project_as(const std::string& file_path) {
 }
 
 bool ProjectManager::close_project() {
+    ++load_generation_;
+    loading_path_.clear();
     current_project_.reset();
     current_project_path_.clear();
     return true;
@@ -194,7 +260,7 @@ std::vector<std::string> ProjectManager::find_project_files(const std::string& d
             }
         }
     } catch (const std::exception& e) {
-        std::cerr << "Error scanning directory for project files: " << e.what() << std::endl;
+        LOG_ERROR("PROJECT_MANAGER", "Error scanning directory for project files: ", e.what());
     }
     
     return project_files;
@@ -226,7 +292,7 @@ void ProjectManager::notify_project_saved() {
 }
 
 void ProjectManager::notify_error(const std::string& message) {
-    std::cerr << "[PROJECT_MANAGER] Error: " << message << std::endl;
+    LOG_ERROR("PROJECT_MANAGER", "Error: ", message);
     if (on_error_) {
         on_error_(message);
     }
@@ -262,41 +328,61 @@ bool ProjectManager::write_project_file(const std::string& file_path, const Proj
 }
 
 std::optional<ProjectConfig> ProjectManager::read_project_file(const std::string& file_path) {
+    std::string error;
+    auto project = parse_project_file(file_path, error);
+    if (!project) {
+        notify_error(error);
+    }
+    return project;
+}
+
+std::optional<ProjectConfig> ProjectManager::parse_project_file(const std::string& file_path, std::string& error) {
     try {
-        std::ifstream file(file_path);
+        std::ifstream file(file_path, std::ios::binary);
         if (!file.is_open()) {
-            notify_error("Could not open project file: " + file_path);
+            error = "Could not open project file: " + file_path;
             return std::nullopt;
         }
         
-        nlohmann::json file_data;
-        file >> file_data;
-        file.close();
+        // Bulky top-level sections are tokenized but never built into the document
+        size_t skipped_sections = 0;
+        nlohmann::json file_data = nlohmann::json::parse(file,
+            [&skipped_sections](int depth, nlohmann::json::parse_event_t event, nlohmann::json& parsed) {
+                if (depth == 1 && event == nlohmann::json::parse_event_t::key && !is_metadata_member(parsed.get<std::string>())) {
+                    ++skipped_sections;
+                    return false;
+                }
+                return true;
+            });
+        if (skipped_sections > 0) {
+            LOG_DEBUG("PROJECT_MANAGER", "Skipped ", skipped_sections, " non-metadata sections of ", file_path);
+        }
         
         // Check format version
         if (file_data.contains("format_version")) {
             std::string version = file_data["format_version"];
             if (version != PROJECT_FILE_VERSION) {
-                std::cout << "[PROJECT_MANAGER] Warning: Project file version " << version 
-                         << " may not be fully compatible with current version " << PROJECT_FILE_VERSION << std::endl;
+                LOG_WARNING("PROJECT_MANAGER", "Warning: Project file version ", version,
+                    " may not be fully compatible with current version ", PROJECT_FILE_VERSION);
             }
         }
         
         // Extract project data
         if (!file_data.contains("project")) {
-            notify_error("Invalid project file format: missing project data");
+            error = "Invalid project file format: missing project data";
             return std::nullopt;
         }
         
-        auto project_result = serializer_.deserialize(file_data["project"]);
+        wip::serialization::JsonSerializer<ProjectConfig> serializer;
+        auto project_result = serializer.deserialize(file_data["project"]);
         if (!project_result) {
-            notify_error("Failed to deserialize project data");
+            error = "Failed to deserialize project data";
             return std::nullopt;
         }
         
-        return *project_result;
+        return project_result;
     } catch (const std::exception& e) {
-        notify_error("Failed to read project file: " + std::string(e.what()));
+        error = "Failed to read project file: " + std::string(e.what());
         return std::nullopt;
     }
 }
@@ -321,9 +407,9 @@ void ProjectManager::ensure_project_directories(const ProjectConfig& project) {
             }
         }
         
-        std::cout << "[PROJECT_MANAGER] Project directories ensured" << std::endl;
+        LOG_DEBUG("PROJECT_MANAGER", "Project directories ensured");
     } catch (const std::exception& e) {
-        std::cerr << "[PROJECT_MANAGER] Warning: Could not create all project directories: " << e.what() << std::endl;
+        LOG_WARNING("PROJECT_MANAGER", "Warning: Could not create all project directories: ", e.what());
     }
 }
 
@@ -2,6 +2,8 @@
 
 #include "project_config.h"
 #include <json_serializer.h>
+#include <executor.h>
+#include <task.h>
 #include <functional>
 #include <memory>
 
@@ -10,6 +12,7 @@ namespace gran_azul {
 using ProjectLoadCallback = std::function<void(const ProjectConfig& project)>;
 using ProjectSaveCallback = std::function<void(const std::string& file_path)>;
 using ProjectErrorCallback = std::function<void(const std::string& error_message)>;
+using ProjectLoadDoneCallback = std::function<void(bool loaded)>;
 
 /**
  * @brief Manages Gran Azul project files and configuration
@@ -19,6 +22,12 @@ using ProjectErrorCallback = std::function<void(const std::string& error_message
  * - Converting between ProjectConfig and JSON
  * - Managing current project state
  * - Project validation and error handling
+ * 
+ * Project files are read metadata first: only the format version and the
+ * "project" section are parsed into a document, and any other top-level
+ * section (bulky data such as analysis history or stored results) is skipped
+ * while parsing. load_project_async() does the reading and deserialization on
+ * the default thread pool, so the UI stays interactive while a project opens.
  */
 class ProjectManager {
 private:
@@ -33,13 +42,36 @@ private:
     // JSON serializer
     wip::serialization::JsonSerializer<ProjectConfig> serializer_;
     
+    // Background loading; a newer load or close_project() supersedes a running one
+    std::string loading_path_;
+    uint64_t load_generation_ = 0;
+    std::shared_ptr<ProjectManager*> self_ = std::make_shared<ProjectManager*>(this);  // Expires with the manager
+    std::vector<wip::utils::concurrency::Task<void>> load_tasks_;   // Superseded reads finish on their own
+    
 public:
     ProjectManager();
-    ~ProjectManager() = default;
+    ~ProjectManager();
     
     // Project file operations
     bool create_new_project(const std::string& name, const std::string& root_path);
     bool load_project(const std::string& file_path);
+    
+    /**
+     * @brief Load a project without blocking the caller
+     * 
+     * The file is read and deserialized on a background thread; the project is
+     * then installed, and the loaded or error callback and on_done called, by
+     * a task posted to completion_executor. A load that is superseded by
+     * another load or by close_project() is dropped without callbacks.
+     * @param file_path Project file to load
+     * @param completion_executor Executor of the thread that owns the manager; must outlive the load
+     * @param on_done Called with whether the project was loaded
+     */
+    void load_project_async(const std::string& file_path, wip::utils::event::Executor& completion_executor,
+                            ProjectLoadDoneCallback on_done = nullptr);
+    bool is_loading() const { return !loading_path_.empty(); }
+    const std::string& get_loading_project_path() const { return loading_path_; }
+    
     bool save_project();
     bool save_project_as(const std::string& file_path);
     bool close_project();
@@ -75,6 +107,10 @@ private:
     
     bool write_project_file(const std::string& file_path, const ProjectConfig& project);
     std::optional<ProjectConfig> read_project_file(const std::string& file_path);
+    bool install_project(const std::string& file_path, ProjectConfig project);
+    
+    // Reads the metadata of a project file; thread-safe, reports failures through error
+    static std::optional<ProjectConfig> parse_project_file(const std::string& file_path, std::string& error);
     
     void ensure_project_directories(const ProjectConfig& project);
     
@@ -1,13 +1,23 @@
 #include "report_generator.h"
 #include <fstream>
-#include <iostream>
+#include <log.h>
+#include <directory_walker.h>
+#include <mapped_file.h>
+#include <tools/cppcheck_tool.h>
 #include <filesystem>
 #include <algorithm>
+#include <atomic>
 #include <sstream>
 #include <iomanip>
 
 namespace gran_azul {
 
+namespace {
+
+const std::vector<std::string> SOURCE_EXTENSIONS = {".cpp", ".h", ".hpp", ".c", ".cc", ".cxx"};
+
+} // namespace
+
 ReportGenerator::ReportGenerator(const std::string& project_base_path)
     : project_base_path_(project_base_path) {
 }
@@ -59,92 +69,176 @@ void ReportGenerator::add_tool_result(ComprehensiveReport& report, const Analysi
     generate_recommendations(report);
 }
 
+wip::analysis::ReportStatistics ReportGenerator::write_report(std::ostream& out, wip::analysis::ReportFormat format,
+                                                             const ProjectSummary& project,
+                                                             const std::string& cppcheck_output_file,
+                                                             const std::vector<wip::analysis::HistoryRun>& history) {
+    using wip::analysis::IssueSeverity;
+    
+    wip::analysis::ReportHeader header;
+    header.title = "Gran Azul Code Quality Report";
+    header.project_name = project.name;
+    header.generator_name = "Gran Azul";
+    header.generated_at = std::chrono::system_clock::now();
+    header.properties = {{"root_path", project.root_path},
+                         {"total_files", std::to_string(project.total_files)},
+                         {"lines_of_code", std::to_string(project.lines_of_code)}};
+    for (const auto& extension : project.extension_summaries) {
+        header.properties.emplace_back("lines_of_code" + extension.extension, std::to_string(extension.lines_of_code));
+    }
+    if (!history.empty()) {
+        std::string trend;
+        for (const auto& run : history) {
+            trend += (trend.empty() ? "" : ",") + std::to_string(run.issue_count);
+        }
+        header.properties.emplace_back("history_runs", std::to_string(history.size()));
+        header.properties.emplace_back("history_issue_trend", trend);
+        header.properties.emplace_back("previous_run_issues", std::to_string(history.back().issue_count));
+    }
+    
+    wip::analysis::ReportWriter writer(out, format, header);
+    if (std::filesystem::exists(cppcheck_output_file)) {
+        writer.begin_tool("Cppcheck");
+        try {
+            wip::analysis::tools::CppcheckTool cppcheck;
+            cppcheck.stream_results_file(cppcheck_output_file, [&writer](const wip::analysis::AnalysisIssue& issue) {
+                writer.write_issue(issue);
+            });
+            writer.end_tool(true);
+        } catch (const std::exception& e) {
+            writer.end_tool(false, "Error parsing cppcheck results: " + std::string(e.what()));
+        }
+    }
+    
+    // Score the typed severities the way calculate_statistics() scores cppcheck's
+    const auto& counts = writer.get_statistics();
+    ComprehensiveReport::Statistics statistics;
+    statistics.total_issues = counts.total_issues;
+    statistics.critical_issues = counts.get_issue_count(IssueSeverity::Critical) + counts.get_issue_count(IssueSeverity::Error);
+    statistics.major_issues = counts.get_issue_count(IssueSeverity::Warning);
+    statistics.minor_issues = counts.get_issue_count(IssueSeverity::Info);
+    const double score = calculate_quality_score(statistics);
+    
+    std::ostringstream score_text;
+    score_text << std::fixed << std::setprecision(1) << score;
+    return writer.finish({{"quality_score", score_text.str()}, {"quality_rating", determine_quality_rating(score)}});
+}
+
+std::string ReportGenerator::render_json_report(const ComprehensiveReport& report) {
+    wip::serialization::Serializer<nlohmann::json, ComprehensiveReport> serializer;
+    nlohmann::json j;
+    serializer.to_json(j, report);
+    return j.dump(4) + "\n";
+}
+
+std::string ReportGenerator::render_html_report(const ComprehensiveReport& report) {
+    std::ostringstream file;
+    
+    file << "<!DOCTYPE html>\n";
+    file << "<html><head><title>Gran Azul Code Quality Report</title>\n";
+    file << "<style>\n";
+    file << "body { font-family: Arial, sans-serif; margin: 40px; }\n";
+    file << ".header { background-color: #2c3e50; color: white; padding: 20px; border-radius: 8px; }\n";
+    file << ".section { margin: 20px 0; padding: 15px; border: 1px solid #ddd; border-radius: 5px; }\n";
+    file << ".stats { display: flex; gap: 20px; }\n";
+    file << ".stat-box { background: #ecf0f1; padding: 10px; border-radius: 5px; text-align: center; }\n";
+    file << ".critical { color: #e74c3c; }\n";
+    file << ".major { color: #f39c12; }\n";
+    file << ".minor { color: #f1c40f; }\n";
+    file << ".info { color: #3498db; }\n";
+    file << "</style></head><body>\n";
+    
+    // Header
+    file << "<div class='header'>\n";
+    file << "<h1>Gran Azul Code Quality Report</h1>\n";
+    file << "<p>Project: " << report.project.name << "</p>\n";
+    auto time_t_value = std::chrono::system_clock::to_time_t(report.generated_at);
+    file << "<p>Generated: " << std::put_time(std::localtime(&time_t_value), "%Y-%m-%d %H:%M:%S") << "</p>\n";
+    file << "</div>\n";
+    
+    // Statistics
+    file << "<div class='section'>\n";
+    file << "<h2>Analysis Summary</h2>\n";
+    file << "<div class='stats'>\n";
+    file << "<div class='stat-box'><h3>" << report.statistics.total_issues << "</h3><p>Total Issues</p></div>\n";
+    file << "<div class='stat-box critical'><h3>" << report.statistics.critical_issues << "</h3><p>Critical</p></div>\n";
+    file << "<div class='stat-box major'><h3>" << report.statistics.major_issues << "</h3><p>Major</p></div>\n";
+    file << "<div class='stat-box minor'><h3>" << report.statistics.minor_issues << "</h3><p>Minor</p></div>\n";
+    file << "<div class='stat-box'><h3>" << std::fixed << std::setprecision(1) << report.statistics.quality_score << "</h3><p>Quality Score</p></div>\n";
+    file << "</div>\n";
+    file << "</div>\n";
+    
+    // Project structure
+    if (!report.project.extension_summaries.empty()) {
+        file << "<div class='section'>\n";
+        file << "<h2>Project Structure</h2>\n";
+        file << "<p>" << report.project.total_files << " files, " << report.project.lines_of_code << " lines</p>\n";
+        file << "<table>\n";
+        file << "<tr><th>Extension</th><th>Files</th><th>Lines</th></tr>\n";
+        for (const auto& extension : report.project.extension_summaries) {
+            file << "<tr><td>" << extension.extension << "</td><td>" << extension.files << "</td><td>"
+                 << extension.lines_of_code << "</td></tr>\n";
+        }
+        file << "</table>\n";
+        file << "</div>\n";
+    }
+    
+    // Tools
+    for (const auto& tool : report.tools) {
+        file << "<div class='section'>\n";
+        file << "<h3>" << tool.name << "</h3>\n";
+        file << "<p>Status: " << (tool.success ? "Success" : "Failed") << "</p>\n";
+        if (!tool.success) {
+            file << "<p style='color: red;'>Error: " << tool.error_message << "</p>\n";
+        }
+        file << "</div>\n";
+    }
+    
+    file << "</body></html>\n";
+    
+    return file.str();
+}
+
 bool ReportGenerator::export_json_report(const ComprehensiveReport& report, const std::string& output_file) {
     try {
-        wip::serialization::Serializer<nlohmann::json, ComprehensiveReport> serializer;
-        nlohmann::json j;
-        serializer.to_json(j, report);
+        std::string content = render_json_report(report);
         
         std::ofstream file(output_file);
         if (!file.is_open()) {
-            std::cerr << "[REPORT_GENERATOR] Failed to open output file: " << output_file << std::endl;
+            LOG_ERROR("REPORT_GENERATOR", "Failed to open output file: ", output_file);
             return false;
         }
         
-        file << j.dump(4) << std::endl;
+        file << content;
         file.close();
         
-        std::cout << "[REPORT_GENERATOR] JSON report exported to: " << output_file << std::endl;
+        LOG_INFO("REPORT_GENERATOR", "JSON report exported to: ", output_file);
         return true;
         
     } catch (const std::exception& e) {
-        std::cerr << "[REPORT_GENERATOR] Error exporting JSON report: " << e.what() << std::endl;
+        LOG_ERROR("REPORT_GENERATOR", "Error exporting JSON report: ", e.what());
         return false;
     }
 }
 
 bool ReportGenerator::export_html_report(const ComprehensiveReport& report, const std::string& output_file) {
     try {
+        std::string content = render_html_report(report);
+        
         std::ofstream file(output_file);
         if (!file.is_open()) {
-            std::cerr << "[REPORT_GENERATOR] Failed to open HTML output file: " << output_file << std::endl;
+            LOG_ERROR("REPORT_GENERATOR", "Failed to open HTML output file: ", output_file);
             return false;
         }
         
-        // Generate HTML report
-        file << "<!DOCTYPE html>\n";
-        file << "<html><head><title>Gran Azul Code Quality Report</title>\n";
-        file << "<style>\n";
-        file << "body { font-family: Arial, sans-serif; margin: 40px; }\n";
-        file << ".header { background-color: #2c3e50; color: white; padding: 20px; border-radius: 8px; }\n";
-        file << ".section { margin: 20px 0; padding: 15px; border: 1px solid #ddd; border-radius: 5px; }\n";
-        file << ".stats { display: flex; gap: 20px; }\n";
-        file << ".stat-box { background: #ecf0f1; padding: 10px; border-radius: 5px; text-align: center; }\n";
-        file << ".critical { color: #e74c3c; }\n";
-        file << ".major { color: #f39c12; }\n";
-        file << ".minor { color: #f1c40f; }\n";
-        file << ".info { color: #3498db; }\n";
-        file << "</style></head><body>\n";
-        
-        // Header
-        file << "<div class='header'>\n";
-        file << "<h1>Gran Azul Code Quality Report</h1>\n";
-        file << "<p>Project: " << report.project.name << "</p>\n";
-        auto time_t_value = std::chrono::system_clock::to_time_t(report.generated_at);
-        file << "<p>Generated: " << std::put_time(std::localtime(&time_t_value), "%Y-%m-%d %H:%M:%S") << "</p>\n";
-        file << "</div>\n";
-        
-        // Statistics
-        file << "<div class='section'>\n";
-        file << "<h2>Analysis Summary</h2>\n";
-        file << "<div class='stats'>\n";
-        file << "<div class='stat-box'><h3>" << report.statistics.total_issues << "</h3><p>Total Issues</p></div>\n";
-        file << "<div class='stat-box critical'><h3>" << report.statistics.critical_issues << "</h3><p>Critical</p></div>\n";
-        file << "<div class='stat-box major'><h3>" << report.statistics.major_issues << "</h3><p>Major</p></div>\n";
-        file << "<div class='stat-box minor'><h3>" << report.statistics.minor_issues << "</h3><p>Minor</p></div>\n";
-        file << "<div class='stat-box'><h3>" << std::fixed << std::setprecision(1) << report.statistics.quality_score << "</h3><p>Quality Score</p></div>\n";
-        file << "</div>\n";
-        file << "</div>\n";
-        
-        // Tools
-        for (const auto& tool : report.tools) {
-            file << "<div class='section'>\n";
-            file << "<h3>" << tool.name << "</h3>\n";
-            file << "<p>Status: " << (tool.success ? "Success" : "Failed") << "</p>\n";
-            if (!tool.success) {
-                file << "<p style='color: red;'>Error: " << tool.error_message << "</p>\n";
-            }
-            file << "</div>\n";
-        }
-        
-        file << "</body></html>\n";
+        file << content;
         file.close();
         
-        std::cout << "[REPORT_GENERATOR] HTML report exported to: " << output_file << std::endl;
+        LOG_INFO("REPORT_GENERATOR", "HTML report exported to: ", output_file);
         return true;
         
     } catch (const std::exception& e) {
-        std::cerr << "[REPORT_GENERATOR] Error exporting HTML report: " << e.what() << std::endl;
+        LOG_ERROR("REPORT_GENERATOR", "Error exporting HTML report: ", e.what());
         return false;
     }
 }
@@ -161,32 +255,51 @@ ProjectSummary ReportGenerator::analyze_project_structure(const std::string& pro
     summary.total_files = 0;
     summary.lines_of_code = 0;
     
+    // One slot per extension, filled by the walker's threads without locking
+    struct Totals {
+        std::atomic<size_t> files{0};
+        std::atomic<size_t> lines{0};
+    };
+    wip::utils::file::WalkOptions options;
+    options.extensions = SOURCE_EXTENSIONS;
+    std::vector<Totals> totals(options.extensions.size());
+    
     for (const auto& source_path : source_paths) {
-        if (std::filesystem::exists(source_path)) {
-            for (const auto& entry : std::filesystem::recursive_directory_iterator(source_path)) {
-                if (entry.is_regular_file()) {
-                    std::string extension = entry.path().extension().string();
-                    if (extension == ".cpp" || extension == ".h" || extension == ".hpp" || 
-                        extension == ".c" || extension == ".cc" || extension == ".cxx") {
-                        summary.total_files++;
-                        
-                        // Count lines (simplified)
-                        std::ifstream file(entry.path());
-                        summary.lines_of_code += std::count(
-                            std::istreambuf_iterator<char>(file),
-                            std::istreambuf_iterator<char>(), '\n');
-                        
-                        // Track extensions
-                        if (std::find(summary.file_extensions.begin(), 
-                                    summary.file_extensions.end(), extension) == summary.file_extensions.end()) {
-                            summary.file_extensions.push_back(extension);
-                        }
-                    }
-                }
+        auto walked = wip::utils::file::walk_directory(source_path, options, [&](const std::filesystem::directory_entry& entry) {
+            if (!entry.is_regular_file()) {
+                return;
+            }
+            const std::string extension = entry.path().extension().string();
+            const auto slot = std::find(options.extensions.begin(), options.extensions.end(), extension) -
+                              options.extensions.begin();
+            
+            size_t lines = 0;
+            if (auto file = wip::utils::file::MappedFile::open(entry.path())) {
+                lines = wip::utils::file::count_lines(file->view());
             }
+            totals[slot].files.fetch_add(1, std::memory_order_relaxed);
+            totals[slot].lines.fetch_add(lines, std::memory_order_relaxed);
+        });
+        if (!walked) {
+            LOG_WARNING("REPORT_GENERATOR", "Cannot read source path: ", source_path);
         }
     }
     
+    for (size_t i = 0; i < totals.size(); ++i) {
+        ExtensionSummary extension{options.extensions[i], totals[i].files.load(), totals[i].lines.load()};
+        if (extension.files == 0) {
+            continue;
+        }
+        summary.total_files += extension.files;
+        summary.lines_of_code += extension.lines_of_code;
+        summary.extension_summaries.push_back(std::move(extension));
+    }
+    std::stable_sort(summary.extension_summaries.begin(), summary.extension_summaries.end(),
+                     [](const ExtensionSummary& a, const ExtensionSummary& b) { return a.lines_of_code > b.lines_of_code; });
+    for (const auto& extension : summary.extension_summaries) {
+        summary.file_extensions.push_back(extension.extension);
+    }
+    
     return summary;
 }
 
@@ -347,6 +460,12 @@ void Serializer<nlohmann::json, gran_azul::ComprehensiveReport>::to_json(nlohman
     j["project"]["total_files"] = report.project.total_files;
     j["project"]["lines_of_code"] = report.project.lines_of_code;
     j["project"]["file_extensions"] = report.project.file_extensions;
+    j["project"]["extensions"] = nlohmann::json::array();
+    for (const auto& extension : report.project.extension_summaries) {
+        j["project"]["extensions"].push_back({{"extension", extension.extension},
+                                              {"files", extension.files},
+                                              {"lines_of_code", extension.lines_of_code}});
+    }
     j["project"]["source_paths"] = report.project.source_paths;
     
     j["statistics"]["total_issues"] = report.statistics.total_issues;
@@ -385,6 +504,16 @@ void Serializer<nlohmann::json, gran_azul::ComprehensiveReport>::from_json(const
     proj.at("total_files").get_to(report.project.total_files);
     proj.at("lines_of_code").get_to(report.project.lines_of_code);
     proj.at("file_extensions").get_to(report.project.file_extensions);
+    report.project.extension_summaries.clear();
+    if (proj.contains("extensions")) {  // Reports written before per-extension counts have none
+        for (const auto& extension_json : proj.at("extensions")) {
+            gran_azul::ExtensionSummary extension;
+            extension_json.at("extension").get_to(extension.extension);
+            extension_json.at("files").get_to(extension.files);
+            extension_json.at("lines_of_code").get_to(extension.lines_of_code);
+            report.project.extension_summaries.push_back(std::move(extension));
+        }
+    }
     proj.at("source_paths").get_to(report.project.source_paths);
     
     // Statistics
@@ -3,7 +3,10 @@
 #include <string>
 #include <vector>
 #include <chrono>
+#include <ostream>
 #include <json_serializer.h>
+#include <report_writer.h>
+#include <history_store.h>
 
 namespace gran_azul {
 
@@ -20,6 +23,12 @@ struct AnalysisTool {
     nlohmann::json results;
 };
 
+struct ExtensionSummary {
+    std::string extension;      // Including the dot, e.g. ".cpp"
+    size_t files = 0;
+    size_t lines_of_code = 0;
+};
+
 struct ProjectSummary {
     std::string name;
     std::string root_path;
@@ -33,6 +42,7 @@ struct ProjectSummary {
     size_t total_files;
     size_t lines_of_code;
     std::vector<std::string> file_extensions;
+    std::vector<ExtensionSummary> extension_summaries;  // Found extensions, most lines first
 };
 
 struct ComprehensiveReport {
@@ -86,11 +96,24 @@ public:
     void add_cppcheck_results(ComprehensiveReport& report, const std::string& cppcheck_output_file);
     void add_tool_result(ComprehensiveReport& report, const AnalysisTool& tool);
     
+    // Stream a report of the cppcheck results straight from its XML output, with the statistics
+    // counted on the way, so no report DOM is built; the tool is left out if the file does not exist.
+    // Summaries of earlier runs, oldest first, add the issue trend to the header
+    static wip::analysis::ReportStatistics write_report(std::ostream& out, wip::analysis::ReportFormat format,
+                                                        const ProjectSummary& project,
+                                                        const std::string& cppcheck_output_file,
+                                                        const std::vector<wip::analysis::HistoryRun>& history = {});
+    
+    // Render report content, e.g. to hand it to an AsyncFileWriter
+    static std::string render_json_report(const ComprehensiveReport& report);
+    static std::string render_html_report(const ComprehensiveReport& report);
+    
     // Export report
     bool export_json_report(const ComprehensiveReport& report, const std::string& output_file);
     bool export_html_report(const ComprehensiveReport& report, const std::string& output_file);
     
     // Utility methods
+    // Walks and counts the source files in parallel, mapping each file instead of reading it
     static ProjectSummary analyze_project_structure(const std::string& project_path, 
                                                    const std::vector<std::string>& source_paths);
     static double calculate_quality_score(const ComprehensiveReport::Statistics& stats);
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <event.h>
+#include <file_watcher.h>
+#include "analysis_result.h"
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace gran_azul::utils {
+
+/**
+ * @brief Events published by the analysis engine's worker threads
+ *
+ * The engine callbacks only dispatch these; the main layer subscribes on the
+ * application's UI executor, so the widgets are updated on the UI thread once
+ * per frame without locking. Tool output and progress, which arrive far more
+ * often, bypass the dispatcher through a wip::analysis::ProgressChannel.
+ */
+
+/**
+ * @brief Issues found while the analysis is still running
+ */
+class AnalysisIssuesEvent : public wip::utils::event::Event {
+public:
+    AnalysisIssuesEvent(std::string tool_name, std::vector<wip::analysis::AnalysisIssue> issues)
+        : tool_name_(std::move(tool_name)), issues_(std::move(issues)) {}
+    
+    const std::string& tool_name() const noexcept { return tool_name_; }
+    const std::vector<wip::analysis::AnalysisIssue>& issues() const noexcept { return issues_; }
+
+private:
+    std::string tool_name_;
+    std::vector<wip::analysis::AnalysisIssue> issues_;
+};
+
+/**
+ * @brief Merged result of a finished analysis, prepared for display on the worker
+ *
+ * The result is shared rather than copied, so the UI thread can take it over
+ * with a move.
+ */
+class AnalysisCompletedEvent : public wip::utils::event::Event {
+public:
+    explicit AnalysisCompletedEvent(std::shared_ptr<gran_azul::widgets::PreparedAnalysisResult> result)
+        : result_(std::move(result)) {}
+    
+    const std::shared_ptr<gran_azul::widgets::PreparedAnalysisResult>& result() const noexcept { return result_; }
+
+private:
+    std::shared_ptr<gran_azul::widgets::PreparedAnalysisResult> result_;
+};
+
+/**
+ * @brief Coalesced batch of changed project sources, published by the source watcher's thread
+ */
+class SourceFilesChangedEvent : public wip::utils::event::Event {
+public:
+    explicit SourceFilesChangedEvent(std::vector<wip::utils::file::FileChange> changes)
+        : changes_(std::move(changes)) {}
+    
+    const std::vector<wip::utils::file::FileChange>& changes() const noexcept { return changes_; }
+
+private:
+    std::vector<wip::utils::file::FileChange> changes_;
+};
+
+} // namespace gran_azul::utils
@@ -1,5 +1,8 @@
 #include "async_process_executor.h"
-#include <iostream>
+#include <algorithm>
+#include <log.h>
+#include <thread_pool.h>
+#include <wip_string.h>
 #include <sstream>
 #include <regex>
 #include <chrono>
@@ -16,96 +19,96 @@
 namespace gran_azul::utils {
 
 AsyncProcessExecutor::AsyncProcessExecutor()
-    : is_running_(false)
-    , should_cancel_(false)
-    , current_progress_(0.0f)
+    : running_count_(0)
 {
 }
 
 AsyncProcessExecutor::~AsyncProcessExecutor() {
+    // Pool jobs refer to this executor, so every run must be over before it goes away
     cancel();
-    if (worker_thread_.joinable()) {
-        worker_thread_.join();
-    }
 }
 
 std::future<wip::utils::process::ProcessResult> AsyncProcessExecutor::execute_async(const AsyncProcessConfig& config) {
-    if (is_running_) {
-        throw std::runtime_error("Process is already running");
-    }
+    auto run = std::make_shared<RunState>();
+    run->status = std::make_shared<const std::string>("Starting...");
+    auto future = run->result_promise.get_future();
     
-    // Clean up previous thread if it exists
-    if (worker_thread_.joinable()) {
-        worker_thread_.join();
+    {
+        std::lock_guard<std::mutex> lock(runs_mutex_);
+        runs_.push_back(run);
     }
+    ++running_count_;
+    std::atomic_store(&latest_run_, run);
     
-    // Reset state
-    is_running_ = true;
-    should_cancel_ = false;
-    current_progress_ = 0.0f;
-    current_status_ = "Starting...";
-    
-    // Create new promise for this execution
-    result_promise_ = std::promise<wip::utils::process::ProcessResult>();
-    auto future = result_promise_.get_future();
-    
-    // Start background thread
-    worker_thread_ = std::thread([this, config]() {
-        std::cout << "[ASYNC_EXECUTOR] Starting worker thread for command: " << config.command << std::endl;
-        execute_with_realtime_output(config);
+    // A run occupies a pool worker for as long as its process lives
+    wip::utils::concurrency::default_thread_pool().post([this, config, run]() {
+        if (run->should_cancel) {
+            // Cancelled while waiting for a pool worker
+            wip::utils::process::ProcessResult cancelled{};
+            cancelled.exit_code = -1;
+            cancelled.timed_out = true;
+            run->result_promise.set_value(cancelled);
+        } else {
+            LOG_DEBUG("ASYNC_EXECUTOR", "Starting pool job for command: ", config.command);
+            execute_with_realtime_output(config, *run);
+        }
+        
+        // Notify under the lock: the executor may be destroyed as soon as it sees runs_ empty
+        std::lock_guard<std::mutex> lock(runs_mutex_);
+        runs_.erase(std::find(runs_.begin(), runs_.end(), run));
+        --running_count_;
+        runs_finished_.notify_all();
     });
     
     return future;
 }
 
 void AsyncProcessExecutor::cancel() {
-    should_cancel_ = true;
-    
-    // Wait for the worker thread to finish with a timeout
-    if (worker_thread_.joinable()) {
-        // Give it a moment to clean up naturally
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        
-        // If it's still running, we'll force join
-        if (is_running_) {
-            // The thread should detect should_cancel_ and exit soon
-            worker_thread_.join();
-        }
+    std::unique_lock<std::mutex> lock(runs_mutex_);
+    for (const auto& run : runs_) {
+        run->should_cancel = true;
     }
+    
+    // Each run notices the flag within one poll interval
+    runs_finished_.wait(lock, [this]() { return runs_.empty(); });
 }
 
 bool AsyncProcessExecutor::is_running() const {
-    return is_running_;
+    return running_count_ > 0;
+}
+
+size_t AsyncProcessExecutor::get_running_count() const {
+    return running_count_;
 }
 
 float AsyncProcessExecutor::get_progress() const {
-    return current_progress_;
+    auto run = std::atomic_load(&latest_run_);
+    return run ? run->progress.load() : 0.0f;
 }
 
 std::string AsyncProcessExecutor::get_status() const {
-    std::lock_guard<std::mutex> lock(status_mutex_);
-    return current_status_;
+    auto run = std::atomic_load(&latest_run_);
+    if (!run) {
+        return "";
+    }
+    return *std::atomic_load(&run->status);
 }
 
-void AsyncProcessExecutor::update_progress(float progress, const std::string& status) {
-    current_progress_ = std::clamp(progress, 0.0f, 1.0f);
-    
-    {
-        std::lock_guard<std::mutex> lock(status_mutex_);
-        current_status_ = status;
-    }
+void AsyncProcessExecutor::update_progress(RunState& run, float progress, const std::string& status) {
+    run.progress = std::clamp(progress, 0.0f, 1.0f);
+    std::atomic_store(&run.status, std::make_shared<const std::string>(status));
 }
 
-void AsyncProcessExecutor::parse_cppcheck_output(const std::string& line, const AsyncProcessConfig& config) {
+void AsyncProcessExecutor::parse_cppcheck_output(const std::string& line, const AsyncProcessConfig& config, RunState& run) {
     // Parse cppcheck progress output patterns
-    static std::regex progress_regex(R"((\d+)/(\d+) files checked (\d+)% done)");
-    static std::regex file_regex(R"(Checking (.+\.(cpp|hpp|c|h|cxx|hxx))\.\.\.)");
-    static std::regex info_regex(R"(\[info\].*?)");
+    static const std::regex progress_regex(R"((\d+)/(\d+) files checked (\d+)% done)");
+    static const std::regex file_regex(R"(Checking (.+\.(cpp|hpp|c|h|cxx|hxx))\.\.\.)");
     
+    // Most lines are diagnostics; only run a regex on lines that can match it
     std::smatch match;
     
     // Check for progress pattern: "X/Y files checked Z% done"
-    if (std::regex_search(line, match, progress_regex)) {
+    if (line.find("files checked") != std::string::npos && std::regex_search(line, match, progress_regex)) {
         int current_files = std::stoi(match[1].str());
         int total_files = std::stoi(match[2].str());
         int percent = std::stoi(match[3].str());
@@ -113,14 +116,14 @@ void AsyncProcessExecutor::parse_cppcheck_output(const std::string& line, const
         float progress = percent / 100.0f;
         std::string status = "Checked " + std::to_string(current_files) + "/" + std::to_string(total_files) + " files";
         
-        update_progress(progress, status);
+        update_progress(run, progress, status);
         
         if (config.on_progress) {
             config.on_progress(progress, status);
         }
     }
     // Check for file being checked: "Checking filename..."
-    else if (std::regex_search(line, match, file_regex)) {
+    else if (line.find("Checking ") != std::string::npos && std::regex_search(line, match, file_regex)) {
         std::string filename = match[1].str();
         // Extract just the filename without path
         size_t last_slash = filename.find_last_of("/\\");
@@ -129,37 +132,33 @@ void AsyncProcessExecutor::parse_cppcheck_output(const std::string& line, const
         }
         
         std::string status = "Checking " + filename;
-        update_progress(current_progress_, status);
+        update_progress(run, run.progress, status);
         
         if (config.on_progress) {
-            config.on_progress(current_progress_, status);
+            config.on_progress(run.progress, status);
         }
     }
     // General info messages
-    else if (std::regex_search(line, match, info_regex)) {
-        update_progress(current_progress_, line);
+    else if (line.find("[info]") != std::string::npos) {
+        update_progress(run, run.progress, line);
         
         if (config.on_progress) {
-            config.on_progress(current_progress_, line);
+            config.on_progress(run.progress, line);
         }
     }
 }
 
-void AsyncProcessExecutor::execute_with_realtime_output(const AsyncProcessConfig& config) {
-    std::cout << "[ASYNC_EXECUTOR] execute_with_realtime_output called" << std::endl;
-    std::cout << "[ASYNC_EXECUTOR] Command: " << config.command << std::endl;
-    std::cout << "[ASYNC_EXECUTOR] Working dir: " << config.working_directory << std::endl;
-    std::cout << "[ASYNC_EXECUTOR] Arguments: ";
-    for (const auto& arg : config.arguments) {
-        std::cout << "'" << arg << "' ";
-    }
-    std::cout << std::endl;
+void AsyncProcessExecutor::execute_with_realtime_output(const AsyncProcessConfig& config, RunState& run) {
+    LOG_DEBUG("ASYNC_EXECUTOR", "execute_with_realtime_output called");
+    LOG_DEBUG("ASYNC_EXECUTOR", "Command: ", config.command);
+    LOG_DEBUG("ASYNC_EXECUTOR", "Working dir: ", config.working_directory);
+    LOG_DEBUG("ASYNC_EXECUTOR", "Arguments: '", wip::utils::string::join(config.arguments, "' '"), "'");
     
     try {
         #ifdef _WIN32
-        execute_windows(config);
+        execute_windows(config, run);
         #else
-        execute_unix(config);
+        execute_unix(config, run);
         #endif
     } catch (const std::exception& e) {
         // Create error result
@@ -170,20 +169,16 @@ void AsyncProcessExecutor::execute_with_realtime_output(const AsyncProcessConfig
         error_result.duration = std::chrono::milliseconds(0);
         
         try {
-            result_promise_.set_value(error_result);
+            run.result_promise.set_value(error_result);
         } catch (const std::exception&) {
             // Promise might already be set, ignore
         }
     }
-    
-    // Ensure state is properly reset
-    is_running_ = false;
-    should_cancel_ = false;
 }
 
 #ifndef _WIN32
-void AsyncProcessExecutor::execute_unix(const AsyncProcessConfig& config) {
-    std::cout << "[ASYNC_EXECUTOR] execute_unix called" << std::endl;
+void AsyncProcessExecutor::execute_unix(const AsyncProcessConfig& config, RunState& run) {
+    LOG_DEBUG("ASYNC_EXECUTOR", "execute_unix called");
     auto start_time = std::chrono::steady_clock::now();
     
     // Build command string
@@ -191,7 +186,7 @@ void AsyncProcessExecutor::execute_unix(const AsyncProcessConfig& config) {
     for (const auto& arg : config.arguments) {
         full_command += " " + arg;
     }
-    std::cout << "[ASYNC_EXECUTOR] Full command: " << full_command << std::endl;
+    LOG_DEBUG("ASYNC_EXECUTOR", "Full command: ", full_command);
     
     // Create pipes for stdout and stderr
     int stdout_pipe[2];
@@ -240,17 +235,16 @@ void AsyncProcessExecutor::execute_unix(const AsyncProcessConfig& config) {
         std::string stderr_buffer;
         
         bool process_running = true;
+        int final_status = 0;
         
         while (process_running || !stdout_buffer.empty() || !stderr_buffer.empty()) {
-            if (should_cancel_) {
+            if (run.should_cancel) {
                 kill(pid, SIGTERM);
                 break;
             }
             
             // Check if process is still running
-            int status;
-            pid_t result = waitpid(pid, &status, WNOHANG);
-            if (result == pid) {
+            if (process_running && waitpid(pid, &final_status, WNOHANG) == pid) {
                 process_running = false;
             }
             
@@ -280,14 +274,14 @@ void AsyncProcessExecutor::execute_unix(const AsyncProcessConfig& config) {
                             
                             stdout_output += line + "\n";
                             
-                            std::cout << "[ASYNC_EXECUTOR] Read stdout line: '" << line << "'" << std::endl;
+                            LOG_TRACE("ASYNC_EXECUTOR", "Read stdout line: '", line, "'");
                             
                             if (config.on_output) {
                                 config.on_output(line);
                             }
                             
                             if (config.parse_cppcheck_progress) {
-                                parse_cppcheck_output(line, config);
+                                parse_cppcheck_output(line, config, run);
                             }
                         }
                     }
@@ -309,7 +303,7 @@ void AsyncProcessExecutor::execute_unix(const AsyncProcessConfig& config) {
                             
                             stderr_output += line + "\n";
                             
-                            std::cout << "[ASYNC_EXECUTOR] Read stderr line: '" << line << "'" << std::endl;
+                            LOG_TRACE("ASYNC_EXECUTOR", "Read stderr line: '", line, "'");
                             
                             if (config.on_output) {
                                 config.on_output("ERROR: " + line);
@@ -324,9 +318,10 @@ void AsyncProcessExecutor::execute_unix(const AsyncProcessConfig& config) {
         close(stdout_pipe[0]);
         close(stderr_pipe[0]);
         
-        // Wait for final process status
-        int final_status;
-        waitpid(pid, &final_status, 0);
+        // Wait for final process status unless the loop already collected it
+        if (process_running) {
+            waitpid(pid, &final_status, 0);
+        }
         
         auto end_time = std::chrono::steady_clock::now();
         auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
@@ -337,7 +332,7 @@ void AsyncProcessExecutor::execute_unix(const AsyncProcessConfig& config) {
         result.stdout_output = stdout_output;
         result.stderr_output = stderr_output;
         result.duration = duration;
-        result.timed_out = should_cancel_;
+        result.timed_out = run.should_cancel;
         
         // Final progress update
         if (config.on_progress) {
@@ -350,7 +345,7 @@ void AsyncProcessExecutor::execute_unix(const AsyncProcessConfig& config) {
         
         // Set the result promise (protect against multiple calls)
         try {
-            result_promise_.set_value(result);
+            run.result_promise.set_value(result);
         } catch (const std::exception&) {
             // Promise might already be set, ignore
         }
@@ -359,7 +354,7 @@ void AsyncProcessExecutor::execute_unix(const AsyncProcessConfig& config) {
 #endif
 
 #ifdef _WIN32
-void AsyncProcessExecutor::execute_windows(const AsyncProcessConfig& config) {
+void AsyncProcessExecutor::execute_windows(const AsyncProcessConfig& config, RunState& run) {
     // Windows implementation would go here
     // For now, fall back to synchronous execution
     wip::utils::process::ProcessExecutor executor;
@@ -369,7 +364,7 @@ void AsyncProcessExecutor::execute_windows(const AsyncProcessConfig& config) {
         config.on_completion(result);
     }
     
-    result_promise_.set_value(result);
+    run.result_promise.set_value(result);
 }
 #endif
 
@@ -2,10 +2,12 @@
 
 #include <process.h>
 #include <functional>
-#include <thread>
 #include <atomic>
+#include <condition_variable>
+#include <memory>
 #include <mutex>
 #include <future>
+#include <vector>
 
 namespace gran_azul::utils {
 
@@ -41,6 +43,11 @@ struct AsyncProcessConfig {
 
 /**
  * @brief Async process executor for real-time feedback during analysis
+ * 
+ * Runs are executed on a worker pool shared by every executor, so starting a
+ * run never creates a thread and several runs may be in flight at once.
+ * Progress and status are published as atomics and immutable snapshots; the
+ * getters never wait for a running process and are safe to call every frame.
  */
 class AsyncProcessExecutor {
 public:
@@ -55,52 +62,66 @@ public:
     
     /**
      * @brief Start async execution with callbacks
+     * 
+     * Callbacks are invoked on a pool thread.
      * @param config Configuration and callbacks
      * @return Future that completes when process finishes
      */
     std::future<wip::utils::process::ProcessResult> execute_async(const AsyncProcessConfig& config);
     
     /**
-     * @brief Cancel the running process
+     * @brief Cancel all running processes and wait for them to stop
      */
     void cancel();
     
     /**
-     * @brief Check if process is currently running
+     * @brief Check if any process is currently running
      */
     bool is_running() const;
     
     /**
-     * @brief Get current progress (0.0 to 1.0)
+     * @brief Get number of runs started and not yet finished
+     */
+    size_t get_running_count() const;
+    
+    /**
+     * @brief Get current progress of the most recent run (0.0 to 1.0)
      */
     float get_progress() const;
     
     /**
-     * @brief Get current status message
+     * @brief Get current status message of the most recent run
      */
     std::string get_status() const;
 
 private:
-    std::atomic<bool> is_running_;
-    std::atomic<bool> should_cancel_;
-    std::atomic<float> current_progress_;
-    mutable std::mutex status_mutex_;
-    std::string current_status_;
+    // State of one run, shared between the pool job and the getters
+    struct RunState {
+        std::atomic<bool> should_cancel{false};
+        std::atomic<float> progress{0.0f};
+        std::shared_ptr<const std::string> status;  // Replaced whole via std::atomic_store
+        std::promise<wip::utils::process::ProcessResult> result_promise;
+    };
+    
+    std::shared_ptr<RunState> latest_run_;          // Accessed via std::atomic_load/atomic_store
+    std::atomic<size_t> running_count_;
     
-    std::thread worker_thread_;
-    std::promise<wip::utils::process::ProcessResult> result_promise_;
+    // Guards runs_ only; taken when runs start and finish, never by the getters
+    std::mutex runs_mutex_;
+    std::condition_variable runs_finished_;
+    std::vector<std::shared_ptr<RunState>> runs_;
     
     // Progress estimation for cppcheck
-    void parse_cppcheck_output(const std::string& line, const AsyncProcessConfig& config);
-    void update_progress(float progress, const std::string& status);
+    void parse_cppcheck_output(const std::string& line, const AsyncProcessConfig& config, RunState& run);
+    void update_progress(RunState& run, float progress, const std::string& status);
     
     // Platform-specific process management
-    void execute_with_realtime_output(const AsyncProcessConfig& config);
+    void execute_with_realtime_output(const AsyncProcessConfig& config, RunState& run);
     
     #ifdef _WIN32
-    void execute_windows(const AsyncProcessConfig& config);
+    void execute_windows(const AsyncProcessConfig& config, RunState& run);
     #else
-    void execute_unix(const AsyncProcessConfig& config);
+    void execute_unix(const AsyncProcessConfig& config, RunState& run);
     #endif
 };
 
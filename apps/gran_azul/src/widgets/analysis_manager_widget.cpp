@@ -2,7 +2,8 @@
 #include "../project/project_config.h"
 #include <imgui.h>
 #include <algorithm>
-#include <iostream>
+#include <log.h>
+#include <wip_string.h>
 #include <filesystem>
 #include <sstream>
 
@@ -24,13 +25,8 @@ AnalysisManagerWidget::AnalysisManagerWidget() {
         }
     }
     
-    std::cout << "[ANALYSIS_MANAGER] Widget initialized with " 
-              << analysis_engine_->get_registered_tools().size() << " analysis tools\n";
-    std::cout << "[ANALYSIS_MANAGER] Selected tools: ";
-    for (const auto& tool : selected_tools_) {
-        std::cout << tool << " ";
-    }
-    std::cout << "\n";
+    LOG_DEBUG("ANALYSIS_MANAGER", "Widget initialized with ", analysis_engine_->get_registered_tools().size(), " analysis tools");
+    LOG_DEBUG("ANALYSIS_MANAGER", "Selected tools: ", wip::utils::string::join(selected_tools_, " "));
 }
 
 void AnalysisManagerWidget::update(float delta_time) {
@@ -197,6 +193,7 @@ void AnalysisManagerWidget::render_clang_tidy_configuration() {
     if (ImGui::CollapsingHeader("Options")) {
         ImGui::Checkbox("Fix Errors", &clang_tidy_fix_errors_);
         ImGui::Checkbox("Enable Header Filter", &clang_tidy_header_filter_);
+        ImGui::Checkbox("Precompile Shared Headers", &clang_tidy_precompiled_headers_);
     }
 }
 
@@ -228,8 +225,8 @@ void AnalysisManagerWidget::render_analysis_controls() {
             }
             
             auto request = build_analysis_request();
-            std::cout << "[ANALYSIS_MANAGER] Running analysis with " << selected_tools_.size() 
-                      << " tools, source: " << request.source_path << ", output: " << request.output_file << "\n";
+            LOG_DEBUG("ANALYSIS_MANAGER", "Running analysis with ", selected_tools_.size(), " tools, source: ",
+                request.source_path, ", output: ", request.output_file);
             analysis_callback_(selected_tools_, request);
         }
     }
@@ -312,6 +309,7 @@ void AnalysisManagerWidget::configure_clang_tidy_tool() {
     config->checks = clang_tidy_checks_;
     config->fix_errors = clang_tidy_fix_errors_;
     config->header_filter_regex_enabled = clang_tidy_header_filter_;
+    config->precompiled_headers = clang_tidy_precompiled_headers_;
     if (clang_tidy_header_filter_) {
         config->header_filter_regex = ".*";
     }
@@ -84,6 +84,7 @@ private:
     char clang_tidy_checks_input_[1024] = "bugprone-*,performance-*,readability-*";
     bool clang_tidy_fix_errors_ = false;
     bool clang_tidy_header_filter_ = true;
+    bool clang_tidy_precompiled_headers_ = false;
     
     // Callbacks
     AnalysisCallback analysis_callback_;
@@ -1,16 +1,35 @@
 #include "analysis_result.h"
 #include <fstream>
-#include <sstream>
 #include <algorithm>
 #include <cctype>
 #include <set>
-#include <ctime>
-#include <iomanip>
-#include <regex>
+#include <unordered_set>
+#include <filesystem>
+#include <nlohmann/json.hpp>
+#include <log.h>
 
 namespace gran_azul::widgets {
 
-std::string AnalysisIssue::severity_string() const {
+IssueSeverity display_severity(wip::analysis::IssueSeverity severity, wip::analysis::IssueCategory category) {
+    switch (severity) {
+        case wip::analysis::IssueSeverity::Error:
+        case wip::analysis::IssueSeverity::Critical:
+            return IssueSeverity::ERROR;
+        case wip::analysis::IssueSeverity::Warning:
+            return IssueSeverity::WARNING;
+        case wip::analysis::IssueSeverity::Info:
+        default:
+            // Map based on category for better classification
+            switch (category) {
+                case wip::analysis::IssueCategory::Performance: return IssueSeverity::PERFORMANCE;
+                case wip::analysis::IssueCategory::Style: return IssueSeverity::STYLE;
+                case wip::analysis::IssueCategory::Portability: return IssueSeverity::PORTABILITY;
+                default: return IssueSeverity::INFORMATION;
+            }
+    }
+}
+
+const char* severity_string(IssueSeverity severity) {
     switch (severity) {
         case IssueSeverity::ERROR: return "Error";
         case IssueSeverity::WARNING: return "Warning";
@@ -22,7 +41,7 @@ std::string AnalysisIssue::severity_string() const {
     }
 }
 
-AnalysisIssue::Color AnalysisIssue::severity_color() const {
+SeverityColor severity_color(IssueSeverity severity) {
     switch (severity) {
         case IssueSeverity::ERROR: return {1.0f, 0.2f, 0.2f, 1.0f};        // Red
         case IssueSeverity::WARNING: return {1.0f, 0.7f, 0.0f, 1.0f};      // Orange
@@ -34,34 +53,48 @@ AnalysisIssue::Color AnalysisIssue::severity_color() const {
     }
 }
 
-bool AnalysisIssue::matches_filter(const std::string& filter) const {
+namespace {
+
+// Case insensitive substring search that doesn't copy either string
+bool contains_ignore_case(std::string_view text, std::string_view filter) {
+    auto equal = [](char a, char b) {
+        return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+    };
+    return std::search(text.begin(), text.end(), filter.begin(), filter.end(), equal) != text.end();
+}
+
+// Identity of an issue in the false positives file
+std::string false_positive_key(std::string_view file_path, int line, int column, std::string_view id) {
+    std::string key;
+    key.reserve(file_path.size() + id.size() + 24);
+    key.append(file_path).append(1, '\n');
+    key.append(std::to_string(line)).append(1, ':').append(std::to_string(column)).append(1, '\n');
+    key.append(id);
+    return key;
+}
+
+} // namespace
+
+bool matches_filter(const IssueView& issue, std::string_view filter) {
     if (filter.empty()) return true;
     
-    std::string lower_filter = filter;
-    std::transform(lower_filter.begin(), lower_filter.end(), lower_filter.begin(), ::tolower);
-    
     // Check if filter matches any of these fields (case insensitive)
-    std::string lower_file = file;
-    std::string lower_id = id;
-    std::string lower_message = message;
-    std::string lower_severity = severity_string();
-    
-    std::transform(lower_file.begin(), lower_file.end(), lower_file.begin(), ::tolower);
-    std::transform(lower_id.begin(), lower_id.end(), lower_id.begin(), ::tolower);
-    std::transform(lower_message.begin(), lower_message.end(), lower_message.begin(), ::tolower);
-    std::transform(lower_severity.begin(), lower_severity.end(), lower_severity.begin(), ::tolower);
-    
-    return lower_file.find(lower_filter) != std::string::npos ||
-           lower_id.find(lower_filter) != std::string::npos ||
-           lower_message.find(lower_filter) != std::string::npos ||
-           lower_severity.find(lower_filter) != std::string::npos;
+    return contains_ignore_case(issue.file_path(), filter) ||
+           contains_ignore_case(issue.rule_id(), filter) ||
+           contains_ignore_case(issue.message(), filter) ||
+           contains_ignore_case(severity_string(display_severity(issue)), filter);
 }
 
-std::vector<const AnalysisIssue*> AnalysisResult::get_issues_by_severity(IssueSeverity severity) const {
-    std::vector<const AnalysisIssue*> result;
-    for (const auto& issue : issues) {
-        if (issue.severity == severity) {
-            result.push_back(&issue);
+void AnalysisResult::add_issue(const wip::analysis::AnalysisIssue& issue) {
+    issues.add(issue);
+    false_positives.push_back(0);
+}
+
+std::vector<size_t> AnalysisResult::get_issues_by_severity(IssueSeverity severity) const {
+    std::vector<size_t> result;
+    for (size_t i = 0; i < issues.size(); ++i) {
+        if (this->severity(i) == severity) {
+            result.push_back(i);
         }
     }
     return result;
@@ -69,8 +102,8 @@ std::vector<const AnalysisIssue*> AnalysisResult::get_issues_by_severity(IssueSe
 
 size_t AnalysisResult::count_by_severity(IssueSeverity severity) const {
     size_t count = 0;
-    for (const auto& issue : issues) {
-        if (issue.severity == severity) {
+    for (size_t i = 0; i < issues.size(); ++i) {
+        if (this->severity(i) == severity) {
             count++;
         }
     }
@@ -78,15 +111,16 @@ size_t AnalysisResult::count_by_severity(IssueSeverity severity) const {
 }
 
 std::vector<std::string> AnalysisResult::get_affected_files() const {
-    std::set<std::string> unique_files;
-    for (const auto& issue : issues) {
-        unique_files.insert(issue.file);
+    std::set<std::string_view> unique_files;
+    for (size_t i = 0; i < issues.size(); ++i) {
+        unique_files.insert(issues[i].file_path());
     }
     return std::vector<std::string>(unique_files.begin(), unique_files.end());
 }
 
 void AnalysisResult::clear() {
     issues.clear();
+    false_positives.clear();
     source_path.clear();
     timestamp.clear();
     total_files_analyzed = 0;
@@ -94,166 +128,156 @@ void AnalysisResult::clear() {
     error_message.clear();
 }
 
-namespace analysis_parser {
+bool IssueViewOptions::operator==(const IssueViewOptions& other) const {
+    return filter_text == other.filter_text && show_severity == other.show_severity &&
+           show_false_positives == other.show_false_positives && sort_column == other.sort_column &&
+           sort_ascending == other.sort_ascending;
+}
 
-// Simple JSON value extraction - finds value after "key": in JSON line
-std::string extract_json_string_value(const std::string& line, const std::string& key) {
-    std::string search_key = "\"" + key + "\":";
-    size_t pos = line.find(search_key);
-    if (pos == std::string::npos) return "";
-    
-    pos += search_key.length();
-    
-    // Skip whitespace
-    while (pos < line.length() && std::isspace(line[pos])) pos++;
+IssueTextMatcher::IssueTextMatcher(const AnalysisResult& result, const std::string& filter,
+                                   const wip::analysis::IssueSearchIndex* search_index)
+    : result_(result), filter_(filter) {
+    if (filter_.empty()) {
+        return;
+    }
     
-    if (pos >= line.length()) return "";
+    // A severity name matching the filter matches every issue of that severity
+    for (size_t i = 0; i < severity_matches_.size(); ++i) {
+        severity_matches_[i] = contains_ignore_case(severity_string(static_cast<IssueSeverity>(i)), filter_);
+    }
     
-    if (line[pos] == '"') {
-        // String value
-        pos++; // Skip opening quote
-        size_t end_pos = pos;
-        while (end_pos < line.length() && line[end_pos] != '"') {
-            if (line[end_pos] == '\\') end_pos++; // Skip escaped character
-            end_pos++;
+    if (search_index) {
+        indexed_matches_.resize(std::min(search_index->get_issue_count(), result.size()), 0);
+        for (uint32_t issue : search_index->find(filter_)) {
+            if (issue < indexed_matches_.size()) {
+                indexed_matches_[issue] = 1;
+            }
         }
-        if (end_pos < line.length()) {
-            return line.substr(pos, end_pos - pos);
-        }
-    } else {
-        // Numeric value
-        size_t end_pos = pos;
-        while (end_pos < line.length() && (std::isdigit(line[end_pos]) || line[end_pos] == '-')) {
-            end_pos++;
-        }
-        return line.substr(pos, end_pos - pos);
     }
-    
-    return "";
 }
 
-int extract_json_int_value(const std::string& line, const std::string& key) {
-    std::string value = extract_json_string_value(line, key);
-    if (value.empty()) return 0;
+bool IssueTextMatcher::matches(size_t index) const {
+    if (filter_.empty() || severity_matches_[static_cast<size_t>(result_.severity(index))]) {
+        return true;
+    }
+    if (index < indexed_matches_.size()) {
+        return indexed_matches_[index] != 0;
+    }
+    return matches_filter(result_.issue(index), filter_);
+}
+
+bool IssueViewOptions::accepts(const AnalysisResult& result, size_t index, const IssueTextMatcher& text) const {
+    if (!show_severity[static_cast<size_t>(result.severity(index))]) return false;
     
-    try {
-        return std::stoi(value);
-    } catch (...) {
-        return 0;
+    // Filter by false positive status
+    if (result.is_false_positive(index) && !show_false_positives) return false;
+    
+    // Filter by text
+    return text.matches(index);
+}
+
+std::vector<size_t> IssueViewOptions::select(const AnalysisResult& result, const std::vector<size_t>& issues,
+                                             const wip::analysis::IssueSearchIndex* search_index) const {
+    IssueTextMatcher text(result, filter_text, search_index);
+    std::vector<size_t> selected;
+    selected.reserve(issues.size());
+    for (size_t index : issues) {
+        if (accepts(result, index, text)) {
+            selected.push_back(index);
+        }
     }
+    return selected;
 }
 
-// Parse the current cppcheck format: {file:/path,line:123,column:45,severity:style,id:shadowFunction,message:text,cwe:398}
-bool parse_cppcheck_format(const std::string& line, AnalysisIssue& issue) {
-    // Use regex to parse the format
-    // Pattern: {file:([^,]+),line:(\d+),column:(\d+),severity:([^,]+),id:([^,]+),message:([^,]+),cwe:(\d+)}
-    std::regex pattern(R"(\{file:([^,]+),line:(\d+),column:(\d+),severity:([^,]+),id:([^,]+),message:([^,}]+),cwe:(\d+)\})");
-    std::smatch match;
+bool IssueViewOptions::less(const AnalysisResult& result, size_t a, size_t b) const {
+    // Descending order compares the other way round, which keeps the ordering strict
+    IssueView first = result.issue(sort_ascending ? a : b);
+    IssueView second = result.issue(sort_ascending ? b : a);
     
-    if (std::regex_match(line, match, pattern) && match.size() == 8) {
-        issue.file = match[1].str();
-        issue.line = std::stoi(match[2].str());
-        issue.column = std::stoi(match[3].str());
-        issue.severity = string_to_severity(match[4].str());
-        issue.id = match[5].str();
-        issue.message = match[6].str();
-        issue.cwe = std::stoi(match[7].str());
-        
-        return !issue.file.empty() && issue.line > 0 && !issue.id.empty();
+    int order = 0;
+    switch (sort_column) {
+        case 0: // File
+            order = first.file_path().compare(second.file_path());
+            break;
+        case 1: // Line
+            order = first.line_number() - second.line_number();
+            break;
+        case 2: // Column
+            order = first.column_number() - second.column_number();
+            break;
+        case 3: // Severity
+            order = static_cast<int>(display_severity(first)) - static_cast<int>(display_severity(second));
+            break;
+        case 4: // Message
+            order = first.message().compare(second.message());
+            break;
     }
     
-    return false;
+    // Equal keys keep the order the issues were reported in
+    return order != 0 ? order < 0 : a < b;
 }
 
-bool parse_issue_line(const std::string& json_line, AnalysisIssue& issue) {
-    // Handle both JSON format and the current cppcheck format
-    // Current format: {file:/path,line:123,column:45,severity:style,id:shadowFunction,message:text,cwe:398}
-    // Expected format: {"file":"path","line":123,"column":45,"severity":"error","id":"nullPointer","message":"text","cwe":476}
+std::shared_ptr<PreparedAnalysisResult> prepare_analysis_result(AnalysisResult result, const IssueViewOptions& options,
+                                                                 const std::string& false_positives_file) {
+    auto prepared = std::make_shared<PreparedAnalysisResult>();
+    prepared->result = std::move(result);
+    prepared->options = options;
     
-    if (json_line.empty() || json_line[0] != '{') {
-        return false;
+    const AnalysisResult& prepared_result = prepared->result;
+    try {
+        mark_false_positives(prepared->result, false_positives_file);
+    } catch (const std::exception& e) {
+        LOG_ERROR("GRAN_AZUL", "Error loading false positives: ", e.what());
     }
     
-    // Check if it's the current cppcheck format (no quotes around field names)
-    if (json_line.find("file:") != std::string::npos && json_line.find("\"file\"") == std::string::npos) {
-        // Parse the current cppcheck format
-        return parse_cppcheck_format(json_line, issue);
+    for (size_t i = 0; i < prepared_result.size(); ++i) {
+        ++prepared->severity_counts[static_cast<size_t>(prepared_result.severity(i))];
     }
+    prepared->search_index = std::make_shared<const wip::analysis::IssueSearchIndex>(prepared_result.issues);
     
-    // Extract fields for standard JSON format
-    issue.file = extract_json_string_value(json_line, "file");
-    issue.line = extract_json_int_value(json_line, "line");
-    issue.column = extract_json_int_value(json_line, "column");
-    issue.id = extract_json_string_value(json_line, "id");
-    issue.message = extract_json_string_value(json_line, "message");
-    issue.cwe = extract_json_int_value(json_line, "cwe");
-    
-    std::string severity_str = extract_json_string_value(json_line, "severity");
-    issue.severity = string_to_severity(severity_str);
-    
-    // Validate that we got the essential fields
-    return !issue.file.empty() && issue.line > 0 && !issue.id.empty();
+    // Every issue is sorted, so later filter changes only have to select from the order
+    prepared->sorted_issues.resize(prepared_result.size());
+    for (size_t i = 0; i < prepared_result.size(); ++i) {
+        prepared->sorted_issues[i] = i;
+    }
+    std::sort(prepared->sorted_issues.begin(), prepared->sorted_issues.end(),
+              [&](size_t a, size_t b) { return options.less(prepared_result, a, b); });
+    prepared->visible_issues = options.select(prepared_result, prepared->sorted_issues, prepared->search_index.get());
+    return prepared;
 }
 
-bool parse_analysis_file(const std::string& file_path, AnalysisResult& result) {
-    result.clear();
+bool mark_false_positives(AnalysisResult& result, const std::string& false_positives_file) {
+    if (!std::filesystem::exists(false_positives_file)) {
+        return true; // No false positives file exists yet
+    }
     
-    std::ifstream file(file_path);
+    std::ifstream file(false_positives_file);
     if (!file.is_open()) {
-        result.error_message = "Could not open analysis file: " + file_path;
         return false;
     }
     
-    std::string line;
-    int parsed_issues = 0;
-    
-    while (std::getline(file, line)) {
-        // Skip empty lines
-        if (line.empty()) continue;
-        
-        AnalysisIssue issue;
-        if (parse_issue_line(line, issue)) {
-            result.issues.push_back(issue);
-            parsed_issues++;
-        }
+    nlohmann::json j;
+    file >> j;
+    if (!j.is_array()) {
+        return false;
     }
     
-    file.close();
-    
-    // Set result metadata
-    result.analysis_successful = true;
-    
-    // Get current timestamp
-    auto now = std::time(nullptr);
-    auto tm = *std::localtime(&now);
-    std::ostringstream oss;
-    oss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S");
-    result.timestamp = oss.str();
-    
-    // Count unique files
-    std::set<std::string> unique_files;
-    for (const auto& issue : result.issues) {
-        unique_files.insert(issue.file);
+    // Index the entries by location and id, then look every issue up once
+    std::unordered_set<std::string> false_positives;
+    false_positives.reserve(j.size());
+    for (const auto& fp_item : j) {
+        false_positives.insert(false_positive_key(fp_item["file"].get<std::string>(), fp_item["line"],
+                                                  fp_item["column"], fp_item["id"].get<std::string>()));
     }
-    result.total_files_analyzed = static_cast<int>(unique_files.size());
-    
-    return parsed_issues > 0;
-}
-
-IssueSeverity string_to_severity(const std::string& severity_str) {
-    std::string lower_str = severity_str;
-    std::transform(lower_str.begin(), lower_str.end(), lower_str.begin(), ::tolower);
-    
-    if (lower_str == "error") return IssueSeverity::ERROR;
-    if (lower_str == "warning") return IssueSeverity::WARNING;
-    if (lower_str == "style") return IssueSeverity::STYLE;
-    if (lower_str == "performance") return IssueSeverity::PERFORMANCE;
-    if (lower_str == "portability") return IssueSeverity::PORTABILITY;
-    if (lower_str == "information") return IssueSeverity::INFORMATION;
     
-    return IssueSeverity::INFORMATION; // Default
+    for (size_t i = 0; i < result.size(); ++i) {
+        IssueView issue = result.issue(i);
+        if (false_positives.count(false_positive_key(issue.file_path(), issue.line_number(), issue.column_number(),
+                                                     issue.rule_id()))) {
+            result.false_positives[i] = 1;
+        }
+    }
+    return true;
 }
 
-} // namespace analysis_parser
-
 } // namespace gran_azul::widgets
\ No newline at end of file
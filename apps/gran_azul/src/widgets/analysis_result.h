@@ -1,82 +1,138 @@
 #pragma once
 
+#include <issue_search_index.h>
+#include <issue_store.h>
+#include <array>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace gran_azul::widgets {
 
-// Severity levels for analysis issues
+// Issue of the analysis library as the results panel reads it, straight from the store
+using IssueView = wip::analysis::IssueStore::IssueView;
+
+// Severity levels the results panel groups issues by
 enum class IssueSeverity {
     ERROR,
-    WARNING, 
+    WARNING,
     STYLE,
     PERFORMANCE,
     PORTABILITY,
     INFORMATION
 };
 
-// Represents a single analysis issue found by cppcheck
-struct AnalysisIssue {
-    std::string file;           // File path where issue was found
-    int line;                   // Line number (1-based)
-    int column;                 // Column number (1-based)
-    IssueSeverity severity;     // Issue severity level
-    std::string id;             // Cppcheck rule ID (e.g., "nullPointer")
-    std::string message;        // Human readable description
-    int cwe;                    // Common Weakness Enumeration ID (0 if none)
-    bool false_positive;        // Whether this issue is marked as false positive
-    
-    AnalysisIssue() : line(0), column(0), severity(IssueSeverity::INFORMATION), cwe(0), false_positive(false) {}
-    
-    // Convert severity enum to string for display
-    std::string severity_string() const;
-    
-    // Get severity color for UI display (RGBA values 0.0-1.0)  
-    struct Color { float r, g, b, a; };
-    Color severity_color() const;
-    
-    // Check if this issue matches a text filter
-    bool matches_filter(const std::string& filter) const;
-};
+// Severity color for UI display (RGBA values 0.0-1.0)
+struct SeverityColor { float r, g, b, a; };
+
+// Display severity of a library issue: errors and warnings keep their level,
+// informational issues are grouped by category
+IssueSeverity display_severity(wip::analysis::IssueSeverity severity, wip::analysis::IssueCategory category);
+inline IssueSeverity display_severity(const IssueView& issue) {
+    return display_severity(issue.severity(), issue.category());
+}
+
+// Convert severity enum to string for display
+const char* severity_string(IssueSeverity severity);
+SeverityColor severity_color(IssueSeverity severity);
+
+// Check if an issue matches a text filter (case insensitive)
+bool matches_filter(const IssueView& issue, std::string_view filter);
 
 // Represents the complete analysis results
+//
+// Issues are kept in the analysis library's column store, so results are shown
+// without converting them; only the false positive flags are the panel's own.
 struct AnalysisResult {
-    std::vector<AnalysisIssue> issues;
+    wip::analysis::IssueStore issues;
+    std::vector<uint8_t> false_positives;   // Per issue: 1 if marked as false positive
     std::string source_path;        // Path that was analyzed
     std::string timestamp;          // When analysis was performed
     int total_files_analyzed;       // Number of files processed
     bool analysis_successful;       // Whether analysis completed without errors
     std::string error_message;      // Error message if analysis failed
-    
+
     AnalysisResult() : total_files_analyzed(0), analysis_successful(false) {}
-    
-    // Get issues filtered by severity
-    std::vector<const AnalysisIssue*> get_issues_by_severity(IssueSeverity severity) const;
-    
+
+    // Add an issue reported by the analysis library
+    void add_issue(const wip::analysis::AnalysisIssue& issue);
+
+    size_t size() const { return issues.size(); }
+    bool empty() const { return issues.empty(); }
+    IssueView issue(size_t index) const { return issues[index]; }
+    IssueSeverity severity(size_t index) const { return display_severity(issues[index]); }
+    bool is_false_positive(size_t index) const { return false_positives[index] != 0; }
+
+    // Get indices of the issues with a severity
+    std::vector<size_t> get_issues_by_severity(IssueSeverity severity) const;
+
     // Get issue count by severity
     size_t count_by_severity(IssueSeverity severity) const;
-    
+
     // Get unique files with issues
     std::vector<std::string> get_affected_files() const;
-    
+
     // Clear all results
     void clear();
 };
 
-// Utility functions for parsing cppcheck JSON output
-namespace analysis_parser {
+// Text filter of the issues table; the issues a search index covers are looked up in it,
+// later ones are checked one by one
+class IssueTextMatcher {
+public:
+    IssueTextMatcher(const AnalysisResult& result, const std::string& filter,
+                     const wip::analysis::IssueSearchIndex* search_index);
     
-    // Parse the current cppcheck format
-    bool parse_cppcheck_format(const std::string& line, AnalysisIssue& issue);
+    bool matches(size_t index) const;
     
-    // Parse a single JSON line from cppcheck output
-    bool parse_issue_line(const std::string& json_line, AnalysisIssue& issue);
-    
-    // Parse complete cppcheck output file and populate result
-    bool parse_analysis_file(const std::string& file_path, AnalysisResult& result);
+private:
+    const AnalysisResult& result_;
+    std::string_view filter_;
+    std::array<bool, 6> severity_matches_{};    // Severity names containing the filter
+    std::vector<uint8_t> indexed_matches_;      // Per issue covered by the index
+};
+
+// Filter and sort settings of the issues table
+struct IssueViewOptions {
+    std::string filter_text;
+    std::array<bool, 6> show_severity = {true, true, true, true, true, true}; // Indexed by IssueSeverity
+    bool show_false_positives = false; // Hide false positives by default
+    int sort_column = 0;               // 0=file, 1=line, 2=column, 3=severity, 4=message
+    bool sort_ascending = true;
+
+    bool operator==(const IssueViewOptions& other) const;
+    bool operator!=(const IssueViewOptions& other) const { return !(*this == other); }
+
+    // Whether issue `index` of a result passes the filters
+    bool accepts(const AnalysisResult& result, size_t index, const IssueTextMatcher& text) const;
     
-    // Convert severity string to enum
-    IssueSeverity string_to_severity(const std::string& severity_str);
-}
+    // Issues of `issues` that pass the filters, in the same order
+    std::vector<size_t> select(const AnalysisResult& result, const std::vector<size_t>& issues,
+                               const wip::analysis::IssueSearchIndex* search_index) const;
+
+    // Row order of issues a and b; equal keys keep the reported order
+    bool less(const AnalysisResult& result, size_t a, size_t b) const;
+};
+
+// A result with everything the results panel needs to show it, built off the UI
+// thread so the panel only has to take it over
+struct PreparedAnalysisResult {
+    AnalysisResult result;
+    IssueViewOptions options;                   // Options the indices were built with
+    std::vector<size_t> sorted_issues;          // Every index into result.issues, sorted
+    std::vector<size_t> visible_issues;         // The sorted indices that pass the filters
+    std::shared_ptr<const wip::analysis::IssueSearchIndex> search_index; // Over result.issues
+    std::array<size_t, 6> severity_counts{};    // Indexed by IssueSeverity
+};
+
+// Mark the false positives saved in false_positives_file, count the severities, build
+// the search index and sort and filter the issues for options; safe to call on any thread
+std::shared_ptr<PreparedAnalysisResult> prepare_analysis_result(AnalysisResult result, const IssueViewOptions& options,
+                                                                 const std::string& false_positives_file);
+
+// Mark the issues listed in a false positives file; returns false if it can't be read
+bool mark_false_positives(AnalysisResult& result, const std::string& false_positives_file);
 
-} // namespace gran_azul::widgets
\ No newline at end of file
+} // namespace gran_azul::widgets
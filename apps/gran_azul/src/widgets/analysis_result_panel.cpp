@@ -1,13 +1,45 @@
 #include "analysis_result_panel.h"
 #include <imgui.h>
 #include <algorithm>
+#include <charconv>
 #include <filesystem>
 #include <fstream>
-#include <iostream>
+#include <log.h>
 #include <nlohmann/json.hpp>
 
 namespace gran_azul::widgets {
 
+namespace {
+
+constexpr const char* FALSE_POSITIVE_PREFIX = "[FP] ";
+
+// Badge label of a false positive, e.g. "[FP] Error"
+const char* false_positive_badge_label(IssueSeverity severity) {
+    static const std::array<std::string, 6> labels = [] {
+        std::array<std::string, 6> result;
+        for (size_t i = 0; i < result.size(); ++i) {
+            result[i] = std::string(FALSE_POSITIVE_PREFIX) + severity_string(static_cast<IssueSeverity>(i));
+        }
+        return result;
+    }();
+    return labels[static_cast<size_t>(severity)].c_str();
+}
+
+} // namespace
+
+struct AnalysisResultPanel::RowStyle {
+    std::array<ImU32, 6> badge_colors;             // Indexed by IssueSeverity
+    std::array<float, 6> badge_widths;
+    std::array<float, 6> false_positive_badge_widths;
+    ImU32 text_color;
+    ImU32 muted_color;                             // False positives are grayed out
+    ImU32 false_positive_badge_color;
+    float false_positive_prefix_width;
+    float badge_padding;
+    float badge_rounding;
+    float row_height;
+};
+
 AnalysisResultPanel::AnalysisResultPanel(const std::string& title) 
     : Panel(title) {
     // Initialize with reasonable default size
@@ -19,7 +51,7 @@ void AnalysisResultPanel::update(float delta_time) {
 }
 
 void AnalysisResultPanel::draw_content() {
-    if (result_.issues.empty() && result_.analysis_successful) {
+    if (result_.empty() && result_.analysis_successful) {
         ImGui::TextColored(ImVec4(0.2f, 0.8f, 0.2f, 1.0f), "✓ No issues found!");
         ImGui::Text("Analysis completed successfully with no problems detected.");
         return;
@@ -31,7 +63,7 @@ void AnalysisResultPanel::draw_content() {
         return;
     }
     
-    if (result_.issues.empty()) {
+    if (result_.empty()) {
         ImGui::Text("No analysis results available.");
         ImGui::Text("Run cppcheck analysis to see results here.");
         return;
@@ -55,39 +87,35 @@ void AnalysisResultPanel::render_summary() {
     ImGui::Columns(6, "SummaryColumns", false);
     
     // Error count
-    auto error_count = result_.count_by_severity(IssueSeverity::ERROR);
-    AnalysisIssue error_issue;
-    error_issue.severity = IssueSeverity::ERROR;
-    auto error_color = error_issue.severity_color();
+    auto error_count = severity_counts_[static_cast<size_t>(IssueSeverity::ERROR)];
+    auto error_color = severity_color(IssueSeverity::ERROR);
     ImGui::TextColored(ImVec4(error_color.r, error_color.g, error_color.b, error_color.a), 
                       "Errors: %zu", error_count);
     
     ImGui::NextColumn();
     
     // Warning count
-    auto warning_count = result_.count_by_severity(IssueSeverity::WARNING);
-    AnalysisIssue warning_issue;
-    warning_issue.severity = IssueSeverity::WARNING;
-    auto warning_color_struct = warning_issue.severity_color();
+    auto warning_count = severity_counts_[static_cast<size_t>(IssueSeverity::WARNING)];
+    auto warning_color_struct = severity_color(IssueSeverity::WARNING);
     auto warning_color = ImVec4(warning_color_struct.r, warning_color_struct.g, warning_color_struct.b, warning_color_struct.a);
     ImGui::TextColored(warning_color, "Warnings: %zu", warning_count);
     
     ImGui::NextColumn();
     
     // Style count  
-    auto style_count = result_.count_by_severity(IssueSeverity::STYLE);
+    auto style_count = severity_counts_[static_cast<size_t>(IssueSeverity::STYLE)];
     ImGui::Text("Style: %zu", style_count);
     
     ImGui::NextColumn();
     
     // Performance count
-    auto perf_count = result_.count_by_severity(IssueSeverity::PERFORMANCE);
+    auto perf_count = severity_counts_[static_cast<size_t>(IssueSeverity::PERFORMANCE)];
     ImGui::Text("Performance: %zu", perf_count);
     
     ImGui::NextColumn();
     
     // Total issues
-    ImGui::Text("Total Issues: %zu", result_.issues.size());
+    ImGui::Text("Total Issues: %zu", result_.size());
     
     ImGui::NextColumn();
     
@@ -102,7 +130,10 @@ void AnalysisResultPanel::render_filters() {
     
     // Text filter
     ImGui::PushItemWidth(200);
-    ImGui::InputText("##filter", filter_text_, sizeof(filter_text_));
+    if (ImGui::InputText("##filter", filter_text_, sizeof(filter_text_))) {
+        options_.filter_text = filter_text_;
+        invalidate_filter();
+    }
     ImGui::PopItemWidth();
     ImGui::SameLine();
     ImGui::Text("Search");
@@ -114,31 +145,31 @@ void AnalysisResultPanel::render_filters() {
     // Severity filters
     ImGui::Text("Show:");
     ImGui::SameLine();
-    ImGui::Checkbox("Errors##filter", &show_errors_);
+    if (ImGui::Checkbox("Errors##filter", &options_.show_severity[static_cast<size_t>(IssueSeverity::ERROR)])) invalidate_filter();
     ImGui::SameLine();
-    ImGui::Checkbox("Warnings##filter", &show_warnings_);
+    if (ImGui::Checkbox("Warnings##filter", &options_.show_severity[static_cast<size_t>(IssueSeverity::WARNING)])) invalidate_filter();
     ImGui::SameLine();
-    ImGui::Checkbox("Style##filter", &show_style_);
+    if (ImGui::Checkbox("Style##filter", &options_.show_severity[static_cast<size_t>(IssueSeverity::STYLE)])) invalidate_filter();
     ImGui::SameLine();
-    ImGui::Checkbox("Performance##filter", &show_performance_);
+    if (ImGui::Checkbox("Performance##filter", &options_.show_severity[static_cast<size_t>(IssueSeverity::PERFORMANCE)])) invalidate_filter();
     ImGui::SameLine();
-    ImGui::Checkbox("Portability##filter", &show_portability_);
+    if (ImGui::Checkbox("Portability##filter", &options_.show_severity[static_cast<size_t>(IssueSeverity::PORTABILITY)])) invalidate_filter();
     ImGui::SameLine();
-    ImGui::Checkbox("Info##filter", &show_information_);
+    if (ImGui::Checkbox("Info##filter", &options_.show_severity[static_cast<size_t>(IssueSeverity::INFORMATION)])) invalidate_filter();
     
     // New line for false positive filter
     ImGui::SameLine();
     ImGui::Dummy(ImVec2(20, 0)); // Spacing
     ImGui::SameLine();
-    ImGui::Checkbox("False Positives##filter", &show_false_positives_);
+    if (ImGui::Checkbox("False Positives##filter", &options_.show_false_positives)) invalidate_filter();
 }
 
 void AnalysisResultPanel::render_issues_table() {
-    auto filtered_issues = get_filtered_issues();
+    update_index();
     
-    ImGui::Text("Issues (%zu)", filtered_issues.size());
+    ImGui::Text("Issues (%zu)", visible_issues_.size());
     
-    if (filtered_issues.empty()) {
+    if (visible_issues_.empty()) {
         ImGui::Text("No issues match current filters.");
         return;
     }
@@ -150,7 +181,11 @@ void AnalysisResultPanel::render_issues_table() {
                                        ImGuiTableFlags_BordersInnerH |
                                        ImGuiTableFlags_RowBg;
     
-    if (ImGui::BeginTable("IssuesTable", 5, table_flags)) {
+    // Leave room for the source preview of the selected issue
+    const bool show_preview = selected_issue_ != NO_SELECTION;
+    const ImVec2 table_size(0.0f, show_preview ? -SourcePreview::get_height() : 0.0f);
+    
+    if (ImGui::BeginTable("IssuesTable", 5, table_flags, table_size)) {
         // Setup columns
         ImGui::TableSetupColumn("File", ImGuiTableColumnFlags_WidthFixed, 200.0f);
         ImGui::TableSetupColumn("Line", ImGuiTableColumnFlags_WidthFixed, 60.0f);
@@ -162,231 +197,290 @@ void AnalysisResultPanel::render_issues_table() {
         // Headers with sorting
         ImGui::TableHeadersRow();
         
-        // Handle sorting
+        // Handle sorting: the index is only re-sorted when the user changes the sort order
         if (ImGuiTableSortSpecs* sort_specs = ImGui::TableGetSortSpecs()) {
             if (sort_specs->SpecsDirty) {
                 if (sort_specs->SpecsCount > 0) {
-                    sort_column_ = sort_specs->Specs[0].ColumnIndex;
-                    sort_ascending_ = sort_specs->Specs[0].SortDirection == ImGuiSortDirection_Ascending;
-                    sort_issues(const_cast<std::vector<const AnalysisIssue*>&>(filtered_issues));
+                    int sort_column = sort_specs->Specs[0].ColumnIndex;
+                    bool sort_ascending = sort_specs->Specs[0].SortDirection == ImGuiSortDirection_Ascending;
+                    if (sort_column != options_.sort_column || sort_ascending != options_.sort_ascending) {
+                        options_.sort_column = sort_column;
+                        options_.sort_ascending = sort_ascending;
+                        invalidate_order();
+                        update_index();
+                    }
                 }
                 sort_specs->SpecsDirty = false;
             }
         }
         
-        // Render rows
-        for (size_t i = 0; i < filtered_issues.size(); ++i) {
-            render_issue_row(*filtered_issues[i], static_cast<int>(i));
+        // Colors and label sizes are the same for every row of the frame
+        const ImGuiStyle& imgui_style = ImGui::GetStyle();
+        RowStyle row_style;
+        row_style.text_color = ImGui::GetColorU32(ImGuiCol_Text);
+        row_style.muted_color = ImGui::ColorConvertFloat4ToU32(ImVec4(0.5f, 0.5f, 0.5f, 1.0f));
+        row_style.false_positive_badge_color = ImGui::ColorConvertFloat4ToU32(ImVec4(0.3f, 0.3f, 0.3f, 1.0f));
+        row_style.false_positive_prefix_width = ImGui::CalcTextSize(FALSE_POSITIVE_PREFIX).x;
+        row_style.badge_padding = imgui_style.FramePadding.x;
+        row_style.badge_rounding = imgui_style.FrameRounding;
+        row_style.row_height = ImGui::GetTextLineHeight();
+        for (size_t i = 0; i < row_style.badge_colors.size(); ++i) {
+            auto severity = static_cast<IssueSeverity>(i);
+            auto color = severity_color(severity);
+            row_style.badge_colors[i] = ImGui::ColorConvertFloat4ToU32(ImVec4(color.r, color.g, color.b, color.a));
+            row_style.badge_widths[i] = ImGui::CalcTextSize(severity_string(severity)).x + 2.0f * row_style.badge_padding;
+            row_style.false_positive_badge_widths[i] =
+                ImGui::CalcTextSize(false_positive_badge_label(severity)).x + 2.0f * row_style.badge_padding;
+        }
+        
+        // Render only the rows that are scrolled into view
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(visible_issues_.size()), row_style.row_height + imgui_style.CellPadding.y * 2.0f);
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                render_issue_row(static_cast<size_t>(row), row_style);
+            }
         }
         
         ImGui::EndTable();
     }
+    
+    if (show_preview) {
+        IssueView issue = result_.issue(selected_issue_);
+        source_preview_.draw(issue.file_path(), issue.line_number());
+    }
 }
 
-void AnalysisResultPanel::render_issue_row(const AnalysisIssue& issue, int index) {
-    ImGui::TableNextRow();
+void AnalysisResultPanel::render_issue_row(size_t row, const RowStyle& style) {
+    const size_t issue_index = visible_issues_[row];
+    IssueView issue = result_.issue(issue_index);
+    const bool false_positive = result_.is_false_positive(issue_index);
+    const IssueSeverity severity = display_severity(issue);
+    const ImU32 text_color = false_positive ? style.muted_color : style.text_color;
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
     
-    // File column (clickable)
-    ImGui::TableNextColumn();
-    std::string file_name = std::filesystem::path(issue.file).filename().string();
+    ImGui::TableNextRow();
     
-    // Add visual indicator for false positives
-    if (issue.false_positive) {
-        ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.5f, 0.5f, 0.5f, 1.0f)); // Gray out false positives
-        file_name = "[FP] " + file_name;
-    }
+    // Scope the row's widget ID by the issue so rows never collide
+    ImGui::PushID(static_cast<int>(issue_index));
     
-    // Create unique ID for this selectable using index to avoid ID collisions
-    std::string selectable_id = file_name + "##issue_" + std::to_string(index);
-    if (ImGui::Selectable(selectable_id.c_str(), false, ImGuiSelectableFlags_SpanAllColumns)) {
-        if (on_file_open_) {
-            on_file_open_(issue.file, issue.line, issue.column);
+    // File column: the row's only widget, spanning all columns
+    ImGui::TableNextColumn();
+    ImVec2 pos = ImGui::GetCursorScreenPos();
+    const ImGuiSelectableFlags row_flags = ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowDoubleClick;
+    if (ImGui::Selectable("##row", issue_index == selected_issue_, row_flags, ImVec2(0.0f, style.row_height))) {
+        select_issue(row);
+        if (ImGui::IsMouseDoubleClicked(0) && on_file_open_) {
+            on_file_open_(std::string(issue.file_path()), issue.line_number(), issue.column_number());
         }
     }
     if (ImGui::IsItemHovered()) {
-        ImGui::SetTooltip("Click to open: %s:%d:%d", issue.file.c_str(), issue.line, issue.column);
-    }
-    
-    if (issue.false_positive) {
-        ImGui::PopStyleColor(); // Restore original text color
+        // Show the full message over the message column, the location elsewhere
+        if (ImGui::TableGetColumnFlags(4) & ImGuiTableColumnFlags_IsHovered) {
+            std::string_view message = issue.message();
+            ImGui::SetTooltip("%.*s", static_cast<int>(message.size()), message.data());
+        } else {
+            std::string_view file_path = issue.file_path();
+            ImGui::SetTooltip("Click to preview, double-click to open: %.*s:%d:%d", static_cast<int>(file_path.size()), file_path.data(),
+                              issue.line_number(), issue.column_number());
+        }
     }
     
     // Context menu for false positive management
-    std::string popup_id = "IssueContextMenu##" + std::to_string(index);
-    if (ImGui::BeginPopupContextItem(popup_id.c_str())) {
-        if (issue.false_positive) {
+    if (ImGui::BeginPopupContextItem("IssueContextMenu")) {
+        if (false_positive) {
             if (ImGui::MenuItem("Unmark as False Positive")) {
-                // Find and update the issue in result_
-                for (auto& result_issue : result_.issues) {
-                    if (result_issue.file == issue.file && 
-                        result_issue.line == issue.line && 
-                        result_issue.column == issue.column &&
-                        result_issue.id == issue.id) {
-                        result_issue.false_positive = false;
-                        save_false_positives(); // Auto-save changes
-                        break;
-                    }
-                }
+                set_false_positive(issue_index, false);
             }
         } else {
             if (ImGui::MenuItem("Mark as False Positive")) {
-                // Find and update the issue in result_
-                for (auto& result_issue : result_.issues) {
-                    if (result_issue.file == issue.file && 
-                        result_issue.line == issue.line && 
-                        result_issue.column == issue.column &&
-                        result_issue.id == issue.id) {
-                        result_issue.false_positive = true;
-                        save_false_positives(); // Auto-save changes
-                        break;
-                    }
-                }
+                set_false_positive(issue_index, true);
             }
         }
         ImGui::EndPopup();
     }
     
-    // Line column
-    ImGui::TableNextColumn();
-    if (issue.false_positive) {
-        ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.5f, 0.5f, 0.5f, 1.0f));
+    const std::string& file_label = get_file_label(issue.file_path());
+    if (false_positive) {
+        draw_list->AddText(pos, text_color, FALSE_POSITIVE_PREFIX);
+        pos.x += style.false_positive_prefix_width;
     }
-    ImGui::Text("%d", issue.line);
-    if (issue.false_positive) {
-        ImGui::PopStyleColor();
+    draw_list->AddText(pos, text_color, file_label.data(), file_label.data() + file_label.size());
+    
+    // Line and column
+    char number[16];
+    for (int value : {issue.line_number(), issue.column_number()}) {
+        ImGui::TableNextColumn();
+        auto end = std::to_chars(number, number + sizeof(number), value).ptr;
+        draw_list->AddText(ImGui::GetCursorScreenPos(), text_color, number, end);
     }
     
-    // Column column
+    // Severity badge, gray for false positives
     ImGui::TableNextColumn();
-    if (issue.false_positive) {
-        ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.5f, 0.5f, 0.5f, 1.0f));
-    }
-    ImGui::Text("%d", issue.column);
-    if (issue.false_positive) {
-        ImGui::PopStyleColor();
-    }
-    
-    // Severity column with colored badge
+    pos = ImGui::GetCursorScreenPos();
+    const size_t severity_index = static_cast<size_t>(severity);
+    const char* badge_label = false_positive ? false_positive_badge_label(severity) : severity_string(severity);
+    float badge_width = false_positive ? style.false_positive_badge_widths[severity_index] : style.badge_widths[severity_index];
+    draw_list->AddRectFilled(pos, ImVec2(pos.x + badge_width, pos.y + style.row_height),
+                             false_positive ? style.false_positive_badge_color : style.badge_colors[severity_index],
+                             style.badge_rounding);
+    draw_list->AddText(ImVec2(pos.x + style.badge_padding, pos.y), style.text_color, badge_label);
+    
+    // Message column: a single line keeps every row the same height, as the clipper requires
     ImGui::TableNextColumn();
-    if (issue.false_positive) {
-        // Draw a grayed-out version of the severity badge for false positives
-        ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.3f, 0.3f, 0.3f, 1.0f));
-        ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(0.35f, 0.35f, 0.35f, 1.0f));
-        ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4(0.25f, 0.25f, 0.25f, 1.0f));
-        AnalysisIssue temp_issue;
-        temp_issue.severity = issue.severity;
-        std::string button_id = "[FP] " + temp_issue.severity_string() + "##badge_" + std::to_string(index);
-        ImGui::SmallButton(button_id.c_str());
-        ImGui::PopStyleColor(3);
-    } else {
-        draw_severity_badge(issue.severity, index);
+    pos = ImGui::GetCursorScreenPos();
+    const std::string& rule_label = get_rule_label(issue.rule_id());
+    std::string_view message = issue.message();
+    draw_list->AddText(pos, text_color, rule_label.data(), rule_label.data() + rule_label.size());
+    pos.x += ImGui::CalcTextSize(rule_label.data(), rule_label.data() + rule_label.size()).x;
+    draw_list->AddText(pos, text_color, message.data(), message.data() + message.size());
+    
+    ImGui::PopID();
+}
+
+void AnalysisResultPanel::select_issue(size_t row) {
+    if (visible_issues_[row] == selected_issue_) {
+        return;
     }
-    
-    // Message column
-    ImGui::TableNextColumn();
-    if (issue.false_positive) {
-        ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.5f, 0.5f, 0.5f, 1.0f));
+    selected_issue_ = visible_issues_[row];
+    
+    // Load the files of the rows around the selection ahead, nearest first, so that
+    // clicking or scrolling through them shows their source right away
+    const char* previous_file = nullptr;
+    for (size_t distance = 1; distance <= PREFETCH_ROWS; ++distance) {
+        for (size_t neighbor : {row + distance, row - distance}) {
+            if (neighbor >= visible_issues_.size()) {
+                continue; // Also catches row - distance wrapping around
+            }
+            std::string_view file_path = result_.issue(visible_issues_[neighbor]).file_path();
+            if (file_path.data() != previous_file) {
+                source_preview_.prefetch(file_path);
+                previous_file = file_path.data();
+            }
+        }
     }
-    ImGui::TextWrapped("[%s] %s", issue.id.c_str(), issue.message.c_str());
-    if (issue.false_positive) {
-        ImGui::PopStyleColor();
+}
+
+const std::string& AnalysisResultPanel::get_file_label(std::string_view file_path) {
+    // Interned strings never move, so their address identifies them
+    auto [it, inserted] = file_labels_.try_emplace(file_path.data());
+    if (inserted) {
+        it->second = std::filesystem::path(file_path).filename().string();
     }
-    
-    // Show CWE in tooltip if available
-    if (ImGui::IsItemHovered() && issue.cwe > 0) {
-        ImGui::SetTooltip("CWE-%d: %s", issue.cwe, issue.message.c_str());
+    return it->second;
+}
+
+const std::string& AnalysisResultPanel::get_rule_label(std::string_view rule_id) {
+    auto [it, inserted] = rule_labels_.try_emplace(rule_id.data());
+    if (inserted) {
+        it->second.append("[").append(rule_id).append("] ");
     }
+    return it->second;
+}
+
+void AnalysisResultPanel::clear_row_labels() {
+    file_labels_.clear();
+    rule_labels_.clear();
 }
 
-std::vector<const AnalysisIssue*> AnalysisResultPanel::get_filtered_issues() const {
-    std::vector<const AnalysisIssue*> filtered;
-    
-    for (const auto& issue : result_.issues) {
-        // Filter by severity
-        bool show_severity = false;
-        switch (issue.severity) {
-            case IssueSeverity::ERROR: show_severity = show_errors_; break;
-            case IssueSeverity::WARNING: show_severity = show_warnings_; break;
-            case IssueSeverity::STYLE: show_severity = show_style_; break;
-            case IssueSeverity::PERFORMANCE: show_severity = show_performance_; break;
-            case IssueSeverity::PORTABILITY: show_severity = show_portability_; break;
-            case IssueSeverity::INFORMATION: show_severity = show_information_; break;
+void AnalysisResultPanel::update_index() {
+    const size_t issue_count = result_.size();
+    
+    if (order_dirty_ || sorted_issue_count_ > issue_count) {
+        sorted_issues_.clear();
+        sorted_issue_count_ = 0;
+        order_dirty_ = false;
+        filter_dirty_ = true;
+    }
+    
+    // Sort only the issues not in the order yet, then merge them into it
+    if (sorted_issue_count_ < issue_count) {
+        auto less = [this](size_t a, size_t b) { return options_.less(result_, a, b); };
+        std::vector<size_t> new_issues;
+        new_issues.reserve(issue_count - sorted_issue_count_);
+        for (size_t i = sorted_issue_count_; i < issue_count; ++i) {
+            new_issues.push_back(i);
         }
+        std::sort(new_issues.begin(), new_issues.end(), less);
         
-        if (!show_severity) continue;
-        
-        // Filter by false positive status
-        if (issue.false_positive && !show_false_positives_) continue;
-        
-        // Filter by text
-        if (!issue.matches_filter(filter_text_)) continue;
-        
-        filtered.push_back(&issue);
+        auto merge_into = [&less](std::vector<size_t>& rows, const std::vector<size_t>& sorted_rows) {
+            size_t middle = rows.size();
+            rows.insert(rows.end(), sorted_rows.begin(), sorted_rows.end());
+            std::inplace_merge(rows.begin(), rows.begin() + static_cast<std::ptrdiff_t>(middle), rows.end(), less);
+        };
+        merge_into(sorted_issues_, new_issues);
+        if (!filter_dirty_) {
+            merge_into(visible_issues_, options_.select(result_, new_issues, search_index_.get()));
+        }
+        sorted_issue_count_ = issue_count;
     }
     
-    // Sort the filtered results
-    auto mutable_filtered = filtered;  // Make a mutable copy for sorting
-    sort_issues(mutable_filtered);
-    
-    return mutable_filtered;
+    // Filters changed: select from the order, which needs no sorting
+    if (filter_dirty_) {
+        visible_issues_ = options_.select(result_, sorted_issues_, search_index_.get());
+        filter_dirty_ = false;
+    }
 }
 
-void AnalysisResultPanel::sort_issues(std::vector<const AnalysisIssue*>& issues) const {
-    std::sort(issues.begin(), issues.end(), [this](const AnalysisIssue* a, const AnalysisIssue* b) {
-        bool result = false;
-        
-        switch (sort_column_) {
-            case 0: // File
-                result = a->file < b->file;
-                break;
-            case 1: // Line
-                result = a->line < b->line;
-                break;
-            case 2: // Column  
-                result = a->column < b->column;
-                break;
-            case 3: // Severity
-                result = static_cast<int>(a->severity) < static_cast<int>(b->severity);
-                break;
-            case 4: // Message
-                result = a->message < b->message;
-                break;
-        }
-        
-        return sort_ascending_ ? result : !result;
-    });
+void AnalysisResultPanel::count_severities(size_t first_issue) {
+    for (size_t i = first_issue; i < result_.size(); ++i) {
+        ++severity_counts_[static_cast<size_t>(result_.severity(i))];
+    }
 }
 
-void AnalysisResultPanel::draw_severity_badge(IssueSeverity severity, int index) {
-    AnalysisIssue issue;
-    issue.severity = severity;
-    auto color = issue.severity_color();
-    
-    ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(color.r, color.g, color.b, color.a));
-    ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(color.r * 0.8f, color.g * 0.8f, color.b * 0.8f, color.a));
-    ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4(color.r * 0.6f, color.g * 0.6f, color.b * 0.6f, color.a));
-    
-    // Create unique ID for the button to avoid ID collisions
-    std::string button_id = issue.severity_string() + "##badge_" + std::to_string(index);
-    ImGui::SmallButton(button_id.c_str());
-    
-    ImGui::PopStyleColor(3);
+void AnalysisResultPanel::set_false_positive(size_t issue_index, bool false_positive) {
+    result_.false_positives[issue_index] = false_positive ? 1 : 0;
+    save_false_positives(); // Auto-save changes
+    invalidate_filter();
 }
 
-void AnalysisResultPanel::set_analysis_result(const AnalysisResult& result) {
-    result_ = result;
-    
-    // Load any existing false positive markings
-    load_false_positives();
+void AnalysisResultPanel::set_analysis_result(AnalysisResult result) {
+    set_prepared_result(std::move(*prepare_analysis_result(std::move(result), options_, get_false_positives_file_path())));
+}
+
+void AnalysisResultPanel::set_prepared_result(PreparedAnalysisResult&& prepared) {
+    // Everything is moved, so taking over a large result costs no copies
+    result_ = std::move(prepared.result);
+    clear_row_labels();
+    selected_issue_ = NO_SELECTION;
+    source_preview_.clear();
+    severity_counts_ = prepared.severity_counts;
+    sorted_issues_ = std::move(prepared.sorted_issues);
+    visible_issues_ = std::move(prepared.visible_issues);
+    search_index_ = std::move(prepared.search_index);
+    sorted_issue_count_ = result_.size();
+    order_dirty_ = prepared.options.sort_column != options_.sort_column ||
+                   prepared.options.sort_ascending != options_.sort_ascending;
+    filter_dirty_ = prepared.options != options_;
     
     // Auto-open panel when new results arrive with issues
-    if (!result.issues.empty()) {
+    if (!result_.empty()) {
         set_visible(true);
     }
 }
 
+void AnalysisResultPanel::append_issues(const std::vector<wip::analysis::AnalysisIssue>& issues) {
+    if (issues.empty()) {
+        return;
+    }
+    
+    // Only the new issues need sorting; update_index() merges them into the rows
+    size_t first_new = result_.size();
+    for (const auto& issue : issues) {
+        result_.add_issue(issue);
+    }
+    count_severities(first_new);
+    set_visible(true);
+}
+
 void AnalysisResultPanel::clear_results() {
     result_.clear();
+    clear_row_labels();
+    selected_issue_ = NO_SELECTION;
+    source_preview_.clear();
+    search_index_.reset();
+    severity_counts_.fill(0);
+    invalidate_order();
 }
 
 void AnalysisResultPanel::save_false_positives(const std::string& project_path) const {
@@ -396,14 +490,15 @@ void AnalysisResultPanel::save_false_positives(const std::string& project_path)
         nlohmann::json j = nlohmann::json::array();
         
         // Save only false positives with their identifying information
-        for (const auto& issue : result_.issues) {
-            if (issue.false_positive) {
+        for (size_t i = 0; i < result_.size(); ++i) {
+            if (result_.is_false_positive(i)) {
+                IssueView issue = result_.issue(i);
                 nlohmann::json fp_item;
-                fp_item["file"] = issue.file;
-                fp_item["line"] = issue.line;
-                fp_item["column"] = issue.column;
-                fp_item["id"] = issue.id;
-                fp_item["message"] = issue.message; // For additional verification
+                fp_item["file"] = issue.file_path();
+                fp_item["line"] = issue.line_number();
+                fp_item["column"] = issue.column_number();
+                fp_item["id"] = issue.rule_id();
+                fp_item["message"] = issue.message(); // For additional verification
                 j.push_back(fp_item);
             }
         }
@@ -413,58 +508,26 @@ void AnalysisResultPanel::save_false_positives(const std::string& project_path)
         if (file.is_open()) {
             file << j.dump(2); // Pretty print with 2-space indentation
             file.close();
-            std::cout << "[GRAN_AZUL] False positives saved to: " << fp_file << std::endl;
+            LOG_DEBUG("GRAN_AZUL", "False positives saved to: ", fp_file);
         }
     } catch (const std::exception& e) {
-        std::cerr << "[GRAN_AZUL] Error saving false positives: " << e.what() << std::endl;
+        LOG_ERROR("GRAN_AZUL", "Error saving false positives: ", e.what());
     }
 }
 
 void AnalysisResultPanel::load_false_positives(const std::string& project_path) {
     try {
         std::string fp_file = get_false_positives_file_path(project_path);
-        
-        if (!std::filesystem::exists(fp_file)) {
-            return; // No false positives file exists yet
-        }
-        
-        std::ifstream file(fp_file);
-        if (!file.is_open()) {
-            return;
-        }
-        
-        nlohmann::json j;
-        file >> j;
-        file.close();
-        
-        // Mark matching issues as false positives
-        if (j.is_array()) {
-            for (const auto& fp_item : j) {
-                std::string file_path = fp_item["file"];
-                int line = fp_item["line"];
-                int column = fp_item["column"];
-                std::string id = fp_item["id"];
-                
-                // Find matching issue in current results
-                for (auto& issue : result_.issues) {
-                    if (issue.file == file_path &&
-                        issue.line == line &&
-                        issue.column == column &&
-                        issue.id == id) {
-                        issue.false_positive = true;
-                        break;
-                    }
-                }
-            }
+        if (mark_false_positives(result_, fp_file)) {
+            LOG_DEBUG("GRAN_AZUL", "False positives loaded from: ", fp_file);
+            invalidate_filter();
         }
-        
-        std::cout << "[GRAN_AZUL] False positives loaded from: " << fp_file << std::endl;
     } catch (const std::exception& e) {
-        std::cerr << "[GRAN_AZUL] Error loading false positives: " << e.what() << std::endl;
+        LOG_ERROR("GRAN_AZUL", "Error loading false positives: ", e.what());
     }
 }
 
-std::string AnalysisResultPanel::get_false_positives_file_path(const std::string& project_path) const {
+std::string AnalysisResultPanel::get_false_positives_file_path(const std::string& project_path) {
     if (project_path.empty()) {
         // Use a default location if no project path provided
         return "false_positives.json";
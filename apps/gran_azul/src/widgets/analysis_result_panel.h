@@ -2,7 +2,13 @@
 
 #include <widgets.h>
 #include "analysis_result.h"
+#include "source_preview.h"
+#include <array>
+#include <cstdint>
 #include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
 
 namespace gran_azul::widgets {
 
@@ -12,16 +18,30 @@ using FileOpenCallback = std::function<void(const std::string& file_path, int li
 class AnalysisResultPanel : public wip::gui::Panel {
 private:
     AnalysisResult result_;
-    char filter_text_[256] = "";
-    bool show_errors_ = true;
-    bool show_warnings_ = true;
-    bool show_style_ = true;
-    bool show_performance_ = true;
-    bool show_portability_ = true;
-    bool show_information_ = true;
-    bool show_false_positives_ = false; // Hide false positives by default
-    int sort_column_ = 0; // 0=file, 1=line, 2=severity, 3=message
-    bool sort_ascending_ = true;
+    IssueViewOptions options_;
+    char filter_text_[256] = ""; // Edit buffer of options_.filter_text
+    
+    // Every issue in sort order, and the rows to display selected from it; kept between frames
+    // so a filter change only selects again and new issues are sorted and merged in
+    std::vector<size_t> sorted_issues_;
+    std::vector<size_t> visible_issues_;
+    size_t sorted_issue_count_ = 0;  // Issues of result_ already in sorted_issues_
+    bool order_dirty_ = true;        // Sort order changed: sort from scratch
+    bool filter_dirty_ = true;       // Filters changed: select the visible rows again
+    
+    // Text search over the issues of the last prepared result; later issues are matched one by one
+    std::shared_ptr<const wip::analysis::IssueSearchIndex> search_index_;
+    std::array<size_t, 6> severity_counts_{}; // Indexed by IssueSeverity
+    
+    // Row labels built once per distinct file and rule, keyed by the store's interned strings
+    std::unordered_map<const char*, std::string> file_labels_;
+    std::unordered_map<const char*, std::string> rule_labels_;
+    
+    // Issue whose source is previewed below the table; its neighbors' files are loaded ahead
+    static constexpr size_t NO_SELECTION = SIZE_MAX;
+    static constexpr size_t PREFETCH_ROWS = 16;
+    size_t selected_issue_ = NO_SELECTION;
+    SourcePreview source_preview_;
     
     FileOpenCallback on_file_open_;
     
@@ -33,35 +53,49 @@ public:
     void draw_content() override;
     
     // Result management
-    void set_analysis_result(const AnalysisResult& result);
+    void set_analysis_result(AnalysisResult result);
+    
+    // Take over a result prepared with prepare_analysis_result(); its index is kept
+    // unless the filters or sort order changed since it was built
+    void set_prepared_result(PreparedAnalysisResult&& prepared);
+    const IssueViewOptions& get_view_options() const { return options_; }
+    void append_issues(const std::vector<wip::analysis::AnalysisIssue>& issues); // For results streamed while analysis runs
     const AnalysisResult& get_analysis_result() const { return result_; }
     void clear_results();
     
-    // Callback setters
+    // Callback setters; a double click on a row opens its file
     void set_file_open_callback(FileOpenCallback callback) { on_file_open_ = callback; }
     
     // False positive management
     void save_false_positives(const std::string& project_path = "") const;
     void load_false_positives(const std::string& project_path = "");
     
+    // False positives file of a project; a default file when project_path is empty
+    static std::string get_false_positives_file_path(const std::string& project_path = "");
+    
 private:
     void render_summary();
     void render_filters();
     void render_issues_table();
-    void render_issue_row(const AnalysisIssue& issue, int index);
     
-    // Get filtered and sorted issues for display
-    std::vector<const AnalysisIssue*> get_filtered_issues() const;
+    // Rows are drawn straight into the window draw list with colors and sizes
+    // computed once per frame; one selectable per row takes the input
+    struct RowStyle;
+    void render_issue_row(size_t row, const RowStyle& style);
+    void select_issue(size_t row);
+    const std::string& get_file_label(std::string_view file_path);
+    const std::string& get_rule_label(std::string_view rule_id);
+    void clear_row_labels();
     
-    // Sorting helper
-    void sort_issues(std::vector<const AnalysisIssue*>& issues) const;
+    // Display index maintenance
+    void invalidate_order() { order_dirty_ = true; }
+    void invalidate_filter() { filter_dirty_ = true; }
+    void update_index();
+    void count_severities(size_t first_issue);
+    void set_false_positive(size_t issue_index, bool false_positive);
     
     // UI helpers
-    void draw_severity_badge(IssueSeverity severity, int index);
     const char* get_sort_arrow(int column) const;
-    
-    // False positive management helpers
-    std::string get_false_positives_file_path(const std::string& project_path = "") const;
 };
 
 } // namespace gran_azul::widgets
\ No newline at end of file
@@ -1,7 +1,7 @@
 #include "cppcheck_config_widget.h"
 #include "path_selector_widget.h"
 #include <imgui.h>
-#include <iostream>
+#include <log.h>
 #include <sstream>
 #include <filesystem>
 #include <algorithm>
@@ -646,7 +646,7 @@ std::string CppcheckConfigWidget::convert_to_relative_path(const std::string& ab
             return absolute_path;
         }
     } catch (const std::exception& e) {
-        std::cout << "[CPPCHECK_WIDGET] Error calculating relative path: " << e.what() << std::endl;
+        LOG_ERROR("CPPCHECK_WIDGET", "Error calculating relative path: ", e.what());
         return absolute_path;
     }
 }
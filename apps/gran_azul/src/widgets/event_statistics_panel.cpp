@@ -0,0 +1,159 @@
+#include "event_statistics_panel.h"
+#include <imgui.h>
+#include <log.h>
+
+namespace gran_azul::widgets {
+
+namespace {
+
+double to_microseconds(std::chrono::nanoseconds duration) {
+    return static_cast<double>(duration.count()) / 1000.0;
+}
+
+} // namespace
+
+EventStatisticsPanel::EventStatisticsPanel(wip::utils::event::EventDispatcher* dispatcher)
+    : wip::gui::Panel("Event Statistics"), dispatcher_(dispatcher) {
+    set_size(700, 400);
+    set_visible(false);
+}
+
+void EventStatisticsPanel::update(float delta_time) {
+    Panel::update(delta_time);
+    
+    if (!dispatcher_) {
+        return;
+    }
+    
+    // Handlers are only timed while someone is looking at the numbers
+    if (is_visible() != was_visible_) {
+        was_visible_ = is_visible();
+        set_instrumented(was_visible_);
+    }
+    if (!was_visible_) {
+        return;
+    }
+    
+    refresh_timer_ -= delta_time;
+    if (refresh_timer_ <= 0.0f) {
+        statistics_ = dispatcher_->get_statistics();
+        refresh_timer_ = REFRESH_INTERVAL;
+    }
+}
+
+void EventStatisticsPanel::draw_content() {
+    if (!dispatcher_) {
+        ImGui::Text("No event dispatcher attached.");
+        return;
+    }
+    
+    render_header();
+    render_event_types();
+    ImGui::Spacing();
+    render_handlers();
+}
+
+void EventStatisticsPanel::set_dispatcher(wip::utils::event::EventDispatcher* dispatcher) {
+    dispatcher_ = dispatcher;
+    statistics_ = {};
+}
+
+void EventStatisticsPanel::set_instrumented(bool instrumented) {
+    if (dispatcher_) {
+        dispatcher_->set_instrumentation_enabled(instrumented);
+    }
+    refresh_timer_ = 0.0f;
+}
+
+void EventStatisticsPanel::render_header() {
+    bool instrumented = dispatcher_->is_instrumentation_enabled();
+    if (ImGui::Checkbox("Time dispatches", &instrumented)) {
+        set_instrumented(instrumented);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Reset")) {
+        dispatcher_->reset_statistics();
+        refresh_timer_ = 0.0f;
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Dump to Console")) {
+        LOG_DEBUG("EVENT_STATISTICS", dispatcher_->get_statistics().to_string());
+    }
+    ImGui::SameLine();
+    ImGui::Text("Subscriptions: %zu", dispatcher_->total_subscription_count());
+    
+    ImGui::Separator();
+}
+
+void EventStatisticsPanel::render_event_types() {
+    ImGuiTableFlags table_flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable;
+    if (ImGui::BeginTable("EventTypesTable", 6, table_flags)) {
+        ImGui::TableSetupColumn("Event Type", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("Dispatches", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+        ImGui::TableSetupColumn("Per Second", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+        ImGui::TableSetupColumn("p50 (us)", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+        ImGui::TableSetupColumn("p99 (us)", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+        ImGui::TableSetupColumn("Exceptions", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+        ImGui::TableHeadersRow();
+        
+        for (const auto& type : statistics_.event_types) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(type.name.c_str());
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", static_cast<unsigned long long>(type.dispatches));
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", type.dispatches_per_second);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", to_microseconds(type.latency.p50));
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", to_microseconds(type.latency.p99));
+            ImGui::TableNextColumn();
+            if (type.exceptions > 0) {
+                ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "%llu", static_cast<unsigned long long>(type.exceptions));
+            } else {
+                ImGui::Text("0");
+            }
+        }
+        ImGui::EndTable();
+    }
+}
+
+void EventStatisticsPanel::render_handlers() {
+    ImGui::Text("Handlers (slowest first)");
+    
+    ImGuiTableFlags table_flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable |
+                                  ImGuiTableFlags_ScrollY;
+    if (ImGui::BeginTable("HandlersTable", 7, table_flags)) {
+        ImGui::TableSetupColumn("Id", ImGuiTableColumnFlags_WidthFixed, 40.0f);
+        ImGui::TableSetupColumn("Event Type", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("Calls", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+        ImGui::TableSetupColumn("Mean (us)", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+        ImGui::TableSetupColumn("p99 (us)", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+        ImGui::TableSetupColumn("Max (us)", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+        ImGui::TableSetupColumn("Exceptions", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+        ImGui::TableSetupScrollFreeze(0, 1); // Freeze header row
+        ImGui::TableHeadersRow();
+        
+        for (const auto& handler : statistics_.handlers) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", static_cast<unsigned long long>(handler.subscription_id));
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(handler.event_type.c_str());
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", static_cast<unsigned long long>(handler.calls));
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", to_microseconds(handler.latency.mean));
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", to_microseconds(handler.latency.p99));
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", to_microseconds(handler.latency.max));
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", static_cast<unsigned long long>(handler.exceptions));
+        }
+        ImGui::EndTable();
+    }
+}
+
+} // namespace gran_azul::widgets
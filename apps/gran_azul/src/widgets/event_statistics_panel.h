@@ -0,0 +1,35 @@
+#pragma once
+
+#include <widgets.h>
+#include <event_dispatcher.h>
+
+namespace gran_azul::widgets {
+
+// Debug panel showing dispatch rates, handler latencies and swallowed exceptions
+class EventStatisticsPanel : public wip::gui::Panel {
+private:
+    wip::utils::event::EventDispatcher* dispatcher_;
+    wip::utils::event::DispatchStatistics statistics_;
+    float refresh_timer_ = 0.0f;
+    bool was_visible_ = false;
+    
+    static constexpr float REFRESH_INTERVAL = 0.5f; // Seconds between snapshots
+    
+public:
+    explicit EventStatisticsPanel(wip::utils::event::EventDispatcher* dispatcher = nullptr);
+    
+    // Panel interface
+    void update(float delta_time) override;
+    void draw_content() override;
+    
+    // Dispatcher whose statistics are shown; instrumentation runs while the panel is visible
+    void set_dispatcher(wip::utils::event::EventDispatcher* dispatcher);
+    void set_instrumented(bool instrumented);
+    
+private:
+    void render_header();
+    void render_event_types();
+    void render_handlers();
+};
+
+} // namespace gran_azul::widgets
@@ -0,0 +1,150 @@
+#include "history_trend_panel.h"
+#include <imgui.h>
+#include <log.h>
+#include <algorithm>
+#include <ctime>
+
+namespace gran_azul::widgets {
+
+namespace {
+
+std::string format_timestamp(std::chrono::system_clock::time_point timestamp) {
+    std::time_t time = std::chrono::system_clock::to_time_t(timestamp);
+    char buffer[32];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M", std::localtime(&time));
+    return buffer;
+}
+
+} // namespace
+
+HistoryTrendPanel::HistoryTrendPanel()
+    : wip::gui::Panel("Analysis History") {
+    set_size(700, 450);
+    set_visible(false);
+}
+
+void HistoryTrendPanel::draw_content() {
+    if (!history_) {
+        ImGui::Text("Open a project to see its analysis history.");
+        return;
+    }
+    if (runs_.empty()) {
+        ImGui::Text("No analysis runs recorded yet.");
+        return;
+    }
+
+    render_runs();
+    ImGui::Spacing();
+    ImGui::Separator();
+    render_filter();
+}
+
+void HistoryTrendPanel::set_history(std::shared_ptr<wip::analysis::HistoryStore> history) {
+    history_ = std::move(history);
+    filter_counts_.clear();
+    filter_error_.clear();
+    refresh();
+}
+
+void HistoryTrendPanel::refresh() {
+    runs_.clear();
+    run_counts_.clear();
+    if (!history_) {
+        return;
+    }
+
+    // Summaries come from the catalog; no run is loaded
+    runs_ = history_->get_runs(MAX_RUNS);
+    for (const auto& run : runs_) {
+        run_counts_.push_back(static_cast<float>(run.issue_count));
+    }
+    if (!filter_counts_.empty()) {
+        query_filter();
+    }
+}
+
+void HistoryTrendPanel::render_runs() {
+    float max_count = *std::max_element(run_counts_.begin(), run_counts_.end());
+    ImGui::Text("Issues over the last %zu runs", runs_.size());
+    ImGui::PlotLines("##RunTrend", run_counts_.data(), static_cast<int>(run_counts_.size()), 0, nullptr, 0.0f,
+                     max_count * 1.1f + 1.0f, ImVec2(-1.0f, 80.0f));
+
+    ImGuiTableFlags table_flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable |
+                                  ImGuiTableFlags_ScrollY;
+    if (ImGui::BeginTable("HistoryRunsTable", 6, table_flags, ImVec2(0.0f, 180.0f))) {
+        ImGui::TableSetupColumn("Run", ImGuiTableColumnFlags_WidthFixed, 50.0f);
+        ImGui::TableSetupColumn("Time", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("Issues", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+        ImGui::TableSetupColumn("Errors", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+        ImGui::TableSetupColumn("Files", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+        ImGui::TableSetupColumn("Duration (s)", ImGuiTableColumnFlags_WidthFixed, 90.0f);
+        ImGui::TableSetupScrollFreeze(0, 1); // Freeze header row
+        ImGui::TableHeadersRow();
+
+        // Newest first
+        for (auto it = runs_.rbegin(); it != runs_.rend(); ++it) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", static_cast<unsigned long long>(it->run_id));
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(format_timestamp(it->timestamp).c_str());
+            if (!it->success) {
+                ImGui::SameLine();
+                ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "(failed)");
+            }
+            ImGui::TableNextColumn();
+            ImGui::Text("%zu", it->issue_count);
+            ImGui::TableNextColumn();
+            ImGui::Text("%zu", it->issue_counts_by_severity[static_cast<size_t>(wip::analysis::IssueSeverity::Error)]);
+            ImGui::TableNextColumn();
+            ImGui::Text("%zu", it->files_analyzed);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", static_cast<double>(it->execution_time.count()) / 1000.0);
+        }
+        ImGui::EndTable();
+    }
+}
+
+void HistoryTrendPanel::render_filter() {
+    ImGui::RadioButton("File", &filter_kind_, 0);
+    ImGui::SameLine();
+    ImGui::RadioButton("Rule", &filter_kind_, 1);
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(-80.0f);
+    bool submitted = ImGui::InputText("##HistoryFilter", filter_, sizeof(filter_), ImGuiInputTextFlags_EnterReturnsTrue);
+    ImGui::SameLine();
+    if (ImGui::Button("Show") || submitted) {
+        query_filter();
+    }
+
+    if (!filter_error_.empty()) {
+        ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "%s", filter_error_.c_str());
+    } else if (!filter_counts_.empty()) {
+        float max_count = *std::max_element(filter_counts_.begin(), filter_counts_.end());
+        ImGui::Text("Issues per run for %s (latest: %.0f)", filter_, filter_counts_.back());
+        ImGui::PlotHistogram("##FilterTrend", filter_counts_.data(), static_cast<int>(filter_counts_.size()), 0,
+                             nullptr, 0.0f, max_count * 1.1f + 1.0f, ImVec2(-1.0f, 80.0f));
+    }
+}
+
+void HistoryTrendPanel::query_filter() {
+    filter_counts_.clear();
+    filter_error_.clear();
+    if (!history_ || filter_[0] == '\0') {
+        return;
+    }
+
+    // Only the file or rule index of each run is read
+    try {
+        auto trend = filter_kind_ == 1 ? history_->get_rule_trend(filter_, MAX_RUNS)
+                                     : history_->get_file_trend(filter_, MAX_RUNS);
+        for (const auto& point : trend) {
+            filter_counts_.push_back(static_cast<float>(point.issue_count));
+        }
+    } catch (const std::exception& e) {
+        LOG_ERROR("HISTORY", "History query failed: ", e.what());
+        filter_error_ = e.what();
+    }
+}
+
+} // namespace gran_azul::widgets
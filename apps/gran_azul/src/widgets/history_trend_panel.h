@@ -0,0 +1,44 @@
+#pragma once
+
+#include <widgets.h>
+#include <history_store.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace gran_azul::widgets {
+
+// Issue counts of the project's recent runs, overall and for one file or rule
+class HistoryTrendPanel : public wip::gui::Panel {
+private:
+    std::shared_ptr<wip::analysis::HistoryStore> history_;
+    std::vector<wip::analysis::HistoryRun> runs_;
+    std::vector<float> run_counts_;
+
+    // Trend of the file or rule typed into the filter
+    char filter_[512] = "";
+    int filter_kind_ = 0;          // 0: file, 1: rule
+    std::vector<float> filter_counts_;
+    std::string filter_error_;
+
+    static constexpr size_t MAX_RUNS = 30;
+
+public:
+    HistoryTrendPanel();
+
+    // Panel interface
+    void draw_content() override;
+
+    // Store whose runs are shown; nullptr when no project is open
+    void set_history(std::shared_ptr<wip::analysis::HistoryStore> history);
+
+    // Reload the summaries after a run was recorded; call on the UI thread
+    void refresh();
+
+private:
+    void render_runs();
+    void render_filter();
+    void query_filter();
+};
+
+} // namespace gran_azul::widgets
@@ -0,0 +1,218 @@
+#include "log_buffer.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <log.h>
+#include <sstream>
+
+namespace gran_azul::widgets {
+
+using wip::utils::process::OutputStream;
+
+LogBuffer::LogBuffer(size_t memory_budget, size_t max_entries, std::filesystem::path spill_directory)
+    : memory_budget_(memory_budget), max_entries_(std::max<size_t>(1, max_entries)),
+      spill_directory_(std::move(spill_directory)) {
+    if (spill_directory_.empty()) {
+        std::error_code error;
+        std::filesystem::path temp = std::filesystem::temp_directory_path(error);
+        if (error) {
+            temp = ".";
+        }
+        auto unique = std::chrono::steady_clock::now().time_since_epoch().count();
+        spill_directory_ = temp / ("gran_azul_log_" + std::to_string(unique));
+    }
+}
+
+LogBuffer::~LogBuffer() {
+    if (spill_directory_created_) {
+        std::error_code error;
+        std::filesystem::remove_all(spill_directory_, error);
+    }
+}
+
+uint64_t LogBuffer::begin_entry(std::string command) {
+    LogEntry entry;
+    entry.id = next_id_++;
+    entry.command = std::move(command);
+
+    // Create timestamp
+    auto now = std::chrono::system_clock::now();
+    auto time_t = std::chrono::system_clock::to_time_t(now);
+    auto tm = *std::localtime(&time_t);
+
+    std::ostringstream ss;
+    ss << std::put_time(&tm, "%H:%M:%S");
+    entry.timestamp = ss.str();
+
+    memory_usage_ += entry.command.size();
+    entries_.push_back(std::move(entry));
+    enforce_limits();
+    return entries_.back().id;
+}
+
+void LogBuffer::append_output(uint64_t id, OutputStream stream, std::string_view text) {
+    LogEntry* entry = find(id);
+    if (!entry || entry->spilled) {
+        return;
+    }
+
+    auto index = static_cast<size_t>(stream);
+    size_t before = entry->output[index].memory_usage();
+    entry->output[index].append(text);
+    entry->output_size[index] += text.size();
+    memory_usage_ += entry->output[index].memory_usage() - before;
+}
+
+void LogBuffer::finish_entry(uint64_t id, bool success, int exit_code, std::chrono::milliseconds duration) {
+    LogEntry* entry = find(id);
+    if (!entry) {
+        return;
+    }
+
+    entry->finished = true;
+    entry->success = success;
+    entry->exit_code = exit_code;
+    entry->duration = duration;
+    enforce_limits();
+}
+
+uint64_t LogBuffer::add_entry(std::string command, const wip::utils::process::ProcessResult& result) {
+    uint64_t id = begin_entry(std::move(command));
+    append_output(id, OutputStream::Stdout, result.stdout_output);
+    append_output(id, OutputStream::Stderr, result.stderr_output);
+    finish_entry(id, result.success(), result.exit_code, result.duration);
+    return id;
+}
+
+void LogBuffer::clear() {
+    entries_.clear();
+    memory_usage_ = 0;
+    loaded_.clear();
+
+    if (spill_directory_created_) {
+        std::error_code error;
+        std::filesystem::remove_all(spill_directory_, error);
+        spill_directory_created_ = false;
+    }
+}
+
+const TextBuffer& LogBuffer::output(size_t position, OutputStream stream) {
+    LogEntry& entry = entries_[position];
+    auto index = static_cast<size_t>(stream);
+    if (!entry.spilled) {
+        return entry.output[index];
+    }
+
+    auto loaded = std::find_if(loaded_.begin(), loaded_.end(),
+                               [&entry](const LoadedOutput& output) { return output.id == entry.id; });
+    if (loaded != loaded_.end()) {
+        return loaded->output[index];
+    }
+
+    if (loaded_.size() >= LOADED_ENTRIES) {
+        loaded_.pop_front();
+    }
+    LoadedOutput& output = loaded_.emplace_back();
+    output.id = entry.id;
+
+    std::ifstream file(spill_path(entry.id), std::ios::binary);
+    if (!file.is_open()) {
+        LOG_ERROR("LOG_BUFFER", "Spilled output of command ", entry.id, " is no longer available");
+    }
+
+    std::string buffer;
+    for (size_t i = 0; i < output.output.size() && file; ++i) {
+        size_t remaining = entry.output_size[i];
+        while (remaining > 0 && file) {
+            buffer.resize(std::min(remaining, TextBuffer::MAX_CHUNK_SIZE));
+            file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            auto read = static_cast<size_t>(file.gcount());
+            output.output[i].append(std::string_view(buffer.data(), read));
+            remaining -= std::min(remaining, read);
+        }
+    }
+    return output.output[index];
+}
+
+LogEntry* LogBuffer::find(uint64_t id) {
+    // Ids are consecutive, so the position follows from the oldest id
+    if (entries_.empty() || id < entries_.front().id) {
+        return nullptr;
+    }
+    auto position = static_cast<size_t>(id - entries_.front().id);
+    return position < entries_.size() ? &entries_[position] : nullptr;
+}
+
+std::filesystem::path LogBuffer::spill_path(uint64_t id) const {
+    return spill_directory_ / (std::to_string(id) + ".log");
+}
+
+size_t LogBuffer::resident_bytes(const LogEntry& entry) const {
+    return entry.command.size() + entry.output[0].memory_usage() + entry.output[1].memory_usage();
+}
+
+void LogBuffer::enforce_limits() {
+    while (entries_.size() > max_entries_) {
+        drop_oldest();
+    }
+
+    // Oldest output goes to disk first; running commands stay resident until they finish
+    for (auto& entry : entries_) {
+        if (memory_usage_ <= memory_budget_) {
+            break;
+        }
+        if (entry.finished && !entry.spilled && (entry.output_size[0] > 0 || entry.output_size[1] > 0)) {
+            spill(entry);
+        }
+    }
+}
+
+bool LogBuffer::spill(LogEntry& entry) {
+    std::error_code error;
+    if (!spill_directory_created_) {
+        std::filesystem::create_directories(spill_directory_, error);
+        if (error) {
+            LOG_ERROR("LOG_BUFFER", "Cannot create spill directory ", spill_directory_, ": ", error.message());
+            return false;
+        }
+        spill_directory_created_ = true;
+    }
+
+    std::ofstream file(spill_path(entry.id), std::ios::binary | std::ios::trunc);
+    for (const auto& text : entry.output) {
+        text.write_to(file);
+    }
+    file.close();
+    if (!file) {
+        LOG_ERROR("LOG_BUFFER", "Cannot spill output of command ", entry.id, " to ", spill_directory_);
+        std::filesystem::remove(spill_path(entry.id), error);
+        return false;
+    }
+
+    for (auto& text : entry.output) {
+        memory_usage_ -= text.memory_usage();
+        text.clear();
+    }
+    entry.spilled = true;
+    return true;
+}
+
+void LogBuffer::drop_oldest() {
+    LogEntry& entry = entries_.front();
+    memory_usage_ -= resident_bytes(entry);
+
+    if (entry.spilled) {
+        std::error_code error;
+        std::filesystem::remove(spill_path(entry.id), error);
+    }
+    forget_loaded(entry.id);
+    entries_.pop_front();
+}
+
+void LogBuffer::forget_loaded(uint64_t id) {
+    loaded_.erase(std::remove_if(loaded_.begin(), loaded_.end(),
+                                 [id](const LoadedOutput& output) { return output.id == id; }),
+                  loaded_.end());
+}
+
+} // namespace gran_azul::widgets
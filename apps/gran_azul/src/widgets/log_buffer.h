@@ -0,0 +1,104 @@
+#pragma once
+
+#include <process.h>
+#include <text_buffer.h>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace gran_azul::widgets {
+
+using wip::gui::widgets::TextBuffer;
+
+// One command run, possibly still producing output
+struct LogEntry {
+    uint64_t id = 0;
+    std::string timestamp;
+    std::string command;
+    bool finished = false;
+    bool success = false;
+    int exit_code = -1;
+    std::chrono::milliseconds duration{0};
+
+    // Output while resident; spilled entries keep only the sizes and read it back on demand
+    std::array<TextBuffer, 2> output;                 // Indexed by OutputStream
+    std::array<size_t, 2> output_size{};
+    bool spilled = false;
+
+    bool has_output(wip::utils::process::OutputStream stream) const {
+        return output_size[static_cast<size_t>(stream)] > 0;
+    }
+};
+
+// Bounded log of command runs for the log window.
+//
+// Keeps at most max_entries entries, dropping the oldest ones. When the
+// output held in memory exceeds the memory budget, the output of the oldest
+// finished entries is written to one file per entry in a spill directory and
+// read back only while such an entry is being viewed.
+class LogBuffer {
+public:
+    static constexpr size_t DEFAULT_MEMORY_BUDGET = 16 * 1024 * 1024;
+    static constexpr size_t DEFAULT_MAX_ENTRIES = 1000;
+    static constexpr size_t LOADED_ENTRIES = 4;    // Spilled entries kept loaded while viewed
+
+    explicit LogBuffer(size_t memory_budget = DEFAULT_MEMORY_BUDGET, size_t max_entries = DEFAULT_MAX_ENTRIES,
+                       std::filesystem::path spill_directory = {});
+    ~LogBuffer();
+
+    LogBuffer(const LogBuffer&) = delete;
+    LogBuffer& operator=(const LogBuffer&) = delete;
+
+    // Streaming entries: begin, append output as it arrives, finish
+    uint64_t begin_entry(std::string command);
+    void append_output(uint64_t id, wip::utils::process::OutputStream stream, std::string_view text);
+    void finish_entry(uint64_t id, bool success, int exit_code, std::chrono::milliseconds duration);
+
+    // Complete entry from a finished process
+    uint64_t add_entry(std::string command, const wip::utils::process::ProcessResult& result);
+
+    void clear();
+
+    // Entries oldest first
+    size_t size() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+    const LogEntry& at(size_t position) const { return entries_[position]; }
+
+    // Output of an entry, read back from the spill directory if it has been spilled
+    const TextBuffer& output(size_t position, wip::utils::process::OutputStream stream);
+
+    size_t memory_usage() const { return memory_usage_; }
+    size_t get_memory_budget() const { return memory_budget_; }
+
+private:
+    LogEntry* find(uint64_t id);
+    std::filesystem::path spill_path(uint64_t id) const;
+    size_t resident_bytes(const LogEntry& entry) const;
+    void enforce_limits();
+    bool spill(LogEntry& entry);
+    void drop_oldest();
+    void forget_loaded(uint64_t id);
+
+    std::deque<LogEntry> entries_;
+    uint64_t next_id_ = 1;
+    size_t memory_budget_;
+    size_t max_entries_;
+    size_t memory_usage_ = 0;
+
+    std::filesystem::path spill_directory_;
+    bool spill_directory_created_ = false;
+
+    // Output of the spilled entries read back last, oldest first
+    struct LoadedOutput {
+        uint64_t id;
+        std::array<TextBuffer, 2> output;
+    };
+    std::deque<LoadedOutput> loaded_;
+};
+
+} // namespace gran_azul::widgets
@@ -1,6 +1,6 @@
 #include "log_window_panel.h"
 #include <imgui.h>
-#include <iostream>
+#include <log.h>
 
 namespace gran_azul::widgets {
 
@@ -20,17 +20,25 @@ void LogWindowPanel::draw_content() {
     render_log_entries();
 }
 
-void LogWindowPanel::add_log_entry(const LogEntry& entry) {
-    log_entries_.push_back(entry);
-}
-
 void LogWindowPanel::add_log_entry(const std::string& command, const wip::utils::process::ProcessResult& result) {
-    log_entries_.emplace_back(command, result);
+    log_buffer_.add_entry(command, result);
 }
 
 void LogWindowPanel::clear_log() {
-    log_entries_.clear();
-    std::cout << "[LOG_WINDOW_PANEL] Log cleared\n";
+    log_buffer_.clear();
+    LOG_DEBUG("LOG_WINDOW_PANEL", "Log cleared");
+}
+
+uint64_t LogWindowPanel::begin_log_entry(const std::string& command) {
+    return log_buffer_.begin_entry(command);
+}
+
+void LogWindowPanel::append_log_output(uint64_t entry_id, wip::utils::process::OutputStream stream, std::string_view text) {
+    log_buffer_.append_output(entry_id, stream, text);
+}
+
+void LogWindowPanel::finish_log_entry(uint64_t entry_id, bool success, int exit_code, std::chrono::milliseconds duration) {
+    log_buffer_.finish_entry(entry_id, success, exit_code, duration);
 }
 
 void LogWindowPanel::render_header() {
@@ -42,10 +50,10 @@ void LogWindowPanel::render_header() {
     if (ImGui::Button(all_collapsed_ ? "Expand All" : "Collapse All")) {
         all_collapsed_ = !all_collapsed_;
         force_collapse_state_ = true; // Force state change on next render
-        std::cout << "[LOG_WINDOW_PANEL] " << (all_collapsed_ ? "Collapsed" : "Expanded") << " all log entries\n";
+        LOG_DEBUG("LOG_WINDOW_PANEL", (all_collapsed_ ? "Collapsed" : "Expanded"), " all log entries");
     }
     ImGui::SameLine();
-    ImGui::Text("Commands executed: %zu", log_entries_.size());
+    ImGui::Text("Commands executed: %zu", log_buffer_.size());
     
     ImGui::Separator();
 }
@@ -55,10 +63,8 @@ void LogWindowPanel::render_log_entries() {
     ImGuiWindowFlags child_flags = ImGuiWindowFlags_HorizontalScrollbar;
     if (ImGui::BeginChild("LogContent", ImVec2(0, 0), false, child_flags)) {
         // Iterate in reverse order to show latest commands at the top
-        for (int idx = static_cast<int>(log_entries_.size()) - 1; idx >= 0; --idx) {
-            size_t i = static_cast<size_t>(idx);
-            size_t display_number = log_entries_.size() - i;
-            render_log_entry(log_entries_[i], i, display_number);
+        for (size_t i = log_buffer_.size(); i-- > 0;) {
+            render_log_entry(i, static_cast<size_t>(log_buffer_.at(i).id));
         }
         
         // Reset the force flag after processing all headers
@@ -72,11 +78,15 @@ void LogWindowPanel::render_log_entries() {
     ImGui::EndChild();
 }
 
-void LogWindowPanel::render_log_entry(const LogEntry& entry, size_t index, size_t display_number) {
-    ImGui::PushID(static_cast<int>(index));
+void LogWindowPanel::render_log_entry(size_t position, size_t display_number) {
+    const LogEntry& entry = log_buffer_.at(position);
+    
+    // Entry ids stay the same when older entries are dropped, unlike positions
+    ImGui::PushID(static_cast<int>(entry.id));
     
-    // Color-code based on success
-    ImVec4 color = entry.success ? ImVec4(0.0f, 0.8f, 0.0f, 1.0f) : ImVec4(0.8f, 0.0f, 0.0f, 1.0f);
+    // Color-code based on success; commands still running are shown in yellow
+    ImVec4 color = !entry.finished ? ImVec4(0.8f, 0.8f, 0.0f, 1.0f)
+                 : entry.success ? ImVec4(0.0f, 0.8f, 0.0f, 1.0f) : ImVec4(0.8f, 0.0f, 0.0f, 1.0f);
     ImGui::PushStyleColor(ImGuiCol_Text, color);
     
     // Force the collapse state if the button was pressed
@@ -89,8 +99,8 @@ void LogWindowPanel::render_log_entry(const LogEntry& entry, size_t index, size_
     if (is_open) {
         ImGui::PopStyleColor(); // Reset color for content
         
-        render_command_section(entry, index);
-        render_output_section(entry, index);
+        render_command_section(entry);
+        render_output_section(position);
     } else {
         ImGui::PopStyleColor(); // Reset color if header is collapsed
     }
@@ -99,45 +109,52 @@ void LogWindowPanel::render_log_entry(const LogEntry& entry, size_t index, size_
     ImGui::Spacing();
 }
 
-void LogWindowPanel::render_command_section(const LogEntry& entry, size_t index) {
+void LogWindowPanel::render_command_section(const LogEntry& entry) {
     // Display command in a scrollable, copyable area
     ImGui::Text("Command:");
     ImGui::SameLine();
-    if (ImGui::Button(("Copy Command##cmd_" + std::to_string(index)).c_str())) {
+    if (ImGui::Button("Copy Command")) {
         wip::gui::widgets::SelectableTextWidget::copy_text_to_clipboard(entry.command);
     }
     
-    ImGui::BeginChild(("CommandText_" + std::to_string(index)).c_str(), ImVec2(0, 60), true);
-    wip::gui::widgets::SelectableTextWidget::render_selectable_text_lines(entry.command, "command_" + std::to_string(index));
+    ImGui::BeginChild("CommandText", ImVec2(0, 60), true);
+    wip::gui::widgets::SelectableTextWidget::render_selectable_text_lines(entry.command, "command_" + std::to_string(entry.id));
     ImGui::EndChild();
     
-    ImGui::Text("Exit Code: %d", entry.exit_code);
-    ImGui::Text("Duration: %ld ms", entry.duration.count());
-    ImGui::Text("Success: %s", entry.success ? "Yes" : "No");
+    if (entry.finished) {
+        ImGui::Text("Exit Code: %d", entry.exit_code);
+        ImGui::Text("Duration: %ld ms", entry.duration.count());
+        ImGui::Text("Success: %s", entry.success ? "Yes" : "No");
+    } else {
+        ImGui::Text("Running...");
+    }
     
     ImGui::Separator();
 }
 
-void LogWindowPanel::render_output_section(const LogEntry& entry, size_t index) {
+void LogWindowPanel::render_output_section(size_t position) {
+    using wip::utils::process::OutputStream;
+    
+    const LogEntry& entry = log_buffer_.at(position);
+    const bool has_stdout = entry.has_output(OutputStream::Stdout);
+    const bool has_stderr = entry.has_output(OutputStream::Stderr);
+    
     // Display stdout
-    if (!entry.stdout_output.empty()) {
+    if (has_stdout) {
         ImGui::Text("Standard Output:");
         
         // Add copy button for stdout
         ImGui::SameLine();
-        if (ImGui::Button(("Copy Stdout##stdout_" + std::to_string(index)).c_str())) {
-            wip::gui::widgets::SelectableTextWidget::copy_text_to_clipboard(entry.stdout_output);
+        if (ImGui::Button("Copy Stdout")) {
+            wip::gui::widgets::SelectableTextWidget::copy_text_to_clipboard(log_buffer_.output(position, OutputStream::Stdout).to_string());
         }
         
-        // Display stdout in a selectable child window
-        ImGui::BeginChild(("StdoutText_" + std::to_string(index)).c_str(), ImVec2(0, 100), true);
-        wip::gui::widgets::SelectableTextWidget::render_selectable_text_lines(entry.stdout_output, "stdout_" + std::to_string(index));
-        ImGui::EndChild();
+        render_output_text_if_visible(position, OutputStream::Stdout, "StdoutText");
     }
     
     // Display stderr
-    if (!entry.stderr_output.empty()) {
-        if (!entry.stdout_output.empty()) {
+    if (has_stderr) {
+        if (has_stdout) {
             ImGui::Spacing();
         }
         
@@ -147,20 +164,48 @@ void LogWindowPanel::render_output_section(const LogEntry& entry, size_t index)
         
         // Add copy button for stderr
         ImGui::SameLine();
-        if (ImGui::Button(("Copy Stderr##stderr_" + std::to_string(index)).c_str())) {
-            wip::gui::widgets::SelectableTextWidget::copy_text_to_clipboard(entry.stderr_output);
+        if (ImGui::Button("Copy Stderr")) {
+            wip::gui::widgets::SelectableTextWidget::copy_text_to_clipboard(log_buffer_.output(position, OutputStream::Stderr).to_string());
         }
         
-        // Display stderr in a selectable child window
-        ImGui::BeginChild(("StderrText_" + std::to_string(index)).c_str(), ImVec2(0, 100), true);
-        wip::gui::widgets::SelectableTextWidget::render_selectable_text_lines(entry.stderr_output, "stderr_" + std::to_string(index));
-        ImGui::EndChild();
+        render_output_text_if_visible(position, OutputStream::Stderr, "StderrText");
     }
     
     // If both are empty
-    if (entry.stdout_output.empty() && entry.stderr_output.empty()) {
+    if (!has_stdout && !has_stderr) {
         ImGui::Text("No output");
     }
 }
 
+void LogWindowPanel::render_output_text_if_visible(size_t position, wip::utils::process::OutputStream stream, const char* child_id) {
+    const ImVec2 size(0, OUTPUT_HEIGHT);
+    
+    // Entries scrolled out of view only reserve their space, so spilled output is not read back for them
+    if (!ImGui::IsRectVisible(ImVec2(ImGui::GetContentRegionAvail().x, OUTPUT_HEIGHT))) {
+        ImGui::Dummy(size);
+        return;
+    }
+    
+    const TextBuffer& text = log_buffer_.output(position, stream);
+    
+    // Display the output in a selectable child window, drawing only the lines in view
+    ImGui::BeginChild(child_id, size, true);
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(text.line_count()));
+    while (clipper.Step()) {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+            line_buffer_.assign(text.line(static_cast<size_t>(row)));
+            
+            ImGui::PushID(row);
+            if (ImGui::Selectable(line_buffer_.c_str(), false, ImGuiSelectableFlags_AllowDoubleClick)) {
+                if (ImGui::IsMouseDoubleClicked(0)) {
+                    wip::gui::widgets::SelectableTextWidget::copy_text_to_clipboard(line_buffer_);
+                }
+            }
+            ImGui::PopID();
+        }
+    }
+    ImGui::EndChild();
+}
+
 } // namespace gran_azul::widgets
@@ -2,44 +2,21 @@
 
 #include <widgets.h>
 #include <process.h>
-#include <string>
-#include <vector>
+#include "log_buffer.h"
 #include <chrono>
-#include <sstream>
-#include <iomanip>
+#include <string>
+#include <string_view>
 
 namespace gran_azul::widgets {
 
-// Log entry structure for the log window
-struct LogEntry {
-    std::string timestamp;
-    std::string command;
-    std::string stdout_output;
-    std::string stderr_output;
-    bool success;
-    int exit_code;
-    std::chrono::milliseconds duration;
-    
-    LogEntry(const std::string& cmd, const wip::utils::process::ProcessResult& result) 
-        : command(cmd), stdout_output(result.stdout_output), 
-          stderr_output(result.stderr_output), success(result.success()), 
-          exit_code(result.exit_code), duration(result.duration) {
-        // Create timestamp
-        auto now = std::chrono::system_clock::now();
-        auto time_t = std::chrono::system_clock::to_time_t(now);
-        auto tm = *std::localtime(&time_t);
-        
-        std::ostringstream ss;
-        ss << std::put_time(&tm, "%H:%M:%S");
-        timestamp = ss.str();
-    }
-};
-
 class LogWindowPanel : public wip::gui::Panel {
 private:
-    std::vector<LogEntry> log_entries_;
+    static constexpr float OUTPUT_HEIGHT = 100.0f;
+    
+    LogBuffer log_buffer_;
     bool all_collapsed_;
     bool force_collapse_state_;
+    std::string line_buffer_; // NUL-terminated copy of the line being drawn
     
 public:
     LogWindowPanel();
@@ -49,20 +26,25 @@ public:
     void draw_content() override;
     
     // Log management
-    void add_log_entry(const LogEntry& entry);
     void add_log_entry(const std::string& command, const wip::utils::process::ProcessResult& result);
     void clear_log();
     
+    // Streaming log entries, for commands whose output arrives while they run
+    uint64_t begin_log_entry(const std::string& command);
+    void append_log_output(uint64_t entry_id, wip::utils::process::OutputStream stream, std::string_view text);
+    void finish_log_entry(uint64_t entry_id, bool success, int exit_code, std::chrono::milliseconds duration);
+    
     // State management
-    size_t get_log_count() const { return log_entries_.size(); }
-    bool is_empty() const { return log_entries_.empty(); }
+    size_t get_log_count() const { return log_buffer_.size(); }
+    bool is_empty() const { return log_buffer_.empty(); }
     
 private:
     void render_header();
     void render_log_entries();
-    void render_log_entry(const LogEntry& entry, size_t index, size_t display_number);
-    void render_command_section(const LogEntry& entry, size_t index);
-    void render_output_section(const LogEntry& entry, size_t index);
+    void render_log_entry(size_t position, size_t display_number);
+    void render_command_section(const LogEntry& entry);
+    void render_output_section(size_t position);
+    void render_output_text_if_visible(size_t position, wip::utils::process::OutputStream stream, const char* child_id);
 };
 
 } // namespace gran_azul::widgets
\ No newline at end of file
@@ -2,7 +2,7 @@
 #include <imgui.h>
 #include <nfd.h>
 #include <filesystem>
-#include <iostream>
+#include <log.h>
 
 namespace gran_azul::widgets {
 
@@ -83,14 +83,14 @@ void PathSelectorWidget::open_dialog() {
             on_path_selected_(current_path_);
         }
         
-        std::cout << "[PATH_SELECTOR] Selected: " << current_path_ << std::endl;
+        LOG_DEBUG("PATH_SELECTOR", "Selected: ", current_path_);
         
         // Remember to free the path memory
         NFD_FreePath(out_path);
     } else if (result == NFD_CANCEL) {
-        std::cout << "[PATH_SELECTOR] Selection cancelled\n";
+        LOG_DEBUG("PATH_SELECTOR", "Selection cancelled");
     } else {
-        std::cout << "[PATH_SELECTOR] Error: " << NFD_GetError() << "\n";
+        LOG_ERROR("PATH_SELECTOR", "Error: ", NFD_GetError());
     }
 }
 
@@ -102,7 +102,7 @@ std::string PathSelectorWidget::get_relative_path(const std::string& absolute_pa
         std::filesystem::path relative = std::filesystem::relative(abs_path, base);
         return relative.string();
     } catch (const std::exception& e) {
-        std::cout << "[PATH_SELECTOR] Error calculating relative path: " << e.what() << std::endl;
+        LOG_ERROR("PATH_SELECTOR", "Error calculating relative path: ", e.what());
         return absolute_path;
     }
 }
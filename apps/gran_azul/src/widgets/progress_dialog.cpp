@@ -3,13 +3,15 @@
 #include <algorithm>
 #include <iomanip>
 #include <sstream>
-#include <iostream>
+#include <log.h>
+#include <wip_string.h>
 
 namespace gran_azul::widgets {
 
 ProgressDialog::ProgressDialog(const std::string& title)
     : title_(title)
     , current_status_("Ready")
+    , output_(MAX_OUTPUT_SIZE)
     , progress_value_(0.0f)
     , is_visible_(false)
     , can_cancel_(true)
@@ -83,13 +85,13 @@ void ProgressDialog::show(const std::string& initial_status) {
     is_completed_ = false;
     progress_value_ = 0.0f;
     current_status_ = initial_status;
-    output_text_.clear();
+    clear_output();
     start_time_ = std::chrono::steady_clock::now();
     last_update_ = start_time_;
     popup_opened_ = false;  // Reset popup state
     scroll_to_bottom_ = false;  // Reset scroll flag
     
-    std::cout << "[PROGRESS_DIALOG] show() called with status: " << initial_status << std::endl;
+    LOG_DEBUG("PROGRESS_DIALOG", "show() called with status: ", initial_status);
 }
 
 void ProgressDialog::hide() {
@@ -106,31 +108,18 @@ void ProgressDialog::set_progress(float progress, const std::string& status) {
 }
 
 void ProgressDialog::add_output_line(const std::string& line) {
-    std::cout << "[PROGRESS_DIALOG] add_output_line called with: '" << line << "'" << std::endl;
+    LOG_TRACE("PROGRESS_DIALOG", "add_output_line called with: '", line, "'");
     
-    if (!output_text_.empty()) {
-        output_text_ += "\n";
-    }
-    output_text_ += line;
+    output_.append_line(line);
     
     // Set flag to scroll to bottom on next render
     if (auto_scroll_output_) {
         scroll_to_bottom_ = true;
     }
-    
-    // Limit output size to prevent memory issues
-    const size_t MAX_OUTPUT_SIZE = 50000; // ~50KB
-    if (output_text_.size() > MAX_OUTPUT_SIZE) {
-        // Remove oldest lines
-        size_t newline_pos = output_text_.find('\n', output_text_.size() - MAX_OUTPUT_SIZE + 1000);
-        if (newline_pos != std::string::npos) {
-            output_text_ = output_text_.substr(newline_pos + 1);
-        }
-    }
 }
 
 void ProgressDialog::set_completed(bool success, const std::string& final_message) {
-    std::cout << "[PROGRESS_DIALOG] Setting dialog as completed, success=" << success << std::endl;
+    LOG_DEBUG("PROGRESS_DIALOG", "Setting dialog as completed, success=", success);
     is_completed_ = true;
     progress_value_ = 1.0f;
     can_cancel_ = true; // Allow closing when completed
@@ -141,11 +130,37 @@ void ProgressDialog::set_completed(bool success, const std::string& final_messag
     } else {
         current_status_ = success ? "Completed successfully" : "Completed with errors";
     }
-    std::cout << "[PROGRESS_DIALOG] Dialog state: visible=" << is_visible_ << ", completed=" << is_completed_ << std::endl;
+    LOG_DEBUG("PROGRESS_DIALOG", "Dialog state: visible=", is_visible_, ", completed=", is_completed_);
 }
 
 void ProgressDialog::clear_output() {
-    output_text_.clear();
+    output_.clear();
+    filtered_lines_.clear();
+    filtered_until_ = 0;
+}
+
+void ProgressDialog::update_filtered_lines() {
+    if (filtered_text_ != output_filter_) {
+        filtered_text_ = output_filter_;
+        filtered_lines_.clear();
+        filtered_until_ = 0;
+    }
+    if (filtered_text_.empty()) {
+        return;
+    }
+    
+    const uint64_t first = output_.first_line_number();
+    while (!filtered_lines_.empty() && filtered_lines_.front() < first) {
+        filtered_lines_.pop_front();
+    }
+    
+    const uint64_t end = first + output_.line_count();
+    for (uint64_t number = std::max(filtered_until_, first); number < end; ++number) {
+        if (wip::utils::string::contains_ignore_case(output_.line(static_cast<size_t>(number - first)), filtered_text_)) {
+            filtered_lines_.push_back(number);
+        }
+    }
+    filtered_until_ = end;
 }
 
 void ProgressDialog::render_progress_bar() {
@@ -191,24 +206,18 @@ void ProgressDialog::render_output_section() {
     // Output text area
     ImVec2 output_size = ImVec2(-1, ImGui::GetContentRegionAvail().y - 60); // Reserve space for buttons
     if (ImGui::BeginChild("OutputText", output_size, true, ImGuiWindowFlags_HorizontalScrollbar)) {
-        if (!output_text_.empty()) {
-            std::string filter_str = output_filter_;
-            std::transform(filter_str.begin(), filter_str.end(), filter_str.begin(), ::tolower);
-            
-            if (filter_str.empty()) {
-                // No filter - show all text
-                ImGui::TextUnformatted(output_text_.c_str());
-            } else {
-                // Apply filter - show matching lines
-                std::istringstream iss(output_text_);
-                std::string line;
-                while (std::getline(iss, line)) {
-                    std::string line_lower = line;
-                    std::transform(line_lower.begin(), line_lower.end(), line_lower.begin(), ::tolower);
-                    
-                    if (line_lower.find(filter_str) != std::string::npos) {
-                        ImGui::TextUnformatted(line.c_str());
-                    }
+        update_filtered_lines();
+        if (!output_.empty()) {
+            // Only the lines in view are drawn, however much output there is
+            const bool filtered = !filtered_text_.empty();
+            const uint64_t first = output_.first_line_number();
+            ImGuiListClipper clipper;
+            clipper.Begin(static_cast<int>(filtered ? filtered_lines_.size() : output_.line_count()));
+            while (clipper.Step()) {
+                for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                    size_t index = filtered ? static_cast<size_t>(filtered_lines_[row] - first) : static_cast<size_t>(row);
+                    std::string_view line = output_.line(index);
+                    ImGui::TextUnformatted(line.data(), line.data() + line.size());
                 }
             }
             
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <widgets.h>
+#include <text_buffer.h>
+#include <cstdint>
+#include <deque>
 #include <string>
 #include <functional>
 #include <chrono>
@@ -19,7 +22,15 @@ public:
 private:
     std::string title_;
     std::string current_status_;
-    std::string output_text_;
+    
+    // Tool output; the oldest lines are dropped once it passes MAX_OUTPUT_SIZE
+    static constexpr size_t MAX_OUTPUT_SIZE = 1024 * 1024;
+    wip::gui::widgets::TextBuffer output_;
+    
+    // Line numbers of the output lines matching filtered_text_; only new lines are checked each frame
+    std::string filtered_text_;
+    std::deque<uint64_t> filtered_lines_;
+    uint64_t filtered_until_ = 0;
     float progress_value_;
     bool is_visible_;
     bool can_cancel_;
@@ -65,12 +76,13 @@ public:
     
     // Output management
     void clear_output();
-    const std::string& get_output() const { return output_text_; }
+    const wip::gui::widgets::TextBuffer& get_output() const { return output_; }
     
 private:
     void render_progress_bar();
     void render_status_text();
     void render_output_section();
+    void update_filtered_lines();
     void render_control_buttons();
     
     std::string format_elapsed_time() const;
@@ -1,6 +1,6 @@
 #include "project_startup_modal.h"
 #include <filesystem>
-#include <iostream>
+#include <log.h>
 #include <cstring>
 
 namespace gran_azul {
@@ -102,7 +102,14 @@ void ProjectStartupModal::render_welcome_screen() {
     ImGui::Spacing();
     ImGui::Spacing();
     
+    if (!loading_file_.empty()) {
+        ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "Loading %s...",
+                           std::filesystem::path(loading_file_).filename().string().c_str());
+        ImGui::Spacing();
+    }
+    
     // Center the buttons
+    ImGui::BeginDisabled(!loading_file_.empty());
     float button_width = 200.0f;
     float spacing = 20.0f;
     float total_width = button_width * 2 + spacing;
@@ -124,15 +131,16 @@ void ProjectStartupModal::render_welcome_screen() {
         
         nfdresult_t result = NFD_OpenDialog(&outPath, filterItem, 1, nullptr);
         if (result == NFD_OKAY) {
+            // The owner closes the modal once the project has loaded
             if (on_load_project_) {
                 on_load_project_(std::string(outPath));
             }
             NFD_FreePath(outPath);
-            show_modal_ = false;
         } else if (result != NFD_CANCEL) {
             show_error("Failed to open file dialog");
         }
     }
+    ImGui::EndDisabled();
     
     ImGui::Spacing();
     ImGui::Spacing();
@@ -307,7 +315,7 @@ bool ProjectStartupModal::create_project_directory(const std::string& path) {
         std::filesystem::create_directories(path);
         return true;
     } catch (const std::filesystem::filesystem_error& e) {
-        std::cerr << "Failed to create project directory: " << e.what() << std::endl;
+        LOG_ERROR("PROJECT_STARTUP", "Failed to create project directory: ", e.what());
         return false;
     }
 }
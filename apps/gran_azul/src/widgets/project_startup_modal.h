@@ -49,6 +49,9 @@ private:
     // Error state
     std::string error_message_;
     
+    // Project file being loaded in the background; empty when none
+    std::string loading_file_;
+    
     // Callbacks
     NewProjectCallback on_new_project_;
     LoadProjectCallback on_load_project_;
@@ -89,6 +92,13 @@ public:
      */
     void show_error(const std::string& message) { error_message_ = message; }
     
+    /**
+     * @brief Show that a project file is loading, or clear it with an empty path
+     * 
+     * While a file loads the modal stays responsive but offers only Exit.
+     */
+    void set_loading(const std::string& project_file) { loading_file_ = project_file; }
+    
     // Callback setters
     void set_new_project_callback(NewProjectCallback callback) { on_new_project_ = std::move(callback); }
     void set_load_project_callback(LoadProjectCallback callback) { on_load_project_ = std::move(callback); }
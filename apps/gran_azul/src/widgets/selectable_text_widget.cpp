@@ -1,6 +1,6 @@
 #include "selectable_text_widget.h"
 #include <imgui.h>
-#include <iostream>
+#include <log.h>
 
 namespace gran_azul::widgets {
 
@@ -63,7 +63,7 @@ void SelectableTextWidget::render_selectable_text_lines(const std::string& text,
 
 void SelectableTextWidget::copy_text_to_clipboard(const std::string& text) {
     ImGui::SetClipboardText(text.c_str());
-    std::cout << "[SELECTABLE_TEXT_WIDGET] Text copied to clipboard\n";
+    LOG_DEBUG("SELECTABLE_TEXT_WIDGET", "Text copied to clipboard");
 }
 
 } // namespace gran_azul::widgets
\ No newline at end of file
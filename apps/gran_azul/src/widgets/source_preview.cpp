@@ -0,0 +1,221 @@
+#include "source_preview.h"
+#include <imgui.h>
+#include <algorithm>
+#include <array>
+#include <charconv>
+
+namespace gran_azul::widgets {
+
+namespace {
+
+constexpr size_t TAB_WIDTH = 4;
+
+// Sorted for binary search
+constexpr std::array<std::string_view, 84> CPP_KEYWORDS = {
+    "alignas", "alignof", "and", "asm", "auto", "bool", "break", "case", "catch", "char", "char16_t",
+    "char32_t", "char8_t", "class", "co_await", "co_return", "co_yield", "concept", "const", "const_cast",
+    "consteval", "constexpr", "constinit", "continue", "decltype", "default", "delete", "do", "double",
+    "dynamic_cast", "else", "enum", "explicit", "export", "extern", "false", "final", "float", "for", "friend",
+    "goto", "if", "inline", "int", "long", "mutable", "namespace", "new", "noexcept", "not", "nullptr",
+    "operator", "or", "override", "private", "protected", "public", "register", "reinterpret_cast",
+    "requires", "return", "short", "signed", "sizeof", "static", "static_assert", "static_cast", "struct",
+    "switch", "template", "this", "thread_local", "throw", "true", "try", "typedef", "typeid", "typename",
+    "union", "unsigned", "using", "virtual", "void", "while"
+};
+
+bool is_keyword(std::string_view word) {
+    return std::binary_search(CPP_KEYWORDS.begin(), CPP_KEYWORDS.end(), word);
+}
+
+bool is_identifier_start(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+bool is_identifier_char(char c) {
+    return is_identifier_start(c) || (c >= '0' && c <= '9');
+}
+
+bool is_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+void add_span(std::vector<TokenSpan>& spans, size_t begin, size_t end, TokenKind kind) {
+    // Neighboring spans of one class are drawn as one
+    if (!spans.empty() && spans.back().kind == kind && spans.back().end == begin) {
+        spans.back().end = static_cast<uint32_t>(end);
+    } else {
+        spans.push_back({static_cast<uint32_t>(begin), static_cast<uint32_t>(end), kind});
+    }
+}
+
+std::string expand_tabs(std::string_view line) {
+    std::string text;
+    text.reserve(line.size());
+    for (char c : line) {
+        if (c == '\t') {
+            text.append(TAB_WIDTH - text.size() % TAB_WIDTH, ' ');
+        } else {
+            text.push_back(c);
+        }
+    }
+    return text;
+}
+
+ImU32 token_color(TokenKind kind, ImU32 text_color) {
+    switch (kind) {
+        case TokenKind::KEYWORD: return IM_COL32(86, 156, 214, 255);
+        case TokenKind::PREPROCESSOR: return IM_COL32(197, 134, 192, 255);
+        case TokenKind::STRING: return IM_COL32(206, 145, 120, 255);
+        case TokenKind::NUMBER: return IM_COL32(181, 206, 168, 255);
+        case TokenKind::COMMENT: return IM_COL32(106, 153, 85, 255);
+        case TokenKind::TEXT: break;
+    }
+    return text_color;
+}
+
+} // namespace
+
+void highlight_cpp_line(std::string_view line, bool& in_block_comment, std::vector<TokenSpan>& spans) {
+    spans.clear();
+    const size_t size = line.size();
+    size_t i = 0;
+
+    // Only whitespace may come before a directive
+    const size_t first = line.find_first_not_of(" \t");
+
+    while (i < size) {
+        const size_t start = i;
+        const char c = line[i];
+        const char next = i + 1 < size ? line[i + 1] : '\0';
+
+        if (in_block_comment || (c == '/' && next == '*')) {
+            size_t close = line.find("*/", in_block_comment ? i : i + 2);
+            in_block_comment = close == std::string_view::npos;
+            i = in_block_comment ? size : close + 2;
+            add_span(spans, start, i, TokenKind::COMMENT);
+        } else if (c == '/' && next == '/') {
+            add_span(spans, start, size, TokenKind::COMMENT);
+            break;
+        } else if (c == '#' && i == first) {
+            i = line.find_first_not_of(" \t", i + 1);
+            i = i == std::string_view::npos ? size : i;
+            while (i < size && is_identifier_char(line[i])) {
+                ++i;
+            }
+            add_span(spans, start, i, TokenKind::PREPROCESSOR);
+        } else if (c == '"' || c == '\'') {
+            for (++i; i < size && line[i] != c; ++i) {
+                i += line[i] == '\\';
+            }
+            i = std::min(i + 1, size);
+            add_span(spans, start, i, TokenKind::STRING);
+        } else if (is_digit(c) || (c == '.' && is_digit(next))) {
+            // Digit separators, suffixes and exponents belong to the number
+            while (i < size && (is_identifier_char(line[i]) || line[i] == '.' || line[i] == '\'')) {
+                ++i;
+            }
+            add_span(spans, start, i, TokenKind::NUMBER);
+        } else if (is_identifier_start(c)) {
+            while (i < size && is_identifier_char(line[i])) {
+                ++i;
+            }
+            add_span(spans, start, i, is_keyword(line.substr(start, i - start)) ? TokenKind::KEYWORD : TokenKind::TEXT);
+        } else {
+            add_span(spans, start, ++i, TokenKind::TEXT);
+        }
+    }
+}
+
+SourceSnippet make_snippet(const wip::utils::file::SourceFile& file, std::string_view file_path, int line_number,
+                           size_t context) {
+    SourceSnippet snippet;
+    snippet.file_path = file_path;
+    snippet.line_number = line_number;
+    snippet.loaded = true;
+
+    const size_t center = static_cast<size_t>(std::max(line_number, 1));
+    const size_t first = center > context ? center - context : 1;
+    const size_t last = std::min(center + context, file.line_count());
+
+    // A comment open at the first line is not known, so the snippet starts outside of one
+    bool in_block_comment = false;
+    for (size_t number = first; number <= last; ++number) {
+        SourceSnippet::Line line;
+        line.number = number;
+        line.text = expand_tabs(file.line(number));
+        highlight_cpp_line(line.text, in_block_comment, line.spans);
+        snippet.lines.push_back(std::move(line));
+    }
+    return snippet;
+}
+
+float SourcePreview::get_height() {
+    const ImGuiStyle& style = ImGui::GetStyle();
+    return ImGui::GetTextLineHeightWithSpacing() * static_cast<float>(2 * CONTEXT_LINES + 2) +
+           style.WindowPadding.y * 2.0f + style.ItemSpacing.y;
+}
+
+void SourcePreview::prefetch(std::string_view file_path) {
+    files_.prefetch(wip::utils::file::Path(file_path));
+}
+
+void SourcePreview::draw(std::string_view file_path, int line_number) {
+    if (snippet_.file_path != file_path || snippet_.line_number != line_number) {
+        snippet_ = SourceSnippet();
+        snippet_.file_path = file_path;
+        snippet_.line_number = line_number;
+    }
+
+    // Ask the cache every frame until the file is there; it never blocks
+    if (!snippet_.loaded) {
+        if (auto file = files_.find(wip::utils::file::Path(file_path))) {
+            snippet_ = make_snippet(*file, file_path, line_number, CONTEXT_LINES);
+        }
+    }
+
+    ImGui::BeginChild("SourcePreview", ImVec2(0.0f, get_height() - ImGui::GetStyle().ItemSpacing.y), true);
+    ImGui::TextDisabled("%s:%d", snippet_.file_path.c_str(), line_number);
+
+    if (!snippet_.loaded) {
+        ImGui::TextDisabled("Loading...");
+    } else if (snippet_.lines.empty()) {
+        ImGui::TextDisabled("Source not available");
+    } else {
+        ImDrawList* draw_list = ImGui::GetWindowDrawList();
+        const ImU32 text_color = ImGui::GetColorU32(ImGuiCol_Text);
+        const ImU32 muted_color = ImGui::GetColorU32(ImGuiCol_TextDisabled);
+        const ImU32 issue_line_color = IM_COL32(255, 255, 255, 24);
+        const float line_height = ImGui::GetTextLineHeight();
+        const float gutter_width = ImGui::CalcTextSize("000000").x;
+        const float width = ImGui::GetContentRegionAvail().x;
+
+        char number[16];
+        for (const auto& line : snippet_.lines) {
+            ImVec2 pos = ImGui::GetCursorScreenPos();
+            if (line.number == static_cast<size_t>(line_number)) {
+                draw_list->AddRectFilled(pos, ImVec2(pos.x + width, pos.y + line_height), issue_line_color);
+            }
+
+            auto end = std::to_chars(number, number + sizeof(number), line.number).ptr;
+            float number_width = ImGui::CalcTextSize(number, end).x;
+            draw_list->AddText(ImVec2(pos.x + gutter_width - number_width, pos.y), muted_color, number, end);
+
+            float x = pos.x + gutter_width + ImGui::GetStyle().ItemSpacing.x;
+            const char* text = line.text.data();
+            for (const auto& span : line.spans) {
+                draw_list->AddText(ImVec2(x, pos.y), token_color(span.kind, text_color), text + span.begin, text + span.end);
+                x += ImGui::CalcTextSize(text + span.begin, text + span.end).x;
+            }
+            ImGui::Dummy(ImVec2(x - pos.x, line_height));
+        }
+    }
+
+    ImGui::EndChild();
+}
+
+void SourcePreview::clear() {
+    files_.clear();
+    snippet_ = SourceSnippet();
+}
+
+} // namespace gran_azul::widgets
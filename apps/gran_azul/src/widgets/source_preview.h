@@ -0,0 +1,71 @@
+#pragma once
+
+#include <source_file_cache.h>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace gran_azul::widgets {
+
+// Token classes the preview colors
+enum class TokenKind : uint8_t {
+    TEXT,
+    KEYWORD,
+    PREPROCESSOR,
+    STRING,
+    NUMBER,
+    COMMENT
+};
+
+// Characters [begin, end) of a line that share a token class
+struct TokenSpan {
+    uint32_t begin;
+    uint32_t end;
+    TokenKind kind;
+};
+
+// Split a line of C++ into colored spans; in_block_comment carries /* */ comments from line to line
+void highlight_cpp_line(std::string_view line, bool& in_block_comment, std::vector<TokenSpan>& spans);
+
+// Highlighted source lines around an issue; built once when the file has loaded
+struct SourceSnippet {
+    struct Line {
+        size_t number;
+        std::string text;               // Tabs expanded
+        std::vector<TokenSpan> spans;
+    };
+
+    std::string file_path;
+    int line_number = 0;                // Line of the issue
+    bool loaded = false;                // The file was loaded; lines is empty if it couldn't be read
+    std::vector<Line> lines;
+};
+
+// Snippet of the lines within `context` lines of line_number
+SourceSnippet make_snippet(const wip::utils::file::SourceFile& file, std::string_view file_path, int line_number,
+                           size_t context);
+
+// Source pane of the results panel: shows the code around the selected issue.
+// Files are read on the cache's worker thread, so drawing never waits for the disk;
+// until a file is there the pane says so and looks again on the next frame.
+class SourcePreview {
+public:
+    static constexpr size_t CONTEXT_LINES = 6;
+
+    // Height the pane takes, for laying out the widgets above it
+    static float get_height();
+
+    // Load a file in the background, e.g. for the issues next to the selected one
+    void prefetch(std::string_view file_path);
+    void draw(std::string_view file_path, int line_number);
+
+    // Forget every file, e.g. when a new analysis run may have seen edited sources
+    void clear();
+
+private:
+    wip::utils::file::SourceFileCache files_;
+    SourceSnippet snippet_;
+};
+
+} // namespace gran_azul::widgets
@@ -0,0 +1,89 @@
+// Benchmark for the in-process banned token scanner.
+//
+// Scans generated C++ text for the default banned tokens, once with one
+// search per token, as a naive in-process check would, and once with the
+// tool's single-pass automaton. Then runs the tool over a tree of generated
+// files through the analysis engine, which maps every file and scans the
+// shards on its worker threads. Reports nanoseconds per byte. Usage:
+//
+//   bench_wip_analysis_banned_tokens [file-count] [file-kib]
+
+#include "benchmark.h"
+#include "analysis_engine.h"
+#include "tools/banned_token_tool.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace wip::analysis;
+
+namespace {
+
+// Code that looks like a source file, with a banned call every few hundred lines
+std::string generate_source(size_t bytes, size_t seed) {
+    std::string text;
+    text.reserve(bytes + 128);
+    for (size_t line = 0; text.size() < bytes; ++line) {
+        if ((line + seed) % 400 == 0) {
+            text += "    sprintf(buffer, \"%d\", value);\n";
+        } else {
+            text += "    result_" + std::to_string(line % 97) + " = compute_widget_state(input, " +
+                    std::to_string(line) + ");  // update\n";
+        }
+    }
+    return text;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    wip::benchmark::Runner runner("bench_wip_analysis_banned_tokens", argc, argv, "[file-count] [file-kib]");
+    size_t file_count = runner.argument(0, 256);
+    size_t file_bytes = runner.argument(1, 256) * 1024;
+
+    tools::BannedTokenTool tool;
+    std::vector<std::string> tokens;
+    for (const auto& banned : tools::BannedTokenConfig::get_default_tokens()) {
+        tokens.push_back(banned.token);
+    }
+
+    const std::string text = generate_source(file_bytes, 0);
+    runner.out() << tokens.size() << " tokens, " << file_count << " files of " << file_bytes / 1024 << " KiB" << std::endl;
+
+    runner.measure("one search per token", text.size(), [&]() {
+        size_t matches = 0;
+        std::string_view view(text);
+        for (const auto& token : tokens) {
+            for (size_t pos = view.find(token); pos != std::string_view::npos; pos = view.find(token, pos + 1)) {
+                ++matches;
+            }
+        }
+        return matches;
+    });
+
+    runner.measure("automaton, one pass", text.size(), [&]() {
+        std::vector<AnalysisIssue> issues;
+        tool.analyze_file("bench.cpp", text, issues);
+        return issues.size();
+    });
+
+    auto root = std::filesystem::temp_directory_path() / "wip_bench_banned_tokens";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root / "src");
+    for (size_t i = 0; i < file_count; ++i) {
+        std::ofstream(root / "src" / ("file" + std::to_string(i) + ".cpp")) << generate_source(file_bytes, i);
+    }
+
+    auto engine = AnalysisEngineFactory::create_engine_with_tools({"banned-tokens"});
+    AnalysisRequest request;
+    request.source_path = root.string();
+    runner.measure("engine, mapped files", file_count * file_bytes, [&]() {
+        auto results = engine->analyze_async({"banned-tokens"}, request).get();
+        return results.front().issues.size();
+    });
+
+    std::filesystem::remove_all(root);
+    return runner.finish();
+}
@@ -0,0 +1,114 @@
+// Microbenchmark for clang-tidy diagnostic line parsing.
+//
+// Compares the previous regex-based parser (regex constructed per line), the
+// same regex precompiled once, and the string_view scanner used by
+// ClangTidyTool. Usage:
+//
+//   bench_wip_analysis [recorded-clang-tidy-log]
+//
+// Without an argument a synthetic log of one million lines is generated.
+
+#include "benchmark.h"
+#include "tools/clang_tidy_diagnostic_parser.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <regex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace wip::analysis::tools;
+
+namespace {
+
+constexpr size_t SYNTHETIC_LINE_COUNT = 1000000;
+const char* DIAGNOSTIC_PATTERN = R"(^([^:]+):(\d+):(\d+):\s+(warning|error|note):\s+([^[]+)\s*(?:\[([^\]]+)\])?.*$)";
+
+std::vector<std::string> generate_log(size_t line_count) {
+    std::vector<std::string> lines;
+    lines.reserve(line_count);
+
+    for (size_t i = 0; lines.size() < line_count; ++i) {
+        std::string file = "/home/user/project/src/module_" + std::to_string(i % 97) + "/file_" + std::to_string(i % 13) + ".cpp";
+        lines.push_back(file + ":" + std::to_string(i % 2000 + 1) + ":" + std::to_string(i % 80 + 1) +
+                        ": warning: variable 'value' is not initialized [cppcoreguidelines-init-variables]");
+        lines.push_back("    int value;");
+        lines.push_back("        ^");
+        lines.push_back("              = 0");
+    }
+    lines.resize(line_count);
+    return lines;
+}
+
+std::vector<std::string> read_log(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open log file: " + path);
+    }
+
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(file, line)) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+template <typename Function>
+size_t count_matches(const std::vector<std::string>& lines, Function&& parse) {
+    size_t matches = 0;
+    for (const auto& line : lines) {
+        if (parse(line)) {
+            ++matches;
+        }
+    }
+    return matches;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    wip::benchmark::Runner runner("bench_wip_analysis", argc, argv, "[recorded-clang-tidy-log]");
+    std::vector<std::string> lines;
+    try {
+        lines = runner.arguments().empty() ? generate_log(SYNTHETIC_LINE_COUNT) : read_log(runner.arguments()[0]);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    runner.out() << "Parsing " << lines.size() << " lines" << std::endl;
+
+    size_t scanner_matches = 0;
+    runner.measure("string_view scanner", lines.size(), [&]() {
+        return scanner_matches = count_matches(lines, [](const std::string& line) {
+            return parse_clang_tidy_diagnostic(line).has_value();
+        });
+    });
+
+    const std::regex precompiled(DIAGNOSTIC_PATTERN);
+    size_t precompiled_matches = 0;
+    runner.measure("precompiled regex", lines.size(), [&]() {
+        return precompiled_matches = count_matches(lines, [&precompiled](const std::string& line) {
+            std::smatch matches;
+            return std::regex_match(line, matches, precompiled);
+        });
+    });
+
+    // The regex used to be constructed for every line; only sample that path on large logs
+    std::vector<std::string> sample(lines.begin(), lines.begin() + std::min<size_t>(lines.size(), 10000));
+    runner.measure("per-line regex (first 10k lines)", sample.size(), [&]() {
+        return count_matches(sample, [](const std::string& line) {
+            std::regex diagnostic_regex(DIAGNOSTIC_PATTERN);
+            std::smatch matches;
+            return std::regex_match(line, matches, diagnostic_regex);
+        });
+    });
+
+    if (runner.selected("string_view scanner") && runner.selected("precompiled regex") &&
+        scanner_matches != precompiled_matches) {
+        runner.out() << "Warning: match counts differ (" << scanner_matches << " vs " << precompiled_matches << ")" << std::endl;
+    }
+
+    return runner.finish();
+}
@@ -0,0 +1,76 @@
+// Benchmark for reading a compile_commands.json.
+//
+// Writes a database of the given number of units, each with a command line
+// as long as a CMake project's (include directories, definitions, warnings),
+// then compares loading it into a JSON document, as every tool did before,
+// with indexing it through CompilationDatabase, once cold and once shared
+// through open(). Also times writing the one-unit database a clang-tidy
+// process is given. Usage:
+//
+//   bench_wip_analysis_compilation_database [unit-count]
+
+#include "benchmark.h"
+#include "compilation_database.h"
+#include <nlohmann/json.hpp>
+#include <filesystem>
+#include <fstream>
+#include <mapped_file.h>
+#include <string>
+
+using namespace wip::analysis;
+
+int main(int argc, char* argv[]) {
+    wip::benchmark::Runner runner("bench_wip_analysis_compilation_database", argc, argv, "[unit-count]");
+    size_t unit_count = runner.argument(0, 50000);
+
+    std::string flags;
+    for (int i = 0; i < 40; ++i) {
+        flags += " -I/project/libs/module" + std::to_string(i) + "/include";
+    }
+    for (int i = 0; i < 20; ++i) {
+        flags += " -DFEATURE_" + std::to_string(i) + "=1";
+    }
+    flags += " -Wall -Wextra -Wpedantic -O2 -g -std=c++17 -fPIC";
+
+    auto directory = std::filesystem::temp_directory_path() / "bench_wip_analysis_compilation_database";
+    std::filesystem::create_directories(directory);
+    auto path = directory / "compile_commands.json";
+    {
+        std::ofstream file(path);
+        file << "[\n";
+        for (size_t i = 0; i < unit_count; ++i) {
+            std::string unit = "/project/src/module" + std::to_string(i / 100) + "/unit" + std::to_string(i) + ".cpp";
+            file << (i ? ",\n" : "") << "{\"directory\": \"/project/build\", \"file\": \"" << unit
+                 << "\", \"command\": \"/usr/bin/c++" << flags << " -o unit" << i << ".o -c " << unit << "\"}";
+        }
+        file << "\n]\n";
+    }
+    double megabytes = static_cast<double>(std::filesystem::file_size(path)) / (1024.0 * 1024.0);
+    runner.out() << unit_count << " units, " << megabytes << " MiB" << std::endl;
+
+    runner.measure("json document", unit_count, [&]() {
+        std::ifstream file(path);
+        return nlohmann::json::parse(file).size();
+    });
+
+    runner.measure("index (cold)", unit_count, [&]() {
+        auto mapped = wip::utils::file::MappedFile::open(path);
+        return CompilationDatabase::parse(mapped->view(), directory.string())->get_entries().size();
+    });
+
+    auto database = CompilationDatabase::open(directory.string());
+    runner.measure("open (shared)", 1, [&]() {
+        return CompilationDatabase::open(directory.string())->get_entries().size();
+    });
+
+    size_t middle = unit_count / 2;
+    std::string unit = "/project/src/module" + std::to_string(middle / 100) + "/unit" + std::to_string(middle) + ".cpp";
+    auto subset_directory = directory / "subset";
+    std::filesystem::create_directories(subset_directory);
+    runner.measure("one-unit database", 1, [&]() {
+        return database->write_subset({unit}, subset_directory);
+    });
+
+    std::filesystem::remove_all(directory);
+    return runner.finish();
+}
@@ -0,0 +1,88 @@
+// Benchmark for sending analysis shards to workers over loopback TCP.
+//
+// Runs the banned token scanner, posing as an external tool, over a tree of
+// generated files: once on this machine, once as single shards sent to a
+// worker, which shows the round trip each shard pays (request JSON, the
+// worker's tool set-up, the binary result back), and once through an engine
+// spreading every shard over two workers. Reports nanoseconds per file. Usage:
+//
+//   bench_wip_analysis_distributed [file-count] [worker-slots]
+
+#include "benchmark.h"
+#include "analysis_engine.h"
+#include "distributed_analysis.h"
+#include "tools/banned_token_tool.h"
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace wip::analysis;
+using wip::utils::net::Endpoint;
+
+namespace {
+
+class RemoteBannedTokenTool : public tools::BannedTokenTool {
+public:
+    bool runs_in_process() const override { return false; }
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    wip::benchmark::Runner runner("bench_wip_analysis_distributed", argc, argv, "[file-count] [worker-slots]");
+    size_t file_count = runner.argument(0, 512);
+    size_t slots = runner.argument(1, 4);
+
+    auto root = std::filesystem::temp_directory_path() / "wip_bench_distributed_analysis";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root / "src");
+    for (size_t i = 0; i < file_count; ++i) {
+        std::ofstream(root / "src" / ("file" + std::to_string(i) + ".cpp"))
+            << "int f" << i << "(char* out) {\n    sprintf(out, \"%d\", " << i << ");\n    return 0;\n}\n";
+    }
+
+    AnalysisWorker first(0, AnalysisWorker::Options{slots, "127.0.0.1"});
+    AnalysisWorker second(0, AnalysisWorker::Options{slots, "127.0.0.1"});
+    std::thread first_thread([&first]() { first.serve(); });
+    std::thread second_thread([&second]() { second.serve(); });
+
+    auto coordinator = std::make_shared<AnalysisCoordinator>(std::vector<Endpoint>{
+        Endpoint{"127.0.0.1", first.get_port()}, Endpoint{"127.0.0.1", second.get_port()}});
+    runner.out() << file_count << " files, " << coordinator->connect() << " remote slots" << std::endl;
+
+    AnalysisRequest request;
+    request.source_path = root.string();
+    RemoteBannedTokenTool tool;
+
+    runner.measure("local execute", file_count, [&]() {
+        return tool.execute(request).issues.size();
+    });
+
+    runner.measure("one shard, remote", file_count, [&]() {
+        return coordinator->execute_shard(tool, request).issues.size();
+    });
+
+    AnalysisEngine local_engine;
+    local_engine.register_tool(std::make_unique<RemoteBannedTokenTool>());
+    local_engine.set_concurrency(2 * slots);
+    runner.measure("engine, local shards", file_count, [&]() {
+        return local_engine.analyze_async({"banned-tokens"}, request).get().front().issues.size();
+    });
+
+    AnalysisEngine remote_engine;
+    remote_engine.register_tool(std::make_unique<RemoteBannedTokenTool>());
+    remote_engine.set_shard_executor(coordinator);
+    runner.measure("engine, remote shards", file_count, [&]() {
+        return remote_engine.analyze_async({"banned-tokens"}, request).get().front().issues.size();
+    });
+
+    first.stop();
+    second.stop();
+    first_thread.join();
+    second_thread.join();
+    std::filesystem::remove_all(root);
+    return runner.finish();
+}
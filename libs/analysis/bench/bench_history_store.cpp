@@ -0,0 +1,115 @@
+// Benchmark for cross-run history queries.
+//
+// Records a series of runs in a HistoryStore and asks for the issues of one
+// file and the trend of one rule over all of them. As a baseline, the same
+// runs are kept as one binary result file each, and every query loads the
+// runs with BinaryResultFile::read_all and filters them. Usage:
+//
+//   bench_wip_analysis_history [run-count] [issues-per-run]
+//
+// The defaults are 30 runs of fifty thousand issues spread over 2000 files.
+
+#include "benchmark.h"
+#include "history_store.h"
+#include "result_file.h"
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace wip::analysis;
+
+namespace {
+
+constexpr size_t DEFAULT_RUN_COUNT = 30;
+constexpr size_t DEFAULT_ISSUE_COUNT = 50000;
+const std::string QUERY_FILE = "/home/user/project/src/module_7/file_7.cpp";
+const std::string QUERY_RULE = "rule7";
+
+std::vector<AnalysisResult> generate_run(size_t run, size_t issue_count) {
+    AnalysisResult result;
+    result.tool_name = "cppcheck";
+    result.success = true;
+    result.files_analyzed = 2000;
+    result.issues.reserve(issue_count);
+
+    // Each run fixes a few issues, so the counts drift from run to run
+    for (size_t i = run; i < issue_count + run; ++i) {
+        AnalysisIssue issue;
+        issue.file_path = "/home/user/project/src/module_" + std::to_string(i % 2000 % 97) + "/file_" +
+                          std::to_string(i % 2000) + ".cpp";
+        issue.line_number = static_cast<int>(i % 5000 + 1);
+        issue.column_number = static_cast<int>(i % 80 + 1);
+        issue.rule_id = "rule" + std::to_string(i % 150);
+        issue.message = "Variable 'value" + std::to_string(i % 40) + "' is assigned a value that is never used";
+        issue.severity = static_cast<IssueSeverity>(i % 4);
+        issue.category = static_cast<IssueCategory>(i % 7);
+        issue.tool_name = "cppcheck";
+        result.issues.push_back(std::move(issue));
+    }
+    result.compute_statistics();
+    return {result};
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    wip::benchmark::Runner runner("bench_wip_analysis_history", argc, argv, "[run-count] [issues-per-run]");
+    size_t run_count = runner.argument(0, DEFAULT_RUN_COUNT);
+    size_t issue_count = runner.argument(1, DEFAULT_ISSUE_COUNT);
+
+    auto directory = std::filesystem::temp_directory_path() / "bench_history_store";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    std::vector<std::string> run_files;
+    {
+        HistoryStore history((directory / "history").string());
+        for (size_t run = 0; run < run_count; ++run) {
+            auto results = generate_run(run, issue_count);
+            history.append_run(results);
+            run_files.push_back((directory / ("run-" + std::to_string(run) + ".wipr")).string());
+            BinaryResultFile::write(results, run_files.back());
+        }
+    }
+    runner.out() << "Querying " << run_count << " runs of " << issue_count << " issues" << std::endl;
+
+    HistoryStore history((directory / "history").string());
+    runner.measure("file issues: load runs", run_count, [&]() {
+        size_t matches = 0;
+        for (const auto& path : run_files) {
+            for (const auto& result : BinaryResultFile(path).read_all()) {
+                for (const auto& issue : result.issues) {
+                    matches += issue.file_path == QUERY_FILE;
+                }
+            }
+        }
+        return matches;
+    });
+    runner.measure("file issues: history", run_count, [&]() {
+        size_t matches = 0;
+        for (const auto& run : history.get_issues_in_file(QUERY_FILE, 0)) {
+            matches += run.issues.size();
+        }
+        return matches;
+    });
+
+    runner.measure("rule trend: load runs", run_count, [&]() {
+        std::vector<size_t> trend;
+        for (const auto& path : run_files) {
+            size_t count = 0;
+            for (const auto& result : BinaryResultFile(path).read_all()) {
+                for (const auto& issue : result.issues) {
+                    count += issue.rule_id == QUERY_RULE;
+                }
+            }
+            trend.push_back(count);
+        }
+        return trend.size();
+    });
+    runner.measure("rule trend: history", run_count, [&]() {
+        return history.get_rule_trend(QUERY_RULE, 0).size();
+    });
+
+    std::filesystem::remove_all(directory);
+    return runner.finish();
+}
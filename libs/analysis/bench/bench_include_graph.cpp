@@ -0,0 +1,112 @@
+// Benchmark for the include graph behind incremental re-analysis.
+//
+// Generates a project of translation units including a few headers each,
+// from a layer of headers that include each other. Measures a full scan,
+// a rescan of the unchanged project (a stat per file), planning the units
+// against the analysis cache with a fresh graph, as every run did before the
+// graph was kept, and with a shared one, and finally reporting one edited
+// header: rescanning it and finding the units it reaches. Reports
+// nanoseconds per file, and per edit for the last one. Usage:
+//
+//   bench_wip_analysis_include_graph [unit-count] [header-count]
+
+#include "benchmark.h"
+#include "analysis_cache.h"
+#include "include_graph.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace wip::analysis;
+
+namespace {
+
+std::string header_name(size_t index) {
+    return "header_" + std::to_string(index) + ".h";
+}
+
+// Each file gets some code so reading and hashing it costs what a real one does
+std::string body(size_t lines) {
+    std::string text;
+    for (size_t line = 0; line < lines; ++line) {
+        text += "int function_" + std::to_string(line) + "(int value) { return value * " + std::to_string(line) + "; }\n";
+    }
+    return text;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    wip::benchmark::Runner runner("bench_wip_analysis_include_graph", argc, argv, "[unit-count] [header-count]");
+    size_t unit_count = runner.argument(0, 2000);
+    size_t header_count = std::max<size_t>(runner.argument(1, 400), 1);
+
+    auto root = std::filesystem::temp_directory_path() / "wip_bench_include_graph";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root / "src");
+    std::filesystem::create_directories(root / "include");
+
+    // Headers include two lower ones, so deep headers reach many units
+    for (size_t i = 0; i < header_count; ++i) {
+        std::ofstream file(root / "include" / header_name(i));
+        file << "#pragma once\n#include <vector>\n";
+        if (i > 0) {
+            file << "#include \"" << header_name(i / 2) << "\"\n";
+            file << "#include \"" << header_name((i * 7) % i) << "\"\n";
+        }
+        file << body(40);
+    }
+
+    std::vector<std::string> units;
+    for (size_t i = 0; i < unit_count; ++i) {
+        std::string name = "src/unit_" + std::to_string(i) + ".cpp";
+        std::ofstream file(root / name);
+        for (size_t j = 0; j < 4; ++j) {
+            file << "#include <" << header_name((i * 31 + j * 17) % header_count) << ">\n";
+        }
+        file << body(200);
+        units.push_back(name);
+    }
+
+    AnalysisRequest request;
+    request.source_path = root.string();
+    request.include_paths = {"include"};
+    const size_t file_count = unit_count + header_count;
+    runner.out() << unit_count << " units, " << header_count << " headers" << std::endl;
+
+    runner.measure("full scan", file_count, [&]() {
+        IncludeGraph graph(request);
+        return graph.scan(units);
+    });
+
+    auto graph = std::make_shared<IncludeGraph>(request);
+    graph->scan(units);
+    runner.measure("rescan, nothing changed", file_count, [&]() {
+        return graph->scan(units) + graph->get_file_count();
+    });
+
+    AnalysisCache cache;
+    runner.measure("plan, fresh graph", file_count, [&]() {
+        return cache.plan("tool", "1.0", "config", units, request).changed_units.size();
+    });
+
+    cache.set_include_graph(graph);
+    runner.measure("plan, shared graph", file_count, [&]() {
+        return cache.plan("tool", "1.0", "config", units, request).changed_units.size();
+    });
+
+    const std::string edited = (root / "include" / header_name(header_count / 3)).string();
+    size_t affected = 0;
+    runner.measure("update one header", 1, [&]() {
+        affected = graph->update({edited}).size();
+        return affected;
+    });
+    runner.out() << "An edit of " << header_name(header_count / 3) << " affects " << affected << " of "
+                 << unit_count << " units" << std::endl;
+
+    std::filesystem::remove_all(root);
+    return runner.finish();
+}
@@ -0,0 +1,80 @@
+// Benchmark for substring search over issues.
+//
+// Builds an IssueSearchIndex over a store of issues and looks up a few
+// filter texts of different selectivity. As a baseline, the same texts are
+// matched with a case insensitive scan over the file path, rule and message
+// of every issue, as a filter box without an index does on each keystroke.
+// Usage:
+//
+//   bench_wip_analysis_search [issue-count]
+//
+// The default is half a million issues spread over 2000 files, 150 rules and
+// 5000 distinct messages.
+
+#include "benchmark.h"
+#include "issue_search_index.h"
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace wip::analysis;
+
+namespace {
+
+constexpr size_t DEFAULT_ISSUE_COUNT = 500000;
+
+std::vector<AnalysisIssue> generate_issues(size_t issue_count) {
+    std::vector<AnalysisIssue> issues(issue_count);
+    for (size_t i = 0; i < issue_count; ++i) {
+        AnalysisIssue& issue = issues[i];
+        issue.file_path = "/home/user/project/src/module_" + std::to_string(i % 2000 % 97) + "/file_" +
+                          std::to_string(i % 2000) + ".cpp";
+        issue.line_number = static_cast<int>(i % 5000 + 1);
+        issue.rule_id = "rule" + std::to_string(i % 150);
+        issue.message = "Variable 'value" + std::to_string(i % 5000) + "' is assigned a value that is never used";
+        issue.tool_name = "cppcheck";
+    }
+    return issues;
+}
+
+bool contains_ignore_case(std::string_view text, std::string_view filter) {
+    auto equal = [](char a, char b) {
+        return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+    };
+    return std::search(text.begin(), text.end(), filter.begin(), filter.end(), equal) != text.end();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    wip::benchmark::Runner runner("bench_wip_analysis_search", argc, argv, "[issue-count]");
+    size_t issue_count = runner.argument(0, DEFAULT_ISSUE_COUNT);
+    IssueStore store(generate_issues(issue_count));
+    runner.out() << "Searching " << issue_count << " issues" << std::endl;
+
+    IssueSearchIndex index;
+    runner.measure("build index", issue_count, [&]() {
+        index = IssueSearchIndex(store);
+        return index.get_string_count();
+    });
+
+    // A rare message, a file, a rule shared by many issues and a text in every message
+    for (const char* text : {"VALUE4242'", "file_17.cpp", "rule12", "never used"}) {
+        runner.measure(std::string("scan: ") + text, issue_count, [&]() {
+            size_t matches = 0;
+            for (size_t i = 0; i < store.size(); ++i) {
+                auto issue = store[i];
+                matches += contains_ignore_case(issue.file_path(), text) || contains_ignore_case(issue.rule_id(), text) ||
+                           contains_ignore_case(issue.message(), text);
+            }
+            return matches;
+        });
+        runner.measure(std::string("index: ") + text, issue_count, [&]() {
+            return index.find(text).size();
+        });
+    }
+
+    return runner.finish();
+}
@@ -0,0 +1,104 @@
+// Microbenchmark for the scratch allocations of a parse pass.
+//
+// Compares keeping diagnostic lines and deduplication sets on the heap with
+// taking them from a ParseArena, for the merge of a sharded clang-tidy run
+// (line copies plus an ordered set) and for issue deduplication (hash set of
+// issue keys). Usage:
+//
+//   bench_wip_analysis_parse_arena [diagnostic-count]
+
+#include "benchmark.h"
+#include "analysis_types.h"
+#include "parse_arena.h"
+#include <set>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+using namespace wip::analysis;
+
+namespace {
+
+// Every TU reports the diagnostics of the shared headers again
+std::vector<std::string> generate_diagnostics(size_t count) {
+    std::vector<std::string> lines;
+    lines.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        size_t source = i % 3 == 0 ? i % 500 : i;
+        lines.push_back("/home/user/project/src/module_" + std::to_string(source % 97) + "/file_" + std::to_string(source) +
+                        ".cpp:" + std::to_string(source % 2000 + 1) +
+                        ":7: warning: variable 'value' is not initialized [cppcoreguidelines-init-variables]");
+    }
+    return lines;
+}
+
+std::vector<AnalysisIssue> generate_issues(size_t count) {
+    std::vector<AnalysisIssue> issues(count);
+    for (size_t i = 0; i < count; ++i) {
+        size_t source = i % 3 == 0 ? i % 500 : i;
+        issues[i].file_path = "/home/user/project/src/module_" + std::to_string(source % 97) + "/file_" + std::to_string(source) + ".cpp";
+        issues[i].line_number = static_cast<int>(source % 2000 + 1);
+        issues[i].rule_id = "cppcoreguidelines-init-variables";
+    }
+    return issues;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    wip::benchmark::Runner runner("bench_wip_analysis_parse_arena", argc, argv, "[diagnostic-count]");
+    size_t count = runner.argument(0, 500000);
+    auto lines = generate_diagnostics(count);
+    auto issues = generate_issues(count);
+    runner.out() << "Merging " << count << " diagnostic lines" << std::endl;
+
+    runner.measure("merge, heap lines and set", count, [&]() {
+        std::vector<std::string> kept;
+        for (const auto& line : lines) {
+            kept.emplace_back(line);
+        }
+        std::set<std::string_view> seen;
+        size_t unique = 0;
+        for (const auto& line : kept) {
+            unique += seen.insert(line).second;
+        }
+        return unique;
+    });
+
+    runner.measure("merge, arena lines and set", count, [&]() {
+        ParseArena arena;
+        std::pmr::vector<std::string_view> kept(arena.resource());
+        for (const auto& line : lines) {
+            kept.push_back(arena.copy(line));
+        }
+        std::pmr::set<std::string_view> seen(arena.resource());
+        size_t unique = 0;
+        for (const auto& line : kept) {
+            unique += seen.insert(line).second;
+        }
+        return unique;
+    });
+
+    runner.measure("dedup keys, heap set", count, [&]() {
+        std::unordered_set<IssueKey, IssueKeyHash> seen;
+        seen.reserve(issues.size());
+        size_t unique = 0;
+        for (const auto& issue : issues) {
+            unique += seen.insert(issue.key()).second;
+        }
+        return unique;
+    });
+
+    runner.measure("dedup keys, arena set", count, [&]() {
+        ParseArena arena;
+        std::pmr::unordered_set<IssueKey, IssueKeyHash> seen(arena.resource());
+        seen.reserve(issues.size());
+        size_t unique = 0;
+        for (const auto& issue : issues) {
+            unique += seen.insert(issue.key()).second;
+        }
+        return unique;
+    });
+
+    return runner.finish();
+}
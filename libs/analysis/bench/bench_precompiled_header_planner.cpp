@@ -0,0 +1,57 @@
+// Benchmark for grouping translation units by shared include prefix.
+//
+// Generates units shaped like a C++ code base: each module has a common
+// header every unit starts with, after a few standard headers picked from a
+// small set, and units add headers of their own. Reports how many units get
+// a precompiled header, how many headers would be built, and the planning
+// time per unit. Usage:
+//
+//   bench_wip_analysis_precompiled_header_planner [unit-count] [min-units]
+
+#include "benchmark.h"
+#include "precompiled_header_planner.h"
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace wip::analysis;
+
+int main(int argc, char* argv[]) {
+    wip::benchmark::Runner runner("bench_wip_analysis_precompiled_header_planner", argc, argv, "[unit-count] [min-units]");
+    size_t unit_count = runner.argument(0, 20000);
+    size_t min_units = runner.argument(1, 3);
+
+    static const char* const STANDARD_HEADERS[] = {"<vector>", "<string>", "<map>", "<memory>", "<algorithm>"};
+    std::mt19937 random(42);
+    std::uniform_int_distribution<size_t> standard(0, 4);
+    std::uniform_int_distribution<size_t> own(0, 3);
+
+    std::vector<PrecompiledHeaderPlanner::Unit> units(unit_count);
+    for (size_t i = 0; i < unit_count; ++i) {
+        auto& unit = units[i];
+        std::string module = "/project/src/module" + std::to_string(i / 100);
+        unit.path = module + "/unit" + std::to_string(i) + ".cpp";
+        unit.command.directory = "/project/build";
+        unit.command.flags = {"-std=c++17", "-I/project/include"};
+        unit.includes.push_back('"' + module + "/module.h\"");
+        unit.includes.push_back(STANDARD_HEADERS[standard(random)]);
+        for (size_t j = own(random); j > 0; --j) {
+            unit.includes.push_back('"' + module + "/detail" + std::to_string(i % 7) + "_" + std::to_string(j) + ".h\"");
+        }
+    }
+    runner.out() << unit_count << " units, groups of at least " << min_units << std::endl;
+
+    auto groups = PrecompiledHeaderPlanner::plan(units, min_units);
+    size_t covered = 0;
+    for (const auto& group : groups) {
+        covered += group.units.size();
+    }
+    runner.report("precompiled headers", static_cast<double>(groups.size()), "");
+    runner.report("units with a precompiled header", 100.0 * static_cast<double>(covered) / static_cast<double>(unit_count), "%");
+
+    runner.measure("plan", unit_count, [&]() {
+        return PrecompiledHeaderPlanner::plan(units, min_units).size();
+    });
+
+    return runner.finish();
+}
@@ -0,0 +1,151 @@
+// Benchmark for the channel carrying tool output and progress to the UI.
+//
+// Several producer threads stand in for tool workers, each publishing lines
+// and a progress update every few lines, while a consumer thread stands in
+// for the UI and collects what arrived once per simulated frame. Compares the
+// previous path, where every line was queued as a task under a mutex and
+// progress was throttled under another one, with the lock-free channel, once
+// with its default ring and once with one holding every line. Reports
+// nanoseconds per published line until the producers are done, and how many
+// lines and progress updates the consumer saw. Usage:
+//
+//   bench_wip_analysis_progress_channel [producer-count] [lines-per-producer] [frame-microseconds]
+
+#include "benchmark.h"
+#include "progress_channel.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace wip::analysis;
+
+namespace {
+
+// The previous path: each line becomes a task posted to the UI queue
+class LockedQueue {
+public:
+    void post(std::function<void()> task) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(std::move(task));
+    }
+
+    size_t run_pending() {
+        std::deque<std::function<void()>> tasks;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks.swap(tasks_);
+        }
+        for (auto& task : tasks) {
+            task();
+        }
+        return tasks.size();
+    }
+
+private:
+    std::mutex mutex_;
+    std::deque<std::function<void()>> tasks_;
+};
+
+template<typename Produce, typename Consume>
+void run_frames(size_t producer_count, std::chrono::microseconds frame, Produce produce, Consume consume) {
+    std::atomic<size_t> running{producer_count};
+    std::vector<std::thread> producers;
+    for (size_t p = 0; p < producer_count; ++p) {
+        producers.emplace_back([&, p]() {
+            produce(p);
+            --running;
+        });
+    }
+    while (running.load() > 0) {
+        consume();
+        std::this_thread::sleep_for(frame);
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    consume();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    wip::benchmark::Runner runner("bench_wip_analysis_progress_channel", argc, argv,
+                                  "[producer-count] [lines-per-producer] [frame-microseconds]");
+    size_t producer_count = std::max<size_t>(runner.argument(0, 4), 1);
+    size_t line_count = runner.argument(1, 100000);
+    std::chrono::microseconds frame(runner.argument(2, 1000));
+    constexpr size_t LINES_PER_PROGRESS = 16;
+
+    std::vector<std::string> tools;
+    for (size_t p = 0; p < producer_count; ++p) {
+        tools.push_back("tool_" + std::to_string(p));
+    }
+    const std::string line = "src/module/file.cpp:42:7: style: Variable 'value' is assigned a value that is never used.";
+    const uint64_t total_lines = producer_count * line_count;
+    runner.out() << producer_count << " producers, " << line_count << " lines each, "
+                 << frame.count() << " us frames" << std::endl;
+
+    size_t seen_lines = 0;
+    size_t seen_progress = 0;
+    runner.measure("mutex queue, throttled progress", total_lines, [&]() {
+        LockedQueue queue;
+        std::mutex throttle_mutex;
+        auto last_progress = std::chrono::steady_clock::now();
+        seen_lines = 0;
+        seen_progress = 0;
+        run_frames(producer_count, frame, [&](size_t p) {
+            for (size_t i = 0; i < line_count; ++i) {
+                queue.post([&, tool = tools[p], text = line]() { seen_lines += !tool.empty() && !text.empty(); });
+                if (i % LINES_PER_PROGRESS == 0) {
+                    auto now = std::chrono::steady_clock::now();
+                    std::lock_guard<std::mutex> lock(throttle_mutex);
+                    if (now - last_progress < std::chrono::milliseconds(100)) {
+                        continue;
+                    }
+                    last_progress = now;
+                    AnalysisProgress progress;
+                    progress.processed_files = i;
+                    queue.post([&, progress]() { seen_progress += progress.processed_files <= line_count; });
+                }
+            }
+        }, [&]() { queue.run_pending(); });
+        return seen_lines;
+    });
+    runner.out() << "  delivered " << seen_lines << " lines, " << seen_progress << " progress updates" << std::endl;
+
+    // The default ring drops what a flat-out producer outruns; one holding every line shows the cost without drops
+    ProgressChannel::Statistics statistics;
+    for (size_t capacity : {ProgressChannel::DEFAULT_LINE_CAPACITY, static_cast<size_t>(total_lines)}) {
+        runner.measure("progress channel, " + std::to_string(capacity) + " lines", total_lines, [&]() {
+            ProgressChannel channel(tools, capacity);
+            seen_lines = 0;
+            seen_progress = 0;
+            run_frames(producer_count, frame, [&](size_t p) {
+                for (size_t i = 0; i < line_count; ++i) {
+                    channel.publish_line(tools[p], line);
+                    if (i % LINES_PER_PROGRESS == 0) {
+                        AnalysisProgress progress;
+                        progress.processed_files = i;
+                        channel.publish_progress(tools[p], progress);
+                    }
+                }
+            }, [&]() {
+                channel.drain([&](const std::string&, const std::string&) { ++seen_lines; },
+                              [&](const std::string&, const AnalysisProgress&) { ++seen_progress; });
+            });
+            statistics = channel.get_statistics();
+            return seen_lines;
+        });
+        runner.out() << "  delivered " << seen_lines << " lines, " << seen_progress << " progress updates; dropped "
+                     << statistics.lines_dropped << " lines, merged " << statistics.progress_merged
+                     << " updates, peak " << statistics.peak_queued_lines << " queued" << std::endl;
+    }
+
+    return runner.finish();
+}
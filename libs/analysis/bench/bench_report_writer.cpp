@@ -0,0 +1,95 @@
+// Benchmark for writing analysis reports.
+//
+// Writes the same result as a JSON report by building the nlohmann DOM and
+// dumping it, the way reports used to be written, and by streaming it
+// through ReportWriter as JSON, HTML and SARIF. Output goes to a stream that
+// discards it, so only rendering is timed. Usage:
+//
+//   bench_wip_analysis_reports [issue-count]
+//
+// The default is two hundred thousand issues spread over 2000 files.
+
+#include "benchmark.h"
+#include "report_writer.h"
+#include <ostream>
+#include <streambuf>
+#include <string>
+
+using namespace wip::analysis;
+
+namespace {
+
+constexpr size_t DEFAULT_ISSUE_COUNT = 200000;
+
+// Counts and discards everything written to it
+class CountingBuffer : public std::streambuf {
+public:
+    size_t size() const { return size_; }
+
+protected:
+    int_type overflow(int_type c) override {
+        size_ += traits_type::eq_int_type(c, traits_type::eof()) ? 0 : 1;
+        return traits_type::not_eof(c);
+    }
+
+    std::streamsize xsputn(const char*, std::streamsize count) override {
+        size_ += static_cast<size_t>(count);
+        return count;
+    }
+
+private:
+    size_t size_ = 0;
+};
+
+AnalysisResult generate_result(size_t issue_count) {
+    AnalysisResult result;
+    result.tool_name = "cppcheck";
+    result.success = true;
+    result.issues.reserve(issue_count);
+    for (size_t i = 0; i < issue_count; ++i) {
+        AnalysisIssue issue;
+        issue.id = "rule" + std::to_string(i % 150);
+        issue.file_path = "/home/user/project/src/module_" + std::to_string(i % 97) + "/file_" + std::to_string(i % 2000) + ".cpp";
+        issue.line_number = static_cast<int>(i % 5000 + 1);
+        issue.column_number = static_cast<int>(i % 80 + 1);
+        issue.rule_id = issue.id;
+        issue.message = "Variable 'value" + std::to_string(i % 40) + "' is assigned a value that is never used";
+        issue.severity = static_cast<IssueSeverity>(i % 4);
+        issue.category = static_cast<IssueCategory>(i % 7);
+        issue.tool_name = "cppcheck";
+        result.issues.push_back(std::move(issue));
+    }
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    wip::benchmark::Runner runner("bench_wip_analysis_reports", argc, argv, "[issue-count]");
+    size_t issue_count = runner.argument(0, DEFAULT_ISSUE_COUNT);
+    const AnalysisResult result = generate_result(issue_count);
+    runner.out() << "Writing reports of " << issue_count << " issues" << std::endl;
+
+    runner.measure("nlohmann DOM + dump", issue_count, [&]() {
+        CountingBuffer buffer;
+        std::ostream out(&buffer);
+        nlohmann::json report;
+        report["tools"] = nlohmann::json::array({result.to_json()});
+        out << report.dump(2);
+        return buffer.size();
+    });
+
+    auto stream = [&](ReportFormat format) {
+        CountingBuffer buffer;
+        std::ostream out(&buffer);
+        ReportWriter writer(out, format);
+        writer.write_result(result);
+        writer.finish();
+        return buffer.size();
+    };
+    runner.measure("ReportWriter JSON", issue_count, [&]() { return stream(ReportFormat::Json); });
+    runner.measure("ReportWriter HTML", issue_count, [&]() { return stream(ReportFormat::Html); });
+    runner.measure("ReportWriter SARIF", issue_count, [&]() { return stream(ReportFormat::Sarif); });
+
+    return runner.finish();
+}
@@ -0,0 +1,114 @@
+// Benchmark for saving and loading analysis results.
+//
+// Compares the JSON format with the binary and NDJSON formats, both through
+// AnalysisEngine::save_results / load_results and by scanning the mapped
+// binary file without materializing issues. NDJSON is also read on one
+// thread and split over all of them. Usage:
+//
+//   bench_wip_analysis_results [issue-count]
+//
+// The default is half a million issues spread over 2000 files.
+
+#include "analysis_engine.h"
+#include "benchmark.h"
+#include "result_file.h"
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace wip::analysis;
+
+namespace {
+
+constexpr size_t DEFAULT_ISSUE_COUNT = 500000;
+
+std::vector<AnalysisResult> generate_results(size_t issue_count) {
+    AnalysisResult result;
+    result.tool_name = "cppcheck";
+    result.success = true;
+    result.files_analyzed = 2000;
+    result.issues.reserve(issue_count);
+
+    for (size_t i = 0; i < issue_count; ++i) {
+        AnalysisIssue issue;
+        issue.file_path = "/home/user/project/src/module_" + std::to_string(i % 97) + "/file_" + std::to_string(i % 2000) + ".cpp";
+        issue.line_number = static_cast<int>(i % 5000 + 1);
+        issue.column_number = static_cast<int>(i % 80 + 1);
+        issue.rule_id = "rule" + std::to_string(i % 150);
+        issue.message = "Variable 'value" + std::to_string(i % 40) + "' is assigned a value that is never used";
+        issue.severity = static_cast<IssueSeverity>(i % 4);
+        issue.category = static_cast<IssueCategory>(i % 7);
+        issue.tool_name = "cppcheck";
+        result.issues.push_back(std::move(issue));
+    }
+    result.compute_statistics();
+    return {result};
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    wip::benchmark::Runner runner("bench_wip_analysis_results", argc, argv, "[issue-count]");
+    size_t issue_count = runner.argument(0, DEFAULT_ISSUE_COUNT);
+    auto results = generate_results(issue_count);
+    runner.out() << "Saving and loading " << issue_count << " issues" << std::endl;
+
+    auto directory = std::filesystem::temp_directory_path();
+    auto json_file = (directory / "bench_results.json").string();
+    auto binary_file = (directory / "bench_results.wipr").string();
+    auto ndjson_file = (directory / "bench_results.ndjson").string();
+    AnalysisEngine engine;
+
+    runner.measure("save json", issue_count, [&]() { engine.save_results(results, json_file); });
+    runner.measure("save binary", issue_count, [&]() { engine.save_results(results, binary_file, ResultFormat::Binary); });
+    runner.measure("save ndjson", issue_count, [&]() { engine.save_results(results, ndjson_file, ResultFormat::Ndjson); });
+    // Loading needs every file even when --filter skipped saving them
+    if (!std::filesystem::exists(json_file)) engine.save_results(results, json_file);
+    if (!std::filesystem::exists(binary_file)) engine.save_results(results, binary_file, ResultFormat::Binary);
+    if (!std::filesystem::exists(ndjson_file)) engine.save_results(results, ndjson_file, ResultFormat::Ndjson);
+    runner.report("json size", std::filesystem::file_size(json_file) / 1024.0, "KiB");
+    runner.report("binary size", std::filesystem::file_size(binary_file) / 1024.0, "KiB");
+    runner.report("ndjson size", std::filesystem::file_size(ndjson_file) / 1024.0, "KiB");
+
+    size_t loaded_json = issue_count;
+    size_t loaded_binary = issue_count;
+    runner.measure("load json", issue_count, [&]() {
+        return loaded_json = engine.load_results(json_file)[0].issues.size();
+    });
+    runner.measure("load binary", issue_count, [&]() {
+        return loaded_binary = engine.load_results(binary_file)[0].issues.size();
+    });
+
+    const size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    runner.measure("load ndjson, 1 thread", issue_count, [&]() {
+        return NdjsonResultFile(ndjson_file).read_issues(1).size();
+    });
+    if (threads > 1) {
+        runner.measure("load ndjson, " + std::to_string(threads) + " threads", issue_count, [&]() {
+            return NdjsonResultFile(ndjson_file).read_issues(threads).size();
+        });
+    }
+
+    runner.measure("scan mapped binary", issue_count, [&]() {
+        BinaryResultFile file(binary_file);
+        size_t errors = 0;
+        for (size_t i = 0; i < file.get_issue_count(); ++i) {
+            if (file.get_issue(i).severity() >= IssueSeverity::Error) {
+                ++errors;
+            }
+        }
+        return errors;
+    });
+
+    if (loaded_json != issue_count || loaded_binary != issue_count) {
+        runner.out() << "Warning: loaded issue counts differ (" << loaded_json << ", " << loaded_binary << ")" << std::endl;
+    }
+
+    std::filesystem::remove(json_file);
+    std::filesystem::remove(binary_file);
+    std::filesystem::remove(ndjson_file);
+    return runner.finish();
+}
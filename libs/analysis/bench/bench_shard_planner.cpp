@@ -0,0 +1,86 @@
+// Benchmark for cost-based shard planning.
+//
+// Generates unit costs shaped like a C++ code base, where a few
+// template-heavy translation units take a hundred times longer than the
+// rest, and simulates workers running the shards: each worker takes the next
+// shard as soon as it is free. Compares shards of equal unit count, started in
+// file order, with ShardPlanner's longest-first shards, started most expensive
+// first. Reports the simulated run time as a multiple of the ideal (total
+// cost over workers) and the planning time per unit. Usage:
+//
+//   bench_wip_analysis_shard_planner [unit-count] [workers]
+
+#include "benchmark.h"
+#include "shard_planner.h"
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace wip::analysis;
+
+namespace {
+
+constexpr size_t SHARDS_PER_WORKER = 4;    // As AnalysisEngine::JOBS_PER_WORKER
+
+// Time until the last worker finishes when shards start in the given order
+double simulate(const std::vector<double>& shard_costs, size_t workers) {
+    std::priority_queue<double, std::vector<double>, std::greater<double>> free_at;
+    for (size_t i = 0; i < workers; ++i) {
+        free_at.push(0.0);
+    }
+    double end = 0.0;
+    for (double cost : shard_costs) {
+        double start = free_at.top();
+        free_at.pop();
+        free_at.push(start + cost);
+        end = std::max(end, start + cost);
+    }
+    return end;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    wip::benchmark::Runner runner("bench_wip_analysis_shard_planner", argc, argv, "[unit-count] [workers]");
+    size_t unit_count = runner.argument(0, 20000);
+    size_t workers = runner.argument(1, 32);
+
+    // Mostly log-normal costs, with one unit in fifty a hundred times heavier
+    std::mt19937 random(42);
+    std::lognormal_distribution<double> typical(std::log(2e6), 0.6);
+    std::bernoulli_distribution heavy(0.02);
+    std::vector<std::string> units(unit_count);
+    std::vector<double> costs(unit_count);
+    for (size_t i = 0; i < unit_count; ++i) {
+        units[i] = "src/module" + std::to_string(i / 100) + "/unit" + std::to_string(i) + ".cpp";
+        costs[i] = typical(random) * (heavy(random) ? 100.0 : 1.0);
+    }
+    double ideal = std::accumulate(costs.begin(), costs.end(), 0.0) / static_cast<double>(workers);
+    size_t shard_count = workers * SHARDS_PER_WORKER;
+    runner.out() << unit_count << " units, " << workers << " workers, " << shard_count << " shards" << std::endl;
+
+    // Equal unit counts, in file order
+    std::vector<double> chunk_costs;
+    size_t chunk_size = (unit_count + shard_count - 1) / shard_count;
+    for (size_t begin = 0; begin < unit_count; begin += chunk_size) {
+        size_t end = std::min(unit_count, begin + chunk_size);
+        chunk_costs.push_back(std::accumulate(costs.begin() + begin, costs.begin() + end, 0.0));
+    }
+    runner.report("count chunks, run time / ideal", simulate(chunk_costs, workers) / ideal, "x");
+
+    std::vector<double> planned_costs;
+    for (const auto& shard : ShardPlanner::plan(units, costs, shard_count)) {
+        planned_costs.push_back(shard.cost);
+    }
+    runner.report("longest first, run time / ideal", simulate(planned_costs, workers) / ideal, "x");
+
+    runner.measure("plan", unit_count, [&]() {
+        return ShardPlanner::plan(units, costs, shard_count).size();
+    });
+
+    return runner.finish();
+}
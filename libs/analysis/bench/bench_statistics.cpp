@@ -0,0 +1,66 @@
+// Benchmark for result statistics.
+//
+// Builds a result with add_issue, which keeps the severity and category
+// counts current, and then measures AnalysisEngine::get_statistics, which
+// reads those counts and ranks the files with the most issues. A full
+// recount with compute_statistics is measured for reference. Usage:
+//
+//   bench_wip_analysis_statistics [issue-count]
+//
+// The default is half a million issues spread over 2000 files.
+
+#include "analysis_engine.h"
+#include "benchmark.h"
+#include <string>
+#include <vector>
+
+using namespace wip::analysis;
+
+namespace {
+
+constexpr size_t DEFAULT_ISSUE_COUNT = 500000;
+
+std::vector<AnalysisIssue> generate_issues(size_t issue_count) {
+    std::vector<AnalysisIssue> issues(issue_count);
+    for (size_t i = 0; i < issue_count; ++i) {
+        AnalysisIssue& issue = issues[i];
+        issue.file_path = "/home/user/project/src/module_" + std::to_string(i % 97) + "/file_" + std::to_string(i % 2000) + ".cpp";
+        issue.line_number = static_cast<int>(i % 5000 + 1);
+        issue.rule_id = "rule" + std::to_string(i % 150);
+        issue.severity = static_cast<IssueSeverity>(i % 4);
+        issue.category = static_cast<IssueCategory>(i % 7);
+        issue.tool_name = "cppcheck";
+    }
+    return issues;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    wip::benchmark::Runner runner("bench_wip_analysis_statistics", argc, argv, "[issue-count]");
+    size_t issue_count = runner.argument(0, DEFAULT_ISSUE_COUNT);
+    const auto issues = generate_issues(issue_count);
+    runner.out() << "Counting " << issue_count << " issues" << std::endl;
+
+    std::vector<AnalysisResult> results(1);
+    runner.measure("add_issue", issue_count, [&]() {
+        results[0] = AnalysisResult();
+        for (const auto& issue : issues) {
+            results[0].add_issue(issue);
+        }
+        return results[0].get_issue_count(IssueSeverity::Error);
+    });
+
+    runner.measure("compute_statistics", issue_count, [&]() {
+        results[0].compute_statistics();
+        return results[0].get_issue_count(IssueSeverity::Error);
+    });
+
+    AnalysisEngine engine;
+    runner.measure("get_statistics", issue_count, [&]() {
+        auto stats = engine.get_statistics(results);
+        return stats.issues_by_severity[0] + stats.most_problematic_files.size();
+    });
+
+    return runner.finish();
+}
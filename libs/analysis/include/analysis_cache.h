@@ -0,0 +1,179 @@
+#pragma once
+
+#include "analysis_types.h"
+#include "tool_config.h"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace wip {
+namespace analysis {
+
+class IncludeGraph;
+
+/**
+ * @brief Persistent per-project cache of analysis issues for incremental runs
+ *
+ * Issues are stored per tool and per translation unit. An entry is reused when
+ * the tool version, the configuration hash, the content hash of the unit and
+ * the hash of its include closure (every project header it reaches through
+ * #include directives) all match. Changing any of them sends the unit back to
+ * the tool.
+ *
+ * Includes are resolved with an IncludeGraph. Without one set through
+ * set_include_graph(), every plan() scans the project again.
+ *
+ * Usage:
+ * ```cpp
+ * AnalysisCache cache("project/.analysis_cache.json");
+ * cache.load();
+ * auto plan = cache.plan(tool_name, tool_version, config_hash, units, request);
+ * // ... run the tool on plan.changed_units ...
+ * cache.update(tool_name, tool_version, config_hash, plan, new_issues);
+ * cache.save();
+ * ```
+ */
+class AnalysisCache {
+public:
+    /**
+     * @brief Content and include closure hashes of a translation unit
+     */
+    struct UnitState {
+        std::string content_hash;                   ///< Hash of the unit's own contents
+        std::string closure_hash;                   ///< Hash of every header reached from the unit
+        std::vector<std::string> closure;           ///< Headers reached from the unit
+    };
+
+    /**
+     * @brief Outcome of checking a set of translation units against the cache
+     */
+    struct Plan {
+        std::vector<std::string> units;             ///< All units of the run (absolute paths)
+        std::vector<std::string> changed_units;     ///< Units that must be analyzed again
+        std::vector<AnalysisIssue> cached_issues;   ///< Stored issues of the unchanged units
+        size_t cached_unit_count = 0;               ///< Number of units served from the cache
+        std::map<std::string, UnitState> states;    ///< Current state of every unit
+        std::string base_directory;                 ///< Directory relative issue paths are resolved against
+        std::map<std::string, double> unit_costs;   ///< Analysis cost per unit (tool CPU microseconds): the
+                                                    ///< previous run's from plan(), measured ones for update()
+        std::map<std::string, IssueSeverity> unit_severities;  ///< Highest severity each unit reported last
+                                                    ///< time, even under another tool version; units without issues are absent
+    };
+
+    /**
+     * @brief Create a cache
+     * @param cache_file File the cache is loaded from and saved to (empty = in memory only)
+     */
+    explicit AnalysisCache(std::string cache_file = "");
+
+    /**
+     * @brief Load the cache file, replacing the current contents
+     * @return True if the file was read; a missing or unreadable file leaves the cache empty
+     */
+    bool load();
+
+    /**
+     * @brief Write the cache file
+     * @return True if the file was written (always false for an in-memory cache)
+     */
+    bool save() const;
+
+    /**
+     * @brief Check translation units against the cache
+     * @param tool_name Name of the tool
+     * @param tool_version Version reported by the tool
+     * @param config_hash Hash of the tool configuration (see compute_config_hash())
+     * @param units Translation units of the run
+     * @param request Request the units belong to, used to resolve includes
+     * @return Units to analyze again and the issues of the others
+     */
+    Plan plan(const std::string& tool_name, const std::string& tool_version, const std::string& config_hash,
+              const std::vector<std::string>& units, const AnalysisRequest& request) const;
+
+    /**
+     * @brief Store the issues found for the changed units of a plan
+     *
+     * Issues are assigned to the unit they were reported in, or to every
+     * changed unit including the reported header. Units of a previous run that
+     * are no longer part of the plan are dropped. The costs in plan.unit_costs
+     * are stored with the changed units, to balance the shards of the next run.
+     * @param tool_name Name of the tool
+     * @param tool_version Version reported by the tool
+     * @param config_hash Hash of the tool configuration
+     * @param plan Plan returned by plan() for this run
+     * @param issues Issues found when analyzing plan.changed_units
+     */
+    void update(const std::string& tool_name, const std::string& tool_version, const std::string& config_hash,
+                const Plan& plan, const std::vector<AnalysisIssue>& issues);
+
+    /**
+     * @brief Use a long-lived include graph for plan(), so unchanged files are not read again
+     *
+     * The graph is only used for requests it matches() and gets the planned
+     * units added. Report created and removed files to it with update(), or
+     * an include shadowed by a new file keeps resolving to the old one.
+     * Pass nullptr to scan the project on every plan().
+     * @param graph Include graph shared with the code watching the project
+     */
+    void set_include_graph(std::shared_ptr<IncludeGraph> graph);
+
+    /**
+     * @brief Get the include graph set with set_include_graph(), if any
+     */
+    std::shared_ptr<IncludeGraph> get_include_graph() const;
+
+    /**
+     * @brief Remove all entries
+     */
+    void clear();
+
+    /**
+     * @brief Get number of cached translation units across all tools
+     */
+    size_t get_entry_count() const;
+
+    /**
+     * @brief Get the file the cache is persisted to
+     */
+    const std::string& get_cache_file() const { return cache_file_; }
+
+    /**
+     * @brief Hash a block of data (128-bit wip::utils::hash::hash128, hex encoded)
+     * @param data Data to hash
+     * @return 32 character hex string
+     */
+    static std::string hash_content(std::string_view data);
+
+    /**
+     * @brief Hash everything in a tool configuration and request that affects results
+     * @param config Tool configuration (may be null)
+     * @param request Analysis request (the source and output paths are not included)
+     * @return Configuration hash
+     */
+    static std::string compute_config_hash(const ToolConfig* config, const AnalysisRequest& request);
+
+private:
+    struct UnitEntry {
+        std::string content_hash;
+        std::string closure_hash;
+        std::vector<AnalysisIssue> issues;
+        double cost = 0.0;                      // Cost of the last analysis (0 = unknown)
+    };
+
+    struct ToolEntry {
+        std::string tool_version;
+        std::string config_hash;
+        std::map<std::string, UnitEntry> units;
+    };
+
+    std::string cache_file_;
+    mutable std::mutex mutex_;
+    std::map<std::string, ToolEntry> tools_;
+    std::shared_ptr<IncludeGraph> include_graph_;
+};
+
+} // namespace analysis
+} // namespace wip
@@ -2,6 +2,12 @@
 
 #include "analysis_tool.h"
 #include "analysis_types.h"
+#include "analysis_cache.h"
+#include "concurrency_governor.h"
+#include "job_scheduler.h"
+#include "shard_executor.h"
+#include "result_file.h"
+#include <async_file_writer.h>
 #include <memory>
 #include <vector>
 #include <map>
@@ -42,6 +48,13 @@ public:
      */
     using CompletionCallback = std::function<void(const std::vector<AnalysisResult>& results)>;
     
+    /**
+     * @brief Callback for issues delivered while analysis is still running
+     * @param tool_name Name of the tool that found the issues
+     * @param issues Batch of issues not yet delivered for this tool
+     */
+    using IssueCallback = std::function<void(const std::string& tool_name, const std::vector<AnalysisIssue>& issues)>;
+    
     AnalysisEngine();
     ~AnalysisEngine();
     
@@ -109,6 +122,41 @@ public:
      */
     std::map<std::string, ValidationResult> validate_configurations(const std::vector<std::string>& tool_names) const;
     
+    // ==================== Incremental Analysis ====================
+    
+    /**
+     * @brief Enable incremental analysis with a persistent issue cache
+     * 
+     * With a cache set, every tool run only analyzes the translation units
+     * whose contents, include closure, tool version or configuration changed
+     * since the cached run; issues of the other units come from the cache.
+     * @param cache Cache to use, or nullptr to always run full analyses
+     */
+    void set_cache(std::shared_ptr<AnalysisCache> cache);
+    
+    /**
+     * @brief Get the cache used for incremental analysis
+     * @return Current cache, or nullptr if incremental analysis is disabled
+     */
+    std::shared_ptr<AnalysisCache> get_cache() const;
+    
+    /**
+     * @brief Run the shards of external tools elsewhere, e.g. on remote workers
+     * 
+     * analyze_async() then sizes its concurrency budget and shards by the
+     * executor's slots and hands it every shard of a tool that does not run
+     * in process. Caching, shard balancing and merging stay here, so the
+     * results are the same as those of a local run. Raw output lines of
+     * those shards are not passed to the output callback.
+     * @param executor Executor to use, or nullptr to run every shard locally
+     */
+    void set_shard_executor(std::shared_ptr<ShardExecutor> executor);
+    
+    /**
+     * @brief Get the executor set with set_shard_executor(), if any
+     */
+    std::shared_ptr<ShardExecutor> get_shard_executor() const;
+    
     // ==================== Analysis Execution ====================
     
     /**
@@ -121,6 +169,9 @@ public:
     
     /**
      * @brief Execute analysis with multiple tools synchronously
+     * 
+     * With AnalysisRequest::stop_on_severity, the tools after the first one
+     * reporting an issue that severe are not run.
      * @param tool_names Names of tools to run
      * @param request Analysis request parameters
      * @return Vector of analysis results (one per tool)
@@ -128,23 +179,65 @@ public:
     std::vector<AnalysisResult> analyze_multiple(const std::vector<std::string>& tool_names, 
                                                  const AnalysisRequest& request);
     
+    /**
+     * @brief Set the number of jobs run at the same time by analyze_async
+     * @param job_count Concurrency budget shared by all tools (0 = computed by the governor)
+     */
+    void set_concurrency(size_t job_count);
+    
+    /**
+     * @brief Get the effective concurrency budget of analyze_async
+     * @return Number of jobs run at the same time; without an explicit budget this
+     *         follows the free CPUs and memory of the machine
+     */
+    size_t get_concurrency() const;
+    
+    /**
+     * @brief Get the governor that sizes the concurrency budget and hands out job slots
+     */
+    ConcurrencyGovernor& get_governor() { return governor_; }
+    
     /**
      * @brief Execute analysis with multiple tools asynchronously
+     * 
+     * The translation units of every tool are split into (tool, file shard)
+     * jobs that share one work-stealing scheduler, so all tools fill the cores
+     * together. Progress updates report completed jobs out of the total.
+     * In-process tools (see InProcessTool) run directly on the workers.
+     * 
+     * Issues are streamed to issue_callback in batches as soon as each shard
+     * finishes (cached issues right at the start), so callers can show results
+     * long before the completion callback fires. Every issue is delivered at
+     * most once per tool; the final results contain the same issues.
+     * 
+     * With AnalysisRequest::stop_on_severity the analysis fails fast: the
+     * first shard reporting an issue that severe cancels the request's token,
+     * which stops every running tool process, and the jobs not yet started are
+     * skipped. Units that reached that severity in the cached run start before
+     * all others. The results are then marked stopped_early, and the cache is
+     * not updated.
      * @param tool_names Names of tools to run
      * @param request Analysis request parameters
      * @param progress_callback Called for progress updates
+     * @param output_callback Called with raw tool output lines
      * @param completion_callback Called when analysis completes
-     * @return Future that will contain the analysis results
+     * @param issue_callback Called with new issues while the analysis runs
+     * @return Task that will contain the analysis results
      */
-    std::future<std::vector<AnalysisResult>> analyze_async(
+    wip::utils::concurrency::Task<std::vector<AnalysisResult>> analyze_async(
         const std::vector<std::string>& tool_names,
         const AnalysisRequest& request,
         ProgressCallback progress_callback = nullptr,
         OutputCallback output_callback = nullptr,
-        CompletionCallback completion_callback = nullptr);
+        CompletionCallback completion_callback = nullptr,
+        IssueCallback issue_callback = nullptr);
     
     /**
      * @brief Cancel any running analysis
+     * 
+     * Tool processes are started in their own process group and receive
+     * SIGTERM (then SIGKILL after a short grace period) immediately; jobs that
+     * have not started yet are skipped.
      * @return True if cancellation was successful
      */
     bool cancel_analysis();
@@ -166,10 +259,34 @@ public:
     
     /**
      * @brief Save analysis results to file
+     * 
+     * JSON is meant for interchange; the binary format (see BinaryResultFile)
+     * is much smaller and loads orders of magnitude faster, which matters for
+     * large baselines. NDJSON (see NdjsonResultFile) holds one issue per line
+     * for line-by-line ingestion, but drops tools without issues and tool
+     * failures; to write it while the analysis runs, pass an
+     * NdjsonIssueWriter's callback() as the issue callback.
      * @param results Results to save
      * @param file_path Output file path
+     * @param format File format to write
+     */
+    void save_results(const std::vector<AnalysisResult>& results, const std::string& file_path,
+                      ResultFormat format = ResultFormat::Json) const;
+    
+    /**
+     * @brief Save analysis results to file without blocking the caller
+     * 
+     * Serialization and writing both happen on the writer's I/O thread, and
+     * the file is replaced atomically, so a failed save keeps the old file.
+     * @param results Results to save, moved to the I/O thread
+     * @param file_path Output file path
+     * @param writer Writer that performs the save
+     * @param format File format to write
+     * @return Becomes true once the file is written
      */
-    void save_results(const std::vector<AnalysisResult>& results, const std::string& file_path) const;
+    std::future<bool> save_results_async(std::vector<AnalysisResult> results, const std::string& file_path,
+                                         wip::utils::file::AsyncFileWriter& writer,
+                                         ResultFormat format = ResultFormat::Json) const;
     
     /**
      * @brief Save aggregated results to file
@@ -180,6 +297,8 @@ public:
     
     /**
      * @brief Load analysis results from file
+     * 
+     * The format (JSON, binary or NDJSON) is detected from the file contents.
      * @param file_path Input file path
      * @return Loaded analysis results
      */
@@ -204,38 +323,85 @@ public:
         size_t total_files_analyzed = 0;
         std::chrono::milliseconds total_execution_time{0};
         std::map<std::string, size_t> issues_per_tool;
-        std::map<IssueSeverity, size_t> issues_by_severity;
-        std::map<IssueCategory, size_t> issues_by_category;
-        std::vector<std::string> most_problematic_files;  // Files with most issues
+        ExecutionProfile total_profile;                       // Phase timings and resource usage over all results
+        std::map<std::string, ExecutionProfile> profile_per_tool;
+        std::array<size_t, ISSUE_SEVERITY_COUNT> issues_by_severity{};    // Indexed by IssueSeverity
+        std::array<size_t, ISSUE_CATEGORY_COUNT> issues_by_category{};    // Indexed by IssueCategory
+        std::vector<std::string> most_problematic_files;  // Files with most issues, ties by path
+        std::vector<std::pair<std::string, size_t>> largest_units;    // Units by peak RSS in KiB, largest first, ties by path
     };
     
     AnalysisStatistics get_statistics(const std::vector<AnalysisResult>& results) const;
     
-    /**
-     * @brief Generate comparison report between different analysis runs
-     * @param baseline_results Previous analysis results
-     * @param current_results Current analysis results
-     * @return Comparison summary
-     */
     struct ComparisonReport {
         int issue_count_delta = 0;  // Positive = more issues, negative = fewer issues
         std::vector<AnalysisIssue> new_issues;
         std::vector<AnalysisIssue> resolved_issues;
-        std::vector<AnalysisIssue> persistent_issues;
+        std::vector<AnalysisIssue> persistent_issues;   // Includes moved issues
+        size_t moved_issue_count = 0;                   // Persistent issues matched despite a changed line
         std::map<IssueSeverity, int> severity_deltas;
     };
     
+    /**
+     * @brief Options for comparing analysis runs
+     */
+    struct ComparisonOptions {
+        bool match_line_drift = true;   // Match issues whose line moved (same file, rule and message)
+        int max_line_drift = -1;        // Largest line distance matched as a move (-1 = any)
+    };
+    
+    /**
+     * @brief Generate comparison report between different analysis runs
+     * 
+     * Both sides are deduplicated and sorted in parallel by a compact interned
+     * key, then classified in a single merge pass. Issues that only moved to a
+     * different line (for example because code was inserted above them) are
+     * reported as persistent, not as a resolved plus a new issue.
+     * @param baseline_results Previous analysis results
+     * @param current_results Current analysis results
+     * @param options How to match issues between the runs
+     * @return Comparison summary; new and persistent issues in current run
+     *         order, resolved issues in baseline run order
+     */
+    ComparisonReport compare_results(const std::vector<AnalysisResult>& baseline_results,
+                                    const std::vector<AnalysisResult>& current_results,
+                                    const ComparisonOptions& options) const;
+    
     ComparisonReport compare_results(const std::vector<AnalysisResult>& baseline_results,
-                                    const std::vector<AnalysisResult>& current_results) const;
+                                    const std::vector<AnalysisResult>& current_results) const {
+        return compare_results(baseline_results, current_results, ComparisonOptions{});
+    }
     
 private:
+    static constexpr size_t JOBS_PER_WORKER = 4;    // Target shards per worker and tool
+    
     mutable std::mutex tools_mutex_;
     std::map<std::string, std::unique_ptr<AnalysisTool>> tools_;
     
+    std::shared_ptr<AnalysisCache> cache_;
+    std::shared_ptr<ShardExecutor> shard_executor_;
+    std::atomic<size_t> concurrency_{0};
+    ConcurrencyGovernor governor_;
+    
     std::atomic<bool> analysis_running_{false};
     std::atomic<bool> cancel_requested_{false};
+    wip::utils::process::CancellationToken cancellation_;     // Token of the latest analysis, guarded by tools_mutex_
     
     // Helper methods
+    AnalysisRequest make_cancellable_request(const AnalysisRequest& request);
+    AnalysisResult execute_tool(AnalysisTool& tool, const AnalysisRequest& request,
+                                std::function<void(const AnalysisProgress&)> progress_callback = nullptr,
+                                std::function<void(const std::string&)> output_callback = nullptr);
+    std::vector<AnalysisResult> run_scheduled(const std::vector<std::string>& tool_names,
+                                              const AnalysisRequest& request,
+                                              ProgressCallback progress_callback,
+                                              OutputCallback output_callback,
+                                              IssueCallback issue_callback);
+    std::vector<std::string> get_changed_units(const std::vector<std::string>& units, const AnalysisRequest& request) const;
+    void apply_cache(AnalysisCache& cache, const std::string& tool_version, const std::string& config_hash,
+                     AnalysisCache::Plan& plan, AnalysisResult& result) const;
+    AnalysisRequest make_tool_request(const AnalysisRequest& request, const std::string& tool_name) const;
+    AnalysisResult make_error_result(const std::string& tool_name, const std::string& error_message) const;
     void validate_tool_names(const std::vector<std::string>& tool_names) const;
     std::string generate_analysis_id() const;
     
@@ -260,6 +426,9 @@ public:
     
     /**
      * @brief Create engine with specified tools
+     * 
+     * Names other than the built-in tools are created through the
+     * AnalysisToolRegistry; unknown names are skipped.
      * @param tool_names Names of tools to register
      * @return Configured AnalysisEngine
      */
@@ -267,6 +436,9 @@ public:
     
     /**
      * @brief Create engine and auto-register all available tools
+     * 
+     * Registers the default tools, the built-in in-process analyzers and
+     * every tool of the AnalysisToolRegistry.
      * @return Configured AnalysisEngine with all available tools
      */
     static std::unique_ptr<AnalysisEngine> create_full_engine();
@@ -6,7 +6,8 @@
 #include <vector>
 #include <memory>
 #include <functional>
-#include <future>
+#include <mutex>
+#include <task.h>
 
 namespace wip {
 namespace analysis {
@@ -94,6 +95,15 @@ public:
      */
     virtual std::string get_system_requirements() const = 0;
     
+    /**
+     * @brief Check whether this tool analyzes files inside the calling process
+     * 
+     * In-process tools (see InProcessTool) start no processes, so the engine
+     * runs them directly on its worker threads.
+     * @return True if execute() does its work on the calling thread
+     */
+    virtual bool runs_in_process() const { return false; }
+    
     // ==================== Analysis Execution ====================
     
     /**
@@ -109,9 +119,9 @@ public:
      * @param request Analysis parameters and configuration
      * @param progress_callback Called periodically with progress updates
      * @param output_callback Called with raw output lines from the tool
-     * @return Future that will contain the analysis result
+     * @return Task that will contain the analysis result
      */
-    virtual std::future<AnalysisResult> execute_async(
+    virtual wip::utils::concurrency::Task<AnalysisResult> execute_async(
         const AnalysisRequest& request,
         std::function<void(const AnalysisProgress&)> progress_callback = nullptr,
         std::function<void(const std::string&)> output_callback = nullptr) = 0;
@@ -153,11 +163,100 @@ public:
      */
     virtual std::vector<std::string> build_command_line(const AnalysisRequest& request) const = 0;
     
+    /**
+     * @brief List the translation units analyzed for a request
+     * 
+     * Returns request.source_files when set, the file itself when source_path
+     * is a file, and otherwise the source files found under source_path
+     * (hidden and build directories are skipped). Headers are not listed since
+     * they are analyzed through the translation units that include them.
+     * Units matching request.exclude_patterns are left out.
+     * @param request Analysis request
+     * @return Sorted, de-duplicated list of source file paths
+     */
+    virtual std::vector<std::string> get_translation_units(const AnalysisRequest& request) const;
+    
     /**
      * @brief Get tool-specific help text
      * @return Help text explaining tool options and usage
      */
     virtual std::string get_help_text() const = 0;
+    
+protected:
+    /**
+     * @brief Registers one run's cancellation token for cancel_active_runs()
+     * 
+     * The run uses the request's token when it has one, so cancelling either
+     * the request or the tool stops the run's processes.
+     */
+    class ActiveRun {
+    public:
+        ActiveRun(const AnalysisTool& tool, const AnalysisRequest& request);
+        ~ActiveRun();
+        
+        ActiveRun(const ActiveRun&) = delete;
+        ActiveRun& operator=(const ActiveRun&) = delete;
+        
+        /**
+         * @brief Get the token to pass to the run's processes
+         */
+        const wip::utils::process::CancellationToken& get_token() const { return token_; }
+        
+    private:
+        const AnalysisTool& tool_;
+        wip::utils::process::CancellationToken token_;
+    };
+    
+    /**
+     * @brief Cancel every run registered through ActiveRun
+     * @return True if at least one run was cancelled
+     */
+    bool cancel_active_runs();
+    
+    /**
+     * @brief List the files of a request with the given extensions
+     * 
+     * Works like get_translation_units() with a different set of extensions,
+     * for tools that also look at headers.
+     * @param request Analysis request
+     * @param extensions Extensions of the files found under a source directory, with the dot
+     * @return Sorted, de-duplicated list of file paths
+     */
+    static std::vector<std::string> list_source_files(const AnalysisRequest& request,
+                                                      const std::vector<std::string>& extensions);
+    
+    /**
+     * @brief Find the build directory holding compile_commands.json for a source path
+     * 
+     * Looks for build, _build, Debug and Release directories in the source
+     * directory and each of its parents.
+     * @param source_path Source file or directory
+     * @return Build directory, or empty if none was found
+     */
+    static std::string find_compilation_database_directory(const std::string& source_path);
+    
+    /**
+     * @brief Read the translation units of a compilation database
+     * @param build_dir Directory holding compile_commands.json
+     * @param source_path Only units below this directory are returned
+     * @return Absolute unit paths in database order
+     */
+    static std::vector<std::string> read_compilation_database(const std::string& build_dir,
+                                                              const std::string& source_path);
+    
+    /**
+     * @brief List the units of the compilation database found for a request
+     * @param request Analysis request
+     * @return Sorted, de-duplicated units without those matching
+     *         request.exclude_patterns; empty if the request lists its files,
+     *         its source path is not a directory or no database was found
+     */
+    static std::vector<std::string> get_compilation_database_units(const AnalysisRequest& request);
+    
+private:
+    // Runs may be started from const members, so the registry is mutable
+    mutable std::mutex active_runs_mutex_;
+    mutable std::vector<wip::utils::process::CancellationToken> active_runs_;
 };
 
 /**
@@ -1,11 +1,14 @@
 #pragma once
 
+#include <array>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <chrono>
 #include <optional>
 #include <map>
 #include <nlohmann/json.hpp>
+#include <process.h>
 
 namespace wip {
 namespace analysis {
@@ -33,6 +36,39 @@ enum class IssueCategory {
     Maintainability
 };
 
+constexpr size_t ISSUE_SEVERITY_COUNT = static_cast<size_t>(IssueSeverity::Critical) + 1;
+constexpr size_t ISSUE_CATEGORY_COUNT = static_cast<size_t>(IssueCategory::Maintainability) + 1;
+
+/**
+ * @brief Identity of an issue used for de-duplication and run comparison
+ * 
+ * Two issues with the same file, line and rule are considered the same issue,
+ * even when reported by different tools. The key views the strings of the issue
+ * it was built from, so it must not outlive that issue.
+ */
+struct IssueKey {
+    std::string_view file_path;                        ///< File containing the issue
+    int line_number = 0;                               ///< Line number of the issue
+    std::string_view rule_id;                          ///< Tool-specific rule identifier
+    
+    bool operator==(const IssueKey& other) const {
+        return line_number == other.line_number &&
+               file_path == other.file_path &&
+               rule_id == other.rule_id;
+    }
+    
+    bool operator!=(const IssueKey& other) const {
+        return !(*this == other);
+    }
+};
+
+/**
+ * @brief Hash functor for IssueKey, for use with unordered containers
+ */
+struct IssueKeyHash {
+    size_t operator()(const IssueKey& key) const;
+};
+
 /**
  * @brief Represents a single issue found during analysis
  */
@@ -61,6 +97,14 @@ struct AnalysisIssue {
      */
     static AnalysisIssue from_json(const nlohmann::json& j);
     
+    /**
+     * @brief Get the identity key of this issue (file, line, rule)
+     * @return Key viewing this issue's strings
+     */
+    IssueKey key() const {
+        return IssueKey{file_path, line_number, rule_id};
+    }
+    
     /**
      * @brief Equality comparison for testing
      */
@@ -75,6 +119,8 @@ struct AnalysisProgress {
     size_t processed_files = 0;    ///< Number of files processed so far
     std::string current_file;      ///< Currently processing file
     std::string status_message;    ///< Current status description
+    size_t total_jobs = 0;         ///< Total number of scheduled jobs (0 = not scheduled)
+    size_t completed_jobs = 0;     ///< Number of scheduled jobs finished so far
     
     /**
      * @brief Get progress as percentage (0.0 to 1.0)
@@ -86,6 +132,57 @@ struct AnalysisProgress {
     }
 };
 
+/**
+ * @brief Time spent in each phase of an analysis
+ * 
+ * Phases of processes that ran in parallel are summed, so their total can
+ * exceed the wall-clock execution_time of the result. Tools that parse output
+ * while it is read count that parsing in both capture_time and parse_time.
+ */
+struct ExecutionProfile {
+    std::chrono::nanoseconds spawn_time{0};       ///< Creating pipes and starting tool processes
+    std::chrono::nanoseconds process_time{0};     ///< Wall-clock lifetime of tool processes
+    std::chrono::nanoseconds tool_cpu_time{0};    ///< User and system CPU time of tool processes
+    std::chrono::nanoseconds tool_user_cpu_time{0};   ///< User part of tool_cpu_time
+    std::chrono::nanoseconds tool_system_cpu_time{0}; ///< System part of tool_cpu_time
+    std::chrono::nanoseconds capture_time{0};     ///< Reading tool output
+    std::chrono::nanoseconds precompile_time{0};  ///< Building precompiled headers shared by tool processes
+    std::chrono::nanoseconds parse_time{0};       ///< Turning tool output into issues
+    std::chrono::nanoseconds aggregate_time{0};   ///< Merging shards and results
+    size_t process_count = 0;                     ///< Number of tool processes started
+    size_t tool_cache_lookups = 0;                ///< Units looked up in a tool's own result cache
+    size_t tool_cache_hits = 0;                   ///< Lookups the tool answered without analyzing the unit
+    size_t peak_rss_kb = 0;                       ///< Largest peak resident set size of any tool process, in KiB
+    size_t voluntary_context_switches = 0;        ///< Times tool processes blocked, e.g. on I/O
+    size_t involuntary_context_switches = 0;      ///< Times tool processes were preempted
+    
+    /// Tool CPU time by translation unit, for tools running one process per
+    /// unit; the engine takes these out when it records the units' costs
+    std::map<std::string, std::chrono::nanoseconds> unit_cpu_times;
+    
+    /// Peak resident set size in KiB by translation unit, for tools running
+    /// one process per unit; the largest of a unit's processes is kept
+    std::map<std::string, size_t> unit_peak_rss_kb;
+    
+    /**
+     * @brief Add the timings and resource usage of one finished tool process
+     * @param process_result Result reported by the process executor
+     */
+    void add_process(const wip::utils::process::ProcessResult& process_result);
+    
+    ExecutionProfile& operator+=(const ExecutionProfile& other);
+    
+    /**
+     * @brief Convert profile to JSON representation (durations in microseconds)
+     */
+    nlohmann::json to_json() const;
+    
+    /**
+     * @brief Create profile from JSON representation
+     */
+    static ExecutionProfile from_json(const nlohmann::json& j);
+};
+
 /**
  * @brief Complete result of an analysis run
  */
@@ -100,10 +197,12 @@ struct AnalysisResult {
     std::chrono::milliseconds execution_time{0};             ///< Total analysis time
     bool success = false;                                     ///< Whether analysis completed successfully
     std::string error_message;                                ///< Error message if analysis failed
+    bool stopped_early = false;                               ///< Stopped at an issue of AnalysisRequest::stop_on_severity; issues are incomplete
+    ExecutionProfile profile;                                 ///< Time spent per phase (not compared by ==)
     
-    // Issue statistics (computed automatically)
-    std::map<IssueSeverity, size_t> issue_counts_by_severity; ///< Count of issues by severity
-    std::map<IssueCategory, size_t> issue_counts_by_category; ///< Count of issues by category
+    // Issue statistics: kept current by add_issue(), recounted by compute_statistics()
+    std::array<size_t, ISSUE_SEVERITY_COUNT> issue_counts_by_severity{}; ///< Indexed by IssueSeverity
+    std::array<size_t, ISSUE_CATEGORY_COUNT> issue_counts_by_category{}; ///< Indexed by IssueCategory
     
     /**
      * @brief Add an issue to the result and update statistics
@@ -113,9 +212,27 @@ struct AnalysisResult {
     
     /**
      * @brief Compute statistics from current issues
+     * 
+     * Needed only after issues was changed directly rather than through add_issue().
      */
     void compute_statistics();
     
+    /**
+     * @brief Check that the statistics account for every issue
+     * 
+     * A cheap test for issues changed without compute_statistics(); it misses
+     * issues that were replaced one for one.
+     */
+    bool has_current_statistics() const;
+    
+    size_t get_issue_count(IssueSeverity severity) const {
+        return issue_counts_by_severity[static_cast<size_t>(severity)];
+    }
+    
+    size_t get_issue_count(IssueCategory category) const {
+        return issue_counts_by_category[static_cast<size_t>(category)];
+    }
+    
     /**
      * @brief Get total number of issues
      */
@@ -156,15 +273,34 @@ struct AnalysisResult {
     bool operator==(const AnalysisResult& other) const;
 };
 
+/**
+ * @brief Lines of a file that a diff-scoped analysis reports on
+ */
+struct ChangedRange {
+    std::string file;                               ///< Changed file, absolute or relative to source_path
+    int first_line = 0;                             ///< First changed line (1-based)
+    int last_line = 0;                              ///< Last changed line, inclusive
+
+    bool operator==(const ChangedRange& other) const {
+        return file == other.file && first_line == other.first_line && last_line == other.last_line;
+    }
+};
+
 /**
  * @brief Request parameters for analysis execution
  */
 struct AnalysisRequest {
     std::string source_path;                        ///< Path to analyze (file or directory)
     std::string output_file;                        ///< Where to save analysis output
+    std::vector<std::string> source_files;          ///< Translation units to analyze (empty = all under source_path)
+    std::vector<std::string> exclude_patterns;      ///< Glob patterns of units to skip, matched relative to source_path
     std::vector<std::string> include_paths;         ///< Additional include directories
     std::vector<std::string> definitions;           ///< Preprocessor definitions
+    size_t max_parallel_jobs = 0;                   ///< Upper bound on tool-internal parallelism (0 = tool default)
+    std::vector<ChangedRange> changed_ranges;       ///< Only units reaching these files are analyzed and only issues on these lines reported (empty = no scoping)
+    std::optional<IssueSeverity> stop_on_severity;  ///< Cancel the whole analysis at the first issue this severe (nullopt = run to completion)
     nlohmann::json tool_specific_options;           ///< Tool-specific configuration options
+    wip::utils::process::CancellationToken cancellation;  ///< Stops the tool's processes when cancelled (not serialized)
     
     /**
      * @brief Convert request to JSON representation
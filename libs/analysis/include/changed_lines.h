@@ -0,0 +1,74 @@
+#pragma once
+
+#include "analysis_types.h"
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace wip {
+namespace analysis {
+
+/**
+ * @brief Lookup of the changed lines a diff-scoped request reports on
+ *
+ * Built from AnalysisRequest::changed_ranges, with paths made absolute and
+ * normalized and each file's ranges merged and sorted, so tools can decide
+ * per issue, while parsing their output, whether it is kept. Issues without
+ * a line (line 0) are kept if their file changed.
+ *
+ * Usage:
+ * ```cpp
+ * ChangedLines scope(request.changed_ranges);
+ * if (scope.empty() || scope.contains(issue)) {
+ *     result.issues.push_back(std::move(issue));
+ * }
+ * ```
+ */
+class ChangedLines {
+public:
+    ChangedLines() = default;
+
+    /**
+     * @brief Index changed ranges
+     * @param ranges Ranges whose relative paths are resolved against the current directory
+     */
+    explicit ChangedLines(const std::vector<ChangedRange>& ranges);
+
+    /**
+     * @brief Check whether no ranges were given, i.e. nothing is scoped
+     */
+    bool empty() const { return files_.empty(); }
+
+    /**
+     * @brief Get the changed files
+     * @return Absolute, normalized paths, sorted
+     */
+    std::vector<std::string> get_files() const;
+
+    /**
+     * @brief Check whether a file has changed lines
+     */
+    bool contains_file(const std::string& file) const;
+
+    /**
+     * @brief Check whether a line of a file changed
+     * @param file Path, absolute or relative to the current directory
+     * @param line 1-based line; 0 matches any changed file
+     */
+    bool contains(const std::string& file, int line) const;
+
+    bool contains(const AnalysisIssue& issue) const {
+        return contains(issue.file_path, issue.line_number);
+    }
+
+private:
+    using Ranges = std::vector<std::pair<int, int>>;
+
+    const Ranges* find(const std::string& file) const;
+
+    std::unordered_map<std::string, Ranges> files_;     ///< Merged, sorted ranges by normalized path
+};
+
+} // namespace analysis
+} // namespace wip
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace wip {
+namespace analysis {
+
+/**
+ * @brief Index of a compile_commands.json, shared by every tool and shard
+ *
+ * The database is memory-mapped and read with a streaming parser, so no JSON
+ * document of the whole file is built; each entry keeps its directory, its
+ * unit path made absolute and normalized, and its command as written. Command
+ * lines are split into arguments only for the entries a tool asks for.
+ *
+ * open() keeps one index per build directory for the process and reads the
+ * file again only once its size or modification time changed, so tools and
+ * shards started after a build system regenerated the database see the new
+ * one, and all others share a single parse.
+ *
+ * Tools that would otherwise load the whole database in every process are
+ * handed a database of only the units they analyze (write_subset()).
+ *
+ * Usage:
+ * ```cpp
+ * auto database = CompilationDatabase::open(build_dir);
+ * if (database) {
+ *     if (const auto* entry = database->find(unit)) {
+ *         // entry->directory, entry->get_arguments()
+ *     }
+ * }
+ * ```
+ */
+class CompilationDatabase {
+public:
+    /**
+     * @brief One compile command
+     */
+    struct Entry {
+        std::string file;                       ///< Absolute, normalized unit path
+        std::string directory;                  ///< Directory the command runs in
+        std::string command;                    ///< Shell command line, empty if given as arguments
+        std::vector<std::string> arguments;     ///< Arguments, compiler first; empty if given as a command
+        std::string output;                     ///< Output file, empty if not given
+
+        /**
+         * @brief Get the arguments, splitting the command line if the entry has one
+         */
+        std::vector<std::string> get_arguments() const;
+    };
+
+    /**
+     * @brief Get the index of a build directory's compile_commands.json
+     * @param build_dir Directory holding compile_commands.json
+     * @return Shared index, current as of this call; nullptr if the file is missing or not a JSON array
+     */
+    static std::shared_ptr<const CompilationDatabase> open(const std::string& build_dir);
+
+    /**
+     * @brief Index a database from memory, bypassing the shared indexes
+     * @param json Contents of a compile_commands.json
+     * @param build_dir Directory the database belongs to
+     * @return Index, or nullptr if the contents are not a JSON array
+     */
+    static std::shared_ptr<const CompilationDatabase> parse(std::string_view json, const std::string& build_dir);
+
+    /**
+     * @brief Split a shell command line as compile_commands.json "command" entries are written
+     */
+    static std::vector<std::string> split_command(std::string_view command);
+
+    const std::string& get_build_dir() const { return build_dir_; }
+
+    /**
+     * @brief Get all entries in database order
+     */
+    const std::vector<Entry>& get_entries() const { return entries_; }
+
+    /**
+     * @brief Find the command of a unit
+     * @param file Unit path, absolute or relative to the current directory
+     * @return First entry for the unit, or nullptr if the database has none
+     */
+    const Entry* find(const std::string& file) const;
+
+    /**
+     * @brief List the units below a source path
+     * @param source_path Only units below this directory are returned
+     * @return Absolute unit paths in database order
+     */
+    std::vector<std::string> get_units(const std::string& source_path) const;
+
+    /**
+     * @brief Write a compile_commands.json holding only some units
+     * @param units Units to keep; those without an entry are left out
+     * @param directory Directory the database is written to
+     * @return Number of entries written, or 0 if the file cannot be written
+     */
+    size_t write_subset(const std::vector<std::string>& units, const std::filesystem::path& directory) const;
+
+private:
+    std::string build_dir_;
+    std::vector<Entry> entries_;
+    std::unordered_map<std::string, size_t> index_;     ///< First entry by unit path
+};
+
+} // namespace analysis
+} // namespace wip
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+
+namespace wip {
+namespace analysis {
+
+/**
+ * @brief Snapshot of the machine resources that bound analysis parallelism
+ */
+struct SystemResources {
+    size_t cpu_count = 1;                   ///< CPUs this process may run on
+    size_t available_memory_mb = 0;         ///< Memory available without swapping (0 = unknown)
+    double load_average = -1.0;             ///< One-minute load average (negative = unknown)
+
+    /**
+     * @brief Read the current resources of this machine
+     *
+     * Uses the CPU affinity mask, MemAvailable from /proc/meminfo and
+     * getloadavg(), falling back to the hardware concurrency and unknown
+     * values where those are not available.
+     */
+    static SystemResources probe();
+};
+
+/**
+ * @brief Shares one worker budget between the analysis jobs of a run
+ *
+ * The budget is the number of processes the machine can run at once: the CPUs
+ * not already busy with other work (as reported by the load average), further
+ * limited by how many jobs fit into the available memory. Several projects
+ * analysed on one machine therefore shrink each other's budgets instead of
+ * over-subscribing it.
+ *
+ * Jobs take a lease of one or more slots when they start. A job gets an even
+ * share of the free slots, leaving one for every other job that is about to
+ * start, so a run with fewer jobs than slots hands the surplus out as tool
+ * parallelism and slots returned by a tool that finished early go to the jobs
+ * started after it.
+ *
+ * Usage:
+ * ```cpp
+ * ConcurrencyGovernor governor;
+ * governor.begin_run(governor.compute_budget());
+ * auto lease = governor.acquire(pending_jobs, idle_workers);
+ * request.max_parallel_jobs = lease.get_slots();
+ * ```
+ */
+class ConcurrencyGovernor {
+public:
+    /**
+     * @brief Limits applied when computing the budget
+     */
+    struct Options {
+        size_t max_workers = 0;             ///< Upper bound on the budget (0 = no bound)
+        size_t memory_per_job_mb = 512;     ///< Memory one tool process is expected to need (0 = ignore memory)
+        bool use_load_average = true;       ///< Subtract CPUs kept busy by other processes
+    };
+
+    /**
+     * @brief Slots held by one job, returned to the governor on destruction
+     */
+    class Lease {
+    public:
+        Lease() = default;
+        ~Lease() { release(); }
+
+        Lease(Lease&& other) noexcept : governor_(other.governor_), slots_(other.slots_) {
+            other.governor_ = nullptr;
+            other.slots_ = 0;
+        }
+        Lease& operator=(Lease&& other) noexcept;
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        /**
+         * @brief Get number of slots held (at least 1 for an acquired lease)
+         */
+        size_t get_slots() const { return slots_; }
+
+        /**
+         * @brief Return the slots early
+         */
+        void release();
+
+    private:
+        friend class ConcurrencyGovernor;
+        Lease(ConcurrencyGovernor* governor, size_t slots) : governor_(governor), slots_(slots) {}
+
+        ConcurrencyGovernor* governor_ = nullptr;
+        size_t slots_ = 0;
+    };
+
+    ConcurrencyGovernor();
+    explicit ConcurrencyGovernor(Options options);
+
+    ConcurrencyGovernor(const ConcurrencyGovernor&) = delete;
+    ConcurrencyGovernor& operator=(const ConcurrencyGovernor&) = delete;
+
+    /**
+     * @brief Compute the worker budget for given resources
+     * @param resources Machine resources
+     * @param options Limits to apply
+     * @return Number of jobs to run at the same time, at least 1
+     */
+    static size_t compute_budget(const SystemResources& resources, const Options& options);
+
+    /**
+     * @brief Compute the worker budget from the current machine resources
+     *
+     * Load caused by jobs holding leases of this governor is not counted as
+     * load of other processes.
+     */
+    size_t compute_budget() const;
+
+    /**
+     * @brief Set the number of slots shared by the jobs of a new run
+     * @param budget Slots available (at least 1 is used)
+     */
+    void begin_run(size_t budget);
+
+    /**
+     * @brief Take slots for a job that is starting
+     * @param pending_jobs Jobs not yet started, including this one
+     * @param idle_workers Workers other than this one that are about to start a job
+     * @return Lease of at least one slot
+     */
+    Lease acquire(size_t pending_jobs, size_t idle_workers);
+
+    /**
+     * @brief Get the slot count of the current run
+     */
+    size_t get_budget() const;
+
+    /**
+     * @brief Get number of slots currently leased
+     */
+    size_t get_slots_in_use() const;
+
+    const Options& get_options() const { return options_; }
+
+private:
+    void release(size_t slots);
+
+    Options options_;
+    size_t budget_ = 1;
+    size_t in_use_ = 0;
+    mutable std::mutex mutex_;
+};
+
+} // namespace analysis
+} // namespace wip
@@ -0,0 +1,203 @@
+#pragma once
+
+#include "shard_executor.h"
+#include <net.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace wip {
+namespace analysis {
+
+/**
+ * @brief Frame types of the coordinator/worker protocol
+ *
+ * A connection carries one shard at a time:
+ * - Hello (worker, on connect): JSON {"protocol", "slots"}
+ * - ShardRequest (coordinator): JSON {"tool", "tool_version", "config", "request"}
+ * - ShardResult (worker): 4-byte big-endian length of a JSON head {"profile"},
+ *   the head, then the result as encoded by BinaryResultFile::serialize()
+ * - Error (worker): text of a request the worker refuses, e.g. another tool version
+ */
+enum class RemoteFrame : uint8_t {
+    Hello = 1,
+    ShardRequest = 2,
+    ShardResult = 3,
+    Error = 4
+};
+
+constexpr int REMOTE_PROTOCOL_VERSION = 1;
+
+/**
+ * @brief ShardExecutor sending shards to AnalysisWorkers on other machines
+ *
+ * Every worker announces its slots when connected, and the coordinator keeps
+ * one connection per slot. execute_shard() takes an idle connection, sends
+ * the shard and waits for its result, so the engine's scheduler, which
+ * balances shards by the per-unit costs the cache recorded, spreads them
+ * over every worker.
+ *
+ * A worker whose connection breaks or times out is dropped for the rest of
+ * the run and the shard is sent to another worker, up to max_attempts
+ * times. Workers must see the sources at the same paths as the coordinator,
+ * and have the same tool versions; a worker refusing a shard fails it.
+ *
+ * Usage:
+ * ```cpp
+ * auto coordinator = std::make_shared<AnalysisCoordinator>(endpoints);
+ * if (coordinator->connect() > 0) {
+ *     engine.set_shard_executor(coordinator);
+ * }
+ * auto results = engine.analyze_async({"clang-tidy"}, request).get();
+ * ```
+ */
+class AnalysisCoordinator : public ShardExecutor {
+public:
+    struct Options {
+        std::chrono::milliseconds connect_timeout{5000};    ///< Per connection, including the hello
+        std::chrono::milliseconds shard_timeout{0};         ///< Longest wait for one shard (0 = none)
+        size_t max_attempts = 3;                            ///< Workers tried per shard before it fails
+    };
+
+    explicit AnalysisCoordinator(std::vector<wip::utils::net::Endpoint> workers);
+    AnalysisCoordinator(std::vector<wip::utils::net::Endpoint> workers, Options options);
+    ~AnalysisCoordinator() override;
+
+    AnalysisCoordinator(const AnalysisCoordinator&) = delete;
+    AnalysisCoordinator& operator=(const AnalysisCoordinator&) = delete;
+
+    /**
+     * @brief Connect every worker that is not connected, including ones lost before
+     *
+     * Unreachable workers are logged and skipped. Not to be called while shards run.
+     * @return Number of slots over all connected workers
+     */
+    size_t connect();
+
+    AnalysisResult execute_shard(const AnalysisTool& tool, const AnalysisRequest& request) override;
+
+    /**
+     * @brief Get number of slots over all connected workers
+     */
+    size_t get_slot_count() const override;
+
+    /**
+     * @brief Get number of connected workers
+     */
+    size_t get_worker_count() const;
+
+    /**
+     * @brief Get number of shards sent again after their worker was lost
+     */
+    size_t get_requeue_count() const { return requeue_count_.load(); }
+
+private:
+    struct Worker {
+        wip::utils::net::Endpoint endpoint;
+        size_t slots = 0;
+        bool connected = false;
+    };
+
+    struct Lane {
+        size_t worker = 0;
+        wip::utils::net::FramedSocket socket;
+        bool busy = false;
+    };
+
+    Lane* acquire_lane();
+    void release_lane(Lane* lane);
+    void drop_worker(Lane* lane, const std::string& reason);
+    void drop_lane(Lane* lane);
+
+    Options options_;
+    mutable std::mutex mutex_;
+    std::condition_variable lane_released_;
+    std::vector<Worker> workers_;
+    std::list<Lane> lanes_;                    // One per connection; list keeps Lane* stable
+    std::atomic<size_t> requeue_count_{0};
+};
+
+/**
+ * @brief Serves shards to AnalysisCoordinators, one thread per connection
+ *
+ * Each connection gets its own tool instances, created by name through
+ * AnalysisEngineFactory with the configuration sent along, so connections
+ * never share a running tool. Tool discovery is cached process-wide, which
+ * keeps it warm between shards. When the coordinator goes away mid-shard,
+ * the shard's processes are cancelled.
+ *
+ * Usage (what gran_azul_cli --worker does):
+ * ```cpp
+ * AnalysisWorker worker(7420);
+ * worker.serve();          // Until stop() is called from another thread
+ * ```
+ */
+class AnalysisWorker {
+public:
+    struct Options {
+        size_t slots = 0;                       ///< Shards run at once (0 = hardware concurrency)
+        std::string address = "0.0.0.0";       ///< Local address to listen on
+    };
+
+    /**
+     * @brief Listen for coordinators
+     * @param port Port to listen on (0 = any free port, see get_port())
+     * @throws wip::utils::net::NetworkError if the port cannot be bound
+     */
+    explicit AnalysisWorker(uint16_t port);
+    AnalysisWorker(uint16_t port, Options options);
+
+    /**
+     * @brief Stop serving and wait for the connection threads
+     */
+    ~AnalysisWorker();
+
+    AnalysisWorker(const AnalysisWorker&) = delete;
+    AnalysisWorker& operator=(const AnalysisWorker&) = delete;
+
+    /**
+     * @brief Accept and serve connections until stop()
+     */
+    void serve();
+
+    /**
+     * @brief Stop accepting and drop every connection; running shards are cancelled
+     */
+    void stop();
+
+    uint16_t get_port() const { return listener_.get_port(); }
+    size_t get_slot_count() const { return slots_; }
+
+    /**
+     * @brief Get number of shards run so far
+     */
+    size_t get_shard_count() const { return shard_count_.load(); }
+
+private:
+    struct Connection {
+        std::shared_ptr<wip::utils::net::FramedSocket> socket;
+        std::thread thread;
+        std::atomic<bool> done{false};
+    };
+
+    void serve_connection(wip::utils::net::FramedSocket& socket);
+    void join_finished_connections(bool all);
+
+    wip::utils::net::TcpListener listener_;
+    size_t slots_;
+    std::atomic<size_t> shard_count_{0};
+    std::atomic<bool> stopping_{false};
+
+    std::mutex connections_mutex_;
+    std::list<Connection> connections_;
+};
+
+} // namespace analysis
+} // namespace wip
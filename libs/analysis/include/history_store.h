@@ -0,0 +1,193 @@
+#pragma once
+
+#include "analysis_types.h"
+#include <mapped_file.h>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace wip {
+namespace analysis {
+
+/**
+ * @brief Summary of one run recorded in a HistoryStore
+ */
+struct HistoryRun {
+    uint64_t run_id = 0;                                      ///< Sequential ID, starting at 1
+    std::chrono::system_clock::time_point timestamp;          ///< When the run was performed
+    size_t issue_count = 0;                                   ///< Issues over all tools
+    size_t files_analyzed = 0;                                ///< Largest file count of any tool
+    std::chrono::milliseconds execution_time{0};              ///< Longest execution time of any tool
+    bool success = false;                                     ///< Whether every tool succeeded
+    std::array<size_t, ISSUE_SEVERITY_COUNT> issue_counts_by_severity{}; ///< Indexed by IssueSeverity
+    std::array<size_t, ISSUE_CATEGORY_COUNT> issue_counts_by_category{}; ///< Indexed by IssueCategory
+};
+
+/**
+ * @brief Issues of one run that matched a history query
+ */
+struct HistoryIssues {
+    HistoryRun run;
+    std::vector<AnalysisIssue> issues;      ///< Sorted by file, line and rule
+};
+
+/**
+ * @brief Issue count of one run for a file or rule
+ */
+struct HistoryTrendPoint {
+    uint64_t run_id = 0;
+    std::chrono::system_clock::time_point timestamp;
+    size_t issue_count = 0;
+};
+
+/**
+ * @brief Append-only store of analysis runs with per-file and per-rule indexes
+ *
+ * Each run is appended to a segment file as one self-contained block: its
+ * tool results, its issues as fixed-width records sorted by file, a file
+ * index, a rule index and a string table. A new segment is started once the
+ * current one would grow past the segment size. A catalog file holds one
+ * fixed-width record per run with its location and summary counts, and is
+ * the only file read when the store is opened.
+ *
+ * Queries read the catalog for the runs they cover and then only the index
+ * entries and records they need from the memory-mapped segments, so trends
+ * over many runs never load whole runs. Blocks are written before their
+ * catalog record; a run torn by a crash is not in the catalog and is ignored.
+ *
+ * All integers use the byte order of the writing machine, as in
+ * BinaryResultFile. The store is safe to use from several threads, but only
+ * one process may append to a directory at a time.
+ *
+ * Usage:
+ * ```cpp
+ * HistoryStore history(project_dir + "/history");
+ * history.append_run(results);
+ *
+ * for (const auto& point : history.get_file_trend("src/main.cpp", 30)) {
+ *     std::cout << point.run_id << ": " << point.issue_count << "\n";
+ * }
+ * auto report = engine.compare_results(history.read_run(previous_id), history.read_run(latest_id));
+ * ```
+ */
+class HistoryStore {
+public:
+    static constexpr char CATALOG_MAGIC[4] = {'W', 'I', 'P', 'H'};
+    static constexpr char BLOCK_MAGIC[4] = {'W', 'I', 'P', 'B'};
+    static constexpr uint32_t FORMAT_VERSION = 1;
+    static constexpr uint64_t DEFAULT_SEGMENT_SIZE = 64ull << 20;
+
+    /**
+     * @brief Open a store, creating its directory if needed
+     * @param directory Directory holding the catalog and segments
+     * @param segment_size Size after which a new segment file is started
+     * @throws std::runtime_error if the directory cannot be created or the catalog is not a history catalog
+     */
+    explicit HistoryStore(const std::string& directory, uint64_t segment_size = DEFAULT_SEGMENT_SIZE);
+
+    HistoryStore(const HistoryStore&) = delete;
+    HistoryStore& operator=(const HistoryStore&) = delete;
+
+    /**
+     * @brief Record the results of one run
+     * @param results Results of every tool of the run
+     * @return ID of the new run
+     * @throws std::runtime_error if the run cannot be written
+     */
+    uint64_t append_run(const std::vector<AnalysisResult>& results);
+
+    /**
+     * @brief Get the number of recorded runs
+     */
+    size_t get_run_count() const;
+
+    /**
+     * @brief Get the summaries of the most recent runs, oldest first
+     * @param last_runs Number of runs; 0 for all
+     */
+    std::vector<HistoryRun> get_runs(size_t last_runs = 0) const;
+
+    /**
+     * @brief Get the summary of a run
+     * @return Summary or nullopt if no run has the ID
+     */
+    std::optional<HistoryRun> get_run(uint64_t run_id) const;
+
+    /**
+     * @brief Materialize one run, one result per tool
+     *
+     * Issues come sorted by file, line and rule rather than in the order the
+     * tools reported them; profiles are not recorded.
+     * @throws std::out_of_range if no run has the ID
+     * @throws std::runtime_error if the run's block is corrupt
+     */
+    std::vector<AnalysisResult> read_run(uint64_t run_id) const;
+
+    /**
+     * @brief Get the issues reported for a file in the most recent runs
+     * @param file_path Exact path of the file, as reported by the tools
+     * @param last_runs Number of runs; 0 for all
+     * @return One entry per run, oldest first, including runs without issues in the file
+     */
+    std::vector<HistoryIssues> get_issues_in_file(std::string_view file_path, size_t last_runs) const;
+
+    /**
+     * @brief Get the issues reported for a rule in the most recent runs
+     * @param rule_id Rule identifier
+     * @param last_runs Number of runs; 0 for all
+     * @return One entry per run, oldest first, including runs without issues for the rule
+     */
+    std::vector<HistoryIssues> get_issues_for_rule(std::string_view rule_id, size_t last_runs) const;
+
+    /**
+     * @brief Count the issues of a file per run, reading only the file index
+     * @param file_path Exact path of the file
+     * @param last_runs Number of runs; 0 for all
+     * @return One point per run, oldest first
+     */
+    std::vector<HistoryTrendPoint> get_file_trend(std::string_view file_path, size_t last_runs) const;
+
+    /**
+     * @brief Count the issues of a rule per run, reading only the rule index
+     * @param rule_id Rule identifier
+     * @param last_runs Number of runs; 0 for all
+     * @return One point per run, oldest first
+     */
+    std::vector<HistoryTrendPoint> get_rule_trend(std::string_view rule_id, size_t last_runs) const;
+
+    const std::string& get_directory() const { return directory_; }
+
+private:
+    class Block;
+
+    struct RunLocation {
+        uint32_t segment = 0;
+        uint64_t offset = 0;
+        uint64_t size = 0;
+    };
+
+    enum class IndexKind { File, Rule };
+
+    void load_catalog();
+    std::string segment_path(uint32_t segment) const;
+    size_t first_run(size_t last_runs) const;
+    Block get_block(size_t run_index) const;
+    std::vector<HistoryIssues> query_issues(IndexKind kind, std::string_view key, size_t last_runs) const;
+    std::vector<HistoryTrendPoint> query_trend(IndexKind kind, std::string_view key, size_t last_runs) const;
+
+    std::string directory_;
+    uint64_t segment_size_;
+
+    mutable std::mutex mutex_;
+    std::vector<HistoryRun> runs_;
+    std::vector<RunLocation> locations_;
+    mutable std::map<uint32_t, wip::utils::file::MappedFile> segments_;     // Remapped when a segment grows
+};
+
+} // namespace analysis
+} // namespace wip
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "analysis_tool.h"
+#include <atomic>
+#include <string_view>
+
+namespace wip {
+namespace analysis {
+
+/**
+ * @brief Base class for analysis tools that run inside the application
+ *
+ * Cheap checks such as banned APIs, file size limits or include rules are
+ * not worth a subprocess per translation unit. An in-process tool only
+ * implements analyze_file(), which receives a read-only memory mapping of
+ * each file; listing the files, mapping them, cancellation and building the
+ * result are done here. The engine runs in-process tools on its own worker
+ * threads, one file shard per job, like the shards of external tools.
+ *
+ * analyze_file() is called from several threads at once and must not
+ * modify the tool. There is no executable, command line or result file.
+ *
+ * Usage:
+ * ```cpp
+ * class LongFileTool : public InProcessTool {
+ *     void analyze_file(const std::string& path, std::string_view contents,
+ *                       std::vector<AnalysisIssue>& issues) const override {
+ *         if (wip::utils::file::count_lines(contents) > 2000) {
+ *             issues.push_back(make_issue(path, 1, 1, "file-too-long", "File has over 2000 lines"));
+ *         }
+ *     }
+ *     // ...metadata and configuration
+ * };
+ * ```
+ */
+class InProcessTool : public AnalysisTool {
+public:
+    ~InProcessTool() override = default;
+
+    // ==================== File Analysis ====================
+
+    /**
+     * @brief Analyze the contents of one file
+     * @param path Path of the file, as listed by get_translation_units()
+     * @param contents Mapped contents of the file, valid during the call
+     * @param issues Receives the issues found in the file
+     */
+    virtual void analyze_file(const std::string& path, std::string_view contents,
+                              std::vector<AnalysisIssue>& issues) const = 0;
+
+    // ==================== Tool Metadata ====================
+
+    /**
+     * @brief Get file extensions analyzed by this tool
+     * @return C and C++ sources and headers
+     */
+    std::vector<std::string> get_supported_extensions() const override;
+
+    // ==================== Configuration Management ====================
+    void set_configuration(std::unique_ptr<ToolConfig> config) override;
+    const ToolConfig* get_configuration() const override;
+    ValidationResult validate_configuration() const override;
+
+    // ==================== Tool Availability ====================
+    bool is_available() const override { return true; }
+    std::string get_executable_path() const override { return ""; }
+    std::string get_system_requirements() const override;
+    bool runs_in_process() const override { return true; }
+
+    // ==================== Analysis Execution ====================
+
+    /**
+     * @brief Analyze the files of a request on the calling thread
+     *
+     * Files that cannot be mapped are skipped and counted in the error
+     * message; the request's cancellation token is checked between files.
+     * @param request Analysis request
+     * @return Analysis result; the scan time is reported as parse time
+     */
+    AnalysisResult execute(const AnalysisRequest& request) override;
+
+    /**
+     * @brief Analyze the files of a request on a separate thread
+     *
+     * Progress is reported after every file. Nothing is written to
+     * output_callback.
+     */
+    wip::utils::concurrency::Task<AnalysisResult> execute_async(
+        const AnalysisRequest& request,
+        std::function<void(const AnalysisProgress&)> progress_callback = nullptr,
+        std::function<void(const std::string&)> output_callback = nullptr) override;
+
+    bool cancel_analysis() override;
+    bool is_analysis_running() const override;
+
+    // ==================== Result Processing ====================
+
+    /**
+     * @brief Not supported: in-process tools write no result files
+     * @throws std::runtime_error always
+     */
+    AnalysisResult parse_results_file(const std::string& output_file) override;
+    std::vector<std::string> get_supported_output_formats() const override { return {}; }
+
+    // ==================== Utility Functions ====================
+    std::vector<std::string> build_command_line(const AnalysisRequest&) const override { return {}; }
+
+    /**
+     * @brief List the files analyzed for a request
+     *
+     * Like AnalysisTool::get_translation_units(), but lists every file with
+     * a supported extension, headers included.
+     */
+    std::vector<std::string> get_translation_units(const AnalysisRequest& request) const override;
+
+protected:
+    /**
+     * @brief Called after set_configuration(), for tools that precompute state from it
+     */
+    virtual void on_configuration_changed() {}
+
+    /**
+     * @brief Build an issue of this tool
+     * @param path File containing the issue
+     * @param line Line number (1-based)
+     * @param column Column number (1-based)
+     * @param rule_id Rule identifier, also used as the issue id
+     * @param message Issue description
+     */
+    AnalysisIssue make_issue(const std::string& path, int line, int column, const std::string& rule_id,
+                             const std::string& message) const;
+
+    std::unique_ptr<ToolConfig> config_;
+
+private:
+    AnalysisResult run(const AnalysisRequest& request,
+                       const std::function<void(const AnalysisProgress&)>& progress_callback);
+
+    std::atomic<size_t> running_count_{0};   // Runs in progress; the engine runs several shards at once
+};
+
+} // namespace analysis
+} // namespace wip
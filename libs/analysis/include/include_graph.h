@@ -0,0 +1,184 @@
+#pragma once
+
+#include "analysis_types.h"
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace wip {
+namespace analysis {
+
+/**
+ * @brief Include dependencies of a project's translation units, with a reverse index
+ *
+ * Every file reached from the units through #include directives is scanned
+ * once: its content hash and the project files it includes are stored, along
+ * with the files including it. Includes are resolved like a compiler does,
+ * quoted ones against the including file's directory first, then against the
+ * request's include paths; system headers are not found and not followed.
+ *
+ * Files are read and scanned in parallel, and rescanned only when their
+ * modification time or size changed, or when update() reports them changed.
+ * From the reverse index, get_affected_units() computes exactly the units
+ * an edit reaches, without reading any file.
+ *
+ * All members can be called from several threads; they are serialized.
+ *
+ * Usage:
+ * ```cpp
+ * IncludeGraph graph(request);
+ * graph.scan(units);
+ * // ... a header is saved ...
+ * auto affected = graph.update({"/project/include/config.h"});
+ * ```
+ */
+class IncludeGraph {
+public:
+    /**
+     * @brief What is known about one scanned file
+     */
+    struct FileInfo {
+        bool exists = false;                    ///< False if the file could not be read
+        std::string content_hash;               ///< AnalysisCache::hash_content() of the contents
+        std::vector<std::string> includes;      ///< Resolved project files it includes, in directive order
+        std::vector<std::string> include_names; ///< File names of every include directive, resolved or not
+        int64_t modification_time = 0;          ///< Write time when scanned (file clock ticks)
+        uint64_t size = 0;                      ///< Size when scanned
+    };
+
+    /**
+     * @brief Create an empty graph resolving includes like a request
+     * @param request Request whose include paths and source path are used
+     * @param thread_count Threads scanning files (0 = hardware concurrency)
+     */
+    explicit IncludeGraph(const AnalysisRequest& request, size_t thread_count = 0);
+
+    /**
+     * @brief Get the directory relative paths of a request are resolved against
+     * @return Normalized absolute source directory (the parent of a source file)
+     */
+    static std::string get_base_directory(const AnalysisRequest& request);
+
+    /**
+     * @brief Normalize a path the way the graph stores it
+     * @param path Absolute path, or path relative to base_directory
+     * @param base_directory Directory relative paths are resolved against
+     * @return Absolute, lexically normal path
+     */
+    static std::string normalize_path(const std::string& path, const std::string& base_directory);
+
+    /**
+     * @brief Collect the targets of the #include directives of a text
+     * @param contents Text to scan
+     * @param includes Receives each target and whether it was quoted ("...") rather than <...>
+     */
+    static void scan_includes(std::string_view contents, std::vector<std::pair<std::string, bool>>& includes);
+
+    /**
+     * @brief Check whether the graph resolves includes like a request
+     */
+    bool matches(const AnalysisRequest& request) const;
+
+    /**
+     * @brief Add translation units and bring the graph up to date
+     *
+     * Scans the units and every file they reach that is not known yet, and
+     * rescans known files whose modification time or size changed, so a
+     * missed update() cannot leave stale hashes behind. Files created where
+     * an include could resolve to them are only noticed by update().
+     * @param units Translation units (absolute or relative to the base directory)
+     * @return Number of files read
+     */
+    size_t scan(const std::vector<std::string>& units);
+
+    /**
+     * @brief Rescan changed files and get the units the changes reach
+     *
+     * Known files are rescanned, files whose creation or removal can change
+     * how an include resolves cause the files including that name to be
+     * rescanned, and newly included files are scanned. Removed units are
+     * dropped. New translation units are not detected; add them with scan().
+     * @param changed_files Paths of created, modified or removed files
+     * @return Units reached by the changes, sorted
+     */
+    std::vector<std::string> update(const std::vector<std::string>& changed_files);
+
+    /**
+     * @brief Get the units that reach any of the given files, without reading anything
+     * @param files Paths of files, units included
+     * @return Sorted units, including given files that are units
+     */
+    std::vector<std::string> get_affected_units(const std::vector<std::string>& files) const;
+
+    /**
+     * @brief Get every project file a unit reaches through includes
+     * @param unit Normalized unit path
+     * @return Sorted files, not including the unit itself
+     */
+    std::vector<std::string> get_closure(const std::string& unit) const;
+
+    /**
+     * @brief Get the files including a file directly
+     * @param path Normalized file path
+     * @return Sorted including files
+     */
+    std::vector<std::string> get_includers(const std::string& path) const;
+
+    /**
+     * @brief Get what is known about a file
+     * @param path Normalized file path
+     * @return Copy of the file's entry, or an entry with exists = false if it was never scanned
+     */
+    FileInfo get_file(const std::string& path) const;
+
+    /**
+     * @brief Get the content hash of a file
+     * @param path Normalized file path
+     * @return Hash of the contents, or an empty string if the file was never scanned or is missing
+     */
+    std::string get_content_hash(const std::string& path) const;
+
+    /**
+     * @brief Get the translation units of the graph, sorted
+     */
+    std::vector<std::string> get_units() const;
+
+    /**
+     * @brief Get the number of scanned files, units included
+     */
+    size_t get_file_count() const;
+
+    /**
+     * @brief Get the base directory relative paths are resolved against
+     */
+    const std::string& get_base_directory() const { return base_directory_; }
+
+private:
+    FileInfo read_file_info(const std::string& path) const;
+    std::string resolve(const std::string& name, const std::string* including_directory) const;
+    size_t scan_files(std::vector<std::string> paths);
+    void install(const std::string& path, FileInfo info);
+    void add_name_users(const std::string& path, std::set<std::string>& files) const;
+    std::vector<std::string> affected_units_locked(const std::vector<std::string>& files) const;
+    void collect_closure(const std::string& unit, std::set<std::string>& closure) const;
+
+    std::string base_directory_;
+    std::vector<std::string> include_paths_;        // As given in the request, for matches()
+    std::vector<std::string> include_dirs_;         // Absolute include directories
+    size_t thread_count_ = 0;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, FileInfo> files_;
+    std::unordered_map<std::string, std::set<std::string>> includers_;             // File -> files including it
+    std::unordered_map<std::string, std::unordered_set<std::string>> by_name_;     // Include file name -> files using it
+    std::set<std::string> units_;
+};
+
+} // namespace analysis
+} // namespace wip
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "issue_store.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace wip {
+namespace analysis {
+
+/**
+ * @brief Trigram index for substring search over the issues of an IssueStore
+ *
+ * Finds the issues whose file path, rule ID or message contains a text,
+ * ignoring ASCII case. Only the distinct strings of the store are indexed:
+ * each trigram lists the strings containing it, and each string lists the
+ * issues referencing it. A query intersects the lists of its trigrams, checks
+ * the few candidate strings, and collects their issues, so its cost depends
+ * on the number of matches rather than on the number of issues.
+ *
+ * The index is immutable once built and can be shared between threads.
+ *
+ * Usage:
+ * ```cpp
+ * IssueSearchIndex index(store);
+ * for (uint32_t issue : index.find("nullptr")) {
+ *     std::cout << store[issue].message() << "\n";
+ * }
+ * ```
+ */
+class IssueSearchIndex {
+public:
+    IssueSearchIndex() = default;
+
+    /**
+     * @brief Index every issue of a store
+     * @param store Issues to index; the index keeps no reference to it
+     */
+    explicit IssueSearchIndex(const IssueStore& store);
+
+    /**
+     * @brief Find the issues containing a text
+     * @param text Text to look for in file paths, rule IDs and messages
+     * @return Ascending indices of the matching issues; all issues for an empty text
+     */
+    std::vector<uint32_t> find(std::string_view text) const;
+
+    /**
+     * @brief Get number of issues covered by the index
+     */
+    size_t get_issue_count() const { return issue_count_; }
+
+    /**
+     * @brief Get number of distinct strings indexed
+     */
+    size_t get_string_count() const { return strings_.size(); }
+
+    /**
+     * @brief Estimate heap memory held by the index, in bytes
+     */
+    size_t get_memory_usage() const;
+
+private:
+    // Indices into strings_ containing `text`, ascending
+    std::vector<uint32_t> find_strings(const std::string& text) const;
+
+    size_t issue_count_ = 0;
+
+    // Distinct strings referenced by the issues, lowercased
+    std::vector<std::string> strings_;
+
+    // Issues referencing each string: string_issues_[string_offsets_[s] .. string_offsets_[s + 1])
+    std::vector<uint32_t> string_offsets_;
+    std::vector<uint32_t> string_issues_;
+
+    // Strings containing each trigram, sorted by trigram:
+    // trigram_strings_[trigram_offsets_[t] .. trigram_offsets_[t + 1]) for trigrams_[t]
+    std::vector<uint32_t> trigrams_;
+    std::vector<uint32_t> trigram_offsets_;
+    std::vector<uint32_t> trigram_strings_;
+};
+
+} // namespace analysis
+} // namespace wip
@@ -0,0 +1,238 @@
+#pragma once
+
+#include "analysis_types.h"
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace wip {
+namespace analysis {
+
+/**
+ * @brief Deduplicating string storage handing out stable 32-bit IDs
+ *
+ * Interned strings never move, so the views returned by get() stay valid for
+ * the lifetime of the pool.
+ */
+class StringPool {
+public:
+    using Id = uint32_t;
+
+    /**
+     * @brief Get the ID of a string, adding it on first use
+     * @param value String to intern
+     * @return ID of the string
+     */
+    Id intern(std::string_view value);
+
+    /**
+     * @brief Look up an interned string
+     * @param id ID returned by intern()
+     * @return View of the string
+     */
+    std::string_view get(Id id) const { return strings_[id]; }
+
+    /**
+     * @brief Find the ID of a string without interning it
+     * @param value String to look up
+     * @param id Receives the ID if the string is known
+     * @return True if the string has been interned
+     */
+    bool find(std::string_view value, Id& id) const;
+
+    /**
+     * @brief Get number of distinct strings
+     */
+    size_t size() const { return strings_.size(); }
+
+    /**
+     * @brief Get total number of characters stored
+     */
+    size_t get_character_count() const { return character_count_; }
+
+    /**
+     * @brief Remove all strings (invalidates every ID and view)
+     */
+    void clear();
+
+private:
+    std::deque<std::string> strings_;                    // Deque keeps elements in place on growth
+    std::unordered_map<std::string_view, Id> ids_;        // Views into strings_
+    size_t character_count_ = 0;
+};
+
+/**
+ * @brief Compact, column-oriented storage for large issue sets
+ *
+ * Paths, rule IDs and tool names repeat across hundreds of thousands of
+ * issues, so every string is interned once and issues only store 32-bit IDs.
+ * Numeric fields live in separate columns, which keeps filtering by severity,
+ * category or file a linear scan over small integers.
+ *
+ * Usage:
+ * ```cpp
+ * IssueStore store(result.issues);
+ * for (auto issue : store.get_issues_by_severity(IssueSeverity::Error)) {
+ *     std::cout << issue.file_path() << ":" << issue.line_number() << "\n";
+ * }
+ * ```
+ */
+class IssueStore {
+public:
+    /**
+     * @brief Lightweight read-only view of one stored issue
+     *
+     * Views are two words wide and can be copied freely. They stay valid until
+     * the store is cleared or destroyed.
+     */
+    class IssueView {
+    public:
+        IssueView(const IssueStore& store, size_t index) : store_(&store), index_(index) {}
+
+        size_t get_index() const { return index_; }
+
+        std::string_view id() const { return text(store_->ids_); }
+        std::string_view message() const { return text(store_->messages_); }
+        std::string_view file_path() const { return text(store_->file_paths_); }
+        int line_number() const { return store_->line_numbers_[index_]; }
+        int column_number() const { return store_->column_numbers_[index_]; }
+        IssueSeverity severity() const { return static_cast<IssueSeverity>(store_->severities_[index_]); }
+        IssueCategory category() const { return static_cast<IssueCategory>(store_->categories_[index_]); }
+        std::string_view rule_id() const { return text(store_->rule_ids_); }
+        std::string_view tool_name() const { return text(store_->tool_names_); }
+        bool has_fix_suggestion() const { return store_->fix_suggestions_[index_] != NO_STRING; }
+        std::string_view fix_suggestion() const { return has_fix_suggestion() ? text(store_->fix_suggestions_) : std::string_view(); }
+
+        // IDs of the issue's strings in get_strings(), for indexing issues by string
+        StringPool::Id message_string_id() const { return store_->messages_[index_]; }
+        StringPool::Id file_path_string_id() const { return store_->file_paths_[index_]; }
+        StringPool::Id rule_id_string_id() const { return store_->rule_ids_[index_]; }
+
+        /**
+         * @brief Get the identity key of this issue (file, line, rule)
+         * @return Key viewing the store's strings
+         */
+        IssueKey key() const { return IssueKey{file_path(), line_number(), rule_id()}; }
+
+        /**
+         * @brief Materialize the issue as an AnalysisIssue
+         */
+        AnalysisIssue to_issue() const;
+
+    private:
+        std::string_view text(const std::vector<StringPool::Id>& column) const {
+            return store_->strings_.get(column[index_]);
+        }
+
+        const IssueStore* store_;
+        size_t index_;
+    };
+
+    IssueStore() = default;
+
+    /**
+     * @brief Build a store from a list of issues
+     * @param issues Issues to store, in order
+     */
+    explicit IssueStore(const std::vector<AnalysisIssue>& issues);
+
+    // Views point into the store, so it is move-only
+    IssueStore(const IssueStore&) = delete;
+    IssueStore& operator=(const IssueStore&) = delete;
+    IssueStore(IssueStore&&) = default;
+    IssueStore& operator=(IssueStore&&) = default;
+
+    /**
+     * @brief Append an issue
+     * @param issue Issue to store
+     */
+    void add(const AnalysisIssue& issue);
+
+    /**
+     * @brief Reserve column capacity for a number of issues
+     */
+    void reserve(size_t issue_count);
+
+    /**
+     * @brief Remove all issues and strings
+     */
+    void clear();
+
+    size_t size() const { return line_numbers_.size(); }
+    bool empty() const { return line_numbers_.empty(); }
+
+    IssueView operator[](size_t index) const { return IssueView(*this, index); }
+
+    /**
+     * @brief Materialize every issue, in insertion order
+     * @return Issues equal to the ones that were added
+     */
+    std::vector<AnalysisIssue> to_issues() const;
+
+    /**
+     * @brief Get issues filtered by severity
+     * @param min_severity Minimum severity level to include
+     * @return Views of issues with severity >= min_severity
+     */
+    std::vector<IssueView> get_issues_by_severity(IssueSeverity min_severity) const;
+
+    /**
+     * @brief Get issues filtered by category
+     * @param category Category to filter by
+     * @return Views of issues in the specified category
+     */
+    std::vector<IssueView> get_issues_by_category(IssueCategory category) const;
+
+    /**
+     * @brief Get issues reported for a file
+     * @param file_path Exact path of the file
+     * @return Views of issues in the file
+     */
+    std::vector<IssueView> get_issues_in_file(std::string_view file_path) const;
+
+    /**
+     * @brief Count issues by severity
+     * @return Counts indexed by IssueSeverity
+     */
+    std::array<size_t, ISSUE_SEVERITY_COUNT> count_by_severity() const;
+
+    /**
+     * @brief Count issues by category
+     * @return Counts indexed by IssueCategory
+     */
+    std::array<size_t, ISSUE_CATEGORY_COUNT> count_by_category() const;
+
+    /**
+     * @brief Get interned string storage shared by all columns
+     */
+    const StringPool& get_strings() const { return strings_; }
+
+    /**
+     * @brief Estimate heap memory held by the store, in bytes
+     */
+    size_t get_memory_usage() const;
+
+private:
+    static constexpr StringPool::Id NO_STRING = UINT32_MAX;
+
+    StringPool strings_;
+
+    // One entry per issue in every column
+    std::vector<StringPool::Id> ids_;
+    std::vector<StringPool::Id> messages_;
+    std::vector<StringPool::Id> file_paths_;
+    std::vector<StringPool::Id> rule_ids_;
+    std::vector<StringPool::Id> tool_names_;
+    std::vector<StringPool::Id> fix_suggestions_;       // NO_STRING when absent
+    std::vector<int32_t> line_numbers_;
+    std::vector<int32_t> column_numbers_;
+    std::vector<uint8_t> severities_;
+    std::vector<uint8_t> categories_;
+};
+
+} // namespace analysis
+} // namespace wip
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace wip {
+namespace analysis {
+
+/**
+ * @brief Fixed-size thread pool with per-worker job deques and work stealing
+ *
+ * Every worker owns a deque. Jobs submitted from outside the pool are spread
+ * round-robin over the deques; jobs submitted from inside a job go to the
+ * submitting worker's own deque. A worker takes jobs from the back of its own
+ * deque and, when it runs dry, steals from the front of the others, so a slow
+ * job never leaves the remaining cores idle.
+ *
+ * Usage:
+ * ```cpp
+ * JobScheduler scheduler(4);
+ * for (const auto& file : files) {
+ *     scheduler.submit([file]() { analyze(file); });
+ * }
+ * scheduler.wait();
+ * ```
+ */
+class JobScheduler {
+public:
+    using Job = std::function<void()>;
+
+    /**
+     * @brief Start the worker threads
+     * @param worker_count Number of workers (0 = hardware concurrency)
+     */
+    explicit JobScheduler(size_t worker_count = 0);
+
+    /**
+     * @brief Finish all submitted jobs and stop the workers
+     */
+    ~JobScheduler();
+
+    JobScheduler(const JobScheduler&) = delete;
+    JobScheduler& operator=(const JobScheduler&) = delete;
+
+    /**
+     * @brief Queue a job for execution
+     * @param job Job to run on one of the workers
+     */
+    void submit(Job job);
+
+    /**
+     * @brief Block until every submitted job has finished
+     * @throws The first exception thrown by a job since the last wait()
+     */
+    void wait();
+
+    /**
+     * @brief Get number of worker threads
+     */
+    size_t get_worker_count() const { return workers_.size(); }
+
+    /**
+     * @brief Get number of jobs taken from another worker's deque so far
+     */
+    size_t get_steal_count() const { return steal_count_.load(); }
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    void worker_loop(size_t index);
+    bool take_job(size_t index, Job& job);
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> workers_;
+
+    std::mutex state_mutex_;
+    std::condition_variable work_available_;
+    std::condition_variable all_done_;
+    size_t queued_jobs_ = 0;                // Jobs waiting in a deque
+    size_t pending_jobs_ = 0;               // Jobs submitted but not finished
+    bool stopping_ = false;
+    std::exception_ptr first_exception_;
+
+    std::atomic<size_t> next_queue_{0};
+    std::atomic<size_t> steal_count_{0};
+};
+
+} // namespace analysis
+} // namespace wip
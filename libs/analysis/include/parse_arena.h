@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <string_view>
+
+namespace wip {
+namespace analysis {
+
+/**
+ * @brief Monotonic memory for the scratch data of one parse or aggregation pass
+ *
+ * Copies of output lines and the nodes of deduplication sets are needed only
+ * until the pass ends, and are all dropped at once. Taking them from an arena
+ * turns one malloc and free per line into a bump of a pointer, and dropping
+ * them into releasing a few large blocks. Containers use it through
+ * resource(), e.g. `std::pmr::set<std::string_view> seen(arena.resource())`.
+ *
+ * Issues themselves are not kept in the arena: they outlive the pass in
+ * results, caches and the UI.
+ *
+ * Not thread-safe; use one arena per thread.
+ */
+class ParseArena {
+public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    /**
+     * @brief Create an empty arena
+     * @param block_size Size of the first block; later blocks grow geometrically
+     */
+    explicit ParseArena(size_t block_size = DEFAULT_BLOCK_SIZE);
+
+    ParseArena(const ParseArena&) = delete;
+    ParseArena& operator=(const ParseArena&) = delete;
+
+    /**
+     * @brief Get the memory resource for pmr containers
+     */
+    std::pmr::memory_resource* resource() { return &counter_; }
+
+    /**
+     * @brief Copy text into the arena
+     * @return View of the copy, valid until reset() or destruction
+     */
+    std::string_view copy(std::string_view text);
+
+    /**
+     * @brief Get number of bytes handed out so far, including container nodes
+     */
+    size_t get_bytes_allocated() const { return counter_.bytes; }
+
+    /**
+     * @brief Release everything at once; containers using the arena must be gone
+     */
+    void reset();
+
+private:
+    // Counts what the arena hands out; every allocation still goes to the monotonic buffer
+    class CountingResource : public std::pmr::memory_resource {
+    public:
+        explicit CountingResource(std::pmr::memory_resource* upstream) : upstream_(upstream) {}
+        size_t bytes = 0;
+
+    private:
+        void* do_allocate(size_t size, size_t alignment) override {
+            bytes += size;
+            return upstream_->allocate(size, alignment);
+        }
+        void do_deallocate(void* pointer, size_t size, size_t alignment) override {
+            upstream_->deallocate(pointer, size, alignment);
+        }
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+        std::pmr::memory_resource* upstream_;
+    };
+
+    std::pmr::monotonic_buffer_resource buffer_;
+    CountingResource counter_;
+};
+
+} // namespace analysis
+} // namespace wip
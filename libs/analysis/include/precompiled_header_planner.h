@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace wip {
+namespace analysis {
+
+/**
+ * @brief Groups translation units by the headers they all start with, for precompiling
+ *
+ * A unit's prefix is the run of #include directives at the top of its file,
+ * before any other directive or code. Units compiled with the same flags
+ * whose prefixes begin alike share a group; the group's header includes that
+ * common prefix, so one precompiled header can stand in for parsing it in
+ * every unit. Groups are made as deep as they can be while keeping at least
+ * the minimum number of units.
+ *
+ * Quoted includes are resolved to absolute paths, since the generated header
+ * lives elsewhere. A prefix stops at an include that cannot be resolved or
+ * names a project header without an include guard, because the unit includes
+ * it again after the precompiled header was loaded.
+ *
+ * Usage:
+ * ```cpp
+ * std::vector<PrecompiledHeaderPlanner::Unit> prefixes;
+ * for (const auto& unit : units) {
+ *     auto command = commands.count(unit) ? commands[unit] : default_command;
+ *     prefixes.push_back({unit, command, PrecompiledHeaderPlanner::leading_includes(read(unit), unit, include_dirs)});
+ * }
+ * for (const auto& group : PrecompiledHeaderPlanner::plan(prefixes, 2)) {
+ *     write(header_path, PrecompiledHeaderPlanner::header_text(group));
+ *     // compile header_path with group.command, pass the result to group.units
+ * }
+ * ```
+ */
+class PrecompiledHeaderPlanner {
+public:
+    /**
+     * @brief How a unit is compiled, without its input and outputs
+     */
+    struct CompileCommand {
+        std::string directory;                  ///< Directory the compiler runs in
+        std::vector<std::string> flags;         ///< Arguments without compiler, -c, -o and dependency outputs
+        std::string language = "c++";           ///< "c" or "c++"
+
+        bool operator<(const CompileCommand& other) const;
+        bool operator==(const CompileCommand& other) const;
+    };
+
+    /**
+     * @brief A unit with its compile command and include prefix
+     */
+    struct Unit {
+        std::string path;
+        CompileCommand command;
+        std::vector<std::string> includes;      ///< leading_includes() of the unit
+    };
+
+    /**
+     * @brief Units sharing a precompiled header
+     */
+    struct Group {
+        CompileCommand command;                 ///< Shared by all units
+        std::vector<std::string> includes;      ///< Common prefix, as spelled in header_text()
+        std::vector<std::string> units;         ///< Sorted unit paths
+    };
+
+    /**
+     * @brief Collect the include directives a unit starts with
+     * @param contents Contents of the unit
+     * @param unit_path Path of the unit; its directory is searched first for quoted includes
+     * @param include_dirs Absolute include directories, searched in order
+     * @return Targets as `<name>` or `"absolute path"`, in directive order
+     */
+    static std::vector<std::string> leading_includes(std::string_view contents, const std::string& unit_path,
+                                                     const std::vector<std::string>& include_dirs);
+
+    /**
+     * @brief Group units by compile command and common include prefix
+     * @param units Units with their prefixes
+     * @param min_units Fewest units a group is made for (at least 2)
+     * @return Groups with a non-empty prefix, most units first; units outside every group are left out
+     */
+    static std::vector<Group> plan(const std::vector<Unit>& units, size_t min_units);
+
+    /**
+     * @brief Get the contents of a group's header
+     */
+    static std::string header_text(const Group& group);
+
+    /**
+     * @brief Read the compile commands of a compilation database
+     * @param build_dir Directory holding compile_commands.json
+     * @return Command by normalized absolute unit path; empty if the database cannot be read
+     */
+    static std::map<std::string, CompileCommand> read_compile_commands(const std::string& build_dir);
+
+    /**
+     * @brief Get the -I and -iquote directories of compile flags, made absolute
+     * @param command Compile command whose flags are searched
+     * @return Directories in flag order
+     */
+    static std::vector<std::string> get_include_dirs(const CompileCommand& command);
+};
+
+} // namespace analysis
+} // namespace wip
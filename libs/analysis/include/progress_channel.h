@@ -0,0 +1,130 @@
+#pragma once
+
+#include "analysis_types.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace wip {
+namespace analysis {
+
+/**
+ * @brief Carries tool output and progress from analysis workers to the UI
+ *
+ * Workers publish without taking a lock or waiting: output lines go into a
+ * bounded lock-free ring, and progress goes into one slot per tool, where a
+ * newer update replaces the one not yet drained. The UI drains the channel
+ * once per frame, so it sees every line that fit into the ring and only the
+ * latest progress of each tool, however fast the tools report.
+ *
+ * When the ring is full, new lines are dropped rather than blocking the tool.
+ * The statistics count the dropped lines and merged updates, so a view can
+ * tell the user that output was lost and the ring can be sized from the peak.
+ *
+ * Usage:
+ * ```cpp
+ * auto channel = std::make_shared<ProgressChannel>(tool_names);
+ * engine.analyze_async(tool_names, request,
+ *     [channel](const std::string& tool, const AnalysisProgress& p) { channel->publish_progress(tool, p); },
+ *     [channel](const std::string& tool, const std::string& line) { channel->publish_line(tool, line); },
+ *     on_complete);
+ * // Once per frame
+ * channel->drain(show_line, show_progress);
+ * ```
+ */
+class ProgressChannel {
+public:
+    static constexpr size_t DEFAULT_LINE_CAPACITY = 8192;
+
+    using LineHandler = std::function<void(const std::string& tool_name, const std::string& line)>;
+    using ProgressHandler = std::function<void(const std::string& tool_name, const AnalysisProgress& progress)>;
+
+    /**
+     * @brief Counters describing how much the channel carried and lost
+     */
+    struct Statistics {
+        uint64_t lines_published = 0;       ///< Lines accepted into the ring
+        uint64_t lines_delivered = 0;       ///< Lines handed to a drain
+        uint64_t lines_dropped = 0;         ///< Lines lost because the ring was full or the tool unknown
+        uint64_t progress_published = 0;    ///< Progress updates published
+        uint64_t progress_merged = 0;       ///< Updates replaced by a newer one before being drained
+        uint64_t progress_delivered = 0;    ///< Updates handed to a drain
+        size_t peak_queued_lines = 0;       ///< Most lines waiting at once
+    };
+
+    /**
+     * @brief Create a channel for the tools of one run
+     * @param tool_names Tools that publish into the channel
+     * @param line_capacity Lines held before new ones are dropped (rounded up to a power of two)
+     */
+    explicit ProgressChannel(std::vector<std::string> tool_names, size_t line_capacity = DEFAULT_LINE_CAPACITY);
+    ~ProgressChannel();
+
+    ProgressChannel(const ProgressChannel&) = delete;
+    ProgressChannel& operator=(const ProgressChannel&) = delete;
+
+    /**
+     * @brief Queue one output line; safe to call from any number of threads
+     * @return false if the line was dropped
+     */
+    bool publish_line(const std::string& tool_name, std::string line);
+
+    /**
+     * @brief Replace the tool's pending progress; safe to call from any number of threads
+     */
+    void publish_progress(const std::string& tool_name, const AnalysisProgress& progress);
+
+    /**
+     * @brief Deliver the queued lines, then the latest progress of each tool
+     *
+     * Only one thread may drain at a time.
+     *
+     * @param on_line Called for each line in the order it was published (may be empty)
+     * @param on_progress Called for each tool with pending progress (may be empty)
+     * @param max_lines Lines delivered at most; the rest wait for the next drain (0 = all)
+     * @return Number of lines delivered
+     */
+    size_t drain(const LineHandler& on_line, const ProgressHandler& on_progress, size_t max_lines = 0);
+
+    /**
+     * @brief Check whether lines or progress are waiting to be drained
+     */
+    bool has_pending() const;
+
+    Statistics get_statistics() const;
+    size_t get_line_capacity() const { return mask_ + 1; }
+    const std::vector<std::string>& get_tool_names() const { return tool_names_; }
+
+private:
+    struct alignas(64) Cell {
+        std::atomic<size_t> sequence{0};
+        uint32_t tool = 0;
+        std::string line;
+    };
+
+    size_t find_tool(const std::string& tool_name) const;
+    void note_queued(size_t queued);
+
+    std::vector<std::string> tool_names_;
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_;
+    std::unique_ptr<std::atomic<AnalysisProgress*>[]> progress_;
+
+    alignas(64) std::atomic<size_t> enqueue_position_{0};
+    alignas(64) std::atomic<size_t> dequeue_position_{0};
+
+    alignas(64) std::atomic<uint64_t> lines_published_{0};
+    std::atomic<uint64_t> lines_dropped_{0};
+    std::atomic<uint64_t> progress_published_{0};
+    std::atomic<uint64_t> progress_merged_{0};
+    std::atomic<size_t> peak_queued_lines_{0};
+    std::atomic<uint64_t> lines_delivered_{0};
+    std::atomic<uint64_t> progress_delivered_{0};
+};
+
+} // namespace analysis
+} // namespace wip
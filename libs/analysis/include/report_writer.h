@@ -0,0 +1,292 @@
+#pragma once
+
+#include "analysis_types.h"
+#include "result_file.h"
+#include <array>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace wip {
+namespace analysis {
+
+/**
+ * @brief Output formats of ReportWriter
+ */
+enum class ReportFormat {
+    Json,      ///< Report object with one issue array per tool
+    Html,      ///< Standalone page with one issue table per tool
+    Sarif      ///< SARIF 2.1.0 log with one run per tool, for code scanning services
+};
+
+/**
+ * @brief Borrowed view of one issue as the report writer needs it
+ *
+ * Built from an AnalysisIssue or straight from a binary result file record,
+ * without copying any string.
+ */
+struct ReportIssue {
+    std::string_view id;
+    std::string_view message;
+    std::string_view file_path;
+    int line_number = 0;
+    int column_number = 0;
+    IssueSeverity severity = IssueSeverity::Warning;
+    IssueCategory category = IssueCategory::Style;
+    std::string_view rule_id;
+    std::string_view tool_name;
+    std::string_view fix_suggestion;                   ///< Empty if there is none
+
+    ReportIssue() = default;
+    ReportIssue(const AnalysisIssue& issue);
+    ReportIssue(const BinaryResultFile::IssueView& issue);
+};
+
+/**
+ * @brief Everything written before the first tool
+ */
+struct ReportHeader {
+    std::string title = "Code Quality Report";
+    std::string project_name;
+    std::string generator_name = "wip-analysis";
+    std::string generator_version = "1.0.0";
+    std::chrono::system_clock::time_point generated_at = std::chrono::system_clock::now();
+    std::vector<std::pair<std::string, std::string>> properties;    ///< Extra project facts, written in order
+};
+
+/**
+ * @brief Counts gathered while the issues are written
+ */
+struct ReportStatistics {
+    size_t total_issues = 0;
+    std::array<size_t, ISSUE_SEVERITY_COUNT> issues_by_severity{};     ///< Indexed by IssueSeverity
+    std::array<size_t, ISSUE_CATEGORY_COUNT> issues_by_category{};     ///< Indexed by IssueCategory
+    size_t tool_count = 0;
+    size_t failed_tool_count = 0;
+
+    size_t get_issue_count(IssueSeverity severity) const {
+        return issues_by_severity[static_cast<size_t>(severity)];
+    }
+
+    size_t get_issue_count(IssueCategory category) const {
+        return issues_by_category[static_cast<size_t>(category)];
+    }
+};
+
+/**
+ * @brief Streaming writer for analysis reports
+ *
+ * Every issue is rendered to the stream as soon as it is written, and the
+ * statistics are counted in the same pass, so memory use stays the same
+ * however many issues a report holds. The statistics are written last, after
+ * the tools. Nothing is buffered between calls, so issues can come straight
+ * from a parser callback or a memory-mapped result file.
+ *
+ * Usage:
+ * ```cpp
+ * ReportWriter writer(out, ReportFormat::Sarif, header);
+ * writer.begin_tool("cppcheck", "2.13");
+ * tool.stream_results_file("cppcheck.xml", [&](const AnalysisIssue& issue) { writer.write_issue(issue); });
+ * writer.end_tool(true);
+ * writer.finish();
+ * ```
+ */
+class ReportWriter {
+public:
+    using Summary = std::vector<std::pair<std::string, std::string>>;
+
+    /**
+     * @brief Start a report
+     * @param out Stream the report is written to; must outlive the writer
+     * @param format Output format
+     * @param header Title, project and generator written before the tools
+     */
+    ReportWriter(std::ostream& out, ReportFormat format, const ReportHeader& header = {});
+
+    ReportWriter(const ReportWriter&) = delete;
+    ReportWriter& operator=(const ReportWriter&) = delete;
+
+    /**
+     * @brief Start the section of one tool
+     * @param name Tool name
+     * @param version Tool version, if known
+     * @throws std::logic_error if a tool is already open or the report is finished
+     */
+    void begin_tool(std::string_view name, std::string_view version = {});
+
+    /**
+     * @brief Write one issue of the open tool
+     * @throws std::logic_error if no tool is open
+     */
+    void write_issue(const ReportIssue& issue);
+
+    /**
+     * @brief Close the open tool's section
+     * @param success Whether the tool ran successfully
+     * @param error_message Why it failed, if it did
+     */
+    void end_tool(bool success = true, std::string_view error_message = {});
+
+    /**
+     * @brief Write a whole result as one tool section
+     */
+    void write_result(const AnalysisResult& result);
+
+    /**
+     * @brief Write the statistics and close the report
+     * @param summary Extra results, such as a quality score, written with the statistics
+     * @return Statistics over every written issue
+     */
+    const ReportStatistics& finish(const Summary& summary = {});
+
+    /**
+     * @brief Get the statistics of the issues written so far
+     */
+    const ReportStatistics& get_statistics() const { return statistics_; }
+
+private:
+    void write_header();
+    void flush_line();
+
+    std::ostream& out_;
+    ReportFormat format_;
+    ReportHeader header_;
+    ReportStatistics statistics_;
+    std::string line_;                 // Rendered text not yet handed to the stream, reused
+    std::string tool_name_;
+    bool tool_open_ = false;
+    bool finished_ = false;
+    size_t tool_issue_count_ = 0;
+};
+
+/**
+ * @brief NDJSON sink for issues streamed from AnalysisEngine
+ *
+ * Writes one issue per line as a compact JSON object with the members of
+ * AnalysisIssue::to_json(), so a consumer can ingest the stream line by line
+ * and NdjsonResultFile can split it into byte ranges. Batches may arrive from
+ * several threads; each batch is rendered without holding the lock and then
+ * written in one piece, so lines never interleave.
+ *
+ * Usage:
+ * ```cpp
+ * std::ofstream out("issues.ndjson");
+ * NdjsonIssueWriter ndjson(out);
+ * engine.run_analysis(request, nullptr, nullptr, nullptr, ndjson.callback());
+ * ```
+ */
+class NdjsonIssueWriter {
+public:
+    using Callback = std::function<void(const std::string& tool_name, const std::vector<AnalysisIssue>& issues)>;
+
+    /**
+     * @param out Stream the lines are written to; must outlive the writer
+     */
+    explicit NdjsonIssueWriter(std::ostream& out) : out_(out) {}
+
+    NdjsonIssueWriter(const NdjsonIssueWriter&) = delete;
+    NdjsonIssueWriter& operator=(const NdjsonIssueWriter&) = delete;
+
+    /**
+     * @brief Write a batch of issues of one tool
+     * @param tool_name Written for issues that carry no tool name of their own
+     * @param issues Issues to write, one line each
+     */
+    void write_issues(std::string_view tool_name, const std::vector<AnalysisIssue>& issues);
+
+    /**
+     * @brief Write every issue of a result
+     */
+    void write_result(const AnalysisResult& result) { write_issues(result.tool_name, result.issues); }
+
+    /**
+     * @brief Get an issue callback that writes to this writer, for AnalysisEngine
+     */
+    Callback callback();
+
+    /**
+     * @brief Get the number of issues written so far
+     */
+    size_t get_issue_count() const;
+
+private:
+    std::ostream& out_;
+    mutable std::mutex mutex_;
+    size_t issue_count_ = 0;
+};
+
+/**
+ * @brief SARIF 2.1.0 sink for issues streamed from AnalysisEngine
+ *
+ * The engine delivers the batches of all tools interleaved, so unlike
+ * ReportWriter, which writes one run per tool, the log holds a single run:
+ * its results are written as they arrive, each naming its tool in its
+ * property bag, and the run's tool object, which lists every tool seen as an
+ * extension of the driver, is written after them by finish(). The writer is
+ * thread-safe in the same way as NdjsonIssueWriter.
+ */
+class SarifIssueWriter {
+public:
+    using Callback = NdjsonIssueWriter::Callback;
+
+    /**
+     * @brief Start a log
+     * @param out Stream the log is written to; must outlive the writer
+     * @param header Generator written as the run's driver, and project facts
+     */
+    explicit SarifIssueWriter(std::ostream& out, const ReportHeader& header = {});
+
+    SarifIssueWriter(const SarifIssueWriter&) = delete;
+    SarifIssueWriter& operator=(const SarifIssueWriter&) = delete;
+
+    /**
+     * @brief Write a batch of issues of one tool
+     * @throws std::logic_error after finish()
+     */
+    void write_issues(std::string_view tool_name, const std::vector<AnalysisIssue>& issues);
+
+    /**
+     * @brief Write every issue of a result, and its failure if it failed
+     */
+    void write_result(const AnalysisResult& result);
+
+    /**
+     * @brief Get an issue callback that writes to this writer, for AnalysisEngine
+     */
+    Callback callback();
+
+    /**
+     * @brief Record a tool that failed, for the run's invocation
+     */
+    void add_tool_failure(std::string_view tool_name, std::string_view error_message);
+
+    /**
+     * @brief Write the tools, the invocation and the statistics, and close the log
+     * @return Statistics over every written issue
+     */
+    ReportStatistics finish();
+
+    /**
+     * @brief Get the statistics of the issues written so far
+     */
+    ReportStatistics get_statistics() const;
+
+private:
+    size_t add_tool(std::string_view tool_name);  // mutex_ must be held
+
+    std::ostream& out_;
+    ReportHeader header_;
+    mutable std::mutex mutex_;
+    ReportStatistics statistics_;
+    std::vector<std::string> tools_;                                 // In order of first issue
+    std::vector<std::pair<std::string, std::string>> failures_;      // Tool and error message
+    bool finished_ = false;
+};
+
+} // namespace analysis
+} // namespace wip
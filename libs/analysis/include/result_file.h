@@ -0,0 +1,278 @@
+#pragma once
+
+#include "analysis_types.h"
+#include <mapped_file.h>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace wip {
+namespace analysis {
+
+/**
+ * @brief On-disk formats for saved analysis results
+ */
+enum class ResultFormat {
+    Json,      ///< Human-readable, for interchange
+    Binary,    ///< Compact and fast to load, for baselines
+    Ndjson     ///< One issue per line, for line-by-line ingestion (see NdjsonResultFile)
+};
+
+/**
+ * @brief Reader and writer for the versioned binary result format
+ *
+ * The file holds a fixed header, one fixed-width record per result, one
+ * fixed-width record per issue and a string table that every record refers to
+ * by index, so repeated paths, rules and tool names are stored once. All
+ * integers use the byte order of the writing machine; a file written with a
+ * different byte order is rejected by the version check.
+ *
+ * Files are memory-mapped where the platform supports it, and issues can be
+ * inspected straight from the mapping without building AnalysisIssue objects.
+ *
+ * Usage:
+ * ```cpp
+ * BinaryResultFile::write(results, "baseline.wipr");
+ *
+ * BinaryResultFile file("baseline.wipr");
+ * for (size_t i = 0; i < file.get_issue_count(); ++i) {
+ *     auto issue = file.get_issue(i);
+ *     std::cout << issue.file_path() << ":" << issue.line_number() << "\n";
+ * }
+ * auto loaded = file.read_all();
+ * ```
+ */
+class BinaryResultFile {
+public:
+    static constexpr char MAGIC[4] = {'W', 'I', 'P', 'R'};
+    static constexpr uint32_t FORMAT_VERSION = 1;
+    static constexpr uint32_t NO_STRING = UINT32_MAX;
+
+    /**
+     * @brief Zero-copy view of one issue record
+     */
+    class IssueView {
+    public:
+        std::string_view id() const;
+        std::string_view message() const;
+        std::string_view file_path() const;
+        int line_number() const;
+        int column_number() const;
+        IssueSeverity severity() const;
+        IssueCategory category() const;
+        std::string_view rule_id() const;
+        std::string_view tool_name() const;
+        bool has_fix_suggestion() const;
+        std::string_view fix_suggestion() const;
+
+        /**
+         * @brief Get the identity key of this issue (file, line, rule)
+         * @return Key viewing the file's string table
+         */
+        IssueKey key() const { return IssueKey{file_path(), line_number(), rule_id()}; }
+
+        /**
+         * @brief Materialize the issue as an AnalysisIssue
+         */
+        AnalysisIssue to_issue() const;
+
+    private:
+        friend class BinaryResultFile;
+        IssueView(const BinaryResultFile& file, const void* record) : file_(&file), record_(record) {}
+
+        const BinaryResultFile* file_;
+        const void* record_;
+    };
+
+    /**
+     * @brief Encode results in binary format
+     * @param results Results to encode
+     * @return File content, as written by write()
+     */
+    static std::string serialize(const std::vector<AnalysisResult>& results);
+
+    /**
+     * @brief Decode results encoded by serialize(), e.g. received over a network
+     * @param data Encoded results
+     * @return Every result with its issues
+     * @throws std::runtime_error if the data is malformed
+     */
+    static std::vector<AnalysisResult> deserialize(std::string_view data);
+
+    /**
+     * @brief Write results in binary format
+     * @param results Results to save
+     * @param file_path Output file path
+     * @throws std::runtime_error if the file cannot be written
+     */
+    static void write(const std::vector<AnalysisResult>& results, const std::string& file_path);
+
+    /**
+     * @brief Check whether a file starts with the binary format's magic bytes
+     * @param file_path File to inspect
+     * @return True if the file looks like a binary result file
+     */
+    static bool is_binary_file(const std::string& file_path);
+
+    /**
+     * @brief Open and validate a binary result file
+     * @param file_path File to open
+     * @param use_mmap Map the file instead of reading it into memory, where supported
+     * @throws std::runtime_error if the file cannot be read or is malformed
+     */
+    explicit BinaryResultFile(const std::string& file_path, bool use_mmap = true);
+    ~BinaryResultFile();
+
+    BinaryResultFile(const BinaryResultFile&) = delete;
+    BinaryResultFile& operator=(const BinaryResultFile&) = delete;
+
+    /**
+     * @brief Check whether the file contents are memory-mapped
+     */
+    bool is_memory_mapped() const { return mapping_ != nullptr; }
+
+    /**
+     * @brief Get number of stored results
+     */
+    size_t get_result_count() const { return result_count_; }
+
+    /**
+     * @brief Get number of issues over all results
+     */
+    size_t get_issue_count() const { return issue_count_; }
+
+    /**
+     * @brief Get an issue by its index over all results
+     * @param index Issue index (< get_issue_count())
+     */
+    IssueView get_issue(size_t index) const;
+
+    /**
+     * @brief Get the range of issues belonging to a result
+     * @param result_index Result index (< get_result_count())
+     * @return Pair of first issue index and issue count
+     */
+    std::pair<size_t, size_t> get_issue_range(size_t result_index) const;
+
+    /**
+     * @brief Materialize one result with its issues and statistics
+     * @param result_index Result index (< get_result_count())
+     */
+    AnalysisResult read_result(size_t result_index) const;
+
+    /**
+     * @brief Materialize every result
+     */
+    std::vector<AnalysisResult> read_all() const;
+
+private:
+    BinaryResultFile() = default;
+    void validate(const std::string& file_path);
+    std::string_view get_string(uint32_t index) const;
+
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    void* mapping_ = nullptr;          // Start of the mapping, if mapped
+    std::vector<char> buffer_;         // File contents, if not mapped
+
+    size_t result_count_ = 0;
+    size_t issue_count_ = 0;
+    size_t string_count_ = 0;
+    const char* results_ = nullptr;
+    const char* issues_ = nullptr;
+    const uint64_t* string_offsets_ = nullptr;
+    const char* string_data_ = nullptr;
+};
+
+/**
+ * @brief Reader for NDJSON issue files, as written by NdjsonIssueWriter
+ *
+ * Every line is one issue object with the members of AnalysisIssue::to_json().
+ * The file is memory-mapped and can be read in byte ranges that need not fall
+ * on line boundaries: a range owns every line that starts inside it, so any
+ * set of ranges that covers the file reads each issue exactly once. That lets
+ * independent workers share a file knowing nothing but its size.
+ *
+ * Usage:
+ * ```cpp
+ * NdjsonResultFile file("issues.ndjson");
+ * for (auto [begin, end] : file.split(workers)) {
+ *     pool.submit([&, begin, end]() {
+ *         file.read_range(begin, end, [](AnalysisIssue&& issue) { ingest(std::move(issue)); });
+ *     });
+ * }
+ * ```
+ */
+class NdjsonResultFile {
+public:
+    using IssueVisitor = std::function<void(AnalysisIssue&& issue)>;
+    using ByteRange = std::pair<size_t, size_t>;        ///< [begin, end) in bytes
+
+    /**
+     * @brief Check whether a file looks like NDJSON issues
+     *
+     * True if the file's first line is a complete JSON object; a pretty-printed
+     * JSON result file opens with a bracket or brace on a line of its own.
+     * @param file_path File to inspect
+     */
+    static bool is_ndjson_file(const std::string& file_path);
+
+    /**
+     * @brief Write results as NDJSON, one issue per line
+     * @throws std::runtime_error if the file cannot be written
+     */
+    static void write(const std::vector<AnalysisResult>& results, const std::string& file_path);
+
+    /**
+     * @brief Map an NDJSON file
+     * @throws std::runtime_error if the file cannot be read
+     */
+    explicit NdjsonResultFile(const std::string& file_path);
+
+    /**
+     * @brief Get the file size in bytes
+     */
+    size_t size() const { return file_.size(); }
+
+    /**
+     * @brief Split the file into byte ranges of about equal size
+     * @param parts Number of ranges (at least 1)
+     * @return Ranges covering the file, in order; may be fewer than parts for small files
+     */
+    std::vector<ByteRange> split(size_t parts) const;
+
+    /**
+     * @brief Parse the issues of every line that starts in [begin, end)
+     * @param begin First byte of the range
+     * @param end One past the last byte of the range (clamped to size())
+     * @param visitor Called with each issue, in file order
+     * @return Number of issues read
+     * @throws std::runtime_error on a line that is not a JSON object, naming its byte offset
+     */
+    size_t read_range(size_t begin, size_t end, const IssueVisitor& visitor) const;
+
+    /**
+     * @brief Parse every issue, splitting the file over several threads
+     * @param threads Number of threads; 0 uses the hardware concurrency
+     * @return Issues in file order
+     */
+    std::vector<AnalysisIssue> read_issues(size_t threads = 0) const;
+
+    /**
+     * @brief Parse every issue and group it into one successful result per tool
+     *
+     * NDJSON holds issues only, so tools without issues and tool failures are
+     * not recorded; results come in order of their first issue.
+     * @param threads Number of threads; 0 uses the hardware concurrency
+     */
+    std::vector<AnalysisResult> read_all(size_t threads = 0) const;
+
+private:
+    std::string path_;
+    wip::utils::file::MappedFile file_;
+};
+
+} // namespace analysis
+} // namespace wip
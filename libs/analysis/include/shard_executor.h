@@ -0,0 +1,38 @@
+#pragma once
+
+#include "analysis_tool.h"
+#include "analysis_types.h"
+#include <cstddef>
+
+namespace wip {
+namespace analysis {
+
+/**
+ * @brief Runs single shards of a tool outside the engine's own process
+ *
+ * The engine still plans, balances and merges; an executor only decides
+ * where one (tool, file shard) job runs. See AnalysisEngine::set_shard_executor()
+ * and AnalysisCoordinator.
+ */
+class ShardExecutor {
+public:
+    virtual ~ShardExecutor() = default;
+
+    /**
+     * @brief Run a tool on one shard, blocking until it is done
+     *
+     * Called from several scheduler workers at once. Failures, including
+     * cancellation through request.cancellation, are reported in the result.
+     * @param tool Local instance of the tool, for its name, version and configuration
+     * @param request Request naming the shard's files
+     */
+    virtual AnalysisResult execute_shard(const AnalysisTool& tool, const AnalysisRequest& request) = 0;
+
+    /**
+     * @brief Get number of shards that can run at once
+     */
+    virtual size_t get_slot_count() const = 0;
+};
+
+} // namespace analysis
+} // namespace wip
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "analysis_types.h"
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace wip {
+namespace analysis {
+
+/**
+ * @brief Splits a tool's translation units into shards of similar expected cost
+ *
+ * A unit's expected cost is what it cost the tool last time (tool CPU
+ * microseconds, as kept by AnalysisCache), or, for a unit without history,
+ * its file size scaled by the cost per byte of the units that have one. Units
+ * are placed longest processing time first: the most expensive unit goes to
+ * the cheapest shard, so a few template-heavy files end up in shards of their
+ * own instead of stretching the end of the run.
+ *
+ * Usage:
+ * ```cpp
+ * auto costs = ShardPlanner::estimate_costs(units, plan.unit_costs);
+ * for (auto& shard : ShardPlanner::plan(units, costs, shard_count)) {
+ *     submit(shard.units, shard.cost);
+ * }
+ * // After the shard ran
+ * auto measured = ShardPlanner::attribute_costs(shard.units, result.profile);
+ * ```
+ */
+class ShardPlanner {
+public:
+    struct Shard {
+        std::vector<std::string> units;     ///< In their original order
+        double cost = 0.0;                  ///< Sum of the units' expected costs
+    };
+
+    /**
+     * @brief Expected cost of every unit
+     * @param units Units to analyse
+     * @param known_costs Costs of the previous run by unit; may cover only some units
+     * @return Cost per unit, parallel to units; file sizes in bytes if no unit is known
+     */
+    static std::vector<double> estimate_costs(const std::vector<std::string>& units,
+                                              const std::map<std::string, double>& known_costs);
+
+    /**
+     * @brief Split units into shards with longest processing time first placement
+     * @param units Units to analyse
+     * @param costs Expected cost per unit, parallel to units
+     * @param shard_count Shards wanted; fewer are returned if there are fewer units
+     * @return Shards, most expensive first
+     */
+    static std::vector<Shard> plan(const std::vector<std::string>& units, const std::vector<double>& costs,
+                                   size_t shard_count);
+
+    /**
+     * @brief Measured cost of every unit of a finished shard
+     *
+     * Units the tool timed on their own (profile.unit_cpu_times) get their
+     * time; the rest share what remains of the shard's cost by file size.
+     * @param units Units of the shard
+     * @param profile Profile of the shard's result
+     * @param elapsed Wall time of the shard, used when the tool reports no CPU time
+     * @return Cost in microseconds by unit
+     */
+    static std::map<std::string, double> attribute_costs(const std::vector<std::string>& units,
+                                                         const ExecutionProfile& profile,
+                                                         std::chrono::nanoseconds elapsed);
+};
+
+} // namespace analysis
+} // namespace wip
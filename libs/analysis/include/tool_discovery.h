@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace wip {
+namespace analysis {
+
+/**
+ * @brief Outcome of looking for a tool executable
+ */
+struct ToolProbe {
+    std::string executable;         ///< Candidate that answered --version, empty if none did
+    std::string version_output;     ///< Standard output of `executable --version`
+
+    bool found() const { return !executable.empty(); }
+};
+
+/**
+ * @brief Process-wide, persistent cache of tool executables and their versions
+ *
+ * Finding a tool means trying a list of candidates and running the first one
+ * that exists with --version, which costs a subprocess per attempt. The outcome
+ * is remembered per tool together with the PATH it was found under, the
+ * modification time and size of the executable and the modification times of
+ * every directory that was searched. A later probe reuses the entry without
+ * starting any process as long as none of those changed, so installing,
+ * upgrading or removing a tool is still noticed.
+ *
+ * Usage:
+ * ```cpp
+ * auto probe = ToolDiscovery::get_shared().probe("cppcheck", {"cppcheck", "/opt/cppcheck/bin/cppcheck"});
+ * if (probe.found()) {
+ *     std::cout << probe.executable << ": " << probe.version_output;
+ * }
+ * ```
+ */
+class ToolDiscovery {
+public:
+    /**
+     * @brief Create a discovery cache
+     * @param cache_file File the cache is loaded from and saved to (empty = in memory only)
+     */
+    explicit ToolDiscovery(std::string cache_file = "");
+
+    /**
+     * @brief Get the instance shared by all tools, loaded from get_default_cache_file()
+     */
+    static ToolDiscovery& get_shared();
+
+    /**
+     * @brief Get the per-user cache file location
+     * @return $XDG_CACHE_HOME/wip/tool_discovery.json or ~/.cache/wip/tool_discovery.json,
+     *         empty if neither variable is set
+     */
+    static std::string get_default_cache_file();
+
+    /**
+     * @brief Load the cache file, replacing the current contents
+     * @return True if the file was read; a missing or unreadable file leaves the cache empty
+     */
+    bool load();
+
+    /**
+     * @brief Write the cache file
+     * @return True if the file was written (always false for an in-memory cache)
+     */
+    bool save() const;
+
+    /**
+     * @brief Find a tool, reusing the cached outcome while it is still valid
+     *
+     * Candidates are tried in order; a bare name is looked up in PATH and a
+     * candidate that does not exist is skipped without starting a process.
+     * The cache file is saved whenever a probe had to run the tool.
+     * @param tool_name Name the outcome is cached under
+     * @param candidates Command names or paths to try, in order of preference
+     * @return The first candidate that ran --version successfully, or an empty probe
+     */
+    ToolProbe probe(const std::string& tool_name, const std::vector<std::string>& candidates);
+
+    /**
+     * @brief Forget every cached outcome (the cache file is rewritten on the next probe)
+     */
+    void clear();
+
+    /**
+     * @brief Get number of processes started by probes so far
+     */
+    size_t get_launch_count() const;
+
+private:
+    struct FileStamp {
+        int64_t modified = 0;           // Modification time, in file clock ticks
+        uint64_t size = 0;
+        bool operator==(const FileStamp& other) const { return modified == other.modified && size == other.size; }
+    };
+
+    struct Entry {
+        std::string path_env;                               // PATH at the time of the probe
+        std::vector<std::string> candidates;
+        ToolProbe result;
+        std::string resolved_path;                          // Where result.executable was found
+        FileStamp executable_stamp;
+        std::vector<std::pair<std::string, FileStamp>> directories;  // Every directory searched
+    };
+
+    bool is_valid(const Entry& entry, const std::vector<std::string>& candidates) const;
+    Entry run_probe(const std::vector<std::string>& candidates);
+    bool save_locked() const;
+
+    std::string cache_file_;
+    std::map<std::string, Entry> entries_;
+    size_t launch_count_ = 0;
+    mutable std::mutex mutex_;
+};
+
+} // namespace analysis
+} // namespace wip
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "in_process_tool.h"
+#include "tool_config.h"
+
+namespace wip {
+namespace utils {
+namespace string {
+class LiteralMatcher;
+} // namespace string
+} // namespace utils
+
+namespace analysis {
+namespace tools {
+
+/**
+ * @brief A token whose every use is reported
+ */
+struct BannedToken {
+    std::string token;                                  ///< Literal text, such as "strcpy" or "std::auto_ptr"
+    std::string message;                                ///< Issue message (empty = "Use of banned token '<token>'")
+    IssueSeverity severity = IssueSeverity::Warning;
+    IssueCategory category = IssueCategory::Security;
+};
+
+/**
+ * @brief Configuration of the banned token scanner
+ */
+class BannedTokenConfig : public ToolConfig {
+public:
+    std::vector<BannedToken> tokens = get_default_tokens();
+    bool whole_words = true;    // Only report tokens not preceded or followed by identifier characters
+
+    BannedTokenConfig();
+
+    // ToolConfig interface
+    nlohmann::json to_json() const override;
+    void from_json(const nlohmann::json& j) override;
+    std::unique_ptr<ToolConfig> clone() const override;
+    std::string get_display_name() const override;
+    ValidationResult validate() const override;
+
+    /**
+     * @brief Get the C library functions without bounds checks, and other well known pitfalls
+     */
+    static std::vector<BannedToken> get_default_tokens();
+};
+
+/**
+ * @brief Reports uses of banned functions and types without starting a process
+ *
+ * All tokens are compiled into one Aho-Corasick automaton (see
+ * wip::utils::string::LiteralMatcher), so a file is scanned in a single pass
+ * however many tokens are banned, at close to memory bandwidth. The scan is
+ * lexical: tokens in comments and string literals are reported too.
+ *
+ * Issues use the rule id "banned-token:<token>".
+ */
+class BannedTokenTool : public InProcessTool {
+public:
+    BannedTokenTool();
+    ~BannedTokenTool() override;
+
+    // ==================== Tool Metadata ====================
+    std::string get_name() const override;
+    std::string get_version() const override;
+    std::string get_description() const override;
+    std::unique_ptr<ToolConfig> create_default_config() const override;
+    std::string get_help_text() const override;
+
+    // ==================== File Analysis ====================
+    void analyze_file(const std::string& path, std::string_view contents,
+                      std::vector<AnalysisIssue>& issues) const override;
+
+protected:
+    void on_configuration_changed() override;
+
+private:
+    struct Rule {
+        std::string rule_id;
+        std::string message;
+        IssueSeverity severity;
+        IssueCategory category;
+        size_t length;
+    };
+
+    std::vector<Rule> rules_;                                       // Indexed like the matcher's patterns
+    std::unique_ptr<wip::utils::string::LiteralMatcher> matcher_;
+    bool whole_words_ = true;
+};
+
+} // namespace tools
+} // namespace analysis
+} // namespace wip
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <optional>
+#include <string_view>
+
+namespace wip {
+namespace analysis {
+namespace tools {
+
+/**
+ * @brief Diagnostic header line from clang-tidy output
+ *
+ * All views point into the line that was parsed and are only valid while that
+ * line is alive.
+ */
+struct ClangTidyDiagnostic {
+    std::string_view file_path;     ///< Path of the file the diagnostic refers to
+    int line_number = 0;            ///< 1-based line number
+    int column_number = 0;          ///< 1-based column number
+    std::string_view severity;      ///< "warning", "error" or "note"
+    std::string_view message;       ///< Message without the trailing check list
+    std::string_view check_name;    ///< Contents of the trailing [...] group, empty if absent
+};
+
+/**
+ * @brief Parse a clang-tidy diagnostic line without allocating
+ *
+ * Recognises lines of the form
+ * `path/to/file.cpp:123:45: warning: message [check-name]`.
+ * Source excerpts, caret lines and summary lines are rejected. A trailing `\r`
+ * is ignored and Windows drive letters (`C:\...`) are accepted in the path.
+ * @param line One line of clang-tidy output, without the newline
+ * @return Parsed diagnostic, or std::nullopt if the line is not a diagnostic
+ */
+std::optional<ClangTidyDiagnostic> parse_clang_tidy_diagnostic(std::string_view line);
+
+} // namespace tools
+} // namespace analysis
+} // namespace wip
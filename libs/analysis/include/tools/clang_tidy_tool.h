@@ -2,7 +2,10 @@
 
 #include "analysis_tool.h"
 #include "tool_config.h"
+#include "tools/clang_tidy_diagnostic_parser.h"
 #include <atomic>
+#include <filesystem>
+#include <map>
 #include <process.h>
 
 namespace wip {
@@ -44,6 +47,11 @@ public:
     bool fix_errors = false;
     bool fix_notes = false;
     
+    // Performance
+    int job_count = 0;  // Concurrent clang-tidy processes (0 = hardware concurrency)
+    bool precompiled_headers = false;       // Precompile include prefixes shared by translation units
+    int precompiled_header_min_units = 3;   // Fewest units sharing a prefix to precompile it for
+    
     ClangTidyConfig();
     
     // ToolConfig interface
@@ -85,7 +93,7 @@ public:
     
     // ==================== Analysis Execution ====================
     AnalysisResult execute(const AnalysisRequest& request) override;
-    std::future<AnalysisResult> execute_async(
+    wip::utils::concurrency::Task<AnalysisResult> execute_async(
         const AnalysisRequest& request,
         std::function<void(const AnalysisProgress&)> progress_callback = nullptr,
         std::function<void(const std::string&)> output_callback = nullptr) override;
@@ -115,6 +123,22 @@ public:
      */
     bool has_compilation_database(const std::string& build_dir) const;
     
+    /**
+     * @brief List the translation units clang-tidy should analyze for a request
+     * 
+     * Uses compile_commands.json when one is found for the source path, otherwise
+     * falls back to AnalysisTool::get_translation_units().
+     * @param request Analysis request
+     * @return Sorted, de-duplicated list of source file paths
+     */
+    std::vector<std::string> get_translation_units(const AnalysisRequest& request) const override;
+    
+    /**
+     * @brief Get the number of clang-tidy processes run concurrently
+     * @return Configured job count, or hardware concurrency when unset
+     */
+    size_t get_effective_job_count() const;
+    
 private:
     std::unique_ptr<ClangTidyConfig> config_;
     std::atomic<bool> analysis_running_{false};
@@ -126,8 +150,8 @@ private:
     std::string find_clang_tidy_executable() const;
     std::string get_clang_tidy_version() const;
     AnalysisResult parse_clang_tidy_output(const std::string& output) const;
-    AnalysisIssue parse_diagnostic_line(const std::string& line) const;
-    IssueSeverity map_clang_tidy_severity(const std::string& severity) const;
+    AnalysisIssue make_issue(const ClangTidyDiagnostic& diagnostic) const;
+    IssueSeverity map_clang_tidy_severity(std::string_view severity) const;
     IssueCategory map_clang_tidy_category(const std::string& check_name) const;
     void validate_clang_tidy_config(const ClangTidyConfig& config, ValidationResult& result) const;
     
@@ -135,9 +159,29 @@ private:
     void track_progress_from_output(const std::string& line,
                                    std::function<void(const AnalysisProgress&)> callback,
                                    AnalysisProgress& progress) const;
-                                   
-    // Find build directory with compile_commands.json
-    std::string find_build_directory(const std::string& source_path) const;
+
+
+    // Sharded execution: one clang-tidy process per translation unit
+    struct ShardedRunResult {
+        int exit_code = 0;                 // Highest exit code of all shards
+        std::vector<AnalysisIssue> issues; // Deduplicated diagnostics in TU order
+        std::string diagnostic_output;     // Diagnostic lines behind issues, one per line
+        std::string stderr_output;         // Shard stderr, concatenated in TU order
+        size_t files_analyzed = 0;         // Number of translation units processed
+        bool cancelled = false;            // Whether any shard was cancelled
+        ExecutionProfile profile;          // Summed over all shards
+    };
+    
+    std::vector<std::string> build_base_command_line(const AnalysisRequest& request) const;
+    std::string find_clang_compiler() const;
+    std::map<std::string, std::string> build_precompiled_headers(
+        const AnalysisRequest& request, const std::vector<std::string>& units,
+        const std::string& working_directory, size_t job_count,
+        const wip::utils::process::CancellationToken& token,
+        const std::filesystem::path& directory, ExecutionProfile& profile) const;
+    ShardedRunResult run_sharded(const AnalysisRequest& request,
+                                 std::function<void(const AnalysisProgress&)> progress_callback,
+                                 std::function<void(const std::string&)> output_callback) const;
 };
 
 } // namespace tools
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace wip {
+namespace analysis {
+namespace tools {
+
+/**
+ * @brief Keeps cppcheck's per-unit analysis (--cppcheck-build-dir) between runs
+ *
+ * Cppcheck skips a unit whose analyzer file in the build directory still
+ * matches the unit's tokens and the tool's settings. It names those files
+ * after the unit's base name, numbered within one invocation, and rewrites
+ * files.txt on every start, so concurrent shards cannot share a build
+ * directory. Each run therefore gets a private one, seeded from a store kept
+ * by full unit path under <root>/<config hash>; what cppcheck rewrote is moved
+ * back into the store when the run is committed.
+ *
+ * Stores of other configuration hashes under the root are removed when a run
+ * is opened, so changing the configuration drops the old analysis.
+ *
+ * Usage:
+ * ```cpp
+ * CppcheckBuildDirectory build_directory(root, config_hash, units);
+ * args.push_back("--cppcheck-build-dir=" + build_directory.get_path());
+ * // run cppcheck
+ * auto stats = build_directory.commit();
+ * ```
+ */
+class CppcheckBuildDirectory {
+public:
+    /**
+     * @brief Lookups of one run
+     */
+    struct Stats {
+        size_t lookups = 0;     ///< Units cppcheck analyzed or skipped
+        size_t hits = 0;        ///< Units skipped on their stored analysis
+    };
+
+    /**
+     * @brief Create a private build directory seeded with the stored analysis of the units
+     * @param root Directory holding one store per configuration hash
+     * @param config_hash Hash of the configuration the run uses
+     * @param units Units cppcheck is given, relative to the current directory or absolute
+     * @throws std::filesystem::filesystem_error if the directories cannot be created
+     */
+    CppcheckBuildDirectory(const std::filesystem::path& root, const std::string& config_hash,
+                           const std::vector<std::string>& units);
+
+    /**
+     * @brief Remove the private build directory
+     */
+    ~CppcheckBuildDirectory();
+
+    CppcheckBuildDirectory(const CppcheckBuildDirectory&) = delete;
+    CppcheckBuildDirectory& operator=(const CppcheckBuildDirectory&) = delete;
+
+    /**
+     * @brief Get the directory to pass as --cppcheck-build-dir
+     */
+    std::string get_path() const;
+
+    /**
+     * @brief Move the analysis cppcheck wrote into the store
+     *
+     * Call only after cppcheck finished successfully; a failed run is dropped
+     * with the private directory.
+     * @param working_directory Directory cppcheck ran in, for relative paths in files.txt
+     * @return Lookups read from the run's files.txt
+     */
+    Stats commit(const std::filesystem::path& working_directory = std::filesystem::current_path());
+
+private:
+    struct Seed {
+        std::filesystem::path stored;
+        std::filesystem::file_time_type write_time;
+    };
+
+    std::filesystem::path store_;
+    std::filesystem::path path_;
+    std::map<std::string, Seed> seeds_;     ///< By analyzer file name in the private directory
+
+    std::filesystem::path get_stored_path(const std::filesystem::path& unit) const;
+};
+
+} // namespace tools
+} // namespace analysis
+} // namespace wip
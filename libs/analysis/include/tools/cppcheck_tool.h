@@ -2,6 +2,9 @@
 
 #include "analysis_tool.h"
 #include "tool_config.h"
+#include "changed_lines.h"
+#include "tools/cppcheck_build_directory.h"
+#include "tools/cppcheck_xml_parser.h"
 #include <atomic>
 #include <process.h>
 
@@ -51,6 +54,8 @@ public:
     // Performance
     int job_count = 4;
     bool quiet = true;
+    bool use_compilation_database = true;   // Analyze through compile_commands.json (--project) when one is found
+    std::string cache_directory;            // Keeps per-unit analysis between runs (--cppcheck-build-dir); empty = off
     
     // Suppressions
     bool suppress_unused_function = true;
@@ -103,7 +108,7 @@ public:
     
     // ==================== Analysis Execution ====================
     AnalysisResult execute(const AnalysisRequest& request) override;
-    std::future<AnalysisResult> execute_async(
+    wip::utils::concurrency::Task<AnalysisResult> execute_async(
         const AnalysisRequest& request,
         std::function<void(const AnalysisProgress&)> progress_callback = nullptr,
         std::function<void(const std::string&)> output_callback = nullptr) override;
@@ -118,6 +123,32 @@ public:
     std::vector<std::string> build_command_line(const AnalysisRequest& request) const override;
     std::string get_help_text() const override;
     
+    /**
+     * @brief List the translation units cppcheck should analyze for a request
+     * 
+     * Uses compile_commands.json when the configuration allows it and one is
+     * found for the source path, otherwise falls back to
+     * AnalysisTool::get_translation_units().
+     * @param request Analysis request
+     * @return Sorted, de-duplicated list of source file paths
+     */
+    std::vector<std::string> get_translation_units(const AnalysisRequest& request) const override;
+    
+    // ==================== Cppcheck Specific ====================
+    
+    /**
+     * @brief Parse an XML report incrementally, reporting issues one by one
+     * 
+     * The report is read in fixed-size chunks, so memory use does not grow with
+     * the size of the report.
+     * @param output_file Path to the cppcheck XML report
+     * @param issue_callback Called for every issue as soon as it is parsed
+     * @return Number of issues reported
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    size_t stream_results_file(const std::string& output_file,
+                               const std::function<void(const AnalysisIssue&)>& issue_callback) const;
+    
 private:
     std::unique_ptr<CppcheckConfig> config_;
     std::atomic<bool> analysis_running_{false};
@@ -127,10 +158,12 @@ private:
     // Helper methods
     std::string find_cppcheck_executable() const;
     std::string get_cppcheck_version() const;
-    AnalysisResult parse_xml_output(const std::string& xml_file) const;
-    AnalysisIssue parse_xml_error_element(const nlohmann::json& error_json) const;
+    AnalysisResult parse_results_file(const std::string& output_file, const ChangedLines& scope) const;
+    AnalysisResult parse_xml_output(const std::string& xml_file, const ChangedLines& scope) const;
+    AnalysisIssue convert_xml_error(const CppcheckXmlError& error) const;
     IssueSeverity map_cppcheck_severity(const std::string& severity) const;
     IssueCategory map_cppcheck_category(const std::string& severity, const std::string& rule_id) const;
+    std::unique_ptr<CppcheckBuildDirectory> open_build_directory(const AnalysisRequest& request) const;
     void validate_cppcheck_config(const CppcheckConfig& config, ValidationResult& result) const;
     
     // Progress tracking
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <functional>
+#include <istream>
+#include <string>
+#include <string_view>
+
+namespace wip {
+namespace analysis {
+namespace tools {
+
+/**
+ * @brief Raw <error> record from a cppcheck XML report
+ *
+ * Attribute values are entity-decoded. The file, line and column come from the
+ * first <location> child (XML version 2) or from the <error> element itself
+ * (XML version 1).
+ */
+struct CppcheckXmlError {
+    std::string id;                 ///< Cppcheck check identifier (e.g. "nullPointer")
+    std::string severity;           ///< Cppcheck severity string (e.g. "error", "style")
+    std::string message;            ///< Short message ("msg" attribute)
+    std::string verbose_message;    ///< Long message ("verbose" attribute)
+    std::string cwe;                ///< CWE identifier, empty if not reported
+    std::string file_path;          ///< File of the primary location
+    int line_number = 0;            ///< Line of the primary location (0 = unknown)
+    int column_number = 0;          ///< Column of the primary location (0 = unknown)
+};
+
+/**
+ * @brief Incremental (SAX-style) parser for cppcheck XML reports
+ *
+ * The report is fed in chunks of any size and every <error> element is passed
+ * to the callback as soon as it is closed. Only the tag currently being read is
+ * buffered, so memory use depends on the largest tag rather than on the size of
+ * the report.
+ *
+ * Usage:
+ * ```cpp
+ * CppcheckXmlParser parser([](const CppcheckXmlError& error) { ... });
+ * parser.feed(chunk1);
+ * parser.feed(chunk2);
+ * parser.finish();
+ * ```
+ */
+class CppcheckXmlParser {
+public:
+    using ErrorCallback = std::function<void(const CppcheckXmlError& error)>;
+
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+    /**
+     * @brief Create a parser
+     * @param callback Called once for every parsed <error> element
+     */
+    explicit CppcheckXmlParser(ErrorCallback callback);
+
+    /**
+     * @brief Feed the next piece of the report
+     * @param data Report bytes; tags may be split across calls
+     */
+    void feed(std::string_view data);
+
+    /**
+     * @brief Signal the end of input
+     *
+     * An <error> element left open by a truncated report is still reported;
+     * a partially read tag is discarded.
+     */
+    void finish();
+
+    /**
+     * @brief Get number of <error> elements reported so far
+     */
+    size_t get_error_count() const { return error_count_; }
+
+    /**
+     * @brief Parse a whole stream in fixed-size chunks
+     * @param input Stream to read
+     * @param callback Called for every <error> element
+     * @param chunk_size Number of bytes read per chunk
+     * @return Number of <error> elements found
+     */
+    static size_t parse_stream(std::istream& input, ErrorCallback callback,
+                               size_t chunk_size = DEFAULT_CHUNK_SIZE);
+
+    /**
+     * @brief Parse a report file in fixed-size chunks
+     * @param file_path Path to the cppcheck XML report
+     * @param callback Called for every <error> element
+     * @param chunk_size Number of bytes read per chunk
+     * @return Number of <error> elements found
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    static size_t parse_file(const std::string& file_path, ErrorCallback callback,
+                             size_t chunk_size = DEFAULT_CHUNK_SIZE);
+
+    /**
+     * @brief Decode XML character and entity references
+     * @param text Raw attribute text
+     * @return Decoded text (unknown entities are kept as-is)
+     */
+    static std::string decode_entities(std::string_view text);
+
+private:
+    enum class State {
+        Text,       // Between tags
+        Tag,        // Inside <...>
+        Comment,    // Inside <!-- ... -->
+        CData       // Inside <![CDATA[ ... ]]>
+    };
+
+    void handle_tag(std::string_view tag);
+    void begin_error(std::string_view attributes);
+    void apply_location(std::string_view attributes);
+    void end_error();
+
+    ErrorCallback callback_;
+    State state_ = State::Text;
+    char quote_ = 0;                // Active quote character inside a tag, 0 if none
+    std::string tag_buffer_;        // Body of the tag (or comment) being read
+
+    bool in_error_ = false;
+    bool has_location_ = false;
+    CppcheckXmlError current_error_;
+    size_t error_count_ = 0;
+};
+
+} // namespace tools
+} // namespace analysis
+} // namespace wip
@@ -0,0 +1,339 @@
+#include "analysis_cache.h"
+#include "include_graph.h"
+#include <hash.h>
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <unordered_map>
+
+namespace wip {
+namespace analysis {
+
+namespace {
+
+constexpr int CACHE_FORMAT_VERSION = 2;   // 2: 128-bit content hashes
+
+AnalysisCache::UnitState compute_state(const IncludeGraph& graph, const std::string& unit) {
+    AnalysisCache::UnitState state;
+    state.content_hash = graph.get_content_hash(unit);
+    state.closure = graph.get_closure(unit);
+
+    std::string combined;
+    for (const auto& path : state.closure) {
+        combined += path;
+        combined += '\0';
+        combined += graph.get_content_hash(path);
+        combined += '\n';
+    }
+    state.closure_hash = AnalysisCache::hash_content(combined);
+
+    return state;
+}
+
+} // namespace
+
+AnalysisCache::AnalysisCache(std::string cache_file)
+    : cache_file_(std::move(cache_file)) {
+}
+
+bool AnalysisCache::load() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tools_.clear();
+
+    if (cache_file_.empty()) {
+        return false;
+    }
+
+    std::ifstream file(cache_file_);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    try {
+        nlohmann::json j;
+        file >> j;
+
+        // Entries written by another format version are discarded
+        if (j.value("version", 0) != CACHE_FORMAT_VERSION || !j.contains("tools") || !j["tools"].is_object()) {
+            return false;
+        }
+
+        for (const auto& tool_item : j["tools"].items()) {
+            const auto& tool_json = tool_item.value();
+            ToolEntry tool_entry;
+            tool_entry.tool_version = tool_json.value("tool_version", "");
+            tool_entry.config_hash = tool_json.value("config_hash", "");
+
+            if (tool_json.contains("units") && tool_json["units"].is_object()) {
+                for (const auto& unit_item : tool_json["units"].items()) {
+                    const auto& unit_json = unit_item.value();
+                    UnitEntry unit_entry;
+                    unit_entry.content_hash = unit_json.value("content_hash", "");
+                    unit_entry.closure_hash = unit_json.value("closure_hash", "");
+                    unit_entry.cost = unit_json.value("cost_us", 0.0);
+                    if (unit_json.contains("issues") && unit_json["issues"].is_array()) {
+                        unit_entry.issues.reserve(unit_json["issues"].size());
+                        for (const auto& issue_json : unit_json["issues"]) {
+                            unit_entry.issues.push_back(AnalysisIssue::from_json(issue_json));
+                        }
+                    }
+                    tool_entry.units.emplace(unit_item.key(), std::move(unit_entry));
+                }
+            }
+
+            tools_.emplace(tool_item.key(), std::move(tool_entry));
+        }
+    } catch (const std::exception&) {
+        // A corrupt cache only costs a full run
+        tools_.clear();
+        return false;
+    }
+
+    return true;
+}
+
+bool AnalysisCache::save() const {
+    if (cache_file_.empty()) {
+        return false;
+    }
+
+    nlohmann::json j;
+    j["version"] = CACHE_FORMAT_VERSION;
+    j["tools"] = nlohmann::json::object();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [tool_name, tool_entry] : tools_) {
+            nlohmann::json tool_json;
+            tool_json["tool_version"] = tool_entry.tool_version;
+            tool_json["config_hash"] = tool_entry.config_hash;
+            tool_json["units"] = nlohmann::json::object();
+
+            for (const auto& [unit, unit_entry] : tool_entry.units) {
+                nlohmann::json unit_json;
+                unit_json["content_hash"] = unit_entry.content_hash;
+                unit_json["closure_hash"] = unit_entry.closure_hash;
+                if (unit_entry.cost > 0.0) {
+                    unit_json["cost_us"] = unit_entry.cost;
+                }
+                unit_json["issues"] = nlohmann::json::array();
+                for (const auto& issue : unit_entry.issues) {
+                    unit_json["issues"].push_back(issue.to_json());
+                }
+                tool_json["units"][unit] = std::move(unit_json);
+            }
+
+            j["tools"][tool_name] = std::move(tool_json);
+        }
+    }
+
+    // Write to a temporary file first so an interrupted save never leaves a truncated cache
+    std::error_code ec;
+    std::filesystem::path path(cache_file_);
+    if (path.has_parent_path()) {
+        std::filesystem::create_directories(path.parent_path(), ec);
+    }
+
+    std::string temp_file = cache_file_ + ".tmp";
+    {
+        std::ofstream file(temp_file);
+        if (!file.is_open()) {
+            return false;
+        }
+        file << j.dump();
+        if (!file) {
+            return false;
+        }
+    }
+
+    std::filesystem::rename(temp_file, path, ec);
+    return !ec;
+}
+
+AnalysisCache::Plan AnalysisCache::plan(const std::string& tool_name, const std::string& tool_version,
+                                        const std::string& config_hash, const std::vector<std::string>& units,
+                                        const AnalysisRequest& request) const {
+    Plan plan;
+
+    std::shared_ptr<IncludeGraph> graph = get_include_graph();
+    if (!graph || !graph->matches(request)) {
+        graph = std::make_shared<IncludeGraph>(request);
+    }
+    plan.base_directory = graph->get_base_directory();
+
+    plan.units.reserve(units.size());
+    for (const auto& unit : units) {
+        plan.units.push_back(IncludeGraph::normalize_path(unit, plan.base_directory));
+    }
+
+    // Reads only the files that are new or changed since the graph last saw them
+    graph->scan(plan.units);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto tool_it = tools_.find(tool_name);
+    const ToolEntry* tool_entry = nullptr;
+    if (tool_it != tools_.end() && tool_it->second.tool_version == tool_version &&
+        tool_it->second.config_hash == config_hash) {
+        tool_entry = &tool_it->second;
+    }
+
+    // A changed unit usually costs about as much as it did last time, even after
+    // a tool or configuration change
+    const ToolEntry* previous_entry = tool_it != tools_.end() ? &tool_it->second : nullptr;
+
+    for (const auto& unit : plan.units) {
+        UnitState state = compute_state(*graph, unit);
+
+        if (previous_entry) {
+            auto unit_it = previous_entry->units.find(unit);
+            if (unit_it != previous_entry->units.end() && unit_it->second.cost > 0.0) {
+                plan.unit_costs.emplace(unit, unit_it->second.cost);
+            }
+            if (unit_it != previous_entry->units.end() && !unit_it->second.issues.empty()) {
+                auto worst = std::max_element(unit_it->second.issues.begin(), unit_it->second.issues.end(),
+                    [](const AnalysisIssue& a, const AnalysisIssue& b) { return a.severity < b.severity; });
+                plan.unit_severities.emplace(unit, worst->severity);
+            }
+        }
+
+        const UnitEntry* cached = nullptr;
+        if (tool_entry && !state.content_hash.empty()) {
+            auto unit_it = tool_entry->units.find(unit);
+            if (unit_it != tool_entry->units.end() && unit_it->second.content_hash == state.content_hash &&
+                unit_it->second.closure_hash == state.closure_hash) {
+                cached = &unit_it->second;
+            }
+        }
+
+        if (cached) {
+            plan.cached_issues.insert(plan.cached_issues.end(), cached->issues.begin(), cached->issues.end());
+            ++plan.cached_unit_count;
+        } else {
+            plan.changed_units.push_back(unit);
+        }
+
+        plan.states.emplace(unit, std::move(state));
+    }
+
+    return plan;
+}
+
+void AnalysisCache::update(const std::string& tool_name, const std::string& tool_version,
+                           const std::string& config_hash, const Plan& plan,
+                           const std::vector<AnalysisIssue>& issues) {
+    // Group the new issues by the changed unit they belong to
+    std::unordered_map<std::string, std::vector<std::string>> units_by_header;
+    for (const auto& unit : plan.changed_units) {
+        auto state_it = plan.states.find(unit);
+        if (state_it == plan.states.end()) {
+            continue;
+        }
+        for (const auto& header : state_it->second.closure) {
+            units_by_header[header].push_back(unit);
+        }
+    }
+
+    std::set<std::string> changed(plan.changed_units.begin(), plan.changed_units.end());
+    std::map<std::string, std::vector<AnalysisIssue>> issues_by_unit;
+    std::unordered_map<std::string, std::string> normalized_paths;
+
+    for (const auto& issue : issues) {
+        auto path_it = normalized_paths.find(issue.file_path);
+        if (path_it == normalized_paths.end()) {
+            std::string normalized = issue.file_path.empty() ? std::string()
+                : IncludeGraph::normalize_path(issue.file_path, plan.base_directory);
+            path_it = normalized_paths.emplace(issue.file_path, std::move(normalized)).first;
+        }
+        const std::string& file = path_it->second;
+
+        if (changed.count(file)) {
+            issues_by_unit[file].push_back(issue);
+            continue;
+        }
+
+        // Header issues are kept with every unit that reaches the header; issues that
+        // cannot be attributed are kept with all changed units so they are not lost
+        auto header_it = units_by_header.find(file);
+        const auto& owners = header_it != units_by_header.end() ? header_it->second : plan.changed_units;
+        for (const auto& unit : owners) {
+            issues_by_unit[unit].push_back(issue);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    ToolEntry& tool_entry = tools_[tool_name];
+    if (tool_entry.tool_version != tool_version || tool_entry.config_hash != config_hash) {
+        tool_entry = ToolEntry{};
+        tool_entry.tool_version = tool_version;
+        tool_entry.config_hash = config_hash;
+    }
+
+    // Drop units that are no longer part of the project
+    std::set<std::string> current(plan.units.begin(), plan.units.end());
+    for (auto it = tool_entry.units.begin(); it != tool_entry.units.end();) {
+        it = current.count(it->first) ? std::next(it) : tool_entry.units.erase(it);
+    }
+
+    for (const auto& unit : plan.changed_units) {
+        auto state_it = plan.states.find(unit);
+        if (state_it == plan.states.end() || state_it->second.content_hash.empty()) {
+            continue;  // Unreadable units are never cached
+        }
+
+        UnitEntry& entry = tool_entry.units[unit];
+        entry.content_hash = state_it->second.content_hash;
+        entry.closure_hash = state_it->second.closure_hash;
+        entry.issues = std::move(issues_by_unit[unit]);
+
+        auto cost_it = plan.unit_costs.find(unit);
+        entry.cost = cost_it != plan.unit_costs.end() ? cost_it->second : 0.0;
+    }
+}
+
+void AnalysisCache::set_include_graph(std::shared_ptr<IncludeGraph> graph) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    include_graph_ = std::move(graph);
+}
+
+std::shared_ptr<IncludeGraph> AnalysisCache::get_include_graph() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return include_graph_;
+}
+
+void AnalysisCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tools_.clear();
+}
+
+size_t AnalysisCache::get_entry_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t count = 0;
+    for (const auto& [tool_name, tool_entry] : tools_) {
+        count += tool_entry.units.size();
+    }
+    return count;
+}
+
+std::string AnalysisCache::hash_content(std::string_view data) {
+    return wip::utils::hash::hash128(data).to_hex();
+}
+
+std::string AnalysisCache::compute_config_hash(const ToolConfig* config, const AnalysisRequest& request) {
+    nlohmann::json j;
+    if (config) {
+        j["config"] = config->to_json();
+        j["config"].erase("source_path");
+        j["config"].erase("output_file");
+    }
+    j["include_paths"] = request.include_paths;
+    j["definitions"] = request.definitions;
+    j["tool_specific_options"] = request.tool_specific_options;
+
+    return hash_content(j.dump());
+}
+
+} // namespace analysis
+} // namespace wip
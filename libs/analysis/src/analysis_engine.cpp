@@ -1,16 +1,110 @@
 #include "analysis_engine.h"
+#include "changed_lines.h"
+#include "include_graph.h"
+#include "report_writer.h"
+#include "parse_arena.h"
+#include "shard_planner.h"
 #include "tools/cppcheck_tool.h"
 #include "tools/clang_tidy_tool.h"
+#include "tools/banned_token_tool.h"
+#include <time_utilities.h>
 #include <fstream>
 #include <algorithm>
 #include <future>
-#include <set>
+#include <unordered_set>
 #include <filesystem>
-#include <iostream>
+#include <log.h>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <cstdlib>
 
 namespace wip {
 namespace analysis {
 
+namespace {
+
+// Maps strings to dense IDs without copying them; the strings must outlive the interner
+class StringInterner {
+public:
+    uint32_t intern(std::string_view value) {
+        auto it = ids_.try_emplace(value, static_cast<uint32_t>(ids_.size())).first;
+        return it->second;
+    }
+    
+private:
+    std::unordered_map<std::string_view, uint32_t> ids_;
+};
+
+// Compact sort key of one issue taking part in a comparison
+struct ComparisonEntry {
+    enum Status : uint8_t { Unmatched, Persistent, Moved };
+    
+    uint32_t file;
+    uint32_t rule;
+    uint32_t message;
+    int line;
+    size_t order;                 // Position in the run, for stable output
+    const AnalysisIssue* issue;
+    Status status = Unmatched;
+};
+
+std::vector<ComparisonEntry> make_comparison_entries(const std::vector<AnalysisResult>& results, StringInterner& strings) {
+    size_t total = 0;
+    for (const auto& result : results) {
+        total += result.issues.size();
+    }
+    
+    std::vector<ComparisonEntry> entries;
+    entries.reserve(total);
+    for (const auto& result : results) {
+        for (const auto& issue : result.issues) {
+            entries.push_back(ComparisonEntry{strings.intern(issue.file_path), strings.intern(issue.rule_id),
+                                              strings.intern(issue.message), issue.line_number, entries.size(), &issue});
+        }
+    }
+    return entries;
+}
+
+// Sorts chunks on a job scheduler, then merges neighbouring chunks pairwise
+template <typename T, typename Compare>
+void parallel_sort(std::vector<T>& items, Compare compare, size_t thread_count) {
+    static constexpr size_t MIN_CHUNK_SIZE = 16384;
+    
+    size_t chunk_count = std::min(thread_count, items.size() / MIN_CHUNK_SIZE);
+    if (chunk_count < 2) {
+        std::sort(items.begin(), items.end(), compare);
+        return;
+    }
+    
+    std::vector<size_t> bounds(chunk_count + 1);
+    for (size_t i = 0; i <= chunk_count; ++i) {
+        bounds[i] = items.size() * i / chunk_count;
+    }
+    
+    JobScheduler scheduler(chunk_count);
+    auto begin = items.begin();
+    for (size_t i = 0; i < chunk_count; ++i) {
+        scheduler.submit([&, i]() { std::sort(begin + bounds[i], begin + bounds[i + 1], compare); });
+    }
+    scheduler.wait();
+    
+    for (size_t width = 1; width < chunk_count; width *= 2) {
+        for (size_t i = 0; i + width < chunk_count; i += 2 * width) {
+            size_t last = std::min(i + 2 * width, chunk_count);
+            scheduler.submit([&, i, width, last]() {
+                std::inplace_merge(begin + bounds[i], begin + bounds[i + width], begin + bounds[last], compare);
+            });
+        }
+        scheduler.wait();
+    }
+}
+
+} // namespace
+
 // ==================== AnalysisEngine Implementation ====================
 
 AnalysisEngine::AnalysisEngine() = default;
@@ -119,10 +213,10 @@ AnalysisResult AnalysisEngine::analyze_single(const std::string& tool_name, cons
     }
     
     analysis_running_ = true;
-    cancel_requested_ = false;
+    AnalysisRequest cancellable_request = make_cancellable_request(request);
     
     try {
-        auto result = tool->execute(request);
+        auto result = execute_tool(*tool, cancellable_request);
         analysis_running_ = false;
         return result;
     } catch (...) {
@@ -133,57 +227,54 @@ AnalysisResult AnalysisEngine::analyze_single(const std::string& tool_name, cons
 
 std::vector<AnalysisResult> AnalysisEngine::analyze_multiple(const std::vector<std::string>& tool_names, 
                                                            const AnalysisRequest& request) {
-    std::cout << "[ANALYSIS_ENGINE] analyze_multiple called with " << tool_names.size() << " tools\n";
+    LOG_DEBUG("ANALYSIS_ENGINE", "analyze_multiple called with ", tool_names.size(), " tools");
     validate_tool_names(tool_names);
     
     std::vector<AnalysisResult> results;
     results.reserve(tool_names.size());
     
     analysis_running_ = true;
-    cancel_requested_ = false;
+    AnalysisRequest cancellable_request = make_cancellable_request(request);
     
     try {
         for (const auto& tool_name : tool_names) {
-            std::cout << "[ANALYSIS_ENGINE] Processing tool: " << tool_name << "\n";
+            LOG_DEBUG("ANALYSIS_ENGINE", "Processing tool: ", tool_name);
             if (cancel_requested_) {
-                std::cout << "[ANALYSIS_ENGINE] Cancel requested, breaking\n";
+                LOG_DEBUG("ANALYSIS_ENGINE", "Cancel requested, breaking");
                 break;
             }
             
             auto tool = get_tool(tool_name);
             if (tool && tool->is_available()) {
-                std::cout << "[ANALYSIS_ENGINE] Tool " << tool_name << " is available, executing...\n";
-                // Create a tool-specific request with appropriate output file
-                AnalysisRequest tool_request = request;
-                if (!tool_request.output_file.empty()) {
-                    std::filesystem::path output_path(tool_request.output_file);
-                    std::string base_name = output_path.stem().string();
-                    std::string extension = output_path.extension().string();
-                    tool_request.output_file = base_name + "_" + tool_name + extension;
-                }
+                LOG_DEBUG("ANALYSIS_ENGINE", "Tool ", tool_name, " is available, executing...");
+                AnalysisRequest tool_request = make_tool_request(cancellable_request, tool_name);
                 
-                std::cout << "[ANALYSIS_ENGINE] About to execute tool " << tool_name << " with source: " << tool_request.source_path << "\n";
+                LOG_DEBUG("ANALYSIS_ENGINE", "About to execute tool ", tool_name, " with source: ", tool_request.source_path);
                 try {
-                    auto result = tool->execute(tool_request);
-                    std::cout << "[ANALYSIS_ENGINE] Tool " << tool_name << " execution completed, success: " << result.success << "\n";
+                    auto result = execute_tool(*tool, tool_request);
+                    LOG_DEBUG("ANALYSIS_ENGINE", "Tool ", tool_name, " execution completed, success: ", result.success);
+                    
+                    // Tools run one after the other here, so failing fast skips the remaining ones
+                    const auto& stop_on_severity = request.stop_on_severity;
+                    bool stop = stop_on_severity &&
+                        std::any_of(result.issues.begin(), result.issues.end(),
+                                    [&](const AnalysisIssue& issue) { return issue.severity >= *stop_on_severity; });
                     results.push_back(std::move(result));
+                    if (stop) {
+                        LOG_INFO("ANALYSIS_ENGINE", "Tool ", tool_name, " reported a ",
+                            severity_to_string(*stop_on_severity), " issue; stopping the analysis");
+                        break;
+                    }
                 } catch (const std::exception& e) {
-                    std::cout << "[ANALYSIS_ENGINE] Tool " << tool_name << " execution failed: " << e.what() << "\n";
-                    // Create error result for failed tool
-                    AnalysisResult error_result;
-                    error_result.tool_name = tool_name;
-                    error_result.analysis_id = generate_analysis_id();
-                    error_result.timestamp = std::chrono::system_clock::now();
-                    error_result.success = false;
-                    error_result.error_message = std::string("Tool execution failed: ") + e.what();
-                    results.push_back(std::move(error_result));
+                    LOG_ERROR("ANALYSIS_ENGINE", "Tool ", tool_name, " execution failed: ", e.what());
+                    results.push_back(make_error_result(tool_name, std::string("Tool execution failed: ") + e.what()));
                 }
             } else {
-                std::cout << "[ANALYSIS_ENGINE] Tool " << tool_name << " is not available\n";
+                LOG_WARNING("ANALYSIS_ENGINE", "Tool ", tool_name, " is not available");
             }
         }
         
-        std::cout << "[ANALYSIS_ENGINE] All tools processed, returning " << results.size() << " results\n";
+        LOG_DEBUG("ANALYSIS_ENGINE", "All tools processed, returning ", results.size(), " results");
         analysis_running_ = false;
         return results;
     } catch (...) {
@@ -192,118 +283,29 @@ std::vector<AnalysisResult> AnalysisEngine::analyze_multiple(const std::vector<s
     }
 }
 
-std::future<std::vector<AnalysisResult>> AnalysisEngine::analyze_async(
+wip::utils::concurrency::Task<std::vector<AnalysisResult>> AnalysisEngine::analyze_async(
     const std::vector<std::string>& tool_names,
     const AnalysisRequest& request,
     ProgressCallback progress_callback,
     OutputCallback output_callback,
-    CompletionCallback completion_callback) {
+    CompletionCallback completion_callback,
+    IssueCallback issue_callback) {
     
-    return std::async(std::launch::async, [this, tool_names, request, progress_callback, output_callback, completion_callback]() {
+    return wip::utils::concurrency::async([this, tool_names, request, progress_callback, output_callback,
+                                          completion_callback, issue_callback]() {
         try {
-            std::cout << "[ANALYSIS_ENGINE] Starting async analysis with progress callbacks\n";
+            LOG_DEBUG("ANALYSIS_ENGINE", "Starting async analysis with progress callbacks");
             
             validate_tool_names(tool_names);
             
-            std::vector<AnalysisResult> results;
-            results.reserve(tool_names.size());
-            
             analysis_running_ = true;
-            cancel_requested_ = false;
+            AnalysisRequest cancellable_request = make_cancellable_request(request);
             
-            // Start all tools asynchronously and collect futures
-            std::vector<std::pair<std::string, std::future<AnalysisResult>>> tool_futures;
-            
-            for (const auto& tool_name : tool_names) {
-                std::cout << "[ANALYSIS_ENGINE] Processing tool: " << tool_name << "\n";
-                if (cancel_requested_) {
-                    std::cout << "[ANALYSIS_ENGINE] Cancel requested, breaking\n";
-                    break;
-                }
-                
-                auto tool = get_tool(tool_name);
-                if (tool && tool->is_available()) {
-                    std::cout << "[ANALYSIS_ENGINE] Tool " << tool_name << " is available, starting async...\n";
-                    
-                    // Create a tool-specific request with appropriate output file
-                    AnalysisRequest tool_request = request;
-                    if (!tool_request.output_file.empty()) {
-                        std::filesystem::path output_path(tool_request.output_file);
-                        std::string base_name = output_path.stem().string();
-                        std::string extension = output_path.extension().string();
-                        tool_request.output_file = base_name + "_" + tool_name + extension;
-                    }
-                    
-                    // Create progress callback wrapper for this specific tool
-                    auto tool_progress_callback = [progress_callback, tool_name](const AnalysisProgress& progress) {
-                        if (progress_callback) {
-                            progress_callback(tool_name, progress);
-                        }
-                    };
-                    
-                    // Create output callback wrapper for this specific tool
-                    auto tool_output_callback = [output_callback, tool_name](const std::string& output_line) {
-                        if (output_callback) {
-                            output_callback(tool_name, output_line);
-                        }
-                    };
-                    
-                    std::cout << "[ANALYSIS_ENGINE] Starting tool " << tool_name << " async with source: " << tool_request.source_path << "\n";
-                    try {
-                        // Start async execution and store future
-                        auto future = tool->execute_async(tool_request, tool_progress_callback, tool_output_callback);
-                        tool_futures.emplace_back(tool_name, std::move(future));
-                        
-                    } catch (const std::exception& e) {
-                        std::cout << "[ANALYSIS_ENGINE] Tool " << tool_name << " failed to start: " << e.what() << "\n";
-                        // Create error result for failed tool
-                        AnalysisResult error_result;
-                        error_result.tool_name = tool_name;
-                        error_result.analysis_id = generate_analysis_id();
-                        error_result.timestamp = std::chrono::system_clock::now();
-                        error_result.success = false;
-                        error_result.error_message = std::string("Tool failed to start: ") + e.what();
-                        results.push_back(std::move(error_result));
-                    }
-                } else {
-                    std::cout << "[ANALYSIS_ENGINE] Tool " << tool_name << " is not available\n";
-                    // Create error result for unavailable tool
-                    AnalysisResult error_result;
-                    error_result.tool_name = tool_name;
-                    error_result.analysis_id = generate_analysis_id();
-                    error_result.timestamp = std::chrono::system_clock::now();
-                    error_result.success = false;
-                    error_result.error_message = "Tool is not available";
-                    results.push_back(std::move(error_result));
-                }
-            }
-            
-            // Wait for all tool executions to complete (truly parallel)
-            std::cout << "[ANALYSIS_ENGINE] Waiting for " << tool_futures.size() << " tools to complete in parallel...\n";
-            
-            // Collect results while maintaining order and handling exceptions
-            results.reserve(tool_futures.size());
-            for (auto& [tool_name, future] : tool_futures) {
-                try {
-                    // Wait for this specific tool (they all run in parallel)
-                    auto result = future.get(); 
-                    std::cout << "[ANALYSIS_ENGINE] Tool " << tool_name << " completed, success: " << result.success << "\n";
-                    results.push_back(std::move(result));
-                } catch (const std::exception& e) {
-                    std::cout << "[ANALYSIS_ENGINE] Tool " << tool_name << " execution failed: " << e.what() << "\n";
-                    // Create error result for failed tool
-                    AnalysisResult error_result;
-                    error_result.tool_name = tool_name;
-                    error_result.analysis_id = generate_analysis_id();
-                    error_result.timestamp = std::chrono::system_clock::now();
-                    error_result.success = false;
-                    error_result.error_message = std::string("Tool execution failed: ") + e.what();
-                    results.push_back(std::move(error_result));
-                }
-            }
+            auto results = run_scheduled(tool_names, cancellable_request, progress_callback, output_callback,
+                                         issue_callback);
             
             analysis_running_ = false;
-            std::cout << "[ANALYSIS_ENGINE] All tools processed async, returning " << results.size() << " results\n";
+            LOG_DEBUG("ANALYSIS_ENGINE", "All tools processed async, returning ", results.size(), " results");
             
             if (completion_callback) {
                 completion_callback(results);
@@ -320,11 +322,43 @@ std::future<std::vector<AnalysisResult>> AnalysisEngine::analyze_async(
     });
 }
 
+void AnalysisEngine::set_cache(std::shared_ptr<AnalysisCache> cache) {
+    std::lock_guard<std::mutex> lock(tools_mutex_);
+    cache_ = std::move(cache);
+}
+
+std::shared_ptr<AnalysisCache> AnalysisEngine::get_cache() const {
+    std::lock_guard<std::mutex> lock(tools_mutex_);
+    return cache_;
+}
+
+void AnalysisEngine::set_shard_executor(std::shared_ptr<ShardExecutor> executor) {
+    std::lock_guard<std::mutex> lock(tools_mutex_);
+    shard_executor_ = std::move(executor);
+}
+
+std::shared_ptr<ShardExecutor> AnalysisEngine::get_shard_executor() const {
+    std::lock_guard<std::mutex> lock(tools_mutex_);
+    return shard_executor_;
+}
+
+void AnalysisEngine::set_concurrency(size_t job_count) {
+    concurrency_ = job_count;
+}
+
+size_t AnalysisEngine::get_concurrency() const {
+    size_t job_count = concurrency_.load();
+    return job_count > 0 ? job_count : governor_.compute_budget();
+}
+
 bool AnalysisEngine::cancel_analysis() {
     cancel_requested_ = true;
     
-    // Try to cancel individual tools
+    // Every process started for the analysis shares this token and is signalled right away
     std::lock_guard<std::mutex> lock(tools_mutex_);
+    cancellation_.cancel();
+    
+    // Try to cancel individual tools
     for (const auto& [name, tool] : tools_) {
         if (tool && tool->is_analysis_running()) {
             tool->cancel_analysis();
@@ -334,6 +368,18 @@ bool AnalysisEngine::cancel_analysis() {
     return true;
 }
 
+AnalysisRequest AnalysisEngine::make_cancellable_request(const AnalysisRequest& request) {
+    AnalysisRequest cancellable_request = request;
+    if (!cancellable_request.cancellation.can_be_cancelled()) {
+        cancellable_request.cancellation = wip::utils::process::CancellationToken::create();
+    }
+    
+    std::lock_guard<std::mutex> lock(tools_mutex_);
+    cancellation_ = cancellable_request.cancellation;
+    cancel_requested_ = false;
+    return cancellable_request;
+}
+
 bool AnalysisEngine::is_analysis_running() const {
     return analysis_running_.load();
 }
@@ -350,15 +396,20 @@ AnalysisResult AnalysisEngine::aggregate_results(const std::vector<AnalysisResul
     }
     
     // Aggregate all issues
+    size_t total_issue_count = 0;
+    for (const auto& result : results) {
+        total_issue_count += result.issues.size();
+    }
+    
     std::vector<AnalysisIssue> all_issues;
+    all_issues.reserve(total_issue_count);
     for (const auto& result : results) {
-        for (const auto& issue : result.issues) {
-            all_issues.push_back(issue);
-        }
+        all_issues.insert(all_issues.end(), result.issues.begin(), result.issues.end());
         
         // Sum up metadata
         aggregated.files_analyzed += result.files_analyzed;
         aggregated.execution_time += result.execution_time;
+        aggregated.profile += result.profile;
         
         // Aggregate success (all must succeed)
         if (!result.success) {
@@ -371,7 +422,10 @@ AnalysisResult AnalysisEngine::aggregate_results(const std::vector<AnalysisResul
     }
     
     // Remove duplicates
-    deduplicate_issues(all_issues);
+    {
+        wip::time::utilities::ScopedTimer dedup_timer(aggregated.profile.aggregate_time);
+        deduplicate_issues(all_issues);
+    }
     
     // Set aggregated issues
     aggregated.issues = std::move(all_issues);
@@ -384,7 +438,17 @@ AnalysisResult AnalysisEngine::aggregate_results(const std::vector<AnalysisResul
     return aggregated;
 }
 
-void AnalysisEngine::save_results(const std::vector<AnalysisResult>& results, const std::string& file_path) const {
+void AnalysisEngine::save_results(const std::vector<AnalysisResult>& results, const std::string& file_path,
+                                  ResultFormat format) const {
+    if (format == ResultFormat::Binary) {
+        BinaryResultFile::write(results, file_path);
+        return;
+    }
+    if (format == ResultFormat::Ndjson) {
+        NdjsonResultFile::write(results, file_path);
+        return;
+    }
+    
     nlohmann::json j = nlohmann::json::array();
     
     for (const auto& result : results) {
@@ -399,6 +463,31 @@ void AnalysisEngine::save_results(const std::vector<AnalysisResult>& results, co
     file << j.dump(2);  // Pretty print with 2-space indentation
 }
 
+std::future<bool> AnalysisEngine::save_results_async(std::vector<AnalysisResult> results, const std::string& file_path,
+                                                     wip::utils::file::AsyncFileWriter& writer,
+                                                     ResultFormat format) const {
+    auto shared_results = std::make_shared<const std::vector<AnalysisResult>>(std::move(results));
+    if (format == ResultFormat::Ndjson) {
+        return writer.write_stream(file_path, [shared_results](std::ostream& out) {
+            NdjsonIssueWriter ndjson(out);
+            for (const auto& result : *shared_results) {
+                ndjson.write_result(result);
+            }
+        });
+    }
+    return writer.write(file_path, [shared_results, format]() {
+        if (format == ResultFormat::Binary) {
+            return BinaryResultFile::serialize(*shared_results);
+        }
+        
+        nlohmann::json j = nlohmann::json::array();
+        for (const auto& result : *shared_results) {
+            j.push_back(result.to_json());
+        }
+        return j.dump(2);
+    });
+}
+
 void AnalysisEngine::save_aggregated_result(const AnalysisResult& result, const std::string& file_path) const {
     auto j = result.to_json();
     
@@ -411,6 +500,13 @@ void AnalysisEngine::save_aggregated_result(const AnalysisResult& result, const
 }
 
 std::vector<AnalysisResult> AnalysisEngine::load_results(const std::string& file_path) const {
+    if (BinaryResultFile::is_binary_file(file_path)) {
+        return BinaryResultFile(file_path).read_all();
+    }
+    if (NdjsonResultFile::is_ndjson_file(file_path)) {
+        return NdjsonResultFile(file_path).read_all();
+    }
+    
     std::ifstream file(file_path);
     if (!file.is_open()) {
         throw std::runtime_error("Cannot open file for reading: " + file_path);
@@ -453,83 +549,662 @@ AnalysisEngine::AnalysisStatistics AnalysisEngine::get_statistics(const std::vec
         stats.total_files_analyzed += result.files_analyzed;
         stats.total_execution_time += result.execution_time;
         stats.issues_per_tool[result.tool_name] = result.issues.size();
+        stats.total_profile += result.profile;
+        stats.profile_per_tool[result.tool_name] += result.profile;
         
-        for (const auto& issue : result.issues) {
-            stats.issues_by_severity[issue.severity]++;
-            stats.issues_by_category[issue.category]++;
+        // The result's own counts are used unless its issues were changed behind its back
+        if (result.has_current_statistics()) {
+            for (size_t i = 0; i < ISSUE_SEVERITY_COUNT; ++i) {
+                stats.issues_by_severity[i] += result.issue_counts_by_severity[i];
+            }
+            for (size_t i = 0; i < ISSUE_CATEGORY_COUNT; ++i) {
+                stats.issues_by_category[i] += result.issue_counts_by_category[i];
+            }
+        } else {
+            for (const auto& issue : result.issues) {
+                ++stats.issues_by_severity[static_cast<size_t>(issue.severity)];
+                ++stats.issues_by_category[static_cast<size_t>(issue.category)];
+            }
         }
     }
     
     stats.most_problematic_files = find_most_problematic_files(results);
     
+    // Units whose tool processes needed the most memory, for sizing concurrency on a host
+    const auto& unit_rss = stats.total_profile.unit_peak_rss_kb;
+    stats.largest_units.assign(unit_rss.begin(), unit_rss.end());
+    size_t unit_count = std::min<size_t>(10, stats.largest_units.size());
+    std::partial_sort(stats.largest_units.begin(), stats.largest_units.begin() + static_cast<std::ptrdiff_t>(unit_count),
+                      stats.largest_units.end(), [](const auto& a, const auto& b) {
+                          return a.second != b.second ? a.second > b.second : a.first < b.first;
+                      });
+    stats.largest_units.resize(unit_count);
+    
     return stats;
 }
 
 AnalysisEngine::ComparisonReport AnalysisEngine::compare_results(const std::vector<AnalysisResult>& baseline_results,
-                                                               const std::vector<AnalysisResult>& current_results) const {
+                                                               const std::vector<AnalysisResult>& current_results,
+                                                               const ComparisonOptions& options) const {
     ComparisonReport report;
     
-    // Aggregate results for comparison
-    auto baseline_aggregated = aggregate_results(baseline_results);
-    auto current_aggregated = aggregate_results(current_results);
+    // Both sides share one interner so that equal strings get equal IDs
+    StringInterner strings;
+    auto baseline = make_comparison_entries(baseline_results, strings);
+    auto current = make_comparison_entries(current_results, strings);
+    
+    size_t thread_count = get_concurrency();
+    auto by_key = [](const ComparisonEntry& a, const ComparisonEntry& b) {
+        return std::tie(a.file, a.rule, a.line, a.order) < std::tie(b.file, b.rule, b.line, b.order);
+    };
+    parallel_sort(baseline, by_key, thread_count);
+    parallel_sort(current, by_key, thread_count);
+    
+    // Drop repeated keys, keeping the first report (as aggregate_results does)
+    auto same_key = [](const ComparisonEntry& a, const ComparisonEntry& b) {
+        return a.file == b.file && a.rule == b.rule && a.line == b.line;
+    };
+    baseline.erase(std::unique(baseline.begin(), baseline.end(), same_key), baseline.end());
+    current.erase(std::unique(current.begin(), current.end(), same_key), current.end());
+    
+    report.issue_count_delta = static_cast<int>(current.size()) - static_cast<int>(baseline.size());
+    
+    // Classify exact matches in one merge pass; unmatched entries stay sorted
+    std::vector<ComparisonEntry*> unmatched_baseline;
+    std::vector<ComparisonEntry*> unmatched_current;
+    size_t b = 0;
+    size_t c = 0;
+    while (b < baseline.size() || c < current.size()) {
+        if (c == current.size() || (b < baseline.size() && by_key(baseline[b], current[c]) && !same_key(baseline[b], current[c]))) {
+            unmatched_baseline.push_back(&baseline[b++]);
+        } else if (b == baseline.size() || !same_key(baseline[b], current[c])) {
+            unmatched_current.push_back(&current[c++]);
+        } else {
+            current[c++].status = ComparisonEntry::Persistent;
+            baseline[b++].status = ComparisonEntry::Persistent;
+        }
+    }
     
-    report.issue_count_delta = static_cast<int>(current_aggregated.issues.size()) - 
-                              static_cast<int>(baseline_aggregated.issues.size());
+    // Issues that only changed line: same file, rule and message. Within each
+    // message the matching keeps line order, which is how inserted or removed
+    // code shifts the issues below it.
+    if (options.match_line_drift && !unmatched_baseline.empty() && !unmatched_current.empty()) {
+        auto by_message = [](const ComparisonEntry* a, const ComparisonEntry* b) {
+            return std::tie(a->file, a->rule, a->message, a->line) < std::tie(b->file, b->rule, b->message, b->line);
+        };
+        auto same_message = [](const ComparisonEntry* a, const ComparisonEntry* b) {
+            return a->file == b->file && a->rule == b->rule && a->message == b->message;
+        };
+        std::sort(unmatched_baseline.begin(), unmatched_baseline.end(), by_message);
+        std::sort(unmatched_current.begin(), unmatched_current.end(), by_message);
+        
+        b = 0;
+        c = 0;
+        while (b < unmatched_baseline.size() && c < unmatched_current.size()) {
+            auto* old_entry = unmatched_baseline[b];
+            auto* new_entry = unmatched_current[c];
+            if (!same_message(old_entry, new_entry)) {
+                if (by_message(old_entry, new_entry)) {
+                    ++b;
+                } else {
+                    ++c;
+                }
+                continue;
+            }
+            
+            long long drift = static_cast<long long>(new_entry->line) - old_entry->line;
+            if (options.max_line_drift < 0 || std::llabs(drift) <= options.max_line_drift) {
+                old_entry->status = ComparisonEntry::Persistent;
+                new_entry->status = ComparisonEntry::Moved;
+                ++b;
+                ++c;
+            } else if (old_entry->line < new_entry->line) {
+                ++b;
+            } else {
+                ++c;
+            }
+        }
+    }
+    
+    // Emit in run order
+    auto by_order = [](const ComparisonEntry& a, const ComparisonEntry& b) { return a.order < b.order; };
+    parallel_sort(baseline, by_order, thread_count);
+    parallel_sort(current, by_order, thread_count);
+    
+    std::map<IssueSeverity, size_t> current_counts;
+    std::map<IssueSeverity, size_t> baseline_counts;
+    for (const auto& entry : current) {
+        ++current_counts[entry.issue->severity];
+        if (entry.status == ComparisonEntry::Unmatched) {
+            report.new_issues.push_back(*entry.issue);
+        } else {
+            report.moved_issue_count += entry.status == ComparisonEntry::Moved ? 1 : 0;
+            report.persistent_issues.push_back(*entry.issue);
+        }
+    }
+    for (const auto& entry : baseline) {
+        ++baseline_counts[entry.issue->severity];
+        if (entry.status == ComparisonEntry::Unmatched) {
+            report.resolved_issues.push_back(*entry.issue);
+        }
+    }
     
-    // Create sets for easier comparison
-    std::set<std::string> baseline_issue_ids;
-    std::map<std::string, AnalysisIssue> baseline_issues_map;
+    // Calculate severity deltas
+    for (const auto& [severity, current_count] : current_counts) {
+        auto it = baseline_counts.find(severity);
+        size_t baseline_count = it != baseline_counts.end() ? it->second : 0;
+        report.severity_deltas[severity] = static_cast<int>(current_count) - static_cast<int>(baseline_count);
+    }
     
-    for (const auto& issue : baseline_aggregated.issues) {
-        std::string issue_key = issue.file_path + ":" + std::to_string(issue.line_number) + ":" + issue.rule_id;
-        baseline_issue_ids.insert(issue_key);
-        baseline_issues_map[issue_key] = issue;
+    return report;
+}
+
+// ==================== Private Helper Methods ====================
+
+AnalysisResult AnalysisEngine::execute_tool(AnalysisTool& tool, const AnalysisRequest& request,
+                                           std::function<void(const AnalysisProgress&)> progress_callback,
+                                           std::function<void(const std::string&)> output_callback) {
+    auto run = [&](const AnalysisRequest& run_request) {
+        if (progress_callback || output_callback) {
+            return tool.execute_async(run_request, progress_callback, output_callback).get();
+        }
+        return tool.execute(run_request);
+    };
+    
+    // Issues of a diff-scoped run are not a unit's complete result, so the cache is bypassed
+    if (!request.changed_ranges.empty()) {
+        auto units = tool.get_translation_units(request);
+        if (units.empty()) {
+            return run(request);
+        }
+        AnalysisRequest scoped_request = request;
+        scoped_request.source_files = get_changed_units(units, request);
+        if (!scoped_request.source_files.empty()) {
+            return run(scoped_request);
+        }
+        AnalysisResult result;
+        result.tool_name = tool.get_name();
+        result.analysis_id = generate_analysis_id();
+        result.timestamp = std::chrono::system_clock::now();
+        result.success = true;
+        return result;
     }
     
-    std::set<std::string> current_issue_ids;
-    std::map<std::string, AnalysisIssue> current_issues_map;
+    auto cache = get_cache();
+    if (!cache) {
+        return run(request);
+    }
     
-    for (const auto& issue : current_aggregated.issues) {
-        std::string issue_key = issue.file_path + ":" + std::to_string(issue.line_number) + ":" + issue.rule_id;
-        current_issue_ids.insert(issue_key);
-        current_issues_map[issue_key] = issue;
+    auto units = tool.get_translation_units(request);
+    if (units.empty()) {
+        return run(request);
     }
     
-    // Find new issues
-    for (const auto& issue_key : current_issue_ids) {
-        if (baseline_issue_ids.find(issue_key) == baseline_issue_ids.end()) {
-            report.new_issues.push_back(current_issues_map[issue_key]);
+    std::string tool_name = tool.get_name();
+    std::string tool_version = tool.get_version();
+    std::string config_hash = AnalysisCache::compute_config_hash(tool.get_configuration(), request);
+    auto plan = cache->plan(tool_name, tool_version, config_hash, units, request);
+    
+    LOG_DEBUG("ANALYSIS_ENGINE", "Cache: ", plan.cached_unit_count, " of ", plan.units.size(), " units up to date for ", tool_name);
+    
+    AnalysisResult result;
+    if (!plan.changed_units.empty()) {
+        AnalysisRequest changed_request = request;
+        changed_request.source_files = plan.changed_units;
+        result = run(changed_request);
+    } else {
+        result.tool_name = tool_name;
+        result.analysis_id = generate_analysis_id();
+        result.timestamp = std::chrono::system_clock::now();
+        result.success = true;
+        
+        if (progress_callback) {
+            AnalysisProgress progress;
+            progress.total_files = plan.units.size();
+            progress.processed_files = plan.units.size();
+            progress.status_message = "All files up to date";
+            progress_callback(progress);
         }
     }
     
-    // Find resolved issues
-    for (const auto& issue_key : baseline_issue_ids) {
-        if (current_issue_ids.find(issue_key) == current_issue_ids.end()) {
-            report.resolved_issues.push_back(baseline_issues_map[issue_key]);
+    apply_cache(*cache, tool_version, config_hash, plan, result);
+    return result;
+}
+
+std::vector<AnalysisResult> AnalysisEngine::run_scheduled(const std::vector<std::string>& tool_names,
+                                                          const AnalysisRequest& request,
+                                                          ProgressCallback progress_callback,
+                                                          OutputCallback output_callback,
+                                                          IssueCallback issue_callback) {
+    struct ToolRun {
+        std::string tool_name;
+        AnalysisTool* tool = nullptr;
+        AnalysisRequest request;
+        std::string tool_version;
+        std::string config_hash;
+        std::optional<AnalysisCache::Plan> plan;
+        std::optional<AnalysisResult> error_result;     // Set when the tool could not be started
+        std::vector<AnalysisResult> shard_results;
+        std::vector<std::map<std::string, double>> shard_costs;  // Measured cost of every unit, per shard
+        size_t total_files = 0;
+        std::atomic<size_t> processed_files{0};
+        std::chrono::steady_clock::time_point start_time;
+        std::unordered_set<IssueKey, IssueKeyHash> delivered_keys;  // Views issues held by this run
+    };
+    
+    std::mutex callback_mutex;
+    
+    // Streams the issues of a batch that were not delivered before; callback_mutex must be held
+    auto deliver_issues = [&issue_callback](ToolRun& run, const std::vector<AnalysisIssue>& issues) {
+        std::vector<AnalysisIssue> batch;
+        for (const auto& issue : issues) {
+            if (run.delivered_keys.insert(issue.key()).second) {
+                batch.push_back(issue);
+            }
+        }
+        if (!batch.empty()) {
+            issue_callback(run.tool_name, batch);
+        }
+    };
+    
+    struct ShardJob {
+        ToolRun* run = nullptr;
+        size_t shard_index = 0;
+        std::vector<std::string> files;                 // Empty = the whole request
+        double cost = 0.0;                              // Expected cost, to start the longest jobs first
+        bool likely_offender = false;                   // Reached the stop severity last time, so starts before all others
+    };
+    
+    auto cache = get_cache();
+    auto shard_executor = get_shard_executor();
+    size_t concurrency = shard_executor ? std::max<size_t>(1, shard_executor->get_slot_count()) : get_concurrency();
+    
+    std::vector<std::unique_ptr<ToolRun>> runs;
+    std::vector<ShardJob> jobs;
+    
+    // Split every tool's work into (tool, file shard) jobs
+    for (const auto& tool_name : tool_names) {
+        LOG_DEBUG("ANALYSIS_ENGINE", "Processing tool: ", tool_name);
+        if (cancel_requested_) {
+            LOG_DEBUG("ANALYSIS_ENGINE", "Cancel requested, breaking");
+            break;
         }
+        
+        auto run = std::make_unique<ToolRun>();
+        run->tool_name = tool_name;
+        run->start_time = std::chrono::steady_clock::now();
+        
+        auto tool = get_tool(tool_name);
+        if (!tool || !tool->is_available()) {
+            LOG_WARNING("ANALYSIS_ENGINE", "Tool ", tool_name, " is not available");
+            run->error_result = make_error_result(tool_name, "Tool is not available");
+            runs.push_back(std::move(run));
+            continue;
+        }
+        
+        run->tool = tool;
+        run->request = make_tool_request(request, tool_name);
+        
+        try {
+            // Resolve lazily cached tool state before jobs call into the tool concurrently
+            run->tool_version = tool->get_version();
+            tool->get_executable_path();
+            
+            auto units = tool->get_translation_units(run->request);
+            bool scoped = !run->request.changed_ranges.empty() && !units.empty();
+            if (scoped) {
+                // Issues of a diff-scoped run are not a unit's complete result, so the cache is bypassed
+                units = get_changed_units(units, run->request);
+                LOG_DEBUG("ANALYSIS_ENGINE", units.size(), " units reach the changed files for ", tool_name);
+            } else if (cache && !units.empty()) {
+                run->config_hash = AnalysisCache::compute_config_hash(tool->get_configuration(), run->request);
+                run->plan = cache->plan(tool_name, run->tool_version, run->config_hash, units, run->request);
+                units = run->plan->changed_units;
+                
+                LOG_DEBUG("ANALYSIS_ENGINE", "Cache: ", run->plan->cached_unit_count, " of ",
+                    run->plan->units.size(), " units up to date for ", tool_name);
+                
+                // Cached issues are known before any job runs
+                if (issue_callback) {
+                    std::lock_guard<std::mutex> lock(callback_mutex);
+                    deliver_issues(*run, run->plan->cached_issues);
+                }
+            }
+            
+            run->total_files = units.size();
+            
+            if (units.empty()) {
+                if (!run->plan && !scoped) {
+                    // The tool does not expose its units; run it once on the whole request
+                    jobs.push_back(ShardJob{run.get(), 0, {}, std::numeric_limits<double>::infinity()});
+                    run->shard_results.resize(1);
+                }
+            } else {
+                // Several jobs per worker keep the workers busy until the end of the run
+                size_t target_jobs = concurrency * JOBS_PER_WORKER;
+                size_t shard_size = std::max<size_t>(1, (units.size() + target_jobs - 1) / target_jobs);
+                
+                // Balance shards by what their units cost last time, or by file size
+                static const std::map<std::string, double> no_costs;
+                const auto& unit_costs = run->plan ? run->plan->unit_costs : no_costs;
+                
+                // When failing fast, the units that reached the stop severity last time are
+                // spread over all workers in shards of their own, which start first
+                std::vector<std::string> offenders;
+                if (run->request.stop_on_severity && run->plan) {
+                    const auto& severities = run->plan->unit_severities;
+                    auto is_offender = [&](const std::string& unit) {
+                        auto it = severities.find(unit);
+                        return it != severities.end() && it->second >= *run->request.stop_on_severity;
+                    };
+                    std::copy_if(units.begin(), units.end(), std::back_inserter(offenders), is_offender);
+                    units.erase(std::remove_if(units.begin(), units.end(), is_offender), units.end());
+                }
+                
+                auto add_shards = [&](const std::vector<std::string>& shard_units, size_t count, bool likely_offender) {
+                    if (shard_units.empty()) {
+                        return;
+                    }
+                    auto costs = ShardPlanner::estimate_costs(shard_units, unit_costs);
+                    for (auto& shard : ShardPlanner::plan(shard_units, costs, count)) {
+                        jobs.push_back(ShardJob{run.get(), run->shard_results.size(), std::move(shard.units), shard.cost,
+                                                likely_offender});
+                        run->shard_results.emplace_back();
+                        run->shard_costs.emplace_back();
+                    }
+                };
+                add_shards(offenders, std::min(offenders.size(), concurrency), true);
+                add_shards(units, (units.size() + shard_size - 1) / shard_size, false);
+            }
+        } catch (const std::exception& e) {
+            LOG_ERROR("ANALYSIS_ENGINE", "Tool ", tool_name, " failed to start: ", e.what());
+            run->error_result = make_error_result(tool_name, std::string("Tool failed to start: ") + e.what());
+        }
+        
+        runs.push_back(std::move(run));
     }
     
-    // Find persistent issues
-    for (const auto& issue_key : current_issue_ids) {
-        if (baseline_issue_ids.find(issue_key) != baseline_issue_ids.end()) {
-            report.persistent_issues.push_back(current_issues_map[issue_key]);
+    LOG_DEBUG("ANALYSIS_ENGINE", "Scheduling ", jobs.size(), " jobs on ",
+        std::min(concurrency, std::max<size_t>(1, jobs.size())), " workers");
+    
+    std::atomic<size_t> completed_jobs{0};
+    const size_t total_jobs = jobs.size();
+    std::atomic<bool> stopped{false};      // An issue reached the request's stop severity
+    
+    if (!jobs.empty()) {
+        const size_t worker_count = std::min(concurrency, jobs.size());
+        JobScheduler scheduler(worker_count);
+        
+        // Slots left by jobs that have finished go to the jobs started after them
+        governor_.begin_run(concurrency);
+        std::mutex lease_mutex;
+        size_t started_jobs = 0;
+        size_t active_jobs = 0;
+        auto acquire_slots = [&]() {
+            std::lock_guard<std::mutex> lock(lease_mutex);
+            size_t pending = total_jobs - started_jobs++;
+            size_t idle_workers = worker_count - std::min(worker_count, ++active_jobs);
+            return governor_.acquire(pending, idle_workers);
+        };
+        auto finish_job = [&]() {
+            std::lock_guard<std::mutex> lock(lease_mutex);
+            --active_jobs;
+        };
+        
+        // Workers run their own newest job first, so submitting the cheapest jobs
+        // first starts the most expensive ones first, over all tools of the run
+        std::vector<ShardJob*> submit_order;
+        submit_order.reserve(jobs.size());
+        for (auto& job : jobs) {
+            submit_order.push_back(&job);
         }
+        std::stable_sort(submit_order.begin(), submit_order.end(), [](const ShardJob* a, const ShardJob* b) {
+            return std::tie(a->likely_offender, a->cost) < std::tie(b->likely_offender, b->cost);
+        });
+        
+        for (ShardJob* job_ptr : submit_order) {
+            scheduler.submit([&, job_ptr]() {
+                ShardJob& job = *job_ptr;
+                ToolRun& run = *job.run;
+                AnalysisResult shard_result;
+                
+                auto lease = acquire_slots();
+                
+                if (cancel_requested_) {
+                    shard_result = make_error_result(run.tool_name, "Analysis cancelled");
+                } else if (stopped) {
+                    // Failing fast: the outcome is known, so the job is skipped
+                    shard_result.tool_name = run.tool_name;
+                    shard_result.success = true;
+                } else {
+                    AnalysisRequest shard_request = run.request;
+                    if (!job.files.empty()) {
+                        shard_request.source_files = job.files;
+                    }
+                    // The governor owns the parallelism; a tool runs at most as many processes as its lease
+                    shard_request.max_parallel_jobs = lease.get_slots();
+                    if (run.shard_results.size() > 1 && !shard_request.output_file.empty()) {
+                        std::filesystem::path output_path(shard_request.output_file);
+                        output_path.replace_filename(output_path.stem().string() + "_shard" +
+                                                     std::to_string(job.shard_index) + output_path.extension().string());
+                        shard_request.output_file = output_path.string();
+                    }
+                    
+                    auto job_start = std::chrono::steady_clock::now();
+                    try {
+                        if (shard_executor && !run.tool->runs_in_process()) {
+                            shard_result = shard_executor->execute_shard(*run.tool, shard_request);
+                        } else if (output_callback && !run.tool->runs_in_process()) {
+                            auto tool_output_callback = [&callback_mutex, &output_callback, &run](const std::string& output_line) {
+                                std::lock_guard<std::mutex> lock(callback_mutex);
+                                output_callback(run.tool_name, output_line);
+                            };
+                            shard_result = run.tool->execute_async(shard_request, nullptr, tool_output_callback).get();
+                        } else {
+                            shard_result = run.tool->execute(shard_request);
+                        }
+                    } catch (const std::exception& e) {
+                        LOG_ERROR("ANALYSIS_ENGINE", "Tool ", run.tool_name, " execution failed: ", e.what());
+                        shard_result = make_error_result(run.tool_name, std::string("Tool execution failed: ") + e.what());
+                    }
+                    
+                    if (shard_result.success && !job.files.empty()) {
+                        run.shard_costs[job.shard_index] = ShardPlanner::attribute_costs(
+                            job.files, shard_result.profile, std::chrono::steady_clock::now() - job_start);
+                    }
+                    shard_result.profile.unit_cpu_times.clear();
+                    
+                    // Every tool and job of the analysis shares the request's token
+                    const auto& stop_on_severity = run.request.stop_on_severity;
+                    if (stop_on_severity && !stopped &&
+                        std::any_of(shard_result.issues.begin(), shard_result.issues.end(),
+                                    [&](const AnalysisIssue& issue) { return issue.severity >= *stop_on_severity; }) &&
+                        !stopped.exchange(true)) {
+                        LOG_INFO("ANALYSIS_ENGINE", "Tool ", run.tool_name, " reported a ",
+                            severity_to_string(*stop_on_severity), " issue; stopping the analysis");
+                        run.request.cancellation.cancel();
+                    }
+                }
+                
+                lease.release();
+                finish_job();
+                
+                run.shard_results[job.shard_index] = std::move(shard_result);
+                size_t done = ++completed_jobs;
+                size_t processed = (run.processed_files += job.files.size());
+                
+                if (issue_callback) {
+                    std::lock_guard<std::mutex> lock(callback_mutex);
+                    deliver_issues(run, run.shard_results[job.shard_index].issues);
+                }
+                
+                if (progress_callback) {
+                    std::lock_guard<std::mutex> lock(callback_mutex);
+                    AnalysisProgress progress;
+                    progress.total_files = run.total_files;
+                    progress.processed_files = processed;
+                    progress.total_jobs = total_jobs;
+                    progress.completed_jobs = done;
+                    progress.current_file = job.files.empty() ? std::string() : job.files.back();
+                    progress.status_message = "Completed " + std::to_string(done) + " of " + std::to_string(total_jobs) + " jobs";
+                    progress_callback(run.tool_name, progress);
+                }
+            });
+        }
+        
+        scheduler.wait();
+        LOG_DEBUG("ANALYSIS_ENGINE", "Scheduler finished, ", scheduler.get_steal_count(), " jobs stolen");
     }
     
-    // Calculate severity deltas
-    for (const auto& [severity, current_count] : current_aggregated.issue_counts_by_severity) {
-        size_t baseline_count = 0;
-        auto it = baseline_aggregated.issue_counts_by_severity.find(severity);
-        if (it != baseline_aggregated.issue_counts_by_severity.end()) {
-            baseline_count = it->second;
+    // Merge the shards of every tool, in tool order
+    std::vector<AnalysisResult> results;
+    results.reserve(runs.size());
+    
+    for (auto& run : runs) {
+        run->delivered_keys.clear();  // The keys view issues that are moved below
+        
+        if (run->error_result) {
+            results.push_back(std::move(*run->error_result));
+            continue;
         }
-        report.severity_deltas[severity] = static_cast<int>(current_count) - static_cast<int>(baseline_count);
+        
+        AnalysisResult result;
+        result.tool_name = run->tool_name;
+        result.analysis_id = generate_analysis_id();
+        result.timestamp = std::chrono::system_clock::now();
+        result.success = true;
+        
+        size_t issue_count = 0;
+        for (const auto& shard_result : run->shard_results) {
+            issue_count += shard_result.issues.size();
+        }
+        result.issues.reserve(issue_count);
+        
+        wip::time::utilities::Stopwatch merge_stopwatch;
+        merge_stopwatch.start();
+        
+        for (auto& shard_result : run->shard_results) {
+            result.issues.insert(result.issues.end(), std::make_move_iterator(shard_result.issues.begin()),
+                                 std::make_move_iterator(shard_result.issues.end()));
+            result.files_analyzed += shard_result.files_analyzed;
+            result.profile += shard_result.profile;
+            
+            // Shards cut short by a stop are not failures
+            if (!shard_result.success && !stopped) {
+                result.success = false;
+                if (!result.error_message.empty()) {
+                    result.error_message += "; ";
+                }
+                result.error_message += shard_result.error_message;
+            }
+        }
+        
+        // Headers reached from several shards are reported once per shard
+        if (run->shard_results.size() > 1) {
+            deduplicate_issues(result.issues);
+        }
+        result.execution_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - run->start_time);
+        
+        result.stopped_early = stopped;
+        if (stopped) {
+            // The units that were not analyzed must not be cached as clean
+            if (run->plan) {
+                result.issues.insert(result.issues.end(), std::make_move_iterator(run->plan->cached_issues.begin()),
+                                     std::make_move_iterator(run->plan->cached_issues.end()));
+                deduplicate_issues(result.issues);
+                result.files_analyzed += run->plan->cached_unit_count;
+            }
+            result.compute_statistics();
+        } else if (run->plan) {
+            for (const auto& costs : run->shard_costs) {
+                for (const auto& [unit, cost] : costs) {
+                    run->plan->unit_costs[unit] = cost;
+                }
+            }
+            apply_cache(*cache, run->tool_version, run->config_hash, *run->plan, result);
+        } else {
+            result.compute_statistics();
+        }
+        merge_stopwatch.stop();
+        result.profile.aggregate_time += merge_stopwatch.elapsed();
+        
+        LOG_DEBUG("ANALYSIS_ENGINE", "Tool ", run->tool_name, " completed, success: ", result.success);
+        results.push_back(std::move(result));
     }
     
-    return report;
+    return results;
 }
 
-// ==================== Private Helper Methods ====================
+void AnalysisEngine::apply_cache(AnalysisCache& cache, const std::string& tool_version, const std::string& config_hash,
+                                 AnalysisCache::Plan& plan, AnalysisResult& result) const {
+    // Failed runs are not cached so the next run retries the same units
+    if (!result.success) {
+        return;
+    }
+    
+    if (!plan.changed_units.empty()) {
+        cache.update(result.tool_name, tool_version, config_hash, plan, result.issues);
+        cache.save();
+    }
+    
+    result.issues.insert(result.issues.end(), std::make_move_iterator(plan.cached_issues.begin()),
+                         std::make_move_iterator(plan.cached_issues.end()));
+    deduplicate_issues(result.issues);
+    result.files_analyzed += plan.cached_unit_count;
+    result.compute_statistics();
+}
+
+std::vector<std::string> AnalysisEngine::get_changed_units(const std::vector<std::string>& units,
+                                                           const AnalysisRequest& request) const {
+    // A changed header reaches every unit including it, directly or not
+    auto cache = get_cache();
+    std::shared_ptr<IncludeGraph> graph = cache ? cache->get_include_graph() : nullptr;
+    if (!graph || !graph->matches(request)) {
+        graph = std::make_shared<IncludeGraph>(request);
+    }
+    
+    // Units are listed relative to the current directory, like the changed files
+    std::string current_directory = std::filesystem::current_path().string();
+    std::vector<std::string> normalized_units;
+    normalized_units.reserve(units.size());
+    for (const auto& unit : units) {
+        normalized_units.push_back(IncludeGraph::normalize_path(unit, current_directory));
+    }
+    graph->scan(normalized_units);
+    
+    auto affected = graph->get_affected_units(ChangedLines(request.changed_ranges).get_files());
+    std::unordered_set<std::string> affected_units(affected.begin(), affected.end());
+    std::vector<std::string> changed_units;
+    for (size_t index = 0; index < units.size(); ++index) {
+        if (affected_units.count(normalized_units[index])) {
+            changed_units.push_back(units[index]);
+        }
+    }
+    return changed_units;
+}
+
+AnalysisRequest AnalysisEngine::make_tool_request(const AnalysisRequest& request, const std::string& tool_name) const {
+    // Create a tool-specific request with appropriate output file
+    AnalysisRequest tool_request = request;
+    if (!tool_request.output_file.empty()) {
+        std::filesystem::path output_path(tool_request.output_file);
+        std::string base_name = output_path.stem().string();
+        std::string extension = output_path.extension().string();
+        tool_request.output_file = base_name + "_" + tool_name + extension;
+    }
+    return tool_request;
+}
+
+AnalysisResult AnalysisEngine::make_error_result(const std::string& tool_name, const std::string& error_message) const {
+    AnalysisResult error_result;
+    error_result.tool_name = tool_name;
+    error_result.analysis_id = generate_analysis_id();
+    error_result.timestamp = std::chrono::system_clock::now();
+    error_result.success = false;
+    error_result.error_message = error_message;
+    return error_result;
+}
 
 void AnalysisEngine::validate_tool_names(const std::vector<std::string>& tool_names) const {
     if (tool_names.empty()) {
@@ -554,54 +1229,58 @@ void AnalysisEngine::deduplicate_issues(std::vector<AnalysisIssue>& issues) cons
         return;
     }
     
-    std::vector<AnalysisIssue> unique_issues;
-    unique_issues.reserve(issues.size());
-    
-    for (const auto& issue : issues) {
-        bool is_duplicate = false;
+    // Mark the first occurrence of every key; later occurrences are duplicates.
+    // The set's nodes come from an arena, which drops them all at once afterwards.
+    std::vector<bool> keep(issues.size(), false);
+    {
+        ParseArena arena;
+        std::pmr::unordered_set<IssueKey, IssueKeyHash> seen_keys(arena.resource());
+        seen_keys.reserve(issues.size());
         
-        for (const auto& unique_issue : unique_issues) {
-            if (are_issues_similar(issue, unique_issue)) {
-                is_duplicate = true;
-                break;
-            }
+        for (size_t i = 0; i < issues.size(); ++i) {
+            keep[i] = seen_keys.insert(issues[i].key()).second;
         }
-        
-        if (!is_duplicate) {
-            unique_issues.push_back(issue);
+    }   // Keys view the issues, drop them before moving issues around
+    
+    // Compact in place, preserving the original order of the kept issues
+    size_t write_index = 0;
+    for (size_t read_index = 0; read_index < issues.size(); ++read_index) {
+        if (keep[read_index]) {
+            if (write_index != read_index) {
+                issues[write_index] = std::move(issues[read_index]);
+            }
+            ++write_index;
         }
     }
-    
-    issues = std::move(unique_issues);
+    issues.resize(write_index);
 }
 
 bool AnalysisEngine::are_issues_similar(const AnalysisIssue& issue1, const AnalysisIssue& issue2) const {
     // Consider issues similar if they have the same file, line, and rule (different tools may report same issue)
-    return issue1.file_path == issue2.file_path &&
-           issue1.line_number == issue2.line_number &&
-           issue1.rule_id == issue2.rule_id;
+    return issue1.key() == issue2.key();
 }
 
 std::vector<std::string> AnalysisEngine::find_most_problematic_files(const std::vector<AnalysisResult>& results, size_t max_files) const {
-    std::map<std::string, size_t> file_issue_counts;
-    
+    // Paths are viewed in the results, not copied
+    std::unordered_map<std::string_view, size_t> file_issue_counts;
     for (const auto& result : results) {
         for (const auto& issue : result.issues) {
             file_issue_counts[issue.file_path]++;
         }
     }
     
-    // Sort files by issue count
-    std::vector<std::pair<std::string, size_t>> sorted_files(file_issue_counts.begin(), file_issue_counts.end());
-    std::sort(sorted_files.begin(), sorted_files.end(), 
-              [](const auto& a, const auto& b) { return a.second > b.second; });
+    // Only the top entries are ordered
+    std::vector<std::pair<std::string_view, size_t>> sorted_files(file_issue_counts.begin(), file_issue_counts.end());
+    size_t count = std::min(max_files, sorted_files.size());
+    std::partial_sort(sorted_files.begin(), sorted_files.begin() + static_cast<std::ptrdiff_t>(count), sorted_files.end(),
+                      [](const auto& a, const auto& b) {
+                          return a.second != b.second ? a.second > b.second : a.first < b.first;
+                      });
     
     std::vector<std::string> result;
-    size_t count = std::min(max_files, sorted_files.size());
     result.reserve(count);
-    
     for (size_t i = 0; i < count; ++i) {
-        result.push_back(sorted_files[i].first);
+        result.emplace_back(sorted_files[i].first);
     }
     
     return result;
@@ -627,15 +1306,30 @@ std::unique_ptr<AnalysisEngine> AnalysisEngineFactory::create_engine_with_tools(
             engine->register_tool(std::make_unique<tools::CppcheckTool>());
         } else if (tool_name == "clang-tidy") {
             engine->register_tool(std::make_unique<tools::ClangTidyTool>());
+        } else if (tool_name == "banned-tokens") {
+            engine->register_tool(std::make_unique<tools::BannedTokenTool>());
+        } else if (auto tool = AnalysisToolRegistry::instance().create_tool(tool_name)) {
+            // Tools registered by the application, such as its own in-process checks
+            engine->register_tool(std::move(tool));
         }
-        // Add more tools as they are implemented
     }
     
     return engine;
 }
 
 std::unique_ptr<AnalysisEngine> AnalysisEngineFactory::create_full_engine() {
-    return create_default_engine();  // For now, same as default
+    auto engine = create_default_engine();
+    engine->register_tool(std::make_unique<tools::BannedTokenTool>());
+    
+    for (const auto& tool_name : AnalysisToolRegistry::instance().get_available_tools()) {
+        if (!engine->get_tool(tool_name)) {
+            if (auto tool = AnalysisToolRegistry::instance().create_tool(tool_name)) {
+                engine->register_tool(std::move(tool));
+            }
+        }
+    }
+    
+    return engine;
 }
 
 } // namespace analysis
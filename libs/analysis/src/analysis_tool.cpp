@@ -1,9 +1,171 @@
 #include "analysis_tool.h"
+#include "compilation_database.h"
+#include <directory_walker.h>
+#include <pattern_matcher.h>
+#include <algorithm>
+#include <filesystem>
+#include <mutex>
 #include <stdexcept>
 
 namespace wip {
 namespace analysis {
 
+namespace {
+
+// Files analyzed directly; headers are reached through the units that include them
+const std::vector<std::string>& translation_unit_extensions() {
+    static const std::vector<std::string> extensions = {".cpp", ".cxx", ".cc", ".c", ".m", ".mm"};
+    return extensions;
+}
+
+// Drops the units matching the request's exclude patterns. Units are matched
+// by their path relative to the source path, or as given when outside it; all
+// patterns are compiled into one automaton, so the cost does not grow with them.
+void remove_excluded_units(std::vector<std::string>& units, const AnalysisRequest& request) {
+    if (request.exclude_patterns.empty() || units.empty()) {
+        return;
+    }
+    
+    const wip::utils::string::GlobMatcher matcher(request.exclude_patterns);
+    std::error_code ec;
+    std::filesystem::path source(request.source_path);
+    if (std::filesystem::is_regular_file(source, ec)) {
+        source = source.parent_path();
+    }
+    std::filesystem::path relative_root = source.lexically_normal();
+    std::filesystem::path absolute_root = std::filesystem::weakly_canonical(source, ec);
+    if (ec) {
+        absolute_root = std::filesystem::absolute(source).lexically_normal();
+    }
+    
+    units.erase(std::remove_if(units.begin(), units.end(), [&](const std::string& unit) {
+        std::filesystem::path path = std::filesystem::path(unit).lexically_normal();
+        auto relative = path.lexically_relative(path.is_absolute() ? absolute_root : relative_root);
+        bool inside = !relative.empty() && *relative.begin() != "..";
+        return matcher.matches((inside ? relative : path).generic_string());
+    }), units.end());
+}
+
+} // namespace
+
+// ==================== AnalysisTool Implementation ====================
+
+AnalysisTool::ActiveRun::ActiveRun(const AnalysisTool& tool, const AnalysisRequest& request)
+    : tool_(tool),
+      token_(request.cancellation.can_be_cancelled() ? request.cancellation
+                                                     : wip::utils::process::CancellationToken::create()) {
+    std::lock_guard<std::mutex> lock(tool_.active_runs_mutex_);
+    tool_.active_runs_.push_back(token_);
+}
+
+AnalysisTool::ActiveRun::~ActiveRun() {
+    std::lock_guard<std::mutex> lock(tool_.active_runs_mutex_);
+    auto& runs = tool_.active_runs_;
+    auto it = std::find(runs.begin(), runs.end(), token_);
+    if (it != runs.end()) {
+        runs.erase(it);
+    }
+}
+
+bool AnalysisTool::cancel_active_runs() {
+    std::lock_guard<std::mutex> lock(active_runs_mutex_);
+    for (const auto& token : active_runs_) {
+        token.cancel();
+    }
+    return !active_runs_.empty();
+}
+
+std::vector<std::string> AnalysisTool::get_translation_units(const AnalysisRequest& request) const {
+    return list_source_files(request, translation_unit_extensions());
+}
+
+std::vector<std::string> AnalysisTool::list_source_files(const AnalysisRequest& request,
+                                                         const std::vector<std::string>& extensions) {
+    std::vector<std::string> units;
+    
+    if (!request.source_files.empty()) {
+        units = request.source_files;
+    } else if (!request.source_path.empty()) {
+        std::error_code ec;
+        std::filesystem::path source(request.source_path);
+        
+        if (std::filesystem::is_regular_file(source, ec)) {
+            units.push_back(request.source_path);
+        } else if (std::filesystem::is_directory(source, ec)) {
+            // Subtrees are scanned in parallel, skipping hidden and build
+            // directories; the sort below restores a stable order
+            wip::utils::file::WalkOptions options;
+            options.extensions = extensions;
+            options.prune_directories = {".*", "build", "_build", "Debug", "Release", "CMakeFiles"};
+            std::mutex units_mutex;
+            wip::utils::file::walk_directory(source, options, [&](const std::filesystem::directory_entry& entry) {
+                std::error_code status_error;
+                if (entry.is_regular_file(status_error)) {
+                    std::string path = entry.path().string();
+                    std::lock_guard<std::mutex> lock(units_mutex);
+                    units.push_back(std::move(path));
+                }
+            });
+        }
+    }
+    
+    remove_excluded_units(units, request);
+    std::sort(units.begin(), units.end());
+    units.erase(std::unique(units.begin(), units.end()), units.end());
+    
+    return units;
+}
+
+std::string AnalysisTool::find_compilation_database_directory(const std::string& source_path) {
+    std::filesystem::path source(source_path);
+    
+    // If source_path is a file, get its directory
+    if (std::filesystem::is_regular_file(source)) {
+        source = source.parent_path();
+    }
+    
+    // Common build directory names to search for
+    std::vector<std::string> build_dirs = {"build", "_build", "Debug", "Release"};
+    
+    // Search up the directory tree
+    std::filesystem::path current = source;
+    while (!current.empty() && current != current.parent_path()) {
+        for (const auto& build_dir : build_dirs) {
+            std::filesystem::path build_path = current / build_dir;
+            if (std::filesystem::exists(build_path / "compile_commands.json")) {
+                return build_path.string();
+            }
+        }
+        current = current.parent_path();
+    }
+    
+    return "";
+}
+
+std::vector<std::string> AnalysisTool::read_compilation_database(const std::string& build_dir,
+                                                                const std::string& source_path) {
+    auto database = CompilationDatabase::open(build_dir);
+    return database ? database->get_units(source_path) : std::vector<std::string>();
+}
+
+std::vector<std::string> AnalysisTool::get_compilation_database_units(const AnalysisRequest& request) {
+    std::error_code ec;
+    if (!request.source_files.empty() || !std::filesystem::is_directory(request.source_path, ec)) {
+        return {};
+    }
+    
+    std::string build_dir = find_compilation_database_directory(request.source_path);
+    if (build_dir.empty()) {
+        return {};
+    }
+    
+    auto units = read_compilation_database(build_dir, request.source_path);
+    remove_excluded_units(units, request);
+    std::sort(units.begin(), units.end());
+    units.erase(std::unique(units.begin(), units.end()), units.end());
+    return units;
+}
+
 // ==================== AnalysisToolRegistry Implementation ====================
 
 AnalysisToolRegistry& AnalysisToolRegistry::instance() {
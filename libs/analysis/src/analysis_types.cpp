@@ -6,6 +6,18 @@
 namespace wip {
 namespace analysis {
 
+// ==================== IssueKey Implementation ====================
+
+size_t IssueKeyHash::operator()(const IssueKey& key) const {
+    size_t seed = std::hash<std::string_view>{}(key.file_path);
+    auto combine = [&seed](size_t value) {
+        seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+    };
+    combine(std::hash<int>{}(key.line_number));
+    combine(std::hash<std::string_view>{}(key.rule_id));
+    return seed;
+}
+
 // ==================== AnalysisIssue Implementation ====================
 
 nlohmann::json AnalysisIssue::to_json() const {
@@ -59,21 +71,138 @@ bool AnalysisIssue::operator==(const AnalysisIssue& other) const {
            fix_suggestion == other.fix_suggestion;
 }
 
+// ==================== ExecutionProfile Implementation ====================
+
+void ExecutionProfile::add_process(const wip::utils::process::ProcessResult& process_result) {
+    spawn_time += process_result.spawn_time;
+    process_time += process_result.duration;
+    tool_cpu_time += process_result.cpu_time;
+    tool_user_cpu_time += process_result.user_cpu_time;
+    tool_system_cpu_time += process_result.system_cpu_time;
+    capture_time += process_result.capture_time;
+    ++process_count;
+    peak_rss_kb = std::max(peak_rss_kb, process_result.max_rss_kb);
+    voluntary_context_switches += process_result.voluntary_context_switches;
+    involuntary_context_switches += process_result.involuntary_context_switches;
+}
+
+ExecutionProfile& ExecutionProfile::operator+=(const ExecutionProfile& other) {
+    spawn_time += other.spawn_time;
+    process_time += other.process_time;
+    tool_cpu_time += other.tool_cpu_time;
+    tool_user_cpu_time += other.tool_user_cpu_time;
+    tool_system_cpu_time += other.tool_system_cpu_time;
+    capture_time += other.capture_time;
+    precompile_time += other.precompile_time;
+    parse_time += other.parse_time;
+    aggregate_time += other.aggregate_time;
+    process_count += other.process_count;
+    tool_cache_lookups += other.tool_cache_lookups;
+    tool_cache_hits += other.tool_cache_hits;
+    peak_rss_kb = std::max(peak_rss_kb, other.peak_rss_kb);
+    voluntary_context_switches += other.voluntary_context_switches;
+    involuntary_context_switches += other.involuntary_context_switches;
+    for (const auto& [unit, time] : other.unit_cpu_times) {
+        unit_cpu_times[unit] += time;
+    }
+    for (const auto& [unit, rss] : other.unit_peak_rss_kb) {
+        auto& peak = unit_peak_rss_kb[unit];
+        peak = std::max(peak, rss);
+    }
+    return *this;
+}
+
+nlohmann::json ExecutionProfile::to_json() const {
+    auto to_us = [](std::chrono::nanoseconds duration) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    };
+    
+    nlohmann::json j;
+    j["spawn_us"] = to_us(spawn_time);
+    j["process_us"] = to_us(process_time);
+    j["tool_cpu_us"] = to_us(tool_cpu_time);
+    j["tool_user_cpu_us"] = to_us(tool_user_cpu_time);
+    j["tool_system_cpu_us"] = to_us(tool_system_cpu_time);
+    j["capture_us"] = to_us(capture_time);
+    j["precompile_us"] = to_us(precompile_time);
+    j["parse_us"] = to_us(parse_time);
+    j["aggregate_us"] = to_us(aggregate_time);
+    j["process_count"] = process_count;
+    j["tool_cache_lookups"] = tool_cache_lookups;
+    j["tool_cache_hits"] = tool_cache_hits;
+    j["peak_rss_kb"] = peak_rss_kb;
+    j["voluntary_context_switches"] = voluntary_context_switches;
+    j["involuntary_context_switches"] = involuntary_context_switches;
+    if (!unit_cpu_times.empty()) {
+        auto& units = j["unit_cpu_us"] = nlohmann::json::object();
+        for (const auto& [unit, time] : unit_cpu_times) {
+            units[unit] = to_us(time);
+        }
+    }
+    if (!unit_peak_rss_kb.empty()) {
+        j["unit_peak_rss_kb"] = unit_peak_rss_kb;
+    }
+    return j;
+}
+
+ExecutionProfile ExecutionProfile::from_json(const nlohmann::json& j) {
+    auto from_us = [&j](const char* key) {
+        return std::chrono::nanoseconds(std::chrono::microseconds(j.value(key, int64_t(0))));
+    };
+    
+    ExecutionProfile profile;
+    profile.spawn_time = from_us("spawn_us");
+    profile.process_time = from_us("process_us");
+    profile.tool_cpu_time = from_us("tool_cpu_us");
+    profile.tool_user_cpu_time = from_us("tool_user_cpu_us");
+    profile.tool_system_cpu_time = from_us("tool_system_cpu_us");
+    profile.capture_time = from_us("capture_us");
+    profile.precompile_time = from_us("precompile_us");
+    profile.parse_time = from_us("parse_us");
+    profile.aggregate_time = from_us("aggregate_us");
+    profile.process_count = j.value("process_count", size_t(0));
+    profile.tool_cache_lookups = j.value("tool_cache_lookups", size_t(0));
+    profile.tool_cache_hits = j.value("tool_cache_hits", size_t(0));
+    profile.peak_rss_kb = j.value("peak_rss_kb", size_t(0));
+    profile.voluntary_context_switches = j.value("voluntary_context_switches", size_t(0));
+    profile.involuntary_context_switches = j.value("involuntary_context_switches", size_t(0));
+    if (j.contains("unit_cpu_us") && j["unit_cpu_us"].is_object()) {
+        for (const auto& [unit, time] : j["unit_cpu_us"].items()) {
+            profile.unit_cpu_times[unit] = std::chrono::microseconds(time.get<int64_t>());
+        }
+    }
+    if (j.contains("unit_peak_rss_kb") && j["unit_peak_rss_kb"].is_object()) {
+        for (const auto& [unit, rss] : j["unit_peak_rss_kb"].items()) {
+            profile.unit_peak_rss_kb[unit] = rss.get<size_t>();
+        }
+    }
+    return profile;
+}
+
 // ==================== AnalysisResult Implementation ====================
 
 void AnalysisResult::add_issue(const AnalysisIssue& issue) {
     issues.push_back(issue);
-    compute_statistics();
+    ++issue_counts_by_severity[static_cast<size_t>(issue.severity)];
+    ++issue_counts_by_category[static_cast<size_t>(issue.category)];
 }
 
 void AnalysisResult::compute_statistics() {
-    issue_counts_by_severity.clear();
-    issue_counts_by_category.clear();
+    issue_counts_by_severity.fill(0);
+    issue_counts_by_category.fill(0);
     
     for (const auto& issue : issues) {
-        issue_counts_by_severity[issue.severity]++;
-        issue_counts_by_category[issue.category]++;
+        ++issue_counts_by_severity[static_cast<size_t>(issue.severity)];
+        ++issue_counts_by_category[static_cast<size_t>(issue.category)];
+    }
+}
+
+bool AnalysisResult::has_current_statistics() const {
+    size_t severity_total = 0;
+    for (size_t count : issue_counts_by_severity) {
+        severity_total += count;
     }
+    return severity_total == issues.size();
 }
 
 std::vector<AnalysisIssue> AnalysisResult::get_issues_by_severity(IssueSeverity min_severity) const {
@@ -115,6 +244,10 @@ nlohmann::json AnalysisResult::to_json() const {
     j["execution_time_ms"] = execution_time.count();
     j["success"] = success;
     j["error_message"] = error_message;
+    if (stopped_early) {
+        j["stopped_early"] = true;
+    }
+    j["profile"] = profile.to_json();
     
     // Convert issues to JSON array
     nlohmann::json issues_json = nlohmann::json::array();
@@ -125,14 +258,18 @@ nlohmann::json AnalysisResult::to_json() const {
     
     // Add statistics
     nlohmann::json severity_stats;
-    for (const auto& [severity, count] : issue_counts_by_severity) {
-        severity_stats[severity_to_string(severity)] = count;
+    for (size_t i = 0; i < ISSUE_SEVERITY_COUNT; ++i) {
+        if (issue_counts_by_severity[i] > 0) {
+            severity_stats[severity_to_string(static_cast<IssueSeverity>(i))] = issue_counts_by_severity[i];
+        }
     }
     j["issue_counts_by_severity"] = severity_stats;
     
     nlohmann::json category_stats;
-    for (const auto& [category, count] : issue_counts_by_category) {
-        category_stats[category_to_string(category)] = count;
+    for (size_t i = 0; i < ISSUE_CATEGORY_COUNT; ++i) {
+        if (issue_counts_by_category[i] > 0) {
+            category_stats[category_to_string(static_cast<IssueCategory>(i))] = issue_counts_by_category[i];
+        }
     }
     j["issue_counts_by_category"] = category_stats;
     
@@ -157,6 +294,10 @@ AnalysisResult AnalysisResult::from_json(const nlohmann::json& j) {
     result.execution_time = std::chrono::milliseconds(j.value("execution_time_ms", 0));
     result.success = j.value("success", false);
     result.error_message = j.value("error_message", "");
+    result.stopped_early = j.value("stopped_early", false);
+    if (j.contains("profile") && j["profile"].is_object()) {
+        result.profile = ExecutionProfile::from_json(j["profile"]);
+    }
     
     // Parse issues
     if (j.contains("issues") && j["issues"].is_array()) {
@@ -185,8 +326,21 @@ nlohmann::json AnalysisRequest::to_json() const {
     nlohmann::json j;
     j["source_path"] = source_path;
     j["output_file"] = output_file;
+    j["source_files"] = source_files;
+    j["exclude_patterns"] = exclude_patterns;
     j["include_paths"] = include_paths;
     j["definitions"] = definitions;
+    j["max_parallel_jobs"] = max_parallel_jobs;
+    if (!changed_ranges.empty()) {
+        nlohmann::json ranges = nlohmann::json::array();
+        for (const auto& range : changed_ranges) {
+            ranges.push_back({{"file", range.file}, {"first_line", range.first_line}, {"last_line", range.last_line}});
+        }
+        j["changed_ranges"] = std::move(ranges);
+    }
+    if (stop_on_severity) {
+        j["stop_on_severity"] = severity_to_string(*stop_on_severity);
+    }
     j["tool_specific_options"] = tool_specific_options;
     return j;
 }
@@ -196,6 +350,14 @@ AnalysisRequest AnalysisRequest::from_json(const nlohmann::json& j) {
     request.source_path = j.value("source_path", "");
     request.output_file = j.value("output_file", "");
     
+    if (j.contains("source_files") && j["source_files"].is_array()) {
+        request.source_files = j["source_files"].get<std::vector<std::string>>();
+    }
+    
+    if (j.contains("exclude_patterns") && j["exclude_patterns"].is_array()) {
+        request.exclude_patterns = j["exclude_patterns"].get<std::vector<std::string>>();
+    }
+    
     if (j.contains("include_paths") && j["include_paths"].is_array()) {
         request.include_paths = j["include_paths"].get<std::vector<std::string>>();
     }
@@ -204,6 +366,18 @@ AnalysisRequest AnalysisRequest::from_json(const nlohmann::json& j) {
         request.definitions = j["definitions"].get<std::vector<std::string>>();
     }
     
+    request.max_parallel_jobs = j.value("max_parallel_jobs", static_cast<size_t>(0));
+    
+    if (j.contains("changed_ranges") && j["changed_ranges"].is_array()) {
+        for (const auto& range : j["changed_ranges"]) {
+            request.changed_ranges.push_back({range.value("file", ""), range.value("first_line", 0), range.value("last_line", 0)});
+        }
+    }
+    
+    if (j.contains("stop_on_severity") && j["stop_on_severity"].is_string()) {
+        request.stop_on_severity = string_to_severity(j["stop_on_severity"].get<std::string>());
+    }
+    
     if (j.contains("tool_specific_options")) {
         request.tool_specific_options = j["tool_specific_options"];
     }
@@ -0,0 +1,81 @@
+#include "changed_lines.h"
+#include <algorithm>
+#include <climits>
+#include <filesystem>
+
+namespace wip {
+namespace analysis {
+
+namespace {
+
+std::string normalize(const std::string& file) {
+    std::error_code ec;
+    auto absolute = std::filesystem::absolute(file, ec);
+    return (ec ? std::filesystem::path(file) : absolute).lexically_normal().string();
+}
+
+} // anonymous namespace
+
+ChangedLines::ChangedLines(const std::vector<ChangedRange>& ranges) {
+    for (const auto& range : ranges) {
+        if (range.file.empty()) {
+            continue;
+        }
+        files_[normalize(range.file)].emplace_back(range.first_line, std::max(range.first_line, range.last_line));
+    }
+
+    for (auto& [file, file_ranges] : files_) {
+        std::sort(file_ranges.begin(), file_ranges.end());
+        Ranges merged;
+        for (const auto& range : file_ranges) {
+            if (!merged.empty() && range.first <= merged.back().second + 1) {
+                merged.back().second = std::max(merged.back().second, range.second);
+            } else {
+                merged.push_back(range);
+            }
+        }
+        file_ranges = std::move(merged);
+    }
+}
+
+std::vector<std::string> ChangedLines::get_files() const {
+    std::vector<std::string> files;
+    files.reserve(files_.size());
+    for (const auto& [file, ranges] : files_) {
+        files.push_back(file);
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+const ChangedLines::Ranges* ChangedLines::find(const std::string& file) const {
+    if (file.empty()) {
+        return nullptr;
+    }
+    // Tools mostly report the absolute paths they were given; normalize only the others
+    auto it = files_.find(file);
+    if (it == files_.end()) {
+        it = files_.find(normalize(file));
+    }
+    return it == files_.end() ? nullptr : &it->second;
+}
+
+bool ChangedLines::contains_file(const std::string& file) const {
+    return find(file) != nullptr;
+}
+
+bool ChangedLines::contains(const std::string& file, int line) const {
+    const Ranges* ranges = find(file);
+    if (!ranges) {
+        return false;
+    }
+    if (line <= 0) {
+        return true;
+    }
+    // First range starting after the line; the one before it is the only candidate
+    auto it = std::upper_bound(ranges->begin(), ranges->end(), std::make_pair(line, INT_MAX));
+    return it != ranges->begin() && std::prev(it)->second >= line;
+}
+
+} // namespace analysis
+} // namespace wip
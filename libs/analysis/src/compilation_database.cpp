@@ -0,0 +1,464 @@
+#include "compilation_database.h"
+#include <mapped_file.h>
+#include <cctype>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <nlohmann/json.hpp>
+
+namespace wip {
+namespace analysis {
+
+namespace {
+
+// Reads a database straight from its text. Only the entries' strings are
+// copied, a run of plain characters at a time; other values are skipped
+// without being decoded, so no JSON document of the file is ever built.
+class DatabaseReader {
+public:
+    explicit DatabaseReader(std::string_view json) : pos_(json.data()), end_(json.data() + json.size()) {}
+
+    bool read(std::vector<CompilationDatabase::Entry>& entries) {
+        skip_space();
+        if (!consume('[')) {
+            return false;
+        }
+        skip_space();
+        if (consume(']')) {
+            return at_end();
+        }
+        while (true) {
+            skip_space();
+            if (peek() == '{') {
+                CompilationDatabase::Entry entry;
+                if (!read_entry(entry)) {
+                    return false;
+                }
+                if (!entry.file.empty() && (!entry.arguments.empty() || !entry.command.empty())) {
+                    finish_entry(entry);
+                    entries.push_back(std::move(entry));
+                }
+            } else if (!skip_value(0)) {
+                return false;
+            }
+            skip_space();
+            if (consume(']')) {
+                return at_end();
+            }
+            if (!consume(',')) {
+                return false;
+            }
+        }
+    }
+
+private:
+    static constexpr int MAX_DEPTH = 256;
+
+    char peek() const { return pos_ < end_ ? *pos_ : '\0'; }
+
+    bool consume(char c) {
+        if (pos_ < end_ && *pos_ == c) {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    bool at_end() {
+        skip_space();
+        return pos_ == end_;
+    }
+
+    void skip_space() {
+        while (pos_ < end_ && (*pos_ == ' ' || *pos_ == '\n' || *pos_ == '\r' || *pos_ == '\t')) {
+            ++pos_;
+        }
+    }
+
+    bool read_entry(CompilationDatabase::Entry& entry) {
+        ++pos_;
+        skip_space();
+        if (consume('}')) {
+            return true;
+        }
+        std::string key;
+        while (true) {
+            skip_space();
+            key.clear();
+            if (!read_string(key)) {
+                return false;
+            }
+            skip_space();
+            if (!consume(':')) {
+                return false;
+            }
+            skip_space();
+
+            std::string* field = key == "file" ? &entry.file
+                : key == "directory" ? &entry.directory
+                : key == "command" ? &entry.command
+                : key == "output" ? &entry.output : nullptr;
+            bool ok;
+            if (field && peek() == '"') {
+                ok = read_string(*field);
+            } else if (key == "arguments" && peek() == '[') {
+                ok = read_arguments(entry.arguments);
+            } else {
+                ok = skip_value(1);
+            }
+            if (!ok) {
+                return false;
+            }
+
+            skip_space();
+            if (consume('}')) {
+                return true;
+            }
+            if (!consume(',')) {
+                return false;
+            }
+        }
+    }
+
+    bool read_arguments(std::vector<std::string>& arguments) {
+        ++pos_;
+        skip_space();
+        if (consume(']')) {
+            return true;
+        }
+        while (true) {
+            skip_space();
+            if (peek() == '"') {
+                arguments.emplace_back();
+                if (!read_string(arguments.back())) {
+                    return false;
+                }
+            } else if (!skip_value(2)) {
+                return false;
+            }
+            skip_space();
+            if (consume(']')) {
+                return true;
+            }
+            if (!consume(',')) {
+                return false;
+            }
+        }
+    }
+
+    bool read_string(std::string& out) {
+        if (!consume('"')) {
+            return false;
+        }
+        while (true) {
+            const char* run = pos_;
+            while (pos_ < end_ && *pos_ != '"' && *pos_ != '\\') {
+                ++pos_;
+            }
+            out.append(run, static_cast<size_t>(pos_ - run));
+            if (pos_ == end_) {
+                return false;
+            }
+            if (*pos_++ == '"') {
+                return true;
+            }
+            if (!read_escape(out)) {
+                return false;
+            }
+        }
+    }
+
+    bool read_escape(std::string& out) {
+        if (pos_ == end_) {
+            return false;
+        }
+        switch (char c = *pos_++) {
+        case '"': case '\\': case '/': out += c; return true;
+        case 'b': out += '\b'; return true;
+        case 'f': out += '\f'; return true;
+        case 'n': out += '\n'; return true;
+        case 'r': out += '\r'; return true;
+        case 't': out += '\t'; return true;
+        case 'u': break;
+        default: return false;
+        }
+
+        uint32_t code_point;
+        if (!read_hex(code_point)) {
+            return false;
+        }
+        if (code_point >= 0xD800 && code_point < 0xDC00) {
+            uint32_t low;
+            if (end_ - pos_ < 2 || pos_[0] != '\\' || pos_[1] != 'u') {
+                return false;
+            }
+            pos_ += 2;
+            if (!read_hex(low) || low < 0xDC00 || low > 0xDFFF) {
+                return false;
+            }
+            code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+        }
+        append_utf8(out, code_point);
+        return true;
+    }
+
+    bool read_hex(uint32_t& value) {
+        if (end_ - pos_ < 4) {
+            return false;
+        }
+        value = 0;
+        for (int i = 0; i < 4; ++i) {
+            char c = *pos_++;
+            value <<= 4;
+            if (c >= '0' && c <= '9') {
+                value |= static_cast<uint32_t>(c - '0');
+            } else if (c >= 'a' && c <= 'f') {
+                value |= static_cast<uint32_t>(c - 'a' + 10);
+            } else if (c >= 'A' && c <= 'F') {
+                value |= static_cast<uint32_t>(c - 'A' + 10);
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static void append_utf8(std::string& out, uint32_t code_point) {
+        if (code_point < 0x80) {
+            out += static_cast<char>(code_point);
+        } else if (code_point < 0x800) {
+            out += static_cast<char>(0xC0 | (code_point >> 6));
+            out += static_cast<char>(0x80 | (code_point & 0x3F));
+        } else if (code_point < 0x10000) {
+            out += static_cast<char>(0xE0 | (code_point >> 12));
+            out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code_point & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (code_point >> 18));
+            out += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code_point & 0x3F));
+        }
+    }
+
+    bool skip_value(int depth) {
+        if (depth > MAX_DEPTH) {
+            return false;
+        }
+        char c = peek();
+        if (c == '"') {
+            ++pos_;
+            while (pos_ < end_ && *pos_ != '"') {
+                if (*pos_ == '\\' && ++pos_ == end_) {
+                    return false;
+                }
+                ++pos_;
+            }
+            return pos_++ < end_;
+        }
+        if (c == '{' || c == '[') {
+            char close = c == '{' ? '}' : ']';
+            ++pos_;
+            skip_space();
+            if (consume(close)) {
+                return true;
+            }
+            while (true) {
+                skip_space();
+                if (c == '{') {
+                    if (!skip_value(depth + 1) || (skip_space(), !consume(':'))) {
+                        return false;
+                    }
+                    skip_space();
+                }
+                if (!skip_value(depth + 1)) {
+                    return false;
+                }
+                skip_space();
+                if (consume(close)) {
+                    return true;
+                }
+                if (!consume(',')) {
+                    return false;
+                }
+            }
+        }
+        const char* start = pos_;
+        while (pos_ < end_ && (std::isalnum(static_cast<unsigned char>(*pos_)) || *pos_ == '-' ||
+                               *pos_ == '+' || *pos_ == '.')) {
+            ++pos_;
+        }
+        return pos_ != start;
+    }
+
+    static void finish_entry(CompilationDatabase::Entry& entry) {
+        if (!entry.arguments.empty()) {
+            entry.command.clear();
+        }
+        std::filesystem::path file_path = entry.file;
+        if (file_path.is_relative()) {
+            file_path = std::filesystem::path(entry.directory) / file_path;
+        }
+        entry.file = file_path.lexically_normal().string();
+    }
+
+    const char* pos_;
+    const char* end_;
+};
+
+struct LoadedDatabase {
+    std::shared_ptr<const CompilationDatabase> database;
+    std::filesystem::file_time_type write_time;
+    uintmax_t size = 0;
+};
+
+std::string normalize(const std::string& path) {
+    std::error_code ec;
+    auto absolute = std::filesystem::absolute(path, ec);
+    auto normal = (ec ? std::filesystem::path(path) : absolute).lexically_normal();
+    return (normal.has_filename() ? normal : normal.parent_path()).string();
+}
+
+} // namespace
+
+std::vector<std::string> CompilationDatabase::Entry::get_arguments() const {
+    return arguments.empty() ? split_command(command) : arguments;
+}
+
+std::shared_ptr<const CompilationDatabase> CompilationDatabase::open(const std::string& build_dir) {
+    static std::mutex mutex;
+    static std::map<std::string, LoadedDatabase> loaded;
+
+    std::string key = normalize(build_dir);
+    auto path = std::filesystem::path(key) / "compile_commands.json";
+
+    // Shards asking at the same time wait for one parse instead of each doing their own
+    std::lock_guard<std::mutex> lock(mutex);
+    std::error_code ec;
+    auto write_time = std::filesystem::last_write_time(path, ec);
+    auto size = ec ? 0 : std::filesystem::file_size(path, ec);
+    if (ec) {
+        loaded.erase(key);
+        return nullptr;
+    }
+
+    auto it = loaded.find(key);
+    if (it != loaded.end() && it->second.write_time == write_time && it->second.size == size) {
+        return it->second.database;
+    }
+
+    auto file = wip::utils::file::MappedFile::open(path);
+    LoadedDatabase database{file ? parse(file->view(), build_dir) : nullptr, write_time, size};
+    loaded[key] = database;
+    return database.database;
+}
+
+std::shared_ptr<const CompilationDatabase> CompilationDatabase::parse(std::string_view json, const std::string& build_dir) {
+    auto database = std::make_shared<CompilationDatabase>();
+    database->build_dir_ = build_dir;
+
+    if (!DatabaseReader(json).read(database->entries_)) {
+        return nullptr;
+    }
+
+    database->index_.reserve(database->entries_.size());
+    for (size_t i = 0; i < database->entries_.size(); ++i) {
+        database->index_.emplace(database->entries_[i].file, i);
+    }
+    return database;
+}
+
+std::vector<std::string> CompilationDatabase::split_command(std::string_view command) {
+    std::vector<std::string> arguments;
+    std::string current;
+    bool in_argument = false;
+    char quote = 0;
+    for (size_t i = 0; i < command.size(); ++i) {
+        char c = command[i];
+        if (quote == '\'') {
+            if (c == '\'') {
+                quote = 0;
+            } else {
+                current += c;
+            }
+        } else if (c == '\\' && i + 1 < command.size() && (quote == 0 || command[i + 1] == '"' || command[i + 1] == '\\')) {
+            current += command[++i];
+            in_argument = true;
+        } else if (quote == '"') {
+            if (c == '"') {
+                quote = 0;
+            } else {
+                current += c;
+            }
+        } else if (c == '\'' || c == '"') {
+            quote = c;
+            in_argument = true;
+        } else if (std::isspace(static_cast<unsigned char>(c))) {
+            if (in_argument) {
+                arguments.push_back(std::move(current));
+                current.clear();
+                in_argument = false;
+            }
+        } else {
+            current += c;
+            in_argument = true;
+        }
+    }
+    if (in_argument) {
+        arguments.push_back(std::move(current));
+    }
+    return arguments;
+}
+
+const CompilationDatabase::Entry* CompilationDatabase::find(const std::string& file) const {
+    auto it = index_.find(normalize(file));
+    return it == index_.end() ? nullptr : &entries_[it->second];
+}
+
+std::vector<std::string> CompilationDatabase::get_units(const std::string& source_path) const {
+    std::error_code ec;
+    std::filesystem::path source(source_path);
+    std::filesystem::path source_root = std::filesystem::weakly_canonical(source, ec);
+    if (ec) {
+        source_root = std::filesystem::absolute(source).lexically_normal();
+    }
+
+    std::vector<std::string> units;
+    for (const auto& entry : entries_) {
+        // Only keep TUs that live under the requested source path
+        auto relative = std::filesystem::path(entry.file).lexically_relative(source_root);
+        if (relative.empty() || *relative.begin() == "..") {
+            continue;
+        }
+        units.push_back(entry.file);
+    }
+    return units;
+}
+
+size_t CompilationDatabase::write_subset(const std::vector<std::string>& units, const std::filesystem::path& directory) const {
+    nlohmann::json subset = nlohmann::json::array();
+    for (const auto& unit : units) {
+        const Entry* entry = find(unit);
+        if (!entry) {
+            continue;
+        }
+        nlohmann::json object = {{"directory", entry->directory}, {"file", entry->file}};
+        if (entry->arguments.empty()) {
+            object["command"] = entry->command;
+        } else {
+            object["arguments"] = entry->arguments;
+        }
+        if (!entry->output.empty()) {
+            object["output"] = entry->output;
+        }
+        subset.push_back(std::move(object));
+    }
+
+    std::ofstream file(directory / "compile_commands.json");
+    file << subset.dump();
+    return file ? subset.size() : 0;
+}
+
+} // namespace analysis
+} // namespace wip
@@ -0,0 +1,158 @@
+#include "concurrency_governor.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace wip {
+namespace analysis {
+
+namespace {
+
+size_t get_cpu_count() {
+#ifdef __linux__
+    // The affinity mask reflects taskset and cpuset limits, unlike hardware_concurrency()
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0) {
+        int count = CPU_COUNT(&cpu_set);
+        if (count > 0) {
+            return static_cast<size_t>(count);
+        }
+    }
+#endif
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+size_t get_available_memory_mb() {
+    std::ifstream meminfo("/proc/meminfo");
+    std::string line;
+    while (std::getline(meminfo, line)) {
+        if (line.compare(0, 13, "MemAvailable:") == 0) {
+            std::istringstream fields(line.substr(13));
+            size_t kilobytes = 0;
+            if (fields >> kilobytes) {
+                return kilobytes / 1024;
+            }
+        }
+    }
+    return 0;
+}
+
+double get_load_average() {
+#if defined(__linux__) || defined(__APPLE__) || defined(__unix__)
+    double load = 0.0;
+    if (getloadavg(&load, 1) == 1) {
+        return load;
+    }
+#endif
+    return -1.0;
+}
+
+} // namespace
+
+SystemResources SystemResources::probe() {
+    SystemResources resources;
+    resources.cpu_count = get_cpu_count();
+    resources.available_memory_mb = get_available_memory_mb();
+    resources.load_average = get_load_average();
+    return resources;
+}
+
+ConcurrencyGovernor::Lease& ConcurrencyGovernor::Lease::operator=(Lease&& other) noexcept {
+    if (this != &other) {
+        release();
+        governor_ = other.governor_;
+        slots_ = other.slots_;
+        other.governor_ = nullptr;
+        other.slots_ = 0;
+    }
+    return *this;
+}
+
+void ConcurrencyGovernor::Lease::release() {
+    if (governor_) {
+        governor_->release(slots_);
+        governor_ = nullptr;
+    }
+}
+
+ConcurrencyGovernor::ConcurrencyGovernor() : ConcurrencyGovernor(Options{}) {
+}
+
+ConcurrencyGovernor::ConcurrencyGovernor(Options options) : options_(options) {
+}
+
+size_t ConcurrencyGovernor::compute_budget(const SystemResources& resources, const Options& options) {
+    size_t budget = std::max<size_t>(1, resources.cpu_count);
+
+    // CPUs kept busy by other processes are not ours to use
+    if (options.use_load_average && resources.load_average > 0.0) {
+        auto busy = static_cast<size_t>(std::lround(resources.load_average));
+        budget = busy < budget ? budget - busy : 1;
+    }
+
+    // More jobs than fit into memory would only make the machine swap
+    if (options.memory_per_job_mb > 0 && resources.available_memory_mb > 0) {
+        budget = std::min(budget, resources.available_memory_mb / options.memory_per_job_mb);
+    }
+
+    if (options.max_workers > 0) {
+        budget = std::min(budget, options.max_workers);
+    }
+
+    return std::max<size_t>(1, budget);
+}
+
+size_t ConcurrencyGovernor::compute_budget() const {
+    SystemResources resources = SystemResources::probe();
+
+    // Our own jobs show up in the load average as well
+    if (resources.load_average > 0.0) {
+        resources.load_average = std::max(0.0, resources.load_average - static_cast<double>(get_slots_in_use()));
+    }
+
+    return compute_budget(resources, options_);
+}
+
+void ConcurrencyGovernor::begin_run(size_t budget) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    budget_ = std::max<size_t>(1, budget);
+}
+
+ConcurrencyGovernor::Lease ConcurrencyGovernor::acquire(size_t pending_jobs, size_t idle_workers) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Split the free slots evenly between this job and the ones starting next to it
+    size_t free_slots = budget_ > in_use_ ? budget_ - in_use_ : 0;
+    size_t starting = 1 + std::min(idle_workers, pending_jobs > 0 ? pending_jobs - 1 : 0);
+    size_t slots = std::max<size_t>(1, free_slots / starting);
+
+    in_use_ += slots;
+    return Lease(this, slots);
+}
+
+size_t ConcurrencyGovernor::get_budget() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return budget_;
+}
+
+size_t ConcurrencyGovernor::get_slots_in_use() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return in_use_;
+}
+
+void ConcurrencyGovernor::release(size_t slots) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    in_use_ -= std::min(in_use_, slots);
+}
+
+} // namespace analysis
+} // namespace wip
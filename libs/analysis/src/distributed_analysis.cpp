@@ -0,0 +1,390 @@
+#include "distributed_analysis.h"
+#include "analysis_engine.h"
+#include "result_file.h"
+#include <log.h>
+#include <algorithm>
+
+namespace wip {
+namespace analysis {
+
+using wip::utils::net::Endpoint;
+using wip::utils::net::FramedSocket;
+using wip::utils::net::NetworkError;
+
+namespace {
+
+AnalysisResult make_failed_result(const std::string& tool_name, const std::string& error_message) {
+    AnalysisResult result;
+    result.tool_name = tool_name;
+    result.timestamp = std::chrono::system_clock::now();
+    result.success = false;
+    result.error_message = error_message;
+    return result;
+}
+
+std::string encode_result(const AnalysisResult& result) {
+    nlohmann::json head;
+    head["profile"] = result.profile.to_json();
+    std::string head_text = head.dump();
+
+    auto size = static_cast<uint32_t>(head_text.size());
+    std::string payload = {static_cast<char>(size >> 24), static_cast<char>(size >> 16),
+                           static_cast<char>(size >> 8), static_cast<char>(size)};
+    payload += head_text;
+    payload += BinaryResultFile::serialize({result});
+    return payload;
+}
+
+AnalysisResult decode_result(std::string_view payload) {
+    if (payload.size() < 4) {
+        throw std::runtime_error("Shard result too short");
+    }
+    auto bytes = reinterpret_cast<const unsigned char*>(payload.data());
+    size_t head_size = (size_t{bytes[0]} << 24) | (size_t{bytes[1]} << 16) | (size_t{bytes[2]} << 8) | bytes[3];
+    if (head_size > payload.size() - 4) {
+        throw std::runtime_error("Shard result head out of bounds");
+    }
+
+    auto head = nlohmann::json::parse(payload.substr(4, head_size));
+    auto results = BinaryResultFile::deserialize(payload.substr(4 + head_size));
+    if (results.size() != 1) {
+        throw std::runtime_error("Shard result holds " + std::to_string(results.size()) + " results");
+    }
+    results[0].profile = ExecutionProfile::from_json(head.value("profile", nlohmann::json::object()));
+    return std::move(results[0]);
+}
+
+} // namespace
+
+// ==================== AnalysisCoordinator ====================
+
+AnalysisCoordinator::AnalysisCoordinator(std::vector<Endpoint> workers)
+    : AnalysisCoordinator(std::move(workers), Options{}) {}
+
+AnalysisCoordinator::AnalysisCoordinator(std::vector<Endpoint> workers, Options options)
+    : options_(options) {
+    for (auto& endpoint : workers) {
+        workers_.push_back(Worker{std::move(endpoint), 0, false});
+    }
+}
+
+AnalysisCoordinator::~AnalysisCoordinator() = default;
+
+size_t AnalysisCoordinator::connect() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (size_t index = 0; index < workers_.size(); ++index) {
+        auto& worker = workers_[index];
+        if (worker.connected) {
+            continue;
+        }
+
+        // The first hello tells how many connections the worker wants
+        size_t slots = 1;
+        std::vector<FramedSocket> sockets;
+        try {
+            while (sockets.size() < slots) {
+                auto socket = FramedSocket::connect(worker.endpoint, options_.connect_timeout);
+                auto hello = socket.receive(options_.connect_timeout);
+                if (!hello || hello->type != static_cast<uint8_t>(RemoteFrame::Hello)) {
+                    throw NetworkError("No hello from worker");
+                }
+                auto info = nlohmann::json::parse(hello->payload);
+                if (info.value("protocol", 0) != REMOTE_PROTOCOL_VERSION) {
+                    throw NetworkError("Worker speaks protocol " + std::to_string(info.value("protocol", 0)));
+                }
+                if (sockets.empty()) {
+                    slots = std::max<size_t>(1, info.value("slots", size_t{1}));
+                }
+                sockets.push_back(std::move(socket));
+            }
+        } catch (const std::exception& e) {
+            LOG_WARNING("ANALYSIS_COORDINATOR", "Skipping worker ", worker.endpoint.to_string(), ": ", e.what());
+            continue;
+        }
+
+        for (auto& socket : sockets) {
+            lanes_.push_back(Lane{index, std::move(socket), false});
+        }
+        worker.slots = slots;
+        worker.connected = true;
+        LOG_INFO("ANALYSIS_COORDINATOR", "Connected to ", worker.endpoint.to_string(), " with ", slots, " slots");
+    }
+
+    return lanes_.size();
+}
+
+AnalysisResult AnalysisCoordinator::execute_shard(const AnalysisTool& tool, const AnalysisRequest& request) {
+    std::string tool_name = tool.get_name();
+
+    nlohmann::json message;
+    message["tool"] = tool_name;
+    message["tool_version"] = tool.get_version();
+    const ToolConfig* config = tool.get_configuration();
+    message["config"] = config ? config->to_json() : nlohmann::json();
+    message["request"] = request.to_json();
+    std::string payload = message.dump();
+
+    auto timeout = options_.shard_timeout.count() > 0 ? options_.shard_timeout : FramedSocket::NO_TIMEOUT;
+    std::string last_error = "no worker connected";
+
+    for (size_t attempt = 0; attempt < std::max<size_t>(1, options_.max_attempts); ++attempt) {
+        if (request.cancellation.is_cancelled()) {
+            return make_failed_result(tool_name, "Analysis cancelled");
+        }
+
+        Lane* lane = acquire_lane();
+        if (!lane) {
+            break;
+        }
+
+        try {
+            lane->socket.send(static_cast<uint8_t>(RemoteFrame::ShardRequest), payload);
+            auto reply = lane->socket.receive(timeout, request.cancellation);
+            if (!reply) {
+                throw NetworkError("Worker closed the connection");
+            }
+            release_lane(lane);
+
+            if (reply->type == static_cast<uint8_t>(RemoteFrame::ShardResult)) {
+                return decode_result(reply->payload);
+            }
+            if (reply->type == static_cast<uint8_t>(RemoteFrame::Error)) {
+                return make_failed_result(tool_name, "Worker refused shard: " + reply->payload);
+            }
+            return make_failed_result(tool_name, "Unexpected frame from worker");
+        } catch (const NetworkError& e) {
+            // The worker sees the connection close and stops the shard's processes
+            if (request.cancellation.is_cancelled()) {
+                drop_lane(lane);
+                return make_failed_result(tool_name, "Analysis cancelled");
+            }
+            last_error = e.what();
+            drop_worker(lane, last_error);
+            ++requeue_count_;
+        } catch (const std::exception& e) {
+            // Malformed result; another worker would most likely send the same
+            return make_failed_result(tool_name, std::string("Bad shard result: ") + e.what());
+        }
+    }
+
+    return make_failed_result(tool_name, "Shard could not be run on any worker: " + last_error);
+}
+
+size_t AnalysisCoordinator::get_slot_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lanes_.size();
+}
+
+size_t AnalysisCoordinator::get_worker_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<size_t>(std::count_if(workers_.begin(), workers_.end(),
+                                             [](const Worker& worker) { return worker.connected; }));
+}
+
+AnalysisCoordinator::Lane* AnalysisCoordinator::acquire_lane() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        if (lanes_.empty()) {
+            return nullptr;
+        }
+        for (auto& lane : lanes_) {
+            if (!lane.busy) {
+                lane.busy = true;
+                return &lane;
+            }
+        }
+        lane_released_.wait(lock);
+    }
+}
+
+void AnalysisCoordinator::release_lane(Lane* lane) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        lane->busy = false;
+    }
+    lane_released_.notify_one();
+}
+
+void AnalysisCoordinator::drop_worker(Lane* lane, const std::string& reason) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& worker = workers_[lane->worker];
+        if (worker.connected) {
+            LOG_WARNING("ANALYSIS_COORDINATOR", "Lost worker ", worker.endpoint.to_string(), ": ", reason,
+                        "; sending its shards elsewhere");
+            worker.connected = false;
+        }
+
+        // Idle connections go now; busy ones fail on their own and come back here
+        size_t index = lane->worker;
+        lanes_.remove_if([lane, index](const Lane& other) {
+            return &other == lane || (other.worker == index && !other.busy);
+        });
+    }
+    lane_released_.notify_all();
+}
+
+void AnalysisCoordinator::drop_lane(Lane* lane) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t index = lane->worker;
+        lanes_.remove_if([lane](const Lane& other) { return &other == lane; });
+        workers_[index].connected = std::any_of(lanes_.begin(), lanes_.end(),
+                                                [index](const Lane& other) { return other.worker == index; });
+    }
+    lane_released_.notify_all();
+}
+
+// ==================== AnalysisWorker ====================
+
+AnalysisWorker::AnalysisWorker(uint16_t port)
+    : AnalysisWorker(port, Options{}) {}
+
+AnalysisWorker::AnalysisWorker(uint16_t port, Options options)
+    : listener_(port, options.address),
+      slots_(options.slots > 0 ? options.slots : std::max(1u, std::thread::hardware_concurrency())) {}
+
+AnalysisWorker::~AnalysisWorker() {
+    stop();
+    join_finished_connections(true);
+}
+
+void AnalysisWorker::serve() {
+    LOG_INFO("ANALYSIS_WORKER", "Serving shards on port ", get_port(), " with ", slots_, " slots");
+
+    while (!stopping_) {
+        FramedSocket accepted = listener_.accept();
+        if (!accepted.is_open()) {
+            break;
+        }
+        LOG_INFO("ANALYSIS_WORKER", "Coordinator connected from ", accepted.get_peer_name());
+
+        join_finished_connections(false);
+        std::lock_guard<std::mutex> lock(connections_mutex_);
+        if (stopping_) {
+            break;
+        }
+        auto& connection = connections_.emplace_back();
+        connection.socket = std::make_shared<FramedSocket>(std::move(accepted));
+        connection.thread = std::thread([this, &connection, socket = connection.socket]() {
+            try {
+                serve_connection(*socket);
+            } catch (const std::exception& e) {
+                LOG_WARNING("ANALYSIS_WORKER", "Connection from ", socket->get_peer_name(), " failed: ", e.what());
+            }
+            connection.done = true;
+        });
+    }
+
+    join_finished_connections(true);
+}
+
+void AnalysisWorker::stop() {
+    stopping_ = true;
+    {
+        // Before waking serve(), which takes the connections over to join them
+        std::lock_guard<std::mutex> lock(connections_mutex_);
+        for (auto& connection : connections_) {
+            connection.socket->shutdown();
+        }
+    }
+    listener_.close();
+}
+
+void AnalysisWorker::join_finished_connections(bool all) {
+    std::list<Connection> finished;
+    {
+        std::lock_guard<std::mutex> lock(connections_mutex_);
+        for (auto it = connections_.begin(); it != connections_.end();) {
+            auto next = std::next(it);
+            if (all || it->done) {
+                finished.splice(finished.end(), connections_, it);
+            }
+            it = next;
+        }
+    }
+    for (auto& connection : finished) {
+        connection.thread.join();
+    }
+}
+
+void AnalysisWorker::serve_connection(FramedSocket& socket) {
+    nlohmann::json hello;
+    hello["protocol"] = REMOTE_PROTOCOL_VERSION;
+    hello["slots"] = slots_;
+    socket.send(static_cast<uint8_t>(RemoteFrame::Hello), hello.dump());
+
+    // Tool instances of this connection, by name
+    std::map<std::string, std::unique_ptr<AnalysisEngine>> engines;
+
+    while (auto frame = socket.receive()) {
+        if (frame->type != static_cast<uint8_t>(RemoteFrame::ShardRequest)) {
+            socket.send(static_cast<uint8_t>(RemoteFrame::Error), "Unexpected frame");
+            return;
+        }
+
+        auto message = nlohmann::json::parse(frame->payload, nullptr, false);
+        if (message.is_discarded() || !message.is_object() || !message.contains("request")) {
+            socket.send(static_cast<uint8_t>(RemoteFrame::Error), "Malformed shard request");
+            continue;
+        }
+
+        std::string tool_name = message.value("tool", "");
+        auto& engine = engines[tool_name];
+        if (!engine) {
+            engine = AnalysisEngineFactory::create_engine_with_tools({tool_name});
+        }
+        AnalysisTool* tool = engine->get_tool(tool_name);
+        if (!tool || !tool->is_available()) {
+            socket.send(static_cast<uint8_t>(RemoteFrame::Error), "Tool " + tool_name + " is not available");
+            continue;
+        }
+        std::string tool_version = tool->get_version();
+        if (message.value("tool_version", "") != tool_version) {
+            socket.send(static_cast<uint8_t>(RemoteFrame::Error), "Worker has " + tool_name + " " + tool_version +
+                        ", coordinator " + message.value("tool_version", ""));
+            continue;
+        }
+
+        const auto& config_json = message["config"];
+        if (!config_json.is_null()) {
+            if (auto config = tool->create_default_config()) {
+                config->from_json(config_json);
+                tool->set_configuration(std::move(config));
+            }
+        }
+
+        // The coordinator holds one connection per slot
+        auto request = AnalysisRequest::from_json(message["request"]);
+        request.max_parallel_jobs = 1;
+        request.cancellation = wip::utils::concurrency::CancellationToken::create();
+
+        // Run on a helper thread, whose token ends the wait; the coordinator going away cancels the shard
+        AnalysisResult result;
+        auto finished = wip::utils::concurrency::CancellationToken::create();
+        std::thread runner([&]() {
+            try {
+                result = tool->execute(request);
+            } catch (const std::exception& e) {
+                result = make_failed_result(tool_name, std::string("Tool execution failed: ") + e.what());
+            }
+            finished.cancel();
+        });
+        bool abandoned = socket.wait_readable(FramedSocket::NO_TIMEOUT, finished);
+        if (abandoned) {
+            request.cancellation.cancel();
+        }
+        runner.join();
+        ++shard_count_;
+
+        if (abandoned) {
+            LOG_INFO("ANALYSIS_WORKER", "Coordinator went away; cancelled shard of ", tool_name);
+            return;
+        }
+        socket.send(static_cast<uint8_t>(RemoteFrame::ShardResult), encode_result(result));
+    }
+}
+
+} // namespace analysis
+} // namespace wip
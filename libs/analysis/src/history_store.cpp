@@ -0,0 +1,645 @@
+#include "history_store.h"
+#include "issue_store.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace wip {
+namespace analysis {
+
+namespace {
+
+// Catalog: header, then one RunRecord per run
+
+struct CatalogHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t record_size;
+    uint32_t padding;
+};
+
+struct RunRecord {
+    uint64_t run_id;
+    int64_t timestamp_ms;         // Since the system clock epoch
+    int64_t execution_time_ms;
+    uint64_t files_analyzed;
+    uint64_t issue_count;
+    uint64_t block_offset;
+    uint64_t block_size;
+    uint32_t segment;
+    uint32_t success;
+    uint64_t severity_counts[4];
+    uint64_t category_counts[7];
+};
+
+// Run block: header and sections at multiples of 8 bytes, offsets relative to the block
+
+struct BlockHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t tool_count;
+    uint32_t string_count;
+    uint32_t file_count;
+    uint32_t rule_count;
+    uint64_t issue_count;
+    uint64_t tools_offset;
+    uint64_t issues_offset;
+    uint64_t files_offset;        // File index, sorted by path
+    uint64_t rules_offset;        // Rule index, sorted by rule ID
+    uint64_t postings_offset;     // Issue indexes grouped by rule
+    uint64_t strings_offset;      // string_count + 1 offsets, then the characters
+    uint64_t block_size;
+};
+
+struct ToolRecord {
+    uint32_t tool_name;
+    uint32_t analysis_id;
+    uint32_t error_message;
+    uint32_t success;
+    int64_t timestamp_ms;
+    int64_t execution_time_ms;
+    uint64_t files_analyzed;
+};
+
+struct IssueRecord {
+    uint32_t id;
+    uint32_t message;
+    uint32_t file_path;
+    uint32_t rule_id;
+    uint32_t tool_name;
+    uint32_t fix_suggestion;      // NO_STRING when absent
+    int32_t line_number;
+    int32_t column_number;
+    uint8_t severity;
+    uint8_t category;
+    uint8_t padding[6];
+};
+
+// Files: a range of issues. Rules: a range of postings.
+struct IndexEntry {
+    uint32_t key;
+    uint32_t padding;
+    uint64_t first;
+    uint64_t count;
+};
+
+static_assert(sizeof(CatalogHeader) == 16, "CatalogHeader layout changed");
+static_assert(sizeof(RunRecord) == 152, "RunRecord layout changed");
+static_assert(sizeof(BlockHeader) == 88, "BlockHeader layout changed");
+static_assert(sizeof(ToolRecord) == 40, "ToolRecord layout changed");
+static_assert(sizeof(IssueRecord) == 40, "IssueRecord layout changed");
+static_assert(sizeof(IndexEntry) == 24, "IndexEntry layout changed");
+
+constexpr uint32_t NO_STRING = UINT32_MAX;
+constexpr char CATALOG_FILE[] = "catalog.wiph";
+
+template<typename T>
+void append_pod(std::string& out, const T& value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+void append_pods(std::string& out, const std::vector<T>& values) {
+    out.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+}
+
+void pad_to_8(std::string& out) {
+    out.append((8 - out.size() % 8) % 8, '\0');
+}
+
+int64_t to_milliseconds(std::chrono::system_clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count();
+}
+
+std::chrono::system_clock::time_point from_milliseconds(int64_t milliseconds) {
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::milliseconds(milliseconds)));
+}
+
+HistoryRun to_run(const RunRecord& record) {
+    HistoryRun run;
+    run.run_id = record.run_id;
+    run.timestamp = from_milliseconds(record.timestamp_ms);
+    run.issue_count = static_cast<size_t>(record.issue_count);
+    run.files_analyzed = static_cast<size_t>(record.files_analyzed);
+    run.execution_time = std::chrono::milliseconds(record.execution_time_ms);
+    run.success = record.success != 0;
+    for (size_t i = 0; i < ISSUE_SEVERITY_COUNT; ++i) {
+        run.issue_counts_by_severity[i] = static_cast<size_t>(record.severity_counts[i]);
+    }
+    for (size_t i = 0; i < ISSUE_CATEGORY_COUNT; ++i) {
+        run.issue_counts_by_category[i] = static_cast<size_t>(record.category_counts[i]);
+    }
+    return run;
+}
+
+// Encode one run as a block; fills in the summary fields of record
+std::string encode_block(const std::vector<AnalysisResult>& results, RunRecord& record) {
+    std::vector<const AnalysisIssue*> issues;
+    for (const auto& result : results) {
+        for (const auto& issue : result.issues) {
+            issues.push_back(&issue);
+        }
+    }
+    std::stable_sort(issues.begin(), issues.end(), [](const AnalysisIssue* a, const AnalysisIssue* b) {
+        if (a->file_path != b->file_path) return a->file_path < b->file_path;
+        if (a->line_number != b->line_number) return a->line_number < b->line_number;
+        return a->rule_id < b->rule_id;
+    });
+
+    StringPool strings;
+    std::vector<ToolRecord> tool_records;
+    tool_records.reserve(results.size());
+    record.success = 1;
+    for (const auto& result : results) {
+        ToolRecord tool{};
+        tool.tool_name = strings.intern(result.tool_name);
+        tool.analysis_id = strings.intern(result.analysis_id);
+        tool.error_message = strings.intern(result.error_message);
+        tool.success = result.success ? 1 : 0;
+        tool.timestamp_ms = to_milliseconds(result.timestamp);
+        tool.execution_time_ms = result.execution_time.count();
+        tool.files_analyzed = result.files_analyzed;
+        tool_records.push_back(tool);
+
+        record.success &= tool.success;
+        record.execution_time_ms = std::max<int64_t>(record.execution_time_ms, tool.execution_time_ms);
+        record.files_analyzed = std::max<uint64_t>(record.files_analyzed, tool.files_analyzed);
+    }
+
+    std::vector<IssueRecord> issue_records;
+    std::vector<IndexEntry> file_index;
+    std::map<std::string_view, std::vector<uint32_t>> rule_postings;
+    issue_records.reserve(issues.size());
+    for (const AnalysisIssue* issue : issues) {
+        IssueRecord issue_record{};
+        issue_record.id = strings.intern(issue->id);
+        issue_record.message = strings.intern(issue->message);
+        issue_record.file_path = strings.intern(issue->file_path);
+        issue_record.rule_id = strings.intern(issue->rule_id);
+        issue_record.tool_name = strings.intern(issue->tool_name);
+        issue_record.fix_suggestion = issue->fix_suggestion ? strings.intern(*issue->fix_suggestion) : NO_STRING;
+        issue_record.line_number = issue->line_number;
+        issue_record.column_number = issue->column_number;
+        issue_record.severity = static_cast<uint8_t>(issue->severity);
+        issue_record.category = static_cast<uint8_t>(issue->category);
+
+        if (file_index.empty() || file_index.back().key != issue_record.file_path) {
+            file_index.push_back({issue_record.file_path, 0, issue_records.size(), 0});
+        }
+        ++file_index.back().count;
+        rule_postings[issue->rule_id].push_back(static_cast<uint32_t>(issue_records.size()));
+        ++record.severity_counts[issue_record.severity];
+        ++record.category_counts[issue_record.category];
+        issue_records.push_back(issue_record);
+    }
+    record.issue_count = issue_records.size();
+
+    std::vector<IndexEntry> rule_index;
+    std::vector<uint32_t> postings;
+    rule_index.reserve(rule_postings.size());
+    postings.reserve(issue_records.size());
+    for (const auto& [rule_id, indexes] : rule_postings) {
+        rule_index.push_back({strings.intern(rule_id), 0, postings.size(), indexes.size()});
+        postings.insert(postings.end(), indexes.begin(), indexes.end());
+    }
+
+    BlockHeader header{};
+    std::memcpy(header.magic, HistoryStore::BLOCK_MAGIC, sizeof(header.magic));
+    header.version = HistoryStore::FORMAT_VERSION;
+    header.tool_count = static_cast<uint32_t>(tool_records.size());
+    header.string_count = static_cast<uint32_t>(strings.size());
+    header.file_count = static_cast<uint32_t>(file_index.size());
+    header.rule_count = static_cast<uint32_t>(rule_index.size());
+    header.issue_count = issue_records.size();
+
+    std::string block;
+    append_pod(block, header);
+    header.tools_offset = block.size();
+    append_pods(block, tool_records);
+    header.issues_offset = block.size();
+    append_pods(block, issue_records);
+    header.files_offset = block.size();
+    append_pods(block, file_index);
+    header.rules_offset = block.size();
+    append_pods(block, rule_index);
+    header.postings_offset = block.size();
+    append_pods(block, postings);
+    pad_to_8(block);
+    header.strings_offset = block.size();
+
+    uint64_t offset = 0;
+    append_pod(block, offset);
+    for (size_t i = 0; i < strings.size(); ++i) {
+        offset += strings.get(static_cast<StringPool::Id>(i)).size();
+        append_pod(block, offset);
+    }
+    for (size_t i = 0; i < strings.size(); ++i) {
+        block.append(strings.get(static_cast<StringPool::Id>(i)));
+    }
+    pad_to_8(block);
+    header.block_size = block.size();
+
+    std::memcpy(block.data(), &header, sizeof(header));
+    return block;
+}
+
+[[noreturn]] void throw_corrupt(const std::string& path, const std::string& reason) {
+    throw std::runtime_error("Corrupt history segment " + path + ": " + reason);
+}
+
+} // namespace
+
+// ==================== Block ====================
+
+/**
+ * Run block inside a mapped segment. Only the header and section bounds are
+ * validated up front; string indexes are checked as they are read, so a query
+ * touches nothing but the index entries and records it returns.
+ */
+class HistoryStore::Block {
+public:
+    Block(const char* data, uint64_t size, std::string path) : data_(data), path_(std::move(path)) {
+        if (size < sizeof(BlockHeader)) {
+            throw_corrupt(path_, "block too small");
+        }
+        header_ = reinterpret_cast<const BlockHeader*>(data);
+        if (std::memcmp(header_->magic, BLOCK_MAGIC, sizeof(BLOCK_MAGIC)) != 0 ||
+            header_->version != FORMAT_VERSION || header_->block_size != size) {
+            throw_corrupt(path_, "bad block header");
+        }
+
+        const auto& h = *header_;
+        uint64_t tools_end = h.tools_offset + uint64_t{h.tool_count} * sizeof(ToolRecord);
+        uint64_t issues_end = h.issues_offset + h.issue_count * sizeof(IssueRecord);
+        uint64_t files_end = h.files_offset + uint64_t{h.file_count} * sizeof(IndexEntry);
+        uint64_t rules_end = h.rules_offset + uint64_t{h.rule_count} * sizeof(IndexEntry);
+        uint64_t postings_end = h.postings_offset + h.issue_count * sizeof(uint32_t);
+        uint64_t offsets_end = h.strings_offset + (uint64_t{h.string_count} + 1) * sizeof(uint64_t);
+        if (h.issue_count > size / sizeof(IssueRecord) || h.tools_offset < sizeof(BlockHeader) ||
+            h.issues_offset < tools_end || h.files_offset < issues_end || h.rules_offset < files_end ||
+            h.postings_offset < rules_end || h.strings_offset < postings_end || offsets_end > size ||
+            (h.tools_offset | h.issues_offset | h.files_offset | h.rules_offset | h.strings_offset) % 8 != 0) {
+            throw_corrupt(path_, "section out of bounds");
+        }
+
+        string_offsets_ = reinterpret_cast<const uint64_t*>(data + h.strings_offset);
+        string_data_ = data + offsets_end;
+        string_data_size_ = size - offsets_end;
+    }
+
+    std::string_view get_string(uint32_t index) const {
+        if (index >= header_->string_count) {
+            throw_corrupt(path_, "string index out of range");
+        }
+        uint64_t begin = string_offsets_[index];
+        uint64_t end = string_offsets_[index + 1];
+        if (begin > end || end > string_data_size_) {
+            throw_corrupt(path_, "corrupt string table");
+        }
+        return std::string_view(string_data_ + begin, end - begin);
+    }
+
+    size_t get_issue_count() const { return static_cast<size_t>(header_->issue_count); }
+
+    AnalysisIssue get_issue(size_t index) const {
+        const auto& record = reinterpret_cast<const IssueRecord*>(data_ + header_->issues_offset)[index];
+        if (record.severity >= ISSUE_SEVERITY_COUNT || record.category >= ISSUE_CATEGORY_COUNT) {
+            throw_corrupt(path_, "corrupt issue record");
+        }
+        AnalysisIssue issue;
+        issue.id = std::string(get_string(record.id));
+        issue.message = std::string(get_string(record.message));
+        issue.file_path = std::string(get_string(record.file_path));
+        issue.line_number = record.line_number;
+        issue.column_number = record.column_number;
+        issue.severity = static_cast<IssueSeverity>(record.severity);
+        issue.category = static_cast<IssueCategory>(record.category);
+        issue.rule_id = std::string(get_string(record.rule_id));
+        issue.tool_name = std::string(get_string(record.tool_name));
+        if (record.fix_suggestion != NO_STRING) {
+            issue.fix_suggestion = std::string(get_string(record.fix_suggestion));
+        }
+        return issue;
+    }
+
+    std::vector<AnalysisResult> get_results() const {
+        std::vector<AnalysisResult> results;
+        std::map<std::string_view, size_t> result_of_tool;
+        const auto* tools = reinterpret_cast<const ToolRecord*>(data_ + header_->tools_offset);
+        for (uint32_t i = 0; i < header_->tool_count; ++i) {
+            AnalysisResult result;
+            result.tool_name = std::string(get_string(tools[i].tool_name));
+            result.analysis_id = std::string(get_string(tools[i].analysis_id));
+            result.error_message = std::string(get_string(tools[i].error_message));
+            result.success = tools[i].success != 0;
+            result.timestamp = from_milliseconds(tools[i].timestamp_ms);
+            result.execution_time = std::chrono::milliseconds(tools[i].execution_time_ms);
+            result.files_analyzed = static_cast<size_t>(tools[i].files_analyzed);
+            result_of_tool.emplace(get_string(tools[i].tool_name), results.size());
+            results.push_back(std::move(result));
+        }
+
+        for (size_t i = 0; i < get_issue_count(); ++i) {
+            AnalysisIssue issue = get_issue(i);
+            auto it = result_of_tool.find(issue.tool_name);
+            if (it == result_of_tool.end()) {
+                // Issues whose tool name differs from their result's stay with the first result
+                if (results.empty()) {
+                    results.emplace_back();
+                    results.back().success = true;
+                }
+                results.front().issues.push_back(std::move(issue));
+            } else {
+                results[it->second].issues.push_back(std::move(issue));
+            }
+        }
+        for (auto& result : results) {
+            result.compute_statistics();
+        }
+        return results;
+    }
+
+    /**
+     * @brief Look up a file or rule in its index
+     * @return Entry, or nullptr if the key has no issues in this run
+     */
+    const IndexEntry* find(IndexKind kind, std::string_view key) const {
+        const bool files = kind == IndexKind::File;
+        const auto* begin = reinterpret_cast<const IndexEntry*>(data_ + (files ? header_->files_offset : header_->rules_offset));
+        const auto* end = begin + (files ? header_->file_count : header_->rule_count);
+        const auto* it = std::lower_bound(begin, end, key, [this](const IndexEntry& entry, std::string_view value) {
+            return get_string(entry.key) < value;
+        });
+        if (it == end || get_string(it->key) != key) {
+            return nullptr;
+        }
+        uint64_t limit = get_issue_count();
+        if (it->first > limit || it->count > limit - it->first) {
+            throw_corrupt(path_, "corrupt index entry");
+        }
+        return it;
+    }
+
+    /**
+     * @brief Get the issues of an index entry
+     */
+    std::vector<AnalysisIssue> get_issues(IndexKind kind, const IndexEntry& entry) const {
+        std::vector<AnalysisIssue> issues;
+        issues.reserve(static_cast<size_t>(entry.count));
+        const auto* postings = reinterpret_cast<const uint32_t*>(data_ + header_->postings_offset);
+        for (uint64_t i = entry.first; i < entry.first + entry.count; ++i) {
+            size_t index = kind == IndexKind::File ? static_cast<size_t>(i) : postings[i];
+            if (index >= get_issue_count()) {
+                throw_corrupt(path_, "corrupt rule posting");
+            }
+            issues.push_back(get_issue(index));
+        }
+        return issues;
+    }
+
+private:
+    const char* data_;
+    std::string path_;
+    const BlockHeader* header_ = nullptr;
+    const uint64_t* string_offsets_ = nullptr;
+    const char* string_data_ = nullptr;
+    uint64_t string_data_size_ = 0;
+};
+
+// ==================== HistoryStore ====================
+
+HistoryStore::HistoryStore(const std::string& directory, uint64_t segment_size)
+    : directory_(directory), segment_size_(segment_size) {
+    std::error_code error;
+    std::filesystem::create_directories(directory_, error);
+    if (!std::filesystem::is_directory(directory_)) {
+        throw std::runtime_error("Cannot create history directory: " + directory_);
+    }
+    load_catalog();
+}
+
+void HistoryStore::load_catalog() {
+    const auto catalog_path = std::filesystem::path(directory_) / CATALOG_FILE;
+    std::ifstream file(catalog_path, std::ios::binary);
+    if (!file || file.peek() == std::char_traits<char>::eof()) {
+        return;     // New store; the catalog is created with the first run
+    }
+
+    CatalogHeader header{};
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, CATALOG_MAGIC, sizeof(CATALOG_MAGIC)) != 0) {
+        throw std::runtime_error("Not a history catalog: " + catalog_path.string());
+    }
+    if (header.version != FORMAT_VERSION || header.record_size != sizeof(RunRecord)) {
+        throw std::runtime_error("Unsupported history catalog version " + std::to_string(header.version) + ": " +
+                                 catalog_path.string());
+    }
+
+    // Keep the runs whose blocks were completely written; anything after the
+    // first incomplete one was torn by a crash and is cut off
+    std::map<uint32_t, uint64_t> segment_sizes;
+    RunRecord record{};
+    while (file.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+        auto size = segment_sizes.find(record.segment);
+        if (size == segment_sizes.end()) {
+            std::error_code error;
+            auto bytes = std::filesystem::file_size(segment_path(record.segment), error);
+            size = segment_sizes.emplace(record.segment, error ? 0 : bytes).first;
+        }
+        if (record.block_offset > size->second || record.block_size > size->second - record.block_offset ||
+            (!runs_.empty() && record.run_id <= runs_.back().run_id)) {
+            break;
+        }
+        runs_.push_back(to_run(record));
+        locations_.push_back({record.segment, record.block_offset, record.block_size});
+    }
+    file.close();
+
+    const uint64_t valid_size = sizeof(CatalogHeader) + runs_.size() * sizeof(RunRecord);
+    std::error_code error;
+    if (std::filesystem::file_size(catalog_path, error) != valid_size && !error) {
+        std::filesystem::resize_file(catalog_path, valid_size, error);
+    }
+}
+
+std::string HistoryStore::segment_path(uint32_t segment) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "segment-%06u.wips", segment);
+    return (std::filesystem::path(directory_) / name).string();
+}
+
+uint64_t HistoryStore::append_run(const std::vector<AnalysisResult>& results) {
+    RunRecord record{};
+    std::string block = encode_block(results, record);
+
+    std::chrono::system_clock::time_point timestamp{};
+    for (const auto& result : results) {
+        timestamp = std::max(timestamp, result.timestamp);
+    }
+    if (timestamp == std::chrono::system_clock::time_point{}) {
+        timestamp = std::chrono::system_clock::now();
+    }
+    record.timestamp_ms = to_milliseconds(timestamp);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    record.run_id = runs_.empty() ? 1 : runs_.back().run_id + 1;
+
+    // Append after the last recorded block of the newest segment unless the
+    // block would overflow it; blocks left behind by a torn append are cut off
+    uint32_t segment = locations_.empty() ? 0 : locations_.back().segment;
+    uint64_t segment_end = locations_.empty() ? 0 : locations_.back().offset + locations_.back().size;
+    if (segment_end > 0 && segment_end + block.size() > segment_size_) {
+        ++segment;
+        segment_end = 0;
+    }
+
+    {
+        const std::string path = segment_path(segment);
+        std::error_code error;
+        if (std::filesystem::exists(path, error)) {
+            std::filesystem::resize_file(path, segment_end, error);
+        }
+        std::ofstream file(path, std::ios::binary | std::ios::app);
+        if (!file.is_open() || error) {
+            throw std::runtime_error("Cannot open history segment for writing: " + path);
+        }
+        file.write(block.data(), static_cast<std::streamsize>(block.size()));
+        file.flush();
+        if (!file) {
+            throw std::runtime_error("Failed to write history segment: " + path);
+        }
+    }
+
+    record.segment = segment;
+    record.block_offset = segment_end;
+    record.block_size = block.size();
+
+    const auto catalog_path = std::filesystem::path(directory_) / CATALOG_FILE;
+    std::ofstream catalog(catalog_path, std::ios::binary | std::ios::app);
+    if (!catalog.is_open()) {
+        throw std::runtime_error("Cannot open history catalog for writing: " + catalog_path.string());
+    }
+    if (runs_.empty()) {
+        // The catalog is rewritten from its header only when it holds no runs
+        catalog.close();
+        catalog.open(catalog_path, std::ios::binary | std::ios::trunc);
+        CatalogHeader header{};
+        std::memcpy(header.magic, CATALOG_MAGIC, sizeof(CATALOG_MAGIC));
+        header.version = FORMAT_VERSION;
+        header.record_size = sizeof(RunRecord);
+        catalog.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+    catalog.write(reinterpret_cast<const char*>(&record), sizeof(record));
+    catalog.flush();
+    if (!catalog) {
+        throw std::runtime_error("Failed to write history catalog: " + catalog_path.string());
+    }
+
+    runs_.push_back(to_run(record));
+    locations_.push_back({record.segment, record.block_offset, record.block_size});
+    return record.run_id;
+}
+
+size_t HistoryStore::get_run_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return runs_.size();
+}
+
+std::vector<HistoryRun> HistoryStore::get_runs(size_t last_runs) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::vector<HistoryRun>(runs_.begin() + static_cast<std::ptrdiff_t>(first_run(last_runs)), runs_.end());
+}
+
+std::optional<HistoryRun> HistoryStore::get_run(uint64_t run_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = std::lower_bound(runs_.begin(), runs_.end(), run_id,
+                               [](const HistoryRun& run, uint64_t id) { return run.run_id < id; });
+    if (it == runs_.end() || it->run_id != run_id) {
+        return std::nullopt;
+    }
+    return *it;
+}
+
+std::vector<AnalysisResult> HistoryStore::read_run(uint64_t run_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = std::lower_bound(runs_.begin(), runs_.end(), run_id,
+                               [](const HistoryRun& run, uint64_t id) { return run.run_id < id; });
+    if (it == runs_.end() || it->run_id != run_id) {
+        throw std::out_of_range("No run with ID " + std::to_string(run_id));
+    }
+    return get_block(static_cast<size_t>(it - runs_.begin())).get_results();
+}
+
+std::vector<HistoryIssues> HistoryStore::get_issues_in_file(std::string_view file_path, size_t last_runs) const {
+    return query_issues(IndexKind::File, file_path, last_runs);
+}
+
+std::vector<HistoryIssues> HistoryStore::get_issues_for_rule(std::string_view rule_id, size_t last_runs) const {
+    return query_issues(IndexKind::Rule, rule_id, last_runs);
+}
+
+std::vector<HistoryTrendPoint> HistoryStore::get_file_trend(std::string_view file_path, size_t last_runs) const {
+    return query_trend(IndexKind::File, file_path, last_runs);
+}
+
+std::vector<HistoryTrendPoint> HistoryStore::get_rule_trend(std::string_view rule_id, size_t last_runs) const {
+    return query_trend(IndexKind::Rule, rule_id, last_runs);
+}
+
+// ==================== Private Helper Methods ====================
+
+size_t HistoryStore::first_run(size_t last_runs) const {
+    return last_runs == 0 || last_runs >= runs_.size() ? 0 : runs_.size() - last_runs;
+}
+
+HistoryStore::Block HistoryStore::get_block(size_t run_index) const {
+    const RunLocation& location = locations_[run_index];
+    auto it = segments_.find(location.segment);
+    if (it == segments_.end() || it->second.size() < location.offset + location.size) {
+        auto mapped = wip::utils::file::MappedFile::open(segment_path(location.segment));
+        if (!mapped || mapped->size() < location.offset + location.size) {
+            throw std::runtime_error("Cannot map history segment: " + segment_path(location.segment));
+        }
+        it = segments_.insert_or_assign(location.segment, std::move(*mapped)).first;
+    }
+    return Block(it->second.data() + location.offset, location.size, segment_path(location.segment));
+}
+
+std::vector<HistoryIssues> HistoryStore::query_issues(IndexKind kind, std::string_view key, size_t last_runs) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<HistoryIssues> matches;
+    for (size_t i = first_run(last_runs); i < runs_.size(); ++i) {
+        HistoryIssues entry;
+        entry.run = runs_[i];
+        Block block = get_block(i);
+        if (const IndexEntry* index = block.find(kind, key)) {
+            entry.issues = block.get_issues(kind, *index);
+        }
+        matches.push_back(std::move(entry));
+    }
+    return matches;
+}
+
+std::vector<HistoryTrendPoint> HistoryStore::query_trend(IndexKind kind, std::string_view key, size_t last_runs) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<HistoryTrendPoint> trend;
+    for (size_t i = first_run(last_runs); i < runs_.size(); ++i) {
+        HistoryTrendPoint point;
+        point.run_id = runs_[i].run_id;
+        point.timestamp = runs_[i].timestamp;
+        Block block = get_block(i);
+        if (const IndexEntry* index = block.find(kind, key)) {
+            point.issue_count = static_cast<size_t>(index->count);
+        }
+        trend.push_back(point);
+    }
+    return trend;
+}
+
+} // namespace analysis
+} // namespace wip
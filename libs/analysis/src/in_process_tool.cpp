@@ -0,0 +1,158 @@
+#include "in_process_tool.h"
+#include "changed_lines.h"
+#include <mapped_file.h>
+#include <time_utilities.h>
+#include <log.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace wip {
+namespace analysis {
+
+std::vector<std::string> InProcessTool::get_supported_extensions() const {
+    return {".cpp", ".cxx", ".cc", ".c", ".h", ".hpp", ".hxx", ".hh", ".inl", ".ipp"};
+}
+
+void InProcessTool::set_configuration(std::unique_ptr<ToolConfig> config) {
+    config_ = std::move(config);
+    on_configuration_changed();
+}
+
+const ToolConfig* InProcessTool::get_configuration() const {
+    return config_.get();
+}
+
+ValidationResult InProcessTool::validate_configuration() const {
+    if (!config_) {
+        ValidationResult result;
+        result.add_error("No configuration set for " + get_name());
+        return result;
+    }
+
+    return config_->validate();
+}
+
+std::string InProcessTool::get_system_requirements() const {
+    return "None: " + get_name() + " is built in and runs inside the application";
+}
+
+AnalysisResult InProcessTool::execute(const AnalysisRequest& request) {
+    return run(request, nullptr);
+}
+
+wip::utils::concurrency::Task<AnalysisResult> InProcessTool::execute_async(
+    const AnalysisRequest& request,
+    std::function<void(const AnalysisProgress&)> progress_callback,
+    std::function<void(const std::string&)> /*output_callback*/) {
+
+    return wip::utils::concurrency::async([this, request, progress_callback]() {
+        return run(request, progress_callback);
+    });
+}
+
+bool InProcessTool::cancel_analysis() {
+    return cancel_active_runs();
+}
+
+bool InProcessTool::is_analysis_running() const {
+    return running_count_ > 0;
+}
+
+AnalysisResult InProcessTool::parse_results_file(const std::string& output_file) {
+    throw std::runtime_error(get_name() + " runs in process and writes no result file: " + output_file);
+}
+
+std::vector<std::string> InProcessTool::get_translation_units(const AnalysisRequest& request) const {
+    return list_source_files(request, get_supported_extensions());
+}
+
+AnalysisIssue InProcessTool::make_issue(const std::string& path, int line, int column, const std::string& rule_id,
+                                        const std::string& message) const {
+    AnalysisIssue issue;
+    issue.tool_name = get_name();
+    issue.id = rule_id;
+    issue.rule_id = rule_id;
+    issue.message = message;
+    issue.file_path = path;
+    issue.line_number = line;
+    issue.column_number = column;
+    return issue;
+}
+
+AnalysisResult InProcessTool::run(const AnalysisRequest& request,
+                                  const std::function<void(const AnalysisProgress&)>& progress_callback) {
+    ++running_count_;
+    ActiveRun active_run(*this, request);
+
+    AnalysisResult result;
+    result.tool_name = get_name();
+    result.analysis_id = "in-process-" + std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    result.timestamp = std::chrono::system_clock::now();
+
+    auto start_time = std::chrono::steady_clock::now();
+    std::vector<std::string> unreadable;
+
+    try {
+        auto files = get_translation_units(request);
+        ChangedLines scope(request.changed_ranges);
+
+        AnalysisProgress progress;
+        progress.total_files = files.size();
+
+        wip::time::utilities::ScopedTimer scan_timer(result.profile.parse_time);
+        for (const auto& path : files) {
+            if (active_run.get_token().is_cancelled()) {
+                break;
+            }
+
+            // Files only report on themselves, so a diff-scoped run reads only the changed ones
+            if (scope.empty() || scope.contains_file(path)) {
+                // Empty files map without a view and have nothing to report
+                auto file = wip::utils::file::MappedFile::open(path);
+                if (!file) {
+                    unreadable.push_back(path);
+                } else {
+                    size_t first_issue = result.issues.size();
+                    analyze_file(path, file->view(), result.issues);
+                    if (!scope.empty()) {
+                        result.issues.erase(std::remove_if(result.issues.begin() + first_issue, result.issues.end(),
+                                                           [&scope](const AnalysisIssue& issue) { return !scope.contains(issue); }),
+                                            result.issues.end());
+                    }
+                    ++result.files_analyzed;
+                }
+            }
+
+            if (progress_callback) {
+                ++progress.processed_files;
+                progress.current_file = path;
+                progress_callback(progress);
+            }
+        }
+
+        if (active_run.get_token().is_cancelled()) {
+            result.success = false;
+            result.error_message = get_name() + " analysis cancelled";
+        } else if (!unreadable.empty()) {
+            result.success = false;
+            result.error_message = "Could not read " + std::to_string(unreadable.size()) + " file(s), first: " +
+                                   unreadable.front();
+        } else {
+            result.success = true;
+        }
+    } catch (const std::exception& e) {
+        LOG_ERROR("IN_PROCESS_TOOL", get_name(), " failed: ", e.what());
+        result.success = false;
+        result.error_message = get_name() + " execution failed: " + e.what();
+    }
+
+    result.compute_statistics();
+    result.execution_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start_time);
+    --running_count_;
+    return result;
+}
+
+} // namespace analysis
+} // namespace wip
@@ -0,0 +1,390 @@
+#include "include_graph.h"
+#include "analysis_cache.h"
+#include "job_scheduler.h"
+#include <mapped_file.h>
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+
+namespace wip {
+namespace analysis {
+
+namespace {
+
+bool is_blank(char c) {
+    return c == ' ' || c == '\t';
+}
+
+std::string file_name(const std::string& path) {
+    size_t slash = path.find_last_of("/\\");
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+} // namespace
+
+IncludeGraph::IncludeGraph(const AnalysisRequest& request, size_t thread_count)
+    : base_directory_(get_base_directory(request)),
+      include_paths_(request.include_paths),
+      thread_count_(thread_count) {
+    for (const auto& include_path : include_paths_) {
+        include_dirs_.push_back(normalize_path(include_path, base_directory_));
+    }
+}
+
+std::string IncludeGraph::get_base_directory(const AnalysisRequest& request) {
+    std::error_code ec;
+    std::filesystem::path source(request.source_path.empty() ? "." : request.source_path);
+    if (std::filesystem::is_regular_file(source, ec)) {
+        source = source.parent_path();
+    }
+    auto absolute = std::filesystem::absolute(source, ec);
+    return (ec ? source : absolute).lexically_normal().string();
+}
+
+std::string IncludeGraph::normalize_path(const std::string& path, const std::string& base_directory) {
+    std::filesystem::path file(path);
+    if (file.is_relative()) {
+        file = std::filesystem::path(base_directory) / file;
+    }
+    return file.lexically_normal().string();
+}
+
+void IncludeGraph::scan_includes(std::string_view contents, std::vector<std::pair<std::string, bool>>& includes) {
+    size_t pos = 0;
+    while (pos < contents.size()) {
+        size_t line_end = contents.find('\n', pos);
+        if (line_end == std::string_view::npos) {
+            line_end = contents.size();
+        }
+
+        size_t i = pos;
+        while (i < line_end && is_blank(contents[i])) ++i;
+        if (i < line_end && contents[i] == '#') {
+            ++i;
+            while (i < line_end && is_blank(contents[i])) ++i;
+            if (contents.compare(i, 7, "include") == 0) {
+                i += 7;
+                while (i < line_end && is_blank(contents[i])) ++i;
+                if (i < line_end && (contents[i] == '"' || contents[i] == '<')) {
+                    bool quoted = contents[i] == '"';
+                    size_t close = contents.find(quoted ? '"' : '>', i + 1);
+                    if (close != std::string_view::npos && close < line_end) {
+                        includes.emplace_back(std::string(contents.substr(i + 1, close - i - 1)), quoted);
+                    }
+                }
+            }
+        }
+
+        pos = line_end + 1;
+    }
+}
+
+bool IncludeGraph::matches(const AnalysisRequest& request) const {
+    return request.include_paths == include_paths_ && get_base_directory(request) == base_directory_;
+}
+
+size_t IncludeGraph::scan(const std::vector<std::string>& units) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::vector<std::string> pending;
+    for (const auto& unit : units) {
+        std::string path = normalize_path(unit, base_directory_);
+        units_.insert(path);
+        if (!files_.count(path)) {
+            pending.push_back(std::move(path));
+        }
+    }
+
+    // Known files edited behind our back; a stat costs far less than a read
+    std::vector<std::pair<const std::string*, const FileInfo*>> known;
+    known.reserve(files_.size());
+    for (const auto& [path, info] : files_) {
+        known.emplace_back(&path, &info);
+    }
+    std::vector<char> stale(known.size(), 0);  // 1 = changed, 2 = appeared or vanished
+    auto check = [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+            std::error_code ec;
+            auto size = std::filesystem::file_size(*known[i].first, ec);
+            bool exists = !ec;
+            int64_t time = exists ? std::filesystem::last_write_time(*known[i].first, ec).time_since_epoch().count() : 0;
+            const FileInfo& info = *known[i].second;
+            stale[i] = exists != info.exists ? 2 : exists && (size != info.size || time != info.modification_time);
+        }
+    };
+    constexpr size_t CHECK_CHUNK = 256;
+    if (known.size() <= CHECK_CHUNK) {
+        check(0, known.size());
+    } else {
+        JobScheduler scheduler(thread_count_);
+        for (size_t first = 0; first < known.size(); first += CHECK_CHUNK) {
+            scheduler.submit([&check, &known, first]() { check(first, std::min(first + CHECK_CHUNK, known.size())); });
+        }
+        scheduler.wait();
+    }
+    std::set<std::string> rescan;
+    for (size_t i = 0; i < known.size(); ++i) {
+        if (stale[i]) {
+            rescan.insert(*known[i].first);
+        }
+        if (stale[i] == 2) {
+            add_name_users(*known[i].first, rescan);
+        }
+    }
+    pending.insert(pending.end(), rescan.begin(), rescan.end());
+
+    return scan_files(std::move(pending));
+}
+
+std::vector<std::string> IncludeGraph::update(const std::vector<std::string>& changed_files) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::set<std::string> rescan;
+    std::vector<std::string> changed;
+    for (const auto& file : changed_files) {
+        std::string path = normalize_path(file, base_directory_);
+        std::error_code ec;
+        bool exists = std::filesystem::is_regular_file(path, ec);
+
+        auto it = files_.find(path);
+        bool existed = it != files_.end() && it->second.exists;
+        if (it != files_.end()) {
+            rescan.insert(path);
+        }
+        // A file appearing or disappearing can change what includes of its name resolve to
+        if (exists != existed) {
+            add_name_users(path, rescan);
+        }
+        changed.push_back(std::move(path));
+    }
+
+    changed.insert(changed.end(), rescan.begin(), rescan.end());
+    scan_files(std::vector<std::string>(rescan.begin(), rescan.end()));
+
+    // Removed units are no longer analyzed
+    for (const auto& path : changed) {
+        auto it = files_.find(path);
+        if (units_.count(path) && (it == files_.end() || !it->second.exists)) {
+            units_.erase(path);
+        }
+    }
+
+    return affected_units_locked(changed);
+}
+
+std::vector<std::string> IncludeGraph::get_affected_units(const std::vector<std::string>& files) const {
+    std::vector<std::string> paths;
+    paths.reserve(files.size());
+    for (const auto& file : files) {
+        paths.push_back(normalize_path(file, base_directory_));
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    return affected_units_locked(paths);
+}
+
+std::vector<std::string> IncludeGraph::get_closure(const std::string& unit) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::set<std::string> closure;
+    collect_closure(unit, closure);
+    return std::vector<std::string>(closure.begin(), closure.end());
+}
+
+std::vector<std::string> IncludeGraph::get_includers(const std::string& path) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = includers_.find(path);
+    return it == includers_.end() ? std::vector<std::string>()
+                                  : std::vector<std::string>(it->second.begin(), it->second.end());
+}
+
+IncludeGraph::FileInfo IncludeGraph::get_file(const std::string& path) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = files_.find(path);
+    return it == files_.end() ? FileInfo() : it->second;
+}
+
+std::string IncludeGraph::get_content_hash(const std::string& path) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = files_.find(path);
+    return it == files_.end() ? std::string() : it->second.content_hash;
+}
+
+std::vector<std::string> IncludeGraph::get_units() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::vector<std::string>(units_.begin(), units_.end());
+}
+
+size_t IncludeGraph::get_file_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return files_.size();
+}
+
+void IncludeGraph::add_name_users(const std::string& path, std::set<std::string>& files) const {
+    auto it = by_name_.find(file_name(path));
+    if (it != by_name_.end()) {
+        files.insert(it->second.begin(), it->second.end());
+    }
+}
+
+IncludeGraph::FileInfo IncludeGraph::read_file_info(const std::string& path) const {
+    FileInfo info;
+
+    std::error_code ec;
+    info.size = std::filesystem::file_size(path, ec);
+    if (ec) {
+        info.size = 0;
+        return info;
+    }
+    info.modification_time = std::filesystem::last_write_time(path, ec).time_since_epoch().count();
+
+    // Empty files map without a view, which hashes like any empty content
+    auto file = wip::utils::file::MappedFile::open(path);
+    if (!file) {
+        return info;
+    }
+    info.exists = true;
+    info.content_hash = AnalysisCache::hash_content(file->view());
+
+    std::vector<std::pair<std::string, bool>> includes;
+    scan_includes(file->view(), includes);
+    const std::string directory = std::filesystem::path(path).parent_path().string();
+    for (const auto& [name, quoted] : includes) {
+        info.include_names.push_back(file_name(name));
+        std::string resolved = resolve(name, quoted ? &directory : nullptr);
+        if (!resolved.empty()) {
+            info.includes.push_back(std::move(resolved));
+        }
+    }
+
+    return info;
+}
+
+std::string IncludeGraph::resolve(const std::string& name, const std::string* including_directory) const {
+    std::error_code ec;
+    if (including_directory) {
+        std::string candidate = normalize_path(name, *including_directory);
+        if (std::filesystem::is_regular_file(candidate, ec)) {
+            return candidate;
+        }
+    }
+    for (const auto& directory : include_dirs_) {
+        std::string candidate = normalize_path(name, directory);
+        if (std::filesystem::is_regular_file(candidate, ec)) {
+            return candidate;
+        }
+    }
+    return "";
+}
+
+size_t IncludeGraph::scan_files(std::vector<std::string> paths) {
+    if (paths.empty()) {
+        return 0;
+    }
+
+    // Workers read files and queue the includes nobody claimed yet; the graph
+    // itself is only changed below, after all of them finished
+    std::mutex scanned_mutex;
+    std::unordered_set<std::string> claimed(paths.begin(), paths.end());
+    std::vector<std::pair<std::string, FileInfo>> scanned;
+
+    JobScheduler scheduler(thread_count_);
+    std::function<void(std::string)> scan_file = [&](std::string path) {
+        FileInfo info = read_file_info(path);
+        std::vector<std::string> reached;
+        {
+            std::lock_guard<std::mutex> lock(scanned_mutex);
+            for (const auto& include : info.includes) {
+                if (!files_.count(include) && claimed.insert(include).second) {
+                    reached.push_back(include);
+                }
+            }
+            scanned.emplace_back(std::move(path), std::move(info));
+        }
+        for (auto& include : reached) {
+            scheduler.submit([&scan_file, include = std::move(include)]() { scan_file(include); });
+        }
+    };
+
+    for (auto& path : paths) {
+        scheduler.submit([&scan_file, path = std::move(path)]() { scan_file(path); });
+    }
+    scheduler.wait();
+
+    for (auto& [path, info] : scanned) {
+        install(path, std::move(info));
+    }
+    return scanned.size();
+}
+
+void IncludeGraph::install(const std::string& path, FileInfo info) {
+    auto it = files_.find(path);
+    if (it != files_.end()) {
+        for (const auto& include : it->second.includes) {
+            auto includers = includers_.find(include);
+            if (includers != includers_.end()) {
+                includers->second.erase(path);
+            }
+        }
+        for (const auto& name : it->second.include_names) {
+            auto users = by_name_.find(name);
+            if (users != by_name_.end()) {
+                users->second.erase(path);
+            }
+        }
+    }
+
+    for (const auto& include : info.includes) {
+        includers_[include].insert(path);
+    }
+    for (const auto& name : info.include_names) {
+        by_name_[name].insert(path);
+    }
+    files_[path] = std::move(info);
+}
+
+std::vector<std::string> IncludeGraph::affected_units_locked(const std::vector<std::string>& files) const {
+    std::unordered_set<std::string> visited;
+    std::vector<std::string> pending(files.begin(), files.end());
+    std::vector<std::string> units;
+
+    while (!pending.empty()) {
+        std::string path = std::move(pending.back());
+        pending.pop_back();
+        if (!visited.insert(path).second) {
+            continue;
+        }
+        if (units_.count(path)) {
+            units.push_back(path);
+        }
+        auto it = includers_.find(path);
+        if (it != includers_.end()) {
+            pending.insert(pending.end(), it->second.begin(), it->second.end());
+        }
+    }
+
+    std::sort(units.begin(), units.end());
+    return units;
+}
+
+void IncludeGraph::collect_closure(const std::string& unit, std::set<std::string>& closure) const {
+    auto unit_it = files_.find(unit);
+    if (unit_it == files_.end()) {
+        return;
+    }
+
+    std::vector<std::string> pending(unit_it->second.includes.begin(), unit_it->second.includes.end());
+    while (!pending.empty()) {
+        std::string path = std::move(pending.back());
+        pending.pop_back();
+        if (path == unit || !closure.insert(path).second) {
+            continue;
+        }
+        auto it = files_.find(path);
+        if (it != files_.end()) {
+            pending.insert(pending.end(), it->second.includes.begin(), it->second.includes.end());
+        }
+    }
+}
+
+} // namespace analysis
+} // namespace wip
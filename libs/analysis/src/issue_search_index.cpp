@@ -0,0 +1,198 @@
+#include "issue_search_index.h"
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace wip {
+namespace analysis {
+
+namespace {
+
+constexpr uint32_t NO_STRING = UINT32_MAX;
+
+// ASCII only, so results don't depend on the locale
+char to_lower(char c) {
+    return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+std::string to_lower(std::string_view text) {
+    std::string lower(text);
+    std::transform(lower.begin(), lower.end(), lower.begin(), [](char c) { return to_lower(c); });
+    return lower;
+}
+
+uint32_t trigram_at(const std::string& text, size_t position) {
+    return static_cast<uint32_t>(static_cast<unsigned char>(text[position])) << 16 |
+           static_cast<uint32_t>(static_cast<unsigned char>(text[position + 1])) << 8 |
+           static_cast<uint32_t>(static_cast<unsigned char>(text[position + 2]));
+}
+
+} // namespace
+
+IssueSearchIndex::IssueSearchIndex(const IssueStore& store) : issue_count_(store.size()) {
+    // Give every string referenced by an issue a dense index, in order of first use
+    std::vector<uint32_t> string_of_id(store.get_strings().size(), NO_STRING);
+    std::vector<uint32_t> references;
+    references.reserve(issue_count_ * 3);
+    std::vector<uint32_t> issue_counts;
+    for (size_t i = 0; i < issue_count_; ++i) {
+        auto issue = store[i];
+        StringPool::Id ids[] = {issue.file_path_string_id(), issue.rule_id_string_id(), issue.message_string_id()};
+        for (size_t field = 0; field < 3; ++field) {
+            uint32_t& string = string_of_id[ids[field]];
+            if (string == NO_STRING) {
+                string = static_cast<uint32_t>(strings_.size());
+                strings_.push_back(to_lower(store.get_strings().get(ids[field])));
+                issue_counts.push_back(0);
+            }
+            // An issue is listed once per string, even if two of its fields share it
+            bool repeated = (field > 0 && ids[field] == ids[0]) || (field > 1 && ids[field] == ids[1]);
+            references.push_back(repeated ? NO_STRING : string);
+            issue_counts[string] += repeated ? 0 : 1;
+        }
+    }
+
+    // Issues per string; filling in issue order keeps every list sorted
+    string_offsets_.resize(strings_.size() + 1, 0);
+    for (size_t s = 0; s < strings_.size(); ++s) {
+        string_offsets_[s + 1] = string_offsets_[s] + issue_counts[s];
+    }
+    string_issues_.resize(string_offsets_.back());
+    std::vector<uint32_t> next(string_offsets_.begin(), string_offsets_.end() - 1);
+    for (size_t r = 0; r < references.size(); ++r) {
+        if (references[r] != NO_STRING) {
+            string_issues_[next[references[r]]++] = static_cast<uint32_t>(r / 3);
+        }
+    }
+
+    // Strings per trigram
+    std::vector<std::pair<uint32_t, uint32_t>> postings;
+    std::vector<uint32_t> string_trigrams;
+    for (size_t s = 0; s < strings_.size(); ++s) {
+        const std::string& text = strings_[s];
+        string_trigrams.clear();
+        for (size_t position = 0; position + 3 <= text.size(); ++position) {
+            string_trigrams.push_back(trigram_at(text, position));
+        }
+        std::sort(string_trigrams.begin(), string_trigrams.end());
+        string_trigrams.erase(std::unique(string_trigrams.begin(), string_trigrams.end()), string_trigrams.end());
+        for (uint32_t trigram : string_trigrams) {
+            postings.emplace_back(trigram, static_cast<uint32_t>(s));
+        }
+    }
+    std::sort(postings.begin(), postings.end());
+
+    trigram_strings_.reserve(postings.size());
+    for (const auto& [trigram, string] : postings) {
+        if (trigrams_.empty() || trigrams_.back() != trigram) {
+            trigrams_.push_back(trigram);
+            trigram_offsets_.push_back(static_cast<uint32_t>(trigram_strings_.size()));
+        }
+        trigram_strings_.push_back(string);
+    }
+    trigram_offsets_.push_back(static_cast<uint32_t>(trigram_strings_.size()));
+}
+
+std::vector<uint32_t> IssueSearchIndex::find(std::string_view text) const {
+    std::vector<uint32_t> issues;
+    if (text.empty()) {
+        issues.resize(issue_count_);
+        for (size_t i = 0; i < issue_count_; ++i) {
+            issues[i] = static_cast<uint32_t>(i);
+        }
+        return issues;
+    }
+
+    auto strings = find_strings(to_lower(text));
+    if (strings.size() == 1) {
+        return std::vector<uint32_t>(string_issues_.begin() + string_offsets_[strings[0]],
+                                     string_issues_.begin() + string_offsets_[strings[0] + 1]);
+    }
+
+    size_t total = 0;
+    for (uint32_t s : strings) {
+        total += string_offsets_[s + 1] - string_offsets_[s];
+    }
+
+    if (total * 8 < issue_count_) {
+        // Few matches: merge the lists by sorting them
+        issues.reserve(total);
+        for (uint32_t s : strings) {
+            issues.insert(issues.end(), string_issues_.begin() + string_offsets_[s],
+                          string_issues_.begin() + string_offsets_[s + 1]);
+        }
+        std::sort(issues.begin(), issues.end());
+        issues.erase(std::unique(issues.begin(), issues.end()), issues.end());
+    } else {
+        // Many matches: mark them and collect them in order
+        std::vector<uint8_t> matched(issue_count_, 0);
+        for (uint32_t s : strings) {
+            for (uint32_t r = string_offsets_[s]; r < string_offsets_[s + 1]; ++r) {
+                matched[string_issues_[r]] = 1;
+            }
+        }
+        issues.reserve(total);
+        for (size_t i = 0; i < issue_count_; ++i) {
+            if (matched[i]) {
+                issues.push_back(static_cast<uint32_t>(i));
+            }
+        }
+    }
+    return issues;
+}
+
+std::vector<uint32_t> IssueSearchIndex::find_strings(const std::string& text) const {
+    std::vector<uint32_t> candidates;
+    if (text.size() < 3) {
+        // Too short for a trigram: check every distinct string
+        candidates.resize(strings_.size());
+        for (size_t s = 0; s < strings_.size(); ++s) {
+            candidates[s] = static_cast<uint32_t>(s);
+        }
+    } else {
+        // Posting ranges of the text's trigrams; a trigram no string contains rules out every string
+        std::vector<std::pair<uint32_t, uint32_t>> ranges;
+        for (size_t position = 0; position + 3 <= text.size(); ++position) {
+            uint32_t trigram = trigram_at(text, position);
+            auto it = std::lower_bound(trigrams_.begin(), trigrams_.end(), trigram);
+            if (it == trigrams_.end() || *it != trigram) {
+                return {};
+            }
+            size_t t = static_cast<size_t>(it - trigrams_.begin());
+            ranges.emplace_back(trigram_offsets_[t], trigram_offsets_[t + 1]);
+        }
+        std::sort(ranges.begin(), ranges.end(), [](const auto& a, const auto& b) {
+            return std::make_pair(a.second - a.first, a.first) < std::make_pair(b.second - b.first, b.first);
+        });
+        ranges.erase(std::unique(ranges.begin(), ranges.end()), ranges.end());
+
+        // Intersect, shortest list first
+        candidates.assign(trigram_strings_.begin() + ranges[0].first, trigram_strings_.begin() + ranges[0].second);
+        std::vector<uint32_t> intersection;
+        for (size_t r = 1; r < ranges.size() && !candidates.empty(); ++r) {
+            intersection.clear();
+            std::set_intersection(candidates.begin(), candidates.end(), trigram_strings_.begin() + ranges[r].first,
+                                  trigram_strings_.begin() + ranges[r].second, std::back_inserter(intersection));
+            candidates.swap(intersection);
+        }
+    }
+
+    // Trigrams can match out of order, so every candidate is verified
+    candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+                                    [&](uint32_t s) { return strings_[s].find(text) == std::string::npos; }),
+                     candidates.end());
+    return candidates;
+}
+
+size_t IssueSearchIndex::get_memory_usage() const {
+    size_t bytes = strings_.capacity() * sizeof(std::string);
+    for (const auto& text : strings_) {
+        bytes += text.capacity() + 1;
+    }
+    bytes += (string_offsets_.capacity() + string_issues_.capacity() + trigrams_.capacity() +
+              trigram_offsets_.capacity() + trigram_strings_.capacity()) * sizeof(uint32_t);
+    return bytes;
+}
+
+} // namespace analysis
+} // namespace wip
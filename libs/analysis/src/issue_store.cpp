@@ -0,0 +1,183 @@
+#include "issue_store.h"
+#include <iterator>
+
+namespace wip {
+namespace analysis {
+
+// ==================== StringPool Implementation ====================
+
+StringPool::Id StringPool::intern(std::string_view value) {
+    auto it = ids_.find(value);
+    if (it != ids_.end()) {
+        return it->second;
+    }
+
+    Id id = static_cast<Id>(strings_.size());
+    strings_.emplace_back(value);
+    ids_.emplace(strings_.back(), id);
+    character_count_ += value.size();
+    return id;
+}
+
+bool StringPool::find(std::string_view value, Id& id) const {
+    auto it = ids_.find(value);
+    if (it == ids_.end()) {
+        return false;
+    }
+    id = it->second;
+    return true;
+}
+
+void StringPool::clear() {
+    ids_.clear();
+    strings_.clear();
+    character_count_ = 0;
+}
+
+// ==================== IssueStore Implementation ====================
+
+AnalysisIssue IssueStore::IssueView::to_issue() const {
+    AnalysisIssue issue;
+    issue.id = std::string(id());
+    issue.message = std::string(message());
+    issue.file_path = std::string(file_path());
+    issue.line_number = line_number();
+    issue.column_number = column_number();
+    issue.severity = severity();
+    issue.category = category();
+    issue.rule_id = std::string(rule_id());
+    issue.tool_name = std::string(tool_name());
+    if (has_fix_suggestion()) {
+        issue.fix_suggestion = std::string(fix_suggestion());
+    }
+    return issue;
+}
+
+IssueStore::IssueStore(const std::vector<AnalysisIssue>& issues) {
+    reserve(issues.size());
+    for (const auto& issue : issues) {
+        add(issue);
+    }
+}
+
+void IssueStore::add(const AnalysisIssue& issue) {
+    ids_.push_back(strings_.intern(issue.id));
+    messages_.push_back(strings_.intern(issue.message));
+    file_paths_.push_back(strings_.intern(issue.file_path));
+    rule_ids_.push_back(strings_.intern(issue.rule_id));
+    tool_names_.push_back(strings_.intern(issue.tool_name));
+    fix_suggestions_.push_back(issue.fix_suggestion ? strings_.intern(*issue.fix_suggestion) : NO_STRING);
+    line_numbers_.push_back(issue.line_number);
+    column_numbers_.push_back(issue.column_number);
+    severities_.push_back(static_cast<uint8_t>(issue.severity));
+    categories_.push_back(static_cast<uint8_t>(issue.category));
+}
+
+void IssueStore::reserve(size_t issue_count) {
+    ids_.reserve(issue_count);
+    messages_.reserve(issue_count);
+    file_paths_.reserve(issue_count);
+    rule_ids_.reserve(issue_count);
+    tool_names_.reserve(issue_count);
+    fix_suggestions_.reserve(issue_count);
+    line_numbers_.reserve(issue_count);
+    column_numbers_.reserve(issue_count);
+    severities_.reserve(issue_count);
+    categories_.reserve(issue_count);
+}
+
+void IssueStore::clear() {
+    ids_.clear();
+    messages_.clear();
+    file_paths_.clear();
+    rule_ids_.clear();
+    tool_names_.clear();
+    fix_suggestions_.clear();
+    line_numbers_.clear();
+    column_numbers_.clear();
+    severities_.clear();
+    categories_.clear();
+    strings_.clear();
+}
+
+std::vector<AnalysisIssue> IssueStore::to_issues() const {
+    std::vector<AnalysisIssue> issues;
+    issues.reserve(size());
+    for (size_t i = 0; i < size(); ++i) {
+        issues.push_back((*this)[i].to_issue());
+    }
+    return issues;
+}
+
+std::vector<IssueStore::IssueView> IssueStore::get_issues_by_severity(IssueSeverity min_severity) const {
+    std::vector<IssueView> filtered;
+    auto threshold = static_cast<uint8_t>(min_severity);
+    for (size_t i = 0; i < severities_.size(); ++i) {
+        if (severities_[i] >= threshold) {
+            filtered.emplace_back(*this, i);
+        }
+    }
+    return filtered;
+}
+
+std::vector<IssueStore::IssueView> IssueStore::get_issues_by_category(IssueCategory category) const {
+    std::vector<IssueView> filtered;
+    auto wanted = static_cast<uint8_t>(category);
+    for (size_t i = 0; i < categories_.size(); ++i) {
+        if (categories_[i] == wanted) {
+            filtered.emplace_back(*this, i);
+        }
+    }
+    return filtered;
+}
+
+std::vector<IssueStore::IssueView> IssueStore::get_issues_in_file(std::string_view file_path) const {
+    std::vector<IssueView> filtered;
+    StringPool::Id wanted;
+    if (!strings_.find(file_path, wanted)) {
+        return filtered;
+    }
+
+    // Compares IDs only; the path was resolved once above
+    for (size_t i = 0; i < file_paths_.size(); ++i) {
+        if (file_paths_[i] == wanted) {
+            filtered.emplace_back(*this, i);
+        }
+    }
+    return filtered;
+}
+
+std::array<size_t, ISSUE_SEVERITY_COUNT> IssueStore::count_by_severity() const {
+    std::array<size_t, ISSUE_SEVERITY_COUNT> counts{};
+    for (uint8_t severity : severities_) {
+        ++counts[severity];
+    }
+    return counts;
+}
+
+std::array<size_t, ISSUE_CATEGORY_COUNT> IssueStore::count_by_category() const {
+    std::array<size_t, ISSUE_CATEGORY_COUNT> counts{};
+    for (uint8_t category : categories_) {
+        ++counts[category];
+    }
+    return counts;
+}
+
+size_t IssueStore::get_memory_usage() const {
+    size_t bytes = 0;
+
+    // Columns
+    bytes += (ids_.capacity() + messages_.capacity() + file_paths_.capacity() + rule_ids_.capacity() +
+              tool_names_.capacity() + fix_suggestions_.capacity()) * sizeof(StringPool::Id);
+    bytes += (line_numbers_.capacity() + column_numbers_.capacity()) * sizeof(int32_t);
+    bytes += severities_.capacity() + categories_.capacity();
+
+    // Strings, plus one view and ID per hash table entry
+    bytes += strings_.size() * (sizeof(std::string) + sizeof(std::string_view) + sizeof(StringPool::Id));
+    bytes += strings_.get_character_count();
+
+    return bytes;
+}
+
+} // namespace analysis
+} // namespace wip
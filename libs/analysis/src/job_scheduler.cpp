@@ -0,0 +1,146 @@
+#include "job_scheduler.h"
+#include <algorithm>
+
+namespace wip {
+namespace analysis {
+
+namespace {
+
+// Scheduler and worker index of the calling thread, if it is a worker
+thread_local const JobScheduler* current_scheduler = nullptr;
+thread_local size_t current_worker_index = 0;
+
+} // namespace
+
+JobScheduler::JobScheduler(size_t worker_count) {
+    if (worker_count == 0) {
+        worker_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    queues_.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+        queues_.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    workers_.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+        workers_.emplace_back(&JobScheduler::worker_loop, this, i);
+    }
+}
+
+JobScheduler::~JobScheduler() {
+    {
+        std::unique_lock<std::mutex> lock(state_mutex_);
+        all_done_.wait(lock, [this]() { return pending_jobs_ == 0; });
+        stopping_ = true;
+    }
+    work_available_.notify_all();
+
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void JobScheduler::submit(Job job) {
+    if (!job) {
+        return;
+    }
+
+    size_t index = current_scheduler == this ? current_worker_index : next_queue_++ % queues_.size();
+    {
+        std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+        queues_[index]->jobs.push_back(std::move(job));
+    }
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        ++queued_jobs_;
+        ++pending_jobs_;
+    }
+    work_available_.notify_one();
+}
+
+void JobScheduler::wait() {
+    std::unique_lock<std::mutex> lock(state_mutex_);
+    all_done_.wait(lock, [this]() { return pending_jobs_ == 0; });
+
+    if (first_exception_) {
+        auto exception = first_exception_;
+        first_exception_ = nullptr;
+        std::rethrow_exception(exception);
+    }
+}
+
+// ==================== Private Helper Methods ====================
+
+void JobScheduler::worker_loop(size_t index) {
+    current_scheduler = this;
+    current_worker_index = index;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(state_mutex_);
+            work_available_.wait(lock, [this]() { return stopping_ || queued_jobs_ > 0; });
+            if (stopping_ && queued_jobs_ == 0) {
+                return;
+            }
+        }
+
+        Job job;
+        if (!take_job(index, job)) {
+            continue;  // Another worker got there first
+        }
+
+        try {
+            job();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            if (!first_exception_) {
+                first_exception_ = std::current_exception();
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            if (--pending_jobs_ == 0) {
+                all_done_.notify_all();
+            }
+        }
+    }
+}
+
+bool JobScheduler::take_job(size_t index, Job& job) {
+    bool found = false;
+
+    // Own deque first, newest job (its data is most likely still in cache)
+    {
+        std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+        auto& jobs = queues_[index]->jobs;
+        if (!jobs.empty()) {
+            job = std::move(jobs.back());
+            jobs.pop_back();
+            found = true;
+        }
+    }
+
+    // Then steal the oldest job of another worker
+    for (size_t offset = 1; !found && offset < queues_.size(); ++offset) {
+        auto& victim = *queues_[(index + offset) % queues_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            found = true;
+            ++steal_count_;
+        }
+    }
+
+    if (found) {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        --queued_jobs_;
+    }
+
+    return found;
+}
+
+} // namespace analysis
+} // namespace wip
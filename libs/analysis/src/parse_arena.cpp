@@ -0,0 +1,26 @@
+#include "parse_arena.h"
+#include <cstring>
+
+namespace wip {
+namespace analysis {
+
+ParseArena::ParseArena(size_t block_size)
+    : buffer_(block_size), counter_(&buffer_) {
+}
+
+std::string_view ParseArena::copy(std::string_view text) {
+    if (text.empty()) {
+        return std::string_view();
+    }
+    auto* data = static_cast<char*>(counter_.allocate(text.size(), alignof(char)));
+    std::memcpy(data, text.data(), text.size());
+    return std::string_view(data, text.size());
+}
+
+void ParseArena::reset() {
+    buffer_.release();
+    counter_.bytes = 0;
+}
+
+} // namespace analysis
+} // namespace wip
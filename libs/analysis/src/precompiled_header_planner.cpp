@@ -0,0 +1,293 @@
+#include "precompiled_header_planner.h"
+#include "compilation_database.h"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <tuple>
+
+namespace wip {
+namespace analysis {
+
+namespace {
+
+// Skips whitespace and comments; false at the end of the line
+bool skip_blank(std::string_view line, size_t& pos, bool& in_comment) {
+    while (pos < line.size()) {
+        if (in_comment) {
+            size_t end = line.find("*/", pos);
+            if (end == std::string_view::npos) {
+                pos = line.size();
+                return false;
+            }
+            pos = end + 2;
+            in_comment = false;
+        } else if (std::isspace(static_cast<unsigned char>(line[pos]))) {
+            ++pos;
+        } else if (line.compare(pos, 2, "//") == 0) {
+            pos = line.size();
+        } else if (line.compare(pos, 2, "/*") == 0) {
+            pos += 2;
+            in_comment = true;
+        } else {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string_view next_word(std::string_view line, size_t& pos) {
+    size_t begin = pos;
+    while (pos < line.size() && (std::isalnum(static_cast<unsigned char>(line[pos])) || line[pos] == '_')) {
+        ++pos;
+    }
+    return line.substr(begin, pos - begin);
+}
+
+// Calls on_directive(name, line, pos after the name) for every directive up
+// to the first line of code, or until on_directive returns false
+template<typename Function>
+void for_each_leading_directive(std::string_view contents, Function on_directive) {
+    bool in_comment = false;
+    size_t line_begin = 0;
+    while (line_begin < contents.size()) {
+        size_t line_end = contents.find('\n', line_begin);
+        if (line_end == std::string_view::npos) {
+            line_end = contents.size();
+        }
+        std::string_view line = contents.substr(line_begin, line_end - line_begin);
+        line_begin = line_end + 1;
+
+        size_t pos = 0;
+        if (!skip_blank(line, pos, in_comment)) {
+            continue;
+        }
+        if (line[pos] != '#') {
+            return;
+        }
+        ++pos;
+        skip_blank(line, pos, in_comment);
+        auto name = next_word(line, pos);
+        if (!on_directive(name, line, pos)) {
+            return;
+        }
+    }
+}
+
+// A project header is included again by the unit after the precompiled header
+bool has_include_guard(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    bool guarded = false;
+    for_each_leading_directive(contents, [&guarded](std::string_view name, std::string_view line, size_t pos) {
+        bool in_comment = false;
+        skip_blank(line, pos, in_comment);
+        guarded = name == "ifndef" || (name == "pragma" && next_word(line, pos) == "once");
+        return false;
+    });
+    return guarded;
+}
+
+std::string find_file(const std::string& name, const std::vector<std::string>& directories) {
+    std::error_code ec;
+    for (const auto& directory : directories) {
+        auto candidate = (std::filesystem::path(directory) / name).lexically_normal();
+        if (std::filesystem::is_regular_file(candidate, ec)) {
+            return candidate.string();
+        }
+    }
+    return "";
+}
+
+// Drops the compiler, the input and every output, which differ per unit
+std::vector<std::string> compile_flags(const CompilationDatabase::Entry& entry) {
+    static const char* const OPTIONS_WITH_VALUE[] = {"-o", "-MF", "-MT", "-MQ"};
+    static const char* const DROPPED_OPTIONS[] = {"-c", "-MD", "-MMD", "-M", "-MM", "-MP"};
+
+    auto arguments = entry.get_arguments();
+    std::vector<std::string> flags;
+    for (size_t i = 1; i < arguments.size(); ++i) {
+        const auto& argument = arguments[i];
+        if (std::find(std::begin(OPTIONS_WITH_VALUE), std::end(OPTIONS_WITH_VALUE), argument) != std::end(OPTIONS_WITH_VALUE)) {
+            ++i;
+        } else if (std::find(std::begin(DROPPED_OPTIONS), std::end(DROPPED_OPTIONS), argument) != std::end(DROPPED_OPTIONS) ||
+                   (argument.size() > 2 && argument.compare(0, 2, "-o") == 0) ||
+                   ((argument.empty() || argument[0] != '-') &&
+                    (std::filesystem::path(entry.directory) / argument).lexically_normal() == entry.file)) {
+            continue;
+        } else {
+            flags.push_back(argument);
+        }
+    }
+    return flags;
+}
+
+struct PlanContext {
+    const std::vector<const PrecompiledHeaderPlanner::Unit*>& units;
+    size_t min_units;
+    std::vector<PrecompiledHeaderPlanner::Group>& groups;
+};
+
+// Units in [begin, end) share their first depth includes
+void split(PlanContext& context, size_t begin, size_t end, size_t depth) {
+    std::vector<const PrecompiledHeaderPlanner::Unit*> leftovers;
+    size_t i = begin;
+    while (i < end) {
+        const auto& includes = context.units[i]->includes;
+        if (includes.size() == depth) {
+            leftovers.push_back(context.units[i++]);
+            continue;
+        }
+        size_t j = i + 1;
+        while (j < end && context.units[j]->includes[depth] == includes[depth]) {
+            ++j;
+        }
+        if (j - i >= context.min_units) {
+            split(context, i, j, depth + 1);
+        } else {
+            leftovers.insert(leftovers.end(), context.units.begin() + i, context.units.begin() + j);
+        }
+        i = j;
+    }
+
+    if (depth > 0 && leftovers.size() >= context.min_units) {
+        PrecompiledHeaderPlanner::Group group;
+        group.command = leftovers.front()->command;
+        group.includes.assign(leftovers.front()->includes.begin(), leftovers.front()->includes.begin() + depth);
+        for (const auto* unit : leftovers) {
+            group.units.push_back(unit->path);
+        }
+        std::sort(group.units.begin(), group.units.end());
+        context.groups.push_back(std::move(group));
+    }
+}
+
+} // namespace
+
+bool PrecompiledHeaderPlanner::CompileCommand::operator<(const CompileCommand& other) const {
+    return std::tie(directory, language, flags) < std::tie(other.directory, other.language, other.flags);
+}
+
+bool PrecompiledHeaderPlanner::CompileCommand::operator==(const CompileCommand& other) const {
+    return directory == other.directory && language == other.language && flags == other.flags;
+}
+
+std::vector<std::string> PrecompiledHeaderPlanner::leading_includes(std::string_view contents,
+                                                                    const std::string& unit_path,
+                                                                    const std::vector<std::string>& include_dirs) {
+    std::vector<std::string> quoted_dirs = {std::filesystem::path(unit_path).parent_path().string()};
+    quoted_dirs.insert(quoted_dirs.end(), include_dirs.begin(), include_dirs.end());
+
+    std::vector<std::string> includes;
+    for_each_leading_directive(contents, [&](std::string_view name, std::string_view line, size_t pos) {
+        if (name != "include") {
+            return false;
+        }
+        bool in_comment = false;
+        skip_blank(line, pos, in_comment);
+        if (pos >= line.size() || (line[pos] != '"' && line[pos] != '<')) {
+            return false;
+        }
+        char close = line[pos] == '"' ? '"' : '>';
+        size_t end = line.find(close, pos + 1);
+        if (end == std::string_view::npos) {
+            return false;
+        }
+        std::string target(line.substr(pos + 1, end - pos - 1));
+
+        // Headers outside the project are taken to be guarded, like system headers
+        auto path = find_file(target, close == '"' ? quoted_dirs : include_dirs);
+        if (!path.empty() && !has_include_guard(path)) {
+            return false;
+        }
+        if (close == '"' && !path.empty()) {
+            includes.push_back('"' + path + '"');
+        } else {
+            includes.push_back('<' + target + '>');
+        }
+        return true;
+    });
+    return includes;
+}
+
+std::vector<PrecompiledHeaderPlanner::Group> PrecompiledHeaderPlanner::plan(const std::vector<Unit>& units,
+                                                                            size_t min_units) {
+    std::map<CompileCommand, std::vector<const Unit*>> by_command;
+    for (const auto& unit : units) {
+        if (!unit.includes.empty()) {
+            by_command[unit.command].push_back(&unit);
+        }
+    }
+
+    std::vector<Group> groups;
+    for (auto& [command, command_units] : by_command) {
+        std::sort(command_units.begin(), command_units.end(), [](const Unit* a, const Unit* b) {
+            return std::tie(a->includes, a->path) < std::tie(b->includes, b->path);
+        });
+        PlanContext context{command_units, std::max<size_t>(min_units, 2), groups};
+        split(context, 0, command_units.size(), 0);
+    }
+
+    std::sort(groups.begin(), groups.end(), [](const Group& a, const Group& b) {
+        if (a.units.size() != b.units.size()) {
+            return a.units.size() > b.units.size();
+        }
+        return a.units.front() < b.units.front();
+    });
+    return groups;
+}
+
+std::string PrecompiledHeaderPlanner::header_text(const Group& group) {
+    std::string text = "// Include prefix shared by " + std::to_string(group.units.size()) + " translation units\n";
+    for (const auto& include : group.includes) {
+        text += "#include " + include + "\n";
+    }
+    return text;
+}
+
+std::map<std::string, PrecompiledHeaderPlanner::CompileCommand> PrecompiledHeaderPlanner::read_compile_commands(
+    const std::string& build_dir) {
+    std::map<std::string, CompileCommand> commands;
+    auto database = CompilationDatabase::open(build_dir);
+    if (!database) {
+        return commands;
+    }
+
+    for (const auto& entry : database->get_entries()) {
+        CompileCommand command;
+        command.directory = entry.directory;
+        command.flags = compile_flags(entry);
+        command.language = std::filesystem::path(entry.file).extension() == ".c" ? "c" : "c++";
+        commands.emplace(entry.file, std::move(command));
+    }
+    return commands;
+}
+
+std::vector<std::string> PrecompiledHeaderPlanner::get_include_dirs(const CompileCommand& command) {
+    std::vector<std::string> directories;
+    auto add = [&](const std::string& directory) {
+        std::filesystem::path path(directory);
+        if (path.is_relative()) {
+            path = std::filesystem::path(command.directory) / path;
+        }
+        directories.push_back(path.lexically_normal().string());
+    };
+
+    for (size_t i = 0; i < command.flags.size(); ++i) {
+        const auto& flag = command.flags[i];
+        if ((flag == "-I" || flag == "-iquote") && i + 1 < command.flags.size()) {
+            add(command.flags[++i]);
+        } else if (flag.size() > 2 && flag.compare(0, 2, "-I") == 0) {
+            add(flag.substr(2));
+        }
+    }
+    return directories;
+}
+
+} // namespace analysis
+} // namespace wip
@@ -0,0 +1,167 @@
+#include "progress_channel.h"
+#include <utility>
+
+namespace wip {
+namespace analysis {
+
+namespace {
+
+size_t round_up_to_power_of_two(size_t value) {
+    size_t result = 2;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+} // namespace
+
+ProgressChannel::ProgressChannel(std::vector<std::string> tool_names, size_t line_capacity)
+    : tool_names_(std::move(tool_names)),
+      mask_(round_up_to_power_of_two(line_capacity) - 1) {
+    // A cell is free for the producer whose position equals its sequence
+    cells_.reset(new Cell[mask_ + 1]);
+    for (size_t i = 0; i <= mask_; ++i) {
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    progress_.reset(new std::atomic<AnalysisProgress*>[tool_names_.size()]);
+    for (size_t i = 0; i < tool_names_.size(); ++i) {
+        progress_[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+ProgressChannel::~ProgressChannel() {
+    for (size_t i = 0; i < tool_names_.size(); ++i) {
+        delete progress_[i].load(std::memory_order_acquire);
+    }
+}
+
+size_t ProgressChannel::find_tool(const std::string& tool_name) const {
+    // A run has a handful of tools, so a scan beats hashing the name
+    for (size_t i = 0; i < tool_names_.size(); ++i) {
+        if (tool_names_[i] == tool_name) {
+            return i;
+        }
+    }
+    return tool_names_.size();
+}
+
+bool ProgressChannel::publish_line(const std::string& tool_name, std::string line) {
+    size_t tool = find_tool(tool_name);
+    if (tool == tool_names_.size()) {
+        lines_dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    size_t position = enqueue_position_.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+        cell = &cells_[position & mask_];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+        if (difference == 0) {
+            if (enqueue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            // The drain has not freed this cell yet: the ring is full
+            lines_dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            position = enqueue_position_.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->tool = static_cast<uint32_t>(tool);
+    cell->line = std::move(line);
+    cell->sequence.store(position + 1, std::memory_order_release);
+
+    lines_published_.fetch_add(1, std::memory_order_relaxed);
+    note_queued(position + 1 - dequeue_position_.load(std::memory_order_relaxed));
+    return true;
+}
+
+void ProgressChannel::note_queued(size_t queued) {
+    // The drain may already be past this line, which makes the count wrap; those are ignored
+    size_t peak = peak_queued_lines_.load(std::memory_order_relaxed);
+    while (queued > peak && queued <= mask_ + 1 &&
+           !peak_queued_lines_.compare_exchange_weak(peak, queued, std::memory_order_relaxed)) {
+    }
+}
+
+void ProgressChannel::publish_progress(const std::string& tool_name, const AnalysisProgress& progress) {
+    size_t tool = find_tool(tool_name);
+    if (tool == tool_names_.size()) {
+        return;
+    }
+
+    progress_published_.fetch_add(1, std::memory_order_relaxed);
+    AnalysisProgress* previous = progress_[tool].exchange(new AnalysisProgress(progress), std::memory_order_acq_rel);
+    if (previous) {
+        // Never seen by the UI; the newer update supersedes it
+        progress_merged_.fetch_add(1, std::memory_order_relaxed);
+        delete previous;
+    }
+}
+
+size_t ProgressChannel::drain(const LineHandler& on_line, const ProgressHandler& on_progress, size_t max_lines) {
+    size_t delivered = 0;
+    size_t position = dequeue_position_.load(std::memory_order_relaxed);
+    while (max_lines == 0 || delivered < max_lines) {
+        Cell& cell = cells_[position & mask_];
+        if (cell.sequence.load(std::memory_order_acquire) != position + 1) {
+            break;      // Empty, or the producer of this cell has not finished writing it
+        }
+
+        if (on_line) {
+            on_line(tool_names_[cell.tool], cell.line);
+        }
+        cell.line.clear();
+        cell.sequence.store(position + mask_ + 1, std::memory_order_release);
+        ++position;
+        ++delivered;
+    }
+    dequeue_position_.store(position, std::memory_order_relaxed);
+    lines_delivered_.fetch_add(delivered, std::memory_order_relaxed);
+
+    for (size_t i = 0; i < tool_names_.size(); ++i) {
+        std::unique_ptr<AnalysisProgress> progress(progress_[i].exchange(nullptr, std::memory_order_acq_rel));
+        if (progress) {
+            progress_delivered_.fetch_add(1, std::memory_order_relaxed);
+            if (on_progress) {
+                on_progress(tool_names_[i], *progress);
+            }
+        }
+    }
+
+    return delivered;
+}
+
+bool ProgressChannel::has_pending() const {
+    size_t position = dequeue_position_.load(std::memory_order_relaxed);
+    if (cells_[position & mask_].sequence.load(std::memory_order_acquire) == position + 1) {
+        return true;
+    }
+    for (size_t i = 0; i < tool_names_.size(); ++i) {
+        if (progress_[i].load(std::memory_order_acquire)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+ProgressChannel::Statistics ProgressChannel::get_statistics() const {
+    Statistics statistics;
+    statistics.lines_published = lines_published_.load(std::memory_order_relaxed);
+    statistics.lines_delivered = lines_delivered_.load(std::memory_order_relaxed);
+    statistics.lines_dropped = lines_dropped_.load(std::memory_order_relaxed);
+    statistics.progress_published = progress_published_.load(std::memory_order_relaxed);
+    statistics.progress_merged = progress_merged_.load(std::memory_order_relaxed);
+    statistics.progress_delivered = progress_delivered_.load(std::memory_order_relaxed);
+    statistics.peak_queued_lines = peak_queued_lines_.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+} // namespace analysis
+} // namespace wip
@@ -0,0 +1,678 @@
+#include "report_writer.h"
+#include <charconv>
+#include <ctime>
+#include <iterator>
+#include <stdexcept>
+
+namespace wip {
+namespace analysis {
+
+namespace {
+
+constexpr const char* SARIF_SCHEMA = "https://json.schemastore.org/sarif-2.1.0.json";
+
+void append_number(std::string& out, size_t value) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    out.append(digits, result.ptr);
+}
+
+void append_number(std::string& out, int value) {
+    char digits[16];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    out.append(digits, result.ptr);
+}
+
+// Appends text as a quoted JSON string
+void append_json(std::string& out, std::string_view text) {
+    static constexpr char HEX[] = "0123456789abcdef";
+    out += '"';
+    size_t plain = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+        const auto c = static_cast<unsigned char>(text[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        out.append(text.data() + plain, i - plain);
+        plain = i + 1;
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                out += "\\u00";
+                out += HEX[c >> 4];
+                out += HEX[c & 0xF];
+        }
+    }
+    out.append(text.data() + plain, text.size() - plain);
+    out += '"';
+}
+
+// Appends "key": "value"
+void append_json_field(std::string& out, std::string_view key, std::string_view value) {
+    append_json(out, key);
+    out += ": ";
+    append_json(out, value);
+}
+
+void append_html(std::string& out, std::string_view text) {
+    size_t plain = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+        const char* entity = nullptr;
+        switch (text[i]) {
+            case '&':  entity = "&amp;"; break;
+            case '<':  entity = "&lt;"; break;
+            case '>':  entity = "&gt;"; break;
+            case '"':  entity = "&quot;"; break;
+            case '\'': entity = "&#39;"; break;
+            default:   continue;
+        }
+        out.append(text.data() + plain, i - plain);
+        out += entity;
+        plain = i + 1;
+    }
+    out.append(text.data() + plain, text.size() - plain);
+}
+
+// SARIF locations are URIs: forward slashes, a scheme for absolute paths and escaped spaces
+void append_uri(std::string& out, std::string_view path) {
+    const bool absolute = (!path.empty() && (path[0] == '/' || path[0] == '\\')) ||
+                          (path.size() > 2 && path[1] == ':' && (path[2] == '/' || path[2] == '\\'));
+    std::string uri = absolute ? (path[0] == '/' ? "file://" : "file:///") : "";
+    for (char c : path) {
+        switch (c) {
+            case '\\': uri += '/'; break;
+            case ' ':  uri += "%20"; break;
+            case '%':  uri += "%25"; break;
+            default:   uri += c;
+        }
+    }
+    append_json(out, uri);
+}
+
+const char* sarif_level(IssueSeverity severity) {
+    switch (severity) {
+        case IssueSeverity::Critical:
+        case IssueSeverity::Error:    return "error";
+        case IssueSeverity::Warning:  return "warning";
+        default:                      return "note";
+    }
+}
+
+// Appends an issue as a one-line JSON object with the members of
+// AnalysisIssue::to_json(), so readers can use AnalysisIssue::from_json()
+void append_issue_json(std::string& out, const ReportIssue& issue, std::string_view tool_name) {
+    out += '{';
+    append_json_field(out, "id", issue.id);
+    out += ", ";
+    append_json_field(out, "message", issue.message);
+    out += ", ";
+    append_json_field(out, "file_path", issue.file_path);
+    out += ", \"line_number\": ";
+    append_number(out, issue.line_number);
+    out += ", \"column_number\": ";
+    append_number(out, issue.column_number);
+    out += ", ";
+    append_json_field(out, "severity", severity_to_string(issue.severity));
+    out += ", ";
+    append_json_field(out, "category", category_to_string(issue.category));
+    out += ", ";
+    append_json_field(out, "rule_id", issue.rule_id);
+    out += ", ";
+    append_json_field(out, "tool_name", issue.tool_name.empty() ? tool_name : issue.tool_name);
+    if (!issue.fix_suggestion.empty()) {
+        out += ", ";
+        append_json_field(out, "fix_suggestion", issue.fix_suggestion);
+    }
+    out += '}';
+}
+
+// Appends an issue as a SARIF result object; a non-empty tool name is added to its property bag
+void append_sarif_result(std::string& out, const ReportIssue& issue, std::string_view tool_name) {
+    out += '{';
+    append_json_field(out, "ruleId", issue.rule_id);
+    out += ", ";
+    append_json_field(out, "level", sarif_level(issue.severity));
+    out += ", \"message\": {";
+    append_json_field(out, "text", issue.message);
+    out += "}";
+    if (!issue.file_path.empty()) {
+        out += ", \"locations\": [{\"physicalLocation\": {\"artifactLocation\": {\"uri\": ";
+        append_uri(out, issue.file_path);
+        out += '}';
+        // SARIF regions start at line 1; an unknown line leaves the region out
+        if (issue.line_number > 0) {
+            out += ", \"region\": {\"startLine\": ";
+            append_number(out, issue.line_number);
+            if (issue.column_number > 0) {
+                out += ", \"startColumn\": ";
+                append_number(out, issue.column_number);
+            }
+            out += '}';
+        }
+        out += "}}]";
+    }
+    out += ", \"properties\": {";
+    if (!tool_name.empty()) {
+        append_json_field(out, "tool", tool_name);
+        out += ", ";
+    }
+    append_json_field(out, "severity", severity_to_string(issue.severity));
+    out += ", ";
+    append_json_field(out, "category", category_to_string(issue.category));
+    out += "}}";
+}
+
+std::string format_utc(std::chrono::system_clock::time_point time) {
+    const std::time_t seconds = std::chrono::system_clock::to_time_t(time);
+    std::tm utc{};
+#ifdef _WIN32
+    gmtime_s(&utc, &seconds);
+#else
+    gmtime_r(&seconds, &utc);
+#endif
+    char text[32];
+    size_t length = std::strftime(text, sizeof(text), "%Y-%m-%dT%H:%M:%SZ", &utc);
+    return std::string(text, length);
+}
+
+constexpr IssueSeverity SEVERITIES[] = {IssueSeverity::Info, IssueSeverity::Warning, IssueSeverity::Error,
+                                        IssueSeverity::Critical};
+constexpr IssueCategory CATEGORIES[] = {IssueCategory::Style, IssueCategory::Performance, IssueCategory::Security,
+                                        IssueCategory::Bug, IssueCategory::Portability, IssueCategory::Modernization,
+                                        IssueCategory::Maintainability};
+
+// Appends the statistics and summary as the members of a JSON object
+void append_statistics(std::string& out, const ReportStatistics& statistics, const ReportWriter::Summary& summary,
+                       std::string_view indent) {
+    out += indent;
+    out += "\"total_issues\": ";
+    append_number(out, statistics.total_issues);
+    out += ",\n";
+    out += indent;
+    out += "\"issue_counts_by_severity\": {";
+    for (size_t i = 0; i < std::size(SEVERITIES); ++i) {
+        out += i ? ", " : "";
+        append_json(out, severity_to_string(SEVERITIES[i]));
+        out += ": ";
+        append_number(out, statistics.get_issue_count(SEVERITIES[i]));
+    }
+    out += "},\n";
+    out += indent;
+    out += "\"issue_counts_by_category\": {";
+    for (size_t i = 0; i < std::size(CATEGORIES); ++i) {
+        out += i ? ", " : "";
+        append_json(out, category_to_string(CATEGORIES[i]));
+        out += ": ";
+        append_number(out, statistics.get_issue_count(CATEGORIES[i]));
+    }
+    out += "},\n";
+    out += indent;
+    out += "\"tool_count\": ";
+    append_number(out, statistics.tool_count);
+    out += ",\n";
+    out += indent;
+    out += "\"failed_tool_count\": ";
+    append_number(out, statistics.failed_tool_count);
+    for (const auto& [key, value] : summary) {
+        out += ",\n";
+        out += indent;
+        append_json_field(out, key, value);
+    }
+    out += '\n';
+}
+
+} // namespace
+
+// ==================== ReportIssue Implementation ====================
+
+ReportIssue::ReportIssue(const AnalysisIssue& issue)
+    : id(issue.id), message(issue.message), file_path(issue.file_path),
+      line_number(issue.line_number), column_number(issue.column_number),
+      severity(issue.severity), category(issue.category),
+      rule_id(issue.rule_id), tool_name(issue.tool_name),
+      fix_suggestion(issue.fix_suggestion ? std::string_view(*issue.fix_suggestion) : std::string_view()) {
+}
+
+ReportIssue::ReportIssue(const BinaryResultFile::IssueView& issue)
+    : id(issue.id()), message(issue.message()), file_path(issue.file_path()),
+      line_number(issue.line_number()), column_number(issue.column_number()),
+      severity(issue.severity()), category(issue.category()),
+      rule_id(issue.rule_id()), tool_name(issue.tool_name()),
+      fix_suggestion(issue.fix_suggestion()) {
+}
+
+// ==================== ReportWriter Implementation ====================
+
+ReportWriter::ReportWriter(std::ostream& out, ReportFormat format, const ReportHeader& header)
+    : out_(out), format_(format), header_(header) {
+    write_header();
+}
+
+void ReportWriter::write_header() {
+    switch (format_) {
+        case ReportFormat::Json:
+            line_ += "{\n  \"report_version\": \"2.0\",\n  ";
+            append_json_field(line_, "title", header_.title);
+            line_ += ",\n  \"generator\": {";
+            append_json_field(line_, "name", header_.generator_name);
+            line_ += ", ";
+            append_json_field(line_, "version", header_.generator_version);
+            line_ += "},\n  ";
+            append_json_field(line_, "generated_at", format_utc(header_.generated_at));
+            line_ += ",\n  \"project\": {\n    ";
+            append_json_field(line_, "name", header_.project_name);
+            for (const auto& [key, value] : header_.properties) {
+                line_ += ",\n    ";
+                append_json_field(line_, key, value);
+            }
+            line_ += "\n  },\n  \"tools\": [";
+            break;
+
+        case ReportFormat::Html:
+            line_ += "<!DOCTYPE html>\n<html><head><meta charset='utf-8'><title>";
+            append_html(line_, header_.title);
+            line_ += "</title>\n<style>\n"
+                     "body { font-family: Arial, sans-serif; margin: 40px; }\n"
+                     ".header { background-color: #2c3e50; color: white; padding: 20px; border-radius: 8px; }\n"
+                     ".section { margin: 20px 0; padding: 15px; border: 1px solid #ddd; border-radius: 5px; }\n"
+                     "table { border-collapse: collapse; width: 100%; }\n"
+                     "th, td { text-align: left; padding: 4px 8px; border-bottom: 1px solid #eee; }\n"
+                     ".critical { color: #e74c3c; }\n"
+                     ".error { color: #e67e22; }\n"
+                     ".warning { color: #f39c12; }\n"
+                     ".info { color: #3498db; }\n"
+                     "</style></head><body>\n<div class='header'>\n<h1>";
+            append_html(line_, header_.title);
+            line_ += "</h1>\n<p>Project: ";
+            append_html(line_, header_.project_name);
+            line_ += "</p>\n<p>Generated: ";
+            append_html(line_, format_utc(header_.generated_at));
+            line_ += " by ";
+            append_html(line_, header_.generator_name);
+            line_ += ' ';
+            append_html(line_, header_.generator_version);
+            line_ += "</p>\n</div>\n";
+            if (!header_.properties.empty()) {
+                line_ += "<div class='section'>\n<h2>Project</h2>\n<table>\n";
+                for (const auto& [key, value] : header_.properties) {
+                    line_ += "<tr><th>";
+                    append_html(line_, key);
+                    line_ += "</th><td>";
+                    append_html(line_, value);
+                    line_ += "</td></tr>\n";
+                }
+                line_ += "</table>\n</div>\n";
+            }
+            break;
+
+        case ReportFormat::Sarif:
+            line_ += "{\n  ";
+            append_json_field(line_, "$schema", SARIF_SCHEMA);
+            line_ += ",\n  \"version\": \"2.1.0\",\n  \"runs\": [";
+            break;
+    }
+    flush_line();
+}
+
+void ReportWriter::begin_tool(std::string_view name, std::string_view version) {
+    if (tool_open_ || finished_) {
+        throw std::logic_error("ReportWriter: begin_tool() while a tool is open or after finish()");
+    }
+    tool_open_ = true;
+    tool_issue_count_ = 0;
+    tool_name_.assign(name);
+    const bool first = statistics_.tool_count++ == 0;
+
+    switch (format_) {
+        case ReportFormat::Json:
+            line_ += first ? "\n    {\n      " : ",\n    {\n      ";
+            append_json_field(line_, "name", name);
+            line_ += ",\n      ";
+            append_json_field(line_, "version", version);
+            line_ += ",\n      \"issues\": [";
+            break;
+
+        case ReportFormat::Html:
+            line_ += "<div class='section'>\n<h2>";
+            append_html(line_, name);
+            if (!version.empty()) {
+                line_ += ' ';
+                append_html(line_, version);
+            }
+            line_ += "</h2>\n<table>\n<tr><th>Severity</th><th>Location</th><th>Rule</th><th>Message</th></tr>\n";
+            break;
+
+        case ReportFormat::Sarif:
+            line_ += first ? "\n    {\n      " : ",\n    {\n      ";
+            line_ += "\"tool\": {\"driver\": {";
+            append_json_field(line_, "name", name);
+            if (!version.empty()) {
+                line_ += ", ";
+                append_json_field(line_, "version", version);
+            }
+            line_ += "}},\n      \"results\": [";
+            break;
+    }
+    flush_line();
+}
+
+void ReportWriter::write_issue(const ReportIssue& issue) {
+    if (!tool_open_) {
+        throw std::logic_error("ReportWriter: write_issue() outside begin_tool() / end_tool()");
+    }
+    const bool first = tool_issue_count_++ == 0;
+    ++statistics_.total_issues;
+    ++statistics_.issues_by_severity[static_cast<size_t>(issue.severity)];
+    ++statistics_.issues_by_category[static_cast<size_t>(issue.category)];
+
+    switch (format_) {
+        case ReportFormat::Json:
+            line_ += first ? "\n        " : ",\n        ";
+            append_issue_json(line_, issue, tool_name_);
+            break;
+
+        case ReportFormat::Html: {
+            const std::string severity = severity_to_string(issue.severity);
+            line_ += "<tr class='";
+            line_ += severity;
+            line_ += "'><td>";
+            line_ += severity;
+            line_ += "</td><td>";
+            append_html(line_, issue.file_path);
+            if (issue.line_number > 0) {
+                line_ += ':';
+                append_number(line_, issue.line_number);
+            }
+            line_ += "</td><td>";
+            append_html(line_, issue.rule_id);
+            line_ += "</td><td>";
+            append_html(line_, issue.message);
+            line_ += "</td></tr>\n";
+            break;
+        }
+
+        case ReportFormat::Sarif:
+            line_ += first ? "\n        " : ",\n        ";
+            append_sarif_result(line_, issue, {});
+            break;
+    }
+    flush_line();
+}
+
+void ReportWriter::end_tool(bool success, std::string_view error_message) {
+    if (!tool_open_) {
+        throw std::logic_error("ReportWriter: end_tool() without begin_tool()");
+    }
+    tool_open_ = false;
+    if (!success) {
+        ++statistics_.failed_tool_count;
+    }
+
+    switch (format_) {
+        case ReportFormat::Json:
+            line_ += tool_issue_count_ ? "\n      ],\n      \"issue_count\": " : "],\n      \"issue_count\": ";
+            append_number(line_, tool_issue_count_);
+            line_ += success ? ",\n      \"success\": true,\n      " : ",\n      \"success\": false,\n      ";
+            append_json_field(line_, "error_message", error_message);
+            line_ += "\n    }";
+            break;
+
+        case ReportFormat::Html:
+            line_ += "</table>\n<p>";
+            append_number(line_, tool_issue_count_);
+            line_ += tool_issue_count_ == 1 ? " issue" : " issues";
+            line_ += success ? "</p>\n" : ", <span class='critical'>failed: ";
+            if (!success) {
+                append_html(line_, error_message);
+                line_ += "</span></p>\n";
+            }
+            line_ += "</div>\n";
+            break;
+
+        case ReportFormat::Sarif:
+            line_ += tool_issue_count_ ? "\n      ],\n" : "],\n";
+            line_ += "      \"invocations\": [{\"executionSuccessful\": ";
+            line_ += success ? "true" : "false";
+            if (!error_message.empty()) {
+                line_ += ", \"toolExecutionNotifications\": [{\"level\": \"error\", \"message\": {";
+                append_json_field(line_, "text", error_message);
+                line_ += "}}]";
+            }
+            line_ += "}]\n    }";
+            break;
+    }
+    flush_line();
+}
+
+void ReportWriter::write_result(const AnalysisResult& result) {
+    begin_tool(result.tool_name);
+    for (const auto& issue : result.issues) {
+        write_issue(issue);
+    }
+    end_tool(result.success, result.error_message);
+}
+
+const ReportStatistics& ReportWriter::finish(const Summary& summary) {
+    if (finished_) {
+        return statistics_;
+    }
+    if (tool_open_) {
+        end_tool();
+    }
+    finished_ = true;
+
+    switch (format_) {
+        case ReportFormat::Json:
+            line_ += statistics_.tool_count ? "\n  ],\n  \"statistics\": {\n" : "],\n  \"statistics\": {\n";
+            append_statistics(line_, statistics_, summary, "    ");
+            line_ += "  }\n}\n";
+            break;
+
+        case ReportFormat::Html:
+            line_ += "<div class='section'>\n<h2>Summary</h2>\n<table>\n<tr><th>Total issues</th><td>";
+            append_number(line_, statistics_.total_issues);
+            line_ += "</td></tr>\n";
+            for (auto it = std::rbegin(SEVERITIES); it != std::rend(SEVERITIES); ++it) {
+                const std::string severity = severity_to_string(*it);
+                line_ += "<tr class='" + severity + "'><th>" + severity + "</th><td>";
+                append_number(line_, statistics_.get_issue_count(*it));
+                line_ += "</td></tr>\n";
+            }
+            line_ += "<tr><th>Tools</th><td>";
+            append_number(line_, statistics_.tool_count);
+            if (statistics_.failed_tool_count > 0) {
+                line_ += " (";
+                append_number(line_, statistics_.failed_tool_count);
+                line_ += " failed)";
+            }
+            line_ += "</td></tr>\n";
+            for (const auto& [key, value] : summary) {
+                line_ += "<tr><th>";
+                append_html(line_, key);
+                line_ += "</th><td>";
+                append_html(line_, value);
+                line_ += "</td></tr>\n";
+            }
+            line_ += "</table>\n</div>\n</body></html>\n";
+            break;
+
+        case ReportFormat::Sarif:
+            // Project and statistics go in the log's property bag
+            line_ += statistics_.tool_count ? "\n  ],\n  \"properties\": {\n    " : "],\n  \"properties\": {\n    ";
+            append_json_field(line_, "title", header_.title);
+            line_ += ",\n    ";
+            append_json_field(line_, "project", header_.project_name);
+            line_ += ",\n    ";
+            append_json_field(line_, "generated_at", format_utc(header_.generated_at));
+            for (const auto& [key, value] : header_.properties) {
+                line_ += ",\n    ";
+                append_json_field(line_, key, value);
+            }
+            line_ += ",\n";
+            append_statistics(line_, statistics_, summary, "    ");
+            line_ += "  }\n}\n";
+            break;
+    }
+    flush_line();
+    out_.flush();
+    return statistics_;
+}
+
+void ReportWriter::flush_line() {
+    out_.write(line_.data(), static_cast<std::streamsize>(line_.size()));
+    line_.clear();
+}
+
+// ==================== NdjsonIssueWriter ====================
+
+void NdjsonIssueWriter::write_issues(std::string_view tool_name, const std::vector<AnalysisIssue>& issues) {
+    std::string lines;
+    for (const auto& issue : issues) {
+        append_issue_json(lines, issue, tool_name);
+        lines += '\n';
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    out_.write(lines.data(), static_cast<std::streamsize>(lines.size()));
+    issue_count_ += issues.size();
+}
+
+NdjsonIssueWriter::Callback NdjsonIssueWriter::callback() {
+    return [this](const std::string& tool_name, const std::vector<AnalysisIssue>& issues) {
+        write_issues(tool_name, issues);
+    };
+}
+
+size_t NdjsonIssueWriter::get_issue_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return issue_count_;
+}
+
+// ==================== SarifIssueWriter ====================
+
+SarifIssueWriter::SarifIssueWriter(std::ostream& out, const ReportHeader& header) : out_(out), header_(header) {
+    std::string text = "{\n  ";
+    append_json_field(text, "$schema", SARIF_SCHEMA);
+    text += ",\n  \"version\": \"2.1.0\",\n  \"runs\": [\n    {\n      \"results\": [";
+    out_.write(text.data(), static_cast<std::streamsize>(text.size()));
+}
+
+size_t SarifIssueWriter::add_tool(std::string_view tool_name) {
+    for (size_t i = 0; i < tools_.size(); ++i) {
+        if (tools_[i] == tool_name) {
+            return i;
+        }
+    }
+    tools_.emplace_back(tool_name);
+    return tools_.size() - 1;
+}
+
+void SarifIssueWriter::write_issues(std::string_view tool_name, const std::vector<AnalysisIssue>& issues) {
+    // Rendered with a leading separator each; the first result of the log drops its comma
+    std::string results;
+    for (const auto& issue : issues) {
+        const ReportIssue view(issue);
+        results += ",\n        ";
+        append_sarif_result(results, view, view.tool_name.empty() ? tool_name : view.tool_name);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (finished_) {
+        throw std::logic_error("SarifIssueWriter: write_issues() after finish()");
+    }
+    if (issues.empty()) {
+        return;
+    }
+    add_tool(tool_name);
+    const size_t skip = statistics_.total_issues == 0 ? 1 : 0;
+    out_.write(results.data() + skip, static_cast<std::streamsize>(results.size() - skip));
+    for (const auto& issue : issues) {
+        ++statistics_.total_issues;
+        ++statistics_.issues_by_severity[static_cast<size_t>(issue.severity)];
+        ++statistics_.issues_by_category[static_cast<size_t>(issue.category)];
+    }
+}
+
+void SarifIssueWriter::write_result(const AnalysisResult& result) {
+    write_issues(result.tool_name, result.issues);
+    if (!result.success) {
+        add_tool_failure(result.tool_name, result.error_message);
+    }
+}
+
+SarifIssueWriter::Callback SarifIssueWriter::callback() {
+    return [this](const std::string& tool_name, const std::vector<AnalysisIssue>& issues) {
+        write_issues(tool_name, issues);
+    };
+}
+
+void SarifIssueWriter::add_tool_failure(std::string_view tool_name, std::string_view error_message) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    add_tool(tool_name);
+    failures_.emplace_back(tool_name, error_message);
+}
+
+ReportStatistics SarifIssueWriter::finish() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (finished_) {
+        return statistics_;
+    }
+    finished_ = true;
+    statistics_.tool_count = tools_.size();
+    statistics_.failed_tool_count = failures_.size();
+
+    std::string text = statistics_.total_issues ? "\n      ],\n" : "],\n";
+    text += "      \"tool\": {\"driver\": {";
+    append_json_field(text, "name", header_.generator_name);
+    text += ", ";
+    append_json_field(text, "version", header_.generator_version);
+    text += "}, \"extensions\": [";
+    for (size_t i = 0; i < tools_.size(); ++i) {
+        text += i ? ", {" : "{";
+        append_json_field(text, "name", tools_[i]);
+        text += '}';
+    }
+    text += "]},\n      \"invocations\": [{\"executionSuccessful\": ";
+    text += failures_.empty() ? "true" : "false";
+    if (!failures_.empty()) {
+        text += ", \"toolExecutionNotifications\": [";
+        for (size_t i = 0; i < failures_.size(); ++i) {
+            text += i ? ", {\"level\": \"error\", \"message\": {" : "{\"level\": \"error\", \"message\": {";
+            append_json_field(text, "text", failures_[i].second);
+            text += "}, \"properties\": {";
+            append_json_field(text, "tool", failures_[i].first);
+            text += "}}";
+        }
+        text += ']';
+    }
+    text += "}]\n    }\n  ],\n  \"properties\": {\n    ";
+    append_json_field(text, "title", header_.title);
+    text += ",\n    ";
+    append_json_field(text, "project", header_.project_name);
+    text += ",\n    ";
+    append_json_field(text, "generated_at", format_utc(header_.generated_at));
+    for (const auto& [key, value] : header_.properties) {
+        text += ",\n    ";
+        append_json_field(text, key, value);
+    }
+    text += ",\n";
+    append_statistics(text, statistics_, {}, "    ");
+    text += "  }\n}\n";
+    out_.write(text.data(), static_cast<std::streamsize>(text.size()));
+    out_.flush();
+    return statistics_;
+}
+
+ReportStatistics SarifIssueWriter::get_statistics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ReportStatistics statistics = statistics_;
+    statistics.tool_count = tools_.size();
+    statistics.failed_tool_count = failures_.size();
+    return statistics;
+}
+
+} // namespace analysis
+} // namespace wip
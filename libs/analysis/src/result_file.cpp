@@ -0,0 +1,533 @@
+#include "result_file.h"
+#include "issue_store.h"
+#include "report_writer.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <task.h>
+#include <thread>
+#include <unordered_map>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace wip {
+namespace analysis {
+
+namespace {
+
+// Fixed-width records; every section starts at a multiple of 8 bytes so the
+// records can be used in place from a mapping
+
+struct FileHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t result_count;
+    uint32_t string_count;
+    uint64_t issue_count;
+    uint64_t results_offset;
+    uint64_t issues_offset;
+    uint64_t strings_offset;      // string_count + 1 offsets, then the characters
+};
+
+struct ResultRecord {
+    uint32_t tool_name;
+    uint32_t analysis_id;
+    uint32_t error_message;
+    uint32_t success;
+    int64_t timestamp_ms;         // Since the system clock epoch
+    int64_t execution_time_ms;
+    uint64_t files_analyzed;
+    uint64_t first_issue;
+    uint64_t issue_count;
+};
+
+struct IssueRecord {
+    uint32_t id;
+    uint32_t message;
+    uint32_t file_path;
+    uint32_t rule_id;
+    uint32_t tool_name;
+    uint32_t fix_suggestion;      // NO_STRING when absent
+    int32_t line_number;
+    int32_t column_number;
+    uint8_t severity;
+    uint8_t category;
+    uint8_t padding[6];
+};
+
+static_assert(sizeof(FileHeader) == 48, "FileHeader layout changed");
+static_assert(sizeof(ResultRecord) == 56, "ResultRecord layout changed");
+static_assert(sizeof(IssueRecord) == 40, "IssueRecord layout changed");
+
+const IssueRecord& as_issue(const void* record) {
+    return *static_cast<const IssueRecord*>(record);
+}
+
+template<typename T>
+void write_pod(std::ostream& file, const T& value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+[[noreturn]] void throw_invalid(const std::string& file_path, const std::string& reason) {
+    throw std::runtime_error("Invalid binary result file " + file_path + ": " + reason);
+}
+
+} // namespace
+
+// ==================== IssueView Implementation ====================
+
+std::string_view BinaryResultFile::IssueView::id() const { return file_->get_string(as_issue(record_).id); }
+std::string_view BinaryResultFile::IssueView::message() const { return file_->get_string(as_issue(record_).message); }
+std::string_view BinaryResultFile::IssueView::file_path() const { return file_->get_string(as_issue(record_).file_path); }
+int BinaryResultFile::IssueView::line_number() const { return as_issue(record_).line_number; }
+int BinaryResultFile::IssueView::column_number() const { return as_issue(record_).column_number; }
+IssueSeverity BinaryResultFile::IssueView::severity() const { return static_cast<IssueSeverity>(as_issue(record_).severity); }
+IssueCategory BinaryResultFile::IssueView::category() const { return static_cast<IssueCategory>(as_issue(record_).category); }
+std::string_view BinaryResultFile::IssueView::rule_id() const { return file_->get_string(as_issue(record_).rule_id); }
+std::string_view BinaryResultFile::IssueView::tool_name() const { return file_->get_string(as_issue(record_).tool_name); }
+
+bool BinaryResultFile::IssueView::has_fix_suggestion() const {
+    return as_issue(record_).fix_suggestion != NO_STRING;
+}
+
+std::string_view BinaryResultFile::IssueView::fix_suggestion() const {
+    return has_fix_suggestion() ? file_->get_string(as_issue(record_).fix_suggestion) : std::string_view();
+}
+
+AnalysisIssue BinaryResultFile::IssueView::to_issue() const {
+    AnalysisIssue issue;
+    issue.id = std::string(id());
+    issue.message = std::string(message());
+    issue.file_path = std::string(file_path());
+    issue.line_number = line_number();
+    issue.column_number = column_number();
+    issue.severity = severity();
+    issue.category = category();
+    issue.rule_id = std::string(rule_id());
+    issue.tool_name = std::string(tool_name());
+    if (has_fix_suggestion()) {
+        issue.fix_suggestion = std::string(fix_suggestion());
+    }
+    return issue;
+}
+
+// ==================== Writing ====================
+
+std::string BinaryResultFile::serialize(const std::vector<AnalysisResult>& results) {
+    StringPool strings;
+    std::vector<ResultRecord> result_records;
+    std::vector<IssueRecord> issue_records;
+    result_records.reserve(results.size());
+
+    size_t total_issues = 0;
+    for (const auto& result : results) {
+        total_issues += result.issues.size();
+    }
+    issue_records.reserve(total_issues);
+
+    for (const auto& result : results) {
+        ResultRecord record{};
+        record.tool_name = strings.intern(result.tool_name);
+        record.analysis_id = strings.intern(result.analysis_id);
+        record.error_message = strings.intern(result.error_message);
+        record.success = result.success ? 1 : 0;
+        record.timestamp_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            result.timestamp.time_since_epoch()).count();
+        record.execution_time_ms = result.execution_time.count();
+        record.files_analyzed = result.files_analyzed;
+        record.first_issue = issue_records.size();
+        record.issue_count = result.issues.size();
+        result_records.push_back(record);
+
+        for (const auto& issue : result.issues) {
+            IssueRecord issue_record{};
+            issue_record.id = strings.intern(issue.id);
+            issue_record.message = strings.intern(issue.message);
+            issue_record.file_path = strings.intern(issue.file_path);
+            issue_record.rule_id = strings.intern(issue.rule_id);
+            issue_record.tool_name = strings.intern(issue.tool_name);
+            issue_record.fix_suggestion = issue.fix_suggestion ? strings.intern(*issue.fix_suggestion) : NO_STRING;
+            issue_record.line_number = issue.line_number;
+            issue_record.column_number = issue.column_number;
+            issue_record.severity = static_cast<uint8_t>(issue.severity);
+            issue_record.category = static_cast<uint8_t>(issue.category);
+            issue_records.push_back(issue_record);
+        }
+    }
+
+    FileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = FORMAT_VERSION;
+    header.result_count = static_cast<uint32_t>(result_records.size());
+    header.string_count = static_cast<uint32_t>(strings.size());
+    header.issue_count = issue_records.size();
+    header.results_offset = sizeof(FileHeader);
+    header.issues_offset = header.results_offset + result_records.size() * sizeof(ResultRecord);
+    header.strings_offset = header.issues_offset + issue_records.size() * sizeof(IssueRecord);
+
+    std::ostringstream file(std::ios::binary);
+
+    write_pod(file, header);
+    file.write(reinterpret_cast<const char*>(result_records.data()), result_records.size() * sizeof(ResultRecord));
+    file.write(reinterpret_cast<const char*>(issue_records.data()), issue_records.size() * sizeof(IssueRecord));
+
+    uint64_t offset = 0;
+    write_pod(file, offset);
+    for (size_t i = 0; i < strings.size(); ++i) {
+        offset += strings.get(static_cast<StringPool::Id>(i)).size();
+        write_pod(file, offset);
+    }
+    for (size_t i = 0; i < strings.size(); ++i) {
+        auto value = strings.get(static_cast<StringPool::Id>(i));
+        file.write(value.data(), value.size());
+    }
+
+    return file.str();
+}
+
+void BinaryResultFile::write(const std::vector<AnalysisResult>& results, const std::string& file_path) {
+    std::string content = serialize(results);
+
+    std::ofstream file(file_path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file for writing: " + file_path);
+    }
+    file.write(content.data(), static_cast<std::streamsize>(content.size()));
+    if (!file) {
+        throw std::runtime_error("Failed to write file: " + file_path);
+    }
+}
+
+bool BinaryResultFile::is_binary_file(const std::string& file_path) {
+    std::ifstream file(file_path, std::ios::binary);
+    char magic[sizeof(MAGIC)] = {};
+    return file.read(magic, sizeof(magic)) && std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+// ==================== Reading ====================
+
+std::vector<AnalysisResult> BinaryResultFile::deserialize(std::string_view data) {
+    // Records are read in place, so the data is copied into suitably aligned storage
+    BinaryResultFile file;
+    file.buffer_.assign(data.begin(), data.end());
+    file.data_ = file.buffer_.data();
+    file.size_ = file.buffer_.size();
+    file.validate("<memory>");
+    return file.read_all();
+}
+
+BinaryResultFile::BinaryResultFile(const std::string& file_path, bool use_mmap) {
+#ifndef _WIN32
+    if (use_mmap) {
+        int fd = ::open(file_path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open file for reading: " + file_path);
+        }
+
+        struct stat info;
+        if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+            size_ = static_cast<size_t>(info.st_size);
+            void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping != MAP_FAILED) {
+                mapping_ = mapping;
+                data_ = static_cast<const char*>(mapping);
+            }
+        }
+        ::close(fd);
+    }
+#endif
+
+    if (!mapping_) {
+        std::ifstream file(file_path, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            throw std::runtime_error("Cannot open file for reading: " + file_path);
+        }
+        size_ = static_cast<size_t>(file.tellg());
+        buffer_.resize(size_);
+        file.seekg(0);
+        file.read(buffer_.data(), size_);
+        data_ = buffer_.data();
+    }
+
+    try {
+        validate(file_path);
+    } catch (...) {
+#ifndef _WIN32
+        if (mapping_) {
+            ::munmap(mapping_, size_);
+        }
+#endif
+        throw;
+    }
+}
+
+BinaryResultFile::~BinaryResultFile() {
+#ifndef _WIN32
+    if (mapping_) {
+        ::munmap(mapping_, size_);
+    }
+#endif
+}
+
+BinaryResultFile::IssueView BinaryResultFile::get_issue(size_t index) const {
+    if (index >= issue_count_) {
+        throw std::out_of_range("Issue index out of range");
+    }
+    return IssueView(*this, issues_ + index * sizeof(IssueRecord));
+}
+
+std::pair<size_t, size_t> BinaryResultFile::get_issue_range(size_t result_index) const {
+    if (result_index >= result_count_) {
+        throw std::out_of_range("Result index out of range");
+    }
+    const auto& record = reinterpret_cast<const ResultRecord*>(results_)[result_index];
+    return {static_cast<size_t>(record.first_issue), static_cast<size_t>(record.issue_count)};
+}
+
+AnalysisResult BinaryResultFile::read_result(size_t result_index) const {
+    if (result_index >= result_count_) {
+        throw std::out_of_range("Result index out of range");
+    }
+    const auto& record = reinterpret_cast<const ResultRecord*>(results_)[result_index];
+
+    AnalysisResult result;
+    result.tool_name = std::string(get_string(record.tool_name));
+    result.analysis_id = std::string(get_string(record.analysis_id));
+    result.error_message = std::string(get_string(record.error_message));
+    result.success = record.success != 0;
+    result.timestamp = std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::milliseconds(record.timestamp_ms)));
+    result.execution_time = std::chrono::milliseconds(record.execution_time_ms);
+    result.files_analyzed = static_cast<size_t>(record.files_analyzed);
+
+    result.issues.reserve(record.issue_count);
+    for (uint64_t i = 0; i < record.issue_count; ++i) {
+        result.issues.push_back(get_issue(record.first_issue + i).to_issue());
+    }
+
+    result.compute_statistics();
+    return result;
+}
+
+std::vector<AnalysisResult> BinaryResultFile::read_all() const {
+    std::vector<AnalysisResult> results;
+    results.reserve(result_count_);
+    for (size_t i = 0; i < result_count_; ++i) {
+        results.push_back(read_result(i));
+    }
+    return results;
+}
+
+// ==================== Private Helper Methods ====================
+
+void BinaryResultFile::validate(const std::string& file_path) {
+    if (size_ < sizeof(FileHeader)) {
+        throw_invalid(file_path, "file too small");
+    }
+
+    const auto& header = *reinterpret_cast<const FileHeader*>(data_);
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw_invalid(file_path, "bad magic");
+    }
+    if (header.version != FORMAT_VERSION) {
+        throw_invalid(file_path, "unsupported version " + std::to_string(header.version));
+    }
+
+    // Sections must be in order, aligned and inside the file
+    uint64_t results_end = header.results_offset + uint64_t{header.result_count} * sizeof(ResultRecord);
+    uint64_t issues_end = header.issues_offset + header.issue_count * sizeof(IssueRecord);
+    uint64_t offsets_end = header.strings_offset + (uint64_t{header.string_count} + 1) * sizeof(uint64_t);
+    if (header.results_offset < sizeof(FileHeader) || header.issues_offset < results_end ||
+        header.strings_offset < issues_end || offsets_end > size_ ||
+        header.issue_count > size_ / sizeof(IssueRecord) ||
+        (header.results_offset | header.issues_offset | header.strings_offset) % alignof(uint64_t) != 0) {
+        throw_invalid(file_path, "section out of bounds");
+    }
+
+    result_count_ = header.result_count;
+    issue_count_ = static_cast<size_t>(header.issue_count);
+    string_count_ = header.string_count;
+    results_ = data_ + header.results_offset;
+    issues_ = data_ + header.issues_offset;
+    string_offsets_ = reinterpret_cast<const uint64_t*>(data_ + header.strings_offset);
+    string_data_ = data_ + offsets_end;
+
+    // String offsets must grow monotonically and stay inside the file
+    uint64_t data_size = size_ - offsets_end;
+    for (size_t i = 0; i < string_count_; ++i) {
+        if (string_offsets_[i] > string_offsets_[i + 1]) {
+            throw_invalid(file_path, "corrupt string table");
+        }
+    }
+    if (string_offsets_[0] != 0 || string_offsets_[string_count_] > data_size) {
+        throw_invalid(file_path, "corrupt string table");
+    }
+
+    // Every record must refer to existing strings and issues
+    auto valid_string = [this](uint32_t index, bool optional) {
+        return index < string_count_ || (optional && index == NO_STRING);
+    };
+    const auto* results = reinterpret_cast<const ResultRecord*>(results_);
+    for (size_t i = 0; i < result_count_; ++i) {
+        const auto& record = results[i];
+        if (!valid_string(record.tool_name, false) || !valid_string(record.analysis_id, false) ||
+            !valid_string(record.error_message, false) || record.first_issue > issue_count_ ||
+            record.issue_count > issue_count_ - record.first_issue) {
+            throw_invalid(file_path, "corrupt result record");
+        }
+    }
+    const auto* issues = reinterpret_cast<const IssueRecord*>(issues_);
+    for (size_t i = 0; i < issue_count_; ++i) {
+        const auto& record = issues[i];
+        if (!valid_string(record.id, false) || !valid_string(record.message, false) ||
+            !valid_string(record.file_path, false) || !valid_string(record.rule_id, false) ||
+            !valid_string(record.tool_name, false) || !valid_string(record.fix_suggestion, true) ||
+            record.severity > static_cast<uint8_t>(IssueSeverity::Critical) ||
+            record.category > static_cast<uint8_t>(IssueCategory::Maintainability)) {
+            throw_invalid(file_path, "corrupt issue record");
+        }
+    }
+}
+
+std::string_view BinaryResultFile::get_string(uint32_t index) const {
+    return std::string_view(string_data_ + string_offsets_[index], string_offsets_[index + 1] - string_offsets_[index]);
+}
+
+// ==================== NdjsonResultFile ====================
+
+bool NdjsonResultFile::is_ndjson_file(const std::string& file_path) {
+    std::ifstream file(file_path, std::ios::binary);
+    std::string line;
+    if (!file || !std::getline(file, line)) {
+        return false;
+    }
+    auto first = line.find_first_not_of(" \t\r");
+    if (first == std::string::npos || line[first] != '{') {
+        return false;
+    }
+    auto json = nlohmann::json::parse(line, nullptr, false);
+    return !json.is_discarded() && json.is_object();
+}
+
+void NdjsonResultFile::write(const std::vector<AnalysisResult>& results, const std::string& file_path) {
+    std::ofstream file(file_path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file for writing: " + file_path);
+    }
+    NdjsonIssueWriter writer(file);
+    for (const auto& result : results) {
+        writer.write_result(result);
+    }
+    file.flush();
+    if (!file) {
+        throw std::runtime_error("Failed to write NDJSON result file: " + file_path);
+    }
+}
+
+NdjsonResultFile::NdjsonResultFile(const std::string& file_path) : path_(file_path) {
+    auto file = wip::utils::file::MappedFile::open(file_path);
+    if (!file) {
+        throw std::runtime_error("Cannot open file for reading: " + file_path);
+    }
+    file_ = std::move(*file);
+}
+
+std::vector<NdjsonResultFile::ByteRange> NdjsonResultFile::split(size_t parts) const {
+    parts = std::max<size_t>(1, std::min(parts, size()));
+    std::vector<ByteRange> ranges;
+    ranges.reserve(parts);
+    for (size_t i = 0; i < parts; ++i) {
+        ranges.emplace_back(size() * i / parts, size() * (i + 1) / parts);
+    }
+    return ranges;
+}
+
+size_t NdjsonResultFile::read_range(size_t begin, size_t end, const IssueVisitor& visitor) const {
+    const std::string_view text = file_.view();
+    end = std::min(end, text.size());
+
+    // A line belongs to the range it starts in, so skip the tail of one that started earlier
+    size_t pos = begin;
+    if (pos > 0 && pos < end && text[pos - 1] != '\n') {
+        pos = text.find('\n', pos);
+        pos = pos == std::string_view::npos ? end : pos + 1;
+    }
+
+    size_t count = 0;
+    while (pos < end) {
+        size_t line_end = text.find('\n', pos);
+        if (line_end == std::string_view::npos) {
+            line_end = text.size();
+        }
+        std::string_view line = text.substr(pos, line_end - pos);
+        while (!line.empty() && (line.back() == '\r' || line.back() == ' ' || line.back() == '\t')) {
+            line.remove_suffix(1);
+        }
+        if (!line.empty()) {
+            auto json = nlohmann::json::parse(line.begin(), line.end(), nullptr, false);
+            if (json.is_discarded() || !json.is_object()) {
+                throw std::runtime_error("Malformed NDJSON issue at byte " + std::to_string(pos) + " of " + path_);
+            }
+            visitor(AnalysisIssue::from_json(json));
+            ++count;
+        }
+        pos = line_end + 1;
+    }
+    return count;
+}
+
+std::vector<AnalysisIssue> NdjsonResultFile::read_issues(size_t threads) const {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    auto ranges = split(threads);
+
+    std::vector<wip::utils::concurrency::Task<std::vector<AnalysisIssue>>> parts;
+    parts.reserve(ranges.size());
+    for (const auto& [begin, end] : ranges) {
+        parts.push_back(wip::utils::concurrency::async([this, begin = begin, end = end]() {
+            std::vector<AnalysisIssue> issues;
+            read_range(begin, end, [&issues](AnalysisIssue&& issue) { issues.push_back(std::move(issue)); });
+            return issues;
+        }));
+    }
+
+    std::vector<AnalysisIssue> issues;
+    for (auto& part : parts) {
+        auto part_issues = part.get();
+        if (issues.empty()) {
+            issues = std::move(part_issues);
+        } else {
+            std::move(part_issues.begin(), part_issues.end(), std::back_inserter(issues));
+        }
+    }
+    return issues;
+}
+
+std::vector<AnalysisResult> NdjsonResultFile::read_all(size_t threads) const {
+    std::vector<AnalysisResult> results;
+    std::unordered_map<std::string, size_t> result_index;
+    for (auto& issue : read_issues(threads)) {
+        auto [it, inserted] = result_index.try_emplace(issue.tool_name, results.size());
+        if (inserted) {
+            results.emplace_back();
+            results.back().tool_name = issue.tool_name;
+            results.back().success = true;
+        }
+        results[it->second].issues.push_back(std::move(issue));
+    }
+    for (auto& result : results) {
+        result.compute_statistics();
+    }
+    return results;
+}
+
+} // namespace analysis
+} // namespace wip
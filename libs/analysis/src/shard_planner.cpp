@@ -0,0 +1,131 @@
+#include "shard_planner.h"
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+#include <queue>
+
+namespace wip {
+namespace analysis {
+
+namespace {
+
+// Size of a unit plus one, so empty and unreadable files still cost something
+double unit_size(const std::string& unit) {
+    std::error_code ec;
+    auto size = std::filesystem::file_size(unit, ec);
+    return ec ? 1.0 : static_cast<double>(size) + 1.0;
+}
+
+double to_microseconds(std::chrono::nanoseconds duration) {
+    return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+} // namespace
+
+std::vector<double> ShardPlanner::estimate_costs(const std::vector<std::string>& units,
+                                                 const std::map<std::string, double>& known_costs) {
+    std::vector<double> sizes(units.size());
+    double known_cost = 0.0;
+    double known_size = 0.0;
+    for (size_t i = 0; i < units.size(); ++i) {
+        sizes[i] = unit_size(units[i]);
+
+        auto it = known_costs.find(units[i]);
+        if (it != known_costs.end()) {
+            known_cost += it->second;
+            known_size += sizes[i];
+        }
+    }
+
+    double cost_per_byte = known_size > 0.0 ? known_cost / known_size : 1.0;
+    std::vector<double> costs(units.size());
+    for (size_t i = 0; i < units.size(); ++i) {
+        auto it = known_costs.find(units[i]);
+        costs[i] = it != known_costs.end() ? it->second : sizes[i] * cost_per_byte;
+    }
+    return costs;
+}
+
+std::vector<ShardPlanner::Shard> ShardPlanner::plan(const std::vector<std::string>& units,
+                                                    const std::vector<double>& costs, size_t shard_count) {
+    if (units.empty()) {
+        return {};
+    }
+    shard_count = std::max<size_t>(1, std::min(shard_count, units.size()));
+
+    std::vector<size_t> order(units.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&costs](size_t a, size_t b) { return costs[a] > costs[b]; });
+
+    using Load = std::pair<double, size_t>;    // Total cost and index of a shard
+    std::priority_queue<Load, std::vector<Load>, std::greater<Load>> loads;
+    for (size_t shard = 0; shard < shard_count; ++shard) {
+        loads.push({0.0, shard});
+    }
+
+    std::vector<std::vector<size_t>> members(shard_count);
+    std::vector<double> totals(shard_count, 0.0);
+    for (size_t unit : order) {
+        auto [total, shard] = loads.top();
+        loads.pop();
+        members[shard].push_back(unit);
+        totals[shard] = total + costs[unit];
+        loads.push({totals[shard], shard});
+    }
+
+    std::vector<size_t> shard_order(shard_count);
+    for (size_t i = 0; i < shard_order.size(); ++i) {
+        shard_order[i] = i;
+    }
+    std::stable_sort(shard_order.begin(), shard_order.end(), [&totals](size_t a, size_t b) { return totals[a] > totals[b]; });
+
+    std::vector<Shard> shards;
+    shards.reserve(shard_count);
+    for (size_t shard : shard_order) {
+        std::sort(members[shard].begin(), members[shard].end());
+        Shard planned;
+        planned.cost = totals[shard];
+        planned.units.reserve(members[shard].size());
+        for (size_t unit : members[shard]) {
+            planned.units.push_back(units[unit]);
+        }
+        shards.push_back(std::move(planned));
+    }
+    return shards;
+}
+
+std::map<std::string, double> ShardPlanner::attribute_costs(const std::vector<std::string>& units,
+                                                            const ExecutionProfile& profile,
+                                                            std::chrono::nanoseconds elapsed) {
+    // Tool CPU time does not depend on how many slots the shard had
+    double remaining = to_microseconds(profile.tool_cpu_time.count() > 0 ? profile.tool_cpu_time : elapsed);
+
+    std::map<std::string, double> costs;
+    std::vector<size_t> unmeasured;
+    for (size_t i = 0; i < units.size(); ++i) {
+        auto it = profile.unit_cpu_times.find(units[i]);
+        if (it != profile.unit_cpu_times.end()) {
+            costs[units[i]] = to_microseconds(it->second);
+            remaining -= costs[units[i]];
+        } else {
+            unmeasured.push_back(i);
+        }
+    }
+
+    std::vector<double> sizes(unmeasured.size());
+    double total_size = 0.0;
+    for (size_t i = 0; i < unmeasured.size(); ++i) {
+        sizes[i] = unit_size(units[unmeasured[i]]);
+        total_size += sizes[i];
+    }
+    remaining = std::max(0.0, remaining);
+    for (size_t i = 0; i < unmeasured.size(); ++i) {
+        costs[units[unmeasured[i]]] = remaining * sizes[i] / total_size;
+    }
+    return costs;
+}
+
+} // namespace analysis
+} // namespace wip
@@ -0,0 +1,264 @@
+#include "tool_discovery.h"
+#include <process.h>
+#include <nlohmann/json.hpp>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <unistd.h>
+
+namespace wip {
+namespace analysis {
+
+namespace {
+
+constexpr int CACHE_FORMAT_VERSION = 1;
+
+std::string get_path_env() {
+    const char* path_env = std::getenv("PATH");
+    return path_env ? path_env : "";
+}
+
+// Directories a candidate is looked up in: its own for a path, PATH for a bare name
+std::vector<std::string> get_search_directories(const std::string& candidate, const std::string& path_env) {
+    std::vector<std::string> directories;
+    if (candidate.find('/') != std::string::npos) {
+        auto parent = std::filesystem::path(candidate).parent_path();
+        directories.push_back(parent.empty() ? "." : parent.string());
+        return directories;
+    }
+
+    std::istringstream path_stream(path_env);
+    std::string entry;
+    while (std::getline(path_stream, entry, ':')) {
+        directories.push_back(entry.empty() ? "." : entry);
+    }
+    return directories;
+}
+
+int64_t get_modified_time(const std::string& path) {
+    std::error_code ec;
+    auto modified = std::filesystem::last_write_time(path, ec);
+    return ec ? -1 : static_cast<int64_t>(modified.time_since_epoch().count());
+}
+
+} // namespace
+
+ToolDiscovery::ToolDiscovery(std::string cache_file)
+    : cache_file_(std::move(cache_file)) {
+}
+
+ToolDiscovery& ToolDiscovery::get_shared() {
+    static ToolDiscovery shared(get_default_cache_file());
+    static bool loaded = shared.load();
+    (void)loaded;
+    return shared;
+}
+
+std::string ToolDiscovery::get_default_cache_file() {
+    std::filesystem::path cache_directory;
+    if (const char* xdg_cache = std::getenv("XDG_CACHE_HOME"); xdg_cache && *xdg_cache) {
+        cache_directory = xdg_cache;
+    } else if (const char* home = std::getenv("HOME"); home && *home) {
+        cache_directory = std::filesystem::path(home) / ".cache";
+    } else {
+        return "";
+    }
+    return (cache_directory / "wip" / "tool_discovery.json").string();
+}
+
+bool ToolDiscovery::load() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+
+    if (cache_file_.empty()) {
+        return false;
+    }
+
+    std::ifstream file(cache_file_);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    try {
+        nlohmann::json j;
+        file >> j;
+
+        // Entries written by another format version are discarded
+        if (j.value("version", 0) != CACHE_FORMAT_VERSION || !j.contains("tools") || !j["tools"].is_object()) {
+            return false;
+        }
+
+        for (const auto& tool_item : j["tools"].items()) {
+            const auto& tool_json = tool_item.value();
+            Entry entry;
+            entry.path_env = tool_json.value("path", "");
+            entry.candidates = tool_json.value("candidates", std::vector<std::string>());
+            entry.result.executable = tool_json.value("executable", "");
+            entry.result.version_output = tool_json.value("version_output", "");
+            entry.resolved_path = tool_json.value("resolved_path", "");
+            entry.executable_stamp.modified = tool_json.value("modified", int64_t(0));
+            entry.executable_stamp.size = tool_json.value("size", uint64_t(0));
+            if (tool_json.contains("directories") && tool_json["directories"].is_object()) {
+                for (const auto& directory_item : tool_json["directories"].items()) {
+                    entry.directories.emplace_back(directory_item.key(),
+                                                   FileStamp{directory_item.value().get<int64_t>(), 0});
+                }
+            }
+            entries_.emplace(tool_item.key(), std::move(entry));
+        }
+    } catch (const std::exception&) {
+        // A corrupt cache only costs one round of probing
+        entries_.clear();
+        return false;
+    }
+
+    return true;
+}
+
+bool ToolDiscovery::save() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return save_locked();
+}
+
+bool ToolDiscovery::save_locked() const {
+    if (cache_file_.empty()) {
+        return false;
+    }
+
+    nlohmann::json j;
+    j["version"] = CACHE_FORMAT_VERSION;
+    j["tools"] = nlohmann::json::object();
+
+    for (const auto& [tool_name, entry] : entries_) {
+        nlohmann::json tool_json;
+        tool_json["path"] = entry.path_env;
+        tool_json["candidates"] = entry.candidates;
+        tool_json["executable"] = entry.result.executable;
+        tool_json["version_output"] = entry.result.version_output;
+        tool_json["resolved_path"] = entry.resolved_path;
+        tool_json["modified"] = entry.executable_stamp.modified;
+        tool_json["size"] = entry.executable_stamp.size;
+        tool_json["directories"] = nlohmann::json::object();
+        for (const auto& [directory, stamp] : entry.directories) {
+            tool_json["directories"][directory] = stamp.modified;
+        }
+        j["tools"][tool_name] = std::move(tool_json);
+    }
+
+    // Write to a temporary file first; several processes may share the cache
+    std::error_code ec;
+    std::filesystem::path path(cache_file_);
+    if (path.has_parent_path()) {
+        std::filesystem::create_directories(path.parent_path(), ec);
+    }
+
+    std::string temp_file = cache_file_ + ".tmp" + std::to_string(getpid());
+    {
+        std::ofstream file(temp_file);
+        if (!file.is_open()) {
+            return false;
+        }
+        file << j.dump();
+        if (!file) {
+            return false;
+        }
+    }
+
+    std::filesystem::rename(temp_file, path, ec);
+    return !ec;
+}
+
+ToolProbe ToolDiscovery::probe(const std::string& tool_name, const std::vector<std::string>& candidates) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = entries_.find(tool_name);
+    if (it != entries_.end() && is_valid(it->second, candidates)) {
+        return it->second.result;
+    }
+
+    Entry entry = run_probe(candidates);
+    ToolProbe result = entry.result;
+    entries_[tool_name] = std::move(entry);
+    save_locked();
+    return result;
+}
+
+void ToolDiscovery::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+}
+
+size_t ToolDiscovery::get_launch_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return launch_count_;
+}
+
+bool ToolDiscovery::is_valid(const Entry& entry, const std::vector<std::string>& candidates) const {
+    if (entry.candidates != candidates || entry.path_env != get_path_env()) {
+        return false;
+    }
+
+    // Adding or removing a file changes its directory's modification time
+    for (const auto& [directory, stamp] : entry.directories) {
+        if (get_modified_time(directory) != stamp.modified) {
+            return false;
+        }
+    }
+
+    // An upgrade in place (or through a symlink) changes the executable itself
+    if (entry.result.found()) {
+        std::error_code ec;
+        auto size = std::filesystem::file_size(entry.resolved_path, ec);
+        if (ec || !(FileStamp{get_modified_time(entry.resolved_path), size} == entry.executable_stamp)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+ToolDiscovery::Entry ToolDiscovery::run_probe(const std::vector<std::string>& candidates) {
+    Entry entry;
+    entry.path_env = get_path_env();
+    entry.candidates = candidates;
+
+    std::set<std::string> searched;
+    for (const auto& candidate : candidates) {
+        for (const auto& directory : get_search_directories(candidate, entry.path_env)) {
+            if (searched.insert(directory).second) {
+                entry.directories.emplace_back(directory, FileStamp{get_modified_time(directory), 0});
+            }
+        }
+
+        // Skip candidates that do not exist without starting a process
+        std::string resolved = wip::utils::process::ProcessExecutor::find_command_path(candidate);
+        if (resolved.empty()) {
+            continue;
+        }
+
+        try {
+            wip::utils::process::ProcessExecutor executor;
+            ++launch_count_;
+            auto result = executor.execute(candidate, std::vector<std::string>{"--version"});
+            if (result.exit_code != 0) {
+                continue;
+            }
+
+            std::error_code ec;
+            entry.result.executable = candidate;
+            entry.result.version_output = std::move(result.stdout_output);
+            entry.resolved_path = resolved;
+            entry.executable_stamp = FileStamp{get_modified_time(resolved), std::filesystem::file_size(resolved, ec)};
+            break;
+        } catch (...) {
+            continue;
+        }
+    }
+
+    return entry;
+}
+
+} // namespace analysis
+} // namespace wip
@@ -0,0 +1,214 @@
+#include "tools/banned_token_tool.h"
+#include <pattern_matcher.h>
+#include <cstring>
+
+namespace wip {
+namespace analysis {
+namespace tools {
+
+namespace {
+
+bool is_identifier_char(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+} // namespace
+
+// ==================== BannedTokenConfig Implementation ====================
+
+BannedTokenConfig::BannedTokenConfig() {
+    tool_name = "banned-tokens";
+}
+
+std::vector<BannedToken> BannedTokenConfig::get_default_tokens() {
+    const std::string unbounded = "' does not check the size of its destination buffer";
+    return {
+        {"gets", "'gets' cannot limit its input; use fgets or std::getline", IssueSeverity::Error, IssueCategory::Security},
+        {"strcpy", "'strcpy" + unbounded, IssueSeverity::Warning, IssueCategory::Security},
+        {"strcat", "'strcat" + unbounded, IssueSeverity::Warning, IssueCategory::Security},
+        {"sprintf", "'sprintf" + unbounded + "; use snprintf", IssueSeverity::Warning, IssueCategory::Security},
+        {"vsprintf", "'vsprintf" + unbounded + "; use vsnprintf", IssueSeverity::Warning, IssueCategory::Security},
+        {"strtok", "'strtok' keeps hidden state and is not thread safe", IssueSeverity::Warning, IssueCategory::Bug},
+        {"tmpnam", "'tmpnam' races with other processes creating the same file", IssueSeverity::Warning, IssueCategory::Security},
+        {"std::auto_ptr", "'std::auto_ptr' was removed in C++17; use std::unique_ptr", IssueSeverity::Warning, IssueCategory::Modernization},
+    };
+}
+
+nlohmann::json BannedTokenConfig::to_json() const {
+    auto j = ToolConfig::to_json();
+
+    nlohmann::json token_array = nlohmann::json::array();
+    for (const auto& banned : tokens) {
+        token_array.push_back({
+            {"token", banned.token},
+            {"message", banned.message},
+            {"severity", severity_to_string(banned.severity)},
+            {"category", category_to_string(banned.category)}
+        });
+    }
+    j["tokens"] = token_array;
+    j["whole_words"] = whole_words;
+
+    return j;
+}
+
+void BannedTokenConfig::from_json(const nlohmann::json& j) {
+    ToolConfig::from_json(j);
+
+    if (j.contains("tokens") && j["tokens"].is_array()) {
+        tokens.clear();
+        for (const auto& entry : j["tokens"]) {
+            BannedToken banned;
+            banned.token = entry.value("token", "");
+            banned.message = entry.value("message", "");
+            banned.severity = string_to_severity(entry.value("severity", "warning"));
+            banned.category = string_to_category(entry.value("category", "security"));
+            tokens.push_back(std::move(banned));
+        }
+    }
+    whole_words = j.value("whole_words", true);
+}
+
+std::unique_ptr<ToolConfig> BannedTokenConfig::clone() const {
+    auto cloned = std::make_unique<BannedTokenConfig>();
+    *cloned = *this;
+    return cloned;
+}
+
+std::string BannedTokenConfig::get_display_name() const {
+    return "Banned Tokens";
+}
+
+ValidationResult BannedTokenConfig::validate() const {
+    ValidationResult result = ToolConfig::validate();
+
+    if (tokens.empty()) {
+        result.add_warning("No banned tokens configured, nothing will be reported");
+    }
+    for (const auto& banned : tokens) {
+        if (banned.token.empty()) {
+            result.add_error("Banned token cannot be empty");
+            break;
+        }
+    }
+
+    return result;
+}
+
+// ==================== BannedTokenTool Implementation ====================
+
+BannedTokenTool::BannedTokenTool() {
+    set_configuration(std::make_unique<BannedTokenConfig>());
+}
+
+BannedTokenTool::~BannedTokenTool() = default;
+
+std::string BannedTokenTool::get_name() const {
+    return "banned-tokens";
+}
+
+std::string BannedTokenTool::get_version() const {
+    return "1.0";
+}
+
+std::string BannedTokenTool::get_description() const {
+    return "Reports uses of banned functions and types, such as C library calls without bounds checks, "
+           "in a single in-process pass over every file.";
+}
+
+std::unique_ptr<ToolConfig> BannedTokenTool::create_default_config() const {
+    return std::make_unique<BannedTokenConfig>();
+}
+
+std::string BannedTokenTool::get_help_text() const {
+    return R"(Banned Token Options:
+
+- Tokens: Literal texts to report, each with an optional message, severity
+  and category. Defaults to gets, strcpy, strcat, sprintf, vsprintf, strtok,
+  tmpnam and std::auto_ptr.
+- Whole Words: Only report a token that is not part of a longer identifier,
+  so "gets" does not match "widgets".
+
+The scan is lexical and runs inside the application; tokens in comments and
+string literals are reported too.)";
+}
+
+void BannedTokenTool::on_configuration_changed() {
+    rules_.clear();
+    matcher_.reset();
+
+    auto config = dynamic_cast<const BannedTokenConfig*>(config_.get());
+    if (!config) {
+        return;
+    }
+
+    std::vector<std::string> patterns;
+    patterns.reserve(config->tokens.size());
+    for (const auto& banned : config->tokens) {
+        patterns.push_back(banned.token);
+        rules_.push_back(Rule{
+            "banned-token:" + banned.token,
+            banned.message.empty() ? "Use of banned token '" + banned.token + "'" : banned.message,
+            banned.severity,
+            banned.category,
+            banned.token.size()
+        });
+    }
+    matcher_ = std::make_unique<wip::utils::string::LiteralMatcher>(patterns);
+    whole_words_ = config->whole_words;
+}
+
+void BannedTokenTool::analyze_file(const std::string& path, std::string_view contents,
+                                   std::vector<AnalysisIssue>& issues) const {
+    if (!matcher_ || matcher_->pattern_count() == 0) {
+        return;
+    }
+
+    // Matches come in text order, so lines are counted once, up to each match
+    int line = 1;
+    size_t line_start = 0;
+    size_t counted = 0;
+
+    matcher_->for_each_match(contents, [&](size_t pattern, size_t end) {
+        const Rule& rule = rules_[pattern];
+        const size_t start = end - rule.length;
+
+        if (whole_words_) {
+            if (start > 0 && is_identifier_char(contents[start]) && is_identifier_char(contents[start - 1])) {
+                return;
+            }
+            if (end < contents.size() && is_identifier_char(contents[end - 1]) && is_identifier_char(contents[end])) {
+                return;
+            }
+        }
+
+        const char* data = contents.data();
+        while (counted < start) {
+            auto newline = static_cast<const char*>(std::memchr(data + counted, '\n', start - counted));
+            if (!newline) {
+                counted = start;
+                break;
+            }
+            ++line;
+            counted = static_cast<size_t>(newline - data) + 1;
+            line_start = counted;
+        }
+
+        AnalysisIssue issue = make_issue(path, line, static_cast<int>(start - line_start) + 1, rule.rule_id, rule.message);
+        issue.severity = rule.severity;
+        issue.category = rule.category;
+        issues.push_back(std::move(issue));
+    });
+}
+
+// Static registration
+namespace {
+    wip::analysis::AnalysisToolRegistration register_banned_tokens("banned-tokens",
+        []() -> std::unique_ptr<wip::analysis::AnalysisTool> {
+            return std::make_unique<wip::analysis::tools::BannedTokenTool>();
+        });
+}
+
+} // namespace tools
+} // namespace analysis
+} // namespace wip
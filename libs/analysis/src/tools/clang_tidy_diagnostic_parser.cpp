@@ -0,0 +1,115 @@
+#include "tools/clang_tidy_diagnostic_parser.h"
+#include <charconv>
+
+namespace wip {
+namespace analysis {
+namespace tools {
+
+namespace {
+
+bool is_blank(char c) {
+    return c == ' ' || c == '\t';
+}
+
+bool is_alpha(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+// Parses a positive decimal number followed by ':' and advances pos past the colon
+bool parse_number_field(std::string_view line, size_t& pos, int& value) {
+    const char* begin = line.data() + pos;
+    const char* end = line.data() + line.size();
+    if (begin == end || *begin < '0' || *begin > '9') {
+        return false;
+    }
+    auto [ptr, ec] = std::from_chars(begin, end, value);
+    if (ec != std::errc() || ptr == begin || ptr == end || *ptr != ':') {
+        return false;
+    }
+    pos = static_cast<size_t>(ptr - line.data()) + 1;
+    return true;
+}
+
+// Skips at least one blank character
+bool skip_blanks(std::string_view line, size_t& pos) {
+    size_t start = pos;
+    while (pos < line.size() && is_blank(line[pos])) ++pos;
+    return pos > start;
+}
+
+std::string_view trim_trailing_blanks(std::string_view text) {
+    while (!text.empty() && is_blank(text.back())) text.remove_suffix(1);
+    return text;
+}
+
+} // namespace
+
+std::optional<ClangTidyDiagnostic> parse_clang_tidy_diagnostic(std::string_view line) {
+    if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+    }
+
+    // Cheap rejection of source excerpts and caret lines, which start with blanks
+    if (line.size() < 8 || is_blank(line[0])) {
+        return std::nullopt;
+    }
+
+    // File path runs up to the first ':' (after an optional drive letter)
+    size_t search_from = 0;
+    if (line.size() > 2 && is_alpha(line[0]) && line[1] == ':' && (line[2] == '\\' || line[2] == '/')) {
+        search_from = 2;
+    }
+    size_t file_end = line.find(':', search_from);
+    if (file_end == std::string_view::npos || file_end == 0) {
+        return std::nullopt;
+    }
+
+    ClangTidyDiagnostic diagnostic;
+    diagnostic.file_path = line.substr(0, file_end);
+
+    size_t pos = file_end + 1;
+    if (!parse_number_field(line, pos, diagnostic.line_number) ||
+        !parse_number_field(line, pos, diagnostic.column_number)) {
+        return std::nullopt;
+    }
+
+    if (!skip_blanks(line, pos)) {
+        return std::nullopt;
+    }
+
+    // Severity
+    size_t severity_end = line.find(':', pos);
+    if (severity_end == std::string_view::npos) {
+        return std::nullopt;
+    }
+    diagnostic.severity = line.substr(pos, severity_end - pos);
+    if (diagnostic.severity != "warning" && diagnostic.severity != "error" && diagnostic.severity != "note") {
+        return std::nullopt;
+    }
+
+    pos = severity_end + 1;
+    if (!skip_blanks(line, pos)) {
+        return std::nullopt;
+    }
+
+    // Message, optionally followed by the check list in brackets at the end of the line
+    std::string_view rest = trim_trailing_blanks(line.substr(pos));
+    if (!rest.empty() && rest.back() == ']') {
+        size_t open = rest.rfind('[');
+        if (open != std::string_view::npos && open + 2 < rest.size()) {
+            diagnostic.check_name = rest.substr(open + 1, rest.size() - open - 2);
+            rest = trim_trailing_blanks(rest.substr(0, open));
+        }
+    }
+
+    if (rest.empty()) {
+        return std::nullopt;
+    }
+    diagnostic.message = rest;
+
+    return diagnostic;
+}
+
+} // namespace tools
+} // namespace analysis
+} // namespace wip
@@ -1,17 +1,66 @@
 #include "tools/clang_tidy_tool.h"
-#include <iostream>
+#include "tool_discovery.h"
+#include "parse_arena.h"
+#include "precompiled_header_planner.h"
+#include "compilation_database.h"
+#include "changed_lines.h"
+#include <time_utilities.h>
+#include <log.h>
+#include <file.h>
 #include <fstream>
 #include <sstream>
 #include <filesystem>
 #include <regex>
 #include <algorithm>
-#include <future>
+#include <thread>
+#include <set>
+#include <memory>
 #include <process.h>
 
 namespace wip {
 namespace analysis {
 namespace tools {
 
+namespace {
+
+// Keep the most severe exit code: anything other than 0/1 is a failure and wins over 1
+int merge_exit_codes(int current, int next) {
+    bool current_failed = current != 0 && current != 1;
+    bool next_failed = next != 0 && next != 1;
+    if (current_failed) return current;
+    if (next_failed) return next;
+    return std::max(current, next);
+}
+
+// Common locations, then versioned executables
+std::vector<std::string> get_executable_candidates() {
+    std::vector<std::string> candidates = {
+        "clang-tidy",
+        "/usr/bin/clang-tidy",
+        "/usr/local/bin/clang-tidy",
+        "/opt/llvm/bin/clang-tidy"
+    };
+    for (int version = 18; version >= 10; --version) {
+        candidates.push_back("clang-tidy-" + std::to_string(version));
+        candidates.push_back("/usr/bin/clang-tidy-" + std::to_string(version));
+    }
+    return candidates;
+}
+
+// Removes a temporary directory with everything in it
+struct ScopedDirectory {
+    std::filesystem::path path;
+    
+    ~ScopedDirectory() {
+        if (!path.empty()) {
+            std::error_code ec;
+            std::filesystem::remove_all(path, ec);
+        }
+    }
+};
+
+} // namespace
+
 // ==================== ClangTidyConfig Implementation ====================
 
 ClangTidyConfig::ClangTidyConfig() {
@@ -33,6 +82,9 @@ nlohmann::json ClangTidyConfig::to_json() const {
     j["system_headers"] = system_headers;
     j["fix_errors"] = fix_errors;
     j["fix_notes"] = fix_notes;
+    j["job_count"] = job_count;
+    j["precompiled_headers"] = precompiled_headers;
+    j["precompiled_header_min_units"] = precompiled_header_min_units;
     
     return j;
 }
@@ -57,6 +109,9 @@ void ClangTidyConfig::from_json(const nlohmann::json& j) {
     system_headers = j.value("system_headers", false);
     fix_errors = j.value("fix_errors", false);
     fix_notes = j.value("fix_notes", false);
+    job_count = j.value("job_count", 0);
+    precompiled_headers = j.value("precompiled_headers", false);
+    precompiled_header_min_units = j.value("precompiled_header_min_units", 3);
 }
 
 std::unique_ptr<ToolConfig> ClangTidyConfig::clone() const {
@@ -76,6 +131,14 @@ ValidationResult ClangTidyConfig::validate() const {
         result.add_warning("No checks enabled - analysis will not find any issues");
     }
     
+    if (job_count < 0 || job_count > 64) {
+        result.add_warning("Job count should be between 0 (automatic) and 64");
+    }
+    
+    if (precompiled_headers && precompiled_header_min_units < 2) {
+        result.add_error("Precompiled headers need at least 2 units sharing a prefix");
+    }
+    
     if (!config_file.empty() && !std::filesystem::exists(config_file)) {
         result.add_error("Specified config file does not exist: " + config_file);
     }
@@ -224,45 +287,32 @@ AnalysisResult ClangTidyTool::execute(const AnalysisRequest& request) {
     try {
         auto start_time = std::chrono::steady_clock::now();
         
-        // Build command line
-        auto command_args = build_command_line(request);
-        
-        // Execute clang-tidy
-        wip::utils::process::ProcessExecutor executor;
-        wip::utils::process::ProcessResult process_result = executor.execute(
-            command_args[0], 
-            std::vector<std::string>(command_args.begin() + 1, command_args.end())
-        );
+        // Run one clang-tidy process per translation unit
+        auto sharded_result = run_sharded(request, nullptr, nullptr);
         
         auto end_time = std::chrono::steady_clock::now();
         result.execution_time = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+        result.files_analyzed = sharded_result.files_analyzed;
+        result.profile = sharded_result.profile;
         
         // Clang-tidy uses different exit codes:
         // 0 = No issues found
         // 1 = Issues found
         // >1 = Error
-        if (process_result.exit_code <= 1) {
+        if (sharded_result.cancelled) {
+            result.success = false;
+            result.error_message = "Clang-Tidy analysis cancelled";
+        } else if (sharded_result.exit_code <= 1) {
             result.success = true;
             
-            // Parse output directly (clang-tidy outputs to stdout)
-            std::string output_content;
-            if (!request.output_file.empty() && std::filesystem::exists(request.output_file)) {
-                std::ifstream file(request.output_file);
-                std::stringstream buffer;
-                buffer << file.rdbuf();
-                output_content = buffer.str();
-            } else {
-                output_content = process_result.stdout_output + "\n" + process_result.stderr_output;
-            }
-            
-            auto parsed_result = parse_clang_tidy_output(output_content);
-            result.issues = std::move(parsed_result.issues);
+            // Diagnostics were parsed while clang-tidy was running
+            result.issues = std::move(sharded_result.issues);
             result.compute_statistics();
             
         } else {
             result.success = false;
-            result.error_message = "Clang-Tidy failed with exit code " + std::to_string(process_result.exit_code) + 
-                                 ": " + process_result.stderr_output;
+            result.error_message = "Clang-Tidy failed with exit code " + std::to_string(sharded_result.exit_code) + 
+                                 ": " + sharded_result.stderr_output;
         }
         
     } catch (const std::exception& e) {
@@ -274,13 +324,13 @@ AnalysisResult ClangTidyTool::execute(const AnalysisRequest& request) {
     return result;
 }
 
-std::future<AnalysisResult> ClangTidyTool::execute_async(
+wip::utils::concurrency::Task<AnalysisResult> ClangTidyTool::execute_async(
     const AnalysisRequest& request,
     std::function<void(const AnalysisProgress&)> progress_callback,
     std::function<void(const std::string&)> output_callback) {
     
-    return std::async(std::launch::async, [this, request, progress_callback, output_callback]() {
-        std::cout << "[CLANG_TIDY_TOOL] Starting async execution with progress callbacks\n";
+    return wip::utils::concurrency::async([this, request, progress_callback, output_callback]() {
+        LOG_DEBUG("CLANG_TIDY_TOOL", "Starting async execution with progress callbacks");
         
         AnalysisResult result;
         result.tool_name = get_name();
@@ -324,101 +374,64 @@ std::future<AnalysisResult> ClangTidyTool::execute_async(
                 progress_callback(progress);
             }
             
-            // Build command line arguments  
-            std::vector<std::string> args = build_command_line(request);
+            LOG_DEBUG("CLANG_TIDY_TOOL", "Executing clang-tidy with ", get_effective_job_count(), " parallel jobs...");
             
-            // Send progress update
-            if (progress_callback) {
-                AnalysisProgress progress;
-                progress.total_files = 1;
-                progress.processed_files = 0;
-                progress.status_message = "Running clang-tidy analysis...";
-                progress_callback(progress);
-            }
-            
-            std::cout << "[CLANG_TIDY_TOOL] Executing clang-tidy with progress tracking...\n";
-            
-            // Execute the actual clang-tidy process
-            wip::utils::process::ProcessExecutor executor;
-            wip::utils::process::ProcessConfig config_process;
-            config_process.command = "clang-tidy";
-            config_process.arguments = args;
-            config_process.working_directory = request.source_path;
-            config_process.timeout = std::chrono::minutes(30); // 30 minute timeout
-            
-            auto process_result = executor.execute(config_process);
-            
-            // Write clang-tidy output to the output file (clang-tidy writes to stdout)
-            std::cout << "[CLANG_TIDY_TOOL] Clang-tidy stdout size: " << process_result.stdout_output.size() << " bytes\n";
-            std::cout << "[CLANG_TIDY_TOOL] Clang-tidy stderr: " << process_result.stderr_output << "\n";
+            // Run one clang-tidy process per translation unit; output and progress are
+            // reported as each shard completes
+            auto process_result = run_sharded(request, progress_callback, output_callback);
             
-            // Send output to callback line by line
-            if (output_callback && !process_result.stdout_output.empty()) {
-                std::istringstream iss(process_result.stdout_output);
-                std::string line;
-                while (std::getline(iss, line)) {
-                    output_callback(line);
-                }
-            }
-            
-            // Also send stderr if available
-            if (output_callback && !process_result.stderr_output.empty()) {
-                std::istringstream iss(process_result.stderr_output);
-                std::string line;
-                while (std::getline(iss, line)) {
-                    output_callback("ERROR: " + line);
-                }
-            }
+            // Keep the diagnostics in the output file so it can be re-parsed later
+            LOG_DEBUG("CLANG_TIDY_TOOL", "Clang-tidy analyzed ", process_result.files_analyzed, " translation units");
+            LOG_DEBUG("CLANG_TIDY_TOOL", "Clang-tidy reported ", process_result.issues.size(), " diagnostics");
             
             if (!request.output_file.empty()) {
-                std::cout << "[CLANG_TIDY_TOOL] Writing clang-tidy output to: " << request.output_file << std::endl;
+                LOG_DEBUG("CLANG_TIDY_TOOL", "Writing clang-tidy diagnostics to: ", request.output_file);
                 std::ofstream output_file(request.output_file);
                 if (output_file) {
-                    if (!process_result.stdout_output.empty()) {
-                        output_file << process_result.stdout_output;
+                    if (!process_result.diagnostic_output.empty()) {
+                        output_file << process_result.diagnostic_output;
                     } else {
                         // Write a minimal output if no stdout (so file parsing doesn't fail)
                         output_file << "# Clang-tidy analysis completed\n# No issues found or no output generated\n";
                     }
                     output_file.close();
-                    std::cout << "[CLANG_TIDY_TOOL] Output file written successfully\n";
+                    LOG_DEBUG("CLANG_TIDY_TOOL", "Output file written successfully");
                 } else {
-                    std::cout << "[CLANG_TIDY_TOOL] Failed to open output file for writing: " << request.output_file << std::endl;
+                    LOG_ERROR("CLANG_TIDY_TOOL", "Failed to open output file for writing: ", request.output_file);
                 }
             } else {
-                std::cout << "[CLANG_TIDY_TOOL] No output file specified in request\n";
+                LOG_DEBUG("CLANG_TIDY_TOOL", "No output file specified in request");
             }
             
+            bool run_succeeded = !process_result.cancelled &&
+                                 (process_result.exit_code == 0 || process_result.exit_code == 1);
+            
             // Send completion progress
             if (progress_callback) {
                 AnalysisProgress progress;
-                progress.total_files = 1; // Completed
-                progress.processed_files = 1;
-                progress.status_message = process_result.success() ? "Clang-tidy analysis completed" : "Clang-tidy analysis failed";
+                progress.total_files = process_result.files_analyzed; // Completed
+                progress.processed_files = process_result.files_analyzed;
+                progress.status_message = run_succeeded ? "Clang-tidy analysis completed" : "Clang-tidy analysis failed";
                 progress_callback(progress);
             }
             
-            std::cout << "[CLANG_TIDY_TOOL] Clang-tidy process completed with exit code: " << process_result.exit_code << "\n";
+            LOG_DEBUG("CLANG_TIDY_TOOL", "Clang-tidy processes completed with exit code: ", process_result.exit_code);
             
             auto end_time = std::chrono::steady_clock::now();
             auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+            result.profile = process_result.profile;
             
-            if (process_result.success() || process_result.exit_code == 1) {
-                // Parse results from output file (use request output file, not config default)
-                try {
-                    std::cout << "[CLANG_TIDY_TOOL] Parsing results from: " << request.output_file << std::endl;
-                    auto parsed_result = parse_results_file(request.output_file);
-                    
-                    result.issues = std::move(parsed_result.issues);
-                    result.success = true;
-                    result.files_analyzed = parsed_result.files_analyzed;
-                    result.execution_time = duration;
-                } catch (const std::exception& e) {
-                    std::cout << "[CLANG_TIDY_TOOL] Failed to parse results: " << e.what() << std::endl;
-                    result.success = false;
-                    result.error_message = "Failed to parse clang-tidy results: " + std::string(e.what());
-                    result.execution_time = duration;
-                }
+            if (run_succeeded) {
+                // Diagnostics were parsed while clang-tidy was running
+                result.issues = std::move(process_result.issues);
+                result.compute_statistics();
+                result.success = true;
+                result.files_analyzed = process_result.files_analyzed;
+                result.execution_time = duration;
+            } else if (process_result.cancelled) {
+                result.success = false;
+                result.error_message = "Clang-tidy analysis cancelled";
+                result.execution_time = duration;
             } else {
                 result.success = false;
                 result.error_message = "Clang-tidy execution failed with exit code " + std::to_string(process_result.exit_code) + ": " + process_result.stderr_output;
@@ -436,8 +449,7 @@ std::future<AnalysisResult> ClangTidyTool::execute_async(
 }
 
 bool ClangTidyTool::cancel_analysis() {
-    // TODO: Implement analysis cancellation
-    return false;
+    return cancel_active_runs();
 }
 
 bool ClangTidyTool::is_analysis_running() const {
@@ -462,6 +474,16 @@ std::vector<std::string> ClangTidyTool::get_supported_output_formats() const {
 }
 
 std::vector<std::string> ClangTidyTool::build_command_line(const AnalysisRequest& request) const {
+    auto args = build_base_command_line(request);
+    
+    // Source files (clang-tidy accepts several translation units per invocation)
+    auto translation_units = get_translation_units(request);
+    args.insert(args.end(), translation_units.begin(), translation_units.end());
+    
+    return args;
+}
+
+std::vector<std::string> ClangTidyTool::build_base_command_line(const AnalysisRequest& request) const {
     if (!config_) {
         throw std::runtime_error("No configuration set");
     }
@@ -476,7 +498,7 @@ std::vector<std::string> ClangTidyTool::build_command_line(const AnalysisRequest
     }
     
     // Build database path
-    std::string build_dir = find_build_directory(request.source_path);
+    std::string build_dir = find_compilation_database_directory(request.source_path);
     if (!build_dir.empty()) {
         args.push_back("-p");
         args.push_back(build_dir);
@@ -531,24 +553,6 @@ std::vector<std::string> ClangTidyTool::build_command_line(const AnalysisRequest
         args.push_back("--extra-arg=-D" + definition);
     }
     
-    // Source file (clang-tidy analyzes single files)
-    if (std::filesystem::is_regular_file(request.source_path)) {
-        args.push_back(request.source_path);
-    } else if (std::filesystem::is_directory(request.source_path)) {
-        // For directories, we need to find C++ files
-        // This is simplified - in practice, you'd want to handle this better
-        for (const auto& entry : std::filesystem::recursive_directory_iterator(request.source_path)) {
-            if (entry.is_regular_file()) {
-                auto ext = entry.path().extension().string();
-                if (std::find(get_supported_extensions().begin(), get_supported_extensions().end(), ext) 
-                    != get_supported_extensions().end()) {
-                    args.push_back(entry.path().string());
-                    break; // For now, just analyze the first file found
-                }
-            }
-        }
-    }
-    
     return args;
 }
 
@@ -625,57 +629,43 @@ bool ClangTidyTool::has_compilation_database(const std::string& build_dir) const
     return std::filesystem::exists(compile_commands);
 }
 
-// ==================== Private Helper Methods ====================
-
-std::string ClangTidyTool::find_clang_tidy_executable() const {
-    // Try common locations
-    std::vector<std::string> possible_paths = {
-        "clang-tidy",
-        "/usr/bin/clang-tidy",
-        "/usr/local/bin/clang-tidy",
-        "/opt/llvm/bin/clang-tidy"
-    };
-    
-    // Also try versioned executables
-    for (int version = 18; version >= 10; --version) {
-        possible_paths.push_back("clang-tidy-" + std::to_string(version));
-        possible_paths.push_back("/usr/bin/clang-tidy-" + std::to_string(version));
+std::vector<std::string> ClangTidyTool::get_translation_units(const AnalysisRequest& request) const {
+    // Prefer the compilation database: it lists exactly the TUs that are built
+    auto units = get_compilation_database_units(request);
+    if (!units.empty()) {
+        return units;
     }
     
-    for (const auto& path : possible_paths) {
-        try {
-            wip::utils::process::ProcessExecutor executor;
-            auto result = executor.execute(path, std::vector<std::string>{"--version"});
-            if (result.exit_code == 0) {
-                return path;
-            }
-        } catch (...) {
-            continue;
-        }
+    // Fall back to the explicit file list or walking the source tree
+    return AnalysisTool::get_translation_units(request);
+}
+
+size_t ClangTidyTool::get_effective_job_count() const {
+    if (config_ && config_->job_count > 0) {
+        return static_cast<size_t>(config_->job_count);
     }
     
-    return "";
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// ==================== Private Helper Methods ====================
+
+std::string ClangTidyTool::find_clang_tidy_executable() const {
+    return ToolDiscovery::get_shared().probe(get_name(), get_executable_candidates()).executable;
 }
 
 std::string ClangTidyTool::get_clang_tidy_version() const {
-    std::string executable = get_executable_path();
-    if (executable.empty()) {
+    // The discovery probe already ran --version, and its output is cached with it
+    auto probe = ToolDiscovery::get_shared().probe(get_name(), get_executable_candidates());
+    if (!probe.found()) {
         return "Not available";
     }
     
-    try {
-        wip::utils::process::ProcessExecutor executor;
-        auto result = executor.execute(executable, std::vector<std::string>{"--version"});
-        if (result.exit_code == 0 && !result.stdout_output.empty()) {
-            // Extract version from output like "LLVM (http://llvm.org/):\n  LLVM version 14.0.0"
-            std::regex version_regex(R"(LLVM version\s+(\d+\.\d+(?:\.\d+)?))");
-            std::smatch matches;
-            if (std::regex_search(result.stdout_output, matches, version_regex)) {
-                return matches[1].str();
-            }
-        }
-    } catch (...) {
-        // Ignore errors
+    // Extract version from output like "LLVM (http://llvm.org/):\n  LLVM version 14.0.0"
+    std::regex version_regex(R"(LLVM version\s+(\d+\.\d+(?:\.\d+)?))");
+    std::smatch matches;
+    if (std::regex_search(probe.version_output, matches, version_regex)) {
+        return matches[1].str();
     }
     
     return "Unknown";
@@ -689,15 +679,23 @@ AnalysisResult ClangTidyTool::parse_clang_tidy_output(const std::string& output)
     result.timestamp = std::chrono::system_clock::now();
     
     try {
-        std::istringstream stream(output);
-        std::string line;
+        // Diagnostics in shared headers are reported once per TU that includes them
+        ParseArena arena;
+        std::pmr::set<std::string_view> seen_diagnostics(arena.resource());
         
-        while (std::getline(stream, line)) {
-            auto issue = parse_diagnostic_line(line);
-            if (!issue.file_path.empty()) {
-                result.add_issue(issue);
+        std::string_view remaining(output);
+        while (!remaining.empty()) {
+            size_t newline = remaining.find('\n');
+            std::string_view line = remaining.substr(0, newline);
+            remaining.remove_prefix(newline == std::string_view::npos ? remaining.size() : newline + 1);
+            
+            // Nothing is allocated for lines that are not diagnostics
+            auto diagnostic = parse_clang_tidy_diagnostic(line);
+            if (diagnostic && seen_diagnostics.insert(line).second) {
+                result.issues.push_back(make_issue(*diagnostic));
             }
         }
+        result.compute_statistics();
         
         result.success = true;
         
@@ -709,38 +707,27 @@ AnalysisResult ClangTidyTool::parse_clang_tidy_output(const std::string& output)
     return result;
 }
 
-AnalysisIssue ClangTidyTool::parse_diagnostic_line(const std::string& line) const {
-    AnalysisIssue issue;
-    
+AnalysisIssue ClangTidyTool::make_issue(const ClangTidyDiagnostic& diagnostic) const {
     // Clang-tidy output format: /path/to/file.cpp:123:45: warning: message [check-name]
-    std::regex diagnostic_regex(R"(^([^:]+):(\d+):(\d+):\s+(warning|error|note):\s+([^[]+)\s*(?:\[([^\]]+)\])?.*$)");
-    std::smatch matches;
+    AnalysisIssue issue;
+    issue.file_path = std::string(diagnostic.file_path);
+    issue.line_number = diagnostic.line_number;
+    issue.column_number = diagnostic.column_number;
+    issue.severity = map_clang_tidy_severity(diagnostic.severity);
+    issue.message = std::string(diagnostic.message);
     
-    if (std::regex_match(line, matches, diagnostic_regex)) {
-        issue.file_path = matches[1].str();
-        issue.line_number = std::stoi(matches[2].str());
-        issue.column_number = std::stoi(matches[3].str());
-        
-        std::string severity_str = matches[4].str();
-        issue.severity = map_clang_tidy_severity(severity_str);
-        
-        issue.message = matches[5].str();
-        // Trim trailing whitespace
-        issue.message.erase(issue.message.find_last_not_of(" \t") + 1);
-        
-        if (matches[6].matched) {
-            issue.rule_id = matches[6].str();
-            issue.category = map_clang_tidy_category(issue.rule_id);
-        }
-        
-        issue.tool_name = get_name();
-        issue.id = issue.rule_id + "_" + std::to_string(issue.line_number) + "_" + std::to_string(issue.column_number);
+    if (!diagnostic.check_name.empty()) {
+        issue.rule_id = std::string(diagnostic.check_name);
+        issue.category = map_clang_tidy_category(issue.rule_id);
     }
     
+    issue.tool_name = get_name();
+    issue.id = issue.rule_id + "_" + std::to_string(issue.line_number) + "_" + std::to_string(issue.column_number);
+    
     return issue;
 }
 
-IssueSeverity ClangTidyTool::map_clang_tidy_severity(const std::string& severity) const {
+IssueSeverity ClangTidyTool::map_clang_tidy_severity(std::string_view severity) const {
     if (severity == "error") return IssueSeverity::Error;
     if (severity == "warning") return IssueSeverity::Warning;
     if (severity == "note") return IssueSeverity::Info;
@@ -762,30 +749,303 @@ IssueCategory ClangTidyTool::map_clang_tidy_category(const std::string& check_na
     return IssueCategory::Bug;
 }
 
-std::string ClangTidyTool::find_build_directory(const std::string& source_path) const {
-    std::filesystem::path source(source_path);
+ClangTidyTool::ShardedRunResult ClangTidyTool::run_sharded(
+    const AnalysisRequest& request,
+    std::function<void(const AnalysisProgress&)> progress_callback,
+    std::function<void(const std::string&)> output_callback) const {
     
-    // If source_path is a file, get its directory
-    if (std::filesystem::is_regular_file(source)) {
-        source = source.parent_path();
+    ShardedRunResult run_result;
+    
+    auto base_args = build_base_command_line(request);
+    auto units = get_translation_units(request);
+    if (units.empty() || base_args.empty() || base_args[0].empty()) {
+        return run_result;
+    }
+    
+    std::filesystem::path working_directory(request.source_path);
+    if (std::filesystem::is_regular_file(working_directory)) {
+        working_directory = working_directory.parent_path();
     }
     
-    // Common build directory names to search for
-    std::vector<std::string> build_dirs = {"build", "_build", "Debug", "Release"};
+    // Cancelling stops the running shards and skips the ones not started yet
+    ActiveRun active_run(*this, request);
     
-    // Search up the directory tree
-    std::filesystem::path current = source;
-    while (!current.empty() && current != current.parent_path()) {
-        for (const auto& build_dir : build_dirs) {
-            std::filesystem::path build_path = current / build_dir;
-            if (has_compilation_database(build_path.string())) {
-                return build_path.string();
+    std::vector<wip::utils::process::ProcessConfig> process_configs;
+    process_configs.reserve(units.size());
+    for (const auto& unit : units) {
+        wip::utils::process::ProcessConfig process_config;
+        process_config.command = base_args[0];
+        process_config.arguments.assign(base_args.begin() + 1, base_args.end());
+        process_config.arguments.push_back(unit);
+        if (std::filesystem::is_directory(working_directory)) {
+            process_config.working_directory = working_directory.string();
+        }
+        process_config.timeout = std::chrono::minutes(30); // 30 minute timeout per TU
+        process_config.cancellation = active_run.get_token();
+        process_config.own_process_group = true;
+        process_configs.push_back(std::move(process_config));
+    }
+    
+    size_t job_count = std::min(get_effective_job_count(), units.size());
+    if (request.max_parallel_jobs > 0) {
+        job_count = std::min(job_count, request.max_parallel_jobs);
+    }
+    
+    // Units starting with the same includes load them from one precompiled header
+    ScopedDirectory precompiled_directory;
+    if (config_->precompiled_headers && !active_run.get_token().is_cancelled()) {
+        if (auto directory = wip::utils::file::create_temp_directory(std::filesystem::temp_directory_path(),
+                                                                     "wip_clang_tidy_pch")) {
+            precompiled_directory.path = *directory;
+            auto precompiled_headers = build_precompiled_headers(request, units, working_directory.string(), job_count,
+                                                                 active_run.get_token(), *directory, run_result.profile);
+            for (size_t index = 0; index < units.size(); ++index) {
+                auto it = precompiled_headers.find(units[index]);
+                if (it != precompiled_headers.end()) {
+                    auto& arguments = process_configs[index].arguments;
+                    arguments.insert(arguments.end() - 1, {"--extra-arg=-include-pch", "--extra-arg=" + it->second});
+                }
             }
+        } else {
+            LOG_WARNING("CLANG_TIDY_TOOL", "Cannot create a directory for precompiled headers");
         }
-        current = current.parent_path();
     }
     
-    return "";
+    // With -p each process would load the whole database for its one unit;
+    // it gets a database of just that unit instead
+    ScopedDirectory database_directory;
+    auto build_dir_argument = std::find(base_args.begin(), base_args.end(), "-p");
+    auto database = build_dir_argument != base_args.end() && build_dir_argument + 1 != base_args.end()
+        ? CompilationDatabase::open(*(build_dir_argument + 1)) : nullptr;
+    if (database && !active_run.get_token().is_cancelled()) {
+        if (auto directory = wip::utils::file::create_temp_directory(std::filesystem::temp_directory_path(),
+                                                                     "wip_clang_tidy_db")) {
+            database_directory.path = *directory;
+            size_t build_dir_index = static_cast<size_t>(build_dir_argument - base_args.begin());
+            for (size_t index = 0; index < units.size(); ++index) {
+                std::error_code ec;
+                auto unit_directory = *directory / std::to_string(index);
+                if (database->find(units[index]) && std::filesystem::create_directory(unit_directory, ec) &&
+                    database->write_subset({units[index]}, unit_directory) == 1) {
+                    process_configs[index].arguments[build_dir_index] = unit_directory.string();
+                }
+            }
+        }
+    }
+    
+    // Output is parsed line by line as it arrives instead of being buffered:
+    // source excerpts and notes make up most of it and are dropped straight away.
+    // Every callback runs on this thread, driven by the batch event loop.
+    // Diagnostic lines are only kept until the merge, so they live in the run's arena.
+    ParseArena arena;
+    struct ShardOutput {
+        explicit ShardOutput(std::pmr::memory_resource* resource) : diagnostic_lines(resource) {}
+        std::pmr::vector<std::string_view> diagnostic_lines;
+        std::vector<AnalysisIssue> issues;     // Parallel to diagnostic_lines
+        std::string stderr_output;
+    };
+    std::vector<ShardOutput> shard_outputs;
+    shard_outputs.reserve(units.size());
+    ChangedLines scope(request.changed_ranges);
+    for (size_t index = 0; index < units.size(); ++index) {
+        shard_outputs.emplace_back(arena.resource());
+    }
+    std::vector<std::unique_ptr<wip::utils::process::LineSplitter>> splitters;
+    splitters.reserve(units.size());
+    for (size_t index = 0; index < units.size(); ++index) {
+        auto* shard_output = &shard_outputs[index];
+        splitters.push_back(std::make_unique<wip::utils::process::LineSplitter>(
+            [this, shard_output, &arena, &scope, &output_callback, &run_result](wip::utils::process::OutputStream stream, std::string_view line) {
+                bool is_stderr = stream == wip::utils::process::OutputStream::Stderr;
+                if (is_stderr) {
+                    shard_output->stderr_output.append(line.data(), line.size());
+                    shard_output->stderr_output += '\n';
+                }
+                if (output_callback) {
+                    output_callback((is_stderr ? "ERROR: " : "") + std::string(line));
+                }
+                wip::time::utilities::ScopedTimer parse_timer(run_result.profile.parse_time);
+                // A diff-scoped run keeps only the diagnostics on changed lines
+                auto diagnostic = parse_clang_tidy_diagnostic(line);
+                if (diagnostic && (scope.empty() || scope.contains(std::string(diagnostic->file_path), diagnostic->line_number))) {
+                    shard_output->diagnostic_lines.push_back(arena.copy(line));
+                    shard_output->issues.push_back(make_issue(*diagnostic));
+                }
+            }));
+        process_configs[index].output_callback = splitters.back()->as_output_callback();
+        process_configs[index].buffer_output = false;
+    }
+    
+    size_t completed_units = 0;
+    wip::utils::process::ProcessExecutor executor;
+    auto shard_results = executor.execute_batch(process_configs, job_count,
+        [&](size_t index, const wip::utils::process::ProcessResult& shard) {
+            ++completed_units;
+            splitters[index]->flush();
+            
+            // Launch failures are reported in the result rather than as output
+            if (!shard.stderr_output.empty()) {
+                shard_outputs[index].stderr_output += shard.stderr_output + "\n";
+            }
+            
+            if (progress_callback) {
+                AnalysisProgress progress;
+                progress.total_files = units.size();
+                progress.processed_files = completed_units;
+                progress.current_file = units[index];
+                progress.status_message = "Analyzed " + units[index];
+                progress_callback(progress);
+            }
+        });
+    
+    // Merge shards in TU order so results are deterministic; diagnostics in
+    // shared headers are reported once per TU that includes them
+    {
+        wip::time::utilities::ScopedTimer merge_timer(run_result.profile.aggregate_time);
+        std::pmr::set<std::string_view> seen_diagnostics(arena.resource());
+        for (size_t index = 0; index < units.size(); ++index) {
+            auto& shard_output = shard_outputs[index];
+            run_result.profile.add_process(shard_results[index]);
+            run_result.profile.unit_cpu_times[units[index]] += shard_results[index].cpu_time;
+            auto& unit_rss = run_result.profile.unit_peak_rss_kb[units[index]];
+            unit_rss = std::max(unit_rss, shard_results[index].max_rss_kb);
+            run_result.exit_code = merge_exit_codes(run_result.exit_code, shard_results[index].exit_code);
+            run_result.cancelled = run_result.cancelled || shard_results[index].cancelled;
+            for (size_t issue_index = 0; issue_index < shard_output.issues.size(); ++issue_index) {
+                const auto& line = shard_output.diagnostic_lines[issue_index];
+                if (seen_diagnostics.insert(line).second) {
+                    run_result.diagnostic_output += line;
+                    run_result.diagnostic_output += '\n';
+                    run_result.issues.push_back(std::move(shard_output.issues[issue_index]));
+                }
+            }
+            run_result.stderr_output += shard_output.stderr_output;
+        }
+    }
+    run_result.files_analyzed = units.size();
+    
+    return run_result;
+}
+
+std::string ClangTidyTool::find_clang_compiler() const {
+    // clang-tidy only loads precompiled headers of its own clang version, so
+    // the compiler installed next to it is tried first
+    std::filesystem::path clang_tidy(get_executable_path());
+    std::string name = clang_tidy.filename().string();
+    std::vector<std::string> candidates;
+    size_t position = name.find("clang-tidy");
+    if (position != std::string::npos) {
+        name.replace(position, std::string("clang-tidy").size(), "clang++");
+        if (clang_tidy.has_parent_path()) {
+            candidates.push_back((clang_tidy.parent_path() / name).string());
+        }
+        candidates.push_back(name);
+    }
+    candidates.push_back("clang++");
+    
+    auto probe = ToolDiscovery::get_shared().probe("clang++", candidates);
+    if (!probe.found()) {
+        return "";
+    }
+    std::regex version_regex(R"(clang version\s+(\d+\.\d+(?:\.\d+)?))");
+    std::smatch matches;
+    if (!std::regex_search(probe.version_output, matches, version_regex) || matches[1].str() != get_version()) {
+        return "";
+    }
+    return probe.executable;
+}
+
+std::map<std::string, std::string> ClangTidyTool::build_precompiled_headers(
+    const AnalysisRequest& request, const std::vector<std::string>& units,
+    const std::string& working_directory, size_t job_count,
+    const wip::utils::process::CancellationToken& token,
+    const std::filesystem::path& directory, ExecutionProfile& profile) const {
+    
+    std::map<std::string, std::string> precompiled_headers;
+    std::string compiler = find_clang_compiler();
+    if (compiler.empty()) {
+        LOG_WARNING("CLANG_TIDY_TOOL", "No clang++ of clang-tidy's version ", get_version(), " found; not precompiling headers");
+        return precompiled_headers;
+    }
+    wip::time::utilities::ScopedTimer precompile_timer(profile.precompile_time);
+    
+    // Units are compiled as clang-tidy compiles them: with their database
+    // command, if any, and the request's --extra-arg flags appended
+    std::map<std::string, PrecompiledHeaderPlanner::CompileCommand> commands;
+    std::string build_dir = find_compilation_database_directory(request.source_path);
+    if (!build_dir.empty()) {
+        commands = PrecompiledHeaderPlanner::read_compile_commands(build_dir);
+    }
+    std::vector<PrecompiledHeaderPlanner::Unit> prefixes;
+    prefixes.reserve(units.size());
+    for (const auto& unit : units) {
+        PrecompiledHeaderPlanner::Unit prefix;
+        prefix.path = unit;
+        auto it = commands.find(unit);
+        if (it != commands.end()) {
+            prefix.command = it->second;
+        } else {
+            prefix.command.directory = working_directory;
+            prefix.command.language = std::filesystem::path(unit).extension() == ".c" ? "c" : "c++";
+        }
+        for (const auto& include_path : request.include_paths) {
+            prefix.command.flags.push_back("-I" + include_path);
+        }
+        for (const auto& definition : request.definitions) {
+            prefix.command.flags.push_back("-D" + definition);
+        }
+        
+        std::ifstream file(unit, std::ios::binary);
+        std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        prefix.includes = PrecompiledHeaderPlanner::leading_includes(
+            contents, unit, PrecompiledHeaderPlanner::get_include_dirs(prefix.command));
+        prefixes.push_back(std::move(prefix));
+    }
+    
+    auto groups = PrecompiledHeaderPlanner::plan(prefixes, static_cast<size_t>(config_->precompiled_header_min_units));
+    if (groups.empty()) {
+        return precompiled_headers;
+    }
+    
+    std::vector<wip::utils::process::ProcessConfig> process_configs;
+    std::vector<std::string> outputs;
+    for (size_t index = 0; index < groups.size(); ++index) {
+        const auto& group = groups[index];
+        auto header = directory / ("prefix" + std::to_string(index) + ".h");
+        std::ofstream(header) << PrecompiledHeaderPlanner::header_text(group);
+        outputs.push_back(header.string() + ".pch");
+        
+        wip::utils::process::ProcessConfig process_config;
+        process_config.command = compiler;
+        process_config.arguments = {"-x", group.command.language + "-header"};
+        process_config.arguments.insert(process_config.arguments.end(), group.command.flags.begin(), group.command.flags.end());
+        process_config.arguments.insert(process_config.arguments.end(), {header.string(), "-o", outputs.back()});
+        if (std::filesystem::is_directory(group.command.directory)) {
+            process_config.working_directory = group.command.directory;
+        }
+        process_config.timeout = std::chrono::minutes(30);
+        process_config.cancellation = token;
+        process_config.own_process_group = true;
+        process_configs.push_back(std::move(process_config));
+    }
+    
+    // A prefix that does not compile on its own is parsed by its units as before
+    wip::utils::process::ProcessExecutor executor;
+    auto results = executor.execute_batch(process_configs, job_count);
+    for (size_t index = 0; index < groups.size(); ++index) {
+        profile.add_process(results[index]);
+        if (!results[index].success()) {
+            LOG_WARNING("CLANG_TIDY_TOOL", "Cannot precompile the include prefix of ", groups[index].units.size(),
+                        " units: ", results[index].stderr_output);
+            continue;
+        }
+        for (const auto& unit : groups[index].units) {
+            precompiled_headers[unit] = outputs[index];
+        }
+    }
+    LOG_INFO("CLANG_TIDY_TOOL", "Precompiled ", groups.size(), " include prefixes for ",
+             precompiled_headers.size(), " of ", units.size(), " translation units");
+    return precompiled_headers;
 }
 
 // Static registration
@@ -0,0 +1,114 @@
+#include "tools/cppcheck_build_directory.h"
+#include "analysis_cache.h"
+#include <file.h>
+#include <fstream>
+
+namespace wip {
+namespace analysis {
+namespace tools {
+
+namespace {
+
+// Base name cppcheck numbers its analyzer files by: the file name up to its last dot
+std::string analyzer_stem(const std::string& unit) {
+    size_t begin = unit.find_last_of("/\\");
+    std::string name = begin == std::string::npos ? unit : unit.substr(begin + 1);
+    size_t dot = name.rfind('.');
+    return dot == std::string::npos ? name : name.substr(0, dot);
+}
+
+} // namespace
+
+CppcheckBuildDirectory::CppcheckBuildDirectory(const std::filesystem::path& root, const std::string& config_hash,
+                                               const std::vector<std::string>& units)
+    : store_(root / config_hash) {
+    std::filesystem::create_directories(store_);
+
+    std::error_code ec;
+    for (std::filesystem::directory_iterator it(root, ec), end; !ec && it != end; it.increment(ec)) {
+        if (it->path().filename() != config_hash) {
+            std::error_code remove_error;
+            std::filesystem::remove_all(it->path(), remove_error);
+        }
+    }
+
+    auto directory = wip::utils::file::create_temp_directory(store_, "run");
+    if (!directory) {
+        throw std::filesystem::filesystem_error("Cannot create cppcheck build directory", store_,
+                                                std::make_error_code(std::errc::io_error));
+    }
+    path_ = *directory;
+
+    // Units sharing a base name are numbered in an order cppcheck picks, so only
+    // the unique ones can be seeded under the name cppcheck will look for
+    std::map<std::string, size_t> stem_counts;
+    for (const auto& unit : units) {
+        ++stem_counts[analyzer_stem(unit)];
+    }
+    for (const auto& unit : units) {
+        std::string stem = analyzer_stem(unit);
+        if (stem_counts[stem] != 1) {
+            continue;
+        }
+        auto stored = get_stored_path(unit);
+        auto seeded = path_ / (stem + ".a1");
+        if (std::filesystem::copy_file(stored, seeded, ec)) {
+            seeds_[seeded.filename().string()] = {stored, std::filesystem::last_write_time(seeded, ec)};
+        }
+    }
+}
+
+CppcheckBuildDirectory::~CppcheckBuildDirectory() {
+    std::error_code ec;
+    std::filesystem::remove_all(path_, ec);
+}
+
+std::string CppcheckBuildDirectory::get_path() const {
+    return path_.string();
+}
+
+CppcheckBuildDirectory::Stats CppcheckBuildDirectory::commit(const std::filesystem::path& working_directory) {
+    Stats stats;
+
+    // One "<analyzer file>:<configuration>:<unit>" line per unit of the run
+    std::ifstream files(path_ / "files.txt");
+    std::string line;
+    while (std::getline(files, line)) {
+        size_t first = line.find(':');
+        size_t second = first == std::string::npos ? std::string::npos : line.find(':', first + 1);
+        if (second == std::string::npos) {
+            continue;
+        }
+        std::string analyzer_file = line.substr(0, first);
+        std::filesystem::path unit = line.substr(second + 1);
+        if (unit.is_relative()) {
+            unit = working_directory / unit;
+        }
+
+        std::error_code ec;
+        auto written = path_ / analyzer_file;
+        auto write_time = std::filesystem::last_write_time(written, ec);
+        if (ec) {
+            continue;
+        }
+        ++stats.lookups;
+
+        auto stored = get_stored_path(unit.string());
+        auto seed = seeds_.find(analyzer_file);
+        if (seed != seeds_.end() && seed->second.stored == stored && seed->second.write_time == write_time) {
+            ++stats.hits;
+            continue;
+        }
+        std::filesystem::rename(written, stored, ec);
+    }
+    return stats;
+}
+
+std::filesystem::path CppcheckBuildDirectory::get_stored_path(const std::filesystem::path& unit) const {
+    auto absolute = std::filesystem::absolute(unit).lexically_normal();
+    return store_ / (AnalysisCache::hash_content(absolute.string()) + ".a");
+}
+
+} // namespace tools
+} // namespace analysis
+} // namespace wip
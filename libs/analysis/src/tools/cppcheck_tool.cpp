@@ -1,11 +1,17 @@
 #include "tools/cppcheck_tool.h"
-#include <iostream>
+#include "tool_discovery.h"
+#include "analysis_cache.h"
+#include "compilation_database.h"
+#include "changed_lines.h"
+#include <time_utilities.h>
+#include <log.h>
+#include <wip_string.h>
+#include <file.h>
 #include <fstream>
 #include <sstream>
 #include <filesystem>
 #include <regex>
 #include <algorithm>
-#include <future>
 #include <thread>
 #include <process.h>
 
@@ -13,6 +19,74 @@ namespace wip {
 namespace analysis {
 namespace tools {
 
+namespace {
+
+// Common install locations
+std::vector<std::string> get_executable_candidates() {
+    return {
+        "cppcheck",
+        "/usr/bin/cppcheck",
+        "/usr/local/bin/cppcheck",
+        "/opt/cppcheck/bin/cppcheck"
+    };
+}
+
+struct ScopedDirectory {
+    std::filesystem::path path;
+    
+    ~ScopedDirectory() {
+        if (!path.empty()) {
+            std::error_code ec;
+            std::filesystem::remove_all(path, ec);
+        }
+    }
+};
+
+// Points --project at a database holding only the units of the --file-filter
+// arguments, so cppcheck does not load every entry of a large database for
+// one shard. Returns the directory of the new database; empty if the
+// arguments were left alone.
+std::filesystem::path narrow_project(std::vector<std::string>& args) {
+    const std::string project_option = "--project=";
+    const std::string filter_option = "--file-filter=";
+    auto project = std::find_if(args.begin(), args.end(), [&project_option](const std::string& argument) {
+        return argument.compare(0, project_option.size(), project_option) == 0;
+    });
+    if (project == args.end()) {
+        return {};
+    }
+    
+    std::vector<std::string> units;
+    for (const auto& argument : args) {
+        if (argument.compare(0, filter_option.size(), filter_option) == 0) {
+            std::string filter = argument.substr(filter_option.size());
+            if (filter.find_first_of("*?") != std::string::npos) {
+                return {};
+            }
+            units.push_back(std::move(filter));
+        }
+    }
+    
+    auto database = units.empty() ? nullptr : CompilationDatabase::open(
+        std::filesystem::path(project->substr(project_option.size())).parent_path().string());
+    if (!database) {
+        return {};
+    }
+    auto directory = wip::utils::file::create_temp_directory(std::filesystem::temp_directory_path(), "wip_cppcheck_db");
+    if (!directory) {
+        return {};
+    }
+    if (database->write_subset(units, *directory) == 0) {
+        std::error_code ec;
+        std::filesystem::remove_all(*directory, ec);
+        return {};
+    }
+    *project = project_option + (*directory / "compile_commands.json").string();
+    return *directory;
+}
+
+} // namespace
+
 // ==================== CppcheckConfig Implementation ====================
 
 CppcheckConfig::CppcheckConfig() {
@@ -41,6 +115,8 @@ nlohmann::json CppcheckConfig::to_json() const {
     
     j["job_count"] = job_count;
     j["quiet"] = quiet;
+    j["use_compilation_database"] = use_compilation_database;
+    j["cache_directory"] = cache_directory;
     
     j["suppress_unused_function"] = suppress_unused_function;
     j["suppress_missing_include_system"] = suppress_missing_include_system;
@@ -74,6 +150,8 @@ void CppcheckConfig::from_json(const nlohmann::json& j) {
     
     job_count = j.value("job_count", 4);
     quiet = j.value("quiet", true);
+    use_compilation_database = j.value("use_compilation_database", true);
+    cache_directory = j.value("cache_directory", std::string());
     
     suppress_unused_function = j.value("suppress_unused_function", true);
     suppress_missing_include_system = j.value("suppress_missing_include_system", true);
@@ -198,18 +276,18 @@ std::string CppcheckTool::get_system_requirements() const {
 }
 
 AnalysisResult CppcheckTool::execute(const AnalysisRequest& request) {
-    std::cout << "[CPPCHECK_TOOL] execute() called\n";
+    LOG_DEBUG("CPPCHECK_TOOL", "execute() called");
     if (!config_) {
-        std::cout << "[CPPCHECK_TOOL] No configuration set!\n";
+        LOG_ERROR("CPPCHECK_TOOL", "No configuration set!");
         throw std::runtime_error("No configuration set for CppcheckTool");
     }
     
     if (!is_available()) {
-        std::cout << "[CPPCHECK_TOOL] Tool not available!\n";
+        LOG_ERROR("CPPCHECK_TOOL", "Tool not available!");
         throw std::runtime_error("Cppcheck is not available on this system");
     }
     
-    std::cout << "[CPPCHECK_TOOL] Tool is available, starting analysis...\n";
+    LOG_DEBUG("CPPCHECK_TOOL", "Tool is available, starting analysis...");
     analysis_running_ = true;
     
     AnalysisResult result;
@@ -222,31 +300,49 @@ AnalysisResult CppcheckTool::execute(const AnalysisRequest& request) {
         auto start_time = std::chrono::steady_clock::now();
         
         // Build command line
-        std::cout << "[CPPCHECK_TOOL] Building command line...\n";
+        LOG_DEBUG("CPPCHECK_TOOL", "Building command line...");
         auto command_args = build_command_line(request);
-        
-        std::cout << "[CPPCHECK_TOOL] Command: ";
-        for (const auto& arg : command_args) {
-            std::cout << arg << " ";
+        ScopedDirectory project_directory{narrow_project(command_args)};
+        auto build_directory = open_build_directory(request);
+        if (build_directory) {
+            command_args.insert(command_args.begin() + 1, "--cppcheck-build-dir=" + build_directory->get_path());
         }
-        std::cout << "\n";
+        
+        LOG_DEBUG("CPPCHECK_TOOL", "Command: ", wip::utils::string::join(command_args, " "));
         
         // Execute cppcheck
-        std::cout << "[CPPCHECK_TOOL] About to execute cppcheck...\n";
+        LOG_DEBUG("CPPCHECK_TOOL", "About to execute cppcheck...");
+        ActiveRun active_run(*this, request);
         wip::utils::process::ProcessExecutor executor;
-        wip::utils::process::ProcessResult process_result = executor.execute(
+        auto config_process = wip::utils::process::ProcessConfig::from_command_args(
             command_args[0], 
             std::vector<std::string>(command_args.begin() + 1, command_args.end())
         );
+        config_process.cancellation = active_run.get_token();
+        config_process.own_process_group = true;     // Cancelling also stops cppcheck's own workers
+        wip::utils::process::ProcessResult process_result = executor.execute(config_process);
         
-        std::cout << "[CPPCHECK_TOOL] Cppcheck execution completed with exit code: " << process_result.exit_code << "\n";
+        LOG_DEBUG("CPPCHECK_TOOL", "Cppcheck execution completed with exit code: ", process_result.exit_code);
         auto end_time = std::chrono::steady_clock::now();
         result.execution_time = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+        ExecutionProfile profile;
+        profile.add_process(process_result);
         
-        if (process_result.exit_code == 0 || process_result.exit_code == 1) {
+        if (process_result.cancelled) {
+            result.success = false;
+            result.error_message = "Cppcheck analysis cancelled";
+        } else if (process_result.exit_code == 0 || process_result.exit_code == 1) {
             // Exit code 1 is normal for cppcheck when issues are found
+            {
+                wip::time::utilities::ScopedTimer parse_timer(profile.parse_time);
+                result = parse_results_file(request.output_file, ChangedLines(request.changed_ranges));
+            }
+            if (build_directory) {
+                auto stats = build_directory->commit();
+                profile.tool_cache_lookups = stats.lookups;
+                profile.tool_cache_hits = stats.hits;
+            }
             result.success = true;
-            result = parse_results_file(request.output_file);
             result.execution_time = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
         } else {
             result.success = false;
@@ -254,6 +350,8 @@ AnalysisResult CppcheckTool::execute(const AnalysisRequest& request) {
                                  ": " + process_result.stderr_output;
         }
         
+        result.profile = profile;
+        
     } catch (const std::exception& e) {
         result.success = false;
         result.error_message = std::string("Cppcheck execution failed: ") + e.what();
@@ -263,13 +361,13 @@ AnalysisResult CppcheckTool::execute(const AnalysisRequest& request) {
     return result;
 }
 
-std::future<AnalysisResult> CppcheckTool::execute_async(
+wip::utils::concurrency::Task<AnalysisResult> CppcheckTool::execute_async(
     const AnalysisRequest& request,
     std::function<void(const AnalysisProgress&)> progress_callback,
     std::function<void(const std::string&)> output_callback) {
     
-    return std::async(std::launch::async, [this, request, progress_callback, output_callback]() {
-        std::cout << "[CPPCHECK_TOOL] Starting async execution with progress callbacks\n";
+    return wip::utils::concurrency::async([this, request, progress_callback, output_callback]() {
+        LOG_DEBUG("CPPCHECK_TOOL", "Starting async execution with progress callbacks");
         
         AnalysisResult result;
         result.tool_name = get_name();
@@ -306,6 +404,11 @@ std::future<AnalysisResult> CppcheckTool::execute_async(
             
             // Build command line arguments
             std::vector<std::string> args = build_command_line(request);
+            ScopedDirectory project_directory{narrow_project(args)};
+            auto build_directory = open_build_directory(request);
+            if (build_directory) {
+                args.insert(args.begin() + 1, "--cppcheck-build-dir=" + build_directory->get_path());
+            }
             
             // Send progress update
             if (progress_callback) {
@@ -316,7 +419,7 @@ std::future<AnalysisResult> CppcheckTool::execute_async(
                 progress_callback(progress);
             }
             
-            std::cout << "[CPPCHECK_TOOL] Executing cppcheck with progress tracking...\n";
+            LOG_DEBUG("CPPCHECK_TOOL", "Executing cppcheck with progress tracking...");
             
             // Send initial progress
             if (progress_callback) {
@@ -328,12 +431,14 @@ std::future<AnalysisResult> CppcheckTool::execute_async(
             }
             
             // Execute the actual cppcheck process
+            ActiveRun active_run(*this, request);
             wip::utils::process::ProcessExecutor executor;
-            wip::utils::process::ProcessConfig config_process;
-            config_process.command = "cppcheck";
-            config_process.arguments = args;
+            auto config_process = wip::utils::process::ProcessConfig::from_command_args(
+                args[0], std::vector<std::string>(args.begin() + 1, args.end()));
             config_process.working_directory = request.source_path;
             config_process.timeout = std::chrono::minutes(30); // 30 minute timeout
+            config_process.cancellation = active_run.get_token();
+            config_process.own_process_group = true;
             
             auto process_result = executor.execute(config_process);
             
@@ -364,14 +469,28 @@ std::future<AnalysisResult> CppcheckTool::execute_async(
                 progress_callback(progress);
             }
             
-            std::cout << "[CPPCHECK_TOOL] Cppcheck process completed with exit code: " << process_result.exit_code << "\n";
+            LOG_DEBUG("CPPCHECK_TOOL", "Cppcheck process completed with exit code: ", process_result.exit_code);
             
             auto end_time = std::chrono::steady_clock::now();
             auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+            result.profile.add_process(process_result);
             
-            if (process_result.success()) {
+            if (process_result.cancelled) {
+                result.success = false;
+                result.error_message = "Cppcheck analysis cancelled";
+                result.execution_time = duration;
+            } else if (process_result.success()) {
                 // Parse results from output file
-                auto parsed_result = parse_results_file(request.output_file);
+                AnalysisResult parsed_result;
+                {
+                    wip::time::utilities::ScopedTimer parse_timer(result.profile.parse_time);
+                    parsed_result = parse_results_file(request.output_file, ChangedLines(request.changed_ranges));
+                }
+                if (build_directory) {
+                    auto stats = build_directory->commit(std::filesystem::absolute(request.source_path));
+                    result.profile.tool_cache_lookups = stats.lookups;
+                    result.profile.tool_cache_hits = stats.hits;
+                }
                 
                 result.issues = std::move(parsed_result.issues);
                 result.success = true;
@@ -394,8 +513,7 @@ std::future<AnalysisResult> CppcheckTool::execute_async(
 }
 
 bool CppcheckTool::cancel_analysis() {
-    // TODO: Implement analysis cancellation
-    return false;
+    return cancel_active_runs();
 }
 
 bool CppcheckTool::is_analysis_running() const {
@@ -403,8 +521,12 @@ bool CppcheckTool::is_analysis_running() const {
 }
 
 AnalysisResult CppcheckTool::parse_results_file(const std::string& output_file) {
+    return parse_results_file(output_file, ChangedLines());
+}
+
+AnalysisResult CppcheckTool::parse_results_file(const std::string& output_file, const ChangedLines& scope) const {
     if (output_file.size() >= 4 && output_file.substr(output_file.size() - 4) == ".xml") {
-        return parse_xml_output(output_file);
+        return parse_xml_output(output_file, scope);
     }
     
     throw std::runtime_error("Unsupported cppcheck output format. Only XML is supported.");
@@ -455,8 +577,12 @@ std::vector<std::string> CppcheckTool::build_command_line(const AnalysisRequest&
     args.push_back("--platform=" + config_->get_platform_string());
     
     // Performance options
-    if (config_->job_count > 1) {
-        args.push_back("-j" + std::to_string(config_->job_count));
+    size_t job_count = static_cast<size_t>(std::max(config_->job_count, 1));
+    if (request.max_parallel_jobs > 0) {
+        job_count = std::min(job_count, request.max_parallel_jobs);
+    }
+    if (job_count > 1) {
+        args.push_back("-j" + std::to_string(job_count));
     }
     
     // Analysis options
@@ -501,12 +627,80 @@ std::vector<std::string> CppcheckTool::build_command_line(const AnalysisRequest&
         args.push_back("-D" + definition);
     }
     
-    // Source path (must be last)
-    args.push_back(request.source_path);
+    // Exclusions are applied by listing the remaining units instead of
+    // letting cppcheck walk the source path
+    std::vector<std::string> source_files = request.source_files;
+    bool list_units = !source_files.empty() || !request.exclude_patterns.empty();
+    if (source_files.empty() && list_units) {
+        source_files = get_translation_units(request);
+    }
+    
+    // With a compilation database every TU gets its own flags and only the
+    // listed TUs are parsed, instead of every file under the source path
+    std::string build_dir = config_->use_compilation_database
+        ? find_compilation_database_directory(request.source_path) : std::string();
+    if (!build_dir.empty()) {
+        args.push_back("--project=" + (std::filesystem::path(build_dir) / "compile_commands.json").string());
+        if (list_units) {
+            for (const auto& source_file : source_files) {
+                args.push_back("--file-filter=" + source_file);
+            }
+        } else {
+            std::error_code ec;
+            auto source = std::filesystem::weakly_canonical(request.source_path, ec);
+            std::string filter = ec ? request.source_path : source.string();
+            args.push_back("--file-filter=" + filter + (std::filesystem::is_directory(source, ec) ? "/*" : ""));
+        }
+        return args;
+    }
+    
+    // Sources (must be last): the explicit file list when given, otherwise the source path
+    if (list_units) {
+        args.insert(args.end(), source_files.begin(), source_files.end());
+    } else {
+        args.push_back(request.source_path);
+    }
     
     return args;
 }
 
+std::vector<std::string> CppcheckTool::get_translation_units(const AnalysisRequest& request) const {
+    if (config_ && config_->use_compilation_database) {
+        auto units = get_compilation_database_units(request);
+        if (!units.empty()) {
+            return units;
+        }
+    }
+    
+    return AnalysisTool::get_translation_units(request);
+}
+
+std::unique_ptr<CppcheckBuildDirectory> CppcheckTool::open_build_directory(const AnalysisRequest& request) const {
+    if (config_->cache_directory.empty()) {
+        return nullptr;
+    }
+    
+    // Stored analysis only carries over between runs with the same settings and cppcheck
+    std::string config_hash = AnalysisCache::hash_content(
+        AnalysisCache::compute_config_hash(config_.get(), request) + get_version());
+    std::vector<std::string> units = request.source_files.empty() ? get_translation_units(request) : request.source_files;
+    try {
+        return std::make_unique<CppcheckBuildDirectory>(config_->cache_directory, config_hash, units);
+    } catch (const std::filesystem::filesystem_error& e) {
+        LOG_WARNING("CPPCHECK_TOOL", "Running without build directory: ", e.what());
+        return nullptr;
+    }
+}
+
+size_t CppcheckTool::stream_results_file(const std::string& output_file,
+                                         const std::function<void(const AnalysisIssue&)>& issue_callback) const {
+    return CppcheckXmlParser::parse_file(output_file, [this, &issue_callback](const CppcheckXmlError& error) {
+        if (issue_callback) {
+            issue_callback(convert_xml_error(error));
+        }
+    });
+}
+
 std::string CppcheckTool::get_help_text() const {
     return R"(Cppcheck Configuration Options:
 
@@ -526,6 +720,7 @@ Standards:
 Performance:
 - Job Count: Number of parallel analysis threads
 - Quiet: Suppress progress messages
+- Compilation Database: Use compile_commands.json from the build directory for per-file flags
 
 Suppressions:
 - Various options to suppress common false positives
@@ -538,54 +733,27 @@ Libraries:
 // ==================== Private Helper Methods ====================
 
 std::string CppcheckTool::find_cppcheck_executable() const {
-    // Try common locations
-    std::vector<std::string> possible_paths = {
-        "cppcheck",
-        "/usr/bin/cppcheck",
-        "/usr/local/bin/cppcheck",
-        "/opt/cppcheck/bin/cppcheck"
-    };
-    
-    for (const auto& path : possible_paths) {
-        try {
-            wip::utils::process::ProcessExecutor executor;
-            auto result = executor.execute(path, std::vector<std::string>{"--version"});
-            if (result.exit_code == 0) {
-                return path;
-            }
-        } catch (...) {
-            continue;
-        }
-    }
-    
-    return "";
+    return ToolDiscovery::get_shared().probe(get_name(), get_executable_candidates()).executable;
 }
 
 std::string CppcheckTool::get_cppcheck_version() const {
-    std::string executable = get_executable_path();
-    if (executable.empty()) {
+    // The discovery probe already ran --version, and its output is cached with it
+    auto probe = ToolDiscovery::get_shared().probe(get_name(), get_executable_candidates());
+    if (!probe.found()) {
         return "Not available";
     }
     
-    try {
-        wip::utils::process::ProcessExecutor executor;
-        auto result = executor.execute(executable, std::vector<std::string>{"--version"});
-        if (result.exit_code == 0 && !result.stdout_output.empty()) {
-            // Extract version from output like "Cppcheck 2.12.0"
-            std::regex version_regex(R"(Cppcheck\s+(\d+\.\d+(?:\.\d+)?))");
-            std::smatch matches;
-            if (std::regex_search(result.stdout_output, matches, version_regex)) {
-                return matches[1].str();
-            }
-        }
-    } catch (...) {
-        // Ignore errors
+    // Extract version from output like "Cppcheck 2.12.0"
+    std::regex version_regex(R"(Cppcheck\s+(\d+\.\d+(?:\.\d+)?))");
+    std::smatch matches;
+    if (std::regex_search(probe.version_output, matches, version_regex)) {
+        return matches[1].str();
     }
     
     return "Unknown";
 }
 
-AnalysisResult CppcheckTool::parse_xml_output(const std::string& xml_file) const {
+AnalysisResult CppcheckTool::parse_xml_output(const std::string& xml_file, const ChangedLines& scope) const {
     AnalysisResult result;
     result.tool_name = get_name();
     result.analysis_id = "parsed-" + std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -593,56 +761,13 @@ AnalysisResult CppcheckTool::parse_xml_output(const std::string& xml_file) const
     result.timestamp = std::chrono::system_clock::now();
     
     try {
-        std::ifstream file(xml_file);
-        if (!file.is_open()) {
-            throw std::runtime_error("Cannot open XML file: " + xml_file);
-        }
-        
-        // Read entire file
-        std::stringstream buffer;
-        buffer << file.rdbuf();
-        std::string xml_content = buffer.str();
-        
-        // Parse XML content (simplified - in production, use a proper XML parser)
-        // For now, use regex to extract error elements
-        std::regex error_regex(R"(<error\s+[^>]*>)");
-        std::sregex_iterator iter(xml_content.begin(), xml_content.end(), error_regex);
-        std::sregex_iterator end;
-        
-        for (; iter != end; ++iter) {
-            std::string error_tag = iter->str();
-            
-            AnalysisIssue issue;
-            issue.tool_name = get_name();
-            
-            // Extract attributes using regex (simplified)
-            std::regex attr_regex(R"((\w+)=\"([^\"]*)\")");
-            std::sregex_iterator attr_iter(error_tag.begin(), error_tag.end(), attr_regex);
-            std::sregex_iterator attr_end;
-            
-            for (; attr_iter != attr_end; ++attr_iter) {
-                std::string attr_name = (*attr_iter)[1];
-                std::string attr_value = (*attr_iter)[2];
-                
-                if (attr_name == "id") {
-                    issue.rule_id = attr_value;
-                    issue.id = attr_value;
-                } else if (attr_name == "severity") {
-                    issue.severity = map_cppcheck_severity(attr_value);
-                    issue.category = map_cppcheck_category(attr_value, issue.rule_id);
-                } else if (attr_name == "msg") {
-                    issue.message = attr_value;
-                } else if (attr_name == "file") {
-                    issue.file_path = attr_value;
-                } else if (attr_name == "line") {
-                    issue.line_number = std::stoi(attr_value);
-                } else if (attr_name == "column") {
-                    issue.column_number = std::stoi(attr_value);
-                }
+        // Issues outside the changed lines of a diff-scoped run are dropped as they are read
+        stream_results_file(xml_file, [&result, &scope](const AnalysisIssue& issue) {
+            if (scope.empty() || scope.contains(issue)) {
+                result.issues.push_back(issue);
             }
-            
-            result.add_issue(issue);
-        }
+        });
+        result.compute_statistics();
         
         result.success = true;
         
@@ -654,6 +779,20 @@ AnalysisResult CppcheckTool::parse_xml_output(const std::string& xml_file) const
     return result;
 }
 
+AnalysisIssue CppcheckTool::convert_xml_error(const CppcheckXmlError& error) const {
+    AnalysisIssue issue;
+    issue.tool_name = get_name();
+    issue.id = error.id;
+    issue.rule_id = error.id;
+    issue.message = error.message;
+    issue.file_path = error.file_path;
+    issue.line_number = error.line_number;
+    issue.column_number = error.column_number;
+    issue.severity = map_cppcheck_severity(error.severity);
+    issue.category = map_cppcheck_category(error.severity, error.id);
+    return issue;
+}
+
 IssueSeverity CppcheckTool::map_cppcheck_severity(const std::string& severity) const {
     if (severity == "error") return IssueSeverity::Error;
     if (severity == "warning") return IssueSeverity::Warning;
@@ -0,0 +1,351 @@
+#include "tools/cppcheck_xml_parser.h"
+#include <charconv>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+namespace wip {
+namespace analysis {
+namespace tools {
+
+namespace {
+
+constexpr std::string_view COMMENT_OPEN = "!--";
+constexpr std::string_view COMMENT_CLOSE = "-->";
+constexpr std::string_view CDATA_OPEN = "![CDATA[";
+constexpr std::string_view CDATA_CLOSE = "]]>";
+
+bool is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+bool starts_with(std::string_view text, std::string_view prefix) {
+    return text.size() >= prefix.size() && text.compare(0, prefix.size(), prefix) == 0;
+}
+
+int parse_int(std::string_view text) {
+    int value = 0;
+    auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return ec == std::errc() ? value : 0;
+}
+
+void append_utf8(std::string& out, unsigned long code_point) {
+    if (code_point < 0x80) {
+        out += static_cast<char>(code_point);
+    } else if (code_point < 0x800) {
+        out += static_cast<char>(0xC0 | (code_point >> 6));
+        out += static_cast<char>(0x80 | (code_point & 0x3F));
+    } else if (code_point < 0x10000) {
+        out += static_cast<char>(0xE0 | (code_point >> 12));
+        out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (code_point & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (code_point >> 18));
+        out += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (code_point & 0x3F));
+    }
+}
+
+// Calls callback(name, raw_value) for every name="value" pair of a tag body
+template <typename Callback>
+void for_each_attribute(std::string_view attributes, Callback&& callback) {
+    size_t pos = 0;
+    while (pos < attributes.size()) {
+        while (pos < attributes.size() && is_space(attributes[pos])) ++pos;
+
+        size_t name_start = pos;
+        while (pos < attributes.size() && attributes[pos] != '=' && !is_space(attributes[pos])) ++pos;
+        std::string_view name = attributes.substr(name_start, pos - name_start);
+
+        while (pos < attributes.size() && is_space(attributes[pos])) ++pos;
+        if (pos >= attributes.size() || attributes[pos] != '=') {
+            continue;  // Attribute without value
+        }
+        ++pos;
+        while (pos < attributes.size() && is_space(attributes[pos])) ++pos;
+        if (pos >= attributes.size()) {
+            break;
+        }
+
+        char quote = attributes[pos];
+        if (quote != '"' && quote != '\'') {
+            continue;  // Malformed, skip to the next token
+        }
+        size_t value_start = ++pos;
+        size_t value_end = attributes.find(quote, value_start);
+        if (value_end == std::string_view::npos) {
+            break;
+        }
+
+        if (!name.empty()) {
+            callback(name, attributes.substr(value_start, value_end - value_start));
+        }
+        pos = value_end + 1;
+    }
+}
+
+} // namespace
+
+CppcheckXmlParser::CppcheckXmlParser(ErrorCallback callback)
+    : callback_(std::move(callback)) {
+}
+
+void CppcheckXmlParser::feed(std::string_view data) {
+    size_t pos = 0;
+
+    while (pos < data.size()) {
+        switch (state_) {
+            case State::Text: {
+                size_t open = data.find('<', pos);
+                if (open == std::string_view::npos) {
+                    return;
+                }
+                pos = open + 1;
+                state_ = State::Tag;
+                quote_ = 0;
+                tag_buffer_.clear();
+                break;
+            }
+
+            case State::Tag: {
+                // Comments and CDATA sections are recognised from their first bytes,
+                // which may arrive split across chunks
+                if (tag_buffer_.size() < CDATA_OPEN.size() && !tag_buffer_.empty() && tag_buffer_[0] == '!' &&
+                    (starts_with(COMMENT_OPEN, tag_buffer_) || starts_with(CDATA_OPEN, tag_buffer_))) {
+                    tag_buffer_ += data[pos++];
+                    if (tag_buffer_ == COMMENT_OPEN) {
+                        state_ = State::Comment;
+                        tag_buffer_.clear();
+                    } else if (tag_buffer_ == CDATA_OPEN) {
+                        state_ = State::CData;
+                        tag_buffer_.clear();
+                    }
+                    break;
+                }
+
+                size_t next = quote_ ? data.find(quote_, pos) : data.find_first_of("\"'>!", pos);
+                if (next == std::string_view::npos) {
+                    tag_buffer_.append(data.substr(pos));
+                    return;
+                }
+
+                char c = data[next];
+                tag_buffer_.append(data.substr(pos, next - pos));
+                pos = next + 1;
+
+                if (quote_) {
+                    tag_buffer_ += c;
+                    quote_ = 0;
+                } else if (c == '"' || c == '\'') {
+                    tag_buffer_ += c;
+                    quote_ = c;
+                } else if (c == '!') {
+                    tag_buffer_ += c;
+                } else {
+                    handle_tag(tag_buffer_);
+                    tag_buffer_.clear();
+                    state_ = State::Text;
+                }
+                break;
+            }
+
+            case State::Comment:
+            case State::CData: {
+                // Only the last bytes are kept so the terminator can span chunks
+                std::string_view terminator = state_ == State::Comment ? COMMENT_CLOSE : CDATA_CLOSE;
+                char c = data[pos++];
+                tag_buffer_ += c;
+                if (tag_buffer_.size() > terminator.size()) {
+                    tag_buffer_.erase(0, tag_buffer_.size() - terminator.size());
+                }
+                if (tag_buffer_ == terminator) {
+                    tag_buffer_.clear();
+                    state_ = State::Text;
+                }
+                break;
+            }
+        }
+    }
+}
+
+void CppcheckXmlParser::finish() {
+    if (in_error_) {
+        end_error();
+    }
+
+    state_ = State::Text;
+    quote_ = 0;
+    tag_buffer_.clear();
+}
+
+size_t CppcheckXmlParser::parse_stream(std::istream& input, ErrorCallback callback, size_t chunk_size) {
+    CppcheckXmlParser parser(std::move(callback));
+    std::vector<char> buffer(chunk_size > 0 ? chunk_size : DEFAULT_CHUNK_SIZE);
+
+    while (input.read(buffer.data(), static_cast<std::streamsize>(buffer.size())) || input.gcount() > 0) {
+        parser.feed(std::string_view(buffer.data(), static_cast<size_t>(input.gcount())));
+    }
+    parser.finish();
+
+    return parser.get_error_count();
+}
+
+size_t CppcheckXmlParser::parse_file(const std::string& file_path, ErrorCallback callback, size_t chunk_size) {
+    std::ifstream file(file_path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open XML file: " + file_path);
+    }
+
+    return parse_stream(file, std::move(callback), chunk_size);
+}
+
+std::string CppcheckXmlParser::decode_entities(std::string_view text) {
+    if (text.find('&') == std::string_view::npos) {
+        return std::string(text);
+    }
+
+    std::string decoded;
+    decoded.reserve(text.size());
+
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t amp = text.find('&', pos);
+        if (amp == std::string_view::npos) {
+            decoded.append(text.substr(pos));
+            break;
+        }
+        decoded.append(text.substr(pos, amp - pos));
+
+        size_t semicolon = text.find(';', amp);
+        if (semicolon == std::string_view::npos) {
+            decoded.append(text.substr(amp));
+            break;
+        }
+
+        std::string_view entity = text.substr(amp + 1, semicolon - amp - 1);
+        if (entity == "lt") {
+            decoded += '<';
+        } else if (entity == "gt") {
+            decoded += '>';
+        } else if (entity == "amp") {
+            decoded += '&';
+        } else if (entity == "quot") {
+            decoded += '"';
+        } else if (entity == "apos") {
+            decoded += '\'';
+        } else if (entity.size() > 1 && entity[0] == '#') {
+            bool hex = entity[1] == 'x' || entity[1] == 'X';
+            std::string_view digits = entity.substr(hex ? 2 : 1);
+            unsigned long code_point = 0;
+            auto [ptr, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), code_point, hex ? 16 : 10);
+            if (ec == std::errc() && ptr == digits.data() + digits.size() && !digits.empty()) {
+                append_utf8(decoded, code_point);
+            } else {
+                decoded.append(text.substr(amp, semicolon - amp + 1));
+            }
+        } else {
+            decoded.append(text.substr(amp, semicolon - amp + 1));
+        }
+
+        pos = semicolon + 1;
+    }
+
+    return decoded;
+}
+
+// ==================== Private Helper Methods ====================
+
+void CppcheckXmlParser::handle_tag(std::string_view tag) {
+    if (tag.empty() || tag[0] == '?' || tag[0] == '!') {
+        return;  // Declarations and processing instructions
+    }
+
+    if (tag[0] == '/') {
+        std::string_view name = tag.substr(1);
+        while (!name.empty() && is_space(name.back())) name.remove_suffix(1);
+        if (name == "error" && in_error_) {
+            end_error();
+        }
+        return;
+    }
+
+    bool self_closing = tag.back() == '/';
+    if (self_closing) {
+        tag.remove_suffix(1);
+    }
+
+    size_t name_end = 0;
+    while (name_end < tag.size() && !is_space(tag[name_end])) ++name_end;
+    std::string_view name = tag.substr(0, name_end);
+    std::string_view attributes = tag.substr(name_end);
+
+    if (name == "error") {
+        if (in_error_) {
+            end_error();  // Unclosed previous element
+        }
+        begin_error(attributes);
+        if (self_closing) {
+            end_error();
+        }
+    } else if (name == "location" && in_error_) {
+        apply_location(attributes);
+    }
+}
+
+void CppcheckXmlParser::begin_error(std::string_view attributes) {
+    current_error_ = CppcheckXmlError{};
+    in_error_ = true;
+    has_location_ = false;
+
+    for_each_attribute(attributes, [this](std::string_view name, std::string_view value) {
+        if (name == "id") {
+            current_error_.id = decode_entities(value);
+        } else if (name == "severity") {
+            current_error_.severity = decode_entities(value);
+        } else if (name == "msg") {
+            current_error_.message = decode_entities(value);
+        } else if (name == "verbose") {
+            current_error_.verbose_message = decode_entities(value);
+        } else if (name == "cwe") {
+            current_error_.cwe = decode_entities(value);
+        } else if (name == "file") {
+            current_error_.file_path = decode_entities(value);
+        } else if (name == "line") {
+            current_error_.line_number = parse_int(value);
+        } else if (name == "column") {
+            current_error_.column_number = parse_int(value);
+        }
+    });
+}
+
+void CppcheckXmlParser::apply_location(std::string_view attributes) {
+    // The first location is the primary one; later ones are related notes
+    if (has_location_) {
+        return;
+    }
+    has_location_ = true;
+
+    for_each_attribute(attributes, [this](std::string_view name, std::string_view value) {
+        if (name == "file") {
+            current_error_.file_path = decode_entities(value);
+        } else if (name == "line") {
+            current_error_.line_number = parse_int(value);
+        } else if (name == "column") {
+            current_error_.column_number = parse_int(value);
+        }
+    });
+}
+
+void CppcheckXmlParser::end_error() {
+    in_error_ = false;
+    ++error_count_;
+
+    if (callback_) {
+        callback_(current_error_);
+    }
+}
+
+} // namespace tools
+} // namespace analysis
+} // namespace wip
@@ -0,0 +1,330 @@
+#include <gtest/gtest.h>
+#include "analysis_cache.h"
+#include "analysis_engine.h"
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace wip::analysis;
+
+namespace {
+
+// Reports one issue per analyzed translation unit and records what it was asked to analyze
+class FileCountingTool : public AnalysisTool {
+public:
+    std::mutex runs_mutex;
+    std::vector<std::vector<std::string>> runs;
+    std::string version = "1.0.0";
+
+    size_t get_analyzed_file_count() {
+        std::lock_guard<std::mutex> lock(runs_mutex);
+        size_t count = 0;
+        for (const auto& run : runs) {
+            count += run.size();
+        }
+        return count;
+    }
+
+    std::string get_name() const override { return "counting-tool"; }
+    std::string get_version() const override { return version; }
+    std::vector<std::string> get_supported_extensions() const override { return {".cpp", ".h"}; }
+    std::string get_description() const override { return "Counting tool"; }
+
+    void set_configuration(std::unique_ptr<ToolConfig> config) override {}
+    const ToolConfig* get_configuration() const override { return nullptr; }
+    std::unique_ptr<ToolConfig> create_default_config() const override { return nullptr; }
+    ValidationResult validate_configuration() const override { return ValidationResult{}; }
+
+    bool is_available() const override { return true; }
+    std::string get_executable_path() const override { return "/usr/bin/counting-tool"; }
+    std::string get_system_requirements() const override { return ""; }
+
+    AnalysisResult execute(const AnalysisRequest& request) override {
+        auto units = get_translation_units(request);
+        {
+            std::lock_guard<std::mutex> lock(runs_mutex);
+            runs.push_back(units);
+        }
+
+        AnalysisResult result;
+        result.tool_name = get_name();
+        result.success = true;
+        result.files_analyzed = units.size();
+        for (const auto& unit : units) {
+            AnalysisIssue issue;
+            issue.file_path = unit;
+            issue.line_number = 1;
+            issue.rule_id = "counting-rule";
+            issue.message = "Issue in " + unit;
+            result.issues.push_back(issue);
+        }
+        return result;
+    }
+
+    wip::utils::concurrency::Task<AnalysisResult> execute_async(
+        const AnalysisRequest& request,
+        std::function<void(const AnalysisProgress&)> progress_callback,
+        std::function<void(const std::string&)> output_callback = nullptr) override {
+        return wip::utils::concurrency::make_ready_task(execute(request));
+    }
+
+    bool cancel_analysis() override { return false; }
+    bool is_analysis_running() const override { return false; }
+
+    AnalysisResult parse_results_file(const std::string& output_file) override { return AnalysisResult{}; }
+    std::vector<std::string> get_supported_output_formats() const override { return {}; }
+    std::vector<std::string> build_command_line(const AnalysisRequest& request) const override { return {}; }
+    std::string get_help_text() const override { return ""; }
+};
+
+} // namespace
+
+class AnalysisCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        project_dir_ = std::filesystem::temp_directory_path() / "wip_analysis_cache_test";
+        std::filesystem::remove_all(project_dir_);
+        std::filesystem::create_directories(project_dir_ / "src");
+        std::filesystem::create_directories(project_dir_ / "include");
+
+        write_file("include/shared.h", "#pragma once\nint shared();\n");
+        write_file("src/a.cpp", "#include \"shared.h\"\nint a() { return shared(); }\n");
+        write_file("src/b.cpp", "#include <shared.h>\nint b() { return 2; }\n");
+        write_file("src/c.cpp", "#include <vector>\nint c() { return 3; }\n");
+
+        request_.source_path = (project_dir_ / "src").string();
+        request_.include_paths = {(project_dir_ / "include").string()};
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(project_dir_);
+    }
+
+    void write_file(const std::string& relative_path, const std::string& contents) {
+        std::ofstream file(project_dir_ / relative_path, std::ios::binary);
+        file << contents;
+    }
+
+    std::string path(const std::string& relative_path) const {
+        return (project_dir_ / relative_path).lexically_normal().string();
+    }
+
+    std::vector<std::string> units() const {
+        return {path("src/a.cpp"), path("src/b.cpp"), path("src/c.cpp")};
+    }
+
+    // Runs a fake analysis of the changed units and stores it
+    AnalysisCache::Plan run(AnalysisCache& cache, const std::string& config_hash = "config") {
+        auto plan = cache.plan("tool", "1.0", config_hash, units(), request_);
+        std::vector<AnalysisIssue> issues;
+        for (const auto& unit : plan.changed_units) {
+            AnalysisIssue issue;
+            issue.file_path = unit;
+            issue.line_number = 1;
+            issue.rule_id = "rule";
+            issues.push_back(issue);
+        }
+        AnalysisIssue header_issue;
+        header_issue.file_path = path("include/shared.h");
+        header_issue.line_number = 2;
+        header_issue.rule_id = "header-rule";
+        issues.push_back(header_issue);
+
+        cache.update("tool", "1.0", config_hash, plan, issues);
+        return plan;
+    }
+
+    std::filesystem::path project_dir_;
+    AnalysisRequest request_;
+};
+
+TEST_F(AnalysisCacheTest, HashContent) {
+    EXPECT_EQ(AnalysisCache::hash_content(""), "2ff5161c5cc566ff68013efac61967ef");
+    EXPECT_EQ(AnalysisCache::hash_content("hello world"), "4b041b0e7a1a975403f2ec52c18de292");
+    EXPECT_NE(AnalysisCache::hash_content("abc"), AnalysisCache::hash_content("abd"));
+}
+
+TEST_F(AnalysisCacheTest, ConfigHashIgnoresPaths) {
+    AnalysisRequest other = request_;
+    other.source_path = "/somewhere/else";
+    other.output_file = "out.xml";
+    other.source_files = {"x.cpp"};
+    EXPECT_EQ(AnalysisCache::compute_config_hash(nullptr, request_), AnalysisCache::compute_config_hash(nullptr, other));
+
+    other.definitions = {"NDEBUG"};
+    EXPECT_NE(AnalysisCache::compute_config_hash(nullptr, request_), AnalysisCache::compute_config_hash(nullptr, other));
+}
+
+TEST_F(AnalysisCacheTest, EmptyCacheAnalyzesEverything) {
+    AnalysisCache cache;
+    auto plan = cache.plan("tool", "1.0", "config", units(), request_);
+
+    EXPECT_EQ(plan.changed_units.size(), 3);
+    EXPECT_EQ(plan.cached_unit_count, 0);
+    EXPECT_TRUE(plan.cached_issues.empty());
+}
+
+TEST_F(AnalysisCacheTest, UnchangedUnitsComeFromCache) {
+    AnalysisCache cache;
+    run(cache);
+
+    auto plan = cache.plan("tool", "1.0", "config", units(), request_);
+    EXPECT_TRUE(plan.changed_units.empty());
+    EXPECT_EQ(plan.cached_unit_count, 3);
+    // One issue per unit plus the header issue for both units including the header
+    EXPECT_EQ(plan.cached_issues.size(), 5);
+    EXPECT_EQ(cache.get_entry_count(), 3);
+}
+
+TEST_F(AnalysisCacheTest, ChangedUnitIsAnalyzedAgain) {
+    AnalysisCache cache;
+    run(cache);
+
+    write_file("src/c.cpp", "int c() { return 33; }\n");
+    auto plan = cache.plan("tool", "1.0", "config", units(), request_);
+
+    ASSERT_EQ(plan.changed_units.size(), 1);
+    EXPECT_EQ(plan.changed_units[0], path("src/c.cpp"));
+}
+
+TEST_F(AnalysisCacheTest, ChangedHeaderInvalidatesIncludingUnits) {
+    AnalysisCache cache;
+    run(cache);
+
+    write_file("include/shared.h", "#pragma once\nint shared(int);\n");
+    auto plan = cache.plan("tool", "1.0", "config", units(), request_);
+
+    ASSERT_EQ(plan.changed_units.size(), 2);
+    EXPECT_EQ(plan.changed_units[0], path("src/a.cpp"));
+    EXPECT_EQ(plan.changed_units[1], path("src/b.cpp"));
+}
+
+TEST_F(AnalysisCacheTest, VersionOrConfigChangeInvalidatesEverything) {
+    AnalysisCache cache;
+    run(cache);
+
+    EXPECT_EQ(cache.plan("tool", "2.0", "config", units(), request_).changed_units.size(), 3);
+    EXPECT_EQ(cache.plan("tool", "1.0", "other-config", units(), request_).changed_units.size(), 3);
+    EXPECT_EQ(cache.plan("other-tool", "1.0", "config", units(), request_).changed_units.size(), 3);
+}
+
+TEST_F(AnalysisCacheTest, RemovedUnitsAreDropped) {
+    AnalysisCache cache;
+    run(cache);
+
+    auto plan = cache.plan("tool", "1.0", "config", {path("src/a.cpp")}, request_);
+    cache.update("tool", "1.0", "config", plan, {});
+
+    EXPECT_EQ(cache.get_entry_count(), 1);
+}
+
+TEST_F(AnalysisCacheTest, SaveAndLoad) {
+    std::string cache_file = (project_dir_ / ".cache" / "analysis_cache.json").string();
+    {
+        AnalysisCache cache(cache_file);
+        run(cache);
+        EXPECT_TRUE(cache.save());
+    }
+
+    AnalysisCache loaded(cache_file);
+    ASSERT_TRUE(loaded.load());
+    EXPECT_EQ(loaded.get_entry_count(), 3);
+
+    auto plan = loaded.plan("tool", "1.0", "config", units(), request_);
+    EXPECT_TRUE(plan.changed_units.empty());
+    EXPECT_EQ(plan.cached_issues.size(), 5);
+}
+
+TEST_F(AnalysisCacheTest, UnitCostsArePersisted) {
+    auto cache_file = (project_dir_ / "cache.json").string();
+    {
+        AnalysisCache cache(cache_file);
+        auto plan = cache.plan("tool", "1.0", "config", units(), request_);
+        EXPECT_TRUE(plan.unit_costs.empty());
+
+        plan.unit_costs[path("src/a.cpp")] = 1500.0;
+        cache.update("tool", "1.0", "config", plan, {});
+        ASSERT_TRUE(cache.save());
+    }
+
+    AnalysisCache cache(cache_file);
+    ASSERT_TRUE(cache.load());
+
+    // The previous cost is still known after the unit changed
+    write_file("src/a.cpp", "int a() { return 11; }\n");
+    auto plan = cache.plan("tool", "1.0", "config", units(), request_);
+    ASSERT_EQ(plan.unit_costs.size(), 1);
+    EXPECT_DOUBLE_EQ(plan.unit_costs[path("src/a.cpp")], 1500.0);
+}
+
+TEST_F(AnalysisCacheTest, CorruptFileLoadsEmpty) {
+    std::string cache_file = (project_dir_ / "analysis_cache.json").string();
+    write_file("analysis_cache.json", "{ not json");
+
+    AnalysisCache cache(cache_file);
+    EXPECT_FALSE(cache.load());
+    EXPECT_EQ(cache.get_entry_count(), 0);
+}
+
+TEST_F(AnalysisCacheTest, EngineOnlyAnalyzesChangedUnits) {
+    AnalysisEngine engine;
+    auto tool = std::make_unique<FileCountingTool>();
+    auto* tool_ptr = tool.get();
+    engine.register_tool(std::move(tool));
+    engine.set_cache(std::make_shared<AnalysisCache>());
+
+    auto first = engine.analyze_single("counting-tool", request_);
+    EXPECT_EQ(first.issues.size(), 3);
+    EXPECT_EQ(first.files_analyzed, 3);
+
+    auto second = engine.analyze_single("counting-tool", request_);
+    EXPECT_EQ(second.issues.size(), 3);
+    EXPECT_EQ(second.files_analyzed, 3);
+    ASSERT_EQ(tool_ptr->runs.size(), 1);
+
+    write_file("src/b.cpp", "int b() { return 22; }\n");
+    auto results = engine.analyze_multiple({"counting-tool"}, request_);
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_EQ(results[0].issues.size(), 3);
+    ASSERT_EQ(tool_ptr->runs.size(), 2);
+    ASSERT_EQ(tool_ptr->runs[1].size(), 1);
+    EXPECT_EQ(tool_ptr->runs[1][0], path("src/b.cpp"));
+
+    // Bumping the tool version invalidates the cache
+    tool_ptr->version = "2.0.0";
+    auto async_results = engine.analyze_async({"counting-tool"}, request_).get();
+    ASSERT_EQ(async_results.size(), 1);
+    EXPECT_EQ(async_results[0].issues.size(), 3);
+    EXPECT_EQ(tool_ptr->get_analyzed_file_count(), 7);
+}
+
+TEST_F(AnalysisCacheTest, EngineStreamsCachedIssuesFirst) {
+    AnalysisEngine engine;
+    auto tool = std::make_unique<FileCountingTool>();
+    auto* tool_ptr = tool.get();
+    engine.register_tool(std::move(tool));
+    engine.set_cache(std::make_shared<AnalysisCache>());
+    engine.analyze_single("counting-tool", request_);
+
+    write_file("src/c.cpp", "int c() { return 33; }\n");
+
+    std::vector<std::vector<AnalysisIssue>> batches;
+    std::mutex batches_mutex;
+    auto issue_callback = [&](const std::string&, const std::vector<AnalysisIssue>& issues) {
+        std::lock_guard<std::mutex> lock(batches_mutex);
+        batches.push_back(issues);
+    };
+    auto results = engine.analyze_async({"counting-tool"}, request_, nullptr, nullptr, nullptr, issue_callback).get();
+
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_EQ(results[0].issues.size(), 3);
+    EXPECT_EQ(tool_ptr->get_analyzed_file_count(), 4);
+
+    // The two cached units arrive before the re-analyzed one
+    ASSERT_EQ(batches.size(), 2);
+    EXPECT_EQ(batches[0].size(), 2);
+    ASSERT_EQ(batches[1].size(), 1);
+    EXPECT_EQ(batches[1][0].file_path, path("src/c.cpp"));
+}
@@ -2,11 +2,18 @@
 #include "analysis_engine.h"
 #include "analysis_types.h"
 #include "tool_config.h"
+#include "analysis_cache.h"
 #include <memory>
 #include <vector>
 #include <future>
 #include <chrono>
 #include <thread>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <algorithm>
+#include <atomic>
+#include <map>
 
 using namespace wip::analysis;
 
@@ -85,12 +92,12 @@ public:
         return result;
     }
     
-    std::future<AnalysisResult> execute_async(
+    wip::utils::concurrency::Task<AnalysisResult> execute_async(
         const AnalysisRequest& request,
         std::function<void(const AnalysisProgress&)> progress_callback,
         std::function<void(const std::string&)> output_callback = nullptr) override {
         
-        return std::async(std::launch::async, [this, request, progress_callback]() {
+        return wip::utils::concurrency::async([this, request, progress_callback]() {
             running_ = true;
             
             // Send progress updates
@@ -151,6 +158,82 @@ public:
     }
 };
 
+// Runs a long process that only stops when the request is cancelled
+class SleepingToolForEngine : public MockAnalysisToolForEngine {
+public:
+    SleepingToolForEngine() : MockAnalysisToolForEngine("sleeping-tool") {}
+    
+    AnalysisResult execute(const AnalysisRequest& request) override {
+        auto config = wip::utils::process::ProcessConfig::from_command_args("sleep", {"30"});
+        config.cancellation = request.cancellation;
+        config.own_process_group = true;
+        auto process_result = wip::utils::process::ProcessExecutor().execute(config);
+        
+        AnalysisResult result;
+        result.tool_name = get_name();
+        result.success = process_result.success();
+        result.error_message = process_result.cancelled ? "cancelled" : "";
+        return result;
+    }
+};
+
+// Records the files of every call
+class RecordingToolForEngine : public MockAnalysisToolForEngine {
+public:
+    RecordingToolForEngine() : MockAnalysisToolForEngine("recording-tool") {}
+    
+    AnalysisResult execute(const AnalysisRequest& request) override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            calls_.push_back(request.source_files);
+        }
+        return MockAnalysisToolForEngine::execute(request);
+    }
+    
+    std::vector<std::vector<std::string>> get_calls() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return calls_;
+    }
+    
+private:
+    std::mutex mutex_;
+    std::vector<std::vector<std::string>> calls_;
+};
+
+// Reports an error in every file named bad*; shards without one sleep until cancelled, if asked to
+class OffendingToolForEngine : public RecordingToolForEngine {
+public:
+    explicit OffendingToolForEngine(bool sleep_when_clean) : sleep_when_clean_(sleep_when_clean) {}
+    
+    AnalysisResult execute(const AnalysisRequest& request) override {
+        RecordingToolForEngine::execute(request);
+        AnalysisResult result;
+        result.tool_name = get_name();
+        result.success = true;
+        for (const auto& file : request.source_files) {
+            if (std::filesystem::path(file).filename().string().rfind("bad", 0) == 0) {
+                AnalysisIssue issue;
+                issue.file_path = file;
+                issue.line_number = 1;
+                issue.severity = IssueSeverity::Error;
+                issue.rule_id = "offence";
+                result.issues.push_back(issue);
+            }
+        }
+        if (result.issues.empty() && sleep_when_clean_) {
+            auto config = wip::utils::process::ProcessConfig::from_command_args("sleep", {"30"});
+            config.cancellation = request.cancellation;
+            auto process_result = wip::utils::process::ProcessExecutor().execute(config);
+            result.success = process_result.success();
+            result.error_message = process_result.cancelled ? "cancelled" : "";
+        }
+        return result;
+    }
+    
+private:
+    bool sleep_when_clean_;
+};
+
 class AnalysisEngineTest : public ::testing::Test {
 protected:
     void SetUp() override {
@@ -376,6 +459,94 @@ TEST_F(AnalysisEngineTest, AsyncAnalysisWithoutCallbacks) {
     EXPECT_TRUE(results[0].success);
 }
 
+TEST_F(AnalysisEngineTest, ConcurrencyBudget) {
+    EXPECT_GE(engine_->get_concurrency(), 1);
+    
+    engine_->set_concurrency(3);
+    EXPECT_EQ(engine_->get_concurrency(), 3);
+    
+    // Without an explicit budget the governor leaves room for other load on the machine
+    engine_->set_concurrency(0);
+    EXPECT_GE(engine_->get_concurrency(), 1);
+    EXPECT_LE(engine_->get_concurrency(), std::max(1u, std::thread::hardware_concurrency()));
+}
+
+TEST_F(AnalysisEngineTest, AsyncAnalysisSchedulesFileShards) {
+    auto source_dir = std::filesystem::temp_directory_path() / "wip_engine_scheduler_test";
+    std::filesystem::remove_all(source_dir);
+    std::filesystem::create_directories(source_dir);
+    for (int i = 0; i < 8; ++i) {
+        std::ofstream(source_dir / ("file" + std::to_string(i) + ".cpp")) << "int f" << i << "();\n";
+    }
+    
+    AnalysisRequest request;
+    request.source_path = source_dir.string();
+    
+    std::mutex progress_mutex;
+    std::vector<AnalysisProgress> progress_updates;
+    auto progress_callback = [&](const std::string& tool_name, const AnalysisProgress& progress) {
+        std::lock_guard<std::mutex> lock(progress_mutex);
+        progress_updates.push_back(progress);
+    };
+    
+    engine_->set_concurrency(2);
+    auto results = engine_->analyze_async({"tool1", "tool2"}, request, progress_callback).get();
+    std::filesystem::remove_all(source_dir);
+    
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_EQ(results[0].tool_name, "tool1");
+    EXPECT_EQ(results[1].tool_name, "tool2");
+    EXPECT_TRUE(results[0].success);
+    
+    // Every shard reports the same mock issues, which are merged into one set per tool
+    EXPECT_EQ(results[0].issues.size(), 2);
+    EXPECT_EQ(results[1].issues.size(), 1);
+    
+    // One update per job, the last one reporting every job as done
+    ASSERT_FALSE(progress_updates.empty());
+    size_t total_jobs = progress_updates.front().total_jobs;
+    EXPECT_GT(total_jobs, 2);
+    EXPECT_EQ(progress_updates.size(), total_jobs);
+    EXPECT_EQ(progress_updates.back().completed_jobs, total_jobs);
+}
+
+TEST_F(AnalysisEngineTest, AsyncAnalysisStreamsIssues) {
+    auto source_dir = std::filesystem::temp_directory_path() / "wip_engine_stream_test";
+    std::filesystem::remove_all(source_dir);
+    std::filesystem::create_directories(source_dir);
+    for (int i = 0; i < 8; ++i) {
+        std::ofstream(source_dir / ("file" + std::to_string(i) + ".cpp")) << "int f" << i << "();\n";
+    }
+    
+    AnalysisRequest request;
+    request.source_path = source_dir.string();
+    
+    std::mutex issues_mutex;
+    std::map<std::string, std::vector<AnalysisIssue>> streamed;
+    bool completed_before_stream = false;
+    std::atomic<bool> completed{false};
+    auto completion_callback = [&](const std::vector<AnalysisResult>&) { completed = true; };
+    auto issue_callback = [&](const std::string& tool_name, const std::vector<AnalysisIssue>& issues) {
+        std::lock_guard<std::mutex> lock(issues_mutex);
+        completed_before_stream = completed_before_stream || completed;
+        EXPECT_FALSE(issues.empty());
+        auto& tool_issues = streamed[tool_name];
+        tool_issues.insert(tool_issues.end(), issues.begin(), issues.end());
+    };
+    
+    engine_->set_concurrency(2);
+    auto results = engine_->analyze_async({"tool1", "tool2"}, request, nullptr, nullptr,
+                                          completion_callback, issue_callback).get();
+    std::filesystem::remove_all(source_dir);
+    
+    // Every shard reports the same issues but each one is streamed only once
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_FALSE(completed_before_stream);
+    ASSERT_EQ(streamed.size(), 2);
+    EXPECT_EQ(streamed["tool1"].size(), results[0].issues.size());
+    EXPECT_EQ(streamed["tool2"].size(), results[1].issues.size());
+}
+
 // Test analysis state management
 TEST_F(AnalysisEngineTest, AnalysisStateManagement) {
     EXPECT_FALSE(engine_->is_analysis_running());
@@ -441,6 +612,170 @@ TEST_F(AnalysisEngineTest, ResultAggregation) {
     EXPECT_EQ(aggregated.issues.size(), 2);
 }
 
+TEST_F(AnalysisEngineTest, ResultAggregationDeduplicatesInOrder) {
+    auto make_issue = [](const std::string& file, int line, const std::string& rule, const std::string& tool) {
+        AnalysisIssue issue;
+        issue.file_path = file;
+        issue.line_number = line;
+        issue.rule_id = rule;
+        issue.tool_name = tool;
+        return issue;
+    };
+    
+    AnalysisResult result1;
+    result1.tool_name = "tool1";
+    result1.success = true;
+    result1.issues = {make_issue("b.cpp", 1, "r1", "tool1"),
+                      make_issue("a.cpp", 2, "r2", "tool1"),
+                      make_issue("b.cpp", 1, "r1", "tool1")};
+    
+    AnalysisResult result2;
+    result2.tool_name = "tool2";
+    result2.success = true;
+    result2.issues = {make_issue("a.cpp", 2, "r2", "tool2"),
+                      make_issue("a.cpp", 2, "r3", "tool2"),
+                      make_issue("c.cpp", 7, "r1", "tool2")};
+    
+    auto aggregated = engine_->aggregate_results({result1, result2});
+    
+    ASSERT_EQ(aggregated.issues.size(), 4u);
+    EXPECT_EQ(aggregated.issues[0].file_path, "b.cpp");
+    EXPECT_EQ(aggregated.issues[1].file_path, "a.cpp");
+    EXPECT_EQ(aggregated.issues[1].tool_name, "tool1");  // First report wins
+    EXPECT_EQ(aggregated.issues[2].rule_id, "r3");
+    EXPECT_EQ(aggregated.issues[3].file_path, "c.cpp");
+}
+
+TEST_F(AnalysisEngineTest, ResultAggregationScalesLinearly) {
+    AnalysisResult result;
+    result.tool_name = "tool1";
+    result.success = true;
+    
+    // 100k issues, every issue reported twice
+    for (int copy = 0; copy < 2; ++copy) {
+        for (int i = 0; i < 50000; ++i) {
+            AnalysisIssue issue;
+            issue.file_path = "file" + std::to_string(i % 500) + ".cpp";
+            issue.line_number = i;
+            issue.rule_id = "rule";
+            result.issues.push_back(issue);
+        }
+    }
+    
+    auto aggregated = engine_->aggregate_results({result});
+    EXPECT_EQ(aggregated.issues.size(), 50000u);
+}
+
+TEST_F(AnalysisEngineTest, CompareResults) {
+    auto make_result = [](const std::vector<std::pair<std::string, int>>& locations) {
+        AnalysisResult result;
+        result.tool_name = "tool1";
+        result.success = true;
+        for (const auto& [file, line] : locations) {
+            AnalysisIssue issue;
+            issue.file_path = file;
+            issue.line_number = line;
+            issue.rule_id = "rule";
+            issue.severity = IssueSeverity::Warning;
+            result.issues.push_back(issue);
+        }
+        return result;
+    };
+    
+    auto baseline = make_result({{"a.cpp", 1}, {"b.cpp", 2}, {"c.cpp", 3}});
+    auto current = make_result({{"d.cpp", 4}, {"b.cpp", 2}, {"c.cpp", 3}, {"e.cpp", 5}});
+    
+    auto report = engine_->compare_results({baseline}, {current});
+    
+    EXPECT_EQ(report.issue_count_delta, 1);
+    ASSERT_EQ(report.new_issues.size(), 2u);
+    EXPECT_EQ(report.new_issues[0].file_path, "d.cpp");
+    EXPECT_EQ(report.new_issues[1].file_path, "e.cpp");
+    ASSERT_EQ(report.resolved_issues.size(), 1u);
+    EXPECT_EQ(report.resolved_issues[0].file_path, "a.cpp");
+    ASSERT_EQ(report.persistent_issues.size(), 2u);
+    EXPECT_EQ(report.persistent_issues[0].file_path, "b.cpp");
+    EXPECT_EQ(report.severity_deltas[IssueSeverity::Warning], 1);
+}
+
+TEST_F(AnalysisEngineTest, CompareResultsMatchesLineDrift) {
+    auto make_issue = [](const std::string& file, int line, const std::string& rule, const std::string& message) {
+        AnalysisIssue issue;
+        issue.file_path = file;
+        issue.line_number = line;
+        issue.rule_id = rule;
+        issue.message = message;
+        return issue;
+    };
+    
+    AnalysisResult baseline;
+    baseline.issues = {make_issue("a.cpp", 10, "unused", "x is unused"),
+                       make_issue("a.cpp", 20, "unused", "y is unused"),
+                       make_issue("a.cpp", 30, "null", "p may be null"),
+                       make_issue("b.cpp", 5, "unused", "z is unused")};
+    
+    // Three lines inserted at the top of a.cpp; the null check was fixed and a new one appeared
+    AnalysisResult current;
+    current.issues = {make_issue("a.cpp", 13, "unused", "x is unused"),
+                      make_issue("a.cpp", 23, "unused", "y is unused"),
+                      make_issue("a.cpp", 40, "null", "q may be null"),
+                      make_issue("b.cpp", 5, "unused", "z is unused")};
+    
+    auto report = engine_->compare_results({baseline}, {current});
+    EXPECT_EQ(report.persistent_issues.size(), 3u);
+    EXPECT_EQ(report.moved_issue_count, 2u);
+    ASSERT_EQ(report.new_issues.size(), 1u);
+    EXPECT_EQ(report.new_issues[0].message, "q may be null");
+    ASSERT_EQ(report.resolved_issues.size(), 1u);
+    EXPECT_EQ(report.resolved_issues[0].message, "p may be null");
+    
+    AnalysisEngine::ComparisonOptions limited;
+    limited.max_line_drift = 2;
+    report = engine_->compare_results({baseline}, {current}, limited);
+    EXPECT_EQ(report.moved_issue_count, 0u);
+    EXPECT_EQ(report.new_issues.size(), 3u);
+    
+    AnalysisEngine::ComparisonOptions exact;
+    exact.match_line_drift = false;
+    report = engine_->compare_results({baseline}, {current}, exact);
+    EXPECT_EQ(report.persistent_issues.size(), 1u);
+    EXPECT_EQ(report.resolved_issues.size(), 3u);
+}
+
+TEST_F(AnalysisEngineTest, CompareResultsLargeRuns) {
+    // 200k issues per side; every other issue moved by one line, one in ten moved and changed
+    AnalysisResult baseline;
+    AnalysisResult current;
+    for (int i = 0; i < 200000; ++i) {
+        AnalysisIssue issue;
+        issue.file_path = "file" + std::to_string(i % 1000) + ".cpp";
+        issue.line_number = i;
+        issue.rule_id = "rule" + std::to_string(i % 20);
+        issue.message = "message " + std::to_string(i);
+        baseline.issues.push_back(issue);
+        
+        issue.line_number += i % 2;
+        if (i % 10 == 1) {
+            issue.message = "changed " + std::to_string(i);
+        }
+        current.issues.push_back(issue);
+    }
+    baseline.issues.push_back(baseline.issues.front());  // Duplicates are ignored
+    
+    engine_->set_concurrency(4);
+    auto report = engine_->compare_results({baseline}, {current});
+    
+    EXPECT_EQ(report.issue_count_delta, 0);
+    EXPECT_EQ(report.new_issues.size(), 20000u);
+    EXPECT_EQ(report.resolved_issues.size(), 20000u);
+    EXPECT_EQ(report.persistent_issues.size(), 180000u);
+    EXPECT_EQ(report.moved_issue_count, 80000u);
+    
+    // Output keeps run order
+    EXPECT_TRUE(std::is_sorted(report.new_issues.begin(), report.new_issues.end(),
+                               [](const AnalysisIssue& a, const AnalysisIssue& b) { return a.line_number < b.line_number; }));
+}
+
 // Test edge cases
 TEST_F(AnalysisEngineTest, EmptyToolList) {
     AnalysisRequest request;
@@ -457,4 +792,237 @@ TEST_F(AnalysisEngineTest, DuplicateToolNames) {
     auto results = engine_->analyze_multiple({"tool1", "tool1"}, request);
     // Implementation may vary - could deduplicate or run twice
     EXPECT_FALSE(results.empty());
-}
\ No newline at end of file
+}
+TEST_F(AnalysisEngineTest, CancelStopsRunningToolProcesses) {
+    engine_->register_tool(std::make_unique<SleepingToolForEngine>());
+    AnalysisRequest request;
+    request.source_path = "/nonexistent";
+    
+    auto start = std::chrono::steady_clock::now();
+    auto future = engine_->analyze_async({"sleeping-tool"}, request);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_TRUE(engine_->cancel_analysis());
+    
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    auto results = future.get();
+    
+    EXPECT_LT(elapsed.count(), 2000);
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_FALSE(results[0].success);
+    EXPECT_EQ(results[0].error_message, "cancelled");
+}
+
+TEST_F(AnalysisEngineTest, StatisticsIncludePhaseTimings) {
+    std::vector<AnalysisResult> results(3);
+    results[0].tool_name = "tool1";
+    results[0].profile.parse_time = std::chrono::milliseconds(4);
+    results[0].profile.process_count = 2;
+    results[0].profile.peak_rss_kb = 300;
+    results[0].profile.unit_peak_rss_kb = {{"a.cpp", 300}, {"b.cpp", 100}};
+    results[1].tool_name = "tool2";
+    results[1].profile.tool_cpu_time = std::chrono::milliseconds(30);
+    results[1].profile.process_count = 1;
+    results[2].tool_name = "tool1";
+    results[2].profile.parse_time = std::chrono::milliseconds(6);
+    results[2].profile.process_count = 1;
+    results[2].profile.peak_rss_kb = 200;
+    results[2].profile.involuntary_context_switches = 7;
+    results[2].profile.unit_peak_rss_kb = {{"b.cpp", 200}, {"c.cpp", 200}};
+    
+    auto stats = engine_->get_statistics(results);
+    
+    EXPECT_EQ(stats.total_profile.process_count, 4);
+    EXPECT_EQ(stats.total_profile.parse_time, std::chrono::milliseconds(10));
+    EXPECT_EQ(stats.total_profile.tool_cpu_time, std::chrono::milliseconds(30));
+    ASSERT_EQ(stats.profile_per_tool.size(), 2);
+    EXPECT_EQ(stats.profile_per_tool["tool1"].parse_time, std::chrono::milliseconds(10));
+    EXPECT_EQ(stats.profile_per_tool["tool2"].process_count, 1);
+    EXPECT_EQ(stats.profile_per_tool["tool1"].peak_rss_kb, 300u);
+    EXPECT_EQ(stats.profile_per_tool["tool1"].involuntary_context_switches, 7u);
+    EXPECT_EQ(stats.profile_per_tool["tool2"].peak_rss_kb, 0u);
+    EXPECT_EQ(stats.largest_units, (std::vector<std::pair<std::string, size_t>>{
+        {"a.cpp", 300}, {"b.cpp", 200}, {"c.cpp", 200}}));
+}
+
+TEST_F(AnalysisEngineTest, StatisticsCountIssuesAndRankFiles) {
+    std::vector<AnalysisResult> results(2);
+    auto add = [](AnalysisResult& result, const std::string& file, IssueSeverity severity) {
+        AnalysisIssue issue;
+        issue.file_path = file;
+        issue.severity = severity;
+        issue.category = IssueCategory::Bug;
+        result.add_issue(issue);
+    };
+    for (int i = 0; i < 3; ++i) {
+        add(results[0], "c.cpp", IssueSeverity::Warning);
+    }
+    add(results[0], "b.cpp", IssueSeverity::Error);
+    add(results[1], "a.cpp", IssueSeverity::Error);
+    add(results[1], "b.cpp", IssueSeverity::Warning);
+    add(results[1], "d.cpp", IssueSeverity::Info);
+    
+    // Issues pushed without recomputing are still counted
+    AnalysisIssue unrecorded;
+    unrecorded.file_path = "a.cpp";
+    unrecorded.severity = IssueSeverity::Critical;
+    results[1].issues.push_back(unrecorded);
+    
+    auto stats = engine_->get_statistics(results);
+    
+    EXPECT_EQ(stats.total_issues, 8);
+    EXPECT_EQ(stats.issues_by_severity[static_cast<size_t>(IssueSeverity::Warning)], 4);
+    EXPECT_EQ(stats.issues_by_severity[static_cast<size_t>(IssueSeverity::Error)], 2);
+    EXPECT_EQ(stats.issues_by_severity[static_cast<size_t>(IssueSeverity::Critical)], 1);
+    EXPECT_EQ(stats.issues_by_category[static_cast<size_t>(IssueCategory::Bug)], 7);
+    EXPECT_EQ(stats.most_problematic_files, (std::vector<std::string>{"c.cpp", "a.cpp", "b.cpp", "d.cpp"}));
+}
+
+TEST_F(AnalysisEngineTest, ShardsAreBalancedByFileSize) {
+    auto source_dir = std::filesystem::temp_directory_path() / "wip_engine_balance_test";
+    std::filesystem::remove_all(source_dir);
+    std::filesystem::create_directories(source_dir);
+    std::ofstream(source_dir / "big.cpp") << std::string(64 * 1024, ' ');
+    for (int i = 0; i < 7; ++i) {
+        std::ofstream(source_dir / ("small" + std::to_string(i) + ".cpp")) << "int f" << i << "();\n";
+    }
+    
+    auto recording = std::make_unique<RecordingToolForEngine>();
+    auto* tool = recording.get();
+    engine_->register_tool(std::move(recording));
+    
+    AnalysisRequest request;
+    request.source_path = source_dir.string();
+    
+    engine_->set_concurrency(1);
+    auto results = engine_->analyze_async({"recording-tool"}, request).get();
+    auto calls = tool->get_calls();
+    std::filesystem::remove_all(source_dir);
+    
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_TRUE(results[0].success);
+    
+    // Four shards; the big file is worth more than all small files together, so it runs alone
+    ASSERT_EQ(calls.size(), 4);
+    size_t file_count = 0;
+    bool big_file_alone = false;
+    for (const auto& files : calls) {
+        file_count += files.size();
+        big_file_alone = big_file_alone ||
+            (files.size() == 1 && std::filesystem::path(files[0]).filename() == "big.cpp");
+    }
+    EXPECT_EQ(file_count, 8);
+    EXPECT_TRUE(big_file_alone);
+    
+    // The most expensive shard starts first
+    EXPECT_EQ(std::filesystem::path(calls[0][0]).filename(), "big.cpp");
+}
+
+TEST_F(AnalysisEngineTest, DiffScopedAnalysisRunsOnlyAffectedUnits) {
+    auto source_dir = std::filesystem::temp_directory_path() / "wip_engine_scope_test";
+    std::filesystem::remove_all(source_dir);
+    std::filesystem::create_directories(source_dir);
+    std::ofstream(source_dir / "util.h") << "int util();\n";
+    std::ofstream(source_dir / "a.cpp") << "#include \"util.h\"\nint a() { return util(); }\n";
+    std::ofstream(source_dir / "b.cpp") << "int b();\n";
+    std::ofstream(source_dir / "c.cpp") << "int c();\n";
+    
+    auto recording = std::make_unique<RecordingToolForEngine>();
+    auto* tool = recording.get();
+    engine_->register_tool(std::move(recording));
+    
+    AnalysisRequest request;
+    request.source_path = source_dir.string();
+    request.changed_ranges = {{(source_dir / "util.h").string(), 1, 1}, {(source_dir / "c.cpp").string(), 1, 1}};
+    
+    // The header reaches a.cpp; b.cpp is not analyzed
+    engine_->set_concurrency(1);
+    auto results = engine_->analyze_async({"recording-tool"}, request).get();
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_TRUE(results[0].success);
+    std::vector<std::string> analyzed;
+    for (const auto& files : tool->get_calls()) {
+        for (const auto& file : files) {
+            analyzed.push_back(std::filesystem::path(file).filename().string());
+        }
+    }
+    std::sort(analyzed.begin(), analyzed.end());
+    EXPECT_EQ(analyzed, (std::vector<std::string>{"a.cpp", "c.cpp"}));
+    
+    // Nothing reaches a file outside the project, so no tool runs at all
+    size_t call_count = tool->get_calls().size();
+    request.changed_ranges = {{(source_dir / "unrelated" / "x.h").string(), 1, 5}};
+    auto single = engine_->analyze_single("recording-tool", request);
+    EXPECT_TRUE(single.success);
+    EXPECT_TRUE(single.issues.empty());
+    EXPECT_EQ(tool->get_calls().size(), call_count);
+    
+    std::filesystem::remove_all(source_dir);
+}
+
+TEST_F(AnalysisEngineTest, FailFastStopsAtTheFirstSevereIssue) {
+    auto source_dir = std::filesystem::temp_directory_path() / "wip_engine_fail_fast_test";
+    std::filesystem::remove_all(source_dir);
+    std::filesystem::create_directories(source_dir);
+    for (const char* name : {"bad.cpp", "a.cpp", "b.cpp", "c.cpp"}) {
+        std::ofstream(source_dir / name) << "int f();\n";
+    }
+    engine_->register_tool(std::make_unique<OffendingToolForEngine>(true));
+    
+    AnalysisRequest request;
+    request.source_path = source_dir.string();
+    request.stop_on_severity = IssueSeverity::Error;
+    
+    // The clean shards would sleep for 30 seconds; the error cancels them
+    engine_->set_concurrency(4);
+    auto start = std::chrono::steady_clock::now();
+    auto results = engine_->analyze_async({"recording-tool"}, request).get();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    std::filesystem::remove_all(source_dir);
+    
+    EXPECT_LT(elapsed, std::chrono::seconds(10));
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_TRUE(results[0].success) << results[0].error_message;
+    EXPECT_TRUE(results[0].stopped_early);
+    ASSERT_EQ(results[0].issues.size(), 1);
+    EXPECT_EQ(results[0].issues[0].severity, IssueSeverity::Error);
+}
+
+TEST_F(AnalysisEngineTest, FailFastStartsWithLastRunsOffenders) {
+    auto source_dir = std::filesystem::temp_directory_path() / "wip_engine_offender_test";
+    std::filesystem::remove_all(source_dir);
+    std::filesystem::create_directories(source_dir);
+    auto write_sources = [&](const std::string& body) {
+        for (const char* name : {"a.cpp", "b.cpp", "bad.cpp", "c.cpp"}) {
+            std::ofstream(source_dir / name) << body;
+        }
+    };
+    auto offending = std::make_unique<OffendingToolForEngine>(false);
+    auto* tool = offending.get();
+    engine_->register_tool(std::move(offending));
+    engine_->set_cache(std::make_shared<AnalysisCache>());
+    engine_->set_concurrency(1);
+    
+    AnalysisRequest request;
+    request.source_path = source_dir.string();
+    write_sources("int f();\n");
+    auto first = engine_->analyze_async({"recording-tool"}, request).get();
+    ASSERT_EQ(first.size(), 1);
+    EXPECT_FALSE(first[0].stopped_early);
+    EXPECT_EQ(first[0].issues.size(), 1);
+    size_t first_calls = tool->get_calls().size();
+    EXPECT_EQ(first_calls, 4u);
+    
+    // Every unit changed; the one that failed last time runs first and ends the run
+    write_sources("int g();\n");
+    request.stop_on_severity = IssueSeverity::Error;
+    auto second = engine_->analyze_async({"recording-tool"}, request).get();
+    auto calls = tool->get_calls();
+    std::filesystem::remove_all(source_dir);
+    
+    ASSERT_EQ(second.size(), 1);
+    EXPECT_TRUE(second[0].stopped_early);
+    ASSERT_EQ(calls.size(), first_calls + 1);
+    ASSERT_EQ(calls.back().size(), 1u);
+    EXPECT_EQ(std::filesystem::path(calls.back()[0]).filename(), "bad.cpp");
+}
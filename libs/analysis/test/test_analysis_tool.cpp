@@ -98,12 +98,12 @@ public:
         return result;
     }
     
-    std::future<AnalysisResult> execute_async(
+    wip::utils::concurrency::Task<AnalysisResult> execute_async(
         const AnalysisRequest& request,
         std::function<void(const AnalysisProgress&)> progress_callback = nullptr,
         std::function<void(const std::string&)> output_callback = nullptr) override {
         
-        return std::async(std::launch::async, [this, request, progress_callback, output_callback]() {
+        return wip::utils::concurrency::async([this, request, progress_callback, output_callback]() {
             running_ = true;
             
             // Send initial progress
@@ -38,6 +38,31 @@ TEST_F(AnalysisTypesTest, AnalysisRequestSetValues) {
     EXPECT_EQ(request.include_paths[1], "/opt/include");
 }
 
+TEST_F(AnalysisTypesTest, AnalysisRequestChangedRangesRoundTrip) {
+    AnalysisRequest request;
+    request.source_path = "/project";
+    request.changed_ranges = {{"/project/src/a.cpp", 3, 7}, {"/project/include/b.h", 1, 1}};
+    
+    auto loaded = AnalysisRequest::from_json(request.to_json());
+    EXPECT_EQ(loaded.changed_ranges, request.changed_ranges);
+    
+    // Unscoped requests keep their JSON unchanged
+    EXPECT_FALSE(AnalysisRequest{}.to_json().contains("changed_ranges"));
+    EXPECT_TRUE(AnalysisRequest::from_json(AnalysisRequest{}.to_json()).changed_ranges.empty());
+}
+
+TEST_F(AnalysisTypesTest, AnalysisRequestStopSeverityRoundTrip) {
+    AnalysisRequest request;
+    request.stop_on_severity = IssueSeverity::Error;
+    EXPECT_EQ(AnalysisRequest::from_json(request.to_json()).stop_on_severity, IssueSeverity::Error);
+    EXPECT_FALSE(AnalysisRequest::from_json(AnalysisRequest{}.to_json()).stop_on_severity);
+    
+    AnalysisResult result;
+    result.stopped_early = true;
+    EXPECT_TRUE(AnalysisResult::from_json(result.to_json()).stopped_early);
+    EXPECT_FALSE(AnalysisResult::from_json(AnalysisResult{}.to_json()).stopped_early);
+}
+
 // Test AnalysisResult structure
 TEST_F(AnalysisTypesTest, AnalysisResultConstruction) {
     AnalysisResult result;
@@ -62,6 +87,137 @@ TEST_F(AnalysisTypesTest, AnalysisResultSetValues) {
     EXPECT_EQ(result.files_analyzed, 5);
 }
 
+TEST_F(AnalysisTypesTest, AddIssueKeepsStatisticsCurrent) {
+    AnalysisResult result;
+    AnalysisIssue issue;
+    issue.severity = IssueSeverity::Error;
+    issue.category = IssueCategory::Bug;
+    result.add_issue(issue);
+    result.add_issue(issue);
+    issue.severity = IssueSeverity::Info;
+    issue.category = IssueCategory::Style;
+    result.add_issue(issue);
+    
+    EXPECT_TRUE(result.has_current_statistics());
+    EXPECT_EQ(result.get_issue_count(IssueSeverity::Error), 2);
+    EXPECT_EQ(result.get_issue_count(IssueSeverity::Info), 1);
+    EXPECT_EQ(result.get_issue_count(IssueCategory::Bug), 2);
+    EXPECT_EQ(result.get_issue_count(IssueCategory::Security), 0);
+    
+    // Issues added directly are only counted once statistics are recomputed
+    result.issues.push_back(issue);
+    EXPECT_FALSE(result.has_current_statistics());
+    result.compute_statistics();
+    EXPECT_TRUE(result.has_current_statistics());
+    EXPECT_EQ(result.get_issue_count(IssueCategory::Style), 2);
+    
+    auto json = result.to_json();
+    EXPECT_EQ(json["issue_counts_by_severity"]["error"], 2);
+    EXPECT_FALSE(json["issue_counts_by_severity"].contains("warning"));
+}
+
+// Test ExecutionProfile structure
+TEST_F(AnalysisTypesTest, ExecutionProfileSumsProcesses) {
+    wip::utils::process::ProcessResult process_result{};
+    process_result.duration = std::chrono::milliseconds(20);
+    process_result.spawn_time = std::chrono::microseconds(150);
+    process_result.cpu_time = std::chrono::milliseconds(15);
+    process_result.user_cpu_time = std::chrono::milliseconds(12);
+    process_result.system_cpu_time = std::chrono::milliseconds(3);
+    process_result.capture_time = std::chrono::microseconds(40);
+    process_result.max_rss_kb = 2048;
+    process_result.voluntary_context_switches = 5;
+    process_result.involuntary_context_switches = 2;
+    
+    ExecutionProfile profile;
+    profile.add_process(process_result);
+    process_result.max_rss_kb = 1024;
+    profile.add_process(process_result);
+    EXPECT_EQ(profile.process_count, 2);
+    EXPECT_EQ(profile.process_time, std::chrono::milliseconds(40));
+    EXPECT_EQ(profile.spawn_time, std::chrono::microseconds(300));
+    EXPECT_EQ(profile.tool_cpu_time, std::chrono::milliseconds(30));
+    EXPECT_EQ(profile.capture_time, std::chrono::microseconds(80));
+    EXPECT_EQ(profile.tool_user_cpu_time, std::chrono::milliseconds(24));
+    EXPECT_EQ(profile.tool_system_cpu_time, std::chrono::milliseconds(6));
+    EXPECT_EQ(profile.peak_rss_kb, 2048u);
+    EXPECT_EQ(profile.voluntary_context_switches, 10u);
+    EXPECT_EQ(profile.involuntary_context_switches, 4u);
+    
+    ExecutionProfile other;
+    other.parse_time = std::chrono::milliseconds(3);
+    other.aggregate_time = std::chrono::milliseconds(1);
+    other.precompile_time = std::chrono::milliseconds(4);
+    other.unit_cpu_times["a.cpp"] = std::chrono::milliseconds(5);
+    other.tool_cache_lookups = 3;
+    other.tool_cache_hits = 2;
+    other.peak_rss_kb = 4096;
+    other.voluntary_context_switches = 1;
+    other.unit_peak_rss_kb["a.cpp"] = 3000;
+    profile.unit_peak_rss_kb["a.cpp"] = 5000;
+    profile += other;
+    profile += other;
+    EXPECT_EQ(profile.unit_cpu_times["a.cpp"], std::chrono::milliseconds(10));
+    EXPECT_EQ(profile.parse_time, std::chrono::milliseconds(6));
+    EXPECT_EQ(profile.aggregate_time, std::chrono::milliseconds(2));
+    EXPECT_EQ(profile.precompile_time, std::chrono::milliseconds(8));
+    EXPECT_EQ(profile.tool_cache_lookups, 6u);
+    EXPECT_EQ(profile.tool_cache_hits, 4u);
+    EXPECT_EQ(profile.peak_rss_kb, 4096u);
+    EXPECT_EQ(profile.voluntary_context_switches, 12u);
+    EXPECT_EQ(profile.unit_peak_rss_kb["a.cpp"], 5000u);
+}
+
+TEST_F(AnalysisTypesTest, ExecutionProfileJsonRoundTrip) {
+    AnalysisResult result;
+    result.tool_name = "test-tool";
+    result.profile.spawn_time = std::chrono::microseconds(120);
+    result.profile.process_time = std::chrono::milliseconds(250);
+    result.profile.tool_cpu_time = std::chrono::milliseconds(900);
+    result.profile.capture_time = std::chrono::microseconds(75);
+    result.profile.parse_time = std::chrono::milliseconds(12);
+    result.profile.aggregate_time = std::chrono::microseconds(300);
+    result.profile.precompile_time = std::chrono::milliseconds(40);
+    result.profile.process_count = 4;
+    result.profile.tool_cache_lookups = 10;
+    result.profile.tool_cache_hits = 7;
+    result.profile.unit_cpu_times["src/a.cpp"] = std::chrono::milliseconds(700);
+    result.profile.tool_user_cpu_time = std::chrono::milliseconds(800);
+    result.profile.tool_system_cpu_time = std::chrono::milliseconds(100);
+    result.profile.peak_rss_kb = 65536;
+    result.profile.voluntary_context_switches = 40;
+    result.profile.involuntary_context_switches = 9;
+    result.profile.unit_peak_rss_kb["src/a.cpp"] = 65536;
+    
+    auto j = result.to_json();
+    EXPECT_EQ(j["profile"]["tool_cpu_us"], 900000);
+    EXPECT_EQ(j["profile"]["unit_cpu_us"]["src/a.cpp"], 700000);
+    EXPECT_EQ(j["profile"]["peak_rss_kb"], 65536);
+    
+    auto loaded = AnalysisResult::from_json(j);
+    EXPECT_EQ(loaded.profile.spawn_time, result.profile.spawn_time);
+    EXPECT_EQ(loaded.profile.process_time, result.profile.process_time);
+    EXPECT_EQ(loaded.profile.tool_cpu_time, result.profile.tool_cpu_time);
+    EXPECT_EQ(loaded.profile.capture_time, result.profile.capture_time);
+    EXPECT_EQ(loaded.profile.parse_time, result.profile.parse_time);
+    EXPECT_EQ(loaded.profile.aggregate_time, result.profile.aggregate_time);
+    EXPECT_EQ(loaded.profile.precompile_time, result.profile.precompile_time);
+    EXPECT_EQ(loaded.profile.process_count, 4);
+    EXPECT_EQ(loaded.profile.tool_cache_lookups, 10u);
+    EXPECT_EQ(loaded.profile.tool_cache_hits, 7u);
+    EXPECT_EQ(loaded.profile.unit_cpu_times, result.profile.unit_cpu_times);
+    EXPECT_EQ(loaded.profile.tool_user_cpu_time, result.profile.tool_user_cpu_time);
+    EXPECT_EQ(loaded.profile.tool_system_cpu_time, result.profile.tool_system_cpu_time);
+    EXPECT_EQ(loaded.profile.peak_rss_kb, 65536u);
+    EXPECT_EQ(loaded.profile.voluntary_context_switches, 40u);
+    EXPECT_EQ(loaded.profile.involuntary_context_switches, 9u);
+    EXPECT_EQ(loaded.profile.unit_peak_rss_kb, result.profile.unit_peak_rss_kb);
+    
+    // Reports written before profiling existed load with an empty profile
+    j.erase("profile");
+    EXPECT_EQ(AnalysisResult::from_json(j).profile.process_count, 0);
+}
+
 // Test AnalysisIssue structure
 TEST_F(AnalysisTypesTest, AnalysisIssueConstruction) {
     AnalysisIssue issue;
@@ -0,0 +1,215 @@
+#include <gtest/gtest.h>
+#include "tools/banned_token_tool.h"
+#include "analysis_engine.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+
+using namespace wip::analysis::tools;
+using namespace wip::analysis;
+
+class BannedTokenToolTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        tool_ = std::make_unique<BannedTokenTool>();
+        project_dir_ = std::filesystem::temp_directory_path() / "wip_banned_token_test";
+        std::filesystem::remove_all(project_dir_);
+        std::filesystem::create_directories(project_dir_ / "src");
+        std::filesystem::create_directories(project_dir_ / "build");
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(project_dir_);
+    }
+
+    void write_file(const std::string& relative_path, const std::string& contents) {
+        std::ofstream(project_dir_ / relative_path) << contents;
+    }
+
+    std::vector<AnalysisIssue> scan(const std::string& contents) const {
+        std::vector<AnalysisIssue> issues;
+        tool_->analyze_file("test.cpp", contents, issues);
+        return issues;
+    }
+
+    std::unique_ptr<BannedTokenTool> tool_;
+    std::filesystem::path project_dir_;
+};
+
+TEST_F(BannedTokenToolTest, BasicProperties) {
+    EXPECT_EQ(tool_->get_name(), "banned-tokens");
+    EXPECT_TRUE(tool_->is_available());
+    EXPECT_TRUE(tool_->runs_in_process());
+    EXPECT_TRUE(tool_->get_executable_path().empty());
+    EXPECT_TRUE(tool_->build_command_line(AnalysisRequest{}).empty());
+
+    auto config = dynamic_cast<const BannedTokenConfig*>(tool_->get_configuration());
+    ASSERT_NE(config, nullptr);
+    EXPECT_FALSE(config->tokens.empty());
+    EXPECT_THROW(tool_->parse_results_file("results.xml"), std::runtime_error);
+}
+
+TEST_F(BannedTokenToolTest, ReportsLineAndColumn) {
+    auto issues = scan("#include <cstring>\n"
+                       "void f(char* d, const char* s) {\n"
+                       "    strcpy(d, s); strcat(d, s);\n"
+                       "}\n");
+
+    ASSERT_EQ(issues.size(), 2u);
+    EXPECT_EQ(issues[0].rule_id, "banned-token:strcpy");
+    EXPECT_EQ(issues[0].file_path, "test.cpp");
+    EXPECT_EQ(issues[0].line_number, 3);
+    EXPECT_EQ(issues[0].column_number, 5);
+    EXPECT_EQ(issues[0].tool_name, "banned-tokens");
+    EXPECT_EQ(issues[0].category, IssueCategory::Security);
+    EXPECT_EQ(issues[1].rule_id, "banned-token:strcat");
+    EXPECT_EQ(issues[1].line_number, 3);
+    EXPECT_EQ(issues[1].column_number, 19);
+}
+
+TEST_F(BannedTokenToolTest, MatchesWholeWordsOnly) {
+    auto issues = scan("widgets(); my_strcpy(); strcpy_s(); gets(); sprintf();\nstd::auto_ptr<int> p;");
+
+    ASSERT_EQ(issues.size(), 3u);
+    EXPECT_EQ(issues[0].rule_id, "banned-token:gets");
+    EXPECT_EQ(issues[0].severity, IssueSeverity::Error);
+    EXPECT_EQ(issues[1].rule_id, "banned-token:sprintf");
+    EXPECT_EQ(issues[2].rule_id, "banned-token:std::auto_ptr");
+    EXPECT_EQ(issues[2].line_number, 2);
+    EXPECT_EQ(issues[2].column_number, 1);
+}
+
+TEST_F(BannedTokenToolTest, CustomTokens) {
+    auto config = std::make_unique<BannedTokenConfig>();
+    config->tokens = {{"rand", "", IssueSeverity::Info, IssueCategory::Bug}, {"TODO", "Unfinished code"}};
+    config->whole_words = false;
+    tool_->set_configuration(std::move(config));
+
+    auto issues = scan("int x = srand(); // TODO\n");
+    ASSERT_EQ(issues.size(), 2u);
+    EXPECT_EQ(issues[0].message, "Use of banned token 'rand'");
+    EXPECT_EQ(issues[0].severity, IssueSeverity::Info);
+    EXPECT_EQ(issues[0].column_number, 10);
+    EXPECT_EQ(issues[1].message, "Unfinished code");
+}
+
+TEST_F(BannedTokenToolTest, ConfigurationRoundTrip) {
+    BannedTokenConfig config;
+    config.tokens = {{"alloca", "Stack allocation of unknown size", IssueSeverity::Error, IssueCategory::Bug}};
+    config.whole_words = false;
+
+    BannedTokenConfig loaded;
+    loaded.from_json(config.to_json());
+    ASSERT_EQ(loaded.tokens.size(), 1u);
+    EXPECT_EQ(loaded.tokens[0].token, "alloca");
+    EXPECT_EQ(loaded.tokens[0].message, "Stack allocation of unknown size");
+    EXPECT_EQ(loaded.tokens[0].severity, IssueSeverity::Error);
+    EXPECT_EQ(loaded.tokens[0].category, IssueCategory::Bug);
+    EXPECT_FALSE(loaded.whole_words);
+
+    loaded.tokens.push_back(BannedToken{});
+    EXPECT_FALSE(loaded.validate().is_valid);
+}
+
+TEST_F(BannedTokenToolTest, ExecuteScansSourcesAndHeaders) {
+    write_file("src/main.cpp", "int main() { char b[8]; gets(b); }\n");
+    write_file("src/util.h", "\n\ninline void copy(char* d, const char* s) { strcpy(d, s); }\n");
+    write_file("src/empty.cpp", "");
+    write_file("src/notes.txt", "strcpy");
+    write_file("build/generated.cpp", "strcpy");
+
+    AnalysisRequest request;
+    request.source_path = project_dir_.string();
+    auto result = tool_->execute(request);
+
+    EXPECT_TRUE(result.success) << result.error_message;
+    EXPECT_EQ(result.files_analyzed, 3u);
+    ASSERT_EQ(result.issues.size(), 2u);
+    EXPECT_EQ(std::filesystem::path(result.issues[0].file_path).filename(), "main.cpp");
+    EXPECT_EQ(std::filesystem::path(result.issues[1].file_path).filename(), "util.h");
+    EXPECT_EQ(result.issues[1].line_number, 3);
+    EXPECT_TRUE(result.has_current_statistics());
+    EXPECT_FALSE(tool_->is_analysis_running());
+}
+
+TEST_F(BannedTokenToolTest, ExecuteReportsOnlyChangedLines) {
+    write_file("src/main.cpp", "int main() { char b[8]; gets(b); }\n\nvoid f(char* d) { strcpy(d, \"x\"); }\n");
+    write_file("src/util.h", "inline void copy(char* d, const char* s) { strcpy(d, s); }\n");
+
+    AnalysisRequest request;
+    request.source_path = project_dir_.string();
+    request.changed_ranges = {{(project_dir_ / "src" / "main.cpp").string(), 2, 3}};
+    auto result = tool_->execute(request);
+
+    // util.h has no changed lines and is not read
+    EXPECT_TRUE(result.success) << result.error_message;
+    EXPECT_EQ(result.files_analyzed, 1u);
+    ASSERT_EQ(result.issues.size(), 1u);
+    EXPECT_EQ(result.issues[0].line_number, 3);
+}
+
+TEST_F(BannedTokenToolTest, ExecuteStopsWhenCancelled) {
+    write_file("src/main.cpp", "gets");
+
+    AnalysisRequest request;
+    request.source_path = project_dir_.string();
+    request.cancellation = wip::utils::process::CancellationToken::create();
+    request.cancellation.cancel();
+
+    auto result = tool_->execute(request);
+    EXPECT_FALSE(result.success);
+    EXPECT_TRUE(result.issues.empty());
+}
+
+TEST_F(BannedTokenToolTest, ExecuteAsyncReportsProgress) {
+    write_file("src/a.cpp", "strtok");
+    write_file("src/b.cpp", "tmpnam");
+
+    AnalysisRequest request;
+    request.source_path = project_dir_.string();
+    std::vector<size_t> processed;
+    auto result = tool_->execute_async(request, [&](const AnalysisProgress& progress) {
+        processed.push_back(progress.processed_files);
+        EXPECT_EQ(progress.total_files, 2u);
+    }).get();
+
+    EXPECT_TRUE(result.success);
+    EXPECT_EQ(result.issues.size(), 2u);
+    EXPECT_EQ(processed, (std::vector<size_t>{1, 2}));
+}
+
+TEST_F(BannedTokenToolTest, EngineRunsShardsOnItsWorkers) {
+    for (int i = 0; i < 20; ++i) {
+        write_file("src/file" + std::to_string(i) + ".cpp", "void f() {\n    sprintf(buffer, \"%d\", " + std::to_string(i) + ");\n}\n");
+    }
+
+    auto engine = AnalysisEngineFactory::create_engine_with_tools({"banned-tokens"});
+    ASSERT_NE(engine->get_tool("banned-tokens"), nullptr);
+    engine->set_concurrency(4);
+
+    AnalysisRequest request;
+    request.source_path = project_dir_.string();
+    std::vector<std::string> output;
+    auto results = engine->analyze_async({"banned-tokens"}, request, nullptr,
+        [&](const std::string&, const std::string& line) { output.push_back(line); }).get();
+
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_TRUE(results[0].success) << results[0].error_message;
+    EXPECT_EQ(results[0].files_analyzed, 20u);
+    EXPECT_EQ(results[0].issues.size(), 20u);
+    EXPECT_TRUE(std::all_of(results[0].issues.begin(), results[0].issues.end(), [](const AnalysisIssue& issue) {
+        return issue.line_number == 2 && issue.column_number == 5;
+    }));
+    EXPECT_TRUE(output.empty());
+}
+
+TEST_F(BannedTokenToolTest, RegisteredWithToolRegistry) {
+    EXPECT_TRUE(AnalysisToolRegistry::instance().is_tool_available("banned-tokens"));
+    auto tool = AnalysisToolRegistry::instance().create_tool("banned-tokens");
+    ASSERT_NE(tool, nullptr);
+    EXPECT_TRUE(tool->runs_in_process());
+
+    auto engine = AnalysisEngineFactory::create_full_engine();
+    EXPECT_NE(engine->get_tool("banned-tokens"), nullptr);
+}
@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+#include "changed_lines.h"
+#include <filesystem>
+
+using namespace wip::analysis;
+
+TEST(ChangedLinesTest, MergesAndLooksUpRanges) {
+    ChangedLines scope({{"/src/a.cpp", 10, 12}, {"/src/a.cpp", 3, 3}, {"/src/a.cpp", 13, 20},
+                        {"/src/./b.h", 5, 5}, {"", 1, 1}});
+    EXPECT_FALSE(scope.empty());
+    EXPECT_EQ(scope.get_files(), (std::vector<std::string>{"/src/a.cpp", "/src/b.h"}));
+
+    EXPECT_TRUE(scope.contains("/src/a.cpp", 3));
+    EXPECT_FALSE(scope.contains("/src/a.cpp", 4));
+    EXPECT_FALSE(scope.contains("/src/a.cpp", 9));
+    EXPECT_TRUE(scope.contains("/src/a.cpp", 10));
+    EXPECT_TRUE(scope.contains("/src/a.cpp", 16));
+    EXPECT_TRUE(scope.contains("/src/a.cpp", 20));
+    EXPECT_FALSE(scope.contains("/src/a.cpp", 21));
+    EXPECT_TRUE(scope.contains("/src/x/../b.h", 5));
+    EXPECT_FALSE(scope.contains("/src/c.cpp", 5));
+
+    // Issues without a line are kept when their file changed
+    EXPECT_TRUE(scope.contains("/src/b.h", 0));
+    EXPECT_FALSE(scope.contains("", 0));
+    EXPECT_TRUE(scope.contains_file("/src/b.h"));
+    EXPECT_FALSE(scope.contains_file("/src/c.cpp"));
+
+    AnalysisIssue issue;
+    issue.file_path = "/src/a.cpp";
+    issue.line_number = 11;
+    EXPECT_TRUE(scope.contains(issue));
+}
+
+TEST(ChangedLinesTest, ResolvesRelativePathsAgainstTheCurrentDirectory) {
+    ChangedLines scope({{"src/a.cpp", 1, 2}});
+    auto absolute = (std::filesystem::current_path() / "src" / "a.cpp").string();
+    EXPECT_EQ(scope.get_files(), std::vector<std::string>{absolute});
+    EXPECT_TRUE(scope.contains(absolute, 2));
+    EXPECT_TRUE(scope.contains("./src/a.cpp", 1));
+}
+
+TEST(ChangedLinesTest, EmptyMeansUnscoped) {
+    EXPECT_TRUE(ChangedLines().empty());
+    EXPECT_TRUE(ChangedLines(std::vector<ChangedRange>{}).empty());
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include "tools/clang_tidy_diagnostic_parser.h"
+#include "tools/clang_tidy_tool.h"
+#include <filesystem>
+#include <fstream>
+
+using namespace wip::analysis::tools;
+using namespace wip::analysis;
+
+class ClangTidyDiagnosticParserTest : public ::testing::Test {
+};
+
+TEST_F(ClangTidyDiagnosticParserTest, ParsesWarningWithCheckName) {
+    auto diagnostic = parse_clang_tidy_diagnostic(
+        "/src/main.cpp:42:7: warning: use nullptr [modernize-use-nullptr]");
+
+    ASSERT_TRUE(diagnostic.has_value());
+    EXPECT_EQ(diagnostic->file_path, "/src/main.cpp");
+    EXPECT_EQ(diagnostic->line_number, 42);
+    EXPECT_EQ(diagnostic->column_number, 7);
+    EXPECT_EQ(diagnostic->severity, "warning");
+    EXPECT_EQ(diagnostic->message, "use nullptr");
+    EXPECT_EQ(diagnostic->check_name, "modernize-use-nullptr");
+}
+
+TEST_F(ClangTidyDiagnosticParserTest, ParsesErrorAndNoteSeverities) {
+    auto error = parse_clang_tidy_diagnostic("a.cpp:1:2: error: unknown type name 'foo' [clang-diagnostic-error]");
+    ASSERT_TRUE(error.has_value());
+    EXPECT_EQ(error->severity, "error");
+
+    auto note = parse_clang_tidy_diagnostic("a.cpp:3:4: note: previous declaration is here");
+    ASSERT_TRUE(note.has_value());
+    EXPECT_EQ(note->severity, "note");
+    EXPECT_EQ(note->message, "previous declaration is here");
+    EXPECT_TRUE(note->check_name.empty());
+}
+
+TEST_F(ClangTidyDiagnosticParserTest, KeepsBracketsInsideMessage) {
+    auto diagnostic = parse_clang_tidy_diagnostic(
+        "a.cpp:10:1: warning: array 'v[3]' is indexed out of bounds [cppcoreguidelines-pro-bounds-constant-array-index]");
+
+    ASSERT_TRUE(diagnostic.has_value());
+    EXPECT_EQ(diagnostic->message, "array 'v[3]' is indexed out of bounds");
+    EXPECT_EQ(diagnostic->check_name, "cppcoreguidelines-pro-bounds-constant-array-index");
+}
+
+TEST_F(ClangTidyDiagnosticParserTest, HandlesCarriageReturnAndDriveLetter) {
+    auto diagnostic = parse_clang_tidy_diagnostic(
+        "C:\\work\\src\\main.cpp:5:9: warning: variable 'x' is not initialized [cppcoreguidelines-init-variables]\r");
+
+    ASSERT_TRUE(diagnostic.has_value());
+    EXPECT_EQ(diagnostic->file_path, "C:\\work\\src\\main.cpp");
+    EXPECT_EQ(diagnostic->line_number, 5);
+    EXPECT_EQ(diagnostic->column_number, 9);
+    EXPECT_EQ(diagnostic->check_name, "cppcoreguidelines-init-variables");
+}
+
+TEST_F(ClangTidyDiagnosticParserTest, RejectsNonDiagnosticLines) {
+    EXPECT_FALSE(parse_clang_tidy_diagnostic("").has_value());
+    EXPECT_FALSE(parse_clang_tidy_diagnostic("    int* p = 0;").has_value());
+    EXPECT_FALSE(parse_clang_tidy_diagnostic("             ^~~~").has_value());
+    EXPECT_FALSE(parse_clang_tidy_diagnostic("12 warnings generated.").has_value());
+    EXPECT_FALSE(parse_clang_tidy_diagnostic("Suppressed 12 warnings (12 in non-user code).").has_value());
+    EXPECT_FALSE(parse_clang_tidy_diagnostic("Error while processing /src/main.cpp.").has_value());
+}
+
+TEST_F(ClangTidyDiagnosticParserTest, RejectsMalformedFields) {
+    EXPECT_FALSE(parse_clang_tidy_diagnostic("a.cpp:-1:2: warning: msg").has_value());
+    EXPECT_FALSE(parse_clang_tidy_diagnostic("a.cpp:x:2: warning: msg").has_value());
+    EXPECT_FALSE(parse_clang_tidy_diagnostic("a.cpp:1: warning: msg").has_value());
+    EXPECT_FALSE(parse_clang_tidy_diagnostic("a.cpp:1:2: remark: msg").has_value());
+    EXPECT_FALSE(parse_clang_tidy_diagnostic("a.cpp:1:2:warning: msg").has_value());
+    EXPECT_FALSE(parse_clang_tidy_diagnostic("a.cpp:1:2: warning: [check-only]").has_value());
+}
+
+TEST_F(ClangTidyDiagnosticParserTest, ToolOutputParsing) {
+    ClangTidyTool tool;
+    std::string output =
+        "/src/a.cpp:1:1: warning: first [readability-x]\n"
+        "    int x;\n"
+        "    ^\n"
+        "/src/a.cpp:1:1: warning: first [readability-x]\n"
+        "/src/b.cpp:2:3: error: second [bugprone-y]\r\n"
+        "2 warnings generated.\n";
+
+    auto output_file = std::filesystem::temp_directory_path() / "wip_clang_tidy_parser_test.txt";
+    {
+        std::ofstream file(output_file, std::ios::binary);
+        file << output;
+    }
+
+    AnalysisResult result = tool.parse_results_file(output_file.string());
+    std::filesystem::remove(output_file);
+
+    ASSERT_EQ(result.issues.size(), 2);
+    EXPECT_EQ(result.issues[0].file_path, "/src/a.cpp");
+    EXPECT_EQ(result.issues[0].rule_id, "readability-x");
+    EXPECT_EQ(result.issues[1].severity, IssueSeverity::Error);
+    EXPECT_EQ(result.issues[1].category, IssueCategory::Bug);
+    EXPECT_EQ(result.issues[1].tool_name, "clang-tidy");
+}
@@ -3,6 +3,7 @@
 #include "analysis_types.h"
 #include <memory>
 #include <filesystem>
+#include <fstream>
 
 using namespace wip::analysis::tools;
 using namespace wip::analysis;
@@ -356,4 +357,131 @@ TEST_F(ClangTidyToolTest, EmptyConfiguration) {
     // Should still work with empty configuration
     auto validation_result = tool_->validate_configuration();
     EXPECT_TRUE(validation_result.errors.empty());
-}
\ No newline at end of file
+}
+
+// Test translation unit discovery for sharded execution
+TEST_F(ClangTidyToolTest, TranslationUnitsFromDirectory) {
+    auto temp_dir = std::filesystem::temp_directory_path() / "wip_clang_tidy_tu_walk";
+    std::filesystem::remove_all(temp_dir);
+    std::filesystem::create_directories(temp_dir / "src");
+    std::filesystem::create_directories(temp_dir / "CMakeFiles");
+    std::ofstream(temp_dir / "main.cpp") << "int main() { return 0; }\n";
+    std::ofstream(temp_dir / "src" / "a.cc") << "void a() {}\n";
+    std::ofstream(temp_dir / "src" / "b.c") << "void b(void) {}\n";
+    std::ofstream(temp_dir / "src" / "a.h") << "void a();\n";
+    std::ofstream(temp_dir / "CMakeFiles" / "generated.cpp") << "\n";
+    
+    AnalysisRequest request;
+    request.source_path = temp_dir.string();
+    
+    auto units = tool_->get_translation_units(request);
+    ASSERT_EQ(units.size(), 3u);
+    EXPECT_EQ(units[0], (temp_dir / "main.cpp").string());
+    EXPECT_EQ(units[1], (temp_dir / "src" / "a.cc").string());
+    EXPECT_EQ(units[2], (temp_dir / "src" / "b.c").string());
+    
+    // Every translation unit is passed to a single-invocation command line
+    auto cmdline = tool_->build_command_line(request);
+    for (const auto& unit : units) {
+        EXPECT_NE(std::find(cmdline.begin(), cmdline.end(), unit), cmdline.end());
+    }
+    
+    std::filesystem::remove_all(temp_dir);
+}
+
+TEST_F(ClangTidyToolTest, TranslationUnitsSkipExcludePatterns) {
+    auto temp_dir = std::filesystem::temp_directory_path() / "wip_clang_tidy_tu_exclude";
+    std::filesystem::remove_all(temp_dir);
+    std::filesystem::create_directories(temp_dir / "src" / "generated");
+    std::filesystem::create_directories(temp_dir / "third_party" / "zlib");
+    std::ofstream(temp_dir / "main.cpp") << "\n";
+    std::ofstream(temp_dir / "src" / "a.cpp") << "\n";
+    std::ofstream(temp_dir / "src" / "message.pb.cc") << "\n";
+    std::ofstream(temp_dir / "src" / "generated" / "b.cpp") << "\n";
+    std::ofstream(temp_dir / "third_party" / "zlib" / "zlib.c") << "\n";
+    
+    AnalysisRequest request;
+    request.source_path = temp_dir.string();
+    request.exclude_patterns = {"generated", "*.pb.cc", "third_party/"};
+    
+    auto units = tool_->get_translation_units(request);
+    ASSERT_EQ(units.size(), 2u);
+    EXPECT_EQ(units[0], (temp_dir / "main.cpp").string());
+    EXPECT_EQ(units[1], (temp_dir / "src" / "a.cpp").string());
+    
+    // Patterns are matched relative to the source path, not the full path
+    request.exclude_patterns = {std::filesystem::path(temp_dir).filename().string()};
+    EXPECT_EQ(tool_->get_translation_units(request).size(), 5u);
+    
+    std::filesystem::remove_all(temp_dir);
+}
+
+TEST_F(ClangTidyToolTest, TranslationUnitsFromCompilationDatabase) {
+    auto temp_dir = std::filesystem::temp_directory_path() / "wip_clang_tidy_tu_db";
+    std::filesystem::remove_all(temp_dir);
+    std::filesystem::create_directories(temp_dir / "build");
+    std::ofstream(temp_dir / "listed.cpp") << "\n";
+    std::ofstream(temp_dir / "unlisted.cpp") << "\n";
+    
+    nlohmann::json database = nlohmann::json::array();
+    database.push_back({{"directory", temp_dir.string()}, {"file", "listed.cpp"}, {"command", "c++ -c listed.cpp"}});
+    database.push_back({{"directory", temp_dir.string()}, {"file", "listed.cpp"}, {"command", "c++ -c listed.cpp"}});
+    database.push_back({{"directory", "/elsewhere"}, {"file", "/elsewhere/other.cpp"}, {"command", "c++ -c other.cpp"}});
+    std::ofstream(temp_dir / "build" / "compile_commands.json") << database.dump();
+    
+    AnalysisRequest request;
+    request.source_path = temp_dir.string();
+    
+    auto units = tool_->get_translation_units(request);
+    ASSERT_EQ(units.size(), 1u);
+    EXPECT_EQ(std::filesystem::path(units[0]).filename(), "listed.cpp");
+    
+    std::filesystem::remove_all(temp_dir);
+}
+
+TEST_F(ClangTidyToolTest, TranslationUnitsForSingleFile) {
+    AnalysisRequest request;
+    request.source_path = "/nonexistent/file.cpp";
+    EXPECT_TRUE(tool_->get_translation_units(request).empty());
+    
+    auto temp_file = std::filesystem::temp_directory_path() / "wip_clang_tidy_single.cpp";
+    std::ofstream(temp_file) << "\n";
+    request.source_path = temp_file.string();
+    
+    auto units = tool_->get_translation_units(request);
+    ASSERT_EQ(units.size(), 1u);
+    EXPECT_EQ(units[0], temp_file.string());
+    
+    std::filesystem::remove(temp_file);
+}
+
+TEST_F(ClangTidyToolTest, JobCountConfiguration) {
+    auto config = std::make_unique<ClangTidyConfig>();
+    EXPECT_EQ(config->job_count, 0);
+    config->job_count = 6;
+    
+    ClangTidyConfig restored;
+    restored.from_json(config->to_json());
+    EXPECT_EQ(restored.job_count, 6);
+    
+    tool_->set_configuration(std::move(config));
+    EXPECT_EQ(tool_->get_effective_job_count(), 6u);
+    
+    tool_->set_configuration(std::make_unique<ClangTidyConfig>());
+    EXPECT_GE(tool_->get_effective_job_count(), 1u);
+}
+
+TEST_F(ClangTidyToolTest, PrecompiledHeaderConfiguration) {
+    ClangTidyConfig config;
+    EXPECT_FALSE(config.precompiled_headers);
+    config.precompiled_headers = true;
+    config.precompiled_header_min_units = 5;
+    
+    ClangTidyConfig restored;
+    restored.from_json(config.to_json());
+    EXPECT_TRUE(restored.precompiled_headers);
+    EXPECT_EQ(restored.precompiled_header_min_units, 5);
+    
+    restored.precompiled_header_min_units = 1;
+    EXPECT_FALSE(restored.validate().is_valid);
+}
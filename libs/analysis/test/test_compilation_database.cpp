@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include "compilation_database.h"
+#include <nlohmann/json.hpp>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+using namespace wip::analysis;
+
+class CompilationDatabaseTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        directory_ = std::filesystem::temp_directory_path() / "wip_compilation_database_test";
+        std::filesystem::remove_all(directory_);
+        std::filesystem::create_directories(directory_ / "build");
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory_);
+    }
+
+    void write_database(const std::string& contents) {
+        std::ofstream(directory_ / "build" / "compile_commands.json") << contents;
+    }
+
+    std::string build_dir() const {
+        return (directory_ / "build").string();
+    }
+
+    std::filesystem::path directory_;
+};
+
+TEST_F(CompilationDatabaseTest, IndexesCommandsAndArguments) {
+    auto database = CompilationDatabase::parse(R"([
+        {"directory": "/project/build", "file": "../src/a.cpp", "output": "a.o",
+         "command": "/usr/bin/c++ -I../include -DNAME=\"a b\" -c ../src/a.cpp"},
+        {"file": "/project/src/b.c", "directory": "/project/build", "extra": {"nested": [1, 2.5, null, true]},
+         "arguments": ["cc", "-Iinclude", "-c", "/project/src/b.c"]},
+        {"directory": "/project/build", "command": "c++ -c no_file.cpp"},
+        {"directory": "/project/build", "file": "/project/src/a.cpp", "arguments": ["c++", "-DSECOND"]}
+    ])", "/project/build");
+    ASSERT_NE(database, nullptr);
+    ASSERT_EQ(database->get_entries().size(), 3u);
+
+    const auto* a = database->find("/project/src/../src/a.cpp");
+    ASSERT_NE(a, nullptr);
+    EXPECT_EQ(a->file, "/project/src/a.cpp");
+    EXPECT_EQ(a->directory, "/project/build");
+    EXPECT_EQ(a->output, "a.o");
+    EXPECT_TRUE(a->arguments.empty());
+    EXPECT_EQ(a->get_arguments(), (std::vector<std::string>{"/usr/bin/c++", "-I../include", "-DNAME=a b", "-c", "../src/a.cpp"}));
+
+    const auto* b = database->find("/project/src/b.c");
+    ASSERT_NE(b, nullptr);
+    EXPECT_EQ(b->get_arguments(), (std::vector<std::string>{"cc", "-Iinclude", "-c", "/project/src/b.c"}));
+
+    EXPECT_EQ(database->find("/project/src/c.cpp"), nullptr);
+    EXPECT_EQ(database->get_units("/project/src"),
+              (std::vector<std::string>{"/project/src/a.cpp", "/project/src/b.c", "/project/src/a.cpp"}));
+    EXPECT_TRUE(database->get_units("/other").empty());
+}
+
+TEST_F(CompilationDatabaseTest, RejectsWhatIsNotAnArray) {
+    EXPECT_EQ(CompilationDatabase::parse(R"({"file": "a.cpp"})", "/build"), nullptr);
+    EXPECT_EQ(CompilationDatabase::parse(R"([{"file": "a.cpp", )", "/build"), nullptr);
+    EXPECT_EQ(CompilationDatabase::parse("", "/build"), nullptr);
+
+    auto empty = CompilationDatabase::parse("[]", "/build");
+    ASSERT_NE(empty, nullptr);
+    EXPECT_TRUE(empty->get_entries().empty());
+}
+
+TEST_F(CompilationDatabaseTest, DecodesEscapedStrings) {
+    auto database = CompilationDatabase::parse(R"([
+        {"directory": "/b\/c", "file": "caf\u00e9.cpp", "skipped": {"a": ["x\"y", -1.5e3, false]},
+         "arguments": ["c++", "-DQ=\"\ud83d\ude00\"", 7, "-DT=a\tb"]}
+    ])", "/b");
+    ASSERT_NE(database, nullptr);
+    ASSERT_EQ(database->get_entries().size(), 1u);
+    const auto& entry = database->get_entries()[0];
+    EXPECT_EQ(entry.file, "/b/c/caf\xc3\xa9.cpp");
+    EXPECT_EQ(entry.arguments, (std::vector<std::string>{"c++", "-DQ=\"\xf0\x9f\x98\x80\"", "-DT=a\tb"}));
+
+    EXPECT_EQ(CompilationDatabase::parse(R"([{"file": "a\u12"}])", "/b"), nullptr);
+    EXPECT_EQ(CompilationDatabase::parse(R"([{"file": "a.cpp"}] x)", "/b"), nullptr);
+}
+
+TEST_F(CompilationDatabaseTest, SplitsCommandsLikeAShell) {
+    EXPECT_EQ(CompilationDatabase::split_command(R"(c++  -DA='x y' -DB="q\"r" a\ b.cpp)"),
+              (std::vector<std::string>{"c++", "-DA=x y", "-DB=q\"r", "a b.cpp"}));
+    EXPECT_TRUE(CompilationDatabase::split_command("   ").empty());
+}
+
+TEST_F(CompilationDatabaseTest, SharesOneIndexUntilTheFileChanges) {
+    write_database(R"([{"directory": "/b", "file": "/s/a.cpp", "arguments": ["c++", "-c", "/s/a.cpp"]}])");
+    auto first = CompilationDatabase::open(build_dir());
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(CompilationDatabase::open(build_dir() + "/."), first);
+
+    write_database(R"([{"directory": "/b", "file": "/s/a.cpp", "arguments": ["c++", "-c", "/s/a.cpp"]},
+                       {"directory": "/b", "file": "/s/b.cpp", "arguments": ["c++", "-c", "/s/b.cpp"]}])");
+    auto second = CompilationDatabase::open(build_dir());
+    ASSERT_NE(second, nullptr);
+    EXPECT_NE(second, first);
+    EXPECT_EQ(second->get_entries().size(), 2u);
+    EXPECT_EQ(first->get_entries().size(), 1u);
+
+    std::filesystem::remove(directory_ / "build" / "compile_commands.json");
+    EXPECT_EQ(CompilationDatabase::open(build_dir()), nullptr);
+}
+
+TEST_F(CompilationDatabaseTest, WritesSubsetsOfUnits) {
+    auto database = CompilationDatabase::parse(R"([
+        {"directory": "/b", "file": "/s/a.cpp", "arguments": ["c++", "-DA", "-c", "/s/a.cpp"], "output": "a.o"},
+        {"directory": "/b", "file": "../s/b.cpp", "command": "c++ -DB -c ../s/b.cpp"},
+        {"directory": "/b", "file": "/s/c.cpp", "arguments": ["c++", "-c", "/s/c.cpp"]}
+    ])", "/b");
+    ASSERT_NE(database, nullptr);
+
+    auto subset_dir = directory_ / "subset";
+    std::filesystem::create_directories(subset_dir);
+    EXPECT_EQ(database->write_subset({"/s/b.cpp", "/s/a.cpp", "/s/missing.cpp"}, subset_dir), 2u);
+
+    std::ifstream file(subset_dir / "compile_commands.json");
+    std::stringstream contents;
+    contents << file.rdbuf();
+    auto subset = CompilationDatabase::parse(contents.str(), subset_dir.string());
+    ASSERT_NE(subset, nullptr);
+    ASSERT_EQ(subset->get_entries().size(), 2u);
+    EXPECT_EQ(subset->get_entries()[0].file, "/s/b.cpp");
+    EXPECT_EQ(subset->get_entries()[0].command, "c++ -DB -c ../s/b.cpp");
+    EXPECT_EQ(subset->get_entries()[1].arguments, (std::vector<std::string>{"c++", "-DA", "-c", "/s/a.cpp"}));
+    EXPECT_EQ(subset->get_entries()[1].output, "a.o");
+    EXPECT_EQ(subset->find("/s/c.cpp"), nullptr);
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include "concurrency_governor.h"
+
+using namespace wip::analysis;
+
+class ConcurrencyGovernorTest : public ::testing::Test {
+protected:
+    static SystemResources make_resources(size_t cpus, size_t memory_mb, double load) {
+        SystemResources resources;
+        resources.cpu_count = cpus;
+        resources.available_memory_mb = memory_mb;
+        resources.load_average = load;
+        return resources;
+    }
+
+    ConcurrencyGovernor::Options options_;
+};
+
+TEST_F(ConcurrencyGovernorTest, BudgetFollowsIdleCpus) {
+    EXPECT_EQ(ConcurrencyGovernor::compute_budget(make_resources(64, 0, -1.0), options_), 64);
+    EXPECT_EQ(ConcurrencyGovernor::compute_budget(make_resources(64, 0, 0.3), options_), 64);
+
+    // Another project keeping 40 CPUs busy leaves the rest
+    EXPECT_EQ(ConcurrencyGovernor::compute_budget(make_resources(64, 0, 40.2), options_), 24);
+    EXPECT_EQ(ConcurrencyGovernor::compute_budget(make_resources(64, 0, 90.0), options_), 1);
+
+    options_.use_load_average = false;
+    EXPECT_EQ(ConcurrencyGovernor::compute_budget(make_resources(64, 0, 40.0), options_), 64);
+}
+
+TEST_F(ConcurrencyGovernorTest, BudgetFitsIntoMemory) {
+    options_.memory_per_job_mb = 1024;
+    EXPECT_EQ(ConcurrencyGovernor::compute_budget(make_resources(64, 8 * 1024, 0.0), options_), 8);
+    EXPECT_EQ(ConcurrencyGovernor::compute_budget(make_resources(64, 512, 0.0), options_), 1);
+
+    options_.max_workers = 4;
+    EXPECT_EQ(ConcurrencyGovernor::compute_budget(make_resources(64, 8 * 1024, 0.0), options_), 4);
+}
+
+TEST_F(ConcurrencyGovernorTest, CurrentBudgetIsPositive) {
+    auto resources = SystemResources::probe();
+    EXPECT_GE(resources.cpu_count, 1);
+
+    ConcurrencyGovernor governor;
+    size_t budget = governor.compute_budget();
+    EXPECT_GE(budget, 1);
+    EXPECT_LE(budget, resources.cpu_count);
+}
+
+TEST_F(ConcurrencyGovernorTest, ManyJobsGetOneSlotEach) {
+    ConcurrencyGovernor governor;
+    governor.begin_run(4);
+
+    std::vector<ConcurrencyGovernor::Lease> leases;
+    for (size_t i = 0; i < 4; ++i) {
+        leases.push_back(governor.acquire(100 - i, 3 - i));
+        EXPECT_EQ(leases.back().get_slots(), 1);
+    }
+    EXPECT_EQ(governor.get_slots_in_use(), 4);
+
+    leases.clear();
+    EXPECT_EQ(governor.get_slots_in_use(), 0);
+}
+
+TEST_F(ConcurrencyGovernorTest, FewJobsShareSurplusSlots) {
+    ConcurrencyGovernor governor;
+    governor.begin_run(64);
+
+    // Two tools starting together split the machine
+    auto first = governor.acquire(2, 1);
+    auto second = governor.acquire(1, 0);
+    EXPECT_EQ(first.get_slots(), 32);
+    EXPECT_EQ(second.get_slots(), 32);
+    EXPECT_EQ(governor.get_slots_in_use(), 64);
+}
+
+TEST_F(ConcurrencyGovernorTest, SlotsOfFinishedJobGoToLaterJobs) {
+    ConcurrencyGovernor governor;
+    governor.begin_run(8);
+
+    auto first = governor.acquire(3, 1);
+    auto second = governor.acquire(2, 0);
+    EXPECT_EQ(first.get_slots(), 4);
+    EXPECT_EQ(second.get_slots(), 4);
+
+    // The first tool finished early; the last job takes its slots
+    first.release();
+    auto third = governor.acquire(1, 0);
+    EXPECT_EQ(third.get_slots(), 4);
+
+    // With nothing free a job still gets a slot to make progress
+    auto fourth = governor.acquire(1, 0);
+    EXPECT_EQ(fourth.get_slots(), 1);
+}
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include "tools/cppcheck_build_directory.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+using namespace wip::analysis::tools;
+
+class CppcheckBuildDirectoryTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        root_ = std::filesystem::temp_directory_path() / "wip_cppcheck_build_directory_test";
+        std::filesystem::remove_all(root_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(root_);
+    }
+
+    // Does what cppcheck does with a build directory: writes files.txt, then
+    // rewrites the analyzer files of the units whose analysis is out of date
+    static void run_cppcheck(const CppcheckBuildDirectory& build_directory,
+                             const std::vector<std::pair<std::string, std::string>>& files,
+                             const std::vector<std::string>& analyzed) {
+        std::filesystem::path path = build_directory.get_path();
+        std::ofstream list(path / "files.txt");
+        for (const auto& [analyzer_file, unit] : files) {
+            list << analyzer_file << "::" << unit << "\n";
+        }
+        for (const auto& analyzer_file : analyzed) {
+            std::ofstream(path / analyzer_file) << "analysis of " << analyzer_file;
+        }
+    }
+
+    static std::string read(const std::filesystem::path& path) {
+        std::ifstream file(path);
+        std::stringstream contents;
+        contents << file.rdbuf();
+        return contents.str();
+    }
+
+    std::filesystem::path root_;
+};
+
+TEST_F(CppcheckBuildDirectoryTest, SeedsUnitsFromEarlierRuns) {
+    std::vector<std::string> units = {"/src/a.cpp", "/src/b.cpp"};
+    {
+        CppcheckBuildDirectory build_directory(root_, "config", units);
+        run_cppcheck(build_directory, {{"a.a1", "/src/a.cpp"}, {"b.a1", "/src/b.cpp"}}, {"a.a1", "b.a1"});
+        auto stats = build_directory.commit();
+        EXPECT_EQ(stats.lookups, 2u);
+        EXPECT_EQ(stats.hits, 0u);
+    }
+
+    CppcheckBuildDirectory build_directory(root_, "config", units);
+    std::filesystem::path path = build_directory.get_path();
+    EXPECT_EQ(read(path / "a.a1"), "analysis of a.a1");
+    EXPECT_EQ(read(path / "b.a1"), "analysis of b.a1");
+
+    // b.cpp changed, so cppcheck rewrote its file
+    run_cppcheck(build_directory, {{"a.a1", "/src/a.cpp"}, {"b.a1", "/src/b.cpp"}}, {"b.a1"});
+    auto stats = build_directory.commit();
+    EXPECT_EQ(stats.lookups, 2u);
+    EXPECT_EQ(stats.hits, 1u);
+}
+
+TEST_F(CppcheckBuildDirectoryTest, KeepsUnitsWithTheSameNameApart) {
+    std::vector<std::string> units = {"/src/x/util.cpp", "/src/y/util.cpp"};
+    {
+        CppcheckBuildDirectory build_directory(root_, "config", units);
+        run_cppcheck(build_directory, {{"util.a1", "/src/x/util.cpp"}, {"util.a2", "/src/y/util.cpp"}},
+                     {"util.a1", "util.a2"});
+        EXPECT_EQ(build_directory.commit().lookups, 2u);
+    }
+
+    // Cppcheck may number them either way, so neither is seeded
+    {
+        CppcheckBuildDirectory build_directory(root_, "config", units);
+        EXPECT_FALSE(std::filesystem::exists(std::filesystem::path(build_directory.get_path()) / "util.a1"));
+    }
+
+    // A shard with only one of them gets it back
+    CppcheckBuildDirectory build_directory(root_, "config", {"/src/y/util.cpp"});
+    EXPECT_EQ(read(std::filesystem::path(build_directory.get_path()) / "util.a1"), "analysis of util.a2");
+}
+
+TEST_F(CppcheckBuildDirectoryTest, ConcurrentRunsUsePrivateDirectories) {
+    CppcheckBuildDirectory first(root_, "config", {"/src/a.cpp"});
+    CppcheckBuildDirectory second(root_, "config", {"/src/b.cpp"});
+    EXPECT_NE(first.get_path(), second.get_path());
+
+    run_cppcheck(first, {{"a.a1", "/src/a.cpp"}}, {"a.a1"});
+    run_cppcheck(second, {{"b.a1", "/src/b.cpp"}}, {"b.a1"});
+    EXPECT_EQ(first.commit().lookups, 1u);
+    EXPECT_EQ(second.commit().lookups, 1u);
+
+    CppcheckBuildDirectory both(root_, "config", {"/src/a.cpp", "/src/b.cpp"});
+    EXPECT_TRUE(std::filesystem::exists(std::filesystem::path(both.get_path()) / "a.a1"));
+    EXPECT_TRUE(std::filesystem::exists(std::filesystem::path(both.get_path()) / "b.a1"));
+}
+
+TEST_F(CppcheckBuildDirectoryTest, DropsStoresOfOtherConfigurations) {
+    std::string path;
+    {
+        CppcheckBuildDirectory build_directory(root_, "old", {"/src/a.cpp"});
+        path = build_directory.get_path();
+        run_cppcheck(build_directory, {{"a.a1", "/src/a.cpp"}}, {"a.a1"});
+        build_directory.commit();
+    }
+    EXPECT_FALSE(std::filesystem::exists(path));
+    EXPECT_TRUE(std::filesystem::exists(root_ / "old"));
+
+    CppcheckBuildDirectory build_directory(root_, "new", {"/src/a.cpp"});
+    EXPECT_FALSE(std::filesystem::exists(root_ / "old"));
+    EXPECT_FALSE(std::filesystem::exists(std::filesystem::path(build_directory.get_path()) / "a.a1"));
+}
+
+TEST_F(CppcheckBuildDirectoryTest, ResolvesRelativeUnitsAgainstTheWorkingDirectory) {
+    {
+        CppcheckBuildDirectory build_directory(root_, "config", {"/project/src/a.cpp"});
+        run_cppcheck(build_directory, {{"a.a1", "src/a.cpp"}}, {"a.a1"});
+        EXPECT_EQ(build_directory.commit("/project").lookups, 1u);
+    }
+
+    CppcheckBuildDirectory build_directory(root_, "config", {"/project/src/../src/a.cpp"});
+    EXPECT_TRUE(std::filesystem::exists(std::filesystem::path(build_directory.get_path()) / "a.a1"));
+}
@@ -3,6 +3,8 @@
 #include "analysis_types.h"
 #include <memory>
 #include <filesystem>
+#include <fstream>
+#include <algorithm>
 
 using namespace wip::analysis::tools;
 using namespace wip::analysis;
@@ -232,6 +234,7 @@ TEST_F(CppcheckToolTest, ConfigurationSerialization) {
     config->enable_performance = false;
     config->verbose = true;
     config->job_count = 2;
+    config->cache_directory = "/project/.gran_azul_cppcheck";
     
     // Test serialization
     auto json_data = config->to_json();
@@ -246,4 +249,53 @@ TEST_F(CppcheckToolTest, ConfigurationSerialization) {
     EXPECT_TRUE(config2.enable_style);
     EXPECT_FALSE(config2.enable_performance);
     EXPECT_EQ(config2.job_count, 2);
-}
\ No newline at end of file
+    EXPECT_EQ(config2.cache_directory, "/project/.gran_azul_cppcheck");
+}
+// Test compilation database mode
+TEST_F(CppcheckToolTest, CompilationDatabaseDrivesInvocation) {
+    auto temp_dir = std::filesystem::temp_directory_path() / "wip_cppcheck_project_test";
+    std::filesystem::remove_all(temp_dir);
+    std::filesystem::create_directories(temp_dir / "build");
+    std::ofstream(temp_dir / "listed.cpp") << "\n";
+    std::ofstream(temp_dir / "unlisted.cpp") << "\n";
+    
+    nlohmann::json database = nlohmann::json::array();
+    database.push_back({{"directory", temp_dir.string()}, {"file", "listed.cpp"}, {"command", "c++ -c listed.cpp"}});
+    std::ofstream(temp_dir / "build" / "compile_commands.json") << database.dump();
+    
+    AnalysisRequest request;
+    request.source_path = temp_dir.string();
+    request.output_file = "out.xml";
+    
+    // Only the TUs that are built are listed
+    auto units = tool_->get_translation_units(request);
+    ASSERT_EQ(units.size(), 1u);
+    EXPECT_EQ(std::filesystem::path(units[0]).filename(), "listed.cpp");
+    
+    // A shard is analyzed with the project's flags, restricted to its files
+    request.source_files = units;
+    auto cmdline = tool_->build_command_line(request);
+    std::string project_arg = "--project=" + (temp_dir / "build" / "compile_commands.json").string();
+    EXPECT_NE(std::find(cmdline.begin(), cmdline.end(), project_arg), cmdline.end());
+    EXPECT_NE(std::find(cmdline.begin(), cmdline.end(), "--file-filter=" + units[0]), cmdline.end());
+    EXPECT_EQ(std::find(cmdline.begin(), cmdline.end(), units[0]), cmdline.end());
+    
+    // Turning the mode off restores the plain source list
+    auto config = std::make_unique<CppcheckConfig>();
+    config->use_compilation_database = false;
+    tool_->set_configuration(std::move(config));
+    AnalysisRequest tree_request;
+    tree_request.source_path = temp_dir.string();
+    EXPECT_EQ(tool_->get_translation_units(tree_request).size(), 2u);
+    cmdline = tool_->build_command_line(request);
+    EXPECT_EQ(std::find(cmdline.begin(), cmdline.end(), project_arg), cmdline.end());
+    EXPECT_EQ(cmdline.back(), units[0]);
+    
+    // Excluded units are left out of the walked source path
+    tree_request.exclude_patterns = {"unlisted.cpp"};
+    cmdline = tool_->build_command_line(tree_request);
+    EXPECT_EQ(cmdline.back(), (temp_dir / "listed.cpp").string());
+    EXPECT_EQ(std::find(cmdline.begin(), cmdline.end(), temp_dir.string()), cmdline.end());
+    
+    std::filesystem::remove_all(temp_dir);
+}
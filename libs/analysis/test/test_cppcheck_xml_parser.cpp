@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include "tools/cppcheck_xml_parser.h"
+#include "tools/cppcheck_tool.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+using namespace wip::analysis::tools;
+using namespace wip::analysis;
+
+namespace {
+
+const char* SAMPLE_REPORT = R"(<?xml version="1.0" encoding="UTF-8"?>
+<results version="2">
+    <cppcheck version="2.12.0"/>
+    <errors>
+        <!-- comment with a > and a ' inside -->
+        <error id="nullPointer" severity="error" msg="Null pointer dereference: p" verbose="Null pointer dereference: p" cwe="476" file0="src/main.cpp">
+            <location file="src/main.cpp" line="42" column="7" info="Null pointer dereference"/>
+            <location file="src/helper.h" line="3" column="1" info="Assignment 'p=nullptr'"/>
+            <symbol>p</symbol>
+        </error>
+        <error id="passedByValue" severity="performance" msg="Function parameter &apos;s&apos; should be passed by const reference &amp; not &lt;copied&gt;." verbose="x">
+            <location file="src/util.cpp" line="10" column="20"/>
+        </error>
+        <error id="missingIncludeSystem" severity="information" msg="Include file not found"/>
+    </errors>
+</results>
+)";
+
+std::vector<CppcheckXmlError> parse_in_chunks(const std::string& xml, size_t chunk_size) {
+    std::vector<CppcheckXmlError> errors;
+    CppcheckXmlParser parser([&errors](const CppcheckXmlError& error) { errors.push_back(error); });
+    for (size_t pos = 0; pos < xml.size(); pos += chunk_size) {
+        parser.feed(std::string_view(xml).substr(pos, chunk_size));
+    }
+    parser.finish();
+    return errors;
+}
+
+} // namespace
+
+class CppcheckXmlParserTest : public ::testing::Test {
+};
+
+TEST_F(CppcheckXmlParserTest, ParsesErrorsAndPrimaryLocation) {
+    auto errors = parse_in_chunks(SAMPLE_REPORT, 4096);
+    ASSERT_EQ(errors.size(), 3u);
+    
+    EXPECT_EQ(errors[0].id, "nullPointer");
+    EXPECT_EQ(errors[0].severity, "error");
+    EXPECT_EQ(errors[0].message, "Null pointer dereference: p");
+    EXPECT_EQ(errors[0].cwe, "476");
+    EXPECT_EQ(errors[0].file_path, "src/main.cpp");
+    EXPECT_EQ(errors[0].line_number, 42);
+    EXPECT_EQ(errors[0].column_number, 7);
+    
+    EXPECT_EQ(errors[1].id, "passedByValue");
+    EXPECT_EQ(errors[1].message, "Function parameter 's' should be passed by const reference & not <copied>.");
+    EXPECT_EQ(errors[1].file_path, "src/util.cpp");
+    EXPECT_EQ(errors[1].line_number, 10);
+    
+    // Self-closing error without location
+    EXPECT_EQ(errors[2].id, "missingIncludeSystem");
+    EXPECT_TRUE(errors[2].file_path.empty());
+    EXPECT_EQ(errors[2].line_number, 0);
+}
+
+TEST_F(CppcheckXmlParserTest, ChunkBoundariesDoNotMatter) {
+    auto reference = parse_in_chunks(SAMPLE_REPORT, 1 << 20);
+    
+    for (size_t chunk_size : {1u, 2u, 3u, 7u, 64u}) {
+        auto errors = parse_in_chunks(SAMPLE_REPORT, chunk_size);
+        ASSERT_EQ(errors.size(), reference.size()) << "chunk size " << chunk_size;
+        for (size_t i = 0; i < errors.size(); ++i) {
+            EXPECT_EQ(errors[i].id, reference[i].id);
+            EXPECT_EQ(errors[i].message, reference[i].message);
+            EXPECT_EQ(errors[i].file_path, reference[i].file_path);
+            EXPECT_EQ(errors[i].line_number, reference[i].line_number);
+        }
+    }
+}
+
+TEST_F(CppcheckXmlParserTest, VersionOneAttributes) {
+    auto errors = parse_in_chunks(
+        "<results><error file=\"a.cpp\" line=\"5\" id=\"unusedVariable\" severity=\"style\" msg=\"Unused\"/></results>", 16);
+    ASSERT_EQ(errors.size(), 1u);
+    EXPECT_EQ(errors[0].file_path, "a.cpp");
+    EXPECT_EQ(errors[0].line_number, 5);
+}
+
+TEST_F(CppcheckXmlParserTest, TruncatedReport) {
+    std::string xml = "<results><errors><error id=\"a\" severity=\"error\" msg=\"m\"><location file=\"f.cpp\" line=\"1\"/>"
+                      "<error id=\"b\" sev";
+    auto errors = parse_in_chunks(xml, 5);
+    ASSERT_EQ(errors.size(), 1u);
+    EXPECT_EQ(errors[0].id, "a");
+    EXPECT_EQ(errors[0].file_path, "f.cpp");
+}
+
+TEST_F(CppcheckXmlParserTest, MalformedNumbersDoNotThrow) {
+    auto errors = parse_in_chunks("<error id=\"x\"><location file=\"f.cpp\" line=\"abc\" column=\"\"/></error>", 8);
+    ASSERT_EQ(errors.size(), 1u);
+    EXPECT_EQ(errors[0].line_number, 0);
+    EXPECT_EQ(errors[0].column_number, 0);
+}
+
+TEST_F(CppcheckXmlParserTest, DecodeEntities) {
+    EXPECT_EQ(CppcheckXmlParser::decode_entities("plain"), "plain");
+    EXPECT_EQ(CppcheckXmlParser::decode_entities("a &lt; b &amp;&amp; c &gt; d"), "a < b && c > d");
+    EXPECT_EQ(CppcheckXmlParser::decode_entities("&#65;&#x42;"), "AB");
+    EXPECT_EQ(CppcheckXmlParser::decode_entities("&#xE9;"), "\xC3\xA9");
+    EXPECT_EQ(CppcheckXmlParser::decode_entities("&unknown; &"), "&unknown; &");
+}
+
+TEST_F(CppcheckXmlParserTest, ToolStreamsIssuesFromFile) {
+    auto path = std::filesystem::temp_directory_path() / "wip_cppcheck_stream_test.xml";
+    std::ofstream(path) << SAMPLE_REPORT;
+    
+    CppcheckTool tool;
+    std::vector<AnalysisIssue> issues;
+    size_t count = tool.stream_results_file(path.string(), [&issues](const AnalysisIssue& issue) {
+        issues.push_back(issue);
+    });
+    
+    EXPECT_EQ(count, 3u);
+    ASSERT_EQ(issues.size(), 3u);
+    EXPECT_EQ(issues[0].rule_id, "nullPointer");
+    EXPECT_EQ(issues[0].severity, IssueSeverity::Error);
+    EXPECT_EQ(issues[0].tool_name, "cppcheck");
+    EXPECT_EQ(issues[1].category, IssueCategory::Performance);
+    
+    auto result = tool.parse_results_file(path.string());
+    EXPECT_TRUE(result.success);
+    EXPECT_EQ(result.issues.size(), 3u);
+    EXPECT_EQ(result.get_issue_count(IssueSeverity::Error), 1u);
+    
+    std::filesystem::remove(path);
+}
+
+TEST_F(CppcheckXmlParserTest, MissingFile) {
+    EXPECT_THROW(CppcheckXmlParser::parse_file("/nonexistent/report.xml", nullptr), std::runtime_error);
+    
+    CppcheckTool tool;
+    auto result = tool.parse_results_file("/nonexistent/report.xml");
+    EXPECT_FALSE(result.success);
+}
@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include "distributed_analysis.h"
+#include "analysis_engine.h"
+#include "tools/banned_token_tool.h"
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <thread>
+
+using namespace wip::analysis;
+using wip::utils::net::Endpoint;
+
+namespace {
+
+// banned-tokens as if it were an external tool, so the engine hands its shards to the executor
+class RemoteBannedTokenTool : public tools::BannedTokenTool {
+public:
+    bool runs_in_process() const override { return false; }
+};
+
+// Worker serving on a loopback port from its own thread
+class LocalWorker {
+public:
+    explicit LocalWorker(size_t slots)
+        : worker_(0, AnalysisWorker::Options{slots, "127.0.0.1"}),
+          thread_([this]() { worker_.serve(); }) {}
+
+    ~LocalWorker() {
+        stop();
+    }
+
+    void stop() {
+        worker_.stop();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+    Endpoint endpoint() const { return Endpoint{"127.0.0.1", worker_.get_port()}; }
+    AnalysisWorker& get() { return worker_; }
+
+private:
+    AnalysisWorker worker_;
+    std::thread thread_;
+};
+
+} // namespace
+
+class DistributedAnalysisTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        project_dir_ = std::filesystem::temp_directory_path() / "wip_distributed_analysis_test";
+        std::filesystem::remove_all(project_dir_);
+        std::filesystem::create_directories(project_dir_ / "src");
+        for (int i = 0; i < 24; ++i) {
+            std::ofstream(project_dir_ / "src" / ("file" + std::to_string(i) + ".cpp"))
+                << "void f(char* out) {\n    strcpy(out, \"" << i << "\");\n    gets(out);\n}\n";
+        }
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(project_dir_);
+    }
+
+    AnalysisRequest make_request() const {
+        AnalysisRequest request;
+        request.source_path = project_dir_.string();
+        return request;
+    }
+
+    static std::unique_ptr<AnalysisEngine> make_engine() {
+        auto engine = std::make_unique<AnalysisEngine>();
+        engine->register_tool(std::make_unique<RemoteBannedTokenTool>());
+        engine->set_concurrency(4);
+        return engine;
+    }
+
+    static AnalysisResult run(AnalysisEngine& engine, const AnalysisRequest& request) {
+        auto results = engine.analyze_async({"banned-tokens"}, request).get();
+        EXPECT_EQ(results.size(), 1u);
+        return results.empty() ? AnalysisResult{} : results[0];
+    }
+
+    std::filesystem::path project_dir_;
+};
+
+TEST_F(DistributedAnalysisTest, RemoteRunMatchesLocalRun) {
+    auto local = run(*make_engine(), make_request());
+    ASSERT_TRUE(local.success) << local.error_message;
+    ASSERT_EQ(local.issues.size(), 48u);
+
+    LocalWorker first(2);
+    LocalWorker second(3);
+    auto coordinator = std::make_shared<AnalysisCoordinator>(std::vector<Endpoint>{first.endpoint(), second.endpoint()});
+    ASSERT_EQ(coordinator->connect(), 5u);
+    EXPECT_EQ(coordinator->get_worker_count(), 2u);
+
+    auto engine = make_engine();
+    engine->set_shard_executor(coordinator);
+    auto remote = run(*engine, make_request());
+    ASSERT_TRUE(remote.success) << remote.error_message;
+    EXPECT_EQ(remote.files_analyzed, local.files_analyzed);
+    EXPECT_EQ(remote.issues, local.issues);
+    EXPECT_EQ(remote.issue_counts_by_severity, local.issue_counts_by_severity);
+    EXPECT_GT(first.get().get_shard_count() + second.get().get_shard_count(), 1u);
+    EXPECT_EQ(coordinator->get_requeue_count(), 0u);
+}
+
+TEST_F(DistributedAnalysisTest, ShardsOfLostWorkerAreRequeued) {
+    auto local = run(*make_engine(), make_request());
+
+    LocalWorker lost(2);
+    LocalWorker kept(2);
+    auto coordinator = std::make_shared<AnalysisCoordinator>(std::vector<Endpoint>{lost.endpoint(), kept.endpoint()});
+    ASSERT_EQ(coordinator->connect(), 4u);
+    lost.stop();
+
+    auto engine = make_engine();
+    engine->set_shard_executor(coordinator);
+    auto remote = run(*engine, make_request());
+    ASSERT_TRUE(remote.success) << remote.error_message;
+    EXPECT_EQ(remote.issues, local.issues);
+    EXPECT_GE(coordinator->get_requeue_count(), 1u);
+    EXPECT_EQ(coordinator->get_worker_count(), 1u);
+    EXPECT_EQ(coordinator->get_slot_count(), 2u);
+    EXPECT_GT(kept.get().get_shard_count(), 0u);
+}
+
+TEST_F(DistributedAnalysisTest, ShardFailsWithoutWorkers) {
+    uint16_t port;
+    {
+        wip::utils::net::TcpListener listener(0, "127.0.0.1");
+        port = listener.get_port();
+    }
+    AnalysisCoordinator coordinator({Endpoint{"127.0.0.1", port}});
+    EXPECT_EQ(coordinator.connect(), 0u);
+    EXPECT_EQ(coordinator.get_worker_count(), 0u);
+
+    RemoteBannedTokenTool tool;
+    auto result = coordinator.execute_shard(tool, make_request());
+    EXPECT_FALSE(result.success);
+    EXPECT_EQ(result.tool_name, "banned-tokens");
+    EXPECT_FALSE(result.error_message.empty());
+}
+
+TEST_F(DistributedAnalysisTest, WorkerRefusesOtherToolVersion) {
+    class NewerTool : public RemoteBannedTokenTool {
+    public:
+        std::string get_version() const override { return "99.0"; }
+    };
+
+    LocalWorker worker(1);
+    AnalysisCoordinator coordinator({worker.endpoint()});
+    ASSERT_EQ(coordinator.connect(), 1u);
+
+    NewerTool tool;
+    auto result = coordinator.execute_shard(tool, make_request());
+    EXPECT_FALSE(result.success);
+    EXPECT_NE(result.error_message.find("99.0"), std::string::npos) << result.error_message;
+    EXPECT_EQ(coordinator.get_requeue_count(), 0u);
+
+    // The connection stays usable
+    RemoteBannedTokenTool current;
+    EXPECT_TRUE(coordinator.execute_shard(current, make_request()).success);
+}
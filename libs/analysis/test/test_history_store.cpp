@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+#include "history_store.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace wip::analysis;
+
+class HistoryStoreTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        directory_ = std::filesystem::temp_directory_path() / "wip_history_store_test";
+        std::filesystem::remove_all(directory_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory_);
+    }
+
+    static AnalysisIssue make_issue(const std::string& file, int line, const std::string& rule) {
+        AnalysisIssue issue;
+        issue.id = file + ":" + std::to_string(line);
+        issue.message = "Message for " + rule;
+        issue.file_path = file;
+        issue.line_number = line;
+        issue.column_number = 4;
+        issue.severity = rule == "nullPointer" ? IssueSeverity::Error : IssueSeverity::Warning;
+        issue.category = rule == "nullPointer" ? IssueCategory::Bug : IssueCategory::Style;
+        issue.rule_id = rule;
+        issue.tool_name = "cppcheck";
+        return issue;
+    }
+
+    // Run with `count` issues in src/main.cpp and one in src/util.cpp
+    static std::vector<AnalysisResult> make_run(int count) {
+        AnalysisResult cppcheck;
+        cppcheck.tool_name = "cppcheck";
+        cppcheck.analysis_id = "run-" + std::to_string(count);
+        cppcheck.timestamp = std::chrono::system_clock::now();
+        cppcheck.files_analyzed = 2;
+        cppcheck.execution_time = std::chrono::milliseconds(100 + count);
+        cppcheck.success = true;
+        for (int i = 0; i < count; ++i) {
+            cppcheck.issues.push_back(make_issue("src/main.cpp", 10 * (count - i), i % 2 ? "nullPointer" : "unusedVariable"));
+        }
+        cppcheck.issues.push_back(make_issue("src/util.cpp", 3, "unusedVariable"));
+        cppcheck.issues.back().fix_suggestion = "Remove the variable";
+        cppcheck.compute_statistics();
+
+        AnalysisResult clang_tidy;
+        clang_tidy.tool_name = "clang-tidy";
+        clang_tidy.success = false;
+        clang_tidy.error_message = "clang-tidy not found";
+        return {cppcheck, clang_tidy};
+    }
+
+    std::filesystem::path directory_;
+};
+
+TEST_F(HistoryStoreTest, AppendAndReadRun) {
+    HistoryStore history(directory_.string());
+    EXPECT_EQ(history.get_run_count(), 0);
+
+    auto results = make_run(3);
+    EXPECT_EQ(history.append_run(results), 1);
+
+    auto run = history.get_run(1);
+    ASSERT_TRUE(run.has_value());
+    EXPECT_EQ(run->issue_count, 4);
+    EXPECT_EQ(run->files_analyzed, 2);
+    EXPECT_EQ(run->execution_time, std::chrono::milliseconds(103));
+    EXPECT_FALSE(run->success);
+    EXPECT_EQ(run->issue_counts_by_severity[static_cast<size_t>(IssueSeverity::Error)], 1);
+    EXPECT_EQ(run->issue_counts_by_category[static_cast<size_t>(IssueCategory::Style)], 3);
+    EXPECT_FALSE(history.get_run(2).has_value());
+
+    auto loaded = history.read_run(1);
+    ASSERT_EQ(loaded.size(), 2);
+    EXPECT_EQ(loaded[0].tool_name, "cppcheck");
+    EXPECT_EQ(loaded[0].analysis_id, "run-3");
+    ASSERT_EQ(loaded[0].issues.size(), 4);
+    EXPECT_EQ(loaded[0].issues[0].line_number, 10);
+    EXPECT_EQ(loaded[0].issues[3].file_path, "src/util.cpp");
+    EXPECT_EQ(*loaded[0].issues[3].fix_suggestion, "Remove the variable");
+    EXPECT_EQ(loaded[0].issue_counts_by_severity, results[0].issue_counts_by_severity);
+    EXPECT_EQ(loaded[1].error_message, "clang-tidy not found");
+    EXPECT_TRUE(loaded[1].issues.empty());
+
+    EXPECT_THROW(history.read_run(7), std::out_of_range);
+}
+
+TEST_F(HistoryStoreTest, FileAndRuleQueries) {
+    HistoryStore history(directory_.string());
+    for (int count : {1, 4, 0, 2}) {
+        history.append_run(make_run(count));
+    }
+
+    auto file = history.get_issues_in_file("src/main.cpp", 3);
+    ASSERT_EQ(file.size(), 3);
+    EXPECT_EQ(file[0].run.run_id, 2);
+    EXPECT_EQ(file[0].issues.size(), 4);
+    EXPECT_TRUE(file[1].issues.empty());
+    ASSERT_EQ(file[2].issues.size(), 2);
+    EXPECT_EQ(file[2].issues[0].line_number, 10);
+    EXPECT_EQ(file[2].issues[1].line_number, 20);
+
+    auto rule = history.get_issues_for_rule("nullPointer", 0);
+    ASSERT_EQ(rule.size(), 4);
+    EXPECT_EQ(rule[1].issues.size(), 2);
+    for (const auto& issue : rule[1].issues) {
+        EXPECT_EQ(issue.rule_id, "nullPointer");
+    }
+
+    std::vector<size_t> file_counts;
+    for (const auto& point : history.get_file_trend("src/main.cpp", 0)) {
+        file_counts.push_back(point.issue_count);
+    }
+    EXPECT_EQ(file_counts, (std::vector<size_t>{1, 4, 0, 2}));
+
+    std::vector<size_t> rule_counts;
+    for (const auto& point : history.get_rule_trend("unusedVariable", 2)) {
+        rule_counts.push_back(point.issue_count);
+    }
+    EXPECT_EQ(rule_counts, (std::vector<size_t>{1, 2}));
+
+    EXPECT_EQ(history.get_file_trend("src/missing.cpp", 0)[3].issue_count, 0);
+}
+
+TEST_F(HistoryStoreTest, ReopenAndRollSegments) {
+    {
+        HistoryStore history(directory_.string(), 1024);
+        for (int count = 0; count < 6; ++count) {
+            history.append_run(make_run(count));
+        }
+    }
+    size_t segments = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(directory_)) {
+        segments += entry.path().extension() == ".wips";
+    }
+    EXPECT_GT(segments, 1);
+
+    HistoryStore history(directory_.string(), 1024);
+    EXPECT_EQ(history.get_run_count(), 6);
+    EXPECT_EQ(history.get_runs(2).front().run_id, 5);
+    EXPECT_EQ(history.append_run(make_run(2)), 7);
+    EXPECT_EQ(history.read_run(6)[0].issues.size(), 6);
+    EXPECT_EQ(history.get_file_trend("src/main.cpp", 0).back().issue_count, 2);
+}
+
+TEST_F(HistoryStoreTest, TornCatalogRecordIsDropped) {
+    {
+        HistoryStore history(directory_.string());
+        history.append_run(make_run(1));
+        history.append_run(make_run(2));
+    }
+    auto catalog = directory_ / "catalog.wiph";
+    std::filesystem::resize_file(catalog, std::filesystem::file_size(catalog) - 10);
+
+    HistoryStore history(directory_.string());
+    EXPECT_EQ(history.get_run_count(), 1);
+    EXPECT_EQ(history.append_run(make_run(3)), 2);
+    EXPECT_EQ(history.read_run(2)[0].issues.size(), 4);
+
+    HistoryStore reopened(directory_.string());
+    EXPECT_EQ(reopened.get_run_count(), 2);
+}
+
+TEST_F(HistoryStoreTest, RejectsForeignCatalog) {
+    std::filesystem::create_directories(directory_);
+    std::ofstream(directory_ / "catalog.wiph") << "not a history catalog";
+    EXPECT_THROW(HistoryStore(directory_.string()), std::runtime_error);
+}
@@ -0,0 +1,219 @@
+#include <gtest/gtest.h>
+#include "include_graph.h"
+#include "analysis_cache.h"
+#include <filesystem>
+#include <fstream>
+#include <memory>
+
+using namespace wip::analysis;
+
+class IncludeGraphTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        project_dir_ = std::filesystem::temp_directory_path() / "wip_include_graph_test";
+        std::filesystem::remove_all(project_dir_);
+        std::filesystem::create_directories(project_dir_ / "src");
+        std::filesystem::create_directories(project_dir_ / "include");
+
+        request_.source_path = project_dir_.string();
+        request_.include_paths = {"include"};
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(project_dir_);
+    }
+
+    void write_file(const std::string& relative_path, const std::string& contents) {
+        std::ofstream(project_dir_ / relative_path) << contents;
+    }
+
+    std::string path(const std::string& relative_path) const {
+        return (project_dir_ / relative_path).lexically_normal().string();
+    }
+
+    std::filesystem::path project_dir_;
+    AnalysisRequest request_;
+};
+
+TEST_F(IncludeGraphTest, ScanIncludesFindsDirectives) {
+    std::vector<std::pair<std::string, bool>> includes;
+    IncludeGraph::scan_includes("#include \"a.h\"\n  #  include <vector>\n// #include \"b.h\"\n#include \"broken\n#define X\n"
+                                "\t#include\t\"c.h\"", includes);
+
+    ASSERT_EQ(includes.size(), 3u);
+    EXPECT_EQ(includes[0], std::make_pair(std::string("a.h"), true));
+    EXPECT_EQ(includes[1], std::make_pair(std::string("vector"), false));
+    EXPECT_EQ(includes[2], std::make_pair(std::string("c.h"), true));
+}
+
+TEST_F(IncludeGraphTest, ResolvesLikeACompiler) {
+    write_file("src/main.cpp", "#include \"local.h\"\n#include \"shared.h\"\n#include <config.h>\n#include <vector>\n");
+    write_file("src/local.h", "");
+    write_file("src/config.h", "");
+    write_file("include/shared.h", "#include \"config.h\"\n");
+    write_file("include/config.h", "");
+
+    IncludeGraph graph(request_);
+    EXPECT_EQ(graph.scan({"src/main.cpp"}), 4u);
+
+    // Angle includes skip the including directory, quoted ones look there first
+    auto main_file = graph.get_file(path("src/main.cpp"));
+    EXPECT_TRUE(main_file.exists);
+    EXPECT_EQ(main_file.includes, (std::vector<std::string>{path("src/local.h"), path("include/shared.h"),
+                                                           path("include/config.h")}));
+    EXPECT_EQ(main_file.include_names, (std::vector<std::string>{"local.h", "shared.h", "config.h", "vector"}));
+    EXPECT_EQ(graph.get_closure(path("src/main.cpp")),
+              (std::vector<std::string>{path("include/config.h"), path("include/shared.h"), path("src/local.h")}));
+    EXPECT_EQ(graph.get_includers(path("include/config.h")),
+              (std::vector<std::string>{path("include/shared.h"), path("src/main.cpp")}));
+    EXPECT_EQ(graph.get_content_hash(path("src/local.h")), AnalysisCache::hash_content(""));
+    EXPECT_EQ(graph.get_units(), (std::vector<std::string>{path("src/main.cpp")}));
+}
+
+TEST_F(IncludeGraphTest, AffectedUnitsFollowTheReverseIndex) {
+    write_file("include/base.h", "");
+    write_file("include/widget.h", "#include \"base.h\"\n");
+    write_file("include/other.h", "");
+    write_file("src/a.cpp", "#include \"widget.h\"\n");
+    write_file("src/b.cpp", "#include \"base.h\"\n");
+    write_file("src/c.cpp", "#include \"other.h\"\n");
+
+    IncludeGraph graph(request_);
+    graph.scan({"src/a.cpp", "src/b.cpp", "src/c.cpp"});
+
+    EXPECT_EQ(graph.get_affected_units({path("include/base.h")}),
+              (std::vector<std::string>{path("src/a.cpp"), path("src/b.cpp")}));
+    EXPECT_EQ(graph.get_affected_units({path("include/widget.h")}), (std::vector<std::string>{path("src/a.cpp")}));
+    EXPECT_EQ(graph.get_affected_units({"src/c.cpp"}), (std::vector<std::string>{path("src/c.cpp")}));
+    EXPECT_TRUE(graph.get_affected_units({path("include/unknown.h")}).empty());
+}
+
+TEST_F(IncludeGraphTest, IncludeCyclesTerminate) {
+    write_file("include/a.h", "#include \"b.h\"\n");
+    write_file("include/b.h", "#include \"a.h\"\n");
+    write_file("src/main.cpp", "#include \"a.h\"\n#include \"main.cpp\"\n");
+
+    IncludeGraph graph(request_);
+    EXPECT_EQ(graph.scan({"src/main.cpp"}), 3u);
+    EXPECT_EQ(graph.get_closure(path("src/main.cpp")),
+              (std::vector<std::string>{path("include/a.h"), path("include/b.h")}));
+    EXPECT_EQ(graph.get_affected_units({path("include/b.h")}), (std::vector<std::string>{path("src/main.cpp")}));
+}
+
+TEST_F(IncludeGraphTest, UpdateRescansChangedFilesAndTheirEdges) {
+    write_file("include/old.h", "");
+    write_file("include/new.h", "");
+    write_file("src/main.cpp", "#include \"old.h\"\n");
+    write_file("src/other.cpp", "#include \"new.h\"\n");
+
+    IncludeGraph graph(request_);
+    graph.scan({"src/main.cpp", "src/other.cpp"});
+    std::string old_hash = graph.get_content_hash(path("src/main.cpp"));
+
+    write_file("src/main.cpp", "#include \"new.h\"\n");
+    EXPECT_EQ(graph.update({path("src/main.cpp")}), (std::vector<std::string>{path("src/main.cpp")}));
+    EXPECT_NE(graph.get_content_hash(path("src/main.cpp")), old_hash);
+    EXPECT_TRUE(graph.get_includers(path("include/old.h")).empty());
+    EXPECT_EQ(graph.get_affected_units({path("include/new.h")}),
+              (std::vector<std::string>{path("src/main.cpp"), path("src/other.cpp")}));
+
+    // An unrelated file is not part of the graph and reaches nothing
+    EXPECT_TRUE(graph.update({path("src/notes.txt")}).empty());
+}
+
+TEST_F(IncludeGraphTest, UpdateScansNewlyIncludedHeaders) {
+    write_file("src/main.cpp", "");
+    write_file("include/extra.h", "#include \"deep.h\"\n");
+    write_file("include/deep.h", "");
+
+    IncludeGraph graph(request_);
+    EXPECT_EQ(graph.scan({"src/main.cpp"}), 1u);
+
+    write_file("src/main.cpp", "#include \"extra.h\"\n");
+    graph.update({path("src/main.cpp")});
+    EXPECT_EQ(graph.get_file_count(), 3u);
+    EXPECT_EQ(graph.get_affected_units({path("include/deep.h")}), (std::vector<std::string>{path("src/main.cpp")}));
+}
+
+TEST_F(IncludeGraphTest, CreatedFileShadowsAnInclude) {
+    write_file("src/main.cpp", "#include \"config.h\"\n");
+    write_file("src/other.cpp", "#include \"other.h\"\n");
+    write_file("include/config.h", "");
+
+    IncludeGraph graph(request_);
+    graph.scan({"src/main.cpp", "src/other.cpp"});
+    EXPECT_EQ(graph.get_closure(path("src/main.cpp")), (std::vector<std::string>{path("include/config.h")}));
+
+    // A config.h next to the unit now wins over the include path
+    write_file("src/config.h", "");
+    EXPECT_EQ(graph.update({path("src/config.h")}), (std::vector<std::string>{path("src/main.cpp")}));
+    EXPECT_EQ(graph.get_closure(path("src/main.cpp")), (std::vector<std::string>{path("src/config.h")}));
+
+    std::filesystem::remove(project_dir_ / "src/config.h");
+    EXPECT_EQ(graph.update({path("src/config.h")}), (std::vector<std::string>{path("src/main.cpp")}));
+    EXPECT_EQ(graph.get_closure(path("src/main.cpp")), (std::vector<std::string>{path("include/config.h")}));
+}
+
+TEST_F(IncludeGraphTest, RemovedUnitsAreDropped) {
+    write_file("include/common.h", "");
+    write_file("src/a.cpp", "#include \"common.h\"\n");
+    write_file("src/b.cpp", "#include \"common.h\"\n");
+
+    IncludeGraph graph(request_);
+    graph.scan({"src/a.cpp", "src/b.cpp"});
+
+    std::filesystem::remove(project_dir_ / "src/b.cpp");
+    EXPECT_TRUE(graph.update({path("src/b.cpp")}).empty());
+    EXPECT_EQ(graph.get_units(), (std::vector<std::string>{path("src/a.cpp")}));
+    EXPECT_EQ(graph.get_affected_units({path("include/common.h")}), (std::vector<std::string>{path("src/a.cpp")}));
+}
+
+TEST_F(IncludeGraphTest, ScanOnlyReadsNewAndChangedFiles) {
+    write_file("include/common.h", "");
+    write_file("src/a.cpp", "#include \"common.h\"\n");
+    write_file("src/b.cpp", "#include \"common.h\"\n");
+
+    IncludeGraph graph(request_, 2);
+    EXPECT_EQ(graph.scan({"src/a.cpp", "src/b.cpp"}), 3u);
+    EXPECT_EQ(graph.scan({"src/a.cpp", "src/b.cpp"}), 0u);
+
+    // A different size is noticed without an update()
+    write_file("include/common.h", "int common();\n");
+    EXPECT_EQ(graph.scan({"src/a.cpp", "src/b.cpp"}), 1u);
+    EXPECT_EQ(graph.get_content_hash(path("include/common.h")), AnalysisCache::hash_content("int common();\n"));
+}
+
+TEST_F(IncludeGraphTest, MatchesRequestsResolvingTheSameWay) {
+    IncludeGraph graph(request_);
+    EXPECT_EQ(graph.get_base_directory(), project_dir_.lexically_normal().string());
+    EXPECT_TRUE(graph.matches(request_));
+
+    AnalysisRequest other = request_;
+    other.include_paths.push_back("third_party");
+    EXPECT_FALSE(graph.matches(other));
+
+    other = request_;
+    other.source_path = (project_dir_ / "src").string();
+    EXPECT_FALSE(graph.matches(other));
+}
+
+TEST_F(IncludeGraphTest, CacheReusesASharedGraph) {
+    write_file("include/common.h", "");
+    write_file("src/a.cpp", "#include \"common.h\"\n");
+
+    auto graph = std::make_shared<IncludeGraph>(request_);
+    AnalysisCache cache;
+    cache.set_include_graph(graph);
+    EXPECT_EQ(cache.get_include_graph(), graph);
+
+    auto plan = cache.plan("tool", "1.0", "config", {"src/a.cpp"}, request_);
+    EXPECT_EQ(graph->get_file_count(), 2u);
+    EXPECT_EQ(plan.states[path("src/a.cpp")].closure, (std::vector<std::string>{path("include/common.h")}));
+
+    // A request resolving includes differently gets a graph of its own
+    AnalysisRequest other = request_;
+    other.include_paths.clear();
+    plan = cache.plan("tool", "1.0", "config", {"src/a.cpp"}, other);
+    EXPECT_TRUE(plan.states[path("src/a.cpp")].closure.empty());
+    EXPECT_EQ(graph->get_closure(path("src/a.cpp")), (std::vector<std::string>{path("include/common.h")}));
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include "issue_search_index.h"
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <vector>
+
+using namespace wip::analysis;
+
+class IssueSearchIndexTest : public ::testing::Test {
+protected:
+    static AnalysisIssue make_issue(const std::string& file, const std::string& rule, const std::string& message) {
+        AnalysisIssue issue;
+        issue.id = rule;
+        issue.file_path = file;
+        issue.rule_id = rule;
+        issue.message = message;
+        issue.tool_name = "cppcheck";
+        return issue;
+    }
+
+    static std::vector<AnalysisIssue> generate_issues(size_t count) {
+        std::vector<AnalysisIssue> issues;
+        for (size_t i = 0; i < count; ++i) {
+            issues.push_back(make_issue("src/Module" + std::to_string(i % 7) + "/file_" + std::to_string(i % 23) + ".cpp",
+                                        "rule" + std::to_string(i % 11),
+                                        "Variable 'Value" + std::to_string(i % 13) + "' is never used"));
+        }
+        return issues;
+    }
+
+    // Reference result: a linear, case insensitive scan
+    static std::vector<uint32_t> scan(const std::vector<AnalysisIssue>& issues, std::string text) {
+        auto lower = [](std::string value) {
+            std::transform(value.begin(), value.end(), value.begin(), [](unsigned char c) { return std::tolower(c); });
+            return value;
+        };
+        text = lower(text);
+        std::vector<uint32_t> matches;
+        for (size_t i = 0; i < issues.size(); ++i) {
+            const auto& issue = issues[i];
+            if (lower(issue.file_path).find(text) != std::string::npos ||
+                lower(issue.rule_id).find(text) != std::string::npos ||
+                lower(issue.message).find(text) != std::string::npos) {
+                matches.push_back(static_cast<uint32_t>(i));
+            }
+        }
+        return matches;
+    }
+};
+
+TEST_F(IssueSearchIndexTest, MatchesLinearScan) {
+    auto issues = generate_issues(1000);
+    IssueStore store(issues);
+    IssueSearchIndex index(store);
+    EXPECT_EQ(index.get_issue_count(), 1000);
+
+    for (const char* text : {"module3", "FILE_1", "rule1", "value12", "never used", "'value", "e", "_2", "s",
+                             "src/module0/file_0.cpp", "is never", "missing", "xyz", "used'"}) {
+        EXPECT_EQ(index.find(text), scan(issues, text)) << text;
+    }
+}
+
+TEST_F(IssueSearchIndexTest, EmptyTextMatchesEverything) {
+    IssueStore store(generate_issues(5));
+    IssueSearchIndex index(store);
+    EXPECT_EQ(index.find(""), (std::vector<uint32_t>{0, 1, 2, 3, 4}));
+}
+
+TEST_F(IssueSearchIndexTest, IssueListedOnceWhenFieldsShareString) {
+    std::vector<AnalysisIssue> issues = {
+        make_issue("nullPointer", "nullPointer", "nullPointer"),
+        make_issue("a.cpp", "nullPointer", "Null pointer dereference"),
+    };
+    IssueStore store(issues);
+    IssueSearchIndex index(store);
+    EXPECT_EQ(index.find("nullpointer"), (std::vector<uint32_t>{0, 1}));
+    EXPECT_EQ(index.find("null pointer"), (std::vector<uint32_t>{1}));
+    EXPECT_EQ(index.get_string_count(), 3);
+}
+
+TEST_F(IssueSearchIndexTest, EmptyStore) {
+    IssueStore store;
+    IssueSearchIndex index(store);
+    EXPECT_TRUE(index.find("anything").empty());
+    EXPECT_TRUE(index.find("").empty());
+    EXPECT_TRUE(IssueSearchIndex().find("x").empty());
+}
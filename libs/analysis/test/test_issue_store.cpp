@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include "issue_store.h"
+#include <string>
+#include <vector>
+
+using namespace wip::analysis;
+
+class IssueStoreTest : public ::testing::Test {
+protected:
+    static AnalysisIssue make_issue(const std::string& file, int line, IssueSeverity severity,
+                                    IssueCategory category, const std::string& rule) {
+        AnalysisIssue issue;
+        issue.id = rule + "@" + file + ":" + std::to_string(line);
+        issue.message = "Message for " + rule;
+        issue.file_path = file;
+        issue.line_number = line;
+        issue.column_number = line % 7;
+        issue.severity = severity;
+        issue.category = category;
+        issue.rule_id = rule;
+        issue.tool_name = "cppcheck";
+        return issue;
+    }
+
+    std::vector<AnalysisIssue> sample_issues() const {
+        auto fixed = make_issue("src/b.cpp", 3, IssueSeverity::Info, IssueCategory::Modernization, "use-auto");
+        fixed.fix_suggestion = "auto x = 1;";
+        return {
+            make_issue("src/a.cpp", 10, IssueSeverity::Error, IssueCategory::Bug, "nullPointer"),
+            make_issue("src/a.cpp", 12, IssueSeverity::Warning, IssueCategory::Style, "unusedVariable"),
+            fixed,
+            make_issue("src/c.cpp", 1, IssueSeverity::Critical, IssueCategory::Security, "bufferOverflow"),
+            make_issue("src/a.cpp", 20, IssueSeverity::Warning, IssueCategory::Performance, "passedByValue"),
+        };
+    }
+};
+
+TEST_F(IssueStoreTest, StringPoolInternsOnce) {
+    StringPool pool;
+    auto first = pool.intern("src/main.cpp");
+    auto second = pool.intern("include/main.h");
+    EXPECT_NE(first, second);
+    EXPECT_EQ(pool.intern(std::string("src/main.cpp")), first);
+    EXPECT_EQ(pool.size(), 2);
+    EXPECT_EQ(pool.get(first), "src/main.cpp");
+
+    StringPool::Id found;
+    EXPECT_TRUE(pool.find("include/main.h", found));
+    EXPECT_EQ(found, second);
+    EXPECT_FALSE(pool.find("missing.cpp", found));
+}
+
+TEST_F(IssueStoreTest, StringPoolViewsStayValid) {
+    StringPool pool;
+    auto id = pool.intern("short");
+    auto view = pool.get(id);
+    for (int i = 0; i < 10000; ++i) {
+        pool.intern("string" + std::to_string(i));
+    }
+    EXPECT_EQ(view, "short");
+    EXPECT_EQ(view.data(), pool.get(id).data());
+}
+
+TEST_F(IssueStoreTest, RoundTrip) {
+    auto issues = sample_issues();
+    IssueStore store(issues);
+
+    ASSERT_EQ(store.size(), issues.size());
+    EXPECT_EQ(store.to_issues(), issues);
+
+    auto view = store[2];
+    EXPECT_EQ(view.file_path(), "src/b.cpp");
+    EXPECT_EQ(view.line_number(), 3);
+    EXPECT_EQ(view.severity(), IssueSeverity::Info);
+    EXPECT_EQ(view.category(), IssueCategory::Modernization);
+    ASSERT_TRUE(view.has_fix_suggestion());
+    EXPECT_EQ(view.fix_suggestion(), "auto x = 1;");
+    EXPECT_FALSE(store[0].has_fix_suggestion());
+    EXPECT_EQ(store[0].key(), issues[0].key());
+}
+
+TEST_F(IssueStoreTest, FiltersMatchAnalysisResult) {
+    AnalysisResult result;
+    result.issues = sample_issues();
+    result.compute_statistics();
+    IssueStore store(result.issues);
+
+    auto serious = store.get_issues_by_severity(IssueSeverity::Error);
+    auto expected_serious = result.get_issues_by_severity(IssueSeverity::Error);
+    ASSERT_EQ(serious.size(), expected_serious.size());
+    for (size_t i = 0; i < serious.size(); ++i) {
+        EXPECT_EQ(serious[i].to_issue(), expected_serious[i]);
+    }
+
+    auto style = store.get_issues_by_category(IssueCategory::Style);
+    ASSERT_EQ(style.size(), 1);
+    EXPECT_EQ(style[0].rule_id(), "unusedVariable");
+
+    EXPECT_EQ(store.count_by_severity(), result.issue_counts_by_severity);
+    EXPECT_EQ(store.count_by_category(), result.issue_counts_by_category);
+}
+
+TEST_F(IssueStoreTest, IssuesInFile) {
+    IssueStore store(sample_issues());
+
+    auto in_a = store.get_issues_in_file("src/a.cpp");
+    ASSERT_EQ(in_a.size(), 3);
+    EXPECT_EQ(in_a[0].get_index(), 0);
+    EXPECT_EQ(in_a[1].get_index(), 1);
+    EXPECT_EQ(in_a[2].get_index(), 4);
+
+    EXPECT_TRUE(store.get_issues_in_file("src/missing.cpp").empty());
+}
+
+TEST_F(IssueStoreTest, ClearAndReuse) {
+    IssueStore store(sample_issues());
+    store.clear();
+    EXPECT_TRUE(store.empty());
+    EXPECT_EQ(store.get_strings().size(), 0);
+
+    store.add(make_issue("x.cpp", 1, IssueSeverity::Warning, IssueCategory::Bug, "rule"));
+    EXPECT_EQ(store.size(), 1);
+    EXPECT_EQ(store[0].file_path(), "x.cpp");
+}
+
+TEST_F(IssueStoreTest, RepeatedStringsAreStoredOnce) {
+    // 100k issues over 500 files and 50 rules, as in a large project
+    std::vector<AnalysisIssue> issues;
+    issues.reserve(100000);
+    size_t string_bytes = 0;
+    for (int i = 0; i < 100000; ++i) {
+        auto issue = make_issue("/home/user/project/src/module" + std::to_string(i % 500) + "/source_file.cpp",
+                                i, IssueSeverity::Warning, IssueCategory::Style, "rule" + std::to_string(i % 50));
+        issue.id.clear();
+        issue.message = "Message for " + issue.rule_id;
+        string_bytes += issue.file_path.size() + issue.rule_id.size() + issue.message.size() + issue.tool_name.size();
+        issues.push_back(std::move(issue));
+    }
+
+    IssueStore store(issues);
+    EXPECT_EQ(store.get_strings().size(), 500 + 50 + 50 + 1 + 1);
+    EXPECT_LT(store.get_memory_usage(), issues.size() * sizeof(AnalysisIssue) / 4);
+    EXPECT_LT(store.get_memory_usage(), string_bytes / 2);
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include "job_scheduler.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
+using namespace wip::analysis;
+
+class JobSchedulerTest : public ::testing::Test {
+};
+
+TEST_F(JobSchedulerTest, DefaultWorkerCount) {
+    JobScheduler scheduler;
+    EXPECT_GE(scheduler.get_worker_count(), 1);
+}
+
+TEST_F(JobSchedulerTest, RunsAllJobs) {
+    JobScheduler scheduler(4);
+    std::atomic<int> counter{0};
+
+    for (int i = 0; i < 1000; ++i) {
+        scheduler.submit([&counter]() { ++counter; });
+    }
+    scheduler.wait();
+
+    EXPECT_EQ(counter.load(), 1000);
+}
+
+TEST_F(JobSchedulerTest, WaitCanBeCalledRepeatedly) {
+    JobScheduler scheduler(2);
+    std::atomic<int> counter{0};
+
+    scheduler.wait();  // Nothing submitted yet
+
+    scheduler.submit([&counter]() { ++counter; });
+    scheduler.wait();
+    EXPECT_EQ(counter.load(), 1);
+
+    scheduler.submit([&counter]() { ++counter; });
+    scheduler.wait();
+    EXPECT_EQ(counter.load(), 2);
+}
+
+TEST_F(JobSchedulerTest, NestedSubmission) {
+    JobScheduler scheduler(3);
+    std::atomic<int> counter{0};
+
+    for (int i = 0; i < 10; ++i) {
+        scheduler.submit([&scheduler, &counter]() {
+            for (int j = 0; j < 10; ++j) {
+                scheduler.submit([&counter]() { ++counter; });
+            }
+        });
+    }
+    scheduler.wait();
+
+    EXPECT_EQ(counter.load(), 100);
+}
+
+TEST_F(JobSchedulerTest, IdleWorkersStealFromBusyOnes) {
+    JobScheduler scheduler(4);
+    std::mutex threads_mutex;
+    std::set<std::thread::id> threads;
+
+    // All jobs are pushed onto one worker's deque; the others must steal them
+    scheduler.submit([&]() {
+        for (int i = 0; i < 40; ++i) {
+            scheduler.submit([&]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                std::lock_guard<std::mutex> lock(threads_mutex);
+                threads.insert(std::this_thread::get_id());
+            });
+        }
+    });
+    scheduler.wait();
+
+    EXPECT_GT(scheduler.get_steal_count(), 0);
+    EXPECT_GT(threads.size(), 1);
+}
+
+TEST_F(JobSchedulerTest, RethrowsFirstException) {
+    JobScheduler scheduler(2);
+    std::atomic<int> counter{0};
+
+    scheduler.submit([]() { throw std::runtime_error("job failed"); });
+    for (int i = 0; i < 10; ++i) {
+        scheduler.submit([&counter]() { ++counter; });
+    }
+
+    EXPECT_THROW(scheduler.wait(), std::runtime_error);
+    EXPECT_EQ(counter.load(), 10);
+
+    // The exception is only reported once
+    EXPECT_NO_THROW(scheduler.wait());
+}
+
+TEST_F(JobSchedulerTest, DestructorFinishesPendingJobs) {
+    std::atomic<int> counter{0};
+    {
+        JobScheduler scheduler(2);
+        for (int i = 0; i < 20; ++i) {
+            scheduler.submit([&counter]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                ++counter;
+            });
+        }
+    }
+    EXPECT_EQ(counter.load(), 20);
+}
@@ -0,0 +1,36 @@
+#include <gtest/gtest.h>
+#include "parse_arena.h"
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace wip::analysis;
+
+TEST(ParseArenaTest, CopiesOutliveTheSource) {
+    ParseArena arena(64);
+    std::vector<std::string_view> copies;
+    for (int i = 0; i < 1000; ++i) {
+        std::string line = "src/file_" + std::to_string(i) + ".cpp:1:1: warning: text";
+        copies.push_back(arena.copy(line));
+    }
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(copies[i], "src/file_" + std::to_string(i) + ".cpp:1:1: warning: text");
+    }
+    EXPECT_TRUE(arena.copy("").empty());
+}
+
+TEST(ParseArenaTest, BacksPmrContainersAndResets) {
+    ParseArena arena;
+    {
+        std::pmr::set<std::string_view> seen(arena.resource());
+        EXPECT_TRUE(seen.insert(arena.copy("a.cpp:1:1: warning: x")).second);
+        EXPECT_FALSE(seen.insert("a.cpp:1:1: warning: x").second);
+        EXPECT_TRUE(seen.insert(arena.copy("b.cpp:1:1: warning: x")).second);
+    }
+    size_t used = arena.get_bytes_allocated();
+    EXPECT_GE(used, 2 * std::string_view("a.cpp:1:1: warning: x").size());
+
+    arena.reset();
+    EXPECT_EQ(arena.get_bytes_allocated(), 0u);
+    EXPECT_EQ(arena.copy("again"), "again");
+}
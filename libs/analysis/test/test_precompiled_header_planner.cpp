@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include "precompiled_header_planner.h"
+#include <filesystem>
+#include <fstream>
+
+using namespace wip::analysis;
+
+class PrecompiledHeaderPlannerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        directory_ = std::filesystem::temp_directory_path() / "wip_precompiled_header_planner_test";
+        std::filesystem::remove_all(directory_);
+        std::filesystem::create_directories(directory_ / "include");
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory_);
+    }
+
+    std::string write_file(const std::string& name, const std::string& contents) {
+        auto path = (directory_ / name).string();
+        std::ofstream(path) << contents;
+        return path;
+    }
+
+    static PrecompiledHeaderPlanner::Unit make_unit(const std::string& path, std::vector<std::string> includes) {
+        PrecompiledHeaderPlanner::Unit unit;
+        unit.path = path;
+        unit.command.directory = "/build";
+        unit.command.flags = {"-std=c++17"};
+        unit.includes = std::move(includes);
+        return unit;
+    }
+
+    std::filesystem::path directory_;
+};
+
+TEST_F(PrecompiledHeaderPlannerTest, CollectsIncludesBeforeTheFirstCode) {
+    auto guarded = write_file("include/guarded.h", "// Guarded\n#pragma once\nint g();\n");
+    auto local = write_file("local.h", "#ifndef LOCAL_H\n#define LOCAL_H\n#endif\n");
+    std::string unit = (directory_ / "unit.cpp").string();
+    std::string include_dir = (directory_ / "include").string();
+
+    auto includes = PrecompiledHeaderPlanner::leading_includes(
+        "// Licence\n"
+        "/* spanning\n   lines */\n"
+        "#include <vector>\n"
+        "  #  include \"local.h\"  // comment\n"
+        "\n"
+        "#include \"guarded.h\"\n"
+        "#include <map>\n"
+        "int x;\n"
+        "#include <string>\n",
+        unit, {include_dir});
+    EXPECT_EQ(includes, (std::vector<std::string>{"<vector>", '"' + local + '"', '"' + guarded + '"', "<map>"}));
+
+    // Anything but an include ends the prefix, as it may change what the headers mean
+    includes = PrecompiledHeaderPlanner::leading_includes("#include <vector>\n#define NDEBUG\n#include <cassert>\n",
+                                                          unit, {include_dir});
+    EXPECT_EQ(includes, (std::vector<std::string>{"<vector>"}));
+}
+
+TEST_F(PrecompiledHeaderPlannerTest, StopsAtProjectHeadersWithoutGuard) {
+    write_file("unguarded.h", "int table[] = {\n");
+    std::string unit = (directory_ / "unit.cpp").string();
+
+    auto includes = PrecompiledHeaderPlanner::leading_includes("#include <vector>\n#include \"unguarded.h\"\n#include <map>\n",
+                                                               unit, {});
+    EXPECT_EQ(includes, (std::vector<std::string>{"<vector>"}));
+
+    // Quoted includes outside the project are searched like <...> ones
+    includes = PrecompiledHeaderPlanner::leading_includes("#include \"gtest/gtest.h\"\n", unit, {});
+    EXPECT_EQ(includes, (std::vector<std::string>{"<gtest/gtest.h>"}));
+}
+
+TEST_F(PrecompiledHeaderPlannerTest, GroupsUnitsByLongestSharedPrefix) {
+    std::vector<PrecompiledHeaderPlanner::Unit> units = {
+        make_unit("a.cpp", {"<vector>", "<map>", "<regex>"}),
+        make_unit("b.cpp", {"<vector>", "<map>", "<regex>", "<set>"}),
+        make_unit("c.cpp", {"<vector>", "<map>", "<thread>"}),
+        make_unit("d.cpp", {"<vector>", "<map>", "<thread>"}),
+        make_unit("e.cpp", {"<vector>", "<string>"}),
+        make_unit("f.cpp", {"<string>"}),
+        make_unit("g.cpp", {}),
+    };
+
+    auto groups = PrecompiledHeaderPlanner::plan(units, 2);
+    ASSERT_EQ(groups.size(), 2u);
+    EXPECT_EQ(groups[0].units, (std::vector<std::string>{"a.cpp", "b.cpp"}));
+    EXPECT_EQ(groups[0].includes, (std::vector<std::string>{"<vector>", "<map>", "<regex>"}));
+    EXPECT_EQ(groups[1].units, (std::vector<std::string>{"c.cpp", "d.cpp"}));
+    EXPECT_EQ(groups[1].includes, (std::vector<std::string>{"<vector>", "<map>", "<thread>"}));
+
+    // With three units needed, the split stops one level up
+    groups = PrecompiledHeaderPlanner::plan(units, 3);
+    ASSERT_EQ(groups.size(), 1u);
+    EXPECT_EQ(groups[0].units, (std::vector<std::string>{"a.cpp", "b.cpp", "c.cpp", "d.cpp"}));
+    EXPECT_EQ(groups[0].includes, (std::vector<std::string>{"<vector>", "<map>"}));
+
+    auto text = PrecompiledHeaderPlanner::header_text(groups[0]);
+    EXPECT_NE(text.find("#include <vector>\n#include <map>\n"), std::string::npos);
+}
+
+TEST_F(PrecompiledHeaderPlannerTest, NeverGroupsUnitsWithDifferentFlags) {
+    auto a = make_unit("a.cpp", {"<vector>"});
+    auto b = make_unit("b.cpp", {"<vector>"});
+    b.command.flags.push_back("-DNDEBUG");
+
+    EXPECT_TRUE(PrecompiledHeaderPlanner::plan({a, b}, 2).empty());
+
+    b.command = a.command;
+    EXPECT_EQ(PrecompiledHeaderPlanner::plan({a, b}, 2).size(), 1u);
+}
+
+TEST_F(PrecompiledHeaderPlannerTest, ReadsCompileCommandsWithoutOutputs) {
+    std::string build = (directory_ / "build").string();
+    std::filesystem::create_directories(build);
+    write_file("build/compile_commands.json", R"([
+        {"directory": ")" + build + R"(", "file": "../src/a.cpp",
+         "command": "/usr/bin/c++ -I../include -DNAME=\"a b\" -std=c++17 -MD -MF a.d -o a.o -c ../src/a.cpp"},
+        {"directory": ")" + build + R"(", "file": ")" + (directory_ / "src/b.c").string() + R"(",
+         "arguments": ["cc", "-Iinclude", "-c", ")" + (directory_ / "src/b.c").string() + R"("]}
+    ])");
+
+    auto commands = PrecompiledHeaderPlanner::read_compile_commands(build);
+    ASSERT_EQ(commands.size(), 2u);
+
+    const auto& a = commands[(directory_ / "src/a.cpp").string()];
+    EXPECT_EQ(a.directory, build);
+    EXPECT_EQ(a.language, "c++");
+    EXPECT_EQ(a.flags, (std::vector<std::string>{"-I../include", "-DNAME=a b", "-std=c++17"}));
+    EXPECT_EQ(PrecompiledHeaderPlanner::get_include_dirs(a),
+              (std::vector<std::string>{(directory_ / "include").string()}));
+
+    const auto& b = commands[(directory_ / "src/b.c").string()];
+    EXPECT_EQ(b.language, "c");
+    EXPECT_EQ(b.flags, (std::vector<std::string>{"-Iinclude"}));
+
+    EXPECT_TRUE(PrecompiledHeaderPlanner::read_compile_commands((directory_ / "missing").string()).empty());
+}
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include "progress_channel.h"
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace wip::analysis;
+
+TEST(ProgressChannelTest, DeliversLinesInOrder) {
+    ProgressChannel channel({"cppcheck", "clang-tidy"}, 16);
+    EXPECT_FALSE(channel.has_pending());
+
+    EXPECT_TRUE(channel.publish_line("cppcheck", "one"));
+    EXPECT_TRUE(channel.publish_line("clang-tidy", "two"));
+    EXPECT_TRUE(channel.publish_line("cppcheck", "three"));
+    EXPECT_TRUE(channel.has_pending());
+
+    std::vector<std::string> lines;
+    EXPECT_EQ(channel.drain([&](const std::string& tool, const std::string& line) { lines.push_back(tool + ":" + line); },
+                            nullptr), 3u);
+    EXPECT_EQ(lines, (std::vector<std::string>{"cppcheck:one", "clang-tidy:two", "cppcheck:three"}));
+    EXPECT_FALSE(channel.has_pending());
+    EXPECT_EQ(channel.drain(nullptr, nullptr), 0u);
+}
+
+TEST(ProgressChannelTest, LatestProgressWins) {
+    ProgressChannel channel({"cppcheck", "clang-tidy"});
+    for (size_t i = 1; i <= 5; ++i) {
+        AnalysisProgress progress;
+        progress.total_files = 5;
+        progress.processed_files = i;
+        channel.publish_progress("cppcheck", progress);
+    }
+    AnalysisProgress other;
+    other.status_message = "started";
+    channel.publish_progress("clang-tidy", other);
+
+    std::vector<std::pair<std::string, AnalysisProgress>> delivered;
+    channel.drain(nullptr, [&](const std::string& tool, const AnalysisProgress& progress) {
+        delivered.emplace_back(tool, progress);
+    });
+    ASSERT_EQ(delivered.size(), 2u);
+    EXPECT_EQ(delivered[0].first, "cppcheck");
+    EXPECT_EQ(delivered[0].second.processed_files, 5u);
+    EXPECT_EQ(delivered[1].first, "clang-tidy");
+    EXPECT_EQ(delivered[1].second.status_message, "started");
+
+    auto statistics = channel.get_statistics();
+    EXPECT_EQ(statistics.progress_published, 6u);
+    EXPECT_EQ(statistics.progress_merged, 4u);
+    EXPECT_EQ(statistics.progress_delivered, 2u);
+
+    // Drained progress is not delivered again
+    delivered.clear();
+    channel.drain(nullptr, [&](const std::string& tool, const AnalysisProgress& progress) {
+        delivered.emplace_back(tool, progress);
+    });
+    EXPECT_TRUE(delivered.empty());
+}
+
+TEST(ProgressChannelTest, FullRingDropsNewLines) {
+    ProgressChannel channel({"tool"}, 4);
+    EXPECT_EQ(channel.get_line_capacity(), 4u);
+
+    for (int i = 0; i < 6; ++i) {
+        EXPECT_EQ(channel.publish_line("tool", std::to_string(i)), i < 4);
+    }
+    EXPECT_FALSE(channel.publish_line("unknown", "line"));
+
+    std::vector<std::string> lines;
+    channel.drain([&](const std::string&, const std::string& line) { lines.push_back(line); }, nullptr);
+    EXPECT_EQ(lines, (std::vector<std::string>{"0", "1", "2", "3"}));
+
+    auto statistics = channel.get_statistics();
+    EXPECT_EQ(statistics.lines_published, 4u);
+    EXPECT_EQ(statistics.lines_delivered, 4u);
+    EXPECT_EQ(statistics.lines_dropped, 3u);
+    EXPECT_EQ(statistics.peak_queued_lines, 4u);
+
+    // Drained cells take lines again
+    EXPECT_TRUE(channel.publish_line("tool", "again"));
+}
+
+TEST(ProgressChannelTest, DrainLimitLeavesTheRestQueued) {
+    ProgressChannel channel({"tool"}, 8);
+    for (int i = 0; i < 5; ++i) {
+        channel.publish_line("tool", std::to_string(i));
+    }
+
+    std::vector<std::string> lines;
+    auto collect = [&](const std::string&, const std::string& line) { lines.push_back(line); };
+    EXPECT_EQ(channel.drain(collect, nullptr, 2), 2u);
+    EXPECT_TRUE(channel.has_pending());
+    EXPECT_EQ(channel.drain(collect, nullptr), 3u);
+    EXPECT_EQ(lines, (std::vector<std::string>{"0", "1", "2", "3", "4"}));
+}
+
+TEST(ProgressChannelTest, ConcurrentProducersLoseNothingThatFits) {
+    constexpr int PRODUCERS = 4;
+    constexpr int LINES_PER_PRODUCER = 20000;
+    std::vector<std::string> tools;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        tools.push_back("tool" + std::to_string(p));
+    }
+    ProgressChannel channel(tools, 256);
+
+    std::vector<int> next_expected(PRODUCERS, 0);
+    std::vector<int> accepted(PRODUCERS, 0);
+    bool in_order = true;
+    size_t delivered = 0;
+    auto check = [&](const std::string& tool, const std::string& line) {
+        // Lines of one producer keep their order, though dropped ones leave gaps
+        int producer = tool.back() - '0';
+        int value = std::stoi(line);
+        in_order = in_order && value >= next_expected[producer];
+        next_expected[producer] = value + 1;
+        ++delivered;
+    };
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&, p]() {
+            for (int i = 0; i < LINES_PER_PRODUCER; ++i) {
+                if (channel.publish_line(tools[p], std::to_string(i))) {
+                    ++accepted[p];
+                }
+                AnalysisProgress progress;
+                progress.processed_files = static_cast<size_t>(i);
+                channel.publish_progress(tools[p], progress);
+            }
+        });
+    }
+    for (int i = 0; i < 1000; ++i) {
+        channel.drain(check, nullptr);
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    channel.drain(check, nullptr);
+
+    size_t total_accepted = 0;
+    for (int count : accepted) {
+        total_accepted += static_cast<size_t>(count);
+    }
+    auto statistics = channel.get_statistics();
+    EXPECT_TRUE(in_order);
+    EXPECT_EQ(delivered, total_accepted);
+    EXPECT_EQ(statistics.lines_published, total_accepted);
+    EXPECT_EQ(statistics.lines_published + statistics.lines_dropped, static_cast<uint64_t>(PRODUCERS * LINES_PER_PRODUCER));
+    EXPECT_EQ(statistics.progress_published, static_cast<uint64_t>(PRODUCERS * LINES_PER_PRODUCER));
+    EXPECT_EQ(statistics.progress_merged + statistics.progress_delivered, statistics.progress_published);
+    EXPECT_LE(statistics.peak_queued_lines, 256u);
+}
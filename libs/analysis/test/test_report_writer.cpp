@@ -0,0 +1,255 @@
+#include <gtest/gtest.h>
+#include "report_writer.h"
+#include "result_file.h"
+#include <filesystem>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace wip::analysis;
+
+class ReportWriterTest : public ::testing::Test {
+protected:
+    static ReportHeader sample_header() {
+        ReportHeader header;
+        header.title = "Quality <Report>";
+        header.project_name = "demo";
+        header.properties = {{"total_files", "12"}, {"lines_of_code", "3400"}};
+        return header;
+    }
+
+    static std::vector<AnalysisResult> sample_results() {
+        AnalysisResult cppcheck;
+        cppcheck.tool_name = "cppcheck";
+        cppcheck.success = true;
+        for (int i = 0; i < 3; ++i) {
+            AnalysisIssue issue;
+            issue.id = "issue" + std::to_string(i);
+            issue.message = "Value \"x\" is <never> used\n\tsecond line";
+            issue.file_path = i == 2 ? "/home/user/my project/src/main.cpp" : "src/main.cpp";
+            issue.line_number = i == 1 ? 0 : 10 + i;
+            issue.column_number = i;
+            issue.severity = i == 0 ? IssueSeverity::Error : IssueSeverity::Warning;
+            issue.category = IssueCategory::Bug;
+            issue.rule_id = "unusedValue";
+            issue.tool_name = "cppcheck";
+            cppcheck.issues.push_back(issue);
+        }
+        cppcheck.issues[1].fix_suggestion = "remove it";
+
+        AnalysisResult clang_tidy;
+        clang_tidy.tool_name = "clang-tidy";
+        clang_tidy.success = false;
+        clang_tidy.error_message = "clang-tidy not found";
+
+        return {cppcheck, clang_tidy};
+    }
+
+    static std::string render(ReportFormat format, const ReportWriter::Summary& summary = {}) {
+        std::ostringstream out;
+        ReportWriter writer(out, format, sample_header());
+        for (const auto& result : sample_results()) {
+            writer.write_result(result);
+        }
+        writer.finish(summary);
+        return out.str();
+    }
+};
+
+TEST_F(ReportWriterTest, JsonIsValidAndMatchesIssues) {
+    auto json = nlohmann::json::parse(render(ReportFormat::Json, {{"quality_score", "87.5"}}));
+
+    EXPECT_EQ(json["title"], "Quality <Report>");
+    EXPECT_EQ(json["project"]["name"], "demo");
+    EXPECT_EQ(json["project"]["lines_of_code"], "3400");
+    ASSERT_EQ(json["tools"].size(), 2u);
+
+    const auto& cppcheck = json["tools"][0];
+    EXPECT_EQ(cppcheck["name"], "cppcheck");
+    EXPECT_EQ(cppcheck["issue_count"], 3);
+    EXPECT_TRUE(cppcheck["success"].get<bool>());
+    auto expected = sample_results()[0].issues;
+    ASSERT_EQ(cppcheck["issues"].size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(AnalysisIssue::from_json(cppcheck["issues"][i]), expected[i]);
+    }
+
+    const auto& clang_tidy = json["tools"][1];
+    EXPECT_TRUE(clang_tidy["issues"].empty());
+    EXPECT_FALSE(clang_tidy["success"].get<bool>());
+    EXPECT_EQ(clang_tidy["error_message"], "clang-tidy not found");
+
+    const auto& statistics = json["statistics"];
+    EXPECT_EQ(statistics["total_issues"], 3);
+    EXPECT_EQ(statistics["issue_counts_by_severity"]["error"], 1);
+    EXPECT_EQ(statistics["issue_counts_by_severity"]["warning"], 2);
+    EXPECT_EQ(statistics["issue_counts_by_category"]["bug"], 3);
+    EXPECT_EQ(statistics["failed_tool_count"], 1);
+    EXPECT_EQ(statistics["quality_score"], "87.5");
+}
+
+TEST_F(ReportWriterTest, SarifHasOneRunPerTool) {
+    auto sarif = nlohmann::json::parse(render(ReportFormat::Sarif));
+
+    EXPECT_EQ(sarif["version"], "2.1.0");
+    ASSERT_EQ(sarif["runs"].size(), 2u);
+
+    const auto& run = sarif["runs"][0];
+    EXPECT_EQ(run["tool"]["driver"]["name"], "cppcheck");
+    ASSERT_EQ(run["results"].size(), 3u);
+    EXPECT_EQ(run["results"][0]["ruleId"], "unusedValue");
+    EXPECT_EQ(run["results"][0]["level"], "error");
+    EXPECT_EQ(run["results"][1]["level"], "warning");
+    EXPECT_EQ(run["results"][0]["message"]["text"], "Value \"x\" is <never> used\n\tsecond line");
+
+    const auto& location = run["results"][0]["locations"][0]["physicalLocation"];
+    EXPECT_EQ(location["artifactLocation"]["uri"], "src/main.cpp");
+    EXPECT_EQ(location["region"]["startLine"], 10);
+    EXPECT_FALSE(location["region"].contains("startColumn"));
+    EXPECT_FALSE(run["results"][1]["locations"][0]["physicalLocation"].contains("region"));
+    EXPECT_EQ(run["results"][2]["locations"][0]["physicalLocation"]["artifactLocation"]["uri"],
+              "file:///home/user/my%20project/src/main.cpp");
+
+    EXPECT_FALSE(sarif["runs"][1]["invocations"][0]["executionSuccessful"].get<bool>());
+    EXPECT_EQ(sarif["properties"]["total_issues"], 3);
+    EXPECT_EQ(sarif["properties"]["project"], "demo");
+}
+
+TEST_F(ReportWriterTest, HtmlEscapesText) {
+    std::string html = render(ReportFormat::Html);
+
+    EXPECT_NE(html.find("<title>Quality &lt;Report&gt;</title>"), std::string::npos);
+    EXPECT_NE(html.find("Value &quot;x&quot; is &lt;never&gt; used"), std::string::npos);
+    EXPECT_NE(html.find("src/main.cpp:10"), std::string::npos);
+    EXPECT_NE(html.find("clang-tidy not found"), std::string::npos);
+    EXPECT_EQ(html.find("<never>"), std::string::npos);
+    EXPECT_EQ(html.rfind("</html>\n"), html.size() - 8);
+}
+
+TEST_F(ReportWriterTest, EmptyReportsAreValid) {
+    for (auto format : {ReportFormat::Json, ReportFormat::Sarif}) {
+        std::ostringstream out;
+        ReportWriter writer(out, format);
+        writer.begin_tool("cppcheck");
+        writer.end_tool();
+        writer.finish();
+        EXPECT_NO_THROW(nlohmann::json::parse(out.str()));
+
+        std::ostringstream empty;
+        ReportWriter(empty, format).finish();
+        EXPECT_NO_THROW(nlohmann::json::parse(empty.str()));
+    }
+}
+
+TEST_F(ReportWriterTest, StatisticsAreCountedWhileWriting) {
+    std::ostringstream out;
+    ReportWriter writer(out, ReportFormat::Json);
+    writer.begin_tool("cppcheck");
+    auto results = sample_results();
+    for (const auto& issue : results[0].issues) {
+        writer.write_issue(issue);
+    }
+    EXPECT_EQ(writer.get_statistics().total_issues, 3u);
+    EXPECT_EQ(writer.get_statistics().get_issue_count(IssueSeverity::Warning), 2u);
+
+    EXPECT_THROW(writer.begin_tool("clang-tidy"), std::logic_error);
+    const auto& statistics = writer.finish();
+    EXPECT_EQ(statistics.tool_count, 1u);
+    EXPECT_THROW(writer.write_issue(ReportIssue()), std::logic_error);
+}
+
+TEST_F(ReportWriterTest, WritesIssuesFromBinaryResultFile) {
+    auto path = (std::filesystem::temp_directory_path() / "wip_report_writer_test.wipr").string();
+    BinaryResultFile::write(sample_results(), path);
+
+    std::ostringstream direct;
+    std::ostringstream mapped;
+    {
+        ReportWriter writer(direct, ReportFormat::Sarif);
+        writer.write_result(sample_results()[0]);
+        writer.finish();
+
+        BinaryResultFile file(path);
+        ReportWriter from_file(mapped, ReportFormat::Sarif, ReportHeader{});
+        from_file.begin_tool("cppcheck");
+        auto [first, count] = file.get_issue_range(0);
+        for (size_t i = first; i < first + count; ++i) {
+            from_file.write_issue(file.get_issue(i));
+        }
+        from_file.end_tool();
+        from_file.finish();
+    }
+    std::filesystem::remove(path);
+
+    auto expected = nlohmann::json::parse(direct.str());
+    auto actual = nlohmann::json::parse(mapped.str());
+    EXPECT_EQ(actual["runs"], expected["runs"]);
+}
+
+TEST_F(ReportWriterTest, SarifSinkTakesInterleavedBatches) {
+    std::ostringstream out;
+    auto results = sample_results();
+    {
+        SarifIssueWriter writer(out, sample_header());
+        auto callback = writer.callback();
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&, t]() {
+                AnalysisIssue issue = results[0].issues[0];
+                issue.tool_name = t % 2 ? "cppcheck" : "clang-tidy";
+                for (int i = 0; i < 50; ++i) {
+                    callback(issue.tool_name, {issue, issue});
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        writer.add_tool_failure("iwyu", "iwyu not found");
+        EXPECT_EQ(writer.finish().total_issues, 400u);
+        EXPECT_THROW(writer.write_issues("cppcheck", results[0].issues), std::logic_error);
+    }
+
+    auto sarif = nlohmann::json::parse(out.str());
+    ASSERT_EQ(sarif["runs"].size(), 1u);
+    const auto& run = sarif["runs"][0];
+    EXPECT_EQ(run["tool"]["driver"]["name"], "wip-analysis");
+    EXPECT_EQ(run["tool"]["extensions"].size(), 3u);
+    ASSERT_EQ(run["results"].size(), 400u);
+    EXPECT_EQ(run["results"][0]["level"], "error");
+    EXPECT_FALSE(run["invocations"][0]["executionSuccessful"].get<bool>());
+    EXPECT_EQ(run["invocations"][0]["toolExecutionNotifications"][0]["properties"]["tool"], "iwyu");
+    EXPECT_EQ(sarif["properties"]["failed_tool_count"], 1);
+
+    size_t cppcheck = 0;
+    for (const auto& result : run["results"]) {
+        cppcheck += result["properties"]["tool"] == "cppcheck";
+    }
+    EXPECT_EQ(cppcheck, 200u);
+
+    std::ostringstream empty;
+    SarifIssueWriter(empty).finish();
+    EXPECT_TRUE(nlohmann::json::parse(empty.str())["runs"][0]["results"].empty());
+}
+
+TEST_F(ReportWriterTest, NdjsonSinkWritesOneIssuePerLine) {
+    std::ostringstream out;
+    NdjsonIssueWriter writer(out);
+    auto results = sample_results();
+    results[0].issues[2].tool_name.clear();
+    writer.callback()("cppcheck", results[0].issues);
+    writer.write_result(results[1]);
+
+    std::istringstream lines(out.str());
+    std::string line;
+    size_t count = 0;
+    while (std::getline(lines, line)) {
+        auto issue = AnalysisIssue::from_json(nlohmann::json::parse(line));
+        EXPECT_EQ(issue.message, results[0].issues[count].message);
+        EXPECT_EQ(issue.tool_name, "cppcheck");
+        ++count;
+    }
+    EXPECT_EQ(count, 3u);
+    EXPECT_EQ(writer.get_issue_count(), 3u);
+}
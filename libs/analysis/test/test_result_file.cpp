@@ -0,0 +1,232 @@
+#include <gtest/gtest.h>
+#include "analysis_engine.h"
+#include "result_file.h"
+#include "report_writer.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace wip::analysis;
+
+class ResultFileTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        directory_ = std::filesystem::temp_directory_path() / "wip_result_file_test";
+        std::filesystem::remove_all(directory_);
+        std::filesystem::create_directories(directory_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory_);
+    }
+
+    std::string file(const std::string& name) const {
+        return (directory_ / name).string();
+    }
+
+    static std::vector<AnalysisResult> sample_results() {
+        AnalysisResult cppcheck;
+        cppcheck.tool_name = "cppcheck";
+        cppcheck.analysis_id = "run-42";
+        cppcheck.timestamp = std::chrono::system_clock::now();
+        cppcheck.files_analyzed = 12;
+        cppcheck.execution_time = std::chrono::milliseconds(1234);
+        cppcheck.success = true;
+        for (int i = 0; i < 3; ++i) {
+            AnalysisIssue issue;
+            issue.id = "issue" + std::to_string(i);
+            issue.message = "Possible null pointer dereference";
+            issue.file_path = "src/main.cpp";
+            issue.line_number = 10 + i;
+            issue.column_number = i;
+            issue.severity = IssueSeverity::Error;
+            issue.category = IssueCategory::Bug;
+            issue.rule_id = "nullPointer";
+            issue.tool_name = "cppcheck";
+            cppcheck.issues.push_back(issue);
+        }
+        cppcheck.issues[1].fix_suggestion = "if (ptr) { ... }";
+        cppcheck.compute_statistics();
+
+        AnalysisResult clang_tidy;
+        clang_tidy.tool_name = "clang-tidy";
+        clang_tidy.success = false;
+        clang_tidy.error_message = "clang-tidy not found";
+
+        return {cppcheck, clang_tidy};
+    }
+
+    std::filesystem::path directory_;
+};
+
+TEST_F(ResultFileTest, RoundTrip) {
+    auto results = sample_results();
+    BinaryResultFile::write(results, file("results.wipr"));
+
+    for (bool use_mmap : {true, false}) {
+        BinaryResultFile reader(file("results.wipr"), use_mmap);
+        EXPECT_EQ(reader.get_result_count(), 2);
+        EXPECT_EQ(reader.get_issue_count(), 3);
+
+        auto loaded = reader.read_all();
+        ASSERT_EQ(loaded.size(), 2);
+        EXPECT_EQ(loaded[0], results[0]);
+        EXPECT_EQ(loaded[1], results[1]);
+        EXPECT_EQ(loaded[0].timestamp, std::chrono::time_point_cast<std::chrono::milliseconds>(results[0].timestamp));
+        EXPECT_EQ(loaded[0].issue_counts_by_severity, results[0].issue_counts_by_severity);
+        EXPECT_EQ(*loaded[0].issues[1].fix_suggestion, "if (ptr) { ... }");
+        EXPECT_FALSE(loaded[0].issues[0].fix_suggestion.has_value());
+    }
+}
+
+TEST_F(ResultFileTest, DeserializesFromMemory) {
+    auto results = sample_results();
+    auto encoded = BinaryResultFile::serialize(results);
+
+    auto decoded = BinaryResultFile::deserialize(encoded);
+    ASSERT_EQ(decoded.size(), 2);
+    EXPECT_EQ(decoded[0], results[0]);
+    EXPECT_EQ(decoded[1], results[1]);
+
+    EXPECT_THROW(BinaryResultFile::deserialize(std::string_view(encoded).substr(0, encoded.size() - 8)), std::runtime_error);
+    EXPECT_THROW(BinaryResultFile::deserialize("not results"), std::runtime_error);
+}
+
+TEST_F(ResultFileTest, ZeroCopyIssueAccess) {
+    BinaryResultFile::write(sample_results(), file("results.wipr"));
+    BinaryResultFile reader(file("results.wipr"));
+
+    auto range = reader.get_issue_range(0);
+    EXPECT_EQ(range.first, 0);
+    EXPECT_EQ(range.second, 3);
+    EXPECT_EQ(reader.get_issue_range(1).second, 0);
+
+    auto issue = reader.get_issue(2);
+    EXPECT_EQ(issue.file_path(), "src/main.cpp");
+    EXPECT_EQ(issue.line_number(), 12);
+    EXPECT_EQ(issue.rule_id(), "nullPointer");
+    EXPECT_EQ(issue.severity(), IssueSeverity::Error);
+    EXPECT_EQ(issue.category(), IssueCategory::Bug);
+    EXPECT_THROW(reader.get_issue(3), std::out_of_range);
+}
+
+TEST_F(ResultFileTest, EmptyResults) {
+    BinaryResultFile::write({}, file("empty.wipr"));
+    BinaryResultFile reader(file("empty.wipr"));
+    EXPECT_EQ(reader.get_result_count(), 0);
+    EXPECT_TRUE(reader.read_all().empty());
+}
+
+TEST_F(ResultFileTest, RejectsInvalidFiles) {
+    std::ofstream(file("results.json")) << "[]";
+    EXPECT_FALSE(BinaryResultFile::is_binary_file(file("results.json")));
+    EXPECT_THROW(BinaryResultFile reader(file("results.json")), std::runtime_error);
+    EXPECT_THROW(BinaryResultFile reader(file("missing.wipr")), std::runtime_error);
+
+    // Truncating the string table must be detected
+    BinaryResultFile::write(sample_results(), file("results.wipr"));
+    EXPECT_TRUE(BinaryResultFile::is_binary_file(file("results.wipr")));
+    auto size = std::filesystem::file_size(file("results.wipr"));
+    std::filesystem::resize_file(file("results.wipr"), size - 8);
+    EXPECT_THROW(BinaryResultFile reader(file("results.wipr")), std::runtime_error);
+}
+
+TEST_F(ResultFileTest, EngineDetectsFormat) {
+    AnalysisEngine engine;
+    auto results = sample_results();
+
+    engine.save_results(results, file("results.json"));
+    engine.save_results(results, file("results.wipr"), ResultFormat::Binary);
+    EXPECT_GT(std::filesystem::file_size(file("results.json")), std::filesystem::file_size(file("results.wipr")));
+
+    auto from_json = engine.load_results(file("results.json"));
+    auto from_binary = engine.load_results(file("results.wipr"));
+    ASSERT_EQ(from_json.size(), 2);
+    ASSERT_EQ(from_binary.size(), 2);
+    EXPECT_EQ(from_json[0], from_binary[0]);
+    EXPECT_EQ(from_json[1], from_binary[1]);
+}
+
+TEST_F(ResultFileTest, EngineSavesAsynchronously) {
+    AnalysisEngine engine;
+    wip::utils::file::AsyncFileWriter writer(false);
+    auto results = sample_results();
+
+    auto json_saved = engine.save_results_async(results, file("async.json"), writer);
+    auto binary_saved = engine.save_results_async(results, file("async.wipr"), writer, ResultFormat::Binary);
+    ASSERT_TRUE(json_saved.get());
+    ASSERT_TRUE(binary_saved.get());
+
+    engine.save_results(results, file("results.wipr"), ResultFormat::Binary);
+    BinaryResultFile synchronous(file("results.wipr"));
+    BinaryResultFile asynchronous(file("async.wipr"));
+    EXPECT_EQ(synchronous.read_all(), asynchronous.read_all());
+    ASSERT_EQ(engine.load_results(file("async.json")).size(), 2);
+    EXPECT_EQ(engine.load_results(file("async.json"))[1], results[1]);
+}
+
+TEST_F(ResultFileTest, NdjsonRangesReadEveryIssueOnce) {
+    std::vector<AnalysisIssue> expected;
+    {
+        std::ofstream out(file("issues.ndjson"), std::ios::binary);
+        NdjsonIssueWriter writer(out);
+        for (int i = 0; i < 200; ++i) {
+            AnalysisIssue issue;
+            issue.id = "issue" + std::to_string(i);
+            issue.message = std::string(static_cast<size_t>(i % 13), 'x') + "\n\"quoted\"";
+            issue.file_path = "src/file_" + std::to_string(i % 7) + ".cpp";
+            issue.line_number = i;
+            issue.rule_id = "rule" + std::to_string(i % 5);
+            issue.tool_name = i % 2 ? "cppcheck" : "clang-tidy";
+            expected.push_back(issue);
+        }
+        writer.write_issues("cppcheck", expected);
+        EXPECT_EQ(writer.get_issue_count(), 200u);
+    }
+    ASSERT_TRUE(NdjsonResultFile::is_ndjson_file(file("issues.ndjson")));
+
+    NdjsonResultFile reader(file("issues.ndjson"));
+    // Any cut of the file reads each issue exactly once, in order
+    for (size_t parts : {1u, 2u, 3u, 7u, 64u}) {
+        std::vector<AnalysisIssue> issues;
+        for (auto [begin, end] : reader.split(parts)) {
+            reader.read_range(begin, end, [&](AnalysisIssue&& issue) { issues.push_back(std::move(issue)); });
+        }
+        EXPECT_EQ(issues, expected) << parts << " parts";
+    }
+    EXPECT_EQ(reader.read_issues(4), expected);
+
+    auto results = reader.read_all(3);
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_EQ(results[0].tool_name, "clang-tidy");
+    EXPECT_EQ(results[0].issues.size(), 100u);
+    EXPECT_EQ(results[1].get_total_issue_count(), 100u);
+}
+
+TEST_F(ResultFileTest, NdjsonRejectsMalformedLines) {
+    std::ofstream(file("bad.ndjson")) << "{\"id\": \"a\"}\r\n\n{\"id\": \n";
+    NdjsonResultFile reader(file("bad.ndjson"));
+    size_t count = 0;
+    EXPECT_THROW(reader.read_range(0, reader.size(), [&](AnalysisIssue&&) { ++count; }), std::runtime_error);
+    EXPECT_EQ(count, 1u);
+    EXPECT_EQ(reader.read_range(0, 5, [](AnalysisIssue&& issue) { EXPECT_EQ(issue.id, "a"); }), 1u);
+}
+
+TEST_F(ResultFileTest, EngineSavesAndLoadsNdjson) {
+    AnalysisEngine engine;
+    wip::utils::file::AsyncFileWriter writer(false);
+    auto results = sample_results();
+
+    engine.save_results(results, file("results.json"));
+    engine.save_results(results, file("results.ndjson"), ResultFormat::Ndjson);
+    ASSERT_TRUE(engine.save_results_async(results, file("async.ndjson"), writer, ResultFormat::Ndjson).get());
+    EXPECT_FALSE(NdjsonResultFile::is_ndjson_file(file("results.json")));
+
+    for (const auto& path : {file("results.ndjson"), file("async.ndjson")}) {
+        auto loaded = engine.load_results(path);
+        ASSERT_EQ(loaded.size(), 1u);
+        EXPECT_EQ(loaded[0].tool_name, "cppcheck");
+        EXPECT_EQ(loaded[0].issues, results[0].issues);
+    }
+}
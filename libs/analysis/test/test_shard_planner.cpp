@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include "shard_planner.h"
+#include <filesystem>
+#include <fstream>
+#include <algorithm>
+
+using namespace wip::analysis;
+
+class ShardPlannerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        directory_ = std::filesystem::temp_directory_path() / "wip_shard_planner_test";
+        std::filesystem::remove_all(directory_);
+        std::filesystem::create_directories(directory_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory_);
+    }
+
+    // File of size - 1 bytes, so its size-based cost is size
+    std::string make_file(const std::string& name, size_t size) {
+        auto path = (directory_ / name).string();
+        std::ofstream(path) << std::string(size - 1, 'x');
+        return path;
+    }
+
+    std::filesystem::path directory_;
+};
+
+TEST_F(ShardPlannerTest, EstimatesUnknownUnitsFromKnownCostPerByte) {
+    auto known = make_file("known.cpp", 1000);
+    auto fresh = make_file("fresh.cpp", 500);
+
+    // 1000 bytes took 4000 us, so the new file is expected to take 2000 us
+    auto costs = ShardPlanner::estimate_costs({known, fresh}, {{known, 4000.0}});
+    ASSERT_EQ(costs.size(), 2u);
+    EXPECT_DOUBLE_EQ(costs[0], 4000.0);
+    EXPECT_DOUBLE_EQ(costs[1], 2000.0);
+
+    // Without any history the costs are the sizes
+    costs = ShardPlanner::estimate_costs({known, fresh}, {});
+    EXPECT_DOUBLE_EQ(costs[0], 1000.0);
+    EXPECT_DOUBLE_EQ(costs[1], 500.0);
+}
+
+TEST_F(ShardPlannerTest, PlacesLongestUnitsFirst) {
+    // One template-heavy unit worth as much as all the others
+    std::vector<std::string> units = {"a", "b", "c", "heavy", "d", "e", "f", "g"};
+    std::vector<double> costs = {10, 10, 10, 70, 10, 10, 10, 10};
+
+    auto shards = ShardPlanner::plan(units, costs, 2);
+    ASSERT_EQ(shards.size(), 2u);
+    EXPECT_DOUBLE_EQ(shards[0].cost, 70.0);
+    EXPECT_DOUBLE_EQ(shards[1].cost, 70.0);
+    if (shards[0].units.size() != 1) {
+        std::swap(shards[0], shards[1]);
+    }
+    EXPECT_EQ(shards[0].units, (std::vector<std::string>{"heavy"}));
+    EXPECT_EQ(shards[1].units, (std::vector<std::string>{"a", "b", "c", "d", "e", "f", "g"}));
+
+    // Contiguous chunks of four would take 100 against 40
+    shards = ShardPlanner::plan(units, costs, 4);
+    ASSERT_EQ(shards.size(), 4u);
+    double longest = 0.0;
+    for (const auto& shard : shards) {
+        longest = std::max(longest, shard.cost);
+    }
+    EXPECT_DOUBLE_EQ(longest, 70.0);
+    EXPECT_EQ(shards[0].units, (std::vector<std::string>{"heavy"}));
+}
+
+TEST_F(ShardPlannerTest, ReturnsShardsMostExpensiveFirst) {
+    std::vector<std::string> units = {"a", "b", "c", "d", "e"};
+    std::vector<double> costs = {1, 2, 3, 4, 50};
+
+    auto shards = ShardPlanner::plan(units, costs, 3);
+    ASSERT_EQ(shards.size(), 3u);
+    for (size_t i = 1; i < shards.size(); ++i) {
+        EXPECT_GE(shards[i - 1].cost, shards[i].cost);
+    }
+
+    size_t unit_count = 0;
+    for (const auto& shard : shards) {
+        unit_count += shard.units.size();
+        EXPECT_TRUE(std::is_sorted(shard.units.begin(), shard.units.end()));
+    }
+    EXPECT_EQ(unit_count, units.size());
+}
+
+TEST_F(ShardPlannerTest, NeverPlansEmptyShards) {
+    EXPECT_TRUE(ShardPlanner::plan({}, {}, 4).empty());
+
+    auto shards = ShardPlanner::plan({"a", "b"}, {1, 1}, 8);
+    ASSERT_EQ(shards.size(), 2u);
+    EXPECT_EQ(shards[0].units.size(), 1u);
+    EXPECT_EQ(shards[1].units.size(), 1u);
+}
+
+TEST_F(ShardPlannerTest, AttributesMeasuredAndRemainingCosts) {
+    auto timed = make_file("timed.cpp", 100);
+    auto small = make_file("small.cpp", 100);
+    auto large = make_file("large.cpp", 300);
+
+    ExecutionProfile profile;
+    profile.tool_cpu_time = std::chrono::milliseconds(10);
+    profile.unit_cpu_times[timed] = std::chrono::milliseconds(6);
+
+    // The 4 ms the tool did not time per unit are shared by size
+    auto costs = ShardPlanner::attribute_costs({timed, small, large}, profile, std::chrono::seconds(1));
+    ASSERT_EQ(costs.size(), 3u);
+    EXPECT_DOUBLE_EQ(costs[timed], 6000.0);
+    EXPECT_DOUBLE_EQ(costs[small], 1000.0);
+    EXPECT_DOUBLE_EQ(costs[large], 3000.0);
+
+    // Without CPU time the wall time is shared
+    costs = ShardPlanner::attribute_costs({small, large}, ExecutionProfile{}, std::chrono::milliseconds(8));
+    EXPECT_DOUBLE_EQ(costs[small], 2000.0);
+    EXPECT_DOUBLE_EQ(costs[large], 6000.0);
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include "tool_discovery.h"
+#include <filesystem>
+#include <fstream>
+
+using namespace wip::analysis;
+
+class ToolDiscoveryTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir_ = std::filesystem::temp_directory_path() / "wip_tool_discovery_test";
+        std::filesystem::remove_all(dir_);
+        std::filesystem::create_directories(dir_ / "bin");
+        cache_file_ = (dir_ / "tool_discovery.json").string();
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir_);
+    }
+
+    // Write an executable script that prints a version line
+    std::string write_tool(const std::string& name, const std::string& version) {
+        auto path = dir_ / "bin" / name;
+        {
+            std::ofstream file(path);
+            file << "#!/bin/sh\necho \"" << name << " " << version << "\"\n";
+        }
+        std::filesystem::permissions(path, std::filesystem::perms::owner_all);
+        return path.string();
+    }
+
+    std::string tool_path(const std::string& name) const {
+        return (dir_ / "bin" / name).string();
+    }
+
+    std::filesystem::path dir_;
+    std::string cache_file_;
+};
+
+TEST_F(ToolDiscoveryTest, FindsFirstWorkingCandidate) {
+    write_tool("fake-tool-2", "2.0");
+    ToolDiscovery discovery;
+
+    auto probe = discovery.probe("fake-tool", {tool_path("fake-tool-1"), tool_path("fake-tool-2")});
+
+    EXPECT_TRUE(probe.found());
+    EXPECT_EQ(probe.executable, tool_path("fake-tool-2"));
+    EXPECT_EQ(probe.version_output, "fake-tool-2 2.0\n");
+
+    // The missing candidate was skipped without starting a process
+    EXPECT_EQ(discovery.get_launch_count(), 1);
+}
+
+TEST_F(ToolDiscoveryTest, ReusesProbeWithoutLaunching) {
+    write_tool("fake-tool", "1.0");
+    std::vector<std::string> candidates = {tool_path("fake-tool")};
+    ToolDiscovery discovery;
+
+    auto first = discovery.probe("fake-tool", candidates);
+    auto second = discovery.probe("fake-tool", candidates);
+
+    EXPECT_EQ(second.executable, first.executable);
+    EXPECT_EQ(second.version_output, first.version_output);
+    EXPECT_EQ(discovery.get_launch_count(), 1);
+}
+
+TEST_F(ToolDiscoveryTest, PersistsAcrossInstances) {
+    write_tool("fake-tool", "1.0");
+    std::vector<std::string> candidates = {tool_path("fake-tool")};
+    {
+        ToolDiscovery discovery(cache_file_);
+        discovery.probe("fake-tool", candidates);
+    }
+
+    ToolDiscovery reloaded(cache_file_);
+    ASSERT_TRUE(reloaded.load());
+    auto probe = reloaded.probe("fake-tool", candidates);
+
+    EXPECT_EQ(probe.version_output, "fake-tool 1.0\n");
+    EXPECT_EQ(reloaded.get_launch_count(), 0);
+}
+
+TEST_F(ToolDiscoveryTest, UpgradedExecutableIsProbedAgain) {
+    write_tool("fake-tool", "1.0");
+    std::vector<std::string> candidates = {tool_path("fake-tool")};
+    ToolDiscovery discovery(cache_file_);
+    discovery.probe("fake-tool", candidates);
+
+    write_tool("fake-tool", "1.10");
+    auto probe = discovery.probe("fake-tool", candidates);
+
+    EXPECT_EQ(probe.version_output, "fake-tool 1.10\n");
+    EXPECT_EQ(discovery.get_launch_count(), 2);
+}
+
+TEST_F(ToolDiscoveryTest, InstalledToolIsNoticed) {
+    std::vector<std::string> candidates = {tool_path("fake-tool")};
+    ToolDiscovery discovery(cache_file_);
+
+    EXPECT_FALSE(discovery.probe("fake-tool", candidates).found());
+    EXPECT_FALSE(discovery.probe("fake-tool", candidates).found());
+    EXPECT_EQ(discovery.get_launch_count(), 0);
+
+    write_tool("fake-tool", "1.0");
+    EXPECT_TRUE(discovery.probe("fake-tool", candidates).found());
+}
+
+TEST_F(ToolDiscoveryTest, CorruptCacheIsIgnored) {
+    {
+        std::ofstream file(cache_file_);
+        file << "{ not json";
+    }
+
+    ToolDiscovery discovery(cache_file_);
+    EXPECT_FALSE(discovery.load());
+
+    write_tool("fake-tool", "1.0");
+    EXPECT_TRUE(discovery.probe("fake-tool", {tool_path("fake-tool")}).found());
+    EXPECT_TRUE(ToolDiscovery(cache_file_).load());
+}
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace wip {
+namespace benchmark {
+
+/**
+ * @brief Keep a value alive so the compiler cannot drop the work producing it
+ */
+template<typename T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static const volatile void* sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * @brief One line of a benchmark report
+ */
+struct Result {
+    std::string name;
+    double value = 0.0;         // Nanoseconds per item for measure(), as given for report()
+    std::string unit;
+    std::uint64_t items = 0;    // Items per repetition, 0 for report()
+    double seconds = 0.0;       // Median time of one repetition
+    std::uint64_t checksum = 0;
+};
+
+/**
+ * @brief Command line, timing and reporting shared by the bench_* programs
+ *
+ * Options are taken out of the command line and the rest are positional
+ * arguments for the benchmark itself:
+ *
+ *   --repetitions=N  run every measure() N times and keep the median
+ *   --filter=TEXT    only run measurements whose name contains TEXT
+ *   --json[=PATH]    write results as JSON to PATH, or to stdout with the
+ *                    human-readable report moved to stderr
+ *   --baseline=PATH  compare with a file written by --json
+ *
+ * Unknown options print the usage and exit with status 2.
+ */
+class Runner {
+public:
+    /**
+     * @brief Constructor
+     * @param suite Name written to the JSON output, usually the target name
+     * @param argc Argument count from main()
+     * @param argv Arguments from main()
+     * @param positional Positional arguments for the usage line, e.g. "[count]"
+     */
+    Runner(std::string suite, int argc, char* argv[], const std::string& positional = "");
+
+    /**
+     * @brief Get the positional arguments
+     */
+    const std::vector<std::string>& arguments() const { return arguments_; }
+
+    /**
+     * @brief Get a positional argument as a number
+     * @param index Position among the positional arguments
+     * @param fallback Value when the argument is missing
+     */
+    std::size_t argument(std::size_t index, std::size_t fallback) const;
+
+    /**
+     * @brief Get a positional argument as text
+     * @param index Position among the positional arguments
+     * @param fallback Value when the argument is missing
+     */
+    std::string argument_string(std::size_t index, const std::string& fallback) const;
+
+    /**
+     * @brief Stream for the human-readable report
+     */
+    std::ostream& out() const;
+
+    /**
+     * @brief Check if a measurement passes --filter
+     */
+    bool selected(const std::string& name) const;
+
+    /**
+     * @brief Time run() and report nanoseconds per item
+     *
+     * run() does items units of work. When it returns a number, that is
+     * printed as a checksum, which also keeps the work from being optimized
+     * away.
+     *
+     * @param name Measurement name, unique within the suite
+     * @param items Units of work per call of run()
+     * @param run Function to time
+     * @return Nanoseconds per item, or 0 when filtered out
+     */
+    template<typename Run>
+    double measure(const std::string& name, std::uint64_t items, Run&& run);
+
+    /**
+     * @brief Report a metric the benchmark computed itself, e.g. GB/s
+     *
+     * Units ending in "/s" are throughputs, where higher is better in
+     * baseline comparisons; for all others lower is better.
+     *
+     * @param name Metric name, unique within the suite
+     * @param value Metric value
+     * @param unit Unit of the value
+     */
+    void report(const std::string& name, double value, const std::string& unit);
+
+    /**
+     * @brief Write the JSON output
+     * @return Exit status for main(): 0, or 1 if the JSON file could not be written
+     */
+    int finish();
+
+    /**
+     * @brief Get the results recorded so far
+     */
+    const std::vector<Result>& results() const { return results_; }
+
+private:
+    void record(Result result);
+    std::string baseline_change(const Result& result) const;
+
+    std::string suite_;
+    std::vector<std::string> arguments_;
+    std::size_t repetitions_ = 1;
+    std::string filter_;
+    bool json_ = false;
+    std::string json_path_;
+    std::unordered_map<std::string, double> baseline_;
+    std::vector<Result> results_;
+};
+
+/**
+ * @brief Read the values of a file written by --json, keyed by result name
+ * @param path JSON file path
+ * @return Values by name, empty if the file cannot be read
+ */
+std::unordered_map<std::string, double> load_baseline(const std::string& path);
+
+/**
+ * @brief Write results in the --json format
+ * @param out Stream to write to
+ * @param suite Suite name
+ * @param results Results to write
+ */
+void write_json(std::ostream& out, const std::string& suite, const std::vector<Result>& results);
+
+template<typename Run>
+double Runner::measure(const std::string& name, std::uint64_t items, Run&& run) {
+    if (!selected(name)) {
+        return 0.0;
+    }
+
+    std::vector<double> seconds(repetitions_);
+    std::uint64_t checksum = 0;
+    for (auto& elapsed : seconds) {
+        auto start = std::chrono::steady_clock::now();
+        if constexpr (std::is_void_v<decltype(run())>) {
+            run();
+        } else {
+            auto value = run();
+            do_not_optimize(value);
+            checksum = static_cast<std::uint64_t>(value);
+        }
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    Result result;
+    result.name = name;
+    result.unit = "ns/item";
+    result.items = items;
+    result.checksum = checksum;
+    std::sort(seconds.begin(), seconds.end());
+    result.seconds = seconds[seconds.size() / 2];
+    result.value = items > 0 ? result.seconds * 1e9 / static_cast<double>(items) : 0.0;
+    record(result);
+    return result.value;
+}
+
+} // namespace benchmark
+} // namespace wip
@@ -0,0 +1,222 @@
+#include "benchmark.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+namespace wip {
+namespace benchmark {
+
+namespace {
+
+bool starts_with(const std::string& text, const char* prefix) {
+    return text.rfind(prefix, 0) == 0;
+}
+
+void write_json_string(std::ostream& out, const std::string& text) {
+    out << '"';
+    for (char c : text) {
+        switch (c) {
+            case '"':  out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+                    out << escaped;
+                } else {
+                    out << c;
+                }
+        }
+    }
+    out << '"';
+}
+
+// Reads the string starting at the opening quote at, undoing write_json_string()
+std::string read_json_string(const std::string& line, size_t at) {
+    std::string text;
+    for (size_t i = at + 1; i < line.size() && line[i] != '"'; ++i) {
+        if (line[i] != '\\' || i + 1 >= line.size()) {
+            text += line[i];
+            continue;
+        }
+        switch (line[++i]) {
+            case 'n': text += '\n'; break;
+            case 't': text += '\t'; break;
+            case 'u':
+                text += static_cast<char>(std::strtol(line.substr(i + 1, 4).c_str(), nullptr, 16));
+                i += 4;
+                break;
+            default: text += line[i];
+        }
+    }
+    return text;
+}
+
+[[noreturn]] void usage(const std::string& program, const std::string& positional, int status) {
+    auto& out = status == 0 ? std::cout : std::cerr;
+    out << "Usage: " << program << " [--repetitions=N] [--filter=TEXT] [--json[=PATH]] [--baseline=PATH]";
+    if (!positional.empty()) out << ' ' << positional;
+    out << std::endl;
+    std::exit(status);
+}
+
+} // namespace
+
+Runner::Runner(std::string suite, int argc, char* argv[], const std::string& positional)
+    : suite_(std::move(suite)) {
+    const std::string program = argc > 0 ? argv[0] : suite_;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            usage(program, positional, 0);
+        } else if (starts_with(arg, "--repetitions=")) {
+            repetitions_ = std::max<size_t>(1, std::strtoul(arg.c_str() + 14, nullptr, 10));
+        } else if (starts_with(arg, "--filter=")) {
+            filter_ = arg.substr(9);
+        } else if (arg == "--json") {
+            json_ = true;
+        } else if (starts_with(arg, "--json=")) {
+            json_ = true;
+            json_path_ = arg.substr(7);
+        } else if (starts_with(arg, "--baseline=")) {
+            const std::string path = arg.substr(11);
+            baseline_ = load_baseline(path);
+            if (baseline_.empty()) {
+                std::cerr << "No results in baseline " << path << std::endl;
+                std::exit(2);
+            }
+        } else if (starts_with(arg, "--")) {
+            std::cerr << "Unknown option " << arg << std::endl;
+            usage(program, positional, 2);
+        } else {
+            arguments_.push_back(arg);
+        }
+    }
+}
+
+size_t Runner::argument(size_t index, size_t fallback) const {
+    return index < arguments_.size() ? std::stoul(arguments_[index]) : fallback;
+}
+
+std::string Runner::argument_string(size_t index, const std::string& fallback) const {
+    return index < arguments_.size() ? arguments_[index] : fallback;
+}
+
+std::ostream& Runner::out() const {
+    // Keep stdout clean for the JSON output
+    return json_ && json_path_.empty() ? std::cerr : std::cout;
+}
+
+bool Runner::selected(const std::string& name) const {
+    return filter_.empty() || name.find(filter_) != std::string::npos;
+}
+
+void Runner::report(const std::string& name, double value, const std::string& unit) {
+    if (!selected(name)) {
+        return;
+    }
+    Result result;
+    result.name = name;
+    result.value = value;
+    result.unit = unit;
+    record(result);
+}
+
+void Runner::record(Result result) {
+    auto& stream = out();
+    stream << std::left << std::setw(40) << result.name << std::right << std::fixed;
+    if (result.items > 0) {
+        stream << std::setprecision(1) << std::setw(10) << result.seconds * 1e3 << " ms"
+               << std::setprecision(result.value < 10.0 ? 2 : 1) << std::setw(10) << result.value << " ns/item";
+    } else {
+        stream << std::setprecision(result.value < 10.0 ? 3 : 1) << std::setw(13) << result.value << ' ' << result.unit;
+    }
+    if (result.checksum != 0) {
+        stream << "   (checksum " << result.checksum << ")";
+    }
+    stream << baseline_change(result) << std::endl;
+    results_.push_back(std::move(result));
+}
+
+std::string Runner::baseline_change(const Result& result) const {
+    auto it = baseline_.find(result.name);
+    if (it == baseline_.end() || it->second == 0.0 || result.value == 0.0) {
+        return "";
+    }
+    // Express the change as a speedup, whichever way the unit points
+    const bool throughput = result.unit.size() >= 2 && result.unit.compare(result.unit.size() - 2, 2, "/s") == 0;
+    const double ratio = throughput ? result.value / it->second : it->second / result.value;
+    std::ostringstream change;
+    change << std::fixed << std::setprecision(1) << "   " << std::abs(ratio - 1.0) * 100.0
+           << (ratio >= 1.0 ? "% faster" : "% slower") << " than baseline";
+    return change.str();
+}
+
+int Runner::finish() {
+    if (!json_) {
+        return 0;
+    }
+    if (json_path_.empty()) {
+        write_json(std::cout, suite_, results_);
+        return 0;
+    }
+    std::ofstream file(json_path_);
+    write_json(file, suite_, results_);
+    if (!file) {
+        std::cerr << "Could not write " << json_path_ << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+std::unordered_map<std::string, double> load_baseline(const std::string& path) {
+    // write_json() puts each result on its own line, with name first and value second
+    std::unordered_map<std::string, double> baseline;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+        const size_t name = line.find("{\"name\": \"");
+        const size_t value = line.find("\"value\": ");
+        if (name == std::string::npos || value == std::string::npos) continue;
+        baseline[read_json_string(line, name + 9)] = std::strtod(line.c_str() + value + 9, nullptr);
+    }
+    return baseline;
+}
+
+void write_json(std::ostream& out, const std::string& suite, const std::vector<Result>& results) {
+    char date[32] = "";
+    const std::time_t now = std::time(nullptr);
+    std::tm utc{};
+#ifdef _WIN32
+    gmtime_s(&utc, &now);
+#else
+    gmtime_r(&now, &utc);
+#endif
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", &utc);
+
+    out << "{\n  \"suite\": ";
+    write_json_string(out, suite);
+    out << ",\n  \"date\": \"" << date << "\",\n  \"hardware_threads\": " << std::thread::hardware_concurrency()
+        << ",\n  \"results\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& result = results[i];
+        out << (i == 0 ? "\n    " : ",\n    ") << "{\"name\": ";
+        write_json_string(out, result.name);
+        out << ", \"value\": " << std::setprecision(9) << std::defaultfloat << result.value << ", \"unit\": ";
+        write_json_string(out, result.unit);
+        out << ", \"items\": " << result.items << ", \"seconds\": " << result.seconds
+            << ", \"checksum\": " << result.checksum << '}';
+    }
+    out << "\n  ]\n}\n";
+}
+
+} // namespace benchmark
+} // namespace wip
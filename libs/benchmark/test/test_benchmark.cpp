@@ -0,0 +1,86 @@
+#include "benchmark.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace wip::benchmark;
+
+namespace {
+
+// Runner takes a mutable argv like main() gets
+class Arguments {
+public:
+    Arguments(std::initializer_list<std::string> args) : strings_(args) {
+        for (auto& arg : strings_) pointers_.push_back(arg.data());
+    }
+    int argc() { return static_cast<int>(pointers_.size()); }
+    char** argv() { return pointers_.data(); }
+
+private:
+    std::vector<std::string> strings_;
+    std::vector<char*> pointers_;
+};
+
+} // namespace
+
+TEST(BenchmarkTest, SeparatesOptionsFromPositionalArguments) {
+    Arguments args{"bench", "500", "--repetitions=3", "--filter=parse", "log.txt"};
+    Runner runner("bench_test", args.argc(), args.argv());
+    
+    ASSERT_EQ(runner.arguments().size(), 2u);
+    EXPECT_EQ(runner.argument(0, 10), 500u);
+    EXPECT_EQ(runner.argument(2, 10), 10u);
+    EXPECT_EQ(runner.argument_string(1, ""), "log.txt");
+    EXPECT_TRUE(runner.selected("parse json"));
+    EXPECT_FALSE(runner.selected("save json"));
+}
+
+TEST(BenchmarkTest, MeasureRepeatsAndSkipsFilteredNames) {
+    Arguments args{"bench", "--repetitions=3", "--filter=count", "--json=/dev/null"};
+    Runner runner("bench_test", args.argc(), args.argv());
+    
+    int calls = 0;
+    double ns = runner.measure("count calls", 1000, [&]() { return ++calls; });
+    runner.measure("skipped", 1000, [&]() { ++calls; });
+    
+    EXPECT_EQ(calls, 3);
+    EXPECT_GE(ns, 0.0);
+    ASSERT_EQ(runner.results().size(), 1u);
+    EXPECT_EQ(runner.results()[0].unit, "ns/item");
+    EXPECT_EQ(runner.results()[0].items, 1000u);
+    EXPECT_EQ(runner.results()[0].checksum, 3u);
+}
+
+TEST(BenchmarkTest, JsonRoundTripsThroughBaseline) {
+    std::vector<Result> results(2);
+    results[0].name = "parse \"quoted\" \\ names";
+    results[0].value = 12.5;
+    results[0].unit = "ns/item";
+    results[0].items = 100;
+    results[1].name = "throughput";
+    results[1].value = 3.25;
+    results[1].unit = "GB/s";
+    
+    std::ostringstream json;
+    write_json(json, "bench_test", results);
+    EXPECT_NE(json.str().find("\"suite\": \"bench_test\""), std::string::npos);
+    
+    const std::string path = ::testing::TempDir() + "bench_baseline.json";
+    {
+        std::ofstream file(path);
+        file << json.str();
+    }
+    auto baseline = load_baseline(path);
+    std::remove(path.c_str());
+    
+    ASSERT_EQ(baseline.size(), 2u);
+    EXPECT_DOUBLE_EQ(baseline["parse \"quoted\" \\ names"], 12.5);
+    EXPECT_DOUBLE_EQ(baseline["throughput"], 3.25);
+}
+
+TEST(BenchmarkTest, MissingBaselineIsEmpty) {
+    EXPECT_TRUE(load_baseline("/nonexistent/baseline.json").empty());
+}
@@ -0,0 +1,67 @@
+// Benchmark for command line parsing.
+//
+// Parses a gran_azul-style command line with a long --include list and a
+// few scalar options, repeatedly, through parse() with name lookups and
+// through parse_view() with handles. Reports the time per parse in
+// nanoseconds.
+// Usage:
+//
+//   bench_wip_cli_args [includes] [parses]
+
+#include "args.h"
+#include "benchmark.h"
+#include <string>
+#include <vector>
+
+namespace args = wip::cli::args;
+
+int main(int argc, char* argv[]) {
+    wip::benchmark::Runner runner("bench_wip_cli_args", argc, argv, "[includes] [parses]");
+    size_t include_count = runner.argument(0, 2000);
+    size_t parses = runner.argument(1, 2000);
+
+    args::ArgumentParser parser("gran_azul", "Static analysis driver");
+    auto verbose = parser.add_flag({"-v", "--verbose"}, "verbose").handle();
+    auto jobs = parser.add_option({"-j", "--jobs"}, "jobs").default_value(1).handle();
+    auto output = parser.add_option({"-o", "--output"}, "output").handle();
+    auto format = parser.add_option({"--format"}, "format").choices({"json", "text", "sarif"}).handle();
+    auto include = parser.add_option({"-I", "--include"}, "include").multiple().handle();
+    for (int i = 0; i < 24; ++i) {
+        parser.add_option({"--option-" + std::to_string(i)}, "option_" + std::to_string(i));
+    }
+
+    std::string include_list;
+    for (size_t i = 0; i < include_count; ++i) {
+        include_list += (i ? "," : "") + std::string("src/module_") + std::to_string(i) + "/include";
+    }
+    std::vector<std::string> storage = {"gran_azul", "--verbose", "-j", "8", "--option-17", "x",
+                                        "--output", "report.json", "--format", "sarif", "--include", include_list};
+    std::vector<char*> command_line;
+    for (auto& arg : storage) {
+        command_line.push_back(arg.data());
+    }
+    const int count = static_cast<int>(command_line.size());
+    runner.out() << "Parsing " << count - 1 << " arguments with " << include_count << " includes" << std::endl;
+
+    runner.measure("parse", parses, [&]() {
+        size_t checksum = 0;
+        for (size_t i = 0; i < parses; ++i) {
+            auto result = parser.parse(count, command_line.data());
+            checksum += result->get_bool("verbose").value_or(false) + result->get_int("jobs").value_or(0) +
+                        result->get_string("output")->size() + result->get_string("format")->size() +
+                        result->get_strings("include")->size();
+        }
+        return checksum;
+    });
+    runner.measure("parse_view", parses, [&]() {
+        size_t checksum = 0;
+        for (size_t i = 0; i < parses; ++i) {
+            auto view = parser.parse_view(count, command_line.data());
+            checksum += view->get_bool(verbose).value_or(false) + view->get_int(jobs).value_or(0) +
+                        view->get_string(output)->size() + view->get_string(format)->size() +
+                        view->get_strings(include)->size();
+        }
+        return checksum;
+    });
+    return runner.finish();
+}
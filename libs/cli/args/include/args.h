@@ -1,6 +1,9 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
 #include <optional>
@@ -101,12 +104,110 @@ private:
     std::unique_ptr<ParseResult> subcommand_result_;
 };
 
+/**
+ * @brief Position of an argument in its parser, resolved once at registration
+ *
+ * Reading an ArgsView through a handle is an index, not a name lookup.
+ */
+class ArgumentHandle {
+public:
+    explicit ArgumentHandle(std::size_t index) : index_(index) {}
+    
+    // Get the registration index
+    std::size_t index() const { return index_; }
+
+private:
+    std::size_t index_;
+};
+
+/**
+ * @brief Values of a multiple() option as views, e.g. the items of "a,b,c"
+ */
+class ValueList {
+public:
+    ValueList() = default;
+    ValueList(const std::string_view* begin, const std::string_view* end) : begin_(begin), end_(end) {}
+    
+    const std::string_view* begin() const { return begin_; }
+    const std::string_view* end() const { return end_; }
+    std::size_t size() const { return static_cast<std::size_t>(end_ - begin_); }
+    bool empty() const { return begin_ == end_; }
+    const std::string_view& operator[](std::size_t i) const { return begin_[i]; }
+
+private:
+    const std::string_view* begin_ = nullptr;
+    const std::string_view* end_ = nullptr;
+};
+
+/**
+ * @brief Parse results that point into the arguments instead of copying them
+ *
+ * Strings are views into argv, the environment or the parser's defaults,
+ * so an ArgsView must not outlive the arguments or the parser. Numbers and
+ * flags are converted during parsing, with the same rules as ParseResult.
+ */
+class ArgsView {
+public:
+    ArgsView() = default;
+    ArgsView(const ArgsView&) = delete;
+    ArgsView& operator=(const ArgsView&) = delete;
+    ArgsView(ArgsView&&) = default;
+    ArgsView& operator=(ArgsView&&) = default;
+    
+    // Check if argument was provided or has a default
+    bool has(ArgumentHandle handle) const;
+    
+    // Get argument value as string
+    std::optional<std::string_view> get_string(ArgumentHandle handle) const;
+    
+    // Get argument value as integer
+    std::optional<int> get_int(ArgumentHandle handle) const;
+    
+    // Get argument value as double
+    std::optional<double> get_double(ArgumentHandle handle) const;
+    
+    // Get argument value as boolean
+    std::optional<bool> get_bool(ArgumentHandle handle) const;
+    
+    // Get the values of a multiple() option
+    std::optional<ValueList> get_strings(ArgumentHandle handle) const;
+    
+    // Get the selected subcommand name (if any)
+    std::optional<std::string_view> get_subcommand() const;
+    
+    // Get the parse result for a subcommand, which is parsed by copying as before
+    const ParseResult* get_subcommand_result() const { return subcommand_result_.get(); }
+
+private:
+    friend class ArgumentParser;
+    
+    // Alternative index of ArgumentValue held by a slot
+    enum class Kind : std::uint8_t { Bool, Int, Double, String, Strings };
+    
+    struct Slot {
+        std::string_view text;
+        std::size_t first = 0;          // Range in items_ for Kind::Strings
+        std::size_t count = 0;
+        double number = 0.0;            // Kind::Double
+        int integer = 0;                // Kind::Int, and Kind::Bool as 0 or 1
+        Kind kind = Kind::String;
+        bool present = false;
+    };
+    
+    const Slot* slot(ArgumentHandle handle) const;
+    
+    std::vector<Slot> slots_;
+    std::vector<std::string_view> items_;
+    std::string_view subcommand_;
+    std::unique_ptr<ParseResult> subcommand_result_;
+};
+
 /**
  * @brief Fluent argument builder for type-safe argument specification
  */
 class ArgumentBuilder {
 public:
-    ArgumentBuilder(ArgumentSpec& spec) : spec_(spec) {}
+    ArgumentBuilder(ArgumentSpec& spec, std::size_t index = 0) : spec_(spec), index_(index) {}
     
     // Set description
     ArgumentBuilder& description(const std::string& desc);
@@ -136,8 +237,12 @@ public:
     // Set custom validator
     ArgumentBuilder& validator(Validator val);
     
+    // Get the handle for reading this argument from an ArgsView
+    ArgumentHandle handle() const { return ArgumentHandle(index_); }
+    
 private:
     ArgumentSpec& spec_;
+    std::size_t index_;
 };
 
 /**
@@ -199,6 +304,15 @@ public:
     // Parse arguments from vector
     Result<ParseResult> parse(const std::vector<std::string>& args) const;
     
+    // Parse arguments from command line without copying them
+    Result<ArgsView> parse_view(int argc, const char* const argv[]) const;
+    
+    // Parse arguments from views without copying them
+    Result<ArgsView> parse_view(const std::vector<std::string_view>& args) const;
+    
+    // Get the handle of an argument by name
+    std::optional<ArgumentHandle> handle(const std::string& name) const;
+    
     // Generate help text
     std::string help() const;
     
@@ -222,7 +336,10 @@ private:
     std::string description_;
     std::string version_;
     std::vector<ArgumentSpec> arguments_;
-    std::map<std::string, std::unique_ptr<SubCommand>> subcommands_;
+    std::map<std::string, std::unique_ptr<SubCommand>, std::less<>> subcommands_;
+    
+    // Flags sorted for binary search, with the index of their argument
+    std::vector<std::pair<std::string, std::size_t>> flag_index_;
     
     // Configuration
     std::vector<std::string> help_flags_ = {"-h", "--help"};
@@ -231,12 +348,17 @@ private:
     bool auto_version_ = true;
     
     // Helper methods
+    void index_flags(const std::vector<std::string>& flags, std::size_t index);
+    std::optional<std::size_t> find_index_by_flag(std::string_view flag) const;
     std::optional<ArgumentSpec*> find_argument_by_flag(const std::string& flag) const;
     ArgumentValue parse_value(const ArgumentSpec& spec, const std::string& value) const;
     bool validate_argument(const ArgumentSpec& spec, const ArgumentValue& value) const;
+    void set_view_value(const ArgumentSpec& spec, std::string_view value, ArgsView& view, ArgsView::Slot& slot) const;
+    bool validate_view_value(const ArgumentSpec& spec, std::string_view value, const ArgsView::Slot& slot) const;
     ArgumentValue get_default_or_env_value(const ArgumentSpec& spec) const;
-    bool is_help_flag(const std::string& flag) const;
-    bool is_version_flag(const std::string& flag) const;
+    bool is_help_flag(std::string_view flag) const;
+    bool is_version_flag(std::string_view flag) const;
+    void handle_help_and_version(const std::vector<std::string_view>& args) const;
     std::string generate_usage() const;
     std::vector<std::string> tokenize_arguments(int argc, char* argv[]) const;
 };
@@ -3,6 +3,7 @@
 #include <sstream>
 #include <algorithm>
 #include <cctype>
+#include <charconv>
 #include <cstdlib>
 #include <filesystem>
 
@@ -10,6 +11,67 @@ namespace wip {
 namespace cli {
 namespace args {
 
+namespace {
+
+// Whether a default or environment value is worth reporting through has()
+bool is_meaningful(const ArgumentValue& value) {
+    if (std::holds_alternative<bool>(value)) {
+        return true;  // bool defaults are always meaningful
+    } else if (std::holds_alternative<int>(value)) {
+        return std::get<int>(value) != 0;  // non-zero int is meaningful
+    } else if (std::holds_alternative<double>(value)) {
+        return std::get<double>(value) != 0.0;  // non-zero double is meaningful
+    } else if (std::holds_alternative<std::string>(value)) {
+        return !std::get<std::string>(value).empty();  // non-empty string is meaningful
+    }
+    return !std::get<std::vector<std::string>>(value).empty();  // non-empty vector is meaningful
+}
+
+// Like converters::to_int() and to_double(), but on a view and 0 when invalid
+template<typename T>
+T parse_number(std::string_view text) {
+    if (!text.empty() && text.front() == '+') {
+        text.remove_prefix(1);
+    }
+    T value{};
+    auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return ec == std::errc() && ptr == text.data() + text.size() ? value : T{};
+}
+
+bool equals_ignore_case(std::string_view text, std::string_view lower) {
+    if (text.size() != lower.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (std::tolower(static_cast<unsigned char>(text[i])) != lower[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Like converters::to_bool(), but on a view and false when invalid
+bool parse_bool(std::string_view text) {
+    for (std::string_view word : {"true", "1", "yes", "on"}) {
+        if (equals_ignore_case(text, word)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Split like converters::split(): no item after a trailing delimiter
+void split_views(std::string_view text, char delimiter, std::vector<std::string_view>& items) {
+    size_t pos = 0;
+    while (pos < text.size()) {
+        const size_t end = std::min(text.find(delimiter, pos), text.size());
+        items.push_back(text.substr(pos, end - pos));
+        pos = end + 1;
+    }
+}
+
+} // namespace
+
 // ==================== ParseResult Implementation ====================
 
 template<typename T>
@@ -81,6 +143,52 @@ std::optional<ParseResult> ParseResult::get_subcommand_result() const {
     return std::nullopt;
 }
 
+// ==================== ArgsView Implementation ====================
+
+const ArgsView::Slot* ArgsView::slot(ArgumentHandle handle) const {
+    if (handle.index() >= slots_.size() || !slots_[handle.index()].present) {
+        return nullptr;
+    }
+    return &slots_[handle.index()];
+}
+
+bool ArgsView::has(ArgumentHandle handle) const {
+    return slot(handle) != nullptr;
+}
+
+std::optional<std::string_view> ArgsView::get_string(ArgumentHandle handle) const {
+    const Slot* s = slot(handle);
+    return s && s->kind == Kind::String ? std::make_optional(s->text) : std::nullopt;
+}
+
+std::optional<int> ArgsView::get_int(ArgumentHandle handle) const {
+    const Slot* s = slot(handle);
+    return s && s->kind == Kind::Int ? std::make_optional(s->integer) : std::nullopt;
+}
+
+std::optional<double> ArgsView::get_double(ArgumentHandle handle) const {
+    const Slot* s = slot(handle);
+    return s && s->kind == Kind::Double ? std::make_optional(s->number) : std::nullopt;
+}
+
+std::optional<bool> ArgsView::get_bool(ArgumentHandle handle) const {
+    const Slot* s = slot(handle);
+    return s && s->kind == Kind::Bool ? std::make_optional(s->integer != 0) : std::nullopt;
+}
+
+std::optional<ValueList> ArgsView::get_strings(ArgumentHandle handle) const {
+    const Slot* s = slot(handle);
+    if (!s || s->kind != Kind::Strings) {
+        return std::nullopt;
+    }
+    const std::string_view* first = items_.data() + s->first;
+    return ValueList(first, first + s->count);
+}
+
+std::optional<std::string_view> ArgsView::get_subcommand() const {
+    return subcommand_.empty() ? std::nullopt : std::make_optional(subcommand_);
+}
+
 // ==================== ArgumentBuilder Implementation ====================
 
 ArgumentBuilder& ArgumentBuilder::description(const std::string& desc) {
@@ -382,8 +490,9 @@ ArgumentBuilder ArgumentParser::add_flag(const std::vector<std::string>& flags,
     spec.is_flag = true;
     spec.default_value = false;
     
+    index_flags(flags, arguments_.size());
     arguments_.push_back(spec);
-    return ArgumentBuilder(arguments_.back());
+    return ArgumentBuilder(arguments_.back(), arguments_.size() - 1);
 }
 
 ArgumentBuilder ArgumentParser::add_option(const std::vector<std::string>& flags, const std::string& name) {
@@ -393,8 +502,9 @@ ArgumentBuilder ArgumentParser::add_option(const std::vector<std::string>& flags
     spec.is_flag = false;
     spec.default_value = std::string{};
     
+    index_flags(flags, arguments_.size());
     arguments_.push_back(spec);
-    return ArgumentBuilder(arguments_.back());
+    return ArgumentBuilder(arguments_.back(), arguments_.size() - 1);
 }
 
 SubCommand& ArgumentParser::add_subcommand(const std::string& name, const std::string& description) {
@@ -438,19 +548,7 @@ Result<ParseResult> ArgumentParser::parse(const std::vector<std::string>& args)
         ArgumentValue value = get_default_or_env_value(spec);
         
         // Only add to result if there's a meaningful default value or environment variable
-        bool should_add = false;
-        
-        if (std::holds_alternative<bool>(value)) {
-            should_add = true;  // bool defaults are always meaningful
-        } else if (std::holds_alternative<int>(value)) {
-            should_add = (std::get<int>(value) != 0);  // non-zero int is meaningful
-        } else if (std::holds_alternative<double>(value)) {
-            should_add = (std::get<double>(value) != 0.0);  // non-zero double is meaningful
-        } else if (std::holds_alternative<std::string>(value)) {
-            should_add = !std::get<std::string>(value).empty();  // non-empty string is meaningful
-        } else if (std::holds_alternative<std::vector<std::string>>(value)) {
-            should_add = !std::get<std::vector<std::string>>(value).empty();  // non-empty vector is meaningful
-        }
+        bool should_add = is_meaningful(value);
         
         // Also add if there's an environment variable set (even if default was empty)
         if (!should_add && !spec.env_var.empty() && std::getenv(spec.env_var.c_str()) != nullptr) {
@@ -531,6 +629,128 @@ Result<ParseResult> ArgumentParser::parse(const std::vector<std::string>& args)
     return result;
 }
 
+Result<ArgsView> ArgumentParser::parse_view(int argc, const char* const argv[]) const {
+    std::vector<std::string_view> args;
+    args.reserve(argc > 1 ? static_cast<size_t>(argc - 1) : 0);
+    for (int i = 1; i < argc; ++i) { // Skip program name
+        args.emplace_back(argv[i]);
+    }
+    return parse_view(args);
+}
+
+Result<ArgsView> ArgumentParser::parse_view(const std::vector<std::string_view>& args) const {
+    handle_help_and_version(args);
+    
+    ArgsView view;
+    view.slots_.resize(arguments_.size());
+    
+    // Initialize with default values and environment variables, as parse() does
+    for (size_t i = 0; i < arguments_.size(); ++i) {
+        const auto& spec = arguments_[i];
+        auto& slot = view.slots_[i];
+        slot.kind = spec.is_flag ? ArgsView::Kind::Bool
+                  : spec.multiple ? ArgsView::Kind::Strings
+                  : static_cast<ArgsView::Kind>(spec.default_value.index());
+        
+        const char* env_value = spec.env_var.empty() ? nullptr : std::getenv(spec.env_var.c_str());
+        if (env_value) {
+            set_view_value(spec, env_value, view, slot);
+            continue;
+        }
+        if (!is_meaningful(spec.default_value)) {
+            continue;
+        }
+        
+        // Views of string defaults stay valid as long as the parser
+        if (const auto* text = std::get_if<std::string>(&spec.default_value)) {
+            if (slot.kind == ArgsView::Kind::String || slot.kind == ArgsView::Kind::Strings) {
+                set_view_value(spec, *text, view, slot);
+            }
+        } else if (const auto* items = std::get_if<std::vector<std::string>>(&spec.default_value)) {
+            if (slot.kind == ArgsView::Kind::Strings) {
+                slot.first = view.items_.size();
+                view.items_.insert(view.items_.end(), items->begin(), items->end());
+                slot.count = items->size();
+                slot.present = true;
+            }
+        } else if (slot.kind == static_cast<ArgsView::Kind>(spec.default_value.index())) {
+            if (const auto* flag = std::get_if<bool>(&spec.default_value)) {
+                slot.integer = *flag ? 1 : 0;
+            } else if (const auto* integer = std::get_if<int>(&spec.default_value)) {
+                slot.integer = *integer;
+            } else {
+                slot.number = std::get<double>(spec.default_value);
+            }
+            slot.present = true;
+        }
+    }
+    
+    for (size_t arg_index = 0; arg_index < args.size(); ++arg_index) {
+        const std::string_view arg = args[arg_index];
+        
+        // Check for subcommands first; their arguments are copied for SubCommand::parse()
+        auto subcmd = subcommands_.find(arg);
+        if (subcmd != subcommands_.end()) {
+            view.subcommand_ = arg;
+            std::vector<std::string> sub_args(args.begin() + arg_index + 1, args.end());
+            auto sub_result = subcmd->second->parse(sub_args);
+            if (!sub_result) {
+                return std::nullopt;
+            }
+            view.subcommand_result_ = std::make_unique<ParseResult>(std::move(sub_result.value()));
+            break;
+        }
+        
+        if (arg.empty() || arg.front() != '-') {
+            std::cerr << "Unexpected positional argument: " << arg << std::endl;
+            return std::nullopt;
+        }
+        
+        auto index = find_index_by_flag(arg);
+        if (!index) {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            return std::nullopt;
+        }
+        
+        const auto& spec = arguments_[*index];
+        auto& slot = view.slots_[*index];
+        if (spec.is_flag) {
+            slot.integer = 1;
+            slot.present = true;
+            continue;
+        }
+        
+        if (arg_index + 1 >= args.size()) {
+            std::cerr << "Argument " << arg << " requires a value" << std::endl;
+            return std::nullopt;
+        }
+        const std::string_view value = args[++arg_index];
+        set_view_value(spec, value, view, slot);
+        if (!validate_view_value(spec, value, slot)) {
+            return std::nullopt;
+        }
+    }
+    
+    // Check required arguments
+    for (size_t i = 0; i < arguments_.size(); ++i) {
+        if (arguments_[i].required && !view.slots_[i].present) {
+            std::cerr << "Required argument missing: " << arguments_[i].name << std::endl;
+            return std::nullopt;
+        }
+    }
+    
+    return view;
+}
+
+std::optional<ArgumentHandle> ArgumentParser::handle(const std::string& name) const {
+    for (size_t i = 0; i < arguments_.size(); ++i) {
+        if (arguments_[i].name == name) {
+            return ArgumentHandle(i);
+        }
+    }
+    return std::nullopt;
+}
+
 std::string ArgumentParser::help() const {
     std::ostringstream oss;
     
@@ -627,13 +847,30 @@ ArgumentParser& ArgumentParser::auto_version(bool enable) {
     return *this;
 }
 
+void ArgumentParser::index_flags(const std::vector<std::string>& flags, size_t index) {
+    // Insert after equal flags, so the first registration keeps winning
+    for (const auto& flag : flags) {
+        auto pos = std::upper_bound(flag_index_.begin(), flag_index_.end(), flag,
+                                    [](const std::string& f, const auto& entry) { return f < entry.first; });
+        flag_index_.emplace(pos, flag, index);
+    }
+}
+
+std::optional<size_t> ArgumentParser::find_index_by_flag(std::string_view flag) const {
+    auto it = std::lower_bound(flag_index_.begin(), flag_index_.end(), flag,
+                               [](const auto& entry, std::string_view f) { return entry.first < f; });
+    if (it == flag_index_.end() || it->first != flag) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
 std::optional<ArgumentSpec*> ArgumentParser::find_argument_by_flag(const std::string& flag) const {
-    for (auto& arg : const_cast<ArgumentParser*>(this)->arguments_) {
-        if (std::find(arg.flags.begin(), arg.flags.end(), flag) != arg.flags.end()) {
-            return &arg;
-        }
+    auto index = find_index_by_flag(flag);
+    if (!index) {
+        return std::nullopt;
     }
-    return std::nullopt;
+    return &const_cast<ArgumentParser*>(this)->arguments_[*index];
 }
 
 ArgumentValue ArgumentParser::parse_value(const ArgumentSpec& spec, const std::string& value) const {
@@ -685,6 +922,48 @@ bool ArgumentParser::validate_argument(const ArgumentSpec& spec, const ArgumentV
     return true;
 }
 
+void ArgumentParser::set_view_value(const ArgumentSpec& spec, std::string_view value, ArgsView& view, ArgsView::Slot& slot) const {
+    // Same conversions as parse_value(), without copying the text
+    slot.text = value;
+    slot.present = true;
+    switch (slot.kind) {
+        case ArgsView::Kind::Bool:
+            slot.integer = spec.is_flag || parse_bool(value) ? 1 : 0;
+            break;
+        case ArgsView::Kind::Int:
+            slot.integer = parse_number<int>(value);
+            break;
+        case ArgsView::Kind::Double:
+            slot.number = parse_number<double>(value);
+            break;
+        case ArgsView::Kind::Strings:
+            slot.first = view.items_.size();
+            split_views(value, ',', view.items_);
+            slot.count = view.items_.size() - slot.first;
+            break;
+        case ArgsView::Kind::String:
+            break;
+    }
+}
+
+bool ArgumentParser::validate_view_value(const ArgumentSpec& spec, std::string_view value, const ArgsView::Slot& slot) const {
+    // Custom validators take an ArgumentValue, so only they pay for a copy
+    if (spec.validator) {
+        return validate_argument(spec, parse_value(spec, std::string(value)));
+    }
+    if (spec.choices.empty()) {
+        return true;
+    }
+    if (slot.kind != ArgsView::Kind::String) {
+        return false;
+    }
+    if (std::find(spec.choices.begin(), spec.choices.end(), value) == spec.choices.end()) {
+        std::cerr << "Invalid choice for " << spec.name << ": " << value << std::endl;
+        return false;
+    }
+    return true;
+}
+
 ArgumentValue ArgumentParser::get_default_or_env_value(const ArgumentSpec& spec) const {
     // Check environment variable first
     if (!spec.env_var.empty()) {
@@ -698,14 +977,31 @@ ArgumentValue ArgumentParser::get_default_or_env_value(const ArgumentSpec& spec)
     return spec.default_value;
 }
 
-bool ArgumentParser::is_help_flag(const std::string& flag) const {
+bool ArgumentParser::is_help_flag(std::string_view flag) const {
     return std::find(help_flags_.begin(), help_flags_.end(), flag) != help_flags_.end();
 }
 
-bool ArgumentParser::is_version_flag(const std::string& flag) const {
+bool ArgumentParser::is_version_flag(std::string_view flag) const {
     return std::find(version_flags_.begin(), version_flags_.end(), flag) != version_flags_.end();
 }
 
+void ArgumentParser::handle_help_and_version(const std::vector<std::string_view>& args) const {
+    for (const auto& arg : args) {
+        if (auto_help_ && is_help_flag(arg)) {
+            std::cout << help() << std::endl;
+            std::exit(0);
+        }
+    }
+    if (auto_version_ && !version_.empty()) {
+        for (const auto& arg : args) {
+            if (is_version_flag(arg)) {
+                std::cout << program_name_ << " " << version_ << std::endl;
+                std::exit(0);
+            }
+        }
+    }
+}
+
 std::string ArgumentParser::generate_usage() const {
     std::ostringstream oss;
     oss << program_name_;
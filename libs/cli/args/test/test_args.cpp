@@ -459,4 +459,116 @@ TEST_F(ArgsTest, ParseResultAccessors) {
     EXPECT_NE(std::find(names.begin(), names.end(), "file"), names.end());
 }
 
+// ==================== Argv View Tests ====================
+
+TEST_F(ArgsTest, ViewParsingPointsIntoArgv) {
+    ArgumentParser parser("test");
+    auto verbose = parser.add_flag({"-v", "--verbose"}, "verbose").handle();
+    auto file = parser.add_option({"-f", "--file"}, "file").handle();
+    auto count = parser.add_option({"-c", "--count"}, "count").default_value(1).handle();
+    auto ratio = parser.add_option({"--ratio"}, "ratio").default_value(0.5).handle();
+    
+    const char* argv[] = {"test", "--file", "input.txt", "-c", "42", "--ratio", "+2.25"};
+    auto view = parser.parse_view(7, argv);
+    ASSERT_TRUE(view.has_value());
+    
+    EXPECT_FALSE(view->get_bool(verbose).value_or(true));
+    ASSERT_TRUE(view->get_string(file).has_value());
+    EXPECT_EQ(view->get_string(file)->data(), argv[2]);
+    EXPECT_EQ(view->get_int(count).value_or(0), 42);
+    EXPECT_DOUBLE_EQ(view->get_double(ratio).value_or(0.0), 2.25);
+    
+    // Accessors of the wrong type find nothing, as with ParseResult
+    EXPECT_FALSE(view->get_int(file).has_value());
+    EXPECT_FALSE(view->get_string(count).has_value());
+}
+
+TEST_F(ArgsTest, ViewMatchesParseResult) {
+    ArgumentParser parser("test");
+    parser.add_flag({"-v"}, "verbose");
+    parser.add_option({"-n"}, "count").default_value(3);
+    parser.add_option({"-l"}, "level").default_value(0);
+    parser.add_option({"-m"}, "mode").choices({"fast", "slow"});
+    parser.add_option({"--bad"}, "bad").default_value(7);
+    
+    const std::vector<std::string> args = {"-v", "-m", "slow", "--bad", "12x"};
+    auto result = parser.parse(args);
+    auto view = parser.parse_view(std::vector<std::string_view>(args.begin(), args.end()));
+    ASSERT_TRUE(result.has_value());
+    ASSERT_TRUE(view.has_value());
+    
+    for (const std::string name : {"verbose", "count", "level", "mode", "bad"}) {
+        auto handle = parser.handle(name);
+        ASSERT_TRUE(handle.has_value()) << name;
+        EXPECT_EQ(view->has(*handle), result->has(name)) << name;
+        EXPECT_EQ(view->get_bool(*handle), result->get_bool(name)) << name;
+        EXPECT_EQ(view->get_int(*handle), result->get_int(name)) << name;
+        EXPECT_EQ(view->get_string(*handle).has_value(), result->get_string(name).has_value()) << name;
+    }
+    EXPECT_FALSE(parser.handle("missing").has_value());
+    
+    EXPECT_FALSE(parser.parse_view({"-m", "medium"}).has_value());
+    EXPECT_FALSE(parser.parse_view({"--unknown"}).has_value());
+    EXPECT_FALSE(parser.parse_view({"-n"}).has_value());
+    EXPECT_FALSE(parser.parse_view({"positional"}).has_value());
+    EXPECT_FALSE(parser.parse_view({""}).has_value());
+}
+
+TEST_F(ArgsTest, ViewSplitsMultipleValuesInPlace) {
+    ArgumentParser parser("test");
+    auto include = parser.add_option({"-I", "--include"}, "include").multiple().handle();
+    auto exclude = parser.add_option({"-x"}, "exclude").multiple()
+        .default_value(std::vector<std::string>{"build", "out"}).handle();
+    
+    const std::string list = "src,include,,test,";
+    auto view = parser.parse_view({"--include", list});
+    ASSERT_TRUE(view.has_value());
+    
+    auto includes = view->get_strings(include);
+    ASSERT_TRUE(includes.has_value());
+    ASSERT_EQ(includes->size(), 4u);
+    EXPECT_EQ((*includes)[0], "src");
+    EXPECT_EQ((*includes)[1], "include");
+    EXPECT_EQ((*includes)[2], "");
+    EXPECT_EQ((*includes)[3], "test");
+    EXPECT_EQ((*includes)[1].data(), list.data() + 4);
+    EXPECT_EQ(std::vector<std::string>(includes->begin(), includes->end()),
+              parser.parse({"--include", list})->get_strings("include").value());
+    
+    auto excludes = view->get_strings(exclude);
+    ASSERT_TRUE(excludes.has_value());
+    EXPECT_EQ(std::vector<std::string_view>(excludes->begin(), excludes->end()),
+              (std::vector<std::string_view>{"build", "out"}));
+}
+
+TEST_F(ArgsTest, ViewUsesEnvironmentAndRequiredChecks) {
+    setenv("TEST_COUNT", "9", 1);
+    
+    ArgumentParser parser("test");
+    auto count = parser.add_option({"-c"}, "count").default_value(1).env("TEST_COUNT").handle();
+    auto file = parser.add_option({"-f"}, "file").required().validator(validators::one_of({"a.txt"})).handle();
+    
+    EXPECT_FALSE(parser.parse_view(std::vector<std::string_view>{}).has_value());
+    EXPECT_FALSE(parser.parse_view({"-f", "b.txt"}).has_value());
+    
+    auto view = parser.parse_view({"-f", "a.txt"});
+    ASSERT_TRUE(view.has_value());
+    EXPECT_EQ(view->get_int(count).value_or(0), 9);
+    EXPECT_EQ(view->get_string(file).value_or(""), "a.txt");
+}
+
+TEST_F(ArgsTest, ViewParsesSubcommands) {
+    ArgumentParser parser("git");
+    auto verbose = parser.add_flag({"-v"}, "verbose").handle();
+    auto& add_cmd = parser.add_subcommand("add", "Add files");
+    add_cmd.add_flag({"-A", "--all"}, "all");
+    
+    auto view = parser.parse_view({"-v", "add", "--all"});
+    ASSERT_TRUE(view.has_value());
+    EXPECT_TRUE(view->get_bool(verbose).value_or(false));
+    EXPECT_EQ(view->get_subcommand().value_or(""), "add");
+    ASSERT_NE(view->get_subcommand_result(), nullptr);
+    EXPECT_TRUE(view->get_subcommand_result()->get_bool("all").value_or(false));
+}
+
 // To run the tests, use the command: ctest --output-on-failure
\ No newline at end of file
@@ -0,0 +1,91 @@
+// Benchmark for dice rolling and probability distributions.
+//
+// Rolls single dice one call at a time and into a buffer, rolls a kept-dice
+// pool with and without a per-die record, evaluates an expression by parsing
+// it on every call and through a CompiledDiceExpression, and computes exact
+// and Monte Carlo distributions. Reports the time per roll or per
+// distribution in nanoseconds. Usage:
+//
+//   bench_wip_game_dice [rolls]
+
+#include "benchmark.h"
+#include "dice.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace wip::game::dice;
+
+int main(int argc, char* argv[]) {
+    wip::benchmark::Runner runner("bench_wip_game_dice", argc, argv, "[rolls]");
+    size_t rolls = runner.argument(0, 1000000);
+    auto rng = std::make_shared<wip::utils::rng::RandomGenerator>(12345);
+    runner.out() << "Making " << rolls << " rolls" << std::endl;
+
+    Die<int> d6(6, rng);
+    runner.measure("d6 roll", rolls, [&]() {
+        size_t total = 0;
+        for (size_t i = 0; i < rolls; ++i) {
+            total += d6.roll();
+        }
+        return total;
+    });
+    std::vector<int> faces(rolls);
+    runner.measure("d6 roll into buffer", rolls, [&]() {
+        d6.roll(faces.data(), faces.size());
+        return faces.back();
+    });
+
+    // Ability scores: 4d6, keep the highest three
+    Die<int> pool(6, rng);
+    pool.add_modifier(Modifier(ModifierType::KeepHighest, 3));
+    const size_t pool_rolls = rolls / 4;
+    runner.measure("4d6kh3 roll_detailed", pool_rolls, [&]() {
+        size_t total = 0;
+        for (size_t i = 0; i < pool_rolls; ++i) {
+            total += pool.roll_detailed(4).final_total;
+        }
+        return total;
+    });
+    runner.measure("4d6kh3 roll_summary", pool_rolls, [&]() {
+        size_t total = 0;
+        for (size_t i = 0; i < pool_rolls; ++i) {
+            total += pool.roll_summary(4).final_total;
+        }
+        return total;
+    });
+
+    const std::string expression = "4d6kh3 + 1d8 - 2";
+    const size_t evaluations = rolls / 10;
+    runner.measure("DiceExpression::evaluate", evaluations, [&]() {
+        size_t total = 0;
+        for (size_t i = 0; i < evaluations; ++i) {
+            total += DiceExpression::evaluate(expression).final_total;
+        }
+        return total;
+    });
+    CompiledDiceExpression compiled(expression, rng);
+    runner.measure("CompiledDiceExpression::roll", evaluations, [&]() {
+        size_t total = 0;
+        for (size_t i = 0; i < evaluations; ++i) {
+            total += compiled.roll();
+        }
+        return total;
+    });
+
+    runner.measure("exact distribution 10d6kh3 + 1d8 - 2", 1, [&]() {
+        return CompiledDiceExpression("10d6kh3 + 1d8 - 2").distribution().max_total();
+    });
+    runner.measure("exact distribution 20d20", 1, [&]() {
+        return CompiledDiceExpression("20d20").distribution().max_total();
+    });
+
+    DistributionOptions sampled;
+    sampled.samples = rolls;
+    sampled.seed = 1;
+    runner.measure("Monte Carlo 3d6e6 per sample", rolls, [&]() {
+        return CompiledDiceExpression("3d6e6").distribution(sampled).min_total();
+    });
+
+    return runner.finish();
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <memory>
@@ -40,6 +41,16 @@ enum class ModifierType {
     DropLowest      // Drop N lowest dice
 };
 
+enum class DistributionMethod {
+    Automatic,      // Exact when the dice allow it, otherwise Monte Carlo
+    Exact,          // Convolution and order statistics, fails for exploding dice
+    MonteCarlo      // Estimate from sampled rolls
+};
+
+// Limits that keep rerolling and exploding dice from looping forever
+constexpr int MAX_REROLLS = 10;
+constexpr int MAX_EXPLOSIONS = 100;
+
 // ==================== Utility Classes ====================
 
 /**
@@ -103,6 +114,40 @@ public:
     std::string to_string() const;
 };
 
+/**
+ * @brief Totals of a roll without the per-die record, for hot paths
+ */
+struct RollSummary {
+    int final_total = 0;
+    int kept_count = 0;
+    int lowest_kept = 0;
+    int highest_kept = 0;
+    
+    int total() const { return final_total; }
+    int count() const { return kept_count; }
+    int min_value() const { return lowest_kept; }
+    int max_value() const { return highest_kept; }
+};
+
+/**
+ * @brief Ranks of the dice kept by keep and drop modifiers, lowest first
+ */
+struct KeptRange {
+    int lo;
+    int hi;
+};
+
+/**
+ * @brief Apply keep and drop modifiers to ranks of rolled dice
+ *
+ * Each modifier trims the dice kept so far, in order, and does nothing when
+ * it asks for as many dice as remain or more; other modifiers are ignored.
+ * @param count Number of dice rolled
+ * @param modifiers Modifiers to apply
+ * @return Kept ranks [lo, hi)
+ */
+KeptRange kept_range(int count, const std::vector<Modifier>& modifiers);
+
 // ==================== Die Class Template ====================
 
 /**
@@ -147,6 +192,13 @@ public:
      */
     std::vector<T> roll(int count);
     
+    /**
+     * @brief Roll the die multiple times into a caller-provided buffer
+     * @param out Buffer receiving the results
+     * @param count Number of rolls, at most the size of out
+     */
+    void roll(T* out, size_t count);
+    
     /**
      * @brief Roll with advantage/disadvantage
      * @param type Type of roll (Normal, Advantage, Disadvantage)
@@ -180,6 +232,17 @@ public:
      */
     RollResult roll_detailed(int count);
     
+    /**
+     * @brief Roll multiple dice with modifiers, keeping only the totals
+     *
+     * Rolls and totals exactly as roll_detailed(count) with the same
+     * generator state, but records no individual dice or breakdown and does
+     * not allocate for up to SUMMARY_STACK_DICE dice.
+     * @param count Number of dice to roll
+     * @return Summary of the roll
+     */
+    RollSummary roll_summary(int count);
+    
     // ==================== Convenience Methods ====================
     
     /**
@@ -207,7 +270,7 @@ public:
      * @param max_rerolls Maximum number of rerolls to prevent infinite loops
      * @return Final roll value
      */
-    T reroll_on(T reroll_on, int max_rerolls = 10);
+    T reroll_on(T reroll_on, int max_rerolls = MAX_REROLLS);
     
     // ==================== Information ====================
     
@@ -271,6 +334,9 @@ private:
     std::vector<Modifier> modifiers_;
     std::shared_ptr<wip::utils::rng::RandomGenerator> rng_;
     
+    static constexpr int SUMMARY_STACK_DICE = 64;
+    
+    int roll_with_modifiers(SingleRollResult* record);
     void apply_modifiers(std::vector<SingleRollResult>& rolls, RollResult& result);
 };
 
@@ -305,6 +371,12 @@ public:
      */
     std::vector<T> roll();
     
+    /**
+     * @brief Roll all dice into a caller-provided buffer
+     * @param out Buffer receiving one result per die, at least size() long
+     */
+    void roll(T* out);
+    
     /**
      * @brief Roll all dice with detailed results
      * @return Combined roll result
@@ -343,24 +415,198 @@ private:
     std::vector<Die<T>> dice_;
 };
 
-// ==================== Dice Expression Parser ====================
+// ==================== Probability Distributions ====================
 
-class DiceExpression {
+/**
+ * @brief Options for computing the distribution of a dice expression
+ */
+struct DistributionOptions {
+    DistributionMethod method = DistributionMethod::Automatic;
+    uint64_t samples = 1000000;     // Rolls to simulate for Monte Carlo
+    unsigned threads = 0;           // Worker threads for Monte Carlo, 0 for one per core
+    uint64_t seed = 0;              // Monte Carlo results depend only on this and samples
+};
+
+/**
+ * @brief Probability distribution of the total of a dice expression
+ */
+class Distribution {
 public:
-    static RollResult evaluate(const std::string& expression);
-    static bool is_valid(const std::string& expression);
-    static std::string help_text();
+    /**
+     * @brief Construct from probabilities of consecutive totals
+     * @param min_total Total of the first probability
+     * @param pmf Probability of each total from min_total up
+     * @param samples Rolls the probabilities were estimated from, 0 if exact
+     */
+    Distribution(int min_total, std::vector<double> pmf, uint64_t samples = 0);
+    
+    /**
+     * @brief Get the lowest total with nonzero probability
+     */
+    int min_total() const { return min_total_; }
+    
+    /**
+     * @brief Get the highest total with nonzero probability
+     */
+    int max_total() const { return min_total_ + static_cast<int>(pmf_.size()) - 1; }
+    
+    /**
+     * @brief Get probability of each total from min_total() to max_total()
+     */
+    const std::vector<double>& pmf() const { return pmf_; }
+    
+    /**
+     * @brief Get probability of each total or less, from min_total() to max_total()
+     */
+    const std::vector<double>& cdf() const { return cdf_; }
+    
+    /**
+     * @brief Get probability of rolling exactly a total
+     */
+    double probability(int total) const;
+    
+    /**
+     * @brief Get probability of rolling a total or less
+     */
+    double cumulative(int total) const;
+    
+    /**
+     * @brief Get probability of rolling a total or more
+     */
+    double at_least(int total) const;
+    
+    double mean() const { return mean_; }
+    double variance() const { return variance_; }
+    double stddev() const;
+    
+    /**
+     * @brief Check whether the probabilities are exact rather than estimated
+     */
+    bool is_exact() const { return samples_ == 0; }
+    
+    /**
+     * @brief Get the number of rolls simulated, 0 if exact
+     */
+    uint64_t samples() const { return samples_; }
+
+private:
+    int min_total_;
+    std::vector<double> pmf_;
+    std::vector<double> cdf_;
+    double mean_ = 0.0;
+    double variance_ = 0.0;
+    uint64_t samples_;
+};
+
+// ==================== Dice Expressions ====================
+
+/**
+ * @brief A dice expression parsed once and rolled many times
+ *
+ * An expression is a sum of terms such as "2d6+1d4+3" or "4d6dl1-1". Each
+ * die of a term is rerolled while it shows a reroll value (up to
+ * MAX_REROLLS times), then rolls again and adds while it shows an explode
+ * value (up to MAX_EXPLOSIONS times), then keep and drop modifiers apply in
+ * order. roll() does not allocate, so a compiled expression suits hot loops.
+ */
+class CompiledDiceExpression {
+public:
+    /**
+     * @brief Parse an expression
+     * @param expression Dice notation, see DiceExpression::help_text()
+     * @param rng Generator to roll with (uses the calling thread's global generator if not provided)
+     * @throws std::invalid_argument if the expression is invalid
+     */
+    explicit CompiledDiceExpression(const std::string& expression,
+                                    std::shared_ptr<wip::utils::rng::RandomGenerator> rng = nullptr);
+    
+    /**
+     * @brief Roll the expression
+     * @return Total of the roll
+     */
+    int roll();
+    
+    /**
+     * @brief Roll the expression, recording every die
+     * @return Detailed roll result
+     */
+    RollResult roll_detailed();
+    
+    /**
+     * @brief Compute the distribution of the expression's total
+     *
+     * Without exploding dice the distribution is exact: terms are convolved,
+     * plain sums by convolution of the per-die probabilities and keep and
+     * drop by a dynamic program over order statistics. Exploding dice are
+     * simulated on several threads, each chunk of rolls drawing from its own
+     * counter-based stream so the estimate is the same for any thread count.
+     * @throws std::invalid_argument for an exploding expression when
+     *         options.method is Exact
+     */
+    Distribution distribution(const DistributionOptions& options = {}) const;
+    
+    /**
+     * @brief Get the expression as written
+     */
+    const std::string& expression() const { return expression_; }
+    
+    /**
+     * @brief Check whether any die explodes, which makes totals unbounded
+     */
+    bool is_exploding() const;
 
 private:
-    struct ParsedExpression {
-        int count = 1;
-        int sides = 6;
-        std::vector<Modifier> modifiers;
+    struct Term {
+        int sign = 1;
+        int count = 0;                  // Dice rolled, 0 for a constant
+        int sides = 0;
         int constant = 0;
+        int kept_lo = 0;                // Kept dice by rank, lowest first, after keep and drop
+        int kept_hi = 0;
+        std::vector<int> reroll_on;
+        std::vector<int> explode_on;
+        std::string text;
     };
     
-    static ParsedExpression parse(const std::string& expression);
-    static RollResult evaluate_parsed(const ParsedExpression& parsed);
+    static Term parse_term(const std::string& text, size_t& pos);
+    static int parse_number(const std::string& text, size_t& pos);
+    
+    wip::utils::rng::RandomGenerator& generator();
+    
+    template<typename Generator>
+    static int roll_face(Generator& rng, const Term& term, bool* rerolled = nullptr);
+    
+    template<typename Generator>
+    int sample(Generator& rng, int* dice) const;
+    
+    Distribution exact_distribution() const;
+    Distribution sampled_distribution(const DistributionOptions& options) const;
+    
+    std::string expression_;
+    std::vector<Term> terms_;
+    std::shared_ptr<wip::utils::rng::RandomGenerator> rng_;
+    std::vector<int> dice_;            // Scratch for the largest term, so roll() does not allocate
+};
+
+/**
+ * @brief One-off evaluation of dice expressions
+ *
+ * Each call parses its expression; compile one with CompiledDiceExpression
+ * to roll it repeatedly.
+ */
+class DiceExpression {
+public:
+    static RollResult evaluate(const std::string& expression);
+    static bool is_valid(const std::string& expression);
+    static std::string help_text();
+    
+    /**
+     * @brief Compute the distribution of an expression's total
+     * @see CompiledDiceExpression::distribution
+     * @throws std::invalid_argument for an invalid expression, or for an
+     *         exploding one when options.method is Exact
+     */
+    static Distribution distribution(const std::string& expression, const DistributionOptions& options = {});
 };
 
 // ==================== Gaming Utilities ====================
@@ -451,14 +697,25 @@ std::vector<T> Die<T>::roll(int count) {
         throw std::invalid_argument("Roll count cannot be negative");
     }
     
-    std::vector<T> results;
-    results.reserve(count);
-    for (int i = 0; i < count; ++i) {
-        results.push_back(roll());
-    }
+    std::vector<T> results(static_cast<size_t>(count));
+    roll(results.data(), results.size());
     return results;
 }
 
+template<typename T>
+void Die<T>::roll(T* out, size_t count) {
+    // Bulk draws of face indices through a stack block instead of a distribution call per roll
+    constexpr size_t BLOCK = 256;
+    int indices[BLOCK];
+    for (size_t done = 0; done < count; done += BLOCK) {
+        const size_t n = std::min(BLOCK, count - done);
+        rng_->fill_uniform_int(indices, n, 0, static_cast<int>(faces_.size()) - 1);
+        for (size_t i = 0; i < n; ++i) {
+            out[done + i] = faces_[indices[i]];
+        }
+    }
+}
+
 template<typename T>
 T Die<T>::roll(RollType type) {
     switch (type) {
@@ -492,9 +749,10 @@ RollResult Die<T>::roll_detailed(int count) {
     result.individual_rolls.reserve(count);
     
     for (int i = 0; i < count; ++i) {
-        T roll_value = roll();
         if constexpr (std::is_arithmetic_v<T>) {
-            result.individual_rolls.emplace_back(static_cast<int>(roll_value));
+            SingleRollResult single(0);
+            roll_with_modifiers(&single);
+            result.individual_rolls.push_back(std::move(single));
         }
     }
     
@@ -513,6 +771,57 @@ RollResult Die<T>::roll_detailed(int count) {
     return result;
 }
 
+template<typename T>
+RollSummary Die<T>::roll_summary(int count) {
+    static_assert(std::is_arithmetic_v<T>, "Roll summaries need numeric faces");
+    if (count < 0) {
+        throw std::invalid_argument("Roll count cannot be negative");
+    }
+    
+    int stack_values[SUMMARY_STACK_DICE];
+    std::vector<int> heap_values;
+    int* values = stack_values;
+    if (count > SUMMARY_STACK_DICE) {
+        heap_values.resize(static_cast<size_t>(count));
+        values = heap_values.data();
+    }
+    for (int i = 0; i < count; ++i) {
+        values[i] = roll_with_modifiers(nullptr);
+    }
+    
+    // Partition the kept ranks into [lo, hi) rather than sorting every die
+    const KeptRange kept = kept_range(count, modifiers_);
+    if (kept.lo > 0) {
+        std::nth_element(values, values + kept.lo, values + count);
+    }
+    if (kept.hi < count && kept.hi > kept.lo) {
+        std::nth_element(values + kept.lo, values + kept.hi, values + count);
+    }
+    
+    RollSummary summary;
+    summary.kept_count = kept.hi - kept.lo;
+    if (summary.kept_count > 0) {
+        auto [lowest, highest] = std::minmax_element(values + kept.lo, values + kept.hi);
+        summary.lowest_kept = *lowest;
+        summary.highest_kept = *highest;
+    }
+    summary.final_total = std::accumulate(values + kept.lo, values + kept.hi, 0);
+    
+    // Arithmetic modifiers apply to the total, as in apply_modifiers
+    for (const auto& modifier : modifiers_) {
+        switch (modifier.type) {
+            case ModifierType::Add:      summary.final_total += modifier.value; break;
+            case ModifierType::Subtract: summary.final_total -= modifier.value; break;
+            case ModifierType::Multiply: summary.final_total *= modifier.value; break;
+            case ModifierType::Divide:
+                if (modifier.value != 0) summary.final_total /= modifier.value;
+                break;
+            default: break;
+        }
+    }
+    return summary;
+}
+
 template<typename T>
 T Die<T>::advantage() {
     T roll1 = roll();
@@ -538,9 +847,8 @@ T Die<T>::exploding(std::optional<T> explode_on) {
     
     // Prevent infinite loops
     int explosion_count = 0;
-    const int max_explosions = 100;
     
-    while (current == *explode_on && explosion_count < max_explosions) {
+    while (current == *explode_on && explosion_count < MAX_EXPLOSIONS) {
         current = roll();
         total = static_cast<T>(static_cast<int>(total) + static_cast<int>(current));
         ++explosion_count;
@@ -610,6 +918,40 @@ std::string Die<T>::to_string() const {
     }
 }
 
+template<typename T>
+int Die<T>::roll_with_modifiers(SingleRollResult* record) {
+    auto has_modifier = [this](ModifierType type, int value) {
+        return std::any_of(modifiers_.begin(), modifiers_.end(), [&](const Modifier& modifier) {
+            return modifier.type == type && modifier.value == value;
+        });
+    };
+    auto roll_rerolling = [&](bool& rerolled) {
+        int value = static_cast<int>(roll());
+        for (int rerolls = 0; rerolls < MAX_REROLLS && has_modifier(ModifierType::RerollOn, value); ++rerolls) {
+            value = static_cast<int>(roll());
+            rerolled = true;
+        }
+        return value;
+    };
+    
+    bool rerolled = false;
+    int value = roll_rerolling(rerolled);
+    int total = value;
+    for (int explosions = 0; explosions < MAX_EXPLOSIONS && has_modifier(ModifierType::ExplodingOn, value); ++explosions) {
+        value = roll_rerolling(rerolled);
+        total += value;
+        if (record) {
+            record->explosion_chain.push_back(value);
+            record->was_exploded = true;
+        }
+    }
+    if (record) {
+        record->value = total;
+        record->was_rerolled = rerolled;
+    }
+    return total;
+}
+
 template<typename T>
 void Die<T>::apply_modifiers(std::vector<SingleRollResult>& rolls, RollResult& result) {
     // Initially, all rolls are kept
@@ -704,6 +1046,56 @@ void Die<T>::apply_modifiers(std::vector<SingleRollResult>& rolls, RollResult& r
     }
 }
 
+// CompiledDiceExpression template implementations
+template<typename Generator>
+int CompiledDiceExpression::roll_face(Generator& rng, const Term& term, bool* rerolled) {
+    auto rerolls_on = [&term](int value) {
+        return std::find(term.reroll_on.begin(), term.reroll_on.end(), value) != term.reroll_on.end();
+    };
+    
+    int value = rng.uniform_int(1, term.sides);
+    for (int rerolls = 0; rerolls < MAX_REROLLS && rerolls_on(value); ++rerolls) {
+        value = rng.uniform_int(1, term.sides);
+        if (rerolled) *rerolled = true;
+    }
+    return value;
+}
+
+template<typename Generator>
+int CompiledDiceExpression::sample(Generator& rng, int* dice) const {
+    long long total = 0;
+    for (const auto& term : terms_) {
+        if (term.count == 0) {
+            total += term.sign * term.constant;
+            continue;
+        }
+        
+        for (int i = 0; i < term.count; ++i) {
+            int value = roll_face(rng, term);
+            dice[i] = value;
+            for (int explosions = 0; explosions < MAX_EXPLOSIONS &&
+                 std::find(term.explode_on.begin(), term.explode_on.end(), value) != term.explode_on.end();
+                 ++explosions) {
+                value = roll_face(rng, term);
+                dice[i] += value;
+            }
+        }
+        
+        if (term.kept_lo > 0) {
+            std::nth_element(dice, dice + term.kept_lo, dice + term.count);
+        }
+        if (term.kept_hi < term.count && term.kept_hi > term.kept_lo) {
+            std::nth_element(dice + term.kept_lo, dice + term.kept_hi, dice + term.count);
+        }
+        long long sum = 0;
+        for (int i = term.kept_lo; i < term.kept_hi; ++i) {
+            sum += dice[i];
+        }
+        total += term.sign * sum;
+    }
+    return static_cast<int>(total);
+}
+
 // DiceSet template implementations
 template<typename T>
 void DiceSet<T>::add_die(const Die<T>& die) {
@@ -724,14 +1116,18 @@ void DiceSet<T>::clear() {
 
 template<typename T>
 std::vector<T> DiceSet<T>::roll() {
-    std::vector<T> results;
-    results.reserve(dice_.size());
-    for (auto& die : dice_) {
-        results.push_back(die.roll());
-    }
+    std::vector<T> results(dice_.size());
+    roll(results.data());
     return results;
 }
 
+template<typename T>
+void DiceSet<T>::roll(T* out) {
+    for (size_t i = 0; i < dice_.size(); ++i) {
+        out[i] = dice_[i].roll();
+    }
+}
+
 template<typename T>
 RollResult DiceSet<T>::roll_detailed() {
     RollResult combined_result;
@@ -1,6 +1,6 @@
 #include "dice.h"
-#include <regex>
 #include <cctype>
+#include <limits>
 
 namespace wip {
 namespace game {
@@ -30,12 +30,251 @@ std::string RollResult::to_string() const {
     return ss.str();
 }
 
+// ==================== Keep and Drop ====================
+
+KeptRange kept_range(int count, const std::vector<Modifier>& modifiers) {
+    KeptRange kept{0, count};
+    for (const auto& modifier : modifiers) {
+        if (modifier.value >= kept.hi - kept.lo) {
+            continue;
+        }
+        switch (modifier.type) {
+            case ModifierType::KeepHighest: kept.lo = kept.hi - modifier.value; break;
+            case ModifierType::KeepLowest:  kept.hi = kept.lo + modifier.value; break;
+            case ModifierType::DropHighest: kept.hi -= modifier.value; break;
+            case ModifierType::DropLowest:  kept.lo += modifier.value; break;
+            default: break;
+        }
+    }
+    return kept;
+}
+
+// ==================== CompiledDiceExpression Implementation ====================
+
+namespace {
+
+// Dice in one term, which bounds the scratch space a compiled expression holds
+constexpr int MAX_DICE_PER_TERM = 100000;
+
+bool is_digit(const std::string& text, size_t pos) {
+    return pos < text.size() && std::isdigit(static_cast<unsigned char>(text[pos]));
+}
+
+bool consume(const std::string& text, size_t& pos, const char* token) {
+    const size_t length = std::char_traits<char>::length(token);
+    if (text.compare(pos, length, token) != 0) {
+        return false;
+    }
+    pos += length;
+    return true;
+}
+
+} // namespace
+
+CompiledDiceExpression::CompiledDiceExpression(const std::string& expression,
+                                               std::shared_ptr<wip::utils::rng::RandomGenerator> rng)
+    : expression_(expression), rng_(std::move(rng)) {
+    // Spaces are ignored and letters compared in lowercase
+    std::string text;
+    text.reserve(expression.size());
+    for (char c : expression) {
+        if (!std::isspace(static_cast<unsigned char>(c))) {
+            text += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+    }
+    
+    // expression := ['+' | '-'] term (('+' | '-') term)*
+    size_t pos = 0;
+    bool has_dice = false;
+    do {
+        int sign = 1;
+        if (pos < text.size() && (text[pos] == '+' || text[pos] == '-')) {
+            sign = text[pos] == '-' ? -1 : 1;
+            ++pos;
+        } else if (pos != 0) {
+            throw std::invalid_argument("Invalid dice expression: " + expression);
+        }
+        
+        Term term = parse_term(text, pos);
+        term.sign = sign;
+        has_dice = has_dice || term.count > 0 || term.sides > 0;
+        terms_.push_back(std::move(term));
+    } while (pos < text.size());
+    
+    if (!has_dice) {
+        throw std::invalid_argument("Invalid dice expression: " + expression);
+    }
+    
+    int largest = 0;
+    for (const auto& term : terms_) {
+        largest = std::max(largest, term.count);
+    }
+    dice_.resize(static_cast<size_t>(largest));
+}
+
+CompiledDiceExpression::Term CompiledDiceExpression::parse_term(const std::string& text, size_t& pos) {
+    // term := number | [number] 'd' number modifier*
+    const size_t start = pos;
+    Term term;
+    const bool has_count = is_digit(text, pos);
+    const int count = has_count ? parse_number(text, pos) : 1;
+    
+    if (pos >= text.size() || text[pos] != 'd') {
+        if (!has_count) {
+            throw std::invalid_argument("Expected a number or dice at: " + text.substr(start));
+        }
+        term.constant = count;
+        term.text = text.substr(start, pos - start);
+        return term;
+    }
+    
+    ++pos;
+    term.count = count;
+    term.sides = parse_number(text, pos);
+    if (term.sides <= 0) {
+        throw std::invalid_argument("Die must have at least 1 side");
+    }
+    
+    // modifier := ('kh' | 'kl' | 'dh' | 'dl' | 'r' | 'e') number | 'adv' | 'dis'
+    std::vector<Modifier> ranks;
+    while (pos < text.size() && text[pos] != '+' && text[pos] != '-') {
+        if (consume(text, pos, "adv")) {
+            term.count = std::max(term.count, 2);
+            ranks.emplace_back(ModifierType::KeepHighest, 1);
+        } else if (consume(text, pos, "dis")) {
+            term.count = std::max(term.count, 2);
+            ranks.emplace_back(ModifierType::KeepLowest, 1);
+        } else if (consume(text, pos, "kh")) {
+            ranks.emplace_back(ModifierType::KeepHighest, parse_number(text, pos));
+        } else if (consume(text, pos, "kl")) {
+            ranks.emplace_back(ModifierType::KeepLowest, parse_number(text, pos));
+        } else if (consume(text, pos, "dh")) {
+            ranks.emplace_back(ModifierType::DropHighest, parse_number(text, pos));
+        } else if (consume(text, pos, "dl")) {
+            ranks.emplace_back(ModifierType::DropLowest, parse_number(text, pos));
+        } else if (consume(text, pos, "r")) {
+            term.reroll_on.push_back(parse_number(text, pos));
+        } else if (consume(text, pos, "e")) {
+            term.explode_on.push_back(parse_number(text, pos));
+        } else {
+            throw std::invalid_argument("Unknown dice modifier at: " + text.substr(pos));
+        }
+    }
+    if (term.count > MAX_DICE_PER_TERM) {
+        throw std::invalid_argument("Too many dice in one term: " + std::to_string(term.count));
+    }
+    
+    const KeptRange kept = kept_range(term.count, ranks);
+    term.kept_lo = kept.lo;
+    term.kept_hi = kept.hi;
+    
+    term.text = text.substr(start, pos - start);
+    return term;
+}
+
+int CompiledDiceExpression::parse_number(const std::string& text, size_t& pos) {
+    if (!is_digit(text, pos)) {
+        throw std::invalid_argument("Expected a number at: " + text.substr(pos));
+    }
+    long long value = 0;
+    while (is_digit(text, pos)) {
+        value = value * 10 + (text[pos++] - '0');
+        if (value > std::numeric_limits<int>::max()) {
+            throw std::invalid_argument("Number too large in dice expression");
+        }
+    }
+    return static_cast<int>(value);
+}
+
+wip::utils::rng::RandomGenerator& CompiledDiceExpression::generator() {
+    return rng_ ? *rng_ : wip::utils::rng::global();
+}
+
+bool CompiledDiceExpression::is_exploding() const {
+    return std::any_of(terms_.begin(), terms_.end(), [](const Term& term) {
+        return std::any_of(term.explode_on.begin(), term.explode_on.end(),
+                           [&term](int value) { return value >= 1 && value <= term.sides; });
+    });
+}
+
+int CompiledDiceExpression::roll() {
+    return sample(generator(), dice_.data());
+}
+
+RollResult CompiledDiceExpression::roll_detailed() {
+    auto& rng = generator();
+    RollResult result;
+    result.expression = expression_;
+    
+    std::ostringstream breakdown;
+    long long total = 0;
+    for (size_t t = 0; t < terms_.size(); ++t) {
+        const Term& term = terms_[t];
+        if (t > 0 || term.sign < 0) {
+            breakdown << (term.sign < 0 ? " - " : " + ");
+        }
+        if (term.count == 0) {
+            total += term.sign * term.constant;
+            breakdown << term.constant;
+            continue;
+        }
+        
+        const size_t first = result.individual_rolls.size();
+        for (int i = 0; i < term.count; ++i) {
+            bool rerolled = false;
+            int value = roll_face(rng, term, &rerolled);
+            SingleRollResult single(value);
+            for (int explosions = 0; explosions < MAX_EXPLOSIONS &&
+                 std::find(term.explode_on.begin(), term.explode_on.end(), value) != term.explode_on.end();
+                 ++explosions) {
+                value = roll_face(rng, term, &rerolled);
+                single.explosion_chain.push_back(value);
+                single.value += value;
+                single.was_exploded = true;
+            }
+            single.was_rerolled = rerolled;
+            result.individual_rolls.push_back(std::move(single));
+        }
+        
+        // Rank the term's dice to find which are kept
+        std::vector<size_t> order(static_cast<size_t>(term.count));
+        std::iota(order.begin(), order.end(), first);
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return result.individual_rolls[a].value < result.individual_rolls[b].value;
+        });
+        for (int rank = 0; rank < term.count; ++rank) {
+            result.individual_rolls[order[rank]].was_dropped = rank < term.kept_lo || rank >= term.kept_hi;
+        }
+        
+        long long sum = 0;
+        breakdown << term.text << " [";
+        for (size_t i = first; i < result.individual_rolls.size(); ++i) {
+            const auto& single = result.individual_rolls[i];
+            if (i > first) breakdown << ", ";
+            breakdown << single.value;
+            if (single.was_dropped) {
+                breakdown << " dropped";
+                result.dropped_values.push_back(single.value);
+            } else {
+                result.kept_values.push_back(single.value);
+                sum += single.value;
+            }
+        }
+        breakdown << "]";
+        total += term.sign * sum;
+    }
+    
+    result.final_total = static_cast<int>(total);
+    breakdown << " = " << result.final_total;
+    result.breakdown = breakdown.str();
+    return result;
+}
+
 // ==================== DiceExpression Implementation ====================
 
 RollResult DiceExpression::evaluate(const std::string& expression) {
     try {
-        ParsedExpression parsed = parse(expression);
-        return evaluate_parsed(parsed);
+        return CompiledDiceExpression(expression).roll_detailed();
     } catch (const std::exception& e) {
         RollResult result;
         result.expression = expression;
@@ -46,21 +285,26 @@ RollResult DiceExpression::evaluate(const std::string& expression) {
 
 bool DiceExpression::is_valid(const std::string& expression) {
     try {
-        parse(expression);
+        CompiledDiceExpression compiled(expression);
         return true;
     } catch (...) {
         return false;
     }
 }
 
+Distribution DiceExpression::distribution(const std::string& expression, const DistributionOptions& options) {
+    return CompiledDiceExpression(expression).distribution(options);
+}
+
 std::string DiceExpression::help_text() {
     return R"(Dice Notation Help:
-Basic Format: [count]d[sides][modifiers][+/-constant]
+Basic Format: [count]d[sides][modifiers], terms joined with + or -
 
 Examples:
   d20         - Single 20-sided die
   3d6         - Three 6-sided dice
   2d8+3       - Two 8-sided dice plus 3
+  2d6+1d4+3   - Two 6-sided dice, one 4-sided die, plus 3
   4d6kh3      - Four 6-sided dice, keep highest 3
   2d20adv     - Two d20s with advantage (keep higher)
   1d20dis     - One d20 with disadvantage (roll twice, keep lower)
@@ -77,91 +321,6 @@ Modifiers:
 )";
 }
 
-DiceExpression::ParsedExpression DiceExpression::parse(const std::string& expression) {
-    ParsedExpression result;
-    
-    // Remove spaces and convert to lowercase
-    std::string clean_expr;
-    for (char c : expression) {
-        if (!std::isspace(c)) {
-            clean_expr += std::tolower(c);
-        }
-    }
-    
-    // Basic regex for dice notation
-    std::regex dice_regex(R"((\d*)d(\d+)((?:kh|kl|dh|dl|r|e)\d+|adv|dis)*([+\-]\d+)?)");
-    std::smatch match;
-    
-    if (std::regex_match(clean_expr, match, dice_regex)) {
-        // Parse count
-        if (match[1].length() > 0) {
-            result.count = std::stoi(match[1]);
-        }
-        
-        // Parse sides
-        result.sides = std::stoi(match[2]);
-        
-        // Parse modifiers
-        std::string modifiers_str = match[3];
-        if (!modifiers_str.empty()) {
-            std::regex modifier_regex(R"(kh(\d+)|kl(\d+)|dh(\d+)|dl(\d+)|r(\d+)|e(\d+)|adv|dis)");
-            std::sregex_iterator iter(modifiers_str.begin(), modifiers_str.end(), modifier_regex);
-            std::sregex_iterator end;
-            
-            while (iter != end) {
-                std::smatch mod_match = *iter;
-                if (mod_match[0] == "adv") {
-                    // Handle advantage separately
-                } else if (mod_match[0] == "dis") {
-                    // Handle disadvantage separately  
-                } else if (mod_match[1].matched) {
-                    result.modifiers.emplace_back(ModifierType::KeepHighest, std::stoi(mod_match[1]));
-                } else if (mod_match[2].matched) {
-                    result.modifiers.emplace_back(ModifierType::KeepLowest, std::stoi(mod_match[2]));
-                } else if (mod_match[3].matched) {
-                    result.modifiers.emplace_back(ModifierType::DropHighest, std::stoi(mod_match[3]));
-                } else if (mod_match[4].matched) {
-                    result.modifiers.emplace_back(ModifierType::DropLowest, std::stoi(mod_match[4]));
-                } else if (mod_match[5].matched) {
-                    result.modifiers.emplace_back(ModifierType::RerollOn, std::stoi(mod_match[5]));
-                } else if (mod_match[6].matched) {
-                    result.modifiers.emplace_back(ModifierType::ExplodingOn, std::stoi(mod_match[6]));
-                }
-                ++iter;
-            }
-        }
-        
-        // Parse constant
-        if (match[4].length() > 0) {
-            result.constant = std::stoi(match[4]);
-        }
-    } else {
-        throw std::invalid_argument("Invalid dice expression: " + expression);
-    }
-    
-    return result;
-}
-
-RollResult DiceExpression::evaluate_parsed(const ParsedExpression& parsed) {
-    Die<int> die(parsed.sides);
-    
-    // Add modifiers to die
-    for (const auto& mod : parsed.modifiers) {
-        die.add_modifier(mod);
-    }
-    
-    // Roll the dice
-    RollResult result = die.roll_detailed(parsed.count);
-    
-    // Apply constant modifier
-    if (parsed.constant != 0) {
-        result.final_total += parsed.constant;
-        result.breakdown += (parsed.constant >= 0 ? " + " : " - ") + std::to_string(std::abs(parsed.constant));
-    }
-    
-    return result;
-}
-
 // ==================== Gaming Utilities Implementation ====================
 
 namespace gaming {
@@ -0,0 +1,297 @@
+#include "dice.h"
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <thread>
+
+namespace wip {
+namespace game {
+namespace dice {
+
+namespace {
+
+// Rolls simulated from one stream; chunks rather than threads own streams,
+// so the estimate does not depend on how chunks are spread over threads
+constexpr uint64_t SAMPLES_PER_CHUNK = 1 << 16;
+
+/**
+ * @brief Probability of each face after rerolls, index 0 for face 1
+ *
+ * A die keeps its first roll outside the reroll set, or its last roll after
+ * MAX_REROLLS rerolls, so with q the chance to reroll a face v outside the
+ * set has (1 + q + ... + q^MAX_REROLLS) / sides and one inside q^MAX_REROLLS / sides.
+ */
+std::vector<double> face_probabilities(int sides, const std::vector<int>& reroll_on) {
+    std::vector<char> reroll(static_cast<size_t>(sides) + 1, 0);
+    for (int value : reroll_on) {
+        if (value >= 1 && value <= sides) reroll[value] = 1;
+    }
+    
+    const double face = 1.0 / sides;
+    const double q = std::count(reroll.begin(), reroll.end(), 1) * face;
+    double kept = 0.0;
+    double power = 1.0;
+    for (int i = 0; i <= MAX_REROLLS; ++i) {
+        kept += power;
+        if (i < MAX_REROLLS) power *= q;
+    }
+
+    std::vector<double> pmf(sides);
+    for (int v = 1; v <= sides; ++v) {
+        pmf[v - 1] = (reroll[v] ? power : kept) * face;
+    }
+    return pmf;
+}
+
+std::vector<double> convolve(const std::vector<double>& a, const std::vector<double>& b) {
+    std::vector<double> result(a.size() + b.size() - 1, 0.0);
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i] == 0.0) continue;
+        for (size_t j = 0; j < b.size(); ++j) {
+            result[i + j] += a[i] * b[j];
+        }
+    }
+    return result;
+}
+
+// Distribution of the sum of count dice, by squaring, index 0 for all ones
+std::vector<double> sum_distribution(const std::vector<double>& face, int count) {
+    std::vector<double> result{1.0};
+    std::vector<double> power = face;
+    for (int n = count; n > 0; n >>= 1) {
+        if (n & 1) result = convolve(result, power);
+        if (n > 1) power = convolve(power, power);
+    }
+    return result;
+}
+
+/**
+ * @brief Distribution of the sum of the dice ranked lo..hi-1, index 0 for all ones
+ *
+ * Faces are visited from highest to lowest. With c dice already showing a
+ * higher face, each of the others shows the current face with probability
+ * p(face) / P(face or lower), so the number that do is binomial, and those
+ * dice take ranks c, c + 1, ... counted from the top. The state is c and the
+ * kept sum so far, which keeps the work polynomial in dice and faces.
+ */
+std::vector<double> kept_sum_distribution(const std::vector<double>& face, int count, int lo, int hi) {
+    const int sides = static_cast<int>(face.size());
+    const int kept = hi - lo;
+    const int top_lo = count - hi;     // Kept ranks counted from the highest die
+    const int top_hi = count - lo;
+    const size_t width = static_cast<size_t>(kept) * (sides - 1) + 1;
+
+    std::vector<double> lgamma_table(count + 2);
+    for (int i = 0; i < count + 2; ++i) {
+        lgamma_table[i] = std::lgamma(static_cast<double>(i) + 1.0);
+    }
+
+    // dp[c][s]: c dice show a higher face and the kept ones sum to s above all ones
+    std::vector<std::vector<double>> dp(count + 1, std::vector<double>(width, 0.0));
+    std::vector<std::vector<double>> next(count + 1, std::vector<double>(width, 0.0));
+    dp[0][0] = 1.0;
+
+    double at_or_below = 1.0;
+    for (int f = sides - 1; f >= 0; --f) {
+        const double a = f == 0 ? 1.0 : std::min(1.0, face[f] / at_or_below);
+        const double log_a = std::log(a);
+        const double log_b = std::log1p(-a);
+        at_or_below -= face[f];
+
+        for (auto& row : next) std::fill(row.begin(), row.end(), 0.0);
+        for (int c = 0; c <= count; ++c) {
+            const int remaining = count - c;
+            for (int k = 0; k <= remaining; ++k) {
+                double weight;
+                if (a >= 1.0) {
+                    weight = k == remaining ? 1.0 : 0.0;
+                } else if (a <= 0.0) {
+                    weight = k == 0 ? 1.0 : 0.0;
+                } else {
+                    weight = std::exp(lgamma_table[remaining] - lgamma_table[k] - lgamma_table[remaining - k]
+                                      + k * log_a + (remaining - k) * log_b);
+                }
+                if (weight == 0.0) continue;
+
+                const int overlap = std::max(0, std::min(c + k, top_hi) - std::max(c, top_lo));
+                const size_t shift = static_cast<size_t>(overlap) * f;
+                const auto& from = dp[c];
+                auto& to = next[c + k];
+                for (size_t s = 0; s + shift < width; ++s) {
+                    if (from[s] != 0.0) to[s + shift] += from[s] * weight;
+                }
+            }
+        }
+        std::swap(dp, next);
+    }
+    return dp[count];
+}
+
+} // namespace
+
+// ==================== Distribution Implementation ====================
+
+Distribution::Distribution(int min_total, std::vector<double> pmf, uint64_t samples)
+    : min_total_(min_total), pmf_(std::move(pmf)), samples_(samples) {
+    // Trim totals that cannot occur so min_total() and max_total() are tight
+    auto first = std::find_if(pmf_.begin(), pmf_.end(), [](double p) { return p > 0.0; });
+    if (first == pmf_.end()) {
+        throw std::invalid_argument("Distribution must have a total with nonzero probability");
+    }
+    auto last = std::find_if(pmf_.rbegin(), pmf_.rend(), [](double p) { return p > 0.0; }).base();
+    min_total_ += static_cast<int>(first - pmf_.begin());
+    pmf_.erase(last, pmf_.end());
+    pmf_.erase(pmf_.begin(), first);
+
+    cdf_.resize(pmf_.size());
+    double cumulative = 0.0;
+    for (size_t i = 0; i < pmf_.size(); ++i) {
+        cumulative += pmf_[i];
+        cdf_[i] = cumulative;
+        mean_ += pmf_[i] * (min_total_ + static_cast<double>(i));
+    }
+    for (size_t i = 0; i < pmf_.size(); ++i) {
+        const double deviation = min_total_ + static_cast<double>(i) - mean_;
+        variance_ += pmf_[i] * deviation * deviation;
+    }
+}
+
+double Distribution::probability(int total) const {
+    if (total < min_total() || total > max_total()) return 0.0;
+    return pmf_[total - min_total_];
+}
+
+double Distribution::cumulative(int total) const {
+    if (total < min_total()) return 0.0;
+    if (total >= max_total()) return 1.0;
+    return cdf_[total - min_total_];
+}
+
+double Distribution::at_least(int total) const {
+    return 1.0 - cumulative(total - 1);
+}
+
+double Distribution::stddev() const {
+    return std::sqrt(variance_);
+}
+
+// ==================== CompiledDiceExpression Distributions ====================
+
+Distribution CompiledDiceExpression::distribution(const DistributionOptions& options) const {
+    // Explosions make the totals unbounded, so only those need sampling
+    switch (options.method) {
+        case DistributionMethod::Exact:
+            if (is_exploding()) {
+                throw std::invalid_argument("Exact distribution is not available for exploding dice: " + expression_);
+            }
+            return exact_distribution();
+        case DistributionMethod::MonteCarlo:
+            return sampled_distribution(options);
+        default:
+            return is_exploding() ? sampled_distribution(options) : exact_distribution();
+    }
+}
+
+Distribution CompiledDiceExpression::exact_distribution() const {
+    std::vector<double> pmf{1.0};
+    int min_total = 0;
+    for (const auto& term : terms_) {
+        if (term.count == 0) {
+            min_total += term.sign * term.constant;
+            continue;
+        }
+        
+        const auto face = face_probabilities(term.sides, term.reroll_on);
+        const int kept = term.kept_hi - term.kept_lo;
+        std::vector<double> term_pmf = kept == term.count
+            ? sum_distribution(face, term.count)
+            : kept_sum_distribution(face, term.count, term.kept_lo, term.kept_hi);
+        
+        // Probabilities run from every kept die showing one up to every one showing sides
+        if (term.sign < 0) {
+            std::reverse(term_pmf.begin(), term_pmf.end());
+            min_total -= kept * term.sides;
+        } else {
+            min_total += kept;
+        }
+        pmf = convolve(pmf, term_pmf);
+    }
+    return Distribution(min_total, std::move(pmf));
+}
+
+Distribution CompiledDiceExpression::sampled_distribution(const DistributionOptions& options) const {
+    if (options.samples == 0) {
+        throw std::invalid_argument("Monte Carlo distribution needs at least one sample");
+    }
+    
+    const uint64_t chunks = (options.samples + SAMPLES_PER_CHUNK - 1) / SAMPLES_PER_CHUNK;
+    unsigned threads = options.threads != 0 ? options.threads : std::thread::hardware_concurrency();
+    threads = static_cast<unsigned>(std::min<uint64_t>(std::max(threads, 1u), chunks));
+    
+    // Histograms of totals from a per-thread lowest total, grown as needed
+    struct Histogram {
+        int lowest = 0;
+        std::vector<uint64_t> counts;
+    };
+    std::vector<Histogram> histograms(threads);
+    std::atomic<uint64_t> next_chunk{0};
+    
+    auto worker = [&](unsigned t) {
+        auto& histogram = histograms[t];
+        std::vector<int> dice(dice_.size());
+        
+        for (uint64_t chunk = next_chunk++; chunk < chunks; chunk = next_chunk++) {
+            wip::utils::rng::StreamRandomGenerator rng(options.seed, chunk);
+            const uint64_t begin = chunk * SAMPLES_PER_CHUNK;
+            const uint64_t end = std::min(begin + SAMPLES_PER_CHUNK, options.samples);
+            for (uint64_t i = begin; i < end; ++i) {
+                const int total = sample(rng, dice.data());
+                if (histogram.counts.empty()) {
+                    histogram.lowest = total;
+                } else if (total < histogram.lowest) {
+                    histogram.counts.insert(histogram.counts.begin(), static_cast<size_t>(histogram.lowest - total), 0);
+                    histogram.lowest = total;
+                }
+                const size_t index = static_cast<size_t>(total - histogram.lowest);
+                if (index >= histogram.counts.size()) {
+                    histogram.counts.resize(index + 1, 0);
+                }
+                ++histogram.counts[index];
+            }
+        }
+    };
+    
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (unsigned t = 1; t < threads; ++t) {
+        pool.emplace_back(worker, t);
+    }
+    worker(0);
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    
+    // Integer counts add up the same whichever thread sampled which chunk
+    int lowest = std::numeric_limits<int>::max();
+    int highest = std::numeric_limits<int>::min();
+    for (const auto& histogram : histograms) {
+        if (histogram.counts.empty()) continue;
+        lowest = std::min(lowest, histogram.lowest);
+        highest = std::max(highest, histogram.lowest + static_cast<int>(histogram.counts.size()) - 1);
+    }
+    
+    std::vector<double> pmf(static_cast<size_t>(highest - lowest) + 1, 0.0);
+    for (const auto& histogram : histograms) {
+        for (size_t i = 0; i < histogram.counts.size(); ++i) {
+            pmf[histogram.lowest - lowest + i] += static_cast<double>(histogram.counts[i]);
+        }
+    }
+    for (double& p : pmf) {
+        p /= static_cast<double>(options.samples);
+    }
+    return Distribution(lowest, std::move(pmf), options.samples);
+}
+
+} // namespace dice
+} // namespace game
+} // namespace wip
@@ -249,6 +249,61 @@ TEST_F(DiceTest, DropLowestModifier) {
     EXPECT_EQ(result.dropped_values.size(), 1);
 }
 
+TEST_F(DiceTest, RollIntoBuffer) {
+    auto rng1 = std::make_shared<wip::utils::rng::RandomGenerator>(7);
+    auto rng2 = std::make_shared<wip::utils::rng::RandomGenerator>(7);
+    Die<int> first(20, rng1);
+    Die<int> second(20, rng2);
+    
+    std::vector<int> expected = first.roll(1000);
+    std::vector<int> buffer(1000);
+    second.roll(buffer.data(), buffer.size());
+    EXPECT_EQ(buffer, expected);
+    
+    DiceSet<int> set;
+    set.add_dice(Die<int>(6, rng1), 3);
+    int values[3] = {0, 0, 0};
+    set.roll(values);
+    for (int value : values) {
+        EXPECT_GE(value, 1);
+        EXPECT_LE(value, 6);
+    }
+}
+
+TEST_F(DiceTest, RollSummaryMatchesDetailed) {
+    const std::vector<std::vector<Modifier>> cases = {
+        {},
+        {Modifier(ModifierType::KeepHighest, 3)},
+        {Modifier(ModifierType::DropLowest, 1), Modifier(ModifierType::Add, 2)},
+        {Modifier(ModifierType::KeepLowest, 4), Modifier(ModifierType::DropHighest, 1)},
+        {Modifier(ModifierType::ExplodingOn, 6), Modifier(ModifierType::RerollOn, 1), Modifier(ModifierType::KeepHighest, 2)},
+    };
+    
+    for (int count : {0, 1, 5, 100}) {
+        for (const auto& modifiers : cases) {
+            auto rng1 = std::make_shared<wip::utils::rng::RandomGenerator>(count + 1);
+            auto rng2 = std::make_shared<wip::utils::rng::RandomGenerator>(count + 1);
+            Die<int> detailed_die(6, rng1);
+            Die<int> summary_die(6, rng2);
+            for (const auto& modifier : modifiers) {
+                detailed_die.add_modifier(modifier);
+                summary_die.add_modifier(modifier);
+            }
+            
+            for (int i = 0; i < 20; ++i) {
+                auto detailed = detailed_die.roll_detailed(count);
+                auto summary = summary_die.roll_summary(count);
+                EXPECT_EQ(summary.total(), detailed.total());
+                EXPECT_EQ(summary.count(), static_cast<int>(detailed.count()));
+                EXPECT_EQ(summary.min_value(), detailed.min_value());
+                EXPECT_EQ(summary.max_value(), detailed.max_value());
+            }
+        }
+    }
+    
+    EXPECT_THROW(test_die->roll_summary(-1), std::invalid_argument);
+}
+
 // ==================== Detailed Roll Results ====================
 
 TEST_F(DiceTest, DetailedRollResult) {
@@ -521,6 +576,291 @@ TEST_F(DiceTest, StringRepresentation) {
     EXPECT_TRUE(custom_str.find("2,4,6,8") != std::string::npos);
 }
 
+TEST_F(DiceTest, DiceExpressionMultipleTerms) {
+    EXPECT_TRUE(DiceExpression::is_valid("2d6+1d4+3"));
+    EXPECT_TRUE(DiceExpression::is_valid("1d20 + 5 - 1d4"));
+    EXPECT_TRUE(DiceExpression::is_valid("-1d4+2d6"));
+    EXPECT_FALSE(DiceExpression::is_valid("2d6+"));
+    EXPECT_FALSE(DiceExpression::is_valid("2d6++1"));
+    EXPECT_FALSE(DiceExpression::is_valid("5"));
+    EXPECT_FALSE(DiceExpression::is_valid("1d0"));
+    EXPECT_FALSE(DiceExpression::is_valid("4d6x1"));
+    EXPECT_FALSE(DiceExpression::is_valid("99999999999d6"));
+    
+    for (int i = 0; i < 100; ++i) {
+        auto result = DiceExpression::evaluate("2d6+1d4+3");
+        EXPECT_EQ(result.individual_rolls.size(), 3u);
+        EXPECT_EQ(result.kept_values.size(), 3u);
+        EXPECT_EQ(result.total(), std::accumulate(result.kept_values.begin(), result.kept_values.end(), 3));
+        EXPECT_GE(result.total(), 6);
+        EXPECT_LE(result.total(), 19);
+    }
+    
+    auto negative = DiceExpression::evaluate("1d1-1d1-2");
+    EXPECT_EQ(negative.total(), -2);
+    EXPECT_EQ(negative.expression, "1d1-1d1-2");
+    EXPECT_NE(negative.breakdown.find("= -2"), std::string::npos);
+}
+
+TEST_F(DiceTest, DiceExpressionAdvantage) {
+    auto advantage = DiceExpression::evaluate("1d20adv");
+    EXPECT_EQ(advantage.individual_rolls.size(), 2u);
+    EXPECT_EQ(advantage.kept_values.size(), 1u);
+    EXPECT_EQ(advantage.total(), std::max(advantage.individual_rolls[0].value, advantage.individual_rolls[1].value));
+    
+    auto disadvantage = DiceExpression::evaluate("1d20dis");
+    EXPECT_EQ(disadvantage.total(), std::min(disadvantage.individual_rolls[0].value, disadvantage.individual_rolls[1].value));
+    
+    EXPECT_NEAR(DiceExpression::distribution("1d20adv").mean(), 13.825, 1e-9);
+}
+
+TEST_F(DiceTest, CompiledExpressionRolls) {
+    auto rng1 = std::make_shared<wip::utils::rng::RandomGenerator>(99);
+    auto rng2 = std::make_shared<wip::utils::rng::RandomGenerator>(99);
+    CompiledDiceExpression first("4d6dl1+1d4-1", rng1);
+    CompiledDiceExpression second("4d6dl1+1d4-1", rng2);
+    EXPECT_EQ(first.expression(), "4d6dl1+1d4-1");
+    EXPECT_FALSE(first.is_exploding());
+    
+    std::map<int, int> counts;
+    for (int i = 0; i < 10000; ++i) {
+        int total = first.roll();
+        EXPECT_EQ(total, second.roll());
+        EXPECT_GE(total, 3);
+        EXPECT_LE(total, 21);
+        ++counts[total];
+    }
+    EXPECT_GT(counts.size(), 12u);
+    
+    auto detailed = first.roll_detailed();
+    EXPECT_EQ(detailed.individual_rolls.size(), 5u);
+    EXPECT_EQ(detailed.dropped_values.size(), 1u);
+    EXPECT_EQ(std::count_if(detailed.individual_rolls.begin(), detailed.individual_rolls.end(),
+                            [](const SingleRollResult& roll) { return roll.was_dropped; }), 1);
+    
+    EXPECT_THROW(CompiledDiceExpression("3x6"), std::invalid_argument);
+    EXPECT_TRUE(CompiledDiceExpression("8d10e10kh3").is_exploding());
+    EXPECT_FALSE(CompiledDiceExpression("8d10e11").is_exploding());
+}
+
+// ==================== Distribution Tests ====================
+
+namespace {
+
+// Distribution of the sum of ranks lo..hi-1 of count dice, by enumerating every roll
+std::map<int, double> enumerate_kept_sums(int count, int sides, int lo, int hi, int constant) {
+    std::map<int, double> pmf;
+    std::vector<int> dice(count, 1);
+    const double weight = std::pow(1.0 / sides, count);
+    while (true) {
+        std::vector<int> sorted = dice;
+        std::sort(sorted.begin(), sorted.end());
+        pmf[std::accumulate(sorted.begin() + lo, sorted.begin() + hi, constant)] += weight;
+        
+        int i = 0;
+        while (i < count && dice[i] == sides) dice[i++] = 1;
+        if (i == count) break;
+        ++dice[i];
+    }
+    return pmf;
+}
+
+}  // namespace
+
+TEST(DistributionTest, ExactSumOfDice) {
+    auto dist = DiceExpression::distribution("3d6");
+    EXPECT_TRUE(dist.is_exact());
+    EXPECT_EQ(dist.min_total(), 3);
+    EXPECT_EQ(dist.max_total(), 18);
+    EXPECT_NEAR(dist.probability(10), 27.0 / 216.0, 1e-12);
+    EXPECT_NEAR(dist.probability(3), 1.0 / 216.0, 1e-12);
+    EXPECT_EQ(dist.probability(2), 0.0);
+    EXPECT_NEAR(dist.mean(), 10.5, 1e-9);
+    EXPECT_NEAR(dist.variance(), 8.75, 1e-9);
+    EXPECT_NEAR(dist.cumulative(10), 0.5, 1e-12);
+    EXPECT_NEAR(dist.at_least(11), 0.5, 1e-12);
+    EXPECT_DOUBLE_EQ(dist.cumulative(18), 1.0);
+    EXPECT_EQ(dist.pmf().size(), dist.cdf().size());
+    
+    auto shifted = DiceExpression::distribution("2d8+3");
+    EXPECT_EQ(shifted.min_total(), 5);
+    EXPECT_EQ(shifted.max_total(), 19);
+    EXPECT_NEAR(shifted.mean(), 12.0, 1e-9);
+}
+
+TEST(DistributionTest, ExactKeepAndDropMatchEnumeration) {
+    struct Case { const char* expression; int count; int sides; int lo; int hi; int constant; };
+    const Case cases[] = {
+        {"4d6dl1", 4, 6, 1, 4, 0},
+        {"5d6kh3", 5, 6, 2, 5, 0},
+        {"4d8kl2+3", 4, 8, 0, 2, 3},
+        {"5d4dh1dl1", 5, 4, 1, 4, 0},
+        {"6d6kh4kl2", 6, 6, 2, 4, 0},
+    };
+    
+    for (const auto& c : cases) {
+        SCOPED_TRACE(c.expression);
+        auto dist = DiceExpression::distribution(c.expression);
+        auto expected = enumerate_kept_sums(c.count, c.sides, c.lo, c.hi, c.constant);
+        EXPECT_EQ(dist.min_total(), expected.begin()->first);
+        EXPECT_EQ(dist.max_total(), expected.rbegin()->first);
+        for (const auto& [total, probability] : expected) {
+            EXPECT_NEAR(dist.probability(total), probability, 1e-12) << "total " << total;
+        }
+    }
+    
+    // Ability scores
+    EXPECT_NEAR(DiceExpression::distribution("4d6dl1").mean(), 15869.0 / 1296.0, 1e-9);
+}
+
+TEST(DistributionTest, ExactLargeKeepHighest) {
+    auto dist = DiceExpression::distribution("40d20kh5");
+    EXPECT_TRUE(dist.is_exact());
+    EXPECT_NEAR(dist.cdf().back(), 1.0, 1e-9);
+    EXPECT_EQ(dist.max_total(), 100);
+    // The five highest of forty d20 are all 20 with probability P(at least five 20s)
+    double at_most_four = 0.0;
+    for (int k = 0; k <= 4; ++k) {
+        double choose = 1.0;
+        for (int i = 0; i < k; ++i) choose = choose * (40 - i) / (i + 1);
+        at_most_four += choose * std::pow(0.05, k) * std::pow(0.95, 40 - k);
+    }
+    EXPECT_NEAR(dist.probability(100), 1.0 - at_most_four, 1e-9);
+}
+
+TEST(DistributionTest, ExactMultipleTerms) {
+    // 2d6 + 1d4 + 3, by enumeration
+    std::map<int, double> expected;
+    for (int a = 1; a <= 6; ++a)
+        for (int b = 1; b <= 6; ++b)
+            for (int c = 1; c <= 4; ++c)
+                expected[a + b + c + 3] += 1.0 / 144.0;
+    
+    auto dist = DiceExpression::distribution("2d6+1d4+3");
+    EXPECT_TRUE(dist.is_exact());
+    EXPECT_EQ(dist.min_total(), 6);
+    EXPECT_EQ(dist.max_total(), 19);
+    for (const auto& [total, probability] : expected) {
+        EXPECT_NEAR(dist.probability(total), probability, 1e-12) << "total " << total;
+    }
+    
+    auto difference = DiceExpression::distribution("1d6-1d4");
+    EXPECT_EQ(difference.min_total(), -3);
+    EXPECT_EQ(difference.max_total(), 5);
+    EXPECT_NEAR(difference.mean(), 1.0, 1e-12);
+    EXPECT_NEAR(difference.probability(-3), 1.0 / 24.0, 1e-12);
+}
+
+TEST(DistributionTest, ExactRerolls) {
+    auto dist = DiceExpression::distribution("1d6r1");
+    EXPECT_TRUE(dist.is_exact());
+    EXPECT_NEAR(dist.probability(1), std::pow(1.0 / 6.0, MAX_REROLLS + 1), 1e-15);
+    EXPECT_NEAR(dist.probability(6), (1.0 - dist.probability(1)) / 5.0, 1e-12);
+    
+    auto two = DiceExpression::distribution("2d6r1r2");
+    EXPECT_NEAR(two.mean(), 9.0, 1e-4);  // Slightly less, as rerolls are limited
+    EXPECT_NEAR(two.cdf().back(), 1.0, 1e-12);
+}
+
+TEST(DistributionTest, ParserKeepsEveryModifier) {
+    EXPECT_TRUE(DiceExpression::is_valid("8d10e10kh3"));
+    EXPECT_TRUE(DiceExpression::is_valid("4d6r1dl1+2"));
+    
+    auto result = DiceExpression::evaluate("8d10e10kh3");
+    EXPECT_EQ(result.kept_values.size(), 3u);
+    EXPECT_EQ(result.dropped_values.size(), 5u);
+}
+
+TEST(DistributionTest, EvaluateAppliesRerollsAndExplosions) {
+    // A one-sided die explodes every time until the limit, and rerolls into itself
+    EXPECT_EQ(DiceExpression::evaluate("1d1e1").total(), MAX_EXPLOSIONS + 1);
+    EXPECT_EQ(DiceExpression::evaluate("1d1r1").total(), 1);
+    EXPECT_TRUE(DiceExpression::evaluate("1d1e1").individual_rolls[0].was_exploded);
+    
+    for (int i = 0; i < 200; ++i) {
+        auto result = DiceExpression::evaluate("3d2r1");
+        for (const auto& roll : result.individual_rolls) {
+            if (!roll.was_rerolled) {
+                EXPECT_EQ(roll.value, 2);
+            }
+        }
+    }
+    
+    DistributionOptions options;
+    options.samples = 1000;
+    auto sampled = DiceExpression::distribution("1d1e1", options);
+    EXPECT_FALSE(sampled.is_exact());
+    EXPECT_DOUBLE_EQ(sampled.probability(MAX_EXPLOSIONS + 1), 1.0);
+}
+
+TEST(DistributionTest, MonteCarloMatchesExact) {
+    DistributionOptions options;
+    options.method = DistributionMethod::MonteCarlo;
+    options.samples = 400000;
+    options.seed = 42;
+    
+    for (const char* expression : {"4d6dl1", "3d8r1+2"}) {
+        SCOPED_TRACE(expression);
+        auto exact = DiceExpression::distribution(expression);
+        auto sampled = DiceExpression::distribution(expression, options);
+        EXPECT_FALSE(sampled.is_exact());
+        EXPECT_EQ(sampled.samples(), options.samples);
+        EXPECT_NEAR(sampled.mean(), exact.mean(), 0.02);
+        EXPECT_NEAR(sampled.variance(), exact.variance(), 0.1);
+        for (int total = exact.min_total(); total <= exact.max_total(); ++total) {
+            EXPECT_NEAR(sampled.cumulative(total), exact.cumulative(total), 0.005) << "total " << total;
+        }
+    }
+}
+
+TEST(DistributionTest, ExplodingDiceAreSampled) {
+    auto dist = DiceExpression::distribution("1d6e6");
+    EXPECT_FALSE(dist.is_exact());
+    // An exploding die's mean is the plain mean scaled by sides / (sides - 1)
+    EXPECT_NEAR(dist.mean(), 3.5 * 6.0 / 5.0, 0.01);
+    EXPECT_EQ(dist.min_total(), 1);
+    EXPECT_EQ(dist.probability(6), 0.0);
+    EXPECT_NEAR(dist.probability(7), 1.0 / 36.0, 0.002);
+    
+    DistributionOptions exact;
+    exact.method = DistributionMethod::Exact;
+    EXPECT_THROW(DiceExpression::distribution("8d10e10kh3", exact), std::invalid_argument);
+    EXPECT_NO_THROW(DiceExpression::distribution("8d10e10kh3"));
+}
+
+TEST(DistributionTest, MonteCarloIsIndependentOfThreadCount) {
+    DistributionOptions options;
+    options.method = DistributionMethod::MonteCarlo;
+    options.samples = 300000;
+    options.seed = 7;
+    
+    options.threads = 1;
+    auto serial = DiceExpression::distribution("8d10e10kh3", options);
+    options.threads = 4;
+    auto parallel = DiceExpression::distribution("8d10e10kh3", options);
+    
+    EXPECT_EQ(serial.min_total(), parallel.min_total());
+    EXPECT_EQ(serial.pmf(), parallel.pmf());
+    
+    options.seed = 8;
+    auto reseeded = DiceExpression::distribution("8d10e10kh3", options);
+    EXPECT_NE(serial.pmf(), reseeded.pmf());
+}
+
+TEST(DistributionTest, InvalidExpressions) {
+    EXPECT_THROW(DiceExpression::distribution("3x6"), std::invalid_argument);
+    EXPECT_THROW(DiceExpression::distribution("1d0"), std::invalid_argument);
+    
+    DistributionOptions options;
+    options.method = DistributionMethod::MonteCarlo;
+    options.samples = 0;
+    EXPECT_THROW(DiceExpression::distribution("1d6", options), std::invalid_argument);
+    
+    auto none = DiceExpression::distribution("0d6+2");
+    EXPECT_EQ(none.min_total(), 2);
+    EXPECT_DOUBLE_EQ(none.probability(2), 1.0);
+}
+
 // ==================== Performance Test ====================
 
 TEST(DicePerformanceTest, DISABLED_LargeNumberOfRolls) {
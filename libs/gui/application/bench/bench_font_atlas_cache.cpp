@@ -0,0 +1,109 @@
+// Benchmark for restoring a baked font atlas at startup.
+//
+// Writes font-sized files and an atlas of the size ImGui bakes for a few
+// Latin fonts, then times what a cached startup costs: computing the key,
+// which hashes every font file, and loading the atlas with one mapped read.
+// Saving is timed too; it runs only after the fonts were rasterized.
+// Reports the time per startup in nanoseconds. Usage:
+//
+//   bench_wip_gui_font_atlas_cache [fonts] [atlas-height]
+
+#include "benchmark.h"
+#include "font_atlas_cache.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace application = wip::gui::application;
+
+namespace {
+
+constexpr size_t FONT_FILE_SIZE = 300 * 1024;
+constexpr uint32_t GLYPHS_PER_FONT = 400;
+constexpr uint32_t ATLAS_WIDTH = 1024;
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    wip::benchmark::Runner runner("bench_wip_gui_font_atlas_cache", argc, argv, "[fonts] [atlas-height]");
+    size_t font_count = runner.argument(0, 4);
+    uint32_t atlas_height = static_cast<uint32_t>(runner.argument(1, 1024));
+
+    auto directory = std::filesystem::temp_directory_path() / "bench_wip_gui_font_atlas_cache";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    std::vector<application::FontSpec> fonts;
+    for (size_t f = 0; f < font_count; ++f) {
+        auto path = directory / ("font_" + std::to_string(f) + ".ttf");
+        std::ofstream out(path, std::ios::binary);
+        for (size_t i = 0; i < FONT_FILE_SIZE; ++i) {
+            out.put(static_cast<char>((i * 131 + f) & 0xFF));
+        }
+        fonts.push_back({path.string(), 14.0f + 2.0f * static_cast<float>(f)});
+    }
+
+    application::BakedFontAtlas atlas;
+    atlas.width = ATLAS_WIDTH;
+    atlas.height = atlas_height;
+    atlas.pixels.resize(size_t{ATLAS_WIDTH} * atlas_height);
+    for (size_t i = 0; i < atlas.pixels.size(); ++i) {
+        atlas.pixels[i] = static_cast<uint8_t>(i % 251);
+    }
+    atlas.line_uvs.resize(64);
+    for (size_t f = 0; f < font_count; ++f) {
+        application::BakedFont font;
+        font.source = static_cast<int32_t>(f);
+        font.size = fonts[f].size_pixels;
+        for (uint32_t c = 0; c < GLYPHS_PER_FONT; ++c) {
+            font.glyphs.push_back({32 + c, 8.0f, 0.0f, 0.0f, 8.0f, font.size, 0.0f, 0.0f, 0.01f, 0.01f});
+        }
+        atlas.fonts.push_back(std::move(font));
+    }
+
+    application::FontAtlasCache cache(directory / "cache");
+    std::string key = application::font_atlas_cache_key(fonts, 1.0f, "bench");
+    cache.save(key, atlas);
+
+    runner.out() << font_count << " fonts of " << FONT_FILE_SIZE / 1024 << " KiB, atlas of " << ATLAS_WIDTH << "x"
+                 << atlas_height << std::endl;
+
+    const size_t startups = 50;
+    runner.measure("cache key", startups, [&]() {
+        size_t checksum = 0;
+        for (size_t i = 0; i < startups; ++i) {
+            checksum += application::font_atlas_cache_key(fonts, 1.0f, "bench").size();
+        }
+        return checksum;
+    });
+
+    runner.measure("load atlas", startups, [&]() {
+        size_t checksum = 0;
+        for (size_t i = 0; i < startups; ++i) {
+            auto loaded = cache.load(key);
+            checksum += loaded ? loaded->pixels.size() + loaded->fonts.size() : 0;
+        }
+        return checksum;
+    });
+
+    runner.measure("key and load", startups, [&]() {
+        size_t checksum = 0;
+        for (size_t i = 0; i < startups; ++i) {
+            auto loaded = cache.load(application::font_atlas_cache_key(fonts, 1.0f, "bench"));
+            checksum += loaded ? loaded->pixels.size() : 0;
+        }
+        return checksum;
+    });
+
+    runner.measure("save atlas", startups, [&]() {
+        size_t saved = 0;
+        for (size_t i = 0; i < startups; ++i) {
+            saved += cache.save(key, atlas);
+        }
+        return saved;
+    });
+
+    std::filesystem::remove_all(directory);
+    return runner.finish();
+}
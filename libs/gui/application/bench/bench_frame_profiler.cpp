@@ -0,0 +1,59 @@
+// Benchmark for the cost of frame profiling.
+//
+// Times the scopes of a frame with a given number of sections, such as the
+// layers and panels of an application, with the profiler disabled, which is
+// what every frame pays, and enabled, which is what frames pay while the
+// overlay is shown. Also times building the statistics the overlay draws.
+// Reports the time per scope, and per overlay refresh, in nanoseconds. Usage:
+//
+//   bench_wip_gui_frame_profiler [sections] [frames]
+
+#include "benchmark.h"
+#include "frame_profiler.h"
+#include <string>
+#include <vector>
+
+namespace application = wip::gui::application;
+
+int main(int argc, char* argv[]) {
+    wip::benchmark::Runner runner("bench_wip_gui_frame_profiler", argc, argv, "[sections] [frames]");
+    size_t section_count = runner.argument(0, 24);
+    size_t frames = runner.argument(1, 20000);
+
+    std::vector<std::string> names;
+    for (size_t i = 0; i < section_count; ++i) {
+        names.push_back("Section " + std::to_string(i));
+    }
+    runner.out() << frames << " frames of " << section_count << " sections" << std::endl;
+
+    application::FrameProfiler profiler;
+    auto run_frames = [&]() {
+        size_t scopes = 0;
+        for (size_t frame = 0; frame < frames; ++frame) {
+            for (const std::string& name : names) {
+                application::FrameProfiler::Scope scope(&profiler, name, "Panel");
+                ++scopes;
+            }
+            profiler.end_frame(std::chrono::milliseconds(16));
+        }
+        return scopes;
+    };
+
+    runner.measure("scope, disabled", frames * section_count, run_frames);
+
+    profiler.set_enabled(true);
+    runner.measure("scope, enabled", frames * section_count, run_frames);
+
+    const size_t refreshes = 1000;
+    runner.measure("overlay statistics", refreshes, [&]() {
+        size_t checksum = 0;
+        for (size_t i = 0; i < refreshes; ++i) {
+            checksum += profiler.section_stats().size();
+            checksum += profiler.frame_times_ms().size();
+            checksum += profiler.frame_histogram().counts[1];
+        }
+        return checksum;
+    });
+
+    return runner.finish();
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -8,10 +9,16 @@
 
 #include <window.h>
 #include <event_dispatcher.h>
+#include <executor.h>
+#include <time_utilities.h>
+#include "font_atlas_cache.h"
+#include "frame_profiler.h"
 #include "layer.h"
+#include "render_throttle.h"
 
-// Forward declare ImGui context
+// Forward declare ImGui types
 struct ImGuiContext;
+struct ImFont;
 
 namespace wip::gui::application {
 
@@ -23,6 +30,28 @@ struct ApplicationConfig {
     bool enable_vsync = true;
     bool auto_poll_events = true;
     
+    // Time per frame spent delivering events queued with EventDispatcher::enqueue (0 = all queued events)
+    float queued_event_budget_ms = 0.0f;
+    
+    // Render only after input, queued events or request_frame() instead of continuously
+    bool on_demand_rendering = false;
+    
+    // Longest time run() waits for input while rendering on demand
+    float idle_timeout_ms = 250.0f;
+    
+    // Skip minimized and hidden windows, and draw unfocused windows only when something
+    // changed for them or at unfocused_fps; run() sleeps while no window is due
+    bool throttle_background_windows = true;
+    
+    // Rate of unfocused windows without changes (0 = only on changes)
+    float unfocused_fps = 10.0f;
+    
+    // Directory of baked font atlases reused by load_fonts() (empty = rasterize at every start)
+    std::string font_cache_directory;
+    
+    // Key that shows and hides the profiler overlay (0 = no hotkey)
+    int profiler_overlay_key = GLFW_KEY_F12;
+    
     // Default window configuration
     wip::gui::window::WindowConfig default_window_config{};
 };
@@ -157,10 +186,43 @@ public:
     
     /**
      * @brief Set target frame rate (0 for unlimited)
+     * Frames are paced on an absolute schedule with sub-millisecond accuracy.
      * @param fps Target frames per second
      */
     void set_target_fps(float fps);
     
+    /**
+     * @brief Render only when something changed instead of every frame
+     * While nothing happens, run() blocks in wait_events() for up to
+     * ApplicationConfig::idle_timeout_ms. Input, events queued on the
+     * dispatcher, tasks posted to the UI executor and request_frame() wake it.
+     * @param enabled True to render on demand, false to render continuously
+     */
+    void set_on_demand_rendering(bool enabled) { config_.on_demand_rendering = enabled; }
+    
+    /**
+     * @brief Check if the application renders on demand
+     */
+    bool is_on_demand_rendering() const { return config_.on_demand_rendering; }
+    
+    /**
+     * @brief Ask for another frame, e.g. while something animates
+     * Every window is drawn again, unfocused ones included. Safe to call from
+     * any thread; wakes run() if it is waiting for input.
+     */
+    void request_frame();
+    
+    /**
+     * @brief Skip hidden windows and draw unfocused ones at a reduced rate
+     * @param enabled True to throttle, false to draw every window every frame
+     */
+    void set_background_throttling(bool enabled) { config_.throttle_background_windows = enabled; }
+    
+    /**
+     * @brief Set the rate of unfocused windows without changes (0 = only on changes)
+     */
+    void set_unfocused_fps(float fps);
+    
     /**
      * @brief Get current frame rate
      */
@@ -171,6 +233,21 @@ public:
      */
     float get_frame_time() const { return frame_time_; }
     
+    /**
+     * @brief Get the profiler that times the parts of each frame
+     * It records while the profiler overlay is shown. Layers add their own
+     * sections, e.g. one per panel, with FrameProfiler::Scope.
+     */
+    FrameProfiler& get_profiler() { return profiler_; }
+    
+    /**
+     * @brief Show or hide the overlay with per-layer and per-panel CPU times,
+     * ImGui's draw statistics and a frame time histogram
+     * ApplicationConfig::profiler_overlay_key toggles it as well.
+     */
+    void set_profiler_overlay_visible(bool visible);
+    bool is_profiler_overlay_visible() const { return profiler_overlay_visible_; }
+    
     /**
      * @brief Run one iteration of the event loop
      * Useful for custom main loops or integration with other systems
@@ -182,6 +259,26 @@ public:
      */
     void wait_events();
     
+    /**
+     * @brief Wait for events, at most for the given time
+     * @param timeout_seconds Longest time to wait
+     */
+    void wait_events(double timeout_seconds);
+    
+    /**
+     * @brief Deliver events queued on the event dispatcher and run the UI executor's tasks
+     * Called once per frame by run(); the dispatcher queue is limited by ApplicationConfig::queued_event_budget_ms.
+     * @return Number of events delivered and tasks run
+     */
+    size_t process_queued_events();
+    
+    /**
+     * @brief Get the executor that runs tasks on the UI thread
+     * Subscribe with EventDispatcher::subscribe_on() to have handlers of events
+     * published by worker threads run on the UI thread, once per frame.
+     */
+    wip::utils::event::QueuedExecutor& get_ui_executor() { return *ui_executor_; }
+    
     /**
      * @brief Set the event dispatcher for all windows
      */
@@ -219,16 +316,35 @@ public:
      * @brief Check if ImGui is initialized
      */
     bool is_imgui_initialized() const { return imgui_initialized_; }
+    
+    /**
+     * @brief Replace ImGui's fonts with the built-in font followed by fonts
+     * 
+     * With ImGui before 1.92, which rasterizes every font when the atlas is
+     * built, the baked atlas is stored in font_cache_directory and later starts
+     * load it in one read instead of rasterizing again. Newer ImGui versions
+     * rasterize glyphs on first use, so the fonts are only added. Earlier font
+     * pointers are invalid afterwards and io.FontDefault is reset to the
+     * built-in font. Must be called outside of a frame, e.g. in on_attach()
+     * or on_update().
+     * 
+     * @param fonts Fonts to load; missing files are skipped
+     * @param dpi_scale Scale applied to every size
+     * @return One font per entry of fonts, nullptr where the file could not be loaded
+     */
+    std::vector<ImFont*> load_fonts(const std::vector<FontSpec>& fonts, float dpi_scale = 1.0f);
 
 private:
     ApplicationConfig config_;
     std::unordered_map<WindowId, WindowPtr> windows_;
+    std::unordered_map<WindowId, RenderThrottle> render_throttles_;
     WindowId next_window_id_ = 1;
     WindowId main_window_id_ = 0;
     bool quit_requested_ = false;
     
     wip::utils::event::EventDispatcher* event_dispatcher_;
     bool owns_event_dispatcher_ = false;
+    std::unique_ptr<wip::utils::event::QueuedExecutor> ui_executor_;
     
     // Layer system
     std::vector<std::unique_ptr<Layer>> layers_;
@@ -239,19 +355,42 @@ private:
     float frame_time_ = 0.0f;
     float current_fps_ = 0.0f;
     float target_fps_ = 0.0f;  // 0 = unlimited
+    wip::time::utilities::FramePacer frame_pacer_;
+    
+    // On-demand rendering
+    static constexpr int SETTLE_FRAMES = 2;     // Frames rendered after a wake-up so ImGui settles
+    int settle_frames_ = 0;
+    std::atomic<bool> frame_requested_{false};
+    std::atomic<bool> wake_pending_{false};     // An empty event was posted and not consumed yet
+    std::atomic<bool> redraw_all_{false};       // request_frame() since the windows were last marked
+    
+    // Profiling
+    FrameProfiler profiler_;
+    bool profiler_overlay_visible_ = false;
     
     // ImGui
     ImGuiContext* imgui_context_ = nullptr;
     bool imgui_initialized_ = false;
+    bool fonts_uploaded_ = false;               // The renderer created the font texture in a frame
     
     void cleanup_closed_windows();
+    void flush_window_input();
+    void install_wake_callbacks();
+    bool has_pending_work() const;
+    void idle_until_needed();
+    void collect_redraw_requests(size_t processed_events);
+    void idle_until_due();
+    bool is_window_drawable(const wip::gui::window::Window& window) const;
+    bool has_focused_viewport() const;
     void setup_layer_event_forwarding();
     void update_layers(Timestep timestep);
-    void render_layers(Timestep timestep);
+    size_t render_layers(Timestep timestep);
     bool handle_layer_events(const wip::utils::event::Event& event);
     Timestep calculate_timestep();
     void begin_imgui_frame();
     void end_imgui_frame();
+    void collect_draw_stats();
+    void draw_profiler_overlay();
 };
 
 } // namespace wip::gui::application
\ No newline at end of file
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace wip::gui::application {
+
+/**
+ * @brief Font file to load at one size
+ */
+struct FontSpec {
+    std::string path;
+    float size_pixels = 16.0f;
+};
+
+/**
+ * @brief Placement of one glyph in a baked atlas, as the renderer stores it
+ */
+struct BakedGlyph {
+    uint32_t codepoint = 0;
+    float advance_x = 0.0f;
+    float x0 = 0.0f, y0 = 0.0f, x1 = 0.0f, y1 = 0.0f;     // Quad relative to the pen position
+    float u0 = 0.0f, v0 = 0.0f, u1 = 0.0f, v1 = 0.0f;     // Texture coordinates
+};
+
+/**
+ * @brief Metrics and glyphs of one font in a baked atlas
+ */
+struct BakedFont {
+    int32_t source = -1;            // Index of the FontSpec it was loaded from; -1 for built-in fonts
+    float size = 0.0f;
+    float ascent = 0.0f;
+    float descent = 0.0f;
+    std::vector<BakedGlyph> glyphs;
+};
+
+/**
+ * @brief Texture and glyph tables of a font atlas after rasterization
+ *
+ * Holds everything needed to draw text without opening or rasterizing the
+ * font files again.
+ */
+struct BakedFontAtlas {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<uint8_t> pixels;                        // Alpha, width * height bytes
+    std::array<float, 2> white_pixel_uv{};
+    std::vector<std::array<float, 4>> line_uvs;         // Anti-aliased line textures by width
+    std::vector<BakedFont> fonts;
+};
+
+/**
+ * @brief Compute the key of an atlas built from fonts
+ *
+ * The key covers the content of every font file, the sizes, the DPI scale and
+ * the rasterizer, so editing a font file or moving to another monitor scale
+ * selects another atlas. Missing files are part of the key as missing.
+ *
+ * @param fonts Fonts in the order they are added to the atlas
+ * @param dpi_scale Scale the sizes are multiplied by
+ * @param builder Name and version of the rasterizer that bakes the atlas
+ * @return Hexadecimal key
+ */
+std::string font_atlas_cache_key(const std::vector<FontSpec>& fonts, float dpi_scale, std::string_view builder);
+
+/**
+ * @brief Directory of baked font atlases, one file per key
+ *
+ * Loading an atlas reads one memory-mapped file, which is far cheaper than
+ * rasterizing the fonts at startup. A file that is truncated, corrupt or was
+ * written for another key is treated as missing.
+ *
+ * Example:
+ * ```cpp
+ * FontAtlasCache cache(cache_directory);
+ * std::string key = font_atlas_cache_key(fonts, 1.0f, "renderer 1.0");
+ * if (auto atlas = cache.load(key)) {
+ *     upload(*atlas);
+ * } else {
+ *     cache.save(key, bake(fonts));
+ * }
+ * ```
+ */
+class FontAtlasCache {
+public:
+    /**
+     * @brief Use a cache directory; it is created on the first save
+     */
+    explicit FontAtlasCache(std::filesystem::path directory);
+
+    /**
+     * @brief Get the default directory, under $XDG_CACHE_HOME or ~/.cache
+     * @param application Subdirectory of the application
+     * @return Directory, or an empty path if there is no home directory
+     */
+    static std::filesystem::path default_directory(std::string_view application);
+
+    /**
+     * @brief Load the atlas stored for a key
+     * @return The atlas, or nullopt if none is stored or the file is invalid
+     */
+    std::optional<BakedFontAtlas> load(const std::string& key) const;
+
+    /**
+     * @brief Store an atlas for a key, replacing the file atomically
+     * @return true if the atlas was written
+     */
+    bool save(const std::string& key, const BakedFontAtlas& atlas) const;
+
+    /**
+     * @brief Get the file an atlas is stored in
+     */
+    std::filesystem::path path_for(const std::string& key) const;
+
+    const std::filesystem::path& directory() const noexcept { return directory_; }
+
+private:
+    std::filesystem::path directory_;
+};
+
+} // namespace wip::gui::application
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <time_utilities.h>
+
+namespace wip::gui::application {
+
+/**
+ * @brief CPU time per section of the frame over the last frames
+ *
+ * Sections are named parts of a frame, such as a layer's update or a panel's
+ * draw, grouped by what they belong to. Their time is summed over a frame and
+ * kept for the last HISTORY_FRAMES frames, together with the frame times and
+ * the draw statistics of the last frame. While disabled nothing is recorded
+ * and a Scope costs one branch.
+ *
+ * Example:
+ * ```cpp
+ * void draw_panels(FrameProfiler* profiler) {
+ *     FrameProfiler::Scope scope(profiler, "Results", "Panel");
+ *     results.draw();
+ * }
+ * ```
+ */
+class FrameProfiler {
+public:
+    using Clock = wip::time::utilities::FastClock;
+    using Duration = std::chrono::nanoseconds;
+
+    static constexpr size_t HISTORY_FRAMES = 240;
+
+    /**
+     * @brief Geometry submitted to the renderer in a frame
+     */
+    struct DrawStats {
+        size_t draw_lists = 0;
+        size_t draw_calls = 0;
+        size_t vertices = 0;
+        size_t indices = 0;
+    };
+
+    /**
+     * @brief Times of one section over the recorded frames
+     */
+    struct SectionStats {
+        std::string group;
+        std::string name;
+        Duration last{};                // In the last recorded frame
+        Duration average{};
+        Duration max{};
+    };
+
+    /**
+     * @brief Number of recorded frames per range of frame times
+     */
+    struct Histogram {
+        static constexpr size_t BUCKETS = 6;
+        static constexpr std::array<float, BUCKETS - 1> UPPER_MS = {8.33f, 16.67f, 33.33f, 50.0f, 100.0f};
+
+        std::array<size_t, BUCKETS> counts{};     // Last bucket holds frames above 100 ms
+
+        /**
+         * @brief Get the label of a bucket, e.g. "16.7-33.3 ms"
+         */
+        static std::string label(size_t bucket);
+    };
+
+    /**
+     * @brief Adds the time until its destruction to a section of the current frame
+     */
+    class Scope {
+    public:
+        /**
+         * @brief Start timing
+         * @param profiler Profiler to record into; nothing is timed if null or disabled
+         * @param name Section name; must outlive the scope
+         * @param group Group of the section, e.g. "Update" or "Panel"; must outlive the scope
+         */
+        Scope(FrameProfiler* profiler, std::string_view name, std::string_view group = {}) noexcept;
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        FrameProfiler* profiler_;
+        std::string_view name_;
+        std::string_view group_;
+        Clock::time_point start_;
+    };
+
+    /**
+     * @brief Start or stop recording; starting drops what was recorded before
+     */
+    void set_enabled(bool enabled);
+    bool is_enabled() const noexcept { return enabled_; }
+
+    /**
+     * @brief Add time to a section of the current frame
+     */
+    void add(std::string_view name, std::string_view group, Duration time);
+
+    /**
+     * @brief Record the draw statistics of the current frame
+     */
+    void set_draw_stats(const DrawStats& stats) noexcept;
+
+    /**
+     * @brief Close the current frame
+     * @param frame_time Time the frame took
+     */
+    void end_frame(Duration frame_time);
+
+    /**
+     * @brief Drop every recorded frame and section
+     */
+    void reset();
+
+    /**
+     * @brief Get number of recorded frames, at most HISTORY_FRAMES
+     */
+    size_t frame_count() const noexcept;
+
+    /**
+     * @brief Get the times of every section, in the order they were first recorded
+     */
+    std::vector<SectionStats> section_stats() const;
+
+    /**
+     * @brief Get the recorded frame times in milliseconds, oldest first
+     */
+    std::vector<float> frame_times_ms() const;
+
+    Histogram frame_histogram() const;
+    Duration average_frame_time() const;
+    Duration max_frame_time() const;
+
+    /**
+     * @brief Get the draw statistics of the last recorded frame
+     */
+    const DrawStats& draw_stats() const noexcept { return last_draw_stats_; }
+
+private:
+    struct Section {
+        std::string group;
+        std::string name;
+        Duration current{};                                 // Frame being recorded
+        std::array<Duration, HISTORY_FRAMES> history{};     // Ring indexed like frame_times_
+    };
+
+    // Index of the ring slot of a recorded frame, 0 = oldest
+    size_t slot(size_t frame) const noexcept;
+
+    bool enabled_ = false;
+    std::vector<Section> sections_;
+    std::array<Duration, HISTORY_FRAMES> frame_times_{};
+    uint64_t frames_ = 0;                                   // Frames ended since the last reset
+    DrawStats draw_stats_;
+    DrawStats last_draw_stats_;
+};
+
+} // namespace wip::gui::application
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <chrono>
+
+namespace wip::gui::application {
+
+/**
+ * @brief Decides in which iterations of the main loop a window is drawn
+ *
+ * Minimized and hidden windows are never drawn. The focused window is drawn
+ * whenever the application renders. Other windows are drawn when something
+ * changed for them (input, a window event, request_frame()) and otherwise at
+ * a reduced rate, so that they keep showing progress without costing a full
+ * frame every iteration.
+ */
+class RenderThrottle {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Create the state of a window that has not been drawn yet
+     * @param unfocused_fps Rate of unfocused windows without changes (0 = only on changes)
+     */
+    explicit RenderThrottle(float unfocused_fps = 10.0f);
+
+    /**
+     * @brief Set the rate of unfocused windows without changes (0 = only on changes)
+     */
+    void set_unfocused_fps(float fps);
+
+    /**
+     * @brief Note that the window's content changed since it was last drawn
+     */
+    void mark_dirty() noexcept { dirty_ = true; }
+    bool is_dirty() const noexcept { return dirty_; }
+
+    /**
+     * @brief Check whether the window is due to be drawn
+     * @param visible Shown, not minimized and with a non-empty framebuffer
+     * @param focused Has input focus
+     * @param now Current time
+     */
+    bool should_render(bool visible, bool focused, Clock::time_point now) const;
+
+    /**
+     * @brief Record that the window was drawn
+     */
+    void rendered(Clock::time_point now) noexcept;
+
+    /**
+     * @brief Get the time an unfocused window without changes is due next
+     * @return Clock::time_point::max() if it is only drawn on changes
+     */
+    Clock::time_point next_due() const;
+
+private:
+    Clock::duration unfocused_interval_{};      // Zero when only drawn on changes
+    Clock::time_point last_render_{};
+    bool dirty_ = true;
+};
+
+} // namespace wip::gui::application
@@ -3,8 +3,11 @@
 
 #include <stdexcept>
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
 #include <thread>
-#include <iostream>
+#include <log.h>
 
 #include <imgui.h>
 #include <imgui_impl_glfw.h>
@@ -19,11 +22,107 @@
 
 namespace wip::gui::application {
 
+namespace {
+
+#if IMGUI_VERSION_NUM < 19200
+// Before 1.92 ImGui rasterizes every glyph of every font when the atlas is
+// built, so the result can be stored and put back in place of the build.
+
+// sources holds the FontSpec index of each font of the atlas, -1 for built-in fonts
+BakedFontAtlas capture_font_atlas(ImFontAtlas& atlas, const std::vector<int32_t>& sources) {
+    BakedFontAtlas baked;
+    unsigned char* pixels = nullptr;
+    int width = 0;
+    int height = 0;
+    atlas.GetTexDataAsAlpha8(&pixels, &width, &height);
+    if (!pixels || width <= 0 || height <= 0) {
+        return baked;
+    }
+    baked.width = static_cast<uint32_t>(width);
+    baked.height = static_cast<uint32_t>(height);
+    baked.pixels.assign(pixels, pixels + static_cast<size_t>(width) * static_cast<size_t>(height));
+    baked.white_pixel_uv = {atlas.TexUvWhitePixel.x, atlas.TexUvWhitePixel.y};
+    for (const ImVec4& uv : atlas.TexUvLines) {
+        baked.line_uvs.push_back({uv.x, uv.y, uv.z, uv.w});
+    }
+
+    for (int i = 0; i < atlas.Fonts.Size; ++i) {
+        const ImFont* font = atlas.Fonts[i];
+        BakedFont& out = baked.fonts.emplace_back();
+        out.source = static_cast<size_t>(i) < sources.size() ? sources[i] : -1;
+        out.size = font->FontSize;
+        out.ascent = font->Ascent;
+        out.descent = font->Descent;
+        out.glyphs.reserve(static_cast<size_t>(font->Glyphs.Size));
+        for (const ImFontGlyph& glyph : font->Glyphs) {
+            out.glyphs.push_back({glyph.Codepoint, glyph.AdvanceX, glyph.X0, glyph.Y0, glyph.X1, glyph.Y1,
+                                  glyph.U0, glyph.V0, glyph.U1, glyph.V1});
+        }
+    }
+    return baked;
+}
+
+// Fonts restored this way have no font data, so the atlas must not be built
+// again; load_fonts() clears it and adds the files instead. The software mouse
+// cursor (io.MouseDrawCursor) is not part of a restored atlas.
+bool restore_font_atlas(const BakedFontAtlas& baked, ImFontAtlas& atlas) {
+    if (baked.fonts.empty() || baked.width == 0 || baked.height == 0 ||
+        baked.line_uvs.size() != IM_ARRAYSIZE(atlas.TexUvLines)) {
+        return false;
+    }
+    atlas.Clear();
+
+    // Fonts point at their config, so every config is in place before the first font refers to one
+    atlas.ConfigData.reserve(static_cast<int>(baked.fonts.size()));
+    for (const BakedFont& font : baked.fonts) {
+        ImFontConfig config;
+        config.FontDataOwnedByAtlas = false;
+        config.SizePixels = font.size;
+        atlas.ConfigData.push_back(config);
+    }
+    for (size_t i = 0; i < baked.fonts.size(); ++i) {
+        const BakedFont& source = baked.fonts[i];
+        ImFontConfig& config = atlas.ConfigData[static_cast<int>(i)];
+        ImFont* font = IM_NEW(ImFont)();
+        config.DstFont = font;
+        font->ContainerAtlas = &atlas;
+        font->ConfigData = &config;
+        font->ConfigDataCount = 1;
+        font->FontSize = source.size;
+        font->Ascent = source.ascent;
+        font->Descent = source.descent;
+        for (const BakedGlyph& glyph : source.glyphs) {
+            font->AddGlyph(nullptr, static_cast<ImWchar>(glyph.codepoint), glyph.x0, glyph.y0, glyph.x1, glyph.y1,
+                           glyph.u0, glyph.v0, glyph.u1, glyph.v1, glyph.advance_x);
+        }
+        font->BuildLookupTable();
+        atlas.Fonts.push_back(font);
+    }
+
+    atlas.TexPixelsAlpha8 = static_cast<unsigned char*>(IM_ALLOC(baked.pixels.size()));
+    std::memcpy(atlas.TexPixelsAlpha8, baked.pixels.data(), baked.pixels.size());
+    atlas.TexWidth = static_cast<int>(baked.width);
+    atlas.TexHeight = static_cast<int>(baked.height);
+    atlas.TexUvScale = ImVec2(1.0f / static_cast<float>(baked.width), 1.0f / static_cast<float>(baked.height));
+    atlas.TexUvWhitePixel = ImVec2(baked.white_pixel_uv[0], baked.white_pixel_uv[1]);
+    for (size_t i = 0; i < baked.line_uvs.size(); ++i) {
+        const auto& uv = baked.line_uvs[i];
+        atlas.TexUvLines[i] = ImVec4(uv[0], uv[1], uv[2], uv[3]);
+    }
+    atlas.TexReady = true;
+    return true;
+}
+#endif
+
+} // namespace
+
 Application::Application(const ApplicationConfig& config) 
-    : config_(config), event_dispatcher_(nullptr), owns_event_dispatcher_(true) {
+    : config_(config), event_dispatcher_(nullptr), owns_event_dispatcher_(true),
+      ui_executor_(std::make_unique<wip::utils::event::QueuedExecutor>()) {
     
     // Create default event dispatcher
     event_dispatcher_ = new wip::utils::event::EventDispatcher();
+    install_wake_callbacks();
     
     // Initialize timing
     start_time_ = std::chrono::steady_clock::now();
@@ -42,17 +141,21 @@ Application::~Application() {
     if (owns_event_dispatcher_ && event_dispatcher_) {
         delete event_dispatcher_;
         event_dispatcher_ = nullptr;
+    } else if (event_dispatcher_) {
+        event_dispatcher_->set_wake_callback(nullptr);
     }
 }
 
 Application::Application(Application&& other) noexcept
     : config_(std::move(other.config_)),
       windows_(std::move(other.windows_)),
+      render_throttles_(std::move(other.render_throttles_)),
       next_window_id_(other.next_window_id_),
       main_window_id_(other.main_window_id_),
       quit_requested_(other.quit_requested_),
       event_dispatcher_(other.event_dispatcher_),
-      owns_event_dispatcher_(other.owns_event_dispatcher_) {
+      owns_event_dispatcher_(other.owns_event_dispatcher_),
+      ui_executor_(std::move(other.ui_executor_)) {
     
     // Prevent the other object from deleting the dispatcher
     other.event_dispatcher_ = nullptr;
@@ -60,6 +163,9 @@ Application::Application(Application&& other) noexcept
     other.next_window_id_ = 1;
     other.main_window_id_ = 0;
     other.quit_requested_ = false;
+    
+    // The callbacks point at the moved-from application
+    install_wake_callbacks();
 }
 
 Application& Application::operator=(Application&& other) noexcept {
@@ -72,11 +178,13 @@ Application& Application::operator=(Application&& other) noexcept {
         // Move the data
         config_ = std::move(other.config_);
         windows_ = std::move(other.windows_);
+        render_throttles_ = std::move(other.render_throttles_);
         next_window_id_ = other.next_window_id_;
         main_window_id_ = other.main_window_id_;
         quit_requested_ = other.quit_requested_;
         event_dispatcher_ = other.event_dispatcher_;
         owns_event_dispatcher_ = other.owns_event_dispatcher_;
+        ui_executor_ = std::move(other.ui_executor_);
         
         // Prevent the other object from deleting the dispatcher
         other.event_dispatcher_ = nullptr;
@@ -84,6 +192,8 @@ Application& Application::operator=(Application&& other) noexcept {
         other.next_window_id_ = 1;
         other.main_window_id_ = 0;
         other.quit_requested_ = false;
+        
+        install_wake_callbacks();
     }
     return *this;
 }
@@ -106,6 +216,7 @@ Application::WindowId Application::create_window(const wip::gui::window::WindowC
         }
         
         windows_[id] = std::move(window);
+        render_throttles_.emplace(id, RenderThrottle(config_.unfocused_fps));
         return id;
     }
     catch (const std::exception& e) {
@@ -129,6 +240,7 @@ void Application::destroy_window(WindowId window_id) {
     auto it = windows_.find(window_id);
     if (it != windows_.end()) {
         windows_.erase(it);
+        render_throttles_.erase(window_id);
         
         // If we destroyed the main window, designate a new main window
         if (window_id == main_window_id_ && !windows_.empty()) {
@@ -185,7 +297,7 @@ void Application::quit() {
 }
 
 void Application::run() {
-    std::cout << "Starting " << config_.name << "..." << std::endl;
+    LOG_INFO("APPLICATION", "Starting ", config_.name, "...");
     
     // Attach all layers
     for (auto& layer : layers_) {
@@ -201,30 +313,45 @@ void Application::run() {
     while (!should_quit()) {
         // Calculate frame timing
         Timestep timestep = calculate_timestep();
+        auto frame_start = FrameProfiler::Clock::now();
         
-        // Poll events first
-        if (config_.auto_poll_events) {
-            poll_events();
+        {
+            FrameProfiler::Scope scope(&profiler_, "Events", "Application");
+            
+            // Poll events first
+            if (config_.auto_poll_events) {
+                poll_events();
+            }
+            
+            // Deliver events queued by other threads since the last frame
+            size_t processed = process_queued_events();
+            
+            // Clean up any closed windows
+            cleanup_closed_windows();
+            
+            // Note which windows changed since they were drawn
+            collect_redraw_requests(processed);
         }
         
-        // Clean up any closed windows
-        cleanup_closed_windows();
-        
         // Update layers
         update_layers(timestep);
         
         // Render layers
-        render_layers(timestep);
+        size_t rendered = render_layers(timestep);
         
-        // Frame rate limiting
-        if (target_fps_ > 0.0f) {
-            float target_frame_time = 1.0f / target_fps_;
-            if (frame_time_ < target_frame_time) {
-                float sleep_time = target_frame_time - frame_time_;
-                std::this_thread::sleep_for(
-                    std::chrono::milliseconds(static_cast<int>(sleep_time * 1000.0f))
-                );
-            }
+        // Iterations that draw nothing are counted with the next frame that does
+        if (rendered > 0) {
+            profiler_.end_frame(FrameProfiler::Clock::now() - frame_start);
+        }
+        
+        // Frame rate limiting (no-op when unlimited)
+        frame_pacer_.wait_for_next_frame();
+        
+        // Sleep until there is something to show
+        if (config_.on_demand_rendering) {
+            idle_until_needed();
+        } else if (rendered == 0) {
+            idle_until_due();
         }
         
         // Update FPS counter
@@ -240,7 +367,7 @@ void Application::run() {
         }
     }
     
-    std::cout << config_.name << " shutting down...\\n";
+    LOG_INFO("APPLICATION", config_.name, " shutting down...");
 }
 
 void Application::poll_events() {
@@ -249,6 +376,16 @@ void Application::poll_events() {
         // GLFW events are global, so polling from any window works
         auto first_window = windows_.begin()->second.get();
         first_window->poll_events();
+        flush_window_input();
+    }
+}
+
+void Application::flush_window_input() {
+    // Each window merges its own mouse moves and scrolls; polling flushed only the first one
+    for (auto& [id, window] : windows_) {
+        if (window) {
+            window->flush_input();
+        }
     }
 }
 
@@ -257,16 +394,159 @@ void Application::wait_events() {
         // Wait for events using the first available window
         auto first_window = windows_.begin()->second.get();
         first_window->wait_events();
+        flush_window_input();
+    }
+}
+
+void Application::wait_events(double timeout_seconds) {
+    if (!windows_.empty()) {
+        auto first_window = windows_.begin()->second.get();
+        first_window->wait_events(timeout_seconds);
+        flush_window_input();
+    } else {
+        std::this_thread::sleep_for(std::chrono::duration<double>(timeout_seconds));
+    }
+}
+
+void Application::request_frame() {
+    frame_requested_.store(true);
+    redraw_all_.store(true);
+    
+    // One empty event is enough to wake the loop, however many threads ask
+    bool may_be_waiting = config_.on_demand_rendering || config_.throttle_background_windows;
+    if (may_be_waiting && !wake_pending_.exchange(true)) {
+        wip::gui::window::Window::post_empty_event();
+    }
+}
+
+void Application::set_unfocused_fps(float fps) {
+    config_.unfocused_fps = fps;
+    for (auto& [id, throttle] : render_throttles_) {
+        throttle.set_unfocused_fps(fps);
+    }
+}
+
+void Application::set_profiler_overlay_visible(bool visible) {
+    profiler_overlay_visible_ = visible;
+    profiler_.set_enabled(visible);
+    request_frame();
+}
+
+bool Application::has_pending_work() const {
+    if (event_dispatcher_ && event_dispatcher_->queued_event_count() > 0) {
+        return true;
+    }
+    return ui_executor_ && ui_executor_->pending_count() > 0;
+}
+
+void Application::idle_until_needed() {
+    // Hover and release states take ImGui a frame or two to catch up with input
+    if (settle_frames_ > 0) {
+        --settle_frames_;
+        return;
+    }
+    
+    // Requests made from here on post a new empty event
+    wake_pending_.store(false);
+    if (!frame_requested_.exchange(false) && !has_pending_work()) {
+        wait_events(config_.idle_timeout_ms / 1000.0);
+        frame_pacer_.reset();
+        frame_requested_.store(false);
+    }
+    settle_frames_ = SETTLE_FRAMES;
+}
+
+void Application::collect_redraw_requests(size_t processed_events) {
+    // Requests and queued events may change what any window shows
+    bool redraw_all = redraw_all_.exchange(false) || processed_events > 0;
+    for (auto& [id, window] : windows_) {
+        // Always take the window's request so that it does not linger
+        if (window->take_redraw_request() || redraw_all) {
+            render_throttles_[id].mark_dirty();
+        }
+    }
+}
+
+void Application::idle_until_due() {
+    // Only reached while every window is hidden, minimized or waiting for its next frame
+    wake_pending_.store(false);
+    if (redraw_all_.load() || has_pending_work()) {
+        return;
+    }
+    
+    auto now = RenderThrottle::Clock::now();
+    auto timeout = std::chrono::duration<double>(config_.idle_timeout_ms / 1000.0);
+    for (auto& [id, window] : windows_) {
+        if (is_window_drawable(*window)) {
+            timeout = std::min(timeout, std::chrono::duration<double>(render_throttles_[id].next_due() - now));
+        }
+    }
+    if (timeout.count() > 0.0) {
+        wait_events(timeout.count());
+        frame_pacer_.reset();
+    }
+}
+
+bool Application::is_window_drawable(const wip::gui::window::Window& window) const {
+    if (!window.is_visible() || window.is_iconified()) {
+        return false;
+    }
+    // Some platforms report minimized or fully covered windows as a zero-sized framebuffer
+    auto [width, height] = window.get_framebuffer_size();
+    return width > 0 && height > 0;
+}
+
+bool Application::has_focused_viewport() const {
+    if (!imgui_initialized_ || !(ImGui::GetIO().ConfigFlags & ImGuiConfigFlags_ViewportsEnable)) {
+        return false;
+    }
+    for (ImGuiViewport* viewport : ImGui::GetPlatformIO().Viewports) {
+        auto* glfw_window = static_cast<GLFWwindow*>(viewport->PlatformHandle);
+        if (viewport != ImGui::GetMainViewport() && glfw_window && glfwGetWindowAttrib(glfw_window, GLFW_FOCUSED)) {
+            return true;
+        }
     }
+    return false;
+}
+
+void Application::install_wake_callbacks() {
+    if (event_dispatcher_) {
+        event_dispatcher_->set_wake_callback([this]() { request_frame(); });
+    }
+    if (ui_executor_) {
+        ui_executor_->set_wake_callback([this]() { request_frame(); });
+    }
+}
+
+size_t Application::process_queued_events() {
+    size_t processed = 0;
+    
+    if (event_dispatcher_) {
+        if (config_.queued_event_budget_ms > 0.0f) {
+            auto budget = std::chrono::duration<float, std::milli>(config_.queued_event_budget_ms);
+            processed += event_dispatcher_->process_queue(std::chrono::duration_cast<std::chrono::nanoseconds>(budget));
+        } else {
+            processed += event_dispatcher_->process_queue();
+        }
+    }
+    
+    // Handlers subscribed on the UI executor, including those the queue just fed
+    if (ui_executor_) {
+        processed += ui_executor_->run_pending();
+    }
+    return processed;
 }
 
 void Application::set_event_dispatcher(wip::utils::event::EventDispatcher* dispatcher) {
     if (owns_event_dispatcher_ && event_dispatcher_) {
         delete event_dispatcher_;
         owns_event_dispatcher_ = false;
+    } else if (event_dispatcher_) {
+        event_dispatcher_->set_wake_callback(nullptr);
     }
     
     event_dispatcher_ = dispatcher;
+    install_wake_callbacks();
     
     // Update all existing windows
     for (auto& pair : windows_) {
@@ -294,6 +574,7 @@ void Application::cleanup_closed_windows() {
             if (it->first == main_window_id_) {
                 main_window_id_ = 0;
             }
+            render_throttles_.erase(it->first);
             it = windows_.erase(it);
         } else {
             ++it;
@@ -365,6 +646,7 @@ const Layer* Application::get_layer(const std::string& name) const {
 
 void Application::set_target_fps(float fps) {
     target_fps_ = fps > 0.0f ? fps : 0.0f;
+    frame_pacer_.set_target_fps(target_fps_);
 }
 
 // Helper method to forward events from the event dispatcher to layers
@@ -412,39 +694,76 @@ void Application::setup_layer_event_forwarding() {
 void Application::update_layers(Timestep timestep) {
     for (auto& layer : layers_) {
         if (layer && layer->is_enabled()) {
+            FrameProfiler::Scope scope(&profiler_, layer->get_name(), "Update");
             layer->on_update(timestep);
         }
     }
 }
 
-void Application::render_layers(Timestep timestep) {
+size_t Application::render_layers(Timestep timestep) {
+    // Pick the windows due this frame; without throttling that is every open window
+    auto now = RenderThrottle::Clock::now();
+    std::vector<std::pair<WindowId, wip::gui::window::Window*>> due;
+    for (auto& window_pair : windows_) {
+        auto* window = window_pair.second.get();
+        if (!window || window->should_close()) {
+            continue;
+        }
+        // ImGui's platform windows are drawn with the main window, so they count as its focus
+        bool focused = window->is_focused() || (window_pair.first == main_window_id_ && has_focused_viewport());
+        if (!config_.throttle_background_windows ||
+            render_throttles_[window_pair.first].should_render(is_window_drawable(*window), focused, now)) {
+            due.emplace_back(window_pair.first, window);
+        }
+    }
+    if (due.empty()) {
+        return 0;
+    }
+    
     // Begin ImGui frame if initialized
     begin_imgui_frame();
     
     // Render layers for each window
-    for (auto& window_pair : windows_) {
-        auto* window = window_pair.second.get();
-        if (window && !window->should_close()) {
-            // Make this window's context current
-            window->make_context_current();
-            
-            // Render all enabled layers
-            for (auto& layer : layers_) {
-                if (layer && layer->is_enabled()) {
-                    layer->on_render(timestep);
-                }
+    for (auto& [window_id, window] : due) {
+        // Make this window's context current
+        window->make_context_current();
+        
+        // Render all enabled layers
+        for (auto& layer : layers_) {
+            if (layer && layer->is_enabled()) {
+                FrameProfiler::Scope scope(&profiler_, layer->get_name(), "Render");
+                layer->on_render(timestep);
             }
-            
-            // End ImGui frame and render ImGui content
-            end_imgui_frame();
-            
-            // Swap the buffers to display the rendered frame
+        }
+        
+        // The overlay belongs to the application, above every layer
+        if (profiler_overlay_visible_ && window_id == due.front().first) {
+            draw_profiler_overlay();
+        }
+        
+        // End ImGui frame and render ImGui content
+        end_imgui_frame();
+        
+        // Swap the buffers to display the rendered frame; with vsync this waits for the display
+        {
+            FrameProfiler::Scope scope(&profiler_, "Swap", "Application");
             window->swap_buffers();
         }
+        render_throttles_[window_id].rendered(now);
     }
+    return due.size();
 }
 
 bool Application::handle_layer_events(const wip::utils::event::Event& event) {
+    if (config_.profiler_overlay_key != 0) {
+        auto* key_event = dynamic_cast<const wip::gui::window::events::KeyboardEvent*>(&event);
+        if (key_event && key_event->key() == config_.profiler_overlay_key &&
+            key_event->action() == wip::gui::window::events::KeyboardEvent::Action::Press) {
+            set_profiler_overlay_visible(!profiler_overlay_visible_);
+            return true;
+        }
+    }
+    
     // Events propagate from top to bottom (last added layer first)
     for (auto it = layers_.rbegin(); it != layers_.rend(); ++it) {
         if (*it && (*it)->is_enabled()) {
@@ -545,6 +864,72 @@ void Application::shutdown_imgui() {
     }
     
     imgui_initialized_ = false;
+    fonts_uploaded_ = false;
+}
+
+std::vector<ImFont*> Application::load_fonts(const std::vector<FontSpec>& fonts, float dpi_scale) {
+    if (!imgui_initialized_) {
+        throw std::runtime_error("Cannot load fonts: ImGui is not initialized");
+    }
+    
+    ImGuiIO& io = ImGui::GetIO();
+    ImFontAtlas* atlas = io.Fonts;
+    std::vector<ImFont*> loaded(fonts.size(), nullptr);
+    
+    // ImGui asserts on files it cannot open, so missing fonts are skipped here
+    auto add_fonts = [&]() {
+        atlas->Clear();
+        atlas->AddFontDefault();
+        for (size_t i = 0; i < fonts.size(); ++i) {
+            std::error_code error;
+            if (std::filesystem::is_regular_file(fonts[i].path, error)) {
+                loaded[i] = atlas->AddFontFromFileTTF(fonts[i].path.c_str(), fonts[i].size_pixels * dpi_scale);
+            }
+        }
+    };
+    
+#if IMGUI_VERSION_NUM < 19200
+    FontAtlasCache cache(config_.font_cache_directory);
+    const std::string key = font_atlas_cache_key(fonts, dpi_scale, "imgui " IMGUI_VERSION);
+    auto baked = cache.load(key);
+    if (baked && restore_font_atlas(*baked, *atlas)) {
+        for (size_t i = 0; i < baked->fonts.size(); ++i) {
+            int32_t source = baked->fonts[i].source;
+            if (source >= 0 && static_cast<size_t>(source) < loaded.size()) {
+                loaded[source] = atlas->Fonts[static_cast<int>(i)];
+            }
+        }
+        LOG_DEBUG("APPLICATION", "Fonts loaded from ", cache.path_for(key).string());
+    } else {
+        add_fonts();
+        std::vector<int32_t> sources = {-1};
+        for (size_t i = 0; i < loaded.size(); ++i) {
+            if (loaded[i]) {
+                sources.push_back(static_cast<int32_t>(i));
+            }
+        }
+        if (atlas->Build() && !config_.font_cache_directory.empty()) {
+            if (!cache.save(key, capture_font_atlas(*atlas, sources))) {
+                LOG_WARNING("APPLICATION", "Could not store the font atlas in ", config_.font_cache_directory);
+            }
+        }
+    }
+    
+    // The renderer uploaded the previous atlas in an earlier frame
+    if (fonts_uploaded_) {
+        if (auto* main_window = get_main_window()) {
+            main_window->make_context_current();
+        }
+        ImGui_ImplOpenGL3_DestroyFontsTexture();
+        ImGui_ImplOpenGL3_CreateFontsTexture();
+    }
+#else
+    // Glyphs are rasterized on first use and the renderer updates the texture itself
+    add_fonts();
+#endif
+    
+    io.FontDefault = nullptr;
+    return loaded;
 }
 
 void Application::begin_imgui_frame() {
@@ -552,8 +937,9 @@ void Application::begin_imgui_frame() {
         return;
     }
     
-    // Start the Dear ImGui frame
+    // Start the Dear ImGui frame; the renderer creates the font texture in its first one
     ImGui_ImplOpenGL3_NewFrame();
+    fonts_uploaded_ = true;
     ImGui_ImplGlfw_NewFrame();
     ImGui::NewFrame();
 }
@@ -564,12 +950,17 @@ void Application::end_imgui_frame() {
     }
     
     // Render ImGui
-    ImGui::Render();
-    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    {
+        FrameProfiler::Scope scope(&profiler_, "ImGui render", "Application");
+        ImGui::Render();
+        collect_draw_stats();
+        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    }
     
     // Update and render additional platform windows
     ImGuiIO& io = ImGui::GetIO();
     if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable) {
+        FrameProfiler::Scope scope(&profiler_, "Platform windows", "Application");
         GLFWwindow* backup_current_context = glfwGetCurrentContext();
         ImGui::UpdatePlatformWindows();
         ImGui::RenderPlatformWindowsDefault();
@@ -577,4 +968,99 @@ void Application::end_imgui_frame() {
     }
 }
 
+void Application::collect_draw_stats() {
+    if (!profiler_.is_enabled()) {
+        return;
+    }
+    
+    // Render() fills the draw data of every viewport, platform windows included
+    FrameProfiler::DrawStats stats;
+    for (ImGuiViewport* viewport : ImGui::GetPlatformIO().Viewports) {
+        ImDrawData* draw_data = viewport->DrawData;
+        if (!draw_data || !draw_data->Valid) {
+            continue;
+        }
+        stats.draw_lists += static_cast<size_t>(draw_data->CmdListsCount);
+        stats.vertices += static_cast<size_t>(draw_data->TotalVtxCount);
+        stats.indices += static_cast<size_t>(draw_data->TotalIdxCount);
+        for (int i = 0; i < draw_data->CmdListsCount; ++i) {
+            stats.draw_calls += static_cast<size_t>(draw_data->CmdLists[i]->CmdBuffer.Size);
+        }
+    }
+    profiler_.set_draw_stats(stats);
+}
+
+void Application::draw_profiler_overlay() {
+    ImGui::SetNextWindowSize(ImVec2(460.0f, 520.0f), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowBgAlpha(0.9f);
+    if (!ImGui::Begin("Profiler", &profiler_overlay_visible_, ImGuiWindowFlags_NoFocusOnAppearing)) {
+        ImGui::End();
+        return;
+    }
+    
+    const auto to_ms = [](FrameProfiler::Duration time) {
+        return std::chrono::duration<float, std::milli>(time).count();
+    };
+    
+    // Frame times: the plot shows stutters as spikes, the histogram how often they happen
+    float average_ms = to_ms(profiler_.average_frame_time());
+    ImGui::Text("Frame %.2f ms average, %.2f ms max over %zu frames", average_ms,
+                to_ms(profiler_.max_frame_time()), profiler_.frame_count());
+    std::vector<float> frame_times = profiler_.frame_times_ms();
+    if (!frame_times.empty()) {
+        float scale = std::max(33.4f, to_ms(profiler_.max_frame_time()));
+        ImGui::PlotLines("##FrameTimes", frame_times.data(), static_cast<int>(frame_times.size()), 0, nullptr, 0.0f,
+                         scale, ImVec2(-1.0f, 60.0f));
+    }
+    
+    FrameProfiler::Histogram histogram = profiler_.frame_histogram();
+    for (size_t bucket = 0; bucket < FrameProfiler::Histogram::BUCKETS; ++bucket) {
+        size_t count = histogram.counts[bucket];
+        float fraction = frame_times.empty() ? 0.0f : static_cast<float>(count) / static_cast<float>(frame_times.size());
+        char overlay[32];
+        std::snprintf(overlay, sizeof(overlay), "%zu", count);
+        ImGui::ProgressBar(fraction, ImVec2(-120.0f, 0.0f), overlay);
+        ImGui::SameLine();
+        ImGui::TextUnformatted(FrameProfiler::Histogram::label(bucket).c_str());
+    }
+    
+    const FrameProfiler::DrawStats& draw = profiler_.draw_stats();
+    ImGui::Separator();
+    ImGui::Text("Draw lists %zu, draw calls %zu, vertices %zu, indices %zu", draw.draw_lists, draw.draw_calls,
+                draw.vertices, draw.indices);
+    
+    // Sections: "Application" is the loop itself, the rest are layers and what they time
+    ImGui::Separator();
+    ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_ScrollY;
+    if (ImGui::BeginTable("ProfilerSections", 5, flags)) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Group", ImGuiTableColumnFlags_WidthFixed, 90.0f);
+        ImGui::TableSetupColumn("Section", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("Last ms", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+        ImGui::TableSetupColumn("Avg ms", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+        ImGui::TableSetupColumn("Max ms", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+        ImGui::TableHeadersRow();
+        for (const FrameProfiler::SectionStats& section : profiler_.section_stats()) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(section.group.c_str());
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(section.name.c_str());
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", to_ms(section.last));
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", to_ms(section.average));
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", to_ms(section.max));
+        }
+        ImGui::EndTable();
+    }
+    ImGui::End();
+    
+    // Closed with the window's button
+    if (!profiler_overlay_visible_) {
+        profiler_.set_enabled(false);
+    }
+}
+
 } // namespace wip::gui::application
\ No newline at end of file
@@ -0,0 +1,236 @@
+#include "font_atlas_cache.h"
+
+#include <async_file_writer.h>
+#include <hash.h>
+#include <mapped_file.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <system_error>
+#include <type_traits>
+
+namespace wip::gui::application {
+
+namespace {
+
+// Bumped whenever the layout below changes; old files then fail to load
+constexpr char MAGIC[8] = {'W', 'I', 'P', 'F', 'O', 'N', 'T', '1'};
+
+static_assert(std::is_trivially_copyable_v<BakedGlyph>, "glyphs are stored as raw bytes");
+static_assert(sizeof(BakedGlyph) == 10 * sizeof(float), "glyphs must have no padding");
+
+// Values are stored in the byte order of the machine; the cache never leaves it
+class Writer {
+public:
+    template <typename T>
+    void put(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        bytes(&value, sizeof(T));
+    }
+
+    void bytes(const void* data, size_t size) {
+        if (size == 0) {
+            return;
+        }
+        buffer_.append(static_cast<const char*>(data), size);
+    }
+
+    std::string& buffer() noexcept { return buffer_; }
+
+private:
+    std::string buffer_;
+};
+
+// Reads fail once instead of at every field; callers check ok() at the end
+class Reader {
+public:
+    explicit Reader(std::string_view data) : data_(data) {}
+
+    template <typename T>
+    T get() {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T value{};
+        bytes(&value, sizeof(T));
+        return value;
+    }
+
+    void bytes(void* out, size_t size) {
+        if (!ok_ || data_.size() - offset_ < size) {
+            ok_ = false;
+            return;
+        }
+        if (size == 0) {
+            return;
+        }
+        std::memcpy(out, data_.data() + offset_, size);
+        offset_ += size;
+    }
+
+    // Element counts are checked against the bytes left before anything is allocated
+    bool has(uint64_t count, size_t element_size) {
+        ok_ = ok_ && count <= (data_.size() - offset_) / element_size;
+        return ok_;
+    }
+
+    bool ok() const noexcept { return ok_; }
+    bool at_end() const noexcept { return offset_ == data_.size(); }
+
+private:
+    std::string_view data_;
+    size_t offset_ = 0;
+    bool ok_ = true;
+};
+
+} // namespace
+
+std::string font_atlas_cache_key(const std::vector<FontSpec>& fonts, float dpi_scale, std::string_view builder) {
+    wip::utils::hash::Hasher hasher;
+    hasher.update(MAGIC, sizeof(MAGIC));
+    hasher.update(builder);
+    hasher.update(&dpi_scale, sizeof(dpi_scale));
+
+    for (const FontSpec& font : fonts) {
+        uint64_t path_size = font.path.size();
+        hasher.update(&path_size, sizeof(path_size));
+        hasher.update(font.path);
+        hasher.update(&font.size_pixels, sizeof(font.size_pixels));
+
+        auto content = wip::utils::hash::hash_file(font.path);
+        unsigned char found = content.has_value();
+        hasher.update(&found, sizeof(found));
+        if (content) {
+            hasher.update(&content->low, sizeof(content->low));
+            hasher.update(&content->high, sizeof(content->high));
+        }
+    }
+    return hasher.digest128().to_hex();
+}
+
+FontAtlasCache::FontAtlasCache(std::filesystem::path directory) : directory_(std::move(directory)) {}
+
+std::filesystem::path FontAtlasCache::default_directory(std::string_view application) {
+    std::filesystem::path cache_directory;
+    if (const char* xdg_cache = std::getenv("XDG_CACHE_HOME"); xdg_cache && *xdg_cache) {
+        cache_directory = xdg_cache;
+    } else if (const char* home = std::getenv("HOME"); home && *home) {
+        cache_directory = std::filesystem::path(home) / ".cache";
+    } else {
+        return {};
+    }
+    return cache_directory / std::string(application) / "fonts";
+}
+
+std::filesystem::path FontAtlasCache::path_for(const std::string& key) const {
+    return directory_ / ("atlas-" + key + ".bin");
+}
+
+std::optional<BakedFontAtlas> FontAtlasCache::load(const std::string& key) const {
+    if (directory_.empty()) {
+        return std::nullopt;
+    }
+    auto file = wip::utils::file::MappedFile::open(path_for(key));
+    if (!file) {
+        return std::nullopt;
+    }
+
+    Reader reader(file->view());
+    char magic[sizeof(MAGIC)];
+    reader.bytes(magic, sizeof(magic));
+    if (!reader.ok() || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+        return std::nullopt;
+    }
+
+    // Keys are derived from a hash, so a file renamed or copied by hand is caught here
+    auto key_size = reader.get<uint32_t>();
+    std::string stored_key(reader.has(key_size, 1) ? key_size : 0, '\0');
+    reader.bytes(stored_key.data(), stored_key.size());
+    if (!reader.ok() || stored_key != key) {
+        return std::nullopt;
+    }
+
+    BakedFontAtlas atlas;
+    atlas.width = reader.get<uint32_t>();
+    atlas.height = reader.get<uint32_t>();
+    atlas.white_pixel_uv = reader.get<std::array<float, 2>>();
+
+    auto line_count = reader.get<uint32_t>();
+    if (reader.has(line_count, sizeof(std::array<float, 4>))) {
+        atlas.line_uvs.resize(line_count);
+        reader.bytes(atlas.line_uvs.data(), line_count * sizeof(std::array<float, 4>));
+    }
+
+    auto font_count = reader.get<uint32_t>();
+    if (reader.has(font_count, sizeof(BakedFont::source) + 3 * sizeof(float) + sizeof(uint32_t))) {
+        atlas.fonts.resize(font_count);
+    }
+    for (BakedFont& font : atlas.fonts) {
+        font.source = reader.get<int32_t>();
+        font.size = reader.get<float>();
+        font.ascent = reader.get<float>();
+        font.descent = reader.get<float>();
+        auto glyph_count = reader.get<uint32_t>();
+        if (!reader.has(glyph_count, sizeof(BakedGlyph))) {
+            return std::nullopt;
+        }
+        font.glyphs.resize(glyph_count);
+        reader.bytes(font.glyphs.data(), glyph_count * sizeof(BakedGlyph));
+    }
+
+    auto pixel_count = reader.get<uint64_t>();
+    if (!reader.ok() || pixel_count != uint64_t{atlas.width} * atlas.height || !reader.has(pixel_count, 1)) {
+        return std::nullopt;
+    }
+    atlas.pixels.resize(pixel_count);
+    reader.bytes(atlas.pixels.data(), atlas.pixels.size());
+
+    if (!reader.ok() || !reader.at_end()) {
+        return std::nullopt;
+    }
+    return atlas;
+}
+
+bool FontAtlasCache::save(const std::string& key, const BakedFontAtlas& atlas) const {
+    if (directory_.empty() || atlas.pixels.size() != size_t{atlas.width} * atlas.height) {
+        return false;
+    }
+
+    Writer writer;
+    size_t glyph_count = 0;
+    for (const BakedFont& font : atlas.fonts) {
+        glyph_count += font.glyphs.size();
+    }
+    writer.buffer().reserve(256 + key.size() + glyph_count * sizeof(BakedGlyph) + atlas.pixels.size());
+
+    writer.bytes(MAGIC, sizeof(MAGIC));
+    writer.put(static_cast<uint32_t>(key.size()));
+    writer.bytes(key.data(), key.size());
+
+    writer.put(atlas.width);
+    writer.put(atlas.height);
+    writer.put(atlas.white_pixel_uv);
+    writer.put(static_cast<uint32_t>(atlas.line_uvs.size()));
+    writer.bytes(atlas.line_uvs.data(), atlas.line_uvs.size() * sizeof(std::array<float, 4>));
+
+    writer.put(static_cast<uint32_t>(atlas.fonts.size()));
+    for (const BakedFont& font : atlas.fonts) {
+        writer.put(font.source);
+        writer.put(font.size);
+        writer.put(font.ascent);
+        writer.put(font.descent);
+        writer.put(static_cast<uint32_t>(font.glyphs.size()));
+        writer.bytes(font.glyphs.data(), font.glyphs.size() * sizeof(BakedGlyph));
+    }
+
+    writer.put(static_cast<uint64_t>(atlas.pixels.size()));
+    writer.bytes(atlas.pixels.data(), atlas.pixels.size());
+
+    std::error_code error;
+    std::filesystem::create_directories(directory_, error);
+    if (error) {
+        return false;
+    }
+    // A lost write only costs one more rasterization, so skip the flush
+    return wip::utils::file::write_file_atomic(path_for(key), writer.buffer(), false);
+}
+
+} // namespace wip::gui::application
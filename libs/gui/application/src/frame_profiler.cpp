@@ -0,0 +1,155 @@
+#include "frame_profiler.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace wip::gui::application {
+
+std::string FrameProfiler::Histogram::label(size_t bucket) {
+    char text[32];
+    if (bucket == 0) {
+        std::snprintf(text, sizeof(text), "< %.1f ms", UPPER_MS[0]);
+    } else if (bucket < UPPER_MS.size()) {
+        std::snprintf(text, sizeof(text), "%.1f-%.1f ms", UPPER_MS[bucket - 1], UPPER_MS[bucket]);
+    } else {
+        std::snprintf(text, sizeof(text), "> %.0f ms", UPPER_MS.back());
+    }
+    return text;
+}
+
+FrameProfiler::Scope::Scope(FrameProfiler* profiler, std::string_view name, std::string_view group) noexcept
+    : profiler_(profiler && profiler->is_enabled() ? profiler : nullptr), name_(name), group_(group) {
+    if (profiler_) {
+        start_ = Clock::now();
+    }
+}
+
+FrameProfiler::Scope::~Scope() {
+    if (profiler_) {
+        profiler_->add(name_, group_, Clock::now() - start_);
+    }
+}
+
+void FrameProfiler::set_enabled(bool enabled) {
+    if (enabled && !enabled_) {
+        reset();
+    }
+    enabled_ = enabled;
+}
+
+void FrameProfiler::add(std::string_view name, std::string_view group, Duration time) {
+    if (!enabled_) {
+        return;
+    }
+    // A frame has a few dozen sections at most, so a linear search beats hashing the names
+    for (Section& section : sections_) {
+        if (section.name == name && section.group == group) {
+            section.current += time;
+            return;
+        }
+    }
+    Section& section = sections_.emplace_back();
+    section.group = group;
+    section.name = name;
+    section.current = time;
+}
+
+void FrameProfiler::set_draw_stats(const DrawStats& stats) noexcept {
+    draw_stats_ = stats;
+}
+
+void FrameProfiler::end_frame(Duration frame_time) {
+    if (!enabled_) {
+        return;
+    }
+    const size_t index = frames_ % HISTORY_FRAMES;
+    frame_times_[index] = frame_time;
+    for (Section& section : sections_) {
+        section.history[index] = section.current;
+        section.current = Duration::zero();
+    }
+    last_draw_stats_ = draw_stats_;
+    draw_stats_ = DrawStats();
+    ++frames_;
+}
+
+void FrameProfiler::reset() {
+    sections_.clear();
+    frame_times_.fill(Duration::zero());
+    frames_ = 0;
+    draw_stats_ = DrawStats();
+    last_draw_stats_ = DrawStats();
+}
+
+size_t FrameProfiler::frame_count() const noexcept {
+    return static_cast<size_t>(std::min<uint64_t>(frames_, HISTORY_FRAMES));
+}
+
+size_t FrameProfiler::slot(size_t frame) const noexcept {
+    const size_t first = frames_ > HISTORY_FRAMES ? static_cast<size_t>(frames_ % HISTORY_FRAMES) : 0;
+    return (first + frame) % HISTORY_FRAMES;
+}
+
+std::vector<FrameProfiler::SectionStats> FrameProfiler::section_stats() const {
+    const size_t count = frame_count();
+    std::vector<SectionStats> stats;
+    stats.reserve(sections_.size());
+    for (const Section& section : sections_) {
+        SectionStats& out = stats.emplace_back();
+        out.group = section.group;
+        out.name = section.name;
+        if (count == 0) {
+            continue;
+        }
+        Duration total{};
+        for (size_t frame = 0; frame < count; ++frame) {
+            Duration time = section.history[slot(frame)];
+            total += time;
+            out.max = std::max(out.max, time);
+        }
+        out.last = section.history[slot(count - 1)];
+        out.average = total / static_cast<Duration::rep>(count);
+    }
+    return stats;
+}
+
+std::vector<float> FrameProfiler::frame_times_ms() const {
+    const size_t count = frame_count();
+    std::vector<float> times;
+    times.reserve(count);
+    for (size_t frame = 0; frame < count; ++frame) {
+        times.push_back(std::chrono::duration<float, std::milli>(frame_times_[slot(frame)]).count());
+    }
+    return times;
+}
+
+FrameProfiler::Histogram FrameProfiler::frame_histogram() const {
+    Histogram histogram;
+    for (float time : frame_times_ms()) {
+        auto upper = std::upper_bound(Histogram::UPPER_MS.begin(), Histogram::UPPER_MS.end(), time);
+        ++histogram.counts[static_cast<size_t>(upper - Histogram::UPPER_MS.begin())];
+    }
+    return histogram;
+}
+
+FrameProfiler::Duration FrameProfiler::average_frame_time() const {
+    const size_t count = frame_count();
+    if (count == 0) {
+        return Duration::zero();
+    }
+    Duration total{};
+    for (size_t frame = 0; frame < count; ++frame) {
+        total += frame_times_[slot(frame)];
+    }
+    return total / static_cast<Duration::rep>(count);
+}
+
+FrameProfiler::Duration FrameProfiler::max_frame_time() const {
+    Duration max{};
+    for (size_t frame = 0; frame < frame_count(); ++frame) {
+        max = std::max(max, frame_times_[slot(frame)]);
+    }
+    return max;
+}
+
+} // namespace wip::gui::application
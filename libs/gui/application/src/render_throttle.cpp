@@ -0,0 +1,37 @@
+#include "render_throttle.h"
+
+namespace wip::gui::application {
+
+RenderThrottle::RenderThrottle(float unfocused_fps) {
+    set_unfocused_fps(unfocused_fps);
+}
+
+void RenderThrottle::set_unfocused_fps(float fps) {
+    unfocused_interval_ = fps > 0.0f
+        ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(1.0f / fps))
+        : Clock::duration::zero();
+}
+
+bool RenderThrottle::should_render(bool visible, bool focused, Clock::time_point now) const {
+    if (!visible) {
+        return false;
+    }
+    if (focused || dirty_) {
+        return true;
+    }
+    return now >= next_due();
+}
+
+void RenderThrottle::rendered(Clock::time_point now) noexcept {
+    last_render_ = now;
+    dirty_ = false;
+}
+
+RenderThrottle::Clock::time_point RenderThrottle::next_due() const {
+    if (unfocused_interval_ == Clock::duration::zero()) {
+        return Clock::time_point::max();
+    }
+    return last_render_ + unfocused_interval_;
+}
+
+} // namespace wip::gui::application
@@ -1,7 +1,9 @@
 #include <gtest/gtest.h>
 #include "application.h"
 #include "layer.h"
+#include <common_events.h>
 #include <set>
+#include <thread>
 
 using namespace wip::gui::application;
 
@@ -160,6 +162,40 @@ TEST_F(ApplicationTest, WindowConfigInheritance) {
     EXPECT_EQ(app_config.default_window_config.title, "Default Title");
 }
 
+TEST_F(ApplicationTest, ProcessQueuedEvents) {
+    Application app;
+    auto* dispatcher = app.get_event_dispatcher();
+    
+    int received = 0;
+    dispatcher->subscribe<wip::utils::event::MessageEvent>(
+        [&received](const wip::utils::event::MessageEvent&) { received++; });
+    
+    dispatcher->enqueue(wip::utils::event::MessageEvent("first"));
+    dispatcher->enqueue(wip::utils::event::MessageEvent("second"));
+    EXPECT_EQ(received, 0);
+    
+    EXPECT_EQ(app.process_queued_events(), 2);
+    EXPECT_EQ(received, 2);
+}
+
+TEST_F(ApplicationTest, UiExecutorRunsHandlersPerFrame) {
+    Application app;
+    auto* dispatcher = app.get_event_dispatcher();
+    
+    std::thread::id handler_thread;
+    dispatcher->subscribe_on<wip::utils::event::MessageEvent>(app.get_ui_executor(),
+        [&handler_thread](const wip::utils::event::MessageEvent&) { handler_thread = std::this_thread::get_id(); });
+    
+    std::thread worker([dispatcher]() {
+        dispatcher->dispatch(wip::utils::event::MessageEvent("from worker"));
+    });
+    worker.join();
+    EXPECT_EQ(handler_thread, std::thread::id());
+    
+    EXPECT_EQ(app.process_queued_events(), 1);
+    EXPECT_EQ(handler_thread, std::this_thread::get_id());
+}
+
 // Test edge cases
 TEST_F(ApplicationTest, MultipleQuitCalls) {
     Application app;
@@ -375,6 +411,97 @@ TEST_F(LayerTest, ApplicationFPSControl) {
     app.set_target_fps(0.0f);   // Unlimited
 }
 
+TEST_F(ApplicationTest, OnDemandRendering) {
+    ApplicationConfig config;
+    EXPECT_FALSE(config.on_demand_rendering);
+    EXPECT_GT(config.idle_timeout_ms, 0.0f);
+    
+    Application app(config);
+    app.set_on_demand_rendering(true);
+    EXPECT_TRUE(app.is_on_demand_rendering());
+    
+    // Wake-ups from other threads are safe without any window
+    std::thread worker([&app]() {
+        app.request_frame();
+        app.get_event_dispatcher()->enqueue(wip::utils::event::MessageEvent("progress"));
+        app.get_ui_executor().post([]() {});
+    });
+    worker.join();
+    
+    EXPECT_EQ(app.process_queued_events(), 2);
+}
+
+TEST_F(ApplicationTest, BackgroundThrottlingConfig) {
+    ApplicationConfig config;
+    EXPECT_TRUE(config.throttle_background_windows);
+    EXPECT_GT(config.unfocused_fps, 0.0f);
+    
+    Application app(config);
+    app.set_background_throttling(false);
+    EXPECT_FALSE(app.get_config().throttle_background_windows);
+    app.set_unfocused_fps(2.0f);
+    EXPECT_EQ(app.get_config().unfocused_fps, 2.0f);
+}
+
+TEST_F(ApplicationTest, ProfilerOverlayRecordsWhileVisible) {
+    Application app;
+    EXPECT_EQ(app.get_config().profiler_overlay_key, GLFW_KEY_F12);
+    EXPECT_FALSE(app.is_profiler_overlay_visible());
+    EXPECT_FALSE(app.get_profiler().is_enabled());
+    
+    app.set_profiler_overlay_visible(true);
+    EXPECT_TRUE(app.is_profiler_overlay_visible());
+    EXPECT_TRUE(app.get_profiler().is_enabled());
+    
+    app.set_profiler_overlay_visible(false);
+    EXPECT_FALSE(app.get_profiler().is_enabled());
+}
+
+// Test render throttling decisions
+TEST_F(ApplicationTest, RenderThrottleSkipsHiddenWindows) {
+    RenderThrottle throttle;
+    auto now = RenderThrottle::Clock::now();
+    
+    EXPECT_TRUE(throttle.is_dirty());
+    EXPECT_FALSE(throttle.should_render(false, true, now));
+    EXPECT_TRUE(throttle.should_render(true, true, now));
+}
+
+TEST_F(ApplicationTest, RenderThrottleDrawsFocusedWindowEveryFrame) {
+    RenderThrottle throttle;
+    auto now = RenderThrottle::Clock::now();
+    throttle.rendered(now);
+    
+    EXPECT_FALSE(throttle.is_dirty());
+    EXPECT_TRUE(throttle.should_render(true, true, now));
+}
+
+TEST_F(ApplicationTest, RenderThrottleSlowsUnfocusedWindows) {
+    RenderThrottle throttle(10.0f);
+    auto now = RenderThrottle::Clock::now();
+    throttle.rendered(now);
+    
+    // Unchanged: due once per interval
+    EXPECT_FALSE(throttle.should_render(true, false, now + std::chrono::milliseconds(50)));
+    EXPECT_TRUE(throttle.should_render(true, false, now + std::chrono::milliseconds(100)));
+    EXPECT_EQ(throttle.next_due(), now + std::chrono::milliseconds(100));
+    
+    // Changed: due right away
+    throttle.mark_dirty();
+    EXPECT_TRUE(throttle.should_render(true, false, now + std::chrono::milliseconds(1)));
+}
+
+TEST_F(ApplicationTest, RenderThrottleWithoutUnfocusedRate) {
+    RenderThrottle throttle(0.0f);
+    auto now = RenderThrottle::Clock::now();
+    throttle.rendered(now);
+    
+    EXPECT_EQ(throttle.next_due(), RenderThrottle::Clock::time_point::max());
+    EXPECT_FALSE(throttle.should_render(true, false, now + std::chrono::hours(1)));
+    throttle.mark_dirty();
+    EXPECT_TRUE(throttle.should_render(true, false, now));
+}
+
 // Integration test for Layer lifecycle
 class LayerIntegrationTest : public ::testing::Test {
 protected:
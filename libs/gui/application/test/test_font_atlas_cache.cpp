@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+#include "font_atlas_cache.h"
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+
+using namespace wip::gui::application;
+
+class FontAtlasCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        directory_ = std::filesystem::temp_directory_path() /
+                     ("test_font_atlas_cache_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) +
+                      "_" + ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        std::filesystem::remove_all(directory_);
+        std::filesystem::create_directories(directory_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory_);
+    }
+
+    std::string write_font(const std::string& name, const std::string& content) {
+        auto path = directory_ / name;
+        std::ofstream(path, std::ios::binary) << content;
+        return path.string();
+    }
+
+    static BakedFontAtlas make_atlas() {
+        BakedFontAtlas atlas;
+        atlas.width = 8;
+        atlas.height = 4;
+        for (uint32_t i = 0; i < atlas.width * atlas.height; ++i) {
+            atlas.pixels.push_back(static_cast<uint8_t>(i * 7));
+        }
+        atlas.white_pixel_uv = {0.0625f, 0.125f};
+        atlas.line_uvs = {{0.0f, 0.0f, 0.5f, 0.25f}, {0.5f, 0.25f, 1.0f, 0.5f}};
+
+        BakedFont builtin;
+        builtin.size = 13.0f;
+        builtin.ascent = 11.0f;
+        builtin.descent = -2.0f;
+        builtin.glyphs.push_back({'A', 7.0f, 0.0f, 1.0f, 6.0f, 12.0f, 0.0f, 0.0f, 0.25f, 0.5f});
+        atlas.fonts.push_back(builtin);
+
+        BakedFont regular;
+        regular.source = 0;
+        regular.size = 16.0f;
+        regular.ascent = 15.0f;
+        regular.descent = -4.0f;
+        regular.glyphs.push_back({' ', 4.0f});
+        regular.glyphs.push_back({0x263A, 12.0f, 1.0f, 2.0f, 11.0f, 14.0f, 0.25f, 0.5f, 0.75f, 1.0f});
+        atlas.fonts.push_back(regular);
+        return atlas;
+    }
+
+    std::filesystem::path directory_;
+};
+
+TEST_F(FontAtlasCacheTest, SaveAndLoad) {
+    FontAtlasCache cache(directory_ / "cache");
+    BakedFontAtlas atlas = make_atlas();
+    ASSERT_TRUE(cache.save("key", atlas));
+
+    auto loaded = cache.load("key");
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(loaded->width, atlas.width);
+    EXPECT_EQ(loaded->height, atlas.height);
+    EXPECT_EQ(loaded->pixels, atlas.pixels);
+    EXPECT_EQ(loaded->white_pixel_uv, atlas.white_pixel_uv);
+    EXPECT_EQ(loaded->line_uvs, atlas.line_uvs);
+    ASSERT_EQ(loaded->fonts.size(), 2u);
+    EXPECT_EQ(loaded->fonts[0].source, -1);
+    EXPECT_EQ(loaded->fonts[1].source, 0);
+    EXPECT_FLOAT_EQ(loaded->fonts[1].size, 16.0f);
+    EXPECT_FLOAT_EQ(loaded->fonts[1].ascent, 15.0f);
+    EXPECT_FLOAT_EQ(loaded->fonts[1].descent, -4.0f);
+    ASSERT_EQ(loaded->fonts[1].glyphs.size(), 2u);
+    EXPECT_EQ(loaded->fonts[1].glyphs[1].codepoint, 0x263Au);
+    EXPECT_FLOAT_EQ(loaded->fonts[1].glyphs[1].advance_x, 12.0f);
+    EXPECT_FLOAT_EQ(loaded->fonts[1].glyphs[1].v1, 1.0f);
+}
+
+TEST_F(FontAtlasCacheTest, MissingKeyAndDirectory) {
+    FontAtlasCache cache(directory_ / "cache");
+    EXPECT_FALSE(cache.load("key").has_value());
+
+    ASSERT_TRUE(cache.save("key", make_atlas()));
+    EXPECT_FALSE(cache.load("other").has_value());
+
+    FontAtlasCache disabled{std::filesystem::path()};
+    EXPECT_FALSE(disabled.save("key", make_atlas()));
+    EXPECT_FALSE(disabled.load("key").has_value());
+}
+
+TEST_F(FontAtlasCacheTest, RejectsFileOfAnotherKey) {
+    FontAtlasCache cache(directory_);
+    ASSERT_TRUE(cache.save("first", make_atlas()));
+    std::filesystem::copy_file(cache.path_for("first"), cache.path_for("second"));
+
+    EXPECT_TRUE(cache.load("first").has_value());
+    EXPECT_FALSE(cache.load("second").has_value());
+}
+
+TEST_F(FontAtlasCacheTest, RejectsTruncatedAndCorruptFiles) {
+    FontAtlasCache cache(directory_);
+    ASSERT_TRUE(cache.save("key", make_atlas()));
+    auto path = cache.path_for("key");
+    const auto size = std::filesystem::file_size(path);
+
+    // Every prefix of the file is invalid
+    for (uintmax_t length = 0; length < size; ++length) {
+        ASSERT_TRUE(cache.save("key", make_atlas()));
+        std::filesystem::resize_file(path, length);
+        EXPECT_FALSE(cache.load("key").has_value()) << "length " << length;
+    }
+
+    ASSERT_TRUE(cache.save("key", make_atlas()));
+    std::ofstream(path, std::ios::binary | std::ios::app) << "trailing";
+    EXPECT_FALSE(cache.load("key").has_value());
+
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << "not an atlas at all";
+    EXPECT_FALSE(cache.load("key").has_value());
+}
+
+TEST_F(FontAtlasCacheTest, RejectsInconsistentAtlas) {
+    FontAtlasCache cache(directory_);
+    BakedFontAtlas atlas = make_atlas();
+    atlas.pixels.pop_back();
+    EXPECT_FALSE(cache.save("key", atlas));
+    EXPECT_FALSE(std::filesystem::exists(cache.path_for("key")));
+}
+
+TEST_F(FontAtlasCacheTest, KeyCoversFontsSizesAndScale) {
+    std::string regular = write_font("regular.ttf", "regular outlines");
+    std::string bold = write_font("bold.ttf", "bold outlines");
+    std::vector<FontSpec> fonts = {{regular, 16.0f}, {bold, 16.0f}};
+
+    std::string key = font_atlas_cache_key(fonts, 1.0f, "builder 1");
+    EXPECT_EQ(key.size(), 32u);
+    EXPECT_EQ(key, font_atlas_cache_key(fonts, 1.0f, "builder 1"));
+
+    EXPECT_NE(key, font_atlas_cache_key(fonts, 2.0f, "builder 1"));
+    EXPECT_NE(key, font_atlas_cache_key(fonts, 1.0f, "builder 2"));
+    EXPECT_NE(key, font_atlas_cache_key({{regular, 18.0f}, {bold, 16.0f}}, 1.0f, "builder 1"));
+    EXPECT_NE(key, font_atlas_cache_key({{bold, 16.0f}, {regular, 16.0f}}, 1.0f, "builder 1"));
+    EXPECT_NE(key, font_atlas_cache_key({{regular, 16.0f}}, 1.0f, "builder 1"));
+
+    // Editing a font file selects another atlas
+    write_font("bold.ttf", "bold outlines, hinted");
+    EXPECT_NE(key, font_atlas_cache_key(fonts, 1.0f, "builder 1"));
+
+    std::filesystem::remove(bold);
+    std::string missing = font_atlas_cache_key(fonts, 1.0f, "builder 1");
+    EXPECT_NE(key, missing);
+    EXPECT_EQ(missing, font_atlas_cache_key(fonts, 1.0f, "builder 1"));
+}
+
+TEST_F(FontAtlasCacheTest, DefaultDirectory) {
+    const char* previous = std::getenv("XDG_CACHE_HOME");
+    std::string saved = previous ? previous : "";
+
+    setenv("XDG_CACHE_HOME", directory_.c_str(), 1);
+    EXPECT_EQ(FontAtlasCache::default_directory("app"), directory_ / "app" / "fonts");
+
+    if (previous) {
+        setenv("XDG_CACHE_HOME", saved.c_str(), 1);
+    } else {
+        unsetenv("XDG_CACHE_HOME");
+    }
+}
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include "frame_profiler.h"
+#include <thread>
+
+using namespace wip::gui::application;
+using namespace std::chrono_literals;
+
+TEST(FrameProfilerTest, DisabledRecordsNothing) {
+    FrameProfiler profiler;
+    EXPECT_FALSE(profiler.is_enabled());
+
+    {
+        FrameProfiler::Scope scope(&profiler, "Layer", "Update");
+    }
+    profiler.add("Swap", "Application", 1ms);
+    profiler.end_frame(16ms);
+
+    EXPECT_EQ(profiler.frame_count(), 0u);
+    EXPECT_TRUE(profiler.section_stats().empty());
+
+    // A null profiler is allowed, for code that may run without one
+    FrameProfiler::Scope scope(nullptr, "Panel");
+}
+
+TEST(FrameProfilerTest, SumsSectionsPerFrame) {
+    FrameProfiler profiler;
+    profiler.set_enabled(true);
+
+    profiler.add("Results", "Panel", 2ms);
+    profiler.add("Results", "Panel", 3ms);
+    profiler.add("Main", "Render", 10ms);
+    profiler.end_frame(16ms);
+
+    profiler.add("Results", "Panel", 1ms);
+    profiler.end_frame(8ms);
+
+    auto stats = profiler.section_stats();
+    ASSERT_EQ(stats.size(), 2u);
+    EXPECT_EQ(stats[0].group, "Panel");
+    EXPECT_EQ(stats[0].name, "Results");
+    EXPECT_EQ(stats[0].last, 1ms);
+    EXPECT_EQ(stats[0].max, 5ms);
+    EXPECT_EQ(stats[0].average, 3ms);
+
+    EXPECT_EQ(stats[1].name, "Main");
+    EXPECT_EQ(stats[1].last, 0ms);
+    EXPECT_EQ(stats[1].max, 10ms);
+    EXPECT_EQ(stats[1].average, 5ms);
+
+    EXPECT_EQ(profiler.frame_count(), 2u);
+    EXPECT_EQ(profiler.average_frame_time(), 12ms);
+    EXPECT_EQ(profiler.max_frame_time(), 16ms);
+}
+
+TEST(FrameProfilerTest, SectionsAreKeyedByGroupAndName) {
+    FrameProfiler profiler;
+    profiler.set_enabled(true);
+    profiler.add("Main", "Update", 1ms);
+    profiler.add("Main", "Render", 2ms);
+    profiler.end_frame(3ms);
+
+    auto stats = profiler.section_stats();
+    ASSERT_EQ(stats.size(), 2u);
+    EXPECT_EQ(stats[0].last, 1ms);
+    EXPECT_EQ(stats[1].last, 2ms);
+}
+
+TEST(FrameProfilerTest, KeepsTheLastFrames) {
+    FrameProfiler profiler;
+    profiler.set_enabled(true);
+
+    const size_t frames = FrameProfiler::HISTORY_FRAMES + 10;
+    for (size_t i = 0; i < frames; ++i) {
+        profiler.add("Layer", "Update", std::chrono::milliseconds(i));
+        profiler.end_frame(std::chrono::milliseconds(i));
+    }
+
+    EXPECT_EQ(profiler.frame_count(), FrameProfiler::HISTORY_FRAMES);
+    auto times = profiler.frame_times_ms();
+    ASSERT_EQ(times.size(), FrameProfiler::HISTORY_FRAMES);
+    EXPECT_FLOAT_EQ(times.front(), 10.0f);
+    EXPECT_FLOAT_EQ(times.back(), static_cast<float>(frames - 1));
+
+    auto stats = profiler.section_stats();
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_EQ(stats[0].last, std::chrono::milliseconds(frames - 1));
+    EXPECT_EQ(stats[0].max, std::chrono::milliseconds(frames - 1));
+    EXPECT_EQ(profiler.max_frame_time(), std::chrono::milliseconds(frames - 1));
+}
+
+TEST(FrameProfilerTest, FrameHistogram) {
+    FrameProfiler profiler;
+    profiler.set_enabled(true);
+    for (auto time : {4ms, 7ms, 16ms, 17ms, 40ms, 70ms, 250ms}) {
+        profiler.end_frame(time);
+    }
+
+    auto histogram = profiler.frame_histogram();
+    EXPECT_EQ(histogram.counts[0], 2u);
+    EXPECT_EQ(histogram.counts[1], 1u);
+    EXPECT_EQ(histogram.counts[2], 1u);
+    EXPECT_EQ(histogram.counts[3], 1u);
+    EXPECT_EQ(histogram.counts[4], 1u);
+    EXPECT_EQ(histogram.counts[5], 1u);
+
+    EXPECT_EQ(FrameProfiler::Histogram::label(0), "< 8.3 ms");
+    EXPECT_EQ(FrameProfiler::Histogram::label(2), "16.7-33.3 ms");
+    EXPECT_EQ(FrameProfiler::Histogram::label(5), "> 100 ms");
+}
+
+TEST(FrameProfilerTest, DrawStatsOfLastFrame) {
+    FrameProfiler profiler;
+    profiler.set_enabled(true);
+    profiler.set_draw_stats({2, 40, 9000, 12000});
+    EXPECT_EQ(profiler.draw_stats().draw_calls, 0u);
+
+    profiler.end_frame(16ms);
+    EXPECT_EQ(profiler.draw_stats().draw_lists, 2u);
+    EXPECT_EQ(profiler.draw_stats().draw_calls, 40u);
+    EXPECT_EQ(profiler.draw_stats().vertices, 9000u);
+    EXPECT_EQ(profiler.draw_stats().indices, 12000u);
+
+    // A frame that drew nothing reports nothing
+    profiler.end_frame(16ms);
+    EXPECT_EQ(profiler.draw_stats().draw_calls, 0u);
+}
+
+TEST(FrameProfilerTest, ScopeMeasuresTime) {
+    FrameProfiler profiler;
+    profiler.set_enabled(true);
+    {
+        FrameProfiler::Scope scope(&profiler, "Sleep", "Test");
+        std::this_thread::sleep_for(2ms);
+    }
+    profiler.end_frame(2ms);
+
+    auto stats = profiler.section_stats();
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_GE(stats[0].last, 2ms);
+}
+
+TEST(FrameProfilerTest, EnablingStartsOver) {
+    FrameProfiler profiler;
+    profiler.set_enabled(true);
+    profiler.add("Layer", "Update", 1ms);
+    profiler.end_frame(1ms);
+
+    profiler.set_enabled(false);
+    profiler.set_enabled(true);
+    EXPECT_EQ(profiler.frame_count(), 0u);
+    EXPECT_TRUE(profiler.section_stats().empty());
+}
@@ -0,0 +1,95 @@
+// Benchmark for streaming tool output into a bounded text view.
+//
+// Appends lines of compiler-like output to a view limited to the last MiB,
+// once the way the progress dialog kept it before, as one string whose front
+// was cut off, about 1000 bytes at a time, whenever it grew past the limit,
+// and once into a TextBuffer, which drops the oldest lines in O(1). A frame
+// of each view is timed too: splitting the whole string into lines, against
+// fetching the 40 lines in sight from the line index. Reports nanoseconds
+// per line, and per frame. Usage:
+//
+//   bench_wip_gui_text_buffer [line-count]
+
+#include "benchmark.h"
+#include "text_buffer.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace wip::gui::widgets;
+
+namespace {
+
+constexpr size_t OUTPUT_LIMIT = 1024 * 1024;
+constexpr size_t VISIBLE_LINES = 40;
+
+std::vector<std::string> generate_lines(size_t count) {
+    std::vector<std::string> lines;
+    lines.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        lines.push_back("/home/user/project/src/module_" + std::to_string(i % 97) + "/file_" + std::to_string(i % 2000) +
+                        ".cpp:" + std::to_string(i % 900 + 1) + ":12: warning: unused variable 'value" +
+                        std::to_string(i % 5000) + "' [-Wunused-variable]");
+    }
+    return lines;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    wip::benchmark::Runner runner("bench_wip_gui_text_buffer", argc, argv, "[line-count]");
+    size_t line_count = runner.argument(0, 50000);
+    auto lines = generate_lines(line_count);
+    runner.out() << line_count << " lines, views limited to " << OUTPUT_LIMIT / 1024 << " KiB" << std::endl;
+
+    std::string flat;
+    runner.measure("string, trimmed at the front", line_count, [&]() {
+        flat.clear();
+        for (const auto& line : lines) {
+            if (!flat.empty()) {
+                flat += '\n';
+            }
+            flat += line;
+            if (flat.size() > OUTPUT_LIMIT) {
+                size_t newline = flat.find('\n', flat.size() - OUTPUT_LIMIT + 1000);
+                if (newline != std::string::npos) {
+                    flat = flat.substr(newline + 1);
+                }
+            }
+        }
+        return flat.size();
+    });
+
+    TextBuffer text(OUTPUT_LIMIT);
+    runner.measure("TextBuffer, lines dropped", line_count, [&]() {
+        text.clear();
+        for (const auto& line : lines) {
+            text.append_line(line);
+        }
+        return text.size();
+    });
+
+    runner.measure("frame, split string", 1, [&]() {
+        size_t bytes = 0;
+        std::string copy = flat;
+        for (size_t start = 0, end; start < copy.size(); start = end + 1) {
+            end = copy.find('\n', start);
+            if (end == std::string::npos) {
+                end = copy.size();
+            }
+            bytes += copy.substr(start, end - start).size();
+        }
+        return bytes;
+    });
+
+    runner.measure("frame, visible lines", 1, [&]() {
+        size_t bytes = 0;
+        size_t first = text.line_count() - std::min(text.line_count(), VISIBLE_LINES);
+        for (size_t i = first; i < text.line_count(); ++i) {
+            bytes += text.line(i).size();
+        }
+        return bytes;
+    });
+
+    return runner.finish();
+}
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "widget.h"
+#include "text_buffer.h"
 #include <string>
+#include <string_view>
 #include <functional>
 
 namespace wip::gui::widgets {
@@ -10,7 +12,7 @@ using TextCopyCallback = std::function<void(const std::string&)>;
 
 class SelectableTextWidget : public Widget {
 private:
-    std::string text_;
+    TextBuffer text_;
     std::string unique_id_;
     TextCopyCallback on_text_copied_;
     
@@ -21,9 +23,11 @@ public:
     void update(float delta_time) override;
     void draw() override;
     
-    // Text management
-    void set_text(const std::string& text) { text_ = text; }
-    const std::string& get_text() const { return text_; }
+    // Text management; the text is split into lines once, not on every frame
+    void set_text(std::string_view text) { text_.assign(text); }
+    void append_text(std::string_view text) { text_.append(text); }
+    std::string get_text() const { return text_.to_string(); }
+    const TextBuffer& get_buffer() const { return text_; }
     
     void set_unique_id(const std::string& id) { unique_id_ = id; }
     const std::string& get_unique_id() const { return unique_id_; }
@@ -31,8 +35,9 @@ public:
     // Callback
     void set_copy_callback(TextCopyCallback callback) { on_text_copied_ = callback; }
     
-    // Static utility methods
-    static void render_selectable_text_lines(const std::string& text, const std::string& base_id, TextCopyCallback copy_callback = nullptr);
+    // Static utility methods; only the lines in view are submitted to ImGui
+    static void render_selectable_text_lines(std::string_view text, const std::string& base_id, TextCopyCallback copy_callback = nullptr);
+    static void render_selectable_text_lines(const TextBuffer& text, const std::string& base_id, TextCopyCallback copy_callback = nullptr);
     static void copy_text_to_clipboard(const std::string& text);
     
 private:
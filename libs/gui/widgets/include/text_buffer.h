@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace wip::gui::widgets {
+
+/**
+ * @brief Line-indexed text for views that show a lot of streamed output
+ *
+ * Text is stored in chunks of up to MAX_CHUNK_SIZE bytes, and the position of
+ * every line is kept in an index as text arrives. Appending copies only the
+ * new bytes (plus, when a chunk fills up, the unfinished last line), and any
+ * line is fetched in O(1), so a view can draw just the lines in sight.
+ *
+ * With a size or line limit set, the oldest lines are dropped as new ones
+ * arrive. Dropping a line costs O(1); a chunk is freed once all of its lines
+ * are gone. Lines keep their line number while the ones before them are
+ * dropped, which makes it usable as a stable id.
+ *
+ * Usage:
+ * ```cpp
+ * TextBuffer output(1024 * 1024);     // Keep the last MiB
+ * output.append(process_chunk);
+ * for (size_t i = 0; i < output.line_count(); ++i) {
+ *     draw(output.line(i));
+ * }
+ * ```
+ */
+class TextBuffer {
+public:
+    static constexpr size_t MIN_CHUNK_SIZE = 1024;
+    static constexpr size_t MAX_CHUNK_SIZE = 64 * 1024;
+
+    /**
+     * @brief Create an empty buffer
+     * @param max_size Bytes kept before the oldest lines are dropped (0 = unlimited)
+     * @param max_lines Lines kept before the oldest ones are dropped (0 = unlimited)
+     */
+    explicit TextBuffer(size_t max_size = 0, size_t max_lines = 0);
+
+    TextBuffer(TextBuffer&&) noexcept = default;
+    TextBuffer& operator=(TextBuffer&&) noexcept = default;
+    TextBuffer(const TextBuffer&) = delete;
+    TextBuffer& operator=(const TextBuffer&) = delete;
+
+    /**
+     * @brief Append text; newlines end lines and are not stored
+     */
+    void append(std::string_view text);
+
+    /**
+     * @brief Append one complete line
+     * @param line Text without its newline
+     */
+    void append_line(std::string_view line);
+
+    /**
+     * @brief Replace the contents
+     */
+    void assign(std::string_view text);
+
+    /**
+     * @brief Drop the oldest lines
+     * @param count Number of lines to drop (more than line_count() drops all)
+     */
+    void pop_front(size_t count = 1);
+
+    /**
+     * @brief Remove all text and restart line numbers at 0
+     */
+    void clear();
+
+    /**
+     * @brief Change the limits, dropping the oldest lines now if they are exceeded
+     * @param max_size Bytes kept (0 = unlimited)
+     * @param max_lines Lines kept (0 = unlimited)
+     */
+    void set_limits(size_t max_size, size_t max_lines);
+
+    bool empty() const { return lines_.empty(); }
+    size_t size() const { return size_; }              ///< Bytes of text, newlines included
+    size_t line_count() const { return lines_.size(); }
+
+    /**
+     * @brief Get a line without its newline
+     * @param index Position among the lines held, 0 being the oldest
+     */
+    std::string_view line(size_t index) const;
+
+    /**
+     * @brief Get the line number of line(0), the number of lines dropped since clear()
+     */
+    uint64_t first_line_number() const { return first_line_number_; }
+
+    /**
+     * @brief Get the bytes allocated for chunks and the line index
+     */
+    size_t memory_usage() const;
+
+    std::string to_string() const;
+    void write_to(std::ostream& stream) const;
+
+private:
+    struct Chunk {
+        std::unique_ptr<char[]> data;
+        size_t capacity = 0;
+        size_t used = 0;
+    };
+
+    struct Line {
+        uint64_t chunk;         // Chunk number, counting dropped chunks
+        uint32_t offset;
+        size_t length;
+    };
+
+    // Make room for `length` more bytes of the last line, moving it to a new chunk if needed
+    Chunk& reserve_for_line(size_t length, size_t remaining);
+    Chunk& chunk_of(const Line& line) { return chunks_[line.chunk - first_chunk_]; }
+    const Chunk& chunk_of(const Line& line) const { return chunks_[line.chunk - first_chunk_]; }
+    void enforce_limits();
+
+    std::deque<Chunk> chunks_;
+    std::deque<Line> lines_;
+    uint64_t first_chunk_ = 0;          // Chunk number of chunks_.front()
+    uint64_t first_line_number_ = 0;
+    size_t size_ = 0;
+    size_t chunk_bytes_ = 0;
+    size_t max_size_ = 0;
+    size_t max_lines_ = 0;
+    bool line_open_ = false;            // The last line has no newline yet
+};
+
+} // namespace wip::gui::widgets
@@ -12,6 +12,7 @@
 #include "widget.h"
 #include "panel.h"
 #include "selectable_text_widget.h"
+#include "text_buffer.h"
 
 namespace wip::gui {
 
@@ -1,11 +1,44 @@
 #include "selectable_text_widget.h"
 #include <imgui.h>
-#include <iostream>
+#include <log.h>
+#include <vector>
 
 namespace wip::gui::widgets {
 
+namespace {
+
+// Submits a Selectable for each line in view; the others only take up their height
+template<typename GetLine>
+void render_clipped_lines(size_t line_count, GetLine get_line, const std::string& base_id, const TextCopyCallback& copy_callback) {
+    static std::string label;   // Lines are not null-terminated; reused to avoid an allocation per line
+
+    ImGui::PushID(base_id.c_str());
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(line_count));
+    while (clipper.Step()) {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+            label.assign(get_line(static_cast<size_t>(row)));
+
+            ImGui::PushID(row);
+            if (ImGui::Selectable(label.c_str(), false, ImGuiSelectableFlags_AllowDoubleClick)) {
+                if (ImGui::IsMouseDoubleClicked(0)) {
+                    SelectableTextWidget::copy_text_to_clipboard(label);
+                    if (copy_callback) {
+                        copy_callback(label);
+                    }
+                }
+            }
+            ImGui::PopID();
+        }
+    }
+    ImGui::PopID();
+}
+
+} // namespace
+
 SelectableTextWidget::SelectableTextWidget(const std::string& text, const std::string& unique_id)
-    : text_(text), unique_id_(unique_id) {
+    : unique_id_(unique_id) {
+    text_.assign(text);
 }
 
 void SelectableTextWidget::update([[maybe_unused]] float delta_time) {
@@ -20,50 +53,32 @@ void SelectableTextWidget::render_text_lines() {
     render_selectable_text_lines(text_, unique_id_, on_text_copied_);
 }
 
-void SelectableTextWidget::render_selectable_text_lines(const std::string& text, const std::string& base_id, TextCopyCallback copy_callback) {
+void SelectableTextWidget::render_selectable_text_lines(std::string_view text, const std::string& base_id, TextCopyCallback copy_callback) {
     if (text.empty()) return;
-    
-    std::string text_copy = text;
-    std::string line;
-    size_t line_num = 0;
+
+    // Views into the caller's text; a trailing newline does not start another line
+    static std::vector<std::string_view> lines;
+    lines.clear();
     size_t start = 0;
-    size_t end = 0;
-    
-    while ((end = text_copy.find('\n', start)) != std::string::npos) {
-        line = text_copy.substr(start, end - start);
-        std::string line_id = base_id + "_line_" + std::to_string(line_num);
-        
-        if (ImGui::Selectable((line + "##" + line_id).c_str(), false, ImGuiSelectableFlags_AllowDoubleClick)) {
-            if (ImGui::IsMouseDoubleClicked(0)) {
-                copy_text_to_clipboard(line);
-                if (copy_callback) {
-                    copy_callback(line);
-                }
-            }
+    while (start < text.size()) {
+        size_t end = text.find('\n', start);
+        if (end == std::string_view::npos) {
+            end = text.size();
         }
+        lines.push_back(text.substr(start, end - start));
         start = end + 1;
-        ++line_num;
-    }
-    
-    // Handle the last line (or the only line if no newlines)
-    if (start < text_copy.length()) {
-        line = text_copy.substr(start);
-        std::string line_id = base_id + "_line_" + std::to_string(line_num);
-        
-        if (ImGui::Selectable((line + "##" + line_id).c_str(), false, ImGuiSelectableFlags_AllowDoubleClick)) {
-            if (ImGui::IsMouseDoubleClicked(0)) {
-                copy_text_to_clipboard(line);
-                if (copy_callback) {
-                    copy_callback(line);
-                }
-            }
-        }
     }
+
+    render_clipped_lines(lines.size(), [](size_t row) { return lines[row]; }, base_id, copy_callback);
+}
+
+void SelectableTextWidget::render_selectable_text_lines(const TextBuffer& text, const std::string& base_id, TextCopyCallback copy_callback) {
+    render_clipped_lines(text.line_count(), [&text](size_t row) { return text.line(row); }, base_id, copy_callback);
 }
 
 void SelectableTextWidget::copy_text_to_clipboard(const std::string& text) {
     ImGui::SetClipboardText(text.c_str());
-    std::cout << "[SELECTABLE_TEXT_WIDGET] Text copied to clipboard\n";
+    LOG_DEBUG("SELECTABLE_TEXT_WIDGET", "Text copied to clipboard");
 }
 
-} // namespace wip::gui::widgets
\ No newline at end of file
+} // namespace wip::gui::widgets
@@ -0,0 +1,170 @@
+#include "text_buffer.h"
+#include <algorithm>
+#include <cstring>
+#include <ostream>
+
+namespace wip::gui::widgets {
+
+TextBuffer::TextBuffer(size_t max_size, size_t max_lines)
+    : max_size_(max_size), max_lines_(max_lines) {
+}
+
+void TextBuffer::append(std::string_view text) {
+    size_t position = 0;
+    while (position < text.size()) {
+        size_t newline = text.find('\n', position);
+        size_t end = newline == std::string_view::npos ? text.size() : newline;
+        size_t length = end - position;
+
+        Chunk& chunk = reserve_for_line(length, text.size() - position);
+        if (!line_open_) {
+            lines_.push_back(Line{first_chunk_ + chunks_.size() - 1, static_cast<uint32_t>(chunk.used), 0});
+            line_open_ = true;
+        }
+        std::memcpy(chunk.data.get() + chunk.used, text.data() + position, length);
+        chunk.used += length;
+        lines_.back().length += length;
+
+        // Newlines are implied by the line index rather than stored
+        if (newline != std::string_view::npos) {
+            line_open_ = false;
+            ++end;
+        }
+        size_ += end - position;
+        position = end;
+    }
+
+    enforce_limits();
+}
+
+void TextBuffer::append_line(std::string_view line) {
+    // An unfinished last line is ended first, so the line always starts a line of its own
+    if (line_open_) {
+        append("\n");
+    }
+    append(line);
+    append("\n");
+}
+
+void TextBuffer::assign(std::string_view text) {
+    clear();
+    append(text);
+}
+
+TextBuffer::Chunk& TextBuffer::reserve_for_line(size_t length, size_t remaining) {
+    if (!chunks_.empty() && chunks_.back().capacity - chunks_.back().used >= length) {
+        return chunks_.back();
+    }
+
+    // Chunks grow with the text up to MAX_CHUNK_SIZE, but always hold a whole line
+    size_t open_length = line_open_ ? lines_.back().length : 0;
+    size_t capacity = std::clamp(std::max(remaining, size_), MIN_CHUNK_SIZE, MAX_CHUNK_SIZE);
+    capacity = std::max(capacity, open_length + length);
+
+    Chunk chunk;
+    chunk.data.reset(new char[capacity]);
+    chunk.capacity = capacity;
+
+    // Only the unfinished last line moves, so lines never span chunks
+    if (open_length > 0) {
+        Line& line = lines_.back();
+        Chunk& previous = chunk_of(line);
+        std::memcpy(chunk.data.get(), previous.data.get() + line.offset, open_length);
+        previous.used -= open_length;
+        line.chunk = first_chunk_ + chunks_.size();
+        line.offset = 0;
+        chunk.used = open_length;
+    }
+
+    chunks_.push_back(std::move(chunk));
+    chunk_bytes_ += capacity;
+    return chunks_.back();
+}
+
+void TextBuffer::pop_front(size_t count) {
+    if (count >= lines_.size()) {
+        first_line_number_ += lines_.size();
+        chunks_.clear();
+        lines_.clear();
+        first_chunk_ = 0;
+        size_ = 0;
+        chunk_bytes_ = 0;
+        line_open_ = false;
+        return;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        size_ -= lines_.front().length + 1;     // Only the last line can lack its newline
+        lines_.pop_front();
+    }
+    first_line_number_ += count;
+
+    // Chunks before the one holding the oldest line hold nothing anymore
+    while (first_chunk_ < lines_.front().chunk) {
+        chunk_bytes_ -= chunks_.front().capacity;
+        chunks_.pop_front();
+        ++first_chunk_;
+    }
+}
+
+void TextBuffer::clear() {
+    pop_front(lines_.size());
+    first_line_number_ = 0;
+}
+
+void TextBuffer::set_limits(size_t max_size, size_t max_lines) {
+    max_size_ = max_size;
+    max_lines_ = max_lines;
+    enforce_limits();
+}
+
+void TextBuffer::enforce_limits() {
+    size_t excess = max_lines_ > 0 && lines_.size() > max_lines_ ? lines_.size() - max_lines_ : 0;
+    if (excess > 0) {
+        pop_front(excess);
+    }
+
+    // The newest line is kept even if it alone is over the limit
+    if (max_size_ > 0 && size_ > max_size_) {
+        size_t dropped = 0;
+        size_t remaining = size_;
+        while (dropped + 1 < lines_.size() && remaining > max_size_) {
+            remaining -= lines_[dropped].length + 1;
+            ++dropped;
+        }
+        pop_front(dropped);
+    }
+}
+
+std::string_view TextBuffer::line(size_t index) const {
+    const Line& line = lines_[index];
+    return std::string_view(chunk_of(line).data.get() + line.offset, line.length);
+}
+
+size_t TextBuffer::memory_usage() const {
+    return chunk_bytes_ + lines_.size() * sizeof(Line);
+}
+
+std::string TextBuffer::to_string() const {
+    std::string text;
+    text.reserve(size_);
+    for (size_t i = 0; i < lines_.size(); ++i) {
+        text += line(i);
+        if (i + 1 < lines_.size() || !line_open_) {
+            text += '\n';
+        }
+    }
+    return text;
+}
+
+void TextBuffer::write_to(std::ostream& stream) const {
+    for (size_t i = 0; i < lines_.size(); ++i) {
+        std::string_view text = line(i);
+        stream.write(text.data(), static_cast<std::streamsize>(text.size()));
+        if (i + 1 < lines_.size() || !line_open_) {
+            stream.put('\n');
+        }
+    }
+}
+
+} // namespace wip::gui::widgets
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include "text_buffer.h"
+#include <sstream>
+#include <string>
+
+using namespace wip::gui::widgets;
+
+TEST(TextBufferTest, IndexesLinesAsTheyArrive) {
+    TextBuffer text;
+    EXPECT_TRUE(text.empty());
+
+    text.append("first li");
+    text.append("ne\nsecond\n\nfourth");
+    ASSERT_EQ(text.line_count(), 4u);
+    EXPECT_EQ(text.line(0), "first line");
+    EXPECT_EQ(text.line(1), "second");
+    EXPECT_EQ(text.line(2), "");
+    EXPECT_EQ(text.line(3), "fourth");
+    EXPECT_EQ(text.size(), 25u);
+    EXPECT_EQ(text.to_string(), "first line\nsecond\n\nfourth");
+
+    // The unfinished last line continues
+    text.append(" and more\n");
+    EXPECT_EQ(text.line(3), "fourth and more");
+    EXPECT_EQ(text.to_string(), "first line\nsecond\n\nfourth and more\n");
+
+    std::ostringstream stream;
+    text.write_to(stream);
+    EXPECT_EQ(stream.str(), text.to_string());
+}
+
+TEST(TextBufferTest, AppendLineEndsAnOpenLine) {
+    TextBuffer text;
+    text.append("partial");
+    text.append_line("complete");
+    text.append_line("two\nlines");
+    EXPECT_EQ(text.to_string(), "partial\ncomplete\ntwo\nlines\n");
+    EXPECT_EQ(text.line_count(), 4u);
+}
+
+TEST(TextBufferTest, LinesNeverSpanChunks) {
+    TextBuffer text;
+    std::string expected;
+    for (int i = 0; i < 5000; ++i) {
+        std::string piece = "line " + std::to_string(i) + (i % 3 == 0 ? "\n" : " ");
+        text.append(piece);
+        expected += piece;
+    }
+
+    EXPECT_EQ(text.to_string(), expected);
+    EXPECT_EQ(text.size(), expected.size());
+    EXPECT_GE(text.memory_usage(), text.size() - text.line_count());
+
+    // A line longer than a chunk gets a chunk of its own
+    std::string open_line(text.line(text.line_count() - 1));
+    std::string long_line(TextBuffer::MAX_CHUNK_SIZE * 2, 'x');
+    text.append(long_line);
+    EXPECT_EQ(text.line(text.line_count() - 1), open_line + long_line);
+}
+
+TEST(TextBufferTest, PopFrontKeepsLineNumbers) {
+    TextBuffer text;
+    text.append("a\nb\nc\nd");
+
+    text.pop_front(2);
+    EXPECT_EQ(text.first_line_number(), 2u);
+    ASSERT_EQ(text.line_count(), 2u);
+    EXPECT_EQ(text.line(0), "c");
+    EXPECT_EQ(text.size(), 3u);
+    EXPECT_EQ(text.to_string(), "c\nd");
+
+    text.pop_front(10);
+    EXPECT_TRUE(text.empty());
+    EXPECT_EQ(text.size(), 0u);
+    EXPECT_EQ(text.memory_usage(), 0u);
+    EXPECT_EQ(text.first_line_number(), 4u);
+
+    text.append("e\n");
+    EXPECT_EQ(text.line(0), "e");
+    text.clear();
+    EXPECT_EQ(text.first_line_number(), 0u);
+}
+
+TEST(TextBufferTest, LimitsDropTheOldestLines) {
+    TextBuffer text(0, 3);
+    for (int i = 0; i < 10; ++i) {
+        text.append_line("line " + std::to_string(i));
+    }
+    ASSERT_EQ(text.line_count(), 3u);
+    EXPECT_EQ(text.line(0), "line 7");
+    EXPECT_EQ(text.first_line_number(), 7u);
+
+    // "line 8\nline 9\n" is 14 bytes; the newest line stays even when over the limit
+    text.set_limits(10, 0);
+    EXPECT_EQ(text.to_string(), "line 9\n");
+    text.append(std::string(50, 'y'));
+    EXPECT_EQ(text.to_string(), std::string(50, 'y'));
+}
+
+TEST(TextBufferTest, StreamingWithALimitFreesChunks) {
+    const size_t limit = 256 * 1024;
+    TextBuffer text(limit);
+    std::string line(100, 'z');
+    for (int i = 0; i < 50000; ++i) {
+        text.append_line(line);
+    }
+
+    EXPECT_LE(text.size(), limit);
+    EXPECT_GT(text.size(), limit - line.size() - 1);
+    EXPECT_EQ(text.first_line_number() + text.line_count(), 50000u);
+    EXPECT_LE(text.memory_usage(), limit + 2 * TextBuffer::MAX_CHUNK_SIZE + text.line_count() * 32);
+    EXPECT_EQ(text.line(text.line_count() - 1), line);
+}
+
+TEST(TextBufferTest, AssignReplacesContents) {
+    TextBuffer text;
+    text.append("old\nlines\n");
+    text.assign("new");
+    EXPECT_EQ(text.line_count(), 1u);
+    EXPECT_EQ(text.line(0), "new");
+    EXPECT_EQ(text.first_line_number(), 0u);
+}
@@ -0,0 +1,60 @@
+// Benchmark for coalescing mouse input.
+//
+// Feeds the cursor callbacks of a high polling rate mouse, several moves per
+// frame, to an event dispatcher with a few subscribers, once dispatching
+// every move as the window did before and once through an InputCoalescer
+// flushed once per frame. Reports the time per raw move in nanoseconds.
+// Usage:
+//
+//   bench_wip_gui_input_coalescing [moves-per-frame] [frames]
+
+#include "benchmark.h"
+#include <window.h>
+#include <event_dispatcher.h>
+
+namespace events = wip::gui::window::events;
+
+int main(int argc, char* argv[]) {
+    wip::benchmark::Runner runner("bench_wip_gui_input_coalescing", argc, argv, "[moves-per-frame] [frames]");
+    size_t moves_per_frame = runner.argument(0, 16);
+    size_t frames = runner.argument(1, 50000);
+
+    // Subscribers like those of an application: layer forwarding, a hover tracker, statistics
+    wip::utils::event::EventDispatcher dispatcher;
+    double position = 0.0;
+    size_t handled = 0;
+    dispatcher.subscribe<events::MouseMoveEvent>([&](const events::MouseMoveEvent& event) { position = event.x(); });
+    dispatcher.subscribe<events::MouseMoveEvent>([&](const events::MouseMoveEvent& event) {
+        handled += event.samples();
+    });
+    dispatcher.subscribe<events::MouseMoveEvent>([&](const events::MouseMoveEvent&) { ++handled; });
+
+    runner.out() << frames << " frames of " << moves_per_frame << " mouse moves" << std::endl;
+    const size_t moves = frames * moves_per_frame;
+
+    runner.measure("dispatch every move", moves, [&]() {
+        handled = 0;
+        for (size_t frame = 0; frame < frames; ++frame) {
+            for (size_t i = 0; i < moves_per_frame; ++i) {
+                double x = static_cast<double>(frame * moves_per_frame + i);
+                dispatcher.dispatch(events::MouseMoveEvent(x, x, 1.0, 1.0));
+            }
+        }
+        return handled + static_cast<size_t>(position);
+    });
+
+    wip::gui::window::InputCoalescer coalescer;
+    runner.measure("coalesce per frame", moves, [&]() {
+        handled = 0;
+        for (size_t frame = 0; frame < frames; ++frame) {
+            for (size_t i = 0; i < moves_per_frame; ++i) {
+                double x = static_cast<double>(frame * moves_per_frame + i);
+                coalescer.add_move(x, x, 1.0, 1.0);
+            }
+            coalescer.flush(dispatcher);
+        }
+        return handled + static_cast<size_t>(position);
+    });
+
+    return runner.finish();
+}
@@ -2,6 +2,7 @@
 
 #include <event_dispatcher.h>
 #include <GLFW/glfw3.h>
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <functional>
@@ -119,39 +120,100 @@ private:
 
 /**
  * @brief Mouse cursor movement events
+ * 
+ * Windows merge the moves reported between two frames into one event with
+ * the last position and the summed change, unless input coalescing is off.
  */
 class MouseMoveEvent : public wip::utils::event::Event {
 public:
-    MouseMoveEvent(double x, double y, double dx, double dy)
-        : x_(x), y_(y), dx_(dx), dy_(dy) {}
+    MouseMoveEvent(double x, double y, double dx, double dy, unsigned int samples = 1)
+        : x_(x), y_(y), dx_(dx), dy_(dy), samples_(samples) {}
     
     double x() const noexcept { return x_; }
     double y() const noexcept { return y_; }
     double dx() const noexcept { return dx_; }  // Change in x
     double dy() const noexcept { return dy_; }  // Change in y
+    unsigned int samples() const noexcept { return samples_; }  // Moves reported by the system
 
 private:
     double x_, y_;
     double dx_, dy_;
+    unsigned int samples_;
 };
 
 /**
  * @brief Mouse scroll events
+ * 
+ * Like moves, the scrolls between two frames are merged into one event with
+ * the summed offsets, unless input coalescing is off.
  */
 class MouseScrollEvent : public wip::utils::event::Event {
 public:
-    MouseScrollEvent(double x_offset, double y_offset)
-        : x_offset_(x_offset), y_offset_(y_offset) {}
+    MouseScrollEvent(double x_offset, double y_offset, unsigned int samples = 1)
+        : x_offset_(x_offset), y_offset_(y_offset), samples_(samples) {}
     
     double x_offset() const noexcept { return x_offset_; }
     double y_offset() const noexcept { return y_offset_; }
+    unsigned int samples() const noexcept { return samples_; }  // Scrolls reported by the system
 
 private:
     double x_offset_, y_offset_;
+    unsigned int samples_;
 };
 
 } // namespace events
 
+/**
+ * @brief Merges pointer input into at most one move and one scroll event per flush
+ * 
+ * High polling rate mice report moves far more often than a frame is drawn.
+ * The coalescer keeps the last position with the summed change, and the
+ * summed scroll offsets, until flush() dispatches them. Flushing before
+ * dispatching any other input keeps the order between a move and a
+ * following click or key press.
+ */
+class InputCoalescer {
+public:
+    void add_move(double x, double y, double dx, double dy) noexcept;
+    void add_scroll(double x_offset, double y_offset) noexcept;
+    
+    /**
+     * @brief Check whether a move or a scroll waits for flush()
+     */
+    bool has_pending() const noexcept { return move_.samples > 0 || scroll_.samples > 0; }
+    
+    /**
+     * @brief Dispatch the merged move, then the merged scroll, and start over
+     * @return Number of events dispatched
+     */
+    size_t flush(wip::utils::event::EventDispatcher& dispatcher);
+    
+    /**
+     * @brief Drop pending input without dispatching it
+     */
+    void clear() noexcept;
+    
+    /**
+     * @brief Get number of raw moves and scrolls merged away since construction
+     */
+    uint64_t merged_count() const noexcept { return merged_; }
+
+private:
+    struct PendingMove {
+        double x = 0.0, y = 0.0;
+        double dx = 0.0, dy = 0.0;
+        unsigned int samples = 0;
+    };
+    struct PendingScroll {
+        double x_offset = 0.0, y_offset = 0.0;
+        unsigned int samples = 0;
+    };
+    
+    PendingMove move_;
+    PendingScroll scroll_;
+    uint64_t merged_ = 0;
+};
+
 /**
  * @brief Window creation and management configuration
  */
@@ -168,6 +230,9 @@ struct WindowConfig {
     bool maximized = false;
     int samples = 0; // MSAA samples (0 = disabled)
     
+    // Merge mouse moves and scrolls until the next poll_events() (false = one event per system callback)
+    bool coalesce_input = true;
+    
     // OpenGL context configuration
     int context_version_major = 3;
     int context_version_minor = 3;
@@ -235,6 +300,39 @@ public:
      */
     void wait_events();
     
+    /**
+     * @brief Wait for events, at most for the given time
+     * @param timeout_seconds Longest time to wait
+     */
+    void wait_events(double timeout_seconds);
+    
+    /**
+     * @brief Dispatch the mouse moves and scrolls merged since the last flush
+     * poll_events() and wait_events() flush this window; GLFW reports input of
+     * every window from them, so an application with several windows flushes
+     * the others itself.
+     * @return Number of events dispatched
+     */
+    size_t flush_input();
+    
+    /**
+     * @brief Merge mouse moves and scrolls between flushes, or dispatch each one as reported
+     * Turn it off for handlers that need every sample, e.g. freehand drawing.
+     */
+    void set_input_coalescing(bool enabled);
+    bool is_input_coalescing() const noexcept { return coalesce_input_; }
+    
+    /**
+     * @brief Get the input merger, e.g. for its statistics
+     */
+    const InputCoalescer& get_input_coalescer() const noexcept { return input_coalescer_; }
+    
+    /**
+     * @brief Wake a thread blocked in wait_events()
+     * Safe to call from any thread while GLFW is initialized.
+     */
+    static void post_empty_event();
+    
     /**
      * @brief Get window size
      */
@@ -296,6 +394,21 @@ public:
     void focus();
     bool is_focused() const;
     
+    /**
+     * @brief Ask for the window to be drawn again
+     * Input and window events on the window ask for it themselves.
+     */
+    void request_redraw() noexcept { redraw_requested_ = true; }
+    
+    /**
+     * @brief Check whether the window asked to be drawn, and clear the request
+     */
+    bool take_redraw_request() noexcept {
+        bool requested = redraw_requested_;
+        redraw_requested_ = false;
+        return requested;
+    }
+    
     /**
      * @brief Get the underlying GLFW window handle (use with caution)
      */
@@ -336,6 +449,13 @@ private:
     double last_cursor_y_ = 0.0;
     bool first_cursor_move_ = true;
     
+    // Set by the callbacks of this window, taken by the application loop
+    bool redraw_requested_ = true;
+    
+    // Pointer input waiting for the next flush
+    InputCoalescer input_coalescer_;
+    bool coalesce_input_ = true;
+    
     // Static GLFW management
     static int glfw_window_count_;
     static bool glfw_initialized_;
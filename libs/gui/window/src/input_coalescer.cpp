@@ -0,0 +1,44 @@
+#include "window.h"
+
+namespace wip::gui::window {
+
+void InputCoalescer::add_move(double x, double y, double dx, double dy) noexcept {
+    merged_ += move_.samples > 0;
+    move_.x = x;
+    move_.y = y;
+    move_.dx += dx;
+    move_.dy += dy;
+    ++move_.samples;
+}
+
+void InputCoalescer::add_scroll(double x_offset, double y_offset) noexcept {
+    merged_ += scroll_.samples > 0;
+    scroll_.x_offset += x_offset;
+    scroll_.y_offset += y_offset;
+    ++scroll_.samples;
+}
+
+size_t InputCoalescer::flush(wip::utils::event::EventDispatcher& dispatcher) {
+    // Taken before dispatching, so that handlers may add input again
+    PendingMove move = move_;
+    PendingScroll scroll = scroll_;
+    clear();
+    
+    size_t dispatched = 0;
+    if (move.samples > 0) {
+        dispatcher.dispatch(events::MouseMoveEvent(move.x, move.y, move.dx, move.dy, move.samples));
+        ++dispatched;
+    }
+    if (scroll.samples > 0) {
+        dispatcher.dispatch(events::MouseScrollEvent(scroll.x_offset, scroll.y_offset, scroll.samples));
+        ++dispatched;
+    }
+    return dispatched;
+}
+
+void InputCoalescer::clear() noexcept {
+    move_ = PendingMove();
+    scroll_ = PendingScroll();
+}
+
+} // namespace wip::gui::window
@@ -1,6 +1,6 @@
 #include "window.h"
 #include <stdexcept>
-#include <iostream>
+#include <log.h>
 #include <sstream>
 
 namespace wip::gui::window {
@@ -15,6 +15,7 @@ Window::Window(const WindowConfig& config)
     , last_cursor_x_(0.0)
     , last_cursor_y_(0.0)
     , first_cursor_move_(true)
+    , coalesce_input_(config.coalesce_input)
 {
     initialize_glfw();
     
@@ -72,6 +73,9 @@ Window::Window(Window&& other) noexcept
     , last_cursor_x_(other.last_cursor_x_)
     , last_cursor_y_(other.last_cursor_y_)
     , first_cursor_move_(other.first_cursor_move_)
+    , redraw_requested_(other.redraw_requested_)
+    , input_coalescer_(other.input_coalescer_)
+    , coalesce_input_(other.coalesce_input_)
 {
     other.window_ = nullptr;
     
@@ -93,6 +97,9 @@ Window& Window::operator=(Window&& other) noexcept {
         last_cursor_x_ = other.last_cursor_x_;
         last_cursor_y_ = other.last_cursor_y_;
         first_cursor_move_ = other.first_cursor_move_;
+        redraw_requested_ = other.redraw_requested_;
+        input_coalescer_ = other.input_coalescer_;
+        coalesce_input_ = other.coalesce_input_;
         
         other.window_ = nullptr;
         
@@ -127,10 +134,33 @@ void Window::swap_buffers() {
 
 void Window::poll_events() {
     glfwPollEvents();
+    flush_input();
 }
 
 void Window::wait_events() {
     glfwWaitEvents();
+    flush_input();
+}
+
+void Window::wait_events(double timeout_seconds) {
+    glfwWaitEventsTimeout(timeout_seconds);
+    flush_input();
+}
+
+size_t Window::flush_input() {
+    return input_coalescer_.has_pending() ? input_coalescer_.flush(*event_dispatcher_) : 0;
+}
+
+void Window::set_input_coalescing(bool enabled) {
+    // Input merged so far goes out before the mode changes
+    flush_input();
+    coalesce_input_ = enabled;
+}
+
+void Window::post_empty_event() {
+    if (glfw_initialized_) {
+        glfwPostEmptyEvent();
+    }
 }
 
 void Window::get_size(int& width, int& height) const {
@@ -324,24 +354,28 @@ void Window::setup_callbacks() {
 // GLFW Callback implementations
 void Window::window_close_callback(GLFWwindow* window) {
     if (auto* win = get_window_instance(window)) {
+        win->redraw_requested_ = true;
         win->event_dispatcher_->dispatch(events::WindowEvent(events::WindowEvent::Type::Close));
     }
 }
 
 void Window::window_size_callback(GLFWwindow* window, int width, int height) {
     if (auto* win = get_window_instance(window)) {
+        win->redraw_requested_ = true;
         win->event_dispatcher_->dispatch(events::WindowEvent(events::WindowEvent::Type::Resize, width, height));
     }
 }
 
 void Window::window_pos_callback(GLFWwindow* window, int x, int y) {
     if (auto* win = get_window_instance(window)) {
+        win->redraw_requested_ = true;
         win->event_dispatcher_->dispatch(events::WindowEvent(events::WindowEvent::Type::Move, 0, 0, x, y));
     }
 }
 
 void Window::window_focus_callback(GLFWwindow* window, int focused) {
     if (auto* win = get_window_instance(window)) {
+        win->redraw_requested_ = true;
         auto type = focused ? events::WindowEvent::Type::Focus : events::WindowEvent::Type::Unfocus;
         win->event_dispatcher_->dispatch(events::WindowEvent(type));
     }
@@ -349,6 +383,7 @@ void Window::window_focus_callback(GLFWwindow* window, int focused) {
 
 void Window::window_iconify_callback(GLFWwindow* window, int iconified) {
     if (auto* win = get_window_instance(window)) {
+        win->redraw_requested_ = true;
         auto type = iconified ? events::WindowEvent::Type::Iconify : events::WindowEvent::Type::Restore;
         win->event_dispatcher_->dispatch(events::WindowEvent(type));
     }
@@ -356,6 +391,7 @@ void Window::window_iconify_callback(GLFWwindow* window, int iconified) {
 
 void Window::window_maximize_callback(GLFWwindow* window, int maximized) {
     if (auto* win = get_window_instance(window)) {
+        win->redraw_requested_ = true;
         if (maximized) {
             win->event_dispatcher_->dispatch(events::WindowEvent(events::WindowEvent::Type::Maximize));
         }
@@ -364,12 +400,14 @@ void Window::window_maximize_callback(GLFWwindow* window, int maximized) {
 
 void Window::framebuffer_size_callback(GLFWwindow* window, int width, int height) {
     if (auto* win = get_window_instance(window)) {
+        win->redraw_requested_ = true;
         win->event_dispatcher_->dispatch(events::WindowEvent(events::WindowEvent::Type::FramebufferResize, width, height));
     }
 }
 
 void Window::key_callback(GLFWwindow* window, int key, int scancode, int action, int mods) {
     if (auto* win = get_window_instance(window)) {
+        win->redraw_requested_ = true;
         events::KeyboardEvent::Action event_action;
         switch (action) {
             case GLFW_PRESS:
@@ -385,18 +423,22 @@ void Window::key_callback(GLFWwindow* window, int key, int scancode, int action,
                 return; // Unknown action
         }
         
+        win->flush_input();
         win->event_dispatcher_->dispatch(events::KeyboardEvent(key, scancode, event_action, mods));
     }
 }
 
 void Window::char_callback(GLFWwindow* window, unsigned int codepoint) {
     if (auto* win = get_window_instance(window)) {
+        win->redraw_requested_ = true;
+        win->flush_input();
         win->event_dispatcher_->dispatch(events::CharacterEvent(codepoint));
     }
 }
 
 void Window::mouse_button_callback(GLFWwindow* window, int button, int action, int mods) {
     if (auto* win = get_window_instance(window)) {
+        win->redraw_requested_ = true;
         events::MouseButtonEvent::Action event_action;
         switch (action) {
             case GLFW_PRESS:
@@ -411,12 +453,14 @@ void Window::mouse_button_callback(GLFWwindow* window, int button, int action, i
         
         double x, y;
         glfwGetCursorPos(window, &x, &y);
+        win->flush_input();
         win->event_dispatcher_->dispatch(events::MouseButtonEvent(button, event_action, mods, x, y));
     }
 }
 
 void Window::cursor_pos_callback(GLFWwindow* window, double x, double y) {
     if (auto* win = get_window_instance(window)) {
+        win->redraw_requested_ = true;
         double dx = 0.0, dy = 0.0;
         
         if (!win->first_cursor_move_) {
@@ -429,18 +473,27 @@ void Window::cursor_pos_callback(GLFWwindow* window, double x, double y) {
         win->last_cursor_x_ = x;
         win->last_cursor_y_ = y;
         
-        win->event_dispatcher_->dispatch(events::MouseMoveEvent(x, y, dx, dy));
+        if (win->coalesce_input_) {
+            win->input_coalescer_.add_move(x, y, dx, dy);
+        } else {
+            win->event_dispatcher_->dispatch(events::MouseMoveEvent(x, y, dx, dy));
+        }
     }
 }
 
 void Window::scroll_callback(GLFWwindow* window, double x_offset, double y_offset) {
     if (auto* win = get_window_instance(window)) {
-        win->event_dispatcher_->dispatch(events::MouseScrollEvent(x_offset, y_offset));
+        win->redraw_requested_ = true;
+        if (win->coalesce_input_) {
+            win->input_coalescer_.add_scroll(x_offset, y_offset);
+        } else {
+            win->event_dispatcher_->dispatch(events::MouseScrollEvent(x_offset, y_offset));
+        }
     }
 }
 
 void Window::glfw_error_callback(int error, const char* description) {
-    std::cerr << "GLFW Error " << error << ": " << description << std::endl;
+    LOG_ERROR("WINDOW", "GLFW Error ", error, ": ", description);
 }
 
 Window* Window::get_window_instance(GLFWwindow* glfw_window) {
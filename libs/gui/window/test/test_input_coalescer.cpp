@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <window.h>
+#include <event_dispatcher.h>
+#include <vector>
+
+using namespace wip::gui::window;
+using namespace wip::gui::window::events;
+using namespace wip::utils::event;
+
+class InputCoalescerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dispatcher_.subscribe<MouseMoveEvent>([this](const MouseMoveEvent& event) {
+            moves_.push_back(event);
+            order_.push_back('m');
+        });
+        dispatcher_.subscribe<MouseScrollEvent>([this](const MouseScrollEvent& event) {
+            scrolls_.push_back(event);
+            order_.push_back('s');
+        });
+    }
+
+    EventDispatcher dispatcher_;
+    InputCoalescer coalescer_;
+    std::vector<MouseMoveEvent> moves_;
+    std::vector<MouseScrollEvent> scrolls_;
+    std::string order_;
+};
+
+TEST_F(InputCoalescerTest, NothingPending) {
+    EXPECT_FALSE(coalescer_.has_pending());
+    EXPECT_EQ(coalescer_.flush(dispatcher_), 0u);
+    EXPECT_TRUE(moves_.empty());
+    EXPECT_TRUE(scrolls_.empty());
+}
+
+TEST_F(InputCoalescerTest, MergesMovesIntoLastPositionAndSummedChange) {
+    coalescer_.add_move(10.0, 20.0, 1.0, 2.0);
+    coalescer_.add_move(12.0, 19.0, 2.0, -1.0);
+    coalescer_.add_move(15.0, 25.0, 3.0, 6.0);
+    EXPECT_TRUE(coalescer_.has_pending());
+
+    EXPECT_EQ(coalescer_.flush(dispatcher_), 1u);
+    ASSERT_EQ(moves_.size(), 1u);
+    EXPECT_DOUBLE_EQ(moves_[0].x(), 15.0);
+    EXPECT_DOUBLE_EQ(moves_[0].y(), 25.0);
+    EXPECT_DOUBLE_EQ(moves_[0].dx(), 6.0);
+    EXPECT_DOUBLE_EQ(moves_[0].dy(), 7.0);
+    EXPECT_EQ(moves_[0].samples(), 3u);
+    EXPECT_EQ(coalescer_.merged_count(), 2u);
+    EXPECT_FALSE(coalescer_.has_pending());
+}
+
+TEST_F(InputCoalescerTest, SumsScrollOffsets) {
+    coalescer_.add_scroll(0.0, 1.0);
+    coalescer_.add_scroll(0.5, 1.0);
+    coalescer_.add_scroll(0.0, -0.5);
+
+    EXPECT_EQ(coalescer_.flush(dispatcher_), 1u);
+    ASSERT_EQ(scrolls_.size(), 1u);
+    EXPECT_DOUBLE_EQ(scrolls_[0].x_offset(), 0.5);
+    EXPECT_DOUBLE_EQ(scrolls_[0].y_offset(), 1.5);
+    EXPECT_EQ(scrolls_[0].samples(), 3u);
+}
+
+TEST_F(InputCoalescerTest, OneEventPerTypeMoveFirst) {
+    coalescer_.add_scroll(0.0, 1.0);
+    coalescer_.add_move(1.0, 1.0, 1.0, 1.0);
+    coalescer_.add_scroll(0.0, 1.0);
+    coalescer_.add_move(2.0, 2.0, 1.0, 1.0);
+
+    EXPECT_EQ(coalescer_.flush(dispatcher_), 2u);
+    EXPECT_EQ(order_, "ms");
+}
+
+TEST_F(InputCoalescerTest, FlushStartsOver) {
+    coalescer_.add_move(1.0, 1.0, 1.0, 1.0);
+    coalescer_.flush(dispatcher_);
+    coalescer_.add_move(3.0, 4.0, 2.0, 3.0);
+    coalescer_.flush(dispatcher_);
+
+    ASSERT_EQ(moves_.size(), 2u);
+    EXPECT_DOUBLE_EQ(moves_[1].dx(), 2.0);
+    EXPECT_DOUBLE_EQ(moves_[1].dy(), 3.0);
+    EXPECT_EQ(moves_[1].samples(), 1u);
+}
+
+TEST_F(InputCoalescerTest, ClearDropsPendingInput) {
+    coalescer_.add_move(1.0, 1.0, 1.0, 1.0);
+    coalescer_.add_scroll(0.0, 1.0);
+    coalescer_.clear();
+
+    EXPECT_FALSE(coalescer_.has_pending());
+    EXPECT_EQ(coalescer_.flush(dispatcher_), 0u);
+    EXPECT_TRUE(moves_.empty());
+}
+
+TEST_F(InputCoalescerTest, HandlersMayAddInputWhileFlushing) {
+    EventDispatcher dispatcher;
+    InputCoalescer coalescer;
+    int moves = 0;
+    dispatcher.subscribe<MouseMoveEvent>([&](const MouseMoveEvent&) {
+        if (++moves == 1) {
+            coalescer.add_move(5.0, 5.0, 1.0, 1.0);
+        }
+    });
+
+    coalescer.add_move(1.0, 1.0, 1.0, 1.0);
+    EXPECT_EQ(coalescer.flush(dispatcher), 1u);
+    EXPECT_TRUE(coalescer.has_pending());
+    EXPECT_EQ(coalescer.flush(dispatcher), 1u);
+    EXPECT_EQ(moves, 2);
+}
+
+TEST_F(InputCoalescerTest, RawEventsDefaultToOneSample) {
+    MouseMoveEvent move(1.0, 2.0, 0.5, 0.5);
+    MouseScrollEvent scroll(0.0, 1.0);
+    EXPECT_EQ(move.samples(), 1u);
+    EXPECT_EQ(scroll.samples(), 1u);
+
+    WindowConfig config;
+    EXPECT_TRUE(config.coalesce_input);
+}
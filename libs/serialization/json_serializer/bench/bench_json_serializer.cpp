@@ -0,0 +1,123 @@
+// Benchmark for deserializing large JSON containers.
+//
+// Loads a list of strings and a map of integer lists, first by parsing the
+// text into an nlohmann DOM and deserializing that, then with the SAX path
+// (deserialize_text from a string and deserialize_file from a file stream).
+// Reports the time per element and the peak heap use of each variant on
+// top of what was allocated before it started. Usage:
+//
+//   bench_wip_serialization_json_serializer [element-count]
+//
+// The default is one million elements.
+
+#include "benchmark.h"
+#include "json_serializer.h"
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <malloc.h>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+std::atomic<size_t> allocated_bytes{0};
+std::atomic<size_t> peak_bytes{0};
+
+void track_allocation(void* memory) {
+    size_t current = allocated_bytes += malloc_usable_size(memory);
+    size_t peak = peak_bytes.load();
+    while (current > peak && !peak_bytes.compare_exchange_weak(peak, current)) {
+    }
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+        track_allocation(memory);
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    if (memory) {
+        allocated_bytes -= malloc_usable_size(memory);
+    }
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    operator delete(memory);
+}
+
+using namespace wip::serialization;
+
+namespace {
+
+constexpr size_t DEFAULT_ELEMENT_COUNT = 1000000;
+
+using StringList = std::vector<std::string>;
+using IntListMap = std::unordered_map<std::string, std::vector<int>>;
+
+// Peak heap use of run beyond what was allocated when it started, in MB
+template<typename Run>
+double peak_megabytes(Run&& run) {
+    const size_t baseline = allocated_bytes.load();
+    peak_bytes = baseline;
+    run();
+    return static_cast<double>(peak_bytes.load() - baseline) / (1024.0 * 1024.0);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    wip::benchmark::Runner runner("bench_wip_serialization_json_serializer", argc, argv, "[element-count]");
+    size_t count = runner.argument(0, DEFAULT_ELEMENT_COUNT);
+
+    StringList strings;
+    strings.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        strings.push_back("/home/user/project/src/module_" + std::to_string(i % 97) + "/file_" + std::to_string(i) + ".cpp");
+    }
+    IntListMap lists;
+    for (size_t i = 0; i < count / 10; ++i) {
+        lists["file_" + std::to_string(i)] = {static_cast<int>(i), 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    }
+
+    const std::string strings_text = JsonSerializer<StringList>().serialize(strings).dump();
+    const std::string lists_text = JsonSerializer<IntListMap>().serialize(lists).dump();
+    auto strings_path = std::filesystem::temp_directory_path() / "bench_json_serializer_strings.json";
+    {
+        std::ofstream file(strings_path, std::ios::binary);
+        file << strings_text;
+    }
+    runner.out() << "Deserializing " << count << " strings (" << strings_text.size() / 1024 << " KB) and "
+                 << lists.size() << " integer lists (" << lists_text.size() / 1024 << " KB)" << std::endl;
+
+    JsonSerializer<StringList> string_serializer;
+    auto dom_strings = [&]() { return string_serializer.deserialize(nlohmann::json::parse(strings_text))->size(); };
+    auto sax_strings = [&]() { return string_serializer.deserialize_text(strings_text, count)->size(); };
+    auto file_strings = [&]() { return string_serializer.deserialize_file(strings_path, count)->size(); };
+    runner.measure("strings: DOM", count, dom_strings);
+    runner.measure("strings: SAX text", count, sax_strings);
+    runner.measure("strings: SAX file", count, file_strings);
+    runner.report("strings peak: DOM", peak_megabytes(dom_strings), "MB");
+    runner.report("strings peak: SAX text", peak_megabytes(sax_strings), "MB");
+    runner.report("strings peak: SAX file", peak_megabytes(file_strings), "MB");
+
+    JsonSerializer<IntListMap> list_serializer;
+    auto dom_lists = [&]() { return list_serializer.deserialize(nlohmann::json::parse(lists_text))->size(); };
+    auto sax_lists = [&]() { return list_serializer.deserialize_text(lists_text, lists.size())->size(); };
+    runner.measure("lists: DOM", count, dom_lists);
+    runner.measure("lists: SAX text", count, sax_lists);
+    runner.report("lists peak: DOM", peak_megabytes(dom_lists), "MB");
+    runner.report("lists peak: SAX text", peak_megabytes(sax_lists), "MB");
+
+    std::filesystem::remove(strings_path);
+    return runner.finish();
+}
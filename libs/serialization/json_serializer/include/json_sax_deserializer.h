@@ -0,0 +1,281 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace wip::serialization {
+
+namespace detail {
+
+// Scalar value reported by the SAX parser
+struct JsonSaxScalar {
+    enum class Kind { Null, Boolean, Integer, Unsigned, Float, String, Binary };
+
+    Kind kind = Kind::Null;
+    bool boolean = false;
+    int64_t integer = 0;
+    uint64_t unsigned_integer = 0;
+    double floating = 0.0;
+    const std::string* string = nullptr;
+};
+
+struct JsonSaxType;
+
+// Object a value is read into, with the description of its type
+struct JsonSaxSlot {
+    void* object = nullptr;
+    const JsonSaxType* type = nullptr;
+};
+
+// How the SAX handler fills one C++ type; one static instance per type
+struct JsonSaxType {
+    enum class Kind { Scalar, Array, Object };
+
+    Kind kind;
+
+    // Scalar: store value, false if it has the wrong type
+    bool (*assign)(void* object, const JsonSaxScalar& value);
+
+    // Array / Object: add a default element (under key for objects) and return it
+    JsonSaxSlot (*add_element)(void* container, const std::string& key);
+
+    // Array: reset the element last added after it failed to read
+    void (*discard_element)(void* container);
+
+    // Array / Object: capacity hint for the elements to come
+    void (*reserve)(void* container, size_t size);
+};
+
+/**
+ * @brief nlohmann SAX handler that builds containers in place
+ *
+ * Follows the rules of the DOM based JsonSerializer: an array element that
+ * can't be read becomes a default element, while an object value that can't
+ * be read fails the whole object.
+ */
+class JsonSaxBuilder {
+public:
+    /**
+     * @param root Object receiving the document
+     * @param reserve_hint Capacity reserved for the root container when the input doesn't tell its size
+     */
+    JsonSaxBuilder(JsonSaxSlot root, size_t reserve_hint);
+
+    bool null();
+    bool boolean(bool value);
+    bool number_integer(nlohmann::json::number_integer_t value);
+    bool number_unsigned(nlohmann::json::number_unsigned_t value);
+    bool number_float(nlohmann::json::number_float_t value, const std::string& text);
+    bool string(std::string& value);
+    bool binary(nlohmann::json::binary_t& value);
+    bool start_object(size_t size);
+    bool key(std::string& value);
+    bool end_object();
+    bool start_array(size_t size);
+    bool end_array();
+    bool parse_error(size_t position, const std::string& last_token, const nlohmann::json::exception& error);
+
+    /**
+     * @brief True if the document was well-formed and had the expected type
+     */
+    bool succeeded() const { return !syntax_error_ && !root_failed_; }
+
+private:
+    struct Frame {
+        void* container;
+        const JsonSaxType* type;
+        std::string key;        // Key of the next value, objects only
+        bool failed = false;    // Remaining values are ignored
+    };
+
+    // Slot of the next value; false if it is inside a failed object
+    bool next_slot(JsonSaxSlot& slot);
+    bool scalar(const JsonSaxScalar& value);
+    bool start_container(JsonSaxType::Kind kind, size_t size);
+    bool end_container();
+    void value_failed();
+
+    std::vector<Frame> frames_;
+    JsonSaxSlot root_;
+    size_t reserve_hint_;
+    size_t skip_depth_ = 0;     // Depth inside a container that is being ignored
+    bool root_failed_ = false;
+    bool syntax_error_ = false;
+};
+
+template<typename T>
+struct IsJsonSaxLeaf
+    : std::bool_constant<std::is_same_v<T, std::string> || std::is_same_v<T, int> || std::is_same_v<T, double> ||
+                         std::is_same_v<T, bool>> {};
+
+template<typename T>
+bool assign_json_sax_scalar(void* object, const JsonSaxScalar& value) {
+    using Kind = JsonSaxScalar::Kind;
+    T& target = *static_cast<T*>(object);
+
+    if constexpr (std::is_same_v<T, bool>) {
+        if (value.kind != Kind::Boolean) {
+            return false;
+        }
+        target = value.boolean;
+    } else if constexpr (std::is_same_v<T, int>) {
+        if (value.kind == Kind::Integer) {
+            target = static_cast<int>(value.integer);
+        } else if (value.kind == Kind::Unsigned) {
+            target = static_cast<int>(value.unsigned_integer);
+        } else {
+            return false;
+        }
+    } else if constexpr (std::is_same_v<T, double>) {
+        if (value.kind == Kind::Float) {
+            target = value.floating;
+        } else if (value.kind == Kind::Integer) {
+            target = static_cast<double>(value.integer);
+        } else if (value.kind == Kind::Unsigned) {
+            target = static_cast<double>(value.unsigned_integer);
+        } else {
+            return false;
+        }
+    } else {
+        if (value.kind != Kind::String) {
+            return false;
+        }
+        // A copy is sized to fit, and the parser keeps reusing its token buffer
+        target.assign(*value.string);
+    }
+    return true;
+}
+
+template<typename T>
+struct JsonSaxTraits {
+    static_assert(IsJsonSaxLeaf<T>::value,
+                  "SAX deserialization supports std::string, int, double, bool and vectors / maps of them");
+
+    static constexpr JsonSaxType type{JsonSaxType::Kind::Scalar, &assign_json_sax_scalar<T>, nullptr, nullptr,
+                                      nullptr};
+};
+
+template<typename T>
+struct JsonSaxTraits<std::vector<T>> {
+    static JsonSaxSlot add_element(void* container, const std::string&) {
+        auto& elements = *static_cast<std::vector<T>*>(container);
+        elements.emplace_back();
+        return {&elements.back(), &JsonSaxTraits<T>::type};
+    }
+
+    static void discard_element(void* container) {
+        static_cast<std::vector<T>*>(container)->back() = T{};
+    }
+
+    static void reserve(void* container, size_t size) {
+        static_cast<std::vector<T>*>(container)->reserve(size);
+    }
+
+    static constexpr JsonSaxType type{JsonSaxType::Kind::Array, nullptr, &add_element, &discard_element, &reserve};
+};
+
+// Elements of std::vector<bool> have no address, so they are assigned through the vector
+template<>
+struct JsonSaxTraits<std::vector<bool>> {
+    static bool assign_last(void* container, const JsonSaxScalar& value) {
+        bool element = false;
+        if (!assign_json_sax_scalar<bool>(&element, value)) {
+            return false;
+        }
+        static_cast<std::vector<bool>*>(container)->back() = element;
+        return true;
+    }
+
+    static JsonSaxSlot add_element(void* container, const std::string&) {
+        static_cast<std::vector<bool>*>(container)->push_back(false);
+        return {container, &element_type};
+    }
+
+    static void discard_element(void* container) {
+        static_cast<std::vector<bool>*>(container)->back() = false;
+    }
+
+    static void reserve(void* container, size_t size) {
+        static_cast<std::vector<bool>*>(container)->reserve(size);
+    }
+
+    static constexpr JsonSaxType element_type{JsonSaxType::Kind::Scalar, &assign_last, nullptr, nullptr, nullptr};
+    static constexpr JsonSaxType type{JsonSaxType::Kind::Array, nullptr, &add_element, &discard_element, &reserve};
+};
+
+template<typename Map>
+struct JsonSaxMapTraits {
+    using Value = typename Map::mapped_type;
+
+    static JsonSaxSlot add_element(void* container, const std::string& key) {
+        // A repeated key replaces the earlier value, as in the DOM
+        Value& value = (*static_cast<Map*>(container))[key];
+        value = Value{};
+        return {&value, &JsonSaxTraits<Value>::type};
+    }
+
+    static void reserve(void* container, size_t size) {
+        if constexpr (std::is_same_v<Map, std::unordered_map<std::string, Value>>) {
+            static_cast<Map*>(container)->reserve(size);
+        }
+    }
+
+    static constexpr JsonSaxType type{JsonSaxType::Kind::Object, nullptr, &add_element, nullptr, &reserve};
+};
+
+template<typename T>
+struct JsonSaxTraits<std::unordered_map<std::string, T>> : JsonSaxMapTraits<std::unordered_map<std::string, T>> {};
+
+template<typename T>
+struct JsonSaxTraits<std::map<std::string, T>> : JsonSaxMapTraits<std::map<std::string, T>> {};
+
+template<typename T, typename Input>
+std::optional<T> sax_deserialize(Input&& input, nlohmann::json::input_format_t format, size_t reserve_hint) {
+    T result{};
+    JsonSaxBuilder builder({&result, &JsonSaxTraits<T>::type}, reserve_hint);
+    if (!nlohmann::json::sax_parse(std::forward<Input>(input), &builder, format) || !builder.succeeded()) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+} // namespace detail
+
+/**
+ * @brief Deserialize JSON text straight into a container, without building a DOM
+ *
+ * Gives the same result as parsing text and calling JsonSerializer<T>::deserialize,
+ * but elements are constructed in place, so the peak memory is about the size of
+ * the result. T is std::string, int, double, bool, or a std::vector /
+ * std::unordered_map / std::map with string keys of those, nested to any depth.
+ *
+ * @param reserve_hint Expected element count of the top-level container
+ * @return Deserialized data or nullopt if the text is malformed or has another type
+ */
+template<typename T>
+std::optional<T> deserialize_json_text(std::string_view text, size_t reserve_hint = 0) {
+    return detail::sax_deserialize<T>(text, nlohmann::json::input_format_t::json, reserve_hint);
+}
+
+/**
+ * @brief Deserialize a JSON file as deserialize_json_text() does, reading it as a stream
+ */
+template<typename T>
+std::optional<T> deserialize_json_file(const std::filesystem::path& path, size_t reserve_hint = 0) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return std::nullopt;
+    }
+    return detail::sax_deserialize<T>(file, nlohmann::json::input_format_t::json, reserve_hint);
+}
+
+} // namespace wip::serialization
@@ -5,6 +5,7 @@
 #include <vector>
 #include <string>
 #include "serializer.h"
+#include "json_sax_deserializer.h"
 
 namespace wip::serialization {
 
@@ -60,6 +61,20 @@ public:
                        [](const nlohmann::json& element) { return JsonSerializer<T>().deserialize(element).value_or(T{}); });
         return result;
     }
+
+    /**
+     * @brief deserialize JSON text without building a DOM, see deserialize_json_text()
+     */
+    DeserializeResult deserialize_text(std::string_view text, size_t reserve_hint = 0) const {
+        return deserialize_json_text<std::vector<T>>(text, reserve_hint);
+    }
+
+    /**
+     * @brief deserialize a JSON file without building a DOM, see deserialize_json_file()
+     */
+    DeserializeResult deserialize_file(const std::filesystem::path& path, size_t reserve_hint = 0) const {
+        return deserialize_json_file<std::vector<T>>(path, reserve_hint);
+    }
 };
 
 // Partial specialization for std::unordered_map<std::string, T>
@@ -87,10 +102,24 @@ public:
             if (!deserialized_value) {
                 return std::nullopt;
             }
-            result[key] = *deserialized_value;
+            result[key] = std::move(*deserialized_value);
         }
         return result;
     }
+
+    /**
+     * @brief deserialize JSON text without building a DOM, see deserialize_json_text()
+     */
+    DeserializeResult deserialize_text(std::string_view text, size_t reserve_hint = 0) const {
+        return deserialize_json_text<std::unordered_map<std::string, T>>(text, reserve_hint);
+    }
+
+    /**
+     * @brief deserialize a JSON file without building a DOM, see deserialize_json_file()
+     */
+    DeserializeResult deserialize_file(const std::filesystem::path& path, size_t reserve_hint = 0) const {
+        return deserialize_json_file<std::unordered_map<std::string, T>>(path, reserve_hint);
+    }
 };
 
 // Partial specialization for std::map<std::string, T>
@@ -118,9 +147,23 @@ public:
             if (!deserialized_value) {
                 return std::nullopt;
             }
-            result[key] = *deserialized_value;
+            result[key] = std::move(*deserialized_value);
         }
         return result;
     }
+
+    /**
+     * @brief deserialize JSON text without building a DOM, see deserialize_json_text()
+     */
+    DeserializeResult deserialize_text(std::string_view text, size_t reserve_hint = 0) const {
+        return deserialize_json_text<std::map<std::string, T>>(text, reserve_hint);
+    }
+
+    /**
+     * @brief deserialize a JSON file without building a DOM, see deserialize_json_file()
+     */
+    DeserializeResult deserialize_file(const std::filesystem::path& path, size_t reserve_hint = 0) const {
+        return deserialize_json_file<std::map<std::string, T>>(path, reserve_hint);
+    }
 };
 }  // namespace wip::serialization
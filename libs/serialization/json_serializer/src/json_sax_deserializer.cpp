@@ -0,0 +1,160 @@
+#include "json_sax_deserializer.h"
+
+namespace wip::serialization::detail {
+
+JsonSaxBuilder::JsonSaxBuilder(JsonSaxSlot root, size_t reserve_hint)
+    : root_(root), reserve_hint_(reserve_hint) {}
+
+bool JsonSaxBuilder::next_slot(JsonSaxSlot& slot) {
+    if (frames_.empty()) {
+        slot = root_;
+        return true;
+    }
+    Frame& frame = frames_.back();
+    if (frame.failed) {
+        return false;
+    }
+    slot = frame.type->add_element(frame.container, frame.key);
+    return true;
+}
+
+void JsonSaxBuilder::value_failed() {
+    if (frames_.empty()) {
+        root_failed_ = true;
+        return;
+    }
+    Frame& frame = frames_.back();
+    if (frame.type->kind == JsonSaxType::Kind::Array) {
+        frame.type->discard_element(frame.container);
+    } else {
+        frame.failed = true;
+    }
+}
+
+bool JsonSaxBuilder::scalar(const JsonSaxScalar& value) {
+    if (skip_depth_ > 0) {
+        return true;
+    }
+    JsonSaxSlot slot;
+    if (!next_slot(slot)) {
+        return true;
+    }
+    if (slot.type->kind != JsonSaxType::Kind::Scalar || !slot.type->assign(slot.object, value)) {
+        value_failed();
+    }
+    return true;
+}
+
+bool JsonSaxBuilder::start_container(JsonSaxType::Kind kind, size_t size) {
+    if (skip_depth_ > 0) {
+        ++skip_depth_;
+        return true;
+    }
+    JsonSaxSlot slot;
+    if (!next_slot(slot)) {
+        skip_depth_ = 1;
+        return true;
+    }
+    if (slot.type->kind != kind) {
+        value_failed();
+        skip_depth_ = 1;
+        return true;
+    }
+
+    // Binary formats tell the element count; for text only the caller's hint applies to the root
+    if (size != static_cast<size_t>(-1)) {
+        slot.type->reserve(slot.object, size);
+    } else if (frames_.empty() && reserve_hint_ > 0) {
+        slot.type->reserve(slot.object, reserve_hint_);
+    }
+    frames_.push_back({slot.object, slot.type, {}, false});
+    return true;
+}
+
+bool JsonSaxBuilder::end_container() {
+    if (skip_depth_ > 0) {
+        --skip_depth_;
+        return true;
+    }
+    const bool failed = frames_.back().failed;
+    frames_.pop_back();
+    if (failed) {
+        value_failed();
+    }
+    return true;
+}
+
+bool JsonSaxBuilder::null() {
+    return scalar({});
+}
+
+bool JsonSaxBuilder::boolean(bool value) {
+    JsonSaxScalar scalar_value;
+    scalar_value.kind = JsonSaxScalar::Kind::Boolean;
+    scalar_value.boolean = value;
+    return scalar(scalar_value);
+}
+
+bool JsonSaxBuilder::number_integer(nlohmann::json::number_integer_t value) {
+    JsonSaxScalar scalar_value;
+    scalar_value.kind = JsonSaxScalar::Kind::Integer;
+    scalar_value.integer = value;
+    return scalar(scalar_value);
+}
+
+bool JsonSaxBuilder::number_unsigned(nlohmann::json::number_unsigned_t value) {
+    JsonSaxScalar scalar_value;
+    scalar_value.kind = JsonSaxScalar::Kind::Unsigned;
+    scalar_value.unsigned_integer = value;
+    return scalar(scalar_value);
+}
+
+bool JsonSaxBuilder::number_float(nlohmann::json::number_float_t value, const std::string&) {
+    JsonSaxScalar scalar_value;
+    scalar_value.kind = JsonSaxScalar::Kind::Float;
+    scalar_value.floating = value;
+    return scalar(scalar_value);
+}
+
+bool JsonSaxBuilder::string(std::string& value) {
+    JsonSaxScalar scalar_value;
+    scalar_value.kind = JsonSaxScalar::Kind::String;
+    scalar_value.string = &value;
+    return scalar(scalar_value);
+}
+
+bool JsonSaxBuilder::binary(nlohmann::json::binary_t&) {
+    JsonSaxScalar scalar_value;
+    scalar_value.kind = JsonSaxScalar::Kind::Binary;
+    return scalar(scalar_value);
+}
+
+bool JsonSaxBuilder::start_object(size_t size) {
+    return start_container(JsonSaxType::Kind::Object, size);
+}
+
+bool JsonSaxBuilder::key(std::string& value) {
+    if (skip_depth_ == 0) {
+        frames_.back().key = std::move(value);
+    }
+    return true;
+}
+
+bool JsonSaxBuilder::end_object() {
+    return end_container();
+}
+
+bool JsonSaxBuilder::start_array(size_t size) {
+    return start_container(JsonSaxType::Kind::Array, size);
+}
+
+bool JsonSaxBuilder::end_array() {
+    return end_container();
+}
+
+bool JsonSaxBuilder::parse_error(size_t, const std::string&, const nlohmann::json::exception&) {
+    syntax_error_ = true;
+    return false;
+}
+
+} // namespace wip::serialization::detail
@@ -1,5 +1,7 @@
 #include "json_serializer.h"
 #include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
 #include <unordered_map>
 #include <map>
 #include <vector>
@@ -249,3 +251,72 @@ TEST(JsonSerializerContainerTest, MapOfVectorSerializeDeserialize) {
     EXPECT_TRUE(deserialized.has_value());
     EXPECT_EQ(deserialized.value(), original);
 }
+
+// SAX deserialization tests
+
+namespace {
+
+// The SAX path must give what parsing and deserializing the DOM gives
+template<typename T>
+void expect_same_as_dom(const std::string& text) {
+    auto dom = JsonSerializer<T>().deserialize(nlohmann::json::parse(text));
+    auto sax = deserialize_json_text<T>(text);
+    ASSERT_EQ(sax.has_value(), dom.has_value()) << text;
+    if (dom) {
+        EXPECT_EQ(*sax, *dom) << text;
+    }
+}
+
+} // namespace
+
+TEST(JsonSerializerSaxTest, MatchesDomDeserialization) {
+    expect_same_as_dom<std::vector<int>>(R"([1, -2, 3000000000, 4.5, "x", null, [1], {"a": 1}])");
+    expect_same_as_dom<std::vector<double>>(R"([1, -2.5, 1e300, true])");
+    expect_same_as_dom<std::vector<bool>>(R"([true, false, 0])");
+    expect_same_as_dom<std::vector<std::string>>(R"(["a", "", "\u00e9\n", 5, {"nested": ["x"]}])");
+    expect_same_as_dom<std::vector<std::vector<int>>>(R"([[1, 2], [], "bad", [3, "x"], {"a": [1]}])");
+    expect_same_as_dom<std::map<std::string, std::vector<int>>>(R"({"a": [1, 2], "b": [], "c": [3, [4]]})");
+    expect_same_as_dom<std::map<std::string, int>>(R"({"a": 1, "b": "two", "c": 3})");
+    expect_same_as_dom<std::unordered_map<std::string, std::string>>(R"({"k": "v", "k": "last", "e": ""})");
+    expect_same_as_dom<std::vector<std::map<std::string, int>>>(R"([{"a": 1}, {"b": "x", "c": [1, 2]}, {}])");
+    expect_same_as_dom<std::vector<int>>(R"({"a": 1})");
+    expect_same_as_dom<std::map<std::string, int>>(R"([1, 2])");
+    expect_same_as_dom<std::vector<int>>("[]");
+}
+
+TEST(JsonSerializerSaxTest, RejectsMalformedText) {
+    EXPECT_FALSE(deserialize_json_text<std::vector<int>>("[1, 2").has_value());
+    EXPECT_FALSE(deserialize_json_text<std::vector<int>>("[1, 2] trailing").has_value());
+    EXPECT_FALSE((deserialize_json_text<std::map<std::string, int>>("").has_value()));
+    EXPECT_FALSE(deserialize_json_text<std::vector<std::string>>("\"text\"").has_value());
+}
+
+TEST(JsonSerializerSaxTest, SerializerMembersAndFiles) {
+    JsonSerializer<std::unordered_map<std::string, std::vector<std::string>>> serializer;
+    std::unordered_map<std::string, std::vector<std::string>> original = {
+        {"src", {"a.cpp", "b.cpp"}}, {"include", {"a.h"}}, {"empty", {}}};
+    const std::string text = serializer.serialize(original).dump();
+
+    auto from_text = serializer.deserialize_text(text, original.size());
+    ASSERT_TRUE(from_text.has_value());
+    EXPECT_EQ(*from_text, original);
+
+    auto path = std::filesystem::temp_directory_path() / "json_serializer_sax_test.json";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << text;
+    }
+    auto from_file = serializer.deserialize_file(path);
+    std::filesystem::remove(path);
+    ASSERT_TRUE(from_file.has_value());
+    EXPECT_EQ(*from_file, original);
+
+    EXPECT_FALSE(serializer.deserialize_file(path).has_value());
+}
+
+TEST(JsonSerializerSaxTest, ReservesHintedCapacity) {
+    auto values = JsonSerializer<std::vector<int>>().deserialize_text("[1, 2, 3]", 1000);
+    ASSERT_TRUE(values.has_value());
+    EXPECT_EQ(values->size(), 3u);
+    EXPECT_GE(values->capacity(), 1000u);
+}
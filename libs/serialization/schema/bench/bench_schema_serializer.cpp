@@ -0,0 +1,109 @@
+// Benchmark for the schema serializer.
+//
+// Serializes a list of records declared with WIP_SCHEMA through the
+// nlohmann DOM (write_json followed by to_msgpack, and from_msgpack followed
+// by read_json) and directly with write_binary / read_binary, which skip the
+// DOM. JSON text is measured for reference. Usage:
+//
+//   bench_wip_serialization_schema [record-count]
+//
+// The default is one hundred thousand records.
+
+#include "benchmark.h"
+#include "schema_serializer.h"
+#include <string>
+#include <vector>
+
+using namespace wip::serialization;
+
+namespace bench_types {
+
+enum class Severity { Info, Warning, Error };
+
+struct Location {
+    std::string file;
+    int line = 0;
+    int column = 0;
+};
+WIP_SCHEMA(Location, WIP_FIELD(file), WIP_FIELD(line), WIP_FIELD(column))
+
+struct Record {
+    std::string id;
+    std::string message;
+    Severity severity = Severity::Info;
+    double confidence = 0.0;
+    bool suppressed = false;
+    Location location;
+    std::vector<std::string> tags;
+};
+WIP_SCHEMA(Record, WIP_FIELD(id), WIP_FIELD(message), WIP_FIELD(severity), WIP_FIELD(confidence),
+           WIP_FIELD(suppressed), WIP_FIELD(location), WIP_FIELD(tags))
+
+} // namespace bench_types
+
+using namespace bench_types;
+
+namespace {
+
+constexpr size_t DEFAULT_RECORD_COUNT = 100000;
+
+std::vector<Record> generate_records(size_t count) {
+    std::vector<Record> records(count);
+    for (size_t i = 0; i < count; ++i) {
+        Record& record = records[i];
+        record.id = "rule" + std::to_string(i % 150);
+        record.message = "Variable 'value" + std::to_string(i % 40) + "' is assigned a value that is never used";
+        record.severity = static_cast<Severity>(i % 3);
+        record.confidence = static_cast<double>(i % 100) / 100.0;
+        record.suppressed = i % 11 == 0;
+        record.location = {"/home/user/project/src/file_" + std::to_string(i % 2000) + ".cpp",
+                           static_cast<int>(i % 5000 + 1), static_cast<int>(i % 80 + 1)};
+        record.tags = {"style", "unused"};
+    }
+    return records;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    wip::benchmark::Runner runner("bench_wip_serialization_schema", argc, argv, "[record-count]");
+    size_t count = runner.argument(0, DEFAULT_RECORD_COUNT);
+    const std::vector<Record> records = generate_records(count);
+    runner.out() << "Serializing " << count << " records" << std::endl;
+
+    runner.measure("write: DOM + to_msgpack", count, [&]() {
+        return nlohmann::json::to_msgpack(write_json(records)).size();
+    });
+
+    std::string buffer;
+    runner.measure("write: direct binary", count, [&]() {
+        buffer.clear();
+        to_binary(records, buffer);
+        return buffer.size();
+    });
+    runner.report("binary size", static_cast<double>(buffer.size()) / static_cast<double>(count), "bytes/record");
+
+    const std::string text = write_json(records).dump();
+    runner.measure("write: DOM + JSON dump", count, [&]() { return write_json(records).dump().size(); });
+    runner.report("JSON size", static_cast<double>(text.size()) / static_cast<double>(count), "bytes/record");
+
+    runner.measure("read: from_msgpack + DOM", count, [&]() {
+        std::vector<Record> read;
+        read_json(nlohmann::json::from_msgpack(buffer), read);
+        return read.size();
+    });
+
+    runner.measure("read: direct binary", count, [&]() {
+        std::vector<Record> read;
+        from_binary(buffer, read);
+        return read.size();
+    });
+
+    runner.measure("read: JSON parse + DOM", count, [&]() {
+        std::vector<Record> read;
+        read_json(nlohmann::json::parse(text), read);
+        return read.size();
+    });
+
+    return runner.finish();
+}
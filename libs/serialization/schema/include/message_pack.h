@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace wip::serialization {
+
+/**
+ * @brief Appends MessagePack values to a byte buffer
+ *
+ * Every value goes straight into the caller's buffer in its smallest
+ * encoding; no document is built. Reusing one buffer across messages keeps
+ * serialization free of allocations once it has grown.
+ */
+class MessagePackWriter {
+public:
+    /**
+     * @param out Buffer the values are appended to; must outlive the writer
+     */
+    explicit MessagePackWriter(std::string& out) : out_(out) {}
+
+    void write_nil();
+    void write_bool(bool value);
+    void write_int(int64_t value);
+    void write_uint(uint64_t value);
+    void write_double(double value);
+    void write_string(std::string_view value);
+
+    /**
+     * @brief Start an array; the next size values are its elements
+     */
+    void write_array_header(size_t size);
+
+    /**
+     * @brief Start a map; the next 2 * size values are its keys and values
+     */
+    void write_map_header(size_t size);
+
+    std::string& buffer() { return out_; }
+
+private:
+    void put_big_endian(uint8_t marker, uint64_t value, size_t bytes);
+
+    std::string& out_;
+};
+
+/**
+ * @brief Reads MessagePack values from a byte buffer without copying
+ *
+ * A read whose value has another type, or that runs past the end of the
+ * data, returns false and consumes nothing, so the caller can skip() the
+ * value instead. Strings are returned as views of the buffer.
+ */
+class MessagePackReader {
+public:
+    enum class Type {
+        Nil,
+        Bool,
+        Integer,
+        Float,
+        String,
+        Binary,
+        Array,
+        Map,
+        Extension,
+        Invalid         ///< Reserved marker or end of data
+    };
+
+    explicit MessagePackReader(std::string_view data) : data_(data) {}
+
+    /**
+     * @brief Get the type of the next value without consuming it
+     */
+    Type peek() const;
+
+    bool read_nil();
+    bool read_bool(bool& value);
+
+    /**
+     * @brief Read an integer that fits int64_t
+     */
+    bool read_int(int64_t& value);
+
+    /**
+     * @brief Read a non-negative integer
+     */
+    bool read_uint(uint64_t& value);
+
+    /**
+     * @brief Read a float or double, or an integer converted to double
+     */
+    bool read_double(double& value);
+
+    bool read_string(std::string_view& value);
+    bool read_array_header(size_t& size);
+    bool read_map_header(size_t& size);
+
+    /**
+     * @brief Skip the next value, including everything nested in it
+     * @return False if the data ends inside the value or holds a reserved marker
+     */
+    bool skip();
+
+    bool at_end() const { return position_ >= data_.size(); }
+    size_t position() const { return position_; }
+    size_t remaining() const { return data_.size() - position_; }
+
+    /**
+     * @brief Move back to a position returned by position()
+     */
+    void seek(size_t position) { position_ = position; }
+
+private:
+    // Reads the length of an array or map header; header receives the bytes it takes
+    bool read_container(uint8_t fix_first, uint8_t marker16, uint8_t marker32, size_t& size, size_t& header) const;
+    uint64_t get_big_endian(size_t offset, size_t bytes) const;
+    bool available(size_t bytes) const { return data_.size() - position_ >= bytes; }
+
+    std::string_view data_;
+    size_t position_ = 0;
+};
+
+} // namespace wip::serialization
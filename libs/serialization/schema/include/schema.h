@@ -0,0 +1,93 @@
+#pragma once
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace wip::serialization {
+
+/**
+ * @brief One serialized member of a schema type
+ *
+ * Created by WIP_FIELD / WIP_FIELD_AS inside WIP_SCHEMA.
+ */
+template<typename Class, typename Member>
+struct Field {
+    const char* name;
+    Member Class::* member;
+};
+
+template<typename Class, typename Member>
+constexpr Field<Class, Member> field(const char* name, Member Class::* member) {
+    return Field<Class, Member>{name, member};
+}
+
+namespace detail {
+
+struct NoSchema {};
+
+// Chosen only when argument-dependent lookup finds no WIP_SCHEMA for the type
+NoSchema wip_schema_fields(...);
+
+template<typename T>
+using SchemaFields = decltype(wip_schema_fields(static_cast<const T*>(nullptr)));
+
+template<typename T>
+constexpr auto get_schema_fields() {
+    return wip_schema_fields(static_cast<const T*>(nullptr));
+}
+
+} // namespace detail
+
+/**
+ * @brief True if T has a schema declared with WIP_SCHEMA
+ */
+template<typename T>
+inline constexpr bool has_schema_v = !std::is_same_v<detail::SchemaFields<T>, detail::NoSchema>;
+
+/**
+ * @brief Call visitor with every Field of T's schema, in declaration order
+ */
+template<typename T, typename Visitor>
+constexpr void for_each_field(Visitor&& visitor) {
+    static_assert(has_schema_v<T>, "Type has no WIP_SCHEMA declaration");
+    std::apply([&visitor](const auto&... fields) { (visitor(fields), ...); }, detail::get_schema_fields<T>());
+}
+
+/**
+ * @brief Get the number of fields of T's schema
+ */
+template<typename T>
+constexpr size_t field_count() {
+    return std::tuple_size_v<detail::SchemaFields<T>>;
+}
+
+} // namespace wip::serialization
+
+/**
+ * @brief Declare the serialized fields of a type
+ *
+ * Must appear in the namespace of the type (for a nested type, the namespace
+ * of the outermost class), where argument-dependent lookup finds it. Fields
+ * are written in the order given, and a reader keeps the default of every
+ * field that is missing or has the wrong type.
+ *
+ * Usage:
+ * ```cpp
+ * namespace app {
+ * struct Point { int x = 0; std::string label; };
+ * WIP_SCHEMA(Point, WIP_FIELD(x), WIP_FIELD_AS(label, "name"))
+ * }
+ * ```
+ */
+#define WIP_SCHEMA(TYPE, ...)                                      \
+    [[maybe_unused]] constexpr auto wip_schema_fields(const TYPE*) { \
+        using SchemaType = TYPE;                                   \
+        return std::make_tuple(__VA_ARGS__);                       \
+    }
+
+/// Field serialized under the member's own name
+#define WIP_FIELD(MEMBER) ::wip::serialization::field(#MEMBER, &SchemaType::MEMBER)
+
+/// Field serialized under another name, e.g. to keep an old file key
+#define WIP_FIELD_AS(MEMBER, NAME) ::wip::serialization::field(NAME, &SchemaType::MEMBER)
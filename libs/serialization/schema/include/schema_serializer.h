@@ -0,0 +1,468 @@
+#pragma once
+
+#include <limits>
+#include <map>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include "message_pack.h"
+#include "schema.h"
+#include "serializer.h"
+
+namespace wip::serialization {
+
+/**
+ * Serializers generated from a WIP_SCHEMA declaration.
+ *
+ * Supported members are bool, enums (stored as their integer value), other
+ * integral and floating point types, std::string, std::vector, std::optional,
+ * std::map / std::unordered_map with string keys, and other schema types.
+ * Schema types are written as maps keyed by field name, so the JSON and the
+ * binary form hold the same document and can be converted into each other
+ * (nlohmann::json::to_msgpack / from_msgpack).
+ *
+ * Readers keep the current value of every field that is missing or has the
+ * wrong type, and ignore keys they don't know, so files written by older and
+ * newer versions of a type stay readable.
+ */
+
+namespace detail {
+
+template<typename T>
+struct IsVector : std::false_type {};
+template<typename T, typename Allocator>
+struct IsVector<std::vector<T, Allocator>> : std::true_type {};
+
+template<typename T>
+struct IsOptional : std::false_type {};
+template<typename T>
+struct IsOptional<std::optional<T>> : std::true_type {};
+
+template<typename T>
+struct IsStringMap : std::false_type {};
+template<typename T, typename Compare, typename Allocator>
+struct IsStringMap<std::map<std::string, T, Compare, Allocator>> : std::true_type {};
+template<typename T, typename Hash, typename Equal, typename Allocator>
+struct IsStringMap<std::unordered_map<std::string, T, Hash, Equal, Allocator>> : std::true_type {};
+
+template<typename T>
+inline constexpr bool is_integer_v = std::is_integral_v<T> && !std::is_same_v<T, bool>;
+
+template<typename T>
+inline constexpr bool is_supported_v = std::is_same_v<T, bool> || std::is_enum_v<T> || is_integer_v<T> ||
+                                       std::is_floating_point_v<T> || std::is_same_v<T, std::string> ||
+                                       IsVector<T>::value || IsOptional<T>::value || IsStringMap<T>::value ||
+                                       has_schema_v<T>;
+
+template<typename T, typename Value>
+bool integer_fits(Value value) {
+    if constexpr (std::is_signed_v<Value>) {
+        if (value < 0) {
+            return std::is_signed_v<T> && value >= static_cast<Value>(std::numeric_limits<T>::min());
+        }
+    }
+    return static_cast<std::make_unsigned_t<Value>>(value) <=
+           static_cast<std::make_unsigned_t<T>>(std::numeric_limits<T>::max());
+}
+
+} // namespace detail
+
+// ==================== Binary (MessagePack) ====================
+
+/**
+ * @brief Append value to writer's buffer
+ */
+template<typename T>
+void write_binary(MessagePackWriter& writer, const T& value) {
+    static_assert(detail::is_supported_v<T>, "Type is not supported by the schema serializer");
+
+    if constexpr (std::is_same_v<T, bool>) {
+        writer.write_bool(value);
+    } else if constexpr (std::is_enum_v<T>) {
+        writer.write_int(static_cast<int64_t>(value));
+    } else if constexpr (detail::is_integer_v<T>) {
+        if constexpr (std::is_signed_v<T>) {
+            writer.write_int(value);
+        } else {
+            writer.write_uint(value);
+        }
+    } else if constexpr (std::is_floating_point_v<T>) {
+        writer.write_double(static_cast<double>(value));
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        writer.write_string(value);
+    } else if constexpr (detail::IsVector<T>::value) {
+        writer.write_array_header(value.size());
+        for (const auto& element : value) {
+            write_binary(writer, element);
+        }
+    } else if constexpr (detail::IsOptional<T>::value) {
+        if (value) {
+            write_binary(writer, *value);
+        } else {
+            writer.write_nil();
+        }
+    } else if constexpr (detail::IsStringMap<T>::value) {
+        writer.write_map_header(value.size());
+        for (const auto& [key, element] : value) {
+            writer.write_string(key);
+            write_binary(writer, element);
+        }
+    } else {
+        writer.write_map_header(field_count<T>());
+        for_each_field<T>([&](const auto& field) {
+            writer.write_string(field.name);
+            write_binary(writer, value.*field.member);
+        });
+    }
+}
+
+/**
+ * @brief Read the next value of reader into value
+ * @return False if the next value has another type; the reader's position is
+ *         then unspecified, so callers seek back and skip(). Containers are
+ *         only replaced when all their elements could be read.
+ */
+template<typename T>
+bool read_binary(MessagePackReader& reader, T& value) {
+    static_assert(detail::is_supported_v<T>, "Type is not supported by the schema serializer");
+
+    if constexpr (std::is_same_v<T, bool>) {
+        return reader.read_bool(value);
+    } else if constexpr (std::is_enum_v<T>) {
+        int64_t integer = 0;
+        if (!reader.read_int(integer)) {
+            return false;
+        }
+        value = static_cast<T>(integer);
+        return true;
+    } else if constexpr (detail::is_integer_v<T>) {
+        if constexpr (std::is_signed_v<T>) {
+            int64_t integer = 0;
+            if (!reader.read_int(integer) || !detail::integer_fits<T>(integer)) {
+                return false;
+            }
+            value = static_cast<T>(integer);
+        } else {
+            uint64_t integer = 0;
+            if (!reader.read_uint(integer) || !detail::integer_fits<T>(integer)) {
+                return false;
+            }
+            value = static_cast<T>(integer);
+        }
+        return true;
+    } else if constexpr (std::is_floating_point_v<T>) {
+        double number = 0.0;
+        if (!reader.read_double(number)) {
+            return false;
+        }
+        value = static_cast<T>(number);
+        return true;
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        std::string_view text;
+        if (!reader.read_string(text)) {
+            return false;
+        }
+        value.assign(text.data(), text.size());
+        return true;
+    } else if constexpr (detail::IsVector<T>::value) {
+        size_t size = 0;
+        if (!reader.read_array_header(size)) {
+            return false;
+        }
+        // Each element takes at least one byte, which bounds the size of corrupt data
+        if (size > reader.remaining()) {
+            return false;
+        }
+        T result(size);
+        for (auto& element : result) {
+            if (!read_binary(reader, element)) {
+                return false;
+            }
+        }
+        value = std::move(result);
+        return true;
+    } else if constexpr (detail::IsOptional<T>::value) {
+        if (reader.read_nil()) {
+            value.reset();
+            return true;
+        }
+        typename T::value_type element{};
+        if (!read_binary(reader, element)) {
+            return false;
+        }
+        value = std::move(element);
+        return true;
+    } else if constexpr (detail::IsStringMap<T>::value) {
+        size_t size = 0;
+        if (!reader.read_map_header(size)) {
+            return false;
+        }
+        T result;
+        for (size_t i = 0; i < size; ++i) {
+            std::string_view key;
+            typename T::mapped_type element{};
+            if (!reader.read_string(key) || !read_binary(reader, element)) {
+                return false;
+            }
+            result[std::string(key)] = std::move(element);
+        }
+        value = std::move(result);
+        return true;
+    } else {
+        size_t size = 0;
+        if (!reader.read_map_header(size)) {
+            return false;
+        }
+        for (size_t i = 0; i < size; ++i) {
+            std::string_view key;
+            if (!reader.read_string(key)) {
+                // Not a key this schema can have
+                if (!reader.skip() || !reader.skip()) {
+                    return false;
+                }
+                continue;
+            }
+
+            bool known = false;
+            bool valid = true;
+            for_each_field<T>([&](const auto& field) {
+                if (known || key != field.name) {
+                    return;
+                }
+                known = true;
+                const size_t start = reader.position();
+                if (!read_binary(reader, value.*field.member)) {
+                    reader.seek(start);
+                    valid = reader.skip();
+                }
+            });
+            if (!known) {
+                valid = reader.skip();
+            }
+            if (!valid) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+/**
+ * @brief Append the binary form of value to out
+ */
+template<typename T>
+void to_binary(const T& value, std::string& out) {
+    MessagePackWriter writer(out);
+    write_binary(writer, value);
+}
+
+/**
+ * @brief Read value from the binary form produced by to_binary
+ * @return False if data is truncated or holds another type
+ */
+template<typename T>
+bool from_binary(std::string_view data, T& value) {
+    MessagePackReader reader(data);
+    return read_binary(reader, value);
+}
+
+// ==================== JSON ====================
+
+/**
+ * @brief Convert value to JSON
+ */
+template<typename T>
+nlohmann::json write_json(const T& value) {
+    static_assert(detail::is_supported_v<T>, "Type is not supported by the schema serializer");
+
+    if constexpr (std::is_enum_v<T>) {
+        return static_cast<int64_t>(value);
+    } else if constexpr (std::is_same_v<T, bool> || detail::is_integer_v<T> || std::is_floating_point_v<T> ||
+                         std::is_same_v<T, std::string>) {
+        return value;
+    } else if constexpr (detail::IsVector<T>::value) {
+        nlohmann::json result = nlohmann::json::array();
+        for (const auto& element : value) {
+            result.push_back(write_json(element));
+        }
+        return result;
+    } else if constexpr (detail::IsOptional<T>::value) {
+        return value ? write_json(*value) : nlohmann::json(nullptr);
+    } else if constexpr (detail::IsStringMap<T>::value) {
+        nlohmann::json result = nlohmann::json::object();
+        for (const auto& [key, element] : value) {
+            result[key] = write_json(element);
+        }
+        return result;
+    } else {
+        nlohmann::json result = nlohmann::json::object();
+        for_each_field<T>([&](const auto& field) { result[field.name] = write_json(value.*field.member); });
+        return result;
+    }
+}
+
+/**
+ * @brief Read value from JSON
+ * @return False if json has another type. Containers are only replaced when
+ *         all their elements could be read; schema types always succeed for
+ *         objects and keep the fields that could not be read.
+ */
+template<typename T>
+bool read_json(const nlohmann::json& json, T& value) {
+    static_assert(detail::is_supported_v<T>, "Type is not supported by the schema serializer");
+
+    if constexpr (std::is_same_v<T, bool>) {
+        if (!json.is_boolean()) {
+            return false;
+        }
+        value = json.get<bool>();
+        return true;
+    } else if constexpr (std::is_enum_v<T>) {
+        if (!json.is_number_integer()) {
+            return false;
+        }
+        value = static_cast<T>(json.get<int64_t>());
+        return true;
+    } else if constexpr (detail::is_integer_v<T>) {
+        if (json.is_number_unsigned()) {
+            const auto integer = json.get<uint64_t>();
+            if (!detail::integer_fits<T>(integer)) {
+                return false;
+            }
+            value = static_cast<T>(integer);
+            return true;
+        }
+        if (!json.is_number_integer()) {
+            return false;
+        }
+        const auto integer = json.get<int64_t>();
+        if (!detail::integer_fits<T>(integer)) {
+            return false;
+        }
+        value = static_cast<T>(integer);
+        return true;
+    } else if constexpr (std::is_floating_point_v<T>) {
+        if (!json.is_number()) {
+            return false;
+        }
+        value = json.get<T>();
+        return true;
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        if (!json.is_string()) {
+            return false;
+        }
+        value = json.get_ref<const std::string&>();
+        return true;
+    } else if constexpr (detail::IsVector<T>::value) {
+        if (!json.is_array()) {
+            return false;
+        }
+        T result(json.size());
+        for (size_t i = 0; i < result.size(); ++i) {
+            if (!read_json(json[i], result[i])) {
+                return false;
+            }
+        }
+        value = std::move(result);
+        return true;
+    } else if constexpr (detail::IsOptional<T>::value) {
+        if (json.is_null()) {
+            value.reset();
+            return true;
+        }
+        typename T::value_type element{};
+        if (!read_json(json, element)) {
+            return false;
+        }
+        value = std::move(element);
+        return true;
+    } else if constexpr (detail::IsStringMap<T>::value) {
+        if (!json.is_object()) {
+            return false;
+        }
+        T result;
+        for (const auto& [key, element] : json.items()) {
+            if (!read_json(element, result[key])) {
+                return false;
+            }
+        }
+        value = std::move(result);
+        return true;
+    } else {
+        if (!json.is_object()) {
+            return false;
+        }
+        for_each_field<T>([&](const auto& field) {
+            auto it = json.find(field.name);
+            if (it != json.end()) {
+                read_json(*it, value.*field.member);
+            }
+        });
+        return true;
+    }
+}
+
+// ==================== Serializer integration ====================
+
+/**
+ * @brief MessagePack document produced by Serializer<MessagePack, T>
+ */
+struct MessagePack {
+    std::string bytes;
+};
+
+/**
+ * @brief Binary serializer for every type supported by write_binary
+ */
+template<typename T>
+class Serializer<MessagePack, T> {
+public:
+    using DeserializeResult = std::optional<T>;
+
+    MessagePack serialize(const T& data) const {
+        MessagePack result;
+        to_binary(data, result.bytes);
+        return result;
+    }
+
+    DeserializeResult deserialize(const MessagePack& serialized_data) const {
+        T result{};
+        if (!from_binary(serialized_data.bytes, result)) {
+            return std::nullopt;
+        }
+        return result;
+    }
+};
+
+template<typename T>
+using MessagePackSerializer = Serializer<MessagePack, T>;
+
+/**
+ * @brief JSON serializer for a schema type, with the JsonSerializer interface
+ *
+ * A separate class because Serializer<nlohmann::json, T> is specialized per
+ * type by json_serializer.h.
+ */
+template<typename T>
+class SchemaJsonSerializer {
+public:
+    static_assert(has_schema_v<T>, "Type has no WIP_SCHEMA declaration");
+
+    using DeserializeResult = std::optional<T>;
+
+    nlohmann::json serialize(const T& data) const { return write_json(data); }
+
+    DeserializeResult deserialize(const nlohmann::json& serialized_data) const {
+        T result{};
+        if (!read_json(serialized_data, result)) {
+            return std::nullopt;
+        }
+        return result;
+    }
+};
+
+} // namespace wip::serialization
@@ -0,0 +1,441 @@
+#include "message_pack.h"
+#include <cstring>
+
+namespace wip::serialization {
+
+namespace {
+
+// Format markers, see https://github.com/msgpack/msgpack/blob/master/spec.md
+constexpr uint8_t FIXMAP = 0x80;
+constexpr uint8_t FIXARRAY = 0x90;
+constexpr uint8_t FIXSTR = 0xa0;
+constexpr uint8_t NIL = 0xc0;
+constexpr uint8_t FALSE = 0xc2;
+constexpr uint8_t TRUE = 0xc3;
+constexpr uint8_t BIN8 = 0xc4;
+constexpr uint8_t BIN16 = 0xc5;
+constexpr uint8_t BIN32 = 0xc6;
+constexpr uint8_t EXT8 = 0xc7;
+constexpr uint8_t EXT16 = 0xc8;
+constexpr uint8_t EXT32 = 0xc9;
+constexpr uint8_t FLOAT32 = 0xca;
+constexpr uint8_t FLOAT64 = 0xcb;
+constexpr uint8_t UINT8 = 0xcc;
+constexpr uint8_t UINT16 = 0xcd;
+constexpr uint8_t UINT32 = 0xce;
+constexpr uint8_t UINT64 = 0xcf;
+constexpr uint8_t INT8 = 0xd0;
+constexpr uint8_t INT16 = 0xd1;
+constexpr uint8_t INT32 = 0xd2;
+constexpr uint8_t INT64 = 0xd3;
+constexpr uint8_t FIXEXT1 = 0xd4;
+constexpr uint8_t FIXEXT16 = 0xd8;
+constexpr uint8_t STR8 = 0xd9;
+constexpr uint8_t STR16 = 0xda;
+constexpr uint8_t STR32 = 0xdb;
+constexpr uint8_t ARRAY16 = 0xdc;
+constexpr uint8_t ARRAY32 = 0xdd;
+constexpr uint8_t MAP16 = 0xde;
+constexpr uint8_t MAP32 = 0xdf;
+constexpr uint8_t NEGATIVE_FIXINT = 0xe0;
+
+// Payload bytes of the sized integer markers UINT8 .. INT64
+size_t integer_bytes(uint8_t marker) {
+    return size_t{1} << ((marker - UINT8) & 3);
+}
+
+} // namespace
+
+// ==================== MessagePackWriter ====================
+
+void MessagePackWriter::put_big_endian(uint8_t marker, uint64_t value, size_t bytes) {
+    char encoded[9];
+    encoded[0] = static_cast<char>(marker);
+    for (size_t i = 0; i < bytes; ++i) {
+        encoded[bytes - i] = static_cast<char>(value >> (8 * i));
+    }
+    out_.append(encoded, bytes + 1);
+}
+
+void MessagePackWriter::write_nil() {
+    out_ += static_cast<char>(NIL);
+}
+
+void MessagePackWriter::write_bool(bool value) {
+    out_ += static_cast<char>(value ? TRUE : FALSE);
+}
+
+void MessagePackWriter::write_int(int64_t value) {
+    if (value >= 0) {
+        write_uint(static_cast<uint64_t>(value));
+    } else if (value >= -32) {
+        out_ += static_cast<char>(value);
+    } else if (value >= INT8_MIN) {
+        put_big_endian(INT8, static_cast<uint64_t>(value), 1);
+    } else if (value >= INT16_MIN) {
+        put_big_endian(INT16, static_cast<uint64_t>(value), 2);
+    } else if (value >= INT32_MIN) {
+        put_big_endian(INT32, static_cast<uint64_t>(value), 4);
+    } else {
+        put_big_endian(INT64, static_cast<uint64_t>(value), 8);
+    }
+}
+
+void MessagePackWriter::write_uint(uint64_t value) {
+    if (value < 0x80) {
+        out_ += static_cast<char>(value);
+    } else if (value <= UINT8_MAX) {
+        put_big_endian(UINT8, value, 1);
+    } else if (value <= UINT16_MAX) {
+        put_big_endian(UINT16, value, 2);
+    } else if (value <= UINT32_MAX) {
+        put_big_endian(UINT32, value, 4);
+    } else {
+        put_big_endian(UINT64, value, 8);
+    }
+}
+
+void MessagePackWriter::write_double(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    put_big_endian(FLOAT64, bits, 8);
+}
+
+void MessagePackWriter::write_string(std::string_view value) {
+    const size_t size = value.size();
+    if (size < 32) {
+        out_ += static_cast<char>(FIXSTR | size);
+    } else if (size <= UINT8_MAX) {
+        put_big_endian(STR8, size, 1);
+    } else if (size <= UINT16_MAX) {
+        put_big_endian(STR16, size, 2);
+    } else {
+        put_big_endian(STR32, size, 4);
+    }
+    out_.append(value.data(), size);
+}
+
+void MessagePackWriter::write_array_header(size_t size) {
+    if (size < 16) {
+        out_ += static_cast<char>(FIXARRAY | size);
+    } else if (size <= UINT16_MAX) {
+        put_big_endian(ARRAY16, size, 2);
+    } else {
+        put_big_endian(ARRAY32, size, 4);
+    }
+}
+
+void MessagePackWriter::write_map_header(size_t size) {
+    if (size < 16) {
+        out_ += static_cast<char>(FIXMAP | size);
+    } else if (size <= UINT16_MAX) {
+        put_big_endian(MAP16, size, 2);
+    } else {
+        put_big_endian(MAP32, size, 4);
+    }
+}
+
+// ==================== MessagePackReader ====================
+
+uint64_t MessagePackReader::get_big_endian(size_t offset, size_t bytes) const {
+    uint64_t value = 0;
+    for (size_t i = 0; i < bytes; ++i) {
+        value = (value << 8) | static_cast<uint8_t>(data_[position_ + offset + i]);
+    }
+    return value;
+}
+
+MessagePackReader::Type MessagePackReader::peek() const {
+    if (at_end()) {
+        return Type::Invalid;
+    }
+    const auto marker = static_cast<uint8_t>(data_[position_]);
+    if (marker < FIXMAP || marker >= NEGATIVE_FIXINT) return Type::Integer;
+    if (marker < FIXARRAY) return Type::Map;
+    if (marker < FIXSTR) return Type::Array;
+    if (marker < NIL) return Type::String;
+    switch (marker) {
+        case NIL:                                   return Type::Nil;
+        case FALSE: case TRUE:                      return Type::Bool;
+        case BIN8: case BIN16: case BIN32:          return Type::Binary;
+        case EXT8: case EXT16: case EXT32:          return Type::Extension;
+        case FLOAT32: case FLOAT64:                 return Type::Float;
+        case STR8: case STR16: case STR32:          return Type::String;
+        case ARRAY16: case ARRAY32:                 return Type::Array;
+        case MAP16: case MAP32:                     return Type::Map;
+        default:
+            if (marker >= UINT8 && marker <= INT64) return Type::Integer;
+            if (marker >= FIXEXT1 && marker <= FIXEXT16) return Type::Extension;
+            return Type::Invalid;
+    }
+}
+
+bool MessagePackReader::read_nil() {
+    if (at_end() || static_cast<uint8_t>(data_[position_]) != NIL) {
+        return false;
+    }
+    ++position_;
+    return true;
+}
+
+bool MessagePackReader::read_bool(bool& value) {
+    if (at_end()) {
+        return false;
+    }
+    const auto marker = static_cast<uint8_t>(data_[position_]);
+    if (marker != TRUE && marker != FALSE) {
+        return false;
+    }
+    value = marker == TRUE;
+    ++position_;
+    return true;
+}
+
+bool MessagePackReader::read_int(int64_t& value) {
+    if (at_end()) {
+        return false;
+    }
+    const auto marker = static_cast<uint8_t>(data_[position_]);
+    if (marker < FIXMAP) {
+        value = marker;
+        ++position_;
+        return true;
+    }
+    if (marker >= NEGATIVE_FIXINT) {
+        value = static_cast<int8_t>(marker);
+        ++position_;
+        return true;
+    }
+    if (marker < UINT8 || marker > INT64) {
+        return false;
+    }
+    const size_t bytes = integer_bytes(marker);
+    if (!available(1 + bytes)) {
+        return false;
+    }
+    const uint64_t raw = get_big_endian(1, bytes);
+    if (marker <= UINT64) {
+        if (raw > static_cast<uint64_t>(INT64_MAX)) {
+            return false;
+        }
+        value = static_cast<int64_t>(raw);
+    } else {
+        // Sign-extend from the encoded width
+        const unsigned shift = static_cast<unsigned>(64 - 8 * bytes);
+        value = static_cast<int64_t>(raw << shift) >> shift;
+    }
+    position_ += 1 + bytes;
+    return true;
+}
+
+bool MessagePackReader::read_uint(uint64_t& value) {
+    if (at_end()) {
+        return false;
+    }
+    const auto marker = static_cast<uint8_t>(data_[position_]);
+    if (marker >= UINT8 && marker <= UINT64) {
+        const size_t bytes = integer_bytes(marker);
+        if (!available(1 + bytes)) {
+            return false;
+        }
+        value = get_big_endian(1, bytes);
+        position_ += 1 + bytes;
+        return true;
+    }
+    const size_t start = position_;
+    int64_t signed_value = 0;
+    if (!read_int(signed_value)) {
+        return false;
+    }
+    if (signed_value < 0) {
+        position_ = start;
+        return false;
+    }
+    value = static_cast<uint64_t>(signed_value);
+    return true;
+}
+
+bool MessagePackReader::read_double(double& value) {
+    if (at_end()) {
+        return false;
+    }
+    const auto marker = static_cast<uint8_t>(data_[position_]);
+    if (marker == FLOAT64) {
+        if (!available(9)) {
+            return false;
+        }
+        const uint64_t bits = get_big_endian(1, 8);
+        std::memcpy(&value, &bits, sizeof(value));
+        position_ += 9;
+        return true;
+    }
+    if (marker == FLOAT32) {
+        if (!available(5)) {
+            return false;
+        }
+        const auto bits = static_cast<uint32_t>(get_big_endian(1, 4));
+        float single;
+        std::memcpy(&single, &bits, sizeof(single));
+        value = single;
+        position_ += 5;
+        return true;
+    }
+    if (marker == UINT64) {
+        uint64_t unsigned_value = 0;
+        if (!read_uint(unsigned_value)) {
+            return false;
+        }
+        value = static_cast<double>(unsigned_value);
+        return true;
+    }
+    int64_t integer = 0;
+    if (!read_int(integer)) {
+        return false;
+    }
+    value = static_cast<double>(integer);
+    return true;
+}
+
+bool MessagePackReader::read_string(std::string_view& value) {
+    if (at_end()) {
+        return false;
+    }
+    const auto marker = static_cast<uint8_t>(data_[position_]);
+    size_t size = 0;
+    size_t header = 1;
+    if (marker >= FIXSTR && marker < NIL) {
+        size = marker & 0x1f;
+    } else if (marker >= STR8 && marker <= STR32) {
+        const size_t bytes = size_t{1} << (marker - STR8);
+        if (!available(1 + bytes)) {
+            return false;
+        }
+        size = static_cast<size_t>(get_big_endian(1, bytes));
+        header += bytes;
+    } else {
+        return false;
+    }
+    if (!available(header) || data_.size() - position_ - header < size) {
+        return false;
+    }
+    value = data_.substr(position_ + header, size);
+    position_ += header + size;
+    return true;
+}
+
+bool MessagePackReader::read_container(uint8_t fix_first, uint8_t marker16, uint8_t marker32, size_t& size,
+                                       size_t& header) const {
+    if (at_end()) {
+        return false;
+    }
+    const auto marker = static_cast<uint8_t>(data_[position_]);
+    if (marker >= fix_first && marker < fix_first + 16) {
+        size = marker & 0x0f;
+        header = 1;
+        return true;
+    }
+    if (marker != marker16 && marker != marker32) {
+        return false;
+    }
+    const size_t bytes = marker == marker16 ? 2 : 4;
+    if (!available(1 + bytes)) {
+        return false;
+    }
+    size = static_cast<size_t>(get_big_endian(1, bytes));
+    header = 1 + bytes;
+    return true;
+}
+
+bool MessagePackReader::read_array_header(size_t& size) {
+    size_t header = 0;
+    if (!read_container(FIXARRAY, ARRAY16, ARRAY32, size, header)) {
+        return false;
+    }
+    position_ += header;
+    return true;
+}
+
+bool MessagePackReader::read_map_header(size_t& size) {
+    size_t header = 0;
+    if (!read_container(FIXMAP, MAP16, MAP32, size, header)) {
+        return false;
+    }
+    position_ += header;
+    return true;
+}
+
+bool MessagePackReader::skip() {
+    // Values still to skip; containers add their elements instead of recursing
+    size_t pending = 1;
+    while (pending > 0) {
+        --pending;
+        const Type type = peek();
+        if (type == Type::Invalid) {
+            return false;
+        }
+        const auto marker = static_cast<uint8_t>(data_[position_]);
+        size_t size = 0;
+        size_t header = 1;
+
+        switch (type) {
+            case Type::Integer:
+                if (marker >= UINT8 && marker <= INT64) {
+                    header += integer_bytes(marker);
+                }
+                break;
+
+            case Type::Float:
+                header += marker == FLOAT32 ? 4 : 8;
+                break;
+
+            case Type::String: {
+                std::string_view ignored;
+                if (!read_string(ignored)) {
+                    return false;
+                }
+                continue;
+            }
+
+            case Type::Binary:
+            case Type::Extension:
+                if (marker >= FIXEXT1 && marker <= FIXEXT16) {
+                    header = 2;
+                    size = size_t{1} << (marker - FIXEXT1);
+                } else {
+                    const bool extension = marker >= EXT8;
+                    const size_t bytes = size_t{1} << (marker - (extension ? EXT8 : BIN8));
+                    if (!available(1 + bytes)) {
+                        return false;
+                    }
+                    size = static_cast<size_t>(get_big_endian(1, bytes));
+                    header += bytes + (extension ? 1 : 0);     // Extensions carry a type byte
+                }
+                break;
+
+            case Type::Array:
+                if (!read_array_header(size)) {
+                    return false;
+                }
+                pending += size;
+                continue;
+
+            case Type::Map:
+                if (!read_map_header(size)) {
+                    return false;
+                }
+                pending += 2 * size;
+                continue;
+
+            default:    // Nil, Bool
+                break;
+        }
+
+        if (!available(header) || data_.size() - position_ - header < size) {
+            return false;
+        }
+        position_ += header + size;
+    }
+    return true;
+}
+
+} // namespace wip::serialization
@@ -0,0 +1,149 @@
+#include "message_pack.h"
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <limits>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+using namespace wip::serialization;
+
+namespace {
+
+std::vector<uint8_t> bytes(const std::string& buffer) {
+    return std::vector<uint8_t>(buffer.begin(), buffer.end());
+}
+
+} // namespace
+
+// ==================== Writer Tests ====================
+
+TEST(MessagePackTest, WritesSmallestEncoding) {
+    std::string buffer;
+    MessagePackWriter writer(buffer);
+    writer.write_int(5);
+    writer.write_int(-3);
+    writer.write_int(200);
+    writer.write_int(-200);
+    writer.write_string("abc");
+    writer.write_array_header(2);
+    writer.write_map_header(1);
+    writer.write_nil();
+    writer.write_bool(true);
+
+    std::vector<uint8_t> expected = {0x05, 0xfd, 0xcc, 0xc8, 0xd1, 0xff, 0x38, 0xa3, 'a',
+                                     'b',  'c',  0x92, 0x81, 0xc0, 0xc3};
+    EXPECT_EQ(bytes(buffer), expected);
+}
+
+TEST(MessagePackTest, MatchesNlohmannEncoding) {
+    std::string buffer;
+    MessagePackWriter writer(buffer);
+    writer.write_array_header(8);
+    writer.write_int(std::numeric_limits<int64_t>::min());
+    writer.write_int(-40000);
+    writer.write_uint(std::numeric_limits<uint64_t>::max());
+    writer.write_uint(70000);
+    writer.write_double(0.1);
+    writer.write_string(std::string(40, 's'));
+    writer.write_string(std::string(300, 'm'));
+    writer.write_bool(false);
+
+    nlohmann::json expected = {std::numeric_limits<int64_t>::min(),
+                               -40000,
+                               std::numeric_limits<uint64_t>::max(),
+                               70000,
+                               0.1,
+                               std::string(40, 's'),
+                               std::string(300, 'm'),
+                               false};
+    EXPECT_EQ(bytes(buffer), nlohmann::json::to_msgpack(expected));
+}
+
+// ==================== Reader Tests ====================
+
+TEST(MessagePackTest, ReadsWhatWasWritten) {
+    std::string buffer;
+    MessagePackWriter writer(buffer);
+    for (int64_t value : {int64_t{0}, int64_t{-1}, int64_t{-33}, int64_t{127}, int64_t{-129}, int64_t{65536},
+                          std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()}) {
+        writer.write_int(value);
+    }
+    writer.write_double(-2.5);
+    writer.write_string(std::string(70000, 'x'));
+
+    MessagePackReader reader(buffer);
+    for (int64_t expected : {int64_t{0}, int64_t{-1}, int64_t{-33}, int64_t{127}, int64_t{-129}, int64_t{65536},
+                             std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()}) {
+        int64_t value = 0;
+        ASSERT_TRUE(reader.read_int(value));
+        EXPECT_EQ(value, expected);
+    }
+    double number = 0.0;
+    EXPECT_TRUE(reader.read_double(number));
+    EXPECT_EQ(number, -2.5);
+    std::string_view text;
+    EXPECT_TRUE(reader.read_string(text));
+    EXPECT_EQ(text, std::string(70000, 'x'));
+    EXPECT_TRUE(reader.at_end());
+}
+
+TEST(MessagePackTest, MismatchedReadConsumesNothing) {
+    std::string buffer;
+    MessagePackWriter writer(buffer);
+    writer.write_int(-5);
+    writer.write_string("text");
+
+    MessagePackReader reader(buffer);
+    uint64_t unsigned_value = 0;
+    std::string_view text;
+    EXPECT_FALSE(reader.read_uint(unsigned_value));
+    EXPECT_FALSE(reader.read_string(text));
+    EXPECT_EQ(reader.position(), 0u);
+    EXPECT_EQ(reader.peek(), MessagePackReader::Type::Integer);
+
+    int64_t value = 0;
+    EXPECT_TRUE(reader.read_int(value));
+    EXPECT_EQ(value, -5);
+    EXPECT_EQ(reader.peek(), MessagePackReader::Type::String);
+}
+
+TEST(MessagePackTest, SkipsNestedValues) {
+    nlohmann::json document = {
+        {"list", {1, -300, 2.5, "text", nullptr, true}},
+        {"nested", {{"a", {{"b", {{"c", std::vector<int>(20, 7)}}}}}}},
+        {"binary", nlohmann::json::binary({1, 2, 3})},
+    };
+    auto encoded = nlohmann::json::to_msgpack(document);
+    encoded.push_back(0x2a);
+    std::string buffer(encoded.begin(), encoded.end());
+
+    MessagePackReader reader(buffer);
+    EXPECT_TRUE(reader.skip());
+    int64_t value = 0;
+    EXPECT_TRUE(reader.read_int(value));
+    EXPECT_EQ(value, 42);
+    EXPECT_TRUE(reader.at_end());
+}
+
+TEST(MessagePackTest, RejectsTruncatedData) {
+    std::string buffer;
+    MessagePackWriter writer(buffer);
+    writer.write_map_header(1);
+    writer.write_string("key");
+    writer.write_string(std::string(100, 'v'));
+    buffer.resize(buffer.size() - 1);
+
+    MessagePackReader reader(buffer);
+    EXPECT_FALSE(reader.skip());
+
+    MessagePackReader tail(std::string_view(buffer).substr(5));
+    std::string_view text;
+    EXPECT_FALSE(tail.read_string(text));
+    EXPECT_EQ(tail.position(), 0u);
+
+    MessagePackReader empty("");
+    EXPECT_EQ(empty.peek(), MessagePackReader::Type::Invalid);
+    EXPECT_FALSE(empty.skip());
+}
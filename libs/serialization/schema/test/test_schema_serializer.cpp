@@ -0,0 +1,234 @@
+#include "schema_serializer.h"
+
+#include <gtest/gtest.h>
+#include <map>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace wip::serialization;
+
+namespace test_types {
+
+enum class Level { Low, Medium, High };
+
+struct Point {
+    int x = 0;
+    int y = 0;
+};
+WIP_SCHEMA(Point, WIP_FIELD(x), WIP_FIELD(y))
+
+struct Settings {
+    std::string name = "default";
+    bool enabled = true;
+    Level level = Level::Medium;
+    uint16_t port = 8080;
+    int64_t offset = -1;
+    double scale = 1.0;
+    std::vector<std::string> tags;
+    std::vector<Point> points;
+    std::optional<std::string> comment;
+    std::map<std::string, int> limits;
+    std::unordered_map<std::string, Point> anchors;
+    Point origin;
+};
+WIP_SCHEMA(Settings, WIP_FIELD(name), WIP_FIELD(enabled), WIP_FIELD(level), WIP_FIELD(port), WIP_FIELD(offset),
+           WIP_FIELD(scale), WIP_FIELD(tags), WIP_FIELD(points), WIP_FIELD(comment), WIP_FIELD(limits),
+           WIP_FIELD(anchors), WIP_FIELD_AS(origin, "start"))
+
+// Older version of Point with a field that was later removed
+struct LegacyPoint {
+    int x = 0;
+    std::string label;
+};
+WIP_SCHEMA(LegacyPoint, WIP_FIELD(x), WIP_FIELD(label))
+
+struct Unregistered {
+    int value = 0;
+};
+
+} // namespace test_types
+
+using namespace test_types;
+
+namespace {
+
+Settings make_settings() {
+    Settings settings;
+    settings.name = "release";
+    settings.enabled = false;
+    settings.level = Level::High;
+    settings.port = 65535;
+    settings.offset = -1234567890123;
+    settings.scale = 0.25;
+    settings.tags = {"fast", "", std::string(50, 't')};
+    settings.points = {{1, 2}, {-3, 400000}};
+    settings.comment = "note";
+    settings.limits = {{"files", 10}, {"depth", -2}};
+    settings.anchors = {{"home", {5, 6}}};
+    settings.origin = {7, -8};
+    return settings;
+}
+
+void expect_equal(const Settings& actual, const Settings& expected) {
+    EXPECT_EQ(actual.name, expected.name);
+    EXPECT_EQ(actual.enabled, expected.enabled);
+    EXPECT_EQ(actual.level, expected.level);
+    EXPECT_EQ(actual.port, expected.port);
+    EXPECT_EQ(actual.offset, expected.offset);
+    EXPECT_EQ(actual.scale, expected.scale);
+    EXPECT_EQ(actual.tags, expected.tags);
+    ASSERT_EQ(actual.points.size(), expected.points.size());
+    for (size_t i = 0; i < actual.points.size(); ++i) {
+        EXPECT_EQ(actual.points[i].x, expected.points[i].x);
+        EXPECT_EQ(actual.points[i].y, expected.points[i].y);
+    }
+    EXPECT_EQ(actual.comment, expected.comment);
+    EXPECT_EQ(actual.limits, expected.limits);
+    ASSERT_EQ(actual.anchors.size(), expected.anchors.size());
+    for (const auto& [key, point] : expected.anchors) {
+        ASSERT_TRUE(actual.anchors.count(key));
+        EXPECT_EQ(actual.anchors.at(key).x, point.x);
+        EXPECT_EQ(actual.anchors.at(key).y, point.y);
+    }
+    EXPECT_EQ(actual.origin.x, expected.origin.x);
+    EXPECT_EQ(actual.origin.y, expected.origin.y);
+}
+
+} // namespace
+
+// ==================== Schema Tests ====================
+
+TEST(SchemaSerializerTest, DescribesFields) {
+    EXPECT_TRUE(has_schema_v<Settings>);
+    EXPECT_FALSE(has_schema_v<Unregistered>);
+    EXPECT_FALSE(has_schema_v<int>);
+    EXPECT_EQ(field_count<Point>(), 2u);
+
+    std::vector<std::string> names;
+    for_each_field<Settings>([&](const auto& field) { names.push_back(field.name); });
+    ASSERT_EQ(names.size(), 12u);
+    EXPECT_EQ(names.front(), "name");
+    EXPECT_EQ(names.back(), "start");
+}
+
+// ==================== Round Trip Tests ====================
+
+TEST(SchemaSerializerTest, BinaryRoundTrip) {
+    const Settings settings = make_settings();
+    std::string buffer;
+    to_binary(settings, buffer);
+
+    Settings read;
+    ASSERT_TRUE(from_binary(buffer, read));
+    expect_equal(read, settings);
+}
+
+TEST(SchemaSerializerTest, JsonRoundTrip) {
+    const Settings settings = make_settings();
+    nlohmann::json json = write_json(settings);
+    EXPECT_EQ(json["level"], 2);
+    EXPECT_EQ(json["start"]["y"], -8);
+    EXPECT_FALSE(json.contains("origin"));
+
+    Settings read;
+    ASSERT_TRUE(read_json(json, read));
+    expect_equal(read, settings);
+
+    Settings empty_comment;
+    empty_comment.comment = "to be cleared";
+    EXPECT_TRUE(read_json(write_json(Settings{}), empty_comment));
+    EXPECT_FALSE(empty_comment.comment.has_value());
+}
+
+TEST(SchemaSerializerTest, BinaryAndJsonHoldSameDocument) {
+    const Settings settings = make_settings();
+    std::string buffer;
+    to_binary(settings, buffer);
+
+    EXPECT_EQ(nlohmann::json::from_msgpack(buffer), write_json(settings));
+
+    // Documents encoded by nlohmann (sorted keys, compact floats) read back too
+    auto encoded = nlohmann::json::to_msgpack(write_json(settings));
+    Settings read;
+    ASSERT_TRUE(from_binary(std::string(encoded.begin(), encoded.end()), read));
+    expect_equal(read, settings);
+}
+
+// ==================== Compatibility Tests ====================
+
+TEST(SchemaSerializerTest, UnknownAndMistypedFieldsKeepDefaults) {
+    nlohmann::json document = {
+        {"name", 42},                       // Wrong type
+        {"port", 70000},                    // Out of range for uint16_t
+        {"tags", {"a", 1}},                 // Mixed element types
+        {"removed", {{"deep", {1, 2, 3}}}}, // Unknown key
+        {"scale", 3},                       // Integers convert to double
+        {"start", {{"x", 9}}},              // Partial nested object
+    };
+
+    auto check = [](const Settings& read) {
+        const Settings defaults;
+        EXPECT_EQ(read.name, defaults.name);
+        EXPECT_EQ(read.port, defaults.port);
+        EXPECT_TRUE(read.tags.empty());
+        EXPECT_EQ(read.scale, 3.0);
+        EXPECT_EQ(read.origin.x, 9);
+        EXPECT_EQ(read.origin.y, 0);
+        EXPECT_TRUE(read.enabled);
+    };
+
+    Settings from_json;
+    ASSERT_TRUE(read_json(document, from_json));
+    check(from_json);
+
+    auto encoded = nlohmann::json::to_msgpack(document);
+    Settings from_msgpack;
+    ASSERT_TRUE(from_binary(std::string(encoded.begin(), encoded.end()), from_msgpack));
+    check(from_msgpack);
+}
+
+TEST(SchemaSerializerTest, ReadsOlderVersions) {
+    std::string buffer;
+    to_binary(LegacyPoint{3, "removed later"}, buffer);
+
+    Point point{0, 11};
+    ASSERT_TRUE(from_binary(buffer, point));
+    EXPECT_EQ(point.x, 3);
+    EXPECT_EQ(point.y, 11);
+}
+
+TEST(SchemaSerializerTest, RejectsInvalidDocuments) {
+    Point point;
+    EXPECT_FALSE(read_json(nlohmann::json::array(), point));
+    EXPECT_FALSE(from_binary("", point));
+
+    std::string buffer;
+    to_binary(make_settings(), buffer);
+    buffer.resize(buffer.size() / 2);
+    Settings settings;
+    EXPECT_FALSE(from_binary(buffer, settings));
+
+    // An array header claiming more elements than there are bytes
+    std::vector<int> values;
+    EXPECT_FALSE(from_binary(std::string("\xdd\x7f\xff\xff\xff", 5), values));
+}
+
+// ==================== Serializer Interface Tests ====================
+
+TEST(SchemaSerializerTest, SerializerInterface) {
+    const Settings settings = make_settings();
+
+    MessagePackSerializer<Settings> binary;
+    auto read = binary.deserialize(binary.serialize(settings));
+    ASSERT_TRUE(read.has_value());
+    expect_equal(*read, settings);
+    EXPECT_FALSE(binary.deserialize(MessagePack{"\xc0"}).has_value());
+
+    SchemaJsonSerializer<Settings> json;
+    read = json.deserialize(json.serialize(settings));
+    ASSERT_TRUE(read.has_value());
+    expect_equal(*read, settings);
+    EXPECT_FALSE(json.deserialize(nlohmann::json("text")).has_value());
+}
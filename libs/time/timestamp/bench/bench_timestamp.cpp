@@ -0,0 +1,60 @@
+// Benchmark for Timestamp formatting and parsing.
+//
+// Formats a run of timestamps a few hundred microseconds apart, as when
+// stamping log lines, to strings and into a buffer, then parses the strings
+// back, and reports the time per call in nanoseconds. Usage:
+//
+//   bench_wip_time_timestamp [count]
+
+#include "benchmark.h"
+#include "timestamp.h"
+#include <chrono>
+#include <string>
+#include <vector>
+
+using wip::time::timestamp::Timestamp;
+
+int main(int argc, char* argv[]) {
+    wip::benchmark::Runner runner("bench_wip_time_timestamp", argc, argv, "[count]");
+    size_t count = runner.argument(0, 2000000);
+    std::vector<Timestamp> timestamps;
+    timestamps.reserve(count);
+    Timestamp start(2024, 1, 1, 0, 0, 0, 0);
+    for (size_t i = 0; i < count; ++i) {
+        timestamps.push_back(start + std::chrono::microseconds(i * 250));
+    }
+    std::vector<std::string> strings(count);
+    runner.out() << "Handling " << count << " timestamps" << std::endl;
+
+    runner.measure("to_iso_string", count, [&]() {
+        size_t checksum = 0;
+        for (size_t i = 0; i < count; ++i) {
+            strings[i] = timestamps[i].to_iso_string();
+            checksum += strings[i].size();
+        }
+        return checksum;
+    });
+    runner.measure("to_iso_chars", count, [&]() {
+        size_t checksum = 0;
+        char buffer[Timestamp::ISO_STRING_CAPACITY];
+        for (const auto& timestamp : timestamps) {
+            checksum += timestamp.to_iso_chars(buffer) + static_cast<unsigned char>(buffer[20]);
+        }
+        return checksum;
+    });
+    runner.measure("format", count, [&]() {
+        size_t checksum = 0;
+        for (const auto& timestamp : timestamps) {
+            checksum += timestamp.format("%Y-%m-%d %H:%M:%S").size();
+        }
+        return checksum;
+    });
+    runner.measure("from_iso_string", count, [&]() {
+        size_t checksum = 0;
+        for (const auto& text : strings) {
+            checksum += static_cast<size_t>(Timestamp::from_iso_string(text).unix_timestamp_ms() & 0xFF);
+        }
+        return checksum;
+    });
+    return runner.finish();
+}
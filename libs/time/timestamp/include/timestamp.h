@@ -1,6 +1,8 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
+#include <optional>
 #include <string>
 #include <ctime>
 
@@ -45,7 +47,8 @@ public:
     
     /**
      * @brief Constructor from ISO 8601 string
-     * @param iso_string ISO 8601 formatted string (e.g., "2023-12-25T15:30:45Z")
+     * @param iso_string ISO 8601 formatted string (e.g., "2023-12-25T15:30:45Z"),
+     *                   the current time if it cannot be parsed
      */
     explicit Timestamp(const std::string& iso_string);
     
@@ -111,6 +114,18 @@ public:
      */
     static Timestamp from_iso_string(const std::string& iso_string);
     
+    /**
+     * @brief Parse an ISO 8601 / RFC 3339 date and time
+     *
+     * Accepts "YYYY-MM-DDTHH:MM:SS" with 'T', 't' or a space between date and
+     * time, an optional fraction of a second of up to nine digits, and an
+     * optional zone of 'Z' or an offset such as "+02:00"; without a zone the
+     * time is UTC. Parsed by hand, without streams or the locale.
+     * @param iso_string String to parse
+     * @return Parsed timestamp, or std::nullopt if the string is not valid
+     */
+    static std::optional<Timestamp> try_from_iso_string(const std::string& iso_string);
+    
     // Getters
     
     /**
@@ -207,6 +222,21 @@ public:
      */
     std::string to_iso_string(bool include_milliseconds = true) const;
     
+    /**
+     * @brief Format as ISO 8601 string into a caller-provided buffer
+     *
+     * Writes what to_iso_string() returns without allocating. The date and
+     * time of day are cached per thread for the last second formatted, so
+     * stamping a stream of nearby times mostly copies the cached prefix.
+     * @param out Buffer of at least ISO_STRING_CAPACITY characters, not null-terminated
+     * @param include_milliseconds Include milliseconds in output
+     * @return Number of characters written
+     */
+    size_t to_iso_chars(char* out, bool include_milliseconds = true) const;
+    
+    // Buffer size that to_iso_chars() never exceeds
+    static constexpr size_t ISO_STRING_CAPACITY = 40;
+    
     /**
      * @brief Format as RFC 2822 string
      * @return RFC 2822 formatted string
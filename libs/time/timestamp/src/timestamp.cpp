@@ -1,7 +1,8 @@
 #include "timestamp.h"
-#include <sstream>
-#include <iomanip>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 
 #ifndef _WIN32
 #define _GNU_SOURCE
@@ -12,6 +13,121 @@ namespace wip {
 namespace time {
 namespace timestamp {
 
+namespace {
+
+constexpr std::int64_t SECONDS_PER_DAY = 86400;
+
+// Days from 1970-01-01 to a date of the proleptic Gregorian calendar
+// (H. Hinnant's days_from_civil, counting in 400-year eras)
+constexpr std::int64_t days_from_civil(std::int64_t year, unsigned month, unsigned day) {
+    year -= month <= 2;
+    const std::int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const unsigned year_of_era = static_cast<unsigned>(year - era * 400);
+    const unsigned day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const unsigned day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return era * 146097 + static_cast<std::int64_t>(day_of_era) - 719468;
+}
+
+struct CivilDate {
+    std::int64_t year;
+    unsigned month;
+    unsigned day;
+};
+
+// Date of a day counted from 1970-01-01, the inverse of days_from_civil
+constexpr CivilDate civil_from_days(std::int64_t days) {
+    days += 719468;
+    const std::int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const unsigned day_of_era = static_cast<unsigned>(days - era * 146097);
+    const unsigned year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+    const unsigned day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+    const unsigned shifted_month = (5 * day_of_year + 2) / 153;
+    const unsigned day = day_of_year - (153 * shifted_month + 2) / 5 + 1;
+    const unsigned month = shifted_month < 10 ? shifted_month + 3 : shifted_month - 9;
+    return {static_cast<std::int64_t>(year_of_era) + era * 400 + (month <= 2), month, day};
+}
+
+bool is_leap(std::int64_t year) {
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+unsigned days_in_month(std::int64_t year, unsigned month) {
+    static constexpr unsigned DAYS[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    return month == 2 && is_leap(year) ? 29 : DAYS[month - 1];
+}
+
+void write_digits(char* out, unsigned value, int width) {
+    for (int i = width - 1; i >= 0; --i) {
+        out[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+}
+
+// Write "YYYY-MM-DDTHH:MM:SS" for seconds since the epoch, returning its length
+size_t format_iso_prefix(std::int64_t seconds, char* out) {
+    std::int64_t days = seconds / SECONDS_PER_DAY;
+    std::int64_t second_of_day = seconds % SECONDS_PER_DAY;
+    if (second_of_day < 0) {
+        second_of_day += SECONDS_PER_DAY;
+        --days;
+    }
+    const CivilDate date = civil_from_days(days);
+    
+    size_t length = 0;
+    if (date.year >= 0 && date.year <= 9999) {
+        write_digits(out, static_cast<unsigned>(date.year), 4);
+        length = 4;
+    } else {
+        const std::string year = std::to_string(date.year);
+        std::memcpy(out, year.data(), year.size());
+        length = year.size();
+    }
+    
+    char* rest = out + length;
+    rest[0] = '-';
+    write_digits(rest + 1, date.month, 2);
+    rest[3] = '-';
+    write_digits(rest + 4, date.day, 2);
+    rest[6] = 'T';
+    write_digits(rest + 7, static_cast<unsigned>(second_of_day / 3600), 2);
+    rest[9] = ':';
+    write_digits(rest + 10, static_cast<unsigned>(second_of_day / 60 % 60), 2);
+    rest[12] = ':';
+    write_digits(rest + 13, static_cast<unsigned>(second_of_day % 60), 2);
+    return length + 15;
+}
+
+// Prefix of the last second formatted on this thread
+struct IsoPrefixCache {
+    std::int64_t second = std::numeric_limits<std::int64_t>::min();
+    size_t length = 0;
+    char text[Timestamp::ISO_STRING_CAPACITY];
+};
+
+// Format with strftime into a stack buffer, growing only for long results
+std::string format_tm(const std::tm& tm, const char* format_string) {
+    if (*format_string == '\0') {
+        return std::string();
+    }
+    char buffer[128];
+    size_t length = std::strftime(buffer, sizeof(buffer), format_string, &tm);
+    if (length != 0) {
+        return std::string(buffer, length);
+    }
+    // Either the result does not fit or it is empty, which strftime cannot tell apart
+    for (size_t size = 1024; size <= 65536; size *= 4) {
+        std::string result(size, '\0');
+        length = std::strftime(&result[0], size, format_string, &tm);
+        if (length != 0) {
+            result.resize(length);
+            return result;
+        }
+    }
+    return std::string();
+}
+
+} // namespace
+
 // Constructors
 Timestamp::Timestamp() : time_point_(std::chrono::system_clock::now()) {
 }
@@ -43,23 +159,10 @@ Timestamp::Timestamp(int year, int month, int day, int hour, int minute, int sec
 }
 
 Timestamp::Timestamp(const std::string& iso_string) {
-    // Parse ISO 8601 string (simplified version)
-    std::tm tm = {};
-    std::istringstream ss(iso_string);
-    
-    // Try to parse with format YYYY-MM-DDTHH:MM:SS
-    ss >> std::get_time(&tm, "%Y-%m-%dT%H:%M:%S");
+    auto parsed = try_from_iso_string(iso_string);
     
-    if (ss.fail()) {
-        // Fallback to current time if parsing fails
-        time_point_ = std::chrono::system_clock::now();
-    } else {
-#ifdef _WIN32
-        time_point_ = std::chrono::system_clock::from_time_t(_mkgmtime(&tm));
-#else
-        time_point_ = std::chrono::system_clock::from_time_t(timegm(&tm));
-#endif
-    }
+    // Fallback to current time if parsing fails
+    time_point_ = parsed ? parsed->time_point_ : std::chrono::system_clock::now();
 }
 
 // Static factory methods
@@ -100,6 +203,85 @@ Timestamp Timestamp::from_iso_string(const std::string& iso_string) {
     return Timestamp(iso_string);
 }
 
+std::optional<Timestamp> Timestamp::try_from_iso_string(const std::string& iso_string) {
+    const char* pos = iso_string.data();
+    const char* const end = pos + iso_string.size();
+    
+    auto number = [&](int digits, int& value) {
+        if (end - pos < digits) return false;
+        value = 0;
+        for (int i = 0; i < digits; ++i) {
+            const unsigned digit = static_cast<unsigned>(pos[i] - '0');
+            if (digit > 9) return false;
+            value = value * 10 + static_cast<int>(digit);
+        }
+        pos += digits;
+        return true;
+    };
+    auto separator = [&](char expected) {
+        if (pos == end || *pos != expected) return false;
+        ++pos;
+        return true;
+    };
+    
+    // YYYY-MM-DDTHH:MM:SS
+    int year, month, day, hour, minute, second;
+    if (!number(4, year) || !separator('-') || !number(2, month) || !separator('-') || !number(2, day)) {
+        return std::nullopt;
+    }
+    if (pos == end || (*pos != 'T' && *pos != 't' && *pos != ' ')) {
+        return std::nullopt;
+    }
+    ++pos;
+    if (!number(2, hour) || !separator(':') || !number(2, minute) || !separator(':') || !number(2, second)) {
+        return std::nullopt;
+    }
+    
+    // Fraction of a second, digits past nanoseconds are ignored
+    std::int64_t nanoseconds = 0;
+    if (pos != end && (*pos == '.' || *pos == ',')) {
+        ++pos;
+        int digits = 0;
+        while (pos != end && static_cast<unsigned>(*pos - '0') <= 9) {
+            if (digits < 9) {
+                nanoseconds = nanoseconds * 10 + (*pos - '0');
+                ++digits;
+            }
+            ++pos;
+        }
+        if (digits == 0) return std::nullopt;
+        for (; digits < 9; ++digits) nanoseconds *= 10;
+    }
+    
+    // Zone: none or 'Z' for UTC, or an offset east of UTC
+    int offset_seconds = 0;
+    if (pos != end && (*pos == 'Z' || *pos == 'z')) {
+        ++pos;
+    } else if (pos != end && (*pos == '+' || *pos == '-')) {
+        const int sign = *pos++ == '-' ? -1 : 1;
+        int offset_hours, offset_minutes;
+        if (!number(2, offset_hours)) return std::nullopt;
+        separator(':');
+        if (!number(2, offset_minutes) || offset_hours > 23 || offset_minutes > 59) return std::nullopt;
+        offset_seconds = sign * (offset_hours * 3600 + offset_minutes * 60);
+    }
+    if (pos != end) {
+        return std::nullopt;
+    }
+    
+    // A second of 60 is a leap second, which rolls over into the next minute
+    if (month < 1 || month > 12 || day < 1 || static_cast<unsigned>(day) > days_in_month(year, month) ||
+        hour > 23 || minute > 59 || second > 60) {
+        return std::nullopt;
+    }
+    
+    const std::int64_t seconds = days_from_civil(year, month, day) * SECONDS_PER_DAY +
+                                 hour * 3600 + minute * 60 + second - offset_seconds;
+    return Timestamp(std::chrono::system_clock::time_point{} +
+                     std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                         std::chrono::seconds(seconds) + std::chrono::nanoseconds(nanoseconds)));
+}
+
 // Getters
 const std::chrono::system_clock::time_point& Timestamp::time_point() const {
     return time_point_;
@@ -198,39 +380,35 @@ int Timestamp::week_of_year() const {
 
 // Formatting
 std::string Timestamp::to_iso_string(bool include_milliseconds) const {
-    auto time_t = std::chrono::system_clock::to_time_t(time_point_);
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(time_point_.time_since_epoch()) % 1000;
-    
-    std::tm tm;
-#ifdef _WIN32
-    gmtime_s(&tm, &time_t);
-#else
-    gmtime_r(&time_t, &tm);
-#endif
+    char buffer[ISO_STRING_CAPACITY];
+    return std::string(buffer, to_iso_chars(buffer, include_milliseconds));
+}
+
+size_t Timestamp::to_iso_chars(char* out, bool include_milliseconds) const {
+    const auto since_epoch = time_point_.time_since_epoch();
+    const auto seconds = std::chrono::floor<std::chrono::seconds>(since_epoch);
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(since_epoch - seconds).count();
     
-    std::ostringstream oss;
-    oss << std::put_time(&tm, "%Y-%m-%dT%H:%M:%S");
+    static thread_local IsoPrefixCache cache;
+    if (cache.second != seconds.count()) {
+        cache.length = format_iso_prefix(seconds.count(), cache.text);
+        cache.second = seconds.count();
+    }
+    std::memcpy(out, cache.text, cache.length);
+    size_t length = cache.length;
     
-    if (include_milliseconds && ms.count() > 0) {
-        oss << "." << std::setfill('0') << std::setw(3) << ms.count();
+    if (include_milliseconds && ms > 0) {
+        out[length] = '.';
+        write_digits(out + length + 1, static_cast<unsigned>(ms), 3);
+        length += 4;
     }
     
-    oss << "Z";
-    return oss.str();
+    out[length++] = 'Z';
+    return length;
 }
 
 std::string Timestamp::to_rfc2822_string() const {
-    auto time_t = std::chrono::system_clock::to_time_t(time_point_);
-    std::tm tm;
-#ifdef _WIN32
-    gmtime_s(&tm, &time_t);
-#else
-    gmtime_r(&time_t, &tm);
-#endif
-    
-    std::ostringstream oss;
-    oss << std::put_time(&tm, "%a, %d %b %Y %H:%M:%S +0000");
-    return oss.str();
+    return format_tm(to_tm(), "%a, %d %b %Y %H:%M:%S +0000");
 }
 
 std::string Timestamp::to_unix_string() const {
@@ -238,19 +416,11 @@ std::string Timestamp::to_unix_string() const {
 }
 
 std::string Timestamp::to_readable_string() const {
-    auto time_t = std::chrono::system_clock::to_time_t(time_point_);
-    std::tm tm = to_tm();
-    
-    std::ostringstream oss;
-    oss << std::put_time(&tm, "%A, %B %d, %Y at %I:%M:%S %p");
-    return oss.str();
+    return format_tm(to_tm(), "%A, %B %d, %Y at %I:%M:%S %p");
 }
 
 std::string Timestamp::format(const std::string& format_string) const {
-    auto tm = to_tm();
-    std::ostringstream oss;
-    oss << std::put_time(&tm, format_string.c_str());
-    return oss.str();
+    return format_tm(to_tm(), format_string.c_str());
 }
 
 // Arithmetic operations
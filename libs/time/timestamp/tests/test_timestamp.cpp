@@ -2,6 +2,7 @@
 #include <gtest/gtest.h>
 #include <chrono>
 #include <thread>
+#include <ctime>
 
 using namespace wip::time::timestamp;
 
@@ -223,4 +224,94 @@ TEST_F(TimestampTest, DayOfYear) {
     Timestamp mid_year(2023, 7, 1);
     EXPECT_GT(mid_year.day_of_year(), 180);
     EXPECT_LT(mid_year.day_of_year(), 190);
-}
\ No newline at end of file
+}
+
+TEST_F(TimestampTest, ISOFormattingMatchesGmtime) {
+    // Times across centuries, leap days and both sides of the epoch
+    const std::int64_t seconds[] = {0, -1, 951782400, 951868799, 1709164800, 4102444799, -2208988800, 7258118399};
+    for (std::int64_t second : seconds) {
+        for (int ms : {0, 1, 999}) {
+            Timestamp ts = Timestamp::from_unix_ms(second * 1000 + ms);
+            std::time_t time = static_cast<std::time_t>(second);
+            std::tm tm{};
+            gmtime_r(&time, &tm);
+            char expected[64];
+            size_t length = std::strftime(expected, sizeof(expected), "%Y-%m-%dT%H:%M:%S", &tm);
+            std::string iso = std::string(expected, length);
+            if (ms > 0) {
+                iso += "." + std::string(ms < 10 ? "00" : ms < 100 ? "0" : "") + std::to_string(ms);
+            }
+            iso += "Z";
+            
+            EXPECT_EQ(ts.to_iso_string(), iso);
+            EXPECT_EQ(ts.to_iso_string(false), std::string(expected, length) + "Z");
+            
+            char buffer[Timestamp::ISO_STRING_CAPACITY];
+            EXPECT_EQ(std::string(buffer, ts.to_iso_chars(buffer)), iso);
+        }
+    }
+}
+
+TEST_F(TimestampTest, ISOFormattingCachesBySecond) {
+    // Consecutive calls in one second reuse the prefix, calls across seconds must not
+    Timestamp base(2024, 2, 29, 23, 59, 59, 0);
+    EXPECT_EQ(base.add_milliseconds(1).to_iso_string(), "2024-02-29T23:59:59.001Z");
+    EXPECT_EQ(base.add_milliseconds(500).to_iso_string(), "2024-02-29T23:59:59.500Z");
+    EXPECT_EQ(base.add_milliseconds(1000).to_iso_string(), "2024-03-01T00:00:00Z");
+    EXPECT_EQ(base.to_iso_string(), "2024-02-29T23:59:59Z");
+}
+
+TEST_F(TimestampTest, ISOStringRoundTrip) {
+    for (std::int64_t ms : {std::int64_t{0}, std::int64_t{1700000000123}, std::int64_t{-86400001}, std::int64_t{951868799999}}) {
+        Timestamp ts = Timestamp::from_unix_ms(ms);
+        auto parsed = Timestamp::try_from_iso_string(ts.to_iso_string());
+        ASSERT_TRUE(parsed.has_value()) << ts.to_iso_string();
+        EXPECT_EQ(parsed->unix_timestamp_ms(), ms);
+    }
+}
+
+TEST_F(TimestampTest, ISOStringParsingVariants) {
+    const std::int64_t base = 1703518245;  // 2023-12-25T15:30:45Z
+    auto parse_ns = [](const std::string& text) {
+        auto parsed = Timestamp::try_from_iso_string(text);
+        EXPECT_TRUE(parsed.has_value()) << text;
+        return parsed ? parsed->unix_timestamp_ns() : 0;
+    };
+    
+    EXPECT_EQ(parse_ns("2023-12-25T15:30:45Z"), base * 1000000000);
+    EXPECT_EQ(parse_ns("2023-12-25t15:30:45z"), base * 1000000000);
+    EXPECT_EQ(parse_ns("2023-12-25 15:30:45"), base * 1000000000);
+    EXPECT_EQ(parse_ns("2023-12-25T15:30:45.5Z"), base * 1000000000 + 500000000);
+    EXPECT_EQ(parse_ns("2023-12-25T15:30:45,123456789Z"), base * 1000000000 + 123456789);
+    EXPECT_EQ(parse_ns("2023-12-25T15:30:45.1234567891Z"), base * 1000000000 + 123456789);
+    EXPECT_EQ(parse_ns("2023-12-25T17:30:45+02:00"), base * 1000000000);
+    EXPECT_EQ(parse_ns("2023-12-25T10:00:45-0530"), base * 1000000000);
+    EXPECT_EQ(parse_ns("2024-02-29T00:00:00Z"), std::int64_t{1709164800} * 1000000000);
+    
+    const char* invalid[] = {
+        "", "2023-12-25", "2023-12-25T15:30", "2023-13-01T00:00:00Z", "2023-02-29T00:00:00Z",
+        "2023-12-32T00:00:00Z", "2023-12-25T24:00:00Z", "2023-12-25T15:60:00Z", "2023-12-25T15:30:45.Z",
+        "2023-12-25T15:30:45+2", "2023-12-25T15:30:45Zjunk", "2023-1-25T15:30:45Z", "abcd-12-25T15:30:45Z",
+    };
+    for (const char* text : invalid) {
+        EXPECT_FALSE(Timestamp::try_from_iso_string(text).has_value()) << text;
+    }
+}
+
+TEST_F(TimestampTest, CustomFormatting) {
+    Timestamp ts(2023, 6, 15, 14, 30, 45, 123);
+    EXPECT_EQ(ts.format("%Y/%m/%d %H:%M"), "2023/06/15 14:30");
+    EXPECT_EQ(ts.format(""), "");
+    EXPECT_EQ(ts.to_rfc2822_string(), "Thu, 15 Jun 2023 14:30:45 +0000");
+    EXPECT_EQ(ts.to_readable_string(), "Thursday, June 15, 2023 at 02:30:45 PM");
+    
+    // Results longer than the stack buffer
+    std::string long_format(100, 'x');
+    std::string expected(100, 'x');
+    for (int i = 0; i < 20; ++i) {
+        long_format += "%Y";
+        expected += "2023";
+    }
+    EXPECT_EQ(ts.format(long_format), expected);
+}
+
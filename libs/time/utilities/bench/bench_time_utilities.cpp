@@ -0,0 +1,74 @@
+// Benchmark for clock reads and trace spans.
+//
+// Reads each clock in a tight loop, opens and closes TRACE_SCOPE spans with
+// tracing off and on, then exports the recorded events, and reports the time
+// per call or per event in nanoseconds. Usage:
+//
+//   bench_wip_time_utilities [count]
+
+#include "benchmark.h"
+#include "time_utilities.h"
+#include "trace.h"
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+using namespace wip::time::utilities;
+
+namespace {
+
+template <typename Clock>
+size_t read_clock(size_t count) {
+    size_t checksum = 0;
+    for (size_t i = 0; i < count; ++i) {
+        checksum += static_cast<size_t>(Clock::now().time_since_epoch().count());
+    }
+    return checksum;
+}
+
+size_t trace_spans(size_t count) {
+    size_t checksum = 0;
+    for (size_t i = 0; i < count; ++i) {
+        TRACE_SCOPE("bench");
+        checksum += i;
+    }
+    return checksum;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    wip::benchmark::Runner runner("bench_wip_time_utilities", argc, argv, "[count]");
+    size_t count = runner.argument(0, 10000000);
+    FastClock::now();
+    runner.out() << "Making " << count << " calls, FastClock "
+                 << (FastClock::uses_tsc() ? "reads the TSC at " : "reads the OS clock at ")
+                 << std::setprecision(3) << FastClock::ticks_per_second() / 1e9 << " GHz" << std::endl;
+
+    runner.measure("steady_clock::now", count, [&]() { return read_clock<std::chrono::steady_clock>(count); });
+    runner.measure("high_resolution::now", count, [&]() { return read_clock<std::chrono::high_resolution_clock>(count); });
+    runner.measure("FastClock::now", count, [&]() { return read_clock<FastClock>(count); });
+    runner.measure("TRACE_SCOPE disabled", count, [&]() { return trace_spans(count); });
+    
+    // Record half a buffer of spans and export them, in rounds so nothing is dropped
+    const size_t spans = TRACE_BUFFER_CAPACITY / 4;
+    const size_t rounds = count / spans + 1;
+    std::chrono::nanoseconds recording{0};
+    std::chrono::nanoseconds exporting{0};
+    size_t events = 0;
+    set_tracing_enabled(true);
+    for (size_t round = 0; round < rounds; ++round) {
+        auto start = FastClock::now();
+        wip::benchmark::do_not_optimize(trace_spans(spans));
+        auto recorded = FastClock::now();
+        std::ostringstream out;
+        events += write_chrome_trace(out);
+        recording += recorded - start;
+        exporting += FastClock::now() - recorded;
+    }
+    set_tracing_enabled(false);
+    runner.report("TRACE_SCOPE enabled", static_cast<double>(recording.count()) / (rounds * spans), "ns/span");
+    runner.report("write_chrome_trace", static_cast<double>(exporting.count()) / events, "ns/event");
+    return runner.finish();
+}
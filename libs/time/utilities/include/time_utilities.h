@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 #include <string>
 #include <ctime>
 #include <iomanip>
@@ -51,6 +52,52 @@ std::chrono::system_clock::time_point now_system();
  */
 std::chrono::high_resolution_clock::time_point now_high_res();
 
+/**
+ * @brief Monotonic clock that is cheap enough to read on hot paths
+ *
+ * On x86-64 with an invariant TSC it reads the time stamp counter, converted
+ * to nanoseconds with a fixed-point factor calibrated against steady_clock
+ * over a couple of milliseconds on first use. Elsewhere it reads
+ * CLOCK_MONOTONIC_RAW where available, or steady_clock. The epoch is the
+ * moment of calibration.
+ */
+class FastClock {
+public:
+    using rep = std::int64_t;
+    using period = std::nano;
+    using duration = std::chrono::nanoseconds;
+    using time_point = std::chrono::time_point<FastClock>;
+    static constexpr bool is_steady = true;
+    
+    /**
+     * @brief Get the current time
+     */
+    static time_point now() noexcept;
+    
+    /**
+     * @brief Read the raw counter, for storing many timestamps cheaply
+     * @return Counter value, convert with from_ticks()
+     */
+    static std::uint64_t ticks() noexcept;
+    
+    /**
+     * @brief Convert a raw counter value into a time point
+     * @param ticks Value returned by ticks()
+     */
+    static time_point from_ticks(std::uint64_t ticks) noexcept;
+    
+    /**
+     * @brief Get the counter frequency
+     * @return Ticks per second
+     */
+    static double ticks_per_second() noexcept;
+    
+    /**
+     * @brief Check if the clock reads the time stamp counter
+     */
+    static bool uses_tsc() noexcept;
+};
+
 /**
  * @brief Get current Unix timestamp in seconds
  */
@@ -182,6 +229,20 @@ void sleep_for(const std::chrono::duration<Rep, Period>& duration);
  */
 void sleep_until(const std::chrono::steady_clock::time_point& time_point);
 
+/**
+ * @brief Sleep until a time point with sub-millisecond accuracy
+ *
+ * Sleeps until spin_margin before the deadline, then yields in a loop until
+ * it is reached. Plain sleeps overshoot by up to the scheduler's timer slack,
+ * often a millisecond or more; the spin covers that slack at the cost of
+ * some CPU time.
+ *
+ * @param time_point Time point to wake up at
+ * @param spin_margin Time before the deadline spent yielding instead of sleeping
+ */
+void precise_sleep_until(const std::chrono::steady_clock::time_point& time_point,
+                         std::chrono::nanoseconds spin_margin = std::chrono::microseconds(1000));
+
 /**
  * @brief Measure execution time of a function
  * @param func Function to measure
@@ -192,6 +253,8 @@ std::chrono::nanoseconds measure_execution_time(Func&& func);
 
 /**
  * @brief Simple stopwatch class for timing operations
+ *
+ * Reads FastClock, so starting and stopping costs a few nanoseconds.
  */
 class Stopwatch {
 public:
@@ -230,12 +293,65 @@ public:
     bool is_running() const;
 
 private:
-    std::chrono::high_resolution_clock::time_point start_time_;
-    std::chrono::high_resolution_clock::time_point end_time_;
+    FastClock::time_point start_time_;
+    FastClock::time_point end_time_;
     bool running_ = false;
     bool has_result_ = false;
 };
 
+/**
+ * @brief Paces a loop to a fixed rate
+ *
+ * Frame deadlines are kept on an absolute schedule, so time spent in one
+ * frame does not shift all later frames, and wait_for_next_frame() sleeps
+ * with precise_sleep_until(). A loop that falls more than a frame behind
+ * starts a new schedule instead of running frames back to back to catch up.
+ */
+class FramePacer {
+public:
+    using Clock = std::chrono::steady_clock;
+    
+    /**
+     * @brief Constructor
+     * @param target_fps Frames per second (0 = unpaced)
+     */
+    explicit FramePacer(double target_fps = 0.0);
+    
+    /**
+     * @brief Set the frame rate and start a new schedule
+     * @param target_fps Frames per second (0 = unpaced)
+     */
+    void set_target_fps(double target_fps);
+    
+    /**
+     * @brief Get the frame rate (0 = unpaced)
+     */
+    double target_fps() const { return target_fps_; }
+    
+    /**
+     * @brief Get the time between two frames (zero when unpaced)
+     */
+    Clock::duration frame_interval() const { return interval_; }
+    
+    /**
+     * @brief Wait until the next frame is due
+     * @return Time the frame was due, or now when unpaced or behind schedule
+     */
+    Clock::time_point wait_for_next_frame();
+    
+    /**
+     * @brief Start a new schedule with the next frame one interval from now
+     *
+     * Call after the loop was idle on purpose, e.g. waiting for input.
+     */
+    void reset();
+
+private:
+    double target_fps_ = 0.0;
+    Clock::duration interval_{0};
+    Clock::time_point next_frame_;
+};
+
 /**
  * @brief RAII timer for automatic time measurement
  */
@@ -248,10 +364,19 @@ public:
     explicit ScopedTimer(const std::string& name = "Timer");
     
     /**
-     * @brief Destructor prints elapsed time
+     * @brief Constructor starts timing into an accumulator instead of printing
+     * @param accumulator Duration the elapsed time is added to on destruction
+     */
+    explicit ScopedTimer(std::chrono::nanoseconds& accumulator);
+    
+    /**
+     * @brief Destructor prints elapsed time, or adds it to the accumulator
      */
     ~ScopedTimer();
     
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+    
     /**
      * @brief Get elapsed time so far
      * @return Elapsed time in nanoseconds
@@ -260,7 +385,8 @@ public:
 
 private:
     std::string name_;
-    std::chrono::high_resolution_clock::time_point start_time_;
+    std::chrono::nanoseconds* accumulator_ = nullptr;
+    FastClock::time_point start_time_;
 };
 
 } // namespace utilities
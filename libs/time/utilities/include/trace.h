@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace wip {
+namespace time {
+namespace utilities {
+
+/**
+ * @brief Records each thread keeps until the next export
+ *
+ * A record is 24 bytes, so a buffer takes 1.5 MB once its thread traces.
+ * Scopes that would not fit are dropped whole and counted.
+ */
+constexpr std::size_t TRACE_BUFFER_CAPACITY = 1 << 16;
+
+/**
+ * @brief Turn span recording on or off for all threads
+ *
+ * Recording is off by default; a disabled TRACE_SCOPE costs one relaxed load.
+ */
+void set_tracing_enabled(bool enabled);
+
+/**
+ * @brief Check if spans are being recorded
+ */
+bool tracing_enabled();
+
+/**
+ * @brief Name the calling thread in exported traces, e.g. "engine" or "ui"
+ * @param name Thread name
+ */
+void set_trace_thread_name(const std::string& name);
+
+/**
+ * @brief Write recorded spans as Chrome trace JSON and clear them
+ *
+ * The output opens in Perfetto and chrome://tracing. Timestamps are
+ * microseconds on FastClock. Scopes still open on other threads appear
+ * unfinished in this export and their ends in the next one.
+ *
+ * @param out Stream to write to
+ * @return Number of begin and end events written
+ */
+std::size_t write_chrome_trace(std::ostream& out);
+
+/**
+ * @brief Write recorded spans as Chrome trace JSON to a file and clear them
+ * @param path Output file path
+ * @return True if the file was written
+ */
+bool save_chrome_trace(const std::string& path);
+
+/**
+ * @brief Get the number of scopes dropped because a thread's buffer was full
+ */
+std::uint64_t dropped_trace_scopes();
+
+/**
+ * @brief RAII span that records begin and end events for the calling thread
+ *
+ * Recording is lock-free: each thread appends to its own ring buffer, which
+ * only write_chrome_trace() drains. A scope whose begin is recorded always
+ * has room for its end, so exported spans stay balanced.
+ */
+class ScopedTrace {
+public:
+    /**
+     * @brief Constructor records the begin event
+     * @param name Span name; must outlive the next export, e.g. a string literal
+     */
+    explicit ScopedTrace(const char* name) noexcept;
+
+    /**
+     * @brief Destructor records the end event
+     */
+    ~ScopedTrace();
+
+    ScopedTrace(const ScopedTrace&) = delete;
+    ScopedTrace& operator=(const ScopedTrace&) = delete;
+
+private:
+    bool recorded_ = false;
+};
+
+} // namespace utilities
+} // namespace time
+} // namespace wip
+
+#define WIP_TRACE_CONCAT_INNER(a, b) a##b
+#define WIP_TRACE_CONCAT(a, b) WIP_TRACE_CONCAT_INNER(a, b)
+
+/**
+ * @brief Trace the rest of the enclosing scope under the given name
+ *
+ * Define WIP_DISABLE_TRACING to compile spans out entirely.
+ */
+#ifdef WIP_DISABLE_TRACING
+#define TRACE_SCOPE(name) ((void)0)
+#else
+#define TRACE_SCOPE(name) \
+    ::wip::time::utilities::ScopedTrace WIP_TRACE_CONCAT(wip_trace_scope_, __LINE__)(name)
+#endif
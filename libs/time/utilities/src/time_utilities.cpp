@@ -3,6 +3,16 @@
 #include <iostream>
 #include <cmath>
 
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <cpuid.h>
+#include <x86intrin.h>
+#define WIP_FAST_CLOCK_TSC 1
+#endif
+
+#if defined(__linux__)
+#include <time.h>
+#endif
+
 namespace wip {
 namespace time {
 namespace utilities {
@@ -19,6 +29,121 @@ std::chrono::high_resolution_clock::time_point now_high_res() {
     return std::chrono::high_resolution_clock::now();
 }
 
+// FastClock implementation
+namespace {
+
+struct FastClockCalibration {
+    bool tsc = false;
+    std::uint64_t base_ticks = 0;
+    std::uint64_t ns_per_tick_q32 = 0;   // Nanoseconds per tick, 32.32 fixed point
+    double ticks_per_second = 1e9;
+};
+
+std::uint64_t fallback_ticks() noexcept {
+#if defined(__linux__) && defined(CLOCK_MONOTONIC_RAW)
+    // Not slewed by NTP, so short intervals are not stretched or squeezed
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return static_cast<std::uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<std::uint64_t>(ts.tv_nsec);
+#else
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+#ifdef WIP_FAST_CLOCK_TSC
+bool has_invariant_tsc() {
+    unsigned eax, ebx, ecx, edx;
+    if (!__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) || eax < 0x80000007) {
+        return false;
+    }
+    __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+    return (edx & (1u << 8)) != 0;
+}
+
+// Pair a TSC read with a steady_clock read, keeping the tightest bracket of a few tries
+void sample_tsc(std::uint64_t& tsc, std::chrono::steady_clock::time_point& time) {
+    std::uint64_t best = ~0ull;
+    for (int i = 0; i < 5; ++i) {
+        std::uint64_t before = __rdtsc();
+        auto now = std::chrono::steady_clock::now();
+        std::uint64_t after = __rdtsc();
+        if (after - before < best) {
+            best = after - before;
+            tsc = before + (after - before) / 2;
+            time = now;
+        }
+    }
+}
+#endif
+
+FastClockCalibration calibrate() {
+    FastClockCalibration calibration;
+#ifdef WIP_FAST_CLOCK_TSC
+    if (has_invariant_tsc()) {
+        std::uint64_t tsc_start = 0, tsc_end = 0;
+        std::chrono::steady_clock::time_point start, end;
+        sample_tsc(tsc_start, start);
+        while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(2)) {
+        }
+        sample_tsc(tsc_end, end);
+        
+        const double seconds = std::chrono::duration<double>(end - start).count();
+        const double frequency = static_cast<double>(tsc_end - tsc_start) / seconds;
+        if (frequency > 1e6) {
+            calibration.tsc = true;
+            calibration.base_ticks = tsc_start;
+            calibration.ticks_per_second = frequency;
+            calibration.ns_per_tick_q32 = static_cast<std::uint64_t>(1e9 / frequency * 4294967296.0);
+            return calibration;
+        }
+    }
+#endif
+    calibration.base_ticks = fallback_ticks();
+    return calibration;
+}
+
+const FastClockCalibration& fast_clock_calibration() {
+    static const FastClockCalibration calibration = calibrate();
+    return calibration;
+}
+
+} // namespace
+
+std::uint64_t FastClock::ticks() noexcept {
+#ifdef WIP_FAST_CLOCK_TSC
+    if (fast_clock_calibration().tsc) {
+        return __rdtsc();
+    }
+#endif
+    return fallback_ticks();
+}
+
+FastClock::time_point FastClock::from_ticks(std::uint64_t ticks) noexcept {
+    const auto& calibration = fast_clock_calibration();
+    // Signed difference so counters read on another core just before calibration stay valid
+    const auto delta = static_cast<std::int64_t>(ticks - calibration.base_ticks);
+#ifdef WIP_FAST_CLOCK_TSC
+    if (calibration.tsc) {
+        const auto scaled = (static_cast<__int128>(delta) * calibration.ns_per_tick_q32) >> 32;
+        return time_point(duration(static_cast<rep>(scaled)));
+    }
+#endif
+    return time_point(duration(delta));
+}
+
+FastClock::time_point FastClock::now() noexcept {
+    return from_ticks(ticks());
+}
+
+double FastClock::ticks_per_second() noexcept {
+    return fast_clock_calibration().ticks_per_second;
+}
+
+bool FastClock::uses_tsc() noexcept {
+    return fast_clock_calibration().tsc;
+}
+
 std::time_t unix_timestamp() {
     return std::chrono::system_clock::to_time_t(now_system());
 }
@@ -269,16 +394,64 @@ void sleep_until(const std::chrono::steady_clock::time_point& time_point) {
     std::this_thread::sleep_until(time_point);
 }
 
+void precise_sleep_until(const std::chrono::steady_clock::time_point& time_point,
+                         std::chrono::nanoseconds spin_margin) {
+    auto sleep_deadline = time_point - spin_margin;
+    if (std::chrono::steady_clock::now() < sleep_deadline) {
+        std::this_thread::sleep_until(sleep_deadline);
+    }
+    
+    // Cover the scheduler's wake-up latency without oversleeping
+    while (std::chrono::steady_clock::now() < time_point) {
+        std::this_thread::yield();
+    }
+}
+
+// FramePacer implementation
+FramePacer::FramePacer(double target_fps) {
+    set_target_fps(target_fps);
+}
+
+void FramePacer::set_target_fps(double target_fps) {
+    target_fps_ = target_fps > 0.0 ? target_fps : 0.0;
+    interval_ = target_fps_ > 0.0
+        ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / target_fps_))
+        : Clock::duration::zero();
+    reset();
+}
+
+void FramePacer::reset() {
+    next_frame_ = Clock::now() + interval_;
+}
+
+FramePacer::Clock::time_point FramePacer::wait_for_next_frame() {
+    if (interval_ == Clock::duration::zero()) {
+        return Clock::now();
+    }
+    
+    auto now = Clock::now();
+    if (now >= next_frame_ + interval_) {
+        // More than a frame behind: start over rather than bursting to catch up
+        next_frame_ = now + interval_;
+        return now;
+    }
+    
+    auto due = next_frame_;
+    precise_sleep_until(due);
+    next_frame_ += interval_;
+    return due;
+}
+
 // Stopwatch implementation
 void Stopwatch::start() {
-    start_time_ = std::chrono::high_resolution_clock::now();
+    start_time_ = FastClock::now();
     running_ = true;
     has_result_ = false;
 }
 
 void Stopwatch::stop() {
     if (running_) {
-        end_time_ = std::chrono::high_resolution_clock::now();
+        end_time_ = FastClock::now();
         running_ = false;
         has_result_ = true;
     }
@@ -291,10 +464,9 @@ void Stopwatch::reset() {
 
 std::chrono::nanoseconds Stopwatch::elapsed() const {
     if (running_) {
-        auto now = std::chrono::high_resolution_clock::now();
-        return std::chrono::duration_cast<std::chrono::nanoseconds>(now - start_time_);
+        return FastClock::now() - start_time_;
     } else if (has_result_) {
-        return std::chrono::duration_cast<std::chrono::nanoseconds>(end_time_ - start_time_);
+        return end_time_ - start_time_;
     } else {
         return std::chrono::nanoseconds::zero();
     }
@@ -310,20 +482,27 @@ bool Stopwatch::is_running() const {
 
 // ScopedTimer implementation
 ScopedTimer::ScopedTimer(const std::string& name) 
-    : name_(name), start_time_(std::chrono::high_resolution_clock::now()) {
+    : name_(name), start_time_(FastClock::now()) {
+}
+
+ScopedTimer::ScopedTimer(std::chrono::nanoseconds& accumulator) 
+    : accumulator_(&accumulator), start_time_(FastClock::now()) {
 }
 
 ScopedTimer::~ScopedTimer() {
-    auto end_time = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time_);
+    auto duration = FastClock::now() - start_time_;
+    
+    if (accumulator_) {
+        *accumulator_ += duration;
+        return;
+    }
     
     std::cout << "[" << name_ << "] Elapsed time: " 
               << to_time_unit(duration, TimeUnit::Milliseconds) << " ms" << std::endl;
 }
 
 std::chrono::nanoseconds ScopedTimer::elapsed() const {
-    auto now = std::chrono::high_resolution_clock::now();
-    return std::chrono::duration_cast<std::chrono::nanoseconds>(now - start_time_);
+    return FastClock::now() - start_time_;
 }
 
 } // namespace utilities
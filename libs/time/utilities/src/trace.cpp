@@ -0,0 +1,259 @@
+#include "trace.h"
+#include "time_utilities.h"
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace wip {
+namespace time {
+namespace utilities {
+
+namespace {
+
+static_assert((TRACE_BUFFER_CAPACITY & (TRACE_BUFFER_CAPACITY - 1)) == 0,
+              "Trace buffer capacity must be a power of two");
+
+struct TraceRecord {
+    const char* name;
+    std::uint64_t ticks;
+    char phase;
+};
+
+/**
+ * @brief Single-producer ring buffer owned by one thread
+ *
+ * The owning thread advances head, the exporter advances tail. reserved
+ * counts open scopes, whose end events already have a slot set aside.
+ */
+struct TraceBuffer {
+    std::unique_ptr<TraceRecord[]> records{new TraceRecord[TRACE_BUFFER_CAPACITY]};
+    alignas(64) std::atomic<std::uint64_t> head{0};
+    alignas(64) std::atomic<std::uint64_t> tail{0};
+    std::uint64_t reserved = 0;
+    std::uint32_t tid = 0;
+    std::string name;                   // Guarded by the registry mutex
+    std::atomic<bool> exited{false};
+};
+
+struct TraceRegistry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<TraceBuffer>> buffers;
+    std::uint32_t next_tid = 1;
+};
+
+std::atomic<bool> enabled{false};
+std::atomic<std::uint64_t> dropped{0};
+
+// Never destroyed, so threads that exit after main() can still reach it
+TraceRegistry& registry() {
+    static TraceRegistry* instance = new TraceRegistry;
+    return *instance;
+}
+
+struct ThreadTrace {
+    std::shared_ptr<TraceBuffer> buffer;
+
+    ~ThreadTrace() {
+        // The registry keeps the buffer until its records are exported
+        if (buffer) buffer->exited.store(true, std::memory_order_release);
+    }
+};
+
+thread_local ThreadTrace thread_trace;
+
+TraceBuffer& thread_buffer() {
+    if (!thread_trace.buffer) {
+        auto buffer = std::make_shared<TraceBuffer>();
+        auto& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        buffer->tid = reg.next_tid++;
+        reg.buffers.push_back(buffer);
+        thread_trace.buffer = std::move(buffer);
+    }
+    return *thread_trace.buffer;
+}
+
+int process_id() {
+#ifdef _WIN32
+    return _getpid();
+#else
+    return static_cast<int>(getpid());
+#endif
+}
+
+void write_json_string(std::ostream& out, const char* text) {
+    out << '"';
+    // Copy runs of plain characters at once; span names rarely need escaping
+    const char* run = text;
+    for (const char* c = text; *c; ++c) {
+        const auto byte = static_cast<unsigned char>(*c);
+        if (byte >= 0x20 && byte != '"' && byte != '\\') continue;
+        
+        out.write(run, c - run);
+        run = c + 1;
+        switch (byte) {
+            case '"':  out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\t': out << "\\t"; break;
+            default: {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(byte));
+                out << escaped;
+            }
+        }
+    }
+    out << run << '"';
+}
+
+// Nanoseconds as microseconds with three decimals, without going through double
+void write_microseconds(std::ostream& out, std::int64_t ns) {
+    if (ns < 0) {
+        out << '-';
+        ns = -ns;
+    }
+    const auto fraction = ns % 1000;
+    out << ns / 1000 << '.' << static_cast<char>('0' + fraction / 100)
+        << static_cast<char>('0' + fraction / 10 % 10) << static_cast<char>('0' + fraction % 10);
+}
+
+} // namespace
+
+void set_tracing_enabled(bool value) {
+    if (value) {
+        // Calibrate now rather than inside the first span
+        FastClock::ticks();
+    }
+    enabled.store(value, std::memory_order_relaxed);
+}
+
+bool tracing_enabled() {
+    return enabled.load(std::memory_order_relaxed);
+}
+
+void set_trace_thread_name(const std::string& name) {
+    auto& buffer = thread_buffer();
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    buffer.name = name;
+}
+
+std::uint64_t dropped_trace_scopes() {
+    return dropped.load(std::memory_order_relaxed);
+}
+
+std::size_t write_chrome_trace(std::ostream& out) {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    const int pid = process_id();
+    std::size_t events = 0;
+    bool first = true;
+
+    out << "{\"traceEvents\":[";
+    for (const auto& buffer : reg.buffers) {
+        if (buffer->name.empty()) continue;
+        out << (first ? "\n" : ",\n");
+        first = false;
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid
+            << ",\"tid\":" << buffer->tid << ",\"args\":{\"name\":";
+        write_json_string(out, buffer->name.c_str());
+        out << "}}";
+    }
+
+    for (auto it = reg.buffers.begin(); it != reg.buffers.end();) {
+        auto& buffer = **it;
+        // Read before head, so an exited thread's last records are all visible
+        const bool exited = buffer.exited.load(std::memory_order_acquire);
+        const std::uint64_t tail = buffer.tail.load(std::memory_order_relaxed);
+        const std::uint64_t head = buffer.head.load(std::memory_order_acquire);
+
+        const std::string thread_fields = ",\"pid\":" + std::to_string(pid) + ",\"tid\":" + std::to_string(buffer.tid) + ",\"ts\":";
+        for (std::uint64_t i = tail; i != head; ++i) {
+            const TraceRecord& record = buffer.records[i & (TRACE_BUFFER_CAPACITY - 1)];
+            const auto ns = FastClock::from_ticks(record.ticks).time_since_epoch().count();
+
+            out << (first ? "\n" : ",\n");
+            first = false;
+            // End events close the innermost open span, so they carry no name
+            out << '{';
+            if (record.name) {
+                out << "\"name\":";
+                write_json_string(out, record.name);
+                out << ',';
+            }
+            out << "\"ph\":\"" << record.phase << '"' << thread_fields;
+            write_microseconds(out, ns);
+            out << '}';
+            ++events;
+        }
+        buffer.tail.store(head, std::memory_order_release);
+
+        it = exited ? reg.buffers.erase(it) : it + 1;
+    }
+    out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+    return events;
+}
+
+bool save_chrome_trace(const std::string& path) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    write_chrome_trace(file);
+    return static_cast<bool>(file);
+}
+
+// ScopedTrace implementation
+ScopedTrace::ScopedTrace(const char* name) noexcept {
+    if (!enabled.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    TraceBuffer* buffer;
+    try {
+        buffer = &thread_buffer();
+    } catch (const std::bad_alloc&) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // Room for this begin, its end and the ends of every scope still open
+    const std::uint64_t head = buffer->head.load(std::memory_order_relaxed);
+    const std::uint64_t tail = buffer->tail.load(std::memory_order_acquire);
+    if (head - tail + buffer->reserved + 2 > TRACE_BUFFER_CAPACITY) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    buffer->records[head & (TRACE_BUFFER_CAPACITY - 1)] = {name, FastClock::ticks(), 'B'};
+    buffer->head.store(head + 1, std::memory_order_release);
+    ++buffer->reserved;
+    recorded_ = true;
+}
+
+ScopedTrace::~ScopedTrace() {
+    if (!recorded_) {
+        return;
+    }
+
+    // The slot was set aside when the scope began; tail only moves forward since
+    auto& buffer = *thread_trace.buffer;
+    const std::uint64_t head = buffer.head.load(std::memory_order_relaxed);
+    buffer.records[head & (TRACE_BUFFER_CAPACITY - 1)] = {nullptr, FastClock::ticks(), 'E'};
+    buffer.head.store(head + 1, std::memory_order_release);
+    --buffer.reserved;
+}
+
+} // namespace utilities
+} // namespace time
+} // namespace wip
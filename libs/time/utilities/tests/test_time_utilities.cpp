@@ -1,7 +1,10 @@
 #include "time_utilities.h"
+#include "trace.h"
 #include <gtest/gtest.h>
 #include <thread>
 #include <chrono>
+#include <sstream>
+#include <string>
 
 using namespace wip::time::utilities;
 
@@ -113,6 +116,22 @@ TEST_F(TimeUtilitiesTest, ScopedTimer) {
     }
 }
 
+TEST_F(TimeUtilitiesTest, ScopedTimerAccumulates) {
+    std::chrono::nanoseconds total{0};
+    {
+        ScopedTimer timer(total);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    auto first = total;
+    EXPECT_GE(first, std::chrono::milliseconds(5));
+    
+    {
+        ScopedTimer timer(total);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_GE(total - first, std::chrono::milliseconds(5));
+}
+
 TEST_F(TimeUtilitiesTest, TimeConversions) {
     auto seconds = to_time_unit(std::chrono::minutes(2), TimeUnit::Seconds);
     EXPECT_EQ(seconds, 120);
@@ -137,4 +156,142 @@ TEST_F(TimeUtilitiesTest, SleepFunctions) {
     
     EXPECT_GE(elapsed.count(), 8);  // Allow some margin for timing precision
     EXPECT_LE(elapsed.count(), 50); // But not too much
-}
\ No newline at end of file
+}
+TEST_F(TimeUtilitiesTest, PreciseSleepNeverWakesEarly) {
+    for (int i = 0; i < 5; ++i) {
+        auto deadline = now_steady() + std::chrono::microseconds(2500);
+        precise_sleep_until(deadline);
+        
+        auto woke = now_steady();
+        EXPECT_GE(woke, deadline);
+        EXPECT_LE(woke - deadline, std::chrono::milliseconds(20));  // Generous for loaded machines
+    }
+}
+
+TEST_F(TimeUtilitiesTest, FramePacerKeepsAbsoluteSchedule) {
+    FramePacer pacer(200.0);
+    EXPECT_EQ(pacer.frame_interval(), std::chrono::milliseconds(5));
+    
+    auto start = now_steady();
+    auto previous = start;
+    for (int frame = 0; frame < 10; ++frame) {
+        auto due = pacer.wait_for_next_frame();
+        EXPECT_GT(due, previous);
+        previous = due;
+    }
+    
+    // Ten frames of 5 ms, without the drift of sleeping 5 ms after each frame
+    auto elapsed = now_steady() - start;
+    EXPECT_GE(elapsed, std::chrono::milliseconds(50));
+    EXPECT_LE(elapsed, std::chrono::milliseconds(100));
+}
+
+TEST_F(TimeUtilitiesTest, FramePacerDoesNotBurstAfterStall) {
+    FramePacer pacer(200.0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    
+    // Six frames were missed; the pacer starts over instead of running them back to back
+    pacer.wait_for_next_frame();
+    auto start = now_steady();
+    pacer.wait_for_next_frame();
+    EXPECT_GE(now_steady() - start, std::chrono::milliseconds(4));
+}
+
+TEST_F(TimeUtilitiesTest, UnpacedFramePacerDoesNotWait) {
+    FramePacer pacer;
+    EXPECT_EQ(pacer.frame_interval(), std::chrono::steady_clock::duration::zero());
+    
+    auto start = now_steady();
+    for (int frame = 0; frame < 100; ++frame) {
+        pacer.wait_for_next_frame();
+    }
+    EXPECT_LT(now_steady() - start, std::chrono::milliseconds(5));
+}
+
+TEST_F(TimeUtilitiesTest, FastClockTracksSteadyClock) {
+    auto fast_start = FastClock::now();
+    auto steady_start = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    auto fast_elapsed = FastClock::now() - fast_start;
+    auto steady_elapsed = std::chrono::steady_clock::now() - steady_start;
+    
+    EXPECT_GT(FastClock::ticks_per_second(), 0.0);
+    EXPECT_GE(fast_elapsed, std::chrono::milliseconds(20));
+    auto difference = std::chrono::duration_cast<std::chrono::nanoseconds>(fast_elapsed - steady_elapsed);
+    EXPECT_LT(std::abs(difference.count()), 1000000);
+}
+
+TEST_F(TimeUtilitiesTest, FastClockIsMonotonic) {
+    auto previous = FastClock::now();
+    for (int i = 0; i < 100000; ++i) {
+        auto now = FastClock::now();
+        ASSERT_GE(now, previous);
+        previous = now;
+    }
+    
+    auto ticks = FastClock::ticks();
+    EXPECT_GE(FastClock::from_ticks(ticks), previous);
+}
+
+TEST_F(TimeUtilitiesTest, TraceScopeExportsBalancedChromeEvents) {
+    std::ostringstream discard;
+    write_chrome_trace(discard);
+    
+    set_tracing_enabled(true);
+    set_trace_thread_name("main \"test\"");
+    {
+        TRACE_SCOPE("outer");
+        TRACE_SCOPE("inner");
+    }
+    std::thread worker([]() {
+        set_trace_thread_name("worker");
+        TRACE_SCOPE("work");
+    });
+    worker.join();
+    set_tracing_enabled(false);
+    {
+        TRACE_SCOPE("not recorded");
+    }
+    
+    std::ostringstream out;
+    EXPECT_EQ(write_chrome_trace(out), 6u);
+    auto json = out.str();
+    EXPECT_EQ(json.rfind("{\"traceEvents\":[", 0), 0u);
+    EXPECT_NE(json.find("\"args\":{\"name\":\"main \\\"test\\\"\"}"), std::string::npos);
+    EXPECT_NE(json.find("\"args\":{\"name\":\"worker\"}"), std::string::npos);
+    EXPECT_LT(json.find("\"name\":\"outer\",\"ph\":\"B\""), json.find("\"name\":\"inner\",\"ph\":\"B\""));
+    EXPECT_NE(json.find("\"name\":\"work\",\"ph\":\"B\""), std::string::npos);
+    EXPECT_EQ(json.find("not recorded"), std::string::npos);
+    
+    size_t begins = 0, ends = 0;
+    for (size_t at = json.find("\"ph\":\"B\""); at != std::string::npos; at = json.find("\"ph\":\"B\"", at + 1)) ++begins;
+    for (size_t at = json.find("\"ph\":\"E\""); at != std::string::npos; at = json.find("\"ph\":\"E\"", at + 1)) ++ends;
+    EXPECT_EQ(begins, 3u);
+    EXPECT_EQ(ends, 3u);
+    
+    // Exporting drains the buffers, and the exited worker is forgotten
+    std::ostringstream again;
+    EXPECT_EQ(write_chrome_trace(again), 0u);
+    EXPECT_EQ(again.str().find("worker"), std::string::npos);
+}
+
+TEST_F(TimeUtilitiesTest, TraceScopeDropsWholeSpansWhenFull) {
+    std::ostringstream discard;
+    write_chrome_trace(discard);
+    auto dropped_before = dropped_trace_scopes();
+    
+    set_tracing_enabled(true);
+    {
+        TRACE_SCOPE("held open");
+        for (size_t i = 0; i < TRACE_BUFFER_CAPACITY; ++i) {
+            TRACE_SCOPE("filler");
+        }
+    }
+    set_tracing_enabled(false);
+    
+    std::ostringstream out;
+    size_t events = write_chrome_trace(out);
+    EXPECT_EQ(events % 2, 0u);
+    EXPECT_LE(events, TRACE_BUFFER_CAPACITY);
+    EXPECT_EQ(dropped_trace_scopes() - dropped_before, TRACE_BUFFER_CAPACITY + 1 - events / 2);
+}
@@ -0,0 +1,90 @@
+// Benchmark for running short work through the default thread pool.
+//
+// Runs batches of small tasks the way the analysis code uses std::async:
+// start a batch, then wait for every result. Compares std::async with
+// std::launch::async, which creates a thread per task, against async() on
+// the default pool, collecting results with get() and with when_all(), and
+// a chain of then() continuations. Reports nanoseconds per task. Usage:
+//
+//   bench_wip_utils_concurrency [task-count] [batch-size]
+
+#include "benchmark.h"
+#include "task.h"
+#include <algorithm>
+#include <future>
+#include <vector>
+
+using namespace wip::utils::concurrency;
+
+namespace {
+
+// A few microseconds of work, like parsing a short range of a file
+uint64_t work(uint64_t seed) {
+    uint64_t value = seed;
+    for (int i = 0; i < 2000; ++i) {
+        value = value * 6364136223846793005ULL + 1442695040888963407ULL;
+    }
+    return value;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    wip::benchmark::Runner runner("bench_wip_utils_concurrency", argc, argv, "[task-count] [batch-size]");
+    size_t task_count = std::max<size_t>(runner.argument(0, 20000), 1);
+    size_t batch_size = std::max<size_t>(runner.argument(1, 16), 1);
+    runner.out() << task_count << " tasks in batches of " << batch_size << ", "
+                 << default_thread_pool().get_worker_count() << " pool workers" << std::endl;
+
+    runner.measure("std::async", task_count, [&]() {
+        uint64_t sum = 0;
+        for (size_t done = 0; done < task_count; done += batch_size) {
+            std::vector<std::future<uint64_t>> batch;
+            for (size_t i = done; i < std::min(task_count, done + batch_size); ++i) {
+                batch.push_back(std::async(std::launch::async, [i]() { return work(i); }));
+            }
+            for (auto& future : batch) {
+                sum += future.get();
+            }
+        }
+        return sum;
+    });
+
+    runner.measure("pool async, get", task_count, [&]() {
+        uint64_t sum = 0;
+        for (size_t done = 0; done < task_count; done += batch_size) {
+            std::vector<Task<uint64_t>> batch;
+            for (size_t i = done; i < std::min(task_count, done + batch_size); ++i) {
+                batch.push_back(async([i]() { return work(i); }));
+            }
+            for (auto& task : batch) {
+                sum += task.get();
+            }
+        }
+        return sum;
+    });
+
+    runner.measure("pool async, when_all", task_count, [&]() {
+        uint64_t sum = 0;
+        for (size_t done = 0; done < task_count; done += batch_size) {
+            std::vector<Task<uint64_t>> batch;
+            for (size_t i = done; i < std::min(task_count, done + batch_size); ++i) {
+                batch.push_back(async([i]() { return work(i); }));
+            }
+            for (uint64_t value : when_all(std::move(batch)).get()) {
+                sum += value;
+            }
+        }
+        return sum;
+    });
+
+    runner.measure("then chain", task_count, [&]() {
+        Task<uint64_t> chain = make_ready_task(uint64_t(0));
+        for (size_t i = 0; i < task_count; ++i) {
+            chain = chain.then([i](uint64_t value) { return value + work(i); });
+        }
+        return chain.get();
+    });
+
+    return runner.finish();
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <memory>
+
+namespace wip::utils::concurrency {
+
+/**
+ * @brief Shared flag for stopping work running on other threads
+ * 
+ * Copies refer to the same flag. A default-constructed token can never be
+ * cancelled; use create() for one that can. Tasks started with a token are
+ * skipped if it is cancelled before they run, and long-running work polls
+ * is_cancelled() or waits on get_wait_fd() to stop early. Processes started
+ * with a token are signalled as soon as it is cancelled (see ProcessConfig).
+ * 
+ * Usage:
+ * ```cpp
+ * auto token = CancellationToken::create();
+ * auto task = async(token, [token]() { while (!token.is_cancelled()) { step(); } });
+ * token.cancel();   // From any thread
+ * ```
+ */
+class CancellationToken {
+public:
+    CancellationToken() = default;
+    
+    /**
+     * @brief Create a token that can be cancelled
+     */
+    static CancellationToken create();
+    
+    /**
+     * @brief Request cancellation (no effect on a default-constructed token)
+     */
+    void cancel() const;
+    
+    /**
+     * @brief Check whether cancellation was requested
+     */
+    bool is_cancelled() const;
+    
+    /**
+     * @brief Check whether the token was created with create()
+     */
+    bool can_be_cancelled() const { return state_ != nullptr; }
+    
+    /**
+     * @brief Get a descriptor that polls readable once the token is cancelled
+     * @return Descriptor owned by the token, or -1 if unavailable
+     */
+    int get_wait_fd() const;
+    
+    bool operator==(const CancellationToken& other) const { return state_ == other.state_; }
+    bool operator!=(const CancellationToken& other) const { return state_ != other.state_; }
+
+private:
+    struct State;
+    std::shared_ptr<State> state_;
+};
+
+} // namespace wip::utils::concurrency
@@ -0,0 +1,186 @@
+#pragma once
+
+#include "task.h"
+
+/**
+ * Coroutine front-end for Task, available when the libraries are built as
+ * C++20 (ENABLE_COROUTINES). WIP_HAS_COROUTINES tells code whether it is.
+ *
+ * A function returning Task<T> may be a coroutine:
+ *
+ * ```cpp
+ * Task<size_t> count_issues(ManualExecutor& ui, ProcessConfig config) {
+ *     co_await resume_on(default_thread_pool());     // Leave the caller's thread
+ *     ProcessResult result = co_await ProcessExecutor::execute_async(std::move(config));
+ *     size_t issues = parse(result.stdout_output);
+ *     co_await resume_on(ui);                        // Continue on the UI thread
+ *     show(issues);
+ *     co_return issues;
+ * }
+ * ```
+ *
+ * The coroutine starts at once on the calling thread and runs up to its
+ * first suspension. co_await on a Task takes its result (or rethrows its
+ * exception) without blocking a thread; the coroutine carries on on the
+ * thread that finished the awaited task. resume_on() moves it to a
+ * ThreadPool, a ManualExecutor, or anything else with a post(function).
+ *
+ * The returned Task behaves like any other: get() and wait() block and run
+ * awaited work nobody took yet, then() and when_all() accept it. Never block
+ * a thread on a coroutine that still has to resume on that thread's
+ * ManualExecutor; poll is_ready() there instead.
+ */
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include <coroutine>
+
+#define WIP_HAS_COROUTINES 1
+
+namespace wip::utils::concurrency {
+namespace detail {
+
+template<typename Promise>
+struct FinalAwaiter {
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<Promise> handle) noexcept { handle.promise().finish(handle); }
+    void await_resume() const noexcept {}
+};
+
+template<typename T>
+class TaskPromiseBase {
+public:
+    std::suspend_never initial_suspend() const noexcept { return {}; }
+    void unhandled_exception() noexcept { error_ = std::current_exception(); }
+
+    /**
+     * @brief State of the Task the coroutine returned, so awaited tasks can be noted as its dependencies
+     */
+    TaskStateBase& task_state() { return *state_; }
+
+protected:
+    std::shared_ptr<TaskState<T>> state_ = std::make_shared<TaskState<T>>(nullptr);
+    std::exception_ptr error_;
+};
+
+template<typename T>
+class TaskPromise : public TaskPromiseBase<T> {
+public:
+    Task<T> get_return_object() { return Task<T>(this->state_); }
+    FinalAwaiter<TaskPromise> final_suspend() const noexcept { return {}; }
+
+    template<typename U>
+    void return_value(U&& value) {
+        value_.emplace(std::forward<U>(value));
+    }
+
+    // The frame, and with it every local of the coroutine, is gone before a waiter wakes
+    void finish(std::coroutine_handle<TaskPromise> handle) noexcept {
+        auto state = std::move(this->state_);
+        auto error = std::move(this->error_);
+        auto value = std::move(value_);
+        handle.destroy();
+        if (error) {
+            state->fail(std::move(error));
+        } else {
+            state->set_value(std::move(*value));
+        }
+    }
+
+private:
+    std::optional<T> value_;
+};
+
+template<>
+class TaskPromise<void> : public TaskPromiseBase<void> {
+public:
+    Task<void> get_return_object() { return Task<void>(state_); }
+    FinalAwaiter<TaskPromise> final_suspend() const noexcept { return {}; }
+    void return_void() const noexcept {}
+
+    void finish(std::coroutine_handle<TaskPromise> handle) noexcept {
+        auto state = std::move(state_);
+        auto error = std::move(error_);
+        handle.destroy();
+        if (error) {
+            state->fail(std::move(error));
+        } else {
+            state->set_value();
+        }
+    }
+};
+
+template<typename T>
+class TaskAwaiter {
+public:
+    explicit TaskAwaiter(Task<T>&& task) : state_(std::move(task.state_)) {}
+
+    bool await_ready() const { return state_->is_ready(); }
+
+    template<typename Promise>
+    bool await_suspend(std::coroutine_handle<Promise> handle) {
+        // Lets a thread blocked on the coroutine's Task run the awaited work if no worker took it
+        if constexpr (requires(Promise& promise) { promise.task_state(); }) {
+            handle.promise().task_state().add_dependency(state_);
+        }
+
+        // Whichever of this call and the continuation comes second resumes, so a task
+        // finishing meanwhile continues the coroutine here instead of one level deeper
+        state_->on_done([this, handle]() {
+            if (resume_claimed_.exchange(true)) {
+                handle.resume();
+            }
+        });
+        return !resume_claimed_.exchange(true);
+    }
+
+    T await_resume() { return state_->take(); }
+
+private:
+    std::shared_ptr<TaskState<T>> state_;
+    std::atomic<bool> resume_claimed_{false};
+};
+
+template<typename Executor>
+class ResumeOnAwaiter {
+public:
+    explicit ResumeOnAwaiter(Executor& executor) : executor_(executor) {}
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle) { executor_.post([handle]() { handle.resume(); }); }
+    void await_resume() const noexcept {}
+
+private:
+    Executor& executor_;
+};
+
+} // namespace detail
+
+/**
+ * @brief Suspend until the task is done, then take its value; the task is invalid afterwards
+ * @throws Whatever the task's work threw, or TaskCancelled
+ */
+template<typename T>
+detail::TaskAwaiter<T> operator co_await(Task<T>&& task) {
+    return detail::TaskAwaiter<T>(std::move(task));
+}
+
+/**
+ * @brief Continue the coroutine as a job of the executor (ThreadPool, ManualExecutor, ...)
+ *
+ * The executor must run the job eventually; a coroutine whose job is never
+ * run never finishes, and its Task is never ready.
+ */
+template<typename Executor>
+detail::ResumeOnAwaiter<Executor> resume_on(Executor& executor) {
+    return detail::ResumeOnAwaiter<Executor>(executor);
+}
+
+} // namespace wip::utils::concurrency
+
+template<typename T, typename... Args>
+struct std::coroutine_traits<wip::utils::concurrency::Task<T>, Args...> {
+    using promise_type = wip::utils::concurrency::detail::TaskPromise<T>;
+};
+
+#endif
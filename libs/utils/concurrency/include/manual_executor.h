@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace wip::utils::concurrency {
+
+/**
+ * @brief Queue of jobs run by whichever thread calls run_pending()
+ *
+ * Lets work finishing on a pool hand its last step to one particular thread,
+ * typically the UI thread, which runs the queued jobs once per frame. Has the
+ * same post() as ThreadPool, so either can be given where work is to resume
+ * (see resume_on() in coroutine.h).
+ *
+ * Usage:
+ * ```cpp
+ * ManualExecutor ui_executor;
+ * async([&ui_executor]() {
+ *     auto results = parse();
+ *     ui_executor.post([results]() { show(results); });
+ * });
+ * // Once per frame
+ * ui_executor.run_pending();
+ * ```
+ */
+class ManualExecutor {
+public:
+    using Job = std::function<void()>;
+
+    ManualExecutor() = default;
+
+    ManualExecutor(const ManualExecutor&) = delete;
+    ManualExecutor& operator=(const ManualExecutor&) = delete;
+
+    /**
+     * @brief Queue a job; safe to call from any thread
+     */
+    void post(Job job);
+
+    /**
+     * @brief Run the jobs queued so far on the calling thread
+     *
+     * Jobs posted while running wait for the next call, so a job that posts
+     * itself again cannot keep the caller here.
+     *
+     * @return Number of jobs run
+     */
+    size_t run_pending();
+
+    /**
+     * @brief Get number of jobs waiting for run_pending()
+     */
+    size_t get_pending_count() const;
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<Job> jobs_;
+};
+
+} // namespace wip::utils::concurrency
@@ -0,0 +1,433 @@
+#pragma once
+
+#include "cancellation_token.h"
+#include "thread_pool.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace wip::utils::concurrency {
+
+/**
+ * @brief Thrown by Task::get() for a task whose token was cancelled before it started
+ */
+class TaskCancelled : public std::runtime_error {
+public:
+    TaskCancelled() : std::runtime_error("Task cancelled before it started") {}
+};
+
+template<typename T>
+class Task;
+
+namespace detail {
+
+template<typename T>
+class TaskPromise;
+template<typename T>
+class TaskAwaiter;
+
+/**
+ * @brief Completion state shared by a Task, the job running it and its continuations
+ */
+class TaskStateBase {
+public:
+    explicit TaskStateBase(ThreadPool* pool) : pool_(pool) {}
+    virtual ~TaskStateBase() = default;
+
+    TaskStateBase(const TaskStateBase&) = delete;
+    TaskStateBase& operator=(const TaskStateBase&) = delete;
+
+    /**
+     * @brief Give the state its work and queue it on the pool
+     */
+    static void schedule(const std::shared_ptr<TaskStateBase>& state, std::function<void()> work);
+
+    /**
+     * @brief Run the work on the calling thread unless it was already taken
+     * @return true if this call ran it
+     */
+    bool try_run();
+
+    /**
+     * @brief Block until done, running the work (and what it waits for) here if no worker took it yet
+     */
+    void wait();
+
+    /**
+     * @brief Block until done or the timeout passes, without running anything here
+     * @return true if done
+     */
+    bool wait_for(std::chrono::nanoseconds timeout);
+
+    bool is_ready() const;
+
+    /**
+     * @brief Call a function once done, at once if already done
+     *
+     * Runs on the thread that completes the state, so it must be quick.
+     */
+    void on_done(std::function<void()> continuation);
+
+    /**
+     * @brief Note a state whose work must finish first, so wait() can run it here
+     */
+    void add_dependency(std::shared_ptr<TaskStateBase> dependency);
+
+    void fail(std::exception_ptr error);
+    void rethrow_if_failed() const;
+    ThreadPool& pool() const { return pool_ ? *pool_ : default_thread_pool(); }
+
+protected:
+    void finish();
+
+private:
+    ThreadPool* pool_;
+    mutable std::mutex mutex_;
+    std::condition_variable done_changed_;
+    bool done_ = false;
+    bool claimed_ = false;
+    std::function<void()> work_;
+    std::exception_ptr error_;
+    std::vector<std::function<void()>> continuations_;
+    std::vector<std::shared_ptr<TaskStateBase>> dependencies_;
+    size_t dependency_generation_ = 0;
+};
+
+template<typename T>
+class TaskState : public TaskStateBase {
+public:
+    using TaskStateBase::TaskStateBase;
+
+    void set_value(T value) {
+        value_.emplace(std::move(value));
+        finish();
+    }
+
+    T take() {
+        rethrow_if_failed();
+        return std::move(*value_);
+    }
+
+private:
+    std::optional<T> value_;
+};
+
+template<>
+class TaskState<void> : public TaskStateBase {
+public:
+    using TaskStateBase::TaskStateBase;
+
+    void set_value() { finish(); }
+    void take() { rethrow_if_failed(); }
+};
+
+// Run a callable and store what it returns, or what it throws, in the state
+template<typename T, typename F, typename... Args>
+void complete(TaskState<T>& state, F& function, Args&&... args) {
+    try {
+        if constexpr (std::is_void_v<T>) {
+            function(std::forward<Args>(args)...);
+            state.set_value();
+        } else {
+            state.set_value(function(std::forward<Args>(args)...));
+        }
+    } catch (...) {
+        state.fail(std::current_exception());
+    }
+}
+
+template<typename F, typename T>
+struct ContinuationResult {
+    using type = std::invoke_result_t<F, T>;
+};
+
+template<typename F>
+struct ContinuationResult<F, void> {
+    using type = std::invoke_result_t<F>;
+};
+
+} // namespace detail
+
+/**
+ * @brief Result of work running on a ThreadPool, replacing std::future from std::async
+ *
+ * Works like the std::future that std::async returns: get() waits for the
+ * value or rethrows what the work threw, wait_for() polls, and destroying an
+ * unfinished Task waits for it, so work referring to its caller never
+ * outlives it. Unlike std::async, the work runs on a pool worker instead of a
+ * thread of its own, and a thread waiting for work that no worker has taken
+ * yet runs it itself, so waiting on a task from inside another one cannot
+ * starve a fully busy pool.
+ *
+ * then() chains work to run once the task is done, and when_all() combines
+ * tasks into one. In a C++20 build, coroutine.h also lets a coroutine return
+ * a Task and co_await one.
+ *
+ * Usage:
+ * ```cpp
+ * Task<std::string> text = async([path]() { return read_file(path); });
+ * Task<size_t> lines = text.then([](std::string content) { return count_lines(content); });
+ * size_t count = lines.get();
+ * ```
+ */
+template<typename T>
+class Task {
+public:
+    Task() = default;
+
+    ~Task() { release(); }
+
+    Task(Task&& other) noexcept = default;
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            release();
+            state_ = std::move(other.state_);
+        }
+        return *this;
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    /**
+     * @brief Check whether the task refers to work (false after get(), then() or a move)
+     */
+    bool valid() const { return state_ != nullptr; }
+
+    bool is_ready() const { return state_ && state_->is_ready(); }
+
+    /**
+     * @brief Block until the work is done
+     */
+    void wait() const {
+        if (state_) {
+            state_->wait();
+        }
+    }
+
+    /**
+     * @brief Block until the work is done or the timeout passes
+     */
+    template<typename Rep, typename Period>
+    std::future_status wait_for(const std::chrono::duration<Rep, Period>& timeout) const {
+        return state_->wait_for(std::chrono::duration_cast<std::chrono::nanoseconds>(timeout))
+                   ? std::future_status::ready
+                   : std::future_status::timeout;
+    }
+
+    /**
+     * @brief Wait for the result and take it; the task is invalid afterwards
+     * @throws Whatever the work threw, or TaskCancelled
+     */
+    T get() {
+        auto state = std::move(state_);
+        state->wait();
+        return state->take();
+    }
+
+    /**
+     * @brief Run a function on the result once the task is done; the task is invalid afterwards
+     *
+     * The function runs on the pool of this task and gets the value (nothing
+     * for Task<void>). If this task failed, the returned one fails with the
+     * same exception and the function is not called.
+     *
+     * @return Task for what the function returns
+     */
+    template<typename F>
+    auto then(F function) -> Task<typename detail::ContinuationResult<F, T>::type> {
+        using Result = typename detail::ContinuationResult<F, T>::type;
+        auto antecedent = std::move(state_);
+        auto next = std::make_shared<detail::TaskState<Result>>(&antecedent->pool());
+        next->add_dependency(antecedent);
+
+        std::weak_ptr<detail::TaskState<Result>> weak_next = next;
+        antecedent->on_done([antecedent_state = antecedent.get(), weak_next, function = std::move(function)]() mutable {
+            auto next_state = weak_next.lock();
+            if (!next_state) {
+                return;
+            }
+            // The antecedent stays alive as a dependency of next until next finishes
+            detail::TaskStateBase::schedule(next_state, [antecedent_state, next = next_state.get(),
+                                                         function = std::move(function)]() mutable {
+                if constexpr (std::is_void_v<T>) {
+                    try {
+                        antecedent_state->rethrow_if_failed();
+                    } catch (...) {
+                        next->fail(std::current_exception());
+                        return;
+                    }
+                    detail::complete(*next, function);
+                } else {
+                    std::optional<T> value;
+                    try {
+                        value.emplace(static_cast<detail::TaskState<T>*>(antecedent_state)->take());
+                    } catch (...) {
+                        next->fail(std::current_exception());
+                        return;
+                    }
+                    detail::complete(*next, function, std::move(*value));
+                }
+            });
+        });
+        return Task<Result>(std::move(next));
+    }
+
+private:
+    template<typename U>
+    friend class Task;
+    template<typename U>
+    friend Task<std::decay_t<U>> make_ready_task(U&& value);
+    friend Task<void> make_ready_task();
+    template<typename U>
+    friend auto when_all(std::vector<Task<U>> tasks)
+        -> Task<std::conditional_t<std::is_void_v<U>, void, std::vector<U>>>;
+    template<typename F>
+    friend auto async(ThreadPool& pool, CancellationToken token, F function) -> Task<std::invoke_result_t<F&>>;
+    template<typename U>
+    friend class detail::TaskPromise;
+    template<typename U>
+    friend class detail::TaskAwaiter;
+
+    explicit Task(std::shared_ptr<detail::TaskState<T>> state) : state_(std::move(state)) {}
+
+    void release() {
+        if (state_) {
+            state_->wait();
+            state_.reset();
+        }
+    }
+
+    std::shared_ptr<detail::TaskState<T>> state_;
+};
+
+/**
+ * @brief Run a function on a pool, skipping it if the token is cancelled before it starts
+ */
+template<typename F>
+auto async(ThreadPool& pool, CancellationToken token, F function) -> Task<std::invoke_result_t<F&>> {
+    using Result = std::invoke_result_t<F&>;
+    auto state = std::make_shared<detail::TaskState<Result>>(&pool);
+    detail::TaskStateBase::schedule(state, [state = state.get(), token = std::move(token),
+                                            function = std::move(function)]() mutable {
+        if (token.is_cancelled()) {
+            state->fail(std::make_exception_ptr(TaskCancelled()));
+            return;
+        }
+        detail::complete(*state, function);
+    });
+    return Task<Result>(std::move(state));
+}
+
+/**
+ * @brief Run a function on a pool
+ */
+template<typename F>
+auto async(ThreadPool& pool, F function) {
+    return async(pool, CancellationToken(), std::move(function));
+}
+
+/**
+ * @brief Run a function on the default pool, skipping it if the token is cancelled before it starts
+ */
+template<typename F>
+auto async(CancellationToken token, F function) {
+    return async(default_thread_pool(), std::move(token), std::move(function));
+}
+
+/**
+ * @brief Run a function on the default pool
+ */
+template<typename F>
+auto async(F function) {
+    return async(default_thread_pool(), CancellationToken(), std::move(function));
+}
+
+/**
+ * @brief Get a task that is already done with a value
+ */
+template<typename U>
+Task<std::decay_t<U>> make_ready_task(U&& value) {
+    auto state = std::make_shared<detail::TaskState<std::decay_t<U>>>(nullptr);
+    state->set_value(std::forward<U>(value));
+    return Task<std::decay_t<U>>(std::move(state));
+}
+
+/**
+ * @brief Get a Task<void> that is already done
+ */
+inline Task<void> make_ready_task() {
+    auto state = std::make_shared<detail::TaskState<void>>(nullptr);
+    state->set_value();
+    return Task<void>(std::move(state));
+}
+
+/**
+ * @brief Combine tasks into one that is done when all of them are
+ *
+ * The values come in the order of the tasks. If any task fails, the combined
+ * task fails with the exception of the first failed one in that order.
+ *
+ * @return Task<std::vector<T>>, or Task<void> for Task<void> inputs
+ */
+template<typename T>
+auto when_all(std::vector<Task<T>> tasks) -> Task<std::conditional_t<std::is_void_v<T>, void, std::vector<T>>> {
+    using Result = std::conditional_t<std::is_void_v<T>, void, std::vector<T>>;
+    auto combined = std::make_shared<detail::TaskState<Result>>(nullptr);
+
+    auto inputs = std::make_shared<std::vector<std::shared_ptr<detail::TaskState<T>>>>();
+    inputs->reserve(tasks.size());
+    for (auto& task : tasks) {
+        inputs->push_back(std::move(task.state_));
+    }
+
+    auto collect = [combined_state = combined.get(), inputs]() {
+        try {
+            if constexpr (std::is_void_v<T>) {
+                for (auto& input : *inputs) {
+                    input->take();
+                }
+                combined_state->set_value();
+            } else {
+                std::vector<T> values;
+                values.reserve(inputs->size());
+                for (auto& input : *inputs) {
+                    values.push_back(input->take());
+                }
+                combined_state->set_value(std::move(values));
+            }
+        } catch (...) {
+            combined_state->fail(std::current_exception());
+        }
+    };
+
+    if (inputs->empty()) {
+        collect();
+        return Task<Result>(std::move(combined));
+    }
+
+    // The last input to finish collects the values; the inputs stay alive as dependencies until then
+    auto remaining = std::make_shared<std::atomic<size_t>>(inputs->size());
+    for (auto& input : *inputs) {
+        combined->add_dependency(input);
+    }
+    for (auto& input : *inputs) {
+        input->on_done([remaining, collect]() {
+            if (remaining->fetch_sub(1) == 1) {
+                collect();
+            }
+        });
+    }
+    return Task<Result>(std::move(combined));
+}
+
+} // namespace wip::utils::concurrency
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace wip::utils::concurrency {
+
+/**
+ * @brief Long-lived thread pool with per-worker job deques and work stealing
+ *
+ * Every worker owns a deque. Jobs posted from outside the pool are spread
+ * round-robin over the deques; jobs posted from inside a job go to the
+ * posting worker's own deque. A worker takes jobs from the back of its own
+ * deque and, when it runs dry, steals from the front of the others.
+ *
+ * The workers live as long as the pool, so running work through it costs a
+ * queue operation instead of creating a thread. Most code uses the process
+ * wide default_thread_pool() through async() (see task.h), which makes its
+ * size the one place concurrency is capped.
+ *
+ * Usage:
+ * ```cpp
+ * ThreadPool pool(4);
+ * pool.post([]() { compress_chunk(); });
+ * ```
+ */
+class ThreadPool {
+public:
+    using Job = std::function<void()>;
+
+    /**
+     * @brief Start the worker threads
+     * @param worker_count Number of workers (0 = hardware concurrency)
+     */
+    explicit ThreadPool(size_t worker_count = 0);
+
+    /**
+     * @brief Run the jobs still queued, then stop the workers
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Queue a job; safe to call from any thread, including a worker
+     *
+     * Jobs must not throw; an exception escaping a job is discarded.
+     */
+    void post(Job job);
+
+    /**
+     * @brief Check whether the calling thread is one of this pool's workers
+     */
+    bool is_worker_thread() const;
+
+    /**
+     * @brief Get number of worker threads
+     */
+    size_t get_worker_count() const { return workers_.size(); }
+
+    /**
+     * @brief Get number of jobs posted but not yet taken by a worker
+     */
+    size_t get_queued_count() const;
+
+    /**
+     * @brief Get number of jobs taken from another worker's deque so far
+     */
+    size_t get_steal_count() const { return steal_count_.load(); }
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    void worker_loop(size_t index);
+    bool take_job(size_t index, Job& job);
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> workers_;
+
+    mutable std::mutex state_mutex_;
+    std::condition_variable work_available_;
+    size_t queued_jobs_ = 0;                // Jobs waiting in a deque
+    bool stopping_ = false;
+
+    std::atomic<size_t> next_queue_{0};
+    std::atomic<size_t> steal_count_{0};
+};
+
+/**
+ * @brief Get the pool shared by the whole process
+ *
+ * Created on first use with get_default_thread_pool_size() workers. Work on
+ * it often waits for child processes rather than using a CPU, so the default
+ * is at least 4 workers even on smaller machines.
+ */
+ThreadPool& default_thread_pool();
+
+/**
+ * @brief Set the number of workers of the default pool
+ *
+ * Only has an effect before default_thread_pool() is first called.
+ *
+ * @param worker_count Number of workers (0 = the default)
+ * @return false if the default pool already exists
+ */
+bool set_default_thread_pool_size(size_t worker_count);
+
+/**
+ * @brief Get the number of workers the default pool has or will have
+ */
+size_t get_default_thread_pool_size();
+
+} // namespace wip::utils::concurrency
@@ -0,0 +1,69 @@
+#include "cancellation_token.h"
+#include <atomic>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace wip::utils::concurrency {
+
+namespace {
+
+// A pipe whose ends are not inherited by child processes; the write end never blocks
+bool make_wake_pipe(int fds[2]) {
+#ifdef __linux__
+    if (pipe2(fds, O_CLOEXEC) == -1) {
+        return false;
+    }
+#else
+    if (pipe(fds) == -1) {
+        return false;
+    }
+    fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+#endif
+    fcntl(fds[1], F_SETFL, fcntl(fds[1], F_GETFL) | O_NONBLOCK);
+    return true;
+}
+
+} // namespace
+
+struct CancellationToken::State {
+    std::atomic<bool> cancelled{false};
+    int fds[2] = {-1, -1};              // Written once on cancel, never drained
+    
+    ~State() {
+        for (int fd : fds) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+    }
+};
+
+CancellationToken CancellationToken::create() {
+    CancellationToken token;
+    token.state_ = std::make_shared<State>();
+    if (!make_wake_pipe(token.state_->fds)) {
+        token.state_->fds[0] = token.state_->fds[1] = -1;   // Waiters fall back to periodic checks
+    }
+    return token;
+}
+
+void CancellationToken::cancel() const {
+    if (state_ && !state_->cancelled.exchange(true) && state_->fds[1] >= 0) {
+        ssize_t written;
+        do {
+            written = write(state_->fds[1], "x", 1);
+        } while (written == -1 && errno == EINTR);
+    }
+}
+
+bool CancellationToken::is_cancelled() const {
+    return state_ && state_->cancelled.load();
+}
+
+int CancellationToken::get_wait_fd() const {
+    return state_ ? state_->fds[0] : -1;
+}
+
+} // namespace wip::utils::concurrency
@@ -0,0 +1,29 @@
+#include "manual_executor.h"
+#include <utility>
+
+namespace wip::utils::concurrency {
+
+void ManualExecutor::post(Job job) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    jobs_.push_back(std::move(job));
+}
+
+size_t ManualExecutor::run_pending() {
+    std::vector<Job> jobs;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        jobs.swap(jobs_);
+    }
+
+    for (auto& job : jobs) {
+        job();
+    }
+    return jobs.size();
+}
+
+size_t ManualExecutor::get_pending_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return jobs_.size();
+}
+
+} // namespace wip::utils::concurrency
@@ -0,0 +1,136 @@
+#include "task.h"
+
+namespace wip::utils::concurrency::detail {
+
+void TaskStateBase::schedule(const std::shared_ptr<TaskStateBase>& state, std::function<void()> work) {
+    {
+        std::lock_guard<std::mutex> lock(state->mutex_);
+        state->work_ = std::move(work);
+    }
+    state->pool().post([state]() { state->try_run(); });
+}
+
+bool TaskStateBase::try_run() {
+    std::function<void()> work;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (claimed_ || !work_) {
+            return false;
+        }
+        claimed_ = true;
+        work = std::move(work_);
+        work_ = nullptr;
+    }
+    work();
+    return true;
+}
+
+void TaskStateBase::wait() {
+    for (;;) {
+        std::vector<std::shared_ptr<TaskStateBase>> pending;
+        size_t generation;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (done_) {
+                return;
+            }
+            pending = dependencies_;
+            generation = dependency_generation_;
+        }
+
+        // Collect unfinished dependencies without recursing, so long then() chains cannot overflow the stack
+        std::vector<std::shared_ptr<TaskStateBase>> unfinished;
+        while (!pending.empty()) {
+            auto state = std::move(pending.back());
+            pending.pop_back();
+            std::lock_guard<std::mutex> lock(state->mutex_);
+            if (!state->done_) {
+                pending.insert(pending.end(), state->dependencies_.begin(), state->dependencies_.end());
+                unfinished.push_back(std::move(state));
+            }
+        }
+
+        // Work nobody has started yet runs here, deepest first, rather than waiting for a free worker.
+        // Deeper states are done by the time each is waited for, so this recurses one level at most.
+        for (auto it = unfinished.rbegin(); it != unfinished.rend(); ++it) {
+            (*it)->wait();
+        }
+        try_run();
+
+        // A coroutine notes what it awaits as it goes, so new dependencies are run here as well
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_changed_.wait(lock, [this, generation]() { return done_ || dependency_generation_ != generation; });
+        if (done_) {
+            return;
+        }
+    }
+}
+
+bool TaskStateBase::wait_for(std::chrono::nanoseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return done_changed_.wait_for(lock, timeout, [this]() { return done_; });
+}
+
+bool TaskStateBase::is_ready() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return done_;
+}
+
+void TaskStateBase::on_done(std::function<void()> continuation) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!done_) {
+            continuations_.push_back(std::move(continuation));
+            return;
+        }
+    }
+    continuation();
+}
+
+void TaskStateBase::add_dependency(std::shared_ptr<TaskStateBase> dependency) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!done_) {
+        dependencies_.push_back(std::move(dependency));
+        ++dependency_generation_;
+        done_changed_.notify_all();
+    }
+}
+
+void TaskStateBase::fail(std::exception_ptr error) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        error_ = std::move(error);
+    }
+    finish();
+}
+
+void TaskStateBase::rethrow_if_failed() const {
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        error = error_;
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void TaskStateBase::finish() {
+    std::vector<std::function<void()>> continuations;
+    std::vector<std::shared_ptr<TaskStateBase>> dependencies;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        done_ = true;
+        continuations.swap(continuations_);
+        dependencies.swap(dependencies_);
+
+        // Under the lock: a woken waiter may destroy this state as soon as it gets it
+        done_changed_.notify_all();
+    }
+
+    for (auto& continuation : continuations) {
+        continuation();
+    }
+}
+
+} // namespace wip::utils::concurrency::detail
@@ -0,0 +1,171 @@
+#include "thread_pool.h"
+#include <algorithm>
+
+namespace wip::utils::concurrency {
+
+namespace {
+
+// Pool and worker index of the calling thread, if it is a worker
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local size_t current_worker_index = 0;
+
+std::mutex default_pool_mutex;
+std::atomic<ThreadPool*> default_pool{nullptr};
+size_t default_pool_size = 0;               // 0 = not set; guarded by default_pool_mutex
+
+size_t resolve_default_size() {
+    return default_pool_size > 0 ? default_pool_size : std::max(4u, std::thread::hardware_concurrency());
+}
+
+} // namespace
+
+ThreadPool::ThreadPool(size_t worker_count) {
+    if (worker_count == 0) {
+        worker_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    queues_.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+        queues_.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    workers_.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+        workers_.emplace_back(&ThreadPool::worker_loop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        stopping_ = true;
+    }
+    work_available_.notify_all();
+
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::post(Job job) {
+    if (!job) {
+        return;
+    }
+
+    size_t index = current_pool == this ? current_worker_index : next_queue_++ % queues_.size();
+    {
+        std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+        queues_[index]->jobs.push_back(std::move(job));
+    }
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        ++queued_jobs_;
+    }
+    work_available_.notify_one();
+}
+
+bool ThreadPool::is_worker_thread() const {
+    return current_pool == this;
+}
+
+size_t ThreadPool::get_queued_count() const {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    return queued_jobs_;
+}
+
+// ==================== Private Helper Methods ====================
+
+void ThreadPool::worker_loop(size_t index) {
+    current_pool = this;
+    current_worker_index = index;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(state_mutex_);
+            work_available_.wait(lock, [this]() { return stopping_ || queued_jobs_ > 0; });
+            if (stopping_ && queued_jobs_ == 0) {
+                return;
+            }
+        }
+
+        Job job;
+        if (!take_job(index, job)) {
+            continue;  // Another worker got there first
+        }
+
+        try {
+            job();
+        } catch (...) {
+            // Jobs must not throw; Task catches on its own behalf
+        }
+    }
+}
+
+bool ThreadPool::take_job(size_t index, Job& job) {
+    bool found = false;
+
+    // Own deque first, newest job (its data is most likely still in cache)
+    {
+        std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+        auto& jobs = queues_[index]->jobs;
+        if (!jobs.empty()) {
+            job = std::move(jobs.back());
+            jobs.pop_back();
+            found = true;
+        }
+    }
+
+    // Then steal the oldest job of another worker
+    for (size_t offset = 1; !found && offset < queues_.size(); ++offset) {
+        auto& victim = *queues_[(index + offset) % queues_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            found = true;
+            ++steal_count_;
+        }
+    }
+
+    if (found) {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        --queued_jobs_;
+    }
+
+    return found;
+}
+
+// ==================== Default Pool ====================
+
+ThreadPool& default_thread_pool() {
+    ThreadPool* pool = default_pool.load(std::memory_order_acquire);
+    if (pool) {
+        return *pool;
+    }
+
+    // Never destroyed: work may still be running while static destructors run at exit
+    std::lock_guard<std::mutex> lock(default_pool_mutex);
+    pool = default_pool.load(std::memory_order_relaxed);
+    if (!pool) {
+        pool = new ThreadPool(resolve_default_size());
+        default_pool.store(pool, std::memory_order_release);
+    }
+    return *pool;
+}
+
+bool set_default_thread_pool_size(size_t worker_count) {
+    std::lock_guard<std::mutex> lock(default_pool_mutex);
+    if (default_pool.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    default_pool_size = worker_count;
+    return true;
+}
+
+size_t get_default_thread_pool_size() {
+    std::lock_guard<std::mutex> lock(default_pool_mutex);
+    ThreadPool* pool = default_pool.load(std::memory_order_relaxed);
+    return pool ? pool->get_worker_count() : resolve_default_size();
+}
+
+} // namespace wip::utils::concurrency
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <coroutine.h>
+#include <manual_executor.h>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace wip::utils::concurrency;
+
+namespace {
+
+Task<int> add_later(ThreadPool& pool, int a, int b) {
+    int first = co_await async(pool, [a]() { return a; });
+    int second = co_await async(pool, [b]() { return b; });
+    co_return first + second;
+}
+
+Task<void> fail_after_await(ThreadPool& pool) {
+    co_await async(pool, []() {});
+    throw std::runtime_error("failed in the coroutine");
+}
+
+Task<std::thread::id> hop(ThreadPool& pool, ManualExecutor& ui) {
+    co_await resume_on(pool);
+    EXPECT_TRUE(pool.is_worker_thread());
+    co_await resume_on(ui);
+    co_return std::this_thread::get_id();
+}
+
+} // namespace
+
+TEST(CoroutineTest, AwaitsTasksAndReturnsAValue) {
+    ThreadPool pool(2);
+    EXPECT_EQ(add_later(pool, 2, 40).get(), 42);
+}
+
+TEST(CoroutineTest, ExceptionsReachTheCaller) {
+    ThreadPool pool(1);
+    EXPECT_THROW(fail_after_await(pool).get(), std::runtime_error);
+
+    auto rethrow = [](ThreadPool& pool) -> Task<int> {
+        co_return co_await async(pool, []() -> int { throw std::logic_error("in the awaited task"); });
+    };
+    EXPECT_THROW(rethrow(pool).get(), std::logic_error);
+}
+
+TEST(CoroutineTest, ResumesOnTheGivenExecutor) {
+    ThreadPool pool(2);
+    ManualExecutor ui;
+    auto task = hop(pool, ui);
+
+    // Polled like a frame loop; blocking here would keep the coroutine from resuming
+    while (!task.is_ready()) {
+        ui.run_pending();
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(task.get(), std::this_thread::get_id());
+}
+
+TEST(CoroutineTest, WaitRunsAwaitedWorkOnABusyPool) {
+    ThreadPool pool(1);
+    std::atomic<bool> release{false};
+    auto blocker = async(pool, [&release]() {
+        while (!release.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    // The only worker is busy, so get() must run the awaited work itself
+    auto task = add_later(pool, 1, 2);
+    EXPECT_EQ(task.get(), 3);
+    release = true;
+}
+
+TEST(CoroutineTest, ComposesWithThenAndWhenAll) {
+    ThreadPool pool(2);
+    std::vector<Task<int>> sums;
+    for (int i = 0; i < 16; ++i) {
+        sums.push_back(add_later(pool, i, i));
+    }
+    auto total = when_all(std::move(sums)).then([](std::vector<int> values) {
+        int sum = 0;
+        for (int value : values) {
+            sum += value;
+        }
+        return sum;
+    });
+    EXPECT_EQ(total.get(), 240);
+}
+
+TEST(CoroutineTest, LongAwaitLoopsDoNotRecurse) {
+    ThreadPool pool(2);
+    auto loop = [](ThreadPool& pool) -> Task<long> {
+        long sum = 0;
+        for (int i = 0; i < 20000; ++i) {
+            sum += co_await make_ready_task(i);
+            sum += co_await async(pool, [i]() { return i; });
+        }
+        co_return sum;
+    };
+    EXPECT_EQ(loop(pool).get(), 2L * 20000 * 19999 / 2);
+}
@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+#include <task.h>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace wip::utils::concurrency;
+
+TEST(TaskTest, GetReturnsTheValue) {
+    ThreadPool pool(2);
+    Task<int> task = async(pool, []() { return 42; });
+    EXPECT_TRUE(task.valid());
+    EXPECT_EQ(task.get(), 42);
+    EXPECT_FALSE(task.valid());
+
+    Task<std::string> on_default = async([]() { return std::string("default pool"); });
+    EXPECT_EQ(on_default.get(), "default pool");
+}
+
+TEST(TaskTest, GetRethrowsWhatTheWorkThrew) {
+    ThreadPool pool(1);
+    auto task = async(pool, []() -> int { throw std::runtime_error("broken"); });
+    EXPECT_THROW(task.get(), std::runtime_error);
+
+    auto void_task = async(pool, []() { throw std::logic_error("broken"); });
+    EXPECT_THROW(void_task.get(), std::logic_error);
+}
+
+TEST(TaskTest, WaitForTimesOutWhileRunning) {
+    ThreadPool pool(1);
+    std::atomic<bool> release{false};
+    auto task = async(pool, [&release]() {
+        while (!release.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+    EXPECT_EQ(task.wait_for(std::chrono::milliseconds(10)), std::future_status::timeout);
+    EXPECT_FALSE(task.is_ready());
+
+    release = true;
+    task.wait();
+    EXPECT_TRUE(task.is_ready());
+    EXPECT_EQ(task.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+}
+
+TEST(TaskTest, DestroyingAnUnfinishedTaskWaitsForIt) {
+    ThreadPool pool(1);
+    std::atomic<bool> finished{false};
+    {
+        auto task = async(pool, [&finished]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            finished = true;
+        });
+    }
+    EXPECT_TRUE(finished.load());
+}
+
+TEST(TaskTest, WaiterRunsWorkNoWorkerTookYet) {
+    // The only worker waits for a task queued behind it; it runs that task itself
+    ThreadPool pool(1);
+    auto outer = async(pool, [&pool]() {
+        auto inner = async(pool, []() { return std::this_thread::get_id(); });
+        return inner.get() == std::this_thread::get_id();
+    });
+    EXPECT_TRUE(outer.get());
+}
+
+TEST(TaskTest, CancelledTaskIsSkipped) {
+    ThreadPool pool(1);
+    std::atomic<bool> release{false};
+    auto blocker = async(pool, [&release]() {
+        while (!release.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    auto token = CancellationToken::create();
+    std::atomic<bool> ran{false};
+    auto task = async(pool, token, [&ran]() { ran = true; });
+    token.cancel();
+    release = true;
+
+    EXPECT_THROW(task.get(), TaskCancelled);
+    EXPECT_FALSE(ran.load());
+}
+
+TEST(TaskTest, ThenChainsOnTheResult) {
+    ThreadPool pool(2);
+    auto length = async(pool, []() { return std::string("hello"); })
+                      .then([](std::string text) { return text.size(); })
+                      .then([](size_t size) { return static_cast<int>(size) * 2; });
+    EXPECT_EQ(length.get(), 10);
+
+    std::atomic<int> steps{0};
+    auto chained = async(pool, [&steps]() { ++steps; }).then([&steps]() { ++steps; });
+    chained.get();
+    EXPECT_EQ(steps.load(), 2);
+
+    EXPECT_EQ(make_ready_task(3).then([](int value) { return value + 1; }).get(), 4);
+}
+
+TEST(TaskTest, ThenPassesFailuresOn) {
+    ThreadPool pool(2);
+    std::atomic<bool> called{false};
+    auto task = async(pool, []() -> int { throw std::runtime_error("first step"); })
+                    .then([&called](int value) {
+                        called = true;
+                        return value;
+                    });
+    EXPECT_THROW(task.get(), std::runtime_error);
+    EXPECT_FALSE(called.load());
+}
+
+TEST(TaskTest, WhenAllKeepsTheOrder) {
+    ThreadPool pool(4);
+    std::vector<Task<int>> tasks;
+    for (int i = 0; i < 16; ++i) {
+        tasks.push_back(async(pool, [i]() {
+            std::this_thread::sleep_for(std::chrono::microseconds((16 - i) * 100));
+            return i * i;
+        }));
+    }
+    auto squares = when_all(std::move(tasks)).get();
+    ASSERT_EQ(squares.size(), 16u);
+    for (int i = 0; i < 16; ++i) {
+        EXPECT_EQ(squares[i], i * i);
+    }
+
+    EXPECT_TRUE(when_all(std::vector<Task<int>>()).get().empty());
+}
+
+TEST(TaskTest, WhenAllFailsWithTheFirstFailure) {
+    ThreadPool pool(2);
+    std::vector<Task<void>> tasks;
+    tasks.push_back(async(pool, []() {}));
+    tasks.push_back(async(pool, []() { throw std::invalid_argument("second"); }));
+    tasks.push_back(async(pool, []() { throw std::runtime_error("third"); }));
+    EXPECT_THROW(when_all(std::move(tasks)).get(), std::invalid_argument);
+}
+
+TEST(TaskTest, ManyWaitersOnABusyPool) {
+    // Every worker blocks on a task of its own; without running those inline this would deadlock
+    ThreadPool pool(2);
+    std::vector<Task<int>> outer;
+    for (int i = 0; i < 8; ++i) {
+        outer.push_back(async(pool, [&pool, i]() {
+            std::vector<Task<int>> inner;
+            for (int j = 0; j < 4; ++j) {
+                inner.push_back(async(pool, [i, j]() { return i + j; }));
+            }
+            int sum = 0;
+            for (int value : when_all(std::move(inner)).get()) {
+                sum += value;
+            }
+            return sum;
+        }));
+    }
+    auto sums = when_all(std::move(outer)).get();
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_EQ(sums[i], 4 * i + 6);
+    }
+}
+
+TEST(TaskTest, LongThenChainsDoNotRecurse) {
+    ThreadPool pool(1);
+    std::atomic<bool> release{false};
+    auto first = async(pool, [&release]() {
+        while (!release.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return 0;
+    });
+
+    // Built while the first task blocks the only worker, so the whole chain is waiting at once
+    Task<int> chain = std::move(first);
+    for (int i = 0; i < 100000; ++i) {
+        chain = chain.then([](int value) { return value + 1; });
+    }
+    release = true;
+    EXPECT_EQ(chain.get(), 100000);
+}
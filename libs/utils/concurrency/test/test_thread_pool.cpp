@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <thread_pool.h>
+#include <cancellation_token.h>
+#include <manual_executor.h>
+#include <poll.h>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <thread>
+
+using namespace wip::utils::concurrency;
+
+TEST(ThreadPoolTest, RunsEveryPostedJob) {
+    std::atomic<int> count{0};
+    {
+        ThreadPool pool(4);
+        EXPECT_EQ(pool.get_worker_count(), 4u);
+        for (int i = 0; i < 1000; ++i) {
+            pool.post([&count]() { ++count; });
+        }
+    }   // Queued jobs run before the workers stop
+    EXPECT_EQ(count.load(), 1000);
+}
+
+TEST(ThreadPoolTest, ReusesItsWorkers) {
+    ThreadPool pool(2);
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    std::atomic<int> done{0};
+    for (int i = 0; i < 200; ++i) {
+        pool.post([&]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            threads.insert(std::this_thread::get_id());
+            ++done;
+        });
+    }
+    while (done.load() < 200) {
+        std::this_thread::yield();
+    }
+    EXPECT_LE(threads.size(), 2u);
+    EXPECT_EQ(threads.count(std::this_thread::get_id()), 0u);
+}
+
+TEST(ThreadPoolTest, JobsPostedByWorkersAreStolenByIdleOnes) {
+    ThreadPool pool(4);
+    std::atomic<int> done{0};
+    pool.post([&]() {
+        EXPECT_TRUE(pool.is_worker_thread());
+        for (int i = 0; i < 64; ++i) {
+            pool.post([&]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                ++done;
+            });
+        }
+    });
+    while (done.load() < 64) {
+        std::this_thread::yield();
+    }
+    EXPECT_FALSE(pool.is_worker_thread());
+    EXPECT_GT(pool.get_steal_count(), 0u);
+    EXPECT_EQ(pool.get_queued_count(), 0u);
+}
+
+TEST(ThreadPoolTest, ThrowingJobDoesNotStopTheWorker) {
+    ThreadPool pool(1);
+    std::atomic<bool> ran{false};
+    pool.post([]() { throw std::runtime_error("job failed"); });
+    pool.post([&ran]() { ran = true; });
+    while (!ran.load()) {
+        std::this_thread::yield();
+    }
+}
+
+TEST(ThreadPoolTest, DefaultPoolSizeIsFixedOnFirstUse) {
+    ThreadPool& pool = default_thread_pool();
+    EXPECT_EQ(&pool, &default_thread_pool());
+    EXPECT_GE(pool.get_worker_count(), 4u);
+    EXPECT_EQ(get_default_thread_pool_size(), pool.get_worker_count());
+    EXPECT_FALSE(set_default_thread_pool_size(2));
+}
+
+TEST(ManualExecutorTest, RunsJobsOnlyWhenAsked) {
+    ManualExecutor executor;
+    ThreadPool pool(2);
+    std::atomic<int> posted{0};
+    for (int i = 0; i < 8; ++i) {
+        pool.post([&executor, &posted]() {
+            executor.post([]() {});
+            ++posted;
+        });
+    }
+    while (posted.load() < 8) {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(executor.get_pending_count(), 8u);
+
+    std::thread::id ran_on;
+    executor.post([&ran_on]() { ran_on = std::this_thread::get_id(); });
+    EXPECT_EQ(executor.run_pending(), 9u);
+    EXPECT_EQ(ran_on, std::this_thread::get_id());
+    EXPECT_EQ(executor.get_pending_count(), 0u);
+}
+
+TEST(ManualExecutorTest, JobsPostedWhileRunningWaitForTheNextRun) {
+    ManualExecutor executor;
+    int runs = 0;
+    std::function<void()> repost = [&]() {
+        ++runs;
+        executor.post(repost);
+    };
+    executor.post(repost);
+    EXPECT_EQ(executor.run_pending(), 1u);
+    EXPECT_EQ(executor.run_pending(), 1u);
+    EXPECT_EQ(runs, 2);
+}
+
+TEST(CancellationTokenTest, CopiesShareTheFlag) {
+    CancellationToken never;
+    EXPECT_FALSE(never.can_be_cancelled());
+    never.cancel();
+    EXPECT_FALSE(never.is_cancelled());
+    EXPECT_EQ(never.get_wait_fd(), -1);
+
+    auto token = CancellationToken::create();
+    CancellationToken copy = token;
+    EXPECT_EQ(copy, token);
+    EXPECT_NE(token, CancellationToken::create());
+
+    pollfd before{token.get_wait_fd(), POLLIN, 0};
+    EXPECT_EQ(poll(&before, 1, 0), 0);
+
+    copy.cancel();
+    EXPECT_TRUE(token.is_cancelled());
+    pollfd after{token.get_wait_fd(), POLLIN, 0};
+    EXPECT_EQ(poll(&after, 1, 0), 1);
+}
@@ -0,0 +1,119 @@
+// Benchmark for concurrent event dispatch.
+//
+// Several publisher threads dispatch the same event type in a tight loop
+// while one thread keeps subscribing and unsubscribing a handler, the way
+// short-lived widgets do. Reports dispatches per second for each publisher
+// count, so lock contention on the dispatch path shows up as throughput that
+// stops growing with threads. The single-threaded cost of one dispatch is
+// reported first. Usage:
+//
+//   bench_wip_utils_event [max-publishers] [dispatches-per-thread]
+
+#include "benchmark.h"
+#include "event_dispatcher.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace wip::utils::event;
+
+namespace {
+
+class ProgressEvent : public Event {
+public:
+    explicit ProgressEvent(int value) : value_(value) {}
+    int value() const { return value_; }
+private:
+    int value_;
+};
+
+double throughput(size_t publishers, size_t dispatches_per_thread, bool churn) {
+    EventDispatcher dispatcher;
+    std::atomic<long> sum{0};
+    for (int i = 0; i < 4; ++i) {
+        dispatcher.subscribe<ProgressEvent>([&sum](const ProgressEvent& e) {
+            sum.fetch_add(e.value(), std::memory_order_relaxed);
+        });
+    }
+
+    std::atomic<bool> running{true};
+    std::thread subscriber;
+    if (churn) {
+        subscriber = std::thread([&]() {
+            while (running) {
+                auto handle = dispatcher.subscribe<ProgressEvent>([](const ProgressEvent&) {});
+                dispatcher.unsubscribe(handle);
+            }
+        });
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < publishers; ++i) {
+        threads.emplace_back([&]() {
+            for (size_t j = 0; j < dispatches_per_thread; ++j) {
+                dispatcher.dispatch(ProgressEvent{1});
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    running = false;
+    if (subscriber.joinable()) {
+        subscriber.join();
+    }
+    return publishers * dispatches_per_thread / seconds;
+}
+
+double latency(size_t dispatches) {
+    EventDispatcher dispatcher;
+    long sum = 0;
+    for (int i = 0; i < 4; ++i) {
+        dispatcher.subscribe<ProgressEvent>([&sum](const ProgressEvent& e) {
+            sum += e.value();
+        });
+    }
+
+    // Constructing an event reads the clock, which would dominate the measurement
+    ProgressEvent event{1};
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < dispatches; ++i) {
+        dispatcher.dispatch(event);
+    }
+    double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    if (sum != static_cast<long>(dispatches) * 4) {
+        std::cerr << "Lost events" << std::endl;
+    }
+    return nanoseconds / dispatches;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    wip::benchmark::Runner runner("bench_wip_utils_event", argc, argv, "[max-publishers] [dispatches-per-thread]");
+    size_t max_publishers = runner.argument(0, std::max(1u, std::thread::hardware_concurrency()));
+    size_t dispatches = runner.argument(1, 200000);
+
+    if (runner.selected("single thread dispatch")) {
+        runner.report("single thread dispatch", latency(dispatches), "ns/dispatch");
+    }
+    runner.out() << "Dispatching " << dispatches << " events per publisher to 4 handlers" << std::endl;
+    for (size_t publishers = 1; publishers <= max_publishers; publishers *= 2) {
+        const std::string name = std::to_string(publishers) + " publishers";
+        if (runner.selected(name)) {
+            runner.report(name, throughput(publishers, dispatches, false), "dispatches/s");
+        }
+        if (runner.selected(name + " with subscription churn")) {
+            runner.report(name + " with subscription churn", throughput(publishers, dispatches, true), "dispatches/s");
+        }
+    }
+    return runner.finish();
+}
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "event.h"
+#include "inline_payload.h"
 #include <string>
+#include <string_view>
 #include <any>
 
 namespace wip::utils::event {
@@ -11,6 +13,10 @@ namespace wip::utils::event {
  * 
  * These are concrete event implementations that can be used directly
  * or serve as examples for creating custom events.
+ * 
+ * MessageEvent, DataEvent and PropertyChangeEvent keep short strings and
+ * small payloads inside the event, so creating, copying and queueing them
+ * does not allocate in the common case.
  */
 
 /**
@@ -18,15 +24,17 @@ namespace wip::utils::event {
  */
 class MessageEvent : public Event {
 public:
-    explicit MessageEvent(std::string message) 
-        : message_(std::move(message)) {}
+    static constexpr size_t INLINE_MESSAGE_LENGTH = 63;
     
-    const std::string& message() const noexcept {
-        return message_;
+    explicit MessageEvent(std::string_view message) 
+        : message_(message) {}
+    
+    std::string_view message() const noexcept {
+        return message_.view();
     }
 
 private:
-    std::string message_;
+    InlineString<INLINE_MESSAGE_LENGTH> message_;
 };
 
 /**
@@ -34,32 +42,33 @@ private:
  */
 class DataEvent : public Event {
 public:
+    static constexpr size_t INLINE_KEY_LENGTH = 31;
+    static constexpr size_t INLINE_DATA_SIZE = 32;      // Fits a std::string or four doubles
+    
     template<typename T>
-    explicit DataEvent(std::string key, T&& data)
-        : key_(std::move(key)), data_(std::forward<T>(data)) {}
+    explicit DataEvent(std::string_view key, T&& data)
+        : key_(key), data_(std::forward<T>(data)) {}
     
-    const std::string& key() const noexcept {
-        return key_;
+    std::string_view key() const noexcept {
+        return key_.view();
     }
     
+    /**
+     * @throws std::bad_any_cast if the data is not of type T
+     */
     template<typename T>
     const T& data() const {
-        return std::any_cast<const T&>(data_);
+        return data_.template get<T>();
     }
     
     template<typename T>
     bool has_data() const noexcept {
-        try {
-            std::any_cast<const T&>(data_);
-            return true;
-        } catch (const std::bad_any_cast&) {
-            return false;
-        }
+        return data_.template holds<T>();
     }
 
 private:
-    std::string key_;
-    std::any data_;
+    InlineString<INLINE_KEY_LENGTH> key_;
+    InlineAny<INLINE_DATA_SIZE> data_;
 };
 
 /**
@@ -67,29 +76,36 @@ private:
  */
 class PropertyChangeEvent : public Event {
 public:
-    PropertyChangeEvent(std::string property_name, std::any old_value, std::any new_value)
-        : property_name_(std::move(property_name))
-        , old_value_(std::move(old_value))
-        , new_value_(std::move(new_value)) {}
+    static constexpr size_t INLINE_NAME_LENGTH = 31;
+    static constexpr size_t INLINE_VALUE_SIZE = 32;
+    
+    template<typename OldValue, typename NewValue>
+    PropertyChangeEvent(std::string_view property_name, OldValue&& old_value, NewValue&& new_value)
+        : property_name_(property_name)
+        , old_value_(std::forward<OldValue>(old_value))
+        , new_value_(std::forward<NewValue>(new_value)) {}
     
-    const std::string& property_name() const noexcept {
-        return property_name_;
+    std::string_view property_name() const noexcept {
+        return property_name_.view();
     }
     
+    /**
+     * @throws std::bad_any_cast if the value is not of type T
+     */
     template<typename T>
     const T& old_value() const {
-        return std::any_cast<const T&>(old_value_);
+        return old_value_.template get<T>();
     }
     
     template<typename T>
     const T& new_value() const {
-        return std::any_cast<const T&>(new_value_);
+        return new_value_.template get<T>();
     }
 
 private:
-    std::string property_name_;
-    std::any old_value_;
-    std::any new_value_;
+    InlineString<INLINE_NAME_LENGTH> property_name_;
+    InlineAny<INLINE_VALUE_SIZE> old_value_;
+    InlineAny<INLINE_VALUE_SIZE> new_value_;
 };
 
 /**
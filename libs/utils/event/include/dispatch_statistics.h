@@ -0,0 +1,120 @@
+#pragma once
+
+#include "event.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+namespace wip::utils::event {
+
+/**
+ * @brief Lock-free histogram of durations with logarithmic buckets.
+ *
+ * Every power of two gets SUB_BUCKETS linear sub-buckets, so each recorded
+ * value is known to within 25% whatever its magnitude, in the spirit of an
+ * HDR histogram. Recording is one relaxed atomic increment per counter and
+ * may happen from any number of threads.
+ */
+class LatencyHistogram {
+public:
+    static constexpr size_t SUB_BUCKET_BITS = 2;
+    static constexpr size_t SUB_BUCKETS = size_t(1) << SUB_BUCKET_BITS;
+    static constexpr size_t MAGNITUDES = 40;   // Up to 2^40 ns, about 18 minutes
+    static constexpr size_t BUCKET_COUNT = MAGNITUDES * SUB_BUCKETS;
+
+    /**
+     * @brief Percentiles and totals of a histogram.
+     */
+    struct Summary {
+        uint64_t count = 0;
+        std::chrono::nanoseconds total{0};
+        std::chrono::nanoseconds mean{0};
+        std::chrono::nanoseconds p50{0};
+        std::chrono::nanoseconds p90{0};
+        std::chrono::nanoseconds p99{0};
+        std::chrono::nanoseconds max{0};
+    };
+
+    LatencyHistogram() = default;
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    /**
+     * @brief Record one duration.
+     */
+    void record(std::chrono::nanoseconds duration);
+
+    /**
+     * @brief Compute count, mean and percentiles (upper bounds of their buckets).
+     */
+    Summary summarize() const;
+
+    /**
+     * @brief Forget every recorded duration.
+     */
+    void reset();
+
+    /**
+     * @brief Get the bucket a duration in nanoseconds falls into.
+     */
+    static size_t bucket_index(uint64_t nanoseconds);
+
+    /**
+     * @brief Get the largest duration in nanoseconds counted by a bucket.
+     */
+    static uint64_t bucket_upper_bound(size_t index);
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> total_{0};
+    std::atomic<uint64_t> max_{0};
+};
+
+/**
+ * @brief Statistics of one subscription.
+ */
+struct HandlerStatistics {
+    uint64_t subscription_id = 0;
+    std::string event_type;             ///< Readable name of the event type
+    Priority priority = Priority::Normal;
+    uint64_t calls = 0;                 ///< Calls timed while instrumentation was enabled
+    uint64_t exceptions = 0;            ///< Exceptions thrown by the handler and swallowed by dispatch
+    LatencyHistogram::Summary latency;  ///< Execution time per call
+};
+
+/**
+ * @brief Statistics of one event type.
+ */
+struct EventTypeStatistics {
+    std::string name;                   ///< Readable name of the event type
+    uint64_t dispatches = 0;            ///< Dispatches counted while instrumentation was enabled
+    uint64_t exceptions = 0;            ///< Exceptions swallowed while dispatching this type
+    double dispatches_per_second = 0.0; ///< Dispatch rate since the statistics were last reset
+    LatencyHistogram::Summary latency;  ///< Time of a whole dispatch, all handlers included
+};
+
+/**
+ * @brief Snapshot of the statistics of an EventDispatcher.
+ */
+struct DispatchStatistics {
+    std::chrono::nanoseconds elapsed{0};            ///< Time since the statistics were last reset
+    std::vector<EventTypeStatistics> event_types;   ///< Busiest first
+    std::vector<HandlerStatistics> handlers;        ///< Slowest (highest p99) first
+
+    /**
+     * @brief Format the statistics as a plain text report.
+     */
+    std::string to_string() const;
+};
+
+/**
+ * @brief Get the demangled name of a type where the compiler supports it.
+ */
+std::string readable_type_name(const std::type_info& type);
+
+} // namespace wip::utils::event
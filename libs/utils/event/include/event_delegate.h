@@ -0,0 +1,187 @@
+#pragma once
+
+#include "event.h"
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace wip::utils::event {
+
+namespace detail {
+
+inline size_t next_event_type_id() {
+    static std::atomic<size_t> counter{0};
+    return counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace detail
+
+/**
+ * @brief Get the dense index of an event type.
+ *
+ * Every event type gets the next free index the first time it is used, so
+ * per-type tables can be plain vectors instead of hash maps.
+ *
+ * @tparam EventType The event type
+ * @return Index of the type, stable for the lifetime of the program
+ */
+template<typename EventType>
+size_t event_type_id() {
+    static const size_t id = detail::next_event_type_id();
+    return id;
+}
+
+/**
+ * @brief Type-erased callable taking a base Event, with small-buffer storage.
+ *
+ * Stores the user's callable directly and downcasts the event to its real
+ * type in the same indirect call, instead of wrapping a typed std::function
+ * in an untyped one. Callables up to INLINE_SIZE bytes live inside the
+ * delegate; larger ones are allocated once when the delegate is created.
+ *
+ * @tparam Result Return type of the callable (void for handlers, bool for filters)
+ */
+template<typename Result>
+class EventDelegate {
+public:
+    static constexpr size_t INLINE_SIZE = 48;
+
+    EventDelegate() = default;
+
+    /**
+     * @brief Create a delegate calling a callable with the event downcast to EventType.
+     *
+     * @tparam EventType Type the event is cast to (must be the dispatched type)
+     * @param callable Callable accepting const EventType&
+     */
+    template<typename EventType, typename Callable>
+    static EventDelegate create(Callable&& callable) {
+        using Stored = std::decay_t<Callable>;
+        EventDelegate delegate;
+        delegate.ops_ = &Model<EventType, Stored>::ops;
+        Model<EventType, Stored>::construct(delegate.storage_, std::forward<Callable>(callable));
+        return delegate;
+    }
+
+    EventDelegate(const EventDelegate& other) : ops_(other.ops_) {
+        if (ops_) {
+            ops_->copy(storage_, other.storage_);
+        }
+    }
+
+    EventDelegate(EventDelegate&& other) noexcept : ops_(other.ops_) {
+        if (ops_) {
+            ops_->move(storage_, other.storage_);
+            other.ops_ = nullptr;
+        }
+    }
+
+    EventDelegate& operator=(const EventDelegate& other) {
+        if (this != &other) {
+            EventDelegate copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    EventDelegate& operator=(EventDelegate&& other) noexcept {
+        if (this != &other) {
+            reset();
+            ops_ = other.ops_;
+            if (ops_) {
+                ops_->move(storage_, other.storage_);
+                other.ops_ = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    ~EventDelegate() {
+        reset();
+    }
+
+    /**
+     * @brief Call the stored callable.
+     */
+    Result operator()(const Event& event) const {
+        return ops_->invoke(const_cast<unsigned char*>(storage_), event);
+    }
+
+    explicit operator bool() const noexcept {
+        return ops_ != nullptr;
+    }
+
+private:
+    struct Ops {
+        Result (*invoke)(void* storage, const Event& event);
+        void (*copy)(void* destination, const void* source);
+        void (*move)(void* destination, void* source) noexcept;
+        void (*destroy)(void* storage) noexcept;
+    };
+
+    template<typename EventType, typename Callable>
+    struct Model {
+        static constexpr bool is_inline =
+            sizeof(Callable) <= INLINE_SIZE &&
+            alignof(Callable) <= alignof(std::max_align_t) &&
+            std::is_nothrow_move_constructible_v<Callable>;
+
+        static Callable* get(void* storage) {
+            if constexpr (is_inline) {
+                return std::launder(static_cast<Callable*>(storage));
+            } else {
+                return *static_cast<Callable**>(storage);
+            }
+        }
+
+        template<typename Argument>
+        static void construct(void* storage, Argument&& argument) {
+            if constexpr (is_inline) {
+                new (storage) Callable(std::forward<Argument>(argument));
+            } else {
+                *static_cast<Callable**>(storage) = new Callable(std::forward<Argument>(argument));
+            }
+        }
+
+        static Result invoke(void* storage, const Event& event) {
+            return (*get(storage))(static_cast<const EventType&>(event));
+        }
+
+        static void copy(void* destination, const void* source) {
+            construct(destination, *get(const_cast<void*>(source)));
+        }
+
+        static void move(void* destination, void* source) noexcept {
+            if constexpr (is_inline) {
+                new (destination) Callable(std::move(*get(source)));
+                get(source)->~Callable();
+            } else {
+                *static_cast<Callable**>(destination) = get(source);
+            }
+        }
+
+        static void destroy(void* storage) noexcept {
+            if constexpr (is_inline) {
+                get(storage)->~Callable();
+            } else {
+                delete get(storage);
+            }
+        }
+
+        static constexpr Ops ops = {&invoke, &copy, &move, &destroy};
+    };
+
+    void reset() noexcept {
+        if (ops_) {
+            ops_->destroy(storage_);
+            ops_ = nullptr;
+        }
+    }
+
+    const Ops* ops_ = nullptr;
+    alignas(std::max_align_t) unsigned char storage_[INLINE_SIZE];
+};
+
+} // namespace wip::utils::event
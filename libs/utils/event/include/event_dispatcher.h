@@ -1,9 +1,16 @@
 #pragma once
 
 #include "event.h"
+#include "dispatch_statistics.h"
+#include "event_delegate.h"
+#include "event_queue.h"
+#include "executor.h"
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <functional>
+#include <limits>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <queue>
@@ -11,7 +18,7 @@
 #include <unordered_map>
 #include <vector>
 #include <typeindex>
-#include <future>
+#include <task.h>
 
 namespace wip::utils::event {
 
@@ -95,25 +102,79 @@ private:
  * - Synchronous and asynchronous event dispatch
  * - Event filtering
  * - Automatic subscription management
+ * 
+ * Subscriptions are kept in an ordered map per event type plus an index from
+ * handle to entry, so subscribe() and unsubscribe() cost O(log n). dispatch()
+ * reads an immutable snapshot of the handler lists instead and never holds a
+ * lock while handlers run, so publishers on different threads do not
+ * serialize and a handler may dispatch, subscribe or unsubscribe without
+ * deadlocking. The snapshot is rebuilt by the first dispatch after a change,
+ * once for any number of changes, and only for the event types that changed.
+ * An unsubscribed handler is deactivated at once: a dispatch that is already
+ * running skips it, even though its snapshot still lists it.
+ * The snapshot is indexed by event_type_id(), and each handler is stored in
+ * an EventDelegate that calls the user's callable directly.
+ * 
+ * Exceptions thrown by handlers are counted per handler and event type.
+ * With instrumentation enabled, dispatches are also counted and timed, per
+ * event type and per handler; get_statistics() returns the figures.
+ * Each thread keeps its own reference to the table it dispatched with last
+ * and only reloads it after a change, so the common dispatch touches no
+ * shared reference count. That reference keeps a replaced table, and the
+ * handlers in it, alive until the thread's next dispatch.
+ * 
+ * High-rate events can be deferred instead: enqueue() pushes a copy into a
+ * bounded lock-free queue from any thread, and the owner delivers the queued
+ * events in batches with process_queue(), typically once per frame.
+ * enqueue_coalesced() keeps only the latest queued event of its type, for
+ * events such as mouse moves or progress where older values are stale.
+ * 
+ * subscribe_on() binds a handler to an Executor: dispatch() passes a copy of
+ * the event to the executor, which runs the handler on its own thread in
+ * batches. Worker threads can then publish straight into UI code whose
+ * handlers never run concurrently and need no locking of their own.
  */
 class EventDispatcher {
 private:
     struct HandlerInfo {
-        std::function<void(const Event&)> handler;
+        EventDelegate<void> handler;
         Priority priority;
-        std::function<bool(const Event&)> filter;
+        EventDelegate<bool> filter;
         SubscriptionHandle::HandleType id;
-        
-        bool operator<(const HandlerInfo& other) const {
-            // Reverse comparison for priority queue (higher priority first)
-            return static_cast<int>(priority) < static_cast<int>(other.priority);
-        }
+        std::atomic<bool> active{true};     // Cleared by unsubscribe, also for running dispatches
+        std::atomic<uint64_t> exceptions{0};
+        LatencyHistogram latency;           // Recorded while instrumented
+    };
+    
+    struct TypeCounters {
+        std::string name;
+        std::atomic<uint64_t> dispatches{0};
+        std::atomic<uint64_t> exceptions{0};
+        LatencyHistogram latency;
+    };
+    
+    using HandlerPtr = std::shared_ptr<HandlerInfo>;
+    using HandlerList = std::vector<HandlerPtr>;         // Highest priority first
+    
+    // Snapshot read by dispatch()
+    struct HandlerTable {
+        uint64_t generation = 0;                                    // Value of generation_ it was built for
+        std::vector<std::shared_ptr<const HandlerList>> lists;      // Indexed by event_type_id()
+        std::vector<std::shared_ptr<TypeCounters>> counters;        // Indexed by event_type_id()
     };
     
-    using HandlerList = std::vector<HandlerInfo>;
+    // Highest priority first, then in subscription order
+    using OrderKey = std::pair<int, SubscriptionHandle::HandleType>;
 
 public:
-    EventDispatcher() : next_subscription_id_(1) {}
+    static constexpr size_t DEFAULT_QUEUE_CAPACITY = 4096;
+    
+    /**
+     * @brief Create a dispatcher.
+     * 
+     * @param queue_capacity Maximum number of events waiting for process_queue()
+     */
+    explicit EventDispatcher(size_t queue_capacity = DEFAULT_QUEUE_CAPACITY);
     ~EventDispatcher() = default;
     
     // Non-copyable, non-movable
@@ -126,70 +187,126 @@ public:
      * @brief Subscribe to events of a specific type.
      * 
      * @tparam EventType The type of event to subscribe to (must inherit from Event)
+     * @tparam Handler Callable accepting const EventType& (deduced)
      * @param handler The function to call when the event is dispatched
      * @param priority Priority level for this handler (default: Normal)
      * @param filter Optional filter function to conditionally handle events
      * @return Handle that can be used to unsubscribe
      */
-    template<typename EventType>
-    SubscriptionHandle subscribe(EventHandler<EventType> handler, 
+    template<typename EventType, typename Handler>
+    SubscriptionHandle subscribe(Handler&& handler, 
                                Priority priority = Priority::Normal,
                                std::function<bool(const EventType&)> filter = nullptr) {
         static_assert(is_event_v<EventType>, "EventType must inherit from Event");
         
-        std::lock_guard<std::mutex> lock(handlers_mutex_);
+        // The delegates downcast the event and call the callables in one step
+        auto info = std::make_shared<HandlerInfo>();
+        info->handler = EventDelegate<void>::create<EventType>(std::forward<Handler>(handler));
+        info->priority = priority;
+        if (filter) {
+            info->filter = EventDelegate<bool>::create<EventType>(std::move(filter));
+        }
+        info->id = next_subscription_id_++;
         
-        auto subscription_id = next_subscription_id_++;
-        auto type_index = std::type_index(typeid(EventType));
+        return add_subscription(event_type_id<EventType>(), typeid(EventType), std::move(info));
+    }
+    
+    /**
+     * @brief Subscribe to events, running the handler on an executor.
+     * 
+     * dispatch() copies the event and posts it to the executor instead of
+     * calling the handler; the handler then runs wherever and whenever the
+     * executor runs its tasks. Events posted before unsubscribe() but not
+     * run yet are discarded. Filters still run on the dispatching thread,
+     * the handler cannot consume the event for later handlers, and
+     * exceptions it throws are counted as for any other handler. The
+     * executor must outlive the subscription and the tasks it has queued.
+     * 
+     * @tparam EventType The type of event to subscribe to (must be copyable)
+     * @tparam Handler Callable accepting const EventType& (deduced)
+     * @param executor Executor that runs the handler
+     * @param handler The function to call with each event
+     * @param priority Priority level for this handler (default: Normal)
+     * @param filter Optional filter function, run on the dispatching thread
+     * @return Handle that can be used to unsubscribe
+     */
+    template<typename EventType, typename Handler>
+    SubscriptionHandle subscribe_on(Executor& executor,
+                                    Handler&& handler,
+                                    Priority priority = Priority::Normal,
+                                    std::function<bool(const EventType&)> filter = nullptr) {
+        static_assert(is_event_v<EventType>, "EventType must inherit from Event");
+        static_assert(std::is_copy_constructible_v<EventType>, "EventType must be copyable to cross threads");
         
-        // Wrap the typed handler in a generic handler
-        auto generic_handler = [handler](const Event& event) {
-            const auto& typed_event = static_cast<const EventType&>(event);
-            handler(typed_event);
+        auto info = std::make_shared<HandlerInfo>();
+        std::weak_ptr<HandlerInfo> weak_info = info;
+        auto target = std::make_shared<std::decay_t<Handler>>(std::forward<Handler>(handler));
+        
+        // Runs on the dispatching thread; the task keeps the subscription state alive
+        auto forward = [&executor, weak_info, target](const EventType& event) {
+            executor.post([owner = weak_info.lock(), target, event]() {
+                if (!owner || !owner->active.load(std::memory_order_acquire)) {
+                    return;     // Unsubscribed while the event was waiting
+                }
+                try {
+                    (*target)(event);
+                } catch (const std::exception&) {
+                    owner->exceptions.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
         };
         
-        // Wrap the typed filter in a generic filter if provided
-        std::function<bool(const Event&)> generic_filter = nullptr;
+        info->handler = EventDelegate<void>::create<EventType>(std::move(forward));
+        info->priority = priority;
         if (filter) {
-            generic_filter = [filter](const Event& event) -> bool {
-                const auto& typed_event = static_cast<const EventType&>(event);
-                return filter(typed_event);
-            };
+            info->filter = EventDelegate<bool>::create<EventType>(std::move(filter));
         }
+        info->id = next_subscription_id_++;
         
-        handlers_[type_index].push_back({
-            std::move(generic_handler),
-            priority,
-            std::move(generic_filter),
-            subscription_id
-        });
-        
-        // Sort handlers by priority (highest first)
-        std::sort(handlers_[type_index].begin(), handlers_[type_index].end(),
-                 [](const HandlerInfo& a, const HandlerInfo& b) {
-                     return static_cast<int>(a.priority) > static_cast<int>(b.priority);
-                 });
+        return add_subscription(event_type_id<EventType>(), typeid(EventType), std::move(info));
+    }
+    
+    /**
+     * @brief Create a scoped subscription whose handler runs on an executor.
+     * 
+     * @tparam EventType The type of event to subscribe to
+     * @tparam Handler Callable accepting const EventType& (deduced)
+     * @param executor Executor that runs the handler
+     * @param handler The event handler function
+     * @param priority Priority level (default: Normal)
+     * @param filter Optional filter function
+     * @return Scoped subscription that unsubscribes when destroyed
+     */
+    template<typename EventType, typename Handler>
+    ScopedSubscription subscribe_scoped_on(Executor& executor,
+                                           Handler&& handler,
+                                           Priority priority = Priority::Normal,
+                                           std::function<bool(const EventType&)> filter = nullptr) {
+        auto handle = subscribe_on<EventType>(executor, std::forward<Handler>(handler), priority, std::move(filter));
         
-        return SubscriptionHandle(subscription_id);
+        return ScopedSubscription([this, handle]() {
+            unsubscribe(handle);
+        });
     }
     
     /**
      * @brief Subscribe to events with propagation control.
      * 
      * @tparam EventType The type of event to subscribe to
+     * @tparam Handler Callable accepting const EventType& and returning bool (deduced)
      * @param handler Handler that returns true to continue propagation, false to stop
      * @param priority Priority level for this handler (default: Normal)
      * @param filter Optional filter function
      * @return Handle that can be used to unsubscribe
      */
-    template<typename EventType>
+    template<typename EventType, typename Handler>
     SubscriptionHandle subscribe_with_propagation(
-        EventHandlerWithPropagation<EventType> handler,
+        Handler&& handler,
         Priority priority = Priority::Normal,
         std::function<bool(const EventType&)> filter = nullptr) {
         
         // Convert propagation handler to regular handler that marks consumption
-        auto regular_handler = [handler](const EventType& event) {
+        auto regular_handler = [handler = std::forward<Handler>(handler)](const EventType& event) mutable {
             bool should_continue = handler(event);
             if (!should_continue) {
                 const_cast<EventType&>(event).consume();
@@ -203,16 +320,17 @@ public:
      * @brief Create a scoped subscription that automatically unsubscribes.
      * 
      * @tparam EventType The type of event to subscribe to
+     * @tparam Handler Callable accepting const EventType& (deduced)
      * @param handler The event handler function
      * @param priority Priority level (default: Normal)
      * @param filter Optional filter function
      * @return Scoped subscription that unsubscribes when destroyed
      */
-    template<typename EventType>
-    ScopedSubscription subscribe_scoped(EventHandler<EventType> handler,
+    template<typename EventType, typename Handler>
+    ScopedSubscription subscribe_scoped(Handler&& handler,
                                       Priority priority = Priority::Normal,
                                       std::function<bool(const EventType&)> filter = nullptr) {
-        auto handle = subscribe<EventType>(std::move(handler), priority, std::move(filter));
+        auto handle = subscribe<EventType>(std::forward<Handler>(handler), priority, std::move(filter));
         
         return ScopedSubscription([this, handle]() {
             unsubscribe(handle);
@@ -238,55 +356,183 @@ public:
     size_t dispatch(const EventType& event) {
         static_assert(is_event_v<EventType>, "EventType must inherit from Event");
         
-        std::lock_guard<std::mutex> lock(handlers_mutex_);
-        
-        auto type_index = std::type_index(typeid(EventType));
-        auto it = handlers_.find(type_index);
+        // The snapshot keeps its handler lists alive without holding a lock
+        DispatchScope scope(*this);
+        auto type_id = event_type_id<EventType>();
+        auto handlers = find_handlers(scope.table(), type_id);
         
-        if (it == handlers_.end()) {
+        if (!handlers) {
             return 0;
         }
         
+        using Clock = std::chrono::steady_clock;
+        bool instrumented = instrumentation_enabled_.load(std::memory_order_relaxed);
+        TypeCounters* type_counters = type_id < scope.table().counters.size()
+                                          ? scope.table().counters[type_id].get() : nullptr;
+        auto dispatch_start = instrumented ? Clock::now() : Clock::time_point();
+        
         size_t handlers_called = 0;
-        for (const auto& handler_info : it->second) {
+        for (const auto& handler_ptr : *handlers) {
             if (event.is_consumed()) {
                 break;  // Stop processing if event was consumed
             }
             
+            // Unsubscribed after the snapshot was taken
+            HandlerInfo& handler_info = *handler_ptr;
+            if (!handler_info.active.load(std::memory_order_acquire)) {
+                continue;
+            }
+            
             // Apply filter if present
             if (handler_info.filter && !handler_info.filter(event)) {
                 continue;
             }
             
             try {
-                handler_info.handler(event);
+                if (instrumented) {
+                    auto handler_start = Clock::now();
+                    handler_info.handler(event);
+                    handler_info.latency.record(Clock::now() - handler_start);
+                } else {
+                    handler_info.handler(event);
+                }
                 ++handlers_called;
-            } catch (const std::exception& e) {
-                // Log error but continue processing other handlers
-                // In a real implementation, you might want to use your logging library
-                (void)e; // Suppress unused variable warning
+            } catch (const std::exception&) {
+                // Continue with the other handlers; the failure shows up in get_statistics()
+                handler_info.exceptions.fetch_add(1, std::memory_order_relaxed);
+                if (type_counters) {
+                    type_counters->exceptions.fetch_add(1, std::memory_order_relaxed);
+                }
             }
         }
         
+        if (instrumented && type_counters) {
+            type_counters->dispatches.fetch_add(1, std::memory_order_relaxed);
+            type_counters->latency.record(Clock::now() - dispatch_start);
+        }
+        
         return handlers_called;
     }
     
     /**
      * @brief Dispatch an event asynchronously.
      * 
+     * Runs on the default thread pool; prefer enqueue() for frequent events.
+     * 
      * @tparam EventType The type of event to dispatch
      * @param event The event to dispatch (will be copied)
-     * @return Future that resolves to the number of handlers called
+     * @return Task that resolves to the number of handlers called
      */
     template<typename EventType>
-    std::future<size_t> dispatch_async(EventType event) {
+    wip::utils::concurrency::Task<size_t> dispatch_async(EventType event) {
         static_assert(is_event_v<EventType>, "EventType must inherit from Event");
         
-        return std::async(std::launch::async, [this, event = std::move(event)]() {
+        return wip::utils::concurrency::async([this, event = std::move(event)]() {
             return dispatch(event);
         });
     }
     
+    /**
+     * @brief Queue an event for delivery by the next process_queue() call.
+     * 
+     * Safe to call from any thread; never blocks and never runs handlers.
+     * 
+     * @tparam EventType The type of event to queue
+     * @param event The event to queue (will be copied)
+     * @return False if the queue is full and the event was dropped
+     */
+    template<typename EventType>
+    bool enqueue(EventType event) {
+        static_assert(is_event_v<EventType>, "EventType must inherit from Event");
+        
+        auto queued = std::make_unique<TypedQueuedEvent<EventType>>(std::move(event));
+        if (!queue_.try_push(queued.get())) {
+            return false;
+        }
+        queued.release();
+        notify_enqueued();
+        return true;
+    }
+    
+    /**
+     * @brief Queue an event, replacing a queued event of the same type.
+     * 
+     * If an event of this type is still waiting, it takes the new value and
+     * keeps its place in the queue; otherwise the event is appended.
+     * 
+     * @tparam EventType The type of event to queue
+     * @param event The event to queue (will be copied)
+     * @return False if the queue is full and the event was dropped
+     */
+    template<typename EventType>
+    bool enqueue_coalesced(EventType event) {
+        static_assert(is_event_v<EventType>, "EventType must inherit from Event");
+        
+        std::lock_guard<std::mutex> lock(coalesce_mutex_);
+        
+        auto type_id = event_type_id<EventType>();
+        if (type_id >= pending_coalesced_.size()) {
+            pending_coalesced_.resize(type_id + 1, nullptr);
+        }
+        if (QueuedEvent* pending = pending_coalesced_[type_id]) {
+            static_cast<TypedQueuedEvent<EventType>*>(pending)->replace(std::move(event));
+            return true;
+        }
+        
+        auto queued = std::make_unique<TypedQueuedEvent<EventType>>(std::move(event));
+        queued->coalesced = true;
+        if (!queue_.try_push(queued.get())) {
+            return false;
+        }
+        pending_coalesced_[type_id] = queued.release();
+        notify_enqueued();
+        return true;
+    }
+    
+    /**
+     * @brief Dispatch queued events on the calling thread.
+     * 
+     * Events queued by the handlers themselves wait for the next call, so a
+     * handler that re-queues its event cannot keep this call running. Only
+     * one thread processes the queue at a time; a concurrent or nested call
+     * returns 0.
+     * 
+     * @param max_events Maximum number of events to dispatch
+     * @return Number of events dispatched
+     */
+    size_t process_queue(size_t max_events = std::numeric_limits<size_t>::max());
+    
+    /**
+     * @brief Dispatch queued events until a time budget is used up.
+     * 
+     * The budget is checked between events; one slow handler can overrun it.
+     * 
+     * @param time_budget Time to spend dispatching
+     * @return Number of events dispatched
+     */
+    size_t process_queue(std::chrono::nanoseconds time_budget);
+    
+    /**
+     * @brief Set a function called whenever an event is queued.
+     * 
+     * Runs on the enqueuing thread, typically to wake a loop that waits for
+     * input so it calls process_queue() soon. A coalesced event that only
+     * replaced a queued one does not call it. Set it before other threads
+     * start enqueuing.
+     * 
+     * @param callback Function to call, or nullptr for none
+     */
+    void set_wake_callback(std::function<void()> callback) {
+        wake_callback_ = std::move(callback);
+    }
+    
+    /**
+     * @brief Get the approximate number of events waiting in the queue.
+     */
+    size_t queued_event_count() const {
+        return queue_.size();
+    }
+    
     /**
      * @brief Get the number of active subscriptions for a specific event type.
      * 
@@ -297,12 +543,7 @@ public:
     size_t subscription_count() const {
         static_assert(is_event_v<EventType>, "EventType must inherit from Event");
         
-        std::lock_guard<std::mutex> lock(handlers_mutex_);
-        
-        auto type_index = std::type_index(typeid(EventType));
-        auto it = handlers_.find(type_index);
-        
-        return it != handlers_.end() ? it->second.size() : 0;
+        return subscription_count(event_type_id<EventType>());
     }
     
     /**
@@ -321,23 +562,137 @@ public:
     void clear_subscriptions() {
         static_assert(is_event_v<EventType>, "EventType must inherit from Event");
         
-        std::lock_guard<std::mutex> lock(handlers_mutex_);
-        
-        auto type_index = std::type_index(typeid(EventType));
-        handlers_.erase(type_index);
+        clear_subscriptions(event_type_id<EventType>());
     }
     
     /**
      * @brief Clear all subscriptions for all event types.
      */
     void clear_all_subscriptions();
+    
+    /**
+     * @brief Enable or disable counting and timing of dispatches.
+     * 
+     * Disabled by default; when enabled every handler call reads the clock
+     * twice. Exceptions are counted either way.
+     */
+    void set_instrumentation_enabled(bool enabled) {
+        instrumentation_enabled_.store(enabled, std::memory_order_relaxed);
+    }
+    
+    bool is_instrumentation_enabled() const {
+        return instrumentation_enabled_.load(std::memory_order_relaxed);
+    }
+    
+    /**
+     * @brief Get dispatch counts, exception counts and latencies.
+     * 
+     * @return Statistics of every event type that had subscribers and of
+     *         every current subscription, busiest types and slowest handlers first
+     */
+    DispatchStatistics get_statistics() const;
+    
+    /**
+     * @brief Reset all counters and histograms.
+     */
+    void reset_statistics();
 
 private:
-    mutable std::mutex handlers_mutex_;
-    std::unordered_map<std::type_index, HandlerList> handlers_;
+    // Table used by this thread's outermost dispatch, valid while generation matches
+    struct DispatchCache {
+        uint64_t generation = 0;
+        std::shared_ptr<const HandlerTable> table;
+    };
+    
+    // Provides the handler table for one dispatch on the calling thread
+    class DispatchScope {
+    public:
+        explicit DispatchScope(EventDispatcher& dispatcher) {
+            uint64_t generation = dispatcher.generation_.load(std::memory_order_acquire);
+            if (dispatch_depth_ == 0) {
+                if (dispatch_cache_.generation != generation) {
+                    dispatch_cache_.table = dispatcher.get_handlers(generation);
+                    dispatch_cache_.generation = dispatch_cache_.table->generation;
+                }
+                table_ = dispatch_cache_.table.get();
+            } else {
+                // A nested dispatch must not replace the table the outer one iterates
+                nested_table_ = dispatcher.get_handlers(generation);
+                table_ = nested_table_.get();
+            }
+            ++dispatch_depth_;
+        }
+        
+        ~DispatchScope() {
+            --dispatch_depth_;
+        }
+        
+        DispatchScope(const DispatchScope&) = delete;
+        DispatchScope& operator=(const DispatchScope&) = delete;
+        
+        const HandlerTable& table() const { return *table_; }
+    
+    private:
+        std::shared_ptr<const HandlerTable> nested_table_;
+        const HandlerTable* table_;
+    };
+    
+    // Process-wide unique, so a cache entry never matches a different dispatcher
+    static uint64_t next_generation();
+    
+    static const HandlerList* find_handlers(const HandlerTable& table, size_t type_id) {
+        return type_id < table.lists.size() ? table.lists[type_id].get() : nullptr;
+    }
+    
+    // Snapshot for the given generation, rebuilding it if it is out of date
+    std::shared_ptr<const HandlerTable> get_handlers(uint64_t generation);
+    
+    // Publish a snapshot of the changed types (write_mutex_ must be held); returns the replaced one
+    std::shared_ptr<const HandlerTable> rebuild_handlers_locked();
+    
+    SubscriptionHandle add_subscription(size_t type_id, const std::type_info& type, HandlerPtr info);
+    size_t subscription_count(size_t type_id) const;
+    void clear_subscriptions(size_t type_id);
+    
+    size_t process_queue_until(size_t max_events, std::chrono::steady_clock::time_point deadline);
+    
+    void notify_enqueued() {
+        if (wake_callback_) {
+            wake_callback_();
+        }
+    }
+    
+    // Subscriptions, guarded by write_mutex_
+    mutable std::mutex write_mutex_;
+    std::vector<std::map<OrderKey, HandlerPtr>> subscriptions_;     // Indexed by event_type_id()
+    std::unordered_map<SubscriptionHandle::HandleType, std::pair<size_t, OrderKey>> subscription_index_;
+    std::vector<size_t> changed_types_;                             // Types to copy into the next snapshot
+    std::vector<std::shared_ptr<TypeCounters>> type_counters_;      // Indexed by event_type_id()
+    std::chrono::steady_clock::time_point statistics_start_;
+    std::atomic<bool> instrumentation_enabled_{false};
+    
+    std::shared_ptr<const HandlerTable> handlers_;      // Accessed with atomic_load/atomic_store
+    std::atomic<uint64_t> generation_;                  // Changes whenever the subscriptions change
+    static thread_local DispatchCache dispatch_cache_;
+    static thread_local size_t dispatch_depth_;
     std::atomic<SubscriptionHandle::HandleType> next_subscription_id_;
+    
+    // Deferred delivery
+    EventQueue queue_;
+    std::mutex consume_mutex_;                          // Held by the thread running process_queue()
+    std::mutex coalesce_mutex_;
+    std::vector<QueuedEvent*> pending_coalesced_;       // Coalesced events still in queue_, by event_type_id()
+    std::function<void()> wake_callback_;
 };
 
+inline thread_local EventDispatcher::DispatchCache EventDispatcher::dispatch_cache_;
+inline thread_local size_t EventDispatcher::dispatch_depth_ = 0;
+
+template<typename EventType>
+size_t TypedQueuedEvent<EventType>::dispatch_to(EventDispatcher& dispatcher) {
+    return dispatcher.dispatch(event_);
+}
+
 /**
  * @brief Get a global event dispatcher instance.
  * 
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <thread>
+
+namespace wip::utils::event {
+
+/**
+ * @brief Process-wide pool of equally sized memory blocks.
+ * 
+ * Blocks are carved out of chunks of CHUNK_BLOCKS and recycled through a
+ * free list guarded by a spin lock held for a couple of pointer moves, so
+ * once the pool has grown to the peak number of live blocks, allocation
+ * and release never reach the heap. Blocks may be released on a different
+ * thread than the one that allocated them. Chunks are never returned; the
+ * pool lives until the process exits, so blocks can be released during
+ * static destruction as well.
+ * 
+ * @tparam BlockSize Size of every block in bytes
+ * @tparam Alignment Alignment of every block
+ */
+template<size_t BlockSize, size_t Alignment = alignof(std::max_align_t)>
+class BlockPool {
+public:
+    static constexpr size_t CHUNK_BLOCKS = 64;
+    
+    /**
+     * @brief Take a block, growing the pool by one chunk if none is free.
+     */
+    static void* allocate() {
+        State& state = get_state();
+        state.lock();
+        if (!state.free_list) {
+            grow(state);
+        }
+        FreeBlock* block = state.free_list;
+        state.free_list = block->next;
+        state.unlock();
+        return block;
+    }
+    
+    /**
+     * @brief Return a block taken with allocate().
+     */
+    static void deallocate(void* pointer) noexcept {
+        State& state = get_state();
+        auto* block = static_cast<FreeBlock*>(pointer);
+        state.lock();
+        block->next = state.free_list;
+        state.free_list = block;
+        state.unlock();
+    }
+    
+    /**
+     * @brief Get the number of blocks the pool has created so far.
+     */
+    static size_t capacity() {
+        return get_state().capacity.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+    
+    static constexpr size_t STRIDE =
+        (std::max(BlockSize, sizeof(FreeBlock)) + Alignment - 1) / Alignment * Alignment;
+    
+    struct State {
+        std::atomic_flag busy = ATOMIC_FLAG_INIT;
+        FreeBlock* free_list = nullptr;
+        std::atomic<size_t> capacity{0};
+        
+        void lock() {
+            while (busy.test_and_set(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+        }
+        
+        void unlock() {
+            busy.clear(std::memory_order_release);
+        }
+    };
+    
+    // Never destroyed, so blocks released by static destructors find it intact
+    static State& get_state() {
+        static State* state = new State();
+        return *state;
+    }
+    
+    static void grow(State& state) {
+        auto* chunk = static_cast<unsigned char*>(
+            ::operator new(STRIDE * CHUNK_BLOCKS, std::align_val_t(Alignment)));
+        for (size_t i = CHUNK_BLOCKS; i-- > 0;) {
+            auto* block = reinterpret_cast<FreeBlock*>(chunk + i * STRIDE);
+            block->next = state.free_list;
+            state.free_list = block;
+        }
+        state.capacity.fetch_add(CHUNK_BLOCKS, std::memory_order_relaxed);
+    }
+};
+
+/**
+ * @brief Base class giving a type pooled operator new and delete.
+ * 
+ * Derived classes must be final, since every instance takes a block of
+ * sizeof(Derived) bytes.
+ * 
+ * @tparam Derived The pooled class
+ */
+template<typename Derived>
+class Pooled {
+public:
+    static void* operator new([[maybe_unused]] size_t size) {
+        return BlockPool<sizeof(Derived), alignof(Derived)>::allocate();
+    }
+    
+    static void operator delete(void* pointer) noexcept {
+        BlockPool<sizeof(Derived), alignof(Derived)>::deallocate(pointer);
+    }
+};
+
+} // namespace wip::utils::event
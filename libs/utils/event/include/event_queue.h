@@ -0,0 +1,121 @@
+#pragma once
+
+#include "event.h"
+#include "event_delegate.h"
+#include "event_pool.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace wip::utils::event {
+
+class EventDispatcher;
+
+/**
+ * @brief Type-erased event waiting in an EventQueue.
+ *
+ * Holds a copy of the event and knows how to dispatch it with its real type.
+ */
+class QueuedEvent {
+public:
+    virtual ~QueuedEvent() = default;
+
+    /**
+     * @brief Dispatch the stored event.
+     * @param dispatcher Dispatcher whose handlers receive the event
+     * @return Number of handlers that processed the event
+     */
+    virtual size_t dispatch_to(EventDispatcher& dispatcher) = 0;
+
+    /**
+     * @brief Get the event_type_id() of the stored event.
+     */
+    virtual size_t type_id() const = 0;
+
+    bool coalesced = false;     ///< Newer events of the same type replace this one while queued
+};
+
+/**
+ * @brief Queued copy of an event of a concrete type.
+ *
+ * Allocated from a BlockPool per event type, so a steady stream of queued
+ * events reuses the same blocks instead of calling the heap.
+ */
+template<typename EventType>
+class TypedQueuedEvent final : public QueuedEvent, public Pooled<TypedQueuedEvent<EventType>> {
+public:
+    explicit TypedQueuedEvent(EventType event) : event_(std::move(event)) {}
+
+    size_t dispatch_to(EventDispatcher& dispatcher) override;
+
+    size_t type_id() const override { return event_type_id<EventType>(); }
+
+    /**
+     * @brief Replace the stored event with a newer one.
+     */
+    void replace(EventType event) { event_ = std::move(event); }
+
+private:
+    EventType event_;
+};
+
+/**
+ * @brief Bounded, lock-free multi-producer queue of events.
+ *
+ * A ring buffer of sequence-numbered cells: producers claim a cell with one
+ * compare-and-swap on the enqueue position and publish it by bumping the
+ * cell's sequence number, so publishers on different threads never block
+ * each other or the consumer. Only one thread may pop at a time.
+ */
+class EventQueue {
+public:
+    /**
+     * @brief Create a queue.
+     * @param capacity Maximum number of queued events (rounded up to a power of two)
+     */
+    explicit EventQueue(size_t capacity);
+
+    /**
+     * @brief Destroy the queue and every event still in it.
+     */
+    ~EventQueue();
+
+    EventQueue(const EventQueue&) = delete;
+    EventQueue& operator=(const EventQueue&) = delete;
+
+    /**
+     * @brief Append an event.
+     * @param event Event to queue (ownership is taken only on success)
+     * @return False if the queue is full
+     */
+    bool try_push(QueuedEvent* event);
+
+    /**
+     * @brief Remove the oldest event (single consumer).
+     * @return The event, or nullptr if the queue is empty
+     */
+    QueuedEvent* try_pop();
+
+    /**
+     * @brief Get the approximate number of queued events.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Get the maximum number of queued events.
+     */
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        QueuedEvent* event = nullptr;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_;
+    alignas(64) std::atomic<size_t> enqueue_pos_{0};
+    alignas(64) std::atomic<size_t> dequeue_pos_{0};
+};
+
+} // namespace wip::utils::event
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace wip::utils::event {
+
+/**
+ * @brief Runs tasks on a thread of its choosing.
+ * 
+ * Subscriptions made with EventDispatcher::subscribe_on() hand every event
+ * to an executor instead of running the handler on the publishing thread,
+ * so a handler only ever runs where its executor runs it.
+ */
+class Executor {
+public:
+    using Task = std::function<void()>;
+    
+    virtual ~Executor() = default;
+    
+    /**
+     * @brief Schedule a task.
+     * 
+     * Safe to call from any thread. Tasks run in the order they were posted
+     * and must not throw.
+     * 
+     * @param task Task to run
+     */
+    virtual void post(Task task) = 0;
+};
+
+/**
+ * @brief Executor running every task at once on the posting thread.
+ */
+class InlineExecutor : public Executor {
+public:
+    void post(Task task) override {
+        task();
+    }
+};
+
+/**
+ * @brief Executor collecting tasks until its owner runs them.
+ * 
+ * Any thread may post; the owning thread calls run_pending(), typically once
+ * per frame, and takes the whole batch under a single lock. Tasks therefore
+ * never run concurrently with each other, and state touched only by them
+ * needs no locking.
+ */
+class QueuedExecutor : public Executor {
+public:
+    void post(Task task) override;
+    
+    /**
+     * @brief Run the tasks posted so far on the calling thread.
+     * 
+     * Tasks posted while the batch runs wait for the next call.
+     * 
+     * @return Number of tasks run
+     */
+    size_t run_pending();
+    
+    /**
+     * @brief Get the number of tasks waiting for run_pending().
+     */
+    size_t pending_count() const;
+    
+    /**
+     * @brief Set a function called on the posting thread after every post().
+     * 
+     * Lets an owner that waits for input wake up to run the new task. Set it
+     * before other threads start posting.
+     * 
+     * @param callback Function to call, or nullptr for none
+     */
+    void set_wake_callback(std::function<void()> callback) {
+        wake_callback_ = std::move(callback);
+    }
+
+private:
+    std::function<void()> wake_callback_;
+    mutable std::mutex mutex_;
+    std::vector<Task> pending_;
+    std::vector<Task> running_;     // Kept between calls to reuse its capacity
+};
+
+/**
+ * @brief Executor running tasks on its own background thread.
+ * 
+ * The thread takes every task posted since its last batch at once and runs
+ * them in order, so tasks never run concurrently with each other. Tasks
+ * still waiting when the executor is destroyed are run before it returns.
+ */
+class WorkerExecutor : public Executor {
+public:
+    WorkerExecutor();
+    ~WorkerExecutor() override;
+    
+    WorkerExecutor(const WorkerExecutor&) = delete;
+    WorkerExecutor& operator=(const WorkerExecutor&) = delete;
+    
+    void post(Task task) override;
+    
+    /**
+     * @brief Check whether the calling thread is the worker thread.
+     */
+    bool is_worker_thread() const {
+        return std::this_thread::get_id() == thread_.get_id();
+    }
+
+private:
+    void run();
+    
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::vector<Task> pending_;
+    bool stopping_ = false;
+    std::thread thread_;
+};
+
+/**
+ * @brief Get a shared executor that runs tasks on the posting thread.
+ */
+Executor& inline_executor();
+
+} // namespace wip::utils::event
@@ -0,0 +1,261 @@
+#pragma once
+
+#include <any>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace wip::utils::event {
+
+/**
+ * @brief String stored inside the object up to a fixed length.
+ * 
+ * Texts of up to Capacity characters need no allocation, and copying one
+ * is a memcpy. Longer texts fall back to a heap buffer of their own.
+ * 
+ * @tparam Capacity Longest text stored inline
+ */
+template<size_t Capacity>
+class InlineString {
+public:
+    InlineString() noexcept {
+        inline_[0] = '\0';
+    }
+    
+    InlineString(std::string_view text) {
+        assign(text);
+    }
+    
+    InlineString(const char* text) : InlineString(std::string_view(text)) {}
+    
+    InlineString(const std::string& text) : InlineString(std::string_view(text)) {}
+    
+    InlineString(const InlineString& other) {
+        assign(other.view());
+    }
+    
+    InlineString(InlineString&& other) noexcept {
+        take(other);
+    }
+    
+    InlineString& operator=(const InlineString& other) {
+        if (this != &other) {
+            release();
+            assign(other.view());
+        }
+        return *this;
+    }
+    
+    InlineString& operator=(InlineString&& other) noexcept {
+        if (this != &other) {
+            release();
+            take(other);
+        }
+        return *this;
+    }
+    
+    ~InlineString() {
+        release();
+    }
+    
+    std::string_view view() const noexcept { return std::string_view(data(), size_); }
+    const char* c_str() const noexcept { return data(); }
+    size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    
+    /**
+     * @brief Check whether the text fits without a heap buffer.
+     */
+    bool is_inline() const noexcept { return heap_ == nullptr; }
+    
+    operator std::string_view() const noexcept { return view(); }
+
+private:
+    const char* data() const noexcept { return heap_ ? heap_ : inline_; }
+    
+    void assign(std::string_view text) {
+        size_ = text.size();
+        char* destination = inline_;
+        if (size_ > Capacity) {
+            heap_ = new char[size_ + 1];
+            destination = heap_;
+        }
+        std::memcpy(destination, text.data(), size_);
+        destination[size_] = '\0';
+    }
+    
+    void take(InlineString& other) noexcept {
+        size_ = other.size_;
+        heap_ = other.heap_;
+        if (!heap_) {
+            std::memcpy(inline_, other.inline_, size_ + 1);
+        }
+        other.heap_ = nullptr;
+        other.size_ = 0;
+        other.inline_[0] = '\0';
+    }
+    
+    void release() noexcept {
+        delete[] heap_;
+        heap_ = nullptr;
+    }
+    
+    char* heap_ = nullptr;
+    size_t size_ = 0;
+    char inline_[Capacity + 1];
+};
+
+/**
+ * @brief Type-erased value with small-buffer storage, a lighter std::any.
+ * 
+ * Values of up to INLINE_SIZE bytes that move without throwing are stored
+ * inside the object; std::any keeps only pointer-sized values inline, so
+ * a std::string or a small struct would allocate for every event.
+ * 
+ * @tparam InlineSize Largest value stored inline, in bytes
+ */
+template<size_t InlineSize>
+class InlineAny {
+public:
+    static constexpr size_t INLINE_SIZE = InlineSize;
+    
+    InlineAny() = default;
+    
+    template<typename T, typename = std::enable_if_t<!std::is_same_v<std::decay_t<T>, InlineAny>>>
+    InlineAny(T&& value) : ops_(&Model<std::decay_t<T>>::ops) {
+        Model<std::decay_t<T>>::construct(storage_, std::forward<T>(value));
+    }
+    
+    InlineAny(const InlineAny& other) : ops_(other.ops_) {
+        if (ops_) {
+            ops_->copy(storage_, other.storage_);
+        }
+    }
+    
+    InlineAny(InlineAny&& other) noexcept : ops_(other.ops_) {
+        if (ops_) {
+            ops_->move(storage_, other.storage_);
+            other.ops_ = nullptr;
+        }
+    }
+    
+    InlineAny& operator=(const InlineAny& other) {
+        if (this != &other) {
+            InlineAny copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+    
+    InlineAny& operator=(InlineAny&& other) noexcept {
+        if (this != &other) {
+            reset();
+            ops_ = other.ops_;
+            if (ops_) {
+                ops_->move(storage_, other.storage_);
+                other.ops_ = nullptr;
+            }
+        }
+        return *this;
+    }
+    
+    ~InlineAny() {
+        reset();
+    }
+    
+    bool has_value() const noexcept { return ops_ != nullptr; }
+    
+    /**
+     * @brief Check whether the value is of type T.
+     */
+    template<typename T>
+    bool holds() const noexcept {
+        return ops_ == &Model<T>::ops;
+    }
+    
+    /**
+     * @brief Get the value.
+     * @throws std::bad_any_cast if the value is not of type T
+     */
+    template<typename T>
+    const T& get() const {
+        if (!holds<T>()) {
+            throw std::bad_any_cast();
+        }
+        return *Model<T>::get(const_cast<unsigned char*>(storage_));
+    }
+    
+    void reset() noexcept {
+        if (ops_) {
+            ops_->destroy(storage_);
+            ops_ = nullptr;
+        }
+    }
+
+private:
+    struct Ops {
+        void (*copy)(void* destination, const void* source);
+        void (*move)(void* destination, void* source) noexcept;
+        void (*destroy)(void* storage) noexcept;
+    };
+    
+    // One Ops table per stored type, which doubles as the type check
+    template<typename T>
+    struct Model {
+        static constexpr bool is_inline =
+            sizeof(T) <= InlineSize &&
+            alignof(T) <= alignof(std::max_align_t) &&
+            std::is_nothrow_move_constructible_v<T>;
+        
+        static T* get(void* storage) {
+            if constexpr (is_inline) {
+                return std::launder(static_cast<T*>(storage));
+            } else {
+                return *static_cast<T**>(storage);
+            }
+        }
+        
+        template<typename Argument>
+        static void construct(void* storage, Argument&& argument) {
+            if constexpr (is_inline) {
+                new (storage) T(std::forward<Argument>(argument));
+            } else {
+                *static_cast<T**>(storage) = new T(std::forward<Argument>(argument));
+            }
+        }
+        
+        static void copy(void* destination, const void* source) {
+            construct(destination, *get(const_cast<void*>(source)));
+        }
+        
+        static void move(void* destination, void* source) noexcept {
+            if constexpr (is_inline) {
+                new (destination) T(std::move(*get(source)));
+                get(source)->~T();
+            } else {
+                *static_cast<T**>(destination) = get(source);
+            }
+        }
+        
+        static void destroy(void* storage) noexcept {
+            if constexpr (is_inline) {
+                get(storage)->~T();
+            } else {
+                delete get(storage);
+            }
+        }
+        
+        static constexpr Ops ops = {&copy, &move, &destroy};
+    };
+    
+    static_assert(InlineSize >= sizeof(void*), "InlineSize must hold a pointer");
+    
+    const Ops* ops_ = nullptr;
+    alignas(std::max_align_t) unsigned char storage_[InlineSize];
+};
+
+} // namespace wip::utils::event
@@ -0,0 +1,153 @@
+#include "dispatch_statistics.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#include <cstdlib>
+#include <memory>
+#endif
+
+namespace wip::utils::event {
+
+namespace {
+
+std::string format_duration(std::chrono::nanoseconds duration) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1);
+    auto ns = static_cast<double>(duration.count());
+    if (ns < 1e3) {
+        out << ns << " ns";
+    } else if (ns < 1e6) {
+        out << ns / 1e3 << " us";
+    } else {
+        out << ns / 1e6 << " ms";
+    }
+    return out.str();
+}
+
+} // namespace
+
+void LatencyHistogram::record(std::chrono::nanoseconds duration) {
+    auto nanoseconds = static_cast<uint64_t>(std::max<int64_t>(0, duration.count()));
+    buckets_[bucket_index(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    total_.fetch_add(nanoseconds, std::memory_order_relaxed);
+    
+    uint64_t previous_max = max_.load(std::memory_order_relaxed);
+    while (nanoseconds > previous_max &&
+           !max_.compare_exchange_weak(previous_max, nanoseconds, std::memory_order_relaxed)) {
+    }
+}
+
+LatencyHistogram::Summary LatencyHistogram::summarize() const {
+    Summary summary;
+    std::array<uint64_t, BUCKET_COUNT> counts;
+    uint64_t count = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        counts[i] = buckets_[i].load(std::memory_order_relaxed);
+        count += counts[i];
+    }
+    
+    summary.count = count;
+    if (count == 0) {
+        return summary;
+    }
+    
+    summary.total = std::chrono::nanoseconds(total_.load(std::memory_order_relaxed));
+    summary.mean = summary.total / count;
+    summary.max = std::chrono::nanoseconds(max_.load(std::memory_order_relaxed));
+    
+    // Percentiles are the upper bound of the bucket holding the ranked value
+    auto percentile = [&](double fraction) {
+        auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(fraction * static_cast<double>(count) + 0.5));
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            seen += counts[i];
+            if (seen >= rank) {
+                return std::min(std::chrono::nanoseconds(bucket_upper_bound(i)), summary.max);
+            }
+        }
+        return summary.max;
+    };
+    summary.p50 = percentile(0.50);
+    summary.p90 = percentile(0.90);
+    summary.p99 = percentile(0.99);
+    return summary;
+}
+
+void LatencyHistogram::reset() {
+    for (auto& bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    total_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+size_t LatencyHistogram::bucket_index(uint64_t nanoseconds) {
+    if (nanoseconds < SUB_BUCKETS) {
+        return static_cast<size_t>(nanoseconds);
+    }
+    
+    size_t highest_bit = 63 - static_cast<size_t>(__builtin_clzll(nanoseconds));
+    size_t magnitude = highest_bit - SUB_BUCKET_BITS + 1;
+    if (magnitude >= MAGNITUDES) {
+        return BUCKET_COUNT - 1;
+    }
+    
+    size_t sub_bucket = (nanoseconds >> (highest_bit - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+    return magnitude * SUB_BUCKETS + sub_bucket;
+}
+
+uint64_t LatencyHistogram::bucket_upper_bound(size_t index) {
+    size_t magnitude = index / SUB_BUCKETS;
+    size_t sub_bucket = index % SUB_BUCKETS;
+    if (magnitude == 0) {
+        return sub_bucket;
+    }
+    
+    size_t shift = magnitude - 1;
+    return ((SUB_BUCKETS + sub_bucket) << shift) + ((uint64_t(1) << shift) - 1);
+}
+
+std::string DispatchStatistics::to_string() const {
+    std::ostringstream out;
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    out << "Event dispatch statistics over " << std::fixed << std::setprecision(1) << seconds << " s\n";
+    
+    out << "\nEvent types:\n";
+    for (const auto& type : event_types) {
+        out << "  " << type.name << ": " << type.dispatches << " dispatches ("
+            << std::setprecision(1) << type.dispatches_per_second << "/s), "
+            << type.exceptions << " exceptions, p50 " << format_duration(type.latency.p50)
+            << ", p99 " << format_duration(type.latency.p99)
+            << ", max " << format_duration(type.latency.max) << "\n";
+    }
+    
+    out << "\nHandlers:\n";
+    for (const auto& handler : handlers) {
+        out << "  #" << handler.subscription_id << " " << handler.event_type
+            << " (priority " << static_cast<int>(handler.priority) << "): "
+            << handler.calls << " calls, " << handler.exceptions << " exceptions, mean "
+            << format_duration(handler.latency.mean) << ", p99 " << format_duration(handler.latency.p99)
+            << ", max " << format_duration(handler.latency.max) << "\n";
+    }
+    
+    return out.str();
+}
+
+std::string readable_type_name(const std::type_info& type) {
+#if defined(__GNUG__)
+    int status = 0;
+    std::unique_ptr<char, void (*)(void*)> demangled(
+        abi::__cxa_demangle(type.name(), nullptr, nullptr, &status), std::free);
+    if (status == 0 && demangled) {
+        return demangled.get();
+    }
+#endif
+    return type.name();
+}
+
+} // namespace wip::utils::event
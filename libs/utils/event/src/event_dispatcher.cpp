@@ -2,42 +2,286 @@
 
 namespace wip::utils::event {
 
+EventDispatcher::EventDispatcher(size_t queue_capacity)
+    : generation_(next_generation()),
+      next_subscription_id_(1),
+      queue_(queue_capacity),
+      statistics_start_(std::chrono::steady_clock::now()) {
+    auto table = std::make_shared<HandlerTable>();
+    table->generation = generation_.load(std::memory_order_relaxed);
+    handlers_ = std::move(table);
+}
+
+SubscriptionHandle EventDispatcher::add_subscription(size_t type_id, const std::type_info& type, HandlerPtr info) {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    
+    if (subscriptions_.size() <= type_id) {
+        subscriptions_.resize(type_id + 1);
+    }
+    if (type_counters_.size() <= type_id) {
+        type_counters_.resize(type_id + 1);
+    }
+    
+    // Counters outlive the subscriptions of their type
+    if (!type_counters_[type_id]) {
+        type_counters_[type_id] = std::make_shared<TypeCounters>();
+        type_counters_[type_id]->name = readable_type_name(type);
+    }
+    
+    auto id = info->id;
+    OrderKey key(-static_cast<int>(info->priority), id);
+    subscriptions_[type_id].emplace(key, std::move(info));
+    subscription_index_.emplace(id, std::make_pair(type_id, key));
+    
+    changed_types_.push_back(type_id);
+    generation_.store(next_generation(), std::memory_order_release);
+    return SubscriptionHandle(id);
+}
+
 bool EventDispatcher::unsubscribe(SubscriptionHandle handle) {
     if (!handle.is_valid()) {
         return false;
     }
     
-    std::lock_guard<std::mutex> lock(handlers_mutex_);
+    // Released after the lock; the handler may own a subscription itself
+    HandlerPtr removed;
+    std::lock_guard<std::mutex> lock(write_mutex_);
     
-    for (auto& [type_index, handler_list] : handlers_) {
-        auto it = std::find_if(handler_list.begin(), handler_list.end(),
-                              [handle](const HandlerInfo& info) {
-                                  return info.id == handle.id();
-                              });
-        
-        if (it != handler_list.end()) {
-            handler_list.erase(it);
-            return true;
-        }
+    auto index_it = subscription_index_.find(handle.id());
+    if (index_it == subscription_index_.end()) {
+        return false;
     }
     
-    return false;
+    auto [type_id, key] = index_it->second;
+    subscription_index_.erase(index_it);
+    
+    auto& type_subscriptions = subscriptions_[type_id];
+    auto it = type_subscriptions.find(key);
+    removed = std::move(it->second);
+    type_subscriptions.erase(it);
+    
+    // Running dispatches skip it from now on
+    removed->active.store(false, std::memory_order_release);
+    
+    changed_types_.push_back(type_id);
+    generation_.store(next_generation(), std::memory_order_release);
+    return true;
+}
+
+size_t EventDispatcher::subscription_count(size_t type_id) const {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    return type_id < subscriptions_.size() ? subscriptions_[type_id].size() : 0;
 }
 
 size_t EventDispatcher::total_subscription_count() const {
-    std::lock_guard<std::mutex> lock(handlers_mutex_);
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    return subscription_index_.size();
+}
+
+void EventDispatcher::clear_subscriptions(size_t type_id) {
+    std::map<OrderKey, HandlerPtr> removed;
+    std::lock_guard<std::mutex> lock(write_mutex_);
     
-    size_t total = 0;
-    for (const auto& [type_index, handler_list] : handlers_) {
-        total += handler_list.size();
+    if (type_id >= subscriptions_.size() || subscriptions_[type_id].empty()) {
+        return;
     }
     
-    return total;
+    removed.swap(subscriptions_[type_id]);
+    for (const auto& [key, info] : removed) {
+        info->active.store(false, std::memory_order_release);
+        subscription_index_.erase(info->id);
+    }
+    
+    changed_types_.push_back(type_id);
+    generation_.store(next_generation(), std::memory_order_release);
 }
 
 void EventDispatcher::clear_all_subscriptions() {
-    std::lock_guard<std::mutex> lock(handlers_mutex_);
-    handlers_.clear();
+    std::vector<std::map<OrderKey, HandlerPtr>> removed;
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    
+    removed.swap(subscriptions_);
+    subscriptions_.resize(removed.size());
+    for (size_t type_id = 0; type_id < removed.size(); ++type_id) {
+        for (const auto& [key, info] : removed[type_id]) {
+            info->active.store(false, std::memory_order_release);
+        }
+        if (!removed[type_id].empty()) {
+            changed_types_.push_back(type_id);
+        }
+    }
+    subscription_index_.clear();
+    
+    generation_.store(next_generation(), std::memory_order_release);
+}
+
+std::shared_ptr<const EventDispatcher::HandlerTable> EventDispatcher::get_handlers(uint64_t generation) {
+    auto table = std::atomic_load(&handlers_);
+    if (table->generation == generation) {
+        return table;
+    }
+    
+    // The replaced snapshot is released after the lock, like removed handlers
+    std::shared_ptr<const HandlerTable> replaced;
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    replaced = rebuild_handlers_locked();
+    return handlers_;
+}
+
+std::shared_ptr<const EventDispatcher::HandlerTable> EventDispatcher::rebuild_handlers_locked() {
+    uint64_t generation = generation_.load(std::memory_order_relaxed);
+    if (handlers_->generation == generation) {
+        return nullptr;  // Another dispatch rebuilt it first
+    }
+    
+    // Lists of unchanged types are shared with the previous snapshot, not copied
+    auto table = std::make_shared<HandlerTable>(*handlers_);
+    table->generation = generation;
+    table->counters = type_counters_;
+    if (table->lists.size() < subscriptions_.size()) {
+        table->lists.resize(subscriptions_.size());
+    }
+    
+    std::sort(changed_types_.begin(), changed_types_.end());
+    changed_types_.erase(std::unique(changed_types_.begin(), changed_types_.end()), changed_types_.end());
+    for (size_t type_id : changed_types_) {
+        if (type_id >= subscriptions_.size() || subscriptions_[type_id].empty()) {
+            if (type_id < table->lists.size()) {
+                table->lists[type_id] = nullptr;
+            }
+            continue;
+        }
+        
+        auto list = std::make_shared<HandlerList>();
+        list->reserve(subscriptions_[type_id].size());
+        if (type_id >= subscriptions_.size()) {
+            continue;
+        }
+        for (const auto& [key, info] : subscriptions_[type_id]) {
+            list->push_back(info);
+        }
+        table->lists[type_id] = std::move(list);
+    }
+    changed_types_.clear();
+    
+    return std::atomic_exchange(&handlers_, std::shared_ptr<const HandlerTable>(std::move(table)));
+}
+
+DispatchStatistics EventDispatcher::get_statistics() const {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    
+    DispatchStatistics statistics;
+    statistics.elapsed = std::chrono::steady_clock::now() - statistics_start_;
+    double seconds = std::chrono::duration<double>(statistics.elapsed).count();
+    
+    for (size_t type_id = 0; type_id < type_counters_.size(); ++type_id) {
+        const auto& counters = type_counters_[type_id];
+        if (!counters) {
+            continue;
+        }
+        
+        EventTypeStatistics type_statistics;
+        type_statistics.name = counters->name;
+        type_statistics.dispatches = counters->dispatches.load(std::memory_order_relaxed);
+        type_statistics.exceptions = counters->exceptions.load(std::memory_order_relaxed);
+        type_statistics.dispatches_per_second = seconds > 0.0 ? type_statistics.dispatches / seconds : 0.0;
+        type_statistics.latency = counters->latency.summarize();
+        statistics.event_types.push_back(std::move(type_statistics));
+        
+        if (type_id >= subscriptions_.size()) {
+            continue;
+        }
+        for (const auto& [key, info] : subscriptions_[type_id]) {
+            HandlerStatistics handler_statistics;
+            handler_statistics.subscription_id = info->id;
+            handler_statistics.event_type = counters->name;
+            handler_statistics.priority = info->priority;
+            handler_statistics.exceptions = info->exceptions.load(std::memory_order_relaxed);
+            handler_statistics.latency = info->latency.summarize();
+            handler_statistics.calls = handler_statistics.latency.count;
+            statistics.handlers.push_back(std::move(handler_statistics));
+        }
+    }
+    
+    std::sort(statistics.event_types.begin(), statistics.event_types.end(),
+              [](const EventTypeStatistics& a, const EventTypeStatistics& b) {
+                  return a.dispatches > b.dispatches;
+              });
+    std::sort(statistics.handlers.begin(), statistics.handlers.end(),
+              [](const HandlerStatistics& a, const HandlerStatistics& b) {
+                  return a.latency.p99 > b.latency.p99;
+              });
+    return statistics;
+}
+
+void EventDispatcher::reset_statistics() {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    
+    for (const auto& counters : type_counters_) {
+        if (counters) {
+            counters->dispatches.store(0, std::memory_order_relaxed);
+            counters->exceptions.store(0, std::memory_order_relaxed);
+            counters->latency.reset();
+        }
+    }
+    for (const auto& type_subscriptions : subscriptions_) {
+        for (const auto& [key, info] : type_subscriptions) {
+            info->exceptions.store(0, std::memory_order_relaxed);
+            info->latency.reset();
+        }
+    }
+    statistics_start_ = std::chrono::steady_clock::now();
+}
+
+uint64_t EventDispatcher::next_generation() {
+    static std::atomic<uint64_t> counter{1};
+    return counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+size_t EventDispatcher::process_queue(size_t max_events) {
+    return process_queue_until(max_events, std::chrono::steady_clock::time_point::max());
+}
+
+size_t EventDispatcher::process_queue(std::chrono::nanoseconds time_budget) {
+    return process_queue_until(std::numeric_limits<size_t>::max(),
+                               std::chrono::steady_clock::now() + time_budget);
+}
+
+size_t EventDispatcher::process_queue_until(size_t max_events, std::chrono::steady_clock::time_point deadline) {
+    std::unique_lock<std::mutex> consumer(consume_mutex_, std::try_to_lock);
+    if (!consumer.owns_lock()) {
+        return 0;
+    }
+    
+    // Only events queued before this call; handlers may queue more
+    size_t limit = std::min(max_events, queue_.size());
+    bool timed = deadline != std::chrono::steady_clock::time_point::max();
+    
+    size_t processed = 0;
+    while (processed < limit) {
+        std::unique_ptr<QueuedEvent> event(queue_.try_pop());
+        if (!event) {
+            break;
+        }
+        
+        // From here on, newer coalesced events of this type are queued anew
+        if (event->coalesced) {
+            std::lock_guard<std::mutex> lock(coalesce_mutex_);
+            size_t type_id = event->type_id();
+            if (type_id < pending_coalesced_.size() && pending_coalesced_[type_id] == event.get()) {
+                pending_coalesced_[type_id] = nullptr;
+            }
+        }
+        
+        event->dispatch_to(*this);
+        ++processed;
+        
+        if (timed && std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+    }
+    
+    return processed;
 }
 
 EventDispatcher& global_dispatcher() {
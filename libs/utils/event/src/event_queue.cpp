@@ -0,0 +1,69 @@
+#include "event_queue.h"
+
+namespace wip::utils::event {
+
+EventQueue::EventQueue(size_t capacity) {
+    size_t rounded = 2;
+    while (rounded < capacity) {
+        rounded <<= 1;
+    }
+    
+    cells_ = std::make_unique<Cell[]>(rounded);
+    mask_ = rounded - 1;
+    for (size_t i = 0; i < rounded; ++i) {
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+EventQueue::~EventQueue() {
+    while (QueuedEvent* event = try_pop()) {
+        delete event;
+    }
+}
+
+bool EventQueue::try_push(QueuedEvent* event) {
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell& cell = cells_[pos & mask_];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+        
+        if (difference == 0) {
+            // The cell is free for this lap; claim it
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                cell.event = event;
+                cell.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (difference < 0) {
+            return false;  // The consumer has not freed the cell yet: full
+        } else {
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+QueuedEvent* EventQueue::try_pop() {
+    size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    Cell& cell = cells_[pos & mask_];
+    size_t sequence = cell.sequence.load(std::memory_order_acquire);
+    
+    // A claimed cell is only readable once its producer has published it
+    if (static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1) < 0) {
+        return nullptr;
+    }
+    
+    QueuedEvent* event = cell.event;
+    cell.event = nullptr;
+    dequeue_pos_.store(pos + 1, std::memory_order_relaxed);
+    cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+    return event;
+}
+
+size_t EventQueue::size() const {
+    size_t enqueued = enqueue_pos_.load(std::memory_order_relaxed);
+    size_t dequeued = dequeue_pos_.load(std::memory_order_relaxed);
+    return enqueued > dequeued ? enqueued - dequeued : 0;
+}
+
+} // namespace wip::utils::event
@@ -0,0 +1,85 @@
+#include "executor.h"
+
+namespace wip::utils::event {
+
+void QueuedExecutor::post(Task task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.push_back(std::move(task));
+    }
+    
+    if (wake_callback_) {
+        wake_callback_();
+    }
+}
+
+size_t QueuedExecutor::run_pending() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_.swap(pending_);
+    }
+    
+    size_t count = running_.size();
+    for (auto& task : running_) {
+        task();
+    }
+    running_.clear();
+    return count;
+}
+
+size_t QueuedExecutor::pending_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pending_.size();
+}
+
+WorkerExecutor::WorkerExecutor() : thread_([this]() { run(); }) {
+}
+
+WorkerExecutor::~WorkerExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+}
+
+void WorkerExecutor::post(Task task) {
+    bool was_idle;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        was_idle = pending_.empty();
+        pending_.push_back(std::move(task));
+    }
+    
+    // A worker with tasks already pending is awake or about to take them
+    if (was_idle) {
+        wake_.notify_one();
+    }
+}
+
+void WorkerExecutor::run() {
+    std::vector<Task> batch;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wake_.wait(lock, [this]() { return stopping_ || !pending_.empty(); });
+        if (pending_.empty()) {
+            return;     // Stopping with nothing left to run
+        }
+        
+        batch.swap(pending_);
+        lock.unlock();
+        for (auto& task : batch) {
+            task();
+        }
+        batch.clear();
+        lock.lock();
+    }
+}
+
+Executor& inline_executor() {
+    static InlineExecutor executor;
+    return executor;
+}
+
+} // namespace wip::utils::event
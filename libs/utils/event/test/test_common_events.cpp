@@ -163,4 +163,49 @@ TEST(CommonEventsTest, EventConsumption) {
     event.consume();
     
     EXPECT_TRUE(event.is_consumed());
-}
\ No newline at end of file
+}
+
+TEST(CommonEventsTest, ShortPayloadsAreStoredInline) {
+    MessageEvent short_message{"short"};
+    std::string long_text(MessageEvent::INLINE_MESSAGE_LENGTH + 1, 'x');
+    MessageEvent long_message{long_text};
+    
+    EXPECT_EQ(short_message.message(), "short");
+    EXPECT_EQ(long_message.message(), long_text);
+    
+    // Copies own their storage
+    MessageEvent copy = long_message;
+    long_message = short_message;
+    EXPECT_EQ(copy.message(), long_text);
+    EXPECT_EQ(long_message.message(), "short");
+    
+    InlineString<8> inline_text("12345678");
+    InlineString<8> heap_text("123456789");
+    EXPECT_TRUE(inline_text.is_inline());
+    EXPECT_FALSE(heap_text.is_inline());
+    EXPECT_STREQ(heap_text.c_str(), "123456789");
+}
+
+TEST(CommonEventsTest, InlineAnyChecksTypes) {
+    struct Large {
+        double values[8];
+    };
+    
+    InlineAny<32> number(42);
+    InlineAny<32> large(Large{{1.0}});
+    InlineAny<32> large_copy = large;
+    
+    EXPECT_TRUE(number.holds<int>());
+    EXPECT_FALSE(number.holds<long>());
+    EXPECT_EQ(number.get<int>(), 42);
+    EXPECT_THROW(number.get<double>(), std::bad_any_cast);
+    EXPECT_EQ(large_copy.get<Large>().values[0], 1.0);
+    
+    InlineAny<32> moved = std::move(number);
+    EXPECT_FALSE(number.has_value());
+    EXPECT_EQ(moved.get<int>(), 42);
+    
+    DataEvent event{"point", std::string("not an int")};
+    EXPECT_FALSE(event.has_data<int>());
+    EXPECT_THROW(event.data<int>(), std::bad_any_cast);
+}
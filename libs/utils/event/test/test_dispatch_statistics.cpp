@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <event_dispatcher.h>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+using namespace wip::utils::event;
+
+class StatsTestEvent : public Event {
+public:
+    explicit StatsTestEvent(int value) : value_(value) {}
+    int value() const { return value_; }
+private:
+    int value_;
+};
+
+class QuietTestEvent : public Event {};
+
+class DispatchStatisticsTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dispatcher_ = std::make_unique<EventDispatcher>();
+    }
+    
+    void TearDown() override {
+        dispatcher_.reset();
+    }
+    
+    std::unique_ptr<EventDispatcher> dispatcher_;
+};
+
+TEST(LatencyHistogramTest, BucketsBoundValues) {
+    for (uint64_t value : {0ull, 3ull, 4ull, 7ull, 8ull, 1000ull, 123456789ull}) {
+        auto index = LatencyHistogram::bucket_index(value);
+        EXPECT_GE(LatencyHistogram::bucket_upper_bound(index), value);
+        if (index > 0) {
+            EXPECT_LT(LatencyHistogram::bucket_upper_bound(index - 1), value);
+        }
+    }
+    
+    // Buckets are at most 25% wide
+    auto index = LatencyHistogram::bucket_index(1000000);
+    EXPECT_LE(LatencyHistogram::bucket_upper_bound(index), 1250000u);
+}
+
+TEST(LatencyHistogramTest, SummarizesPercentiles) {
+    LatencyHistogram histogram;
+    for (int i = 0; i < 99; ++i) {
+        histogram.record(std::chrono::microseconds(10));
+    }
+    histogram.record(std::chrono::milliseconds(5));
+    
+    auto summary = histogram.summarize();
+    EXPECT_EQ(summary.count, 100);
+    EXPECT_EQ(summary.max, std::chrono::milliseconds(5));
+    EXPECT_GE(summary.p50, std::chrono::microseconds(10));
+    EXPECT_LE(summary.p50, std::chrono::microseconds(13));
+    EXPECT_LE(summary.p99, std::chrono::microseconds(13));
+    EXPECT_EQ(summary.mean, std::chrono::nanoseconds(59900));
+    
+    histogram.reset();
+    EXPECT_EQ(histogram.summarize().count, 0);
+}
+
+TEST_F(DispatchStatisticsTest, CountsSwallowedExceptions) {
+    dispatcher_->subscribe<StatsTestEvent>([](const StatsTestEvent&) {
+        throw std::runtime_error("handler failed");
+    });
+    
+    // Instrumentation is off, but exceptions are still counted
+    dispatcher_->dispatch(StatsTestEvent{1});
+    dispatcher_->dispatch(StatsTestEvent{2});
+    
+    auto statistics = dispatcher_->get_statistics();
+    ASSERT_EQ(statistics.event_types.size(), 1);
+    EXPECT_EQ(statistics.event_types[0].exceptions, 2);
+    EXPECT_EQ(statistics.event_types[0].dispatches, 0);
+    EXPECT_NE(statistics.event_types[0].name.find("StatsTestEvent"), std::string::npos);
+    ASSERT_EQ(statistics.handlers.size(), 1);
+    EXPECT_EQ(statistics.handlers[0].exceptions, 2);
+}
+
+TEST_F(DispatchStatisticsTest, InstrumentationTimesHandlers) {
+    auto slow = dispatcher_->subscribe<StatsTestEvent>([](const StatsTestEvent&) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    });
+    dispatcher_->subscribe<StatsTestEvent>([](const StatsTestEvent&) {});
+    dispatcher_->subscribe<QuietTestEvent>([](const QuietTestEvent&) {});
+    
+    dispatcher_->set_instrumentation_enabled(true);
+    for (int i = 0; i < 3; ++i) {
+        dispatcher_->dispatch(StatsTestEvent{i});
+    }
+    dispatcher_->set_instrumentation_enabled(false);
+    dispatcher_->dispatch(StatsTestEvent{3});
+    
+    auto statistics = dispatcher_->get_statistics();
+    ASSERT_EQ(statistics.event_types.size(), 2);
+    EXPECT_EQ(statistics.event_types[0].dispatches, 3);
+    EXPECT_GE(statistics.event_types[0].latency.max, std::chrono::milliseconds(2));
+    EXPECT_EQ(statistics.event_types[1].dispatches, 0);
+    
+    // The slow handler is reported first
+    ASSERT_EQ(statistics.handlers.size(), 3);
+    EXPECT_EQ(statistics.handlers[0].subscription_id, slow.id());
+    EXPECT_EQ(statistics.handlers[0].calls, 3);
+    EXPECT_GE(statistics.handlers[0].latency.p50, std::chrono::milliseconds(2));
+    
+    EXPECT_NE(statistics.to_string().find("StatsTestEvent"), std::string::npos);
+    
+    dispatcher_->reset_statistics();
+    statistics = dispatcher_->get_statistics();
+    EXPECT_EQ(statistics.event_types[0].dispatches, 0);
+    EXPECT_EQ(statistics.handlers[0].calls, 0);
+}
+
+TEST_F(DispatchStatisticsTest, CountersSurviveClearingSubscriptions) {
+    dispatcher_->subscribe<StatsTestEvent>([](const StatsTestEvent&) {});
+    dispatcher_->set_instrumentation_enabled(true);
+    dispatcher_->dispatch(StatsTestEvent{1});
+    
+    dispatcher_->clear_all_subscriptions();
+    dispatcher_->subscribe<StatsTestEvent>([](const StatsTestEvent&) {});
+    dispatcher_->dispatch(StatsTestEvent{2});
+    
+    auto statistics = dispatcher_->get_statistics();
+    ASSERT_EQ(statistics.event_types.size(), 1);
+    EXPECT_EQ(statistics.event_types[0].dispatches, 2);
+    EXPECT_EQ(statistics.handlers.size(), 1);
+}
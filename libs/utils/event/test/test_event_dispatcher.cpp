@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <event_dispatcher.h>
 #include <common_events.h>
+#include <array>
 #include <chrono>
 #include <thread>
 
@@ -311,4 +312,73 @@ TEST(GlobalDispatcherTest, GlobalDispatcherPersistence) {
     
     // Clean up
     global_dispatcher().unsubscribe(handle);
-}
\ No newline at end of file
+}
+
+TEST_F(EventDispatcherTest, LargeAndStatefulHandlers) {
+    // Captures larger than the delegate's inline buffer are stored on the heap
+    std::array<int, 32> weights{};
+    weights[31] = 3;
+    int weighted_sum = 0;
+    dispatcher_->subscribe<TestEvent>([weights, &weighted_sum](const TestEvent& e) {
+        weighted_sum += weights[31] * e.value();
+    });
+    
+    // Mutable lambdas keep their state between dispatches
+    int last_count = 0;
+    dispatcher_->subscribe<TestEvent>([count = 0, &last_count](const TestEvent&) mutable {
+        last_count = ++count;
+    });
+    
+    // Copying the handler list on a new subscription keeps both handlers working
+    dispatcher_->subscribe<AnotherTestEvent>([](const AnotherTestEvent&) {});
+    dispatcher_->subscribe<TestEvent>([](const TestEvent&) {}, Priority::Low);
+    
+    dispatcher_->dispatch(TestEvent{2});
+    dispatcher_->dispatch(TestEvent{5});
+    
+    EXPECT_EQ(weighted_sum, 21);
+    EXPECT_EQ(last_count, 2);
+}
+
+TEST(EventTypeIdTest, DenseAndStable) {
+    auto first = event_type_id<TestEvent>();
+    auto second = event_type_id<AnotherTestEvent>();
+    
+    EXPECT_NE(first, second);
+    EXPECT_EQ(event_type_id<TestEvent>(), first);
+    EXPECT_EQ(event_type_id<AnotherTestEvent>(), second);
+}
+
+
+TEST_F(EventDispatcherTest, ManySubscriptionsKeepPriorityAndOrder) {
+    std::vector<int> order;
+    std::vector<SubscriptionHandle> handles;
+    
+    // Interleaved priorities; equal priorities run in subscription order
+    for (int i = 0; i < 300; ++i) {
+        auto priority = (i % 3 == 0) ? Priority::High : (i % 3 == 1) ? Priority::Normal : Priority::Low;
+        handles.push_back(dispatcher_->subscribe<TestEvent>([&order, i](const TestEvent&) {
+            order.push_back(i);
+        }, priority));
+    }
+    
+    // Remove every other subscription
+    for (size_t i = 0; i < handles.size(); i += 2) {
+        EXPECT_TRUE(dispatcher_->unsubscribe(handles[i]));
+        EXPECT_FALSE(dispatcher_->unsubscribe(handles[i]));
+    }
+    EXPECT_EQ(dispatcher_->subscription_count<TestEvent>(), 150);
+    EXPECT_EQ(dispatcher_->total_subscription_count(), 150);
+    
+    dispatcher_->dispatch(TestEvent{1});
+    
+    std::vector<int> expected;
+    for (int remainder : {0, 1, 2}) {
+        for (int i = 1; i < 300; i += 2) {
+            if (i % 3 == remainder) {
+                expected.push_back(i);
+            }
+        }
+    }
+    EXPECT_EQ(order, expected);
+}
@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+#include <event_dispatcher.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace wip::utils::event;
+
+class QueueTestEvent : public Event {
+public:
+    explicit QueueTestEvent(int value) : value_(value) {}
+    int value() const { return value_; }
+private:
+    int value_;
+};
+
+class ProgressTestEvent : public Event {
+public:
+    explicit ProgressTestEvent(int percent) : percent_(percent) {}
+    int percent() const { return percent_; }
+private:
+    int percent_;
+};
+
+class EventQueueTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dispatcher_ = std::make_unique<EventDispatcher>(16);
+    }
+    
+    void TearDown() override {
+        dispatcher_.reset();
+    }
+    
+    std::unique_ptr<EventDispatcher> dispatcher_;
+};
+
+TEST_F(EventQueueTest, QueuedEventsWaitForProcessing) {
+    std::vector<int> received;
+    dispatcher_->subscribe<QueueTestEvent>([&received](const QueueTestEvent& e) {
+        received.push_back(e.value());
+    });
+    
+    EXPECT_TRUE(dispatcher_->enqueue(QueueTestEvent{1}));
+    EXPECT_TRUE(dispatcher_->enqueue(QueueTestEvent{2}));
+    EXPECT_TRUE(received.empty());
+    EXPECT_EQ(dispatcher_->queued_event_count(), 2);
+    
+    EXPECT_EQ(dispatcher_->process_queue(), 2);
+    EXPECT_EQ(received, (std::vector<int>{1, 2}));
+    EXPECT_EQ(dispatcher_->queued_event_count(), 0);
+}
+
+TEST_F(EventQueueTest, SteadyStateQueueingReusesPooledEvents) {
+    using Pool = BlockPool<sizeof(TypedQueuedEvent<QueueTestEvent>), alignof(TypedQueuedEvent<QueueTestEvent>)>;
+    dispatcher_->subscribe<QueueTestEvent>([](const QueueTestEvent&) {});
+    
+    // The first frame grows the pool to the peak number of queued events
+    for (int i = 0; i < 10; ++i) {
+        dispatcher_->enqueue(QueueTestEvent{i});
+    }
+    dispatcher_->process_queue();
+    size_t capacity = Pool::capacity();
+    EXPECT_GE(capacity, 10u);
+    
+    // Later frames of the same size reuse its blocks
+    for (int frame = 0; frame < 100; ++frame) {
+        for (int i = 0; i < 10; ++i) {
+            dispatcher_->enqueue(QueueTestEvent{i});
+        }
+        EXPECT_EQ(dispatcher_->process_queue(), 10);
+    }
+    EXPECT_EQ(Pool::capacity(), capacity);
+}
+
+TEST_F(EventQueueTest, MaxEventsLimitsBatch) {
+    int received = 0;
+    dispatcher_->subscribe<QueueTestEvent>([&received](const QueueTestEvent&) {
+        received++;
+    });
+    
+    for (int i = 0; i < 5; ++i) {
+        dispatcher_->enqueue(QueueTestEvent{i});
+    }
+    
+    EXPECT_EQ(dispatcher_->process_queue(3), 3);
+    EXPECT_EQ(received, 3);
+    EXPECT_EQ(dispatcher_->process_queue(), 2);
+    EXPECT_EQ(received, 5);
+}
+
+TEST_F(EventQueueTest, TimeBudgetStopsProcessing) {
+    dispatcher_->subscribe<QueueTestEvent>([](const QueueTestEvent&) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    });
+    
+    for (int i = 0; i < 4; ++i) {
+        dispatcher_->enqueue(QueueTestEvent{i});
+    }
+    
+    // The budget is exceeded by the first handler already
+    EXPECT_EQ(dispatcher_->process_queue(std::chrono::milliseconds(1)), 1);
+    EXPECT_EQ(dispatcher_->queued_event_count(), 3);
+}
+
+TEST_F(EventQueueTest, FullQueueRejectsEvents) {
+    for (int i = 0; i < 16; ++i) {
+        EXPECT_TRUE(dispatcher_->enqueue(QueueTestEvent{i}));
+    }
+    EXPECT_FALSE(dispatcher_->enqueue(QueueTestEvent{16}));
+    
+    dispatcher_->process_queue(1);
+    EXPECT_TRUE(dispatcher_->enqueue(QueueTestEvent{17}));
+}
+
+TEST_F(EventQueueTest, CoalescedEventsKeepLatestValue) {
+    std::vector<int> progress;
+    std::vector<int> values;
+    dispatcher_->subscribe<ProgressTestEvent>([&progress](const ProgressTestEvent& e) {
+        progress.push_back(e.percent());
+    });
+    dispatcher_->subscribe<QueueTestEvent>([&values](const QueueTestEvent& e) {
+        values.push_back(e.value());
+    });
+    
+    dispatcher_->enqueue_coalesced(ProgressTestEvent{10});
+    dispatcher_->enqueue(QueueTestEvent{1});
+    dispatcher_->enqueue_coalesced(ProgressTestEvent{50});
+    dispatcher_->enqueue_coalesced(ProgressTestEvent{90});
+    EXPECT_EQ(dispatcher_->queued_event_count(), 2);
+    
+    EXPECT_EQ(dispatcher_->process_queue(), 2);
+    EXPECT_EQ(progress, (std::vector<int>{90}));
+    EXPECT_EQ(values, (std::vector<int>{1}));
+    
+    // Once delivered, the next coalesced event is queued again
+    dispatcher_->enqueue_coalesced(ProgressTestEvent{100});
+    dispatcher_->process_queue();
+    EXPECT_EQ(progress, (std::vector<int>{90, 100}));
+}
+
+TEST_F(EventQueueTest, EventsQueuedByHandlersWaitForNextCall) {
+    int received = 0;
+    dispatcher_->subscribe<QueueTestEvent>([this, &received](const QueueTestEvent& e) {
+        received++;
+        dispatcher_->enqueue(QueueTestEvent{e.value() + 1});
+    });
+    
+    dispatcher_->enqueue(QueueTestEvent{0});
+    EXPECT_EQ(dispatcher_->process_queue(), 1);
+    EXPECT_EQ(received, 1);
+    EXPECT_EQ(dispatcher_->queued_event_count(), 1);
+}
+
+TEST_F(EventQueueTest, ConcurrentProducers) {
+    const int num_producers = 4;
+    const int events_per_producer = 1000;
+    auto dispatcher = std::make_unique<EventDispatcher>(256);
+    
+    std::atomic<int> received{0};
+    std::atomic<long> sum{0};
+    dispatcher->subscribe<QueueTestEvent>([&](const QueueTestEvent& e) {
+        received++;
+        sum += e.value();
+    });
+    
+    std::vector<std::thread> producers;
+    for (int i = 0; i < num_producers; ++i) {
+        producers.emplace_back([&]() {
+            for (int j = 1; j <= events_per_producer; ++j) {
+                while (!dispatcher->enqueue(QueueTestEvent{j})) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    
+    // Single consumer pumps while producers run
+    while (received < num_producers * events_per_producer) {
+        if (dispatcher->process_queue() == 0) {
+            std::this_thread::yield();
+        }
+    }
+    
+    for (auto& t : producers) {
+        t.join();
+    }
+    
+    EXPECT_EQ(received.load(), num_producers * events_per_producer);
+    EXPECT_EQ(sum.load(), static_cast<long>(num_producers) * events_per_producer * (events_per_producer + 1) / 2);
+}
@@ -0,0 +1,211 @@
+#include <gtest/gtest.h>
+#include <event_dispatcher.h>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace wip::utils::event;
+
+class WorkerTestEvent : public Event {
+public:
+    explicit WorkerTestEvent(int value) : value_(value) {}
+    int value() const { return value_; }
+private:
+    int value_;
+};
+
+class ExecutorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dispatcher_ = std::make_unique<EventDispatcher>();
+    }
+    
+    void TearDown() override {
+        dispatcher_.reset();
+    }
+    
+    std::unique_ptr<EventDispatcher> dispatcher_;
+};
+
+TEST_F(ExecutorTest, HandlersRunOnTheOwnerThread) {
+    QueuedExecutor ui_executor;
+    std::vector<int> received;
+    std::vector<std::thread::id> threads;
+    
+    dispatcher_->subscribe_on<WorkerTestEvent>(ui_executor, [&](const WorkerTestEvent& event) {
+        received.push_back(event.value());
+        threads.push_back(std::this_thread::get_id());
+    });
+    
+    std::thread publisher([this]() {
+        for (int i = 0; i < 3; ++i) {
+            dispatcher_->dispatch(WorkerTestEvent(i));
+        }
+    });
+    publisher.join();
+    
+    // Nothing runs until the owner pumps the executor
+    EXPECT_TRUE(received.empty());
+    EXPECT_EQ(ui_executor.pending_count(), 3u);
+    
+    EXPECT_EQ(ui_executor.run_pending(), 3u);
+    EXPECT_EQ(received, (std::vector<int>{0, 1, 2}));
+    for (const auto& id : threads) {
+        EXPECT_EQ(id, std::this_thread::get_id());
+    }
+}
+
+TEST_F(ExecutorTest, TasksPostedByTheBatchWaitForTheNextRun) {
+    QueuedExecutor ui_executor;
+    int runs = 0;
+    
+    dispatcher_->subscribe_on<WorkerTestEvent>(ui_executor, [&](const WorkerTestEvent& event) {
+        ++runs;
+        if (event.value() > 0) {
+            dispatcher_->dispatch(WorkerTestEvent(event.value() - 1));
+        }
+    });
+    
+    dispatcher_->dispatch(WorkerTestEvent(2));
+    
+    EXPECT_EQ(ui_executor.run_pending(), 1u);
+    EXPECT_EQ(ui_executor.run_pending(), 1u);
+    EXPECT_EQ(ui_executor.run_pending(), 1u);
+    EXPECT_EQ(ui_executor.run_pending(), 0u);
+    EXPECT_EQ(runs, 3);
+}
+
+TEST_F(ExecutorTest, UnsubscribeDiscardsWaitingEvents) {
+    QueuedExecutor ui_executor;
+    int calls = 0;
+    
+    auto handle = dispatcher_->subscribe_on<WorkerTestEvent>(ui_executor, [&](const WorkerTestEvent&) {
+        ++calls;
+    });
+    
+    dispatcher_->dispatch(WorkerTestEvent(1));
+    EXPECT_TRUE(dispatcher_->unsubscribe(handle));
+    
+    // The task still runs but finds the subscription gone
+    EXPECT_EQ(ui_executor.run_pending(), 1u);
+    EXPECT_EQ(calls, 0);
+}
+
+TEST_F(ExecutorTest, FiltersRunOnTheDispatchingThread) {
+    QueuedExecutor ui_executor;
+    std::vector<int> received;
+    
+    dispatcher_->subscribe_on<WorkerTestEvent>(ui_executor,
+        [&](const WorkerTestEvent& event) { received.push_back(event.value()); },
+        Priority::Normal,
+        [](const WorkerTestEvent& event) { return event.value() % 2 == 0; });
+    
+    for (int i = 0; i < 4; ++i) {
+        dispatcher_->dispatch(WorkerTestEvent(i));
+    }
+    
+    EXPECT_EQ(ui_executor.pending_count(), 2u);
+    ui_executor.run_pending();
+    EXPECT_EQ(received, (std::vector<int>{0, 2}));
+}
+
+TEST_F(ExecutorTest, ExceptionsAreCountedWhereTheHandlerRuns) {
+    QueuedExecutor ui_executor;
+    
+    dispatcher_->subscribe_on<WorkerTestEvent>(ui_executor, [](const WorkerTestEvent&) {
+        throw std::runtime_error("handler failed");
+    });
+    
+    dispatcher_->dispatch(WorkerTestEvent(1));
+    EXPECT_NO_THROW(ui_executor.run_pending());
+    
+    auto statistics = dispatcher_->get_statistics();
+    ASSERT_EQ(statistics.handlers.size(), 1u);
+    EXPECT_EQ(statistics.handlers[0].exceptions, 1u);
+}
+
+TEST_F(ExecutorTest, WorkerRunsHandlersInOrderOnItsThread) {
+    std::vector<int> received;
+    std::atomic<bool> wrong_thread{false};
+    
+    {
+        WorkerExecutor worker;
+        {
+            auto subscription = dispatcher_->subscribe_scoped_on<WorkerTestEvent>(worker,
+                [&](const WorkerTestEvent& event) {
+                    if (!worker.is_worker_thread()) {
+                        wrong_thread = true;
+                    }
+                    received.push_back(event.value());
+                });
+            
+            for (int i = 0; i < 100; ++i) {
+                dispatcher_->dispatch(WorkerTestEvent(i));
+            }
+            
+            // Wait for the worker before the subscription is dropped
+            std::atomic<bool> drained{false};
+            worker.post([&]() { drained = true; });
+            while (!drained) {
+                std::this_thread::yield();
+            }
+        }
+        EXPECT_EQ(dispatcher_->subscription_count<WorkerTestEvent>(), 0u);
+    }
+    
+    EXPECT_FALSE(wrong_thread);
+    ASSERT_EQ(received.size(), 100u);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(received[i], i);
+    }
+}
+
+TEST_F(ExecutorTest, WorkerRunsRemainingTasksOnDestruction) {
+    std::atomic<int> runs{0};
+    
+    {
+        WorkerExecutor worker;
+        for (int i = 0; i < 10; ++i) {
+            worker.post([&]() { ++runs; });
+        }
+    }
+    
+    EXPECT_EQ(runs.load(), 10);
+}
+
+TEST_F(ExecutorTest, InlineExecutorRunsImmediately) {
+    int calls = 0;
+    
+    dispatcher_->subscribe_on<WorkerTestEvent>(inline_executor(), [&](const WorkerTestEvent&) {
+        ++calls;
+    });
+    
+    EXPECT_EQ(dispatcher_->dispatch(WorkerTestEvent(1)), 1u);
+    EXPECT_EQ(calls, 1);
+}
+
+TEST_F(ExecutorTest, WakeCallbacksRunOnThePostingThread) {
+    QueuedExecutor ui_executor;
+    std::atomic<int> executor_wakes{0};
+    std::atomic<int> queue_wakes{0};
+    ui_executor.set_wake_callback([&]() { ++executor_wakes; });
+    dispatcher_->set_wake_callback([&]() { ++queue_wakes; });
+    
+    dispatcher_->subscribe_on<WorkerTestEvent>(ui_executor, [](const WorkerTestEvent&) {});
+    
+    std::thread publisher([this]() {
+        dispatcher_->dispatch(WorkerTestEvent(1));
+        dispatcher_->enqueue(WorkerTestEvent(2));
+        dispatcher_->enqueue_coalesced(WorkerTestEvent(3));
+        dispatcher_->enqueue_coalesced(WorkerTestEvent(4));    // Replaces 3, nothing new to wake for
+    });
+    publisher.join();
+    
+    EXPECT_EQ(executor_wakes.load(), 1);
+    EXPECT_EQ(queue_wakes.load(), 2);
+    
+    // Delivering the queued events posts two more tasks
+    dispatcher_->process_queue();
+    EXPECT_EQ(executor_wakes.load(), 3);
+}
@@ -155,7 +155,7 @@ TEST_F(ThreadSafetyTest, AsyncEventDispatch) {
         std::this_thread::sleep_for(std::chrono::microseconds(10));
     });
     
-    std::vector<std::future<size_t>> futures;
+    std::vector<wip::utils::concurrency::Task<size_t>> futures;
     
     // Launch multiple async dispatches
     for (int i = 0; i < num_async_dispatches; ++i) {
@@ -311,4 +311,95 @@ TEST_F(ThreadSafetyTest, ScopedSubscriptionsInMultipleThreads) {
     // In the worst case, all 8 subscriptions could be active when all 80 events are dispatched
     // So maximum possible is 80 * 8 = 640, but due to timing it should be much less
     EXPECT_LE(events_received.load(), events_dispatched_while_active.load() * num_threads);
+}
+
+TEST_F(ThreadSafetyTest, HandlerCanDispatchAndSubscribe) {
+    std::atomic<int> nested_events{0};
+    
+    // A handler that publishes again must not deadlock on the dispatcher
+    dispatcher_->subscribe<CounterEvent>([this, &nested_events](const CounterEvent& e) {
+        if (e.value() > 0) {
+            dispatcher_->dispatch(CounterEvent{e.value() - 1});
+        } else {
+            nested_events++;
+            dispatcher_->subscribe<MessageEvent>([](const MessageEvent&) {});
+        }
+    });
+    
+    dispatcher_->dispatch(CounterEvent{5});
+    
+    EXPECT_EQ(nested_events.load(), 1);
+    EXPECT_EQ(dispatcher_->subscription_count<MessageEvent>(), 1);
+}
+
+TEST_F(ThreadSafetyTest, UnsubscribeDuringDispatch) {
+    std::atomic<int> calls{0};
+    SubscriptionHandle second;
+    
+    // A handler removed by an earlier handler is skipped by the running dispatch
+    dispatcher_->subscribe<CounterEvent>([&](const CounterEvent&) {
+        calls++;
+        dispatcher_->unsubscribe(second);
+    }, Priority::High);
+    second = dispatcher_->subscribe<CounterEvent>([&](const CounterEvent&) {
+        calls++;
+    });
+    
+    EXPECT_EQ(dispatcher_->dispatch(CounterEvent{1}), 1);
+    EXPECT_EQ(dispatcher_->dispatch(CounterEvent{2}), 1);
+    EXPECT_EQ(calls.load(), 2);
+}
+
+TEST_F(ThreadSafetyTest, DispatchWhileSubscribing) {
+    const int num_publishers = 4;
+    const int events_per_publisher = 2000;
+    std::atomic<int> publishers_done{0};
+    std::atomic<int> events_received{0};
+    
+    dispatcher_->subscribe<CounterEvent>([&](const CounterEvent&) {
+        events_received++;
+    });
+    
+    std::vector<std::thread> publishers;
+    for (int i = 0; i < num_publishers; ++i) {
+        publishers.emplace_back([&]() {
+            for (int j = 0; j < events_per_publisher; ++j) {
+                dispatcher_->dispatch(CounterEvent{j});
+            }
+            publishers_done++;
+        });
+    }
+    
+    // Subscriptions come and go while publishers run
+    while (publishers_done < num_publishers) {
+        auto handle = dispatcher_->subscribe<CounterEvent>([](const CounterEvent&) {});
+        dispatcher_->unsubscribe(handle);
+    }
+    
+    for (auto& t : publishers) {
+        t.join();
+    }
+    
+    EXPECT_EQ(events_received.load(), num_publishers * events_per_publisher);
+    EXPECT_EQ(dispatcher_->subscription_count<CounterEvent>(), 1);
+}
+
+
+TEST_F(ThreadSafetyTest, ScopedSubscriptionReleasedByHandler) {
+    // A widget destroying itself from inside a handler must not be called afterwards
+    auto scoped = std::make_unique<ScopedSubscription>();
+    int later_calls = 0;
+    
+    dispatcher_->subscribe<CounterEvent>([&](const CounterEvent&) {
+        scoped.reset();
+    }, Priority::High);
+    *scoped = dispatcher_->subscribe_scoped<CounterEvent>([&](const CounterEvent&) {
+        later_calls++;
+    });
+    
+    dispatcher_->dispatch(CounterEvent{1});
+    dispatcher_->dispatch(CounterEvent{2});
+    
+    EXPECT_EQ(later_calls, 0);
+    EXPECT_EQ(dispatcher_->subscription_count<CounterEvent>(), 1);
 }
\ No newline at end of file
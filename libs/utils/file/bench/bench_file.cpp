@@ -0,0 +1,103 @@
+// Benchmark for reading, walking and writing files.
+//
+// Reads a generated log through read_file, read_lines and a MappedFile line
+// range, counts its lines with std::count and count_lines, lists a generated
+// source tree with list_directory_recursive and with the parallel
+// walk_directory, and writes small files in place and atomically. Reports the time per line, entry or file in nanoseconds.
+// Usage:
+//
+//   bench_wip_utils_file [log-megabytes] [files]
+
+#include "async_file_writer.h"
+#include "benchmark.h"
+#include "directory_walker.h"
+#include "file.h"
+#include "mapped_file.h"
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace file = wip::utils::file;
+
+int main(int argc, char* argv[]) {
+    wip::benchmark::Runner runner("bench_wip_utils_file", argc, argv, "[log-megabytes] [files]");
+    size_t megabytes = runner.argument(0, 64);
+    size_t file_count = runner.argument(1, 20000);
+
+    auto directory = std::filesystem::temp_directory_path() / "bench_wip_utils_file";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory / "tree");
+
+    // A build log with lines of typical compiler output length
+    auto log_path = directory / "build.log";
+    size_t line_count = 0;
+    {
+        std::ofstream log(log_path, std::ios::binary);
+        for (size_t bytes = 0; bytes < megabytes * 1024 * 1024; ++line_count) {
+            std::string line = "src/module_" + std::to_string(line_count % 97) + "/file_" +
+                               std::to_string(line_count % 13) + ".cpp:" + std::to_string(line_count % 2000 + 1) +
+                               ":7: warning: unused variable 'value' [-Wunused-variable]\n";
+            log << line;
+            bytes += line.size();
+        }
+    }
+
+    // A source tree of 97 modules with a few nested directories each
+    for (size_t i = 0; i < file_count; ++i) {
+        auto parent = directory / "tree" / ("module_" + std::to_string(i % 97)) / ("part_" + std::to_string(i % 7));
+        std::filesystem::create_directories(parent);
+        std::ofstream(parent / ("file_" + std::to_string(i) + (i % 3 ? ".cpp" : ".h"))) << "// " << i << "\n";
+    }
+    runner.out() << "Reading " << line_count << " log lines, walking " << file_count << " files" << std::endl;
+
+    runner.measure("read_file", line_count, [&]() { return file::read_file(log_path)->size(); });
+    runner.measure("read_lines", line_count, [&]() { return file::read_lines(log_path)->size(); });
+    runner.measure("MappedFile lines", line_count, [&]() {
+        auto mapped = file::MappedFile::open(log_path);
+        size_t lines = 0;
+        for (std::string_view line : mapped->lines()) {
+            lines += !line.empty();
+        }
+        return lines;
+    });
+    auto mapped_log = file::MappedFile::open(log_path);
+    runner.measure("std::count newlines", line_count, [&]() {
+        return std::count(mapped_log->data(), mapped_log->data() + mapped_log->size(), '\n');
+    });
+    runner.measure("count_lines", line_count, [&]() { return file::count_lines(mapped_log->view()); });
+
+    runner.measure("list_directory_recursive", file_count, [&]() {
+        return file::list_directory_recursive(directory / "tree")->size();
+    });
+    file::WalkOptions options;
+    options.extensions = {".cpp", ".h"};
+    runner.measure("walk_directory", file_count, [&]() {
+        std::atomic<size_t> entries{0};
+        file::walk_directory(directory / "tree", options, [&entries](const std::filesystem::directory_entry&) {
+            entries.fetch_add(1, std::memory_order_relaxed);
+        });
+        return entries.load();
+    });
+
+    const size_t writes = std::min<size_t>(file_count, 2000);
+    const std::string content(4096, 'x');
+    runner.measure("write_file", writes, [&]() {
+        size_t written = 0;
+        for (size_t i = 0; i < writes; ++i) {
+            written += file::write_file(directory / ("plain_" + std::to_string(i)), content);
+        }
+        return written;
+    });
+    runner.measure("write_file_atomic (not durable)", writes, [&]() {
+        size_t written = 0;
+        for (size_t i = 0; i < writes; ++i) {
+            written += file::write_file_atomic(directory / ("atomic_" + std::to_string(i)), content, false);
+        }
+        return written;
+    });
+
+    std::filesystem::remove_all(directory);
+    return runner.finish();
+}
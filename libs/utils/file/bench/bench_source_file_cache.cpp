@@ -0,0 +1,109 @@
+// Benchmark for previewing source lines around issue locations.
+//
+// Generates a source tree and looks up snippets of 13 lines around random
+// locations in it: by reading the file and scanning to the line, as a
+// synchronous preview would, by loading a SourceFile, which is what the
+// cache's worker does, and through a warm SourceFileCache, which is what a
+// preview pays per frame. Reports the time per snippet in nanoseconds.
+// Usage:
+//
+//   bench_wip_utils_file_preview [files] [lines-per-file]
+
+#include "benchmark.h"
+#include "file.h"
+#include "source_file_cache.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace file = wip::utils::file;
+
+namespace {
+
+constexpr size_t CONTEXT_LINES = 6;
+
+struct Location {
+    size_t file;
+    size_t line;
+
+    size_t first() const { return line > CONTEXT_LINES ? line - CONTEXT_LINES : 1; }
+    size_t last() const { return line + CONTEXT_LINES; }
+};
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    wip::benchmark::Runner runner("bench_wip_utils_file_preview", argc, argv, "[files] [lines-per-file]");
+    size_t file_count = runner.argument(0, 200);
+    size_t line_count = runner.argument(1, 3000);
+
+    auto directory = std::filesystem::temp_directory_path() / "bench_wip_utils_file_preview";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    std::vector<file::Path> paths;
+    for (size_t f = 0; f < file_count; ++f) {
+        paths.push_back(directory / ("file_" + std::to_string(f) + ".cpp"));
+        std::ofstream out(paths.back(), std::ios::binary);
+        for (size_t line = 0; line < line_count; ++line) {
+            out << "    int value_" << line << " = compute(" << f << ", " << line << "); // keep it\n";
+        }
+    }
+
+    // Issues jump between files, as when clicking through a sorted results table
+    const size_t lookups = 2000;
+    std::vector<Location> locations;
+    for (size_t i = 0; i < lookups; ++i) {
+        locations.push_back({i * 7919 % file_count, i * 104729 % line_count + 1});
+    }
+    runner.out() << "Previewing " << lookups << " locations in " << file_count << " files of " << line_count
+                 << " lines" << std::endl;
+
+    runner.measure("read_file and scan", lookups, [&]() {
+        size_t bytes = 0;
+        for (const Location& location : locations) {
+            auto content = file::read_file(paths[location.file]);
+            std::string_view text = *content;
+            size_t line = 1;
+            for (std::string_view current : file::lines(text)) {
+                if (line >= location.first() && line <= location.last()) {
+                    bytes += current.size();
+                }
+                ++line;
+            }
+        }
+        return bytes;
+    });
+
+    runner.measure("SourceFile load", lookups, [&]() {
+        size_t bytes = 0;
+        for (const Location& location : locations) {
+            file::SourceFile source(paths[location.file]);
+            for (size_t line = location.first(); line <= location.last(); ++line) {
+                bytes += source.line(line).size();
+            }
+        }
+        return bytes;
+    });
+
+    file::SourceFileCache cache(file_count);
+    for (const auto& path : paths) {
+        cache.prefetch(path);
+    }
+    cache.wait_idle();
+    runner.measure("SourceFileCache hit", lookups, [&]() {
+        size_t bytes = 0;
+        for (const Location& location : locations) {
+            auto source = cache.find(paths[location.file]);
+            for (size_t line = location.first(); line <= location.last(); ++line) {
+                bytes += source->line(line).size();
+            }
+        }
+        return bytes;
+    });
+
+    std::filesystem::remove_all(directory);
+    return runner.finish();
+}
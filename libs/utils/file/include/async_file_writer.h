@@ -0,0 +1,164 @@
+#pragma once
+
+#include "file.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace wip::utils::file {
+
+// ==================== Atomic Writes ====================
+
+/**
+ * @brief Replace a file's content atomically
+ *
+ * The content goes to a temporary file in the same directory, which is then
+ * renamed over the target, so readers and crashes only ever see the old or
+ * the new content, never a truncated file. The replaced file's permissions
+ * are not preserved.
+ *
+ * @param path File to write
+ * @param content New content
+ * @param durable Flush the file and the directory entry to disk before returning
+ * @return true if the new content is in place
+ */
+bool write_file_atomic(const Path& path, std::string_view content, bool durable = true) noexcept;
+
+// ==================== Asynchronous Writes ====================
+
+/**
+ * @brief Produces the content of a write on the I/O thread, e.g. by serializing a report
+ */
+using ContentProducer = std::function<std::string()>;
+
+/**
+ * @brief Writes the content of a write to a stream on the I/O thread, e.g. a report too large to build in memory
+ */
+using StreamProducer = std::function<void(std::ostream& out)>;
+
+/**
+ * @brief Called on the I/O thread when a write has finished
+ */
+using WriteCallback = std::function<void(const Path& path, bool success)>;
+
+/**
+ * @brief Background writer for files that must not block the calling thread
+ *
+ * Writes are queued and done by one I/O thread, in order for each file.
+ * Replacing writes are atomic like write_file_atomic(); appends are written in
+ * place. Content is written as is, without newline translation. Requests for a
+ * file that is still queued are coalesced: a replacing write supersedes the
+ * earlier queued writes of the file and appends are merged into the queued
+ * request, so a file rewritten faster than the disk keeps up is only written
+ * once. Every request still gets its own result.
+ *
+ * Content can be handed over as a string, which is moved and not copied, or
+ * as a ContentProducer that runs on the I/O thread, so that serializing large
+ * data does not block the caller either. A StreamProducer writes straight to
+ * the file through a small buffer instead, so the content never has to exist
+ * in memory as a whole. A producer throwing or failing its stream fails the
+ * write.
+ *
+ * Example:
+ * ```cpp
+ * AsyncFileWriter writer;
+ * auto done = writer.write("report.json", [report]() { return report.dump(); });
+ * // ... later
+ * bool saved = done.get();
+ * ```
+ */
+class AsyncFileWriter {
+public:
+    /**
+     * @brief Start the I/O thread
+     * @param durable Flush every write to disk before reporting it finished
+     */
+    explicit AsyncFileWriter(bool durable = true);
+
+    /**
+     * @brief Finish every queued write and stop the I/O thread
+     */
+    ~AsyncFileWriter();
+
+    AsyncFileWriter(const AsyncFileWriter&) = delete;
+    AsyncFileWriter& operator=(const AsyncFileWriter&) = delete;
+
+    /**
+     * @brief Replace a file's content
+     * @param path File to write
+     * @param content New content
+     * @param on_done Optional callback run on the I/O thread when the write has finished
+     * @return Becomes true once the content is in place (and on disk if durable)
+     */
+    std::future<bool> write(Path path, std::string content, WriteCallback on_done = {});
+
+    /**
+     * @brief Replace a file's content produced on the I/O thread
+     */
+    std::future<bool> write(Path path, ContentProducer producer, WriteCallback on_done = {});
+
+    /**
+     * @brief Replace a file's content streamed on the I/O thread
+     */
+    std::future<bool> write_stream(Path path, StreamProducer producer, WriteCallback on_done = {});
+
+    /**
+     * @brief Append to a file, creating it if needed
+     */
+    std::future<bool> append(Path path, std::string content, WriteCallback on_done = {});
+
+    /**
+     * @brief Block until every write queued so far has finished
+     */
+    void flush();
+
+    /**
+     * @brief Number of queued or running requests, after coalescing
+     */
+    size_t pending() const;
+
+private:
+    // Content is kept in pieces so merged appends are never concatenated in memory
+    struct Piece {
+        std::string text;
+        ContentProducer producer;
+        StreamProducer stream;
+    };
+
+    struct Waiter {
+        std::promise<bool> promise;
+        WriteCallback on_done;
+    };
+
+    struct Request {
+        Path path;
+        bool replace = false;
+        std::vector<Piece> pieces;
+        std::vector<Waiter> waiters;
+    };
+
+    std::future<bool> submit(Path path, bool replace, Piece piece, WriteCallback on_done);
+    void run();
+    bool perform(Request& request) const;
+
+    const bool durable_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable work_available_;
+    std::condition_variable work_done_;
+    std::deque<Request> queue_;
+    bool busy_ = false;       // The I/O thread is performing a request taken from the queue
+    bool stopping_ = false;
+    std::thread thread_;
+};
+
+}  // namespace wip::utils::file
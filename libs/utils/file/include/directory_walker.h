@@ -0,0 +1,83 @@
+#pragma once
+
+#include "file.h"
+
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace wip::utils::file {
+
+// ==================== Glob Matching ====================
+
+/**
+ * @brief Match a file name against a glob pattern
+ *
+ * Supports '*' (any run of characters), '?' (any one character) and bracket
+ * expressions such as "[abc]", "[a-z]" and "[!0-9]". Runs in linear time for
+ * patterns with a single '*' and never allocates.
+ *
+ * @param pattern Glob pattern
+ * @param name Name to match (a file name, not a path)
+ * @param case_insensitive Compare ASCII letters without regard to case
+ * @return true if the whole name matches the pattern
+ */
+bool matches_glob(std::string_view pattern, std::string_view name, bool case_insensitive = false) noexcept;
+
+// ==================== Directory Walking ====================
+
+/**
+ * @brief Options of walk_directory()
+ *
+ * Filters only apply to reported files; directories are descended into
+ * unless they are pruned.
+ */
+struct WalkOptions {
+    std::vector<std::string> extensions;          ///< Reported file extensions including the dot (e.g. ".cpp"); empty reports all
+    std::vector<std::string> patterns;            ///< Glob patterns a reported file name must match one of; empty reports all
+    std::vector<std::string> prune_directories;   ///< Glob patterns of directory names not descended into (e.g. "build", ".*")
+    bool case_insensitive = false;                ///< Match extensions and patterns without regard to ASCII case
+    bool recursive = true;                        ///< Descend into subdirectories
+    bool include_directories = false;             ///< Also report the directories that are descended into
+    size_t max_threads = 0;                       ///< Walker threads including the caller; 0 uses the hardware concurrency
+};
+
+/**
+ * @brief Check whether a file name passes the extension and pattern filters of WalkOptions
+ */
+bool matches_file_filters(std::string_view name, const WalkOptions& options) noexcept;
+
+/**
+ * @brief Check whether a directory name matches one of the prune patterns of WalkOptions
+ */
+bool matches_prune_patterns(std::string_view name, const WalkOptions& options) noexcept;
+
+/**
+ * @brief Callback receiving each reported entry
+ *
+ * Called from the walker's threads, possibly concurrently, so it must be
+ * thread-safe. Entries arrive in no particular order.
+ */
+using WalkCallback = std::function<void(const std::filesystem::directory_entry& entry)>;
+
+/**
+ * @brief Walk a directory tree in parallel, streaming matching entries to a callback
+ *
+ * Every thread scans one directory at a time and keeps the subdirectories it
+ * finds in its own queue, going depth first; idle threads steal the oldest,
+ * usually largest, subtrees from the others. The calling thread takes part in
+ * the walk and the call returns when the whole tree has been scanned.
+ * Symbolic links to directories are not followed and unreadable
+ * subdirectories are skipped. If the callback throws, the walk stops and the
+ * exception is rethrown to the caller.
+ *
+ * @param root Directory to walk
+ * @param options Filters, pruning and parallelism
+ * @param callback Receives every reported entry
+ * @return Number of reported entries, or nullopt if root cannot be read
+ */
+Result<size_t> walk_directory(const Path& root, const WalkOptions& options, const WalkCallback& callback);
+
+}  // namespace wip::utils::file
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "directory_walker.h"
+#include "file.h"
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace wip::utils::file {
+
+// ==================== File Watching ====================
+
+/**
+ * @brief Kind of change reported for a file
+ */
+enum class FileChangeType {
+    Created,
+    Modified,
+    Removed
+};
+
+/**
+ * @brief One changed file of a change batch
+ */
+struct FileChange {
+    Path path;
+    FileChangeType type;
+};
+
+/**
+ * @brief Callback receiving batches of coalesced changes
+ *
+ * Called from the watcher's thread; a batch lists every file at most once,
+ * sorted by path.
+ */
+using FileChangeCallback = std::function<void(const std::vector<FileChange>& changes)>;
+
+/**
+ * @brief Options of FileWatcher
+ *
+ * The filter selects the reported files and the directories not watched with
+ * the same rules as walk_directory(); its recursive, include_directories and
+ * max_threads fields are ignored.
+ */
+struct FileWatcherOptions {
+    WalkOptions filter;                             ///< Extensions, patterns and pruned directories
+    std::chrono::milliseconds debounce{100};        ///< Quiet time after the last change before a batch is delivered
+    std::chrono::milliseconds max_delay{1000};      ///< Longest time a change waits while further changes keep arriving
+    std::chrono::milliseconds poll_interval{500};   ///< Rescan interval of the polling backend
+    bool force_polling = false;                     ///< Poll even where native notifications exist (e.g. network drives)
+};
+
+/**
+ * @brief Recursive watcher of directory trees delivering debounced change batches
+ *
+ * Uses inotify on Linux and ReadDirectoryChangesW on Windows; elsewhere the
+ * watched trees are rescanned every poll_interval. Changes are collected on a
+ * background thread and coalesced per file, so an editor's burst of writes,
+ * renames and truncations on save arrives as a single change: a file created
+ * and then modified is reported as created, one created and removed again is
+ * not reported, and one removed and recreated is reported as modified. A
+ * batch is delivered once no change arrived for the debounce time, or at the
+ * latest max_delay after its first change.
+ *
+ * Directories created inside a watched tree are watched as they appear and
+ * their files reported as created. Symbolic links to directories are not
+ * followed.
+ *
+ * Example:
+ * ```cpp
+ * FileWatcherOptions options;
+ * options.filter.extensions = {".cpp", ".h"};
+ * options.filter.prune_directories = {".*", "build"};
+ * FileWatcher watcher([](const std::vector<FileChange>& changes) {
+ *     // ...
+ * }, options);
+ * watcher.watch("src");
+ * ```
+ */
+class FileWatcher {
+public:
+    /**
+     * @brief Start the watcher thread
+     * @param callback Receives the change batches
+     * @param options Filters and timing
+     */
+    explicit FileWatcher(FileChangeCallback callback, FileWatcherOptions options = {});
+
+    /**
+     * @brief Stop watching; pending changes are discarded
+     */
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    /**
+     * @brief Watch a directory tree
+     *
+     * Can be called at any time and from any thread, including the callback.
+     * Returns once the tree is being watched, so later changes are reported.
+     *
+     * @param directory Root of the tree to watch
+     * @return true if the directory exists and the watcher is running
+     */
+    bool watch(const Path& directory);
+
+    /**
+     * @brief Stop the watcher thread; no callback runs after this returns
+     *
+     * Must not be called from the callback.
+     */
+    void stop();
+
+    bool is_running() const noexcept;
+
+    /**
+     * @brief Name of the notification mechanism in use ("inotify", "ReadDirectoryChangesW" or "polling")
+     */
+    const char* backend_name() const noexcept;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace wip::utils::file
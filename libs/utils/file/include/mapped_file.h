@@ -0,0 +1,186 @@
+#pragma once
+
+#include "file.h"
+
+#include <cstddef>
+#include <iterator>
+#include <string_view>
+
+namespace wip::utils::file {
+
+// ==================== Line Iteration ====================
+
+/**
+ * @brief Forward iterator over the lines of a text, without copying them
+ *
+ * Lines are split like std::getline: the '\n' is not part of the line and a
+ * final newline does not start an empty line. Each line is a view into the
+ * iterated text.
+ */
+class LineIterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::string_view;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const std::string_view*;
+    using reference = const std::string_view&;
+
+    LineIterator() noexcept = default;
+
+    /**
+     * @brief Create an iterator at the first line of a text
+     * @param text Text to iterate (must outlive the iterator)
+     */
+    explicit LineIterator(std::string_view text) noexcept : rest_(text), at_end_(text.empty()) {
+        advance();
+    }
+
+    reference operator*() const noexcept { return line_; }
+    pointer operator->() const noexcept { return &line_; }
+
+    LineIterator& operator++() noexcept {
+        at_end_ = rest_.empty();
+        advance();
+        return *this;
+    }
+
+    LineIterator operator++(int) noexcept {
+        LineIterator previous = *this;
+        ++*this;
+        return previous;
+    }
+
+    bool operator==(const LineIterator& other) const noexcept {
+        if (at_end_ || other.at_end_) {
+            return at_end_ == other.at_end_;
+        }
+        return line_.data() == other.line_.data();
+    }
+
+    bool operator!=(const LineIterator& other) const noexcept { return !(*this == other); }
+
+private:
+    void advance() noexcept {
+        if (at_end_) {
+            line_ = {};
+            return;
+        }
+        size_t newline = rest_.find('\n');
+        if (newline == std::string_view::npos) {
+            line_ = rest_;
+            rest_ = {};
+        } else {
+            line_ = rest_.substr(0, newline);
+            rest_ = rest_.substr(newline + 1);
+        }
+    }
+
+    std::string_view rest_;
+    std::string_view line_;
+    bool at_end_ = true;
+};
+
+/**
+ * @brief Range of the lines of a text, for range-based for loops
+ */
+class LineRange {
+public:
+    explicit LineRange(std::string_view text) noexcept : text_(text) {}
+
+    LineIterator begin() const noexcept { return LineIterator(text_); }
+    LineIterator end() const noexcept { return LineIterator(); }
+
+private:
+    std::string_view text_;
+};
+
+/**
+ * @brief Iterate the lines of a text without allocating
+ * @param text Text to split (must outlive the range)
+ * @return Range of line views
+ */
+inline LineRange lines(std::string_view text) noexcept {
+    return LineRange(text);
+}
+
+/**
+ * @brief Count the lines of a text without iterating them
+ *
+ * Counts the same lines lines() yields: every '\n', plus a final line that
+ * does not end in one. Compares 32 bytes at a time with AVX2 where the CPU
+ * has it, 16 with SSE2 or NEON otherwise.
+ *
+ * @param text Text to count
+ * @return Number of lines
+ */
+size_t count_lines(std::string_view text) noexcept;
+
+// ==================== Memory-Mapped Files ====================
+
+/**
+ * @brief Read-only memory mapping of a whole file
+ *
+ * The file's content is available as a std::string_view without reading it
+ * into a buffer; pages are loaded by the OS as they are touched. Uses mmap on
+ * POSIX systems and CreateFileMapping on Windows. Empty files are opened
+ * without a mapping and have an empty view, as do files whose size the file
+ * system does not report (such as those in /proc); use read_file() for them.
+ * Unlike read_file(), no newline translation is done on Windows.
+ *
+ * The view stays valid until the MappedFile is closed or destroyed. Another
+ * process truncating the file while it is mapped makes reading the lost part
+ * fault, so only map files that are not rewritten in place.
+ *
+ * Example:
+ * ```cpp
+ * if (auto file = MappedFile::open("report.xml")) {
+ *     for (std::string_view line : file->lines()) {
+ *         // ...
+ *     }
+ * }
+ * ```
+ */
+class MappedFile {
+public:
+    MappedFile() noexcept = default;
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Map a file for reading
+     * @param path File to map
+     * @return Mapped file or nullopt if the file cannot be opened or mapped
+     */
+    static Result<MappedFile> open(const Path& path) noexcept;
+
+    /**
+     * @brief Unmap the file; the view becomes empty
+     */
+    void close() noexcept;
+
+    bool is_open() const noexcept { return open_; }
+    const char* data() const noexcept { return data_; }
+    size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    /**
+     * @brief Get the file's content
+     */
+    std::string_view view() const noexcept { return std::string_view(data_, size_); }
+
+    /**
+     * @brief Iterate the file's lines without copying them
+     */
+    LineRange lines() const noexcept { return LineRange(view()); }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    bool open_ = false;
+};
+
+}  // namespace wip::utils::file
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "mapped_file.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace wip::utils::file {
+
+// ==================== Source Files ====================
+
+/**
+ * @brief Memory-mapped text file with a table of its line offsets
+ *
+ * Lines are numbered from 1 and returned without their '\n' or a trailing
+ * '\r'. A file that could not be mapped is kept as well, with no lines, so
+ * that it is not tried again on every lookup.
+ */
+class SourceFile {
+public:
+    /**
+     * @brief Map a file and index its lines
+     * @param path File to load
+     */
+    explicit SourceFile(Path path);
+
+    const Path& path() const noexcept { return path_; }
+    bool is_open() const noexcept { return file_.is_open(); }
+    std::string_view content() const noexcept { return file_.view(); }
+
+    /**
+     * @brief Get number of lines, counted like lines()
+     */
+    size_t line_count() const noexcept { return line_starts_.size(); }
+
+    /**
+     * @brief Get a line of the file
+     * @param number Line number, starting at 1
+     * @return View of the line; empty when the file has no such line
+     */
+    std::string_view line(size_t number) const noexcept;
+
+private:
+    Path path_;
+    MappedFile file_;
+    std::vector<size_t> line_starts_;
+};
+
+// ==================== Source File Cache ====================
+
+/**
+ * @brief Bounded cache of source files loaded on a background thread
+ *
+ * Meant for previews that must never wait for the disk: find() only looks
+ * into the cache and queues a missing file, and a worker thread maps it and
+ * builds its line table. The caller asks again on a later frame. Files likely
+ * to be wanted next are loaded ahead with prefetch(), behind the files asked
+ * for with find().
+ *
+ * The cache holds up to `capacity` files and drops the least recently found
+ * one when full. Files are shared, so a file in use stays mapped after the
+ * cache dropped it. Files are mapped, so a file rewritten in place while
+ * cached must be dropped with invalidate() or clear() before it shrinks.
+ *
+ * Example:
+ * ```cpp
+ * SourceFileCache cache;
+ * // Every frame
+ * if (auto file = cache.find(issue.file_path)) {
+ *     draw_line(file->line(issue.line_number));
+ * }
+ * ```
+ */
+class SourceFileCache {
+public:
+    /**
+     * @brief Start the loading thread
+     * @param capacity Number of files to keep
+     */
+    explicit SourceFileCache(size_t capacity = 64);
+
+    /**
+     * @brief Drop queued loads and stop the loading thread
+     */
+    ~SourceFileCache();
+
+    SourceFileCache(const SourceFileCache&) = delete;
+    SourceFileCache& operator=(const SourceFileCache&) = delete;
+
+    /**
+     * @brief Get a loaded file without waiting for it
+     * @param path File to look up
+     * @return The file, or nullptr if it is not loaded yet; it is then loaded before any prefetch
+     */
+    std::shared_ptr<const SourceFile> find(const Path& path);
+
+    /**
+     * @brief Load a file in the background unless it is cached or queued
+     * @param path File that is likely to be looked up soon
+     */
+    void prefetch(const Path& path);
+
+    /**
+     * @brief Drop a file so that it is loaded again on its next lookup
+     */
+    void invalidate(const Path& path);
+
+    /**
+     * @brief Drop every file and every queued load
+     */
+    void clear();
+
+    /**
+     * @brief Block until every load queued so far has finished
+     */
+    void wait_idle();
+
+    /**
+     * @brief Get number of cached files
+     */
+    size_t size() const;
+
+    size_t capacity() const noexcept { return capacity_; }
+
+private:
+    using Entry = std::pair<std::string, std::shared_ptr<const SourceFile>>;
+
+    void enqueue(const std::string& key, bool urgent);
+    void run();
+
+    const size_t capacity_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable work_available_;
+    std::condition_variable work_done_;
+    std::list<Entry> files_;                                                 // Most recently found first
+    std::unordered_map<std::string, std::list<Entry>::iterator> index_;      // Keys of files_
+    std::deque<std::string> queue_;                                          // Files asked for first, prefetches last
+    std::unordered_set<std::string> queued_;                                 // Keys of queue_
+    std::string loading_;                                                    // File being loaded while busy_
+    bool busy_ = false;
+    uint64_t generation_ = 0;                                                // Bumped by clear() and invalidate()
+    bool stopping_ = false;
+    std::thread thread_;
+};
+
+}  // namespace wip::utils::file
@@ -0,0 +1,341 @@
+#include "async_file_writer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <ostream>
+#include <streambuf>
+#include <system_error>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace wip::utils::file {
+
+namespace {
+
+// Largest single write; some systems reject larger requests
+constexpr size_t MAX_WRITE_SIZE = size_t(1) << 30;
+
+/**
+ * @brief Unbuffered output file with explicit flushing to disk
+ */
+class OutputFile {
+public:
+    OutputFile() = default;
+    ~OutputFile() { close(); }
+
+    OutputFile(const OutputFile&) = delete;
+    OutputFile& operator=(const OutputFile&) = delete;
+
+#ifdef _WIN32
+    bool open(const Path& path, bool append) noexcept {
+        handle_ = CreateFileW(path.c_str(), append ? FILE_APPEND_DATA : GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                              append ? OPEN_ALWAYS : CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        return handle_ != INVALID_HANDLE_VALUE;
+    }
+
+    bool write(std::string_view data) noexcept {
+        while (!data.empty()) {
+            DWORD written = 0;
+            DWORD chunk = static_cast<DWORD>(std::min(data.size(), MAX_WRITE_SIZE));
+            if (!WriteFile(handle_, data.data(), chunk, &written, nullptr)) {
+                return false;
+            }
+            data.remove_prefix(written);
+        }
+        return true;
+    }
+
+    bool sync() noexcept { return FlushFileBuffers(handle_) != 0; }
+
+    bool close() noexcept {
+        if (handle_ == INVALID_HANDLE_VALUE) {
+            return true;
+        }
+        bool closed = CloseHandle(handle_) != 0;
+        handle_ = INVALID_HANDLE_VALUE;
+        return closed;
+    }
+
+private:
+    HANDLE handle_ = INVALID_HANDLE_VALUE;
+#else
+    bool open(const Path& path, bool append) noexcept {
+        fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC | (append ? O_APPEND : O_TRUNC), 0666);
+        return fd_ >= 0;
+    }
+
+    bool write(std::string_view data) noexcept {
+        while (!data.empty()) {
+            ssize_t written = ::write(fd_, data.data(), std::min(data.size(), MAX_WRITE_SIZE));
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            data.remove_prefix(static_cast<size_t>(written));
+        }
+        return true;
+    }
+
+    bool sync() noexcept { return ::fsync(fd_) == 0; }
+
+    bool close() noexcept {
+        if (fd_ < 0) {
+            return true;
+        }
+        bool closed = ::close(fd_) == 0;
+        fd_ = -1;
+        return closed;
+    }
+
+private:
+    int fd_ = -1;
+#endif
+};
+
+/**
+ * @brief Stream buffer writing to an OutputFile in fixed-size blocks
+ */
+class OutputFileBuffer : public std::streambuf {
+public:
+    explicit OutputFileBuffer(OutputFile& file) : file_(file), buffer_(BLOCK_SIZE) {
+        setp(buffer_.data(), buffer_.data() + buffer_.size());
+    }
+
+protected:
+    int_type overflow(int_type c) override {
+        if (sync() != 0) {
+            return traits_type::eof();
+        }
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(c);
+            pbump(1);
+        }
+        return traits_type::not_eof(c);
+    }
+
+    int sync() override {
+        const auto size = static_cast<size_t>(pptr() - pbase());
+        if (size > 0 && !file_.write(std::string_view(pbase(), size))) {
+            return -1;
+        }
+        setp(buffer_.data(), buffer_.data() + buffer_.size());
+        return 0;
+    }
+
+private:
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+    OutputFile& file_;
+    std::vector<char> buffer_;
+};
+
+Path temporary_path(const Path& path) {
+    static std::atomic<uint64_t> counter{0};
+    auto unique = std::chrono::steady_clock::now().time_since_epoch().count();
+    Path temp = path;
+    temp += ".tmp" + std::to_string(unique) + "-" + std::to_string(counter.fetch_add(1));
+    return temp;
+}
+
+// Move the temporary file over the target; durable also persists the directory entry
+bool commit(const Path& temp, const Path& path, bool durable) noexcept {
+#ifdef _WIN32
+    DWORD flags = MOVEFILE_REPLACE_EXISTING | (durable ? MOVEFILE_WRITE_THROUGH : 0);
+    return MoveFileExW(temp.c_str(), path.c_str(), flags) != 0;
+#else
+    if (::rename(temp.c_str(), path.c_str()) != 0) {
+        return false;
+    }
+    if (durable) {
+        Path directory = path.parent_path();
+        int fd = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd >= 0) {
+            ::fsync(fd);
+            ::close(fd);
+        }
+    }
+    return true;
+#endif
+}
+
+/**
+ * @brief Write a file through write_content, atomically when replacing it
+ *
+ * write_content may throw; the write then fails and the target is left as it was.
+ */
+template <typename ContentWriter>
+bool write_with(const Path& path, bool replace, bool durable, ContentWriter&& write_content) noexcept {
+    Path target = replace ? temporary_path(path) : path;
+
+    OutputFile file;
+    bool success = file.open(target, !replace);
+    if (success) {
+        try {
+            success = write_content(file);
+        } catch (...) {
+            success = false;
+        }
+        success = success && (!durable || file.sync());
+    }
+    success = file.close() && success;
+
+    if (!replace) {
+        return success;
+    }
+    if (success && commit(target, path, durable)) {
+        return true;
+    }
+    std::error_code ec;
+    std::filesystem::remove(target, ec);
+    return false;
+}
+
+} // namespace
+
+bool write_file_atomic(const Path& path, std::string_view content, bool durable) noexcept {
+    return write_with(path, true, durable, [content](OutputFile& file) { return file.write(content); });
+}
+
+// ==================== AsyncFileWriter ====================
+
+AsyncFileWriter::AsyncFileWriter(bool durable) : durable_(durable) {
+    thread_ = std::thread([this]() { run(); });
+}
+
+AsyncFileWriter::~AsyncFileWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    work_available_.notify_one();
+    thread_.join();
+}
+
+std::future<bool> AsyncFileWriter::write(Path path, std::string content, WriteCallback on_done) {
+    return submit(std::move(path), true, Piece{std::move(content), {}, {}}, std::move(on_done));
+}
+
+std::future<bool> AsyncFileWriter::write(Path path, ContentProducer producer, WriteCallback on_done) {
+    return submit(std::move(path), true, Piece{{}, std::move(producer), {}}, std::move(on_done));
+}
+
+std::future<bool> AsyncFileWriter::write_stream(Path path, StreamProducer producer, WriteCallback on_done) {
+    return submit(std::move(path), true, Piece{{}, {}, std::move(producer)}, std::move(on_done));
+}
+
+std::future<bool> AsyncFileWriter::append(Path path, std::string content, WriteCallback on_done) {
+    return submit(std::move(path), false, Piece{std::move(content), {}, {}}, std::move(on_done));
+}
+
+void AsyncFileWriter::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    work_done_.wait(lock, [this]() { return queue_.empty() && !busy_; });
+}
+
+size_t AsyncFileWriter::pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.size() + (busy_ ? 1 : 0);
+}
+
+std::future<bool> AsyncFileWriter::submit(Path path, bool replace, Piece piece, WriteCallback on_done) {
+    Waiter waiter{std::promise<bool>(), std::move(on_done)};
+    std::future<bool> result = waiter.promise.get_future();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        // At most one request per file is queued, so it is the one to coalesce with
+        auto queued = std::find_if(queue_.begin(), queue_.end(),
+                                   [&path](const Request& request) { return request.path == path; });
+        if (queued != queue_.end()) {
+            if (replace) {
+                queued->replace = true;
+                queued->pieces.clear();
+            }
+            queued->pieces.push_back(std::move(piece));
+            queued->waiters.push_back(std::move(waiter));
+        } else {
+            Request request;
+            request.path = std::move(path);
+            request.replace = replace;
+            request.pieces.push_back(std::move(piece));
+            request.waiters.push_back(std::move(waiter));
+            queue_.push_back(std::move(request));
+        }
+    }
+
+    work_available_.notify_one();
+    return result;
+}
+
+void AsyncFileWriter::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        work_available_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+        if (queue_.empty()) {
+            return;   // Stopping with every write done
+        }
+
+        Request request = std::move(queue_.front());
+        queue_.pop_front();
+        busy_ = true;
+        lock.unlock();
+
+        bool success = perform(request);
+        for (auto& waiter : request.waiters) {
+            if (waiter.on_done) {
+                try {
+                    waiter.on_done(request.path, success);
+                } catch (...) {
+                    // A throwing callback must not end the I/O thread
+                }
+            }
+            waiter.promise.set_value(success);
+        }
+
+        lock.lock();
+        busy_ = false;
+        work_done_.notify_all();
+    }
+}
+
+bool AsyncFileWriter::perform(Request& request) const {
+    return write_with(request.path, request.replace, durable_, [&request](OutputFile& file) {
+        for (auto& piece : request.pieces) {
+            if (piece.stream) {
+                OutputFileBuffer buffer(file);
+                std::ostream out(&buffer);
+                piece.stream(out);
+                if (!out.flush()) {
+                    return false;
+                }
+                continue;
+            }
+            if (piece.producer) {
+                piece.text = piece.producer();
+            }
+            if (!file.write(piece.text)) {
+                return false;
+            }
+            std::string().swap(piece.text);   // Release each piece as soon as it is on its way
+        }
+        return true;
+    });
+}
+
+}  // namespace wip::utils::file
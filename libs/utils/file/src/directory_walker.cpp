@@ -0,0 +1,356 @@
+#include "directory_walker.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
+namespace wip::utils::file {
+
+namespace {
+
+constexpr size_t NO_MATCH = std::string_view::npos;
+
+char fold_case(char c, bool case_insensitive) noexcept {
+    return case_insensitive && c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+bool equals(std::string_view a, std::string_view b, bool case_insensitive) noexcept {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (fold_case(a[i], case_insensitive) != fold_case(b[i], case_insensitive)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Match c (already case folded) against the bracket expression starting at pattern[start]
+// Returns the position after the closing ']', or NO_MATCH if the bracket is not closed
+size_t match_bracket(std::string_view pattern, size_t start, char c, bool case_insensitive, bool& matched) noexcept {
+    size_t i = start + 1;
+    bool negate = false;
+    if (i < pattern.size() && (pattern[i] == '!' || pattern[i] == '^')) {
+        negate = true;
+        ++i;
+    }
+
+    // A ']' right after the opening bracket is a literal
+    bool found = false;
+    bool first = true;
+    while (i < pattern.size() && (first || pattern[i] != ']')) {
+        first = false;
+        char low = fold_case(pattern[i], case_insensitive);
+        if (i + 2 < pattern.size() && pattern[i + 1] == '-' && pattern[i + 2] != ']') {
+            char high = fold_case(pattern[i + 2], case_insensitive);
+            found = found || (low <= c && c <= high);
+            i += 3;
+        } else {
+            found = found || low == c;
+            ++i;
+        }
+    }
+
+    if (i >= pattern.size()) {
+        return NO_MATCH;
+    }
+    matched = found != negate;
+    return i + 1;
+}
+
+// Name of the last path component without building a new path where the native format allows
+std::string_view file_name(const Path& path, [[maybe_unused]] std::string& storage) {
+#ifdef _WIN32
+    storage = path.filename().string();
+    return storage;
+#else
+    std::string_view native = path.native();
+    size_t separator = native.find_last_of('/');
+    return separator == std::string_view::npos ? native : native.substr(separator + 1);
+#endif
+}
+
+std::string_view extension_of(std::string_view name) noexcept {
+    // Like std::filesystem::path::extension(), a leading dot starts no extension
+    size_t dot = name.rfind('.');
+    return dot == std::string_view::npos || dot == 0 ? std::string_view() : name.substr(dot);
+}
+
+bool matches_any(const std::vector<std::string>& patterns, std::string_view name, bool case_insensitive) noexcept {
+    for (const auto& pattern : patterns) {
+        if (matches_glob(pattern, name, case_insensitive)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Work-stealing walk of one directory tree
+ *
+ * Each worker owns a queue of directories still to be scanned. Workers push
+ * the subdirectories they find onto the back of their own queue and take
+ * work from the back as well, so a worker goes depth first through its
+ * subtree; idle workers steal from the front of other queues, where the
+ * directories closest to the root are.
+ */
+class ParallelWalk {
+public:
+    ParallelWalk(const WalkOptions& options, const WalkCallback& callback, size_t worker_count)
+        : options_(options), callback_(callback), worker_count_(worker_count),
+          queues_(std::make_unique<WorkQueue[]>(worker_count)) {}
+
+    size_t run(const Path& root) {
+        push(0, root);
+
+        std::vector<std::thread> threads;
+        for (size_t worker = 1; worker < worker_count_; ++worker) {
+            try {
+                threads.emplace_back([this, worker]() { work(worker); });
+            } catch (const std::system_error&) {
+                break; // The threads already running share the walk
+            }
+        }
+        work(0);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+        return reported_.load();
+    }
+
+private:
+    struct alignas(64) WorkQueue {
+        std::mutex mutex;
+        std::deque<Path> directories;
+    };
+
+    void push(size_t worker, Path directory) {
+        pending_.fetch_add(1);
+        {
+            std::lock_guard<std::mutex> lock(queues_[worker].mutex);
+            queues_[worker].directories.push_back(std::move(directory));
+        }
+        queued_.fetch_add(1);
+
+        // Idle workers register before checking queued_, so none can miss this push
+        if (idle_workers_.load() > 0) {
+            std::lock_guard<std::mutex> lock(idle_mutex_);
+            idle_.notify_one();
+        }
+    }
+
+    bool pop(size_t worker, Path& directory) {
+        WorkQueue& queue = queues_[worker];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.directories.empty()) {
+            return false;
+        }
+        directory = std::move(queue.directories.back());
+        queue.directories.pop_back();
+        queued_.fetch_sub(1);
+        return true;
+    }
+
+    bool steal(size_t worker, Path& directory) {
+        for (size_t offset = 1; offset < worker_count_; ++offset) {
+            WorkQueue& queue = queues_[(worker + offset) % worker_count_];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.directories.empty()) {
+                directory = std::move(queue.directories.front());
+                queue.directories.pop_front();
+                queued_.fetch_sub(1);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void work(size_t worker) {
+        Path directory;
+        while (true) {
+            if (pop(worker, directory) || steal(worker, directory)) {
+                if (!stopped_.load(std::memory_order_relaxed)) {
+                    scan(worker, directory);
+                }
+                if (pending_.fetch_sub(1) == 1) {
+                    // The last directory is done: wake everyone up to leave
+                    std::lock_guard<std::mutex> lock(idle_mutex_);
+                    idle_.notify_all();
+                    return;
+                }
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(idle_mutex_);
+            idle_workers_.fetch_add(1);
+            idle_.wait(lock, [this]() { return queued_.load() > 0 || pending_.load() == 0; });
+            idle_workers_.fetch_sub(1);
+            if (pending_.load() == 0) {
+                return;
+            }
+        }
+    }
+
+    void scan(size_t worker, const Path& directory) {
+        std::error_code ec;
+        std::filesystem::directory_iterator it(directory, std::filesystem::directory_options::skip_permission_denied, ec);
+        std::string name_storage;
+
+        for (; !ec && it != std::filesystem::directory_iterator(); it.increment(ec)) {
+            if (stopped_.load(std::memory_order_relaxed)) {
+                return;
+            }
+
+            const auto& entry = *it;
+            std::string_view name = file_name(entry.path(), name_storage);
+            std::error_code status_error;
+
+            if (entry.is_directory(status_error) && !entry.is_symlink(status_error)) {
+                if (matches_prune_patterns(name, options_)) {
+                    continue;
+                }
+                if (options_.include_directories) {
+                    report(entry);
+                }
+                if (options_.recursive) {
+                    push(worker, entry.path());
+                }
+                continue;
+            }
+
+            if (matches_file_filters(name, options_)) {
+                report(entry);
+            }
+        }
+    }
+
+    void report(const std::filesystem::directory_entry& entry) {
+        try {
+            callback_(entry);
+            reported_.fetch_add(1, std::memory_order_relaxed);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(error_mutex_);
+            if (!error_) {
+                error_ = std::current_exception();
+            }
+            stopped_.store(true);
+        }
+    }
+
+    const WalkOptions& options_;
+    const WalkCallback& callback_;
+    const size_t worker_count_;
+    std::unique_ptr<WorkQueue[]> queues_;
+
+    std::atomic<size_t> pending_{0};        // Directories queued or being scanned
+    std::atomic<size_t> queued_{0};         // Directories waiting in a queue
+    std::atomic<size_t> idle_workers_{0};
+    std::atomic<size_t> reported_{0};
+    std::atomic<bool> stopped_{false};
+    std::mutex idle_mutex_;
+    std::condition_variable idle_;
+
+    std::mutex error_mutex_;
+    std::exception_ptr error_;
+};
+
+} // namespace
+
+bool matches_glob(std::string_view pattern, std::string_view name, bool case_insensitive) noexcept {
+    size_t p = 0;
+    size_t n = 0;
+    size_t star = NO_MATCH;   // Position of the last '*' seen
+    size_t resume = 0;        // Name position that '*' is currently matched up to
+
+    while (n < name.size()) {
+        if (p < pattern.size()) {
+            char pc = pattern[p];
+            char c = fold_case(name[n], case_insensitive);
+
+            if (pc == '*') {
+                star = p++;
+                resume = n;
+                continue;
+            }
+            if (pc == '?') {
+                ++p;
+                ++n;
+                continue;
+            }
+            if (pc == '[') {
+                bool matched = false;
+                size_t next = match_bracket(pattern, p, c, case_insensitive, matched);
+                if (next == NO_MATCH ? c == '[' : matched) {
+                    p = next == NO_MATCH ? p + 1 : next;
+                    ++n;
+                    continue;
+                }
+            } else if (fold_case(pc, case_insensitive) == c) {
+                ++p;
+                ++n;
+                continue;
+            }
+        }
+
+        // Mismatch: let the last '*' swallow one more character
+        if (star == NO_MATCH) {
+            return false;
+        }
+        p = star + 1;
+        n = ++resume;
+    }
+
+    while (p < pattern.size() && pattern[p] == '*') {
+        ++p;
+    }
+    return p == pattern.size();
+}
+
+bool matches_file_filters(std::string_view name, const WalkOptions& options) noexcept {
+    if (!options.extensions.empty()) {
+        std::string_view extension = extension_of(name);
+        bool found = false;
+        for (const auto& wanted : options.extensions) {
+            if (equals(extension, wanted, options.case_insensitive)) {
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            return false;
+        }
+    }
+    return options.patterns.empty() || matches_any(options.patterns, name, options.case_insensitive);
+}
+
+bool matches_prune_patterns(std::string_view name, const WalkOptions& options) noexcept {
+    return matches_any(options.prune_directories, name, options.case_insensitive);
+}
+
+Result<size_t> walk_directory(const Path& root, const WalkOptions& options, const WalkCallback& callback) {
+    std::error_code ec;
+    std::filesystem::directory_iterator probe(root, ec);
+    if (ec) {
+        return std::nullopt;
+    }
+
+    size_t worker_count = options.max_threads > 0 ? options.max_threads : std::thread::hardware_concurrency();
+    if (!options.recursive || worker_count == 0) {
+        worker_count = 1;
+    }
+
+    ParallelWalk walk(options, callback, worker_count);
+    return walk.run(root);
+}
+
+}  // namespace wip::utils::file
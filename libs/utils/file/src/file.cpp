@@ -1,11 +1,12 @@
 #include "file.h"
+#include "directory_walker.h"
 
 #include <iostream>
 #include <fstream>
-#include <sstream>
 #include <random>
 #include <algorithm>
-#include <regex>
+#include <atomic>
+#include <mutex>
 
 namespace wip::utils::file {
 
@@ -116,17 +117,26 @@ Result<std::vector<Path>> list_directory(const Path& path) noexcept {
 }
 
 Result<std::vector<Path>> list_directory_recursive(const Path& path) noexcept {
-    std::error_code ec;
-    std::vector<Path> entries;
-    
-    for (const auto& entry : std::filesystem::recursive_directory_iterator(path, ec)) {
-        if (ec) {
+    try {
+        std::mutex entries_mutex;
+        std::vector<Path> entries;
+        
+        WalkOptions options;
+        options.include_directories = true;
+        auto walked = walk_directory(path, options, [&](const std::filesystem::directory_entry& entry) {
+            std::lock_guard<std::mutex> lock(entries_mutex);
+            entries.push_back(entry.path());
+        });
+        if (!walked) {
             return std::nullopt;
         }
-        entries.push_back(entry.path());
+        
+        // The walk reports entries in no particular order
+        std::sort(entries.begin(), entries.end());
+        return entries;
+    } catch (...) {
+        return std::nullopt;
     }
-    
-    return entries;
 }
 
 bool remove_directory(const Path& path) noexcept {
@@ -152,9 +162,19 @@ Result<std::string> read_file(const Path& path) noexcept {
             return std::nullopt;
         }
 
-        std::ostringstream content;
-        content << file.rdbuf();
-        return content.str();
+        // Read straight into the result instead of through a string stream and its copy
+        std::string content;
+        std::error_code ec;
+        auto size = std::filesystem::file_size(path, ec);
+        if (!ec) {
+            content.reserve(static_cast<size_t>(size));
+        }
+
+        char buffer[64 * 1024];
+        while (file.read(buffer, sizeof(buffer)) || file.gcount() > 0) {
+            content.append(buffer, static_cast<size_t>(file.gcount()));
+        }
+        return content;
     } catch (...) {
         return std::nullopt;
     }
@@ -418,34 +438,25 @@ Result<Path> create_temp_directory(const Path& directory, const std::string& pre
 
 Result<std::vector<Path>> find_files(const Path& directory, const std::string& pattern, bool recursive) noexcept {
     try {
+        std::mutex matches_mutex;
         std::vector<Path> matches;
         
-        // Convert glob pattern to regex
-        std::string regex_pattern = pattern;
-        std::replace(regex_pattern.begin(), regex_pattern.end(), '.', '\\');
-        std::replace(regex_pattern.begin(), regex_pattern.end(), '*', '.');
-        regex_pattern = std::regex_replace(regex_pattern, std::regex("\\\\."), "\\.");
-        regex_pattern = std::regex_replace(regex_pattern, std::regex("\\."), ".*");
-        
-        std::regex reg(regex_pattern, std::regex_constants::icase);
-        
-        std::error_code ec;
-        if (recursive) {
-            for (const auto& entry : std::filesystem::recursive_directory_iterator(directory, ec)) {
-                if (ec) return std::nullopt;
-                if (entry.is_regular_file() && std::regex_match(entry.path().filename().string(), reg)) {
-                    matches.push_back(entry.path());
-                }
-            }
-        } else {
-            for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
-                if (ec) return std::nullopt;
-                if (entry.is_regular_file() && std::regex_match(entry.path().filename().string(), reg)) {
-                    matches.push_back(entry.path());
-                }
+        WalkOptions options;
+        options.patterns = {pattern};
+        options.case_insensitive = true;
+        options.recursive = recursive;
+        auto walked = walk_directory(directory, options, [&](const std::filesystem::directory_entry& entry) {
+            std::error_code ec;
+            if (entry.is_regular_file(ec)) {
+                std::lock_guard<std::mutex> lock(matches_mutex);
+                matches.push_back(entry.path());
             }
+        });
+        if (!walked) {
+            return std::nullopt;
         }
         
+        std::sort(matches.begin(), matches.end());
         return matches;
     } catch (...) {
         return std::nullopt;
@@ -454,19 +465,22 @@ Result<std::vector<Path>> find_files(const Path& directory, const std::string& p
 
 Result<std::uintmax_t> directory_size(const Path& path) noexcept {
     try {
-        std::uintmax_t total_size = 0;
-        std::error_code ec;
+        std::atomic<std::uintmax_t> total_size{0};
         
-        for (const auto& entry : std::filesystem::recursive_directory_iterator(path, ec)) {
-            if (ec) return std::nullopt;
-            if (entry.is_regular_file()) {
-                auto size = std::filesystem::file_size(entry, ec);
-                if (ec) continue; // Skip files we can't read
-                total_size += size;
+        auto walked = walk_directory(path, WalkOptions{}, [&](const std::filesystem::directory_entry& entry) {
+            std::error_code ec;
+            if (entry.is_regular_file(ec)) {
+                auto size = entry.file_size(ec);
+                if (!ec) { // Skip files we can't read
+                    total_size.fetch_add(size, std::memory_order_relaxed);
+                }
             }
+        });
+        if (!walked) {
+            return std::nullopt;
         }
         
-        return total_size;
+        return total_size.load();
     } catch (...) {
         return std::nullopt;
     }
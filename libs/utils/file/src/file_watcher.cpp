@@ -0,0 +1,715 @@
+#include "file_watcher.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace wip::utils::file {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Combine the pending change of a file with a newer one; nullopt means nothing happened overall
+std::optional<FileChangeType> coalesce(FileChangeType pending, FileChangeType next) noexcept {
+    switch (pending) {
+        case FileChangeType::Created:
+            if (next == FileChangeType::Removed) {
+                return std::nullopt;
+            }
+            return FileChangeType::Created;
+        case FileChangeType::Removed:
+            return next == FileChangeType::Removed ? FileChangeType::Removed : FileChangeType::Modified;
+        case FileChangeType::Modified:
+        default:
+            return next == FileChangeType::Removed ? FileChangeType::Removed : FileChangeType::Modified;
+    }
+}
+
+/**
+ * @brief Pending changes of the next batch, coalesced per file
+ *
+ * Only used on the watcher thread.
+ */
+class ChangeCollector {
+public:
+    explicit ChangeCollector(const FileWatcherOptions& options) : options_(options) {}
+
+    void record(const Path& path, FileChangeType type) {
+        if (!matches_file_filters(path.filename().string(), options_.filter)) {
+            return;
+        }
+
+        Clock::time_point now = Clock::now();
+        if (changes_.empty()) {
+            first_change_ = now;
+        }
+        last_change_ = now;
+
+        auto [it, inserted] = changes_.emplace(path, type);
+        if (!inserted) {
+            std::optional<FileChangeType> combined = coalesce(it->second, type);
+            if (combined) {
+                it->second = *combined;
+            } else {
+                changes_.erase(it);
+            }
+        }
+    }
+
+    bool empty() const noexcept { return changes_.empty(); }
+
+    Clock::time_point deadline() const noexcept {
+        return std::min(last_change_ + options_.debounce, first_change_ + options_.max_delay);
+    }
+
+    std::vector<FileChange> take() {
+        std::vector<FileChange> batch;
+        batch.reserve(changes_.size());
+        for (auto& [path, type] : changes_) {
+            batch.push_back(FileChange{path, type});
+        }
+        changes_.clear();
+        return batch;
+    }
+
+private:
+    const FileWatcherOptions& options_;
+    std::map<Path, FileChangeType> changes_;
+    Clock::time_point first_change_;
+    Clock::time_point last_change_;
+};
+
+// Walk options listing a whole tree with the watcher's filters
+WalkOptions tree_walk_options(const FileWatcherOptions& options, bool include_directories) {
+    WalkOptions walk = options.filter;
+    walk.recursive = true;
+    walk.include_directories = include_directories;
+    walk.max_threads = 0;
+    return walk;
+}
+
+/**
+ * @brief Source of change notifications for the watcher thread
+ *
+ * Everything but wake() is called on the watcher thread only.
+ */
+class Backend {
+public:
+    Backend(const FileWatcherOptions& options, ChangeCollector& changes) : options_(options), changes_(changes) {}
+    virtual ~Backend() = default;
+
+    virtual const char* name() const noexcept = 0;
+
+    // Prepare the backend; false if the mechanism is unavailable
+    virtual bool start() = 0;
+
+    virtual void add_tree(const Path& root) = 0;
+
+    // Block until changes were recorded, the timeout expired or wake() was called
+    virtual void wait(std::optional<Clock::duration> timeout) = 0;
+
+    // Interrupt wait(); callable from any thread
+    virtual void wake() = 0;
+
+protected:
+    const FileWatcherOptions& options_;
+    ChangeCollector& changes_;
+};
+
+// ==================== Polling Backend ====================
+
+/**
+ * @brief Rescans the watched trees and compares modification times and sizes
+ */
+class PollingBackend : public Backend {
+public:
+    using Backend::Backend;
+
+    const char* name() const noexcept override { return "polling"; }
+
+    bool start() override {
+        next_poll_ = Clock::now() + options_.poll_interval;
+        return true;
+    }
+
+    void add_tree(const Path& root) override {
+        trees_.push_back(WatchedTree{root, snapshot(root)});
+    }
+
+    void wait(std::optional<Clock::duration> timeout) override {
+        Clock::time_point until = next_poll_;
+        if (timeout) {
+            until = std::min(until, Clock::now() + *timeout);
+        }
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            woken_.wait_until(lock, until, [this]() { return wake_requested_; });
+            wake_requested_ = false;
+        }
+
+        if (Clock::now() >= next_poll_) {
+            for (auto& tree : trees_) {
+                rescan(tree);
+            }
+            next_poll_ = Clock::now() + options_.poll_interval;
+        }
+    }
+
+    void wake() override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        wake_requested_ = true;
+        woken_.notify_one();
+    }
+
+private:
+    struct FileState {
+        std::filesystem::file_time_type modified;
+        uintmax_t size;
+
+        bool operator==(const FileState& other) const { return modified == other.modified && size == other.size; }
+        bool operator!=(const FileState& other) const { return !(*this == other); }
+    };
+
+    using Snapshot = std::map<Path, FileState>;
+
+    struct WatchedTree {
+        Path root;
+        Snapshot files;
+    };
+
+    Snapshot snapshot(const Path& root) const {
+        Snapshot files;
+        std::mutex files_mutex;
+        walk_directory(root, tree_walk_options(options_, false),
+                       [&files, &files_mutex](const std::filesystem::directory_entry& entry) {
+                           std::error_code ec;
+                           FileState state{entry.last_write_time(ec), entry.file_size(ec)};
+                           std::lock_guard<std::mutex> lock(files_mutex);
+                           files.emplace(entry.path(), state);
+                       });
+        return files;
+    }
+
+    void rescan(WatchedTree& tree) {
+        Snapshot current = snapshot(tree.root);
+
+        // Both snapshots are sorted by path: merge them
+        auto before = tree.files.begin();
+        auto after = current.begin();
+        while (before != tree.files.end() || after != current.end()) {
+            if (after == current.end() || (before != tree.files.end() && before->first < after->first)) {
+                changes_.record(before->first, FileChangeType::Removed);
+                ++before;
+            } else if (before == tree.files.end() || after->first < before->first) {
+                changes_.record(after->first, FileChangeType::Created);
+                ++after;
+            } else {
+                if (before->second != after->second) {
+                    changes_.record(after->first, FileChangeType::Modified);
+                }
+                ++before;
+                ++after;
+            }
+        }
+        tree.files = std::move(current);
+    }
+
+    std::vector<WatchedTree> trees_;
+    Clock::time_point next_poll_;
+
+    std::mutex mutex_;
+    std::condition_variable woken_;
+    bool wake_requested_ = false;
+};
+
+#if defined(__linux__)
+
+// ==================== inotify Backend ====================
+
+/**
+ * @brief One inotify watch per directory, added as directories appear
+ */
+class InotifyBackend : public Backend {
+public:
+    using Backend::Backend;
+
+    ~InotifyBackend() override {
+        for (int fd : {inotify_fd_, wake_fds_[0], wake_fds_[1]}) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+    }
+
+    const char* name() const noexcept override { return "inotify"; }
+
+    bool start() override {
+        inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        return inotify_fd_ >= 0 && ::pipe2(wake_fds_, O_NONBLOCK | O_CLOEXEC) == 0;
+    }
+
+    void add_tree(const Path& root) override {
+        add_tree(root, false);
+    }
+
+    void wait(std::optional<Clock::duration> timeout) override {
+        int timeout_ms = -1;
+        if (timeout) {
+            // Round up so the deadline has passed when poll() returns
+            auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(*timeout + std::chrono::milliseconds(1));
+            timeout_ms = static_cast<int>(std::clamp<std::chrono::milliseconds::rep>(ms.count(), 0, 60 * 60 * 1000));
+        }
+
+        pollfd fds[2] = {{inotify_fd_, POLLIN, 0}, {wake_fds_[0], POLLIN, 0}};
+        if (::poll(fds, 2, timeout_ms) <= 0) {
+            return;
+        }
+
+        if (fds[1].revents & POLLIN) {
+            char drain[64];
+            while (::read(wake_fds_[0], drain, sizeof(drain)) > 0) {
+            }
+        }
+        if (fds[0].revents & POLLIN) {
+            read_events();
+        }
+    }
+
+    void wake() override {
+        char byte = 1;
+        // A full pipe already guarantees a wake-up
+        [[maybe_unused]] ssize_t written = ::write(wake_fds_[1], &byte, 1);
+    }
+
+private:
+    static constexpr uint32_t WATCH_MASK = IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_FROM |
+                                           IN_MOVED_TO | IN_ONLYDIR | IN_DONT_FOLLOW | IN_EXCL_UNLINK;
+
+    void add_tree(const Path& root, bool report_files) {
+        add_directory(root);
+
+        std::vector<std::pair<Path, bool>> entries;
+        std::mutex entries_mutex;
+        walk_directory(root, tree_walk_options(options_, true),
+                       [&entries, &entries_mutex](const std::filesystem::directory_entry& entry) {
+                           std::error_code ec;
+                           bool is_directory = entry.is_directory(ec);
+                           std::lock_guard<std::mutex> lock(entries_mutex);
+                           entries.emplace_back(entry.path(), is_directory);
+                       });
+
+        for (const auto& [path, is_directory] : entries) {
+            if (is_directory) {
+                add_directory(path);
+            } else if (report_files) {
+                changes_.record(path, FileChangeType::Created);
+            }
+        }
+    }
+
+    void add_directory(const Path& directory) {
+        int wd = inotify_add_watch(inotify_fd_, directory.c_str(), WATCH_MASK);
+        if (wd >= 0) {
+            watches_[wd] = directory;
+        }
+    }
+
+    // Drop the watches of a tree moved elsewhere, which would keep reporting its old paths
+    void forget_tree(const Path& root) {
+        const std::string& prefix = root.native();
+        for (auto it = watches_.begin(); it != watches_.end();) {
+            const std::string& path = it->second.native();
+            bool inside = path.compare(0, prefix.size(), prefix) == 0 &&
+                          (path.size() == prefix.size() || path[prefix.size()] == '/');
+            if (inside) {
+                inotify_rm_watch(inotify_fd_, it->first);
+                it = watches_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    void read_events() {
+        alignas(inotify_event) char buffer[64 * 1024];
+        while (true) {
+            ssize_t length = ::read(inotify_fd_, buffer, sizeof(buffer));
+            if (length <= 0) {
+                return;   // EAGAIN: the queue is drained
+            }
+
+            for (ssize_t offset = 0; offset < length;) {
+                const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+                handle_event(*event);
+            }
+        }
+    }
+
+    void handle_event(const inotify_event& event) {
+        // Events lost to a queue overflow (IN_Q_OVERFLOW) cannot be recovered and are skipped
+        auto watch = watches_.find(event.wd);
+        if (event.mask & IN_IGNORED) {
+            if (watch != watches_.end()) {
+                watches_.erase(watch);
+            }
+            return;
+        }
+        if (watch == watches_.end() || event.len == 0) {
+            return;
+        }
+
+        std::string_view name(event.name);
+        Path path = watch->second / Path(std::string(name));
+
+        if (event.mask & IN_ISDIR) {
+            if ((event.mask & (IN_CREATE | IN_MOVED_TO)) && !matches_prune_patterns(name, options_.filter)) {
+                add_tree(path, true);
+            } else if (event.mask & IN_MOVED_FROM) {
+                forget_tree(path);
+            }
+            return;
+        }
+
+        if (event.mask & (IN_CREATE | IN_MOVED_TO)) {
+            changes_.record(path, FileChangeType::Created);
+        } else if (event.mask & (IN_DELETE | IN_MOVED_FROM)) {
+            changes_.record(path, FileChangeType::Removed);
+        } else if (event.mask & (IN_MODIFY | IN_CLOSE_WRITE)) {
+            changes_.record(path, FileChangeType::Modified);
+        }
+    }
+
+    int inotify_fd_ = -1;
+    int wake_fds_[2] = {-1, -1};
+    std::unordered_map<int, Path> watches_;
+};
+
+#elif defined(_WIN32)
+
+// ==================== ReadDirectoryChangesW Backend ====================
+
+/**
+ * @brief One overlapped ReadDirectoryChangesW per watched tree
+ */
+class WindowsBackend : public Backend {
+public:
+    using Backend::Backend;
+
+    ~WindowsBackend() override {
+        for (auto& tree : trees_) {
+            CancelIoEx(tree->directory, &tree->overlapped);
+            DWORD bytes = 0;
+            GetOverlappedResult(tree->directory, &tree->overlapped, &bytes, TRUE);
+            CloseHandle(tree->overlapped.hEvent);
+            CloseHandle(tree->directory);
+        }
+        if (wake_event_) {
+            CloseHandle(wake_event_);
+        }
+    }
+
+    const char* name() const noexcept override { return "ReadDirectoryChangesW"; }
+
+    bool start() override {
+        wake_event_ = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+        return wake_event_ != nullptr;
+    }
+
+    void add_tree(const Path& root) override {
+        // WaitForMultipleObjects also waits for the wake event
+        if (trees_.size() + 1 >= MAXIMUM_WAIT_OBJECTS) {
+            return;
+        }
+
+        HANDLE directory = CreateFileW(root.c_str(), FILE_LIST_DIRECTORY,
+                                       FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                                       FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+        if (directory == INVALID_HANDLE_VALUE) {
+            return;
+        }
+
+        auto tree = std::make_unique<WatchedTree>();
+        tree->root = root;
+        tree->directory = directory;
+        tree->overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+        if (!tree->overlapped.hEvent || !issue_read(*tree)) {
+            if (tree->overlapped.hEvent) {
+                CloseHandle(tree->overlapped.hEvent);
+            }
+            CloseHandle(directory);
+            return;
+        }
+        trees_.push_back(std::move(tree));
+    }
+
+    void wait(std::optional<Clock::duration> timeout) override {
+        DWORD timeout_ms = INFINITE;
+        if (timeout) {
+            auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(*timeout + std::chrono::milliseconds(1));
+            timeout_ms = static_cast<DWORD>(std::clamp<std::chrono::milliseconds::rep>(ms.count(), 0, 60 * 60 * 1000));
+        }
+
+        std::vector<HANDLE> handles{wake_event_};
+        for (const auto& tree : trees_) {
+            handles.push_back(tree->overlapped.hEvent);
+        }
+
+        DWORD result = WaitForMultipleObjects(static_cast<DWORD>(handles.size()), handles.data(), FALSE, timeout_ms);
+        if (result <= WAIT_OBJECT_0 || result >= WAIT_OBJECT_0 + handles.size()) {
+            return;
+        }
+
+        WatchedTree& tree = *trees_[result - WAIT_OBJECT_0 - 1];
+        DWORD bytes = 0;
+        if (GetOverlappedResult(tree.directory, &tree.overlapped, &bytes, FALSE) && bytes > 0) {
+            // Zero bytes means the buffer overflowed and the changes are lost
+            read_events(tree, bytes);
+        }
+        ResetEvent(tree.overlapped.hEvent);
+        issue_read(tree);
+    }
+
+    void wake() override {
+        SetEvent(wake_event_);
+    }
+
+private:
+    struct WatchedTree {
+        Path root;
+        HANDLE directory = INVALID_HANDLE_VALUE;
+        OVERLAPPED overlapped{};
+        DWORD buffer[16 * 1024];   // FILE_NOTIFY_INFORMATION records must be DWORD aligned
+    };
+
+    static constexpr DWORD NOTIFY_FILTER = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME |
+                                           FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE;
+
+    bool issue_read(WatchedTree& tree) {
+        return ReadDirectoryChangesW(tree.directory, tree.buffer, sizeof(tree.buffer), TRUE, NOTIFY_FILTER, nullptr,
+                                     &tree.overlapped, nullptr) != 0;
+    }
+
+    bool is_pruned(const Path& relative) const {
+        // Every component but the file name is a directory the change happened in
+        Path parent = relative.parent_path();
+        for (const auto& component : parent) {
+            if (matches_prune_patterns(component.string(), options_.filter)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void read_events(const WatchedTree& tree, DWORD bytes) {
+        const auto* data = reinterpret_cast<const char*>(tree.buffer);
+        for (DWORD offset = 0; offset < bytes;) {
+            const auto* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(data + offset);
+            Path relative(std::wstring(info->FileName, info->FileNameLength / sizeof(WCHAR)));
+            handle_event(tree.root, relative, info->Action);
+            if (info->NextEntryOffset == 0) {
+                break;
+            }
+            offset += info->NextEntryOffset;
+        }
+    }
+
+    void handle_event(const Path& root, const Path& relative, DWORD action) {
+        if (is_pruned(relative)) {
+            return;
+        }
+
+        Path path = root / relative;
+        std::error_code ec;
+        bool is_directory = std::filesystem::is_directory(path, ec);
+
+        switch (action) {
+            case FILE_ACTION_ADDED:
+            case FILE_ACTION_RENAMED_NEW_NAME:
+                if (!is_directory) {
+                    changes_.record(path, FileChangeType::Created);
+                } else if (!matches_prune_patterns(relative.filename().string(), options_.filter)) {
+                    // The subtree watch covers the new directory, but its files appeared without events
+                    report_new_directory(path);
+                }
+                break;
+            case FILE_ACTION_REMOVED:
+            case FILE_ACTION_RENAMED_OLD_NAME:
+                changes_.record(path, FileChangeType::Removed);
+                break;
+            case FILE_ACTION_MODIFIED:
+                if (!is_directory) {
+                    changes_.record(path, FileChangeType::Modified);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    void report_new_directory(const Path& directory) {
+        std::vector<Path> files;
+        std::mutex files_mutex;
+        walk_directory(directory, tree_walk_options(options_, false),
+                       [&files, &files_mutex](const std::filesystem::directory_entry& entry) {
+                           std::lock_guard<std::mutex> lock(files_mutex);
+                           files.push_back(entry.path());
+                       });
+        for (const auto& file : files) {
+            changes_.record(file, FileChangeType::Created);
+        }
+    }
+
+    HANDLE wake_event_ = nullptr;
+    std::vector<std::unique_ptr<WatchedTree>> trees_;
+};
+
+#endif
+
+std::unique_ptr<Backend> make_backend(const FileWatcherOptions& options, ChangeCollector& changes) {
+    if (!options.force_polling) {
+#if defined(__linux__)
+        auto native = std::make_unique<InotifyBackend>(options, changes);
+#elif defined(_WIN32)
+        auto native = std::make_unique<WindowsBackend>(options, changes);
+#else
+        std::unique_ptr<Backend> native;
+#endif
+        // Fall back to polling when the mechanism is exhausted (e.g. the inotify instance limit)
+        if (native && native->start()) {
+            return native;
+        }
+    }
+
+    auto polling = std::make_unique<PollingBackend>(options, changes);
+    polling->start();
+    return polling;
+}
+
+} // namespace
+
+struct FileWatcher::Impl {
+    Impl(FileChangeCallback change_callback, FileWatcherOptions watcher_options)
+        : callback(std::move(change_callback)), options(std::move(watcher_options)), changes(options),
+          backend(make_backend(options, changes)) {}
+
+    void run() {
+        while (!stopping.load()) {
+            std::vector<Path> roots;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                roots.swap(new_roots);
+            }
+            if (!roots.empty()) {
+                for (const auto& root : roots) {
+                    backend->add_tree(root);
+                }
+                std::lock_guard<std::mutex> lock(mutex);
+                added_roots += roots.size();
+                roots_added.notify_all();
+            }
+
+            std::optional<Clock::duration> timeout;
+            if (!changes.empty()) {
+                timeout = std::max(Clock::duration::zero(), changes.deadline() - Clock::now());
+            }
+            backend->wait(timeout);
+
+            if (!stopping.load() && !changes.empty() && Clock::now() >= changes.deadline()) {
+                std::vector<FileChange> batch = changes.take();
+                try {
+                    callback(batch);
+                } catch (...) {
+                    // A throwing callback must not end the watcher thread
+                }
+            }
+        }
+    }
+
+    FileChangeCallback callback;
+    FileWatcherOptions options;
+    ChangeCollector changes;
+    std::unique_ptr<Backend> backend;
+
+    std::mutex mutex;
+    std::condition_variable roots_added;
+    std::vector<Path> new_roots;   // Directories watch() handed over to the watcher thread
+    size_t requested_roots = 0;
+    size_t added_roots = 0;
+    std::atomic<bool> stopping{false};
+    std::thread thread;
+};
+
+FileWatcher::FileWatcher(FileChangeCallback callback, FileWatcherOptions options)
+    : impl_(std::make_unique<Impl>(std::move(callback), std::move(options))) {
+    impl_->thread = std::thread([impl = impl_.get()]() { impl->run(); });
+}
+
+FileWatcher::~FileWatcher() {
+    stop();
+}
+
+bool FileWatcher::watch(const Path& directory) {
+    std::error_code ec;
+    if (!is_running() || !std::filesystem::is_directory(directory, ec)) {
+        return false;
+    }
+
+    if (std::this_thread::get_id() == impl_->thread.get_id()) {
+        impl_->backend->add_tree(directory);   // Called from the callback
+        return true;
+    }
+
+    std::unique_lock<std::mutex> lock(impl_->mutex);
+    impl_->new_roots.push_back(directory);
+    size_t ticket = ++impl_->requested_roots;
+    impl_->backend->wake();
+    impl_->roots_added.wait(lock, [this, ticket]() { return impl_->added_roots >= ticket || impl_->stopping.load(); });
+    return impl_->added_roots >= ticket;
+}
+
+void FileWatcher::stop() {
+    if (!impl_->thread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(impl_->mutex);
+        impl_->stopping.store(true);
+        impl_->roots_added.notify_all();
+    }
+    impl_->backend->wake();
+    impl_->thread.join();
+}
+
+bool FileWatcher::is_running() const noexcept {
+    return impl_->thread.joinable() && !impl_->stopping.load();
+}
+
+const char* FileWatcher::backend_name() const noexcept {
+    return impl_->backend->name();
+}
+
+}  // namespace wip::utils::file
@@ -0,0 +1,228 @@
+#include "mapped_file.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#if (defined(__x86_64__) || defined(_M_X64)) && !defined(WIP_FILE_PORTABLE)
+#define WIP_FILE_SSE2 1
+#include <emmintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define WIP_FILE_AVX2 1
+#include <immintrin.h>
+#endif
+#elif (defined(__aarch64__) || defined(_M_ARM64)) && !defined(WIP_FILE_PORTABLE)
+#define WIP_FILE_NEON 1
+#include <arm_neon.h>
+#endif
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace wip::utils::file {
+
+namespace {
+
+// ==================== Newline Counting ====================
+
+// The vector kernels keep one count per byte lane, each subtracting the
+// all-ones compare result, and fold them into a total before a lane can wrap
+constexpr size_t MAX_LANE_BLOCKS = 255;
+
+size_t count_newlines_portable(const char* data, size_t size) noexcept {
+    return static_cast<size_t>(std::count(data, data + size, '\n'));
+}
+
+#ifdef WIP_FILE_SSE2
+size_t count_newlines_sse2(const char* data, size_t size) noexcept {
+    const __m128i newline = _mm_set1_epi8('\n');
+    size_t total = 0;
+    size_t i = 0;
+    while (i + 16 <= size) {
+        __m128i lanes = _mm_setzero_si128();
+        for (size_t block = 0; block < MAX_LANE_BLOCKS && i + 16 <= size; ++block, i += 16) {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            lanes = _mm_sub_epi8(lanes, _mm_cmpeq_epi8(bytes, newline));
+        }
+        __m128i sums = _mm_sad_epu8(lanes, _mm_setzero_si128());
+        total += static_cast<size_t>(_mm_cvtsi128_si32(sums)) + static_cast<size_t>(_mm_extract_epi16(sums, 4));
+    }
+    return total + count_newlines_portable(data + i, size - i);
+}
+#endif
+
+#ifdef WIP_FILE_AVX2
+__attribute__((target("avx2")))
+size_t count_newlines_avx2(const char* data, size_t size) noexcept {
+    const __m256i newline = _mm256_set1_epi8('\n');
+    size_t total = 0;
+    size_t i = 0;
+    while (i + 32 <= size) {
+        __m256i lanes = _mm256_setzero_si256();
+        for (size_t block = 0; block < MAX_LANE_BLOCKS && i + 32 <= size; ++block, i += 32) {
+            __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            lanes = _mm256_sub_epi8(lanes, _mm256_cmpeq_epi8(bytes, newline));
+        }
+        __m256i sums = _mm256_sad_epu8(lanes, _mm256_setzero_si256());
+        total += static_cast<size_t>(_mm256_extract_epi64(sums, 0)) + static_cast<size_t>(_mm256_extract_epi64(sums, 1)) +
+                 static_cast<size_t>(_mm256_extract_epi64(sums, 2)) + static_cast<size_t>(_mm256_extract_epi64(sums, 3));
+    }
+    // Leave the upper halves clean for the SSE code the tail may run
+    _mm256_zeroupper();
+    return total + count_newlines_portable(data + i, size - i);
+}
+#endif
+
+#ifdef WIP_FILE_NEON
+size_t count_newlines_neon(const char* data, size_t size) noexcept {
+    const uint8x16_t newline = vdupq_n_u8('\n');
+    size_t total = 0;
+    size_t i = 0;
+    while (i + 16 <= size) {
+        uint8x16_t lanes = vdupq_n_u8(0);
+        for (size_t block = 0; block < MAX_LANE_BLOCKS && i + 16 <= size; ++block, i += 16) {
+            uint8x16_t bytes = vld1q_u8(reinterpret_cast<const uint8_t*>(data + i));
+            lanes = vsubq_u8(lanes, vceqq_u8(bytes, newline));
+        }
+        total += vaddlvq_u8(lanes);
+    }
+    return total + count_newlines_portable(data + i, size - i);
+}
+#endif
+
+using CountNewlines = size_t (*)(const char*, size_t) noexcept;
+
+CountNewlines select_count_newlines() noexcept {
+#ifdef WIP_FILE_AVX2
+    if (__builtin_cpu_supports("avx2")) {
+        return count_newlines_avx2;
+    }
+#endif
+#if defined(WIP_FILE_SSE2)
+    return count_newlines_sse2;
+#elif defined(WIP_FILE_NEON)
+    return count_newlines_neon;
+#else
+    return count_newlines_portable;
+#endif
+}
+
+}  // namespace
+
+size_t count_lines(std::string_view text) noexcept {
+    static const CountNewlines count_newlines = select_count_newlines();
+    if (text.empty()) {
+        return 0;
+    }
+    return count_newlines(text.data(), text.size()) + (text.back() != '\n');
+}
+
+// ==================== Memory-Mapped Files ====================
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(other.data_), size_(other.size_), open_(other.open_) {
+    other.data_ = nullptr;
+    other.size_ = 0;
+    other.open_ = false;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        data_ = other.data_;
+        size_ = other.size_;
+        open_ = other.open_;
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.open_ = false;
+    }
+    return *this;
+}
+
+Result<MappedFile> MappedFile::open(const Path& path) noexcept {
+    MappedFile file;
+
+#ifdef _WIN32
+    HANDLE handle = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        return std::nullopt;
+    }
+
+    LARGE_INTEGER size;
+    if (!::GetFileSizeEx(handle, &size)) {
+        ::CloseHandle(handle);
+        return std::nullopt;
+    }
+
+    if (size.QuadPart > 0) {
+        // The view keeps the mapping alive, so neither handle is needed afterwards
+        HANDLE mapping = ::CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        void* view = mapping ? ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (mapping) {
+            ::CloseHandle(mapping);
+        }
+        if (!view) {
+            ::CloseHandle(handle);
+            return std::nullopt;
+        }
+        file.data_ = static_cast<const char*>(view);
+        file.size_ = static_cast<size_t>(size.QuadPart);
+    }
+    ::CloseHandle(handle);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return std::nullopt;
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+        ::close(fd);
+        return std::nullopt;
+    }
+
+    if (info.st_size > 0) {
+        // The mapping holds its own reference to the file, so the descriptor can go
+        auto size = static_cast<size_t>(info.st_size);
+        void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            ::close(fd);
+            return std::nullopt;
+        }
+        file.data_ = static_cast<const char*>(mapping);
+        file.size_ = size;
+    }
+    ::close(fd);
+#endif
+
+    file.open_ = true;
+    return file;
+}
+
+void MappedFile::close() noexcept {
+    if (data_) {
+#ifdef _WIN32
+        ::UnmapViewOfFile(data_);
+#else
+        ::munmap(const_cast<char*>(data_), size_);
+#endif
+    }
+    data_ = nullptr;
+    size_ = 0;
+    open_ = false;
+}
+
+}  // namespace wip::utils::file
@@ -0,0 +1,165 @@
+#include "source_file_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace wip::utils::file {
+
+// ==================== Source Files ====================
+
+SourceFile::SourceFile(Path path) : path_(std::move(path)) {
+    auto mapped = MappedFile::open(path_);
+    if (!mapped) {
+        return;
+    }
+    file_ = std::move(*mapped);
+
+    const char* data = file_.data();
+    const size_t size = file_.size();
+    line_starts_.reserve(count_lines(file_.view()));
+    for (size_t start = 0; start < size;) {
+        line_starts_.push_back(start);
+        const void* newline = std::memchr(data + start, '\n', size - start);
+        start = newline ? static_cast<size_t>(static_cast<const char*>(newline) - data) + 1 : size;
+    }
+}
+
+std::string_view SourceFile::line(size_t number) const noexcept {
+    if (number == 0 || number > line_starts_.size()) {
+        return {};
+    }
+    const size_t start = line_starts_[number - 1];
+    size_t end = number < line_starts_.size() ? line_starts_[number] - 1 : file_.size();
+    if (end > start && file_.data()[end - 1] == '\n') {
+        --end;
+    }
+    if (end > start && file_.data()[end - 1] == '\r') {
+        --end;
+    }
+    return std::string_view(file_.data() + start, end - start);
+}
+
+// ==================== Source File Cache ====================
+
+SourceFileCache::SourceFileCache(size_t capacity)
+    : capacity_(std::max<size_t>(capacity, 1)), thread_(&SourceFileCache::run, this) {}
+
+SourceFileCache::~SourceFileCache() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        queue_.clear();
+        queued_.clear();
+    }
+    work_available_.notify_all();
+    thread_.join();
+}
+
+std::shared_ptr<const SourceFile> SourceFileCache::find(const Path& path) {
+    std::string key = path.string();
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+        files_.splice(files_.begin(), files_, it->second);
+        return it->second->second;
+    }
+    enqueue(key, true);
+    return nullptr;
+}
+
+void SourceFileCache::prefetch(const Path& path) {
+    std::string key = path.string();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (index_.count(key) == 0) {
+        enqueue(key, false);
+    }
+}
+
+void SourceFileCache::invalidate(const Path& path) {
+    std::string key = path.string();
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+        files_.erase(it->second);
+        index_.erase(it);
+    }
+    if (busy_ && loading_ == key) {
+        ++generation_;
+    }
+}
+
+void SourceFileCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    files_.clear();
+    index_.clear();
+    queue_.clear();
+    queued_.clear();
+    ++generation_;
+    work_done_.notify_all();
+}
+
+void SourceFileCache::wait_idle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    work_done_.wait(lock, [this]() { return queue_.empty() && !busy_; });
+}
+
+size_t SourceFileCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return files_.size();
+}
+
+void SourceFileCache::enqueue(const std::string& key, bool urgent) {
+    if (key.empty() || (busy_ && loading_ == key)) {
+        return;
+    }
+    if (!queued_.insert(key).second) {
+        // Already queued: a lookup moves it ahead of the prefetches
+        if (urgent && queue_.front() != key) {
+            queue_.erase(std::find(queue_.begin(), queue_.end(), key));
+            queue_.push_front(key);
+        }
+        return;
+    }
+    if (urgent) {
+        queue_.push_front(key);
+    } else {
+        queue_.push_back(key);
+    }
+    work_available_.notify_one();
+}
+
+void SourceFileCache::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        work_available_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+        if (stopping_) {
+            return;
+        }
+
+        loading_ = std::move(queue_.front());
+        queue_.pop_front();
+        queued_.erase(loading_);
+        busy_ = true;
+        const uint64_t generation = generation_;
+
+        // Map and index the file without holding the lock
+        lock.unlock();
+        auto file = std::make_shared<const SourceFile>(Path(loading_));
+        lock.lock();
+
+        // A file dropped while it was loading may be outdated already
+        if (generation == generation_) {
+            if (files_.size() >= capacity_) {
+                index_.erase(files_.back().first);
+                files_.pop_back();
+            }
+            files_.emplace_front(loading_, std::move(file));
+            index_[loading_] = files_.begin();
+        }
+        busy_ = false;
+        work_done_.notify_all();
+    }
+}
+
+}  // namespace wip::utils::file
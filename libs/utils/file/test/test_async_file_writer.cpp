@@ -0,0 +1,213 @@
+#include "async_file_writer.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <filesystem>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace wip::utils::file;
+
+class AsyncFileWriterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        test_dir = std::filesystem::temp_directory_path() / "async_file_writer_test";
+        if (wip::utils::file::exists(test_dir)) {
+            wip::utils::file::remove_all(test_dir);
+        }
+        wip::utils::file::create_directories(test_dir);
+    }
+
+    void TearDown() override {
+        if (wip::utils::file::exists(test_dir)) {
+            wip::utils::file::remove_all(test_dir);
+        }
+    }
+
+    // Occupy the I/O thread until release() so that later requests stay queued
+    std::future<bool> block(AsyncFileWriter& writer) {
+        std::shared_future<void> released = release_.get_future().share();
+        return writer.write(test_dir / "blocker.txt", [released]() {
+            released.wait();
+            return std::string("blocker");
+        });
+    }
+
+    void release() { release_.set_value(); }
+
+    size_t entry_count() const {
+        size_t count = 0;
+        for ([[maybe_unused]] const auto& entry : std::filesystem::directory_iterator(test_dir)) {
+            ++count;
+        }
+        return count;
+    }
+
+    std::filesystem::path test_dir;
+
+private:
+    std::promise<void> release_;
+};
+
+// ==================== Atomic Write Tests ====================
+
+TEST_F(AsyncFileWriterTest, AtomicWriteReplacesContent) {
+    auto path = test_dir / "file.txt";
+    ASSERT_TRUE(write_file(path, "old content that is longer"));
+
+    EXPECT_TRUE(write_file_atomic(path, "new\r\ncontent"));
+    EXPECT_EQ(read_file(path), "new\r\ncontent");
+    EXPECT_TRUE(write_file_atomic(path, "", false));
+    EXPECT_EQ(read_file(path), "");
+
+    // No temporary files are left behind
+    EXPECT_EQ(entry_count(), 1u);
+}
+
+TEST_F(AsyncFileWriterTest, AtomicWriteFailureKeepsNothing) {
+    EXPECT_FALSE(write_file_atomic(test_dir / "missing" / "file.txt", "content"));
+    EXPECT_EQ(entry_count(), 0u);
+}
+
+// ==================== Asynchronous Write Tests ====================
+
+TEST_F(AsyncFileWriterTest, WritesInBackground) {
+    AsyncFileWriter writer;
+    auto path = test_dir / "report.txt";
+
+    auto done = writer.write(path, std::string(1 << 20, 'r'));
+    EXPECT_TRUE(done.get());
+    EXPECT_EQ(read_file(path), std::string(1 << 20, 'r'));
+    EXPECT_EQ(writer.pending(), 0u);
+}
+
+TEST_F(AsyncFileWriterTest, ProducerRunsOnIoThread) {
+    AsyncFileWriter writer(false);
+    auto path = test_dir / "produced.txt";
+    auto caller = std::this_thread::get_id();
+    std::atomic<bool> on_caller{true};
+
+    auto done = writer.write(path, [&]() {
+        on_caller = std::this_thread::get_id() == caller;
+        return std::string("produced");
+    });
+    EXPECT_TRUE(done.get());
+    EXPECT_FALSE(on_caller);
+    EXPECT_EQ(read_file(path), "produced");
+}
+
+TEST_F(AsyncFileWriterTest, ThrowingProducerKeepsOldContent) {
+    AsyncFileWriter writer(false);
+    auto path = test_dir / "kept.txt";
+    ASSERT_TRUE(write_file(path, "old"));
+
+    auto done = writer.write(path, []() -> std::string { throw std::runtime_error("serialization failed"); });
+    EXPECT_FALSE(done.get());
+    EXPECT_EQ(read_file(path), "old");
+    EXPECT_EQ(entry_count(), 1u);
+}
+
+TEST_F(AsyncFileWriterTest, StreamProducerWritesInBlocks) {
+    AsyncFileWriter writer(false);
+    auto path = test_dir / "streamed.txt";
+    ASSERT_TRUE(write_file(path, "old"));
+
+    std::string expected;
+    for (int i = 0; i < 20000; ++i) {
+        expected += "line " + std::to_string(i) + "\n";
+    }
+    auto done = writer.write_stream(path, [](std::ostream& out) {
+        for (int i = 0; i < 20000; ++i) {
+            out << "line " << i << '\n';
+        }
+    });
+    EXPECT_TRUE(done.get());
+    EXPECT_EQ(read_file(path), expected);
+
+    auto failed = writer.write_stream(path, [](std::ostream& out) {
+        out << "partial";
+        throw std::runtime_error("report failed");
+    });
+    EXPECT_FALSE(failed.get());
+    EXPECT_EQ(read_file(path), expected);
+    EXPECT_EQ(entry_count(), 1u);
+}
+
+TEST_F(AsyncFileWriterTest, ReportsFailureThroughCallback) {
+    AsyncFileWriter writer(false);
+    std::promise<std::pair<Path, bool>> reported;
+    auto path = test_dir / "missing" / "file.txt";
+
+    auto done = writer.write(path, std::string("content"), [&](const Path& written, bool success) {
+        reported.set_value({written, success});
+    });
+    EXPECT_FALSE(done.get());
+    auto [written, success] = reported.get_future().get();
+    EXPECT_EQ(written, path);
+    EXPECT_FALSE(success);
+}
+
+TEST_F(AsyncFileWriterTest, AppendsInOrder) {
+    AsyncFileWriter writer(false);
+    auto path = test_dir / "log.txt";
+
+    std::vector<std::future<bool>> results;
+    for (int i = 0; i < 100; ++i) {
+        results.push_back(writer.append(path, std::to_string(i) + "\n"));
+    }
+    writer.flush();
+
+    std::string expected;
+    for (int i = 0; i < 100; ++i) {
+        expected += std::to_string(i) + "\n";
+        EXPECT_TRUE(results[i].get());
+    }
+    EXPECT_EQ(read_file(path), expected);
+}
+
+TEST_F(AsyncFileWriterTest, CoalescesQueuedRequests) {
+    AsyncFileWriter writer(false);
+    auto path = test_dir / "state.txt";
+    auto log = test_dir / "log.txt";
+    std::atomic<int> produced{0};
+
+    auto blocker = block(writer);
+    std::vector<std::future<bool>> results;
+    for (int i = 0; i < 10; ++i) {
+        results.push_back(writer.write(path, [&produced, i]() {
+            ++produced;
+            return "version " + std::to_string(i);
+        }));
+        results.push_back(writer.append(log, "line " + std::to_string(i) + "\n"));
+    }
+    results.push_back(writer.append(path, " final"));
+
+    // The blocker plus one request per file
+    EXPECT_EQ(writer.pending(), 3u);
+    release();
+    writer.flush();
+
+    EXPECT_TRUE(blocker.get());
+    for (auto& result : results) {
+        EXPECT_TRUE(result.get());
+    }
+    EXPECT_EQ(produced, 1);
+    EXPECT_EQ(read_file(path), "version 9 final");
+    EXPECT_EQ(read_file(log)->substr(0, 14), "line 0\nline 1\n");
+}
+
+TEST_F(AsyncFileWriterTest, DestructorFinishesQueuedWrites) {
+    auto path = test_dir / "last.txt";
+    std::future<bool> done;
+    {
+        AsyncFileWriter writer(false);
+        auto blocker = block(writer);
+        done = writer.write(path, std::string("written on shutdown"));
+        release();
+    }
+    EXPECT_EQ(done.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_TRUE(done.get());
+    EXPECT_EQ(read_file(path), "written on shutdown");
+}
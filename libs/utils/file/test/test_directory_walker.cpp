@@ -0,0 +1,160 @@
+#include "directory_walker.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace wip::utils::file;
+
+class DirectoryWalkerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        test_dir = std::filesystem::temp_directory_path() / "directory_walker_test";
+        if (wip::utils::file::exists(test_dir)) {
+            wip::utils::file::remove_all(test_dir);
+        }
+        wip::utils::file::create_directories(test_dir);
+        
+        // src/{a,b}/... with sources, build/ and .git/ to be pruned
+        for (int module = 0; module < 8; ++module) {
+            for (int sub = 0; sub < 3; ++sub) {
+                auto dir = test_dir / "src" / ("module" + std::to_string(module)) / ("sub" + std::to_string(sub));
+                wip::utils::file::create_directories(dir);
+                wip::utils::file::write_file(dir / "code.cpp", "int x;");
+                wip::utils::file::write_file(dir / "code.h", "int y;");
+                wip::utils::file::write_file(dir / "NOTES.TXT", "notes");
+            }
+        }
+        wip::utils::file::create_directories(test_dir / "build" / "CMakeFiles");
+        wip::utils::file::write_file(test_dir / "build" / "generated.cpp", "");
+        wip::utils::file::create_directories(test_dir / ".git" / "objects");
+        wip::utils::file::write_file(test_dir / ".git" / "objects" / "blob.cpp", "");
+    }
+    
+    void TearDown() override {
+        if (wip::utils::file::exists(test_dir)) {
+            wip::utils::file::remove_all(test_dir);
+        }
+    }
+    
+    std::set<std::string> walk(const WalkOptions& options) {
+        std::mutex mutex;
+        std::set<std::string> paths;
+        auto count = walk_directory(test_dir, options, [&](const std::filesystem::directory_entry& entry) {
+            std::lock_guard<std::mutex> lock(mutex);
+            paths.insert(std::filesystem::relative(entry.path(), test_dir).generic_string());
+        });
+        EXPECT_TRUE(count.has_value());
+        if (count) {
+            EXPECT_EQ(*count, paths.size());
+        }
+        return paths;
+    }
+    
+    std::filesystem::path test_dir;
+};
+
+// ==================== Glob Matching Tests ====================
+
+TEST(GlobTest, MatchesWildcards) {
+    EXPECT_TRUE(matches_glob("*", ""));
+    EXPECT_TRUE(matches_glob("*", "anything"));
+    EXPECT_TRUE(matches_glob("*.cpp", "main.cpp"));
+    EXPECT_FALSE(matches_glob("*.cpp", "main.cpp.bak"));
+    EXPECT_TRUE(matches_glob("test_*.cpp", "test_file.cpp"));
+    EXPECT_FALSE(matches_glob("test_*.cpp", "file_test.cpp"));
+    EXPECT_TRUE(matches_glob("?.h", "a.h"));
+    EXPECT_FALSE(matches_glob("?.h", "ab.h"));
+    EXPECT_TRUE(matches_glob("*a*b*c", "xaybzc"));
+    EXPECT_FALSE(matches_glob("*a*b*c", "xaybz"));
+    EXPECT_TRUE(matches_glob(".*", ".git"));
+    EXPECT_FALSE(matches_glob(".*", "git"));
+}
+
+TEST(GlobTest, MatchesBracketsAndCase) {
+    EXPECT_TRUE(matches_glob("file[0-9].txt", "file7.txt"));
+    EXPECT_FALSE(matches_glob("file[0-9].txt", "fileX.txt"));
+    EXPECT_TRUE(matches_glob("file[!0-9].txt", "fileX.txt"));
+    EXPECT_TRUE(matches_glob("[ch]pp", "cpp"));
+    EXPECT_TRUE(matches_glob("a[", "a["));     // Unclosed bracket is literal
+    EXPECT_FALSE(matches_glob("*.CPP", "main.cpp"));
+    EXPECT_TRUE(matches_glob("*.CPP", "main.cpp", true));
+    EXPECT_TRUE(matches_glob("[A-C]*", "beta", true));
+}
+
+// ==================== Walk Tests ====================
+
+TEST_F(DirectoryWalkerTest, ReportsEveryFileByDefault) {
+    auto paths = walk(WalkOptions{});
+    EXPECT_EQ(paths.size(), 8u * 3u * 3u + 2u);
+    EXPECT_EQ(paths.count("src/module3/sub1/code.cpp"), 1u);
+    EXPECT_EQ(paths.count(".git/objects/blob.cpp"), 1u);
+    EXPECT_EQ(paths.count("src"), 0u);  // Directories only on request
+}
+
+TEST_F(DirectoryWalkerTest, FiltersByExtensionAndPrunesDirectories) {
+    WalkOptions options;
+    options.extensions = {".cpp"};
+    options.prune_directories = {"build", ".*"};
+    options.max_threads = 4;
+    
+    auto paths = walk(options);
+    EXPECT_EQ(paths.size(), 8u * 3u);
+    for (const auto& path : paths) {
+        EXPECT_EQ(path.rfind("src/", 0), 0u) << path;
+        EXPECT_EQ(path.substr(path.size() - 4), ".cpp") << path;
+    }
+}
+
+TEST_F(DirectoryWalkerTest, FiltersByGlobPattern) {
+    WalkOptions options;
+    options.patterns = {"*.txt"};
+    EXPECT_TRUE(walk(options).empty());
+    
+    options.case_insensitive = true;
+    EXPECT_EQ(walk(options).size(), 8u * 3u);
+}
+
+TEST_F(DirectoryWalkerTest, ReportsDirectoriesAndStopsAtTopLevel) {
+    WalkOptions options;
+    options.include_directories = true;
+    options.prune_directories = {"build", ".git"};
+    auto paths = walk(options);
+    EXPECT_EQ(paths.count("src"), 1u);
+    EXPECT_EQ(paths.count("src/module0/sub2"), 1u);
+    EXPECT_EQ(paths.count("build"), 0u);
+    
+    options.recursive = false;
+    EXPECT_EQ(walk(options), (std::set<std::string>{"src"}));
+}
+
+TEST_F(DirectoryWalkerTest, SingleThreadedWalkFindsTheSameFiles) {
+    WalkOptions options;
+    options.max_threads = 1;
+    auto single = walk(options);
+    options.max_threads = 8;
+    EXPECT_EQ(walk(options), single);
+}
+
+TEST_F(DirectoryWalkerTest, MissingRootFails) {
+    auto count = walk_directory(test_dir / "missing", WalkOptions{}, [](const auto&) {});
+    EXPECT_FALSE(count.has_value());
+}
+
+TEST_F(DirectoryWalkerTest, CallbackExceptionStopsTheWalk) {
+    std::atomic<int> calls{0};
+    WalkOptions options;
+    options.max_threads = 4;
+    EXPECT_THROW(walk_directory(test_dir, options, [&](const auto&) {
+        ++calls;
+        throw std::runtime_error("stop");
+    }), std::runtime_error);
+    EXPECT_GE(calls.load(), 1);
+    EXPECT_LT(calls.load(), 8 * 3 * 3);
+}
@@ -0,0 +1,179 @@
+#include "file_watcher.h"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace wip::utils::file;
+using namespace std::chrono_literals;
+
+class FileWatcherTest : public ::testing::TestWithParam<bool> {
+protected:
+    void SetUp() override {
+        test_dir = std::filesystem::temp_directory_path() / "file_watcher_test";
+        if (wip::utils::file::exists(test_dir)) {
+            wip::utils::file::remove_all(test_dir);
+        }
+        wip::utils::file::create_directories(test_dir / "src");
+        wip::utils::file::create_directories(test_dir / "build");
+        wip::utils::file::write_file(test_dir / "src" / "existing.cpp", "int x;");
+
+        options.filter.extensions = {".cpp", ".h"};
+        options.filter.prune_directories = {"build"};
+        options.debounce = 50ms;
+        options.max_delay = 1000ms;
+        options.poll_interval = 50ms;
+        options.force_polling = GetParam();
+    }
+
+    void TearDown() override {
+        watcher.reset();
+        if (wip::utils::file::exists(test_dir)) {
+            wip::utils::file::remove_all(test_dir);
+        }
+    }
+
+    void start() {
+        watcher = std::make_unique<FileWatcher>([this](const std::vector<FileChange>& changes) {
+            std::lock_guard<std::mutex> lock(mutex);
+            batches.push_back(changes);
+            received.notify_all();
+        }, options);
+        ASSERT_TRUE(watcher->watch(test_dir));
+    }
+
+    // Changes of all batches so far, keyed by path relative to the test directory
+    std::map<std::string, FileChangeType> wait_for_changes(size_t count) {
+        std::unique_lock<std::mutex> lock(mutex);
+        received.wait_for(lock, 10s, [&]() { return collected(lock).size() >= count; });
+        return collected(lock);
+    }
+
+    std::map<std::string, FileChangeType> collected(std::unique_lock<std::mutex>&) const {
+        std::map<std::string, FileChangeType> changes;
+        for (const auto& batch : batches) {
+            for (const auto& change : batch) {
+                changes[std::filesystem::relative(change.path, test_dir).generic_string()] = change.type;
+            }
+        }
+        return changes;
+    }
+
+    // Let the polling backend see separate modification times
+    void settle() {
+        std::this_thread::sleep_for(options.force_polling ? 150ms : 20ms);
+    }
+
+    std::filesystem::path test_dir;
+    FileWatcherOptions options;
+    std::unique_ptr<FileWatcher> watcher;
+
+    std::mutex mutex;
+    std::condition_variable received;
+    std::vector<std::vector<FileChange>> batches;
+};
+
+TEST_P(FileWatcherTest, ReportsCreatedModifiedAndRemovedFiles) {
+    start();
+    EXPECT_EQ(std::string(watcher->backend_name()), GetParam() ? "polling" : "inotify");
+
+    wip::utils::file::write_file(test_dir / "src" / "new.cpp", "int y;");
+    wip::utils::file::write_file(test_dir / "src" / "existing.cpp", "int x = 1;");
+    wip::utils::file::write_file(test_dir / "src" / "doomed.h", "");
+    wip::utils::file::remove_file(test_dir / "src" / "doomed.h");
+
+    auto changes = wait_for_changes(2);
+    EXPECT_EQ(changes["src/new.cpp"], FileChangeType::Created);
+    EXPECT_EQ(changes["src/existing.cpp"], FileChangeType::Modified);
+    EXPECT_EQ(changes.count("src/doomed.h"), 0u) << "created and removed within one batch";
+}
+
+TEST_P(FileWatcherTest, CoalescesBurstsIntoOneBatch) {
+    options.debounce = 300ms;
+    start();
+
+    for (int i = 0; i < 20; ++i) {
+        wip::utils::file::write_file(test_dir / "src" / "existing.cpp", "int x = " + std::to_string(i) + ";");
+    }
+    wip::utils::file::write_file(test_dir / "src" / "other.cpp", "");
+
+    auto changes = wait_for_changes(2);
+    EXPECT_EQ(changes.size(), 2u);
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(batches.size(), 1u);
+    EXPECT_EQ(batches[0].size(), 2u);
+    EXPECT_LT(batches[0][0].path, batches[0][1].path) << "batches are sorted by path";
+}
+
+TEST_P(FileWatcherTest, FiltersExtensionsAndPrunedDirectories) {
+    start();
+
+    wip::utils::file::write_file(test_dir / "build" / "generated.cpp", "");
+    wip::utils::file::write_file(test_dir / "src" / "notes.txt", "");
+    wip::utils::file::write_file(test_dir / "src" / "kept.h", "");
+
+    auto changes = wait_for_changes(1);
+    std::this_thread::sleep_for(200ms);
+    changes = wait_for_changes(1);
+    EXPECT_EQ(changes.size(), 1u);
+    EXPECT_EQ(changes["src/kept.h"], FileChangeType::Created);
+}
+
+TEST_P(FileWatcherTest, WatchesNewDirectories) {
+    start();
+
+    wip::utils::file::create_directories(test_dir / "src" / "module" / "nested");
+    wip::utils::file::write_file(test_dir / "src" / "module" / "nested" / "first.cpp", "");
+    settle();
+    wip::utils::file::write_file(test_dir / "src" / "module" / "second.cpp", "");
+
+    auto changes = wait_for_changes(2);
+    EXPECT_EQ(changes["src/module/nested/first.cpp"], FileChangeType::Created);
+    EXPECT_EQ(changes["src/module/second.cpp"], FileChangeType::Created);
+}
+
+TEST_P(FileWatcherTest, ReportsRenamesAsRemoveAndCreate) {
+    start();
+
+    std::filesystem::rename(test_dir / "src" / "existing.cpp", test_dir / "src" / "renamed.cpp");
+
+    auto changes = wait_for_changes(2);
+    EXPECT_EQ(changes["src/existing.cpp"], FileChangeType::Removed);
+    EXPECT_EQ(changes["src/renamed.cpp"], FileChangeType::Created);
+}
+
+TEST_P(FileWatcherTest, StopsDeliveringAfterStop) {
+    start();
+    watcher->stop();
+    EXPECT_FALSE(watcher->is_running());
+    EXPECT_FALSE(watcher->watch(test_dir));
+
+    wip::utils::file::write_file(test_dir / "src" / "late.cpp", "");
+    std::this_thread::sleep_for(200ms);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_TRUE(batches.empty());
+}
+
+TEST_P(FileWatcherTest, RejectsMissingDirectories) {
+    start();
+    EXPECT_FALSE(watcher->watch(test_dir / "missing"));
+}
+
+#ifdef __linux__
+INSTANTIATE_TEST_SUITE_P(Backends, FileWatcherTest, ::testing::Values(false, true),
+                         [](const ::testing::TestParamInfo<bool>& info) {
+                             return info.param ? "Polling" : "Native";
+                         });
+#else
+// The native backend's name differs per platform, so only the portable one is tested here
+INSTANTIATE_TEST_SUITE_P(Backends, FileWatcherTest, ::testing::Values(true),
+                         [](const ::testing::TestParamInfo<bool>&) { return std::string("Polling"); });
+#endif
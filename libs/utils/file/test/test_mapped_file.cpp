@@ -0,0 +1,154 @@
+#include "mapped_file.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace wip::utils::file;
+
+class MappedFileTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        test_dir = std::filesystem::temp_directory_path() / "mapped_file_test";
+        if (wip::utils::file::exists(test_dir)) {
+            wip::utils::file::remove_all(test_dir);
+        }
+        wip::utils::file::create_directories(test_dir);
+    }
+    
+    void TearDown() override {
+        if (wip::utils::file::exists(test_dir)) {
+            wip::utils::file::remove_all(test_dir);
+        }
+    }
+    
+    static std::vector<std::string> collect(LineRange range) {
+        std::vector<std::string> result;
+        for (std::string_view line : range) {
+            result.emplace_back(line);
+        }
+        return result;
+    }
+    
+    std::filesystem::path test_dir;
+};
+
+// ==================== Line Iteration Tests ====================
+
+TEST_F(MappedFileTest, LinesSplitLikeGetline) {
+    EXPECT_TRUE(collect(lines("")).empty());
+    EXPECT_EQ(collect(lines("one")), (std::vector<std::string>{"one"}));
+    EXPECT_EQ(collect(lines("one\n")), (std::vector<std::string>{"one"}));
+    EXPECT_EQ(collect(lines("\n")), (std::vector<std::string>{""}));
+    EXPECT_EQ(collect(lines("one\n\ntwo\nthree")), (std::vector<std::string>{"one", "", "two", "three"}));
+}
+
+TEST_F(MappedFileTest, LinesViewTheText) {
+    std::string text = "first\nsecond";
+    auto it = lines(text).begin();
+    EXPECT_EQ(it->data(), text.data());
+    ++it;
+    EXPECT_EQ(it->data(), text.data() + 6);
+    EXPECT_EQ(*it, "second");
+    EXPECT_EQ(++it, lines(text).end());
+}
+
+TEST_F(MappedFileTest, CountLinesMatchesLines) {
+    for (const char* text : {"", "one", "one\n", "\n", "one\n\ntwo\nthree"}) {
+        EXPECT_EQ(count_lines(text), collect(lines(text)).size()) << text;
+    }
+
+    // Long enough for every vector width, its lane counters and a tail at each offset
+    std::string text;
+    for (int i = 0; i < 20000; ++i) {
+        text += (i % 3 == 0) ? '\n' : static_cast<char>('a' + i % 26);
+    }
+    text += "\n\n\n";
+    for (size_t size : {size_t{15}, size_t{31}, size_t{33}, size_t{4095}, size_t{8161}, text.size()}) {
+        std::string_view part(text.data(), size);
+        EXPECT_EQ(count_lines(part), collect(lines(part)).size()) << size;
+        for (size_t offset = 1; offset < std::min<size_t>(size, 32); offset += 7) {
+            std::string_view shifted = part.substr(offset);
+            EXPECT_EQ(count_lines(shifted), collect(lines(shifted)).size()) << size << "+" << offset;
+        }
+    }
+}
+
+// ==================== Mapping Tests ====================
+
+TEST_F(MappedFileTest, MapsFileContent) {
+    std::string content;
+    for (int i = 0; i < 10000; ++i) {
+        content += "line " + std::to_string(i) + "\n";
+    }
+    auto path = test_dir / "large.txt";
+    ASSERT_TRUE(write_file(path, content));
+    
+    auto file = MappedFile::open(path);
+    ASSERT_TRUE(file.has_value());
+    EXPECT_TRUE(file->is_open());
+    EXPECT_EQ(file->size(), content.size());
+    EXPECT_EQ(file->view(), content);
+    
+    size_t count = 0;
+    for (std::string_view line : file->lines()) {
+        EXPECT_EQ(line, "line " + std::to_string(count));
+        ++count;
+    }
+    EXPECT_EQ(count, 10000u);
+    
+    // The same lines read_lines() produces
+    auto read = read_lines(path);
+    ASSERT_TRUE(read.has_value());
+    EXPECT_EQ(collect(file->lines()), *read);
+}
+
+TEST_F(MappedFileTest, EmptyFileHasEmptyView) {
+    auto path = test_dir / "empty.txt";
+    ASSERT_TRUE(write_file(path, ""));
+    
+    auto file = MappedFile::open(path);
+    ASSERT_TRUE(file.has_value());
+    EXPECT_TRUE(file->is_open());
+    EXPECT_TRUE(file->empty());
+    EXPECT_TRUE(file->view().empty());
+    EXPECT_EQ(file->lines().begin(), file->lines().end());
+}
+
+TEST_F(MappedFileTest, MissingFileOrDirectoryFails) {
+    EXPECT_FALSE(MappedFile::open(test_dir / "missing.txt").has_value());
+    EXPECT_FALSE(MappedFile::open(test_dir).has_value());
+}
+
+TEST_F(MappedFileTest, MoveTransfersMappingAndCloseReleasesIt) {
+    auto path = test_dir / "move.txt";
+    ASSERT_TRUE(write_file(path, "content"));
+    
+    auto opened = MappedFile::open(path);
+    ASSERT_TRUE(opened.has_value());
+    MappedFile file = std::move(*opened);
+    EXPECT_FALSE(opened->is_open());
+    EXPECT_TRUE(opened->view().empty());
+    EXPECT_EQ(file.view(), "content");
+    
+    MappedFile other;
+    other = std::move(file);
+    EXPECT_EQ(other.view(), "content");
+    
+    other.close();
+    EXPECT_FALSE(other.is_open());
+    EXPECT_TRUE(other.view().empty());
+}
+
+TEST_F(MappedFileTest, ReadFileMatchesMappedContent) {
+    std::string content(200000, 'x');
+    content += "\ntail";
+    auto path = test_dir / "read.txt";
+    ASSERT_TRUE(write_file(path, content));
+    
+    auto read = read_file(path);
+    ASSERT_TRUE(read.has_value());
+    EXPECT_EQ(*read, content);
+}
@@ -0,0 +1,157 @@
+#include "source_file_cache.h"
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <string>
+
+using namespace wip::utils::file;
+
+class SourceFileCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        test_dir = std::filesystem::temp_directory_path() / "source_file_cache_test";
+        if (wip::utils::file::exists(test_dir)) {
+            wip::utils::file::remove_all(test_dir);
+        }
+        wip::utils::file::create_directories(test_dir);
+    }
+    
+    void TearDown() override {
+        if (wip::utils::file::exists(test_dir)) {
+            wip::utils::file::remove_all(test_dir);
+        }
+    }
+    
+    Path create(const std::string& name, const std::string& content) {
+        Path path = test_dir / name;
+        write_file(path, content);
+        return path;
+    }
+    
+    std::filesystem::path test_dir;
+};
+
+// ==================== Source File Tests ====================
+
+TEST_F(SourceFileCacheTest, SourceFileIndexesLines) {
+    SourceFile file(create("main.cpp", "int main() {\r\n    return 0;\n\n}"));
+    
+    ASSERT_TRUE(file.is_open());
+    EXPECT_EQ(file.line_count(), 4u);
+    EXPECT_EQ(file.line(1), "int main() {");
+    EXPECT_EQ(file.line(2), "    return 0;");
+    EXPECT_EQ(file.line(3), "");
+    EXPECT_EQ(file.line(4), "}");
+    EXPECT_EQ(file.line(0), "");
+    EXPECT_EQ(file.line(5), "");
+    
+    // A final newline does not start another line
+    EXPECT_EQ(SourceFile(create("a.h", "#pragma once\n")).line_count(), 1u);
+    EXPECT_EQ(SourceFile(create("empty.h", "")).line_count(), 0u);
+}
+
+TEST_F(SourceFileCacheTest, MissingFileHasNoLines) {
+    SourceFile file(test_dir / "missing.cpp");
+    
+    EXPECT_FALSE(file.is_open());
+    EXPECT_EQ(file.line_count(), 0u);
+    EXPECT_EQ(file.line(1), "");
+}
+
+// ==================== Cache Tests ====================
+
+TEST_F(SourceFileCacheTest, FindLoadsInBackground) {
+    Path path = create("main.cpp", "first\nsecond\n");
+    SourceFileCache cache;
+    
+    // The first lookup only queues the file
+    EXPECT_EQ(cache.find(path), nullptr);
+    cache.wait_idle();
+    
+    auto file = cache.find(path);
+    ASSERT_NE(file, nullptr);
+    EXPECT_EQ(file->line(2), "second");
+    EXPECT_EQ(cache.find(path), file);
+    EXPECT_EQ(cache.size(), 1u);
+}
+
+TEST_F(SourceFileCacheTest, MissingFileIsCachedToo) {
+    SourceFileCache cache;
+    
+    EXPECT_EQ(cache.find(test_dir / "missing.cpp"), nullptr);
+    cache.wait_idle();
+    
+    auto file = cache.find(test_dir / "missing.cpp");
+    ASSERT_NE(file, nullptr);
+    EXPECT_FALSE(file->is_open());
+}
+
+TEST_F(SourceFileCacheTest, PrefetchLoadsAhead) {
+    Path path = create("next.cpp", "next\n");
+    SourceFileCache cache;
+    
+    cache.prefetch(path);
+    cache.prefetch(path);
+    cache.wait_idle();
+    
+    EXPECT_EQ(cache.size(), 1u);
+    ASSERT_NE(cache.find(path), nullptr);
+}
+
+TEST_F(SourceFileCacheTest, DropsLeastRecentlyFound) {
+    Path a = create("a.cpp", "a\n");
+    Path b = create("b.cpp", "b\n");
+    Path c = create("c.cpp", "c\n");
+    SourceFileCache cache(2);
+    
+    cache.prefetch(a);
+    cache.prefetch(b);
+    cache.wait_idle();
+    
+    // Finding a makes b the least recently used
+    auto kept = cache.find(a);
+    ASSERT_NE(kept, nullptr);
+    cache.prefetch(c);
+    cache.wait_idle();
+    
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_NE(cache.find(a), nullptr);
+    EXPECT_NE(cache.find(c), nullptr);
+    EXPECT_EQ(cache.find(b), nullptr);
+}
+
+TEST_F(SourceFileCacheTest, InvalidateReloadsFile) {
+    Path path = create("main.cpp", "old\n");
+    SourceFileCache cache;
+    cache.find(path);
+    cache.wait_idle();
+    auto old_file = cache.find(path);
+    ASSERT_NE(old_file, nullptr);
+    
+    // Replace the file instead of truncating it, since the old one is still mapped
+    Path replacement = create("replacement.cpp", "new\nlines\n");
+    std::filesystem::rename(replacement, path);
+    cache.invalidate(path);
+    EXPECT_EQ(cache.find(path), nullptr);
+    cache.wait_idle();
+    
+    auto new_file = cache.find(path);
+    ASSERT_NE(new_file, nullptr);
+    EXPECT_EQ(new_file->line(1), "new");
+    EXPECT_EQ(new_file->line_count(), 2u);
+    
+    // Files handed out stay valid
+    EXPECT_EQ(old_file->line(1), "old");
+}
+
+TEST_F(SourceFileCacheTest, ClearDropsEverything) {
+    Path path = create("main.cpp", "text\n");
+    SourceFileCache cache;
+    cache.prefetch(path);
+    cache.wait_idle();
+    ASSERT_EQ(cache.size(), 1u);
+    
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_EQ(cache.find(path), nullptr);
+}
@@ -0,0 +1,108 @@
+// Benchmark for content hashing.
+//
+// Reports the throughput of hash128() in GB/s for inputs from a short line up
+// to a large file, next to std::hash<std::string_view> and the FNV-1a loop the
+// analysis cache used before, and the throughput of hash_files() on a
+// directory of generated files with one thread and with all threads. Usage:
+//
+//   bench_wip_utils_hash [megabytes] [files]
+
+#include "benchmark.h"
+#include "hash.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace wip::utils::hash;
+
+namespace {
+
+uint64_t fnv1a(std::string_view data) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Hash the buffer in pieces of the given size until about total_bytes were hashed, in GB/s
+template <typename HashFunction>
+double throughput(const std::string& buffer, size_t piece, size_t total_bytes, HashFunction hash) {
+    size_t rounds = std::max<size_t>(1, total_bytes / piece);
+    uint64_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < rounds; ++i) {
+        size_t offset = (i * piece) % (buffer.size() - piece + 1);
+        sink += hash(std::string_view(buffer.data() + offset, piece));
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    wip::benchmark::do_not_optimize(sink);
+    return static_cast<double>(rounds * piece) / seconds / 1e9;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    wip::benchmark::Runner runner("bench_wip_utils_hash", argc, argv, "[megabytes] [files]");
+    size_t megabytes = runner.argument(0, 256);
+    size_t file_count = runner.argument(1, 2000);
+    size_t total_bytes = megabytes * 1024 * 1024;
+
+    std::mt19937_64 rng(1);
+    std::string buffer(64 * 1024 * 1024, '\0');
+    for (size_t i = 0; i + 8 <= buffer.size(); i += 8) {
+        uint64_t value = rng();
+        std::copy(reinterpret_cast<const char*>(&value), reinterpret_cast<const char*>(&value) + 8, &buffer[i]);
+    }
+
+    runner.out() << "Hashing " << megabytes << " MiB per size, stripe loop: " << simd_backend() << std::endl;
+    for (size_t piece : {16u, 100u, 1024u, 64u * 1024u, 16u * 1024u * 1024u}) {
+        const std::string size = std::to_string(piece) + " B";
+        if (runner.selected("hash128, " + size)) {
+            runner.report("hash128, " + size,
+                          throughput(buffer, piece, total_bytes, [](std::string_view data) { return hash64(data); }), "GB/s");
+        }
+        if (runner.selected("std::hash, " + size)) {
+            runner.report("std::hash, " + size,
+                          throughput(buffer, piece, total_bytes, std::hash<std::string_view>()), "GB/s");
+        }
+        if (runner.selected("fnv1a, " + size)) {
+            runner.report("fnv1a, " + size, throughput(buffer, piece, total_bytes / 8, fnv1a), "GB/s");
+        }
+    }
+
+    // Source-file-sized inputs on disk, hashed through memory mappings
+    auto directory = std::filesystem::temp_directory_path() / "bench_wip_utils_hash";
+    std::filesystem::create_directories(directory);
+    std::vector<std::filesystem::path> paths;
+    size_t file_bytes = 0;
+    for (size_t i = 0; i < file_count; ++i) {
+        size_t size = 4096 + rng() % (64 * 1024);
+        paths.push_back(directory / ("file" + std::to_string(i) + ".cpp"));
+        std::ofstream(paths.back(), std::ios::binary).write(buffer.data() + (i * 4096) % buffer.size() / 2, static_cast<std::streamsize>(size));
+        file_bytes += size;
+    }
+
+    std::vector<size_t> thread_counts{1};
+    if (std::thread::hardware_concurrency() > 1) {
+        thread_counts.push_back(std::thread::hardware_concurrency());
+    }
+    for (size_t threads : thread_counts) {
+        const std::string name = "hash_files, " + std::to_string(threads) + " thread(s)";
+        if (!runner.selected(name)) continue;
+        auto start = std::chrono::steady_clock::now();
+        auto results = hash_files(paths, threads);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        runner.report(name, file_bytes / seconds / 1e9, "GB/s");
+    }
+
+    std::filesystem::remove_all(directory);
+    return runner.finish();
+}
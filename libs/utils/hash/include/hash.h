@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace wip::utils::hash {
+
+/**
+ * @brief 128-bit hash value
+ */
+struct Hash128 {
+    uint64_t low = 0;
+    uint64_t high = 0;
+
+    bool operator==(const Hash128& other) const noexcept { return low == other.low && high == other.high; }
+    bool operator!=(const Hash128& other) const noexcept { return !(*this == other); }
+    bool operator<(const Hash128& other) const noexcept {
+        return high != other.high ? high < other.high : low < other.low;
+    }
+
+    /**
+     * @brief Format as 32 lowercase hexadecimal digits, high half first
+     */
+    std::string to_hex() const;
+};
+
+/**
+ * @brief Streaming non-cryptographic hasher producing 64- and 128-bit hashes
+ *
+ * The algorithm follows the design of XXH3: the input is consumed in 64-byte
+ * stripes by eight independent 64-bit accumulators, each stripe costing one
+ * 32x32->64-bit multiplication and two additions per accumulator, and the
+ * accumulators are scrambled after every 1 KiB block. The stripe loop uses
+ * AVX2 where the CPU supports it, SSE2 on other x86-64 CPUs and portable code
+ * elsewhere; all paths give the same result, and hashes are identical across
+ * platforms, so they can be stored and compared later. It is not compatible
+ * with the reference xxHash implementation and must not be used where an
+ * attacker chooses the input to provoke collisions.
+ *
+ * Feeding the input in any number of update() calls gives the same hash as
+ * hash128() on the whole input.
+ *
+ * Example:
+ * ```cpp
+ * Hasher hasher;
+ * hasher.update(header).update(body);
+ * std::string key = hasher.digest128().to_hex();
+ * ```
+ */
+class Hasher {
+public:
+    static constexpr size_t STRIPE_SIZE = 64;
+    static constexpr size_t BLOCK_SIZE = 1024;
+
+    Hasher() noexcept;
+
+    /**
+     * @brief Start over with an empty input
+     */
+    void reset() noexcept;
+
+    /**
+     * @brief Append data to the hashed input
+     */
+    Hasher& update(const void* data, size_t size) noexcept;
+    Hasher& update(std::string_view data) noexcept { return update(data.data(), data.size()); }
+
+    /**
+     * @brief Hash of the input so far; more data can still be appended afterwards
+     */
+    Hash128 digest128() const noexcept;
+
+    /**
+     * @brief 64-bit hash of the input so far, the low half of digest128()
+     */
+    uint64_t digest64() const noexcept { return digest128().low; }
+
+private:
+    alignas(32) uint64_t accumulators_[8];
+    alignas(32) unsigned char buffer_[BLOCK_SIZE];   // Input not consumed yet; starts at a block boundary
+    unsigned char last_stripe_[STRIPE_SIZE];         // End of the consumed input, for short final blocks
+    size_t buffered_ = 0;
+    uint64_t total_size_ = 0;
+};
+
+/**
+ * @brief Hash data in one call
+ */
+Hash128 hash128(std::string_view data) noexcept;
+
+/**
+ * @brief 64-bit hash of data, the low half of hash128()
+ */
+inline uint64_t hash64(std::string_view data) noexcept {
+    return hash128(data).low;
+}
+
+/**
+ * @brief Hash a file's content through a memory mapping
+ * @param path File to hash
+ * @return Hash of the content, or nullopt if the file cannot be read
+ */
+std::optional<Hash128> hash_file(const std::filesystem::path& path) noexcept;
+
+/**
+ * @brief Hash many files in parallel
+ *
+ * The calling thread takes part in the work.
+ *
+ * @param paths Files to hash
+ * @param max_threads Threads including the caller; 0 uses the hardware concurrency
+ * @return One result per path, in the order of paths
+ */
+std::vector<std::optional<Hash128>> hash_files(const std::vector<std::filesystem::path>& paths, size_t max_threads = 0);
+
+/**
+ * @brief Name of the stripe loop selected for this CPU ("avx2", "sse2" or "portable")
+ */
+const char* simd_backend() noexcept;
+
+}  // namespace wip::utils::hash
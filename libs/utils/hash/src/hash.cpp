@@ -0,0 +1,456 @@
+#include "hash.h"
+
+#include <file.h>
+#include <mapped_file.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <system_error>
+#include <thread>
+
+#if (defined(__x86_64__) || defined(_M_X64)) && !defined(WIP_HASH_PORTABLE)
+#define WIP_HASH_SSE2 1
+#include <emmintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define WIP_HASH_AVX2 1
+#include <immintrin.h>
+#endif
+#endif
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace wip::utils::hash {
+
+namespace {
+
+constexpr uint64_t PRIME32_1 = 0x9E3779B1ULL;
+constexpr uint64_t PRIME32_2 = 0x85EBCA77ULL;
+constexpr uint64_t PRIME32_3 = 0xC2B2AE3DULL;
+constexpr uint64_t PRIME64_1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t PRIME64_3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t PRIME64_5 = 0x27D4EB2F165667C5ULL;
+
+constexpr size_t STRIPE_SIZE = Hasher::STRIPE_SIZE;
+constexpr size_t BLOCK_SIZE = Hasher::BLOCK_SIZE;
+constexpr size_t STRIPES_PER_BLOCK = BLOCK_SIZE / STRIPE_SIZE;
+constexpr size_t SHORT_INPUT = STRIPE_SIZE;
+
+// Offsets into the secret; stripe n of a block is keyed with the words from n on
+constexpr size_t SECRET_WORDS = 32;
+constexpr size_t SCRAMBLE_KEY = 24;
+constexpr size_t LAST_STRIPE_KEY = 17;
+constexpr size_t MERGE_LOW_KEY = 11;
+constexpr size_t MERGE_HIGH_KEY = 3;
+
+// Key material: a splitmix64 sequence, fixed forever since hashes are persisted
+constexpr std::array<uint64_t, SECRET_WORDS> make_secret() {
+    std::array<uint64_t, SECRET_WORDS> secret{};
+    uint64_t state = 0x243F6A8885A308D3ULL;
+    for (size_t i = 0; i < SECRET_WORDS; ++i) {
+        state += 0x9E3779B97F4A7C15ULL;
+        uint64_t z = state;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        secret[i] = z ^ (z >> 31);
+    }
+    return secret;
+}
+
+alignas(32) constexpr std::array<uint64_t, SECRET_WORDS> SECRET = make_secret();
+
+constexpr uint64_t INITIAL_ACCUMULATORS[8] = {
+    PRIME32_3, PRIME64_1, PRIME64_2, PRIME64_3, PRIME64_4, PRIME32_2, PRIME64_5, PRIME32_1
+};
+
+inline uint64_t read64(const unsigned char* data) noexcept {
+    uint64_t value;
+    std::memcpy(&value, data, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap64(value);
+#endif
+    return value;
+}
+
+inline uint32_t read32(const unsigned char* data) noexcept {
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap32(value);
+#endif
+    return value;
+}
+
+inline uint64_t rotl(uint64_t value, int bits) noexcept {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+// Both halves of the 128-bit product, folded together
+inline uint64_t multiply_fold(uint64_t a, uint64_t b) noexcept {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+    return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    uint64_t high;
+    uint64_t low = _umul128(a, b, &high);
+    return low ^ high;
+#else
+    uint64_t a_low = a & 0xFFFFFFFF, a_high = a >> 32;
+    uint64_t b_low = b & 0xFFFFFFFF, b_high = b >> 32;
+    uint64_t low_low = a_low * b_low;
+    uint64_t high_low = a_high * b_low;
+    uint64_t low_high = a_low * b_high;
+    uint64_t high_high = a_high * b_high;
+    uint64_t cross = (low_low >> 32) + (high_low & 0xFFFFFFFF) + low_high;
+    uint64_t high = (high_low >> 32) + (cross >> 32) + high_high;
+    uint64_t low = (cross << 32) | (low_low & 0xFFFFFFFF);
+    return low ^ high;
+#endif
+}
+
+inline uint64_t avalanche(uint64_t hash) noexcept {
+    hash ^= hash >> 33;
+    hash *= PRIME64_2;
+    hash ^= hash >> 29;
+    hash *= PRIME64_3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+// ==================== Stripe Loops ====================
+
+inline void accumulate_stripe(uint64_t* accumulators, const unsigned char* data, const uint64_t* key) noexcept {
+    for (size_t i = 0; i < 8; ++i) {
+        uint64_t value = read64(data + 8 * i);
+        uint64_t keyed = value ^ key[i];
+        accumulators[i ^ 1] += value;
+        accumulators[i] += (keyed & 0xFFFFFFFF) * (keyed >> 32);
+    }
+}
+
+inline void scramble(uint64_t* accumulators, const uint64_t* key) noexcept {
+    for (size_t i = 0; i < 8; ++i) {
+        uint64_t value = accumulators[i];
+        value ^= value >> 47;
+        value ^= key[i];
+        accumulators[i] = value * PRIME32_1;
+    }
+}
+
+void consume_blocks_portable(uint64_t* accumulators, const unsigned char* data, size_t blocks) noexcept {
+    for (size_t block = 0; block < blocks; ++block, data += BLOCK_SIZE) {
+        for (size_t stripe = 0; stripe < STRIPES_PER_BLOCK; ++stripe) {
+            accumulate_stripe(accumulators, data + stripe * STRIPE_SIZE, SECRET.data() + stripe);
+        }
+        scramble(accumulators, SECRET.data() + SCRAMBLE_KEY);
+    }
+}
+
+#ifdef WIP_HASH_SSE2
+void consume_blocks_sse2(uint64_t* accumulators, const unsigned char* data, size_t blocks) noexcept {
+    __m128i acc[4];
+    for (size_t j = 0; j < 4; ++j) {
+        acc[j] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(accumulators) + j);
+    }
+    const __m128i prime = _mm_set1_epi64x(static_cast<long long>(PRIME32_1));
+
+    for (size_t block = 0; block < blocks; ++block, data += BLOCK_SIZE) {
+        for (size_t stripe = 0; stripe < STRIPES_PER_BLOCK; ++stripe) {
+            const auto* input = reinterpret_cast<const __m128i*>(data + stripe * STRIPE_SIZE);
+            const auto* key = reinterpret_cast<const __m128i*>(SECRET.data() + stripe);
+            for (size_t j = 0; j < 4; ++j) {
+                __m128i value = _mm_loadu_si128(input + j);
+                __m128i keyed = _mm_xor_si128(value, _mm_loadu_si128(key + j));
+                // Low 32 bits times high 32 bits of each lane; the value goes to the neighbouring lane
+                __m128i product = _mm_mul_epu32(keyed, _mm_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1)));
+                __m128i swapped = _mm_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2));
+                acc[j] = _mm_add_epi64(acc[j], _mm_add_epi64(product, swapped));
+            }
+        }
+
+        const auto* key = reinterpret_cast<const __m128i*>(SECRET.data() + SCRAMBLE_KEY);
+        for (size_t j = 0; j < 4; ++j) {
+            __m128i value = _mm_xor_si128(acc[j], _mm_srli_epi64(acc[j], 47));
+            value = _mm_xor_si128(value, _mm_loadu_si128(key + j));
+            __m128i low = _mm_mul_epu32(value, prime);
+            __m128i high = _mm_mul_epu32(_mm_srli_epi64(value, 32), prime);
+            acc[j] = _mm_add_epi64(low, _mm_slli_epi64(high, 32));
+        }
+    }
+
+    for (size_t j = 0; j < 4; ++j) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(accumulators) + j, acc[j]);
+    }
+}
+#endif
+
+#ifdef WIP_HASH_AVX2
+__attribute__((target("avx2")))
+void consume_blocks_avx2(uint64_t* accumulators, const unsigned char* data, size_t blocks) noexcept {
+    __m256i acc[2];
+    for (size_t j = 0; j < 2; ++j) {
+        acc[j] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(accumulators) + j);
+    }
+    const __m256i prime = _mm256_set1_epi64x(static_cast<long long>(PRIME32_1));
+
+    for (size_t block = 0; block < blocks; ++block, data += BLOCK_SIZE) {
+        for (size_t stripe = 0; stripe < STRIPES_PER_BLOCK; ++stripe) {
+            const auto* input = reinterpret_cast<const __m256i*>(data + stripe * STRIPE_SIZE);
+            const auto* key = reinterpret_cast<const __m256i*>(SECRET.data() + stripe);
+            for (size_t j = 0; j < 2; ++j) {
+                __m256i value = _mm256_loadu_si256(input + j);
+                __m256i keyed = _mm256_xor_si256(value, _mm256_loadu_si256(key + j));
+                __m256i product = _mm256_mul_epu32(keyed, _mm256_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1)));
+                __m256i swapped = _mm256_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2));
+                acc[j] = _mm256_add_epi64(acc[j], _mm256_add_epi64(product, swapped));
+            }
+        }
+
+        const auto* key = reinterpret_cast<const __m256i*>(SECRET.data() + SCRAMBLE_KEY);
+        for (size_t j = 0; j < 2; ++j) {
+            __m256i value = _mm256_xor_si256(acc[j], _mm256_srli_epi64(acc[j], 47));
+            value = _mm256_xor_si256(value, _mm256_loadu_si256(key + j));
+            __m256i low = _mm256_mul_epu32(value, prime);
+            __m256i high = _mm256_mul_epu32(_mm256_srli_epi64(value, 32), prime);
+            acc[j] = _mm256_add_epi64(low, _mm256_slli_epi64(high, 32));
+        }
+    }
+
+    for (size_t j = 0; j < 2; ++j) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(accumulators) + j, acc[j]);
+    }
+}
+#endif
+
+using ConsumeBlocks = void (*)(uint64_t*, const unsigned char*, size_t) noexcept;
+
+struct StripeLoop {
+    ConsumeBlocks consume;
+    const char* name;
+};
+
+StripeLoop select_stripe_loop() noexcept {
+#ifdef WIP_HASH_AVX2
+    if (__builtin_cpu_supports("avx2")) {
+        return {consume_blocks_avx2, "avx2"};
+    }
+#endif
+#ifdef WIP_HASH_SSE2
+    return {consume_blocks_sse2, "sse2"};
+#else
+    return {consume_blocks_portable, "portable"};
+#endif
+}
+
+const StripeLoop& stripe_loop() noexcept {
+    static const StripeLoop loop = select_stripe_loop();
+    return loop;
+}
+
+// ==================== Finalization ====================
+
+// Inputs up to one stripe: two independently keyed multiply-rotate chains
+uint64_t hash_short(const unsigned char* data, size_t size, const uint64_t* key, uint64_t seed) noexcept {
+    uint64_t hash = seed + size * PRIME64_5;
+    size_t word = 0;
+    for (; size >= 8; data += 8, size -= 8, ++word) {
+        uint64_t value = (read64(data) ^ key[word]) * PRIME64_2;
+        hash ^= rotl(value, 31) * PRIME64_1;
+        hash = rotl(hash, 27) * PRIME64_1 + PRIME64_4;
+    }
+    if (size >= 4) {
+        hash ^= (read32(data) ^ (key[word] & 0xFFFFFFFF)) * PRIME64_1;
+        hash = rotl(hash, 23) * PRIME64_2 + PRIME64_3;
+        data += 4;
+        size -= 4;
+    }
+    for (; size > 0; ++data, --size) {
+        hash ^= *data * PRIME64_5;
+        hash = rotl(hash, 11) * PRIME64_1;
+    }
+    return avalanche(hash);
+}
+
+Hash128 finish_short(const unsigned char* data, size_t size) noexcept {
+    return Hash128{hash_short(data, size, SECRET.data(), SECRET[16]),
+                   hash_short(data, size, SECRET.data() + 8, SECRET[24])};
+}
+
+uint64_t merge(const uint64_t* accumulators, const uint64_t* key, uint64_t start) noexcept {
+    uint64_t result = start;
+    for (size_t i = 0; i < 4; ++i) {
+        result += multiply_fold(accumulators[2 * i] ^ key[2 * i], accumulators[2 * i + 1] ^ key[2 * i + 1]);
+    }
+    return avalanche(result);
+}
+
+// Hash longer inputs from the accumulators after all full blocks but the last
+// rest: the remaining 1..BLOCK_SIZE bytes; last_stripe: the final STRIPE_SIZE bytes of the input
+Hash128 finish_long(uint64_t* accumulators, const unsigned char* rest, size_t rest_size,
+                    const unsigned char* last_stripe, uint64_t total_size) noexcept {
+    size_t stripes = (rest_size - 1) / STRIPE_SIZE;
+    for (size_t stripe = 0; stripe < stripes; ++stripe) {
+        accumulate_stripe(accumulators, rest + stripe * STRIPE_SIZE, SECRET.data() + stripe);
+    }
+    accumulate_stripe(accumulators, last_stripe, SECRET.data() + LAST_STRIPE_KEY);
+
+    return Hash128{merge(accumulators, SECRET.data() + MERGE_LOW_KEY, total_size * PRIME64_1),
+                   merge(accumulators, SECRET.data() + MERGE_HIGH_KEY, ~(total_size * PRIME64_2))};
+}
+
+} // namespace
+
+std::string Hash128::to_hex() const {
+    static const char* digits = "0123456789abcdef";
+    std::string hex(32, '0');
+    uint64_t halves[2] = {high, low};
+    for (size_t half = 0; half < 2; ++half) {
+        uint64_t value = halves[half];
+        for (size_t i = 0; i < 16; ++i) {
+            hex[half * 16 + 15 - i] = digits[value & 0xF];
+            value >>= 4;
+        }
+    }
+    return hex;
+}
+
+// ==================== Hasher ====================
+
+Hasher::Hasher() noexcept {
+    reset();
+}
+
+void Hasher::reset() noexcept {
+    std::memcpy(accumulators_, INITIAL_ACCUMULATORS, sizeof(accumulators_));
+    buffered_ = 0;
+    total_size_ = 0;
+}
+
+Hasher& Hasher::update(const void* data, size_t size) noexcept {
+    const auto* input = static_cast<const unsigned char*>(data);
+    total_size_ += size;
+
+    // A full block is only consumed once more input follows, so the final block is always buffered
+    if (buffered_ + size <= BLOCK_SIZE) {
+        if (size > 0) {
+            std::memcpy(buffer_ + buffered_, input, size);
+            buffered_ += size;
+        }
+        return *this;
+    }
+
+    if (buffered_ > 0) {
+        size_t fill = BLOCK_SIZE - buffered_;
+        std::memcpy(buffer_ + buffered_, input, fill);
+        input += fill;
+        size -= fill;
+        stripe_loop().consume(accumulators_, buffer_, 1);
+        std::memcpy(last_stripe_, buffer_ + BLOCK_SIZE - STRIPE_SIZE, STRIPE_SIZE);
+        buffered_ = 0;
+    }
+
+    if (size > BLOCK_SIZE) {
+        size_t blocks = (size - 1) / BLOCK_SIZE;
+        stripe_loop().consume(accumulators_, input, blocks);
+        input += blocks * BLOCK_SIZE;
+        size -= blocks * BLOCK_SIZE;
+        std::memcpy(last_stripe_, input - STRIPE_SIZE, STRIPE_SIZE);
+    }
+
+    std::memcpy(buffer_, input, size);
+    buffered_ = size;
+    return *this;
+}
+
+Hash128 Hasher::digest128() const noexcept {
+    if (total_size_ <= SHORT_INPUT) {
+        return finish_short(buffer_, buffered_);
+    }
+
+    // The final stripe may reach back into the consumed input
+    unsigned char joined[STRIPE_SIZE];
+    const unsigned char* last_stripe = buffer_ + buffered_ - STRIPE_SIZE;
+    if (buffered_ < STRIPE_SIZE) {
+        size_t previous = STRIPE_SIZE - buffered_;
+        std::memcpy(joined, last_stripe_ + buffered_, previous);
+        std::memcpy(joined + previous, buffer_, buffered_);
+        last_stripe = joined;
+    }
+
+    alignas(32) uint64_t accumulators[8];
+    std::memcpy(accumulators, accumulators_, sizeof(accumulators));
+    return finish_long(accumulators, buffer_, buffered_, last_stripe, total_size_);
+}
+
+// ==================== One-Shot Hashing ====================
+
+Hash128 hash128(std::string_view data) noexcept {
+    const auto* input = reinterpret_cast<const unsigned char*>(data.data());
+    size_t size = data.size();
+    if (size <= SHORT_INPUT) {
+        return finish_short(input, size);
+    }
+
+    alignas(32) uint64_t accumulators[8];
+    std::memcpy(accumulators, INITIAL_ACCUMULATORS, sizeof(accumulators));
+    size_t blocks = (size - 1) / BLOCK_SIZE;
+    stripe_loop().consume(accumulators, input, blocks);
+
+    size_t consumed = blocks * BLOCK_SIZE;
+    return finish_long(accumulators, input + consumed, size - consumed, input + size - STRIPE_SIZE, size);
+}
+
+std::optional<Hash128> hash_file(const std::filesystem::path& path) noexcept {
+    auto mapped = file::MappedFile::open(path);
+    if (!mapped) {
+        return std::nullopt;
+    }
+    if (!mapped->empty()) {
+        return hash128(mapped->view());
+    }
+
+    // Empty, or a file whose size is not reported (such as those in /proc)
+    auto content = file::read_file(path);
+    if (!content) {
+        return std::nullopt;
+    }
+    return hash128(*content);
+}
+
+std::vector<std::optional<Hash128>> hash_files(const std::vector<std::filesystem::path>& paths, size_t max_threads) {
+    std::vector<std::optional<Hash128>> results(paths.size());
+    std::atomic<size_t> next{0};
+    auto work = [&]() {
+        for (size_t i = next.fetch_add(1); i < paths.size(); i = next.fetch_add(1)) {
+            results[i] = hash_file(paths[i]);
+        }
+    };
+
+    size_t thread_count = max_threads > 0 ? max_threads : std::thread::hardware_concurrency();
+    thread_count = std::max<size_t>(1, std::min(thread_count, paths.size()));
+
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < thread_count; ++i) {
+        try {
+            threads.emplace_back(work);
+        } catch (const std::system_error&) {
+            break; // The threads already running share the files
+        }
+    }
+    work();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return results;
+}
+
+const char* simd_backend() noexcept {
+    return stripe_loop().name;
+}
+
+}  // namespace wip::utils::hash
@@ -0,0 +1,187 @@
+#include "hash.h"
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace wip::utils::hash;
+
+namespace {
+
+std::string random_bytes(size_t size, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::string data(size, '\0');
+    for (auto& c : data) {
+        c = static_cast<char>(rng() & 0xFF);
+    }
+    return data;
+}
+
+int bit_difference(const Hash128& a, const Hash128& b) {
+    int bits = 0;
+    for (uint64_t x : {a.low ^ b.low, a.high ^ b.high}) {
+        for (; x != 0; x &= x - 1) {
+            ++bits;
+        }
+    }
+    return bits;
+}
+
+} // namespace
+
+TEST(HashTest, KnownValuesAreStable) {
+    // Hashes are persisted in caches, so they must never change across versions or platforms
+    EXPECT_EQ(hash128("").to_hex(), "2ff5161c5cc566ff68013efac61967ef");
+    EXPECT_EQ(hash128("hello world").to_hex(), "4b041b0e7a1a975403f2ec52c18de292");
+    EXPECT_EQ(hash128(std::string(5000, 'x')).to_hex(), "e6140fa83b69242e46c4516bd3eb5daa");
+}
+
+TEST(HashTest, Hash64IsLowHalf) {
+    std::string data = random_bytes(3000, 1);
+    EXPECT_EQ(hash64(data), hash128(data).low);
+
+    Hasher hasher;
+    hasher.update(data);
+    EXPECT_EQ(hasher.digest64(), hash64(data));
+}
+
+TEST(HashTest, StreamingMatchesOneShotForAllSizes) {
+    std::string data = random_bytes(3 * Hasher::BLOCK_SIZE + 100, 2);
+    std::mt19937 rng(3);
+
+    for (size_t size = 0; size <= data.size(); ++size) {
+        std::string_view input(data.data(), size);
+        Hash128 expected = hash128(input);
+
+        // Random chunking, including empty updates and chunks larger than a block
+        Hasher hasher;
+        size_t position = 0;
+        while (position < size) {
+            size_t chunk = std::min<size_t>(size - position, rng() % (Hasher::BLOCK_SIZE + 200));
+            hasher.update(input.substr(position, chunk));
+            position += chunk;
+        }
+        ASSERT_EQ(hasher.digest128(), expected) << "size " << size;
+    }
+}
+
+TEST(HashTest, DigestDoesNotEndTheStream) {
+    std::string data = random_bytes(2500, 4);
+    Hasher hasher;
+    hasher.update(std::string_view(data).substr(0, 1000));
+    EXPECT_EQ(hasher.digest128(), hash128(std::string_view(data).substr(0, 1000)));
+    hasher.update(std::string_view(data).substr(1000));
+    EXPECT_EQ(hasher.digest128(), hash128(data));
+
+    hasher.reset();
+    EXPECT_EQ(hasher.digest128(), hash128(""));
+}
+
+TEST(HashTest, DistinguishesSimilarInputs) {
+    std::set<Hash128> hashes;
+    std::set<uint64_t> lows;
+    std::set<uint64_t> highs;
+    std::string data = random_bytes(2100, 5);
+
+    // Every prefix length, and every single-byte change of one input
+    for (size_t size = 0; size <= data.size(); ++size) {
+        Hash128 hash = hash128(std::string_view(data.data(), size));
+        hashes.insert(hash);
+        lows.insert(hash.low);
+        highs.insert(hash.high);
+    }
+    for (size_t i = 0; i < data.size(); ++i) {
+        std::string changed = data;
+        changed[i] ^= 1;
+        hashes.insert(hash128(changed));
+    }
+    EXPECT_EQ(hashes.size(), 2 * data.size() + 1);
+    EXPECT_EQ(lows.size(), data.size() + 1);
+    EXPECT_EQ(highs.size(), data.size() + 1);
+
+    // Zero-filled inputs differ only in length
+    EXPECT_NE(hash128(std::string(64, '\0')), hash128(std::string(65, '\0')));
+    EXPECT_NE(hash128(std::string(1024, '\0')), hash128(std::string(1025, '\0')));
+}
+
+TEST(HashTest, FlippedBitChangesAboutHalfTheHash) {
+    for (size_t size : {8u, 40u, 64u, 200u, 5000u}) {
+        std::string data = random_bytes(size, static_cast<uint32_t>(size));
+        Hash128 original = hash128(data);
+
+        long total = 0;
+        int samples = 0;
+        for (size_t bit = 0; bit < size * 8; bit += 3) {
+            std::string changed = data;
+            changed[bit / 8] ^= static_cast<char>(1 << (bit % 8));
+            total += bit_difference(original, hash128(changed));
+            ++samples;
+        }
+        double average = static_cast<double>(total) / samples;
+        EXPECT_GT(average, 58.0) << "size " << size;
+        EXPECT_LT(average, 70.0) << "size " << size;
+    }
+}
+
+TEST(HashTest, FormatsHex) {
+    Hash128 hash{0x0123456789abcdefULL, 0xfedcba9876543210ULL};
+    EXPECT_EQ(hash.to_hex(), "fedcba98765432100123456789abcdef");
+    EXPECT_EQ(Hash128{}.to_hex(), std::string(32, '0'));
+}
+
+TEST(HashTest, ReportsSimdBackend) {
+    std::string backend = simd_backend();
+    EXPECT_TRUE(backend == "avx2" || backend == "sse2" || backend == "portable") << backend;
+}
+
+class HashFileTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        test_dir = std::filesystem::temp_directory_path() / "hash_test";
+        std::filesystem::remove_all(test_dir);
+        std::filesystem::create_directories(test_dir);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(test_dir);
+    }
+
+    std::filesystem::path write(const std::string& name, const std::string& content) {
+        auto path = test_dir / name;
+        std::ofstream(path, std::ios::binary) << content;
+        return path;
+    }
+
+    std::filesystem::path test_dir;
+};
+
+TEST_F(HashFileTest, HashesFileContent) {
+    std::string content = random_bytes(100000, 6);
+    EXPECT_EQ(hash_file(write("data.bin", content)), hash128(content));
+    EXPECT_EQ(hash_file(write("empty.bin", "")), hash128(""));
+    EXPECT_FALSE(hash_file(test_dir / "missing.bin").has_value());
+}
+
+TEST_F(HashFileTest, HashesBatchesInOrder) {
+    std::vector<std::filesystem::path> paths;
+    std::vector<std::string> contents;
+    for (int i = 0; i < 50; ++i) {
+        contents.push_back(random_bytes(static_cast<size_t>(i) * 997, static_cast<uint32_t>(i)));
+        paths.push_back(write("file" + std::to_string(i), contents.back()));
+    }
+    paths.push_back(test_dir / "missing");
+
+    for (size_t threads : {1u, 4u, 0u}) {
+        auto results = hash_files(paths, threads);
+        ASSERT_EQ(results.size(), paths.size());
+        for (size_t i = 0; i < contents.size(); ++i) {
+            EXPECT_EQ(results[i], hash128(contents[i])) << "file " << i << " with " << threads << " threads";
+        }
+        EXPECT_FALSE(results.back().has_value());
+    }
+    EXPECT_TRUE(hash_files({}).empty());
+}
@@ -0,0 +1,88 @@
+// Benchmark for logging.
+//
+// Logs a typical trace line with a tag, a string and two numbers, from one
+// thread and from several, through LOG_DEBUG with the level on and off, and
+// compares with writing the same line to std::cout under a lock. Reports the
+// time per message in nanoseconds, as seen by the logging thread.
+// Usage:
+//
+//   bench_wip_utils_log [messages]
+
+#include "benchmark.h"
+#include "log.h"
+#include <algorithm>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace log = wip::utils::log;
+
+namespace {
+
+// Accepts and discards everything, so only formatting and locking are timed
+struct NullBuffer : std::streambuf {
+    int overflow(int c) override { return c; }
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    wip::benchmark::Runner runner("bench_wip_utils_log", argc, argv, "[messages]");
+    // Stay below a thread's buffer so the sink thread is not what is measured
+    size_t messages = std::min<size_t>(runner.argument(0, 2000), log::LOG_BUFFER_CAPACITY / 2);
+    const std::string tool = "clang-tidy";
+
+    // Count what reaches the sink instead of printing it
+    size_t written = 0;
+    log::set_sink([&](const log::Entry& entry) { written += entry.message.size(); });
+
+    log::set_level(log::Level::Info);
+    runner.measure("LOG_DEBUG disabled", messages, [&]() {
+        for (size_t i = 0; i < messages; ++i) {
+            LOG_DEBUG("ANALYSIS_ENGINE", "Tool ", tool, " finished unit ", i, " of ", messages);
+        }
+    });
+
+    log::set_level(log::Level::Trace);
+    runner.measure("LOG_DEBUG", messages, [&]() {
+        for (size_t i = 0; i < messages; ++i) {
+            LOG_DEBUG("ANALYSIS_ENGINE", "Tool ", tool, " finished unit ", i, " of ", messages);
+        }
+        log::flush();   // Outside the next repetition, counted in this one
+    });
+
+    const unsigned thread_count = std::max(2u, std::thread::hardware_concurrency());
+    runner.measure("LOG_DEBUG " + std::to_string(thread_count) + " threads", messages * thread_count, [&]() {
+        std::vector<std::thread> threads;
+        for (unsigned t = 0; t < thread_count; ++t) {
+            threads.emplace_back([&]() {
+                for (size_t i = 0; i < messages; ++i) {
+                    LOG_DEBUG("ANALYSIS_ENGINE", "Tool ", tool, " finished unit ", i, " of ", messages);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        log::flush();
+    });
+
+    // What the traces cost before: a locked stream with a flush per line
+    std::mutex cout_mutex;
+    NullBuffer null_buffer;
+    std::ostream sink(&null_buffer);
+    runner.measure("std::cout with endl", messages, [&]() {
+        for (size_t i = 0; i < messages; ++i) {
+            std::lock_guard<std::mutex> lock(cout_mutex);
+            sink << "[ANALYSIS_ENGINE] Tool " << tool << " finished unit " << i << " of " << messages << std::endl;
+        }
+    });
+
+    log::flush();
+    runner.out() << "Sink received " << written << " bytes, dropped " << log::dropped_messages() << std::endl;
+    log::set_sink({});
+    return runner.finish();
+}
@@ -0,0 +1,327 @@
+#pragma once
+
+#include "time_utilities.h"
+#include <atomic>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+/**
+ * @brief Lowest level compiled in, as an int: 0 for everything, 5 for nothing
+ *
+ * Calls below it are discarded at compile time, arguments included.
+ */
+#ifndef WIP_LOG_MIN_LEVEL
+#define WIP_LOG_MIN_LEVEL 0
+#endif
+
+namespace wip::utils::log {
+
+enum class Level : std::uint8_t {
+    Trace,
+    Debug,
+    Info,
+    Warning,
+    Error,
+    Off
+};
+
+/**
+ * @brief Records each thread keeps until the sink thread writes them
+ *
+ * A record is 256 bytes, so a buffer takes 1 MB once its thread logs.
+ * Messages that would not fit are dropped and counted.
+ */
+constexpr std::size_t LOG_BUFFER_CAPACITY = 1 << 12;
+
+/**
+ * @brief One formatted message as a sink receives it
+ */
+struct Entry {
+    Level level;
+    const char* tag;                            // Component, e.g. "ANALYSIS_ENGINE"
+    std::uint32_t thread;                       // Small id of the logging thread, from 1
+    time::utilities::FastClock::time_point time;
+    std::string_view message;                   // Valid during the sink call only
+};
+
+using Sink = std::function<void(const Entry&)>;
+
+/**
+ * @brief Get the lowercase name of a level, e.g. "warning"
+ */
+const char* level_name(Level level);
+
+/**
+ * @brief Parse a level name as written by level_name(), ignoring case
+ * @param text Level name, e.g. "debug"
+ * @param fallback Level when the name is unknown
+ */
+Level parse_level(std::string_view text, Level fallback);
+
+namespace detail {
+
+inline std::atomic<std::uint8_t> min_level{static_cast<std::uint8_t>(Level::Info)};
+
+constexpr std::size_t RECORD_PAYLOAD = 224;
+
+using Decoder = void (*)(const unsigned char* payload, std::string& out);
+
+struct Record {
+    std::uint64_t ticks;
+    const char* tag;
+    Decoder decode;
+    Level level;
+    alignas(8) unsigned char payload[RECORD_PAYLOAD];
+};
+
+static_assert(sizeof(Record) == 256, "Log records should fill four cache lines");
+
+// Slot for the calling thread's next record, or nullptr when its buffer is full
+Record* begin_record(Level level);
+
+// Publish the record taken by begin_record()
+void commit_record(Level level);
+
+template<typename T>
+constexpr bool is_text_v = std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view> ||
+                           std::is_same_v<T, const char*> || std::is_same_v<T, char*>;
+
+// Arguments kept as they are until the sink thread formats them
+template<typename T>
+constexpr bool is_deferred_v = is_text_v<T> || std::is_arithmetic_v<T>;
+
+/**
+ * @brief Appends a value the way operator<< on a std::ostream would
+ */
+template<typename T>
+void append(std::string& out, const T& value) {
+    if constexpr (is_text_v<T>) {
+        if constexpr (std::is_pointer_v<T>) {
+            out += value ? std::string_view(value) : std::string_view("(null)");
+        } else {
+            out += value;
+        }
+    } else if constexpr (std::is_same_v<T, bool>) {
+        out += value ? '1' : '0';
+    } else if constexpr (std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char>) {
+        out += static_cast<char>(value);
+    } else if constexpr (std::is_integral_v<T>) {
+        char digits[24];
+        auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), value);
+        out.append(digits, end);
+    } else {
+        char digits[32];
+        const int length = std::snprintf(digits, sizeof(digits), "%g", static_cast<double>(value));
+        out.append(digits, static_cast<std::size_t>(length));
+    }
+}
+
+/**
+ * @brief Byte layout of a deferred argument in a record payload
+ *
+ * Numbers are copied as they are, text as a length and its characters.
+ */
+template<typename T>
+struct Codec {
+    static std::size_t size(const T&) {
+        return sizeof(T);
+    }
+
+    static void encode(unsigned char*& out, const T& value) {
+        std::memcpy(out, &value, sizeof(T));
+        out += sizeof(T);
+    }
+
+    static void decode(const unsigned char*& in, std::string& out) {
+        T value;
+        std::memcpy(&value, in, sizeof(T));
+        in += sizeof(T);
+        append(out, value);
+    }
+};
+
+struct TextCodec {
+    static std::string_view view(const char* text) {
+        return text ? std::string_view(text) : std::string_view("(null)");
+    }
+
+    static std::string_view view(std::string_view text) {
+        return text;
+    }
+
+    template<typename T>
+    static std::size_t size(const T& text) {
+        return sizeof(std::uint32_t) + view(text).size();
+    }
+
+    template<typename T>
+    static void encode(unsigned char*& out, const T& text) {
+        const std::string_view chars = view(text);
+        const auto length = static_cast<std::uint32_t>(chars.size());
+        std::memcpy(out, &length, sizeof(length));
+        std::memcpy(out + sizeof(length), chars.data(), chars.size());
+        out += sizeof(length) + chars.size();
+    }
+
+    static void decode(const unsigned char*& in, std::string& out) {
+        std::uint32_t length;
+        std::memcpy(&length, in, sizeof(length));
+        out.append(reinterpret_cast<const char*>(in + sizeof(length)), length);
+        in += sizeof(length) + length;
+    }
+};
+
+template<> struct Codec<std::string> : TextCodec {};
+template<> struct Codec<std::string_view> : TextCodec {};
+template<> struct Codec<const char*> : TextCodec {};
+template<> struct Codec<char*> : TextCodec {};
+
+template<typename... Args>
+void decode(const unsigned char* payload, std::string& out) {
+    (Codec<Args>::decode(payload, out), ...);
+    (void)payload;
+}
+
+// Messages too long for a record are formatted right away, onto the heap
+void decode_heap(const unsigned char* payload, std::string& out);
+
+/**
+ * @brief Keep numbers and text as they are, stream anything else now
+ */
+template<typename T>
+decltype(auto) capture(const T& value) {
+    if constexpr (std::is_array_v<T>) {
+        return static_cast<const std::remove_extent_t<T>*>(value);
+    } else if constexpr (is_deferred_v<T>) {
+        return value;
+    } else {
+        std::ostringstream text;
+        text << value;
+        return text.str();
+    }
+}
+
+template<typename... Args>
+void write_captured(Level level, const char* tag, const Args&... args) {
+    Record* record = begin_record(level);
+    if (!record) {
+        return;
+    }
+    record->tag = tag;
+    record->level = level;
+
+    const std::size_t size = (std::size_t{0} + ... + Codec<Args>::size(args));
+    if (size <= RECORD_PAYLOAD) {
+        unsigned char* out = record->payload;
+        (Codec<Args>::encode(out, args), ...);
+        record->decode = &decode<Args...>;
+    } else {
+        auto* text = new std::string;
+        (append(*text, args), ...);
+        std::memcpy(record->payload, &text, sizeof(text));
+        record->decode = &decode_heap;
+    }
+    commit_record(level);
+}
+
+} // namespace detail
+
+/**
+ * @brief Set the lowest level that is recorded, Info by default
+ */
+inline void set_level(Level level) {
+    detail::min_level.store(static_cast<std::uint8_t>(level), std::memory_order_relaxed);
+}
+
+/**
+ * @brief Get the lowest level that is recorded
+ */
+inline Level get_level() {
+    return static_cast<Level>(detail::min_level.load(std::memory_order_relaxed));
+}
+
+/**
+ * @brief Check if a level is above WIP_LOG_MIN_LEVEL
+ */
+constexpr bool compiled_in([[maybe_unused]] Level level) {
+#if WIP_LOG_MIN_LEVEL <= 0
+    return true;
+#else
+    return static_cast<int>(level) >= WIP_LOG_MIN_LEVEL;
+#endif
+}
+
+/**
+ * @brief Check if messages of a level are recorded; one relaxed load
+ */
+inline bool enabled(Level level) {
+    return static_cast<std::uint8_t>(level) >= detail::min_level.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Record a message whose arguments are concatenated like operator<< would
+ *
+ * Numbers and strings are copied into the calling thread's buffer and
+ * formatted later on the sink thread; other types are streamed right away.
+ * Prefer the LOG_* macros, which skip the call and its arguments entirely
+ * when the level is off.
+ *
+ * @param level Message level
+ * @param tag Component name; must outlive the process, e.g. a string literal
+ * @param args Message parts
+ */
+template<typename... Args>
+void write(Level level, const char* tag, const Args&... args) {
+    detail::write_captured(level, tag, detail::capture(args)...);
+}
+
+/**
+ * @brief Replace where messages go
+ *
+ * The default sink prints "[TAG] message" lines, errors to stderr and the
+ * rest to stdout. The sink is called from one thread at a time, in time
+ * order within each batch.
+ *
+ * @param sink New sink, or an empty function for the default
+ */
+void set_sink(Sink sink);
+
+/**
+ * @brief Write every message recorded so far before returning
+ *
+ * Called at exit as well; messages logged after that are written at once.
+ */
+void flush();
+
+/**
+ * @brief Get the number of messages dropped because a thread's buffer was full
+ */
+std::uint64_t dropped_messages();
+
+} // namespace wip::utils::log
+
+#define WIP_LOG(level, tag, ...)                                                    \
+    do {                                                                            \
+        if constexpr (::wip::utils::log::compiled_in(level)) {                      \
+            if (::wip::utils::log::enabled(level)) {                                \
+                ::wip::utils::log::write(level, "" tag, __VA_ARGS__);               \
+            }                                                                       \
+        }                                                                           \
+    } while (0)
+
+/**
+ * @brief Log a message under a string literal tag, e.g. LOG_INFO("ENGINE", "Ran ", count, " tools")
+ */
+#define LOG_TRACE(tag, ...) WIP_LOG(::wip::utils::log::Level::Trace, tag, __VA_ARGS__)
+#define LOG_DEBUG(tag, ...) WIP_LOG(::wip::utils::log::Level::Debug, tag, __VA_ARGS__)
+#define LOG_INFO(tag, ...) WIP_LOG(::wip::utils::log::Level::Info, tag, __VA_ARGS__)
+#define LOG_WARNING(tag, ...) WIP_LOG(::wip::utils::log::Level::Warning, tag, __VA_ARGS__)
+#define LOG_ERROR(tag, ...) WIP_LOG(::wip::utils::log::Level::Error, tag, __VA_ARGS__)
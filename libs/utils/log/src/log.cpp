@@ -0,0 +1,292 @@
+#include "log.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace wip::utils::log {
+
+using time::utilities::FastClock;
+
+namespace {
+
+static_assert((LOG_BUFFER_CAPACITY & (LOG_BUFFER_CAPACITY - 1)) == 0,
+              "Log buffer capacity must be a power of two");
+
+// How long the sink thread sleeps when nobody wakes it
+constexpr auto SINK_INTERVAL = std::chrono::milliseconds(20);
+
+/**
+ * @brief Single-producer ring buffer owned by one thread
+ *
+ * The owning thread advances head, the sink advances tail.
+ */
+struct LogBuffer {
+    std::unique_ptr<detail::Record[]> records{new detail::Record[LOG_BUFFER_CAPACITY]};
+    alignas(64) std::atomic<std::uint64_t> head{0};
+    alignas(64) std::atomic<std::uint64_t> tail{0};
+    std::uint32_t thread = 0;
+    std::atomic<bool> exited{false};
+};
+
+struct Logger {
+    std::mutex buffers_mutex;
+    std::vector<std::shared_ptr<LogBuffer>> buffers;
+    std::uint32_t next_thread = 1;
+
+    // Held while draining, so sinks see one batch at a time
+    std::mutex drain_mutex;
+    Sink sink;
+
+    std::mutex wake_mutex;
+    std::condition_variable wake;
+    bool wake_requested = false;
+    std::thread sink_thread;
+    std::once_flag sink_started;
+    std::atomic<bool> stopped{false};
+
+    std::atomic<std::uint64_t> dropped{0};
+};
+
+// Never destroyed, so threads that log during exit can still reach it
+Logger& logger() {
+    static Logger* instance = new Logger;
+    return *instance;
+}
+
+struct ThreadLog {
+    std::shared_ptr<LogBuffer> buffer;
+
+    ~ThreadLog() {
+        // The logger keeps the buffer until its records are written
+        if (buffer) buffer->exited.store(true, std::memory_order_release);
+    }
+};
+
+thread_local ThreadLog thread_log;
+
+void default_sink(const Entry& entry) {
+    std::FILE* stream = entry.level >= Level::Error ? stderr : stdout;
+    std::fputc('[', stream);
+    std::fputs(entry.tag, stream);
+    std::fputs("] ", stream);
+    std::fwrite(entry.message.data(), 1, entry.message.size(), stream);
+    std::fputc('\n', stream);
+}
+
+struct Pending {
+    std::uint64_t ticks;
+    LogBuffer* buffer;
+    std::uint64_t index;
+};
+
+// Writes what every buffer holds, oldest first; the caller holds drain_mutex
+void drain(Logger& log) {
+    std::vector<std::shared_ptr<LogBuffer>> buffers;
+    {
+        std::lock_guard<std::mutex> lock(log.buffers_mutex);
+        buffers = log.buffers;
+    }
+
+    std::vector<Pending> pending;
+    std::vector<std::uint64_t> heads(buffers.size());
+    std::vector<bool> exited(buffers.size());
+    for (size_t b = 0; b < buffers.size(); ++b) {
+        auto& buffer = *buffers[b];
+        // Read before head, so an exited thread's last records are all visible
+        exited[b] = buffer.exited.load(std::memory_order_acquire);
+        heads[b] = buffer.head.load(std::memory_order_acquire);
+        for (std::uint64_t i = buffer.tail.load(std::memory_order_relaxed); i != heads[b]; ++i) {
+            pending.push_back({buffer.records[i & (LOG_BUFFER_CAPACITY - 1)].ticks, &buffer, i});
+        }
+    }
+    std::stable_sort(pending.begin(), pending.end(),
+                     [](const Pending& a, const Pending& b) { return a.ticks < b.ticks; });
+
+    std::string message;
+    for (const auto& item : pending) {
+        const detail::Record& record = item.buffer->records[item.index & (LOG_BUFFER_CAPACITY - 1)];
+        message.clear();
+        record.decode(record.payload, message);
+
+        Entry entry{record.level, record.tag, item.buffer->thread, FastClock::from_ticks(record.ticks), message};
+        if (log.sink) {
+            log.sink(entry);
+        } else {
+            default_sink(entry);
+        }
+    }
+    if (!log.sink && !pending.empty()) {
+        std::fflush(stdout);
+        std::fflush(stderr);
+    }
+
+    for (size_t b = 0; b < buffers.size(); ++b) {
+        buffers[b]->tail.store(heads[b], std::memory_order_release);
+    }
+
+    std::uint64_t dropped = log.dropped.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0) {
+        const std::string text = std::to_string(dropped) + " messages dropped, log buffer full";
+        Entry entry{Level::Warning, "LOG", 0, FastClock::now(), text};
+        if (log.sink) {
+            log.sink(entry);
+        } else {
+            default_sink(entry);
+            std::fflush(stdout);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(log.buffers_mutex);
+    log.buffers.erase(std::remove_if(log.buffers.begin(), log.buffers.end(),
+                                     [&](const std::shared_ptr<LogBuffer>& buffer) {
+                                         auto it = std::find(buffers.begin(), buffers.end(), buffer);
+                                         return it != buffers.end() && exited[it - buffers.begin()];
+                                     }),
+                      log.buffers.end());
+}
+
+void wake_sink(Logger& log) {
+    {
+        std::lock_guard<std::mutex> lock(log.wake_mutex);
+        log.wake_requested = true;
+    }
+    log.wake.notify_one();
+}
+
+void sink_loop() {
+    auto& log = logger();
+    std::unique_lock<std::mutex> lock(log.wake_mutex);
+    while (!log.stopped.load(std::memory_order_relaxed)) {
+        log.wake.wait_for(lock, SINK_INTERVAL, [&] { return log.wake_requested; });
+        log.wake_requested = false;
+        lock.unlock();
+        {
+            std::lock_guard<std::mutex> drain_lock(log.drain_mutex);
+            drain(log);
+        }
+        lock.lock();
+    }
+}
+
+void stop_sink() {
+    auto& log = logger();
+    {
+        std::lock_guard<std::mutex> lock(log.wake_mutex);
+        log.stopped.store(true, std::memory_order_relaxed);
+        log.wake_requested = true;
+    }
+    log.wake.notify_one();
+    if (log.sink_thread.joinable()) {
+        log.sink_thread.join();
+    }
+    std::lock_guard<std::mutex> drain_lock(log.drain_mutex);
+    drain(log);
+}
+
+void start_sink(Logger& log) {
+    std::call_once(log.sink_started, [&] {
+        log.sink_thread = std::thread(sink_loop);
+        std::atexit(stop_sink);
+    });
+}
+
+LogBuffer& thread_buffer() {
+    if (!thread_log.buffer) {
+        auto buffer = std::make_shared<LogBuffer>();
+        auto& log = logger();
+        start_sink(log);
+        std::lock_guard<std::mutex> lock(log.buffers_mutex);
+        buffer->thread = log.next_thread++;
+        log.buffers.push_back(buffer);
+        thread_log.buffer = std::move(buffer);
+    }
+    return *thread_log.buffer;
+}
+
+} // namespace
+
+const char* level_name(Level level) {
+    switch (level) {
+        case Level::Trace: return "trace";
+        case Level::Debug: return "debug";
+        case Level::Info: return "info";
+        case Level::Warning: return "warning";
+        case Level::Error: return "error";
+        default: return "off";
+    }
+}
+
+Level parse_level(std::string_view text, Level fallback) {
+    std::string lower(text);
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    for (auto level : {Level::Trace, Level::Debug, Level::Info, Level::Warning, Level::Error, Level::Off}) {
+        if (lower == level_name(level)) {
+            return level;
+        }
+    }
+    return fallback;
+}
+
+void set_sink(Sink sink) {
+    auto& log = logger();
+    std::lock_guard<std::mutex> lock(log.drain_mutex);
+    drain(log);
+    log.sink = std::move(sink);
+}
+
+void flush() {
+    auto& log = logger();
+    std::lock_guard<std::mutex> lock(log.drain_mutex);
+    drain(log);
+}
+
+std::uint64_t dropped_messages() {
+    return logger().dropped.load(std::memory_order_relaxed);
+}
+
+namespace detail {
+
+void decode_heap(const unsigned char* payload, std::string& out) {
+    std::string* text;
+    std::memcpy(&text, payload, sizeof(text));
+    out += *text;
+    delete text;
+}
+
+Record* begin_record(Level) {
+    auto& buffer = thread_buffer();
+    const std::uint64_t head = buffer.head.load(std::memory_order_relaxed);
+    if (head - buffer.tail.load(std::memory_order_acquire) >= LOG_BUFFER_CAPACITY) {
+        logger().dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    Record* record = &buffer.records[head & (LOG_BUFFER_CAPACITY - 1)];
+    record->ticks = FastClock::ticks();
+    return record;
+}
+
+void commit_record(Level level) {
+    auto& buffer = *thread_log.buffer;
+    const std::uint64_t head = buffer.head.load(std::memory_order_relaxed) + 1;
+    buffer.head.store(head, std::memory_order_release);
+
+    auto& log = logger();
+    if (log.stopped.load(std::memory_order_relaxed)) {
+        // Past exit nobody drains, so write it now
+        flush();
+    } else if (level >= Level::Error || head - buffer.tail.load(std::memory_order_relaxed) == LOG_BUFFER_CAPACITY / 2) {
+        // Errors go out promptly, and a half-full buffer should not wait for the interval
+        wake_sink(log);
+    }
+}
+
+} // namespace detail
+
+} // namespace wip::utils::log
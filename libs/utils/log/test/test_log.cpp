@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <log.h>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace log = wip::utils::log;
+
+namespace {
+
+struct Captured {
+    log::Level level;
+    std::string tag;
+    std::uint32_t thread;
+    std::string message;
+};
+
+} // namespace
+
+class LogTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        log::set_level(log::Level::Trace);
+        log::set_sink([this](const log::Entry& entry) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            entries_.push_back({entry.level, entry.tag, entry.thread, std::string(entry.message)});
+        });
+    }
+
+    void TearDown() override {
+        log::flush();
+        log::set_sink({});
+        log::set_level(log::Level::Info);
+    }
+
+    std::vector<Captured> take() {
+        log::flush();
+        std::lock_guard<std::mutex> lock(mutex_);
+        return std::move(entries_);
+    }
+
+    std::mutex mutex_;
+    std::vector<Captured> entries_;
+};
+
+TEST_F(LogTest, FormatsArgumentsLikeStreams) {
+    const std::string tool = "cppcheck";
+    const char* status = "done";
+    LOG_INFO("ENGINE", "Tool ", tool, " finished: ", status, ", success: ", true, ", issues: ", 42u,
+             ", ratio: ", 0.25, ", code: ", -3, ' ', std::string_view("ok"));
+
+    auto entries = take();
+    ASSERT_EQ(entries.size(), 1u);
+    EXPECT_EQ(entries[0].level, log::Level::Info);
+    EXPECT_EQ(entries[0].tag, "ENGINE");
+    EXPECT_EQ(entries[0].message, "Tool cppcheck finished: done, success: 1, issues: 42, ratio: 0.25, code: -3 ok");
+}
+
+TEST_F(LogTest, StreamsOtherTypesAtTheCallSite) {
+    const std::filesystem::path path = "src/main.cpp";
+    LOG_DEBUG("PROJECT", "Path: ", path);
+
+    auto entries = take();
+    ASSERT_EQ(entries.size(), 1u);
+    EXPECT_EQ(entries[0].message, "Path: \"src/main.cpp\"");
+}
+
+TEST_F(LogTest, LongMessagesAreKept) {
+    const std::string line(1000, 'x');
+    LOG_TRACE("EXECUTOR", "Read line: '", line, "'");
+
+    auto entries = take();
+    ASSERT_EQ(entries.size(), 1u);
+    EXPECT_EQ(entries[0].message, "Read line: '" + line + "'");
+}
+
+TEST_F(LogTest, LevelFilterSkipsArguments) {
+    log::set_level(log::Level::Warning);
+    int evaluated = 0;
+    auto count = [&]() { return ++evaluated; };
+
+    LOG_INFO("ENGINE", "Not recorded ", count());
+    LOG_WARNING("ENGINE", "Recorded ", count());
+    LOG_ERROR("ENGINE", "Recorded ", count());
+
+    EXPECT_EQ(evaluated, 2);
+    auto entries = take();
+    ASSERT_EQ(entries.size(), 2u);
+    EXPECT_EQ(entries[0].level, log::Level::Warning);
+    EXPECT_EQ(entries[1].message, "Recorded 2");
+    EXPECT_FALSE(log::enabled(log::Level::Debug));
+    EXPECT_TRUE(log::enabled(log::Level::Error));
+}
+
+TEST_F(LogTest, ThreadsKeepTheirOrder) {
+    constexpr int THREADS = 4;
+    constexpr int MESSAGES = 500;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([t]() {
+            for (int i = 0; i < MESSAGES; ++i) {
+                LOG_DEBUG("WORKER", t, ":", i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto entries = take();
+    ASSERT_EQ(entries.size(), static_cast<size_t>(THREADS * MESSAGES));
+    std::vector<int> next(THREADS, 0);
+    for (const auto& entry : entries) {
+        const int t = std::stoi(entry.message);
+        const int i = std::stoi(entry.message.substr(entry.message.find(':') + 1));
+        EXPECT_EQ(i, next[t]++);
+        EXPECT_GE(entry.thread, 1u);
+    }
+    EXPECT_EQ(log::dropped_messages(), 0u);
+}
+
+TEST_F(LogTest, ParsesLevelNames) {
+    EXPECT_EQ(log::parse_level("DEBUG", log::Level::Info), log::Level::Debug);
+    EXPECT_EQ(log::parse_level("warning", log::Level::Info), log::Level::Warning);
+    EXPECT_EQ(log::parse_level("off", log::Level::Info), log::Level::Off);
+    EXPECT_EQ(log::parse_level("loud", log::Level::Info), log::Level::Info);
+    EXPECT_STREQ(log::level_name(log::Level::Error), "error");
+}
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <cancellation_token.h>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace wip::utils::net {
+
+/**
+ * @brief Connection failure: refused, reset, timed out, cancelled or malformed data
+ */
+class NetworkError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/**
+ * @brief Host and TCP port, written "host:port"
+ */
+struct Endpoint {
+    std::string host;
+    uint16_t port = 0;
+
+    /**
+     * @brief Parse "host:port"; the host may be a name, an IPv4 address or a bracketed IPv6 address
+     * @return Endpoint, or nullopt if the text is not of that form
+     */
+    static std::optional<Endpoint> parse(std::string_view text);
+
+    std::string to_string() const;
+};
+
+/**
+ * @brief One message of a FramedSocket
+ */
+struct Frame {
+    uint8_t type = 0;                   ///< Meaning is up to the protocol
+    std::string payload;
+};
+
+/**
+ * @brief Connected TCP stream exchanging length-prefixed frames
+ *
+ * Every frame is a 4-byte big-endian payload length, a type byte and the
+ * payload. Frames larger than MAX_FRAME_SIZE are refused on both ends, so a
+ * peer speaking another protocol fails fast instead of making the reader
+ * allocate gigabytes. TCP keep-alive is enabled, so a peer that vanished
+ * without closing the connection is noticed within about a minute.
+ *
+ * Sending and receiving may happen on two threads at once; two threads must
+ * not send (or receive) on one socket at the same time. POSIX only.
+ *
+ * Usage:
+ * ```cpp
+ * auto socket = FramedSocket::connect(*Endpoint::parse("agent-7:7420"));
+ * socket.send(REQUEST, request_json.dump());
+ * if (auto reply = socket.receive()) {
+ *     handle(reply->type, reply->payload);
+ * }
+ * ```
+ */
+class FramedSocket {
+public:
+    static constexpr size_t HEADER_SIZE = 5;
+    static constexpr size_t MAX_FRAME_SIZE = size_t{1} << 30;
+    static constexpr std::chrono::milliseconds NO_TIMEOUT{-1};
+
+    /**
+     * @brief Create a closed socket
+     */
+    FramedSocket() = default;
+
+    /**
+     * @brief Take ownership of a connected stream socket
+     */
+    explicit FramedSocket(int fd);
+
+    ~FramedSocket();
+
+    FramedSocket(FramedSocket&& other) noexcept;
+    FramedSocket& operator=(FramedSocket&& other) noexcept;
+    FramedSocket(const FramedSocket&) = delete;
+    FramedSocket& operator=(const FramedSocket&) = delete;
+
+    /**
+     * @brief Connect to an endpoint, trying each address the host resolves to
+     * @param endpoint Host and port
+     * @param timeout Time allowed per address
+     * @throws NetworkError if no address accepts the connection
+     */
+    static FramedSocket connect(const Endpoint& endpoint, std::chrono::milliseconds timeout = std::chrono::seconds(5));
+
+    /**
+     * @brief Send one frame, blocking until it is handed to the kernel
+     * @throws NetworkError if the connection is closed or broken, or the payload is too large
+     */
+    void send(uint8_t type, std::string_view payload);
+
+    /**
+     * @brief Receive one frame
+     * @param timeout Longest wait for the whole frame (NO_TIMEOUT = no limit)
+     * @param cancellation Stops the wait when cancelled
+     * @return Frame, or nullopt if the peer closed the connection between frames
+     * @throws NetworkError on timeout, cancellation, a broken connection or a frame cut short
+     */
+    std::optional<Frame> receive(std::chrono::milliseconds timeout = NO_TIMEOUT,
+                                 const wip::utils::concurrency::CancellationToken& cancellation = {});
+
+    /**
+     * @brief Wait until data or the peer's close is ready to be received
+     * @param timeout Longest wait (NO_TIMEOUT = no limit)
+     * @param cancellation Stops the wait when cancelled
+     * @return True if ready, false on timeout or cancellation
+     */
+    bool wait_readable(std::chrono::milliseconds timeout,
+                       const wip::utils::concurrency::CancellationToken& cancellation = {}) const;
+
+    /**
+     * @brief Shut the connection down in both directions, keeping the descriptor
+     *
+     * Unlike close(), safe while another thread is blocked in receive(),
+     * which then fails or returns nullopt.
+     */
+    void shutdown();
+
+    /**
+     * @brief Close the connection; no other thread may be using the socket
+     */
+    void close();
+
+    /**
+     * @brief Check whether the socket holds a connection
+     */
+    bool is_open() const { return fd_ >= 0; }
+
+    /**
+     * @brief Get the peer's address as "host:port"
+     */
+    std::string get_peer_name() const;
+
+private:
+    void read_exact(char* data, size_t size, std::chrono::steady_clock::time_point deadline,
+                    const wip::utils::concurrency::CancellationToken& cancellation, bool allow_eof, bool& eof);
+
+    int fd_ = -1;
+};
+
+/**
+ * @brief Listening TCP socket handing out FramedSockets
+ */
+class TcpListener {
+public:
+    /**
+     * @brief Bind and listen
+     * @param port Port to listen on (0 = any free port, see get_port())
+     * @param address Local address to bind ("0.0.0.0" = every IPv4 interface)
+     * @throws NetworkError if the port cannot be bound
+     */
+    explicit TcpListener(uint16_t port, const std::string& address = "0.0.0.0");
+
+    ~TcpListener();
+
+    TcpListener(const TcpListener&) = delete;
+    TcpListener& operator=(const TcpListener&) = delete;
+
+    /**
+     * @brief Get the port actually bound
+     */
+    uint16_t get_port() const { return port_; }
+
+    /**
+     * @brief Wait for the next connection
+     * @return Connection, or a closed socket once close() was called
+     * @throws NetworkError if accepting fails for another reason
+     */
+    FramedSocket accept();
+
+    /**
+     * @brief Stop accepting connections; wakes a blocked accept(), safe from any thread
+     */
+    void close();
+
+private:
+    int fd_ = -1;
+    int wake_pipe_[2] = {-1, -1};      // Written by close() to wake accept()
+    uint16_t port_ = 0;
+    std::atomic<bool> closed_{false};
+};
+
+} // namespace wip::utils::net
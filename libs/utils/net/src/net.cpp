@@ -0,0 +1,409 @@
+#include "net.h"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <utility>
+
+namespace wip::utils::net {
+
+namespace {
+
+constexpr int KEEPALIVE_IDLE_S = 30;            // Silence before the first probe
+constexpr int KEEPALIVE_INTERVAL_S = 10;        // Between unanswered probes
+constexpr int KEEPALIVE_PROBES = 3;             // Unanswered probes before the connection is dropped
+
+[[noreturn]] void throw_errno(const std::string& what) {
+    throw NetworkError(what + ": " + std::strerror(errno));
+}
+
+void set_keepalive(int fd) {
+    int on = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_KEEPALIVE, &on, sizeof(on));
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+#ifdef TCP_KEEPIDLE
+    int idle = KEEPALIVE_IDLE_S;
+    int interval = KEEPALIVE_INTERVAL_S;
+    int probes = KEEPALIVE_PROBES;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_KEEPIDLE, &idle, sizeof(idle));
+    ::setsockopt(fd, IPPROTO_TCP, TCP_KEEPINTVL, &interval, sizeof(interval));
+    ::setsockopt(fd, IPPROTO_TCP, TCP_KEEPCNT, &probes, sizeof(probes));
+#endif
+}
+
+// Milliseconds left until the deadline for poll(), -1 without one
+int poll_timeout(std::chrono::steady_clock::time_point deadline) {
+    if (deadline == std::chrono::steady_clock::time_point::max()) {
+        return -1;
+    }
+    auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+    return static_cast<int>(std::max<long long>(0, left.count()));
+}
+
+std::chrono::steady_clock::time_point make_deadline(std::chrono::milliseconds timeout) {
+    if (timeout.count() < 0) {
+        return std::chrono::steady_clock::time_point::max();
+    }
+    return std::chrono::steady_clock::now() + timeout;
+}
+
+std::string format_address(const sockaddr* address) {
+    char host[INET6_ADDRSTRLEN] = {};
+    uint16_t port = 0;
+    if (address->sa_family == AF_INET) {
+        const auto* in = reinterpret_cast<const sockaddr_in*>(address);
+        ::inet_ntop(AF_INET, &in->sin_addr, host, sizeof(host));
+        port = ntohs(in->sin_port);
+        return std::string(host) + ":" + std::to_string(port);
+    }
+    if (address->sa_family == AF_INET6) {
+        const auto* in6 = reinterpret_cast<const sockaddr_in6*>(address);
+        ::inet_ntop(AF_INET6, &in6->sin6_addr, host, sizeof(host));
+        port = ntohs(in6->sin6_port);
+        return "[" + std::string(host) + "]:" + std::to_string(port);
+    }
+    return "unknown";
+}
+
+// Non-blocking connect bounded by a timeout; returns the connected descriptor or -1 with errno set
+int connect_with_timeout(const addrinfo* address, std::chrono::milliseconds timeout) {
+    int fd = ::socket(address->ai_family, address->ai_socktype | SOCK_CLOEXEC, address->ai_protocol);
+    if (fd < 0) {
+        return -1;
+    }
+
+    int flags = ::fcntl(fd, F_GETFL);
+    ::fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+    if (::connect(fd, address->ai_addr, address->ai_addrlen) != 0) {
+        if (errno != EINPROGRESS) {
+            int error = errno;
+            ::close(fd);
+            errno = error;
+            return -1;
+        }
+
+        pollfd entry{fd, POLLOUT, 0};
+        int ready = ::poll(&entry, 1, static_cast<int>(timeout.count()));
+        int error = 0;
+        socklen_t length = sizeof(error);
+        if (ready <= 0) {
+            error = ready == 0 ? ETIMEDOUT : errno;
+        } else if (::getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length) != 0) {
+            error = errno;
+        }
+        if (error != 0) {
+            ::close(fd);
+            errno = error;
+            return -1;
+        }
+    }
+    ::fcntl(fd, F_SETFL, flags);
+    return fd;
+}
+
+} // namespace
+
+// ==================== Endpoint ====================
+
+std::optional<Endpoint> Endpoint::parse(std::string_view text) {
+    auto colon = text.rfind(':');
+    if (colon == std::string_view::npos || colon == 0 || colon + 1 == text.size()) {
+        return std::nullopt;
+    }
+
+    std::string_view host = text.substr(0, colon);
+    if (host.front() == '[') {
+        if (host.size() < 3 || host.back() != ']') {
+            return std::nullopt;
+        }
+        host = host.substr(1, host.size() - 2);
+    } else if (host.find(':') != std::string_view::npos) {
+        return std::nullopt;        // Unbracketed IPv6 address
+    }
+
+    unsigned long port = 0;
+    for (char c : text.substr(colon + 1)) {
+        if (c < '0' || c > '9' || (port = port * 10 + static_cast<unsigned long>(c - '0')) > 65535) {
+            return std::nullopt;
+        }
+    }
+    if (port == 0) {
+        return std::nullopt;
+    }
+    return Endpoint{std::string(host), static_cast<uint16_t>(port)};
+}
+
+std::string Endpoint::to_string() const {
+    if (host.find(':') != std::string::npos) {
+        return "[" + host + "]:" + std::to_string(port);
+    }
+    return host + ":" + std::to_string(port);
+}
+
+// ==================== FramedSocket ====================
+
+FramedSocket::FramedSocket(int fd) : fd_(fd) {
+    set_keepalive(fd_);
+}
+
+FramedSocket::~FramedSocket() {
+    close();
+}
+
+FramedSocket::FramedSocket(FramedSocket&& other) noexcept : fd_(std::exchange(other.fd_, -1)) {}
+
+FramedSocket& FramedSocket::operator=(FramedSocket&& other) noexcept {
+    if (this != &other) {
+        close();
+        fd_ = std::exchange(other.fd_, -1);
+    }
+    return *this;
+}
+
+FramedSocket FramedSocket::connect(const Endpoint& endpoint, std::chrono::milliseconds timeout) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addresses = nullptr;
+    int status = ::getaddrinfo(endpoint.host.c_str(), std::to_string(endpoint.port).c_str(), &hints, &addresses);
+    if (status != 0) {
+        throw NetworkError("Cannot resolve " + endpoint.host + ": " + ::gai_strerror(status));
+    }
+
+    int last_error = ECONNREFUSED;
+    for (const addrinfo* address = addresses; address; address = address->ai_next) {
+        int fd = connect_with_timeout(address, timeout);
+        if (fd >= 0) {
+            ::freeaddrinfo(addresses);
+            return FramedSocket(fd);
+        }
+        last_error = errno;
+    }
+    ::freeaddrinfo(addresses);
+    throw NetworkError("Cannot connect to " + endpoint.to_string() + ": " + std::strerror(last_error));
+}
+
+void FramedSocket::send(uint8_t type, std::string_view payload) {
+    if (fd_ < 0) {
+        throw NetworkError("Socket is closed");
+    }
+    if (payload.size() > MAX_FRAME_SIZE) {
+        throw NetworkError("Frame of " + std::to_string(payload.size()) + " bytes exceeds the limit");
+    }
+
+    auto size = static_cast<uint32_t>(payload.size());
+    char header[HEADER_SIZE] = {static_cast<char>(size >> 24), static_cast<char>(size >> 16),
+                                static_cast<char>(size >> 8), static_cast<char>(size), static_cast<char>(type)};
+
+    // Header and payload in one call where possible, so small frames leave in one segment
+    iovec parts[2] = {{header, HEADER_SIZE}, {const_cast<char*>(payload.data()), payload.size()}};
+    msghdr message{};
+    message.msg_iov = parts;
+    message.msg_iovlen = 2;
+    size_t left = HEADER_SIZE + payload.size();
+    while (left > 0) {
+        ssize_t written = ::sendmsg(fd_, &message, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw_errno("Send failed");
+        }
+        left -= static_cast<size_t>(written);
+
+        // Skip what was written
+        auto skip = static_cast<size_t>(written);
+        while (skip > 0 && message.msg_iovlen > 0) {
+            size_t part = std::min(skip, message.msg_iov->iov_len);
+            message.msg_iov->iov_base = static_cast<char*>(message.msg_iov->iov_base) + part;
+            message.msg_iov->iov_len -= part;
+            skip -= part;
+            if (message.msg_iov->iov_len == 0) {
+                ++message.msg_iov;
+                --message.msg_iovlen;
+            }
+        }
+    }
+}
+
+std::optional<Frame> FramedSocket::receive(std::chrono::milliseconds timeout,
+                                           const wip::utils::concurrency::CancellationToken& cancellation) {
+    if (fd_ < 0) {
+        throw NetworkError("Socket is closed");
+    }
+
+    auto deadline = make_deadline(timeout);
+    bool eof = false;
+    unsigned char header[HEADER_SIZE];
+    read_exact(reinterpret_cast<char*>(header), HEADER_SIZE, deadline, cancellation, true, eof);
+    if (eof) {
+        return std::nullopt;
+    }
+
+    size_t size = (size_t{header[0]} << 24) | (size_t{header[1]} << 16) | (size_t{header[2]} << 8) | header[3];
+    if (size > MAX_FRAME_SIZE) {
+        throw NetworkError("Frame of " + std::to_string(size) + " bytes exceeds the limit");
+    }
+
+    Frame frame;
+    frame.type = header[4];
+    frame.payload.resize(size);
+    read_exact(frame.payload.data(), size, deadline, cancellation, false, eof);
+    return frame;
+}
+
+void FramedSocket::read_exact(char* data, size_t size, std::chrono::steady_clock::time_point deadline,
+                              const wip::utils::concurrency::CancellationToken& cancellation, bool allow_eof, bool& eof) {
+    int cancel_fd = cancellation.get_wait_fd();
+    size_t done = 0;
+    while (done < size) {
+        if (cancellation.is_cancelled()) {
+            throw NetworkError("Receive cancelled");
+        }
+
+        pollfd entries[2] = {{fd_, POLLIN, 0}, {cancel_fd, POLLIN, 0}};
+        int ready = ::poll(entries, cancel_fd >= 0 ? 2 : 1, poll_timeout(deadline));
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw_errno("Receive failed");
+        }
+        if (ready == 0) {
+            throw NetworkError("Receive timed out");
+        }
+        if (entries[0].revents == 0) {
+            continue;                           // Only the cancellation fired; checked above
+        }
+
+        ssize_t received = ::recv(fd_, data + done, size - done, 0);
+        if (received < 0) {
+            if (errno == EINTR || errno == EAGAIN) {
+                continue;
+            }
+            throw_errno("Receive failed");
+        }
+        if (received == 0) {
+            if (allow_eof && done == 0) {
+                eof = true;
+                return;
+            }
+            throw NetworkError("Connection closed in the middle of a frame");
+        }
+        done += static_cast<size_t>(received);
+    }
+}
+
+bool FramedSocket::wait_readable(std::chrono::milliseconds timeout,
+                                 const wip::utils::concurrency::CancellationToken& cancellation) const {
+    int cancel_fd = cancellation.get_wait_fd();
+    pollfd entries[2] = {{fd_, POLLIN, 0}, {cancel_fd, POLLIN, 0}};
+    int ready;
+    do {
+        ready = ::poll(entries, cancel_fd >= 0 ? 2 : 1, static_cast<int>(timeout.count()));
+    } while (ready < 0 && errno == EINTR);
+    return ready > 0 && entries[0].revents != 0;
+}
+
+void FramedSocket::shutdown() {
+    if (fd_ >= 0) {
+        ::shutdown(fd_, SHUT_RDWR);
+    }
+}
+
+void FramedSocket::close() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+std::string FramedSocket::get_peer_name() const {
+    sockaddr_storage address{};
+    socklen_t length = sizeof(address);
+    if (fd_ < 0 || ::getpeername(fd_, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        return "unknown";
+    }
+    return format_address(reinterpret_cast<const sockaddr*>(&address));
+}
+
+// ==================== TcpListener ====================
+
+TcpListener::TcpListener(uint16_t port, const std::string& address) {
+    sockaddr_in local{};
+    local.sin_family = AF_INET;
+    local.sin_port = htons(port);
+    if (::inet_pton(AF_INET, address.c_str(), &local.sin_addr) != 1) {
+        throw NetworkError("Not an IPv4 address: " + address);
+    }
+
+    fd_ = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd_ < 0) {
+        throw_errno("Cannot create socket");
+    }
+    int on = 1;
+    ::setsockopt(fd_, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    if (::bind(fd_, reinterpret_cast<sockaddr*>(&local), sizeof(local)) != 0 || ::listen(fd_, SOMAXCONN) != 0) {
+        int error = errno;
+        ::close(fd_);
+        errno = error;
+        throw_errno("Cannot listen on " + address + ":" + std::to_string(port));
+    }
+
+    socklen_t length = sizeof(local);
+    ::getsockname(fd_, reinterpret_cast<sockaddr*>(&local), &length);
+    port_ = ntohs(local.sin_port);
+
+    if (::pipe2(wake_pipe_, O_CLOEXEC) != 0) {
+        ::close(fd_);
+        throw_errno("Cannot create pipe");
+    }
+}
+
+TcpListener::~TcpListener() {
+    ::close(fd_);
+    ::close(wake_pipe_[0]);
+    ::close(wake_pipe_[1]);
+}
+
+FramedSocket TcpListener::accept() {
+    while (!closed_) {
+        pollfd entries[2] = {{fd_, POLLIN, 0}, {wake_pipe_[0], POLLIN, 0}};
+        if (::poll(entries, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw_errno("Accept failed");
+        }
+        if (closed_ || entries[1].revents != 0) {
+            break;
+        }
+
+        int fd = ::accept4(fd_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd >= 0) {
+            return FramedSocket(fd);
+        }
+        // The peer may have given up between poll() and accept()
+        if (errno != EINTR && errno != ECONNABORTED && errno != EAGAIN) {
+            throw_errno("Accept failed");
+        }
+    }
+    return FramedSocket();
+}
+
+void TcpListener::close() {
+    if (!closed_.exchange(true)) {
+        char wake = 1;
+        [[maybe_unused]] auto written = ::write(wake_pipe_[1], &wake, 1);
+    }
+}
+
+} // namespace wip::utils::net
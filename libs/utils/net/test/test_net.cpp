@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+#include <net.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace wip::utils::net;
+using wip::utils::concurrency::CancellationToken;
+
+namespace {
+
+// Connected pair over the loopback interface
+std::pair<FramedSocket, FramedSocket> make_pair() {
+    TcpListener listener(0, "127.0.0.1");
+    auto client = FramedSocket::connect(Endpoint{"127.0.0.1", listener.get_port()});
+    auto server = listener.accept();
+    return {std::move(client), std::move(server)};
+}
+
+} // namespace
+
+TEST(EndpointTest, ParsesHostAndPort) {
+    auto endpoint = Endpoint::parse("agent-7:7420");
+    ASSERT_TRUE(endpoint);
+    EXPECT_EQ(endpoint->host, "agent-7");
+    EXPECT_EQ(endpoint->port, 7420);
+    EXPECT_EQ(endpoint->to_string(), "agent-7:7420");
+
+    auto ipv6 = Endpoint::parse("[::1]:80");
+    ASSERT_TRUE(ipv6);
+    EXPECT_EQ(ipv6->host, "::1");
+    EXPECT_EQ(ipv6->to_string(), "[::1]:80");
+}
+
+TEST(EndpointTest, RejectsMalformedText) {
+    EXPECT_FALSE(Endpoint::parse("agent-7"));
+    EXPECT_FALSE(Endpoint::parse(":80"));
+    EXPECT_FALSE(Endpoint::parse("host:"));
+    EXPECT_FALSE(Endpoint::parse("host:0"));
+    EXPECT_FALSE(Endpoint::parse("host:65536"));
+    EXPECT_FALSE(Endpoint::parse("host:8o"));
+    EXPECT_FALSE(Endpoint::parse("::1:80"));
+}
+
+TEST(FramedSocketTest, ExchangesFrames) {
+    auto [client, server] = make_pair();
+
+    std::string large(3 * 1024 * 1024, 'x');
+    large[12345] = 'y';
+    client.send(1, "hello");
+    client.send(2, "");
+    client.send(3, large);
+
+    auto first = server.receive();
+    ASSERT_TRUE(first);
+    EXPECT_EQ(first->type, 1);
+    EXPECT_EQ(first->payload, "hello");
+
+    auto second = server.receive();
+    ASSERT_TRUE(second);
+    EXPECT_EQ(second->type, 2);
+    EXPECT_TRUE(second->payload.empty());
+
+    auto third = server.receive();
+    ASSERT_TRUE(third);
+    EXPECT_EQ(third->payload, large);
+
+    server.send(4, "reply");
+    auto reply = client.receive();
+    ASSERT_TRUE(reply);
+    EXPECT_EQ(reply->type, 4);
+    EXPECT_EQ(reply->payload, "reply");
+}
+
+TEST(FramedSocketTest, ReceiveReturnsNulloptWhenPeerCloses) {
+    auto [client, server] = make_pair();
+    client.send(1, "last");
+    client.close();
+
+    ASSERT_TRUE(server.receive());
+    EXPECT_FALSE(server.receive());
+}
+
+TEST(FramedSocketTest, FrameCutShortThrows) {
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    FramedSocket socket(fds[0]);
+
+    // A header announcing more bytes than ever arrive
+    const char partial[] = {0, 0, 0, 100, 1, 'a', 'b'};
+    ASSERT_EQ(::write(fds[1], partial, sizeof(partial)), static_cast<ssize_t>(sizeof(partial)));
+    ::close(fds[1]);
+    EXPECT_THROW(socket.receive(), NetworkError);
+}
+
+TEST(FramedSocketTest, OversizedFrameThrows) {
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    FramedSocket socket(fds[0]);
+
+    // What an HTTP client would send
+    const char request[] = "GET / HTTP/1.1\r\n\r\n";
+    ASSERT_GT(::write(fds[1], request, sizeof(request) - 1), 0);
+    EXPECT_THROW(socket.receive(), NetworkError);
+    ::close(fds[1]);
+}
+
+TEST(FramedSocketTest, ReceiveTimesOut) {
+    auto [client, server] = make_pair();
+    EXPECT_THROW(server.receive(std::chrono::milliseconds(20)), NetworkError);
+}
+
+TEST(FramedSocketTest, ReceiveStopsWhenCancelled) {
+    auto [client, server] = make_pair();
+    auto token = CancellationToken::create();
+
+    std::thread canceller([token]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        token.cancel();
+    });
+    EXPECT_THROW(server.receive(FramedSocket::NO_TIMEOUT, token), NetworkError);
+    canceller.join();
+}
+
+TEST(FramedSocketTest, WaitReadableStopsWhenCancelled) {
+    auto [client, server] = make_pair();
+    EXPECT_FALSE(server.wait_readable(std::chrono::milliseconds(10)));
+
+    auto token = CancellationToken::create();
+    std::thread canceller([token]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        token.cancel();
+    });
+    EXPECT_FALSE(server.wait_readable(FramedSocket::NO_TIMEOUT, token));
+    canceller.join();
+
+    client.send(1, "ready");
+    EXPECT_TRUE(server.wait_readable(FramedSocket::NO_TIMEOUT, CancellationToken::create()));
+}
+
+TEST(FramedSocketTest, ShutdownWakesBlockedReceive) {
+    auto [client, server] = make_pair();
+
+    std::thread closer([&server = server]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        server.shutdown();
+    });
+    EXPECT_FALSE(server.receive());
+    closer.join();
+    EXPECT_THROW(client.send(1, std::string(1 << 20, 'x')), NetworkError);
+}
+
+TEST(FramedSocketTest, ConnectToClosedPortThrows) {
+    uint16_t port;
+    {
+        TcpListener listener(0, "127.0.0.1");
+        port = listener.get_port();
+    }
+    EXPECT_THROW(FramedSocket::connect(Endpoint{"127.0.0.1", port}), NetworkError);
+}
+
+TEST(TcpListenerTest, CloseWakesBlockedAccept) {
+    TcpListener listener(0, "127.0.0.1");
+    std::thread closer([&listener]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        listener.close();
+    });
+    auto socket = listener.accept();
+    EXPECT_FALSE(socket.is_open());
+    closer.join();
+}
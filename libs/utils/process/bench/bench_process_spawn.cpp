@@ -0,0 +1,56 @@
+// Benchmark for process creation.
+//
+// Starts a trivial command repeatedly through the fork and posix_spawn paths
+// of ProcessExecutor and reports the time per spawn. fork() has to copy the
+// parent's page tables, so its cost grows with the parent's resident memory;
+// pass a size in MiB to touch that much memory first. Usage:
+//
+//   bench_wip_utils_process [resident-mib] [iterations]
+
+#include "benchmark.h"
+#include "process.h"
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace wip::utils::process;
+
+namespace {
+
+size_t spawn(LaunchMethod method, size_t iterations) {
+    ProcessExecutor executor;
+    auto config = ProcessConfig::from_command("true");
+    config.launch_method = method;
+
+    size_t succeeded = 0;
+    for (size_t i = 0; i < iterations; ++i) {
+        if (executor.execute(config).success()) {
+            ++succeeded;
+        } else {
+            std::cerr << "Command failed" << std::endl;
+        }
+    }
+    return succeeded;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    wip::benchmark::Runner runner("bench_wip_utils_process", argc, argv, "[resident-mib] [iterations]");
+    size_t resident_mib = runner.argument(0, 0);
+    size_t iterations = runner.argument(1, 500);
+
+    // Resident memory makes the parent look like a large GUI process
+    std::unique_ptr<char[]> ballast;
+    if (resident_mib > 0) {
+        size_t bytes = resident_mib * 1024 * 1024;
+        ballast.reset(new char[bytes]);
+        std::memset(ballast.get(), 1, bytes);
+    }
+
+    runner.out() << "Starting 'true' " << iterations << " times with " << resident_mib << " MiB resident" << std::endl;
+    runner.measure("fork", iterations, [&]() { return spawn(LaunchMethod::Fork, iterations); });
+    runner.measure("posix_spawn", iterations, [&]() { return spawn(LaunchMethod::Spawn, iterations); });
+    return runner.finish();
+}
@@ -0,0 +1,46 @@
+// Benchmark for handing a result from a child process to its parent.
+//
+// Writes a message of the given size and reads it back, once through a
+// SharedMemorySegment and once through a temporary file, as a tool writing a
+// result file and the parent loading it would. The segment is read in place;
+// the file has to be copied into a buffer. Usage:
+//
+//   bench_wip_utils_process_shared_memory [message-kib]
+
+#include "benchmark.h"
+#include "shared_memory.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using namespace wip::utils::process;
+
+int main(int argc, char* argv[]) {
+    wip::benchmark::Runner runner("bench_wip_utils_process_shared_memory", argc, argv, "[message-kib]");
+    size_t message_kib = runner.argument(0, 4096);
+
+    std::string message(message_kib * 1024, '\0');
+    for (size_t i = 0; i < message.size(); ++i) {
+        message[i] = static_cast<char>(i % 251);
+    }
+    runner.out() << message_kib << " KiB message" << std::endl;
+
+    auto segment = SharedMemorySegment::create("bench");
+    runner.measure("shared memory publish + read", 1, [&]() {
+        segment.publish(message);
+        return segment.read()->size();
+    });
+
+    auto path = std::filesystem::temp_directory_path() / "bench_wip_utils_process_shared_memory.bin";
+    runner.measure("temp file write + read", 1, [&]() {
+        std::ofstream(path, std::ios::binary).write(message.data(), static_cast<std::streamsize>(message.size()));
+        std::ifstream input(path, std::ios::binary);
+        std::ostringstream contents;
+        contents << input.rdbuf();
+        return contents.str().size();
+    });
+    std::filesystem::remove(path);
+
+    return runner.finish();
+}
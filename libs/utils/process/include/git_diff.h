@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace wip::utils::process {
+
+/**
+ * @brief Inclusive range of 1-based line numbers
+ */
+struct LineRange {
+    int first = 0;
+    int last = 0;
+};
+
+/**
+ * @brief Lines of one file that a diff adds or changes
+ */
+struct FileChanges {
+    std::string path;                 // Path of the file after the change
+    std::vector<LineRange> ranges;    // Changed lines in the new file, in diff order
+};
+
+/**
+ * @brief Parse the changed lines out of a unified diff
+ *
+ * Only added lines are marked, in new-file numbering; context lines are not,
+ * so any context size gives the same result. Lines removed without
+ * replacement mark the lines on either side of the gap, so code that now
+ * meets across it is still covered. Deleted and binary files are left out.
+ * @param diff Output of `git diff` or `diff -u`; any context size
+ * @param root Directory the paths in the diff are relative to (empty = leave them as written)
+ * @return Changed files in diff order
+ */
+std::vector<FileChanges> parse_unified_diff(std::string_view diff, const std::string& root = "");
+
+/**
+ * @brief Get the lines changed in a git working tree since a revision
+ *
+ * Runs `git diff` against the revision, so staged and unstaged edits are
+ * both included; untracked files are not. Paths are absolute.
+ * @param repository Any directory inside the working tree
+ * @param base Revision to compare against, e.g. "HEAD" or "origin/main"
+ * @return Changed files in diff order
+ * @throws std::runtime_error if git fails, e.g. outside a repository or for an unknown revision
+ */
+std::vector<FileChanges> git_changed_lines(const std::string& repository, const std::string& base = "HEAD");
+
+} // namespace wip::utils::process
@@ -1,9 +1,14 @@
 #pragma once
 
+#include <cancellation_token.h>
+#include <task.h>
 #include <string>
 #include <vector>
 #include <chrono>
 #include <optional>
+#include <functional>
+#include <memory>
+#include <string_view>
 
 namespace wip::utils::process {
 
@@ -16,11 +21,20 @@ struct ProcessResult {
     std::string stderr_output;        // Standard error content
     std::chrono::milliseconds duration; // Execution duration
     bool timed_out;                   // Whether the process timed out
+    bool cancelled = false;           // Whether the process was stopped through its CancellationToken
+    std::chrono::microseconds spawn_time{0};    // Creating the pipes and starting the process
+    std::chrono::microseconds cpu_time{0};      // User and system CPU time of the process and its waited-for children
+    std::chrono::microseconds user_cpu_time{0}; // User part of cpu_time
+    std::chrono::microseconds system_cpu_time{0}; // System part of cpu_time
+    std::chrono::microseconds capture_time{0};  // Reading output, including the output callback
+    size_t max_rss_kb = 0;                      // Peak resident set size of the process or its largest waited-for child
+    size_t voluntary_context_switches = 0;      // Times the process blocked, e.g. on I/O
+    size_t involuntary_context_switches = 0;    // Times the process was preempted
     
     /**
      * @brief Check if the process executed successfully (exit code 0)
      */
-    bool success() const { return exit_code == 0 && !timed_out; }
+    bool success() const { return exit_code == 0 && !timed_out && !cancelled; }
     
     /**
      * @brief Get combined output (stdout + stderr)
@@ -28,6 +42,80 @@ struct ProcessResult {
     std::string combined_output() const;
 };
 
+/**
+ * @brief Output stream of a child process
+ */
+enum class OutputStream {
+    Stdout,  // Standard output (also carries stderr when merged)
+    Stderr   // Standard error
+};
+
+/**
+ * @brief Sink receiving child output as it is read
+ * 
+ * Chunks are views into the read buffer and are only valid during the call;
+ * they are not aligned to lines (see LineSplitter).
+ */
+using OutputCallback = std::function<void(OutputStream stream, std::string_view chunk)>;
+
+/**
+ * @brief Splits streamed output chunks into lines
+ * 
+ * Lines that lie entirely within a chunk are passed on as views into that
+ * chunk; only a line that straddles a chunk boundary is copied. The newline
+ * is not included. Each stream keeps its own partial line.
+ */
+class LineSplitter {
+public:
+    using LineCallback = std::function<void(OutputStream stream, std::string_view line)>;
+    
+    explicit LineSplitter(LineCallback on_line) : on_line_(std::move(on_line)) {}
+    
+    /**
+     * @brief Feed a chunk of output
+     * @param stream Stream the chunk was read from
+     * @param chunk Bytes read, in order
+     */
+    void feed(OutputStream stream, std::string_view chunk);
+    
+    /**
+     * @brief Report unterminated trailing lines; call once the output has ended
+     */
+    void flush();
+    
+    /**
+     * @brief Get a ProcessConfig::output_callback that feeds this splitter
+     * 
+     * The splitter must outlive the process it is attached to.
+     */
+    OutputCallback as_output_callback() {
+        return [this](OutputStream stream, std::string_view chunk) { feed(stream, chunk); };
+    }
+
+private:
+    LineCallback on_line_;
+    std::string partial_[2];          // Unterminated line per stream
+};
+
+/**
+ * @brief Shared flag for stopping running processes from another thread
+ * 
+ * Event loops waiting on a process are woken as soon as its token is
+ * cancelled, so the process is signalled within milliseconds rather than at
+ * the next periodic check. Like on a timeout, it receives SIGTERM and, if
+ * still running after a short grace period, SIGKILL.
+ */
+using CancellationToken = wip::utils::concurrency::CancellationToken;
+
+/**
+ * @brief How a child process is started
+ */
+enum class LaunchMethod {
+    Auto,    // posix_spawn where it supports the config, fork otherwise
+    Fork,    // fork + exec (copies the parent's page tables)
+    Spawn    // posix_spawn (falls back to fork if the config needs it)
+};
+
 /**
  * @brief Configuration for process execution
  */
@@ -39,6 +127,12 @@ struct ProcessConfig {
     bool capture_stdout = true;                    // Capture standard output
     bool capture_stderr = true;                    // Capture standard error
     bool merge_stderr_to_stdout = false;           // Redirect stderr to stdout
+    LaunchMethod launch_method = LaunchMethod::Auto; // Process creation strategy
+    OutputCallback output_callback;                // Receives output as it arrives (optional)
+    bool buffer_output = true;                     // Also collect output in ProcessResult (always without a callback)
+    CancellationToken cancellation;                // Stops the process when cancelled
+    bool own_process_group = false;                // Start in a new process group and signal the whole group
+    std::vector<int> inherited_fds;                // Passed to the child under the same numbers, even if close-on-exec
     
     /**
      * @brief Create config with simple command string
@@ -97,6 +191,45 @@ public:
      */
     ProcessResult execute(const ProcessConfig& config);
     
+    /**
+     * @brief Execute on a pool worker instead of the calling thread
+     * 
+     * The process is waited for on the worker, and the output callback is
+     * invoked there. In a C++20 build the task can be co_awaited (see
+     * coroutine.h). The task does not refer to any executor instance.
+     * @param config Process configuration
+     * @param pool Pool whose worker waits for the process
+     * @return Task for the ProcessResult
+     */
+    static wip::utils::concurrency::Task<ProcessResult> execute_async(
+        ProcessConfig config,
+        wip::utils::concurrency::ThreadPool& pool = wip::utils::concurrency::default_thread_pool());
+    
+    /**
+     * @brief Callback reporting one finished process of a batch
+     * @param index Position of the process in the batch
+     * @param result Result of that process
+     */
+    using BatchCallback = std::function<void(size_t index, const ProcessResult& result)>;
+    
+    /**
+     * @brief Run a batch of processes with a bounded number in flight
+     * 
+     * All children are driven by one poll() loop on the calling thread, which
+     * multiplexes their pipes; no thread is started per child. A process that
+     * cannot be started is reported with exit code -1 and the error in
+     * stderr_output instead of throwing. Output callbacks of all configs are
+     * invoked on the calling thread as well. A process whose token is
+     * cancelled before it starts is reported as cancelled without launching.
+     * @param configs Processes to run, started in order
+     * @param max_in_flight Maximum number of concurrent processes (0 = hardware concurrency)
+     * @param on_complete Called on the calling thread as each process finishes
+     * @return Results in the order of configs
+     */
+    std::vector<ProcessResult> execute_batch(const std::vector<ProcessConfig>& configs,
+                                             size_t max_in_flight = 0,
+                                             BatchCallback on_complete = nullptr);
+    
     /**
      * @brief Quick utility to execute and get stdout only (throws on error)
      * @param command Command to execute
@@ -112,6 +245,13 @@ public:
      */
     static bool command_exists(const std::string& command);
     
+    /**
+     * @brief Check whether a config would be started with posix_spawn
+     * @param config Process configuration
+     * @return true if the spawn path supports the config on this platform
+     */
+    static bool uses_spawn(const ProcessConfig& config);
+    
     /**
      * @brief Get the full path to a command if it exists
      * @param command Command name to find
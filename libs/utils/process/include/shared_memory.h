@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace wip::utils::process {
+
+/**
+ * @brief Anonymous shared memory through which a child process hands a result to its parent
+ *
+ * The parent creates the segment and passes its descriptor to the child in
+ * ProcessConfig::inherited_fds, with the number on the command line. The
+ * child attaches and publishes one message; the parent reads it in place from
+ * its own mapping once the child is done. The memory never touches the disk,
+ * and a child that dies while publishing leaves no message rather than a cut
+ * one, because the size is stored only after the data.
+ *
+ * Linux only (memfd_create). The descriptor is close-on-exec, so children
+ * started without it in inherited_fds do not see the segment.
+ *
+ * Usage:
+ * ```cpp
+ * auto segment = SharedMemorySegment::create("results");
+ * config.arguments.push_back("--result-fd=" + std::to_string(segment.get_fd()));
+ * config.inherited_fds.push_back(segment.get_fd());
+ * executor.execute(config);
+ * if (auto message = segment.read()) {
+ *     consume(*message);
+ * }
+ *
+ * // In the child
+ * SharedMemorySegment::attach(fd).publish(encoded_results);
+ * ```
+ */
+class SharedMemorySegment {
+public:
+    /**
+     * @brief Create an empty segment
+     * @param name Name shown in /proc/<pid>/fd, for debugging
+     * @throws std::runtime_error if the segment cannot be created
+     */
+    static SharedMemorySegment create(const std::string& name);
+
+    /**
+     * @brief Open a segment created by another process
+     * @param fd Descriptor of the segment; duplicated, so the caller keeps its own
+     * @throws std::runtime_error if fd is not a segment
+     */
+    static SharedMemorySegment attach(int fd);
+
+    ~SharedMemorySegment();
+
+    SharedMemorySegment(SharedMemorySegment&& other) noexcept;
+    SharedMemorySegment& operator=(SharedMemorySegment&& other) noexcept;
+    SharedMemorySegment(const SharedMemorySegment&) = delete;
+    SharedMemorySegment& operator=(const SharedMemorySegment&) = delete;
+
+    /**
+     * @brief Get the descriptor to pass to a child process
+     */
+    int get_fd() const { return fd_; }
+
+    /**
+     * @brief Replace the message with data
+     * @throws std::runtime_error if the segment cannot be grown (e.g. out of memory)
+     */
+    void publish(std::string_view data);
+
+    /**
+     * @brief Get the published message
+     *
+     * The view points into this object's mapping and stays valid until the
+     * next read() or the segment's destruction.
+     * @return Message, or nullopt if none was published (completely)
+     */
+    std::optional<std::string_view> read();
+
+    /**
+     * @brief Drop the message, e.g. before handing the segment to the next child
+     */
+    void clear();
+
+private:
+    explicit SharedMemorySegment(int fd) : fd_(fd) {}
+
+    void map(size_t size);
+    void unmap();
+
+    int fd_ = -1;
+    void* mapping_ = nullptr;
+    size_t mapped_size_ = 0;
+};
+
+} // namespace wip::utils::process
@@ -0,0 +1,197 @@
+#include "git_diff.h"
+#include "process.h"
+#include <algorithm>
+#include <filesystem>
+#include <stdexcept>
+
+namespace wip::utils::process {
+
+namespace {
+
+// Read a decimal number at pos, advancing past it
+int read_number(std::string_view text, size_t& pos) {
+    int value = 0;
+    while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9') {
+        value = value * 10 + (text[pos++] - '0');
+    }
+    return value;
+}
+
+// Parse "<start>[,<count>]"; the count defaults to 1
+void read_hunk_range(std::string_view text, size_t& pos, int& start, int& count) {
+    start = read_number(text, pos);
+    count = 1;
+    if (pos < text.size() && text[pos] == ',') {
+        ++pos;
+        count = read_number(text, pos);
+    }
+}
+
+// Path of a "+++ " line: git quotes unusual names C-style, diff -u appends a timestamp after a tab
+std::string read_diff_path(std::string_view text) {
+    if (text.empty() || text.front() != '"') {
+        return std::string(text.substr(0, text.find('\t')));
+    }
+
+    std::string path;
+    for (size_t i = 1; i < text.size() && text[i] != '"'; ++i) {
+        if (text[i] != '\\' || i + 1 >= text.size()) {
+            path += text[i];
+            continue;
+        }
+        char escaped = text[++i];
+        if (escaped >= '0' && escaped <= '7') {
+            int value = 0;
+            for (int digits = 0; digits < 3 && i < text.size() && text[i] >= '0' && text[i] <= '7'; ++digits) {
+                value = value * 8 + (text[i++] - '0');
+            }
+            --i;
+            path += static_cast<char>(value);
+        } else {
+            switch (escaped) {
+                case 'a': path += '\a'; break;
+                case 'b': path += '\b'; break;
+                case 'f': path += '\f'; break;
+                case 'n': path += '\n'; break;
+                case 'r': path += '\r'; break;
+                case 't': path += '\t'; break;
+                case 'v': path += '\v'; break;
+                default:  path += escaped; break;
+            }
+        }
+    }
+    return path;
+}
+
+std::string run_git(ProcessExecutor& executor, const std::string& repository, const std::vector<std::string>& arguments) {
+    auto result = executor.execute("git", arguments, repository);
+    if (!result.success()) {
+        std::string message = result.stderr_output.substr(0, result.stderr_output.find('\n'));
+        throw std::runtime_error("git failed in " + (repository.empty() ? std::string(".") : repository) +
+                                 (message.empty() ? "" : ": " + message));
+    }
+    return result.stdout_output;
+}
+
+} // anonymous namespace
+
+std::vector<FileChanges> parse_unified_diff(std::string_view diff, const std::string& root) {
+    std::vector<FileChanges> files;
+    FileChanges* current = nullptr;
+    bool git_header = false;        // Paths carry git's a/ and b/ prefixes
+    int old_remaining = 0;          // Lines left in the current hunk
+    int new_remaining = 0;
+    int new_line = 0;               // Line of the new file the next hunk line is at
+    bool removed = false;           // Lines were removed and not replaced
+
+    // Mark lines changed, merging with the previous range where they touch
+    auto mark = [&](int first, int last) {
+        if (!current) {
+            return;
+        }
+        first = std::max(first, 1);
+        if (!current->ranges.empty() && first <= current->ranges.back().last + 1) {
+            current->ranges.back().last = std::max(current->ranges.back().last, last);
+        } else {
+            current->ranges.push_back({first, last});
+        }
+    };
+    // A removal leaves the lines on either side of the gap meeting
+    auto close_removal = [&]() {
+        if (removed) {
+            mark(new_line - 1, new_line);
+            removed = false;
+        }
+    };
+
+    size_t line_start = 0;
+    while (line_start < diff.size()) {
+        size_t line_end = diff.find('\n', line_start);
+        if (line_end == std::string_view::npos) {
+            line_end = diff.size();
+        }
+        std::string_view line = diff.substr(line_start, line_end - line_start);
+        line_start = line_end + 1;
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+
+        // Hunk bodies come first: an added line may itself start with "+++" or "@@"
+        if (old_remaining > 0 || new_remaining > 0) {
+            char kind = line.empty() ? ' ' : line.front();
+            if (kind == '-') {
+                --old_remaining;
+                removed = true;
+            } else if (kind == '+') {
+                --new_remaining;
+                removed = false;
+                mark(new_line, new_line);
+                ++new_line;
+            } else if (kind == ' ') {
+                --old_remaining;
+                --new_remaining;
+                close_removal();
+                ++new_line;
+            }
+            if (old_remaining <= 0 && new_remaining <= 0) {
+                close_removal();
+            }
+            continue;
+        }
+
+        if (line.rfind("diff --git ", 0) == 0) {
+            git_header = true;
+            current = nullptr;
+        } else if (line.rfind("+++ ", 0) == 0) {
+            std::string path = read_diff_path(line.substr(4));
+            current = nullptr;
+            if (path == "/dev/null") {
+                continue;
+            }
+            if (git_header && path.rfind("b/", 0) == 0) {
+                path.erase(0, 2);
+            }
+            if (!root.empty()) {
+                path = (std::filesystem::path(root) / path).lexically_normal().string();
+            }
+            files.push_back({std::move(path), {}});
+            current = &files.back();
+        } else if (line.rfind("@@ -", 0) == 0) {
+            size_t pos = 4;
+            int old_start = 0;
+            int new_start = 0;
+            read_hunk_range(line, pos, old_start, old_remaining);
+            pos = line.find('+', pos);
+            if (pos == std::string_view::npos) {
+                old_remaining = 0;
+                continue;
+            }
+            ++pos;
+            read_hunk_range(line, pos, new_start, new_remaining);
+            // An empty new side is numbered by the line before it
+            new_line = new_remaining > 0 ? new_start : new_start + 1;
+        }
+    }
+
+    files.erase(std::remove_if(files.begin(), files.end(),
+                               [](const FileChanges& file) { return file.ranges.empty(); }),
+                files.end());
+    return files;
+}
+
+std::vector<FileChanges> git_changed_lines(const std::string& repository, const std::string& base) {
+    ProcessExecutor executor;
+    std::string root = run_git(executor, repository, {"rev-parse", "--show-toplevel"});
+    while (!root.empty() && (root.back() == '\n' || root.back() == '\r')) {
+        root.pop_back();
+    }
+
+    // Zero context keeps the hunks to the changed lines themselves
+    std::string diff = run_git(executor, repository, {
+        "-c", "core.quotePath=false", "diff", "-U0", "--no-color", "--no-ext-diff",
+        "--src-prefix=a/", "--dst-prefix=b/", base, "--"
+    });
+    return parse_unified_diff(diff, root);
+}
+
+} // namespace wip::utils::process
@@ -7,13 +7,592 @@
 #include <chrono>
 #include <unistd.h>
 #include <sys/wait.h>
+#include <sys/resource.h>
 #include <fcntl.h>
+#include <poll.h>
+#include <sys/syscall.h>
 #include <signal.h>
+#include <spawn.h>
 #include <cstring>
 #include <filesystem>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <thread>
+
+// posix_spawn_file_actions_addchdir_np is available since glibc 2.29
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 29))
+#define WIP_PROCESS_HAS_SPAWN_CHDIR 1
+#else
+#define WIP_PROCESS_HAS_SPAWN_CHDIR 0
+#endif
+
+// posix_spawn_file_actions_adddup2(fd, fd) clears close-on-exec since glibc 2.29 as well
+#define WIP_PROCESS_HAS_SPAWN_INHERIT WIP_PROCESS_HAS_SPAWN_CHDIR
+
+extern char** environ;
 
 namespace wip::utils::process {
 
+namespace {
+
+constexpr int FALLBACK_EXIT_CHECK_MS = 10;          // Exit check interval without pidfd support
+constexpr int TERMINATE_GRACE_MS = 100;             // Time between SIGTERM and SIGKILL
+constexpr size_t READ_CHUNK_SIZE = 65536;           // Bytes per read(); one pipe buffer on Linux
+
+// Create a pipe whose ends are not inherited by other children
+bool make_pipe(int fds[2]) {
+#ifdef __linux__
+    return pipe2(fds, O_CLOEXEC) == 0;
+#else
+    if (pipe(fds) == -1) {
+        return false;
+    }
+    fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+    return true;
+#endif
+}
+
+void set_nonblocking(int fd) {
+    if (fd >= 0) {
+        int flags = fcntl(fd, F_GETFL);
+        fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+    }
+}
+
+// Process descriptor that polls readable once the child exits (-1 if unsupported)
+int open_pidfd(pid_t pid) {
+#if defined(__linux__) && defined(SYS_pidfd_open)
+    return static_cast<int>(syscall(SYS_pidfd_open, pid, 0));
+#else
+    (void)pid;
+    return -1;
+#endif
+}
+
+// Pass everything currently readable to consume(data, size); returns false once the pipe reached EOF
+template <typename Consumer>
+bool read_available(int fd, Consumer&& consume) {
+    char buffer[READ_CHUNK_SIZE];
+    while (true) {
+        ssize_t bytes_read = read(fd, buffer, sizeof(buffer));
+        if (bytes_read > 0) {
+            consume(buffer, static_cast<size_t>(bytes_read));
+        } else if (bytes_read == 0) {
+            return false;
+        } else if (errno == EINTR) {
+            continue;
+        } else {
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+    }
+}
+
+// Convert an rusage time
+std::chrono::microseconds to_microseconds(const struct timeval& time) {
+    return std::chrono::seconds(time.tv_sec) + std::chrono::microseconds(time.tv_usec);
+}
+
+// Collect the child's exit status and, if requested, its resource usage; returns true if it has exited
+bool reap_child(pid_t pid, bool block, int& exit_code, struct rusage* usage = nullptr) {
+    int status;
+    pid_t wait_result;
+    do {
+        wait_result = wait4(pid, &status, block ? 0 : WNOHANG, usage);
+    } while (wait_result == -1 && errno == EINTR);
+    
+    if (wait_result == -1 && errno == ECHILD) {
+        exit_code = -1;  // Reaped elsewhere (e.g. SIGCHLD ignored); status is lost
+        return true;
+    }
+    if (wait_result != pid) {
+        return false;
+    }
+    if (WIFEXITED(status)) {
+        exit_code = WEXITSTATUS(status);
+    } else if (WIFSIGNALED(status)) {
+        exit_code = -WTERMSIG(status);
+    }
+    return true;
+}
+
+// Start the child with fork + exec; returns the pid, or -1 with errno set
+pid_t fork_child(const ProcessConfig& config, char* const argv[], const int* stdout_pipe, const int* stderr_pipe) {
+    pid_t pid = fork();
+    if (pid != 0) {
+        return pid;
+    }
+    
+    // Child process
+    
+    // Own process group, so signals reach every descendant
+    if (config.own_process_group) {
+        setpgid(0, 0);
+    }
+    
+    // Change working directory if specified
+    if (!config.working_directory.empty()) {
+        if (chdir(config.working_directory.c_str()) != 0) {
+            _exit(127); // Exit with error code
+        }
+    }
+    
+    // Set up pipes (dup2 clears close-on-exec on the new descriptors)
+    for (int fd : config.inherited_fds) {
+        fcntl(fd, F_SETFD, 0);
+    }
+    if (stdout_pipe) {
+        dup2(stdout_pipe[1], STDOUT_FILENO);
+    }
+    
+    if (config.capture_stderr) {
+        if (config.merge_stderr_to_stdout) {
+            dup2(STDOUT_FILENO, STDERR_FILENO);
+        } else if (stderr_pipe) {
+            dup2(stderr_pipe[1], STDERR_FILENO);
+        }
+    }
+    
+    // Execute the command
+    execvp(config.command.c_str(), argv);
+    
+    // If we reach here, execvp failed
+    _exit(127);
+}
+
+// Start the child with posix_spawn; returns 0 or the error that prevented it
+int spawn_child(const ProcessConfig& config, char* const argv[], const int* stdout_pipe, const int* stderr_pipe,
+                pid_t& pid) {
+    posix_spawn_file_actions_t actions;
+    int error = posix_spawn_file_actions_init(&actions);
+    if (error != 0) {
+        return error;
+    }
+    
+    // Same order as the fork path: working directory first, then the pipes
+#if WIP_PROCESS_HAS_SPAWN_CHDIR
+    if (!config.working_directory.empty()) {
+        error = posix_spawn_file_actions_addchdir_np(&actions, config.working_directory.c_str());
+    }
+#endif
+#if WIP_PROCESS_HAS_SPAWN_INHERIT
+    for (int fd : config.inherited_fds) {
+        if (error == 0) {
+            error = posix_spawn_file_actions_adddup2(&actions, fd, fd);
+        }
+    }
+#endif
+    if (error == 0 && stdout_pipe) {
+        error = posix_spawn_file_actions_adddup2(&actions, stdout_pipe[1], STDOUT_FILENO);
+    }
+    if (error == 0 && config.capture_stderr) {
+        if (config.merge_stderr_to_stdout) {
+            error = posix_spawn_file_actions_adddup2(&actions, STDOUT_FILENO, STDERR_FILENO);
+        } else if (stderr_pipe) {
+            error = posix_spawn_file_actions_adddup2(&actions, stderr_pipe[1], STDERR_FILENO);
+        }
+    }
+    
+    posix_spawnattr_t attributes;
+    bool has_attributes = false;
+    if (error == 0 && config.own_process_group) {
+        error = posix_spawnattr_init(&attributes);
+        has_attributes = error == 0;
+        if (error == 0) {
+            error = posix_spawnattr_setflags(&attributes, POSIX_SPAWN_SETPGROUP);
+        }
+        if (error == 0) {
+            error = posix_spawnattr_setpgroup(&attributes, 0);
+        }
+    }
+    
+    if (error == 0) {
+        error = posix_spawnp(&pid, config.command.c_str(), &actions, has_attributes ? &attributes : nullptr,
+                             argv, environ);
+    }
+    
+    if (has_attributes) {
+        posix_spawnattr_destroy(&attributes);
+    }
+    posix_spawn_file_actions_destroy(&actions);
+    return error;
+}
+
+// One running child: its pipes, exit notification and timeout state
+class ChildProcess {
+public:
+    explicit ChildProcess(const ProcessConfig& config);
+    ~ChildProcess();
+    
+    ChildProcess(const ChildProcess&) = delete;
+    ChildProcess& operator=(const ChildProcess&) = delete;
+    
+    bool is_finished() const { return finished_; }
+    
+    // Append the descriptors to wait on; update() expects the same slots back
+    void add_poll_fds(std::vector<pollfd>& fds);
+    
+    // Stop the child as if it had timed out, reporting it as cancelled
+    void cancel(std::chrono::steady_clock::time_point now);
+    
+    // Longest time the event loop may sleep before this child needs attention (-1 = until an event)
+    int get_wait_ms(std::chrono::steady_clock::time_point now) const;
+    
+    // Handle the events reported for this child's slots
+    void update(const std::vector<pollfd>& fds, std::chrono::steady_clock::time_point now);
+    
+    ProcessResult take_result() { return std::move(result_); }
+    
+private:
+    // Read what is available on one stream; returns false once it reached EOF
+    bool read_stream(int fd, OutputStream stream);
+    void terminate(std::chrono::steady_clock::time_point now);
+    void send_signal(int signal_number);
+    void close_pipes();
+    void finish(std::chrono::steady_clock::time_point now);
+    
+    OutputCallback output_callback_;
+    bool buffer_output_ = true;
+    CancellationToken cancellation_;
+    bool own_process_group_ = false;
+    pid_t pid_ = -1;
+    int stdout_fd_ = -1;
+    int stderr_fd_ = -1;
+    int pid_fd_ = -1;
+    size_t poll_offset_ = 0;
+    
+    std::chrono::steady_clock::time_point start_time_;
+    std::optional<std::chrono::steady_clock::time_point> deadline_;
+    std::optional<std::chrono::steady_clock::time_point> kill_deadline_;   // SIGKILL if still running by then
+    bool terminating_ = false;          // SIGTERM sent after a timeout or cancellation
+    bool reaped_ = false;
+    bool finished_ = false;
+    ProcessResult result_{};
+};
+
+ChildProcess::ChildProcess(const ProcessConfig& config)
+    : output_callback_(config.output_callback),
+      buffer_output_(config.buffer_output || !config.output_callback),
+      cancellation_(config.cancellation),
+      own_process_group_(config.own_process_group),
+      start_time_(std::chrono::steady_clock::now()) {
+    // Create pipes for stdout and stderr
+    int stdout_pipe[2], stderr_pipe[2];
+    bool separate_stderr = config.capture_stderr && !config.merge_stderr_to_stdout;
+    
+    if (config.capture_stdout && !make_pipe(stdout_pipe)) {
+        throw std::runtime_error("Failed to create stdout pipe: " + std::string(strerror(errno)));
+    }
+    
+    if (separate_stderr && !make_pipe(stderr_pipe)) {
+        int pipe_error = errno;
+        if (config.capture_stdout) {
+            close(stdout_pipe[0]);
+            close(stdout_pipe[1]);
+        }
+        throw std::runtime_error("Failed to create stderr pipe: " + std::string(strerror(pipe_error)));
+    }
+    
+    // Prepare arguments for execvp
+    std::vector<char*> argv;
+    argv.push_back(const_cast<char*>(config.command.c_str()));
+    for (const auto& arg : config.arguments) {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+    
+    const int* child_stdout = config.capture_stdout ? stdout_pipe : nullptr;
+    const int* child_stderr = separate_stderr ? stderr_pipe : nullptr;
+    int launch_error = 0;
+    bool spawned = ProcessExecutor::uses_spawn(config);
+    if (spawned) {
+        launch_error = spawn_child(config, argv.data(), child_stdout, child_stderr, pid_);
+    } else {
+        pid_ = fork_child(config, argv.data(), child_stdout, child_stderr);
+        launch_error = pid_ == -1 ? errno : 0;
+        
+        // Also set the group from the parent so it exists before the first signal
+        if (pid_ > 0 && config.own_process_group) {
+            setpgid(pid_, pid_);
+        }
+    }
+    
+    // Close write ends of pipes
+    if (config.capture_stdout) {
+        close(stdout_pipe[1]);
+    }
+    if (separate_stderr) {
+        close(stderr_pipe[1]);
+    }
+    
+    if (launch_error != 0) {
+        if (config.capture_stdout) {
+            close(stdout_pipe[0]);
+        }
+        if (separate_stderr) {
+            close(stderr_pipe[0]);
+        }
+        if (!spawned || launch_error == EAGAIN || launch_error == ENOMEM) {
+            throw std::runtime_error(std::string(spawned ? "Failed to spawn process: " : "Failed to fork process: ") +
+                                     strerror(launch_error));
+        }
+        
+        // Same outcome as a forked child whose chdir or exec failed
+        result_.exit_code = 127;
+        reaped_ = true;
+        finish(std::chrono::steady_clock::now());
+        return;
+    }
+    
+    result_.spawn_time = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start_time_);
+    
+    // Read ends are non-blocking so one readiness event never blocks the loop
+    stdout_fd_ = config.capture_stdout ? stdout_pipe[0] : -1;
+    stderr_fd_ = separate_stderr ? stderr_pipe[0] : -1;
+    set_nonblocking(stdout_fd_);
+    set_nonblocking(stderr_fd_);
+    
+    // A pidfd becomes readable when the child exits, so the event loop can
+    // sleep until there is output, an exit or a timeout
+    pid_fd_ = open_pidfd(pid_);
+    
+    if (config.timeout.has_value()) {
+        deadline_ = start_time_ + config.timeout.value();
+    }
+}
+
+ChildProcess::~ChildProcess() {
+    close_pipes();
+    if (pid_fd_ >= 0) {
+        close(pid_fd_);
+    }
+    
+    // Only reached with a live child when the event loop is unwinding
+    if (!reaped_ && pid_ > 0) {
+        send_signal(SIGKILL);
+        int exit_code;
+        reap_child(pid_, true, exit_code);
+    }
+}
+
+void ChildProcess::add_poll_fds(std::vector<pollfd>& fds) {
+    poll_offset_ = fds.size();
+    fds.push_back(pollfd{stdout_fd_, POLLIN, 0});    // Negative descriptors are ignored by poll()
+    fds.push_back(pollfd{stderr_fd_, POLLIN, 0});
+    fds.push_back(pollfd{pid_fd_, POLLIN, 0});
+    fds.push_back(pollfd{terminating_ ? -1 : cancellation_.get_wait_fd(), POLLIN, 0});
+}
+
+int ChildProcess::get_wait_ms(std::chrono::steady_clock::time_point now) const {
+    int wait_ms = -1;
+    auto wait_until = [&](std::chrono::steady_clock::time_point deadline) {
+        auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - now).count();
+        int remaining_ms = static_cast<int>(std::max<std::chrono::milliseconds::rep>(0, remaining));
+        wait_ms = wait_ms < 0 ? remaining_ms : std::min(wait_ms, remaining_ms);
+    };
+    
+    // Without a pidfd, exit is noticed through pipe EOF or a bounded wait
+    if (pid_fd_ < 0) {
+        wait_until(now + std::chrono::milliseconds(stdout_fd_ >= 0 || stderr_fd_ >= 0 ? FALLBACK_EXIT_CHECK_MS : 1));
+    }
+    if (!terminating_ && cancellation_.can_be_cancelled() && cancellation_.get_wait_fd() < 0) {
+        wait_until(now + std::chrono::milliseconds(FALLBACK_EXIT_CHECK_MS));
+    }
+    if (deadline_ && !terminating_) {
+        wait_until(*deadline_);
+    }
+    if (kill_deadline_) {
+        wait_until(*kill_deadline_);
+    }
+    return wait_ms;
+}
+
+void ChildProcess::update(const std::vector<pollfd>& fds, std::chrono::steady_clock::time_point now) {
+    if (finished_) {
+        return;
+    }
+    
+    const pollfd* slots = &fds[poll_offset_];
+    if (stdout_fd_ >= 0 && slots[0].revents != 0 && !read_stream(stdout_fd_, OutputStream::Stdout)) {
+        close(stdout_fd_);
+        stdout_fd_ = -1;
+    }
+    if (stderr_fd_ >= 0 && slots[1].revents != 0 && !read_stream(stderr_fd_, OutputStream::Stderr)) {
+        close(stderr_fd_);
+        stderr_fd_ = -1;
+    }
+    
+    struct rusage usage{};
+    if ((pid_fd_ < 0 || slots[2].revents != 0) && reap_child(pid_, false, result_.exit_code, &usage)) {
+        reaped_ = true;
+        result_.user_cpu_time = to_microseconds(usage.ru_utime);
+        result_.system_cpu_time = to_microseconds(usage.ru_stime);
+        result_.cpu_time = result_.user_cpu_time + result_.system_cpu_time;
+        result_.max_rss_kb = static_cast<size_t>(usage.ru_maxrss);   // KiB on Linux
+        result_.voluntary_context_switches = static_cast<size_t>(usage.ru_nvcsw);
+        result_.involuntary_context_switches = static_cast<size_t>(usage.ru_nivcsw);
+        
+        // Anything still buffered after exit (descendants may keep the pipes open)
+        if (stdout_fd_ >= 0) read_stream(stdout_fd_, OutputStream::Stdout);
+        if (stderr_fd_ >= 0) read_stream(stderr_fd_, OutputStream::Stderr);
+        finish(now);
+        return;
+    }
+    
+    if (!terminating_ && cancellation_.is_cancelled()) {
+        cancel(now);
+    } else if (!terminating_ && deadline_ && now >= *deadline_) {
+        result_.timed_out = true;
+        terminate(now);
+    } else if (kill_deadline_ && now >= *kill_deadline_) {
+        send_signal(SIGKILL);
+        kill_deadline_.reset();
+    }
+}
+
+void ChildProcess::cancel(std::chrono::steady_clock::time_point now) {
+    if (!terminating_ && !finished_) {
+        result_.cancelled = true;
+        terminate(now);
+    }
+}
+
+void ChildProcess::terminate(std::chrono::steady_clock::time_point now) {
+    // Try graceful termination first; output after this point is not collected
+    terminating_ = true;
+    send_signal(SIGTERM);
+    close_pipes();
+    kill_deadline_ = now + std::chrono::milliseconds(TERMINATE_GRACE_MS);
+}
+
+void ChildProcess::send_signal(int signal_number) {
+    // The group outlives its leader while descendants are running
+    if (!own_process_group_ || kill(-pid_, signal_number) != 0) {
+        kill(pid_, signal_number);
+    }
+}
+
+bool ChildProcess::read_stream(int fd, OutputStream stream) {
+    auto read_start = std::chrono::steady_clock::now();
+    std::string& output = stream == OutputStream::Stdout ? result_.stdout_output : result_.stderr_output;
+    bool open = read_available(fd, [&](const char* data, size_t size) {
+        if (buffer_output_) {
+            output.append(data, size);
+        }
+        if (output_callback_) {
+            output_callback_(stream, std::string_view(data, size));
+        }
+    });
+    result_.capture_time += std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - read_start);
+    return open;
+}
+
+void ChildProcess::close_pipes() {
+    if (stdout_fd_ >= 0) {
+        close(stdout_fd_);
+        stdout_fd_ = -1;
+    }
+    if (stderr_fd_ >= 0) {
+        close(stderr_fd_);
+        stderr_fd_ = -1;
+    }
+}
+
+void ChildProcess::finish(std::chrono::steady_clock::time_point now) {
+    close_pipes();
+    finished_ = true;
+    result_.duration = std::chrono::duration_cast<std::chrono::milliseconds>(now - start_time_);
+}
+
+// Event loop shared by single and batch execution: one poll() over every running child
+std::vector<ProcessResult> run_children(const std::vector<ProcessConfig>& configs, size_t max_in_flight,
+                                        const ProcessExecutor::BatchCallback& on_complete, bool throw_launch_errors) {
+    std::vector<ProcessResult> results(configs.size());
+    std::vector<std::pair<size_t, std::unique_ptr<ChildProcess>>> running;
+    std::vector<pollfd> fds;
+    size_t next_config = 0;
+    
+    auto complete = [&](size_t index, ProcessResult result) {
+        results[index] = std::move(result);
+        if (on_complete) {
+            on_complete(index, results[index]);
+        }
+    };
+    
+    while (next_config < configs.size() || !running.empty()) {
+        // Start processes up to the in-flight limit
+        while (next_config < configs.size() && running.size() < max_in_flight) {
+            size_t index = next_config++;
+            if (configs[index].cancellation.is_cancelled()) {
+                ProcessResult cancelled{};
+                cancelled.exit_code = -1;
+                cancelled.cancelled = true;
+                complete(index, std::move(cancelled));
+                continue;
+            }
+            
+            std::unique_ptr<ChildProcess> child;
+            try {
+                child = std::make_unique<ChildProcess>(configs[index]);
+            } catch (const std::exception& e) {
+                if (throw_launch_errors) {
+                    throw;
+                }
+                ProcessResult failed{};
+                failed.exit_code = -1;
+                failed.stderr_output = e.what();
+                complete(index, std::move(failed));
+                continue;
+            }
+            
+            if (child->is_finished()) {
+                complete(index, child->take_result());
+            } else {
+                running.emplace_back(index, std::move(child));
+            }
+        }
+        if (running.empty()) {
+            continue;
+        }
+        
+        auto now = std::chrono::steady_clock::now();
+        int wait_ms = -1;
+        fds.clear();
+        for (auto& entry : running) {
+            entry.second->add_poll_fds(fds);
+            int child_wait_ms = entry.second->get_wait_ms(now);
+            if (child_wait_ms >= 0) {
+                wait_ms = wait_ms < 0 ? child_wait_ms : std::min(wait_ms, child_wait_ms);
+            }
+        }
+        
+        if (poll(fds.data(), fds.size(), wait_ms) < 0 && errno != EINTR) {
+            throw std::runtime_error("Failed to wait for process events: " + std::string(strerror(errno)));
+        }
+        
+        // Update every child, then report the finished ones in start order
+        now = std::chrono::steady_clock::now();
+        for (auto& entry : running) {
+            entry.second->update(fds, now);
+        }
+        for (auto it = running.begin(); it != running.end();) {
+            if (it->second->is_finished()) {
+                complete(it->first, it->second->take_result());
+                it = running.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    
+    return results;
+}
+
+} // namespace
+
 // ProcessResult implementation
 std::string ProcessResult::combined_output() const {
     std::string result = stdout_output;
@@ -26,6 +605,44 @@ std::string ProcessResult::combined_output() const {
     return result;
 }
 
+// LineSplitter implementation
+void LineSplitter::feed(OutputStream stream, std::string_view chunk) {
+    std::string& partial = partial_[stream == OutputStream::Stdout ? 0 : 1];
+    
+    size_t newline = chunk.find('\n');
+    if (newline == std::string_view::npos) {
+        partial.append(chunk.data(), chunk.size());
+        return;
+    }
+    
+    // Complete the line carried over from the previous chunk
+    if (!partial.empty()) {
+        partial.append(chunk.data(), newline);
+        on_line_(stream, partial);
+        partial.clear();
+    } else {
+        on_line_(stream, chunk.substr(0, newline));
+    }
+    chunk.remove_prefix(newline + 1);
+    
+    // Whole lines are passed straight from the chunk
+    while ((newline = chunk.find('\n')) != std::string_view::npos) {
+        on_line_(stream, chunk.substr(0, newline));
+        chunk.remove_prefix(newline + 1);
+    }
+    partial.assign(chunk.data(), chunk.size());
+}
+
+void LineSplitter::flush() {
+    for (int index = 0; index < 2; ++index) {
+        if (!partial_[index].empty()) {
+            std::string line = std::move(partial_[index]);
+            partial_[index].clear();
+            on_line_(index == 0 ? OutputStream::Stdout : OutputStream::Stderr, line);
+        }
+    }
+}
+
 // ProcessConfig implementation
 ProcessConfig ProcessConfig::from_command(const std::string& cmd) {
     ProcessConfig config;
@@ -80,6 +697,14 @@ ProcessResult ProcessExecutor::execute(const ProcessConfig& config) {
     return execute_internal(config);
 }
 
+wip::utils::concurrency::Task<ProcessResult> ProcessExecutor::execute_async(ProcessConfig config,
+                                                                          wip::utils::concurrency::ThreadPool& pool) {
+    // A token cancelled before a worker takes the task is reported by execute() without launching
+    return wip::utils::concurrency::async(pool, [config = std::move(config)]() {
+        return ProcessExecutor().execute_internal(config);
+    });
+}
+
 std::string ProcessExecutor::execute_and_get_output(const std::string& command) {
     auto result = execute(command);
     if (!result.success()) {
@@ -93,6 +718,19 @@ bool ProcessExecutor::command_exists(const std::string& command) {
     return !find_command_path(command).empty();
 }
 
+bool ProcessExecutor::uses_spawn(const ProcessConfig& config) {
+    if (config.launch_method == LaunchMethod::Fork) {
+        return false;
+    }
+    
+    // Changing the working directory needs posix_spawn_file_actions_addchdir_np
+#if WIP_PROCESS_HAS_SPAWN_CHDIR
+    return true;
+#else
+    return config.working_directory.empty() && config.inherited_fds.empty();
+#endif
+}
+
 std::string ProcessExecutor::find_command_path(const std::string& command) {
     // Check if command contains path separators
     if (command.find('/') != std::string::npos) {
@@ -123,204 +761,17 @@ std::string ProcessExecutor::find_command_path(const std::string& command) {
     return "";
 }
 
-ProcessResult ProcessExecutor::execute_internal(const ProcessConfig& config) {
-    ProcessResult result{};
-    auto start_time = std::chrono::steady_clock::now();
-    
-    // Create pipes for stdout and stderr
-    int stdout_pipe[2], stderr_pipe[2];
-    
-    if (config.capture_stdout && pipe(stdout_pipe) == -1) {
-        throw std::runtime_error("Failed to create stdout pipe: " + std::string(strerror(errno)));
-    }
-    
-    if (config.capture_stderr && !config.merge_stderr_to_stdout && pipe(stderr_pipe) == -1) {
-        if (config.capture_stdout) {
-            close(stdout_pipe[0]);
-            close(stdout_pipe[1]);
-        }
-        throw std::runtime_error("Failed to create stderr pipe: " + std::string(strerror(errno)));
+std::vector<ProcessResult> ProcessExecutor::execute_batch(const std::vector<ProcessConfig>& configs,
+                                                       size_t max_in_flight,
+                                                       BatchCallback on_complete) {
+    if (max_in_flight == 0) {
+        max_in_flight = std::max(1u, std::thread::hardware_concurrency());
     }
-    
-    // Prepare arguments for execvp
-    std::vector<char*> argv;
-    argv.push_back(const_cast<char*>(config.command.c_str()));
-    for (const auto& arg : config.arguments) {
-        argv.push_back(const_cast<char*>(arg.c_str()));
-    }
-    argv.push_back(nullptr);
-    
-    pid_t pid = fork();
-    
-    if (pid == -1) {
-        // Fork failed
-        if (config.capture_stdout) {
-            close(stdout_pipe[0]);
-            close(stdout_pipe[1]);
-        }
-        if (config.capture_stderr && !config.merge_stderr_to_stdout) {
-            close(stderr_pipe[0]);
-            close(stderr_pipe[1]);
-        }
-        throw std::runtime_error("Failed to fork process: " + std::string(strerror(errno)));
-    }
-    
-    if (pid == 0) {
-        // Child process
-        
-        // Change working directory if specified
-        if (!config.working_directory.empty()) {
-            if (chdir(config.working_directory.c_str()) != 0) {
-                _exit(127); // Exit with error code
-            }
-        }
-        
-        // Set up pipes
-        if (config.capture_stdout) {
-            close(stdout_pipe[0]); // Close read end
-            dup2(stdout_pipe[1], STDOUT_FILENO);
-            close(stdout_pipe[1]);
-        }
-        
-        if (config.capture_stderr) {
-            if (config.merge_stderr_to_stdout) {
-                dup2(STDOUT_FILENO, STDERR_FILENO);
-            } else {
-                close(stderr_pipe[0]); // Close read end
-                dup2(stderr_pipe[1], STDERR_FILENO);
-                close(stderr_pipe[1]);
-            }
-        }
-        
-        // Execute the command
-        execvp(config.command.c_str(), argv.data());
-        
-        // If we reach here, execvp failed
-        _exit(127);
-    }
-    
-    // Parent process
-    
-    // Close write ends of pipes
-    if (config.capture_stdout) {
-        close(stdout_pipe[1]);
-    }
-    if (config.capture_stderr && !config.merge_stderr_to_stdout) {
-        close(stderr_pipe[1]);
-    }
-    
-    // Read output from pipes
-    std::string stdout_content, stderr_content;
-    
-    // Set pipes to non-blocking mode for timeout handling
-    if (config.capture_stdout) {
-        int flags = fcntl(stdout_pipe[0], F_GETFL);
-        fcntl(stdout_pipe[0], F_SETFL, flags | O_NONBLOCK);
-    }
-    if (config.capture_stderr && !config.merge_stderr_to_stdout) {
-        int flags = fcntl(stderr_pipe[0], F_GETFL);
-        fcntl(stderr_pipe[0], F_SETFL, flags | O_NONBLOCK);
-    }
-    
-    // Read loop with timeout support
-    bool process_finished = false;
-    bool timed_out = false;
-    
-    while (!process_finished && !timed_out) {
-        // Check if timeout exceeded
-        if (config.timeout.has_value()) {
-            auto elapsed = std::chrono::steady_clock::now() - start_time;
-            if (elapsed >= config.timeout.value()) {
-                timed_out = true;
-                kill(pid, SIGTERM); // Try graceful termination first
-                usleep(100000); // Wait 100ms
-                kill(pid, SIGKILL); // Force kill if still running
-                break;
-            }
-        }
-        
-        // Check if process has finished
-        int status;
-        pid_t wait_result = waitpid(pid, &status, WNOHANG);
-        if (wait_result == pid) {
-            process_finished = true;
-            if (WIFEXITED(status)) {
-                result.exit_code = WEXITSTATUS(status);
-            } else if (WIFSIGNALED(status)) {
-                result.exit_code = -WTERMSIG(status);
-            }
-        }
-        
-        // Read available data
-        if (config.capture_stdout) {
-            char buffer[4096];
-            ssize_t bytes_read = read(stdout_pipe[0], buffer, sizeof(buffer) - 1);
-            if (bytes_read > 0) {
-                buffer[bytes_read] = '\0';
-                stdout_content += buffer;
-            }
-        }
-        
-        if (config.capture_stderr && !config.merge_stderr_to_stdout) {
-            char buffer[4096];
-            ssize_t bytes_read = read(stderr_pipe[0], buffer, sizeof(buffer) - 1);
-            if (bytes_read > 0) {
-                buffer[bytes_read] = '\0';
-                stderr_content += buffer;
-            }
-        }
-        
-        // Small sleep to avoid busy waiting
-        if (!process_finished) {
-            usleep(10000); // 10ms
-        }
-    }
-    
-    // Final read to get any remaining data
-    if (!timed_out && config.capture_stdout) {
-        char buffer[4096];
-        ssize_t bytes_read;
-        while ((bytes_read = read(stdout_pipe[0], buffer, sizeof(buffer) - 1)) > 0) {
-            buffer[bytes_read] = '\0';
-            stdout_content += buffer;
-        }
-    }
-    
-    if (!timed_out && config.capture_stderr && !config.merge_stderr_to_stdout) {
-        char buffer[4096];
-        ssize_t bytes_read;
-        while ((bytes_read = read(stderr_pipe[0], buffer, sizeof(buffer) - 1)) > 0) {
-            buffer[bytes_read] = '\0';
-            stderr_content += buffer;
-        }
-    }
-    
-    // Close read ends of pipes
-    if (config.capture_stdout) {
-        close(stdout_pipe[0]);
-    }
-    if (config.capture_stderr && !config.merge_stderr_to_stdout) {
-        close(stderr_pipe[0]);
-    }
-    
-    // Wait for process if it hasn't finished yet (in case of timeout)
-    if (!process_finished) {
-        int status;
-        waitpid(pid, &status, 0);
-        if (WIFEXITED(status)) {
-            result.exit_code = WEXITSTATUS(status);
-        } else if (WIFSIGNALED(status)) {
-            result.exit_code = -WTERMSIG(status);
-        }
-    }
-    
-    auto end_time = std::chrono::steady_clock::now();
-    result.duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
-    result.stdout_output = std::move(stdout_content);
-    result.stderr_output = std::move(stderr_content);
-    result.timed_out = timed_out;
-    
-    return result;
+    return run_children(configs, max_in_flight, on_complete, false);
+}
+
+ProcessResult ProcessExecutor::execute_internal(const ProcessConfig& config) {
+    return std::move(run_children({config}, 1, nullptr, true).front());
 }
 
 // Convenience functions
@@ -0,0 +1,170 @@
+#include "shared_memory.h"
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace wip::utils::process {
+
+namespace {
+
+constexpr uint64_t SEGMENT_MAGIC = 0x31304d4853504957ULL;  // "WIPSHM01"
+constexpr size_t HEADER_SIZE = 64;                          // Keeps the message cache-line aligned
+
+// Start of every segment; the message follows at HEADER_SIZE
+struct SegmentHeader {
+    uint64_t magic;
+    std::atomic<uint64_t> size;                             // 0 = no message; stored after the data
+};
+
+static_assert(sizeof(SegmentHeader) <= HEADER_SIZE);
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Segment size must be lock-free to be shared");
+
+[[noreturn]] void throw_errno(const std::string& what) {
+    throw std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+void resize_file(int fd, size_t size) {
+    while (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        if (errno != EINTR) {
+            throw_errno("Cannot resize shared memory segment");
+        }
+    }
+}
+
+size_t file_size(int fd) {
+    struct stat status {};
+    if (fstat(fd, &status) != 0) {
+        throw_errno("Cannot inspect shared memory segment");
+    }
+    return static_cast<size_t>(status.st_size);
+}
+
+} // namespace
+
+SharedMemorySegment SharedMemorySegment::create(const std::string& name) {
+    int fd = memfd_create(name.c_str(), MFD_CLOEXEC);
+    if (fd < 0) {
+        throw_errno("Cannot create shared memory segment");
+    }
+
+    SharedMemorySegment segment(fd);
+    resize_file(fd, HEADER_SIZE);
+    segment.map(HEADER_SIZE);
+    auto* header = static_cast<SegmentHeader*>(segment.mapping_);
+    header->magic = SEGMENT_MAGIC;
+    header->size.store(0, std::memory_order_release);
+    return segment;
+}
+
+SharedMemorySegment SharedMemorySegment::attach(int fd) {
+    int own_fd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+    if (own_fd < 0) {
+        throw_errno("Cannot attach shared memory segment " + std::to_string(fd));
+    }
+
+    SharedMemorySegment segment(own_fd);
+    if (file_size(own_fd) < HEADER_SIZE) {
+        throw std::runtime_error("Descriptor " + std::to_string(fd) + " is not a shared memory segment");
+    }
+    segment.map(HEADER_SIZE);
+    if (static_cast<SegmentHeader*>(segment.mapping_)->magic != SEGMENT_MAGIC) {
+        throw std::runtime_error("Descriptor " + std::to_string(fd) + " is not a shared memory segment");
+    }
+    return segment;
+}
+
+SharedMemorySegment::~SharedMemorySegment() {
+    unmap();
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+}
+
+SharedMemorySegment::SharedMemorySegment(SharedMemorySegment&& other) noexcept
+    : fd_(other.fd_), mapping_(other.mapping_), mapped_size_(other.mapped_size_) {
+    other.fd_ = -1;
+    other.mapping_ = nullptr;
+    other.mapped_size_ = 0;
+}
+
+SharedMemorySegment& SharedMemorySegment::operator=(SharedMemorySegment&& other) noexcept {
+    if (this != &other) {
+        unmap();
+        if (fd_ >= 0) {
+            close(fd_);
+        }
+        fd_ = other.fd_;
+        mapping_ = other.mapping_;
+        mapped_size_ = other.mapped_size_;
+        other.fd_ = -1;
+        other.mapping_ = nullptr;
+        other.mapped_size_ = 0;
+    }
+    return *this;
+}
+
+void SharedMemorySegment::publish(std::string_view data) {
+    clear();
+
+    size_t total_size = HEADER_SIZE + data.size();
+    resize_file(fd_, total_size);
+    map(total_size);
+    if (!data.empty()) {
+        std::memcpy(static_cast<char*>(mapping_) + HEADER_SIZE, data.data(), data.size());
+    }
+    static_cast<SegmentHeader*>(mapping_)->size.store(data.size(), std::memory_order_release);
+}
+
+std::optional<std::string_view> SharedMemorySegment::read() {
+    // The writer may have grown the segment since the last mapping
+    size_t total_size = file_size(fd_);
+    if (total_size < HEADER_SIZE) {
+        return std::nullopt;
+    }
+    map(total_size);
+
+    auto* header = static_cast<SegmentHeader*>(mapping_);
+    uint64_t size = header->size.load(std::memory_order_acquire);
+    if (header->magic != SEGMENT_MAGIC || size == 0 || size > total_size - HEADER_SIZE) {
+        return std::nullopt;
+    }
+    return std::string_view(static_cast<const char*>(mapping_) + HEADER_SIZE, static_cast<size_t>(size));
+}
+
+void SharedMemorySegment::clear() {
+    map(HEADER_SIZE);
+    static_cast<SegmentHeader*>(mapping_)->size.store(0, std::memory_order_release);
+    resize_file(fd_, HEADER_SIZE);
+}
+
+// ==================== Private Helper Methods ====================
+
+void SharedMemorySegment::map(size_t size) {
+    if (mapping_ && mapped_size_ == size) {
+        return;
+    }
+    unmap();
+
+    void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (mapping == MAP_FAILED) {
+        throw_errno("Cannot map shared memory segment");
+    }
+    mapping_ = mapping;
+    mapped_size_ = size;
+}
+
+void SharedMemorySegment::unmap() {
+    if (mapping_) {
+        munmap(mapping_, mapped_size_);
+        mapping_ = nullptr;
+        mapped_size_ = 0;
+    }
+}
+
+} // namespace wip::utils::process
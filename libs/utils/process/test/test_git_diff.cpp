@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include "git_diff.h"
+#include "process.h"
+#include <filesystem>
+#include <fstream>
+
+using namespace wip::utils::process;
+
+namespace {
+
+std::vector<std::pair<int, int>> ranges_of(const FileChanges& file) {
+    std::vector<std::pair<int, int>> ranges;
+    for (const auto& range : file.ranges) {
+        ranges.emplace_back(range.first, range.last);
+    }
+    return ranges;
+}
+
+} // anonymous namespace
+
+TEST(GitDiffTest, ParsesZeroContextHunks) {
+    auto files = parse_unified_diff(
+        "diff --git a/src/a.cpp b/src/a.cpp\n"
+        "index 1111111..2222222 100644\n"
+        "--- a/src/a.cpp\n"
+        "+++ b/src/a.cpp\n"
+        "@@ -3 +3 @@ int main() {\n"
+        "-    return 1;\n"
+        "+    return 0;\n"
+        "@@ -10,0 +11,2 @@\n"
+        "+++counter;\n"
+        "+@@ not a hunk\n"
+        "@@ -20,3 +22,0 @@\n"
+        "-a\n"
+        "-b\n"
+        "-c\n"
+        "diff --git a/old.h b/old.h\n"
+        "deleted file mode 100644\n"
+        "--- a/old.h\n"
+        "+++ /dev/null\n"
+        "@@ -1,2 +0,0 @@\n"
+        "-#pragma once\n"
+        "-int f();\n"
+        "diff --git a/logo.png b/logo.png\n"
+        "Binary files a/logo.png and b/logo.png differ\n"
+        "diff --git a/b/c.h b/b/c.h\n"
+        "--- a/b/c.h\n"
+        "+++ b/b/c.h\n"
+        "@@ -0,0 +1 @@\n"
+        "+#pragma once\n",
+        "/repo");
+
+    ASSERT_EQ(files.size(), 2u);
+    EXPECT_EQ(files[0].path, "/repo/src/a.cpp");
+    EXPECT_EQ(ranges_of(files[0]), (std::vector<std::pair<int, int>>{{3, 3}, {11, 12}, {22, 23}}));
+    EXPECT_EQ(files[1].path, "/repo/b/c.h");
+    EXPECT_EQ(ranges_of(files[1]), (std::vector<std::pair<int, int>>{{1, 1}}));
+}
+
+TEST(GitDiffTest, IgnoresContextLines) {
+    auto files = parse_unified_diff(
+        "--- a.c\t2026-01-01 00:00:00\n"
+        "+++ a.c\t2026-01-02 00:00:00\n"
+        "@@ -1,5 +1,6 @@\n"
+        " one\n"
+        " two\n"
+        "-three\n"
+        " four\n"
+        "+five\n"
+        "+six\n"
+        " seven\n"
+        "\\ No newline at end of file\n");
+
+    ASSERT_EQ(files.size(), 1u);
+    EXPECT_EQ(files[0].path, "a.c");
+    // The removal of "three" touches lines 2 and 3, the additions are lines 4 and 5
+    EXPECT_EQ(ranges_of(files[0]), (std::vector<std::pair<int, int>>{{2, 5}}));
+}
+
+TEST(GitDiffTest, UnquotesPaths) {
+    auto files = parse_unified_diff(
+        "diff --git \"a/my file\\t1.cpp\" \"b/my file\\t1.cpp\"\n"
+        "+++ \"b/my file\\t1.cpp\"\n"
+        "@@ -1 +1 @@\n"
+        "-x\n"
+        "+y\n"
+        "diff --git a/caf\\303\\251.cpp b/caf\\303\\251.cpp\n"
+        "+++ \"b/caf\\303\\251.cpp\"\n"
+        "@@ -2 +2 @@\n"
+        "-x\n"
+        "+y\n");
+
+    ASSERT_EQ(files.size(), 2u);
+    EXPECT_EQ(files[0].path, "my file\t1.cpp");
+    EXPECT_EQ(files[1].path, "caf\xc3\xa9.cpp");
+}
+
+TEST(GitDiffTest, ReadsChangesOfAWorkingTree) {
+    if (!ProcessExecutor::command_exists("git")) {
+        GTEST_SKIP() << "git is not installed";
+    }
+
+    auto repository = std::filesystem::temp_directory_path() / "wip_git_diff_test";
+    std::filesystem::remove_all(repository);
+    std::filesystem::create_directories(repository / "src");
+    ProcessExecutor executor;
+    auto git = [&](std::vector<std::string> arguments) {
+        arguments.insert(arguments.begin(), {"-c", "user.name=test", "-c", "user.email=test@example.com"});
+        ASSERT_TRUE(executor.execute("git", arguments, repository.string()).success());
+    };
+
+    std::ofstream(repository / "src" / "a.cpp") << "int a() {\n    return 1;\n}\n";
+    git({"init", "-q"});
+    git({"add", "."});
+    git({"commit", "-q", "-m", "initial"});
+    std::ofstream(repository / "src" / "a.cpp") << "int a() {\n    return 2;\n}\n";
+
+    auto files = git_changed_lines((repository / "src").string());
+    ASSERT_EQ(files.size(), 1u);
+    EXPECT_EQ(std::filesystem::path(files[0].path).filename(), "a.cpp");
+    EXPECT_TRUE(std::filesystem::equivalent(files[0].path, repository / "src" / "a.cpp"));
+    EXPECT_EQ(ranges_of(files[0]), (std::vector<std::pair<int, int>>{{2, 2}}));
+
+    EXPECT_THROW(git_changed_lines(repository.string(), "no-such-revision"), std::runtime_error);
+    std::filesystem::remove_all(repository);
+}
@@ -2,6 +2,9 @@
 #include "process.h"
 #include <chrono>
 #include <filesystem>
+#include <fstream>
+#include <thread>
+#include <signal.h>
 
 using namespace wip::utils::process;
 
@@ -73,6 +76,34 @@ TEST_F(ProcessTest, Timeout) {
     EXPECT_LE(result.duration.count(), 1000); // Should timeout before 1 second
 }
 
+TEST_F(ProcessTest, ShortCommandsReturnPromptly) {
+    // The read loop waits for events instead of sleeping between checks
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_TRUE(executor.execute("true").success());
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_LT(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count(), 200);
+}
+
+TEST_F(ProcessTest, ReturnsWhenDescendantKeepsPipesOpen) {
+    std::vector<std::string> args = {"-c", "sleep 3 & echo done"};
+    auto result = executor.execute("sh", args);
+    
+    EXPECT_TRUE(result.success());
+    EXPECT_EQ(result.stdout_output, "done\n");
+    EXPECT_LT(result.duration.count(), 2000);
+}
+
+TEST_F(ProcessTest, LargeAndBinaryOutput) {
+    std::vector<std::string> args = {"-c", "head -c 1000000 /dev/zero; printf 'a\\000b' >&2"};
+    auto result = executor.execute("sh", args);
+    
+    EXPECT_TRUE(result.success());
+    EXPECT_EQ(result.stdout_output.size(), 1000000);
+    EXPECT_EQ(result.stderr_output, std::string("a\0b", 3));
+}
+
 TEST_F(ProcessTest, CommandExists) {
     EXPECT_TRUE(ProcessExecutor::command_exists("echo"));
     EXPECT_TRUE(ProcessExecutor::command_exists("ls"));
@@ -145,4 +176,311 @@ TEST_F(ProcessTest, CommandWithArguments) {
         EXPECT_TRUE(result.stdout_output.find("Usage") != std::string::npos || 
                    result.stdout_output.find("--help") != std::string::npos);
     }
-}
\ No newline at end of file
+}
+// Both launch paths must behave the same for every config option
+TEST_F(ProcessTest, LaunchMethodsAreEquivalent) {
+    std::filesystem::path temp_dir = std::filesystem::temp_directory_path() / "process_launch_test";
+    std::filesystem::create_directories(temp_dir);
+    
+    for (auto method : {LaunchMethod::Fork, LaunchMethod::Spawn}) {
+        SCOPED_TRACE(method == LaunchMethod::Fork ? "fork" : "spawn");
+        
+        auto config = ProcessConfig::from_command_args("sh", {"-c", "pwd; echo err >&2; exit 3"});
+        config.working_directory = temp_dir.string();
+        config.launch_method = method;
+        auto result = executor.execute(config);
+        EXPECT_EQ(result.exit_code, 3);
+        EXPECT_EQ(result.stdout_output, temp_dir.string() + "\n");
+        EXPECT_EQ(result.stderr_output, "err\n");
+        
+        config.merge_stderr_to_stdout = true;
+        result = executor.execute(config);
+        EXPECT_EQ(result.stdout_output, temp_dir.string() + "\nerr\n");
+        EXPECT_TRUE(result.stderr_output.empty());
+        
+        config.capture_stdout = false;
+        config.capture_stderr = false;
+        config.arguments = {"-c", "exit 0"};
+        EXPECT_TRUE(executor.execute(config).success());
+        
+        auto missing = ProcessConfig::from_command("nonexistent_command_12345");
+        missing.launch_method = method;
+        EXPECT_EQ(executor.execute(missing).exit_code, 127);
+        
+        auto bad_directory = ProcessConfig::from_command("true");
+        bad_directory.working_directory = (temp_dir / "missing").string();
+        bad_directory.launch_method = method;
+        EXPECT_EQ(executor.execute(bad_directory).exit_code, 127);
+    }
+    
+    std::filesystem::remove_all(temp_dir);
+}
+
+TEST_F(ProcessTest, UsesSpawnByDefault) {
+    auto config = ProcessConfig::from_command("true");
+    EXPECT_TRUE(ProcessExecutor::uses_spawn(config));
+    
+    config.launch_method = LaunchMethod::Fork;
+    EXPECT_FALSE(ProcessExecutor::uses_spawn(config));
+}
+
+TEST_F(ProcessTest, BatchReturnsResultsInConfigOrder) {
+    std::vector<ProcessConfig> configs;
+    for (int i = 0; i < 8; ++i) {
+        configs.push_back(ProcessConfig::from_command_args("sh", {"-c", "echo " + std::to_string(i) + "; exit " + std::to_string(i % 3)}));
+    }
+    
+    auto results = executor.execute_batch(configs, 3);
+    
+    ASSERT_EQ(results.size(), 8);
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_EQ(results[i].stdout_output, std::to_string(i) + "\n");
+        EXPECT_EQ(results[i].exit_code, i % 3);
+    }
+}
+
+TEST_F(ProcessTest, BatchReportsCompletionOrder) {
+    std::vector<ProcessConfig> configs = {
+        ProcessConfig::from_command_args("sh", {"-c", "sleep 0.3; echo slow"}),
+        ProcessConfig::from_command_args("sh", {"-c", "echo fast"}),
+    };
+    
+    std::vector<size_t> completed;
+    auto results = executor.execute_batch(configs, 2, [&](size_t index, const ProcessResult& result) {
+        EXPECT_TRUE(result.success());
+        completed.push_back(index);
+    });
+    
+    ASSERT_EQ(completed.size(), 2);
+    EXPECT_EQ(completed[0], 1);
+    EXPECT_EQ(completed[1], 0);
+    EXPECT_EQ(results[0].stdout_output, "slow\n");
+}
+
+TEST_F(ProcessTest, BatchLimitsProcessesInFlight) {
+    std::vector<ProcessConfig> configs(4, ProcessConfig::from_command_args("sleep", {"0.2"}));
+    
+    auto start = std::chrono::steady_clock::now();
+    auto results = executor.execute_batch(configs, 2);
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    
+    // Two waves of two processes
+    EXPECT_GE(elapsed.count(), 400);
+    EXPECT_LT(elapsed.count(), 1500);
+    for (const auto& result : results) {
+        EXPECT_TRUE(result.success());
+    }
+}
+
+TEST_F(ProcessTest, BatchTimeoutsAndFailuresAreIsolated) {
+    auto slow = ProcessConfig::from_command_args("sleep", {"5"});
+    slow.timeout = std::chrono::milliseconds(200);
+    std::vector<ProcessConfig> configs = {
+        slow,
+        ProcessConfig::from_command("nonexistent_command_12345"),
+        ProcessConfig::from_command("echo ok"),
+    };
+    
+    auto results = executor.execute_batch(configs);
+    
+    ASSERT_EQ(results.size(), 3);
+    EXPECT_TRUE(results[0].timed_out);
+    EXPECT_LT(results[0].duration.count(), 1000);
+    EXPECT_EQ(results[1].exit_code, 127);
+    EXPECT_EQ(results[2].stdout_output, "ok\n");
+    EXPECT_TRUE(executor.execute_batch({}).empty());
+}
+
+TEST_F(ProcessTest, LineSplitterJoinsChunks) {
+    std::vector<std::pair<OutputStream, std::string>> lines;
+    LineSplitter splitter([&](OutputStream stream, std::string_view line) {
+        lines.emplace_back(stream, std::string(line));
+    });
+    
+    splitter.feed(OutputStream::Stdout, "first\nsec");
+    splitter.feed(OutputStream::Stderr, "err");
+    splitter.feed(OutputStream::Stdout, "ond\n\nthi");
+    splitter.feed(OutputStream::Stderr, "or\n");
+    splitter.feed(OutputStream::Stdout, "rd");
+    splitter.flush();
+    
+    std::vector<std::pair<OutputStream, std::string>> expected = {
+        {OutputStream::Stdout, "first"},
+        {OutputStream::Stdout, "second"},
+        {OutputStream::Stdout, ""},
+        {OutputStream::Stderr, "error"},
+        {OutputStream::Stdout, "third"},
+    };
+    EXPECT_EQ(lines, expected);
+}
+
+TEST_F(ProcessTest, StreamsOutputWithoutBuffering) {
+    // Far more output than one read, so lines straddle chunk boundaries
+    auto config = ProcessConfig::from_command_args("sh", {"-c", "seq 1 100000; echo done >&2"});
+    size_t stdout_lines = 0;
+    long long sum = 0;
+    std::string stderr_text;
+    LineSplitter splitter([&](OutputStream stream, std::string_view line) {
+        if (stream == OutputStream::Stdout) {
+            ++stdout_lines;
+            sum += std::stoll(std::string(line));
+        } else {
+            stderr_text += line;
+        }
+    });
+    config.output_callback = splitter.as_output_callback();
+    config.buffer_output = false;
+    
+    auto result = executor.execute(config);
+    splitter.flush();
+    
+    EXPECT_TRUE(result.success());
+    EXPECT_TRUE(result.stdout_output.empty());
+    EXPECT_TRUE(result.stderr_output.empty());
+    EXPECT_EQ(stdout_lines, 100000);
+    EXPECT_EQ(sum, 100000LL * 100001 / 2);
+    EXPECT_EQ(stderr_text, "done");
+}
+
+TEST_F(ProcessTest, StreamedAndBufferedOutputMatch) {
+    auto config = ProcessConfig::from_command_args("sh", {"-c", "head -c 300000 /dev/zero | tr '\\0' 'x'; echo; echo err >&2"});
+    std::string streamed_stdout;
+    std::string streamed_stderr;
+    config.output_callback = [&](OutputStream stream, std::string_view chunk) {
+        (stream == OutputStream::Stdout ? streamed_stdout : streamed_stderr).append(chunk);
+    };
+    
+    auto result = executor.execute(config);
+    
+    EXPECT_EQ(result.stdout_output.size(), 300001);
+    EXPECT_EQ(streamed_stdout, result.stdout_output);
+    EXPECT_EQ(streamed_stderr, "err\n");
+    EXPECT_EQ(streamed_stderr, result.stderr_output);
+}
+
+TEST_F(ProcessTest, CancellationStopsProcessGroupPromptly) {
+    auto pid_file = std::filesystem::temp_directory_path() / "wip_process_cancel_test.pid";
+    std::filesystem::remove(pid_file);
+    
+    // The shell's background child must be stopped together with the shell
+    auto config = ProcessConfig::from_command_args("sh", {"-c", "sleep 30 & echo $! > " + pid_file.string() + "; wait"});
+    config.own_process_group = true;
+    config.cancellation = CancellationToken::create();
+    
+    std::thread canceller([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        config.cancellation.cancel();
+    });
+    auto start = std::chrono::steady_clock::now();
+    auto result = executor.execute(config);
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    canceller.join();
+    
+    EXPECT_TRUE(result.cancelled);
+    EXPECT_FALSE(result.timed_out);
+    EXPECT_FALSE(result.success());
+    EXPECT_LT(elapsed.count(), 1000);
+    
+    pid_t background_pid = 0;
+    std::ifstream(pid_file) >> background_pid;
+    std::filesystem::remove(pid_file);
+    ASSERT_GT(background_pid, 0);
+    
+    // The orphaned sleep is killed with the group; it may linger as a zombie
+    // until init reaps it, so check its state rather than its existence
+    auto is_running = [](pid_t pid) {
+        std::ifstream stat_file("/proc/" + std::to_string(pid) + "/stat");
+        if (!stat_file.is_open()) {
+            return kill(pid, 0) == 0;
+        }
+        std::string pid_field, name, state;
+        stat_file >> pid_field >> name >> state;
+        return state != "Z" && state != "X";
+    };
+    bool background_alive = true;
+    for (int i = 0; i < 100 && background_alive; ++i) {
+        background_alive = is_running(background_pid);
+        if (background_alive) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+    EXPECT_FALSE(background_alive);
+}
+
+TEST_F(ProcessTest, CancelledBatchSkipsPendingProcesses) {
+    auto token = CancellationToken::create();
+    std::vector<ProcessConfig> configs(4, ProcessConfig::from_command_args("sleep", {"30"}));
+    for (auto& config : configs) {
+        config.cancellation = token;
+    }
+    
+    std::thread canceller([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        token.cancel();
+    });
+    auto start = std::chrono::steady_clock::now();
+    auto results = executor.execute_batch(configs, 2);
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    canceller.join();
+    
+    EXPECT_LT(elapsed.count(), 1000);
+    for (const auto& result : results) {
+        EXPECT_TRUE(result.cancelled);
+    }
+    EXPECT_EQ(results[3].exit_code, -1);    // Never started
+}
+
+TEST_F(ProcessTest, DefaultTokenIsNeverCancelled) {
+    CancellationToken token;
+    token.cancel();
+    EXPECT_FALSE(token.can_be_cancelled());
+    EXPECT_FALSE(token.is_cancelled());
+    EXPECT_EQ(token.get_wait_fd(), -1);
+    
+    auto shared = CancellationToken::create();
+    auto copy = shared;
+    copy.cancel();
+    EXPECT_TRUE(shared.is_cancelled());
+    EXPECT_EQ(copy, shared);
+}
+
+TEST_F(ProcessTest, ReportsPhaseTimings) {
+    // Busy loop in the shell so the child uses measurable CPU time
+    auto result = executor.execute("sh", std::vector<std::string>{"-c", "i=0; while [ $i -lt 100000 ]; do i=$((i+1)); done; echo done"});
+    
+    ASSERT_TRUE(result.success());
+    EXPECT_EQ(result.stdout_output, "done\n");
+    EXPECT_GT(result.spawn_time.count(), 0);
+    EXPECT_GT(result.cpu_time.count(), 0);
+    EXPECT_LE(result.cpu_time, result.duration + std::chrono::milliseconds(10));
+    EXPECT_EQ(result.cpu_time, result.user_cpu_time + result.system_cpu_time);
+    EXPECT_GT(result.capture_time.count(), 0);
+}
+
+TEST_F(ProcessTest, ReportsResourceUsage) {
+    // The shell touches a 16 MiB string, so the peak RSS must exceed it
+    auto result = executor.execute("sh", std::vector<std::string>{"-c",
+        "s=$(head -c 16777216 /dev/zero | tr '\\0' x); echo ${#s}; sleep 0.05"});
+    
+    ASSERT_TRUE(result.success());
+    EXPECT_EQ(result.stdout_output, "16777216\n");
+    EXPECT_GE(result.max_rss_kb, 16384u);
+    EXPECT_GT(result.voluntary_context_switches + result.involuntary_context_switches, 0u);
+}
+
+TEST_F(ProcessTest, ExecuteAsyncRunsOnThePool) {
+    wip::utils::concurrency::ThreadPool pool(2);
+    auto config = ProcessConfig::from_command_args("echo", {"from the pool"});
+    auto task = ProcessExecutor::execute_async(config, pool);
+    
+    auto result = task.get();
+    EXPECT_TRUE(result.success());
+    EXPECT_EQ(result.stdout_output, "from the pool\n");
+    
+    auto cancelled = ProcessConfig::from_command_args("sleep", {"5"});
+    cancelled.cancellation = CancellationToken::create();
+    cancelled.cancellation.cancel();
+    auto skipped = ProcessExecutor::execute_async(cancelled, pool).get();
+    EXPECT_TRUE(skipped.cancelled);
+    EXPECT_LT(skipped.duration, std::chrono::seconds(1));
+}
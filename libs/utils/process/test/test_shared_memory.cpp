@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include "shared_memory.h"
+#include "process.h"
+#include <stdexcept>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace wip::utils::process;
+
+TEST(SharedMemoryTest, ReadsPublishedMessage) {
+    auto segment = SharedMemorySegment::create("test");
+    EXPECT_FALSE(segment.read().has_value());
+
+    segment.publish("first");
+    ASSERT_TRUE(segment.read().has_value());
+    EXPECT_EQ(*segment.read(), "first");
+
+    // A longer message grows the segment; a shorter one replaces it whole
+    std::string large(1 << 20, 'x');
+    segment.publish(large);
+    EXPECT_EQ(*segment.read(), large);
+    segment.publish("short");
+    EXPECT_EQ(*segment.read(), "short");
+
+    segment.clear();
+    EXPECT_FALSE(segment.read().has_value());
+}
+
+TEST(SharedMemoryTest, ReadsMessageOfForkedChild) {
+    auto segment = SharedMemorySegment::create("test");
+    std::string message(100000, '\0');
+    for (size_t i = 0; i < message.size(); ++i) {
+        message[i] = static_cast<char>(i % 251);
+    }
+
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        SharedMemorySegment::attach(segment.get_fd()).publish(message);
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    ASSERT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+    auto received = segment.read();
+    ASSERT_TRUE(received.has_value());
+    EXPECT_EQ(*received, message);
+}
+
+TEST(SharedMemoryTest, RejectsOtherDescriptors) {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    EXPECT_THROW(SharedMemorySegment::attach(fds[0]), std::runtime_error);
+    close(fds[0]);
+    close(fds[1]);
+
+    EXPECT_THROW(SharedMemorySegment::attach(-1), std::runtime_error);
+}
+
+// The segment is close-on-exec, so only children given its descriptor see it
+TEST(SharedMemoryTest, PassesSegmentToChildThroughInheritedFds) {
+    ProcessExecutor executor;
+    auto segment = SharedMemorySegment::create("inherited");
+    std::string fd = std::to_string(segment.get_fd());
+
+    for (auto method : {LaunchMethod::Fork, LaunchMethod::Spawn}) {
+        SCOPED_TRACE(method == LaunchMethod::Fork ? "fork" : "spawn");
+
+        auto config = ProcessConfig::from_command_args("sh", {"-c", "readlink /proc/self/fd/" + fd});
+        config.launch_method = method;
+        auto result = executor.execute(config);
+        EXPECT_FALSE(result.success());
+
+        config.inherited_fds.push_back(segment.get_fd());
+        result = executor.execute(config);
+        EXPECT_TRUE(result.success());
+        EXPECT_NE(result.stdout_output.find("memfd:inherited"), std::string::npos);
+    }
+}
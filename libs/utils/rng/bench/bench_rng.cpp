@@ -0,0 +1,58 @@
+// Benchmark for the single-value and bulk random generation functions.
+//
+// Generates the same number of integers, uniform doubles and normal doubles
+// with one call per value (Mersenne Twister through the std distributions)
+// and with the fill functions (interleaved xoshiro256++ streams), and
+// reports the time per value in nanoseconds. Usage:
+//
+//   bench_wip_utils_rng [values]
+
+#include "benchmark.h"
+#include "rng.h"
+#include <vector>
+
+namespace rng = wip::utils::rng;
+
+int main(int argc, char* argv[]) {
+    wip::benchmark::Runner runner("bench_wip_utils_rng", argc, argv, "[values]");
+    size_t count = runner.argument(0, 50000000);
+    rng::RandomGenerator generator(12345);
+    std::vector<int> ints(count);
+    std::vector<double> doubles(count);
+    runner.out() << "Generating " << count << " values" << std::endl;
+
+    runner.measure("uniform_int (1-6) per call", count, [&]() {
+        for (auto& value : ints) {
+            value = generator.uniform_int(1, 6);
+        }
+        return ints.back();
+    });
+    runner.measure("fill_uniform_int (1-6)", count, [&]() {
+        generator.fill_uniform_int(ints.data(), ints.size(), 1, 6);
+        return ints.back();
+    });
+
+    runner.measure("uniform_double per call", count, [&]() {
+        for (auto& value : doubles) {
+            value = generator.uniform_double();
+        }
+        return doubles.back() * 1e6;
+    });
+    runner.measure("fill_uniform_double", count, [&]() {
+        generator.fill_uniform_double(doubles.data(), doubles.size());
+        return doubles.back() * 1e6;
+    });
+
+    runner.measure("normal per call", count, [&]() {
+        for (auto& value : doubles) {
+            value = generator.normal(100.0, 15.0);
+        }
+        return doubles.back();
+    });
+    runner.measure("fill_normal", count, [&]() {
+        generator.fill_normal(doubles.data(), doubles.size(), 100.0, 15.0);
+        return doubles.back();
+    });
+
+    return runner.finish();
+}
@@ -1,26 +1,233 @@
 #include "rng.h"
+#include <cmath>
+#include <cstring>
 #include <mutex>
 #include <numeric>
 #include <stdexcept>
 #include <thread>
 
+#if (defined(__x86_64__) || defined(_M_X64)) && (defined(__GNUC__) || defined(__clang__)) && \
+    !defined(WIP_RNG_PORTABLE)
+#define WIP_RNG_AVX2 1
+#include <immintrin.h>
+#endif
+
 namespace wip::utils::rng {
 
+namespace {
+
+constexpr size_t BULK_LANES = 4;
+
+// Raw words the fill functions generate at a time, on the stack
+constexpr size_t BULK_BLOCK = 256;
+
+// Maps the upper 53 bits of a word to [0, 1)
+constexpr double TO_UNIT = 1.0 / 9007199254740992.0; // 2^-53
+
+inline uint64_t rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+uint64_t splitmix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// One xoshiro256++ step on a single state
+uint64_t xoshiro_next(uint64_t (&s)[4]) {
+    const uint64_t result = rotl(s[0] + s[3], 23) + s[0];
+    const uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    return result;
+}
+
+// Advances a state by 2^128 steps, so streams started from successive jumps never overlap
+void xoshiro_jump(uint64_t (&s)[4]) {
+    static const uint64_t jump[] = {0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL,
+                                    0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL};
+    uint64_t result[4] = {0, 0, 0, 0};
+    for (uint64_t word : jump) {
+        for (int bit = 0; bit < 64; ++bit) {
+            if (word & (uint64_t{1} << bit)) {
+                for (size_t i = 0; i < 4; ++i) {
+                    result[i] ^= s[i];
+                }
+            }
+            xoshiro_next(s);
+        }
+    }
+    std::copy(result, result + 4, s);
+}
+
+// ==================== Bulk Streams ====================
+
+using BulkState = uint64_t[4][BULK_LANES];
+
+// Steps all lanes count / BULK_LANES times, writing one word per lane and step
+void generate_bits_portable(BulkState& state, uint64_t* bits, size_t count) noexcept {
+    // Local copies and a fixed lane count let the compiler keep the lanes in vector registers
+    uint64_t s0[BULK_LANES], s1[BULK_LANES], s2[BULK_LANES], s3[BULK_LANES];
+    for (size_t lane = 0; lane < BULK_LANES; ++lane) {
+        s0[lane] = state[0][lane];
+        s1[lane] = state[1][lane];
+        s2[lane] = state[2][lane];
+        s3[lane] = state[3][lane];
+    }
+    
+    for (size_t i = 0; i < count; i += BULK_LANES) {
+        for (size_t lane = 0; lane < BULK_LANES; ++lane) {
+            bits[i + lane] = rotl(s0[lane] + s3[lane], 23) + s0[lane];
+            const uint64_t t = s1[lane] << 17;
+            s2[lane] ^= s0[lane];
+            s3[lane] ^= s1[lane];
+            s1[lane] ^= s2[lane];
+            s0[lane] ^= s3[lane];
+            s2[lane] ^= t;
+            s3[lane] = rotl(s3[lane], 45);
+        }
+    }
+    
+    for (size_t lane = 0; lane < BULK_LANES; ++lane) {
+        state[0][lane] = s0[lane];
+        state[1][lane] = s1[lane];
+        state[2][lane] = s2[lane];
+        state[3][lane] = s3[lane];
+    }
+}
+
+#ifdef WIP_RNG_AVX2
+__attribute__((target("avx2")))
+inline __m256i rotl_avx2(__m256i x, int k) noexcept {
+    return _mm256_or_si256(_mm256_slli_epi64(x, k), _mm256_srli_epi64(x, 64 - k));
+}
+
+// The same steps as generate_bits_portable() with each state word of all lanes in one register
+__attribute__((target("avx2")))
+void generate_bits_avx2(BulkState& state, uint64_t* bits, size_t count) noexcept {
+    __m256i s0 = _mm256_load_si256(reinterpret_cast<const __m256i*>(state[0]));
+    __m256i s1 = _mm256_load_si256(reinterpret_cast<const __m256i*>(state[1]));
+    __m256i s2 = _mm256_load_si256(reinterpret_cast<const __m256i*>(state[2]));
+    __m256i s3 = _mm256_load_si256(reinterpret_cast<const __m256i*>(state[3]));
+    
+    for (size_t i = 0; i < count; i += BULK_LANES) {
+        __m256i result = _mm256_add_epi64(rotl_avx2(_mm256_add_epi64(s0, s3), 23), s0);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(bits + i), result);
+        const __m256i t = _mm256_slli_epi64(s1, 17);
+        s2 = _mm256_xor_si256(s2, s0);
+        s3 = _mm256_xor_si256(s3, s1);
+        s1 = _mm256_xor_si256(s1, s2);
+        s0 = _mm256_xor_si256(s0, s3);
+        s2 = _mm256_xor_si256(s2, t);
+        s3 = rotl_avx2(s3, 45);
+    }
+    
+    _mm256_store_si256(reinterpret_cast<__m256i*>(state[0]), s0);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(state[1]), s1);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(state[2]), s2);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(state[3]), s3);
+    _mm256_zeroupper();
+}
+#endif
+
+using GenerateBits = void (*)(BulkState&, uint64_t*, size_t) noexcept;
+
+GenerateBits select_generate_bits() noexcept {
+#ifdef WIP_RNG_AVX2
+    if (__builtin_cpu_supports("avx2")) {
+        return generate_bits_avx2;
+    }
+#endif
+    return generate_bits_portable;
+}
+
+// ==================== Philox ====================
+
+// Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3"):
+// ten rounds of multiplications and key additions over a 128-bit counter
+void philox4x32(uint32_t (&counter)[4], uint32_t key0, uint32_t key1) {
+    constexpr uint32_t M0 = 0xD2511F53;
+    constexpr uint32_t M1 = 0xCD9E8D57;
+    constexpr uint32_t W0 = 0x9E3779B9;
+    constexpr uint32_t W1 = 0xBB67AE85;
+    
+    for (int round = 0; round < 10; ++round) {
+        const uint64_t product0 = uint64_t{M0} * counter[0];
+        const uint64_t product1 = uint64_t{M1} * counter[2];
+        const uint32_t next[4] = {
+            static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ key0,
+            static_cast<uint32_t>(product1),
+            static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ key1,
+            static_cast<uint32_t>(product0),
+        };
+        std::copy(next, next + 4, counter);
+        key0 += W0;
+        key1 += W1;
+    }
+}
+
+// Marsaglia and Tsang's ziggurat for the normal distribution with 128 layers.
+// A word supplies the layer (bits 0-6), the sign (bit 7) and a 52-bit
+// magnitude; the fast path accepts about 99% of the words outright.
+struct Ziggurat {
+    static constexpr double R = 3.442619855899;  // Start of the tail
+    static constexpr double SCALE = 4503599627370496.0; // 2^52
+    
+    std::array<uint64_t, 128> k;  // Magnitudes below k[i] lie inside layer i's rectangle
+    std::array<double, 128> w;    // Magnitude to x in layer i
+    std::array<double, 128> f;    // Density at layer i's edge
+    
+    Ziggurat() {
+        const double area = 9.91256303526217e-3;
+        double edge = R;
+        double previous = R;
+        const double q = area / std::exp(-0.5 * edge * edge);
+        k[0] = static_cast<uint64_t>((edge / q) * SCALE);
+        k[1] = 0;
+        w[0] = q / SCALE;
+        w[127] = edge / SCALE;
+        f[0] = 1.0;
+        f[127] = std::exp(-0.5 * edge * edge);
+        for (size_t i = 126; i >= 1; --i) {
+            edge = std::sqrt(-2.0 * std::log(area / edge + std::exp(-0.5 * edge * edge)));
+            k[i + 1] = static_cast<uint64_t>((edge / previous) * SCALE);
+            previous = edge;
+            f[i] = std::exp(-0.5 * edge * edge);
+            w[i] = edge / SCALE;
+        }
+    }
+    
+    static const Ziggurat& get() {
+        static const Ziggurat table;
+        return table;
+    }
+};
+
+} // namespace
+
 // Thread-local storage for distributions
 thread_local std::uniform_real_distribution<double> RandomGenerator::uniform_real_(0.0, 1.0);
 
 // ==================== RandomGenerator Implementation ====================
 
 RandomGenerator::RandomGenerator() 
-    : gen_(std::chrono::high_resolution_clock::now().time_since_epoch().count()) {
+    : RandomGenerator(static_cast<result_type>(std::chrono::high_resolution_clock::now().time_since_epoch().count())) {
 }
 
 RandomGenerator::RandomGenerator(result_type seed) 
     : gen_(seed) {
+    seed_bulk(seed);
 }
 
 void RandomGenerator::seed(result_type seed) {
     gen_.seed(seed);
+    seed_bulk(seed);
 }
 
 int RandomGenerator::uniform_int(int min, int max) {
@@ -124,6 +331,154 @@ std::vector<double> RandomGenerator::doubles(size_t count, double min, double ma
     return result;
 }
 
+// ==================== Bulk Generation ====================
+
+void RandomGenerator::seed_bulk(result_type seed) {
+    // Lane 0 starts from the seed, every further lane one jump ahead of the previous
+    uint64_t mix = seed;
+    uint64_t state[4];
+    for (auto& word : state) {
+        word = splitmix64(mix);
+    }
+    for (size_t lane = 0; lane < BULK_LANES; ++lane) {
+        for (size_t i = 0; i < 4; ++i) {
+            bulk_[i][lane] = state[i];
+        }
+        xoshiro_jump(state);
+    }
+}
+
+void RandomGenerator::fill_bits(uint64_t* bits, size_t count) {
+    static const GenerateBits generate = select_generate_bits();
+    generate(bulk_, bits, count);
+}
+
+uint64_t RandomGenerator::next_bits() {
+    uint64_t state[4] = {bulk_[0][0], bulk_[1][0], bulk_[2][0], bulk_[3][0]};
+    uint64_t result = xoshiro_next(state);
+    for (size_t i = 0; i < 4; ++i) {
+        bulk_[i][0] = state[i];
+    }
+    return result;
+}
+
+void RandomGenerator::fill_uniform_int(int* values, size_t count, int min, int max) {
+    if (min > max) {
+        throw std::invalid_argument("min cannot be greater than max");
+    }
+    
+    // Lemire's multiply-shift reduction of 32-bit draws, two per word. A draw
+    // is biased only when the low half of its product falls below threshold,
+    // which is rare (never for power-of-two ranges), and is then redrawn.
+    const uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(max) - min) + 1;
+    const uint64_t threshold = ((uint64_t{1} << 32) - range) % range;
+    // The full 32-bit range (factor 0) is the only one that does not fit a 32-bit factor
+    const uint32_t factor = static_cast<uint32_t>(range);
+    const uint64_t multiplier = factor == 0 ? uint64_t{1} << 32 : factor;
+    auto reduce = [multiplier, min](uint32_t draw) {
+        return static_cast<int>(min + static_cast<int64_t>((uint64_t{draw} * multiplier) >> 32));
+    };
+    auto is_biased = [factor, threshold](uint32_t draw) {
+        return static_cast<uint32_t>(uint64_t{draw} * factor) < threshold;
+    };
+    
+    uint64_t bits[BULK_BLOCK];
+    while (count > 0) {
+        const size_t draws = std::min(count, BULK_BLOCK * 2);
+        const size_t words = (draws + 1) / 2;
+        fill_bits(bits, (words + BULK_LANES - 1) / BULK_LANES * BULK_LANES);
+        
+        // The even draw comes from the low half of a word, the odd one from the high half
+        bool biased = false;
+        for (size_t w = 0; w < draws / 2; ++w) {
+            const auto low = static_cast<uint32_t>(bits[w]);
+            const auto high = static_cast<uint32_t>(bits[w] >> 32);
+            values[2 * w] = reduce(low);
+            values[2 * w + 1] = reduce(high);
+            biased |= is_biased(low) | is_biased(high);
+        }
+        if (draws % 2 != 0) {
+            const auto low = static_cast<uint32_t>(bits[words - 1]);
+            values[draws - 1] = reduce(low);
+            biased |= is_biased(low);
+        }
+        
+        for (size_t i = 0; biased && i < draws; ++i) {
+            auto draw = static_cast<uint32_t>(bits[i / 2] >> (i % 2 * 32));
+            if (is_biased(draw)) {
+                do {
+                    draw = static_cast<uint32_t>(next_bits() >> 32);
+                } while (is_biased(draw));
+                values[i] = reduce(draw);
+            }
+        }
+        
+        values += draws;
+        count -= draws;
+    }
+}
+
+void RandomGenerator::fill_uniform_double(double* values, size_t count, double min, double max) {
+    const double scale = max - min;
+    
+    uint64_t bits[BULK_BLOCK];
+    while (count > 0) {
+        const size_t draws = std::min(count, BULK_BLOCK);
+        fill_bits(bits, (draws + BULK_LANES - 1) / BULK_LANES * BULK_LANES);
+        for (size_t i = 0; i < draws; ++i) {
+            // The upper 52 bits as the mantissa of a double in [1, 2): integer
+            // operations only, so the loop vectorizes where conversions would not
+            uint64_t unit_bits = (bits[i] >> 12) | 0x3FF0000000000000ULL;
+            double unit;
+            std::memcpy(&unit, &unit_bits, sizeof(unit));
+            values[i] = min + (unit - 1.0) * scale;
+        }
+        values += draws;
+        count -= draws;
+    }
+}
+
+void RandomGenerator::fill_normal(double* values, size_t count, double mean, double stddev) {
+    const Ziggurat& table = Ziggurat::get();
+    // Uniform in (0, 1), for the logarithms of the slow path
+    auto open_unit = [this]() { return (static_cast<double>(next_bits() >> 11) + 0.5) * TO_UNIT; };
+    
+    uint64_t bits[BULK_BLOCK];
+    while (count > 0) {
+        const size_t draws = std::min(count, BULK_BLOCK);
+        fill_bits(bits, (draws + BULK_LANES - 1) / BULK_LANES * BULK_LANES);
+        for (size_t i = 0; i < draws; ++i) {
+            uint64_t word = bits[i];
+            double x;
+            while (true) {
+                const size_t layer = word & 127;
+                const uint64_t magnitude = word >> 12;
+                x = static_cast<double>(magnitude) * table.w[layer];
+                if (magnitude < table.k[layer]) {
+                    break;
+                }
+                if (layer == 0) {
+                    // The tail beyond R, by Marsaglia's exponential method
+                    double y;
+                    do {
+                        x = -std::log(open_unit()) / Ziggurat::R;
+                        y = -std::log(open_unit());
+                    } while (y + y < x * x);
+                    x += Ziggurat::R;
+                    break;
+                }
+                if (table.f[layer] + open_unit() * (table.f[layer - 1] - table.f[layer]) < std::exp(-0.5 * x * x)) {
+                    break;
+                }
+                word = next_bits();
+            }
+            values[i] = mean + stddev * ((word & 128) ? -x : x);
+        }
+        values += draws;
+        count -= draws;
+    }
+}
+
 // ==================== Global Functions ====================
 
 RandomGenerator& global() {
@@ -261,4 +616,76 @@ double FastRandomGenerator::uniform_double() {
     return static_cast<double>(value) * (1.0 / 9007199254740992.0); // 2^53
 }
 
+// ==================== StreamRandomGenerator Implementation ====================
+
+StreamRandomGenerator::StreamRandomGenerator()
+    : StreamRandomGenerator((static_cast<result_type>(std::random_device{}()) << 32) | std::random_device{}()) {
+}
+
+StreamRandomGenerator::StreamRandomGenerator(result_type seed, uint64_t stream_id)
+    : key_(seed), stream_(stream_id) {
+}
+
+void StreamRandomGenerator::seed(result_type seed) {
+    key_ = seed;
+    block_ = 0;
+    half_ = 0;
+    buffered_ = false;
+}
+
+StreamRandomGenerator StreamRandomGenerator::stream(uint64_t id) const {
+    return StreamRandomGenerator(key_, id);
+}
+
+StreamRandomGenerator StreamRandomGenerator::split() {
+    // A fresh key rather than a fresh id keeps split generators apart from the numbered streams
+    uint64_t mix = next();
+    return StreamRandomGenerator(splitmix64(mix), stream_);
+}
+
+void StreamRandomGenerator::jump(uint64_t count) {
+    const uint64_t half = half_ + (count & 1);
+    block_ += (count >> 1) + (half >> 1);
+    half_ = static_cast<unsigned>(half & 1);
+    buffered_ = false;
+}
+
+StreamRandomGenerator::result_type StreamRandomGenerator::next() {
+    if (!buffered_) {
+        uint32_t counter[4] = {static_cast<uint32_t>(block_), static_cast<uint32_t>(block_ >> 32),
+                               static_cast<uint32_t>(stream_), static_cast<uint32_t>(stream_ >> 32)};
+        philox4x32(counter, static_cast<uint32_t>(key_), static_cast<uint32_t>(key_ >> 32));
+        buffer_[0] = (uint64_t{counter[1]} << 32) | counter[0];
+        buffer_[1] = (uint64_t{counter[3]} << 32) | counter[2];
+        buffered_ = true;
+    }
+    
+    const result_type value = buffer_[half_];
+    if (half_ == 1) {
+        ++block_;
+        buffered_ = false;
+    }
+    half_ ^= 1;
+    return value;
+}
+
+int StreamRandomGenerator::uniform_int(int min, int max) {
+    if (min > max) {
+        throw std::invalid_argument("min cannot be greater than max");
+    }
+    
+    // Lemire's multiply-shift reduction, as in RandomGenerator::fill_uniform_int()
+    const uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(max) - min) + 1;
+    const uint64_t threshold = ((uint64_t{1} << 32) - range) % range;
+    uint64_t product;
+    do {
+        product = (next() >> 32) * range;
+    } while ((product & 0xFFFFFFFFULL) < threshold);
+    return static_cast<int>(min + static_cast<int64_t>(product >> 32));
+}
+
+double StreamRandomGenerator::uniform_double() {
+    return static_cast<double>(next() >> 11) * TO_UNIT;
+}
+
 } // namespace wip::utils::rng
\ No newline at end of file
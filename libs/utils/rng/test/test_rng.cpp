@@ -3,7 +3,9 @@
 #include <set>
 #include <unordered_set>
 #include <map>
+#include <thread>
 #include <algorithm>
+#include <climits>
 #include <cmath>
 
 using namespace wip::utils::rng;
@@ -506,6 +508,221 @@ TEST(FastRngTest, Reproducibility) {
     }
 }
 
+// ==================== Bulk Generation Tests ====================
+
+TEST_F(RngTest, FillUniformIntRangeAndDistribution) {
+    // An odd count exercises the draw taken from the low half of the last word
+    std::vector<int> values(100001, 0);
+    rng.fill_uniform_int(values.data(), values.size(), 1, 10);
+    
+    std::map<int, int> counts;
+    for (int value : values) {
+        ASSERT_GE(value, 1);
+        ASSERT_LE(value, 10);
+        counts[value]++;
+    }
+    for (int i = 1; i <= 10; ++i) {
+        EXPECT_GT(counts[i], 9400) << "Value " << i << " appeared " << counts[i] << " times";
+        EXPECT_LT(counts[i], 10600) << "Value " << i << " appeared " << counts[i] << " times";
+    }
+}
+
+TEST_F(RngTest, FillUniformIntEdgeRanges) {
+    std::vector<int> values(1000);
+    
+    rng.fill_uniform_int(values.data(), values.size(), 7, 7);
+    EXPECT_TRUE(std::all_of(values.begin(), values.end(), [](int v) { return v == 7; }));
+    
+    rng.fill_uniform_int(values.data(), values.size(), INT_MIN, INT_MAX);
+    EXPECT_TRUE(std::any_of(values.begin(), values.end(), [](int v) { return v < 0; }));
+    EXPECT_TRUE(std::any_of(values.begin(), values.end(), [](int v) { return v > 0; }));
+    
+    // A range just over half of 2^32 rejects almost half of the draws
+    const int low = INT_MIN / 2;
+    const int high = INT_MAX / 2 + 2;
+    rng.fill_uniform_int(values.data(), values.size(), low, high);
+    for (int value : values) {
+        EXPECT_GE(value, low);
+        EXPECT_LE(value, high);
+    }
+    
+    rng.fill_uniform_int(values.data(), 0, 1, 2);
+    EXPECT_THROW(rng.fill_uniform_int(values.data(), values.size(), 2, 1), std::invalid_argument);
+}
+
+TEST_F(RngTest, FillUniformDouble) {
+    std::vector<double> values(10001);
+    rng.fill_uniform_double(values.data(), values.size(), -2.0, 3.0);
+    
+    double sum = 0.0;
+    for (double value : values) {
+        ASSERT_GE(value, -2.0);
+        ASSERT_LT(value, 3.0);
+        sum += value;
+    }
+    EXPECT_NEAR(sum / values.size(), 0.5, 0.05);
+}
+
+TEST_F(RngTest, FillNormalMoments) {
+    std::vector<double> values(200000);
+    rng.fill_normal(values.data(), values.size(), 5.0, 2.0);
+    
+    double sum = 0.0;
+    double sum_sq = 0.0;
+    size_t within_one = 0;
+    size_t beyond_three = 0;
+    for (double value : values) {
+        sum += value;
+        sum_sq += value * value;
+        double z = std::abs(value - 5.0) / 2.0;
+        within_one += z < 1.0;
+        beyond_three += z > 3.0;
+    }
+    double mean = sum / values.size();
+    double stddev = std::sqrt(sum_sq / values.size() - mean * mean);
+    EXPECT_NEAR(mean, 5.0, 0.02);
+    EXPECT_NEAR(stddev, 2.0, 0.02);
+    
+    // Shape, including the tail the ziggurat samples separately
+    EXPECT_NEAR(static_cast<double>(within_one) / values.size(), 0.6827, 0.005);
+    EXPECT_NEAR(static_cast<double>(beyond_three) / values.size(), 0.0027, 0.0005);
+}
+
+TEST_F(RngTest, FillReproducibility) {
+    RandomGenerator rng1(42);
+    RandomGenerator rng2(42);
+    
+    std::vector<int> ints1(1000), ints2(1000);
+    rng1.fill_uniform_int(ints1.data(), ints1.size(), 0, 999);
+    rng2.fill_uniform_int(ints2.data(), ints2.size(), 0, 999);
+    EXPECT_EQ(ints1, ints2);
+    
+    std::vector<double> normals1(1000), normals2(1000);
+    rng1.fill_normal(normals1.data(), normals1.size());
+    rng2.fill_normal(normals2.data(), normals2.size());
+    EXPECT_EQ(normals1, normals2);
+    
+    // Reseeding restarts the bulk streams, and they do not disturb the single-value sequence
+    RandomGenerator rng3(42);
+    rng1.seed(42);
+    rng1.fill_uniform_int(ints1.data(), ints1.size(), 0, 999);
+    rng3.fill_uniform_int(ints2.data(), ints2.size(), 0, 999);
+    EXPECT_EQ(ints1, ints2);
+    EXPECT_EQ(rng1.uniform_int(0, 1000000), RandomGenerator(42).uniform_int(0, 1000000));
+}
+
+// ==================== StreamRandomGenerator Tests ====================
+
+TEST(StreamRngTest, MatchesPhiloxKnownAnswers) {
+    // Random123 known-answer vectors for philox4x32-10: counter 0 with key 0,
+    // and every counter and key bit set
+    StreamRandomGenerator zero(0, 0);
+    EXPECT_EQ(zero.next(), 0xE169C58D6627E8D5ULL);
+    EXPECT_EQ(zero.next(), 0x9B00DBD8BC57AC4CULL);
+    
+    StreamRandomGenerator ones(UINT64_MAX, UINT64_MAX);
+    ones.jump(UINT64_MAX);  // Two values per block: block 2^64 - 1
+    ones.jump(UINT64_MAX);
+    EXPECT_EQ(ones.next(), 0x41C83B0E408F276DULL);
+    EXPECT_EQ(ones.next(), 0x6D5451FDA20BC7C6ULL);
+}
+
+TEST(StreamRngTest, StreamsAreDeterministicAndDistinct) {
+    StreamRandomGenerator root(2024);
+    StreamRandomGenerator a = root.stream(1);
+    StreamRandomGenerator b = StreamRandomGenerator(2024, 1);
+    StreamRandomGenerator c = root.stream(2);
+    EXPECT_EQ(a.stream_id(), 1u);
+    
+    std::set<uint64_t> values;
+    for (int i = 0; i < 1000; ++i) {
+        uint64_t value = a.next();
+        EXPECT_EQ(value, b.next());
+        values.insert(value);
+        values.insert(c.next());
+    }
+    EXPECT_EQ(values.size(), 2000u);
+}
+
+TEST(StreamRngTest, JumpSkipsValues) {
+    StreamRandomGenerator sequential(7, 3);
+    StreamRandomGenerator jumped(7, 3);
+    for (int i = 0; i < 1001; ++i) {
+        sequential.next();
+    }
+    jumped.next();
+    jumped.jump(1000);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(sequential.next(), jumped.next());
+    }
+    
+    // Reseeding restarts the stream
+    sequential.seed(7);
+    EXPECT_EQ(sequential.next(), StreamRandomGenerator(7, 3).next());
+}
+
+TEST(StreamRngTest, SplitIsDeterministic) {
+    StreamRandomGenerator parent1(99);
+    StreamRandomGenerator parent2(99);
+    StreamRandomGenerator child1 = parent1.split();
+    StreamRandomGenerator child2 = parent2.split();
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(child1.next(), child2.next());
+    }
+    EXPECT_EQ(parent1.next(), parent2.next());
+    EXPECT_NE(child1.next(), parent1.next());
+}
+
+TEST(StreamRngTest, ParallelWorkersMatchSequentialRun) {
+    // Every worker draws from its own stream, so the threads' interleaving
+    // does not change the results
+    const size_t workers = 4;
+    const size_t rolls = 10000;
+    StreamRandomGenerator root(42);
+    
+    std::vector<std::vector<int>> parallel(workers, std::vector<int>(rolls));
+    std::vector<std::thread> threads;
+    for (size_t w = 0; w < workers; ++w) {
+        threads.emplace_back([&, w]() {
+            StreamRandomGenerator generator = root.stream(w);
+            for (auto& roll : parallel[w]) {
+                roll = generator.uniform_int(1, 6);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    for (size_t w = 0; w < workers; ++w) {
+        StreamRandomGenerator generator(42, w);
+        for (size_t i = 0; i < rolls; ++i) {
+            ASSERT_EQ(parallel[w][i], generator.uniform_int(1, 6));
+        }
+        EXPECT_GT(std::count(parallel[w].begin(), parallel[w].end(), 6), 1400);
+    }
+}
+
+TEST(StreamRngTest, DistributionsAndStandardInterface) {
+    StreamRandomGenerator generator(5);
+    for (int i = 0; i < 1000; ++i) {
+        int value = generator.uniform_int(-3, 3);
+        EXPECT_GE(value, -3);
+        EXPECT_LE(value, 3);
+        double unit = generator.uniform_double();
+        EXPECT_GE(unit, 0.0);
+        EXPECT_LT(unit, 1.0);
+    }
+    EXPECT_THROW(generator.uniform_int(2, 1), std::invalid_argument);
+    
+    std::vector<int> values(100);
+    std::iota(values.begin(), values.end(), 0);
+    std::shuffle(values.begin(), values.end(), generator);
+    EXPECT_TRUE(std::is_permutation(values.begin(), values.end(), std::vector<int>(values).begin()));
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    EXPECT_LT(distribution(generator), 1.0);
+}
+
 // ==================== Performance Comparison Test ====================
 
 TEST(RngPerformanceTest, DISABLED_SpeedComparison) {
@@ -0,0 +1,386 @@
+// Benchmark for the allocating and view-based string helpers.
+//
+// Parses generated log lines the way log and report parsing does: split the
+// line into fields, trim each field and escape one of them. Each variant is
+// run with split/trim/replace_all and with split_view/trim_view/
+// append_replace_all, and reports the time and the number of heap
+// allocations per line.
+//
+// The second part filters issue messages the way the result panel does:
+// case conversion, contains and contains_ignore_case over short messages and
+// over one long haystack, against byte-at-a-time reference loops.
+//
+// The third part matches issue messages across runs: one message against
+// all others with the full-matrix Levenshtein distance it replaced, the
+// bit-parallel one, the within_distance check and the parallel batch.
+//
+// The fourth part renders one report line per log line with substitute()
+// and with a CompiledTemplate rendering into a reused buffer.
+//
+// The fifth part filters source paths against a thousand exclude patterns
+// and messages against a thousand keywords, one pattern at a time and with
+// GlobMatcher and LiteralMatcher. Usage:
+//
+//   bench_wip_utils_string [lines]
+
+#include "benchmark.h"
+#include "pattern_matcher.h"
+#include "wip_string.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+std::atomic<size_t> allocation_count{0};
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    ++allocation_count;
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+namespace str = wip::utils::string;
+
+namespace {
+
+std::vector<std::string> generate_lines(size_t count) {
+    static const char* const levels[] = {"INFO", "WARN", "ERROR", "DEBUG"};
+    std::vector<std::string> lines;
+    lines.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        lines.push_back("2024-05-01T12:" + std::to_string(i % 60) + ":00 | " + levels[i % 4] +
+                        " | src/module_" + std::to_string(i % 97) + ".cpp:" + std::to_string(i % 1000) +
+                        " |  value <" + std::to_string(i) + "> out of range & ignored  ");
+    }
+    return lines;
+}
+
+template <typename Parse>
+void measure(wip::benchmark::Runner& runner, const std::string& name, const std::vector<std::string>& lines, Parse parse) {
+    size_t allocations = 0;
+    runner.measure(name, lines.size(), [&]() {
+        size_t checksum = 0;
+        size_t allocations_before = allocation_count.load();
+        for (const auto& line : lines) {
+            checksum += parse(line);
+        }
+        allocations = allocation_count.load() - allocations_before;
+        return checksum;
+    });
+    if (runner.selected(name)) {
+        runner.report(name + " allocations", static_cast<double>(allocations) / lines.size(), "allocations/line");
+    }
+}
+
+// Byte-at-a-time versions of the helpers, as they were before the SIMD kernels
+std::string reference_to_lower(std::string_view input) {
+    std::string result{input};
+    std::transform(result.begin(), result.end(), result.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return result;
+}
+
+bool reference_contains_ignore_case(std::string_view text, std::string_view substring) {
+    auto equal = [](char a, char b) {
+        return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+    };
+    return std::search(text.begin(), text.end(), substring.begin(), substring.end(), equal) != text.end();
+}
+
+std::vector<std::string> generate_messages(size_t count) {
+    static const char* const templates[] = {
+        "Unused variable 'value_%' in function process_%",
+        "Possible null pointer dereference of 'node_%' [nullPointer]",
+        "Member function 'Widget%::update' can be made const",
+        "Variable 'buffer_%' is assigned a value that is never used",
+    };
+    std::vector<std::string> messages;
+    messages.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        messages.push_back(str::replace_all(templates[i % 4], "%", std::to_string(i)));
+    }
+    return messages;
+}
+
+template <typename Search>
+void measure_search(wip::benchmark::Runner& runner, const std::string& name, const std::vector<std::string>& haystacks,
+                    size_t rounds, Search search) {
+    if (!runner.selected(name)) {
+        return;
+    }
+    size_t bytes = 0;
+    for (const auto& haystack : haystacks) {
+        bytes += haystack.size();
+    }
+    size_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t round = 0; round < rounds; ++round) {
+        for (const auto& haystack : haystacks) {
+            checksum += search(haystack);
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    wip::benchmark::do_not_optimize(checksum);
+    runner.report(name, static_cast<double>(bytes) * rounds / seconds / 1e9, "GB/s");
+}
+
+void bench_search(wip::benchmark::Runner& runner, const char* label, const std::string& prefix,
+                  const std::vector<std::string>& haystacks, size_t rounds,
+                  std::string_view needle, std::string_view folded_needle) {
+    runner.out() << label << std::endl;
+    measure_search(runner, prefix + "to_lower (reference)", haystacks, rounds,
+                   [](const std::string& text) { return reference_to_lower(text).back(); });
+    measure_search(runner, prefix + "to_lower", haystacks, rounds,
+                   [](const std::string& text) { return str::to_lower(text).back(); });
+    measure_search(runner, prefix + "contains (std::string_view)", haystacks, rounds,
+                   [needle](const std::string& text) { return std::string_view(text).find(needle) != std::string_view::npos; });
+    measure_search(runner, prefix + "contains", haystacks, rounds,
+                   [needle](const std::string& text) { return str::contains(text, needle); });
+    measure_search(runner, prefix + "contains_ignore_case (reference)", haystacks, rounds,
+                   [folded_needle](const std::string& text) { return reference_contains_ignore_case(text, folded_needle); });
+    measure_search(runner, prefix + "contains_ignore_case", haystacks, rounds,
+                   [folded_needle](const std::string& text) { return str::contains_ignore_case(text, folded_needle); });
+}
+
+// The full-matrix distance levenshtein_distance() used before the bit-parallel one
+size_t reference_distance(std::string_view str1, std::string_view str2) {
+    std::vector<std::vector<size_t>> matrix(str1.size() + 1, std::vector<size_t>(str2.size() + 1));
+    for (size_t i = 0; i <= str1.size(); ++i) {
+        matrix[i][0] = i;
+    }
+    for (size_t j = 0; j <= str2.size(); ++j) {
+        matrix[0][j] = j;
+    }
+    for (size_t i = 1; i <= str1.size(); ++i) {
+        for (size_t j = 1; j <= str2.size(); ++j) {
+            size_t cost = (str1[i - 1] == str2[j - 1]) ? 0 : 1;
+            matrix[i][j] = std::min({matrix[i - 1][j] + 1, matrix[i][j - 1] + 1, matrix[i - 1][j - 1] + cost});
+        }
+    }
+    return matrix[str1.size()][str2.size()];
+}
+
+void bench_matching(wip::benchmark::Runner& runner, const std::string& prefix,
+                    const std::vector<std::string>& messages, const std::string& needle) {
+    runner.out() << "\nMatching one message against " << messages.size() << " messages" << std::endl;
+    runner.measure(prefix + "full matrix (reference)", messages.size(), [&]() {
+        size_t total = 0;
+        for (const auto& message : messages) {
+            total += reference_distance(needle, message);
+        }
+        return total;
+    });
+    runner.measure(prefix + "levenshtein_distance", messages.size(), [&]() {
+        size_t total = 0;
+        for (const auto& message : messages) {
+            total += str::levenshtein_distance(needle, message);
+        }
+        return total;
+    });
+    runner.measure(prefix + "within_distance (limit 4)", messages.size(), [&]() {
+        size_t total = 0;
+        for (const auto& message : messages) {
+            total += str::within_distance(needle, message, 4);
+        }
+        return total;
+    });
+    runner.measure(prefix + "levenshtein_distances", messages.size(), [&]() {
+        size_t total = 0;
+        for (size_t distance : str::levenshtein_distances(needle, messages)) {
+            total += distance;
+        }
+        return total;
+    });
+}
+
+// Matches one component against '*' and '?' by backtracking, one pattern at a time
+bool reference_wildcard(std::string_view pattern, std::string_view name) {
+    if (pattern.empty()) {
+        return name.empty();
+    }
+    if (pattern[0] == '*') {
+        for (size_t skip = 0; skip <= name.size(); ++skip) {
+            if (reference_wildcard(pattern.substr(1), name.substr(skip))) {
+                return true;
+            }
+        }
+        return false;
+    }
+    return !name.empty() && (pattern[0] == '?' || pattern[0] == name[0]) &&
+           reference_wildcard(pattern.substr(1), name.substr(1));
+}
+
+// The exclude check as a loop over the patterns: patterns without '/' against
+// every component, the others as a directory prefix
+bool reference_excluded(const std::vector<std::string>& patterns, std::string_view path) {
+    for (const auto& pattern : patterns) {
+        if (pattern.find('/') != std::string::npos) {
+            if (path.substr(0, pattern.size()) == pattern &&
+                (path.size() == pattern.size() || path[pattern.size()] == '/')) {
+                return true;
+            }
+            continue;
+        }
+        for (std::string_view rest = path;;) {
+            size_t slash = rest.find('/');
+            if (reference_wildcard(pattern, rest.substr(0, slash))) {
+                return true;
+            }
+            if (slash == std::string_view::npos) {
+                break;
+            }
+            rest.remove_prefix(slash + 1);
+        }
+    }
+    return false;
+}
+
+void bench_multi_pattern(wip::benchmark::Runner& runner, const std::vector<std::string>& messages) {
+    std::vector<std::string> globs;
+    std::vector<std::string> keywords;
+    for (size_t i = 0; i < 1000; ++i) {
+        std::string n = std::to_string(i);
+        switch (i % 4) {
+        case 0: globs.push_back("generated_" + n); break;
+        case 1: globs.push_back("*.pb" + n + ".cc"); break;
+        case 2: globs.push_back("test_" + n + "_*.cpp"); break;
+        default: globs.push_back("third_party/lib_" + n); break;
+        }
+        keywords.push_back("'node_" + n + "'");
+    }
+
+    std::vector<std::string> paths;
+    for (size_t i = 0; i < 20000; ++i) {
+        paths.push_back("src/module_" + std::to_string(i % 97) + "/part_" + std::to_string(i % 13) + "/file_" +
+                        std::to_string(i) + (i % 50 == 0 ? ".pb405.cc" : ".cpp"));
+    }
+
+    runner.out() << "\nExcluding " << paths.size() << " paths with " << globs.size() << " patterns" << std::endl;
+    runner.measure("exclude: one pattern at a time", paths.size(), [&]() {
+        size_t total = 0;
+        for (const auto& path : paths) {
+            total += reference_excluded(globs, path);
+        }
+        return total;
+    });
+    const str::GlobMatcher glob_matcher(globs);
+    runner.measure("exclude: GlobMatcher", paths.size(), [&]() {
+        size_t total = 0;
+        for (const auto& path : paths) {
+            total += glob_matcher.matches(path);
+        }
+        return total;
+    });
+
+    runner.out() << "\nFiltering " << messages.size() << " messages with " << keywords.size() << " keywords"
+              << std::endl;
+    runner.measure("filter: contains per keyword", messages.size(), [&]() {
+        size_t total = 0;
+        for (const auto& message : messages) {
+            total += std::any_of(keywords.begin(), keywords.end(),
+                                 [&](const std::string& keyword) { return str::contains(message, keyword); });
+        }
+        return total;
+    });
+    const str::LiteralMatcher literal_matcher(keywords);
+    runner.measure("filter: LiteralMatcher", messages.size(), [&]() {
+        size_t total = 0;
+        for (const auto& message : messages) {
+            total += literal_matcher.contains_any(message);
+        }
+        return total;
+    });
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    wip::benchmark::Runner runner("bench_wip_utils_string", argc, argv, "[lines]");
+    size_t line_count = runner.argument(0, 1000000);
+    auto lines = generate_lines(line_count);
+    runner.out() << "Parsing " << line_count << " log lines" << std::endl;
+
+    measure(runner, "parse allocating", lines, [](const std::string& line) {
+        size_t total = 0;
+        auto fields = str::split(line, '|');
+        for (const auto& field : fields) {
+            std::string trimmed = str::trim(field);
+            total += str::replace_all(trimmed, "&", "&amp;").size();
+        }
+        return total;
+    });
+
+    std::string buffer;
+    measure(runner, "parse views", lines, [&buffer](const std::string& line) {
+        size_t total = 0;
+        for (std::string_view field : str::split_view(line, '|')) {
+            buffer.clear();
+            str::append_replace_all(buffer, str::trim_view(field), "&", "&amp;");
+            total += buffer.size();
+        }
+        return total;
+    });
+
+    runner.out() << "\nRendering " << line_count << " report lines" << std::endl;
+    const char* const row = "<tr><td>${file}</td><td>${line}</td><td>${severity}</td><td>${message}</td></tr>";
+    measure(runner, "render substitute", lines, [row](const std::string& line) {
+        std::unordered_map<std::string, std::string> variables = {
+            {"file", "src/module.cpp"}, {"line", "42"}, {"severity", "warning"}, {"message", line}};
+        return str::substitute(row, variables).size();
+    });
+
+    const str::CompiledTemplate compiled(row);
+    std::vector<std::string_view> values(compiled.variables().size());
+    values[compiled.index_of("file")] = "src/module.cpp";
+    values[compiled.index_of("line")] = "42";
+    values[compiled.index_of("severity")] = "warning";
+    const size_t message = compiled.index_of("message");
+    measure(runner, "render compiled", lines, [&](const std::string& line) {
+        values[message] = line;
+        buffer.clear();
+        compiled.render_to(buffer, values);
+        return buffer.size();
+    });
+
+    runner.out() << "\nSearch kernels: " << str::simd_backend() << std::endl;
+    auto messages = generate_messages(100000);
+    bench_search(runner, "Short haystacks (100000 issue messages)", "short: ", messages, 20, "never used", "NULL POINTER");
+
+    std::string joined;
+    for (const auto& message : messages) {
+        joined += message;
+        joined += '\n';
+    }
+    // Needles that do not occur, so every call scans the whole haystack
+    bench_search(runner, "Long haystack (all messages joined)", "long: ", {joined}, 20, "never used!", "NULL POINTER!");
+
+    bench_matching(runner, "match short: ", messages, "Possible null pointer dereference of 'node_1234' [nullPointer]");
+    std::vector<std::string> long_messages;
+    for (size_t i = 0; i + 3 < messages.size(); i += 4) {
+        long_messages.push_back(messages[i] + "; " + messages[i + 1] + "; " + messages[i + 2]);
+    }
+    bench_matching(runner, "match long: ", long_messages, long_messages[1234]);
+
+    bench_multi_pattern(runner, messages);
+
+    return runner.finish();
+}
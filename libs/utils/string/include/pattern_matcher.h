@@ -0,0 +1,195 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace wip::utils::string {
+
+/**
+ * @brief Finds any of many literal strings in one pass over a text (Aho-Corasick)
+ *
+ * The patterns are compiled into a trie with failure links, so a search
+ * reads every byte of the text once however many patterns there are.
+ * Automata of up to DENSE_NODE_LIMIT nodes, which covers a few hundred
+ * short patterns, also get a full transition table, so each byte costs a
+ * single table lookup instead of a walk along the failure links, and a set
+ * of the byte pairs patterns start with, so stretches of text where no
+ * pattern can start are skipped without running the automaton.
+ * Searching is const and can run from several threads at once.
+ */
+class LiteralMatcher {
+public:
+    /**
+     * @brief Compile a set of patterns
+     * @param patterns Literal strings to look for; empty ones never match
+     * @param case_insensitive Compare ASCII letters without regard to case
+     */
+    explicit LiteralMatcher(const std::vector<std::string>& patterns, bool case_insensitive = false);
+
+    /**
+     * @brief Number of patterns the matcher was built from
+     */
+    size_t pattern_count() const noexcept { return pattern_count_; }
+
+    /**
+     * @brief Check whether any pattern occurs in a text
+     */
+    bool contains_any(std::string_view text) const noexcept;
+
+    /**
+     * @brief Find which patterns occur in a text
+     * @return Indices of the occurring patterns, ascending and without duplicates
+     */
+    std::vector<size_t> find_patterns(std::string_view text) const;
+
+    /**
+     * @brief Call a function for every occurrence of every pattern
+     * @param text Text to search
+     * @param on_match Called with the pattern index and the position one past
+     *                 the end of the occurrence, in order of that position
+     */
+    template <typename OnMatch>
+    void for_each_match(std::string_view text, OnMatch on_match) const {
+        auto report = [&](uint32_t node, size_t end) {
+            for (uint32_t out = nodes_[node].output; out != NONE; out = nodes_[out].output_link) {
+                for (uint32_t p = nodes_[out].first_pattern; p != nodes_[out].last_pattern; ++p) {
+                    on_match(static_cast<size_t>(pattern_ids_[p]), end);
+                }
+            }
+        };
+
+        if (!dense_.empty()) {
+            // At the root, positions where no pattern starts are skipped without
+            // touching the automaton; the flag spares looking at the node unless
+            // a pattern ends there
+            const auto* bytes = reinterpret_cast<const unsigned char*>(text.data());
+            const size_t size = text.size();
+            uint32_t state = 0;
+            for (size_t i = 0; i < size; ++i) {
+                if (state == 0) {
+                    while (i + 1 < size && !may_start(bytes[i], bytes[i + 1])) {
+                        ++i;
+                    }
+                }
+                state = dense_[(state & ~OUTPUT_FLAG) * 256 + bytes[i]];
+                if (state & OUTPUT_FLAG) {
+                    report(state & ~OUTPUT_FLAG, i + 1);
+                }
+            }
+            return;
+        }
+
+        uint32_t node = 0;
+        for (size_t i = 0; i < text.size(); ++i) {
+            node = next(node, text[i]);
+            report(node, i + 1);
+        }
+    }
+
+    /**
+     * @brief Largest automaton that gets a full transition table (512 bytes per node)
+     */
+    static constexpr size_t DENSE_NODE_LIMIT = 4096;
+
+private:
+    static constexpr uint32_t NONE = UINT32_MAX;
+    static constexpr uint16_t OUTPUT_FLAG = 0x8000;    // Set in dense_ on nodes where patterns end
+
+    struct Node {
+        uint32_t first_edge = 0;      // Edges to children, sorted by byte
+        uint32_t last_edge = 0;
+        uint32_t fail = 0;            // Longest proper suffix that is a trie node
+        uint32_t output = NONE;       // This node if it ends patterns, else output of fail
+        uint32_t output_link = NONE;  // Next node along the fail chain that ends patterns
+        uint32_t first_pattern = 0;   // Patterns ending here, in pattern_ids_
+        uint32_t last_pattern = 0;
+    };
+
+    struct Edge {
+        unsigned char byte;
+        uint32_t target;
+    };
+
+    uint32_t child(uint32_t node, unsigned char byte) const noexcept;
+
+    bool may_start(unsigned char first, unsigned char second) const noexcept {
+        const uint32_t pair = static_cast<uint32_t>(first) << 8 | second;
+        return (starts_[pair >> 6] >> (pair & 63)) & 1;
+    }
+    uint32_t next(uint32_t node, char c) const noexcept;
+
+    std::vector<Node> nodes_;
+    std::vector<Edge> edges_;
+    std::vector<uint32_t> pattern_ids_;
+    std::vector<uint32_t> root_;   // Transition of the root for every byte
+    std::vector<uint16_t> dense_;  // Transition of every node for every byte, empty above DENSE_NODE_LIMIT
+    std::vector<uint64_t> starts_; // Bit set of the byte pairs a pattern occurrence can start with, with dense_
+    size_t pattern_count_ = 0;
+    bool case_insensitive_ = false;
+};
+
+/**
+ * @brief Matches paths against many glob patterns at once (compiled automaton)
+ *
+ * Pattern syntax, for paths with '/' separators:
+ * - '*' matches any run of characters within one path component and '**'
+ *   any run across components. A '**' component may also match no
+ *   component at all: src, ** and main.cpp joined by '/' match "src/main.cpp"
+ * - '?' matches one character other than '/', and bracket expressions such
+ *   as "[abc]", "[a-z]" and "[!0-9]" match one character of a set
+ * - A pattern without '/' matches any single component of the path, so
+ *   "build" matches "build/a.cpp" and "src/build/b.cpp" and "*.pb.cc"
+ *   matches generated files in any directory
+ * - A pattern with '/' matches from the start of the path, and a match of
+ *   a directory also matches everything below it: "src/gen" matches
+ *   "src/gen/a.cpp". A leading '/' or "./" and a trailing '/' are ignored.
+ *
+ * The patterns are compiled into deterministic automata, one for each kind
+ * above, so matching costs a table lookup per path byte and automaton
+ * however many patterns there are. Automata that would grow too large are
+ * built up to a limit and finish the rare paths that leave it by simulating
+ * the patterns directly.
+ * Matching is const and can run from several threads at once.
+ */
+class GlobMatcher {
+public:
+    /**
+     * @brief Compile a set of patterns
+     * @param patterns Glob patterns; empty ones never match
+     * @param case_insensitive Compare ASCII letters without regard to case
+     */
+    explicit GlobMatcher(const std::vector<std::string>& patterns, bool case_insensitive = false);
+    ~GlobMatcher();
+
+    GlobMatcher(GlobMatcher&&) noexcept;
+    GlobMatcher& operator=(GlobMatcher&&) noexcept;
+
+    /**
+     * @brief Number of patterns the matcher was built from
+     */
+    size_t pattern_count() const noexcept { return pattern_count_; }
+
+    /**
+     * @brief Check whether any pattern matches a path
+     */
+    bool matches(std::string_view path) const;
+
+    /**
+     * @brief Find which patterns match a path
+     * @return Indices of the matching patterns, ascending and without duplicates
+     */
+    std::vector<size_t> matching_patterns(std::string_view path) const;
+
+private:
+    class Automaton;
+
+    std::unique_ptr<Automaton> components_;   // Patterns without '/', run on every component
+    std::unique_ptr<Automaton> paths_;        // Patterns with '/', run on the whole path
+    size_t pattern_count_ = 0;
+};
+
+}  // namespace wip::utils::string
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <iterator>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -10,6 +12,8 @@ namespace wip::utils::string {
 
 /**
  * @brief Converts a string to uppercase
+ *
+ * Only ASCII letters are converted, like std::toupper in the "C" locale.
  * @param input The input string
  * @return The uppercase version of the input string
  */
@@ -17,6 +21,8 @@ std::string to_upper(std::string_view input);
 
 /**
  * @brief Converts a string to lowercase
+ *
+ * Only ASCII letters are converted, like std::tolower in the "C" locale.
  * @param input The input string
  * @return The lowercase version of the input string
  */
@@ -60,6 +66,30 @@ std::string trim_left(std::string_view input, std::string_view chars = " \t\n\r\
  */
 std::string trim_right(std::string_view input, std::string_view chars = " \t\n\r\f\v");
 
+/**
+ * @brief Removes whitespace from both ends of a string without copying it
+ * @param input The input string
+ * @param chars Characters to trim (default: whitespace)
+ * @return View of the trimmed part of input
+ */
+std::string_view trim_view(std::string_view input, std::string_view chars = " \t\n\r\f\v");
+
+/**
+ * @brief Removes whitespace from the beginning of a string without copying it
+ * @param input The input string
+ * @param chars Characters to trim (default: whitespace)
+ * @return View of the left-trimmed part of input
+ */
+std::string_view trim_left_view(std::string_view input, std::string_view chars = " \t\n\r\f\v");
+
+/**
+ * @brief Removes whitespace from the end of a string without copying it
+ * @param input The input string
+ * @param chars Characters to trim (default: whitespace)
+ * @return View of the right-trimmed part of input
+ */
+std::string_view trim_right_view(std::string_view input, std::string_view chars = " \t\n\r\f\v");
+
 /**
  * @brief Splits a string by delimiter
  * @param data The string to split
@@ -78,6 +108,148 @@ std::vector<std::string> split(std::string_view data, char delimiter, size_t max
  */
 std::vector<std::string> split(std::string_view data, std::string_view delimiter, size_t max_splits = 0);
 
+/**
+ * @brief Forward iterator over the parts of a split string, without copying them
+ *
+ * Parts are the same as split() returns: an empty string has one empty part,
+ * a delimiter at the very end does not start an empty part, and once
+ * max_splits delimiters were consumed the rest of the string is the last part.
+ * Each part is a view into the split string.
+ */
+class SplitIterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::string_view;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const std::string_view*;
+    using reference = const std::string_view&;
+
+    SplitIterator() noexcept = default;
+
+    /**
+     * @brief Create an iterator at the first part of a string
+     * @param data String to split (must outlive the iterator)
+     * @param delimiter Delimiter to split by (must outlive the iterator); empty does not split
+     * @param max_splits Maximum number of splits (0 = unlimited)
+     */
+    SplitIterator(std::string_view data, std::string_view delimiter, size_t max_splits) noexcept
+        : rest_(data), delimiter_(delimiter), max_splits_(max_splits), at_end_(false) {
+        if (delimiter_.empty()) {
+            max_splits_ = splits_ = 1;   // Keep the whole string as one part
+        }
+        advance();
+    }
+
+    /**
+     * @brief Create an iterator at the first part of a string split by a character
+     */
+    SplitIterator(std::string_view data, char delimiter, size_t max_splits) noexcept
+        : rest_(data), delimiter_char_(delimiter), max_splits_(max_splits), at_end_(false) {
+        advance();
+    }
+
+    reference operator*() const noexcept { return part_; }
+    pointer operator->() const noexcept { return &part_; }
+
+    SplitIterator& operator++() noexcept {
+        at_end_ = !has_more_;
+        advance();
+        return *this;
+    }
+
+    SplitIterator operator++(int) noexcept {
+        SplitIterator previous = *this;
+        ++*this;
+        return previous;
+    }
+
+    bool operator==(const SplitIterator& other) const noexcept {
+        if (at_end_ || other.at_end_) {
+            return at_end_ == other.at_end_;
+        }
+        return part_.data() == other.part_.data();
+    }
+
+    bool operator!=(const SplitIterator& other) const noexcept { return !(*this == other); }
+
+private:
+    void advance() noexcept {
+        if (at_end_) {
+            part_ = {};
+            return;
+        }
+
+        size_t position = std::string_view::npos;
+        size_t length = 1;
+        if (max_splits_ == 0 || splits_ < max_splits_) {
+            if (delimiter_.empty()) {
+                position = rest_.find(delimiter_char_);
+            } else if (delimiter_.size() == 1) {
+                position = rest_.find(delimiter_[0]);
+            } else {
+                position = rest_.find(delimiter_);
+                length = delimiter_.size();
+            }
+        }
+
+        if (position == std::string_view::npos) {
+            part_ = rest_;
+            rest_ = {};
+            has_more_ = false;
+        } else {
+            part_ = rest_.substr(0, position);
+            rest_ = rest_.substr(position + length);
+            has_more_ = !rest_.empty();
+            ++splits_;
+        }
+    }
+
+    std::string_view rest_;
+    std::string_view part_;
+    std::string_view delimiter_;   // Empty when splitting by delimiter_char_ or not at all
+    char delimiter_char_ = '\0';
+    size_t max_splits_ = 0;
+    size_t splits_ = 0;
+    bool has_more_ = false;
+    bool at_end_ = true;
+};
+
+/**
+ * @brief Range of the parts of a split string, for range-based for loops
+ */
+class SplitRange {
+public:
+    explicit SplitRange(SplitIterator begin) noexcept : begin_(begin) {}
+
+    SplitIterator begin() const noexcept { return begin_; }
+    SplitIterator end() const noexcept { return SplitIterator(); }
+
+private:
+    SplitIterator begin_;
+};
+
+/**
+ * @brief Splits a string by delimiter without allocating
+ * @param data The string to split (must outlive the range)
+ * @param delimiter The character to split by
+ * @param max_splits Maximum number of splits (0 = unlimited)
+ * @return Range of part views, the same parts as split() returns
+ */
+inline SplitRange split_view(std::string_view data, char delimiter, size_t max_splits = 0) noexcept {
+    return SplitRange(SplitIterator(data, delimiter, max_splits));
+}
+
+/**
+ * @brief Splits a string by delimiter string without allocating
+ * @param data The string to split (must outlive the range)
+ * @param delimiter The string to split by (must outlive the range); empty does not split
+ * @param max_splits Maximum number of splits (0 = unlimited)
+ * @return Range of part views, the same parts as split() returns
+ */
+inline SplitRange split_view(std::string_view data, std::string_view delimiter, size_t max_splits = 0) noexcept {
+    return SplitRange(SplitIterator(data, delimiter, max_splits));
+}
+
 /**
  * @brief Joins a vector of strings with a delimiter
  * @param parts The strings to join
@@ -110,6 +282,38 @@ bool ends_with(std::string_view text, std::string_view suffix);
  */
 bool contains(std::string_view text, std::string_view substring);
 
+/**
+ * @brief Checks if a string contains a substring, ignoring the case of ASCII letters
+ * @param text The text to search in
+ * @param substring The substring to search for
+ * @return true if text contains substring
+ */
+bool contains_ignore_case(std::string_view text, std::string_view substring);
+
+/**
+ * @brief Finds the first occurrence of a substring
+ * @param text The text to search in
+ * @param substring The substring to search for
+ * @param start Position to start searching at
+ * @return Position of the occurrence, or std::string_view::npos if there is none
+ */
+size_t find(std::string_view text, std::string_view substring, size_t start = 0);
+
+/**
+ * @brief Finds the first occurrence of a substring, ignoring the case of ASCII letters
+ * @param text The text to search in
+ * @param substring The substring to search for
+ * @param start Position to start searching at
+ * @return Position of the occurrence, or std::string_view::npos if there is none
+ */
+size_t find_ignore_case(std::string_view text, std::string_view substring, size_t start = 0);
+
+/**
+ * @brief Name of the search and case conversion kernels selected for this CPU
+ * @return "avx2", "sse2", "neon" or "portable"
+ */
+const char* simd_backend() noexcept;
+
 /**
  * @brief Replaces all occurrences of a substring with another string
  * @param text The text to modify
@@ -119,6 +323,18 @@ bool contains(std::string_view text, std::string_view substring);
  */
 std::string replace_all(std::string_view text, std::string_view from, std::string_view to);
 
+/**
+ * @brief Appends text with all occurrences of a substring replaced to a buffer
+ *
+ * Reusing the output buffer across calls avoids allocating once it has grown.
+ * @param output The buffer to append to
+ * @param text The text to copy
+ * @param from The substring to replace (empty copies text unchanged)
+ * @param to The replacement string
+ * @return Number of replacements made
+ */
+size_t append_replace_all(std::string& output, std::string_view text, std::string_view from, std::string_view to);
+
 /**
  * @brief Replaces the first occurrence of a substring with another string
  * @param text The text to modify
@@ -223,6 +439,87 @@ std::optional<double> to_double(std::string_view text);
  */
 std::string substitute(std::string_view template_str, const std::unordered_map<std::string, std::string>& variables);
 
+/**
+ * @brief A ${key} template parsed once into literal and placeholder segments
+ *
+ * Renders the same output as substitute(), except that substituted values
+ * are never scanned for further placeholders. Variables are addressed by
+ * index into variables(), so rendering does no lookups by name; values
+ * beyond the given ones leave their placeholders as written.
+ */
+class CompiledTemplate {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    /**
+     * @brief Parse a template
+     * @param template_str The template string with ${key} placeholders
+     */
+    explicit CompiledTemplate(std::string_view template_str);
+
+    /**
+     * @brief Names of the placeholders, each once, in order of first appearance
+     */
+    const std::vector<std::string>& variables() const noexcept { return variables_; }
+
+    /**
+     * @brief Index of a placeholder name in variables()
+     * @return The index, or npos if the template has no such placeholder
+     */
+    size_t index_of(std::string_view name) const noexcept;
+
+    /**
+     * @brief Total size of the text outside placeholders
+     */
+    size_t literal_size() const noexcept { return literal_size_; }
+
+    /**
+     * @brief Exact size render() produces for the given values
+     * @param values One value per entry of variables(), by index
+     */
+    size_t rendered_size(const std::vector<std::string_view>& values) const noexcept;
+
+    /**
+     * @brief Append the rendered template to a buffer
+     *
+     * Reserves the rendered size up front, so a buffer reused across calls
+     * stops allocating once it has grown to the longest output.
+     * @param out Buffer to append to
+     * @param values One value per entry of variables(), by index
+     */
+    void render_to(std::string& out, const std::vector<std::string_view>& values) const;
+
+    /**
+     * @brief Render the template with values by index
+     * @param values One value per entry of variables(), by index
+     * @return The rendered string
+     */
+    std::string render(const std::vector<std::string_view>& values) const;
+
+    /**
+     * @brief Render the template with values by name, like substitute()
+     * @param variables Map of variable names to values
+     * @return The rendered string
+     */
+    std::string render(const std::unordered_map<std::string, std::string>& variables) const;
+
+private:
+    struct Segment {
+        size_t offset;     // Into text_; placeholders include their ${ and }
+        size_t length;
+        size_t variable;   // Index into variables_, npos for literal text
+    };
+
+    template <typename Lookup>
+    void append(std::string& out, Lookup lookup) const;
+
+    std::string text_;
+    std::vector<Segment> segments_;
+    std::vector<std::string> variables_;
+    std::vector<size_t> uses_;   // Occurrences of each variable
+    size_t literal_size_ = 0;
+};
+
 /**
  * @brief Generates a random string of specified length
  * @param length The desired length
@@ -233,12 +530,27 @@ std::string random_string(size_t length, std::string_view charset = "abcdefghijk
 
 /**
  * @brief Calculates the Levenshtein distance between two strings
+ *
+ * Uses Myers' bit-parallel algorithm, one machine word per 64 bytes of the
+ * shorter string.
  * @param str1 First string
  * @param str2 Second string
  * @return The edit distance between the strings
  */
 size_t levenshtein_distance(std::string_view str1, std::string_view str2);
 
+/**
+ * @brief Checks whether the Levenshtein distance is at most a limit
+ *
+ * Only evaluates the band of cells that can stay within the limit and stops
+ * as soon as none of them does, so unrelated strings are rejected early.
+ * @param str1 First string
+ * @param str2 Second string
+ * @param max_distance Largest accepted distance
+ * @return true if levenshtein_distance(str1, str2) <= max_distance
+ */
+bool within_distance(std::string_view str1, std::string_view str2, size_t max_distance);
+
 /**
  * @brief Calculates similarity between two strings as a percentage
  * @param str1 First string
@@ -247,4 +559,28 @@ size_t levenshtein_distance(std::string_view str1, std::string_view str2);
  */
 double similarity(std::string_view str1, std::string_view str2);
 
+/**
+ * @brief Calculates the Levenshtein distance from one string to many in parallel
+ *
+ * The needle is prepared once for all candidates. The calling thread takes
+ * part in the work.
+ * @param needle String to compare against every candidate
+ * @param candidates Strings to compare with
+ * @param max_threads Threads including the caller; 0 uses the hardware concurrency
+ * @return One distance per candidate, in the order of candidates
+ */
+std::vector<size_t> levenshtein_distances(std::string_view needle, const std::vector<std::string>& candidates,
+                                          size_t max_threads = 0);
+
+/**
+ * @brief Calculates the similarity of one string to many in parallel
+ * @param needle String to compare against every candidate
+ * @param candidates Strings to compare with
+ * @param max_threads Threads including the caller; 0 uses the hardware concurrency
+ * @return One similarity per candidate, in the order of candidates
+ * @see levenshtein_distances
+ */
+std::vector<double> similarities(std::string_view needle, const std::vector<std::string>& candidates,
+                                 size_t max_threads = 0);
+
 }  // namespace wip::utils::string
@@ -0,0 +1,265 @@
+#include "wip_string.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <system_error>
+#include <thread>
+
+namespace wip::utils::string {
+
+namespace {
+
+constexpr size_t WORD_BITS = 64;
+
+// Candidates a thread claims at a time in the batch functions
+constexpr size_t BATCH_CHUNK = 256;
+
+// Drops the prefix and suffix both strings share; they never add to the distance
+void strip_common_affixes(std::string_view& str1, std::string_view& str2) noexcept {
+    auto prefix = std::mismatch(str1.begin(), str1.end(), str2.begin(), str2.end());
+    size_t common = static_cast<size_t>(prefix.first - str1.begin());
+    str1.remove_prefix(common);
+    str2.remove_prefix(common);
+
+    auto suffix = std::mismatch(str1.rbegin(), str1.rend(), str2.rbegin(), str2.rend());
+    common = static_cast<size_t>(suffix.first - str1.rbegin());
+    str1.remove_suffix(common);
+    str2.remove_suffix(common);
+}
+
+// One column step of Myers' bit-vector algorithm over a 64-row block
+//
+// pv and mv hold the positive and negative vertical deltas of the block.
+// carry is the horizontal delta (-1, 0 or +1) entering at the top row; the
+// return value is the one leaving at the row selected by high.
+inline int advance_block(uint64_t& pv, uint64_t& mv, uint64_t eq, int carry, uint64_t high) noexcept {
+    const uint64_t carry_negative = carry < 0 ? 1 : 0;
+    const uint64_t xv = eq | mv;
+    eq |= carry_negative;
+    const uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+    uint64_t ph = mv | ~(xh | pv);
+    uint64_t mh = pv & xh;
+
+    const int carry_out = (ph & high) ? 1 : (mh & high) ? -1 : 0;
+    ph = (ph << 1) | (carry > 0 ? 1 : 0);
+    mh = (mh << 1) | carry_negative;
+    pv = mh | ~(xv | ph);
+    mv = ph & xv;
+    return carry_out;
+}
+
+// A string prepared for Myers' algorithm: for every byte value, the bit mask
+// of the positions where it occurs, in blocks of 64 positions
+class Pattern {
+public:
+    explicit Pattern(std::string_view pattern)
+        : size_(pattern.size()), blocks_((pattern.size() + WORD_BITS - 1) / WORD_BITS) {
+        if (blocks_ > 1) {
+            blocked_.assign(256 * blocks_, 0);
+        }
+        for (size_t i = 0; i < size_; ++i) {
+            uint64_t* masks = masks_of(static_cast<unsigned char>(pattern[i]));
+            masks[i / WORD_BITS] |= uint64_t{1} << (i % WORD_BITS);
+        }
+    }
+
+    // Edit distance between text and length bytes of the pattern from offset
+    size_t distance(std::string_view text, size_t offset, size_t length) const {
+        if (length == 0) {
+            return text.size();
+        }
+
+        const uint64_t last_high = uint64_t{1} << ((length - 1) % WORD_BITS);
+        if (blocks_ == 1) {
+            uint64_t pv = ~uint64_t{0};
+            uint64_t mv = 0;
+            size_t score = length;
+            for (char c : text) {
+                // The top row grows by one per column, hence the +1 carry
+                uint64_t eq = single_[static_cast<unsigned char>(c)] >> offset;
+                score += static_cast<size_t>(advance_block(pv, mv, eq, 1, last_high));
+            }
+            return score;
+        }
+
+        const size_t blocks = (length + WORD_BITS - 1) / WORD_BITS;
+        std::vector<uint64_t> pv(blocks, ~uint64_t{0});
+        std::vector<uint64_t> mv(blocks, 0);
+        const uint64_t high = uint64_t{1} << (WORD_BITS - 1);
+        size_t score = length;
+        for (char c : text) {
+            const uint64_t* masks = masks_of(static_cast<unsigned char>(c));
+            int carry = 1;
+            for (size_t b = 0; b < blocks; ++b) {
+                carry = advance_block(pv[b], mv[b], window(masks, offset, b), carry,
+                                      b + 1 == blocks ? last_high : high);
+            }
+            score += static_cast<size_t>(carry);
+        }
+        return score;
+    }
+
+private:
+    // Block b of masks, counted from the pattern byte at offset
+    uint64_t window(const uint64_t* masks, size_t offset, size_t b) const noexcept {
+        const size_t word = offset / WORD_BITS + b;
+        const size_t shift = offset % WORD_BITS;
+        uint64_t value = masks[word] >> shift;
+        if (shift != 0 && word + 1 < blocks_) {
+            value |= masks[word + 1] << (WORD_BITS - shift);
+        }
+        return value;
+    }
+
+    uint64_t* masks_of(unsigned char c) noexcept {
+        return blocks_ > 1 ? &blocked_[c * blocks_] : &single_[c];
+    }
+
+    const uint64_t* masks_of(unsigned char c) const noexcept {
+        return blocks_ > 1 ? &blocked_[c * blocks_] : &single_[c];
+    }
+
+    size_t size_;
+    size_t blocks_;
+    std::array<uint64_t, 256> single_{};  // Masks of patterns up to 64 bytes
+    std::vector<uint64_t> blocked_;       // blocks_ masks per byte value for longer ones
+};
+
+// Ukkonen's band: only cells within max_distance of the diagonal can stay
+// within max_distance, and the search stops once a whole row exceeds it.
+// Expects str1 to be the shorter string.
+bool within_band(std::string_view str1, std::string_view str2, size_t max_distance) {
+    const size_t len1 = str1.length();
+    const size_t len2 = str2.length();
+    const size_t over = max_distance + 1;  // Any value over the limit
+
+    std::vector<size_t> previous(len2 + 1, over);
+    std::vector<size_t> current(len2 + 1, over);
+    for (size_t j = 0; j <= std::min(len2, max_distance); ++j) {
+        previous[j] = j;
+    }
+
+    for (size_t i = 1; i <= len1; ++i) {
+        const size_t first = i > max_distance ? i - max_distance : 1;
+        const size_t last = std::min(len2, i + max_distance);
+        current[first - 1] = first == 1 && i <= max_distance ? i : over;
+
+        size_t row_min = current[first - 1];
+        for (size_t j = first; j <= last; ++j) {
+            size_t cost = (str1[i - 1] == str2[j - 1]) ? 0 : 1;
+            size_t value = std::min({previous[j - 1] + cost, previous[j] + 1, current[j - 1] + 1});
+            current[j] = std::min(value, over);
+            row_min = std::min(row_min, current[j]);
+        }
+        if (last < len2) {
+            current[last + 1] = over;
+        }
+        if (row_min > max_distance) {
+            return false;
+        }
+        std::swap(previous, current);
+    }
+    return previous[len2] <= max_distance;
+}
+
+// Distance from the prepared needle to a candidate, without their common prefix and suffix
+size_t distance_to(const Pattern& pattern, std::string_view needle, std::string_view candidate) {
+    std::string_view rest = needle;
+    strip_common_affixes(rest, candidate);
+    return pattern.distance(candidate, static_cast<size_t>(rest.data() - needle.data()), rest.size());
+}
+
+double similarity_from_distance(size_t distance, size_t len1, size_t len2) noexcept {
+    size_t max_len = std::max(len1, len2);
+    if (max_len == 0) {
+        return 1.0;
+    }
+    return 1.0 - static_cast<double>(distance) / static_cast<double>(max_len);
+}
+
+// Runs work(i) for every i below count on up to max_threads threads, the caller included
+template <typename Work>
+void parallel_for(size_t count, size_t max_threads, Work work) {
+    std::atomic<size_t> next{0};
+    auto run = [&]() {
+        for (size_t begin = next.fetch_add(BATCH_CHUNK); begin < count; begin = next.fetch_add(BATCH_CHUNK)) {
+            size_t end = std::min(count, begin + BATCH_CHUNK);
+            for (size_t i = begin; i < end; ++i) {
+                work(i);
+            }
+        }
+    };
+
+    size_t thread_count = max_threads > 0 ? max_threads : std::thread::hardware_concurrency();
+    thread_count = std::max<size_t>(1, std::min(thread_count, (count + BATCH_CHUNK - 1) / BATCH_CHUNK));
+
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < thread_count; ++i) {
+        try {
+            threads.emplace_back(run);
+        } catch (const std::system_error&) {
+            break; // The threads already running share the candidates
+        }
+    }
+    run();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+} // namespace
+
+size_t levenshtein_distance(std::string_view str1, std::string_view str2) {
+    strip_common_affixes(str1, str2);
+    if (str1.length() > str2.length()) {
+        std::swap(str1, str2);
+    }
+    return Pattern(str1).distance(str2, 0, str1.length());
+}
+
+bool within_distance(std::string_view str1, std::string_view str2, size_t max_distance) {
+    strip_common_affixes(str1, str2);
+    if (str1.length() > str2.length()) {
+        std::swap(str1, str2);
+    }
+    if (str2.length() - str1.length() > max_distance) {
+        return false;
+    }
+    if (str2.length() <= max_distance) {
+        return true;
+    }
+    // A single word step per column is cheaper than any band wider than a few cells
+    if (str1.length() <= WORD_BITS) {
+        return Pattern(str1).distance(str2, 0, str1.length()) <= max_distance;
+    }
+    return within_band(str1, str2, max_distance);
+}
+
+double similarity(std::string_view str1, std::string_view str2) {
+    return similarity_from_distance(levenshtein_distance(str1, str2), str1.length(), str2.length());
+}
+
+std::vector<size_t> levenshtein_distances(std::string_view needle, const std::vector<std::string>& candidates,
+                                          size_t max_threads) {
+    const Pattern pattern(needle);
+    std::vector<size_t> results(candidates.size());
+    parallel_for(candidates.size(), max_threads, [&](size_t i) {
+        results[i] = distance_to(pattern, needle, candidates[i]);
+    });
+    return results;
+}
+
+std::vector<double> similarities(std::string_view needle, const std::vector<std::string>& candidates,
+                                 size_t max_threads) {
+    const Pattern pattern(needle);
+    std::vector<double> results(candidates.size());
+    parallel_for(candidates.size(), max_threads, [&](size_t i) {
+        size_t distance = distance_to(pattern, needle, candidates[i]);
+        results[i] = similarity_from_distance(distance, needle.size(), candidates[i].size());
+    });
+    return results;
+}
+
+} // namespace wip::utils::string
@@ -0,0 +1,613 @@
+#include "pattern_matcher.h"
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <map>
+
+namespace wip::utils::string {
+
+namespace {
+
+constexpr uint32_t NO_STATE = UINT32_MAX;
+
+// Deterministic states built before matching falls back to simulating the patterns
+constexpr size_t MAX_DFA_STATES = 4096;
+
+unsigned char fold_byte(unsigned char c, bool case_insensitive) noexcept {
+    return (case_insensitive && c >= 'A' && c <= 'Z') ? static_cast<unsigned char>(c | 0x20) : c;
+}
+
+// ==================== Glob parsing ====================
+
+// A set of bytes, one bit each
+using ByteSet = std::array<uint64_t, 4>;
+
+void insert(ByteSet& set, unsigned char c) noexcept {
+    set[c / 64] |= uint64_t{1} << (c % 64);
+}
+
+bool contains(const ByteSet& set, unsigned char c) noexcept {
+    return (set[c / 64] >> (c % 64)) & 1;
+}
+
+void insert_letter(ByteSet& set, unsigned char c, bool case_insensitive) noexcept {
+    insert(set, c);
+    if (case_insensitive && ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'))) {
+        insert(set, static_cast<unsigned char>(c ^ 0x20));
+    }
+}
+
+enum class Kind : uint8_t {
+    Set,        // One byte of a set
+    Star,       // '*': any run of bytes other than '/'
+    GlobStar,   // '**': any run of bytes
+    DirStar,    // "**/": nothing, or the GlobStar and '/' states that follow it
+    End,        // End of a pattern
+};
+
+struct Token {
+    Kind kind;
+    ByteSet set;
+};
+
+Token set_token(const ByteSet& set) {
+    return {Kind::Set, set};
+}
+
+// Parses a bracket expression at pattern[open]; returns the position after it,
+// or open if it is not terminated and '[' is a literal
+size_t parse_bracket(std::string_view pattern, size_t open, bool case_insensitive, ByteSet& set) {
+    size_t p = open + 1;
+    bool negate = p < pattern.size() && (pattern[p] == '!' || pattern[p] == '^');
+    if (negate) {
+        ++p;
+    }
+
+    ByteSet members{};
+    bool first = true;
+    for (; p < pattern.size() && (first || pattern[p] != ']'); first = false) {
+        auto low = static_cast<unsigned char>(pattern[p]);
+        auto high = low;
+        if (p + 2 < pattern.size() && pattern[p + 1] == '-' && pattern[p + 2] != ']') {
+            high = static_cast<unsigned char>(pattern[p + 2]);
+            p += 3;
+        } else {
+            ++p;
+        }
+        for (unsigned c = low; c <= high; ++c) {
+            insert_letter(members, static_cast<unsigned char>(c), case_insensitive);
+        }
+    }
+    if (p >= pattern.size()) {
+        return open;
+    }
+
+    for (unsigned c = 0; c < 256; ++c) {
+        if (contains(members, static_cast<unsigned char>(c)) != negate && c != '/') {
+            insert(set, static_cast<unsigned char>(c));
+        }
+    }
+    return p + 1;
+}
+
+std::vector<Token> parse_glob(std::string_view pattern, bool case_insensitive) {
+    std::vector<Token> tokens;
+    for (size_t p = 0; p < pattern.size();) {
+        char c = pattern[p];
+        if (c == '*') {
+            size_t stars = 1;
+            while (p + stars < pattern.size() && pattern[p + stars] == '*') {
+                ++stars;
+            }
+            bool component_start = p == 0 || pattern[p - 1] == '/';
+            if (stars > 1 && component_start && p + stars < pattern.size() && pattern[p + stars] == '/') {
+                tokens.push_back({Kind::DirStar, {}});
+                p += stars + 1;
+            } else {
+                tokens.push_back({stars > 1 ? Kind::GlobStar : Kind::Star, {}});
+                p += stars;
+            }
+            continue;
+        }
+
+        ByteSet set{};
+        size_t after = p + 1;
+        if (c == '?') {
+            set = {~uint64_t{0}, ~uint64_t{0}, ~uint64_t{0}, ~uint64_t{0}};
+            set['/' / 64] &= ~(uint64_t{1} << ('/' % 64));
+        } else if (c == '[' && (after = parse_bracket(pattern, p, case_insensitive, set)) != p) {
+            // A complete bracket expression
+        } else {
+            insert_letter(set, static_cast<unsigned char>(c), case_insensitive);
+            after = p + 1;
+        }
+        tokens.push_back(set_token(set));
+        p = after;
+    }
+    return tokens;
+}
+
+// Drops the parts of a path or pattern that do not change what it names
+std::string_view normalize(std::string_view path) noexcept {
+    while (true) {
+        if (path.substr(0, 2) == "./") {
+            path.remove_prefix(2);
+        } else if (!path.empty() && path.front() == '/') {
+            path.remove_prefix(1);
+        } else {
+            break;
+        }
+    }
+    while (!path.empty() && path.back() == '/') {
+        path.remove_suffix(1);
+    }
+    return path;
+}
+
+// Calls visit for every '/' separated component of path until it returns true
+template <typename Visit>
+bool any_component(std::string_view path, Visit visit) {
+    while (true) {
+        size_t slash = path.find('/');
+        if (visit(path.substr(0, slash))) {
+            return true;
+        }
+        if (slash == std::string_view::npos) {
+            return false;
+        }
+        path.remove_prefix(slash + 1);
+    }
+}
+
+} // namespace
+
+// ==================== LiteralMatcher ====================
+
+LiteralMatcher::LiteralMatcher(const std::vector<std::string>& patterns, bool case_insensitive)
+    : pattern_count_(patterns.size()), case_insensitive_(case_insensitive) {
+    // Trie with unsorted children first, flattened below
+    struct TrieNode {
+        std::vector<Edge> children;
+        std::vector<uint32_t> patterns;
+    };
+    std::vector<TrieNode> trie(1);
+    for (size_t i = 0; i < patterns.size(); ++i) {
+        if (patterns[i].empty()) {
+            continue;
+        }
+        uint32_t node = 0;
+        for (char c : patterns[i]) {
+            unsigned char byte = fold_byte(static_cast<unsigned char>(c), case_insensitive_);
+            auto& children = trie[node].children;
+            auto it = std::find_if(children.begin(), children.end(),
+                                   [byte](const Edge& edge) { return edge.byte == byte; });
+            if (it != children.end()) {
+                node = it->target;
+            } else {
+                auto target = static_cast<uint32_t>(trie.size());
+                children.push_back({byte, target});
+                trie.emplace_back();
+                node = target;
+            }
+        }
+        trie[node].patterns.push_back(static_cast<uint32_t>(i));
+    }
+
+    nodes_.resize(trie.size());
+    for (size_t n = 0; n < trie.size(); ++n) {
+        auto& children = trie[n].children;
+        std::sort(children.begin(), children.end(),
+                  [](const Edge& a, const Edge& b) { return a.byte < b.byte; });
+        nodes_[n].first_edge = static_cast<uint32_t>(edges_.size());
+        edges_.insert(edges_.end(), children.begin(), children.end());
+        nodes_[n].last_edge = static_cast<uint32_t>(edges_.size());
+
+        nodes_[n].first_pattern = static_cast<uint32_t>(pattern_ids_.size());
+        pattern_ids_.insert(pattern_ids_.end(), trie[n].patterns.begin(), trie[n].patterns.end());
+        nodes_[n].last_pattern = static_cast<uint32_t>(pattern_ids_.size());
+    }
+
+    root_.assign(256, 0);
+    for (uint32_t e = nodes_[0].first_edge; e != nodes_[0].last_edge; ++e) {
+        root_[edges_[e].byte] = edges_[e].target;
+    }
+
+    // Breadth first, so the failure links of shallower nodes are known
+    std::deque<uint32_t> queue{0};
+    while (!queue.empty()) {
+        uint32_t node = queue.front();
+        queue.pop_front();
+        for (uint32_t e = nodes_[node].first_edge; e != nodes_[node].last_edge; ++e) {
+            uint32_t target = edges_[e].target;
+            uint32_t fail = node == 0 ? 0 : next(nodes_[node].fail, static_cast<char>(edges_[e].byte));
+            nodes_[target].fail = fail;
+            nodes_[target].output_link = nodes_[fail].output;
+            bool ends_patterns = nodes_[target].first_pattern != nodes_[target].last_pattern;
+            nodes_[target].output = ends_patterns ? target : nodes_[fail].output;
+            queue.push_back(target);
+        }
+    }
+
+    if (nodes_.size() <= DENSE_NODE_LIMIT) {
+        dense_.resize(nodes_.size() * 256);
+        for (uint32_t node = 0; node < nodes_.size(); ++node) {
+            for (uint32_t byte = 0; byte < 256; ++byte) {
+                uint32_t target = next(node, static_cast<char>(byte));
+                dense_[node * 256 + byte] = static_cast<uint16_t>(nodes_[target].output != NONE ? target | OUTPUT_FLAG : target);
+            }
+        }
+        
+        // A one-byte pattern starts with its byte followed by anything
+        starts_.assign(65536 / 64, 0);
+        for (uint32_t first = 0; first < 256; ++first) {
+            uint32_t node = root_[fold_byte(static_cast<unsigned char>(first), case_insensitive_)];
+            if (node == 0) {
+                continue;
+            }
+            bool ends_pattern = nodes_[node].first_pattern != nodes_[node].last_pattern;
+            for (uint32_t second = 0; second < 256; ++second) {
+                if (ends_pattern || child(node, fold_byte(static_cast<unsigned char>(second), case_insensitive_)) != NONE) {
+                    uint32_t pair = first << 8 | second;
+                    starts_[pair >> 6] |= uint64_t{1} << (pair & 63);
+                }
+            }
+        }
+    }
+}
+
+uint32_t LiteralMatcher::child(uint32_t node, unsigned char byte) const noexcept {
+    auto first = edges_.begin() + nodes_[node].first_edge;
+    auto last = edges_.begin() + nodes_[node].last_edge;
+    auto it = std::lower_bound(first, last, byte, [](const Edge& edge, unsigned char b) { return edge.byte < b; });
+    return (it != last && it->byte == byte) ? it->target : NONE;
+}
+
+uint32_t LiteralMatcher::next(uint32_t node, char c) const noexcept {
+    unsigned char byte = fold_byte(static_cast<unsigned char>(c), case_insensitive_);
+    while (node != 0) {
+        uint32_t target = child(node, byte);
+        if (target != NONE) {
+            return target;
+        }
+        node = nodes_[node].fail;
+    }
+    return root_[byte];
+}
+
+bool LiteralMatcher::contains_any(std::string_view text) const noexcept {
+    if (!dense_.empty()) {
+        const auto* bytes = reinterpret_cast<const unsigned char*>(text.data());
+        uint32_t state = 0;
+        for (size_t i = 0; i < text.size(); ++i) {
+            if (state == 0) {
+                while (i + 1 < text.size() && !may_start(bytes[i], bytes[i + 1])) {
+                    ++i;
+                }
+            }
+            state = dense_[(state & ~OUTPUT_FLAG) * 256 + bytes[i]];
+            if (state & OUTPUT_FLAG) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    uint32_t node = 0;
+    for (char c : text) {
+        node = next(node, c);
+        if (nodes_[node].output != NONE) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<size_t> LiteralMatcher::find_patterns(std::string_view text) const {
+    std::vector<bool> found(pattern_count_, false);
+    for_each_match(text, [&found](size_t pattern, size_t) { found[pattern] = true; });
+
+    std::vector<size_t> result;
+    for (size_t i = 0; i < found.size(); ++i) {
+        if (found[i]) {
+            result.push_back(i);
+        }
+    }
+    return result;
+}
+
+// ==================== GlobMatcher ====================
+
+/**
+ * @brief Glob patterns compiled into a deterministic automaton over byte classes
+ *
+ * Each pattern becomes a chain of NFA states, one per token. DFA states are
+ * the sets of NFA states active after some input; they are built breadth
+ * first from the start set until MAX_DFA_STATES, and transitions out of that
+ * range are marked NO_STATE so matching continues on the NFA sets instead.
+ */
+class GlobMatcher::Automaton {
+public:
+    /**
+     * @brief Add a pattern
+     * @param subtree Also match every path below what the pattern matches
+     */
+    void add(const std::vector<Token>& tokens, uint32_t pattern, bool subtree) {
+        start_states_.push_back(static_cast<uint32_t>(nfa_.size()));
+        ByteSet slash{};
+        insert(slash, '/');
+        for (const auto& token : tokens) {
+            nfa_.push_back({token.kind, false, set_index(token), pattern});
+            if (token.kind == Kind::DirStar) {
+                // Either skipped, or any run of bytes and then a '/'
+                nfa_.push_back({Kind::GlobStar, false, 0, pattern});
+                nfa_.push_back({Kind::Set, false, set_index(set_token(slash)), pattern});
+            }
+        }
+        if (subtree) {
+            nfa_.push_back({Kind::Set, true, set_index(set_token(slash)), pattern});
+            nfa_.push_back({Kind::GlobStar, false, 0, pattern});
+        }
+        nfa_.push_back({Kind::End, true, 0, pattern});
+    }
+
+    void compile() {
+        compute_byte_classes();
+
+        // State 0 is the dead state, the empty set
+        add_dfa_state({});
+        std::vector<uint32_t> start = closure(start_states_);
+        start_ = add_dfa_state(start);
+
+        std::map<std::vector<uint32_t>, uint32_t> ids;
+        ids.emplace(std::vector<uint32_t>(), 0);
+        ids.emplace(start, start_);
+        for (uint32_t state = 0; state < dfa_count(); ++state) {
+            std::vector<uint32_t> set(sets_.begin() + set_begin_[state], sets_.begin() + set_begin_[state + 1]);
+            for (uint16_t byte_class = 0; byte_class < class_count_; ++byte_class) {
+                std::vector<uint32_t> next = step(set, byte_class);
+                auto it = ids.find(next);
+                uint32_t target = NO_STATE;
+                if (it != ids.end()) {
+                    target = it->second;
+                } else if (dfa_count() < MAX_DFA_STATES) {
+                    target = add_dfa_state(next);
+                    ids.emplace(std::move(next), target);
+                }
+                transitions_[state * class_count_ + byte_class] = target;
+            }
+        }
+    }
+
+    /**
+     * @brief Match a whole input
+     * @param matched Receives the indices of the matching patterns, if not null
+     * @return true if any pattern matched
+     */
+    bool match(std::string_view input, std::vector<size_t>* matched) const {
+        uint32_t state = start_;
+        size_t i = 0;
+        for (; i < input.size(); ++i) {
+            uint32_t target = transitions_[state * class_count_ + byte_classes_[static_cast<unsigned char>(input[i])]];
+            if (target == NO_STATE) {
+                break;
+            }
+            state = target;
+            if (state == 0) {
+                return false;
+            }
+        }
+
+        if (i == input.size()) {
+            if (matched) {
+                matched->insert(matched->end(), accepts_.begin() + accept_begin_[state],
+                                accepts_.begin() + accept_begin_[state + 1]);
+            }
+            return accept_begin_[state] != accept_begin_[state + 1];
+        }
+
+        // Past the built states: continue on the NFA set
+        std::vector<uint32_t> set(sets_.begin() + set_begin_[state], sets_.begin() + set_begin_[state + 1]);
+        for (; i < input.size() && !set.empty(); ++i) {
+            set = step(set, byte_classes_[static_cast<unsigned char>(input[i])]);
+        }
+        bool any = false;
+        for (uint32_t s : set) {
+            if (nfa_[s].accepting) {
+                any = true;
+                if (matched) {
+                    matched->push_back(nfa_[s].pattern);
+                }
+            }
+        }
+        return any;
+    }
+
+private:
+    struct NfaState {
+        Kind kind;
+        bool accepting;   // Reaching this state matches the pattern
+        uint32_t set;     // Index into byte_sets_ for Kind::Set
+        uint32_t pattern;
+    };
+
+    uint32_t set_index(const Token& token) {
+        if (token.kind != Kind::Set) {
+            return 0;
+        }
+        auto it = std::find(byte_sets_.begin(), byte_sets_.end(), token.set);
+        if (it != byte_sets_.end()) {
+            return static_cast<uint32_t>(it - byte_sets_.begin());
+        }
+        byte_sets_.push_back(token.set);
+        return static_cast<uint32_t>(byte_sets_.size() - 1);
+    }
+
+    // Bytes that every set and '/' treat alike share a class
+    void compute_byte_classes() {
+        std::map<std::vector<bool>, uint16_t> classes;
+        std::vector<unsigned char> representatives;
+        for (unsigned c = 0; c < 256; ++c) {
+            std::vector<bool> signature(byte_sets_.size() + 1);
+            for (size_t s = 0; s < byte_sets_.size(); ++s) {
+                signature[s] = contains(byte_sets_[s], static_cast<unsigned char>(c));
+            }
+            signature.back() = c == '/';
+            auto inserted = classes.emplace(std::move(signature), static_cast<uint16_t>(classes.size()));
+            if (inserted.second) {
+                representatives.push_back(static_cast<unsigned char>(c));
+            }
+            byte_classes_[c] = inserted.first->second;
+        }
+
+        class_count_ = static_cast<uint16_t>(classes.size());
+        slash_class_ = byte_classes_['/'];
+        class_in_set_.assign(byte_sets_.size() * class_count_, false);
+        for (size_t s = 0; s < byte_sets_.size(); ++s) {
+            for (uint16_t k = 0; k < class_count_; ++k) {
+                class_in_set_[s * class_count_ + k] = contains(byte_sets_[s], representatives[k]);
+            }
+        }
+    }
+
+    // Adds the states reachable without input; returns the sorted set
+    std::vector<uint32_t> closure(std::vector<uint32_t> states) const {
+        for (size_t i = 0; i < states.size(); ++i) {
+            Kind kind = nfa_[states[i]].kind;
+            if (kind == Kind::Star || kind == Kind::GlobStar || kind == Kind::DirStar) {
+                states.push_back(states[i] + 1);
+            }
+            if (kind == Kind::DirStar) {
+                states.push_back(states[i] + 3);
+            }
+        }
+        std::sort(states.begin(), states.end());
+        states.erase(std::unique(states.begin(), states.end()), states.end());
+        return states;
+    }
+
+    std::vector<uint32_t> step(const std::vector<uint32_t>& set, uint16_t byte_class) const {
+        std::vector<uint32_t> next;
+        for (uint32_t s : set) {
+            const NfaState& state = nfa_[s];
+            switch (state.kind) {
+            case Kind::Set:
+                if (class_in_set_[state.set * class_count_ + byte_class]) {
+                    next.push_back(s + 1);
+                }
+                break;
+            case Kind::Star:
+                if (byte_class != slash_class_) {
+                    next.push_back(s);
+                }
+                break;
+            case Kind::GlobStar:
+                next.push_back(s);
+                break;
+            case Kind::DirStar:
+            case Kind::End:
+                break;
+            }
+        }
+        return closure(std::move(next));
+    }
+
+    uint32_t dfa_count() const noexcept {
+        return static_cast<uint32_t>(set_begin_.size() - 1);
+    }
+
+    uint32_t add_dfa_state(const std::vector<uint32_t>& set) {
+        uint32_t state = dfa_count();
+        sets_.insert(sets_.end(), set.begin(), set.end());
+        set_begin_.push_back(static_cast<uint32_t>(sets_.size()));
+
+        std::vector<uint32_t> patterns;
+        for (uint32_t s : set) {
+            if (nfa_[s].accepting) {
+                patterns.push_back(nfa_[s].pattern);
+            }
+        }
+        std::sort(patterns.begin(), patterns.end());
+        patterns.erase(std::unique(patterns.begin(), patterns.end()), patterns.end());
+        accepts_.insert(accepts_.end(), patterns.begin(), patterns.end());
+        accept_begin_.push_back(static_cast<uint32_t>(accepts_.size()));
+
+        transitions_.resize(transitions_.size() + class_count_, NO_STATE);
+        return state;
+    }
+
+    // Patterns
+    std::vector<NfaState> nfa_;
+    std::vector<uint32_t> start_states_;
+    std::vector<ByteSet> byte_sets_;
+
+    // Byte classes
+    std::array<uint16_t, 256> byte_classes_{};
+    uint16_t class_count_ = 0;
+    uint16_t slash_class_ = 0;
+    std::vector<bool> class_in_set_;   // byte_sets_.size() rows of class_count_
+
+    // Deterministic states; per-state ranges end where the next state's begin
+    uint32_t start_ = 0;
+    std::vector<uint32_t> transitions_;         // class_count_ per state
+    std::vector<uint32_t> sets_;                // NFA states of each DFA state
+    std::vector<uint32_t> set_begin_{0};
+    std::vector<uint32_t> accepts_;             // Patterns matched in each DFA state
+    std::vector<uint32_t> accept_begin_{0};
+};
+
+GlobMatcher::GlobMatcher(const std::vector<std::string>& patterns, bool case_insensitive)
+    : pattern_count_(patterns.size()) {
+    for (size_t i = 0; i < patterns.size(); ++i) {
+        std::string_view pattern = normalize(patterns[i]);
+        if (pattern.empty()) {
+            continue;
+        }
+        bool has_slash = pattern.find('/') != std::string_view::npos;
+        auto& automaton = has_slash ? paths_ : components_;
+        if (!automaton) {
+            automaton = std::make_unique<Automaton>();
+        }
+        automaton->add(parse_glob(pattern, case_insensitive), static_cast<uint32_t>(i), has_slash);
+    }
+
+    if (components_) {
+        components_->compile();
+    }
+    if (paths_) {
+        paths_->compile();
+    }
+}
+
+GlobMatcher::~GlobMatcher() = default;
+GlobMatcher::GlobMatcher(GlobMatcher&&) noexcept = default;
+GlobMatcher& GlobMatcher::operator=(GlobMatcher&&) noexcept = default;
+
+bool GlobMatcher::matches(std::string_view path) const {
+    path = normalize(path);
+    if (components_ && any_component(path, [this](std::string_view component) {
+            return components_->match(component, nullptr);
+        })) {
+        return true;
+    }
+    return paths_ && paths_->match(path, nullptr);
+}
+
+std::vector<size_t> GlobMatcher::matching_patterns(std::string_view path) const {
+    path = normalize(path);
+    std::vector<size_t> result;
+    if (components_) {
+        any_component(path, [this, &result](std::string_view component) {
+            components_->match(component, &result);
+            return false;
+        });
+    }
+    if (paths_) {
+        paths_->match(path, &result);
+    }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+}  // namespace wip::utils::string
@@ -0,0 +1,331 @@
+#include "wip_string.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(_M_X64)) && !defined(WIP_STRING_PORTABLE)
+#define WIP_STRING_SSE2 1
+#include <emmintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define WIP_STRING_AVX2 1
+#include <immintrin.h>
+#endif
+#elif (defined(__aarch64__) || defined(_M_ARM64)) && !defined(WIP_STRING_PORTABLE)
+#define WIP_STRING_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace wip::utils::string {
+
+namespace {
+
+// Upper and lower case ASCII letters differ only in this bit
+constexpr unsigned char CASE_BIT = 0x20;
+
+inline char fold(char c) noexcept {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c | CASE_BIT) : c;
+}
+
+inline unsigned lowest_bit(uint64_t mask) noexcept {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(mask));
+#endif
+}
+
+template <bool IgnoreCase>
+bool equal(const char* a, const char* b, size_t size) noexcept {
+    if (!IgnoreCase) {
+        return std::memcmp(a, b, size) == 0;
+    }
+    for (size_t i = 0; i < size; ++i) {
+        if (fold(a[i]) != fold(b[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Compares the bytes between the first and last ones, which the vector filters already matched
+template <bool IgnoreCase>
+bool equal_middle(const char* candidate, const char* needle, size_t size) noexcept {
+    return size < 3 || equal<IgnoreCase>(candidate + 1, needle + 1, size - 2);
+}
+
+// ==================== Portable kernels ====================
+
+// Toggles the case bit of every byte in [first, first + 25]
+void flip_case_portable(char* data, size_t size, char first) noexcept {
+    for (size_t i = 0; i < size; ++i) {
+        if (static_cast<unsigned char>(data[i] - first) < 26) {
+            data[i] = static_cast<char>(data[i] ^ CASE_BIT);
+        }
+    }
+}
+
+// The kernels below take a needle that fits in text from start onwards
+
+template <bool IgnoreCase>
+size_t find_portable(const char* text, size_t size, const char* needle, size_t needle_size, size_t start) noexcept {
+    if (!IgnoreCase) {
+        return std::string_view(text, size).find(std::string_view(needle, needle_size), start);
+    }
+    const char first = fold(needle[0]);
+    for (size_t i = start; i + needle_size <= size; ++i) {
+        if (fold(text[i]) == first && equal<true>(text + i + 1, needle + 1, needle_size - 1)) {
+            return i;
+        }
+    }
+    return std::string_view::npos;
+}
+
+// ==================== SSE2 ====================
+
+#ifdef WIP_STRING_SSE2
+inline __m128i flip_case_sse2(__m128i value, char first) noexcept {
+    // Bytes in range move to [-128, -103], the bottom of the signed range
+    __m128i shifted = _mm_add_epi8(value, _mm_set1_epi8(static_cast<char>(0x80 - first)));
+    __m128i in_range = _mm_cmpgt_epi8(_mm_set1_epi8(-128 + 26), shifted);
+    return _mm_xor_si128(value, _mm_and_si128(in_range, _mm_set1_epi8(CASE_BIT)));
+}
+
+void flip_case_sse2(char* data, size_t size, char first) noexcept {
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        auto* block = reinterpret_cast<__m128i*>(data + i);
+        _mm_storeu_si128(block, flip_case_sse2(_mm_loadu_si128(block), first));
+    }
+    flip_case_portable(data + i, size - i, first);
+}
+
+// Matches the first and last needle bytes at 16 positions at once and only
+// compares the rest of the needle where both match
+template <bool IgnoreCase>
+size_t find_sse2(const char* text, size_t size, const char* needle, size_t needle_size, size_t start) noexcept {
+    const __m128i first = _mm_set1_epi8(IgnoreCase ? fold(needle[0]) : needle[0]);
+    const __m128i last = _mm_set1_epi8(IgnoreCase ? fold(needle[needle_size - 1]) : needle[needle_size - 1]);
+
+    size_t i = start;
+    for (; i + needle_size + 15 <= size; i += 16) {
+        __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+        __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i + needle_size - 1));
+        if (IgnoreCase) {
+            head = flip_case_sse2(head, 'A');
+            tail = flip_case_sse2(tail, 'A');
+        }
+        auto mask = static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(head, first), _mm_cmpeq_epi8(tail, last))));
+        for (; mask != 0; mask &= mask - 1) {
+            size_t position = i + lowest_bit(mask);
+            if (equal_middle<IgnoreCase>(text + position, needle, needle_size)) {
+                return position;
+            }
+        }
+    }
+    return find_portable<IgnoreCase>(text, size, needle, needle_size, i);
+}
+#endif
+
+// ==================== AVX2 ====================
+
+#ifdef WIP_STRING_AVX2
+__attribute__((target("avx2")))
+inline __m256i flip_case_avx2(__m256i value, char first) noexcept {
+    __m256i shifted = _mm256_add_epi8(value, _mm256_set1_epi8(static_cast<char>(0x80 - first)));
+    __m256i in_range = _mm256_cmpgt_epi8(_mm256_set1_epi8(-128 + 26), shifted);
+    return _mm256_xor_si256(value, _mm256_and_si256(in_range, _mm256_set1_epi8(CASE_BIT)));
+}
+
+__attribute__((target("avx2")))
+void flip_case_avx2(char* data, size_t size, char first) noexcept {
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        auto* block = reinterpret_cast<__m256i*>(data + i);
+        _mm256_storeu_si256(block, flip_case_avx2(_mm256_loadu_si256(block), first));
+    }
+    // The compiler does not clear the upper halves before a tail call into
+    // SSE2 code, and running legacy SSE with them dirty is slow
+    _mm256_zeroupper();
+    flip_case_sse2(data + i, size - i, first);
+}
+
+template <bool IgnoreCase>
+__attribute__((target("avx2")))
+size_t find_avx2(const char* text, size_t size, const char* needle, size_t needle_size, size_t start) noexcept {
+    const __m256i first = _mm256_set1_epi8(IgnoreCase ? fold(needle[0]) : needle[0]);
+    const __m256i last = _mm256_set1_epi8(IgnoreCase ? fold(needle[needle_size - 1]) : needle[needle_size - 1]);
+
+    size_t i = start;
+    for (; i + needle_size + 31 <= size; i += 32) {
+        __m256i head = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i));
+        __m256i tail = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i + needle_size - 1));
+        if (IgnoreCase) {
+            head = flip_case_avx2(head, 'A');
+            tail = flip_case_avx2(tail, 'A');
+        }
+        auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(head, first), _mm256_cmpeq_epi8(tail, last))));
+        for (; mask != 0; mask &= mask - 1) {
+            size_t position = i + lowest_bit(mask);
+            if (equal_middle<IgnoreCase>(text + position, needle, needle_size)) {
+                return position;
+            }
+        }
+    }
+    _mm256_zeroupper();
+    return find_sse2<IgnoreCase>(text, size, needle, needle_size, i);
+}
+#endif
+
+// ==================== NEON ====================
+
+#ifdef WIP_STRING_NEON
+inline uint8x16_t flip_case_neon(uint8x16_t value, char first) noexcept {
+    uint8x16_t in_range = vcltq_u8(vsubq_u8(value, vdupq_n_u8(static_cast<uint8_t>(first))), vdupq_n_u8(26));
+    return veorq_u8(value, vandq_u8(in_range, vdupq_n_u8(CASE_BIT)));
+}
+
+void flip_case_neon(char* data, size_t size, char first) noexcept {
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        auto* block = reinterpret_cast<uint8_t*>(data + i);
+        vst1q_u8(block, flip_case_neon(vld1q_u8(block), first));
+    }
+    flip_case_portable(data + i, size - i, first);
+}
+
+template <bool IgnoreCase>
+size_t find_neon(const char* text, size_t size, const char* needle, size_t needle_size, size_t start) noexcept {
+    const uint8x16_t first = vdupq_n_u8(static_cast<uint8_t>(IgnoreCase ? fold(needle[0]) : needle[0]));
+    const uint8x16_t last =
+        vdupq_n_u8(static_cast<uint8_t>(IgnoreCase ? fold(needle[needle_size - 1]) : needle[needle_size - 1]));
+
+    size_t i = start;
+    for (; i + needle_size + 15 <= size; i += 16) {
+        uint8x16_t head = vld1q_u8(reinterpret_cast<const uint8_t*>(text + i));
+        uint8x16_t tail = vld1q_u8(reinterpret_cast<const uint8_t*>(text + i + needle_size - 1));
+        if (IgnoreCase) {
+            head = flip_case_neon(head, 'A');
+            tail = flip_case_neon(tail, 'A');
+        }
+        uint8x16_t matches = vandq_u8(vceqq_u8(head, first), vceqq_u8(tail, last));
+        // NEON has no movemask; narrowing leaves four bits per byte, keep one of them
+        uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(matches), 4)), 0);
+        for (mask &= 0x8888888888888888ULL; mask != 0; mask &= mask - 1) {
+            size_t position = i + lowest_bit(mask) / 4;
+            if (equal_middle<IgnoreCase>(text + position, needle, needle_size)) {
+                return position;
+            }
+        }
+    }
+    return find_portable<IgnoreCase>(text, size, needle, needle_size, i);
+}
+#endif
+
+// ==================== Kernel selection ====================
+
+using FlipCase = void (*)(char*, size_t, char) noexcept;
+using Find = size_t (*)(const char*, size_t, const char*, size_t, size_t) noexcept;
+
+struct Kernels {
+    FlipCase flip_case;
+    Find find;
+    Find find_ignore_case;
+    const char* name;
+};
+
+Kernels select_kernels() noexcept {
+#ifdef WIP_STRING_AVX2
+    if (__builtin_cpu_supports("avx2")) {
+        return {flip_case_avx2, find_avx2<false>, find_avx2<true>, "avx2"};
+    }
+#endif
+#if defined(WIP_STRING_SSE2)
+    return {flip_case_sse2, find_sse2<false>, find_sse2<true>, "sse2"};
+#elif defined(WIP_STRING_NEON)
+    return {flip_case_neon, find_neon<false>, find_neon<true>, "neon"};
+#else
+    return {flip_case_portable, find_portable<false>, find_portable<true>, "portable"};
+#endif
+}
+
+const Kernels& kernels() noexcept {
+    static const Kernels selected = select_kernels();
+    return selected;
+}
+
+// Handles the cases std::string_view::find answers without searching
+template <bool IgnoreCase>
+size_t search(std::string_view text, std::string_view substring, size_t start) noexcept {
+    if (start > text.size() || substring.size() > text.size() - start) {
+        return std::string_view::npos;
+    }
+    if (substring.empty()) {
+        return start;
+    }
+    if (!IgnoreCase && substring.size() == 1) {
+        const void* found = std::memchr(text.data() + start, substring[0], text.size() - start);
+        return found ? static_cast<const char*>(found) - text.data() : std::string_view::npos;
+    }
+    Find find = IgnoreCase ? kernels().find_ignore_case : kernels().find;
+    return find(text.data(), text.size(), substring.data(), substring.size(), start);
+}
+
+} // namespace
+
+std::string to_upper(std::string_view input) {
+    std::string result{input};
+    kernels().flip_case(result.data(), result.size(), 'a');
+    return result;
+}
+
+std::string to_lower(std::string_view input) {
+    std::string result{input};
+    kernels().flip_case(result.data(), result.size(), 'A');
+    return result;
+}
+
+bool contains(std::string_view text, std::string_view substring) {
+    return search<false>(text, substring, 0) != std::string_view::npos;
+}
+
+bool contains_ignore_case(std::string_view text, std::string_view substring) {
+    return search<true>(text, substring, 0) != std::string_view::npos;
+}
+
+size_t find(std::string_view text, std::string_view substring, size_t start) {
+    return search<false>(text, substring, start);
+}
+
+size_t find_ignore_case(std::string_view text, std::string_view substring, size_t start) {
+    return search<true>(text, substring, start);
+}
+
+size_t count_occurrences(std::string_view text, std::string_view substring, bool overlap) {
+    if (substring.empty()) {
+        return 0;
+    }
+
+    size_t count = 0;
+    size_t pos = 0;
+
+    while ((pos = search<false>(text, substring, pos)) != std::string_view::npos) {
+        ++count;
+        pos += overlap ? 1 : substring.length();
+    }
+
+    return count;
+}
+
+const char* simd_backend() noexcept {
+    return kernels().name;
+}
+
+} // namespace wip::utils::string
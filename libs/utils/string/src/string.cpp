@@ -9,20 +9,6 @@
 
 namespace wip::utils::string {
 
-std::string to_upper(std::string_view input) {
-    std::string result{input};
-    std::transform(result.begin(), result.end(), result.begin(),
-                   [](unsigned char c) { return std::toupper(c); });
-    return result;
-}
-
-std::string to_lower(std::string_view input) {
-    std::string result{input};
-    std::transform(result.begin(), result.end(), result.begin(),
-                   [](unsigned char c) { return std::tolower(c); });
-    return result;
-}
-
 std::string capitalize(std::string_view input) {
     if (input.empty()) {
         return "";
@@ -53,85 +39,58 @@ std::string title_case(std::string_view input) {
 }
 
 std::string trim(std::string_view input, std::string_view chars) {
+    return std::string{trim_view(input, chars)};
+}
+
+std::string trim_left(std::string_view input, std::string_view chars) {
+    return std::string{trim_left_view(input, chars)};
+}
+
+std::string trim_right(std::string_view input, std::string_view chars) {
+    return std::string{trim_right_view(input, chars)};
+}
+
+std::string_view trim_view(std::string_view input, std::string_view chars) {
     const auto start = input.find_first_not_of(chars);
     if (start == std::string_view::npos) {
-        return "";
+        return {};
     }
     
     const auto end = input.find_last_not_of(chars);
-    return std::string{input.substr(start, end - start + 1)};
+    return input.substr(start, end - start + 1);
 }
 
-std::string trim_left(std::string_view input, std::string_view chars) {
+std::string_view trim_left_view(std::string_view input, std::string_view chars) {
     const auto start = input.find_first_not_of(chars);
     if (start == std::string_view::npos) {
-        return "";
+        return {};
     }
     
-    return std::string{input.substr(start)};
+    return input.substr(start);
 }
 
-std::string trim_right(std::string_view input, std::string_view chars) {
+std::string_view trim_right_view(std::string_view input, std::string_view chars) {
     const auto end = input.find_last_not_of(chars);
     if (end == std::string_view::npos) {
-        return "";
+        return {};
     }
     
-    return std::string{input.substr(0, end + 1)};
+    return input.substr(0, end + 1);
 }
 
 std::vector<std::string> split(std::string_view data, char delimiter, size_t max_splits) {
     std::vector<std::string> result;
-    
-    if (data.empty()) {
-        result.emplace_back("");
-        return result;
-    }
-    
-    std::string item;
-    std::stringstream ss{std::string{data}};
-    
-    size_t splits = 0;
-    while (std::getline(ss, item, delimiter)) {
-        if (max_splits > 0 && splits >= max_splits) {
-            // Add the rest as the last element
-            std::string remainder;
-            if (std::getline(ss, remainder, '\0')) {
-                item += delimiter + remainder;
-            }
-            result.push_back(item);
-            break;
-        }
-        result.push_back(item);
-        ++splits;
+    for (std::string_view part : split_view(data, delimiter, max_splits)) {
+        result.emplace_back(part);
     }
-    
     return result;
 }
 
 std::vector<std::string> split(std::string_view data, std::string_view delimiter, size_t max_splits) {
     std::vector<std::string> result;
-    if (delimiter.empty()) {
-        result.emplace_back(data);
-        return result;
+    for (std::string_view part : split_view(data, delimiter, max_splits)) {
+        result.emplace_back(part);
     }
-    
-    size_t start = 0;
-    size_t splits = 0;
-    
-    while (start < data.length()) {
-        size_t end = data.find(delimiter, start);
-        
-        if (end == std::string_view::npos || (max_splits > 0 && splits >= max_splits)) {
-            result.emplace_back(data.substr(start));
-            break;
-        }
-        
-        result.emplace_back(data.substr(start, end - start));
-        start = end + delimiter.length();
-        ++splits;
-    }
-    
     return result;
 }
 
@@ -164,24 +123,38 @@ bool ends_with(std::string_view text, std::string_view suffix) {
            text.substr(text.length() - suffix.length()) == suffix;
 }
 
-bool contains(std::string_view text, std::string_view substring) {
-    return text.find(substring) != std::string_view::npos;
+std::string replace_all(std::string_view text, std::string_view from, std::string_view to) {
+    std::string result;
+    append_replace_all(result, text, from, to);
+    return result;
 }
 
-std::string replace_all(std::string_view text, std::string_view from, std::string_view to) {
+size_t append_replace_all(std::string& output, std::string_view text, std::string_view from, std::string_view to) {
     if (from.empty()) {
-        return std::string{text};
+        output.append(text);
+        return 0;
     }
     
-    std::string result{text};
-    size_t pos = 0;
+    // Find the first match before growing the buffer; most texts have none
+    size_t pos = text.find(from);
+    if (pos == std::string_view::npos) {
+        output.append(text);
+        return 0;
+    }
     
-    while ((pos = result.find(from, pos)) != std::string::npos) {
-        result.replace(pos, from.length(), to);
-        pos += to.length();
+    size_t count = 0;
+    size_t start = 0;
+    
+    while (pos != std::string_view::npos) {
+        output.append(text.substr(start, pos - start));
+        output.append(to);
+        start = pos + from.length();
+        ++count;
+        pos = text.find(from, start);
     }
     
-    return result;
+    output.append(text.substr(start));
+    return count;
 }
 
 std::string replace_first(std::string_view text, std::string_view from, std::string_view to) {
@@ -254,22 +227,6 @@ bool is_palindrome(std::string_view text, bool ignore_case, bool ignore_spaces)
     return processed == reverse(processed);
 }
 
-size_t count_occurrences(std::string_view text, std::string_view substring, bool overlap) {
-    if (substring.empty()) {
-        return 0;
-    }
-    
-    size_t count = 0;
-    size_t pos = 0;
-    
-    while ((pos = text.find(substring, pos)) != std::string_view::npos) {
-        ++count;
-        pos += overlap ? 1 : substring.length();
-    }
-    
-    return count;
-}
-
 bool is_alpha(std::string_view text) {
     if (text.empty()) {
         return false;
@@ -325,14 +282,7 @@ std::optional<double> to_double(std::string_view text) {
 }
 
 std::string substitute(std::string_view template_str, const std::unordered_map<std::string, std::string>& variables) {
-    std::string result{template_str};
-    
-    for (const auto& [key, value] : variables) {
-        std::string placeholder = "${" + key + "}";
-        result = replace_all(result, placeholder, value);
-    }
-    
-    return result;
+    return CompiledTemplate(template_str).render(variables);
 }
 
 std::string random_string(size_t length, std::string_view charset) {
@@ -354,51 +304,4 @@ std::string random_string(size_t length, std::string_view charset) {
     return result;
 }
 
-size_t levenshtein_distance(std::string_view str1, std::string_view str2) {
-    const size_t len1 = str1.length();
-    const size_t len2 = str2.length();
-    
-    if (len1 == 0) return len2;
-    if (len2 == 0) return len1;
-    
-    std::vector<std::vector<size_t>> matrix(len1 + 1, std::vector<size_t>(len2 + 1));
-    
-    // Initialize first row and column
-    for (size_t i = 0; i <= len1; ++i) {
-        matrix[i][0] = i;
-    }
-    for (size_t j = 0; j <= len2; ++j) {
-        matrix[0][j] = j;
-    }
-    
-    // Fill the matrix
-    for (size_t i = 1; i <= len1; ++i) {
-        for (size_t j = 1; j <= len2; ++j) {
-            size_t cost = (str1[i - 1] == str2[j - 1]) ? 0 : 1;
-            
-            matrix[i][j] = std::min({
-                matrix[i - 1][j] + 1,      // deletion
-                matrix[i][j - 1] + 1,      // insertion
-                matrix[i - 1][j - 1] + cost // substitution
-            });
-        }
-    }
-    
-    return matrix[len1][len2];
-}
-
-double similarity(std::string_view str1, std::string_view str2) {
-    if (str1.empty() && str2.empty()) {
-        return 1.0;
-    }
-    
-    size_t max_len = std::max(str1.length(), str2.length());
-    if (max_len == 0) {
-        return 1.0;
-    }
-    
-    size_t distance = levenshtein_distance(str1, str2);
-    return 1.0 - static_cast<double>(distance) / static_cast<double>(max_len);
-}
-
 }  // namespace wip::utils::string
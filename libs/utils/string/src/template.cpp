@@ -0,0 +1,107 @@
+#include "wip_string.h"
+
+namespace wip::utils::string {
+
+CompiledTemplate::CompiledTemplate(std::string_view template_str) : text_(template_str) {
+    size_t literal_start = 0;
+    auto add_literal = [this](size_t offset, size_t end) {
+        if (end == offset) {
+            return;
+        }
+        if (!segments_.empty() && segments_.back().variable == npos) {
+            segments_.back().length += end - offset;
+        } else {
+            segments_.push_back({offset, end - offset, npos});
+        }
+        literal_size_ += end - offset;
+    };
+
+    size_t open = text_.find("${");
+    while (open != std::string::npos) {
+        size_t close = text_.find('}', open + 2);
+        if (close == std::string::npos) {
+            break;
+        }
+
+        std::string_view name = std::string_view(text_).substr(open + 2, close - open - 2);
+        size_t variable = index_of(name);
+        if (variable == npos) {
+            variable = variables_.size();
+            variables_.emplace_back(name);
+            uses_.push_back(0);
+        }
+        ++uses_[variable];
+
+        add_literal(literal_start, open);
+        segments_.push_back({open, close + 1 - open, variable});
+        literal_start = close + 1;
+        open = text_.find("${", literal_start);
+    }
+    add_literal(literal_start, text_.size());
+}
+
+size_t CompiledTemplate::index_of(std::string_view name) const noexcept {
+    for (size_t i = 0; i < variables_.size(); ++i) {
+        if (variables_[i] == name) {
+            return i;
+        }
+    }
+    return npos;
+}
+
+size_t CompiledTemplate::rendered_size(const std::vector<std::string_view>& values) const noexcept {
+    size_t size = literal_size_;
+    for (size_t i = 0; i < variables_.size(); ++i) {
+        // A placeholder without a value stays as ${name}
+        size_t length = i < values.size() ? values[i].size() : variables_[i].size() + 3;
+        size += length * uses_[i];
+    }
+    return size;
+}
+
+// lookup(index) returns a pointer to the value of a variable, or nullptr to keep its placeholder
+template <typename Lookup>
+void CompiledTemplate::append(std::string& out, Lookup lookup) const {
+    for (const auto& segment : segments_) {
+        const std::string_view* value = segment.variable == npos ? nullptr : lookup(segment.variable);
+        if (value) {
+            out.append(value->data(), value->size());
+        } else {
+            out.append(text_, segment.offset, segment.length);
+        }
+    }
+}
+
+void CompiledTemplate::render_to(std::string& out, const std::vector<std::string_view>& values) const {
+    out.reserve(out.size() + rendered_size(values));
+    append(out, [&values](size_t index) { return index < values.size() ? &values[index] : nullptr; });
+}
+
+std::string CompiledTemplate::render(const std::vector<std::string_view>& values) const {
+    std::string result;
+    render_to(result, values);
+    return result;
+}
+
+std::string CompiledTemplate::render(const std::unordered_map<std::string, std::string>& variables) const {
+    std::vector<std::string_view> values(variables_.size());
+    std::vector<bool> found(variables_.size(), false);
+    size_t size = literal_size_;
+    for (size_t i = 0; i < variables_.size(); ++i) {
+        auto it = variables.find(variables_[i]);
+        if (it != variables.end()) {
+            values[i] = it->second;
+            found[i] = true;
+            size += values[i].size() * uses_[i];
+        } else {
+            size += (variables_[i].size() + 3) * uses_[i];  // Kept as ${name}
+        }
+    }
+
+    std::string result;
+    result.reserve(size);
+    append(result, [&](size_t index) { return found[index] ? &values[index] : nullptr; });
+    return result;
+}
+
+}  // namespace wip::utils::string
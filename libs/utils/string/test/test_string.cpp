@@ -1,7 +1,11 @@
 #include "wip_string.h"
+#include "pattern_matcher.h"
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <random>
+
 class StringTest : public ::testing::Test {
 protected:
     void SetUp() override {
@@ -34,6 +38,27 @@ TEST_F(StringTest, ToLower_WhenEmptyString_ReturnsEmpty) {
     EXPECT_EQ(wip::utils::string::to_lower(""), "");
 }
 
+TEST_F(StringTest, CaseConversion_WhenLongOrNonAscii_ConvertsOnlyAsciiLetters) {
+    std::string mixed;
+    for (int i = 0; i < 256; ++i) {
+        mixed += static_cast<char>(i);
+    }
+    std::string upper = wip::utils::string::to_upper(mixed);
+    std::string lower = wip::utils::string::to_lower(mixed);
+    ASSERT_EQ(upper.size(), mixed.size());
+    ASSERT_EQ(lower.size(), mixed.size());
+    for (int i = 0; i < 256; ++i) {
+        char c = static_cast<char>(i);
+        EXPECT_EQ(upper[i], (c >= 'a' && c <= 'z') ? c - 'a' + 'A' : c) << i;
+        EXPECT_EQ(lower[i], (c >= 'A' && c <= 'Z') ? c - 'A' + 'a' : c) << i;
+    }
+}
+
+TEST_F(StringTest, SimdBackend_ReportsSelectedKernels) {
+    std::string backend = wip::utils::string::simd_backend();
+    EXPECT_TRUE(backend == "avx2" || backend == "sse2" || backend == "neon" || backend == "portable") << backend;
+}
+
 TEST_F(StringTest, Capitalize_WhenValidString_ReturnsCapitalized) {
     EXPECT_EQ(wip::utils::string::capitalize("hello"), "Hello");
     EXPECT_EQ(wip::utils::string::capitalize("HELLO"), "Hello");
@@ -72,6 +97,16 @@ TEST_F(StringTest, TrimRight_WhenWhitespaceAtEnd_RemovesRightWhitespace) {
     EXPECT_EQ(wip::utils::string::trim_right("xxhelloxx", "x"), "xxhello");
 }
 
+TEST_F(StringTest, TrimView_WhenWhitespaceAroundString_ViewsInput) {
+    std::string_view input = "  hello  ";
+    EXPECT_EQ(wip::utils::string::trim_view(input), "hello");
+    EXPECT_EQ(wip::utils::string::trim_view(input).data(), input.data() + 2);
+    EXPECT_EQ(wip::utils::string::trim_left_view(input), "hello  ");
+    EXPECT_EQ(wip::utils::string::trim_right_view(input), "  hello");
+    EXPECT_EQ(wip::utils::string::trim_view("xxhelloxx", "x"), "hello");
+    EXPECT_TRUE(wip::utils::string::trim_view(" \t\n").empty());
+}
+
 // Test split functions
 TEST_F(StringTest, Split_WhenCharDelimiter_ReturnsSplitStrings) {
     auto result = wip::utils::string::split("a,b,c", ',');
@@ -97,6 +132,61 @@ TEST_F(StringTest, Split_WhenEmptyString_ReturnsEmptyVector) {
     EXPECT_EQ(result, expected);
 }
 
+TEST_F(StringTest, SplitView_WhenIterated_YieldsSameAsSplit) {
+    const std::vector<std::string> inputs = {"", ",", ",,", "a", "a,", ",a", "a,,b", "a,b,c", "a,b,c,d,", " a , b "};
+    for (const auto& input : inputs) {
+        for (size_t max_splits : {0, 1, 2}) {
+            std::vector<std::string> parts;
+            for (std::string_view part : wip::utils::string::split_view(input, ',', max_splits)) {
+                EXPECT_GE(part.data(), input.data());
+                parts.emplace_back(part);
+            }
+            EXPECT_EQ(parts, wip::utils::string::split(input, ',', max_splits)) << "'" << input << "' " << max_splits;
+        }
+    }
+}
+
+TEST_F(StringTest, SplitView_WhenMaxSplits_KeepsRestTogether) {
+    std::vector<std::string> parts;
+    for (std::string_view part : wip::utils::string::split_view("a,b,c,", ',', 1)) {
+        parts.emplace_back(part);
+    }
+    EXPECT_EQ(parts, (std::vector<std::string>{"a", "b,c,"}));
+}
+
+TEST_F(StringTest, SplitView_WhenStringDelimiter_YieldsSameAsSplit) {
+    const std::vector<std::string> inputs = {"", "::", "a", "a::", "::a", "a::::b", "hello::world::test", "a:b::c"};
+    for (const auto& input : inputs) {
+        for (std::string_view delimiter : {"::", ":", ""}) {
+            std::vector<std::string> parts;
+            for (std::string_view part : wip::utils::string::split_view(input, delimiter)) {
+                parts.emplace_back(part);
+            }
+            EXPECT_EQ(parts, wip::utils::string::split(input, delimiter)) << "'" << input << "' by '" << delimiter << "'";
+        }
+    }
+
+    // An empty delimiter does not split, not even at embedded null characters
+    std::string with_null("a\0b", 3);
+    auto whole = wip::utils::string::split_view(with_null, std::string_view());
+    EXPECT_EQ(std::distance(whole.begin(), whole.end()), 1);
+    EXPECT_EQ(*whole.begin(), with_null);
+}
+
+TEST_F(StringTest, SplitView_WhenIteratorsCompared_FollowsForwardIteratorRules) {
+    auto range = wip::utils::string::split_view("a,,b", ',');
+    auto it = range.begin();
+    auto copy = it;
+    EXPECT_EQ(it, copy);
+    EXPECT_EQ(*it++, "a");
+    EXPECT_NE(it, copy);
+    EXPECT_EQ(*it, "");
+    EXPECT_EQ(it->size(), 0u);
+    EXPECT_EQ(*++it, "b");
+    EXPECT_EQ(++it, range.end());
+    EXPECT_EQ(std::distance(range.begin(), range.end()), 3);
+}
+
 // Test join function
 TEST_F(StringTest, Join_WhenValidParts_ReturnsJoinedString) {
     std::vector<std::string> parts = {"hello", "world", "test"};
@@ -135,6 +225,45 @@ TEST_F(StringTest, Contains_WhenStringContainsSubstring_ReturnsTrue) {
     EXPECT_FALSE(wip::utils::string::contains("hello", "world"));
 }
 
+TEST_F(StringTest, ContainsIgnoreCase_WhenCaseDiffers_ReturnsTrue) {
+    EXPECT_TRUE(wip::utils::string::contains_ignore_case("Hello World", "lo WO"));
+    EXPECT_TRUE(wip::utils::string::contains_ignore_case("TEST", "test"));
+    EXPECT_TRUE(wip::utils::string::contains_ignore_case("anything", ""));
+    EXPECT_FALSE(wip::utils::string::contains_ignore_case("hello", "world"));
+    EXPECT_FALSE(wip::utils::string::contains_ignore_case("a[b", "A{B"));
+}
+
+TEST_F(StringTest, Find_WhenStartGiven_SearchesFromStart) {
+    EXPECT_EQ(wip::utils::string::find("abcabc", "bc"), 1u);
+    EXPECT_EQ(wip::utils::string::find("abcabc", "bc", 2), 4u);
+    EXPECT_EQ(wip::utils::string::find("abcabc", "", 6), 6u);
+    EXPECT_EQ(wip::utils::string::find("abcabc", "", 7), std::string_view::npos);
+    EXPECT_EQ(wip::utils::string::find("abc", "abcd"), std::string_view::npos);
+    EXPECT_EQ(wip::utils::string::find_ignore_case("xxABCabc", "abc", 3), 5u);
+}
+
+TEST_F(StringTest, Find_WhenHaystackSpansVectorBlocks_MatchesStdFind) {
+    // Haystacks longer than a vector register with matches at every alignment
+    std::string text;
+    for (int i = 0; i < 300; ++i) {
+        text += static_cast<char>('a' + (i * 7) % 26);
+        text += (i % 5 == 0) ? "\xC3\xA9" : "";
+    }
+    std::string upper_text = wip::utils::string::to_upper(text);
+    for (size_t length : {1u, 2u, 3u, 5u, 17u, 33u, 64u}) {
+        for (size_t offset = 0; offset + length <= text.size(); offset += 13) {
+            std::string needle = text.substr(offset, length);
+            for (size_t start : {size_t{0}, offset, offset + 1}) {
+                size_t expected = text.find(needle, start);
+                EXPECT_EQ(wip::utils::string::find(text, needle, start), expected);
+                EXPECT_EQ(wip::utils::string::find_ignore_case(upper_text, needle, start), expected);
+            }
+        }
+    }
+    EXPECT_EQ(wip::utils::string::find(text + "needle", "needle"), text.size());
+    EXPECT_EQ(wip::utils::string::find_ignore_case(upper_text + "NEEDLE", "needle"), text.size());
+}
+
 // Test replacement functions
 TEST_F(StringTest, ReplaceAll_WhenSubstringExists_ReplacesAllOccurrences) {
     EXPECT_EQ(wip::utils::string::replace_all("hello world hello", "hello", "hi"), "hi world hi");
@@ -145,6 +274,20 @@ TEST_F(StringTest, ReplaceAll_WhenSubstringNotFound_ReturnsOriginal) {
     EXPECT_EQ(wip::utils::string::replace_all("hello world", "xyz", "abc"), "hello world");
 }
 
+TEST_F(StringTest, AppendReplaceAll_WhenBufferGiven_AppendsResult) {
+    std::string buffer = "> ";
+    EXPECT_EQ(wip::utils::string::append_replace_all(buffer, "hello world hello", "hello", "hi"), 2u);
+    EXPECT_EQ(buffer, "> hi world hi");
+    EXPECT_EQ(wip::utils::string::append_replace_all(buffer, "|aaa", "aa", "b"), 1u);
+    EXPECT_EQ(buffer, "> hi world hi|ba");
+
+    buffer.clear();
+    EXPECT_EQ(wip::utils::string::append_replace_all(buffer, "unchanged", "xyz", "abc"), 0u);
+    EXPECT_EQ(wip::utils::string::append_replace_all(buffer, "", "a", "b"), 0u);
+    EXPECT_EQ(wip::utils::string::append_replace_all(buffer, " text", "", "b"), 0u);
+    EXPECT_EQ(buffer, "unchanged text");
+}
+
 TEST_F(StringTest, ReplaceFirst_WhenSubstringExists_ReplacesFirstOccurrence) {
     EXPECT_EQ(wip::utils::string::replace_first("hello world hello", "hello", "hi"), "hi world hello");
 }
@@ -250,6 +393,45 @@ TEST_F(StringTest, Substitute_WhenValidTemplate_ReplacesVariables) {
               "${unknown} variable");
 }
 
+TEST_F(StringTest, Substitute_WhenValueContainsPlaceholder_DoesNotExpandIt) {
+    std::unordered_map<std::string, std::string> vars = {{"a", "${b}"}, {"b", "x"}};
+    EXPECT_EQ(wip::utils::string::substitute("${a}${b}", vars), "${b}x");
+    EXPECT_EQ(wip::utils::string::substitute("${a", vars), "${a");
+}
+
+TEST_F(StringTest, CompiledTemplate_WhenParsed_ListsVariablesInOrder) {
+    wip::utils::string::CompiledTemplate line("${file}:${line}: ${message} (${file})");
+    EXPECT_EQ(line.variables(), (std::vector<std::string>{"file", "line", "message"}));
+    EXPECT_EQ(line.index_of("message"), 2u);
+    EXPECT_EQ(line.index_of("column"), wip::utils::string::CompiledTemplate::npos);
+    EXPECT_EQ(line.literal_size(), 6u);
+}
+
+TEST_F(StringTest, CompiledTemplate_WhenRenderedByIndex_MatchesSubstitute) {
+    wip::utils::string::CompiledTemplate line("<li>${file}:${line}: ${message} (${file})</li>");
+    std::vector<std::string_view> values = {"main.cpp", "42", "unused variable"};
+    std::unordered_map<std::string, std::string> vars = {
+        {"file", "main.cpp"}, {"line", "42"}, {"message", "unused variable"}};
+
+    std::string expected = "<li>main.cpp:42: unused variable (main.cpp)</li>";
+    EXPECT_EQ(line.render(values), expected);
+    EXPECT_EQ(line.render(vars), expected);
+    EXPECT_EQ(line.rendered_size(values), expected.size());
+
+    std::string buffer = "> ";
+    line.render_to(buffer, values);
+    EXPECT_EQ(buffer, "> " + expected);
+}
+
+TEST_F(StringTest, CompiledTemplate_WhenValuesMissing_KeepsPlaceholders) {
+    wip::utils::string::CompiledTemplate line("${a}-${b}-${c}");
+    EXPECT_EQ(line.render(std::vector<std::string_view>{"1"}), "1-${b}-${c}");
+    EXPECT_EQ(line.rendered_size({"1"}), std::string("1-${b}-${c}").size());
+    EXPECT_EQ(line.render(std::unordered_map<std::string, std::string>{{"c", "3"}}), "${a}-${b}-3");
+    EXPECT_EQ(wip::utils::string::CompiledTemplate("plain text").render(std::vector<std::string_view>{}),
+              "plain text");
+}
+
 // Test random string generation
 TEST_F(StringTest, RandomString_WhenValidLength_ReturnsStringOfCorrectLength) {
     auto result = wip::utils::string::random_string(10);
@@ -275,6 +457,107 @@ TEST_F(StringTest, LevenshteinDistance_WhenValidStrings_ReturnsCorrectDistance)
     EXPECT_EQ(wip::utils::string::levenshtein_distance("kitten", "sitting"), 3);
 }
 
+namespace {
+
+// Classic dynamic programming distance to check the bit-parallel one against
+size_t reference_distance(const std::string& a, const std::string& b) {
+    std::vector<size_t> row(b.size() + 1);
+    for (size_t j = 0; j <= b.size(); ++j) {
+        row[j] = j;
+    }
+    for (size_t i = 1; i <= a.size(); ++i) {
+        size_t diagonal = row[0];
+        row[0] = i;
+        for (size_t j = 1; j <= b.size(); ++j) {
+            size_t above = row[j];
+            row[j] = std::min({row[j] + 1, row[j - 1] + 1, diagonal + (a[i - 1] != b[j - 1] ? 1 : 0)});
+            diagonal = above;
+        }
+    }
+    return row[b.size()];
+}
+
+// Pairs of related strings of every length up to three words
+std::vector<std::pair<std::string, std::string>> distance_cases() {
+    std::mt19937 rng(42);
+    std::vector<std::pair<std::string, std::string>> cases;
+    for (size_t length : {1u, 7u, 63u, 64u, 65u, 100u, 128u, 129u, 200u}) {
+        for (int round = 0; round < 8; ++round) {
+            std::string a;
+            for (size_t i = 0; i < length; ++i) {
+                a += static_cast<char>('a' + rng() % 4);
+            }
+            std::string b = a;
+            for (size_t edits = rng() % 12; edits > 0 && !b.empty(); --edits) {
+                size_t at = rng() % b.size();
+                switch (rng() % 3) {
+                case 0: b[at] = static_cast<char>('a' + rng() % 4); break;
+                case 1: b.erase(at, 1); break;
+                default: b.insert(at, 1, static_cast<char>('a' + rng() % 4)); break;
+                }
+            }
+            cases.emplace_back(a, b);
+        }
+    }
+    return cases;
+}
+
+} // namespace
+
+TEST_F(StringTest, LevenshteinDistance_WhenLongerThanOneWord_MatchesReference) {
+    for (const auto& [a, b] : distance_cases()) {
+        size_t expected = reference_distance(a, b);
+        EXPECT_EQ(wip::utils::string::levenshtein_distance(a, b), expected) << a << " / " << b;
+        EXPECT_EQ(wip::utils::string::levenshtein_distance(b, a), expected) << a << " / " << b;
+    }
+    EXPECT_EQ(wip::utils::string::levenshtein_distance(std::string(300, 'x'), ""), 300);
+    EXPECT_EQ(wip::utils::string::levenshtein_distance(std::string(150, 'x'), std::string(150, 'y')), 150);
+}
+
+TEST_F(StringTest, WithinDistance_WhenLimitGiven_ComparesAgainstDistance) {
+    EXPECT_TRUE(wip::utils::string::within_distance("kitten", "sitting", 3));
+    EXPECT_FALSE(wip::utils::string::within_distance("kitten", "sitting", 2));
+    EXPECT_TRUE(wip::utils::string::within_distance("", "", 0));
+    EXPECT_FALSE(wip::utils::string::within_distance("abc", "", 2));
+    for (const auto& [a, b] : distance_cases()) {
+        size_t distance = reference_distance(a, b);
+        for (size_t limit : {size_t{0}, size_t{1}, size_t{3}, size_t{8}, size_t{20}}) {
+            EXPECT_EQ(wip::utils::string::within_distance(a, b, limit), distance <= limit)
+                << a << " / " << b << " limit " << limit;
+        }
+    }
+}
+
+TEST_F(StringTest, LevenshteinDistances_WhenManyCandidates_MatchesSingleComparisons) {
+    std::string needle = "Unused variable 'value_12' in function process_12";
+    std::vector<std::string> candidates;
+    for (int i = 0; i < 2000; ++i) {
+        candidates.push_back("Unused variable 'value_" + std::to_string(i) + "' in function process_" +
+                             std::to_string(i * 7));
+    }
+    candidates.push_back("");
+    candidates.push_back(needle + needle);
+
+    auto distances = wip::utils::string::levenshtein_distances(needle, candidates, 4);
+    auto scores = wip::utils::string::similarities(needle, candidates, 4);
+    ASSERT_EQ(distances.size(), candidates.size());
+    ASSERT_EQ(scores.size(), candidates.size());
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        EXPECT_EQ(distances[i], wip::utils::string::levenshtein_distance(needle, candidates[i])) << i;
+        EXPECT_DOUBLE_EQ(scores[i], wip::utils::string::similarity(needle, candidates[i])) << i;
+    }
+    EXPECT_TRUE(wip::utils::string::levenshtein_distances(needle, {}).empty());
+
+    // Needles over one word, with candidates sharing prefixes and suffixes of every length
+    for (const auto& [a, b] : distance_cases()) {
+        std::vector<std::string> related = {b, a.substr(0, a.size() / 2) + b, b + a.substr(a.size() / 3)};
+        auto batch = wip::utils::string::levenshtein_distances(a, related, 2);
+        for (size_t i = 0; i < related.size(); ++i) {
+            EXPECT_EQ(batch[i], reference_distance(a, related[i])) << a << " / " << related[i];
+        }
+    }
+}
+
 TEST_F(StringTest, Similarity_WhenValidStrings_ReturnsCorrectSimilarity) {
     EXPECT_DOUBLE_EQ(wip::utils::string::similarity("hello", "hello"), 1.0);
     EXPECT_DOUBLE_EQ(wip::utils::string::similarity("hello", "hallo"), 0.8);
@@ -284,3 +567,174 @@ TEST_F(StringTest, Similarity_WhenValidStrings_ReturnsCorrectSimilarity) {
     EXPECT_GE(sim, 0.0);
     EXPECT_LE(sim, 1.0);
 }
+
+namespace {
+
+// Indices of the patterns occurring in text, by plain search
+std::vector<size_t> reference_occurrences(const std::vector<std::string>& patterns, const std::string& text) {
+    std::vector<size_t> result;
+    for (size_t i = 0; i < patterns.size(); ++i) {
+        if (!patterns[i].empty() && text.find(patterns[i]) != std::string::npos) {
+            result.push_back(i);
+        }
+    }
+    return result;
+}
+
+// Backtracking match of '*' and '?' within one component
+bool reference_wildcard(const char* pattern, const char* name) {
+    if (*pattern == '\0') {
+        return *name == '\0';
+    }
+    if (*pattern == '*') {
+        for (const char* rest = name;; ++rest) {
+            if (reference_wildcard(pattern + 1, rest)) {
+                return true;
+            }
+            if (*rest == '\0') {
+                return false;
+            }
+        }
+    }
+    return *name != '\0' && (*pattern == '?' || *pattern == *name) && reference_wildcard(pattern + 1, name + 1);
+}
+
+} // namespace
+
+TEST_F(StringTest, LiteralMatcher_WhenPatternsOverlap_ReportsEveryOccurrence) {
+    wip::utils::string::LiteralMatcher matcher({"he", "she", "his", "hers", ""});
+    EXPECT_EQ(matcher.pattern_count(), 5u);
+    EXPECT_TRUE(matcher.contains_any("ushers"));
+    EXPECT_FALSE(matcher.contains_any("xyz"));
+    EXPECT_FALSE(matcher.contains_any(""));
+    EXPECT_EQ(matcher.find_patterns("ushers"), (std::vector<size_t>{0, 1, 3}));
+
+    std::vector<std::pair<size_t, size_t>> matches;
+    matcher.for_each_match("ushers", [&](size_t pattern, size_t end) { matches.emplace_back(pattern, end); });
+    std::sort(matches.begin(), matches.end());
+    EXPECT_EQ(matches, (std::vector<std::pair<size_t, size_t>>{{0, 4}, {1, 4}, {3, 6}}));
+}
+
+TEST_F(StringTest, LiteralMatcher_WhenCaseInsensitive_IgnoresAsciiCase) {
+    wip::utils::string::LiteralMatcher matcher({"TODO", "FixMe"}, true);
+    EXPECT_EQ(matcher.find_patterns("// todo: fixme later"), (std::vector<size_t>{0, 1}));
+    wip::utils::string::LiteralMatcher exact({"TODO"});
+    EXPECT_FALSE(exact.contains_any("// todo"));
+}
+
+TEST_F(StringTest, LiteralMatcher_WhenManyRandomPatterns_MatchesPlainSearch) {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> letter('a', 'd');
+    auto random_string = [&](size_t length) {
+        std::string s;
+        for (size_t i = 0; i < length; ++i) {
+            s += static_cast<char>(letter(rng));
+        }
+        return s;
+    };
+
+    std::vector<std::string> patterns;
+    for (size_t i = 0; i < 300; ++i) {
+        patterns.push_back(random_string(1 + i % 7));
+    }
+    wip::utils::string::LiteralMatcher matcher(patterns);
+    for (size_t i = 0; i < 50; ++i) {
+        std::string text = random_string(i * 3);
+        EXPECT_EQ(matcher.find_patterns(text), reference_occurrences(patterns, text)) << text;
+        EXPECT_EQ(matcher.contains_any(text), !reference_occurrences(patterns, text).empty()) << text;
+    }
+}
+
+TEST_F(StringTest, LiteralMatcher_WhenAutomatonIsTooLargeForTable_MatchesPlainSearch) {
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> letter('a', 'z');
+    auto random_string = [&](size_t length) {
+        std::string s;
+        for (size_t i = 0; i < length; ++i) {
+            s += static_cast<char>(letter(rng));
+        }
+        return s;
+    };
+
+    // About 9000 trie nodes, more than get a transition table
+    std::vector<std::string> patterns;
+    for (size_t i = 0; i < 1500; ++i) {
+        patterns.push_back(random_string(2 + i % 8));
+    }
+    wip::utils::string::LiteralMatcher matcher(patterns);
+    for (size_t i = 0; i < 20; ++i) {
+        std::string text = random_string(200);
+        EXPECT_EQ(matcher.find_patterns(text), reference_occurrences(patterns, text)) << text;
+        EXPECT_EQ(matcher.contains_any(text), !reference_occurrences(patterns, text).empty()) << text;
+    }
+}
+
+TEST_F(StringTest, GlobMatcher_WhenPatternHasNoSlash_MatchesAnyComponent) {
+    wip::utils::string::GlobMatcher matcher({"build", "*.pb.cc", "test_?.cpp", "[!a-m]*.h"});
+    EXPECT_TRUE(matcher.matches("build/a.cpp"));
+    EXPECT_TRUE(matcher.matches("src/build/b.cpp"));
+    EXPECT_TRUE(matcher.matches("proto/gen/msg.pb.cc"));
+    EXPECT_TRUE(matcher.matches("tests/test_1.cpp"));
+    EXPECT_TRUE(matcher.matches("include/widget.h"));
+    EXPECT_FALSE(matcher.matches("include/api.h"));
+    EXPECT_FALSE(matcher.matches("tests/test_12.cpp"));
+    EXPECT_FALSE(matcher.matches("builder/a.cpp"));
+    EXPECT_EQ(matcher.matching_patterns("build/x/test_a.cpp"), (std::vector<size_t>{0, 2}));
+}
+
+TEST_F(StringTest, GlobMatcher_WhenPatternHasSlash_MatchesFromRootAndSubtree) {
+    wip::utils::string::GlobMatcher matcher({"src/gen", "./third_party/", "src/**/main.cpp", "docs/*.md", "lib/a**b"});
+    EXPECT_TRUE(matcher.matches("src/gen/a.cpp"));
+    EXPECT_TRUE(matcher.matches("/src/gen"));
+    EXPECT_FALSE(matcher.matches("lib/src/gen/a.cpp"));
+    EXPECT_FALSE(matcher.matches("src/generated/a.cpp"));
+    EXPECT_TRUE(matcher.matches("third_party/zlib/zlib.h"));
+    EXPECT_TRUE(matcher.matches("src/main.cpp"));
+    EXPECT_TRUE(matcher.matches("src/app/cli/main.cpp"));
+    EXPECT_FALSE(matcher.matches("src/app/domain.cpp"));
+    EXPECT_TRUE(matcher.matches("docs/index.md"));
+    EXPECT_FALSE(matcher.matches("docs/api/index.md"));
+    EXPECT_TRUE(matcher.matches("lib/ab"));
+    EXPECT_TRUE(matcher.matches("lib/a/x/b"));
+}
+
+TEST_F(StringTest, GlobMatcher_WhenCaseInsensitive_IgnoresAsciiCase) {
+    wip::utils::string::GlobMatcher matcher({"*.CPP", "Src/[a-c]*"}, true);
+    EXPECT_TRUE(matcher.matches("lib/main.cpp"));
+    EXPECT_TRUE(matcher.matches("SRC/Core/x.h"));
+    EXPECT_FALSE(matcher.matches("src/dir/x.h"));
+    EXPECT_FALSE(wip::utils::string::GlobMatcher({"*.CPP"}).matches("main.cpp"));
+}
+
+TEST_F(StringTest, GlobMatcher_WhenAutomatonExceedsLimit_MatchesLikeSimplePatterns) {
+    // Many wildcards over a small alphabet make the deterministic automaton
+    // explode, so paths leave the built states and finish on the patterns
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> pick(0, 5);
+    const char symbols[] = {'a', 'b', 'c', '?', '*', 'a'};
+    std::vector<std::string> patterns;
+    for (size_t i = 0; i < 400; ++i) {
+        std::string pattern;
+        for (size_t j = 0; j < 3 + i % 6; ++j) {
+            pattern += symbols[pick(rng)];
+        }
+        patterns.push_back(pattern);
+    }
+    wip::utils::string::GlobMatcher matcher(patterns);
+
+    std::uniform_int_distribution<int> letter('a', 'c');
+    for (size_t i = 0; i < 200; ++i) {
+        std::string name;
+        for (size_t j = 0; j < i % 40; ++j) {
+            name += static_cast<char>(letter(rng));
+        }
+        std::vector<size_t> expected;
+        for (size_t p = 0; p < patterns.size(); ++p) {
+            if (reference_wildcard(patterns[p].c_str(), name.c_str())) {
+                expected.push_back(p);
+            }
+        }
+        EXPECT_EQ(matcher.matching_patterns(name + "/" + name), expected) << name;
+        EXPECT_EQ(matcher.matches(name), !expected.empty()) << name;
+    }
+}
@@ -0,0 +1,64 @@
+// Benchmark for UID generation, formatting and parsing.
+//
+// Generates random (version 4) and time-ordered (version 7) UIDs, formats
+// them to strings and parses the strings back, and reports the time per ID
+// in nanoseconds. Usage:
+//
+//   bench_wip_utils_uid [count]
+
+#include "benchmark.h"
+#include "uid.h"
+#include <string>
+#include <vector>
+
+using wip::utils::uid::UID;
+
+int main(int argc, char* argv[]) {
+    wip::benchmark::Runner runner("bench_wip_utils_uid", argc, argv, "[count]");
+    size_t count = runner.argument(0, 5000000);
+    std::vector<UID> uids(count, UID::null());
+    std::vector<std::string> strings(count);
+    runner.out() << "Handling " << count << " IDs" << std::endl;
+
+    runner.measure("generate (v4)", count, [&]() {
+        size_t checksum = 0;
+        for (auto& uid : uids) {
+            uid = UID::generate();
+            checksum += uid.data()[0];
+        }
+        return checksum;
+    });
+    runner.measure("generate_v7", count, [&]() {
+        size_t checksum = 0;
+        for (auto& uid : uids) {
+            uid = UID::generate_v7();
+            checksum += uid.data()[15];
+        }
+        return checksum;
+    });
+    runner.measure("to_string", count, [&]() {
+        size_t checksum = 0;
+        for (size_t i = 0; i < count; ++i) {
+            strings[i] = uids[i].to_string();
+            checksum += static_cast<unsigned char>(strings[i][35]);
+        }
+        return checksum;
+    });
+    runner.measure("to_chars", count, [&]() {
+        size_t checksum = 0;
+        char buffer[UID::STRING_LENGTH];
+        for (const auto& uid : uids) {
+            uid.to_chars(buffer);
+            checksum += static_cast<unsigned char>(buffer[35]);
+        }
+        return checksum;
+    });
+    runner.measure("parse", count, [&]() {
+        size_t checksum = 0;
+        for (const auto& text : strings) {
+            checksum += UID(text).data()[15];
+        }
+        return checksum;
+    });
+    return runner.finish();
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
 #include <string>
 #include <random>
 #include <functional>
@@ -11,7 +12,8 @@ namespace wip::utils::uid {
  * @brief Universally Unique Identifier (UUID) class
  * 
  * This class represents a 128-bit UUID that can be generated using random numbers
- * and converted to a standard string representation (RFC 4122 format).
+ * (version 4) or from the time and random numbers (version 7), and converted to
+ * a standard string representation (RFC 4122 format).
  * Implements the Rule of 7 for proper resource management.
  */
 class UID {
@@ -49,12 +51,31 @@ public:
      */
     static UID generate();
     
+    /**
+     * @brief Static factory method to create a new time-ordered UID (UUID version 7)
+     *
+     * The first 48 bits are the Unix time in milliseconds, so these UIDs sort
+     * and index in creation order. UIDs created on one thread within the same
+     * millisecond count up from a random start, so they stay strictly ordered.
+     * @return A new UID with the current time and random data
+     */
+    static UID generate_v7();
+    
     /**
      * @brief Convert UID to standard UUID string representation
      * @return String in format: xxxxxxxx-xxxx-4xxx-yxxx-xxxxxxxxxxxx
      */
     std::string to_string() const;
     
+    /**
+     * @brief Write the standard UUID string representation without allocating
+     * @param out Buffer receiving STRING_LENGTH characters, not null-terminated
+     */
+    void to_chars(char* out) const;
+    
+    // Length of the standard string representation
+    static constexpr size_t STRING_LENGTH = 36;
+    
     /**
      * @brief Get the raw UUID data
      * @return Reference to the underlying byte array
@@ -67,6 +88,17 @@ public:
      */
     bool is_null() const;
     
+    /**
+     * @brief Get the UUID version from the version bits (4 for random, 7 for time-ordered)
+     */
+    int version() const;
+    
+    /**
+     * @brief Get the creation time of a version 7 UID
+     * @return Unix time in milliseconds, or 0 for other versions
+     */
+    uint64_t timestamp_ms() const;
+    
     /**
      * @brief Create a null UID (all zeros)
      * @return A UID with all bytes set to zero
@@ -76,6 +108,9 @@ public:
     // Comparison operators
     bool operator==(const UID& other) const;
     bool operator!=(const UID& other) const;
+    
+    // Ordering by bytes, the same as the order of the strings
+    bool operator<(const UID& other) const;
 
 private:
     UUIDData uuid_data_;
@@ -88,33 +123,13 @@ private:
     
     /**
      * @brief Parse UUID string into byte array
+     *
+     * Validates and decodes in one pass through a table of hex digit values.
      * @param uuid_string String in UUID format
      * @return Parsed byte array
      * @throws std::invalid_argument if string format is invalid
      */
     static UUIDData parse_uuid_string(const std::string& uuid_string);
-    
-    /**
-     * @brief Validate UUID string format
-     * @param uuid_string String to validate
-     * @return true if valid UUID format, false otherwise
-     */
-    static bool is_valid_uuid_string(const std::string& uuid_string);
-    
-    /**
-     * @brief Convert hex character to byte value
-     * @param c Hex character ('0'-'9', 'A'-'F', 'a'-'f')
-     * @return Byte value (0-15)
-     * @throws std::invalid_argument if character is not valid hex
-     */
-    static uint8_t hex_char_to_byte(char c);
-    
-    /**
-     * @brief Convert byte value to hex character
-     * @param value Byte value (0-15)
-     * @return Hex character ('0'-'9', 'a'-'f')
-     */
-    static char byte_to_hex_char(uint8_t value);
 };
 
 }  // namespace wip::utils::uid
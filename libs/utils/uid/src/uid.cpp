@@ -1,18 +1,65 @@
 #include "uid.h"
 
-#include <sstream>
-#include <iomanip>
 #include <stdexcept>
 #include <chrono>
+#include <cstring>
 
 namespace wip::utils::uid {
 
-// Static random number generator
-static thread_local std::mt19937 generator(
-    static_cast<unsigned int>(
-        std::chrono::high_resolution_clock::now().time_since_epoch().count()
-    )
-);
+namespace {
+
+// Per-thread generator, seeded from the system entropy source and the clock
+std::mt19937_64& generator() {
+    static thread_local std::mt19937_64 instance = [] {
+        std::random_device device;
+        std::seed_seq seed{device(), device(),
+                           static_cast<unsigned int>(std::chrono::high_resolution_clock::now().time_since_epoch().count())};
+        return std::mt19937_64(seed);
+    }();
+    return instance;
+}
+
+// Two lowercase hex digits for every byte value
+constexpr std::array<char, 512> make_hex_pairs() {
+    constexpr char digits[] = "0123456789abcdef";
+    std::array<char, 512> pairs{};
+    for (int i = 0; i < 256; ++i) {
+        pairs[2 * i] = digits[i >> 4];
+        pairs[2 * i + 1] = digits[i & 15];
+    }
+    return pairs;
+}
+
+// Value of every hex digit character, 0xFF for any other character
+constexpr std::array<uint8_t, 256> make_hex_values() {
+    std::array<uint8_t, 256> values{};
+    for (int c = 0; c < 256; ++c) {
+        values[c] = 0xFF;
+    }
+    for (int i = 0; i < 10; ++i) {
+        values['0' + i] = static_cast<uint8_t>(i);
+    }
+    for (int i = 0; i < 6; ++i) {
+        values['a' + i] = static_cast<uint8_t>(10 + i);
+        values['A' + i] = static_cast<uint8_t>(10 + i);
+    }
+    return values;
+}
+
+constexpr std::array<char, 512> HEX_PAIRS = make_hex_pairs();
+constexpr std::array<uint8_t, 256> HEX_VALUES = make_hex_values();
+
+// Position in the string of the first digit of every byte
+constexpr size_t BYTE_OFFSETS[16] = {0, 2, 4, 6, 9, 11, 14, 16, 19, 21, 24, 26, 28, 30, 32, 34};
+
+void store_big_endian(uint8_t* out, uint64_t value, int bytes) {
+    for (int i = bytes - 1; i >= 0; --i) {
+        out[i] = static_cast<uint8_t>(value);
+        value >>= 8;
+    }
+}
+
+}  // namespace
 
 // Default constructor - generates a new random UUID
 UID::UID() : uuid_data_(generate_random_data()) {
@@ -55,22 +102,52 @@ UID UID::generate() {
     return UID();
 }
 
+// Static factory method to create a new time-ordered UID
+UID UID::generate_v7() {
+    // Last timestamp and the 12-bit and 62-bit random fields that follow it
+    static thread_local uint64_t last_ms = 0;
+    static thread_local uint64_t rand_a = 0;
+    static thread_local uint64_t rand_b = 0;
+    
+    const uint64_t now = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    if (now > last_ms) {
+        last_ms = now;
+        // The top bit of rand_a starts clear, leaving room to count within the millisecond
+        rand_a = generator()() & 0x7FF;
+        rand_b = generator()() & ((uint64_t{1} << 62) - 1);
+    } else if (++rand_b >> 62) {
+        // Same millisecond, or the clock went back: count up from the last UID
+        rand_b = 0;
+        if (++rand_a >> 12) {
+            rand_a = 0;
+            ++last_ms;
+        }
+    }
+    
+    UUIDData data;
+    store_big_endian(&data[0], last_ms, 6);
+    data[6] = static_cast<uint8_t>(0x70 | (rand_a >> 8));
+    data[7] = static_cast<uint8_t>(rand_a);
+    store_big_endian(&data[8], rand_b, 8);
+    data[8] = (data[8] & 0x3F) | 0x80;
+    return UID(data);
+}
+
 // Convert UID to standard UUID string representation
 std::string UID::to_string() const {
-    std::ostringstream oss;
-    oss << std::hex << std::setfill('0');
-    
+    std::string result(STRING_LENGTH, '-');
+    to_chars(&result[0]);
+    return result;
+}
+
+// Write the string representation, two digits per byte from a table
+void UID::to_chars(char* out) const {
     // Format: xxxxxxxx-xxxx-4xxx-yxxx-xxxxxxxxxxxx
-    // Positions: 0-3, 4-5, 6-7, 8-9, 10-15
     for (size_t i = 0; i < 16; ++i) {
-        // Add hyphens at appropriate positions
-        if (i == 4 || i == 6 || i == 8 || i == 10) {
-            oss << '-';
-        }
-        oss << std::setw(2) << static_cast<unsigned int>(uuid_data_[i]);
+        std::memcpy(out + BYTE_OFFSETS[i], &HEX_PAIRS[2 * uuid_data_[i]], 2);
     }
-    
-    return oss.str();
+    out[8] = out[13] = out[18] = out[23] = '-';
 }
 
 // Get the raw UUID data
@@ -88,6 +165,23 @@ bool UID::is_null() const {
     return true;
 }
 
+// Get the UUID version
+int UID::version() const {
+    return uuid_data_[6] >> 4;
+}
+
+// Get the creation time of a version 7 UID
+uint64_t UID::timestamp_ms() const {
+    if (version() != 7) {
+        return 0;
+    }
+    uint64_t timestamp = 0;
+    for (size_t i = 0; i < 6; ++i) {
+        timestamp = (timestamp << 8) | uuid_data_[i];
+    }
+    return timestamp;
+}
+
 // Create a null UID (all zeros)
 UID UID::null() {
     UUIDData null_data{};
@@ -104,15 +198,16 @@ bool UID::operator!=(const UID& other) const {
     return !(*this == other);
 }
 
+bool UID::operator<(const UID& other) const {
+    return uuid_data_ < other.uuid_data_;
+}
+
 // Private: Generate random UUID data
 UID::UUIDData UID::generate_random_data() {
-    std::uniform_int_distribution<uint8_t> distribution(0, 255);
+    // Two 64-bit draws rather than a distribution call per byte
     UUIDData data;
-    
-    // Generate 16 random bytes
-    for (size_t i = 0; i < 16; ++i) {
-        data[i] = distribution(generator);
-    }
+    store_big_endian(&data[0], generator()(), 8);
+    store_big_endian(&data[8], generator()(), 8);
     
     // Set version to 4 (random UUID)
     // Version bits are in the most significant 4 bits of byte 6
@@ -127,87 +222,27 @@ UID::UUIDData UID::generate_random_data() {
 
 // Private: Parse UUID string into byte array
 UID::UUIDData UID::parse_uuid_string(const std::string& uuid_string) {
-    if (!is_valid_uuid_string(uuid_string)) {
+    // UUID format: xxxxxxxx-xxxx-4xxx-yxxx-xxxxxxxxxxxx (36 characters)
+    if (uuid_string.length() != STRING_LENGTH ||
+        uuid_string[8] != '-' || uuid_string[13] != '-' ||
+        uuid_string[18] != '-' || uuid_string[23] != '-') {
         throw std::invalid_argument("Invalid UUID string format");
     }
     
+    // Invalid digits decode to 0xFF, so any of them leaves high bits in invalid
     UUIDData data;
-    size_t data_index = 0;
-    
-    for (size_t i = 0; i < uuid_string.length(); ++i) {
-        char c = uuid_string[i];
-        
-        // Skip hyphens
-        if (c == '-') {
-            continue;
-        }
-        
-        // Parse pairs of hex characters
-        if (data_index < 16 && i + 1 < uuid_string.length()) {
-            char next_c = uuid_string[i + 1];
-            if (next_c != '-') {
-                uint8_t high_nibble = hex_char_to_byte(c);
-                uint8_t low_nibble = hex_char_to_byte(next_c);
-                data[data_index] = (high_nibble << 4) | low_nibble;
-                ++data_index;
-                ++i; // Skip the next character since we processed it
-            }
-        }
-    }
-    
-    return data;
-}
-
-// Private: Validate UUID string format
-bool UID::is_valid_uuid_string(const std::string& uuid_string) {
-    // UUID format: xxxxxxxx-xxxx-4xxx-yxxx-xxxxxxxxxxxx (36 characters)
-    if (uuid_string.length() != 36) {
-        return false;
-    }
-    
-    // Check hyphen positions
-    if (uuid_string[8] != '-' || uuid_string[13] != '-' || 
-        uuid_string[18] != '-' || uuid_string[23] != '-') {
-        return false;
+    uint8_t invalid = 0;
+    for (size_t i = 0; i < 16; ++i) {
+        const uint8_t high = HEX_VALUES[static_cast<unsigned char>(uuid_string[BYTE_OFFSETS[i]])];
+        const uint8_t low = HEX_VALUES[static_cast<unsigned char>(uuid_string[BYTE_OFFSETS[i] + 1])];
+        invalid |= high | low;
+        data[i] = static_cast<uint8_t>((high << 4) | (low & 0x0F));
     }
-    
-    // Check that all other characters are hex digits
-    for (size_t i = 0; i < uuid_string.length(); ++i) {
-        if (i == 8 || i == 13 || i == 18 || i == 23) {
-            continue; // Skip hyphens
-        }
-        
-        char c = uuid_string[i];
-        if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F'))) {
-            return false;
-        }
+    if (invalid & 0xF0) {
+        throw std::invalid_argument("Invalid UUID string format");
     }
     
-    return true;
-}
-
-// Private: Convert hex character to byte value
-uint8_t UID::hex_char_to_byte(char c) {
-    if (c >= '0' && c <= '9') {
-        return static_cast<uint8_t>(c - '0');
-    } else if (c >= 'a' && c <= 'f') {
-        return static_cast<uint8_t>(c - 'a' + 10);
-    } else if (c >= 'A' && c <= 'F') {
-        return static_cast<uint8_t>(c - 'A' + 10);
-    } else {
-        throw std::invalid_argument("Invalid hex character");
-    }
-}
-
-// Private: Convert byte value to hex character
-char UID::byte_to_hex_char(uint8_t value) {
-    if (value < 10) {
-        return static_cast<char>('0' + value);
-    } else if (value < 16) {
-        return static_cast<char>('a' + value - 10);
-    } else {
-        throw std::invalid_argument("Invalid byte value for hex conversion");
-    }
+    return data;
 }
 
 }  // namespace wip::utils::uid
@@ -216,16 +251,18 @@ char UID::byte_to_hex_char(uint8_t value) {
 namespace std {
 
 size_t hash<wip::utils::uid::UID>::operator()(const wip::utils::uid::UID& uid) const noexcept {
-    // Use the first 8 bytes as hash input for efficiency
+    // Mix both halves: the leading bytes of version 7 UIDs are a timestamp
+    // shared by every UID of a millisecond, so they alone hash poorly
     const auto& data = uid.data();
-    size_t hash_value = 0;
-    
-    // Combine first 8 bytes using a simple hash combining algorithm
-    for (size_t i = 0; i < 8 && i < data.size(); ++i) {
-        hash_value ^= std::hash<uint8_t>{}(data[i]) + 0x9e3779b9 + (hash_value << 6) + (hash_value >> 2);
-    }
+    uint64_t high;
+    uint64_t low;
+    std::memcpy(&high, data.data(), 8);
+    std::memcpy(&low, data.data() + 8, 8);
     
-    return hash_value;
+    uint64_t hash_value = low ^ (high * 0x9E3779B97F4A7C15ULL);
+    hash_value = (hash_value ^ (hash_value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    hash_value = (hash_value ^ (hash_value >> 27)) * 0x94D049BB133111EBULL;
+    return static_cast<size_t>(hash_value ^ (hash_value >> 31));
 }
 
 }  // namespace std
\ No newline at end of file
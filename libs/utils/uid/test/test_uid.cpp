@@ -5,6 +5,8 @@
 #include <unordered_map>
 #include <vector>
 #include <regex>
+#include <chrono>
+#include <cctype>
 
 using namespace wip::utils::uid;
 
@@ -260,6 +262,83 @@ TEST_F(UIDTest, CaseInsensitiveStringParsing) {
     EXPECT_EQ(uid_lower.to_string(), lowercase);
 }
 
+// Test time-ordered UIDs
+TEST_F(UIDTest, VersionSevenLayout) {
+    auto before = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    UID uid = UID::generate_v7();
+    auto after = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    
+    EXPECT_EQ(uid.version(), 7);
+    EXPECT_EQ(uid.data()[8] & 0xC0, 0x80);
+    EXPECT_EQ(uid.to_string()[14], '7');
+    EXPECT_GE(uid.timestamp_ms(), static_cast<uint64_t>(before));
+    EXPECT_LE(uid.timestamp_ms(), static_cast<uint64_t>(after) + 1);
+    
+    EXPECT_EQ(UID::generate().version(), 4);
+    EXPECT_EQ(UID::generate().timestamp_ms(), 0u);
+    EXPECT_EQ(UID("017f22e2-79b0-7cc3-98c4-dc0c0c07398f").timestamp_ms(), 0x017f22e279b0u);
+}
+
+TEST_F(UIDTest, VersionSevenIsOrdered) {
+    const int num_uids = 100000;
+    std::vector<UID> uids;
+    uids.reserve(num_uids);
+    for (int i = 0; i < num_uids; ++i) {
+        uids.push_back(UID::generate_v7());
+    }
+    
+    // Strictly increasing both as bytes and as strings, even within a millisecond
+    for (size_t i = 1; i < uids.size(); ++i) {
+        ASSERT_TRUE(uids[i - 1] < uids[i]) << "at " << i;
+        ASSERT_LT(uids[i - 1].to_string(), uids[i].to_string());
+        ASSERT_LE(uids[i - 1].timestamp_ms(), uids[i].timestamp_ms());
+    }
+    
+    std::unordered_set<UID> unique(uids.begin(), uids.end());
+    EXPECT_EQ(unique.size(), uids.size());
+    
+    // UIDs sharing a timestamp still spread over the hash values
+    std::unordered_set<size_t> hash_values;
+    for (const auto& uid : uids) {
+        hash_values.insert(std::hash<UID>{}(uid));
+    }
+    EXPECT_EQ(hash_values.size(), uids.size());
+}
+
+TEST_F(UIDTest, ToCharsMatchesToString) {
+    for (int i = 0; i < 100; ++i) {
+        UID uid = i % 2 ? UID::generate() : UID::generate_v7();
+        char buffer[UID::STRING_LENGTH];
+        uid.to_chars(buffer);
+        EXPECT_EQ(std::string(buffer, UID::STRING_LENGTH), uid.to_string());
+        EXPECT_EQ(UID(uid.to_string()), uid);
+    }
+    
+    UID::UUIDData data;
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>(i * 17);
+    }
+    EXPECT_EQ(UID(data).to_string(), "00112233-4455-6677-8899-aabbccddeeff");
+    
+    // Every digit and non-digit at every position
+    std::string text = "00112233-4455-6677-8899-aabbccddeeff";
+    for (size_t pos = 0; pos < text.size(); ++pos) {
+        if (text[pos] == '-') continue;
+        for (int c = 1; c < 256; ++c) {
+            std::string changed = text;
+            changed[pos] = static_cast<char>(c);
+            bool hex = std::isxdigit(c) != 0;
+            if (hex) {
+                EXPECT_NO_THROW(UID{changed});
+            } else {
+                EXPECT_THROW(UID{changed}, std::invalid_argument) << "char " << c << " at " << pos;
+            }
+        }
+    }
+}
+
 // Performance test (basic)
 TEST_F(UIDTest, BasicPerformanceTest) {
     const int num_iterations = 10000;